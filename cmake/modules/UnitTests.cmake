@@ -0,0 +1,16 @@
+#Directory of openfpga_test_utils.h, shared by all the unit tests
+get_filename_component(UNIT_TEST_UTILS_DIR
+                       ${CMAKE_CURRENT_LIST_DIR}/../../libs/libopenfpgautil/test
+                       ABSOLUTE)
+
+function(add_unit_tests library)
+    #Each source file is a self-checking test executable without arguments
+    foreach(testsourcefile ${ARGN})
+        get_filename_component(testname ${testsourcefile} NAME_WE)
+        add_executable(${testname} ${testsourcefile})
+        target_include_directories(${testname} PRIVATE ${UNIT_TEST_UTILS_DIR})
+        # Make sure the library is linked to each test executable
+        target_link_libraries(${testname} ${library})
+        add_test(NAME ${testname} COMMAND ${testname})
+    endforeach()
+endfunction(add_unit_tests)
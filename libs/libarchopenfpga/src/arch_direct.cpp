@@ -1,5 +1,6 @@
 #include "arch_direct.h"
 
+#include "openfpga_binary_io.h"
 #include "vtr_assert.h"
 
 /************************************************************************
@@ -112,3 +113,24 @@ bool ArchDirect::valid_direct_id(const ArchDirectId& direct_id) const {
   return (size_t(direct_id) < direct_ids_.size()) &&
          (direct_id == direct_ids_[direct_id]);
 }
+
+/************************************************************************
+ * Public serializers
+ ***********************************************************************/
+void ArchDirect::write_binary(std::ostream& fp) const {
+  openfpga::write_binary_data(fp, direct_ids_);
+  openfpga::write_binary_data(fp, names_);
+  openfpga::write_binary_data(fp, circuit_models_);
+  openfpga::write_binary_data(fp, types_);
+  openfpga::write_binary_data(fp, directions_);
+  openfpga::write_binary_data(fp, direct_name2ids_);
+}
+
+void ArchDirect::read_binary(std::istream& fp) {
+  openfpga::read_binary_data(fp, direct_ids_);
+  openfpga::read_binary_data(fp, names_);
+  openfpga::read_binary_data(fp, circuit_models_);
+  openfpga::read_binary_data(fp, types_);
+  openfpga::read_binary_data(fp, directions_);
+  openfpga::read_binary_data(fp, direct_name2ids_);
+}
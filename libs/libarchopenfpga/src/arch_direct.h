@@ -2,6 +2,7 @@
 #define ARCH_DIRECT_H
 
 #include <array>
+#include <iosfwd>
 #include <map>
 
 #include "arch_direct_fwd.h"
@@ -75,6 +76,13 @@ class ArchDirect {
                      const e_direct_direction& x_dir,
                      const e_direct_direction& y_dir);
 
+ public: /* Public serializers */
+  /* Dump the content to a binary stream */
+  void write_binary(std::ostream& fp) const;
+  /* Replace the content by the one loaded from a binary stream, which is
+   * created by write_binary() */
+  void read_binary(std::istream& fp);
+
  public: /* Public invalidators/validators */
   bool valid_direct_id(const ArchDirectId& direct_id) const;
 
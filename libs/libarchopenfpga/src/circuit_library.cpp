@@ -3,6 +3,7 @@
 #include <algorithm>
 #include <numeric>
 
+#include "openfpga_binary_io.h"
 #include "openfpga_port_parser.h"
 #include "vtr_assert.h"
 #include "vtr_log.h"
@@ -31,15 +32,12 @@ CircuitLibrary::circuit_port_range CircuitLibrary::ports() const {
  * ids */
 std::vector<CircuitModelId> CircuitLibrary::models_by_type(
   const enum e_circuit_model_type& type) const {
-  std::vector<CircuitModelId> type_ids;
-  for (auto id : models()) {
-    /* Skip unmatched types */
-    if (type != model_type(id)) {
-      continue;
-    }
-    /* Matched type, update the vector */
-    type_ids.push_back(id);
+  if (size_t(type) >= model_lookup_.size()) {
+    return std::vector<CircuitModelId>();
   }
+  /* The fast look-up puts the default model first, restore the order of ids */
+  std::vector<CircuitModelId> type_ids = model_lookup_[size_t(type)];
+  std::sort(type_ids.begin(), type_ids.end());
   return type_ids;
 }
 
@@ -812,15 +810,9 @@ std::vector<CircuitPortId> CircuitLibrary::model_global_ports_by_type(
 std::vector<CircuitPortId> CircuitLibrary::model_ports_by_type(
   const CircuitModelId& model_id,
   const enum e_circuit_model_port_type& type) const {
-  std::vector<CircuitPortId> port_ids;
-  for (const auto& port_id : model_ports(model_id)) {
-    /* We skip unmatched ports */
-    if (type != port_type(port_id)) {
-      continue;
-    }
-    port_ids.push_back(port_id);
-  }
-  return port_ids;
+  /* validate the model_id */
+  VTR_ASSERT(valid_model_id(model_id));
+  return model_port_lookup_[model_id][type];
 }
 
 /* Find the ports of a circuit model by a given type, return a list of qualified
@@ -1168,22 +1160,11 @@ CircuitModelId CircuitLibrary::model(const char* name) const {
 
 /* Find a circuit model by a given name and return its id */
 CircuitModelId CircuitLibrary::model(const std::string& name) const {
-  CircuitModelId ret = CircuitModelId::INVALID();
-  size_t num_found = 0;
-  for (circuit_model_string_iterator it = model_names_.begin();
-       it != model_names_.end(); it++) {
-    /* Bypass unmatched names */
-    if (0 != name.compare(*it)) {
-      continue;
-    }
-    /* Find one and record it
-     * FIXME: I feel that we may have a better way in getting the CircuitModelId
-     */
-    ret = CircuitModelId(it - model_names_.begin());
-    num_found++;
+  auto result = model_name_lookup_.find(name);
+  if (result == model_name_lookup_.end()) {
+    return CircuitModelId::INVALID();
   }
-  VTR_ASSERT((0 == num_found) || (1 == num_found));
-  return ret;
+  return result->second;
 }
 
 /* Get the CircuitModelId of a default circuit model with a given type */
@@ -1323,6 +1304,13 @@ void CircuitLibrary::set_model_name(const CircuitModelId& model_id,
                                     const std::string& name) {
   /* validate the model_id */
   VTR_ASSERT(valid_model_id(model_id));
+  /* Update the fast look-up, a name may be shared by another model until the
+   * library is checked, so keep the entry of the first model */
+  auto result = model_name_lookup_.find(model_names_[model_id]);
+  if ((result != model_name_lookup_.end()) && (model_id == result->second)) {
+    model_name_lookup_.erase(result);
+  }
+  model_name_lookup_.emplace(name, model_id);
   model_names_[model_id] = name;
   return;
 }
@@ -1527,8 +1515,9 @@ CircuitPortId CircuitLibrary::add_model_port(
   port_in_edge_ids_.emplace_back();
   port_out_edge_ids_.emplace_back();
 
-  /* Build the fast look-up for circuit model ports */
-  build_model_port_lookup();
+  /* Update the fast look-up for circuit model ports. Ports are created in the
+   * order of ids, so the look-up is as built by build_model_port_lookup() */
+  model_port_lookup_[model_id][port_type].push_back(circuit_port_id);
 
   return circuit_port_id;
 }
@@ -2623,6 +2612,175 @@ void CircuitLibrary::invalidate_model_timing_graph() {
   return;
 }
 
+/************************************************************************
+ * Public serializers
+ ***********************************************************************/
+void CircuitLibrary::write_binary(std::ostream& fp) const {
+  openfpga::write_binary_data(fp, model_ids_);
+  openfpga::write_binary_data(fp, model_types_);
+  openfpga::write_binary_data(fp, model_names_);
+  openfpga::write_binary_data(fp, model_prefix_);
+  openfpga::write_binary_data(fp, model_verilog_netlists_);
+  openfpga::write_binary_data(fp, model_spice_netlists_);
+  openfpga::write_binary_data(fp, model_is_default_);
+  openfpga::write_binary_data(fp, sub_models_);
+  openfpga::write_binary_data(fp, model_lookup_);
+  openfpga::write_binary_data(fp, model_port_lookup_);
+  openfpga::write_binary_data(fp, model_name_lookup_);
+  openfpga::write_binary_data(fp, dump_structural_verilog_);
+  openfpga::write_binary_data(fp, dump_explicit_port_map_);
+  openfpga::write_binary_data(fp, design_tech_types_);
+  openfpga::write_binary_data(fp, is_power_gated_);
+  openfpga::write_binary_data(fp, device_model_names_);
+  openfpga::write_binary_data(fp, buffer_existence_);
+  openfpga::write_binary_data(fp, buffer_model_names_);
+  openfpga::write_binary_data(fp, buffer_model_ids_);
+  openfpga::write_binary_data(fp, buffer_location_maps_);
+  openfpga::write_binary_data(fp, pass_gate_logic_model_names_);
+  openfpga::write_binary_data(fp, pass_gate_logic_model_ids_);
+  openfpga::write_binary_data(fp, port_ids_);
+  openfpga::write_binary_data(fp, port_model_ids_);
+  openfpga::write_binary_data(fp, port_types_);
+  openfpga::write_binary_data(fp, port_sizes_);
+  openfpga::write_binary_data(fp, port_prefix_);
+  openfpga::write_binary_data(fp, port_lib_names_);
+  openfpga::write_binary_data(fp, port_inv_prefix_);
+  openfpga::write_binary_data(fp, port_default_values_);
+  openfpga::write_binary_data(fp, port_is_io_);
+  openfpga::write_binary_data(fp, port_is_data_io_);
+  openfpga::write_binary_data(fp, port_is_mode_select_);
+  openfpga::write_binary_data(fp, port_is_global_);
+  openfpga::write_binary_data(fp, port_is_reset_);
+  openfpga::write_binary_data(fp, port_is_set_);
+  openfpga::write_binary_data(fp, port_is_config_enable_);
+  openfpga::write_binary_data(fp, port_is_prog_);
+  openfpga::write_binary_data(fp, port_is_shift_register_);
+  openfpga::write_binary_data(fp, port_tri_state_model_names_);
+  openfpga::write_binary_data(fp, port_tri_state_model_ids_);
+  openfpga::write_binary_data(fp, port_inv_model_names_);
+  openfpga::write_binary_data(fp, port_inv_model_ids_);
+  openfpga::write_binary_data(fp, port_tri_state_maps_);
+  openfpga::write_binary_data(fp, port_lut_frac_level_);
+  openfpga::write_binary_data(fp, port_is_harden_lut_port_);
+  openfpga::write_binary_data(fp, port_lut_output_masks_);
+  openfpga::write_binary_data(fp, port_sram_orgz_);
+  openfpga::write_binary_data(fp, edge_ids_);
+  openfpga::write_binary_data(fp, edge_parent_model_ids_);
+  openfpga::write_binary_data(fp, port_in_edge_ids_);
+  openfpga::write_binary_data(fp, port_out_edge_ids_);
+  openfpga::write_binary_data(fp, edge_src_port_ids_);
+  openfpga::write_binary_data(fp, edge_src_pin_ids_);
+  openfpga::write_binary_data(fp, edge_sink_port_ids_);
+  openfpga::write_binary_data(fp, edge_sink_pin_ids_);
+  openfpga::write_binary_data(fp, edge_timing_info_);
+  openfpga::write_binary_data(fp, delay_types_);
+  openfpga::write_binary_data(fp, delay_in_port_names_);
+  openfpga::write_binary_data(fp, delay_out_port_names_);
+  openfpga::write_binary_data(fp, delay_values_);
+  openfpga::write_binary_data(fp, buffer_types_);
+  openfpga::write_binary_data(fp, buffer_sizes_);
+  openfpga::write_binary_data(fp, buffer_num_levels_);
+  openfpga::write_binary_data(fp, buffer_f_per_stage_);
+  openfpga::write_binary_data(fp, pass_gate_logic_types_);
+  openfpga::write_binary_data(fp, pass_gate_logic_sizes_);
+  openfpga::write_binary_data(fp, mux_structure_);
+  openfpga::write_binary_data(fp, mux_num_levels_);
+  openfpga::write_binary_data(fp, mux_const_input_values_);
+  openfpga::write_binary_data(fp, mux_use_local_encoder_);
+  openfpga::write_binary_data(fp, mux_use_advanced_rram_design_);
+  openfpga::write_binary_data(fp, lut_is_fracturable_);
+  openfpga::write_binary_data(fp, gate_types_);
+  openfpga::write_binary_data(fp, rram_res_);
+  openfpga::write_binary_data(fp, wprog_set_);
+  openfpga::write_binary_data(fp, wprog_reset_);
+  openfpga::write_binary_data(fp, wire_types_);
+  openfpga::write_binary_data(fp, wire_rc_);
+  openfpga::write_binary_data(fp, wire_num_levels_);
+}
+
+void CircuitLibrary::read_binary(std::istream& fp) {
+  openfpga::read_binary_data(fp, model_ids_);
+  openfpga::read_binary_data(fp, model_types_);
+  openfpga::read_binary_data(fp, model_names_);
+  openfpga::read_binary_data(fp, model_prefix_);
+  openfpga::read_binary_data(fp, model_verilog_netlists_);
+  openfpga::read_binary_data(fp, model_spice_netlists_);
+  openfpga::read_binary_data(fp, model_is_default_);
+  openfpga::read_binary_data(fp, sub_models_);
+  openfpga::read_binary_data(fp, model_lookup_);
+  openfpga::read_binary_data(fp, model_port_lookup_);
+  openfpga::read_binary_data(fp, model_name_lookup_);
+  openfpga::read_binary_data(fp, dump_structural_verilog_);
+  openfpga::read_binary_data(fp, dump_explicit_port_map_);
+  openfpga::read_binary_data(fp, design_tech_types_);
+  openfpga::read_binary_data(fp, is_power_gated_);
+  openfpga::read_binary_data(fp, device_model_names_);
+  openfpga::read_binary_data(fp, buffer_existence_);
+  openfpga::read_binary_data(fp, buffer_model_names_);
+  openfpga::read_binary_data(fp, buffer_model_ids_);
+  openfpga::read_binary_data(fp, buffer_location_maps_);
+  openfpga::read_binary_data(fp, pass_gate_logic_model_names_);
+  openfpga::read_binary_data(fp, pass_gate_logic_model_ids_);
+  openfpga::read_binary_data(fp, port_ids_);
+  openfpga::read_binary_data(fp, port_model_ids_);
+  openfpga::read_binary_data(fp, port_types_);
+  openfpga::read_binary_data(fp, port_sizes_);
+  openfpga::read_binary_data(fp, port_prefix_);
+  openfpga::read_binary_data(fp, port_lib_names_);
+  openfpga::read_binary_data(fp, port_inv_prefix_);
+  openfpga::read_binary_data(fp, port_default_values_);
+  openfpga::read_binary_data(fp, port_is_io_);
+  openfpga::read_binary_data(fp, port_is_data_io_);
+  openfpga::read_binary_data(fp, port_is_mode_select_);
+  openfpga::read_binary_data(fp, port_is_global_);
+  openfpga::read_binary_data(fp, port_is_reset_);
+  openfpga::read_binary_data(fp, port_is_set_);
+  openfpga::read_binary_data(fp, port_is_config_enable_);
+  openfpga::read_binary_data(fp, port_is_prog_);
+  openfpga::read_binary_data(fp, port_is_shift_register_);
+  openfpga::read_binary_data(fp, port_tri_state_model_names_);
+  openfpga::read_binary_data(fp, port_tri_state_model_ids_);
+  openfpga::read_binary_data(fp, port_inv_model_names_);
+  openfpga::read_binary_data(fp, port_inv_model_ids_);
+  openfpga::read_binary_data(fp, port_tri_state_maps_);
+  openfpga::read_binary_data(fp, port_lut_frac_level_);
+  openfpga::read_binary_data(fp, port_is_harden_lut_port_);
+  openfpga::read_binary_data(fp, port_lut_output_masks_);
+  openfpga::read_binary_data(fp, port_sram_orgz_);
+  openfpga::read_binary_data(fp, edge_ids_);
+  openfpga::read_binary_data(fp, edge_parent_model_ids_);
+  openfpga::read_binary_data(fp, port_in_edge_ids_);
+  openfpga::read_binary_data(fp, port_out_edge_ids_);
+  openfpga::read_binary_data(fp, edge_src_port_ids_);
+  openfpga::read_binary_data(fp, edge_src_pin_ids_);
+  openfpga::read_binary_data(fp, edge_sink_port_ids_);
+  openfpga::read_binary_data(fp, edge_sink_pin_ids_);
+  openfpga::read_binary_data(fp, edge_timing_info_);
+  openfpga::read_binary_data(fp, delay_types_);
+  openfpga::read_binary_data(fp, delay_in_port_names_);
+  openfpga::read_binary_data(fp, delay_out_port_names_);
+  openfpga::read_binary_data(fp, delay_values_);
+  openfpga::read_binary_data(fp, buffer_types_);
+  openfpga::read_binary_data(fp, buffer_sizes_);
+  openfpga::read_binary_data(fp, buffer_num_levels_);
+  openfpga::read_binary_data(fp, buffer_f_per_stage_);
+  openfpga::read_binary_data(fp, pass_gate_logic_types_);
+  openfpga::read_binary_data(fp, pass_gate_logic_sizes_);
+  openfpga::read_binary_data(fp, mux_structure_);
+  openfpga::read_binary_data(fp, mux_num_levels_);
+  openfpga::read_binary_data(fp, mux_const_input_values_);
+  openfpga::read_binary_data(fp, mux_use_local_encoder_);
+  openfpga::read_binary_data(fp, mux_use_advanced_rram_design_);
+  openfpga::read_binary_data(fp, lut_is_fracturable_);
+  openfpga::read_binary_data(fp, gate_types_);
+  openfpga::read_binary_data(fp, rram_res_);
+  openfpga::read_binary_data(fp, wprog_set_);
+  openfpga::read_binary_data(fp, wprog_reset_);
+  openfpga::read_binary_data(fp, wire_types_);
+  openfpga::read_binary_data(fp, wire_rc_);
+  openfpga::read_binary_data(fp, wire_num_levels_);
+}
+
 /************************************************************************
  * End of file : circuit_library.cpp
  ***********************************************************************/
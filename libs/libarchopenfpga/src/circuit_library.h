@@ -12,7 +12,9 @@
  */
 /* Header files should be included in a sequence */
 /* Standard header files required go first */
+#include <iosfwd>
 #include <string>
+#include <unordered_map>
 
 #include "circuit_library_fwd.h"
 #include "circuit_types.h"
@@ -63,6 +65,7 @@
  *the default model in the first element for each type.
  *  2. model_port_lookup_: A multi-dimension vector to provide fast look-up on
  *ports of circuit models for users It classifies Ports by their types
+ *  3. model_name_lookup_: A hash table to find circuit models by their names
  *
  *  ------ Verilog generation options -----
  * 1. dump_structural_verilog_: if Verilog generator will output structural
@@ -599,6 +602,13 @@ class CircuitLibrary {
   void build_model_lookup();
   void build_model_port_lookup();
 
+ public: /* Public serializers */
+  /* Dump the content to a binary stream */
+  void write_binary(std::ostream& fp) const;
+  /* Replace the content by the one loaded from a binary stream, which is
+   * created by write_binary() */
+  void read_binary(std::istream& fp);
+
  public: /* Public invalidators/validators */
   bool valid_model_id(const CircuitModelId& model_id) const;
   bool valid_circuit_port_id(const CircuitPortId& circuit_port_id) const;
@@ -642,6 +652,8 @@ class CircuitLibrary {
     CircuitModelPortLookup;
   mutable CircuitModelPortLookup
     model_port_lookup_; /* [model_id][port_type][port_ids] */
+  std::unordered_map<std::string, CircuitModelId>
+    model_name_lookup_; /* [model_name] */
 
   /* Verilog generator options */
   vtr::vector<CircuitModelId, bool> dump_structural_verilog_;
@@ -1,5 +1,6 @@
 #include "config_protocol.h"
 
+#include "openfpga_binary_io.h"
 #include "openfpga_tokenizer.h"
 #include "vtr_assert.h"
 #include "vtr_log.h"
@@ -328,3 +329,42 @@ int ConfigProtocol::validate() const {
   }
   return num_err;
 }
+
+/************************************************************************
+ * Public serializers
+ ***********************************************************************/
+void ConfigProtocol::write_binary(std::ostream& fp) const {
+  openfpga::write_binary_data(fp, type_);
+  openfpga::write_binary_data(fp, memory_model_name_);
+  openfpga::write_binary_data(fp, memory_model_);
+  openfpga::write_binary_data(fp, num_regions_);
+  openfpga::write_binary_data(fp, prog_clk_port_);
+  openfpga::write_binary_data(fp, prog_clk_ccff_head_indices_);
+  openfpga::write_binary_data(fp, INDICE_STRING_DELIM_);
+  openfpga::write_binary_data(fp, bl_protocol_type_);
+  openfpga::write_binary_data(fp, bl_memory_model_name_);
+  openfpga::write_binary_data(fp, bl_memory_model_);
+  openfpga::write_binary_data(fp, bl_num_banks_);
+  openfpga::write_binary_data(fp, wl_protocol_type_);
+  openfpga::write_binary_data(fp, wl_memory_model_name_);
+  openfpga::write_binary_data(fp, wl_memory_model_);
+  openfpga::write_binary_data(fp, wl_num_banks_);
+}
+
+void ConfigProtocol::read_binary(std::istream& fp) {
+  openfpga::read_binary_data(fp, type_);
+  openfpga::read_binary_data(fp, memory_model_name_);
+  openfpga::read_binary_data(fp, memory_model_);
+  openfpga::read_binary_data(fp, num_regions_);
+  openfpga::read_binary_data(fp, prog_clk_port_);
+  openfpga::read_binary_data(fp, prog_clk_ccff_head_indices_);
+  openfpga::read_binary_data(fp, INDICE_STRING_DELIM_);
+  openfpga::read_binary_data(fp, bl_protocol_type_);
+  openfpga::read_binary_data(fp, bl_memory_model_name_);
+  openfpga::read_binary_data(fp, bl_memory_model_);
+  openfpga::read_binary_data(fp, bl_num_banks_);
+  openfpga::read_binary_data(fp, wl_protocol_type_);
+  openfpga::read_binary_data(fp, wl_memory_model_name_);
+  openfpga::read_binary_data(fp, wl_memory_model_);
+  openfpga::read_binary_data(fp, wl_num_banks_);
+}
@@ -1,6 +1,7 @@
 #ifndef CONFIG_PROTOCOL_H
 #define CONFIG_PROTOCOL_H
 
+#include <iosfwd>
 #include <map>
 #include <string>
 
@@ -81,6 +82,13 @@ class ConfigProtocol {
    * errors detected */
   int validate() const;
 
+ public: /* Public serializers */
+  /* Dump the content to a binary stream */
+  void write_binary(std::ostream& fp) const;
+  /* Replace the content by the one loaded from a binary stream, which is
+   * created by write_binary() */
+  void read_binary(std::istream& fp);
+
  private: /* Private validators */
   /* For configuration chains, to validate if
    * - programming clocks is smaller than the number of regions
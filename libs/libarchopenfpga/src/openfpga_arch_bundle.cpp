@@ -0,0 +1,265 @@
+/********************************************************************
+ * This file includes functions to save an OpenFPGA architecture, whose
+ * internal links are already built, to a binary bundle and to load it back.
+ * Loading a bundle skips the parsing of the XML file and the linking of the
+ * data structures, which are executed when the bundle is written.
+ *
+ * The bundle is organized as follows:
+ *   - a header: a magic word and the format version
+ *   - a list of sections, each starts with a section id and the number of
+ *     bytes of its payload, so that a corrupted file can be detected.
+ * The binary layout depends on the platform (see openfpga_binary_io.h), so a
+ * bundle is only meant to be read by the same build of OpenFPGA.
+ *******************************************************************/
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <utility>
+
+/* Headers from vtrutil library */
+#include "vtr_assert.h"
+#include "vtr_log.h"
+#include "vtr_time.h"
+
+/* Headers from openfpgashell library */
+#include "command_exit_codes.h"
+
+/* Headers from openfpgautil library */
+#include "openfpga_binary_io.h"
+#include "openfpga_digest.h"
+
+/* Headers from libarchopenfpga */
+#include "openfpga_arch_bundle.h"
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+/* Identify the type of file; change the version whenever the layout of any
+ * data structure in the bundle changes */
+constexpr char OPENFPGA_ARCH_BUNDLE_MAGIC[] = "OFPGAARB";
+constexpr size_t OPENFPGA_ARCH_BUNDLE_MAGIC_SIZE =
+  sizeof(OPENFPGA_ARCH_BUNDLE_MAGIC) - 1;
+constexpr uint32_t OPENFPGA_ARCH_BUNDLE_VERSION = 1;
+
+/* Sections of the bundle, which are stored in this order */
+enum e_openfpga_arch_bundle_section : uint32_t {
+  OPENFPGA_ARCH_BUNDLE_CIRCUIT_LIBRARY,
+  OPENFPGA_ARCH_BUNDLE_TECHNOLOGY_LIBRARY,
+  OPENFPGA_ARCH_BUNDLE_CIRCUIT_TECH_BINDING,
+  OPENFPGA_ARCH_BUNDLE_CONFIG_PROTOCOL,
+  OPENFPGA_ARCH_BUNDLE_ROUTING_CIRCUITS,
+  OPENFPGA_ARCH_BUNDLE_ARCH_DIRECT,
+  OPENFPGA_ARCH_BUNDLE_TILE_ANNOTATIONS,
+  OPENFPGA_ARCH_BUNDLE_PB_TYPE_ANNOTATIONS,
+  NUM_OPENFPGA_ARCH_BUNDLE_SECTIONS
+};
+
+/********************************************************************
+ * Write the payload of a section to a stream
+ *******************************************************************/
+static void write_openfpga_arch_bundle_section_payload(
+  std::ostream& fp, const e_openfpga_arch_bundle_section& section,
+  const Arch& openfpga_arch) {
+  switch (section) {
+    case OPENFPGA_ARCH_BUNDLE_CIRCUIT_LIBRARY:
+      openfpga_arch.circuit_lib.write_binary(fp);
+      break;
+    case OPENFPGA_ARCH_BUNDLE_TECHNOLOGY_LIBRARY:
+      openfpga_arch.tech_lib.write_binary(fp);
+      break;
+    case OPENFPGA_ARCH_BUNDLE_CIRCUIT_TECH_BINDING:
+      write_binary_data(fp, openfpga_arch.circuit_tech_binding);
+      break;
+    case OPENFPGA_ARCH_BUNDLE_CONFIG_PROTOCOL:
+      openfpga_arch.config_protocol.write_binary(fp);
+      break;
+    case OPENFPGA_ARCH_BUNDLE_ROUTING_CIRCUITS:
+      write_binary_data(fp, openfpga_arch.cb_switch2circuit);
+      write_binary_data(fp, openfpga_arch.sb_switch2circuit);
+      write_binary_data(fp, openfpga_arch.routing_seg2circuit);
+      break;
+    case OPENFPGA_ARCH_BUNDLE_ARCH_DIRECT:
+      openfpga_arch.arch_direct.write_binary(fp);
+      break;
+    case OPENFPGA_ARCH_BUNDLE_TILE_ANNOTATIONS:
+      openfpga_arch.tile_annotations.write_binary(fp);
+      break;
+    case OPENFPGA_ARCH_BUNDLE_PB_TYPE_ANNOTATIONS:
+      write_binary_size(fp, openfpga_arch.pb_type_annotations.size());
+      for (const auto& pb_type_annotation : openfpga_arch.pb_type_annotations) {
+        pb_type_annotation.write_binary(fp);
+      }
+      break;
+    default:
+      VTR_ASSERT_MSG(false, "Invalid OpenFPGA architecture bundle section");
+  }
+}
+
+/********************************************************************
+ * Read the payload of a section from a stream
+ *******************************************************************/
+static void read_openfpga_arch_bundle_section_payload(
+  std::istream& fp, const e_openfpga_arch_bundle_section& section,
+  Arch& openfpga_arch) {
+  switch (section) {
+    case OPENFPGA_ARCH_BUNDLE_CIRCUIT_LIBRARY:
+      openfpga_arch.circuit_lib.read_binary(fp);
+      break;
+    case OPENFPGA_ARCH_BUNDLE_TECHNOLOGY_LIBRARY:
+      openfpga_arch.tech_lib.read_binary(fp);
+      break;
+    case OPENFPGA_ARCH_BUNDLE_CIRCUIT_TECH_BINDING:
+      read_binary_data(fp, openfpga_arch.circuit_tech_binding);
+      break;
+    case OPENFPGA_ARCH_BUNDLE_CONFIG_PROTOCOL:
+      openfpga_arch.config_protocol.read_binary(fp);
+      break;
+    case OPENFPGA_ARCH_BUNDLE_ROUTING_CIRCUITS:
+      read_binary_data(fp, openfpga_arch.cb_switch2circuit);
+      read_binary_data(fp, openfpga_arch.sb_switch2circuit);
+      read_binary_data(fp, openfpga_arch.routing_seg2circuit);
+      break;
+    case OPENFPGA_ARCH_BUNDLE_ARCH_DIRECT:
+      openfpga_arch.arch_direct.read_binary(fp);
+      break;
+    case OPENFPGA_ARCH_BUNDLE_TILE_ANNOTATIONS:
+      openfpga_arch.tile_annotations.read_binary(fp);
+      break;
+    case OPENFPGA_ARCH_BUNDLE_PB_TYPE_ANNOTATIONS:
+      openfpga_arch.pb_type_annotations.resize(
+        read_binary_container_size(fp, 1));
+      for (auto& pb_type_annotation : openfpga_arch.pb_type_annotations) {
+        pb_type_annotation.read_binary(fp);
+      }
+      break;
+    default:
+      VTR_ASSERT_MSG(false, "Invalid OpenFPGA architecture bundle section");
+  }
+}
+
+/********************************************************************
+ * Write an OpenFPGA architecture to a binary bundle.
+ * The architecture is expected to be completely linked, as done by
+ * read_xml_openfpga_arch()
+ *
+ * Return 0 if successful
+ * Return 1 if fail when writing the file
+ *******************************************************************/
+int write_openfpga_arch_bundle(const std::string& fname,
+                               const Arch& openfpga_arch) {
+  std::string timer_message =
+    std::string("Write OpenFPGA architecture bundle to binary file '") +
+    fname + std::string("'");
+  vtr::ScopedStartFinishTimer timer(timer_message);
+
+  VTR_ASSERT(true != fname.empty());
+
+  std::fstream fp;
+  fp.open(fname, std::fstream::out | std::fstream::trunc |
+                   std::fstream::binary);
+  check_file_stream(fname.c_str(), fp);
+
+  /* Header */
+  fp.write(OPENFPGA_ARCH_BUNDLE_MAGIC, OPENFPGA_ARCH_BUNDLE_MAGIC_SIZE);
+  write_binary_data(fp, OPENFPGA_ARCH_BUNDLE_VERSION);
+
+  /* Sections: the payload is built in memory first, as its size has to be
+   * written ahead */
+  std::ostringstream payload(std::ios::binary);
+  for (uint32_t isec = 0; isec < NUM_OPENFPGA_ARCH_BUNDLE_SECTIONS; ++isec) {
+    payload.str(std::string());
+    write_openfpga_arch_bundle_section_payload(
+      payload, e_openfpga_arch_bundle_section(isec), openfpga_arch);
+    std::string data = payload.str();
+    write_binary_data(fp, isec);
+    write_binary_size(fp, data.size());
+    fp.write(data.data(), data.size());
+  }
+
+  if (false == fp.good()) {
+    VTR_LOG_ERROR("Fail to write OpenFPGA architecture bundle to file '%s'!\n",
+                  fname.c_str());
+    fp.close();
+    return CMD_EXEC_FATAL_ERROR;
+  }
+
+  fp.close();
+
+  return CMD_EXEC_SUCCESS;
+}
+
+/********************************************************************
+ * Read an OpenFPGA architecture from a binary bundle, which is created by
+ * write_openfpga_arch_bundle().
+ * The architecture is not touched unless the whole bundle is loaded.
+ *
+ * Return 0 if successful
+ * Return 1 if the file does not exist, is created by another version or is
+ * corrupted
+ *******************************************************************/
+int read_openfpga_arch_bundle(const std::string& fname, Arch& openfpga_arch) {
+  std::string timer_message =
+    std::string("Read OpenFPGA architecture bundle from binary file '") +
+    fname + std::string("'");
+  vtr::ScopedStartFinishTimer timer(timer_message);
+
+  std::fstream fp;
+  fp.open(fname, std::fstream::in | std::fstream::binary);
+  if (false == valid_file_stream(fp)) {
+    VTR_LOG_ERROR("OpenFPGA architecture bundle '%s' does not exist!\n",
+                  fname.c_str());
+    return CMD_EXEC_FATAL_ERROR;
+  }
+
+  /* Header */
+  char magic[OPENFPGA_ARCH_BUNDLE_MAGIC_SIZE];
+  uint32_t version = 0;
+  fp.read(magic, OPENFPGA_ARCH_BUNDLE_MAGIC_SIZE);
+  read_binary_data(fp, version);
+  if ((false == fp.good()) ||
+      (0 != std::memcmp(magic, OPENFPGA_ARCH_BUNDLE_MAGIC,
+                        OPENFPGA_ARCH_BUNDLE_MAGIC_SIZE))) {
+    VTR_LOG_ERROR("File '%s' is not an OpenFPGA architecture bundle!\n",
+                  fname.c_str());
+    return CMD_EXEC_FATAL_ERROR;
+  }
+  if (OPENFPGA_ARCH_BUNDLE_VERSION != version) {
+    VTR_LOG_ERROR(
+      "OpenFPGA architecture bundle '%s' has version %u while version %u is "
+      "expected! Please write the bundle again.\n",
+      fname.c_str(), version, OPENFPGA_ARCH_BUNDLE_VERSION);
+    return CMD_EXEC_FATAL_ERROR;
+  }
+
+  /* Sections */
+  Arch bundle_arch;
+  for (uint32_t isec = 0; isec < NUM_OPENFPGA_ARCH_BUNDLE_SECTIONS; ++isec) {
+    uint32_t section_id = NUM_OPENFPGA_ARCH_BUNDLE_SECTIONS;
+    read_binary_data(fp, section_id);
+    size_t num_bytes = read_binary_container_size(fp, 1);
+    if ((false == fp.good()) || (isec != section_id)) {
+      VTR_LOG_ERROR(
+        "OpenFPGA architecture bundle '%s' is corrupted: section %u is "
+        "missing!\n",
+        fname.c_str(), isec);
+      return CMD_EXEC_FATAL_ERROR;
+    }
+    std::streampos start = fp.tellg();
+    read_openfpga_arch_bundle_section_payload(
+      fp, e_openfpga_arch_bundle_section(isec), bundle_arch);
+    if ((false == fp.good()) || (size_t(fp.tellg() - start) != num_bytes)) {
+      VTR_LOG_ERROR(
+        "OpenFPGA architecture bundle '%s' is corrupted in section %u!\n",
+        fname.c_str(), isec);
+      return CMD_EXEC_FATAL_ERROR;
+    }
+  }
+
+  fp.close();
+
+  openfpga_arch = std::move(bundle_arch);
+
+  return CMD_EXEC_SUCCESS;
+}
+
+} /* end namespace openfpga */
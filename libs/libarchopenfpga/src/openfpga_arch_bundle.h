@@ -0,0 +1,25 @@
+#ifndef OPENFPGA_ARCH_BUNDLE_H
+#define OPENFPGA_ARCH_BUNDLE_H
+
+/********************************************************************
+ * Include header files that are required by function declaration
+ *******************************************************************/
+#include <string>
+
+#include "openfpga_arch.h"
+
+/********************************************************************
+ * Function declaration
+ *******************************************************************/
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+int write_openfpga_arch_bundle(const std::string& fname,
+                               const Arch& openfpga_arch);
+
+int read_openfpga_arch_bundle(const std::string& fname, Arch& openfpga_arch);
+
+} /* end namespace openfpga */
+
+#endif
@@ -5,6 +5,7 @@
 
 #include <algorithm>
 
+#include "openfpga_binary_io.h"
 #include "vtr_assert.h"
 #include "vtr_log.h"
 
@@ -286,4 +287,41 @@ void PbTypeAnnotation::add_interconnect_circuit_model_pair(
   interconnect_circuit_model_names_[interc_name] = circuit_model_name;
 }
 
+/************************************************************************
+ * Public serializers
+ ***********************************************************************/
+void PbTypeAnnotation::write_binary(std::ostream& fp) const {
+  write_binary_data(fp, operating_pb_type_name_);
+  write_binary_data(fp, operating_parent_pb_type_names_);
+  write_binary_data(fp, operating_parent_mode_names_);
+  write_binary_data(fp, physical_pb_type_name_);
+  write_binary_data(fp, physical_parent_pb_type_names_);
+  write_binary_data(fp, physical_parent_mode_names_);
+  write_binary_data(fp, physical_mode_name_);
+  write_binary_data(fp, idle_mode_name_);
+  write_binary_data(fp, mode_bits_);
+  write_binary_data(fp, circuit_model_name_);
+  write_binary_data(fp, physical_pb_type_index_factor_);
+  write_binary_data(fp, physical_pb_type_index_offset_);
+  write_binary_data(fp, operating_pb_type_ports_);
+  write_binary_data(fp, interconnect_circuit_model_names_);
+}
+
+void PbTypeAnnotation::read_binary(std::istream& fp) {
+  read_binary_data(fp, operating_pb_type_name_);
+  read_binary_data(fp, operating_parent_pb_type_names_);
+  read_binary_data(fp, operating_parent_mode_names_);
+  read_binary_data(fp, physical_pb_type_name_);
+  read_binary_data(fp, physical_parent_pb_type_names_);
+  read_binary_data(fp, physical_parent_mode_names_);
+  read_binary_data(fp, physical_mode_name_);
+  read_binary_data(fp, idle_mode_name_);
+  read_binary_data(fp, mode_bits_);
+  read_binary_data(fp, circuit_model_name_);
+  read_binary_data(fp, physical_pb_type_index_factor_);
+  read_binary_data(fp, physical_pb_type_index_offset_);
+  read_binary_data(fp, operating_pb_type_ports_);
+  read_binary_data(fp, interconnect_circuit_model_names_);
+}
+
 }  // namespace openfpga
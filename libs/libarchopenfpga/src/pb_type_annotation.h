@@ -5,6 +5,7 @@
  * Include header files required by the data structure definition
  *******************************************************************/
 #include <array>
+#include <iosfwd>
 #include <map>
 #include <vector>
 
@@ -84,6 +85,13 @@ class PbTypeAnnotation {
   void add_interconnect_circuit_model_pair(
     const std::string& interc_name, const std::string& circuit_model_name);
 
+ public: /* Public serializers */
+  /* Dump the content to a binary stream */
+  void write_binary(std::ostream& fp) const;
+  /* Replace the content by the one loaded from a binary stream, which is
+   * created by write_binary() */
+  void read_binary(std::istream& fp);
+
  private: /* Internal data */
   /* Binding between physical pb_type and operating pb_type
    * both operating and physial pb_type names contain the full names
@@ -94,10 +94,6 @@ openfpga::Arch read_xml_openfpga_arch(const char* arch_file_name) {
     openfpga_arch.cb_switch2circuit = read_xml_cb_switch_circuit(
       xml_openfpga_arch, loc_data, openfpga_arch.circuit_lib);
 
-    /* Parse the connection block circuit definition */
-    openfpga_arch.cb_switch2circuit = read_xml_cb_switch_circuit(
-      xml_openfpga_arch, loc_data, openfpga_arch.circuit_lib);
-
     /* Parse the switch block circuit definition */
     openfpga_arch.sb_switch2circuit = read_xml_sb_switch_circuit(
       xml_openfpga_arch, loc_data, openfpga_arch.circuit_lib);
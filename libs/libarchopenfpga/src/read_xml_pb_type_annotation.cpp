@@ -4,6 +4,7 @@
  * data structures
  *******************************************************************/
 #include <string>
+#include <utility>
 
 /* Headers from pugi XML library */
 #include "pugixml.hpp"
@@ -61,10 +62,15 @@ static void read_xml_pb_port_annotation(
   openfpga::StringToken port_tokenizer(physical_mode_port_attr);
   const std::vector<std::string> physical_mode_ports = port_tokenizer.split();
 
-  /* Parse the mode port using openfpga port parser */
+  /* Parse the mode port using openfpga port parser. The ports are parsed only
+   * once and reused by the optional offset attributes below */
+  std::vector<openfpga::BasicPort> physical_pb_ports;
+  physical_pb_ports.reserve(physical_mode_ports.size());
   for (const auto& physical_mode_port : physical_mode_ports) {
-    openfpga::PortParser port_parser(physical_mode_port);
-    pb_type_annotation.add_pb_type_port_pair(name_attr, port_parser.port());
+    physical_pb_ports.push_back(
+      openfpga::PortParser(physical_mode_port).port());
+    pb_type_annotation.add_pb_type_port_pair(name_attr,
+                                             physical_pb_ports.back());
   }
 
   /* We have an optional attribute: physical_mode_pin_initial_offset
@@ -89,9 +95,8 @@ static void read_xml_pb_port_annotation(
     }
 
     for (size_t iport = 0; iport < physical_mode_ports.size(); ++iport) {
-      openfpga::PortParser port_parser(physical_mode_ports[iport]);
       pb_type_annotation.set_physical_pin_initial_offset(
-        name_attr, port_parser.port(), std::stoi(initial_offsets[iport]));
+        name_attr, physical_pb_ports[iport], std::stoi(initial_offsets[iport]));
     }
   }
 
@@ -117,9 +122,8 @@ static void read_xml_pb_port_annotation(
     }
 
     for (size_t iport = 0; iport < physical_mode_ports.size(); ++iport) {
-      openfpga::PortParser port_parser(physical_mode_ports[iport]);
       pb_type_annotation.set_physical_pin_rotate_offset(
-        name_attr, port_parser.port(), std::stoi(rotate_offsets[iport]));
+        name_attr, physical_pb_ports[iport], std::stoi(rotate_offsets[iport]));
     }
   }
 
@@ -145,9 +149,8 @@ static void read_xml_pb_port_annotation(
     }
 
     for (size_t iport = 0; iport < physical_mode_ports.size(); ++iport) {
-      openfpga::PortParser port_parser(physical_mode_ports[iport]);
       pb_type_annotation.set_physical_port_rotate_offset(
-        name_attr, port_parser.port(), std::stoi(rotate_offsets[iport]));
+        name_attr, physical_pb_ports[iport], std::stoi(rotate_offsets[iport]));
     }
   }
 }
@@ -307,7 +310,7 @@ static void read_xml_pb_type_annotation(
   }
 
   /* Finish parsing and add it to the vector */
-  pb_type_annotations.push_back(pb_type_annotation);
+  pb_type_annotations.push_back(std::move(pb_type_annotation));
 }
 
 /********************************************************************
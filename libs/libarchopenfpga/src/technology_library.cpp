@@ -1,5 +1,6 @@
 #include "technology_library.h"
 
+#include "openfpga_binary_io.h"
 #include "vtr_assert.h"
 
 /************************************************************************
@@ -597,3 +598,60 @@ bool TechnologyLibrary::valid_variation_id(
   return (size_t(variation_id) < variation_ids_.size()) &&
          (variation_id == variation_ids_[variation_id]);
 }
+
+/************************************************************************
+ * Public serializers
+ ***********************************************************************/
+void TechnologyLibrary::write_binary(std::ostream& fp) const {
+  openfpga::write_binary_data(fp, model_ids_);
+  openfpga::write_binary_data(fp, model_names_);
+  openfpga::write_binary_data(fp, model_types_);
+  openfpga::write_binary_data(fp, model_lib_types_);
+  openfpga::write_binary_data(fp, model_corners_);
+  openfpga::write_binary_data(fp, model_refs_);
+  openfpga::write_binary_data(fp, model_lib_paths_);
+  openfpga::write_binary_data(fp, model_vdds_);
+  openfpga::write_binary_data(fp, model_pn_ratios_);
+  openfpga::write_binary_data(fp, transistor_model_names_);
+  openfpga::write_binary_data(fp, transistor_model_chan_lengths_);
+  openfpga::write_binary_data(fp, transistor_model_min_widths_);
+  openfpga::write_binary_data(fp, transistor_model_max_widths_);
+  openfpga::write_binary_data(fp, transistor_model_variation_names_);
+  openfpga::write_binary_data(fp, transistor_model_variation_ids_);
+  openfpga::write_binary_data(fp, rram_resistances_);
+  openfpga::write_binary_data(fp, rram_variation_names_);
+  openfpga::write_binary_data(fp, rram_variation_ids_);
+  openfpga::write_binary_data(fp, variation_ids_);
+  openfpga::write_binary_data(fp, variation_names_);
+  openfpga::write_binary_data(fp, variation_abs_values_);
+  openfpga::write_binary_data(fp, variation_num_sigmas_);
+  openfpga::write_binary_data(fp, model_name2ids_);
+  openfpga::write_binary_data(fp, variation_name2ids_);
+}
+
+void TechnologyLibrary::read_binary(std::istream& fp) {
+  openfpga::read_binary_data(fp, model_ids_);
+  openfpga::read_binary_data(fp, model_names_);
+  openfpga::read_binary_data(fp, model_types_);
+  openfpga::read_binary_data(fp, model_lib_types_);
+  openfpga::read_binary_data(fp, model_corners_);
+  openfpga::read_binary_data(fp, model_refs_);
+  openfpga::read_binary_data(fp, model_lib_paths_);
+  openfpga::read_binary_data(fp, model_vdds_);
+  openfpga::read_binary_data(fp, model_pn_ratios_);
+  openfpga::read_binary_data(fp, transistor_model_names_);
+  openfpga::read_binary_data(fp, transistor_model_chan_lengths_);
+  openfpga::read_binary_data(fp, transistor_model_min_widths_);
+  openfpga::read_binary_data(fp, transistor_model_max_widths_);
+  openfpga::read_binary_data(fp, transistor_model_variation_names_);
+  openfpga::read_binary_data(fp, transistor_model_variation_ids_);
+  openfpga::read_binary_data(fp, rram_resistances_);
+  openfpga::read_binary_data(fp, rram_variation_names_);
+  openfpga::read_binary_data(fp, rram_variation_ids_);
+  openfpga::read_binary_data(fp, variation_ids_);
+  openfpga::read_binary_data(fp, variation_names_);
+  openfpga::read_binary_data(fp, variation_abs_values_);
+  openfpga::read_binary_data(fp, variation_num_sigmas_);
+  openfpga::read_binary_data(fp, model_name2ids_);
+  openfpga::read_binary_data(fp, variation_name2ids_);
+}
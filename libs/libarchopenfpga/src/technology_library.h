@@ -5,6 +5,7 @@
  * This file include the declaration of technology library
  *******************************************************************/
 #include <array>
+#include <iosfwd>
 #include <map>
 #include <string>
 
@@ -189,6 +190,13 @@ class TechnologyLibrary {
   bool valid_model_id(const TechnologyModelId& model_id) const;
   bool valid_variation_id(const TechnologyVariationId& variation_id) const;
 
+ public: /* Public serializers */
+  /* Dump the content to a binary stream */
+  void write_binary(std::ostream& fp) const;
+  /* Replace the content by the one loaded from a binary stream, which is
+   * created by write_binary() */
+  void read_binary(std::istream& fp);
+
  private: /* Internal data */
   /* Transistor-related fundamental information */
   /* Unique identifier for each model
@@ -6,6 +6,7 @@
 #include <algorithm>
 
 #include "command_exit_codes.h"
+#include "openfpga_binary_io.h"
 #include "vtr_assert.h"
 #include "vtr_log.h"
 
@@ -234,4 +235,37 @@ int TileAnnotation::add_merge_subtile_ports(const std::string& tile_name,
   return CMD_EXEC_SUCCESS;
 }
 
+/************************************************************************
+ * Public serializers
+ ***********************************************************************/
+void TileAnnotation::write_binary(std::ostream& fp) const {
+  write_binary_data(fp, global_port_ids_);
+  write_binary_data(fp, global_port_names_);
+  write_binary_data(fp, global_port_tile_names_);
+  write_binary_data(fp, global_port_tile_coordinates_);
+  write_binary_data(fp, global_port_tile_ports_);
+  write_binary_data(fp, global_port_is_clock_);
+  write_binary_data(fp, global_port_clock_arch_tree_names_);
+  write_binary_data(fp, global_port_is_reset_);
+  write_binary_data(fp, global_port_is_set_);
+  write_binary_data(fp, global_port_default_values_);
+  write_binary_data(fp, global_port_name2ids_);
+  write_binary_data(fp, tile_ports_to_merge_);
+}
+
+void TileAnnotation::read_binary(std::istream& fp) {
+  read_binary_data(fp, global_port_ids_);
+  read_binary_data(fp, global_port_names_);
+  read_binary_data(fp, global_port_tile_names_);
+  read_binary_data(fp, global_port_tile_coordinates_);
+  read_binary_data(fp, global_port_tile_ports_);
+  read_binary_data(fp, global_port_is_clock_);
+  read_binary_data(fp, global_port_clock_arch_tree_names_);
+  read_binary_data(fp, global_port_is_reset_);
+  read_binary_data(fp, global_port_is_set_);
+  read_binary_data(fp, global_port_default_values_);
+  read_binary_data(fp, global_port_name2ids_);
+  read_binary_data(fp, tile_ports_to_merge_);
+}
+
 }  // namespace openfpga
@@ -5,6 +5,7 @@
  * Include header files required by the data structure definition
  *******************************************************************/
 #include <array>
+#include <iosfwd>
 #include <map>
 #include <vector>
 
@@ -95,6 +96,13 @@ class TileAnnotation {
   bool valid_global_port_attributes(
     const TileGlobalPortId& global_port_id) const;
 
+ public: /* Public serializers */
+  /* Dump the content to a binary stream */
+  void write_binary(std::ostream& fp) const;
+  /* Replace the content by the one loaded from a binary stream, which is
+   * created by write_binary() */
+  void read_binary(std::istream& fp);
+
  private: /* Internal data */
   /* Global port information for tiles */
   vtr::vector<TileGlobalPortId, TileGlobalPortId> global_port_ids_;
@@ -0,0 +1,162 @@
+/********************************************************************
+ * Unit test functions to validate the binary bundle of OpenFPGA
+ * architectures
+ * 1. each data structure of an architecture is written, read back and
+ *    written again, which should result in the same bytes
+ * 2. a bundle is written and read back to the same architecture
+ * 3. a truncated bundle or a bundle of another version is rejected,
+ *    without touching the architecture
+ * The architecture is the file given by OPENFPGA_TEST_ARCH_FILE at
+ * compile time, so that the test runs without arguments
+ *******************************************************************/
+#include <cstdio>
+#include <sstream>
+#include <string>
+
+/* Headers from vtrutils */
+#include "vtr_assert.h"
+#include "vtr_log.h"
+
+/* Headers from libopenfpgashell */
+#include "command_exit_codes.h"
+
+/* Headers from readarchopenfpga */
+#include "openfpga_arch_bundle.h"
+#include "read_xml_openfpga_arch.h"
+#include "write_xml_openfpga_arch.h"
+
+/* Headers shared by the unit tests */
+#include "openfpga_test_utils.h"
+
+/* Offset of the version in the header of a bundle, which follows the
+ * magic word */
+constexpr size_t OPENFPGA_ARCH_BUNDLE_VERSION_OFFSET = 8;
+
+/********************************************************************
+ * Write a data structure, read it back and write it again. The two
+ * streams should be the same
+ *******************************************************************/
+template <class T>
+static std::string write_binary_to_string(const T& data) {
+  std::ostringstream fp(std::ios::binary);
+  data.write_binary(fp);
+  return fp.str();
+}
+
+template <class T>
+static void check_round_trip(const T& data, const char* message) {
+  std::string bytes = write_binary_to_string(data);
+  std::istringstream fp(bytes, std::ios::binary);
+  T loaded_data;
+  loaded_data.read_binary(fp);
+  check(true == fp.good(), message);
+  check(bytes == write_binary_to_string(loaded_data), message);
+
+  /* A truncated stream must leave the stream in a failed state */
+  if (1 < bytes.size()) {
+    std::istringstream truncated_fp(bytes.substr(0, bytes.size() / 2),
+                                    std::ios::binary);
+    T truncated_data;
+    truncated_data.read_binary(truncated_fp);
+    check(false == truncated_fp.good(), message);
+  }
+}
+
+static void test_data_structures(const openfpga::Arch& openfpga_arch) {
+  check_round_trip(openfpga_arch.circuit_lib,
+                   "Circuit library changes after a round trip");
+  check_round_trip(openfpga_arch.tech_lib,
+                   "Technology library changes after a round trip");
+  check_round_trip(openfpga_arch.config_protocol,
+                   "Configuration protocol changes after a round trip");
+  check_round_trip(openfpga_arch.arch_direct,
+                   "Inter-tile directs change after a round trip");
+  check_round_trip(openfpga_arch.tile_annotations,
+                   "Tile annotations change after a round trip");
+  for (const openfpga::PbTypeAnnotation& pb_type_annotation :
+       openfpga_arch.pb_type_annotations) {
+    check_round_trip(pb_type_annotation,
+                     "Pb type annotation changes after a round trip");
+  }
+}
+
+static void test_bundle_file(const openfpga::Arch& openfpga_arch) {
+  std::string fname("test_openfpga_arch_bundle.bin");
+  std::string ref_xml_fname("test_openfpga_arch_bundle_ref.xml");
+  std::string test_xml_fname("test_openfpga_arch_bundle_test.xml");
+
+  check(openfpga::CMD_EXEC_SUCCESS ==
+          openfpga::write_openfpga_arch_bundle(fname, openfpga_arch),
+        "Fail to write architecture bundle");
+  openfpga::Arch bundle_arch;
+  check(openfpga::CMD_EXEC_SUCCESS ==
+          openfpga::read_openfpga_arch_bundle(fname, bundle_arch),
+        "Fail to read architecture bundle");
+
+  /* The bundle describes the same architecture as the XML file */
+  check(openfpga_arch.circuit_lib.num_models() ==
+          bundle_arch.circuit_lib.num_models(),
+        "Mismatch in number of circuit models");
+  check(openfpga_arch.pb_type_annotations.size() ==
+          bundle_arch.pb_type_annotations.size(),
+        "Mismatch in number of pb type annotations");
+  write_xml_openfpga_arch(ref_xml_fname.c_str(), openfpga_arch);
+  write_xml_openfpga_arch(test_xml_fname.c_str(), bundle_arch);
+  check(read_file(ref_xml_fname) == read_file(test_xml_fname),
+        "Architecture changes after a round trip of the bundle");
+
+  /* The bundle of another version is rejected */
+  std::string data = read_file(fname);
+  std::string bad_data = data;
+  bad_data[OPENFPGA_ARCH_BUNDLE_VERSION_OFFSET]++;
+  write_file(fname, bad_data);
+  check(openfpga::CMD_EXEC_FATAL_ERROR ==
+          openfpga::read_openfpga_arch_bundle(fname, bundle_arch),
+        "Bundle of another version is accepted");
+
+  /* Another type of file */
+  bad_data = data;
+  bad_data[0] = 'X';
+  write_file(fname, bad_data);
+  check(openfpga::CMD_EXEC_FATAL_ERROR ==
+          openfpga::read_openfpga_arch_bundle(fname, bundle_arch),
+        "File with a wrong magic word is accepted");
+
+  /* Truncated files */
+  for (size_t num_bytes : {size_t(4), data.size() / 4, data.size() / 2,
+                           data.size() - 1}) {
+    write_file(fname, data.substr(0, num_bytes));
+    check(openfpga::CMD_EXEC_FATAL_ERROR ==
+            openfpga::read_openfpga_arch_bundle(fname, bundle_arch),
+          "Truncated bundle is accepted");
+  }
+
+  /* The architecture is not touched by the failed reads */
+  write_xml_openfpga_arch(test_xml_fname.c_str(), bundle_arch);
+  check(read_file(ref_xml_fname) == read_file(test_xml_fname),
+        "Architecture is changed by a rejected bundle");
+
+  /* Missing file */
+  std::remove(fname.c_str());
+  check(openfpga::CMD_EXEC_FATAL_ERROR ==
+          openfpga::read_openfpga_arch_bundle(fname, bundle_arch),
+        "Missing bundle is accepted");
+
+  std::remove(ref_xml_fname.c_str());
+  std::remove(test_xml_fname.c_str());
+}
+
+int main(int argc, const char** argv) {
+  VTR_ASSERT(1 == argc);
+  (void)argv;
+
+  openfpga::Arch openfpga_arch =
+    read_xml_openfpga_arch(OPENFPGA_TEST_ARCH_FILE);
+  VTR_LOG("Parsed %lu circuit models from XML into circuit library.\n",
+          openfpga_arch.circuit_lib.num_models());
+
+  test_data_structures(openfpga_arch);
+  test_bundle_file(openfpga_arch);
+
+  return test_exit_code("Architecture bundle");
+}
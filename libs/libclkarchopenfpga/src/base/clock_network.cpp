@@ -1,6 +1,7 @@
 #include "clock_network.h"
 
 #include <algorithm>
+#include <cstdlib>
 
 #include "openfpga_port_parser.h"
 #include "openfpga_tokenizer.h"
@@ -221,13 +222,10 @@ std::vector<ClockSpineId> ClockNetwork::tree_top_spines(
 
 std::vector<ClockSpineId> ClockNetwork::spines(
   const ClockTreeId& tree_id) const {
-  std::vector<ClockSpineId> ret;
-  for (ClockSpineId spine_id : spine_ids_) {
-    if (spine_parent_trees_[spine_id] == tree_id) {
-      ret.push_back(spine_id);
-    }
+  if (false == valid_tree_id(tree_id)) {
+    return std::vector<ClockSpineId>();
   }
-  return ret;
+  return tree_spines_[tree_id];
 }
 
 std::string ClockNetwork::spine_name(const ClockSpineId& spine_id) const {
@@ -256,37 +254,15 @@ ClockLevelId ClockNetwork::spine_level(const ClockSpineId& spine_id) const {
   return ClockLevelId(spine_levels_[spine_id]);
 }
 
-std::vector<vtr::Point<int>> ClockNetwork::spine_coordinates(
+const std::vector<vtr::Point<int>>& ClockNetwork::spine_coordinates(
   const ClockSpineId& spine_id) const {
-  vtr::Point<int> start_coord = spine_start_point(spine_id);
-  vtr::Point<int> end_coord = spine_end_point(spine_id);
-  std::vector<vtr::Point<int>> coords;
-  if (Direction::INC == spine_direction(spine_id)) {
-    if (CHANX == spine_track_type(spine_id)) {
-      for (int ix = start_coord.x(); ix <= end_coord.x(); ix++) {
-        coords.push_back(vtr::Point<int>(ix, start_coord.y()));
-      }
-    } else {
-      VTR_ASSERT(CHANY == spine_track_type(spine_id));
-      for (int iy = start_coord.y(); iy <= end_coord.y(); iy++) {
-        coords.push_back(vtr::Point<int>(start_coord.x(), iy));
-      }
-    }
-  } else {
-    VTR_ASSERT(Direction::DEC == spine_direction(spine_id));
-    if (CHANX == spine_track_type(spine_id)) {
-      for (int ix = start_coord.x(); ix >= end_coord.x(); ix--) {
-        coords.push_back(vtr::Point<int>(ix, start_coord.y()));
-      }
-    } else {
-      VTR_ASSERT(CHANY == spine_track_type(spine_id));
-      for (int iy = start_coord.y(); iy >= end_coord.y(); iy--) {
-        coords.push_back(vtr::Point<int>(start_coord.x(), iy));
-      }
-    }
+  VTR_ASSERT(valid_spine_id(spine_id));
+  if (is_dirty_) {
+    VTR_LOG_ERROR(
+      "Unable to identify spine coordinates when data is still dirty!\n");
+    exit(1);
   }
-
-  return coords;
+  return spine_coordinates_[spine_id];
 }
 
 std::vector<ClockSwitchPointId> ClockNetwork::spine_switch_points(
@@ -321,46 +297,15 @@ std::vector<std::string> ClockNetwork::tree_taps(
   return tree_taps_[tree_id];
 }
 
-std::vector<std::string> ClockNetwork::tree_flatten_taps(
+const std::vector<std::string>& ClockNetwork::tree_flatten_taps(
   const ClockTreeId& tree_id, const ClockTreePinId& clk_pin_id) const {
   VTR_ASSERT(valid_tree_id(tree_id));
-  std::vector<std::string> flatten_taps;
-  for (const std::string& tap_name : tree_taps_[tree_id]) {
-    StringToken tokenizer(tap_name);
-    std::vector<std::string> pin_tokens = tokenizer.split(".");
-    if (pin_tokens.size() != 2) {
-      VTR_LOG_ERROR("Invalid pin name '%s'. Expect <tile>.<port>\n",
-                    tap_name.c_str());
-      exit(1);
-    }
-    PortParser tile_parser(pin_tokens[0]);
-    BasicPort tile_info = tile_parser.port();
-    PortParser pin_parser(pin_tokens[1]);
-    BasicPort pin_info = pin_parser.port();
-    if (!tile_info.is_valid()) {
-      VTR_LOG_ERROR("Invalid pin name '%s' whose subtile index is not valid\n",
-                    tap_name.c_str());
-      exit(1);
-    }
-    if (!pin_info.is_valid()) {
-      VTR_LOG_ERROR("Invalid pin name '%s' whose pin index is not valid\n",
-                    tap_name.c_str());
-      exit(1);
-    }
-    for (size_t& tile_idx : tile_info.pins()) {
-      std::string flatten_tile_str =
-        tile_info.get_name() + "[" + std::to_string(tile_idx) + "]";
-      for (size_t& pin_idx : pin_info.pins()) {
-        if (pin_idx != size_t(clk_pin_id)) {
-          continue;
-        }
-        std::string flatten_pin_str =
-          pin_info.get_name() + "[" + std::to_string(pin_idx) + "]";
-        flatten_taps.push_back(flatten_tile_str + "." + flatten_pin_str);
-      }
-    }
+  if (is_dirty_) {
+    VTR_LOG_ERROR("Unable to identify tree taps when data is still dirty!\n");
+    exit(1);
   }
-  return flatten_taps;
+  VTR_ASSERT(size_t(clk_pin_id) < tree_flatten_taps_[tree_id].size());
+  return tree_flatten_taps_[tree_id][size_t(clk_pin_id)];
 }
 
 ClockTreeId ClockNetwork::find_tree(const std::string& name) const {
@@ -403,6 +348,7 @@ void ClockNetwork::reserve_spines(const size_t& num_spines) {
   spine_parents_.reserve(num_spines);
   spine_children_.reserve(num_spines);
   spine_parent_trees_.reserve(num_spines);
+  spine_coordinates_.reserve(num_spines);
 }
 
 void ClockNetwork::reserve_trees(const size_t& num_trees) {
@@ -411,6 +357,8 @@ void ClockNetwork::reserve_trees(const size_t& num_trees) {
   tree_widths_.reserve(num_trees);
   tree_top_spines_.reserve(num_trees);
   tree_taps_.reserve(num_trees);
+  tree_flatten_taps_.reserve(num_trees);
+  tree_spines_.reserve(num_trees);
 }
 
 void ClockNetwork::set_default_segment(const RRSegmentId& seg_id) {
@@ -438,7 +386,9 @@ ClockTreeId ClockNetwork::create_tree(const std::string& name, size_t width) {
   tree_widths_.push_back(width);
   tree_depths_.emplace_back();
   tree_taps_.emplace_back();
+  tree_flatten_taps_.emplace_back();
   tree_top_spines_.emplace_back();
+  tree_spines_.emplace_back();
 
   /* Register to fast look-up */
   auto result = tree_name2id_map_.find(name);
@@ -479,6 +429,7 @@ ClockSpineId ClockNetwork::create_spine(const std::string& name) {
   spine_parents_.emplace_back();
   spine_children_.emplace_back();
   spine_parent_trees_.emplace_back();
+  spine_coordinates_.emplace_back();
 
   /* Register to the lookup */
   VTR_ASSERT(valid_spine_id(spine_id));
@@ -499,7 +450,18 @@ void ClockNetwork::set_spine_parent_tree(const ClockSpineId& spine_id,
                                          const ClockTreeId& tree_id) {
   VTR_ASSERT(valid_spine_id(spine_id));
   VTR_ASSERT(valid_tree_id(tree_id));
+  /* Move the spine from the list of its previous tree */
+  ClockTreeId prev_tree_id = spine_parent_trees_[spine_id];
+  if (valid_tree_id(prev_tree_id)) {
+    std::vector<ClockSpineId>& prev_tree_spines = tree_spines_[prev_tree_id];
+    prev_tree_spines.erase(std::lower_bound(
+      prev_tree_spines.begin(), prev_tree_spines.end(), spine_id));
+  }
   spine_parent_trees_[spine_id] = tree_id;
+  std::vector<ClockSpineId>& tree_spines = tree_spines_[tree_id];
+  tree_spines.insert(
+    std::lower_bound(tree_spines.begin(), tree_spines.end(), spine_id),
+    spine_id);
 }
 
 void ClockNetwork::set_spine_start_point(const ClockSpineId& spine_id,
@@ -641,6 +603,12 @@ bool ClockNetwork::link_tree(const ClockTreeId& tree_id) {
   if (!update_spine_attributes(tree_id)) {
     return false;
   }
+  if (!update_spine_coordinates(tree_id)) {
+    return false;
+  }
+  if (!update_tree_flatten_taps(tree_id)) {
+    return false;
+  }
   return true;
 }
 
@@ -690,6 +658,78 @@ bool ClockNetwork::update_spine_attributes(const ClockTreeId& tree_id) {
   return true;
 }
 
+bool ClockNetwork::update_spine_coordinates(const ClockTreeId& tree_id) {
+  for (ClockSpineId spine_id : spines(tree_id)) {
+    std::vector<vtr::Point<int>>& coords = spine_coordinates_[spine_id];
+    coords.clear();
+    /* Spines without valid attributes are reported by validate() */
+    if (((CHANX != spine_track_types_[spine_id]) &&
+         (CHANY != spine_track_types_[spine_id])) ||
+        ((Direction::INC != spine_directions_[spine_id]) &&
+         (Direction::DEC != spine_directions_[spine_id]))) {
+      continue;
+    }
+    vtr::Point<int> start_coord = spine_start_point(spine_id);
+    vtr::Point<int> end_coord = spine_end_point(spine_id);
+    /* Walk from the starting point to the ending point */
+    int step = (Direction::INC == spine_directions_[spine_id]) ? 1 : -1;
+    int step_x = (CHANX == spine_track_types_[spine_id]) ? step : 0;
+    int step_y = (CHANY == spine_track_types_[spine_id]) ? step : 0;
+    size_t num_coords = std::abs(end_coord.x() - start_coord.x()) +
+                        std::abs(end_coord.y() - start_coord.y()) + 1;
+    coords.reserve(num_coords);
+    for (size_t icoord = 0; icoord < num_coords; ++icoord) {
+      coords.push_back(vtr::Point<int>(start_coord.x() + step_x * int(icoord),
+                                       start_coord.y() + step_y * int(icoord)));
+    }
+  }
+  return true;
+}
+
+bool ClockNetwork::update_tree_flatten_taps(const ClockTreeId& tree_id) {
+  std::vector<std::vector<std::string>>& flatten_taps =
+    tree_flatten_taps_[tree_id];
+  flatten_taps.assign(tree_width(tree_id), std::vector<std::string>());
+  for (const std::string& tap_name : tree_taps_[tree_id]) {
+    StringToken tokenizer(tap_name);
+    std::vector<std::string> pin_tokens = tokenizer.split(".");
+    if (pin_tokens.size() != 2) {
+      VTR_LOG_ERROR("Invalid pin name '%s'. Expect <tile>.<port>\n",
+                    tap_name.c_str());
+      exit(1);
+    }
+    PortParser tile_parser(pin_tokens[0]);
+    BasicPort tile_info = tile_parser.port();
+    PortParser pin_parser(pin_tokens[1]);
+    BasicPort pin_info = pin_parser.port();
+    if (!tile_info.is_valid()) {
+      VTR_LOG_ERROR("Invalid pin name '%s' whose subtile index is not valid\n",
+                    tap_name.c_str());
+      exit(1);
+    }
+    if (!pin_info.is_valid()) {
+      VTR_LOG_ERROR("Invalid pin name '%s' whose pin index is not valid\n",
+                    tap_name.c_str());
+      exit(1);
+    }
+    for (const size_t& tile_idx : tile_info.pins()) {
+      std::string flatten_tile_str =
+        tile_info.get_name() + "[" + std::to_string(tile_idx) + "]";
+      for (const size_t& pin_idx : pin_info.pins()) {
+        /* Only the clock pins of the tree can be accessed */
+        if (pin_idx >= flatten_taps.size()) {
+          continue;
+        }
+        std::string flatten_pin_str =
+          pin_info.get_name() + "[" + std::to_string(pin_idx) + "]";
+        flatten_taps[pin_idx].push_back(flatten_tile_str + "." +
+                                        flatten_pin_str);
+      }
+    }
+  }
+  return true;
+}
+
 /************************************************************************
  * Internal invalidators/validators
  ***********************************************************************/
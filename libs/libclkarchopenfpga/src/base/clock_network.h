@@ -7,6 +7,7 @@
 #include <array>
 #include <map>
 #include <string>
+#include <unordered_map>
 
 /* Headers from vtrutil library */
 #include "vtr_geometry.h"
@@ -87,8 +88,9 @@ class ClockNetwork {
   /* Return the level where the spine locates in the multi-layer clock tree
    * structure */
   ClockLevelId spine_level(const ClockSpineId& spine_id) const;
-  /* Return the list of coordinates that a spine will go across */
-  std::vector<vtr::Point<int>> spine_coordinates(
+  /* Return the list of coordinates that a spine will go across, which is
+   * built when linking the clock network */
+  const std::vector<vtr::Point<int>>& spine_coordinates(
     const ClockSpineId& spine_id) const;
   /* Identify the direction of a spine, depending on its starting and ending
    * points
@@ -120,8 +122,9 @@ class ClockNetwork {
   /* Return the list of flatten tap pins. For example: clb[0:1].clk[2:2] is
    * flatten to { clb[0].clk[2], clb[1].clk[2] } Useful to build clock routing
    * resource graph Note that the clk_pin_id limits only 1 clock to be accessed
+   * The list is built when linking the clock network
    */
-  std::vector<std::string> tree_flatten_taps(
+  const std::vector<std::string>& tree_flatten_taps(
     const ClockTreeId& tree_id, const ClockTreePinId& clk_pin_id) const;
   /* Find a spine with a given name, if not found, return an valid id, otherwise
    * return an invalid one */
@@ -221,6 +224,10 @@ class ClockNetwork {
   bool update_tree_depth(const ClockTreeId& tree_id);
   /* Infer track type and directions for each spine by their coordinates */
   bool update_spine_attributes(const ClockTreeId& tree_id);
+  /* Require update_spine_attributes() to called before! */
+  bool update_spine_coordinates(const ClockTreeId& tree_id);
+  /* Parse the tap pins of a tree and flatten them for each clock pin */
+  bool update_tree_flatten_taps(const ClockTreeId& tree_id);
 
  private: /* Internal data */
   /* Basic information of each tree */
@@ -230,6 +237,11 @@ class ClockNetwork {
   vtr::vector<ClockTreeId, size_t> tree_depths_;
   vtr::vector<ClockTreeId, std::vector<ClockSpineId>> tree_top_spines_;
   vtr::vector<ClockTreeId, std::vector<std::string>> tree_taps_;
+  /* Flatten tap pins of each tree, indexed by [tree][clock_pin] */
+  vtr::vector<ClockTreeId, std::vector<std::vector<std::string>>>
+    tree_flatten_taps_;
+  /* Spines of each tree, sorted by id */
+  vtr::vector<ClockTreeId, std::vector<ClockSpineId>> tree_spines_;
 
   /* Basic information of each spine */
   vtr::vector<ClockSpineId, ClockSpineId> spine_ids_;
@@ -244,6 +256,8 @@ class ClockNetwork {
   vtr::vector<ClockSpineId, ClockSpineId> spine_parents_;
   vtr::vector<ClockSpineId, std::vector<ClockSpineId>> spine_children_;
   vtr::vector<ClockSpineId, ClockTreeId> spine_parent_trees_;
+  /* Coordinates that each spine goes across, from its starting point */
+  vtr::vector<ClockSpineId, std::vector<vtr::Point<int>>> spine_coordinates_;
 
   /* Default routing resource */
   std::string default_segment_name_; /* The routing segment representing the
@@ -254,8 +268,8 @@ class ClockNetwork {
   RRSwitchId default_switch_id_;
 
   /* Fast lookup */
-  std::map<std::string, ClockTreeId> tree_name2id_map_;
-  std::map<std::string, ClockSpineId> spine_name2id_map_;
+  std::unordered_map<std::string, ClockTreeId> tree_name2id_map_;
+  std::unordered_map<std::string, ClockSpineId> spine_name2id_map_;
 
   /* Flags */
   mutable bool is_dirty_;
@@ -0,0 +1,64 @@
+#include "rr_clock_routes.h"
+
+#include "vtr_assert.h"
+
+namespace openfpga {  // begin namespace openfpga
+
+RRClockRoutes::RRClockRoutes() {}
+
+bool RRClockRoutes::empty() const { return pin_edges_.empty(); }
+
+bool RRClockRoutes::valid_pin(const ClockTreeId& tree,
+                              const ClockTreePinId& pin) const {
+  return (size_t(tree) < pin_edges_.size()) &&
+         (size_t(pin) < pin_edges_[tree].size());
+}
+
+const std::vector<std::pair<RRNodeId, RRNodeId>>& RRClockRoutes::pin_edges(
+  const ClockTreeId& tree, const ClockTreePinId& pin) const {
+  VTR_ASSERT(valid_pin(tree, pin));
+  return pin_edges_[tree][size_t(pin)];
+}
+
+const std::vector<RRNodeId>& RRClockRoutes::pin_net_nodes(
+  const ClockTreeId& tree, const ClockTreePinId& pin) const {
+  VTR_ASSERT(valid_pin(tree, pin));
+  return pin_net_nodes_[tree][size_t(pin)];
+}
+
+void RRClockRoutes::add_pin_edge(const ClockTreeId& tree,
+                                 const ClockTreePinId& pin,
+                                 const RRNodeId& src_node,
+                                 const RRNodeId& des_node) {
+  VTR_ASSERT(src_node && des_node);
+  resize_routes(tree, pin);
+  pin_edges_[tree][size_t(pin)].emplace_back(src_node, des_node);
+}
+
+void RRClockRoutes::add_pin_net_node(const ClockTreeId& tree,
+                                     const ClockTreePinId& pin,
+                                     const RRNodeId& node) {
+  VTR_ASSERT(node);
+  resize_routes(tree, pin);
+  pin_net_nodes_[tree][size_t(pin)].push_back(node);
+}
+
+void RRClockRoutes::clear() {
+  pin_edges_.clear();
+  pin_net_nodes_.clear();
+}
+
+void RRClockRoutes::resize_routes(const ClockTreeId& tree,
+                                  const ClockTreePinId& pin) {
+  VTR_ASSERT(tree && pin);
+  if (size_t(tree) >= pin_edges_.size()) {
+    pin_edges_.resize(size_t(tree) + 1);
+    pin_net_nodes_.resize(size_t(tree) + 1);
+  }
+  if (size_t(pin) >= pin_edges_[tree].size()) {
+    pin_edges_[tree].resize(size_t(pin) + 1);
+    pin_net_nodes_[tree].resize(size_t(pin) + 1);
+  }
+}
+
+}  // end namespace openfpga
@@ -0,0 +1,95 @@
+#ifndef RR_CLOCK_ROUTES_H
+#define RR_CLOCK_ROUTES_H
+
+/**
+ * @file
+ * @brief This RRClockRoutes class caches the routing of each clock tree pin
+ *        on the clock part of a routing resource graph
+ *
+ * The routing of spine backbones, switch points and taps only depends on the
+ * clock network and the routing resource graph, i.e., the fabric. Only the
+ * nets which are mapped to the clock tree pins differ between designs.
+ * Therefore, the routing is built once and then applied to each design.
+ *
+ * The data structure allows users to
+ *
+ *   - Register the edges and the nodes which are routed for each clock pin
+ *   - Find the edges and the nodes which should be annotated for a clock pin
+ */
+#include <utility>
+#include <vector>
+
+#include "clock_network_fwd.h"
+#include "rr_graph_fwd.h"
+#include "vtr_vector.h"
+
+namespace openfpga {  // begin namespace openfpga
+
+class RRClockRoutes {
+  /* -- Constructors -- */
+ public:
+  /* Explicitly define the only way to create an object */
+  explicit RRClockRoutes();
+
+  /* Disable copy constructors and copy assignment operator, as the routing of
+   * a large clock network could be expensive to copy */
+  RRClockRoutes(const RRClockRoutes&) = delete;
+  void operator=(const RRClockRoutes&) = delete;
+
+  /* -- Accessors -- */
+ public:
+  /** @brief Check if any clock tree has been routed */
+  bool empty() const;
+  /** @brief Check if a clock pin in a clock tree has been routed */
+  bool valid_pin(const ClockTreeId& tree, const ClockTreePinId& pin) const;
+  /**
+   * @brief Returns the routed edges of a clock pin in a clock tree, where each
+   * edge is a pair of (source node, sink node)
+   * @note The clock pin must be valid
+   */
+  const std::vector<std::pair<RRNodeId, RRNodeId>>& pin_edges(
+    const ClockTreeId& tree, const ClockTreePinId& pin) const;
+  /**
+   * @brief Returns the nodes of a clock pin in a clock tree, which should be
+   * annotated with the net mapped to the clock pin
+   * @note The clock pin must be valid
+   */
+  const std::vector<RRNodeId>& pin_net_nodes(const ClockTreeId& tree,
+                                             const ClockTreePinId& pin) const;
+
+  /* -- Mutators -- */
+ public:
+  /**
+   * @brief Register an edge from a source node to a sink node, which is used
+   * by the routing of a clock pin
+   */
+  void add_pin_edge(const ClockTreeId& tree, const ClockTreePinId& pin,
+                    const RRNodeId& src_node, const RRNodeId& des_node);
+  /**
+   * @brief Register a node which should be annotated with the net mapped to a
+   * clock pin
+   */
+  void add_pin_net_node(const ClockTreeId& tree, const ClockTreePinId& pin,
+                        const RRNodeId& node);
+
+  /** @brief Clear all the data inside */
+  void clear();
+
+ private: /* Private mutators */
+  /** @brief Resize the routes upon needs */
+  void resize_routes(const ClockTreeId& tree, const ClockTreePinId& pin);
+
+  /* -- Internal data storage -- */
+ private:
+  /* Routed edges: [tree_id][clock_pin_id][0..num_edges] */
+  vtr::vector<ClockTreeId,
+              std::vector<std::vector<std::pair<RRNodeId, RRNodeId>>>>
+    pin_edges_;
+  /* Nodes carrying the net of clock pins:
+   * [tree_id][clock_pin_id][0..num_nodes] */
+  vtr::vector<ClockTreeId, std::vector<std::vector<RRNodeId>>> pin_net_nodes_;
+};
+
+}  // end namespace openfpga
+
+#endif
@@ -1,11 +1,16 @@
 #include "rr_clock_spatial_lookup.h"
 
+#include <algorithm>
+
 #include "vtr_assert.h"
 #include "vtr_log.h"
 
 namespace openfpga {  // begin namespace openfpga
 
-RRClockSpatialLookup::RRClockSpatialLookup() {}
+/* Number of directions of a clock node: INC and DEC */
+constexpr size_t NUM_CLOCK_NODE_DIRECTIONS = 2;
+
+RRClockSpatialLookup::RRClockSpatialLookup() { clear(); }
 
 RRNodeId RRClockSpatialLookup::find_node(int x, int y, const ClockTreeId& tree,
                                          const ClockLevelId& lvl,
@@ -24,38 +29,46 @@ RRNodeId RRClockSpatialLookup::find_node(int x, int y, const ClockTreeId& tree,
    * range
    * - Return an invalid id if any out-of-range is detected
    */
-  if (size_t(dir) >= rr_node_indices_.size()) {
+  if (dir >= dim_sizes_[5]) {
     VTR_LOG("Direction out of range");
     return RRNodeId::INVALID();
   }
 
-  if (size_t(x) >= rr_node_indices_[dir].dim_size(0)) {
+  if (size_t(x) >= dim_sizes_[0]) {
     VTR_LOG("X out of range");
     return RRNodeId::INVALID();
   }
 
-  if (size_t(y) >= rr_node_indices_[dir].dim_size(1)) {
+  if (size_t(y) >= dim_sizes_[1]) {
     VTR_LOG("Y out of range");
     return RRNodeId::INVALID();
   }
 
-  if (size_t(tree) >= rr_node_indices_[dir][x][y].size()) {
+  if (size_t(tree) >= dim_sizes_[2]) {
     VTR_LOG("Tree id out of range");
     return RRNodeId::INVALID();
   }
 
-  if (size_t(lvl) == rr_node_indices_[dir][x][y][size_t(tree)].size()) {
+  if (size_t(lvl) >= dim_sizes_[3]) {
     VTR_LOG("Level id out of range");
     return RRNodeId::INVALID();
   }
 
-  if (size_t(pin) ==
-      rr_node_indices_[dir][x][y][size_t(tree)][size_t(lvl)].size()) {
+  if (size_t(pin) >= dim_sizes_[4]) {
     VTR_LOG("Pin id out of range");
     return RRNodeId::INVALID();
   }
 
-  return rr_node_indices_[dir][x][y][size_t(tree)][size_t(lvl)][size_t(pin)];
+  return rr_node_indices_[node_index(x, y, size_t(tree), size_t(lvl),
+                                     size_t(pin), dir)];
+}
+
+size_t RRClockSpatialLookup::node_index(const size_t& x, const size_t& y,
+                                        const size_t& tree, const size_t& lvl,
+                                        const size_t& pin,
+                                        const size_t& dir) const {
+  return x * dim_strides_[0] + y * dim_strides_[1] + tree * dim_strides_[2] +
+         lvl * dim_strides_[3] + pin * dim_strides_[4] + dir * dim_strides_[5];
 }
 
 void RRClockSpatialLookup::add_node(RRNodeId node, int x, int y,
@@ -65,69 +78,82 @@ void RRClockSpatialLookup::add_node(RRNodeId node, int x, int y,
                                     const Direction& direction) {
   size_t dir = size_t(direction);
   VTR_ASSERT(node); /* Must have a valid node id to be added */
-  VTR_ASSERT_SAFE(2 == rr_node_indices_[dir].ndims());
-
-  resize_nodes(x, y, direction);
-
-  if (size_t(tree) >= rr_node_indices_[dir][x][y].size()) {
-    rr_node_indices_[dir][x][y].resize(size_t(tree) + 1);
-  }
+  VTR_ASSERT(dir < NUM_CLOCK_NODE_DIRECTIONS);
+  VTR_ASSERT(x >= 0);
+  VTR_ASSERT(y >= 0);
 
-  if (size_t(lvl) >= rr_node_indices_[dir][x][y][size_t(tree)].size()) {
-    rr_node_indices_[dir][x][y][size_t(tree)].resize(size_t(lvl) + 1);
-  }
-
-  if (size_t(pin) >=
-      rr_node_indices_[dir][x][y][size_t(tree)][size_t(lvl)].size()) {
-    rr_node_indices_[dir][x][y][size_t(tree)][size_t(lvl)].resize(size_t(pin) +
-                                                                  1);
-  }
+  resize_nodes(size_t(x), size_t(y), size_t(tree), size_t(lvl), size_t(pin));
 
   /* Resize on demand finished; Register the node */
-  rr_node_indices_[dir][x][y][size_t(tree)][size_t(lvl)][size_t(pin)] = node;
+  rr_node_indices_[node_index(x, y, size_t(tree), size_t(lvl), size_t(pin),
+                              dir)] = node;
 }
 
 void RRClockSpatialLookup::reserve_nodes(int x, int y, int tree, int lvl,
                                          int pin) {
-  for (Direction dir : {Direction::INC, Direction::DEC}) {
-    resize_nodes(x, y, dir);
-    for (int ix = 0; ix < x; ++ix) {
-      for (int iy = 0; iy < y; ++iy) {
-        rr_node_indices_[size_t(dir)][ix][iy].resize(tree);
-        for (int itree = 0; itree < tree; ++itree) {
-          rr_node_indices_[size_t(dir)][ix][iy][itree].resize(lvl);
-          for (int ilvl = 0; ilvl < lvl; ++ilvl) {
-            rr_node_indices_[size_t(dir)][ix][iy][itree][ilvl].resize(pin);
-          }
-        }
-      }
-    }
+  /* Nothing to reserve if any dimension is empty */
+  if ((x <= 0) || (y <= 0) || (tree <= 0) || (lvl <= 0) || (pin <= 0)) {
+    return;
   }
+  resize_nodes(size_t(x) - 1, size_t(y) - 1, size_t(tree) - 1,
+               size_t(lvl) - 1, size_t(pin) - 1);
 }
 
-void RRClockSpatialLookup::resize_nodes(int x, int y,
-                                        const Direction& direction) {
+void RRClockSpatialLookup::resize_nodes(const size_t& x, const size_t& y,
+                                        const size_t& tree, const size_t& lvl,
+                                        const size_t& pin) {
   /* Expand the fast look-up if the new node is out-of-range
    * This may seldom happen because the rr_graph building function
-   * should ensure the fast look-up well organized
+   * should reserve the fast look-up with the maximum sizes
    */
-  size_t dir = size_t(direction);
-  VTR_ASSERT(dir < rr_node_indices_.size());
-  VTR_ASSERT(x >= 0);
-  VTR_ASSERT(y >= 0);
+  std::array<size_t, 6> new_dim_sizes = dim_sizes_;
+  new_dim_sizes[0] = std::max(dim_sizes_[0], x + 1);
+  new_dim_sizes[1] = std::max(dim_sizes_[1], y + 1);
+  new_dim_sizes[2] = std::max(dim_sizes_[2], tree + 1);
+  new_dim_sizes[3] = std::max(dim_sizes_[3], lvl + 1);
+  new_dim_sizes[4] = std::max(dim_sizes_[4], pin + 1);
+  if (new_dim_sizes == dim_sizes_) {
+    return;
+  }
 
-  if ((x >= int(rr_node_indices_[dir].dim_size(0))) ||
-      (y >= int(rr_node_indices_[dir].dim_size(1)))) {
-    rr_node_indices_[dir].resize(
-      {std::max(rr_node_indices_[dir].dim_size(0), size_t(x) + 1),
-       std::max(rr_node_indices_[dir].dim_size(1), size_t(y) + 1)});
+  std::array<size_t, 6> new_dim_strides;
+  new_dim_strides[5] = 1;
+  for (size_t idim = 5; idim > 0; --idim) {
+    new_dim_strides[idim - 1] = new_dim_strides[idim] * new_dim_sizes[idim];
   }
+
+  /* Move the existing nodes to the new layout */
+  std::vector<RRNodeId> new_rr_node_indices(
+    new_dim_strides[0] * new_dim_sizes[0], RRNodeId::INVALID());
+  for (size_t ix = 0; ix < dim_sizes_[0]; ++ix) {
+    for (size_t iy = 0; iy < dim_sizes_[1]; ++iy) {
+      for (size_t itree = 0; itree < dim_sizes_[2]; ++itree) {
+        for (size_t ilvl = 0; ilvl < dim_sizes_[3]; ++ilvl) {
+          for (size_t ipin = 0; ipin < dim_sizes_[4]; ++ipin) {
+            for (size_t idir = 0; idir < dim_sizes_[5]; ++idir) {
+              new_rr_node_indices[ix * new_dim_strides[0] +
+                                  iy * new_dim_strides[1] +
+                                  itree * new_dim_strides[2] +
+                                  ilvl * new_dim_strides[3] +
+                                  ipin * new_dim_strides[4] + idir] =
+                rr_node_indices_[node_index(ix, iy, itree, ilvl, ipin, idir)];
+            }
+          }
+        }
+      }
+    }
+  }
+  rr_node_indices_.swap(new_rr_node_indices);
+  dim_sizes_ = new_dim_sizes;
+  dim_strides_ = new_dim_strides;
 }
 
 void RRClockSpatialLookup::clear() {
-  for (auto& data : rr_node_indices_) {
-    data.clear();
-  }
+  rr_node_indices_.clear();
+  dim_sizes_.fill(0);
+  /* The direction dimension is always complete */
+  dim_sizes_[5] = NUM_CLOCK_NODE_DIRECTIONS;
+  dim_strides_.fill(0);
 }
 
 }  // end namespace openfpga
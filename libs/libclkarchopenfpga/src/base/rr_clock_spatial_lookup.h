@@ -16,6 +16,9 @@
  *   - Update the look-up with new nodes
  *   - Find the id of a node with given information, e.g., x, y, type etc.
  */
+#include <array>
+#include <vector>
+
 #include "clock_network_fwd.h"
 #include "physical_types.h"
 #include "rr_graph_fwd.h"
@@ -94,18 +97,29 @@ class RRClockSpatialLookup {
   /** @brief Clear all the data inside */
   void clear();
 
+ private: /* Private accessors */
+  /** @brief Index of a node in the flat storage. Inputs must be in range */
+  size_t node_index(const size_t& x, const size_t& y, const size_t& tree,
+                    const size_t& lvl, const size_t& pin,
+                    const size_t& dir) const;
+
  private: /* Private mutators */
-  /** @brief Resize the nodes upon needs */
-  void resize_nodes(int x, int y, const Direction& direction);
+  /** @brief Resize the nodes upon needs, where existing nodes are kept */
+  void resize_nodes(const size_t& x, const size_t& y, const size_t& tree,
+                    const size_t& lvl, const size_t& pin);
 
   /* -- Internal data storage -- */
  private:
-  /* Fast look-up:
-   * [INC|DEC][0..grid_width][0..grid_height][tree_id][level_id][clock_pin_id]
+  /* Fast look-up, which is flattened into a single array:
+   * [0..grid_width][0..grid_height][tree_id][level_id][clock_pin_id][INC|DEC]
+   * Each dimension has a fixed size, which is the maximum size required by any
+   * node, so that the index of a node can be computed with the strides below
    */
-  std::array<vtr::NdMatrix<std::vector<std::vector<std::vector<RRNodeId>>>, 2>,
-             2>
-    rr_node_indices_;
+  std::vector<RRNodeId> rr_node_indices_;
+  /* Size of each dimension: [x, y, tree, level, pin, direction] */
+  std::array<size_t, 6> dim_sizes_;
+  /* Number of nodes between two neighbouring indices in each dimension */
+  std::array<size_t, 6> dim_strides_;
 };
 
 }  // end namespace openfpga
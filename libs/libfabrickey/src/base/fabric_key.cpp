@@ -2,6 +2,7 @@
 
 #include <algorithm>
 
+#include "openfpga_binary_io.h"
 #include "vtr_assert.h"
 #include "vtr_log.h"
 
@@ -46,7 +47,7 @@ FabricKey::fabric_key_module_range FabricKey::modules() const {
                          sub_key_module_ids_.end());
 }
 
-std::vector<FabricSubKeyId> FabricKey::sub_keys(
+const std::vector<FabricSubKeyId>& FabricKey::sub_keys(
   const FabricKeyModuleId& module_id) const {
   VTR_ASSERT(valid_module_id(module_id));
   return module_sub_keys_[module_id];
@@ -84,14 +85,14 @@ std::vector<FabricKeyId> FabricKey::find_key_by_alias(
   return found_keys;
 }
 
-std::vector<FabricKeyId> FabricKey::region_keys(
+const std::vector<FabricKeyId>& FabricKey::region_keys(
   const FabricRegionId& region_id) const {
   /* validate the region_id */
   VTR_ASSERT(valid_region_id(region_id));
   return region_key_ids_[region_id];
 }
 
-std::string FabricKey::key_name(const FabricKeyId& key_id) const {
+const std::string& FabricKey::key_name(const FabricKeyId& key_id) const {
   /* validate the key_id */
   VTR_ASSERT(valid_key_id(key_id));
   return key_names_[key_id];
@@ -103,7 +104,7 @@ size_t FabricKey::key_value(const FabricKeyId& key_id) const {
   return key_values_[key_id];
 }
 
-std::string FabricKey::key_alias(const FabricKeyId& key_id) const {
+const std::string& FabricKey::key_alias(const FabricKeyId& key_id) const {
   /* validate the key_id */
   VTR_ASSERT(valid_key_id(key_id));
   return key_alias_[key_id];
@@ -129,12 +130,14 @@ std::vector<openfpga::BasicPort> FabricKey::wl_bank_data_ports(
   return wl_bank_data_ports_[region_id][bank_id];
 }
 
-std::string FabricKey::module_name(const FabricKeyModuleId& module_id) const {
+const std::string& FabricKey::module_name(
+  const FabricKeyModuleId& module_id) const {
   VTR_ASSERT(valid_module_id(module_id));
   return sub_key_module_names_[module_id];
 }
 
-std::string FabricKey::sub_key_name(const FabricSubKeyId& key_id) const {
+const std::string& FabricKey::sub_key_name(
+  const FabricSubKeyId& key_id) const {
   /* validate the key_id */
   VTR_ASSERT(valid_sub_key_id(key_id));
   return sub_key_names_[key_id];
@@ -146,7 +149,8 @@ size_t FabricKey::sub_key_value(const FabricSubKeyId& key_id) const {
   return sub_key_values_[key_id];
 }
 
-std::string FabricKey::sub_key_alias(const FabricSubKeyId& key_id) const {
+const std::string& FabricKey::sub_key_alias(
+  const FabricSubKeyId& key_id) const {
   /* validate the key_id */
   VTR_ASSERT(valid_sub_key_id(key_id));
   return sub_key_alias_[key_id];
@@ -437,4 +441,77 @@ bool FabricKey::valid_sub_key_id(const FabricSubKeyId& sub_key_id) const {
          (sub_key_id == sub_key_ids_[sub_key_id]);
 }
 
+/************************************************************************
+ * Public serializers
+ * Names of keys mostly repeat the names of a few modules, so they are
+ * written as string tables. Coordinates are flattened to plain integers,
+ * so that each array of keys is written in one shot
+ ***********************************************************************/
+void FabricKey::write_binary(std::ostream& fp) const {
+  write_binary_data(fp, region_ids_);
+  write_binary_data(fp, region_key_ids_);
+
+  write_binary_data(fp, key_ids_);
+  write_binary_string_table(fp, key_names_);
+  write_binary_data(fp, key_values_);
+  std::vector<int> key_coordinates;
+  key_coordinates.reserve(2 * key_coordinates_.size());
+  for (const vtr::Point<int>& coord : key_coordinates_) {
+    key_coordinates.push_back(coord.x());
+    key_coordinates.push_back(coord.y());
+  }
+  write_binary_data(fp, key_coordinates);
+  write_binary_data(fp, key_regions_);
+  write_binary_string_table(fp, key_alias_);
+
+  write_binary_data(fp, bl_bank_ids_);
+  write_binary_data(fp, bl_bank_data_ports_);
+  write_binary_data(fp, wl_bank_ids_);
+  write_binary_data(fp, wl_bank_data_ports_);
+
+  write_binary_data(fp, sub_key_module_ids_);
+  write_binary_data(fp, sub_key_module_names_);
+  write_binary_data(fp, module_sub_keys_);
+  write_binary_data(fp, module2subkey_lookup_);
+
+  write_binary_data(fp, sub_key_ids_);
+  write_binary_string_table(fp, sub_key_names_);
+  write_binary_data(fp, sub_key_values_);
+  write_binary_string_table(fp, sub_key_alias_);
+}
+
+void FabricKey::read_binary(std::istream& fp) {
+  read_binary_data(fp, region_ids_);
+  read_binary_data(fp, region_key_ids_);
+
+  read_binary_data(fp, key_ids_);
+  read_binary_string_table(fp, key_names_);
+  read_binary_data(fp, key_values_);
+  std::vector<int> key_coordinates;
+  read_binary_data(fp, key_coordinates);
+  key_coordinates_.clear();
+  key_coordinates_.reserve(key_coordinates.size() / 2);
+  for (size_t icoord = 0; icoord + 1 < key_coordinates.size(); icoord += 2) {
+    key_coordinates_.emplace_back(key_coordinates[icoord],
+                                  key_coordinates[icoord + 1]);
+  }
+  read_binary_data(fp, key_regions_);
+  read_binary_string_table(fp, key_alias_);
+
+  read_binary_data(fp, bl_bank_ids_);
+  read_binary_data(fp, bl_bank_data_ports_);
+  read_binary_data(fp, wl_bank_ids_);
+  read_binary_data(fp, wl_bank_data_ports_);
+
+  read_binary_data(fp, sub_key_module_ids_);
+  read_binary_data(fp, sub_key_module_names_);
+  read_binary_data(fp, module_sub_keys_);
+  read_binary_data(fp, module2subkey_lookup_);
+
+  read_binary_data(fp, sub_key_ids_);
+  read_binary_string_table(fp, sub_key_names_);
+  read_binary_data(fp, sub_key_values_);
+  read_binary_string_table(fp, sub_key_alias_);
+}
+
 }  // End of namespace openfpga
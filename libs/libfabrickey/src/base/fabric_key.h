@@ -5,6 +5,7 @@
  * This file include the declaration of fabric key
  *******************************************************************/
 #include <array>
+#include <iosfwd>
 #include <map>
 #include <string>
 
@@ -71,20 +72,21 @@ class FabricKey {
   fabric_bit_line_bank_range bl_banks(const FabricRegionId& region_id) const;
   fabric_word_line_bank_range wl_banks(const FabricRegionId& region_id) const;
   fabric_key_module_range modules() const;
-  std::vector<FabricSubKeyId> sub_keys(
+  const std::vector<FabricSubKeyId>& sub_keys(
     const FabricKeyModuleId& module_id) const;
 
  public: /* Public Accessors: Basic data query */
   size_t num_regions() const;
   size_t num_keys() const;
   /* Access all the keys of a region */
-  std::vector<FabricKeyId> region_keys(const FabricRegionId& region_id) const;
+  const std::vector<FabricKeyId>& region_keys(
+    const FabricRegionId& region_id) const;
   /* Access the name of a key */
-  std::string key_name(const FabricKeyId& key_id) const;
+  const std::string& key_name(const FabricKeyId& key_id) const;
   /* Access the value of a key */
   size_t key_value(const FabricKeyId& key_id) const;
   /* Access the alias of a key */
-  std::string key_alias(const FabricKeyId& key_id) const;
+  const std::string& key_alias(const FabricKeyId& key_id) const;
   /* Access the coordinate of a key */
   vtr::Point<int> key_coordinate(const FabricKeyId& key_id) const;
 
@@ -107,10 +109,10 @@ class FabricKey {
   std::vector<BasicPort> wl_bank_data_ports(
     const FabricRegionId& region_id, const FabricWordLineBankId& bank_id) const;
 
-  std::string module_name(const FabricKeyModuleId& module_id) const;
-  std::string sub_key_name(const FabricSubKeyId& key_id) const;
+  const std::string& module_name(const FabricKeyModuleId& module_id) const;
+  const std::string& sub_key_name(const FabricSubKeyId& key_id) const;
   size_t sub_key_value(const FabricSubKeyId& key_id) const;
-  std::string sub_key_alias(const FabricSubKeyId& key_id) const;
+  const std::string& sub_key_alias(const FabricSubKeyId& key_id) const;
 
  public: /* Public Mutators: model-related */
   /* Reserve a number of regions to be memory efficent */
@@ -189,6 +191,13 @@ class FabricKey {
   bool valid_module_id(const FabricKeyModuleId& module_id) const;
   bool valid_sub_key_id(const FabricSubKeyId& sub_key_id) const;
 
+ public: /* Public serializers */
+  /* Dump the content to a binary stream */
+  void write_binary(std::ostream& fp) const;
+  /* Replace the content by the one loaded from a binary stream, which is
+   * created by write_binary() */
+  void read_binary(std::istream& fp);
+
  private: /* Internal data */
   /* ---- Top-level keys and regions ---- */
   /* Unique ids for each region */
@@ -0,0 +1,18 @@
+#ifndef FABRIC_KEY_BIN_CONSTANTS_H
+#define FABRIC_KEY_BIN_CONSTANTS_H
+
+#include <cstddef>
+#include <cstdint>
+
+namespace openfpga {  // Begin namespace openfpga
+
+/* Constants required by binary reader and writer: the magic word identifies
+ * the type of file, and the version should be changed whenever the layout of
+ * the fabric key changes */
+constexpr char BIN_FABRIC_KEY_MAGIC[] = "OFPGAFKB";
+constexpr size_t BIN_FABRIC_KEY_MAGIC_SIZE = sizeof(BIN_FABRIC_KEY_MAGIC) - 1;
+constexpr uint32_t BIN_FABRIC_KEY_VERSION = 1;
+
+}  // End of namespace openfpga
+
+#endif
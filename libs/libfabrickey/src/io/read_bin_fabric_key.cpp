@@ -0,0 +1,90 @@
+/********************************************************************
+ * This file includes the functions to read a fabric key from a binary
+ * file, which is created by write_bin_fabric_key()
+ *******************************************************************/
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <utility>
+
+/* Headers from vtr util library */
+#include "vtr_log.h"
+#include "vtr_time.h"
+
+/* Headers from openfpga util library */
+#include "openfpga_binary_io.h"
+
+/* Headers from fabrickey library */
+#include "fabric_key_bin_constants.h"
+#include "read_bin_fabric_key.h"
+
+namespace openfpga {  // Begin namespace openfpga
+
+/********************************************************************
+ * Check if a file starts with the magic word of binary fabric keys, so
+ * that a fabric key can be loaded whatever its format is
+ *******************************************************************/
+bool is_bin_fabric_key_file(const char* key_fname) {
+  std::ifstream fp(key_fname, std::ifstream::binary);
+  char magic[BIN_FABRIC_KEY_MAGIC_SIZE];
+  fp.read(magic, BIN_FABRIC_KEY_MAGIC_SIZE);
+  return (true == fp.good()) &&
+         (0 == std::memcmp(magic, BIN_FABRIC_KEY_MAGIC,
+                           BIN_FABRIC_KEY_MAGIC_SIZE));
+}
+
+/********************************************************************
+ * Read a fabric key from a binary file.
+ * The fabric key is not touched unless the whole file is loaded.
+ *
+ * Return 0 if successful
+ * Return 1 if the file does not exist, is created by another version or is
+ * corrupted
+ *******************************************************************/
+int read_bin_fabric_key(const char* key_fname, FabricKey& fabric_key) {
+  vtr::ScopedStartFinishTimer timer("Read Fabric Key in binary format");
+
+  std::ifstream fp(key_fname, std::ifstream::binary);
+  if (false == fp.is_open()) {
+    VTR_LOG_ERROR("Fabric key '%s' does not exist!\n", key_fname);
+    return 1;
+  }
+
+  /* Read the header */
+  char magic[BIN_FABRIC_KEY_MAGIC_SIZE];
+  uint32_t version = 0;
+  fp.read(magic, BIN_FABRIC_KEY_MAGIC_SIZE);
+  read_binary_data(fp, version);
+  if ((false == fp.good()) ||
+      (0 != std::memcmp(magic, BIN_FABRIC_KEY_MAGIC,
+                        BIN_FABRIC_KEY_MAGIC_SIZE))) {
+    VTR_LOG_ERROR("File '%s' is not a binary fabric key!\n", key_fname);
+    return 1;
+  }
+  if (BIN_FABRIC_KEY_VERSION != version) {
+    VTR_LOG_ERROR(
+      "Binary fabric key '%s' has version %u while version %u is expected! "
+      "Please write the fabric key again.\n",
+      key_fname, version, BIN_FABRIC_KEY_VERSION);
+    return 1;
+  }
+
+  /* Read the keys */
+  FabricKey bin_fabric_key;
+  bin_fabric_key.read_binary(fp);
+  if (false == fp.good()) {
+    VTR_LOG_ERROR("Binary fabric key '%s' is corrupted!\n", key_fname);
+    return 1;
+  }
+  /* Nothing should remain in the file */
+  if (std::ifstream::traits_type::eof() != fp.peek()) {
+    VTR_LOG_ERROR("Binary fabric key '%s' is corrupted!\n", key_fname);
+    return 1;
+  }
+
+  fabric_key = std::move(bin_fabric_key);
+
+  return 0;
+}
+
+}  // End of namespace openfpga
@@ -0,0 +1,21 @@
+#ifndef READ_BIN_FABRIC_KEY_H
+#define READ_BIN_FABRIC_KEY_H
+
+/********************************************************************
+ * Include header files that are required by function declaration
+ *******************************************************************/
+#include "fabric_key.h"
+
+/********************************************************************
+ * Function declaration
+ *******************************************************************/
+
+namespace openfpga {  // Begin namespace openfpga
+
+bool is_bin_fabric_key_file(const char* key_fname);
+
+int read_bin_fabric_key(const char* key_fname, FabricKey& fabric_key);
+
+}  // End of namespace openfpga
+
+#endif
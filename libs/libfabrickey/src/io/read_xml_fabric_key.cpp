@@ -38,14 +38,16 @@ static void read_xml_module_key(pugi::xml_node& xml_component_key,
                             XML_FABRIC_KEY_KEY_ATTRIBUTE_ID_NAME, loc_data)
                 .as_int();
 
-  FabricSubKeyId sub_key_id = fabric_key.sub_keys(module_id)[id];
-
-  if (false == fabric_key.valid_sub_key_id(sub_key_id)) {
+  const std::vector<FabricSubKeyId>& module_sub_keys =
+    fabric_key.sub_keys(module_id);
+  if (id >= module_sub_keys.size()) {
     archfpga_throw(loc_data.filename_c_str(), loc_data.line(xml_component_key),
                    "Invalid 'id' attribute '%d' (in total %lu keys)!\n", id,
-                   fabric_key.sub_keys(module_id).size());
+                   module_sub_keys.size());
   }
 
+  FabricSubKeyId sub_key_id = module_sub_keys[id];
+
   VTR_ASSERT_SAFE(true == fabric_key.valid_sub_key_id(sub_key_id));
 
   /* If we have an alias, set the value as well */
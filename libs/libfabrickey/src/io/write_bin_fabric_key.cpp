@@ -0,0 +1,65 @@
+/********************************************************************
+ * This file includes functions that outputs a fabric key to a binary
+ * file, which can be loaded much faster than the XML format.
+ *
+ * The file contains a header, i.e., a magic word and the format version,
+ * followed by the content of the fabric key (see FabricKey::write_binary()).
+ * The binary layout depends on the platform, so a binary fabric key is only
+ * meant to be read by the same build of OpenFPGA.
+ *******************************************************************/
+/* Headers from system goes first */
+#include <fstream>
+#include <string>
+
+/* Headers from vtr util library */
+#include "vtr_log.h"
+#include "vtr_time.h"
+
+/* Headers from openfpga util library */
+#include "openfpga_binary_io.h"
+#include "openfpga_digest.h"
+
+/* Headers from fabrickey library */
+#include "fabric_key_bin_constants.h"
+#include "write_bin_fabric_key.h"
+
+namespace openfpga {  // Begin namespace openfpga
+
+/********************************************************************
+ * A writer to output a fabric key to a binary file
+ *
+ * Return 0 if successful
+ * Return 2 if fail when creating files
+ *******************************************************************/
+int write_bin_fabric_key(const char* fname, const FabricKey& fabric_key) {
+  vtr::ScopedStartFinishTimer timer("Write Fabric Key in binary format");
+
+  /* Create a file handler */
+  std::fstream fp;
+  /* Open the file stream */
+  fp.open(std::string(fname),
+          std::fstream::out | std::fstream::trunc | std::fstream::binary);
+
+  /* Validate the file stream */
+  openfpga::check_file_stream(fname, fp);
+
+  /* Write the header */
+  fp.write(BIN_FABRIC_KEY_MAGIC, BIN_FABRIC_KEY_MAGIC_SIZE);
+  write_binary_data(fp, BIN_FABRIC_KEY_VERSION);
+
+  /* Write the keys */
+  fabric_key.write_binary(fp);
+
+  if (false == fp.good()) {
+    VTR_LOG_ERROR("Fail to write fabric key to binary file '%s'!\n", fname);
+    fp.close();
+    return 2;
+  }
+
+  /* Close the file stream */
+  fp.close();
+
+  return 0;
+}
+
+}  // End of namespace openfpga
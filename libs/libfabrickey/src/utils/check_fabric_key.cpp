@@ -7,6 +7,11 @@
  ***********************************************************************/
 #include "check_fabric_key.h"
 
+#include <algorithm>
+#include <string_view>
+#include <tuple>
+#include <unordered_map>
+
 #include "vtr_assert.h"
 #include "vtr_log.h"
 
@@ -23,10 +28,11 @@ int check_fabric_key_alias(const FabricKey& input_key, const bool& verbose) {
   float progress = 0.;
   size_t num_keys_checked = 0;
 
-  std::map<std::string, size_t> alias_count;
+  /* Group the keys by alias in a single pass */
+  std::unordered_map<std::string_view, std::vector<FabricKeyId>> alias_keys;
+  alias_keys.reserve(input_key.num_keys());
   for (FabricKeyId key_id : input_key.keys()) {
-    /* Note that this is slow. May consider to build a map first */
-    std::string curr_alias = input_key.key_alias(key_id);
+    const std::string& curr_alias = input_key.key_alias(key_id);
     progress = static_cast<float>(num_keys_checked) /
                static_cast<float>(input_key.num_keys()) * 100.0;
     VTR_LOGV(verbose, "[%lu%] Checking key alias '%s'\r", size_t(progress),
@@ -37,30 +43,31 @@ int check_fabric_key_alias(const FabricKey& input_key, const bool& verbose) {
         size_t(key_id));
       num_errors++;
     }
-    auto result = alias_count.find(curr_alias);
-    if (result == alias_count.end()) {
-      alias_count[curr_alias] = 0;
-    } else {
-      alias_count[curr_alias] += 1;
-    }
+    alias_keys[curr_alias].push_back(key_id);
     num_keys_checked++;
   }
-  for (const auto& kv : alias_count) {
-    if (kv.second > 1) {
-      std::string key_id_str;
-      std::vector<FabricKeyId> found_keys =
-        input_key.find_key_by_alias(kv.first);
-      for (FabricKeyId found_key_id : found_keys) {
-        key_id_str += std::to_string(size_t(found_key_id)) + ",";
-      }
-      key_id_str.pop_back(); /* Remove last comma */
-      VTR_LOG_ERROR(
-        "Duplicated key alias '%s' found %lu times in keys (ids: %s), which is "
-        "invalid!\n",
-        kv.first.c_str(), kv.second, key_id_str.c_str());
-      num_errors++;
+
+  /* Report the duplicated alias in alphabetical order */
+  std::vector<std::string_view> duplicated_alias;
+  for (const auto& kv : alias_keys) {
+    if (kv.second.size() > 1) {
+      duplicated_alias.push_back(kv.first);
     }
   }
+  std::sort(duplicated_alias.begin(), duplicated_alias.end());
+  for (const std::string_view& curr_alias : duplicated_alias) {
+    const std::vector<FabricKeyId>& found_keys = alias_keys.at(curr_alias);
+    std::string key_id_str;
+    for (FabricKeyId found_key_id : found_keys) {
+      key_id_str += std::to_string(size_t(found_key_id)) + ",";
+    }
+    key_id_str.pop_back(); /* Remove last comma */
+    VTR_LOG_ERROR(
+      "Duplicated key alias '%s' found %lu times in keys (ids: %s), which is "
+      "invalid!\n",
+      std::string(curr_alias).c_str(), found_keys.size(), key_id_str.c_str());
+    num_errors++;
+  }
 
   return num_errors;
 }
@@ -76,10 +83,11 @@ int check_fabric_key_names_and_values(const FabricKey& input_key,
   float progress = 0.;
   size_t num_keys_checked = 0;
 
-  std::map<std::string, std::map<size_t, size_t>> key_value_count;
+  /* Count the keys of each name and value pair in a single pass */
+  std::unordered_map<std::string_view, std::unordered_map<size_t, size_t>>
+    key_value_count;
   for (FabricKeyId key_id : input_key.keys()) {
-    /* Note that this is slow. May consider to build a map first */
-    std::string curr_name = input_key.key_name(key_id);
+    const std::string& curr_name = input_key.key_name(key_id);
     size_t curr_value = input_key.key_value(key_id);
     progress = static_cast<float>(num_keys_checked) /
                static_cast<float>(input_key.num_keys()) * 100.0;
@@ -91,25 +99,29 @@ int check_fabric_key_names_and_values(const FabricKey& input_key,
         size_t(key_id));
       num_errors++;
     }
-    auto result = key_value_count[curr_name].find(curr_value);
-    if (result == key_value_count[curr_name].end()) {
-      key_value_count[curr_name][curr_value] = 0;
-    } else {
-      key_value_count[curr_name][curr_value] += 1;
-    }
+    key_value_count[curr_name][curr_value]++;
     num_keys_checked++;
   }
+
+  /* Report the duplicated pairs in alphabetical order */
+  std::vector<std::tuple<std::string_view, size_t, size_t>> duplicated_keys;
   for (const auto& key_name_kv : key_value_count) {
     for (const auto& key_value_kv : key_name_kv.second) {
       if (key_value_kv.second > 1) {
-        VTR_LOG_ERROR(
-          "Duplicated key name and value pair (%s, %lu) found %lu times in "
-          "keys, which is invalid!\n",
-          key_name_kv.first.c_str(), key_value_kv.first, key_value_kv.second);
-        num_errors++;
+        duplicated_keys.emplace_back(key_name_kv.first, key_value_kv.first,
+                                     key_value_kv.second);
       }
     }
   }
+  std::sort(duplicated_keys.begin(), duplicated_keys.end());
+  for (const auto& duplicated_key : duplicated_keys) {
+    VTR_LOG_ERROR(
+      "Duplicated key name and value pair (%s, %lu) found %lu times in "
+      "keys, which is invalid!\n",
+      std::string(std::get<0>(duplicated_key)).c_str(),
+      std::get<1>(duplicated_key), std::get<2>(duplicated_key));
+    num_errors++;
+  }
 
   return num_errors;
 }
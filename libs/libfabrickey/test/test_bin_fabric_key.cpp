@@ -0,0 +1,164 @@
+/********************************************************************
+ * Unit test functions to validate the binary format of fabric keys
+ * 1. a fabric key is written, read back and written again, which should
+ *    result in the same fabric key and the same bytes
+ * 2. a truncated file or a file of another version is rejected, without
+ *    touching the fabric key
+ *******************************************************************/
+#include <cstdio>
+#include <string>
+
+/* Headers from vtrutils */
+#include "vtr_assert.h"
+#include "vtr_log.h"
+
+/* Headers from fabric key */
+#include "fabric_key_bin_constants.h"
+#include "read_bin_fabric_key.h"
+#include "write_bin_fabric_key.h"
+
+/* Headers shared by the unit tests */
+#include "openfpga_test_utils.h"
+
+/********************************************************************
+ * Build a fabric key with two regions of keys, shift register banks
+ * and a module of sub keys
+ *******************************************************************/
+static openfpga::FabricKey build_test_fabric_key() {
+  openfpga::FabricKey fabric_key;
+  for (size_t iregion = 0; iregion < 2; ++iregion) {
+    openfpga::FabricRegionId region = fabric_key.create_region();
+    for (size_t ikey = 0; ikey < 3; ++ikey) {
+      openfpga::FabricKeyId key = fabric_key.create_key();
+      fabric_key.set_key_name(key, "grid_clb");
+      fabric_key.set_key_value(key, iregion * 3 + ikey);
+      fabric_key.set_key_alias(key, "grid_clb_" + std::to_string(iregion) +
+                                      "_" + std::to_string(ikey));
+      fabric_key.set_key_coordinate(key,
+                                    vtr::Point<int>(int(ikey) + 1, iregion));
+      fabric_key.add_key_to_region(region, key);
+    }
+    openfpga::FabricBitLineBankId bl_bank =
+      fabric_key.create_bl_shift_register_bank(region);
+    fabric_key.add_data_port_to_bl_shift_register_bank(
+      region, bl_bank, openfpga::BasicPort("bl", 0, 3));
+    openfpga::FabricWordLineBankId wl_bank =
+      fabric_key.create_wl_shift_register_bank(region);
+    fabric_key.add_data_port_to_wl_shift_register_bank(
+      region, wl_bank, openfpga::BasicPort("wl", 2, 5));
+  }
+  openfpga::FabricKeyModuleId module = fabric_key.create_module("tile_0_");
+  for (size_t ikey = 0; ikey < 2; ++ikey) {
+    openfpga::FabricSubKeyId sub_key = fabric_key.create_module_key(module);
+    fabric_key.set_sub_key_name(sub_key, "cbx_1__0_");
+    fabric_key.set_sub_key_value(sub_key, ikey);
+    fabric_key.set_sub_key_alias(sub_key, "cbx_" + std::to_string(ikey));
+  }
+  return fabric_key;
+}
+
+static void check_same_fabric_key(const openfpga::FabricKey& ref,
+                                  const openfpga::FabricKey& test) {
+  check(ref.num_keys() == test.num_keys(), "Mismatch in number of keys");
+  check(ref.num_regions() == test.num_regions(),
+        "Mismatch in number of regions");
+  if ((ref.num_keys() != test.num_keys()) ||
+      (ref.num_regions() != test.num_regions())) {
+    return;
+  }
+  for (const openfpga::FabricKeyId& key : ref.keys()) {
+    check(ref.key_name(key) == test.key_name(key), "Mismatch in key name");
+    check(ref.key_value(key) == test.key_value(key), "Mismatch in key value");
+    check(ref.key_alias(key) == test.key_alias(key), "Mismatch in key alias");
+    check(ref.key_coordinate(key) == test.key_coordinate(key),
+          "Mismatch in key coordinate");
+  }
+  for (const openfpga::FabricRegionId& region : ref.regions()) {
+    check(ref.region_keys(region) == test.region_keys(region),
+          "Mismatch in keys of region");
+    for (const openfpga::FabricBitLineBankId& bank : ref.bl_banks(region)) {
+      check(ref.bl_bank_data_ports(region, bank) ==
+              test.bl_bank_data_ports(region, bank),
+            "Mismatch in BL bank");
+    }
+    for (const openfpga::FabricWordLineBankId& bank : ref.wl_banks(region)) {
+      check(ref.wl_bank_data_ports(region, bank) ==
+              test.wl_bank_data_ports(region, bank),
+            "Mismatch in WL bank");
+    }
+  }
+  for (const openfpga::FabricKeyModuleId& module : ref.modules()) {
+    check(ref.module_name(module) == test.module_name(module),
+          "Mismatch in module name");
+    check(ref.sub_keys(module) == test.sub_keys(module),
+          "Mismatch in sub keys of module");
+    for (const openfpga::FabricSubKeyId& sub_key : ref.sub_keys(module)) {
+      check(ref.sub_key_name(sub_key) == test.sub_key_name(sub_key),
+            "Mismatch in sub key name");
+      check(ref.sub_key_value(sub_key) == test.sub_key_value(sub_key),
+            "Mismatch in sub key value");
+      check(ref.sub_key_alias(sub_key) == test.sub_key_alias(sub_key),
+            "Mismatch in sub key alias");
+    }
+  }
+}
+
+int main(int argc, const char** argv) {
+  VTR_ASSERT(1 == argc);
+  (void)argv;
+
+  std::string fname("test_bin_fabric_key.bin");
+  std::string bad_fname("test_bin_fabric_key_bad.bin");
+
+  /* Write and read back */
+  openfpga::FabricKey ref = build_test_fabric_key();
+  check(0 == openfpga::write_bin_fabric_key(fname.c_str(), ref),
+        "Fail to write binary fabric key");
+  check(true == openfpga::is_bin_fabric_key_file(fname.c_str()),
+        "Binary fabric key is not recognized");
+  openfpga::FabricKey test;
+  check(0 == openfpga::read_bin_fabric_key(fname.c_str(), test),
+        "Fail to read binary fabric key");
+  check_same_fabric_key(ref, test);
+  check(0 == openfpga::write_bin_fabric_key(bad_fname.c_str(), test),
+        "Fail to write binary fabric key again");
+  std::string data = read_file(fname);
+  check(data == read_file(bad_fname), "Mismatch in rewritten binary file");
+
+  /* Another version of the file */
+  std::string bad_data = data;
+  bad_data[openfpga::BIN_FABRIC_KEY_MAGIC_SIZE]++;
+  write_file(bad_fname, bad_data);
+  check(0 != openfpga::read_bin_fabric_key(bad_fname.c_str(), test),
+        "Fabric key of another version is accepted");
+
+  /* Another type of file */
+  bad_data = data;
+  bad_data[0] = 'X';
+  write_file(bad_fname, bad_data);
+  check(false == openfpga::is_bin_fabric_key_file(bad_fname.c_str()),
+        "File with a wrong magic word is recognized");
+  check(0 != openfpga::read_bin_fabric_key(bad_fname.c_str(), test),
+        "File with a wrong magic word is accepted");
+
+  /* Truncated files and files with trailing bytes */
+  for (size_t num_bytes : {size_t(4), data.size() / 2, data.size() - 1}) {
+    write_file(bad_fname, data.substr(0, num_bytes));
+    check(0 != openfpga::read_bin_fabric_key(bad_fname.c_str(), test),
+          "Truncated fabric key is accepted");
+  }
+  write_file(bad_fname, data + "x");
+  check(0 != openfpga::read_bin_fabric_key(bad_fname.c_str(), test),
+        "Fabric key with trailing bytes is accepted");
+
+  /* The fabric key is not touched by the failed reads */
+  check_same_fabric_key(ref, test);
+
+  /* Missing file */
+  std::remove(fname.c_str());
+  std::remove(bad_fname.c_str());
+  check(0 != openfpga::read_bin_fabric_key(fname.c_str(), test),
+        "Missing fabric key is accepted");
+
+  return test_exit_code("Binary fabric key");
+}
@@ -0,0 +1,65 @@
+#ifndef BIN_ARCH_BITSTREAM_FORMAT_H
+#define BIN_ARCH_BITSTREAM_FORMAT_H
+
+/********************************************************************
+ * This file defines the layout of the binary file format of the
+ * architecture bitstream database (BitstreamManager)
+ *
+ * All the integers are stored in the byte order of the host which
+ * writes the file, and a byte order mark is stored in the header so
+ * that a reader can reject a file written on a host of another byte
+ * order. Every section starts at an offset aligned to 8 bytes, so that
+ * the sections can be accessed in place when the file is memory-mapped.
+ *
+ *  +--------------------------------------------------------------+
+ *  | Header (see BinArchBitstreamHeader)                          |
+ *  +--------------------------------------------------------------+
+ *  | uint32 parent block of each block (NO_BLOCK for the roots)   |
+ *  | uint64 offset of the children of each block, plus the total  |
+ *  | uint32 child blocks of all the blocks                        |
+ *  | uint64 first bit of each block                               |
+ *  | uint64 number of bits of each block                          |
+ *  | int16  path id of each block                                 |
+ *  | uint64 offset of the name of each block, plus the total      |
+ *  | char   string table of block names                           |
+ *  | uint64 offset of the input net ids of each block, plus total |
+ *  | char   string table of input net ids                         |
+ *  | uint64 offset of the output net ids of each block, plus total|
+ *  | char   string table of output net ids                        |
+ *  | uint64 values of all the bits, packed 64 bits per word,      |
+ *  |        where bit i is the (i % 64)-th bit of word (i / 64)   |
+ *  +--------------------------------------------------------------+
+ *******************************************************************/
+#include <cstddef>
+#include <cstdint>
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+constexpr char BIN_ARCH_BITSTREAM_MAGIC[4] = {'O', 'F', 'A', 'B'};
+constexpr uint32_t BIN_ARCH_BITSTREAM_BYTE_ORDER_MARK = 0x01020304;
+constexpr uint32_t BIN_ARCH_BITSTREAM_VERSION = 1;
+/* Parent id of a block which has no parent */
+constexpr uint32_t BIN_ARCH_BITSTREAM_NO_BLOCK = UINT32_MAX;
+
+struct BinArchBitstreamHeader {
+  char magic[4];
+  uint32_t byte_order_mark;
+  uint32_t version;
+  uint32_t reserved;
+  uint64_t num_blocks;
+  uint64_t num_child_blocks;
+  uint64_t num_bits;
+  uint64_t name_table_size;
+  uint64_t input_net_table_size;
+  uint64_t output_net_table_size;
+};
+
+/* Size of a section padded to the alignment of sections */
+inline size_t bin_arch_bitstream_section_size(const size_t& num_bytes) {
+  return (num_bytes + 7) / 8 * 8;
+}
+
+} /* end namespace openfpga */
+
+#endif
@@ -4,6 +4,7 @@
 #include "bitstream_manager.h"
 
 #include <algorithm>
+#include <bitset>
 
 #include "vtr_assert.h"
 #include "vtr_log.h"
@@ -49,7 +50,8 @@ bool BitstreamManager::bit_value(const ConfigBitId& bit_id) const {
   /* Ensure a valid id */
   VTR_ASSERT(true == valid_bit_id(bit_id));
 
-  return '1' == bit_values_[bit_id];
+  size_t bit = size_t(bit_id);
+  return 0 != ((bit_values_[bit / 64] >> (bit % 64)) & 1);
 }
 
 ConfigBlockId BitstreamManager::bit_parent_block(
@@ -57,7 +59,18 @@ ConfigBlockId BitstreamManager::bit_parent_block(
   /* Ensure a valid id */
   VTR_ASSERT(true == valid_bit_id(bit_id));
 
-  return bit_parent_blocks_[bit_id];
+  /* Find the last block whose first bit is not after the bit */
+  auto it = std::upper_bound(
+    bit_parent_blocks_.begin(), bit_parent_blocks_.end(), size_t(bit_id),
+    [&](const size_t& bit, const ConfigBlockId& block) {
+      return bit < block_bit_id_lsbs_[block];
+    });
+  VTR_ASSERT(it != bit_parent_blocks_.begin());
+  --it;
+  VTR_ASSERT(size_t(bit_id) <
+             block_bit_id_lsbs_[*it] + block_bit_lengths_[*it]);
+
+  return *it;
 }
 
 std::string BitstreamManager::block_name(const ConfigBlockId& block_id) const {
@@ -104,17 +117,94 @@ std::vector<ConfigBitId> BitstreamManager::block_bits(
   return bits;
 }
 
+size_t BitstreamManager::num_block_bits(const ConfigBlockId& block_id) const {
+  /* Ensure the input ids are valid */
+  VTR_ASSERT(true == valid_block_id(block_id));
+
+  return block_bit_lengths_[block_id];
+}
+
+size_t BitstreamManager::num_block_ones(const ConfigBlockId& block_id) const {
+  /* Ensure the input ids are valid */
+  VTR_ASSERT(true == valid_block_id(block_id));
+
+  size_t length = block_bit_lengths_[block_id];
+  if (0 == length) {
+    return 0;
+  }
+
+  /* The bits of a block are contiguous, count them word by word */
+  size_t lsb = block_bit_id_lsbs_[block_id];
+  size_t msb = lsb + length;
+  size_t num_ones = 0;
+  for (size_t iword = lsb / 64; iword * 64 < msb; ++iword) {
+    uint64_t word = bit_values_[iword];
+    if (iword * 64 < lsb) {
+      word &= ~uint64_t(0) << (lsb % 64);
+    }
+    if (msb < (iword + 1) * 64) {
+      word &= ~(~uint64_t(0) << (msb % 64));
+    }
+    num_ones += std::bitset<64>(word).count();
+  }
+
+  return num_ones;
+}
+
+size_t BitstreamManager::num_block_bit_mismatches(
+  const ConfigBlockId& block_id, const BitstreamManager& other,
+  const ConfigBlockId& other_block_id) const {
+  /* Ensure the input ids are valid */
+  VTR_ASSERT(true == valid_block_id(block_id));
+  VTR_ASSERT(true == other.valid_block_id(other_block_id));
+
+  size_t length = std::min(block_bit_lengths_[block_id],
+                           other.block_bit_lengths_[other_block_id]);
+  size_t lsb = block_bit_id_lsbs_[block_id];
+  size_t other_lsb = other.block_bit_id_lsbs_[other_block_id];
+
+  /* The bits of the two blocks may not be aligned in the same way in their
+   * words, so compare them by chunks of 64 bits */
+  size_t num_mismatches = 0;
+  for (size_t offset = 0; offset < length; offset += 64) {
+    size_t num_chunk_bits = std::min(size_t(64), length - offset);
+    uint64_t diff = bit_values_word(lsb + offset, num_chunk_bits) ^
+                    other.bit_values_word(other_lsb + offset, num_chunk_bits);
+    num_mismatches += std::bitset<64>(diff).count();
+  }
+
+  return num_mismatches;
+}
+
 /* Find the child block in a bitstream manager with a given name */
+const std::string& BitstreamManager::block_path(
+  const ConfigBlockId& block_id) const {
+  /* Ensure the input ids are valid */
+  VTR_ASSERT(true == valid_block_id(block_id));
+
+  if (false == block_path_index_.built.load(std::memory_order_acquire)) {
+    build_block_path_index();
+  }
+  return block_path_index_.paths[block_id];
+}
+
 ConfigBlockId BitstreamManager::find_child_block(
   const ConfigBlockId& block_id, const std::string& child_block_name) const {
   /* Ensure the input ids are valid */
   VTR_ASSERT(true == valid_block_id(block_id));
 
+  if (false == child_block_index_.built.load(std::memory_order_acquire)) {
+    build_child_block_index();
+  }
+
   std::vector<ConfigBlockId> candidates;
 
-  for (const ConfigBlockId& child : block_children(block_id)) {
-    if (0 == child_block_name.compare(block_name(child))) {
-      candidates.push_back(child);
+  auto range = child_block_index_.child_blocks.equal_range(
+    child_block_hash(block_id, child_block_name));
+  for (auto it = range.first; it != range.second; ++it) {
+    if ((block_id == parent_block_ids_[it->second]) &&
+        (0 == child_block_name.compare(block_names_[it->second]))) {
+      candidates.push_back(it->second);
     }
   }
 
@@ -150,21 +240,44 @@ std::string BitstreamManager::block_output_net_ids(
   return block_output_net_ids_[block_id];
 }
 
+/* The lookups built on request are included */
+MemoryUsage BitstreamManager::memory_usage() const {
+  MemoryUsage usage = heap_memory_usage(invalid_block_ids_);
+  usage += heap_memory_usage(block_bit_id_lsbs_);
+  usage += heap_memory_usage(block_bit_lengths_);
+  usage += heap_memory_usage(block_names_);
+  usage += heap_memory_usage(parent_block_ids_);
+  usage += heap_memory_usage(child_block_ids_);
+  usage += heap_memory_usage(block_path_ids_);
+  usage += heap_memory_usage(block_input_net_ids_);
+  usage += heap_memory_usage(block_output_net_ids_);
+  usage += heap_memory_usage(invalid_bit_ids_);
+  usage += heap_memory_usage(bit_values_);
+  usage += heap_memory_usage(bit_parent_blocks_);
+  usage += heap_memory_usage(child_block_index_.child_blocks);
+  usage += heap_memory_usage(block_path_index_.paths);
+  return usage;
+}
+
 /******************************************************************************
  * Public Mutators
  ******************************************************************************/
 ConfigBitId BitstreamManager::add_bit(const ConfigBlockId& parent_block,
                                       const bool& bit_value) {
+  /* Ensure the input ids are valid */
+  VTR_ASSERT(true == valid_block_id(parent_block));
+
+  add_block_bit_range(parent_block, 1);
+
   ConfigBitId bit = ConfigBitId(num_bits_);
   /* Add a new bit, and allocate associated data structures */
-  num_bits_++;
+  if (0 == num_bits_ % 64) {
+    bit_values_.push_back(0);
+  }
   if (true == bit_value) {
-    bit_values_.push_back('1');
-  } else {
-    bit_values_.push_back('0');
+    bit_values_.back() |= uint64_t(1) << (num_bits_ % 64);
   }
-
-  bit_parent_blocks_.push_back(parent_block);
+  num_bits_++;
 
   return bit;
 }
@@ -181,7 +294,7 @@ void BitstreamManager::reserve_blocks(const size_t& num_blocks) {
 }
 
 void BitstreamManager::reserve_bits(const size_t& num_bits) {
-  bit_values_.reserve(num_bits);
+  bit_values_.reserve((num_bits + 63) / 64);
 }
 
 ConfigBlockId BitstreamManager::create_block() {
@@ -197,6 +310,8 @@ ConfigBlockId BitstreamManager::create_block() {
   parent_block_ids_.push_back(ConfigBlockId::INVALID());
   child_block_ids_.emplace_back();
 
+  invalidate_block_path_index();
+
   return block;
 }
 
@@ -221,7 +336,10 @@ void BitstreamManager::set_block_name(const ConfigBlockId& block_id,
                                       const std::string& block_name) {
   /* Ensure the input ids are valid */
   VTR_ASSERT(true == valid_block_id(block_id));
+  remove_block_from_child_block_index(block_id);
   block_names_[block_id] = block_name;
+  add_block_to_child_block_index(block_id);
+  invalidate_block_path_index();
 }
 
 void BitstreamManager::reserve_child_blocks(const ConfigBlockId& parent_block,
@@ -253,6 +371,8 @@ void BitstreamManager::add_child_block(const ConfigBlockId& parent_block,
   child_block_ids_[parent_block].push_back(child_block);
   /* Register the block in the parent of the block */
   parent_block_ids_[child_block] = parent_block;
+  add_block_to_child_block_index(child_block);
+  invalidate_block_path_index();
 }
 
 void BitstreamManager::add_block_bits(
@@ -260,15 +380,33 @@ void BitstreamManager::add_block_bits(
   /* Ensure the input ids are valid */
   VTR_ASSERT(true == valid_block_id(block));
 
-  /* Add the bit to the block, record anchors in bit indexing for block-level
-   * searching */
-  block_bit_id_lsbs_[block] = num_bits_;
-  block_bit_lengths_[block] = block_bitstream.size();
-  for (const bool& bit : block_bitstream) {
-    add_bit(block, bit);
+  /* Add the bits to the block, the anchors in bit indexing for block-level
+   * searching are recorded once for all the bits */
+  add_block_bit_range(block, block_bitstream.size());
+
+  /* Pack the bits into words, which are appended one by one */
+  for (size_t ibit = 0; ibit < block_bitstream.size(); ibit += 64) {
+    size_t num_word_bits = std::min<size_t>(64, block_bitstream.size() - ibit);
+    uint64_t word = 0;
+    for (size_t jbit = 0; jbit < num_word_bits; ++jbit) {
+      if (true == block_bitstream[ibit + jbit]) {
+        word |= uint64_t(1) << jbit;
+      }
+    }
+    append_bit_values(&word, num_word_bits);
   }
 }
 
+void BitstreamManager::add_block_bits(const ConfigBlockId& block,
+                                      const uint64_t* words,
+                                      const size_t& num_bits) {
+  /* Ensure the input ids are valid */
+  VTR_ASSERT(true == valid_block_id(block));
+
+  add_block_bit_range(block, num_bits);
+  append_bit_values(words, num_bits);
+}
+
 void BitstreamManager::add_path_id_to_block(const ConfigBlockId& block,
                                             const int& path_id) {
   /* Ensure the input ids are valid */
@@ -296,6 +434,231 @@ void BitstreamManager::add_output_net_id_to_block(
   block_output_net_ids_[block] = output_net_id;
 }
 
+void BitstreamManager::append_bitstream(const ConfigBlockId& parent_block,
+                                        const BitstreamManager& bitstream) {
+  /* Ensure the input ids are valid */
+  VTR_ASSERT(true == valid_block_id(parent_block));
+
+  if (0 == bitstream.num_blocks()) {
+    return;
+  }
+
+  /* The root block stands for the parent block and should not own any bit */
+  ConfigBlockId root_block = ConfigBlockId(0);
+  VTR_ASSERT(0 == bitstream.block_bit_lengths_[root_block]);
+
+  /* Copy the blocks in the order of their ids */
+  vtr::vector<ConfigBlockId, ConfigBlockId> block_map(bitstream.num_blocks(),
+                                                      ConfigBlockId::INVALID());
+  block_map[root_block] = parent_block;
+  for (size_t iblk = 1; iblk < bitstream.num_blocks(); ++iblk) {
+    ConfigBlockId block = ConfigBlockId(iblk);
+    /* Parent blocks are always created before their children */
+    ConfigBlockId block_parent = bitstream.parent_block_ids_[block];
+    VTR_ASSERT(true == bitstream.valid_block_id(block_parent));
+    VTR_ASSERT(true == valid_block_id(block_map[block_parent]));
+
+    ConfigBlockId new_block = add_block(bitstream.block_names_[block]);
+    add_child_block(block_map[block_parent], new_block);
+    reserve_child_blocks(new_block, bitstream.child_block_ids_[block].size());
+    block_path_ids_[new_block] = bitstream.block_path_ids_[block];
+    block_input_net_ids_[new_block] = bitstream.block_input_net_ids_[block];
+    block_output_net_ids_[new_block] = bitstream.block_output_net_ids_[block];
+    block_map[block] = new_block;
+  }
+
+  /* Copy the bits in the order of their ids. The bits of the other bitstream
+   * are contiguous and the new blocks own no bits yet, so the bits are shifted
+   * by the current number of bits and copied word by word */
+  for (const ConfigBlockId& block : bitstream.bit_parent_blocks_) {
+    ConfigBlockId new_block = block_map[block];
+    block_bit_id_lsbs_[new_block] =
+      num_bits_ + bitstream.block_bit_id_lsbs_[block];
+    block_bit_lengths_[new_block] = bitstream.block_bit_lengths_[block];
+    bit_parent_blocks_.push_back(new_block);
+  }
+  append_bit_values(bitstream.bit_values_.data(), bitstream.num_bits_);
+}
+
+/******************************************************************************
+ * Private utility
+ ******************************************************************************/
+uint64_t BitstreamManager::bit_values_word(const size_t& lsb,
+                                           const size_t& num_bits) const {
+  VTR_ASSERT(0 < num_bits && 64 >= num_bits);
+  VTR_ASSERT(lsb + num_bits <= num_bits_);
+
+  size_t iword = lsb / 64;
+  size_t shift = lsb % 64;
+  uint64_t word = bit_values_[iword] >> shift;
+  if ((0 != shift) && (shift + num_bits > 64)) {
+    word |= bit_values_[iword + 1] << (64 - shift);
+  }
+  if (64 > num_bits) {
+    word &= ~(~uint64_t(0) << num_bits);
+  }
+  return word;
+}
+
+BitstreamManager::BlockPathIndex& BitstreamManager::BlockPathIndex::operator=(
+  const BlockPathIndex&) {
+  clear();
+  return *this;
+}
+
+void BitstreamManager::BlockPathIndex::clear() {
+  built.store(false, std::memory_order_release);
+  paths.clear();
+}
+
+void BitstreamManager::add_block_bit_range(const ConfigBlockId& block,
+                                           const size_t& num_bits) {
+  if (0 == num_bits) {
+    return;
+  }
+  /* The bits of a block should be contiguous: a block can only get new bits
+   * when it has no bits yet, or when it owns the latest bits */
+  if (0 == block_bit_lengths_[block]) {
+    block_bit_id_lsbs_[block] = num_bits_;
+    bit_parent_blocks_.push_back(block);
+  }
+  VTR_ASSERT(block == bit_parent_blocks_.back());
+  block_bit_lengths_[block] += num_bits;
+}
+
+void BitstreamManager::append_bit_values(const uint64_t* words,
+                                         const size_t& num_bits) {
+  for (size_t ibit = 0; ibit < num_bits; ibit += 64) {
+    size_t num_word_bits = std::min<size_t>(64, num_bits - ibit);
+    uint64_t word = words[ibit / 64];
+    if (64 > num_word_bits) {
+      word &= (uint64_t(1) << num_word_bits) - 1;
+    }
+    /* Fill the last word first, and then start a new word if needed */
+    size_t offset = num_bits_ % 64;
+    if (0 == offset) {
+      bit_values_.push_back(word);
+    } else {
+      bit_values_.back() |= word << offset;
+      if (64 < offset + num_word_bits) {
+        bit_values_.push_back(word >> (64 - offset));
+      }
+    }
+    num_bits_ += num_word_bits;
+  }
+}
+
+void BitstreamManager::build_block_path_index() const {
+  std::lock_guard<std::mutex> lock(block_path_index_.mutex);
+  /* Another thread may have built the index while waiting for the lock */
+  if (true == block_path_index_.built.load(std::memory_order_acquire)) {
+    return;
+  }
+
+  vtr::vector<ConfigBlockId, std::string>& paths = block_path_index_.paths;
+  paths.clear();
+  paths.resize(num_blocks_);
+
+  /* Visit the block tree from the top-level blocks, so that the path of a
+   * parent block is always built before its children */
+  std::vector<ConfigBlockId> blocks_to_visit;
+  for (size_t iblk = 0; iblk < num_blocks_; ++iblk) {
+    ConfigBlockId block = ConfigBlockId(iblk);
+    if (true == valid_block_id(parent_block_ids_[block])) {
+      continue;
+    }
+    paths[block] = block_names_[block];
+    blocks_to_visit.push_back(block);
+  }
+  while (false == blocks_to_visit.empty()) {
+    ConfigBlockId block = blocks_to_visit.back();
+    blocks_to_visit.pop_back();
+    for (const ConfigBlockId& child : child_block_ids_[block]) {
+      std::string& child_path = paths[child];
+      child_path.reserve(paths[block].size() + 1 + block_names_[child].size());
+      child_path = paths[block];
+      child_path += ".";
+      child_path += block_names_[child];
+      blocks_to_visit.push_back(child);
+    }
+  }
+
+  block_path_index_.built.store(true, std::memory_order_release);
+}
+
+void BitstreamManager::invalidate_block_path_index() {
+  if (true == block_path_index_.built.load(std::memory_order_acquire)) {
+    block_path_index_.clear();
+  }
+}
+
+BitstreamManager::ChildBlockIndex& BitstreamManager::ChildBlockIndex::operator=(
+  const ChildBlockIndex&) {
+  clear();
+  return *this;
+}
+
+void BitstreamManager::ChildBlockIndex::clear() {
+  built.store(false, std::memory_order_release);
+  child_blocks.clear();
+}
+
+size_t BitstreamManager::child_block_hash(const ConfigBlockId& parent_block,
+                                          const std::string& child_block_name) {
+  size_t hash = std::hash<std::string>()(child_block_name);
+  return hash ^ (size_t(parent_block) + 0x9e3779b97f4a7c15ULL + (hash << 6) +
+                 (hash >> 2));
+}
+
+void BitstreamManager::build_child_block_index() const {
+  std::lock_guard<std::mutex> lock(child_block_index_.mutex);
+  /* Another thread may have built the index while waiting for the lock */
+  if (true == child_block_index_.built.load(std::memory_order_acquire)) {
+    return;
+  }
+
+  child_block_index_.child_blocks.clear();
+  child_block_index_.child_blocks.reserve(num_blocks_);
+  for (size_t iblk = 0; iblk < num_blocks_; ++iblk) {
+    ConfigBlockId block = ConfigBlockId(iblk);
+    if (false == valid_block_id(parent_block_ids_[block])) {
+      continue;
+    }
+    child_block_index_.child_blocks.emplace(
+      child_block_hash(parent_block_ids_[block], block_names_[block]), block);
+  }
+
+  child_block_index_.built.store(true, std::memory_order_release);
+}
+
+void BitstreamManager::add_block_to_child_block_index(
+  const ConfigBlockId& block) {
+  /* Only blocks with a parent can be found, and the index is updated only when
+   * it has been built */
+  if ((false == child_block_index_.built.load(std::memory_order_acquire)) ||
+      (false == valid_block_id(parent_block_ids_[block]))) {
+    return;
+  }
+  child_block_index_.child_blocks.emplace(
+    child_block_hash(parent_block_ids_[block], block_names_[block]), block);
+}
+
+void BitstreamManager::remove_block_from_child_block_index(
+  const ConfigBlockId& block) {
+  if ((false == child_block_index_.built.load(std::memory_order_acquire)) ||
+      (false == valid_block_id(parent_block_ids_[block]))) {
+    return;
+  }
+  auto range = child_block_index_.child_blocks.equal_range(
+    child_block_hash(parent_block_ids_[block], block_names_[block]));
+  for (auto it = range.first; it != range.second; ++it) {
+    if (block == it->second) {
+      child_block_index_.child_blocks.erase(it);
+      return;
+    }
+  }
+}
+
 /******************************************************************************
  * Public Validators
  ******************************************************************************/
@@ -37,12 +37,17 @@
 #ifndef BITSTREAM_MANAGER_H
 #define BITSTREAM_MANAGER_H
 
+#include <atomic>
+#include <cstdint>
 #include <map>
+#include <mutex>
+#include <string>
 #include <unordered_map>
 #include <unordered_set>
 #include <vector>
 
 #include "bitstream_manager_fwd.h"
+#include "openfpga_memory_usage.h"
 #include "vtr_vector.h"
 
 /* begin namespace openfpga */
@@ -152,6 +157,26 @@ class BitstreamManager {
   /* Find all the bits that belong to a block */
   std::vector<ConfigBitId> block_bits(const ConfigBlockId& block_id) const;
 
+  /* Find the number of bits that belong to a block, without listing them */
+  size_t num_block_bits(const ConfigBlockId& block_id) const;
+
+  /* Find the number of bits with value '1' that belong to a block */
+  size_t num_block_ones(const ConfigBlockId& block_id) const;
+
+  /* Find the number of bits of a block whose values differ from the bits of
+   * a block in another bitstream manager. Only the first bits shared by both
+   * blocks are compared. Bits are compared 64 at a time */
+  size_t num_block_bit_mismatches(const ConfigBlockId& block_id,
+                                  const BitstreamManager& other,
+                                  const ConfigBlockId& other_block_id) const;
+
+  /* Find the hierarchical path of a block, which consists of the names of
+   * the blocks from the top-level block down to the block, separated by dots.
+   * The paths of all the blocks are built at the first call and kept until
+   * blocks are modified, so that the string returned is cheap to get. It is
+   * safe to call it from multiple threads */
+  const std::string& block_path(const ConfigBlockId& block_id) const;
+
   /* Find the child block in a bitstream manager with a given name */
   ConfigBlockId find_child_block(const ConfigBlockId& block_id,
                                  const std::string& child_block_name) const;
@@ -165,6 +190,9 @@ class BitstreamManager {
   /* Find input net ids of a block */
   std::string block_output_net_ids(const ConfigBlockId& block_id) const;
 
+  /* Approximate heap memory used by the data structure */
+  MemoryUsage memory_usage() const;
+
  public: /* Public Mutators */
   /* Add a new configuration bit to the bitstream manager */
   ConfigBitId add_bit(const ConfigBlockId& parent_block, const bool& bit_value);
@@ -202,6 +230,12 @@ class BitstreamManager {
   void add_block_bits(const ConfigBlockId& block,
                       const std::vector<bool>& block_bitstream);
 
+  /* Add a bitstream packed in 64-bit words to a block. Bit i of the
+   * bitstream is bit (i % 64) of word (i / 64). Bits beyond num_bits in the
+   * last word are ignored */
+  void add_block_bits(const ConfigBlockId& block, const uint64_t* words,
+                      const size_t& num_bits);
+
   /* Add a path id to a block */
   void add_path_id_to_block(const ConfigBlockId& block, const int& path_id);
 
@@ -213,6 +247,15 @@ class BitstreamManager {
   void add_output_net_id_to_block(const ConfigBlockId& block,
                                   const std::string& output_net_id);
 
+  /* Add all the blocks and bits of another bitstream under a block.
+   * The first block of the other bitstream is a root which stands for the
+   * parent block: its children become the children of the parent block.
+   * Blocks and bits keep their order, so that building parts of a bitstream
+   * separately and appending them in order leads to the same bitstream as
+   * building them in place */
+  void append_bitstream(const ConfigBlockId& parent_block,
+                        const BitstreamManager& bitstream);
+
  public: /* Public Validators */
   bool valid_bit_id(const ConfigBitId& bit_id) const;
 
@@ -220,12 +263,62 @@ class BitstreamManager {
 
   bool valid_block_path_id(const ConfigBlockId& block_id) const;
 
+ private: /* Internal types */
+  /* Hierarchical paths of the blocks, which are built on demand.
+   * A path is built by appending the name of a block to the path of its
+   * parent, so that the common prefixes are only walked once.
+   * The index is not copied with the bitstream manager: a copy builds its
+   * own index when needed */
+  struct BlockPathIndex {
+    BlockPathIndex() = default;
+    BlockPathIndex(const BlockPathIndex&) {}
+    BlockPathIndex& operator=(const BlockPathIndex&);
+    void clear();
+
+    std::atomic<bool> built{false};
+    std::mutex mutex;
+    vtr::vector<ConfigBlockId, std::string> paths;
+  };
+
+  /* Fast look-up on the child blocks of a block by names, which is built on
+   * demand and then updated along with the blocks.
+   * Blocks are indexed by the hash of their parent and name, so that names
+   * are not duplicated. Blocks with the same hash are told apart by their
+   * parent and name. The index is not copied with the bitstream manager */
+  struct ChildBlockIndex {
+    ChildBlockIndex() = default;
+    ChildBlockIndex(const ChildBlockIndex&) {}
+    ChildBlockIndex& operator=(const ChildBlockIndex&);
+    void clear();
+
+    std::atomic<bool> built{false};
+    std::mutex mutex;
+    std::unordered_multimap<size_t, ConfigBlockId> child_blocks;
+  };
+
+ private: /* Internal utility */
+  void build_block_path_index() const;
+  void invalidate_block_path_index();
+  static size_t child_block_hash(const ConfigBlockId& parent_block,
+                                 const std::string& child_block_name);
+  void build_child_block_index() const;
+  void add_block_to_child_block_index(const ConfigBlockId& block);
+  void remove_block_from_child_block_index(const ConfigBlockId& block);
+  /* Reserve the next num_bits bits of the bitstream for a block, whose bits
+   * should be contiguous */
+  void add_block_bit_range(const ConfigBlockId& block, const size_t& num_bits);
+  /* Append bits packed in 64-bit words to the end of the bitstream */
+  void append_bit_values(const uint64_t* words, const size_t& num_bits);
+  /* Get up to 64 bits of the bitstream starting from a given bit id, packed
+   * in a word whose LSB is the first bit */
+  uint64_t bit_values_word(const size_t& lsb, const size_t& num_bits) const;
+
  private: /* Internal data */
   /* Unique id of a block of bits in the Bitstream */
   size_t num_blocks_;
   std::unordered_set<ConfigBlockId> invalid_block_ids_;
   vtr::vector<ConfigBlockId, size_t> block_bit_id_lsbs_;
-  vtr::vector<ConfigBlockId, short> block_bit_lengths_;
+  vtr::vector<ConfigBlockId, size_t> block_bit_lengths_;
 
   /* Back-annotation for the bits */
   /* Parent block of a bit in the Bitstream
@@ -239,8 +332,8 @@ class BitstreamManager {
   vtr::vector<ConfigBlockId, ConfigBlockId> parent_block_ids_;
   vtr::vector<ConfigBlockId, std::vector<ConfigBlockId>> child_block_ids_;
 
-  /* Fast look-up by block name to ids */
-  std::map<std::string, ConfigBlockId> block_name2ids_;
+  /* Fast look-up by parent blocks and names to ids */
+  mutable ChildBlockIndex child_block_index_;
 
   /* The ids of the inputs of routing multiplexer blocks which is propagated to
    * outputs By default, it will be -2 (which is invalid) A valid id starts from
@@ -266,9 +359,16 @@ class BitstreamManager {
   /* Unique id of a bit in the Bitstream */
   size_t num_bits_;
   std::unordered_set<ConfigBitId> invalid_bit_ids_;
-  /* value of a bit in the Bitstream */
-  vtr::vector<ConfigBitId, char> bit_values_;
-  vtr::vector<ConfigBitId, ConfigBlockId> bit_parent_blocks_;
+  /* Values of the bits in the Bitstream, packed in 64-bit words.
+   * Bit i is the (i % 64)-th bit of the (i / 64)-th word */
+  std::vector<uint64_t> bit_values_;
+  /* Blocks which own bits, sorted by the first bit they own.
+   * The bits of a block are contiguous, so the parent block of a bit is found
+   * by a binary search on the ranges [block_bit_id_lsbs_,
+   * block_bit_id_lsbs_ + block_bit_lengths_) of these blocks */
+  std::vector<ConfigBlockId> bit_parent_blocks_;
+
+  mutable BlockPathIndex block_path_index_;
 };
 
 } /* end namespace openfpga */
@@ -114,9 +114,9 @@ size_t rec_find_bitstream_manager_block_sum_of_bits(
   const BitstreamManager& bitstream_manager, const ConfigBlockId& block) {
   /* For leaf block, return directly with the number of bits, because it has not
    * child block */
-  if (0 < bitstream_manager.block_bits(block).size()) {
+  if (0 < bitstream_manager.num_block_bits(block)) {
     VTR_ASSERT_SAFE(bitstream_manager.block_children(block).empty());
-    return bitstream_manager.block_bits(block).size();
+    return bitstream_manager.num_block_bits(block);
   }
 
   size_t sum_of_bits = 0;
@@ -130,4 +130,95 @@ size_t rec_find_bitstream_manager_block_sum_of_bits(
   return sum_of_bits;
 }
 
+/********************************************************************
+ * Find the total number of configuration bits, as well as the number of
+ * configuration bits with value '1', under each block of a bitstream
+ * manager. Unlike rec_find_bitstream_manager_block_sum_of_bits(), the
+ * totals of all the blocks are accumulated in a single bottom-up pass,
+ * where the bits of each block are counted on their ranges directly
+ *******************************************************************/
+void find_bitstream_manager_subtree_bit_counts(
+  const BitstreamManager& bitstream_manager,
+  vtr::vector<ConfigBlockId, size_t>& num_bits,
+  vtr::vector<ConfigBlockId, size_t>& num_ones) {
+  num_bits.clear();
+  num_bits.resize(bitstream_manager.num_blocks(), 0);
+  num_ones.clear();
+  num_ones.resize(bitstream_manager.num_blocks(), 0);
+
+  /* Sort the blocks so that a block always comes after its parent */
+  std::vector<ConfigBlockId> sorted_blocks;
+  sorted_blocks.reserve(bitstream_manager.num_blocks());
+  std::vector<ConfigBlockId> block_stack =
+    find_bitstream_manager_top_blocks(bitstream_manager);
+  while (false == block_stack.empty()) {
+    ConfigBlockId block = block_stack.back();
+    block_stack.pop_back();
+    sorted_blocks.push_back(block);
+    for (const ConfigBlockId& child_block :
+         bitstream_manager.block_children(block)) {
+      block_stack.push_back(child_block);
+    }
+  }
+
+  /* Visit the children before their parents */
+  for (auto it = sorted_blocks.rbegin(); it != sorted_blocks.rend(); ++it) {
+    ConfigBlockId block = *it;
+    num_bits[block] += bitstream_manager.num_block_bits(block);
+    num_ones[block] += bitstream_manager.num_block_ones(block);
+    ConfigBlockId parent_block = bitstream_manager.block_parent(block);
+    if (ConfigBlockId::INVALID() != parent_block) {
+      num_bits[parent_block] += num_bits[block];
+      num_ones[parent_block] += num_ones[block];
+    }
+  }
+}
+
+/********************************************************************
+ * Check if two bitstream databases share the same blocks and bits,
+ * i.e., the same block names, block hierarchy and bit owners, so that
+ * the ids of one database refer to the same blocks and bits in the
+ * other database. Only the values of the bits may differ.
+ * This is the case for the bitstreams of two implementations on the
+ * same FPGA fabric
+ *******************************************************************/
+bool is_bitstream_manager_structure_equal(const BitstreamManager& reference,
+                                          const BitstreamManager& bitstream) {
+  if ((reference.num_blocks() != bitstream.num_blocks()) ||
+      (reference.num_bits() != bitstream.num_bits())) {
+    return false;
+  }
+  for (const ConfigBlockId& block : bitstream.blocks()) {
+    if ((reference.block_name(block) != bitstream.block_name(block)) ||
+        (reference.block_parent(block) != bitstream.block_parent(block))) {
+      return false;
+    }
+    std::vector<ConfigBitId> ref_block_bits = reference.block_bits(block);
+    std::vector<ConfigBitId> block_bits = bitstream.block_bits(block);
+    if ((ref_block_bits.size() != block_bits.size()) ||
+        ((false == block_bits.empty()) &&
+         (ref_block_bits.front() != block_bits.front()))) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/********************************************************************
+ * Find the configuration bits whose values differ between two bitstream
+ * databases of the same structure (see
+ * is_bitstream_manager_structure_equal()), in the order of bit ids
+ *******************************************************************/
+std::vector<ConfigBitId> find_bitstream_manager_changed_bits(
+  const BitstreamManager& reference, const BitstreamManager& bitstream) {
+  VTR_ASSERT(reference.num_bits() == bitstream.num_bits());
+  std::vector<ConfigBitId> changed_bits;
+  for (const ConfigBitId& bit : bitstream.bits()) {
+    if (reference.bit_value(bit) != bitstream.bit_value(bit)) {
+      changed_bits.push_back(bit);
+    }
+  }
+  return changed_bits;
+}
+
 } /* end namespace openfpga */
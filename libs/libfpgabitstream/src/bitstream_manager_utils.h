@@ -31,6 +31,17 @@ size_t find_bitstream_manager_config_bit_index_in_grandparent_block(
 size_t rec_find_bitstream_manager_block_sum_of_bits(
   const BitstreamManager& bitstream_manager, const ConfigBlockId& block);
 
+void find_bitstream_manager_subtree_bit_counts(
+  const BitstreamManager& bitstream_manager,
+  vtr::vector<ConfigBlockId, size_t>& num_bits,
+  vtr::vector<ConfigBlockId, size_t>& num_ones);
+
+bool is_bitstream_manager_structure_equal(const BitstreamManager& reference,
+                                          const BitstreamManager& bitstream);
+
+std::vector<ConfigBitId> find_bitstream_manager_changed_bits(
+  const BitstreamManager& reference, const BitstreamManager& bitstream);
+
 } /* end namespace openfpga */
 
 #endif
@@ -0,0 +1,168 @@
+/********************************************************************
+ * This file includes functions that find the differences between two
+ * architecture bitstream databases, e.g., the bitstreams of two runs
+ *******************************************************************/
+#include <algorithm>
+#include <fstream>
+#include <unordered_map>
+
+/* Headers from vtrutil library */
+#include "vtr_assert.h"
+#include "vtr_log.h"
+#include "vtr_time.h"
+
+/* Headers from openfpgautil library */
+#include "bitstream_manager_utils.h"
+#include "diff_arch_bitstream.h"
+#include "openfpga_digest.h"
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+bool ArchBitstreamDiff::empty() const {
+  return changed_blocks.empty() && removed_blocks.empty() &&
+         added_blocks.empty();
+}
+
+size_t ArchBitstreamDiff::num_total_changed_bits() const {
+  size_t num_bits = 0;
+  for (const size_t& num_block_bits : num_changed_bits) {
+    num_bits += num_block_bits;
+  }
+  return num_bits;
+}
+
+/********************************************************************
+ * Recursively compare a block of the reference to the block of the same
+ * name in the bitstream, as well as their child blocks.
+ * Child blocks are matched by their names using the index of the bitstream
+ * managers (see BitstreamManager::find_child_block()), so that the order of
+ * the child blocks does not matter
+ *******************************************************************/
+static void rec_diff_architecture_bitstream_block(
+  ArchBitstreamDiff& diff, const BitstreamManager& reference,
+  const BitstreamManager& bitstream, const ConfigBlockId& ref_block,
+  const ConfigBlockId& block) {
+  size_t num_ref_bits = reference.num_block_bits(ref_block);
+  size_t num_bits = bitstream.num_block_bits(block);
+  size_t num_changed_bits =
+    reference.num_block_bit_mismatches(ref_block, bitstream, block);
+  num_changed_bits += std::max(num_ref_bits, num_bits) -
+                      std::min(num_ref_bits, num_bits);
+  if (0 < num_changed_bits) {
+    diff.changed_reference_blocks.push_back(ref_block);
+    diff.changed_blocks.push_back(block);
+    diff.num_changed_bits.push_back(num_changed_bits);
+  }
+
+  for (const ConfigBlockId& child_block : bitstream.block_children(block)) {
+    ConfigBlockId ref_child_block =
+      reference.find_child_block(ref_block, bitstream.block_name(child_block));
+    if (false == reference.valid_block_id(ref_child_block)) {
+      diff.added_blocks.push_back(child_block);
+      continue;
+    }
+    rec_diff_architecture_bitstream_block(diff, reference, bitstream,
+                                          ref_child_block, child_block);
+  }
+
+  for (const ConfigBlockId& ref_child_block :
+       reference.block_children(ref_block)) {
+    ConfigBlockId child_block =
+      bitstream.find_child_block(block, reference.block_name(ref_child_block));
+    if (false == bitstream.valid_block_id(child_block)) {
+      diff.removed_blocks.push_back(ref_child_block);
+    }
+  }
+}
+
+/********************************************************************
+ * Find the differences between a reference bitstream database and another
+ * one, walking the block hierarchies of both databases at the same time.
+ * The bits of each pair of matched blocks are compared word by word, which
+ * avoids outputting the databases to files
+ *******************************************************************/
+ArchBitstreamDiff diff_architecture_bitstream(
+  const BitstreamManager& reference, const BitstreamManager& bitstream) {
+  vtr::ScopedStartFinishTimer timer("Compare architecture bitstreams");
+
+  ArchBitstreamDiff diff;
+
+  std::unordered_map<std::string, ConfigBlockId> ref_top_blocks;
+  for (const ConfigBlockId& ref_top_block :
+       find_bitstream_manager_top_blocks(reference)) {
+    ref_top_blocks[reference.block_name(ref_top_block)] = ref_top_block;
+  }
+
+  for (const ConfigBlockId& top_block :
+       find_bitstream_manager_top_blocks(bitstream)) {
+    auto result = ref_top_blocks.find(bitstream.block_name(top_block));
+    if (result == ref_top_blocks.end()) {
+      diff.added_blocks.push_back(top_block);
+      continue;
+    }
+    rec_diff_architecture_bitstream_block(diff, reference, bitstream,
+                                          result->second, top_block);
+    ref_top_blocks.erase(result);
+  }
+
+  /* The top blocks left are not in the bitstream */
+  for (const ConfigBlockId& ref_top_block :
+       find_bitstream_manager_top_blocks(reference)) {
+    if (ref_top_blocks.end() !=
+        ref_top_blocks.find(reference.block_name(ref_top_block))) {
+      diff.removed_blocks.push_back(ref_top_block);
+    }
+  }
+
+  return diff;
+}
+
+/********************************************************************
+ * Write the differences between two bitstream databases to a plain text
+ * file, one block per line with its hierarchical path, e.g.,
+ *   changed fpga_top.grid_clb_1__1_.mem_0 3
+ *   added fpga_top.sb_1__1_.mem_left_track_1
+ *   removed fpga_top.cbx_1__1_.mem_top_ipin_0
+ * where the number of changed bits is given for changed blocks
+ *******************************************************************/
+int write_architecture_bitstream_diff_to_file(
+  const std::string& fname, const BitstreamManager& reference,
+  const BitstreamManager& bitstream, const ArchBitstreamDiff& diff) {
+  /* Ensure that we have a valid file name */
+  if (true == fname.empty()) {
+    VTR_LOG_ERROR(
+      "Received empty file name to output bitstream differences!\n\tPlease "
+      "specify a valid file name.\n");
+    return 1;
+  }
+
+  std::string timer_message =
+    std::string("Write bitstream differences to file '") + fname +
+    std::string("'");
+  vtr::ScopedStartFinishTimer timer(timer_message);
+
+  /* Create the file stream */
+  std::fstream fp;
+  fp.open(fname, std::fstream::out | std::fstream::trunc);
+
+  check_file_stream(fname.c_str(), fp);
+
+  VTR_ASSERT(diff.changed_blocks.size() == diff.num_changed_bits.size());
+  for (size_t iblk = 0; iblk < diff.changed_blocks.size(); ++iblk) {
+    fp << "changed " << bitstream.block_path(diff.changed_blocks[iblk]) << " "
+       << diff.num_changed_bits[iblk] << "\n";
+  }
+  for (const ConfigBlockId& block : diff.added_blocks) {
+    fp << "added " << bitstream.block_path(block) << "\n";
+  }
+  for (const ConfigBlockId& ref_block : diff.removed_blocks) {
+    fp << "removed " << reference.block_path(ref_block) << "\n";
+  }
+
+  fp.close();
+
+  return 0;
+}
+
+} /* end namespace openfpga */
@@ -0,0 +1,48 @@
+#ifndef DIFF_ARCH_BITSTREAM_H
+#define DIFF_ARCH_BITSTREAM_H
+
+/********************************************************************
+ * Include header files that are required by function declaration
+ *******************************************************************/
+#include <string>
+#include <vector>
+
+#include "bitstream_manager.h"
+
+/********************************************************************
+ * Function declaration
+ *******************************************************************/
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+/* Differences between two bitstream databases, whose blocks are matched by
+ * their names under the same parent block:
+ * - the pairs of matched blocks whose bits differ, as well as the number of
+ *   bits which differ. Blocks with a different number of bits are included,
+ *   with the bits out of the shared range counted as differences
+ * - the blocks which only exist in the reference. Their child blocks are not
+ *   listed
+ * - the blocks which only exist in the bitstream. Their child blocks are not
+ *   listed */
+struct ArchBitstreamDiff {
+  std::vector<ConfigBlockId> changed_reference_blocks;
+  std::vector<ConfigBlockId> changed_blocks;
+  std::vector<size_t> num_changed_bits;
+  std::vector<ConfigBlockId> removed_blocks;
+  std::vector<ConfigBlockId> added_blocks;
+
+  bool empty() const;
+  size_t num_total_changed_bits() const;
+};
+
+ArchBitstreamDiff diff_architecture_bitstream(
+  const BitstreamManager& reference, const BitstreamManager& bitstream);
+
+int write_architecture_bitstream_diff_to_file(
+  const std::string& fname, const BitstreamManager& reference,
+  const BitstreamManager& bitstream, const ArchBitstreamDiff& diff);
+
+} /* end namespace openfpga */
+
+#endif
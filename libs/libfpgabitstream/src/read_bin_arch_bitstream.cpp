@@ -0,0 +1,348 @@
+/********************************************************************
+ * This file includes the functions which read a binary file of the
+ * architecture bitstream database, whose layout is detailed in
+ * bin_arch_bitstream_format.h
+ *******************************************************************/
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <vector>
+
+/* Headers from vtr util library */
+#include "vtr_assert.h"
+#include "vtr_time.h"
+
+/* Headers from libarchfpga */
+#include "arch_error.h"
+#include "read_bin_arch_bitstream.h"
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+/********************************************************************
+ * Check that a column of string offsets is valid for a string table
+ *******************************************************************/
+static void check_bin_arch_bitstream_string_table(const char* fname,
+                                                  const uint64_t* offsets,
+                                                  const size_t& num_strings,
+                                                  const size_t& table_size,
+                                                  const char* table_name) {
+  if ((0 != offsets[0]) || (table_size != offsets[num_strings])) {
+    archfpga_throw(fname, 0, "Invalid %s table in binary bitstream file!\n",
+                   table_name);
+  }
+  for (size_t istr = 0; istr < num_strings; ++istr) {
+    if (offsets[istr] > offsets[istr + 1]) {
+      archfpga_throw(fname, 0, "Invalid %s table in binary bitstream file!\n",
+                     table_name);
+    }
+  }
+}
+
+/************************************************************************
+ * Constructors
+ ***********************************************************************/
+BinArchBitstreamFile::BinArchBitstreamFile()
+  : offset_(0),
+    header_(nullptr),
+    block_parents_(nullptr),
+    child_offsets_(nullptr),
+    child_blocks_(nullptr),
+    block_bit_lsbs_(nullptr),
+    block_bit_lengths_(nullptr),
+    block_path_ids_(nullptr),
+    name_offsets_(nullptr),
+    name_chars_(nullptr),
+    input_net_offsets_(nullptr),
+    input_net_chars_(nullptr),
+    output_net_offsets_(nullptr),
+    output_net_chars_(nullptr),
+    bit_words_(nullptr) {}
+
+/************************************************************************
+ * Public Mutators
+ ***********************************************************************/
+void BinArchBitstreamFile::open(const std::string& fname) {
+  fname_ = fname;
+  offset_ = 0;
+  if (false == file_.open(fname)) {
+    archfpga_throw(fname.c_str(), 0, "Unable to open file '%s'!\n",
+                   fname.c_str());
+  }
+
+  header_ = reinterpret_cast<const BinArchBitstreamHeader*>(
+    section(sizeof(BinArchBitstreamHeader)));
+  if (0 != std::memcmp(header_->magic, BIN_ARCH_BITSTREAM_MAGIC,
+                       sizeof(header_->magic))) {
+    archfpga_throw(fname.c_str(), 0,
+                   "File is not a binary architecture bitstream!\n");
+  }
+  if (BIN_ARCH_BITSTREAM_BYTE_ORDER_MARK != header_->byte_order_mark) {
+    archfpga_throw(fname.c_str(), 0,
+                   "Binary bitstream file is written on a host of another "
+                   "byte order!\n");
+  }
+  if (BIN_ARCH_BITSTREAM_VERSION != header_->version) {
+    archfpga_throw(fname.c_str(), 0,
+                   "Unsupported version %u of binary bitstream file!\n",
+                   header_->version);
+  }
+
+  /* Each block or bit takes at least a byte, or a bit, of the file, which
+   * rejects sizes leading to overflows */
+  if ((header_->num_blocks > file_.size()) ||
+      (header_->num_child_blocks > file_.size()) ||
+      (header_->num_bits / 8 > file_.size())) {
+    archfpga_throw(fname.c_str(), 0,
+                   "Unexpected end of binary bitstream file!\n");
+  }
+
+  size_t num_blocks = header_->num_blocks;
+  block_parents_ =
+    reinterpret_cast<const uint32_t*>(section(num_blocks * sizeof(uint32_t)));
+  child_offsets_ = reinterpret_cast<const uint64_t*>(
+    section((num_blocks + 1) * sizeof(uint64_t)));
+  child_blocks_ = reinterpret_cast<const uint32_t*>(
+    section(header_->num_child_blocks * sizeof(uint32_t)));
+  block_bit_lsbs_ =
+    reinterpret_cast<const uint64_t*>(section(num_blocks * sizeof(uint64_t)));
+  block_bit_lengths_ =
+    reinterpret_cast<const uint64_t*>(section(num_blocks * sizeof(uint64_t)));
+  block_path_ids_ =
+    reinterpret_cast<const int16_t*>(section(num_blocks * sizeof(int16_t)));
+  name_offsets_ = reinterpret_cast<const uint64_t*>(
+    section((num_blocks + 1) * sizeof(uint64_t)));
+  name_chars_ = section(header_->name_table_size);
+  input_net_offsets_ = reinterpret_cast<const uint64_t*>(
+    section((num_blocks + 1) * sizeof(uint64_t)));
+  input_net_chars_ = section(header_->input_net_table_size);
+  output_net_offsets_ = reinterpret_cast<const uint64_t*>(
+    section((num_blocks + 1) * sizeof(uint64_t)));
+  output_net_chars_ = section(header_->output_net_table_size);
+  bit_words_ = reinterpret_cast<const uint64_t*>(
+    section((header_->num_bits + 63) / 64 * sizeof(uint64_t)));
+
+  /* Check the references between sections, so that the accessors are safe */
+  check_bin_arch_bitstream_string_table(fname.c_str(), child_offsets_,
+                                        num_blocks, header_->num_child_blocks,
+                                        "child block");
+  check_bin_arch_bitstream_string_table(fname.c_str(), name_offsets_,
+                                        num_blocks, header_->name_table_size,
+                                        "block name");
+  check_bin_arch_bitstream_string_table(
+    fname.c_str(), input_net_offsets_, num_blocks,
+    header_->input_net_table_size, "input net");
+  check_bin_arch_bitstream_string_table(
+    fname.c_str(), output_net_offsets_, num_blocks,
+    header_->output_net_table_size, "output net");
+  for (size_t iblk = 0; iblk < num_blocks; ++iblk) {
+    if ((BIN_ARCH_BITSTREAM_NO_BLOCK != block_parents_[iblk]) &&
+        (block_parents_[iblk] >= num_blocks)) {
+      archfpga_throw(fname.c_str(), 0,
+                     "Invalid parent of block %lu in binary bitstream file!\n",
+                     iblk);
+    }
+    if ((block_bit_lsbs_[iblk] > header_->num_bits) ||
+        (block_bit_lengths_[iblk] >
+         header_->num_bits - block_bit_lsbs_[iblk])) {
+      archfpga_throw(fname.c_str(), 0,
+                     "Invalid bits of block %lu in binary bitstream file!\n",
+                     iblk);
+    }
+  }
+  for (size_t ichild = 0; ichild < header_->num_child_blocks; ++ichild) {
+    if (child_blocks_[ichild] >= num_blocks) {
+      archfpga_throw(fname.c_str(), 0,
+                     "Invalid child block in binary bitstream file!\n");
+    }
+  }
+}
+
+/************************************************************************
+ * Public Accessors
+ ***********************************************************************/
+size_t BinArchBitstreamFile::num_blocks() const {
+  return nullptr == header_ ? 0 : header_->num_blocks;
+}
+
+size_t BinArchBitstreamFile::num_bits() const {
+  return nullptr == header_ ? 0 : header_->num_bits;
+}
+
+ConfigBlockId BinArchBitstreamFile::block_parent(
+  const ConfigBlockId& block_id) const {
+  VTR_ASSERT(size_t(block_id) < num_blocks());
+  if (BIN_ARCH_BITSTREAM_NO_BLOCK == block_parents_[size_t(block_id)]) {
+    return ConfigBlockId::INVALID();
+  }
+  return ConfigBlockId(size_t(block_parents_[size_t(block_id)]));
+}
+
+size_t BinArchBitstreamFile::num_block_children(
+  const ConfigBlockId& block_id) const {
+  VTR_ASSERT(size_t(block_id) < num_blocks());
+  return child_offsets_[size_t(block_id) + 1] -
+         child_offsets_[size_t(block_id)];
+}
+
+ConfigBlockId BinArchBitstreamFile::block_child(const ConfigBlockId& block_id,
+                                                const size_t& ichild) const {
+  VTR_ASSERT(ichild < num_block_children(block_id));
+  size_t child_offset = child_offsets_[size_t(block_id)] + ichild;
+  return ConfigBlockId(size_t(child_blocks_[child_offset]));
+}
+
+size_t BinArchBitstreamFile::block_bit_lsb(
+  const ConfigBlockId& block_id) const {
+  VTR_ASSERT(size_t(block_id) < num_blocks());
+  return block_bit_lsbs_[size_t(block_id)];
+}
+
+size_t BinArchBitstreamFile::block_bit_length(
+  const ConfigBlockId& block_id) const {
+  VTR_ASSERT(size_t(block_id) < num_blocks());
+  return block_bit_lengths_[size_t(block_id)];
+}
+
+int BinArchBitstreamFile::block_path_id(const ConfigBlockId& block_id) const {
+  VTR_ASSERT(size_t(block_id) < num_blocks());
+  return block_path_ids_[size_t(block_id)];
+}
+
+std::string_view BinArchBitstreamFile::block_name(
+  const ConfigBlockId& block_id) const {
+  VTR_ASSERT(size_t(block_id) < num_blocks());
+  size_t begin = name_offsets_[size_t(block_id)];
+  return std::string_view(name_chars_ + begin,
+                          name_offsets_[size_t(block_id) + 1] - begin);
+}
+
+std::string_view BinArchBitstreamFile::block_input_net_ids(
+  const ConfigBlockId& block_id) const {
+  VTR_ASSERT(size_t(block_id) < num_blocks());
+  size_t begin = input_net_offsets_[size_t(block_id)];
+  return std::string_view(input_net_chars_ + begin,
+                          input_net_offsets_[size_t(block_id) + 1] - begin);
+}
+
+std::string_view BinArchBitstreamFile::block_output_net_ids(
+  const ConfigBlockId& block_id) const {
+  VTR_ASSERT(size_t(block_id) < num_blocks());
+  size_t begin = output_net_offsets_[size_t(block_id)];
+  return std::string_view(output_net_chars_ + begin,
+                          output_net_offsets_[size_t(block_id) + 1] - begin);
+}
+
+bool BinArchBitstreamFile::bit_value(const size_t& bit) const {
+  VTR_ASSERT(bit < num_bits());
+  return 0 != ((bit_words_[bit / 64] >> (bit % 64)) & 1);
+}
+
+/************************************************************************
+ * Internal utility
+ ***********************************************************************/
+/* Find the next section of the file, and error out if the file is too short */
+const char* BinArchBitstreamFile::section(const size_t& num_bytes) {
+  size_t section_size = bin_arch_bitstream_section_size(num_bytes);
+  if (section_size > file_.size() - offset_) {
+    archfpga_throw(fname_.c_str(), 0,
+                   "Unexpected end of binary bitstream file!\n");
+  }
+  const char* data = file_.data() + offset_;
+  offset_ += section_size;
+  return data;
+}
+
+/********************************************************************
+ * Check if a file starts with the magic number of the binary format
+ *******************************************************************/
+bool is_bin_architecture_bitstream_file(const char* fname) {
+  std::ifstream fp(fname, std::ios::in | std::ios::binary);
+  char magic[sizeof(BIN_ARCH_BITSTREAM_MAGIC)];
+  if (!fp.read(magic, sizeof(magic))) {
+    return false;
+  }
+  return 0 == std::memcmp(magic, BIN_ARCH_BITSTREAM_MAGIC, sizeof(magic));
+}
+
+/********************************************************************
+ * Read a binary file to an object of BitstreamManager
+ * Blocks are created in the order of their ids, and bits are added
+ * block by block in the order of their ids, so that the ids are the
+ * same as the ids of the BitstreamManager which was written
+ *******************************************************************/
+BitstreamManager read_bin_architecture_bitstream(const char* fname) {
+  vtr::ScopedStartFinishTimer timer("Read Architecture Bitstream binary file");
+
+  BinArchBitstreamFile bin_file;
+  bin_file.open(std::string(fname));
+
+  BitstreamManager bitstream_manager;
+  bitstream_manager.reserve_blocks(bin_file.num_blocks());
+  bitstream_manager.reserve_bits(bin_file.num_bits());
+
+  std::vector<ConfigBlockId> bit_blocks;
+  for (size_t iblk = 0; iblk < bin_file.num_blocks(); ++iblk) {
+    ConfigBlockId blk = ConfigBlockId(iblk);
+    bitstream_manager.add_block(std::string(bin_file.block_name(blk)));
+    /* -2 is an invalid value defined in the bitstream manager internally */
+    if (-2 < bin_file.block_path_id(blk)) {
+      bitstream_manager.add_path_id_to_block(blk, bin_file.block_path_id(blk));
+    }
+    if (false == bin_file.block_input_net_ids(blk).empty()) {
+      bitstream_manager.add_input_net_id_to_block(
+        blk, std::string(bin_file.block_input_net_ids(blk)));
+    }
+    if (false == bin_file.block_output_net_ids(blk).empty()) {
+      bitstream_manager.add_output_net_id_to_block(
+        blk, std::string(bin_file.block_output_net_ids(blk)));
+    }
+    if (0 < bin_file.block_bit_length(blk)) {
+      bit_blocks.push_back(blk);
+    }
+  }
+
+  for (size_t iblk = 0; iblk < bin_file.num_blocks(); ++iblk) {
+    ConfigBlockId blk = ConfigBlockId(iblk);
+    size_t num_children = bin_file.num_block_children(blk);
+    bitstream_manager.reserve_child_blocks(blk, num_children);
+    for (size_t ichild = 0; ichild < num_children; ++ichild) {
+      ConfigBlockId child_blk = bin_file.block_child(blk, ichild);
+      if (bin_file.block_parent(child_blk) != blk) {
+        archfpga_throw(fname, 0,
+                       "Inconsistent parent of block %lu in binary bitstream "
+                       "file!\n",
+                       size_t(child_blk));
+      }
+      bitstream_manager.add_child_block(blk, child_blk);
+    }
+  }
+
+  /* The bits of each block are contiguous, and blocks own bits in the order
+   * of their first bits */
+  std::sort(bit_blocks.begin(), bit_blocks.end(),
+            [&](const ConfigBlockId& a, const ConfigBlockId& b) {
+              return bin_file.block_bit_lsb(a) < bin_file.block_bit_lsb(b);
+            });
+  for (const ConfigBlockId& blk : bit_blocks) {
+    if (bitstream_manager.num_bits() != bin_file.block_bit_lsb(blk)) {
+      archfpga_throw(fname, 0,
+                     "Bits of block %lu are not contiguous in binary "
+                     "bitstream file!\n",
+                     size_t(blk));
+    }
+    size_t lsb = bin_file.block_bit_lsb(blk);
+    for (size_t ibit = 0; ibit < bin_file.block_bit_length(blk); ++ibit) {
+      bitstream_manager.add_bit(blk, bin_file.bit_value(lsb + ibit));
+    }
+  }
+  if (bitstream_manager.num_bits() != bin_file.num_bits()) {
+    archfpga_throw(fname, 0,
+                   "Some bits are not owned by any block in binary bitstream "
+                   "file!\n");
+  }
+
+  return bitstream_manager;
+}
+
+} /* end namespace openfpga */
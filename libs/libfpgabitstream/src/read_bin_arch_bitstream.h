@@ -0,0 +1,81 @@
+#ifndef READ_BIN_ARCH_BITSTREAM_H
+#define READ_BIN_ARCH_BITSTREAM_H
+
+/********************************************************************
+ * Include header files that are required by function declaration
+ *******************************************************************/
+#include <string>
+#include <string_view>
+
+#include "bin_arch_bitstream_format.h"
+#include "bitstream_manager.h"
+#include "openfpga_mapped_file.h"
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+/********************************************************************
+ * A read-only view on a binary file of the architecture bitstream
+ * database. The file is memory-mapped and all the accessors read the
+ * file in place, so that a database can be inspected without being
+ * copied to a BitstreamManager.
+ * The ids of blocks and bits are the same as the ids in the
+ * BitstreamManager which was written to the file.
+ *******************************************************************/
+class BinArchBitstreamFile {
+ public: /* Constructors */
+  BinArchBitstreamFile();
+
+ public: /* Public mutators */
+  /* Open and check a binary file. Error out if the file is invalid */
+  void open(const std::string& fname);
+
+ public: /* Public accessors */
+  size_t num_blocks() const;
+  size_t num_bits() const;
+
+  /* Parent of a block, or an invalid id for the root blocks */
+  ConfigBlockId block_parent(const ConfigBlockId& block_id) const;
+  size_t num_block_children(const ConfigBlockId& block_id) const;
+  ConfigBlockId block_child(const ConfigBlockId& block_id,
+                            const size_t& ichild) const;
+  /* First bit and number of bits of a block */
+  size_t block_bit_lsb(const ConfigBlockId& block_id) const;
+  size_t block_bit_length(const ConfigBlockId& block_id) const;
+  int block_path_id(const ConfigBlockId& block_id) const;
+  std::string_view block_name(const ConfigBlockId& block_id) const;
+  std::string_view block_input_net_ids(const ConfigBlockId& block_id) const;
+  std::string_view block_output_net_ids(const ConfigBlockId& block_id) const;
+  bool bit_value(const size_t& bit) const;
+
+ private: /* Internal utility */
+  const char* section(const size_t& num_bytes);
+
+ private: /* Internal data */
+  MappedFile file_;
+  std::string fname_;
+  size_t offset_;
+  const BinArchBitstreamHeader* header_;
+  const uint32_t* block_parents_;
+  const uint64_t* child_offsets_;
+  const uint32_t* child_blocks_;
+  const uint64_t* block_bit_lsbs_;
+  const uint64_t* block_bit_lengths_;
+  const int16_t* block_path_ids_;
+  const uint64_t* name_offsets_;
+  const char* name_chars_;
+  const uint64_t* input_net_offsets_;
+  const char* input_net_chars_;
+  const uint64_t* output_net_offsets_;
+  const char* output_net_chars_;
+  const uint64_t* bit_words_;
+};
+
+/* Check if a file starts with the magic number of the binary format */
+bool is_bin_architecture_bitstream_file(const char* fname);
+
+BitstreamManager read_bin_architecture_bitstream(const char* fname);
+
+} /* end namespace openfpga */
+
+#endif
@@ -0,0 +1,223 @@
+/********************************************************************
+ * This file includes the functions which read a fabric bitstream in
+ * plain text, as written by write_fabric_bitstream
+ *******************************************************************/
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+
+/* Headers from vtr util library */
+#include "vtr_assert.h"
+#include "vtr_log.h"
+
+/* Headers from libarchfpga */
+#include "arch_error.h"
+#include "read_text_fabric_bitstream.h"
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+/********************************************************************
+ * Remove the leading and trailing spaces of a string
+ *******************************************************************/
+static std::string_view trim_text_fabric_bitstream_spaces(
+  std::string_view text) {
+  size_t begin = text.find_first_not_of(' ');
+  if (std::string_view::npos == begin) {
+    return std::string_view();
+  }
+  size_t end = text.find_last_not_of(' ');
+  return text.substr(begin, end - begin + 1);
+}
+
+/************************************************************************
+ * Constructors
+ ***********************************************************************/
+TextFabricBitstreamFile::TextFabricBitstreamFile()
+  : num_bits_(0), num_ones_(0), num_dont_care_bits_(0) {}
+
+/************************************************************************
+ * Public Mutators
+ ***********************************************************************/
+void TextFabricBitstreamFile::open(const std::string& fname) {
+  fields_.clear();
+  lines_.clear();
+  num_bits_ = 0;
+  num_ones_ = 0;
+  num_dont_care_bits_ = 0;
+  if (false == file_.open(fname)) {
+    archfpga_throw(fname.c_str(), 0, "Unable to open file '%s'!\n",
+                   fname.c_str());
+  }
+
+  const char* data = file_.data();
+  size_t size = file_.size();
+  size_t pos = 0;
+  size_t file_line = 0;
+  while (pos < size) {
+    /* Line breaks are found by memchr(), which scans the file by vectors of
+     * characters */
+    const char* eol =
+      static_cast<const char*>(std::memchr(data + pos, '\n', size - pos));
+    size_t end = (nullptr == eol) ? size : size_t(eol - data);
+    size_t next = end + 1;
+    file_line++;
+    /* Accept the line breaks of Windows */
+    if ((end > pos) && ('\r' == data[end - 1])) {
+      end--;
+    }
+    std::string_view text(data + pos, end - pos);
+    pos = next;
+
+    if (0 == text.compare(0, 2, "//")) {
+      /* Comment line: record the fields '<key>: <value>' */
+      std::string_view comment = text.substr(2);
+      size_t colon = comment.find(':');
+      if (std::string_view::npos != colon) {
+        fields_.emplace_back(
+          trim_text_fabric_bitstream_spaces(comment.substr(0, colon)),
+          trim_text_fabric_bitstream_spaces(comment.substr(colon + 1)));
+      }
+      continue;
+    }
+    if (true == text.empty()) {
+      continue;
+    }
+
+    /* Data line: the counts are vectorized by the compiler, and any other
+     * character than '0', '1' and 'x' is found by the sum of the counts */
+    size_t num_zeros = std::count(text.begin(), text.end(), '0');
+    size_t num_ones = std::count(text.begin(), text.end(), '1');
+    size_t num_dont_care_bits = std::count(text.begin(), text.end(), 'x');
+    if (num_zeros + num_ones + num_dont_care_bits != text.size()) {
+      archfpga_throw(fname.c_str(), file_line,
+                     "Invalid character in fabric bitstream! Expect only "
+                     "'0', '1' or 'x'\n");
+    }
+    lines_.emplace_back(size_t(text.data() - data), text.size());
+    num_bits_ += text.size();
+    num_ones_ += num_ones;
+    num_dont_care_bits_ += num_dont_care_bits;
+  }
+}
+
+/************************************************************************
+ * Public Accessors
+ ***********************************************************************/
+std::string_view TextFabricBitstreamFile::field(std::string_view key) const {
+  for (const auto& curr_field : fields_) {
+    if (key == curr_field.first) {
+      return curr_field.second;
+    }
+  }
+  return std::string_view();
+}
+
+const std::vector<std::pair<std::string_view, std::string_view>>&
+TextFabricBitstreamFile::fields() const {
+  return fields_;
+}
+
+size_t TextFabricBitstreamFile::num_lines() const { return lines_.size(); }
+
+std::string_view TextFabricBitstreamFile::line(const size_t& iline) const {
+  VTR_ASSERT(iline < lines_.size());
+  return std::string_view(file_.data() + lines_[iline].first,
+                          lines_[iline].second);
+}
+
+size_t TextFabricBitstreamFile::num_bits() const { return num_bits_; }
+
+size_t TextFabricBitstreamFile::num_ones() const { return num_ones_; }
+
+size_t TextFabricBitstreamFile::num_dont_care_bits() const {
+  return num_dont_care_bits_;
+}
+
+/********************************************************************
+ * Sum all the numbers in a field, e.g., the width of each part of a line
+ * '<bl_address 4 bits><wl_address 3 bits><data input 1 bits>'
+ *******************************************************************/
+static size_t sum_text_fabric_bitstream_field_numbers(std::string_view text) {
+  size_t sum = 0;
+  size_t number = 0;
+  for (const char& curr_char : text) {
+    if (('0' <= curr_char) && ('9' >= curr_char)) {
+      number = number * 10 + size_t(curr_char - '0');
+    } else {
+      sum += number;
+      number = 0;
+    }
+  }
+  return sum + number;
+}
+
+/********************************************************************
+ * Check that the data lines are consistent with the fields of the file
+ * - For shift register banks, each word has a number of BL vectors and
+ *   a number of WL vectors
+ * - For flatten bitstreams, which have no width, all the bits are in a
+ *   single line
+ * - For the other protocols, each line is a configuration cycle with
+ *   the given width
+ *******************************************************************/
+size_t check_text_fabric_bitstream_file(
+  const TextFabricBitstreamFile& bitstream_file) {
+  size_t num_errors = 0;
+
+  std::string_view word_count = bitstream_file.field("Bitstream word count");
+  if (false == word_count.empty()) {
+    size_t num_words = sum_text_fabric_bitstream_field_numbers(word_count);
+    size_t num_lines_per_word =
+      sum_text_fabric_bitstream_field_numbers(
+        bitstream_file.field("Bitstream bl word size")) +
+      sum_text_fabric_bitstream_field_numbers(
+        bitstream_file.field("Bitstream wl word size"));
+    if (num_words * num_lines_per_word != bitstream_file.num_lines()) {
+      VTR_LOG_ERROR("Expect %lu lines in %lu words but found %lu lines!\n",
+                    num_words * num_lines_per_word, num_words,
+                    bitstream_file.num_lines());
+      num_errors++;
+    }
+    return num_errors;
+  }
+
+  std::string_view length = bitstream_file.field("Bitstream length");
+  if (true == length.empty()) {
+    VTR_LOG_ERROR("Missing bitstream length in fabric bitstream!\n");
+    return 1;
+  }
+  size_t num_cycles = sum_text_fabric_bitstream_field_numbers(length);
+
+  std::string_view width = bitstream_file.field("Bitstream width (LSB -> MSB)");
+  if (true == width.empty()) {
+    if (num_cycles != bitstream_file.num_bits()) {
+      VTR_LOG_ERROR("Expect %lu bits but found %lu bits!\n", num_cycles,
+                    bitstream_file.num_bits());
+      num_errors++;
+    }
+    return num_errors;
+  }
+
+  if (num_cycles != bitstream_file.num_lines()) {
+    VTR_LOG_ERROR("Expect %lu lines but found %lu lines!\n", num_cycles,
+                  bitstream_file.num_lines());
+    num_errors++;
+  }
+  size_t line_width = sum_text_fabric_bitstream_field_numbers(width);
+  size_t num_invalid_lines = 0;
+  for (size_t iline = 0; iline < bitstream_file.num_lines(); ++iline) {
+    if (line_width != bitstream_file.line(iline).size()) {
+      num_invalid_lines++;
+    }
+  }
+  if (0 < num_invalid_lines) {
+    VTR_LOG_ERROR("Found %lu lines whose width is not %lu bits!\n",
+                  num_invalid_lines, line_width);
+    num_errors++;
+  }
+
+  return num_errors;
+}
+
+} /* end namespace openfpga */
@@ -0,0 +1,70 @@
+#ifndef READ_TEXT_FABRIC_BITSTREAM_H
+#define READ_TEXT_FABRIC_BITSTREAM_H
+
+/********************************************************************
+ * Include header files that are required by function declaration
+ *******************************************************************/
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "openfpga_mapped_file.h"
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+/********************************************************************
+ * A read-only view on a fabric bitstream in plain text, as written by
+ * the command write_fabric_bitstream for any configuration protocol.
+ * Such a file contains
+ * - comment lines starting with '//'. The comments in the form of
+ *   '// <key>: <value>' are fields describing the bitstream, e.g.,
+ *   '// Bitstream length: 64'
+ * - data lines of '0', '1' and 'x' (don't care bits), e.g., the bit of
+ *   each region in a configuration cycle, or the address and data of a
+ *   configuration frame
+ * The file is memory-mapped and the accessors return views on the file,
+ * so that a bitstream can be inspected without being copied.
+ *******************************************************************/
+class TextFabricBitstreamFile {
+ public: /* Constructors */
+  TextFabricBitstreamFile();
+
+ public: /* Public mutators */
+  /* Open and parse a text file. Error out if the file is invalid */
+  void open(const std::string& fname);
+
+ public: /* Public accessors */
+  /* Value of the first field with a given key in the comments, or an empty
+   * string if there is no such field */
+  std::string_view field(std::string_view key) const;
+  /* All the fields '<key>: <value>' in the order of the file */
+  const std::vector<std::pair<std::string_view, std::string_view>>& fields()
+    const;
+  /* Number of the data lines, whose index does not count comment lines */
+  size_t num_lines() const;
+  std::string_view line(const size_t& iline) const;
+  /* Number of characters of all the data lines */
+  size_t num_bits() const;
+  size_t num_ones() const;
+  size_t num_dont_care_bits() const;
+
+ private: /* Internal data */
+  MappedFile file_;
+  std::vector<std::pair<std::string_view, std::string_view>> fields_;
+  /* First character and size of each data line in the file */
+  std::vector<std::pair<size_t, size_t>> lines_;
+  size_t num_bits_;
+  size_t num_ones_;
+  size_t num_dont_care_bits_;
+};
+
+/* Check that the data lines are consistent with the length and width given
+ * in the fields of the file. Return the number of errors */
+size_t check_text_fabric_bitstream_file(
+  const TextFabricBitstreamFile& bitstream_file);
+
+} /* end namespace openfpga */
+
+#endif
@@ -1,146 +1,144 @@
 /********************************************************************
  * This file includes the top-level function of this library
- * which reads an XML of a fabric key to the associated
+ * which reads an XML of an architecture bitstream to the associated
  * data structures
+ *
+ * The file is memory-mapped and parsed by a pull parser, so that no
+ * document object model is built: the memory footprint is bounded by
+ * the depth of the block hierarchy, on top of the bitstream database
  *******************************************************************/
 #include <string>
-
-/* Headers from pugi XML library */
-#include "pugixml.hpp"
-#include "pugixml_util.hpp"
+#include <vector>
 
 /* Headers from vtr util library */
 #include "vtr_assert.h"
 #include "vtr_time.h"
 
+/* Headers from openfpga util library */
+#include "openfpga_mapped_file.h"
+#include "openfpga_xml_pull_parser.h"
+
 /* Headers from libarchfpga */
 #include "arch_error.h"
 #include "openfpga_reserved_words.h"
 #include "read_xml_arch_bitstream.h"
-#include "read_xml_util.h"
 
 /* begin namespace openfpga */
 namespace openfpga {
 
 /********************************************************************
- * Parse XML codes of a <bitstream_block> to an object of BitstreamManager
- * This function goes recursively until we reach the leaf node
+ * Error out on an unexpected child of an XML element
  *******************************************************************/
-static void rec_read_xml_bitstream_block(pugi::xml_node& xml_bitstream_block,
-                                         const pugiutil::loc_data& loc_data,
-                                         BitstreamManager& bitstream_manager,
-                                         const ConfigBlockId& parent_block) {
-  /* Find the name of this bitstream block */
-  const std::string& block_name =
-    get_attribute(xml_bitstream_block, "name", loc_data).as_string();
-
-  /* Create the bitstream block */
-  ConfigBlockId curr_block = bitstream_manager.add_block(block_name);
-
-  /* Add it to parent block */
-  bitstream_manager.add_child_block(parent_block, curr_block);
-
-  /* Parse input nets if defined */
-  pugi::xml_node xml_input_nets = get_single_child(
-    xml_bitstream_block, "input_nets", loc_data, pugiutil::ReqOpt::OPTIONAL);
-  if (xml_input_nets) {
-    std::vector<std::string> input_nets;
-    size_t num_input_nets = count_children(xml_input_nets, "path", loc_data,
-                                           pugiutil::ReqOpt::OPTIONAL);
-    input_nets.resize(num_input_nets);
-
-    /* Find the child paths/nets */
-    for (pugi::xml_node xml_input_net : xml_input_nets.children()) {
-      /* We only care child bitstream blocks here */
-      if (xml_input_net.name() != std::string("path")) {
-        bad_tag(xml_input_net, loc_data, xml_input_nets, {"path"});
-      }
-      const int& id = get_attribute(xml_input_net, "id", loc_data).as_int();
-      const std::string& net_name =
-        get_attribute(xml_input_net, "net_name", loc_data).as_string();
-      VTR_ASSERT((size_t)id < input_nets.size());
-      input_nets[id] = net_name;
-    }
+static void bad_xml_child(const XmlPullParser& parser,
+                          const std::string& parent_name,
+                          const std::string& expected_name) {
+  throw XmlPullParserError(std::string("Unexpected child element <") +
+                             parser.name() + "> in <" + parent_name +
+                             ">, expect <" + expected_name + ">",
+                           parser.line());
+}
 
-    std::string input_nets_str;
-    bool need_splitter = false;
-    for (const std::string& input_net : input_nets) {
-      if (true == need_splitter) {
-        input_nets_str += std::string(" ");
-      }
-      input_nets_str += input_net;
-      need_splitter = true;
-    }
-    bitstream_manager.add_input_net_id_to_block(curr_block, input_nets_str);
-  }
+/********************************************************************
+ * Parse XML codes of <input_nets> or <output_nets> to a string, where
+ * the net names are joined by spaces in the order of path ids
+ * The parser should stand on the start element of the nets, and will
+ * stand on its end element when the function returns
+ *******************************************************************/
+static std::string read_xml_bitstream_block_nets(XmlPullParser& parser) {
+  const std::string nets_name = parser.name();
+  std::vector<std::string> nets;
 
-  /* Parse output nets if defined */
-  pugi::xml_node xml_output_nets = get_single_child(
-    xml_bitstream_block, "output_nets", loc_data, pugiutil::ReqOpt::OPTIONAL);
-  if (xml_output_nets) {
-    std::vector<std::string> output_nets;
-    size_t num_output_nets = count_children(xml_output_nets, "path", loc_data,
-                                            pugiutil::ReqOpt::OPTIONAL);
-    output_nets.resize(num_output_nets);
-
-    /* Find the child paths/nets */
-    for (pugi::xml_node xml_output_net : xml_output_nets.children()) {
-      /* We only care child bitstream blocks here */
-      if (xml_output_net.name() != std::string("path")) {
-        bad_tag(xml_output_net, loc_data, xml_output_nets, {"path"});
-      }
-      const int& id = get_attribute(xml_output_net, "id", loc_data).as_int();
-      const std::string& net_name =
-        get_attribute(xml_output_net, "net_name", loc_data).as_string();
-      VTR_ASSERT((size_t)id < output_nets.size());
-      output_nets[id] = net_name;
+  while (XmlPullParser::e_event::END_ELEMENT != parser.next()) {
+    if (parser.name() != std::string("path")) {
+      bad_xml_child(parser, nets_name, "path");
     }
-
-    std::string output_nets_str;
-    bool need_splitter = false;
-    for (const std::string& output_net : output_nets) {
-      if (true == need_splitter) {
-        output_nets_str += std::string(" ");
-      }
-      output_nets_str += output_net;
-      need_splitter = true;
+    const int id = parser.int_attribute("id");
+    if (0 > id) {
+      throw XmlPullParserError(std::string("Invalid path id in <path>"),
+                               parser.line());
     }
-    bitstream_manager.add_output_net_id_to_block(curr_block, output_nets_str);
+    if (size_t(id) >= nets.size()) {
+      nets.resize(id + 1);
+    }
+    nets[id] = parser.attribute("net_name");
+    parser.skip_element();
   }
 
-  /* Parse configuration bits */
-  pugi::xml_node xml_bitstream = get_single_child(
-    xml_bitstream_block, "bitstream", loc_data, pugiutil::ReqOpt::OPTIONAL);
-  if (xml_bitstream) {
-    /* Parse path_id: -2 is an invalid value defined in the bitstream manager
-     * internally */
-    const int& path_id = get_attribute(xml_bitstream, "path_id", loc_data,
-                                       pugiutil::ReqOpt::OPTIONAL)
-                           .as_int(-2);
-    if (-2 < path_id) {
-      bitstream_manager.add_path_id_to_block(curr_block, path_id);
+  std::string nets_str;
+  bool need_splitter = false;
+  for (const std::string& net : nets) {
+    if (true == need_splitter) {
+      nets_str += std::string(" ");
     }
+    nets_str += net;
+    need_splitter = true;
+  }
+  return nets_str;
+}
 
-    /* Find the child paths/nets */
-    std::vector<bool> block_bits;
-    for (pugi::xml_node xml_bit : xml_bitstream.children()) {
-      /* We only care child bitstream blocks here */
-      if (xml_bit.name() != std::string("bit")) {
-        bad_tag(xml_bit, loc_data, xml_bitstream, {"bit"});
-      }
-      const int& bit_value = get_attribute(xml_bit, "value", loc_data).as_int();
-      block_bits.push_back(1 == bit_value);
+/********************************************************************
+ * Parse XML codes of a <bitstream> to the bits of a block
+ * The parser should stand on the start element of the bitstream, and
+ * will stand on its end element when the function returns
+ *******************************************************************/
+static void read_xml_bitstream_block_bits(XmlPullParser& parser,
+                                          BitstreamManager& bitstream_manager,
+                                          const ConfigBlockId& curr_block) {
+  /* Parse path_id: -2 is an invalid value defined in the bitstream manager
+   * internally */
+  const int path_id = parser.int_attribute("path_id", -2);
+  if (-2 < path_id) {
+    bitstream_manager.add_path_id_to_block(curr_block, path_id);
+  }
+
+  while (XmlPullParser::e_event::END_ELEMENT != parser.next()) {
+    if (parser.name() != std::string("bit")) {
+      bad_xml_child(parser, "bitstream", "bit");
     }
+    const int bit_value = parser.int_attribute("value");
     /* Link the bit to parent block */
-    bitstream_manager.add_block_bits(curr_block, block_bits);
+    bitstream_manager.add_bit(curr_block, 1 == bit_value);
+    parser.skip_element();
   }
+}
 
-  /* Go recursively: find all the child blocks and parse */
-  for (pugi::xml_node xml_child : xml_bitstream_block.children()) {
-    /* We only care child bitstream blocks here */
-    if (xml_child.name() == std::string("bitstream_block")) {
-      rec_read_xml_bitstream_block(xml_child, loc_data, bitstream_manager,
-                                   curr_block);
+/********************************************************************
+ * Parse XML codes of a <bitstream_block> to an object of BitstreamManager
+ * The block is created when its start element is met, and its children
+ * are parsed in the order they appear in the file
+ * The parser should stand on the start element of the block, and will
+ * stand on its end element when the function returns
+ *******************************************************************/
+static void rec_read_xml_bitstream_block(XmlPullParser& parser,
+                                         BitstreamManager& bitstream_manager,
+                                         const ConfigBlockId& curr_block) {
+  bool bitstream_found = false;
+
+  while (XmlPullParser::e_event::END_ELEMENT != parser.next()) {
+    if (parser.name() == std::string("bitstream_block")) {
+      /* Create the bitstream block and add it to parent block */
+      ConfigBlockId child_block =
+        bitstream_manager.add_block(parser.attribute("name"));
+      bitstream_manager.add_child_block(curr_block, child_block);
+      /* Go recursively */
+      rec_read_xml_bitstream_block(parser, bitstream_manager, child_block);
+    } else if (parser.name() == std::string("input_nets")) {
+      bitstream_manager.add_input_net_id_to_block(
+        curr_block, read_xml_bitstream_block_nets(parser));
+    } else if (parser.name() == std::string("output_nets")) {
+      bitstream_manager.add_output_net_id_to_block(
+        curr_block, read_xml_bitstream_block_nets(parser));
+    } else if (parser.name() == std::string("bitstream")) {
+      if (true == bitstream_found) {
+        throw XmlPullParserError(
+          std::string("Multiple <bitstream> defined in a <bitstream_block>"),
+          parser.line());
+      }
+      bitstream_found = true;
+      read_xml_bitstream_block_bits(parser, bitstream_manager, curr_block);
+    } else {
+      /* Other children, e.g., <hierarchy>, are not needed by the database */
+      parser.skip_element();
     }
   }
 }
@@ -153,24 +151,25 @@ BitstreamManager read_xml_architecture_bitstream(const char* fname) {
 
   BitstreamManager bitstream_manager;
 
-  /* Parse the file */
-  pugi::xml_document doc;
-  pugiutil::loc_data loc_data;
-
-  try {
-    loc_data = pugiutil::load_xml(doc, fname);
+  MappedFile xml_file;
+  if (false == xml_file.open(std::string(fname))) {
+    archfpga_throw(fname, 0, "Unable to open file '%s'!\n", fname);
+  }
 
-    /* Count the child <bitstream_block> */
+  XmlPullParser parser(xml_file.data(), xml_file.data() + xml_file.size());
 
-    pugi::xml_node xml_root =
-      get_single_child(doc, "bitstream_block", loc_data);
+  try {
+    if ((XmlPullParser::e_event::START_ELEMENT != parser.next()) ||
+        (parser.name() != std::string("bitstream_block"))) {
+      archfpga_throw(fname, parser.line(),
+                     "Expect a root element <bitstream_block>!\n");
+    }
 
     /* Find the name of the top block*/
-    const std::string& top_block_name =
-      get_attribute(xml_root, "name", loc_data).as_string();
+    const std::string top_block_name = parser.attribute("name");
 
     if (top_block_name != std::string(FPGA_TOP_MODULE_NAME)) {
-      archfpga_throw(loc_data.filename_c_str(), loc_data.line(xml_root),
+      archfpga_throw(fname, parser.line(),
                      "Top-level block must be named as '%s'!\n",
                      FPGA_TOP_MODULE_NAME);
     }
@@ -178,24 +177,21 @@ BitstreamManager read_xml_architecture_bitstream(const char* fname) {
     /* Create the top-level block */
     ConfigBlockId top_block = bitstream_manager.add_block(top_block_name);
 
-    size_t num_blks = count_children(xml_root, "bitstream_block", loc_data,
-                                     pugiutil::ReqOpt::OPTIONAL);
-
-    /* Reserve bitstream blocks in the data base */
-    bitstream_manager.reserve_blocks(num_blks);
-
-    /* Iterate over the children under this node,
-     * each child should be named after circuit_model
-     */
-    for (pugi::xml_node xml_blk : xml_root.children()) {
+    /* Iterate over the children under this node */
+    while (XmlPullParser::e_event::END_ELEMENT != parser.next()) {
       /* Error out if the XML child has an invalid name! */
-      if (xml_blk.name() != std::string("bitstream_block")) {
-        bad_tag(xml_blk, loc_data, xml_root, {"bitstream_block"});
+      if (parser.name() != std::string("bitstream_block")) {
+        bad_xml_child(parser, "bitstream_block", "bitstream_block");
       }
-      rec_read_xml_bitstream_block(xml_blk, loc_data, bitstream_manager,
-                                   top_block);
+      ConfigBlockId child_block =
+        bitstream_manager.add_block(parser.attribute("name"));
+      bitstream_manager.add_child_block(top_block, child_block);
+      rec_read_xml_bitstream_block(parser, bitstream_manager, child_block);
     }
-  } catch (pugiutil::XmlError& e) {
+
+    /* Nothing but comments is expected after the root element */
+    parser.next();
+  } catch (XmlPullParserError& e) {
     archfpga_throw(fname, e.line(), "%s", e.what());
   }
 
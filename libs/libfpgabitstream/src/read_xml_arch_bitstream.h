@@ -5,8 +5,6 @@
  * Include header files that are required by function declaration
  *******************************************************************/
 #include "bitstream_manager.h"
-#include "pugixml.hpp"
-#include "pugixml_util.hpp"
 
 /********************************************************************
  * Function declaration
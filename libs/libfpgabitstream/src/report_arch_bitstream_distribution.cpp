@@ -28,11 +28,15 @@ namespace openfpga {
  * For block with child blocks, we visit each child recursively
  * The reporting can be stopped at a given maximum hierarchy level
  * which is used to limit the length of the report
+ * The numbers of bits under each block are counted in advance, see
+ * find_bitstream_manager_subtree_bit_counts()
  *******************************************************************/
 static void rec_report_block_bitstream_distribution_to_xml_file(
   std::fstream& fp, const BitstreamManager& bitstream_manager,
-  const ConfigBlockId& block, const size_t& max_hierarchy_level,
-  const size_t& hierarchy_level) {
+  const vtr::vector<ConfigBlockId, size_t>& block_num_bits,
+  const vtr::vector<ConfigBlockId, size_t>& block_num_ones,
+  const bool& count_ones, const ConfigBlockId& block,
+  const size_t& max_hierarchy_level, const size_t& hierarchy_level) {
   valid_file_stream(fp);
 
   if (hierarchy_level > max_hierarchy_level) {
@@ -43,17 +47,18 @@ static void rec_report_block_bitstream_distribution_to_xml_file(
   write_tab_to_file(fp, hierarchy_level);
   fp << "<block";
   fp << " name=\"" << bitstream_manager.block_name(block) << "\"";
-  fp << " number_of_bits=\""
-     << rec_find_bitstream_manager_block_sum_of_bits(bitstream_manager, block)
-     << "\"";
+  fp << " number_of_bits=\"" << block_num_bits[block] << "\"";
+  if (true == count_ones) {
+    fp << " number_of_ones=\"" << block_num_ones[block] << "\"";
+  }
   fp << ">" << std::endl;
 
   /* Dive to child blocks if this block has any */
   for (const ConfigBlockId& child_block :
        bitstream_manager.block_children(block)) {
     rec_report_block_bitstream_distribution_to_xml_file(
-      fp, bitstream_manager, child_block, max_hierarchy_level,
-      hierarchy_level + 1);
+      fp, bitstream_manager, block_num_bits, block_num_ones, count_ones,
+      child_block, max_hierarchy_level, hierarchy_level + 1);
   }
 
   write_tab_to_file(fp, hierarchy_level);
@@ -65,12 +70,16 @@ static void rec_report_block_bitstream_distribution_to_xml_file(
  * configuration bits per SB/CB/CLB
  * This function can generate a report to a file
  *
+ * Optionally, the number of bits with value '1' is reported for each block,
+ * e.g., to estimate the power of the configuration memories
+ *
  * Notes:
  *   - The output format is a table whose format is compatible with RST files
  *******************************************************************/
 int report_architecture_bitstream_distribution(
   std::fstream& fp, const BitstreamManager& bitstream_manager,
-  const size_t& max_hierarchy_level, const size_t& hierarchy_level) {
+  const size_t& max_hierarchy_level, const size_t& hierarchy_level,
+  const bool& count_ones) {
   std::string timer_message =
     std::string("Report architecture bitstream distribution");
   vtr::ScopedStartFinishTimer timer(timer_message);
@@ -88,10 +97,15 @@ int report_architecture_bitstream_distribution(
   /* Make sure we have only 1 top block */
   VTR_ASSERT(1 == top_block.size());
 
+  vtr::vector<ConfigBlockId, size_t> block_num_bits;
+  vtr::vector<ConfigBlockId, size_t> block_num_ones;
+  find_bitstream_manager_subtree_bit_counts(bitstream_manager, block_num_bits,
+                                            block_num_ones);
+
   /* Write bitstream, block by block, in a recursive way */
   rec_report_block_bitstream_distribution_to_xml_file(
-    fp, bitstream_manager, top_block[0], max_hierarchy_level + 2,
-    curr_level + 1);
+    fp, bitstream_manager, block_num_bits, block_num_ones, count_ones,
+    top_block[0], max_hierarchy_level + 2, curr_level + 1);
 
   write_tab_to_file(fp, curr_level);
   fp << "</blocks>" << std::endl;
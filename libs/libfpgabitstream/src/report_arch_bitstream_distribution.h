@@ -17,7 +17,8 @@ namespace openfpga {
 
 int report_architecture_bitstream_distribution(
   std::fstream& fp, const BitstreamManager& bitstream_manager,
-  const size_t& max_hierarchy_level, const size_t& hierarchy_level);
+  const size_t& max_hierarchy_level, const size_t& hierarchy_level,
+  const bool& count_ones = false);
 
 } /* end namespace openfpga */
 
@@ -0,0 +1,194 @@
+/********************************************************************
+ * This file includes functions that output bitstream database
+ * to a binary file, whose layout is detailed in
+ * bin_arch_bitstream_format.h
+ *******************************************************************/
+#include <cstring>
+#include <fstream>
+#include <vector>
+
+/* Headers from vtrutil library */
+#include "vtr_assert.h"
+#include "vtr_log.h"
+#include "vtr_time.h"
+
+/* Headers from openfpgautil library */
+#include "bin_arch_bitstream_format.h"
+#include "openfpga_digest.h"
+#include "write_bin_arch_bitstream.h"
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+/********************************************************************
+ * Write an array of plain values to a binary file, padded to the
+ * alignment of sections
+ *******************************************************************/
+template <class T>
+static void write_bin_arch_bitstream_section(std::fstream& fp,
+                                             const std::vector<T>& values) {
+  size_t num_bytes = values.size() * sizeof(T);
+  fp.write(reinterpret_cast<const char*>(values.data()), num_bytes);
+  const char padding[8] = {0, 0, 0, 0, 0, 0, 0, 0};
+  fp.write(padding, bin_arch_bitstream_section_size(num_bytes) - num_bytes);
+}
+
+/********************************************************************
+ * Build a string table: the offsets of the strings and their characters
+ *******************************************************************/
+static void build_bin_arch_bitstream_string_table(
+  const std::vector<std::string>& strings, std::vector<uint64_t>& offsets,
+  std::vector<char>& chars) {
+  offsets.clear();
+  chars.clear();
+  offsets.reserve(strings.size() + 1);
+  offsets.push_back(0);
+  for (const std::string& str : strings) {
+    chars.insert(chars.end(), str.begin(), str.end());
+    offsets.push_back(chars.size());
+  }
+}
+
+/********************************************************************
+ * Write the bitstream database to a binary file
+ * Return 0 if successful, otherwise return an error code
+ *******************************************************************/
+int write_bin_architecture_bitstream(const BitstreamManager& bitstream_manager,
+                                     const std::string& fname) {
+  /* Ensure that we have a valid file name */
+  if (true == fname.empty()) {
+    VTR_LOG_ERROR(
+      "Received empty file name to output bitstream!\n\tPlease specify a "
+      "valid file name.\n");
+    return 1;
+  }
+
+  std::string timer_message =
+    std::string("Write ") + std::to_string(bitstream_manager.bits().size()) +
+    std::string(" architecture bitstream into binary file '") + fname +
+    std::string("'");
+  vtr::ScopedStartFinishTimer timer(timer_message);
+
+  size_t num_blocks = bitstream_manager.num_blocks();
+  if (BIN_ARCH_BITSTREAM_NO_BLOCK <= num_blocks) {
+    VTR_LOG_ERROR(
+      "Too many blocks (%lu) in the bitstream database to be written into a "
+      "binary file!\n",
+      num_blocks);
+    return 1;
+  }
+
+  /* Collect the columns of the blocks */
+  std::vector<uint32_t> block_parents;
+  std::vector<uint64_t> child_offsets;
+  std::vector<uint32_t> child_blocks;
+  std::vector<uint64_t> block_bit_lsbs;
+  std::vector<uint64_t> block_bit_lengths;
+  std::vector<int16_t> block_path_ids;
+  std::vector<std::string> block_names;
+  std::vector<std::string> block_input_nets;
+  std::vector<std::string> block_output_nets;
+  block_parents.reserve(num_blocks);
+  child_offsets.reserve(num_blocks + 1);
+  child_offsets.push_back(0);
+  block_bit_lsbs.reserve(num_blocks);
+  block_bit_lengths.reserve(num_blocks);
+  block_path_ids.reserve(num_blocks);
+  block_names.reserve(num_blocks);
+  block_input_nets.reserve(num_blocks);
+  block_output_nets.reserve(num_blocks);
+
+  for (const ConfigBlockId& block : bitstream_manager.blocks()) {
+    ConfigBlockId parent_block = bitstream_manager.block_parent(block);
+    if (true == bitstream_manager.valid_block_id(parent_block)) {
+      block_parents.push_back(uint32_t(size_t(parent_block)));
+    } else {
+      block_parents.push_back(BIN_ARCH_BITSTREAM_NO_BLOCK);
+    }
+    for (const ConfigBlockId& child_block :
+         bitstream_manager.block_children(block)) {
+      child_blocks.push_back(uint32_t(size_t(child_block)));
+    }
+    child_offsets.push_back(child_blocks.size());
+
+    std::vector<ConfigBitId> block_bits = bitstream_manager.block_bits(block);
+    if (true == block_bits.empty()) {
+      block_bit_lsbs.push_back(0);
+    } else {
+      block_bit_lsbs.push_back(size_t(block_bits.front()));
+    }
+    block_bit_lengths.push_back(block_bits.size());
+
+    block_path_ids.push_back(int16_t(bitstream_manager.block_path_id(block)));
+    block_names.push_back(bitstream_manager.block_name(block));
+    block_input_nets.push_back(bitstream_manager.block_input_net_ids(block));
+    block_output_nets.push_back(bitstream_manager.block_output_net_ids(block));
+  }
+
+  std::vector<uint64_t> name_offsets;
+  std::vector<char> name_chars;
+  build_bin_arch_bitstream_string_table(block_names, name_offsets, name_chars);
+  std::vector<uint64_t> input_net_offsets;
+  std::vector<char> input_net_chars;
+  build_bin_arch_bitstream_string_table(block_input_nets, input_net_offsets,
+                                        input_net_chars);
+  std::vector<uint64_t> output_net_offsets;
+  std::vector<char> output_net_chars;
+  build_bin_arch_bitstream_string_table(block_output_nets, output_net_offsets,
+                                        output_net_chars);
+
+  /* Pack the bit values */
+  std::vector<uint64_t> bit_words((bitstream_manager.num_bits() + 63) / 64, 0);
+  for (const ConfigBitId& bit : bitstream_manager.bits()) {
+    if (true == bitstream_manager.bit_value(bit)) {
+      bit_words[size_t(bit) / 64] |= uint64_t(1) << (size_t(bit) % 64);
+    }
+  }
+
+  /* Create the file stream */
+  std::fstream fp;
+  fp.open(fname, std::fstream::out | std::fstream::trunc |
+                   std::fstream::binary);
+
+  check_file_stream(fname.c_str(), fp);
+
+  BinArchBitstreamHeader header;
+  std::memset(&header, 0, sizeof(header));
+  std::memcpy(header.magic, BIN_ARCH_BITSTREAM_MAGIC, sizeof(header.magic));
+  header.byte_order_mark = BIN_ARCH_BITSTREAM_BYTE_ORDER_MARK;
+  header.version = BIN_ARCH_BITSTREAM_VERSION;
+  header.num_blocks = num_blocks;
+  header.num_child_blocks = child_blocks.size();
+  header.num_bits = bitstream_manager.num_bits();
+  header.name_table_size = name_chars.size();
+  header.input_net_table_size = input_net_chars.size();
+  header.output_net_table_size = output_net_chars.size();
+  fp.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+  write_bin_arch_bitstream_section(fp, block_parents);
+  write_bin_arch_bitstream_section(fp, child_offsets);
+  write_bin_arch_bitstream_section(fp, child_blocks);
+  write_bin_arch_bitstream_section(fp, block_bit_lsbs);
+  write_bin_arch_bitstream_section(fp, block_bit_lengths);
+  write_bin_arch_bitstream_section(fp, block_path_ids);
+  write_bin_arch_bitstream_section(fp, name_offsets);
+  write_bin_arch_bitstream_section(fp, name_chars);
+  write_bin_arch_bitstream_section(fp, input_net_offsets);
+  write_bin_arch_bitstream_section(fp, input_net_chars);
+  write_bin_arch_bitstream_section(fp, output_net_offsets);
+  write_bin_arch_bitstream_section(fp, output_net_chars);
+  write_bin_arch_bitstream_section(fp, bit_words);
+
+  if (false == fp.good()) {
+    VTR_LOG_ERROR("Failed in writing binary file '%s'!\n", fname.c_str());
+    fp.close();
+    return 1;
+  }
+
+  /* Close file handler */
+  fp.close();
+
+  return 0;
+}
+
+} /* end namespace openfpga */
@@ -0,0 +1,23 @@
+#ifndef WRITE_BIN_ARCH_BITSTREAM_H
+#define WRITE_BIN_ARCH_BITSTREAM_H
+
+/********************************************************************
+ * Include header files that are required by function declaration
+ *******************************************************************/
+#include <string>
+
+#include "bitstream_manager.h"
+
+/********************************************************************
+ * Function declaration
+ *******************************************************************/
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+int write_bin_architecture_bitstream(const BitstreamManager& bitstream_manager,
+                                     const std::string& fname);
+
+} /* end namespace openfpga */
+
+#endif
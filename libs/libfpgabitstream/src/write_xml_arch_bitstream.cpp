@@ -2,9 +2,12 @@
  * This file includes functions that output bitstream database
  * to files in different formats
  *******************************************************************/
+#include <algorithm>
 #include <chrono>
 #include <ctime>
 #include <fstream>
+#include <string>
+#include <vector>
 
 /* Headers from vtrutil library */
 #include "vtr_assert.h"
@@ -14,6 +17,7 @@
 /* Headers from openfpgautil library */
 #include "bitstream_manager_utils.h"
 #include "openfpga_digest.h"
+#include "openfpga_parallel.h"
 #include "openfpga_reserved_words.h"
 #include "openfpga_tokenizer.h"
 #include "write_xml_arch_bitstream.h"
@@ -44,124 +48,188 @@ static void write_bitstream_xml_file_head(std::fstream& fp,
 }
 
 /********************************************************************
- * Recursively write the bitstream of a block to a xml file
- * This function will use a Depth-First Search in outputting bitstream
- * for each block
- * 1. For block with bits as children, we will output the XML lines
- * 2. For block without bits/child blocks, we can return
- * 3. For block with child blocks, we visit each child recursively
+ * Write the opening line of a block to a buffer
  *******************************************************************/
-static void rec_write_block_bitstream_to_xml_file(
-  std::fstream& fp, const BitstreamManager& bitstream_manager,
+static void write_block_bitstream_xml_head(
+  std::string& buffer, const BitstreamManager& bitstream_manager,
   const ConfigBlockId& block, const size_t& hierarchy_level) {
-  valid_file_stream(fp);
+  buffer.append(hierarchy_level, '\t');
+  buffer += "<bitstream_block name=\"";
+  buffer += bitstream_manager.block_name(block);
+  buffer += "\" hierarchy_level=\"";
+  append_number_to_buffer(buffer, hierarchy_level);
+  buffer += "\">\n";
+}
 
-  /* Write the bits of this block */
-  write_tab_to_file(fp, hierarchy_level);
-  fp << "<bitstream_block";
-  fp << " name=\"" << bitstream_manager.block_name(block) << "\"";
-  fp << " hierarchy_level=\"" << hierarchy_level << "\"";
-  fp << ">" << std::endl;
+/********************************************************************
+ * Write a list of nets of a block to a buffer
+ *******************************************************************/
+static void write_block_nets_xml(std::string& buffer,
+                                 const std::string& net_ids,
+                                 const std::string& tag,
+                                 const size_t& hierarchy_level) {
+  if (true == net_ids.empty()) {
+    return;
+  }
+  buffer.append(hierarchy_level + 1, '\t');
+  buffer += "<" + tag + ">\n";
+  size_t path_counter = 0;
+  /* Split with space */
+  StringToken net_tokenizer(net_ids);
+  for (const std::string& net : net_tokenizer.split(std::string(" "))) {
+    buffer.append(hierarchy_level + 2, '\t');
+    buffer += "<path id=\"";
+    append_number_to_buffer(buffer, path_counter);
+    buffer += "\" net_name=\"";
+    buffer += net;
+    buffer += "\"/>\n";
 
-  /* Dive to child blocks if this block has any */
-  for (const ConfigBlockId& child_block :
-       bitstream_manager.block_children(block)) {
-    rec_write_block_bitstream_to_xml_file(fp, bitstream_manager, child_block,
-                                          hierarchy_level + 1);
+    path_counter++;
   }
+  buffer.append(hierarchy_level + 1, '\t');
+  buffer += "</" + tag + ">\n";
+}
 
+/********************************************************************
+ * Write the content of a block after its child blocks to a buffer:
+ * its hierarchy, its nets and its bits if it has any, and the closing
+ * line of the block
+ *******************************************************************/
+static void write_block_bitstream_xml_tail(
+  std::string& buffer, const BitstreamManager& bitstream_manager,
+  const ConfigBlockId& block, const size_t& hierarchy_level,
+  const std::vector<ConfigBlockId>& block_hierarchy) {
   if (0 == bitstream_manager.block_bits(block).size()) {
-    write_tab_to_file(fp, hierarchy_level);
-    fp << "</bitstream_block>" << std::endl;
+    buffer.append(hierarchy_level, '\t');
+    buffer += "</bitstream_block>\n";
     return;
   }
 
-  std::vector<ConfigBlockId> block_hierarchy =
-    find_bitstream_manager_block_hierarchy(bitstream_manager, block);
-
   /* Output hierarchy of this parent*/
-  write_tab_to_file(fp, hierarchy_level + 1);
-  fp << "<hierarchy>" << std::endl;
+  buffer.append(hierarchy_level + 1, '\t');
+  buffer += "<hierarchy>\n";
   size_t hierarchy_counter = 0;
   for (const ConfigBlockId& temp_block : block_hierarchy) {
-    write_tab_to_file(fp, hierarchy_level + 2);
-    fp << "<instance level=\"" << hierarchy_counter << "\"";
-    fp << " name=\"" << bitstream_manager.block_name(temp_block) << "\"";
-    fp << "/>" << std::endl;
+    buffer.append(hierarchy_level + 2, '\t');
+    buffer += "<instance level=\"";
+    append_number_to_buffer(buffer, hierarchy_counter);
+    buffer += "\" name=\"";
+    buffer += bitstream_manager.block_name(temp_block);
+    buffer += "\"/>\n";
     hierarchy_counter++;
   }
-  write_tab_to_file(fp, hierarchy_level + 1);
-  fp << "</hierarchy>" << std::endl;
+  buffer.append(hierarchy_level + 1, '\t');
+  buffer += "</hierarchy>\n";
 
   /* Output input/output nets if there are any */
-  if (false == bitstream_manager.block_input_net_ids(block).empty()) {
-    write_tab_to_file(fp, hierarchy_level + 1);
-    fp << "<input_nets>\n";
-    size_t path_counter = 0;
-    /* Split with space */
-    StringToken input_net_tokenizer(
-      bitstream_manager.block_input_net_ids(block));
-    for (const std::string& net : input_net_tokenizer.split(std::string(" "))) {
-      write_tab_to_file(fp, hierarchy_level + 2);
-      fp << "<path id=\"" << path_counter << "\"";
-      fp << " net_name=\"";
-      fp << net;
-      fp << "\"/>";
-      fp << "\n";
-
-      path_counter++;
-    }
-    write_tab_to_file(fp, hierarchy_level + 1);
-    fp << "</input_nets>\n";
-  }
-
-  if (false == bitstream_manager.block_output_net_ids(block).empty()) {
-    write_tab_to_file(fp, hierarchy_level + 1);
-    fp << "<output_nets>\n";
-    size_t path_counter = 0;
-    /* Split with space */
-    StringToken output_net_tokenizer(
-      bitstream_manager.block_output_net_ids(block));
-    for (const std::string& net :
-         output_net_tokenizer.split(std::string(" "))) {
-      write_tab_to_file(fp, hierarchy_level + 2);
-      fp << "<path id=\"" << path_counter << "\"";
-      fp << " net_name=\"";
-      fp << net;
-      fp << "\"/>";
-      fp << "\n";
-
-      path_counter++;
-    }
-    write_tab_to_file(fp, hierarchy_level + 1);
-    fp << "</output_nets>\n";
-  }
+  write_block_nets_xml(buffer, bitstream_manager.block_input_net_ids(block),
+                       std::string("input_nets"), hierarchy_level);
+  write_block_nets_xml(buffer, bitstream_manager.block_output_net_ids(block),
+                       std::string("output_nets"), hierarchy_level);
 
   /* Output child bits under this block */
   size_t bit_counter = 0;
-  write_tab_to_file(fp, hierarchy_level + 1);
-  fp << "<bitstream";
+  buffer.append(hierarchy_level + 1, '\t');
+  buffer += "<bitstream";
   /* Output path id only when it is valid */
   if (true == bitstream_manager.valid_block_path_id(block)) {
-    fp << " path_id=\"" << bitstream_manager.block_path_id(block) << "\"";
+    buffer += " path_id=\"";
+    buffer += std::to_string(bitstream_manager.block_path_id(block));
+    buffer += "\"";
   }
-  fp << ">" << std::endl;
+  buffer += ">\n";
 
   for (const ConfigBitId& child_bit : bitstream_manager.block_bits(block)) {
-    write_tab_to_file(fp, hierarchy_level + 2);
-    fp << "<bit";
-    fp << " memory_port=\"" << CONFIGURABLE_MEMORY_DATA_OUT_NAME << "["
-       << bit_counter << "]"
-       << "\"";
-    fp << " value=\"" << bitstream_manager.bit_value(child_bit) << "\"";
-    fp << "/>" << std::endl;
+    buffer.append(hierarchy_level + 2, '\t');
+    buffer += "<bit memory_port=\"";
+    buffer += CONFIGURABLE_MEMORY_DATA_OUT_NAME;
+    buffer += "[";
+    append_number_to_buffer(buffer, bit_counter);
+    buffer += "]\" value=\"";
+    buffer += bitstream_manager.bit_value(child_bit) ? '1' : '0';
+    buffer += "\"/>\n";
     bit_counter++;
   }
-  write_tab_to_file(fp, hierarchy_level + 1);
-  fp << "</bitstream>" << std::endl;
+  buffer.append(hierarchy_level + 1, '\t');
+  buffer += "</bitstream>\n";
+
+  buffer.append(hierarchy_level, '\t');
+  buffer += "</bitstream_block>\n";
+}
+
+/********************************************************************
+ * Recursively write the bitstream of a block to a buffer
+ * This function will use a Depth-First Search in outputting bitstream
+ * for each block
+ * 1. For block with bits as children, we will output the XML lines
+ * 2. For block without bits/child blocks, we can return
+ * 3. For block with child blocks, we visit each child recursively
+ * The hierarchy of the parent blocks is carried along the recursion, so
+ * that it is not rebuilt for each block
+ *******************************************************************/
+static void rec_write_block_bitstream_to_xml_buffer(
+  std::string& buffer, const BitstreamManager& bitstream_manager,
+  const ConfigBlockId& block, const size_t& hierarchy_level,
+  std::vector<ConfigBlockId>& block_hierarchy) {
+  block_hierarchy.push_back(block);
+
+  write_block_bitstream_xml_head(buffer, bitstream_manager, block,
+                                 hierarchy_level);
+
+  /* Dive to child blocks if this block has any */
+  for (const ConfigBlockId& child_block :
+       bitstream_manager.block_children(block)) {
+    rec_write_block_bitstream_to_xml_buffer(buffer, bitstream_manager,
+                                            child_block, hierarchy_level + 1,
+                                            block_hierarchy);
+  }
+
+  write_block_bitstream_xml_tail(buffer, bitstream_manager, block,
+                                 hierarchy_level, block_hierarchy);
+
+  block_hierarchy.pop_back();
+}
+
+/********************************************************************
+ * Write the bitstream of the top block to a xml file
+ * The subtrees of the child blocks of the top block are independent, so
+ * they are formatted into separated buffers with multiple threads. The
+ * buffers are written to the file in the order of the child blocks, so the
+ * file is the same whatever the number of threads is.
+ * Child blocks are processed in groups, so that only the buffers of a group
+ * are kept in memory
+ *******************************************************************/
+static void write_top_block_bitstream_to_xml_file(
+  std::fstream& fp, const BitstreamManager& bitstream_manager,
+  const ConfigBlockId& top_block, const size_t& num_threads) {
+  valid_file_stream(fp);
+
+  std::string buffer;
+  write_block_bitstream_xml_head(buffer, bitstream_manager, top_block, 0);
+  write_buffer_to_file(fp, buffer);
+
+  const std::vector<ConfigBlockId>& child_blocks =
+    bitstream_manager.block_children(top_block);
+  size_t group_size = 16 * find_num_threads(num_threads);
+  std::vector<std::string> child_buffers(group_size);
+  for (size_t group_start = 0; group_start < child_blocks.size();
+       group_start += group_size) {
+    size_t num_children =
+      std::min(group_size, child_blocks.size() - group_start);
+    parallel_for(num_children, num_threads, [&](const size_t& ichild) {
+      std::vector<ConfigBlockId> block_hierarchy(1, top_block);
+      rec_write_block_bitstream_to_xml_buffer(
+        child_buffers[ichild], bitstream_manager,
+        child_blocks[group_start + ichild], 1, block_hierarchy);
+    });
+    for (size_t ichild = 0; ichild < num_children; ++ichild) {
+      write_buffer_to_file(fp, child_buffers[ichild]);
+    }
+  }
 
-  write_tab_to_file(fp, hierarchy_level);
-  fp << "</bitstream_block>" << std::endl;
+  write_block_bitstream_xml_tail(buffer, bitstream_manager, top_block, 0,
+                                 std::vector<ConfigBlockId>(1, top_block));
+  write_buffer_to_file(fp, buffer);
 }
 
 /********************************************************************
@@ -177,10 +245,13 @@ static void rec_write_block_bitstream_to_xml_file(
  * 2. Create an intermediate file to reorganize a bitstream for
  *    specific FPGAs
  * 3. TODO: support FASM format
+ * The subtrees of the blocks are formatted with a number of threads, while
+ * the file is the same whatever the number of threads is
  *******************************************************************/
 void write_xml_architecture_bitstream(const BitstreamManager& bitstream_manager,
                                       const std::string& fname,
-                                      const bool& include_time_stamp) {
+                                      const bool& include_time_stamp,
+                                      const size_t& num_threads) {
   /* Ensure that we have a valid file name */
   if (true == fname.empty()) {
     VTR_LOG_ERROR(
@@ -210,7 +281,8 @@ void write_xml_architecture_bitstream(const BitstreamManager& bitstream_manager,
   VTR_ASSERT(1 == top_block.size());
 
   /* Write bitstream, block by block, in a recursive way */
-  rec_write_block_bitstream_to_xml_file(fp, bitstream_manager, top_block[0], 0);
+  write_top_block_bitstream_to_xml_file(fp, bitstream_manager, top_block[0],
+                                        num_threads);
 
   /* Close file handler */
   fp.close();
@@ -17,7 +17,8 @@ namespace openfpga {
 
 void write_xml_architecture_bitstream(const BitstreamManager& bitstream_manager,
                                       const std::string& fname,
-                                      const bool& include_time_stamp);
+                                      const bool& include_time_stamp,
+                                      const size_t& num_threads = 1);
 
 } /* end namespace openfpga */
 
@@ -0,0 +1,143 @@
+/********************************************************************
+ * Unit test functions to validate the binary file format of the
+ * architecture bitstream
+ * 1. a bitstream written and read back is the same as the original one
+ * 2. files which are truncated or have a wrong version are rejected
+ *******************************************************************/
+#include <cstddef>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+/* Headers from vtrutils */
+#include "vtr_assert.h"
+#include "vtr_log.h"
+
+/* Headers from fpgabitstream library */
+#include "bin_arch_bitstream_format.h"
+#include "read_bin_arch_bitstream.h"
+#include "write_bin_arch_bitstream.h"
+
+/* Headers shared by the unit tests */
+#include "openfpga_test_utils.h"
+
+/* Return true if the reader errors out on a file */
+static bool is_rejected(const std::string& fname) {
+  try {
+    openfpga::read_bin_architecture_bitstream(fname.c_str());
+  } catch (const std::exception&) {
+    return true;
+  }
+  return false;
+}
+
+/********************************************************************
+ * Build a small bitstream with a hierarchy of blocks, where blocks
+ * have or miss bits, path ids and net ids
+ *******************************************************************/
+static openfpga::BitstreamManager build_test_bitstream() {
+  openfpga::BitstreamManager bitstream_manager;
+  openfpga::ConfigBlockId top = bitstream_manager.add_block("fpga_top");
+  for (size_t itile = 0; itile < 3; ++itile) {
+    openfpga::ConfigBlockId tile = bitstream_manager.add_block(
+      std::string("grid_clb_") + std::to_string(itile));
+    bitstream_manager.add_child_block(top, tile);
+    openfpga::ConfigBlockId mux = bitstream_manager.add_block("mem_mux");
+    bitstream_manager.add_child_block(tile, mux);
+    std::vector<bool> bits;
+    /* Cross a word boundary in the packed bits */
+    for (size_t ibit = 0; ibit < 40 + itile * 17; ++ibit) {
+      bits.push_back(0 == (ibit * (itile + 3)) % 5);
+    }
+    bitstream_manager.add_block_bits(mux, bits);
+    bitstream_manager.add_path_id_to_block(mux, int(itile) - 1);
+    bitstream_manager.add_input_net_id_to_block(mux, "net_a net_b");
+    bitstream_manager.add_output_net_id_to_block(mux, "net_c");
+  }
+  return bitstream_manager;
+}
+
+static void check_same_bitstream(const openfpga::BitstreamManager& ref,
+                                 const openfpga::BitstreamManager& test) {
+  check(ref.num_blocks() == test.num_blocks(), "Mismatch in number of blocks");
+  check(ref.num_bits() == test.num_bits(), "Mismatch in number of bits");
+  if ((ref.num_blocks() != test.num_blocks()) ||
+      (ref.num_bits() != test.num_bits())) {
+    return;
+  }
+  for (const openfpga::ConfigBlockId& blk : ref.blocks()) {
+    check(ref.block_name(blk) == test.block_name(blk), "Mismatch in name");
+    check(ref.block_parent(blk) == test.block_parent(blk),
+          "Mismatch in parent block");
+    check(ref.block_children(blk) == test.block_children(blk),
+          "Mismatch in child blocks");
+    check(ref.block_bits(blk) == test.block_bits(blk), "Mismatch in bits");
+    check(ref.block_path_id(blk) == test.block_path_id(blk),
+          "Mismatch in path id");
+    check(ref.block_input_net_ids(blk) == test.block_input_net_ids(blk),
+          "Mismatch in input net ids");
+    check(ref.block_output_net_ids(blk) == test.block_output_net_ids(blk),
+          "Mismatch in output net ids");
+  }
+  for (const openfpga::ConfigBitId& bit : ref.bits()) {
+    check(ref.bit_value(bit) == test.bit_value(bit), "Mismatch in bit value");
+  }
+}
+
+int main(int argc, const char** argv) {
+  VTR_ASSERT(1 == argc);
+  (void)argv;
+
+  std::string fname("test_bin_arch_bitstream.bin");
+  std::string bad_fname("test_bin_arch_bitstream_bad.bin");
+
+  /* Write and read back */
+  openfpga::BitstreamManager ref = build_test_bitstream();
+  check(0 == openfpga::write_bin_architecture_bitstream(ref, fname),
+        "Failed to write the binary bitstream");
+  check(true == openfpga::is_bin_architecture_bitstream_file(fname.c_str()),
+        "Binary bitstream is not recognized");
+  openfpga::BitstreamManager test =
+    openfpga::read_bin_architecture_bitstream(fname.c_str());
+  check_same_bitstream(ref, test);
+
+  /* The bitstream which is read back is written to the same bytes */
+  check(0 == openfpga::write_bin_architecture_bitstream(test, bad_fname),
+        "Failed to write the binary bitstream again");
+  std::string data = read_file(fname);
+  check(data == read_file(bad_fname), "Mismatch in rewritten binary file");
+
+  /* Wrong version */
+  std::string bad_data = data;
+  openfpga::BinArchBitstreamHeader header;
+  VTR_ASSERT(sizeof(header) <= bad_data.size());
+  header.version = openfpga::BIN_ARCH_BITSTREAM_VERSION + 1;
+  bad_data.replace(offsetof(openfpga::BinArchBitstreamHeader, version),
+                   sizeof(header.version),
+                   reinterpret_cast<const char*>(&header.version),
+                   sizeof(header.version));
+  write_file(bad_fname, bad_data);
+  check(true == is_rejected(bad_fname), "Wrong version is accepted");
+
+  /* Wrong magic number */
+  bad_data = data;
+  bad_data[0] = 'X';
+  write_file(bad_fname, bad_data);
+  check(false == openfpga::is_bin_architecture_bitstream_file(
+                   bad_fname.c_str()),
+        "Wrong magic number is recognized");
+  check(true == is_rejected(bad_fname), "Wrong magic number is accepted");
+
+  /* Truncated files */
+  for (size_t num_bytes :
+       {size_t(0), size_t(4), sizeof(header), data.size() / 2,
+        data.size() - 1}) {
+    write_file(bad_fname, data.substr(0, num_bytes));
+    check(true == is_rejected(bad_fname), "Truncated file is accepted");
+  }
+
+  std::remove(fname.c_str());
+  std::remove(bad_fname.c_str());
+
+  return test_exit_code("Binary architecture bitstream");
+}
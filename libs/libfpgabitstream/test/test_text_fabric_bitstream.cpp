@@ -0,0 +1,106 @@
+/********************************************************************
+ * Unit test functions to validate the reader of fabric bitstreams in
+ * plain text
+ * 1. fields and data lines are parsed, with Unix or Windows line breaks
+ * 2. invalid characters in data lines are rejected
+ * 3. lines which do not match the length and width fields are reported
+ *******************************************************************/
+#include <cstdio>
+#include <string>
+
+/* Headers from vtrutils */
+#include "vtr_assert.h"
+#include "vtr_log.h"
+
+/* Headers from fpgabitstream library */
+#include "read_text_fabric_bitstream.h"
+
+/* Headers shared by the unit tests */
+#include "openfpga_test_utils.h"
+
+/* Return true if the reader errors out on a file */
+static bool is_rejected(const std::string& fname) {
+  openfpga::TextFabricBitstreamFile bitstream_file;
+  try {
+    bitstream_file.open(fname);
+  } catch (const std::exception&) {
+    return true;
+  }
+  return false;
+}
+
+/* Open a file, which must be valid, and return the number of errors found
+ * by the checker */
+static size_t num_check_errors(const std::string& fname) {
+  openfpga::TextFabricBitstreamFile bitstream_file;
+  bitstream_file.open(fname);
+  return openfpga::check_text_fabric_bitstream_file(bitstream_file);
+}
+
+int main(int argc, const char** argv) {
+  VTR_ASSERT(1 == argc);
+  (void)argv;
+
+  std::string fname("test_text_fabric_bitstream.bit");
+
+  /* A valid bitstream of a configuration frame protocol */
+  std::string header =
+    "// Fabric bitstream\n"
+    "// Bitstream length: 3\n"
+    "// Bitstream width (LSB -> MSB): <address 4 bits><data input 2 bits>\n";
+  write_file(fname, header + "000101\n0011x0\r\n111100");
+  openfpga::TextFabricBitstreamFile bitstream_file;
+  bitstream_file.open(fname);
+  check(2 == bitstream_file.fields().size(), "Mismatch in number of fields");
+  check("3" == bitstream_file.field("Bitstream length"),
+        "Mismatch in bitstream length");
+  check(std::string_view() == bitstream_file.field("Bitstream word count"),
+        "Missing field is found");
+  check(3 == bitstream_file.num_lines(), "Mismatch in number of lines");
+  check("0011x0" == bitstream_file.line(1), "Mismatch in Windows line");
+  check("111100" == bitstream_file.line(2), "Mismatch in last line");
+  check(18 == bitstream_file.num_bits(), "Mismatch in number of bits");
+  check(8 == bitstream_file.num_ones(), "Mismatch in number of ones");
+  check(1 == bitstream_file.num_dont_care_bits(),
+        "Mismatch in number of don't care bits");
+  check(0 == openfpga::check_text_fabric_bitstream_file(bitstream_file),
+        "Valid bitstream is reported as invalid");
+
+  /* Invalid characters */
+  write_file(fname, header + "000101\n0011y0\n111100\n");
+  check(true == is_rejected(fname), "Invalid character is accepted");
+  write_file(fname, header + "000101\n0011 0\n111100\n");
+  check(true == is_rejected(fname), "Space in data line is accepted");
+
+  /* Wrong width of a line */
+  write_file(fname, header + "000101\n00110\n111100\n");
+  check(0 < num_check_errors(fname), "Short line is accepted");
+  write_file(fname, header + "000101\n0011000\n111100\n");
+  check(0 < num_check_errors(fname), "Long line is accepted");
+
+  /* Wrong number of lines */
+  write_file(fname, header + "000101\n001100\n");
+  check(0 < num_check_errors(fname), "Missing line is accepted");
+
+  /* A flatten bitstream has no width and all the bits in one line */
+  write_file(fname, "// Bitstream length: 5\n10x01\n");
+  check(0 == num_check_errors(fname), "Valid flatten bitstream is rejected");
+  write_file(fname, "// Bitstream length: 5\n10x0\n");
+  check(0 < num_check_errors(fname), "Short flatten bitstream is accepted");
+  write_file(fname, "10x01\n");
+  check(0 < num_check_errors(fname), "Missing length is accepted");
+
+  /* Shift register banks have a number of BL and WL lines per word */
+  std::string ql_header =
+    "// Bitstream word count: 2\n"
+    "// Bitstream bl word size: 2\n"
+    "// Bitstream wl word size: 1\n";
+  write_file(fname, ql_header + "01\n10\n11\n00\n10\n01\n");
+  check(0 == num_check_errors(fname), "Valid word bitstream is rejected");
+  write_file(fname, ql_header + "01\n10\n11\n00\n10\n");
+  check(0 < num_check_errors(fname), "Missing word line is accepted");
+
+  std::remove(fname.c_str());
+
+  return test_exit_code("Text fabric bitstream");
+}
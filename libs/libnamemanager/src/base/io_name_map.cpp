@@ -1,5 +1,5 @@
 /******************************************************************************
- * Memember functions for data structure IoLocationMap
+ * Memember functions for data structure IoNameMap
  ******************************************************************************/
 /* Headers from vtrutil library */
 #include "io_name_map.h"
@@ -23,11 +23,22 @@ IoNameMap::IoNameMap() {
  * Public Accessors
  *************************************************/
 std::vector<BasicPort> IoNameMap::fpga_top_ports() const {
-  std::vector<BasicPort> ports;
+  /* Output the ports in the order of their keys */
+  std::vector<const PortMapping*> mappings;
+  for (const auto& kv : top2core_io_name_map_) {
+    for (const PortMapping& mapping : kv.second) {
+      mappings.push_back(&mapping);
+    }
+  }
+  std::sort(mappings.begin(), mappings.end(),
+            [](const PortMapping* a, const PortMapping* b) {
+              return a->key < b->key;
+            });
 
-  for (auto it = top2core_io_name_map_.begin();
-       it != top2core_io_name_map_.end(); ++it) {
-    ports.push_back(str2port(it->first));
+  std::vector<BasicPort> ports;
+  ports.reserve(mappings.size());
+  for (const PortMapping* mapping : mappings) {
+    ports.push_back(mapping->port);
   }
 
   return ports;
@@ -35,28 +46,12 @@ std::vector<BasicPort> IoNameMap::fpga_top_ports() const {
 
 BasicPort IoNameMap::fpga_core_port(const BasicPort& fpga_top_port) const {
   BasicPort core_port;
-  /* First, find the pin name matching */
-  auto result_key = top2core_io_name_keys_.find(fpga_top_port.get_name());
-  if (result_key == top2core_io_name_keys_.end()) {
-    return core_port; /* Not found, return invalid port */
-  }
-  /* Second, find the exact key */
-  std::string top_port_key;
-  for (std::string cand : result_key->second) {
-    BasicPort cand_port = str2port(cand);
-    /* if the top port is part of the cand port, e.g., clk[1] vs. clk[0:2], the
-     * candidate is the key that we want! */
-    if (cand_port.contained(fpga_top_port)) {
-      top_port_key = cand;
-      break;
-    }
-  }
-  if (top_port_key.empty()) {
-    return core_port; /* Not found, return invalid port */
-  }
-  auto result = top2core_io_name_map_.find(top_port_key);
-  if (result != top2core_io_name_map_.end() && result->second.is_valid()) {
-    BasicPort top_port_pool = str2port(top_port_key);
+  /* Find the mapping whose top port contains the given port, e.g., clk[1] vs.
+   * clk[0:2] */
+  const PortMapping* mapping =
+    find_port_mapping(top2core_io_name_map_, fpga_top_port);
+  if ((nullptr != mapping) && mapping->mapped_port.is_valid()) {
+    const BasicPort& top_port_pool = mapping->port;
     BasicPort fpga_top_port_lsb(fpga_top_port.get_name(),
                                 fpga_top_port.get_lsb(),
                                 fpga_top_port.get_lsb());
@@ -68,9 +63,9 @@ BasicPort IoNameMap::fpga_core_port(const BasicPort& fpga_top_port) const {
     /* Now find the exact pin and spot the core port with pin index */
     if (ipin_anchor_lsb < top_port_pool.get_width() &&
         ipin_anchor_msb < top_port_pool.get_width()) {
-      core_port.set_name(result->second.get_name());
-      core_port.set_lsb(result->second.pins()[ipin_anchor_lsb]);
-      core_port.set_msb(result->second.pins()[ipin_anchor_msb]);
+      core_port.set_name(mapping->mapped_port.get_name());
+      core_port.set_lsb(mapping->mapped_port.pins()[ipin_anchor_lsb]);
+      core_port.set_msb(mapping->mapped_port.pins()[ipin_anchor_msb]);
     }
   }
   return core_port;
@@ -78,42 +73,20 @@ BasicPort IoNameMap::fpga_core_port(const BasicPort& fpga_top_port) const {
 
 BasicPort IoNameMap::fpga_top_port(const BasicPort& fpga_core_port) const {
   BasicPort top_port;
-  /* First, find the pin name matching */
-  auto result_key = core2top_io_name_keys_.find(fpga_core_port.get_name());
-  if (result_key == core2top_io_name_keys_.end()) {
-    return top_port; /* Not found, return invalid port */
-  }
-  /* Second, find the exact key */
-  std::string core_port_key;
-  for (std::string cand : result_key->second) {
-    BasicPort cand_port = str2port(cand);
-    /* if the top port is part of the cand port, e.g., clk[1] vs. clk[0:2], the
-     * candidate is the key that we want! */
-    if (cand_port.contained(fpga_core_port)) {
-      core_port_key = cand;
-      break;
-    }
-  }
-  if (core_port_key.empty()) {
-    return top_port; /* Not found, return invalid port */
-  }
-  auto result = core2top_io_name_map_.find(core_port_key);
-  if (result != core2top_io_name_map_.end() && result->second.is_valid()) {
-    BasicPort core_port_pool = str2port(core_port_key);
-    BasicPort fpga_core_port_lsb(fpga_core_port.get_name(),
-                                 fpga_core_port.get_lsb(),
-                                 fpga_core_port.get_lsb());
-    BasicPort fpga_core_port_msb(fpga_core_port.get_name(),
-                                 fpga_core_port.get_msb(),
-                                 fpga_core_port.get_msb());
+  /* Find the mapping whose core port contains the given port, e.g., clk[1]
+   * vs. clk[0:2] */
+  const PortMapping* mapping =
+    find_port_mapping(core2top_io_name_map_, fpga_core_port);
+  if ((nullptr != mapping) && mapping->mapped_port.is_valid()) {
+    const BasicPort& core_port_pool = mapping->port;
     size_t ipin_anchor_lsb = core_port_pool.find_ipin(fpga_core_port);
     size_t ipin_anchor_msb = core_port_pool.find_ipin(fpga_core_port);
     /* Now find the exact pin and spot the core port with pin index */
     if (ipin_anchor_lsb < core_port_pool.get_width() &&
         ipin_anchor_msb < core_port_pool.get_width()) {
-      top_port.set_name(result->second.get_name());
-      top_port.set_lsb(result->second.pins()[ipin_anchor_lsb]);
-      top_port.set_msb(result->second.pins()[ipin_anchor_msb]);
+      top_port.set_name(mapping->mapped_port.get_name());
+      top_port.set_lsb(mapping->mapped_port.pins()[ipin_anchor_lsb]);
+      top_port.set_msb(mapping->mapped_port.pins()[ipin_anchor_msb]);
     }
   }
   return top_port;
@@ -122,8 +95,8 @@ BasicPort IoNameMap::fpga_top_port(const BasicPort& fpga_core_port) const {
 IoNameMap::e_port_mapping_status IoNameMap::fpga_core_port_mapping_status(
   const BasicPort& fpga_core_port, const bool& verbose) const {
   /* First, find the pin name matching */
-  auto result_key = core2top_io_name_keys_.find(fpga_core_port.get_name());
-  if (result_key == core2top_io_name_keys_.end()) {
+  auto result_key = core2top_io_name_map_.find(fpga_core_port.get_name());
+  if (result_key == core2top_io_name_map_.end()) {
     return IoNameMap::e_port_mapping_status::NONE;
   }
   /* Second, find the exact port. Create a scoreboard and check every pin.
@@ -131,9 +104,8 @@ IoNameMap::e_port_mapping_status IoNameMap::fpga_core_port_mapping_status(
    * (indicate overlapped ports). Error on any pin which has no hit (indicate
    * partially unmapped) */
   std::vector<int8_t> scoreboard(fpga_core_port.get_width(), 0);
-  for (std::string cand : result_key->second) {
-    BasicPort cand_port = str2port(cand);
-    for (auto pin : cand_port.pins()) {
+  for (const PortMapping& cand : result_key->second) {
+    for (auto pin : cand.port.pins()) {
       scoreboard[pin - fpga_core_port.get_lsb()]++;
     }
   }
@@ -164,10 +136,12 @@ bool IoNameMap::fpga_top_port_is_dummy(const BasicPort& fpga_top_port) const {
 
 IoNameMap::e_dummy_port_direction IoNameMap::fpga_top_dummy_port_direction(
   const BasicPort& fpga_top_port) const {
-  for (auto& kv : dummy_port_direction_) {
-    BasicPort cand = str2port(kv.first);
-    if (cand.contained(fpga_top_port)) {
-      return kv.second;
+  auto result = dummy_port_directions_.find(fpga_top_port.get_name());
+  if (result != dummy_port_directions_.end()) {
+    for (const DummyPortDirection& cand : result->second) {
+      if (cand.port.contained(fpga_top_port)) {
+        return cand.direction;
+      }
     }
   }
   /* Return an invalid port type */
@@ -175,9 +149,8 @@ IoNameMap::e_dummy_port_direction IoNameMap::fpga_top_dummy_port_direction(
 }
 
 bool IoNameMap::empty() const {
-  return top2core_io_name_keys_.empty() && top2core_io_name_map_.empty() &&
-         core2top_io_name_keys_.empty() && core2top_io_name_map_.empty() &&
-         dummy_port_direction_.empty();
+  return top2core_io_name_map_.empty() && core2top_io_name_map_.empty() &&
+         dummy_port_directions_.empty();
 }
 
 int IoNameMap::set_io_pair(const BasicPort& fpga_top_port,
@@ -192,59 +165,34 @@ int IoNameMap::set_io_pair(const BasicPort& fpga_top_port,
       fpga_core_port.get_lsb(), fpga_core_port.get_msb());
     return CMD_EXEC_FATAL_ERROR;
   }
-  VTR_ASSERT_SAFE(fpga_top_port.get_width() != fpga_core_port.get_width());
-  /* Register in the key first, and then add to the exact name mapping */
+  VTR_ASSERT_SAFE(fpga_top_port.get_width() == fpga_core_port.get_width());
+  /* Register the top port first */
   {
-    std::string top_port_str = port2str(fpga_top_port);
-    auto result_key = top2core_io_name_keys_.find(fpga_top_port.get_name());
-    if (result_key == top2core_io_name_keys_.end()) {
-      /* Add to the key registery */
-      top2core_io_name_keys_[fpga_top_port.get_name()].push_back(top_port_str);
-      top2core_io_name_map_[top_port_str] = fpga_core_port;
-    } else {
-      /* Ensure that the key is not duplicated */
-      if (std::find(result_key->second.begin(), result_key->second.end(),
-                    top_port_str) == result_key->second.end()) {
-        top2core_io_name_keys_[fpga_top_port.get_name()].push_back(
-          top_port_str);
-        top2core_io_name_map_[top_port_str] = fpga_core_port;
-      } else {
-        /* Throw a warning since we have to overwrite */
-        VTR_LOG_WARN(
-          "Overwrite the top-to-core pin mapping: top pin '%s' to core pin "
-          "'%s' (previously was '%s')!\n",
-          top_port_str.c_str(), port2str(fpga_core_port).c_str(),
-          port2str(top2core_io_name_map_[top_port_str]).c_str());
-        top2core_io_name_map_[top_port_str] = fpga_core_port;
-      }
+    PortMapping* mapping = nullptr;
+    if (false == find_or_create_port_mapping(top2core_io_name_map_,
+                                             fpga_top_port, mapping)) {
+      /* Throw a warning since we have to overwrite */
+      VTR_LOG_WARN(
+        "Overwrite the top-to-core pin mapping: top pin '%s' to core pin "
+        "'%s' (previously was '%s')!\n",
+        mapping->key.c_str(), port2str(fpga_core_port).c_str(),
+        port2str(mapping->mapped_port).c_str());
     }
+    mapping->mapped_port = fpga_core_port;
   }
   /* Now, do similar to the core port */
   {
-    std::string core_port_str = port2str(fpga_core_port);
-    auto result_key = core2top_io_name_keys_.find(fpga_core_port.get_name());
-    if (result_key == core2top_io_name_keys_.end()) {
-      /* Add to the key registery */
-      core2top_io_name_keys_[fpga_core_port.get_name()].push_back(
-        core_port_str);
-      core2top_io_name_map_[core_port_str] = fpga_top_port;
-    } else {
-      /* Ensure that the key is not duplicated */
-      if (std::find(result_key->second.begin(), result_key->second.end(),
-                    core_port_str) == result_key->second.end()) {
-        core2top_io_name_keys_[fpga_core_port.get_name()].push_back(
-          core_port_str);
-        core2top_io_name_map_[core_port_str] = fpga_top_port;
-      } else {
-        /* Throw a warning since we have to overwrite */
-        VTR_LOG_WARN(
-          "Overwrite the core-to-top pin mapping: core pin '%s' to top pin "
-          "'%s' (previously was '%s')!\n",
-          core_port_str.c_str(), port2str(fpga_top_port).c_str(),
-          port2str(core2top_io_name_map_[core_port_str]).c_str());
-        core2top_io_name_map_[core_port_str] = fpga_top_port;
-      }
+    PortMapping* mapping = nullptr;
+    if (false == find_or_create_port_mapping(core2top_io_name_map_,
+                                             fpga_core_port, mapping)) {
+      /* Throw a warning since we have to overwrite */
+      VTR_LOG_WARN(
+        "Overwrite the core-to-top pin mapping: core pin '%s' to top pin "
+        "'%s' (previously was '%s')!\n",
+        mapping->key.c_str(), port2str(fpga_top_port).c_str(),
+        port2str(mapping->mapped_port).c_str());
     }
+    mapping->mapped_port = fpga_top_port;
   }
   return CMD_EXEC_SUCCESS;
 }
@@ -252,52 +200,88 @@ int IoNameMap::set_io_pair(const BasicPort& fpga_top_port,
 int IoNameMap::set_dummy_io(const BasicPort& fpga_top_port,
                             const e_dummy_port_direction& direction) {
   /* Must be a true dummy port, none of its pins have been paired! */
-  std::string top_port_str = port2str(fpga_top_port);
-  /* First, find the pin name matching */
-  auto result_key = top2core_io_name_keys_.find(fpga_top_port.get_name());
-  if (result_key == top2core_io_name_keys_.end()) {
-    /* Add to the key registery */
-    top2core_io_name_keys_[fpga_top_port.get_name()].push_back(top_port_str);
-    top2core_io_name_map_[top_port_str] = BasicPort();
-  } else {
-    /* Ensure that the key is not duplicated */
-    if (std::find(result_key->second.begin(), result_key->second.end(),
-                  top_port_str) == result_key->second.end()) {
-      top2core_io_name_keys_[fpga_top_port.get_name()].push_back(top_port_str);
-      top2core_io_name_map_[top_port_str] = BasicPort();
-    } else {
-      /* Throw a error because the dummy pin should NOT be mapped before! */
-      VTR_LOG_ERROR(
-        "Dummy port '%s' of fpga_top is already mapped "
-        "to a valid pin '%s' of fpga_core!\n",
-        port2str(fpga_top_port).c_str(),
-        port2str(top2core_io_name_map_[top_port_str]).c_str());
-      return CMD_EXEC_FATAL_ERROR;
-    }
+  PortMapping* mapping = nullptr;
+  if (false ==
+      find_or_create_port_mapping(top2core_io_name_map_, fpga_top_port,
+                                  mapping)) {
+    /* Throw a error because the dummy pin should NOT be mapped before! */
+    VTR_LOG_ERROR(
+      "Dummy port '%s' of fpga_top is already mapped "
+      "to a valid pin '%s' of fpga_core!\n",
+      port2str(fpga_top_port).c_str(), port2str(mapping->mapped_port).c_str());
+    return CMD_EXEC_FATAL_ERROR;
   }
+  mapping->mapped_port = BasicPort();
   /* Add the direction list */
-  bool dir_defined = false;
-  for (auto& kv : dummy_port_direction_) {
-    BasicPort cand = str2port(kv.first);
-    if (cand.contained(fpga_top_port)) {
-      if (kv.second != direction) {
+  std::vector<DummyPortDirection>& dummy_ports =
+    dummy_port_directions_[fpga_top_port.get_name()];
+  for (const DummyPortDirection& cand : dummy_ports) {
+    if (cand.port.contained(fpga_top_port)) {
+      if (cand.direction != direction) {
         /* Throw a error because the dummy pin should NOT be mapped before! */
         VTR_LOG_ERROR(
           "Dummy port '%s' of fpga_top is already assigned to a different "
           "direction through another dummy port definition '%s'!\n",
-          port2str(fpga_top_port).c_str(), port2str(cand).c_str());
+          port2str(fpga_top_port).c_str(), port2str(cand.port).c_str());
         return CMD_EXEC_FATAL_ERROR;
       }
-      dir_defined = true;
-      break;
+      return CMD_EXEC_SUCCESS;
     }
   }
-  if (!dir_defined) {
-    dummy_port_direction_[top_port_str] = direction;
-  }
+  /* Keep the dummy ports sorted by their keys, so that the first port
+   * containing a given port is always the same one */
+  DummyPortDirection dummy_port;
+  dummy_port.key = mapping->key;
+  dummy_port.port = mapping->port;
+  dummy_port.direction = direction;
+  auto pos = std::lower_bound(
+    dummy_ports.begin(), dummy_ports.end(), dummy_port,
+    [](const DummyPortDirection& a, const DummyPortDirection& b) {
+      return a.key < b.key;
+    });
+  dummy_ports.insert(pos, dummy_port);
   return CMD_EXEC_SUCCESS;
 }
 
+/**************************************************
+ * Internal utility
+ *************************************************/
+const IoNameMap::PortMapping* IoNameMap::find_port_mapping(
+  const std::unordered_map<std::string, std::vector<PortMapping>>& io_name_map,
+  const BasicPort& port) const {
+  /* First, find the pin name matching */
+  auto result = io_name_map.find(port.get_name());
+  if (result == io_name_map.end()) {
+    return nullptr;
+  }
+  /* Second, find the exact mapping */
+  for (const PortMapping& cand : result->second) {
+    if (cand.port.contained(port)) {
+      return &cand;
+    }
+  }
+  return nullptr;
+}
+
+bool IoNameMap::find_or_create_port_mapping(
+  std::unordered_map<std::string, std::vector<PortMapping>>& io_name_map,
+  const BasicPort& port, PortMapping*& mapping) {
+  std::string key = port2str(port);
+  std::vector<PortMapping>& cands = io_name_map[port.get_name()];
+  for (PortMapping& cand : cands) {
+    if (cand.key == key) {
+      mapping = &cand;
+      return false;
+    }
+  }
+  PortMapping new_mapping;
+  new_mapping.key = key;
+  new_mapping.port = str2port(key);
+  cands.push_back(new_mapping);
+  mapping = &cands.back();
+  return true;
+}
+
 std::string IoNameMap::port2str(const BasicPort& port) const {
   return port.to_verilog_string();
 }
@@ -4,7 +4,10 @@
 /********************************************************************
  * Include header files required by the data structure definition
  *******************************************************************/
-#include <map>
+#include <array>
+#include <string>
+#include <unordered_map>
+#include <vector>
 
 #include "openfpga_port.h"
 
@@ -78,6 +81,21 @@ class IoNameMap {
   bool valid_dummy_port_direction(
     const e_dummy_port_direction& direction) const;
 
+ private: /* Internal types */
+  /* A port of one side and the port of the other side it is mapped to. The
+   * key is the port in string, which identifies the mapping */
+  struct PortMapping {
+    std::string key;
+    BasicPort port;
+    BasicPort mapped_port;
+  };
+  /* A dummy port of fpga_top and its direction */
+  struct DummyPortDirection {
+    std::string key;
+    BasicPort port;
+    e_dummy_port_direction direction;
+  };
+
  private: /* Internal utility */
   /* Convert a port info to string, which can be used to store keys */
   std::string port2str(const BasicPort& port) const;
@@ -86,20 +104,33 @@ class IoNameMap {
   /* Generate a string include all the valid directions of the dummy port.
    * Useful for printing debugging messages */
   std::string dummy_port_dir_all2str() const;
+  /* Find the mapping whose port contains a given port, in the order of
+   * creation. Return nullptr if not found */
+  const PortMapping* find_port_mapping(
+    const std::unordered_map<std::string, std::vector<PortMapping>>&
+      io_name_map,
+    const BasicPort& port) const;
+  /* Find the mapping of the port to be paired; create one if not found.
+   * Return true if the mapping is created */
+  bool find_or_create_port_mapping(
+    std::unordered_map<std::string, std::vector<PortMapping>>& io_name_map,
+    const BasicPort& port, PortMapping*& mapping);
 
  private: /* Internal Data */
-  /* fpga_top -> fpga_core io_name_keys. Use the port name to find all the port
-   * details. For instance: prog_clk -> ["prog_clk[0:1]", "prog_clk[2:3]"] The
-   * keys are then used to spot the fpga core ports in the io_name_map_. For
-   * instance: "prog_clk[0:1]" -> pclk[0:1]
+  /* fpga_top -> fpga_core io mapping. Use the port name to find all the port
+   * details, in the order of creation. For instance: prog_clk ->
+   * ["prog_clk[0:1]" -> pclk[0:1], "prog_clk[2:3]" -> pclk[2:3]]
+   * The ports are parsed from the keys once when the mapping is created, so
+   * that queries do not parse any string
    */
-  std::map<std::string, std::vector<std::string>> top2core_io_name_keys_;
-  std::map<std::string, BasicPort> top2core_io_name_map_;
-
-  std::map<std::string, std::vector<std::string>> core2top_io_name_keys_;
-  std::map<std::string, BasicPort> core2top_io_name_map_;
+  std::unordered_map<std::string, std::vector<PortMapping>>
+    top2core_io_name_map_;
+  std::unordered_map<std::string, std::vector<PortMapping>>
+    core2top_io_name_map_;
 
-  std::map<std::string, e_dummy_port_direction> dummy_port_direction_;
+  /* Dummy ports of fpga_top by port name, sorted by their keys */
+  std::unordered_map<std::string, std::vector<DummyPortDirection>>
+    dummy_port_directions_;
 
   /* Constants */
   std::array<const char*, size_t(e_dummy_port_direction::NUM_TYPES)>
@@ -17,44 +17,78 @@ namespace openfpga {
 /**************************************************
  * Public Accessors
  *************************************************/
-std::string ModuleNameMap::name(const std::string& tag) const {
+std::string ModuleNameMap::name(std::string_view tag) const {
   auto result = tag2names_.find(tag);
   if (result == tag2names_.end()) {
+    auto alias_result = alias2tags_.find(tag);
+    if (alias_result != alias2tags_.end()) {
+      return name(symbol_string(alias_result->second));
+    }
     VTR_LOG_ERROR("The given built-in name '%s' does not exist!\n",
-                  tag.c_str());
+                  std::string(tag).c_str());
     return std::string();
   }
-  return result->second;
+  return symbol_string(result->second);
 }
 
-bool ModuleNameMap::name_exist(const std::string& tag) const {
+bool ModuleNameMap::name_exist(std::string_view tag) const {
   auto result = tag2names_.find(tag);
-  return result != tag2names_.end();
+  return (result != tag2names_.end()) || tag_is_alias(tag);
 }
 
-std::string ModuleNameMap::tag(const std::string& name) const {
+std::string ModuleNameMap::tag(std::string_view name) const {
   auto result = name2tags_.find(name);
   if (result == name2tags_.end()) {
     VTR_LOG_ERROR("The given customized name '%s' does not exist!\n",
-                  name.c_str());
+                  std::string(name).c_str());
     return std::string();
   }
-  return result->second;
+  return symbol_string(result->second);
 }
 
-bool ModuleNameMap::tag_exist(const std::string& name) const {
+bool ModuleNameMap::tag_exist(std::string_view name) const {
   auto result = name2tags_.find(name);
   return result != name2tags_.end();
 }
 
 std::vector<std::string> ModuleNameMap::tags() const {
   std::vector<std::string> keys;
+  keys.reserve(tag2names_.size());
   for (auto const& element : tag2names_) {
-    keys.push_back(element.first);
+    keys.emplace_back(element.first);
   }
+  /* Keep a deterministic order regardless of the hash map */
+  std::sort(keys.begin(), keys.end());
   return keys;
 }
 
+bool ModuleNameMap::tag_is_alias(std::string_view tag) const {
+  return alias2tags_.find(tag) != alias2tags_.end();
+}
+
+std::string ModuleNameMap::alias_tag(std::string_view alias) const {
+  auto result = alias2tags_.find(alias);
+  if (result == alias2tags_.end()) {
+    VTR_LOG_ERROR("The given built-in name '%s' is not an alias!\n",
+                  std::string(alias).c_str());
+    return std::string();
+  }
+  return symbol_string(result->second);
+}
+
+std::vector<std::string> ModuleNameMap::alias_tags() const {
+  std::vector<std::string> keys;
+  keys.reserve(alias2tags_.size());
+  for (auto const& element : alias2tags_) {
+    keys.emplace_back(element.first);
+  }
+  std::sort(keys.begin(), keys.end());
+  return keys;
+}
+
+/**************************************************
+ * Public Mutators
+ *************************************************/
 int ModuleNameMap::set_tag_to_name_pair(const std::string& tag,
                                         const std::string& name) {
   /*  tagA <--x--> nameA
@@ -66,24 +100,66 @@ int ModuleNameMap::set_tag_to_name_pair(const std::string& tag,
    * - nameB should NOT be mapped to any other tags!
    */
   auto result = name2tags_.find(name);
-  if (result != name2tags_.end() && result->second != tag) {
+  SymbolId tag_symbol = intern_symbol(tag);
+  if (result != name2tags_.end() && result->second != tag_symbol) {
     VTR_LOG_ERROR(
       "The customized name '%s' has already been mapped to a built-in name "
       "'%s'! Fail to bind it to a new built-in name '%s'\n",
-      name.c_str(), result->second.c_str(), tag.c_str());
+      name.c_str(), symbol_string(result->second).c_str(), tag.c_str());
     return CMD_EXEC_FATAL_ERROR;
   }
   /* Clean up */
   name2tags_.erase(name);
   /* Create double link */
-  name2tags_[name] = tag;
-  tag2names_[tag] = name;
+  SymbolId name_symbol = intern_symbol(name);
+  name2tags_[symbol_string(name_symbol)] = tag_symbol;
+  tag2names_[symbol_string(tag_symbol)] = name_symbol;
+  /* The tag is no longer an alias if it was */
+  alias2tags_.erase(tag);
+  return CMD_EXEC_SUCCESS;
+}
+
+int ModuleNameMap::set_tag_alias(const std::string& alias,
+                                 const std::string& tag) {
+  /* Always merge into a tag which has its own name */
+  std::string target_tag = tag;
+  if (tag_is_alias(target_tag)) {
+    target_tag = alias_tag(target_tag);
+  }
+  if (tag2names_.find(target_tag) == tag2names_.end()) {
+    VTR_LOG_ERROR(
+      "The built-in name '%s' does not exist! Fail to merge built-in name '%s' "
+      "into it\n",
+      tag.c_str(), alias.c_str());
+    return CMD_EXEC_FATAL_ERROR;
+  }
+  if (alias == target_tag) {
+    VTR_LOG_ERROR("The built-in name '%s' cannot be merged into itself!\n",
+                  alias.c_str());
+    return CMD_EXEC_FATAL_ERROR;
+  }
+  /* Remove the double links of the alias */
+  auto result = tag2names_.find(alias);
+  if (result != tag2names_.end()) {
+    name2tags_.erase(symbol_string(result->second));
+    tag2names_.erase(result);
+  }
+  /* The aliases of the alias are merged as well */
+  SymbolId alias_symbol = intern_symbol(alias);
+  SymbolId tag_symbol = intern_symbol(target_tag);
+  for (auto& element : alias2tags_) {
+    if (element.second == alias_symbol) {
+      element.second = tag_symbol;
+    }
+  }
+  alias2tags_[symbol_string(alias_symbol)] = tag_symbol;
   return CMD_EXEC_SUCCESS;
 }
 
 void ModuleNameMap::clear() {
   tag2names_.clear();
   name2tags_.clear();
+  alias2tags_.clear();
 }
 
 } /* end namespace openfpga */
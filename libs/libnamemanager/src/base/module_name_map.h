@@ -4,10 +4,13 @@
 /********************************************************************
  * Include header files required by the data structure definition
  *******************************************************************/
-#include <map>
 #include <string>
+#include <string_view>
+#include <unordered_map>
 #include <vector>
 
+#include "openfpga_symbol_table.h"
+
 /* Begin namespace openfpga */
 namespace openfpga {
 
@@ -17,24 +20,38 @@ namespace openfpga {
  */
 class ModuleNameMap {
  public: /* Public accessors */
-  /** @brief Get customized name with a given tag */
-  std::string name(const std::string& tag) const;
+  /** @brief Get customized name with a given tag. An alias tag gets the name
+   * of the tag it is merged into */
+  std::string name(std::string_view tag) const;
   /** @brief Check if a name does exist with a given tag. Return true if there
-   * is a tag-to-name mapping */
-  bool name_exist(const std::string& tag) const;
+   * is a tag-to-name mapping, either directly or through an alias */
+  bool name_exist(std::string_view tag) const;
   /** @brief Check if a tag does exist with a given name. Return true if there
    * is a name-to-tag mapping */
-  bool tag_exist(const std::string& name) const;
+  bool tag_exist(std::string_view name) const;
   /** @brief Get tag with a given name */
-  std::string tag(const std::string& name) const;
+  std::string tag(std::string_view name) const;
 
-  /** @brief return a list of all the current keys */
+  /** @brief return a list of all the current keys, in alphabetical order.
+   * Alias tags are not included */
   std::vector<std::string> tags() const;
 
+  /** @brief Check if a tag is an alias, whose module has been merged into the
+   * module of another tag */
+  bool tag_is_alias(std::string_view tag) const;
+  /** @brief Get the tag that an alias tag is merged into */
+  std::string alias_tag(std::string_view alias) const;
+  /** @brief return a list of all the alias tags, in alphabetical order */
+  std::vector<std::string> alias_tags() const;
+
  public: /* Public mutators */
   /** @brief Create the one-on-one mapping between an built-in name and a
    * customized name. Return 0 for success, return 1 for fail */
   int set_tag_to_name_pair(const std::string& tag, const std::string& name);
+  /** @brief Merge a tag into another tag, which then share the same customized
+   * name. The tag-to-name mapping of the alias is removed. Return 0 for
+   * success, return 1 for fail */
+  int set_tag_alias(const std::string& alias, const std::string& tag);
   /** @brief Reset to empty status. Clear all the storage */
   void clear();
 
@@ -42,9 +59,13 @@ class ModuleNameMap {
   /* built-in name -> customized_name
    * Create a double link to check any customized name is mapped to more than 1
    * built-in name!
+   * Both tags and names are interned in the symbol table, which is shared
+   * with the module manager. The keys refer to the interned strings
    */
-  std::map<std::string, std::string> tag2names_;
-  std::map<std::string, std::string> name2tags_;
+  std::unordered_map<std::string_view, SymbolId> tag2names_;
+  std::unordered_map<std::string_view, SymbolId> name2tags_;
+  /* alias tag -> tag that the alias is merged into */
+  std::unordered_map<std::string_view, SymbolId> alias2tags_;
 };
 
 } /* End namespace openfpga*/
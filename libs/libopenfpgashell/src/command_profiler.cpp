@@ -0,0 +1,253 @@
+/*********************************************************************
+ * Member functions for class CommandProfiler
+ ********************************************************************/
+#include "command_profiler.h"
+
+#include <fstream>
+
+#ifndef _WIN32
+#include <sys/resource.h>
+#include <unistd.h>
+#endif
+
+/* Headers from vtrutil library */
+#include "vtr_assert.h"
+#include "vtr_log.h"
+
+/* Headers from openfpgashell library */
+#include "command_exit_codes.h"
+
+/* Begin namespace openfpga */
+namespace openfpga {
+
+/*********************************************************************
+ * Memory usage of the process
+ * Return 0 when the platform does not provide the information
+ ********************************************************************/
+size_t get_current_rss_kb() {
+#ifdef __linux__
+  /* The second field of statm is the resident set size in pages */
+  std::ifstream fp("/proc/self/statm");
+  size_t num_pages = 0;
+  size_t num_rss_pages = 0;
+  if (fp >> num_pages >> num_rss_pages) {
+    return num_rss_pages * size_t(sysconf(_SC_PAGESIZE)) / 1024;
+  }
+#endif
+  return 0;
+}
+
+size_t get_peak_rss_kb() {
+#ifndef _WIN32
+  struct rusage usage;
+  if (0 == getrusage(RUSAGE_SELF, &usage)) {
+#ifdef __APPLE__
+    /* The peak is given in bytes on macOS */
+    return size_t(usage.ru_maxrss) / 1024;
+#else
+    return size_t(usage.ru_maxrss);
+#endif
+  }
+#endif
+  return 0;
+}
+
+/*********************************************************************
+ * CPU time of the calling thread, in seconds
+ * Use the CPU time of the process when the platform does not provide it
+ ********************************************************************/
+double get_thread_cpu_time() {
+#ifndef _WIN32
+  struct timespec cpu_time;
+  if (0 == clock_gettime(CLOCK_THREAD_CPUTIME_ID, &cpu_time)) {
+    return double(cpu_time.tv_sec) + double(cpu_time.tv_nsec) * 1e-9;
+  }
+#endif
+  return double(std::clock()) / double(CLOCKS_PER_SEC);
+}
+
+/*********************************************************************
+ * Public constructors
+ ********************************************************************/
+CommandProfiler::CommandProfiler() { reset(); }
+
+/************************************************************************
+ * Public accessors
+ ***********************************************************************/
+const std::vector<CommandProfileRecord>& CommandProfiler::records() const {
+  return records_;
+}
+
+double CommandProfiler::session_wall_time() const {
+  return std::chrono::duration<double>(std::chrono::steady_clock::now() -
+                                       session_wall_start_)
+    .count();
+}
+
+double CommandProfiler::session_cpu_time() const {
+  return double(std::clock() - session_cpu_start_) / double(CLOCKS_PER_SEC);
+}
+
+/* The commands still under execution, e.g., the one requesting the report,
+ * are not reported */
+void CommandProfiler::print_report() const {
+  VTR_LOG("Runtime report of executed commands:\n");
+  VTR_LOG("%-40s %8s %12s %12s %14s %14s\n", "Command", "Status",
+          "Wall (s)", "CPU (s)", "RSS delta (MB)", "Peak RSS (MB)");
+  for (const CommandProfileRecord& record : records_) {
+    if (CMD_EXEC_NONE == record.status) {
+      continue;
+    }
+    /* Nested commands are indented under their callers */
+    std::string name = std::string(2 * record.depth, ' ') + record.name;
+    VTR_LOG("%-40s %8d %12.3f %12.3f %14.1f %14.1f\n", name.c_str(),
+            record.status, record.wall_time, record.cpu_time,
+            double(record.rss_delta) / 1024., double(record.peak_rss) / 1024.);
+  }
+  VTR_LOG("Session took %g seconds (CPU time: %g seconds), peak RSS %.1f MB\n",
+          session_wall_time(), session_cpu_time(),
+          double(get_peak_rss_kb()) / 1024.);
+}
+
+/* Command names are not expected to contain any special character, but
+ * escape the ones that would break a JSON string anyway */
+static std::string escape_json_string(const std::string& str) {
+  std::string escaped;
+  escaped.reserve(str.size());
+  for (const char& c : str) {
+    if (('"' == c) || ('\\' == c)) {
+      escaped.push_back('\\');
+    }
+    escaped.push_back(c);
+  }
+  return escaped;
+}
+
+int CommandProfiler::write_report(const std::string& fname) const {
+  std::ofstream fp(fname, std::ofstream::out | std::ofstream::trunc);
+  if (false == fp.is_open()) {
+    VTR_LOG_ERROR("Fail to open file '%s' to write the runtime report!\n",
+                  fname.c_str());
+    return CMD_EXEC_FATAL_ERROR;
+  }
+
+  const std::string csv_suffix(".csv");
+  bool csv_format = (fname.size() >= csv_suffix.size()) &&
+                    (0 == fname.compare(fname.size() - csv_suffix.size(),
+                                        csv_suffix.size(), csv_suffix));
+  if (true == csv_format) {
+    fp << "command,depth,status,wall_time_s,cpu_time_s,rss_delta_kb,"
+          "peak_rss_kb\n";
+    for (const CommandProfileRecord& record : records_) {
+      if (CMD_EXEC_NONE == record.status) {
+        continue;
+      }
+      fp << record.name << "," << record.depth << "," << record.status << ","
+         << record.wall_time << "," << record.cpu_time << ","
+         << record.rss_delta << "," << record.peak_rss << "\n";
+    }
+  } else {
+    fp << "{\n";
+    fp << "  \"wall_time_s\": " << session_wall_time() << ",\n";
+    fp << "  \"cpu_time_s\": " << session_cpu_time() << ",\n";
+    fp << "  \"peak_rss_kb\": " << get_peak_rss_kb() << ",\n";
+    fp << "  \"commands\": [";
+    bool first_record = true;
+    for (const CommandProfileRecord& record : records_) {
+      if (CMD_EXEC_NONE == record.status) {
+        continue;
+      }
+      fp << (first_record ? "\n" : ",\n");
+      first_record = false;
+      fp << "    {\"command\": \"" << escape_json_string(record.name) << "\"";
+      fp << ", \"depth\": " << record.depth;
+      fp << ", \"status\": " << record.status;
+      fp << ", \"wall_time_s\": " << record.wall_time;
+      fp << ", \"cpu_time_s\": " << record.cpu_time;
+      fp << ", \"rss_delta_kb\": " << record.rss_delta;
+      fp << ", \"peak_rss_kb\": " << record.peak_rss << "}";
+    }
+    fp << "\n  ]\n";
+    fp << "}\n";
+  }
+
+  if (false == fp.good()) {
+    VTR_LOG_ERROR("Fail to write the runtime report to file '%s'!\n",
+                  fname.c_str());
+    return CMD_EXEC_FATAL_ERROR;
+  }
+  return CMD_EXEC_SUCCESS;
+}
+
+/************************************************************************
+ * Public mutators
+ ***********************************************************************/
+void CommandProfiler::reset() {
+  records_.clear();
+  wall_starts_.clear();
+  cpu_starts_.clear();
+  rss_starts_.clear();
+  depth_ = 0;
+  session_wall_start_ = std::chrono::steady_clock::now();
+  session_cpu_start_ = std::clock();
+}
+
+size_t CommandProfiler::begin_command(const std::string& name) {
+  size_t record_id = records_.size();
+  CommandProfileRecord record;
+  record.name = name;
+  record.depth = depth_;
+  record.status = CMD_EXEC_NONE;
+  record.wall_time = 0.;
+  record.cpu_time = 0.;
+  record.rss_delta = 0;
+  record.peak_rss = 0;
+  records_.push_back(record);
+
+  rss_starts_.push_back(get_current_rss_kb());
+  cpu_starts_.push_back(std::clock());
+  wall_starts_.push_back(std::chrono::steady_clock::now());
+
+  ++depth_;
+
+  return record_id;
+}
+
+void CommandProfiler::end_command(const size_t& record_id, const int& status) {
+  std::chrono::steady_clock::time_point wall_end =
+    std::chrono::steady_clock::now();
+  std::clock_t cpu_end = std::clock();
+
+  VTR_ASSERT(record_id < records_.size());
+  VTR_ASSERT(0 < depth_);
+  CommandProfileRecord& record = records_[record_id];
+  record.status = status;
+  record.wall_time =
+    std::chrono::duration<double>(wall_end - wall_starts_[record_id]).count();
+  record.cpu_time =
+    double(cpu_end - cpu_starts_[record_id]) / double(CLOCKS_PER_SEC);
+  record.rss_delta = long(get_current_rss_kb()) - long(rss_starts_[record_id]);
+  record.peak_rss = get_peak_rss_kb();
+
+  --depth_;
+}
+
+void CommandProfiler::add_command(const std::string& name, const int& status,
+                                  const double& wall_time,
+                                  const double& cpu_time) {
+  CommandProfileRecord record;
+  record.name = name;
+  record.depth = depth_;
+  record.status = status;
+  record.wall_time = wall_time;
+  record.cpu_time = cpu_time;
+  record.rss_delta = 0;
+  record.peak_rss = get_peak_rss_kb();
+  records_.push_back(record);
+  /* Keep the counters aligned with the records */
+  wall_starts_.push_back(std::chrono::steady_clock::now());
+  cpu_starts_.push_back(std::clock());
+  rss_starts_.push_back(0);
+}
+
+} /* End namespace openfpga */
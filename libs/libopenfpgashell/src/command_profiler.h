@@ -0,0 +1,99 @@
+#ifndef COMMAND_PROFILER_H
+#define COMMAND_PROFILER_H
+
+/********************************************************************
+ * Include header files required by the data structure definition
+ *******************************************************************/
+#include <chrono>
+#include <ctime>
+#include <string>
+#include <vector>
+
+/* Begin namespace openfpga */
+namespace openfpga {
+
+/*********************************************************************
+ * Runtime and memory statistics of a command execution
+ * - Wall time is the elapsed time, which is the one to watch when commands
+ *   run multiple threads
+ * - CPU time is the processor time of all the threads of the process
+ * - Memory is the resident set size (RSS) in kilobytes
+ ********************************************************************/
+struct CommandProfileRecord {
+  std::string name;
+  /* Level of nesting: 0 for commands called by users, 1 for the commands
+   * called by a command, e.g., source, etc. */
+  size_t depth;
+  int status;
+  double wall_time;
+  double cpu_time;
+  long rss_delta;
+  size_t peak_rss;
+};
+
+/*********************************************************************
+ * A data structure to record the runtime and memory of each command
+ * executed in a shell, in the order of execution.
+ *
+ * An example of how to use
+ * -----------------------
+ *   size_t record_id = profiler.begin_command("read_arch");
+ *   ... execute the command ...
+ *   profiler.end_command(record_id, status);
+ *
+ * Commands can be nested: the statistics of a command include the ones of
+ * the commands it calls.
+ ********************************************************************/
+class CommandProfiler {
+ public: /* Constructor */
+  CommandProfiler();
+
+ public: /* Public accessors */
+  const std::vector<CommandProfileRecord>& records() const;
+  /* Elapsed time and CPU time since the profiler is reset, in seconds */
+  double session_wall_time() const;
+  double session_cpu_time() const;
+  /* Print the records to the log */
+  void print_report() const;
+  /* Write the records to a file. The format is CSV when the file ends with
+   * '.csv', otherwise JSON. Return 0 if successful */
+  int write_report(const std::string& fname) const;
+
+ public: /* Public mutators */
+  /* Clear all the records and restart the session counters */
+  void reset();
+  /* Start recording a command, return the id of the record */
+  size_t begin_command(const std::string& name);
+  /* Finish the record of a command */
+  void end_command(const size_t& record_id, const int& status);
+  /* Add the record of a command which is timed by the caller, e.g., when
+   * commands are executed concurrently. The memory of such a command can not
+   * be isolated from the others, so only the peak RSS is recorded */
+  void add_command(const std::string& name, const int& status,
+                   const double& wall_time, const double& cpu_time);
+
+ private: /* Internal data */
+  std::vector<CommandProfileRecord> records_;
+  /* Counters when each record is started */
+  std::vector<std::chrono::steady_clock::time_point> wall_starts_;
+  std::vector<std::clock_t> cpu_starts_;
+  std::vector<size_t> rss_starts_;
+  /* Number of records which are started but not finished */
+  size_t depth_;
+
+  std::chrono::steady_clock::time_point session_wall_start_;
+  std::clock_t session_cpu_start_;
+};
+
+/********************************************************************
+ * Function declaration
+ *******************************************************************/
+size_t get_current_rss_kb();
+
+size_t get_peak_rss_kb();
+
+double get_thread_cpu_time();
+
+} /* End namespace openfpga */
+
+#endif
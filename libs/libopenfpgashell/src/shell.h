@@ -1,8 +1,8 @@
 #ifndef SHELL_H
 #define SHELL_H
 
-#include <ctime>
 #include <functional>
+#include <istream>
 #include <map>
 #include <string>
 #include <vector>
@@ -10,6 +10,7 @@
 #include "command.h"
 #include "command_context.h"
 #include "command_exit_codes.h"
+#include "command_profiler.h"
 #include "shell_fwd.h"
 #include "vtr_range.h"
 #include "vtr_vector.h"
@@ -105,6 +106,10 @@ class Shell {
     const ShellCommandId& cmd_id) const;
   std::vector<ShellCommandId> commands_by_class(
     const ShellCommandClassId& cmd_class_id) const;
+  /* Check if a command is disabled by disable_command() */
+  bool command_disabled(const ShellCommandId& cmd_id) const;
+  /* Runtime and memory statistics of the executed commands */
+  const CommandProfiler& profiler() const;
 
  public: /* Public mutators */
   void set_name(const char* name);
@@ -184,6 +189,20 @@ class Shell {
     const ShellCommandId& cmd_id,
     const std::vector<ShellCommandId>& cmd_dependency);
   ShellCommandClassId add_command_class(const char* name);
+  /* Forbid a command to be executed for the rest of the session, e.g., when
+   * the data it requires has been released. The reason is reported when
+   * users try to execute the command */
+  void disable_command(const ShellCommandId& cmd_id, const std::string& reason);
+  /* Mark a command as successfully executed without running it, e.g., when
+   * the data it builds has been restored from a file, so that the commands
+   * depending on it can be executed */
+  void set_command_executed(const ShellCommandId& cmd_id);
+  /* Specify a file where the runtime report is written when the shell quits.
+   * No report is written if the file name is empty */
+  void set_runtime_report_file(const std::string& fname);
+  /* Enable the trace of commands and the builders they call, which is
+   * written to the given file when the shell quits */
+  void set_trace_file(const std::string& fname);
 
  public: /* Public validators */
   bool valid_command_id(const ShellCommandId& cmd_id) const;
@@ -193,15 +212,34 @@ class Shell {
   /* Start the interactive mode, where users will type-in command by command */
   void run_interactive_mode(T& context, const bool& quiet_mode = false);
   /* Start the script mode, where users provide a file which includes all the
-   * commands to run */
+   * commands to run.
+   * In concurrent mode, consecutive commands which only read the context,
+   * i.e., whose execute functions take a constant <T>, and do not depend on
+   * each other are executed in parallel */
   void run_script_mode(const char* script_file_name, T& context,
-                       const bool& batch_mode = false);
+                       const bool& batch_mode = false,
+                       const bool& concurrent_mode = false);
+  /* Start the server mode, where the shell stays alive and executes the
+   * scripts whose paths are written, one per line, to a named pipe. The
+   * setup script, if any, is executed once, e.g., to build the fabric. After
+   * each job, the commands executed by the job are marked as not executed
+   * and the reset function is called to clear the design-specific data of
+   * the context. The server stops when 'exit' is written to the pipe */
+  void run_server_mode(const char* pipe_name, const char* setup_script_name,
+                       T& context,
+                       const std::function<void(T&)>& reset_func,
+                       const bool& concurrent_mode = false);
   /* Print all the commands by their classes. This is actually the help desk */
   void print_commands(const bool& show_hidden = false) const;
   /* Find the exit code (assume quit shell now) */
   int exit_code() const;
   /* Show statistics of errors during command execution */
   int execution_errors() const;
+  /* Write the runtime report to the file specified by
+   * set_runtime_report_file(), if any */
+  int write_runtime_report() const;
+  /* Write the trace to the file specified by set_trace_file(), if any */
+  int write_trace() const;
   /* Quit the shell */
   void exit(const int& init_err = 0) const;
   /* Execute a command, the command line is the user's input to launch a command
@@ -212,6 +250,32 @@ class Shell {
   int execute_command(const char* cmd_line, T& common_context,
                       const bool& allow_hidden_command = true);
 
+ private: /* Internal executors */
+  /* Split a command line into tokens and find the command to execute.
+   * Return an invalid id if the command line is not legal */
+  ShellCommandId find_command_in_line(const char* cmd_line,
+                                      const bool& allow_hidden_command,
+                                      std::vector<std::string>& tokens) const;
+  /* Execute a command whose line has been split into tokens */
+  int execute_command_tokens(const ShellCommandId& cmd_id,
+                             const std::vector<std::string>& tokens,
+                             T& common_context);
+  /* Steps of a command execution, each returns an exit code */
+  int check_command_dependency(const ShellCommandId& cmd_id);
+  int parse_command_tokens(const ShellCommandId& cmd_id,
+                           const std::vector<std::string>& tokens);
+  int run_command_function(const ShellCommandId& cmd_id, T& common_context);
+  /* Concurrent execution of read-only commands in script mode */
+  bool concurrent_command(
+    const ShellCommandId& cmd_id,
+    const std::vector<ShellCommandId>& concurrent_cmd_ids) const;
+  int execute_concurrent_commands(const std::vector<std::string>& cmd_lines,
+                                  T& common_context);
+  /* Execute all the commands of a script, return a fatal error code if
+   * any command has fatal errors */
+  int execute_script(std::istream& fp, T& context,
+                     const bool& concurrent_mode);
+
  private: /* Internal data */
   /* Name of the shell, this will appear in the interactive mode */
   std::string name_;
@@ -289,14 +353,20 @@ class Shell {
   vtr::vector<ShellCommandId, std::vector<ShellCommandId>>
     command_dependencies_;
 
+  /* Reasons why commands are disabled, which are empty for enabled commands
+   */
+  vtr::vector<ShellCommandId, std::string> command_disable_reasons_;
+
   /* Fast name look-up */
   std::map<std::string, ShellCommandId> command_name2ids_;
   std::map<std::string, ShellCommandClassId> command_class2ids_;
   vtr::vector<ShellCommandClassId, std::vector<ShellCommandId>>
     commands_by_classes_;
 
-  /* Timer */
-  std::clock_t time_start_;
+  /* Runtime and memory statistics */
+  CommandProfiler profiler_;
+  std::string runtime_report_file_;
+  std::string trace_file_;
 };
 
 } /* End namespace openfpga */
@@ -3,6 +3,9 @@
  ********************************************************************/
 #include <fstream>
 #include <algorithm>
+#include <cstring>
+#include <chrono>
+#include <thread>
 
 /* Headers from vtrutil library */
 #include "vtr_log.h"
@@ -10,6 +13,10 @@
 
 /* Headers from openfpgautil library */
 #include "openfpga_tokenizer.h"
+#include "openfpga_trace.h"
+
+/* Headers for named pipes */
+#include <sys/stat.h>
 
 /* Headers from readline library */
 #include <readline/readline.h>
@@ -28,7 +35,6 @@ namespace openfpga {
 template<class T>
 Shell<T>::Shell() {
   name_ = std::string("shell_no_name");
-  time_start_ = 0;
 }
 
 /************************************************************************
@@ -95,12 +101,23 @@ std::vector<ShellCommandId> Shell<T>::command_dependency(const ShellCommandId& c
   return command_dependencies_[cmd_id];
 }
 
+template<class T>
+bool Shell<T>::command_disabled(const ShellCommandId& cmd_id) const {
+  VTR_ASSERT(true == valid_command_id(cmd_id));
+  return false == command_disable_reasons_[cmd_id].empty();
+}
+
 template<class T>
 std::vector<ShellCommandId> Shell<T>::commands_by_class(const ShellCommandClassId& cmd_class_id) const {
   VTR_ASSERT(true == valid_command_class_id(cmd_class_id));
   return commands_by_classes_[cmd_class_id];
 }
 
+template<class T>
+const CommandProfiler& Shell<T>::profiler() const {
+  return profiler_;
+}
+
 /************************************************************************
  * Public mutators
  ***********************************************************************/
@@ -142,6 +159,7 @@ ShellCommandId Shell<T>::add_command(const Command& cmd, const char* descr, cons
   command_macro_execute_functions_.emplace_back();
   command_status_.push_back(CMD_EXEC_NONE); /* By default, the command should be marked as fatal error as it has been never executed */
   command_dependencies_.emplace_back();
+  command_disable_reasons_.emplace_back();
 
   /* Register the name in the name2id map */
   command_name2ids_[cmd.name()] = shell_cmd;
@@ -237,6 +255,19 @@ void Shell<T>::set_command_dependency(const ShellCommandId& cmd_id,
   command_dependencies_[cmd_id] = dependent_cmds;
 }
 
+template<class T>
+void Shell<T>::disable_command(const ShellCommandId& cmd_id, const std::string& reason) {
+  VTR_ASSERT(true == valid_command_id(cmd_id));
+  VTR_ASSERT(false == reason.empty());
+  command_disable_reasons_[cmd_id] = reason;
+}
+
+template<class T>
+void Shell<T>::set_command_executed(const ShellCommandId& cmd_id) {
+  VTR_ASSERT(true == valid_command_id(cmd_id));
+  command_status_[cmd_id] = CMD_EXEC_SUCCESS;
+}
+
 /* Add a command with it description */
 template<class T>
 ShellCommandClassId Shell<T>::add_command_class(const char* name) {
@@ -260,15 +291,25 @@ ShellCommandClassId Shell<T>::add_command_class(const char* name) {
   return cmd_class;
 } 
 
+template<class T>
+void Shell<T>::set_runtime_report_file(const std::string& fname) {
+  runtime_report_file_ = fname;
+}
+
+template <class T>
+void Shell<T>::set_trace_file(const std::string& fname) {
+  trace_file_ = fname;
+  if (!trace_file_.empty()) {
+    TraceRecorder::instance().enable();
+  }
+}
+
 /************************************************************************
  * Public executors
  ***********************************************************************/
 template <class T>
 void Shell<T>::run_interactive_mode(T& context, const bool& quiet_mode) {
   if (false == quiet_mode) {
-    /* Reset timer since it does not come from another mode */
-    time_start_ = std::clock();
-
     VTR_LOG("Start interactive mode of %s...\n",
             name().c_str());
 
@@ -299,9 +340,8 @@ void Shell<T>::run_interactive_mode(T& context, const bool& quiet_mode) {
 template <class T>
 void Shell<T>::run_script_mode(const char* script_file_name,
                                T& context,
-                               const bool& batch_mode) {
-
-  time_start_ = std::clock();
+                               const bool& batch_mode,
+                               const bool& concurrent_mode) {
 
   VTR_LOG("Reading script file %s...\n", script_file_name);
 
@@ -310,8 +350,6 @@ void Shell<T>::run_script_mode(const char* script_file_name,
     VTR_LOG("%s\n", title().c_str());
   } 
 
-  std::string line;
-
   /* Create an input file stream */
   std::ifstream fp(script_file_name);
 
@@ -322,90 +360,116 @@ void Shell<T>::run_script_mode(const char* script_file_name,
     return; 
   }
 
-  /* Consider that each line may not end due to the continued line charactor 
-   * Use cmd_line to conjunct multiple lines 
-   */
-  std::string cmd_line;
+  bool fatal_error = (CMD_EXEC_FATAL_ERROR == execute_script(fp, context, concurrent_mode));
+  fp.close();
 
-  /* Read line by line */
-  while (getline(fp, line)) {
-    /* Skip empty line */
-    if (true == line.empty()) {
-      continue;
+  if (true == fatal_error) {
+    VTR_LOG("Fatal error occurred!\n");
+    /* If in the batch mode, we will exit with errors */ 
+    VTR_LOGV(batch_mode, "%s Abort\n", name_.c_str());
+    if (batch_mode) {
+      exit(CMD_EXEC_FATAL_ERROR);
     }
+    /* If not in the batch mode, we will got to interactive mode */ 
+    VTR_LOGV(!batch_mode, "Enter interactive mode\n");
+  }
 
-    /* If the line that starts with '#', it is commented, we can skip */ 
-    if ('#' == line.front()) {
-      continue;
-    }
-    /* Try to split the line with '#', the string before '#' is the read command we want */
-    std::string cmd_part = line;
-    std::size_t cmd_end_pos = line.find_first_of('#');
-    /* If the full line has '#', we need the part before it */
-    if (cmd_end_pos != std::string::npos) {
-      cmd_part = line.substr(0, cmd_end_pos);
-    }
+  /* If not in batch mode, switch to interactive mode, stay tuned */
+  if (!batch_mode) {
+    run_interactive_mode(context, true); 
+  }
+}
 
-    /* Remove the space at the end of the line
-     * So that we can check easily if there is a continued line in the end  
-     */
-    StringToken cmd_part_tokenizer(cmd_part);
-    cmd_part_tokenizer.rtrim(std::string(" "));
-    cmd_part = cmd_part_tokenizer.data();
+template <class T>
+void Shell<T>::run_server_mode(const char* pipe_name,
+                               const char* setup_script_name,
+                               T& context,
+                               const std::function<void(T&)>& reset_func,
+                               const bool& concurrent_mode) {
+  /* Print the title of the shell */
+  if (!title().empty()) {
+    VTR_LOG("%s\n", title().c_str());
+  } 
 
-    /* If the line ends with '\', this is a continued line, parse the next until it ends */
-    if ('\\' == cmd_part.back()) {
-      /* Pop up the last charactor and conjunct to cmd_line */
-      cmd_part.pop_back();
- 
-      if (!cmd_part.empty()) {
-        cmd_line += cmd_part; 
-      }
-      /* Not finished yet. Parse the next line */
-      continue;
-    } else {
-      /* End of this line, if cmd_line is empty, 
-       * there is no previous lines, cache the part we have
-       * and then execute the command 
-       */
-      cmd_line += cmd_part;
+  /* Build the data shared by all the jobs */
+  if (0 < strlen(setup_script_name)) {
+    VTR_LOG("Reading setup script file %s...\n", setup_script_name);
+    std::ifstream fp(setup_script_name);
+    if (!fp.is_open()) {
+      VTR_LOG("Fail to open the script file: %s! Please check its location\n",
+              setup_script_name);
+      exit(CMD_EXEC_FATAL_ERROR);
+    }
+    if (CMD_EXEC_FATAL_ERROR == execute_script(fp, context, concurrent_mode)) {
+      VTR_LOG("Fatal error occurred in setup script!\n%s Abort\n", name_.c_str());
+      exit(CMD_EXEC_FATAL_ERROR);
     }
+  }
 
-    /* Remove the space at the beginning of the line */
-    StringToken cmd_line_tokenizer(cmd_line);
-    cmd_line_tokenizer.ltrim(std::string(" "));
-    cmd_line = cmd_line_tokenizer.data();
+  /* Commands of the setup script are considered done by every job */
+  vtr::vector<ShellCommandId, int> setup_command_status = command_status_;
 
-    /* Process the command only when the full command line in ended */
-    if (!cmd_line.empty()) {
-      VTR_LOG("\nCommand line to execute: %s\n", cmd_line.c_str());
-      /* Do not allow any hidden command to be directly called by users */
-      int status = execute_command(cmd_line.c_str(), context, false);
-      /* Empty the line ready to start a new line */
-      cmd_line.clear();
+  /* Create the pipe if it does not exist */
+  struct stat pipe_stat;
+  if ( (0 != stat(pipe_name, &pipe_stat))
+    && (0 != mkfifo(pipe_name, 0600)) ) {
+    VTR_LOG_ERROR("Fail to create the named pipe '%s'!\n", pipe_name);
+    exit(CMD_EXEC_FATAL_ERROR);
+  }
 
-      /* Check the execution status of the command, 
-       * if fatal error happened, we should abort immediately 
-       */
-      if (CMD_EXEC_FATAL_ERROR == status) {
-        VTR_LOG("Fatal error occurred!\n");
-        /* If in the batch mode, we will exit with errors */ 
-        VTR_LOGV(batch_mode, "%s Abort\n", name_.c_str());
-        if (batch_mode) {
-          exit(CMD_EXEC_FATAL_ERROR);
-        }
-        /* If not in the batch mode, we will got to interactive mode */ 
-        VTR_LOGV(!batch_mode, "Enter interactive mode\n");
+  VTR_LOG("Start server mode of %s, waiting for jobs on %s...\n",
+          name().c_str(), pipe_name);
+
+  size_t num_jobs = 0;
+  size_t num_failed_jobs = 0;
+  bool shutdown = false;
+  while (false == shutdown) {
+    /* Opening a pipe blocks until a client opens it for writing. The pipe
+     * is reopened once all the clients have closed it */
+    std::ifstream pipe_fp(pipe_name);
+    if (!pipe_fp.is_open()) {
+      VTR_LOG_ERROR("Fail to open the named pipe '%s'!\n", pipe_name);
+      break;
+    }
+    std::string job_line;
+    while (getline(pipe_fp, job_line)) {
+      StringToken job_tokenizer(job_line);
+      job_tokenizer.trim();
+      std::string job_script_name = job_tokenizer.data();
+      if (true == job_script_name.empty()) {
+        continue;
+      }
+      if (std::string("exit") == job_script_name) {
+        shutdown = true;
         break;
       }
+
+      ++num_jobs;
+      VTR_LOG("\nStart job %lu: %s\n", num_jobs, job_script_name.c_str());
+      int status = CMD_EXEC_FATAL_ERROR;
+      std::ifstream job_fp(job_script_name);
+      if (!job_fp.is_open()) {
+        VTR_LOG_ERROR("Fail to open the script file: %s! Please check its location\n",
+                      job_script_name.c_str());
+      } else {
+        status = execute_script(job_fp, context, concurrent_mode);
+      }
+      /* Errors of a job are reported before the status is restored */
+      bool job_failed = (CMD_EXEC_FATAL_ERROR == status) || (0 != exit_code());
+      if (true == job_failed) {
+        ++num_failed_jobs;
+        execution_errors();
+      }
+      VTR_LOG("Finish job %lu: %s (%s)\n", num_jobs, job_script_name.c_str(),
+              job_failed ? "failed" : "succeed");
+
+      /* Clean up the design-specific data for the next job */
+      command_status_ = setup_command_status;
+      reset_func(context);
     }
   }
-  fp.close();
 
-  /* If not in batch mode, switch to interactive mode, stay tuned */
-  if (!batch_mode) {
-    run_interactive_mode(context, true); 
-  }
+  VTR_LOG("\nServer executed %lu jobs, %lu failed\n", num_jobs, num_failed_jobs);
 }
 
 template <class T>
@@ -442,6 +506,27 @@ void Shell<T>::print_commands(const bool& show_hidden) const {
   VTR_LOG("\n");
 }
 
+template <class T>
+int Shell<T>::write_runtime_report() const {
+  if (true == runtime_report_file_.empty()) {
+    return CMD_EXEC_SUCCESS;
+  }
+  VTR_LOG("Write runtime report to file '%s'\n",
+          runtime_report_file_.c_str());
+  return profiler_.write_report(runtime_report_file_);
+}
+
+template <class T>
+int Shell<T>::write_trace() const {
+  if (true == trace_file_.empty()) {
+    return CMD_EXEC_SUCCESS;
+  }
+  if (0 != TraceRecorder::instance().write_chrome_trace(trace_file_)) {
+    return CMD_EXEC_FATAL_ERROR;
+  }
+  return CMD_EXEC_SUCCESS;
+}
+
 template <class T>
 int Shell<T>::exit_code() const {
   /* Check all the command status, if we see fatal errors or minor errors, we drop an error code */
@@ -494,9 +579,14 @@ void Shell<T>::exit(const int& init_err) const {
   VTR_LOG("\nFinish execution with %d errors\n",
             num_err);
 
-  VTR_LOG("\nThe entire %s flow took %g seconds\n",
-          name_.c_str(),
-          (double)(std::clock() - time_start_) / (double)CLOCKS_PER_SEC);
+  VTR_LOG("\nThe entire %s flow took %g seconds (CPU time: %g seconds)\n",
+          name_.c_str(), profiler_.session_wall_time(),
+          profiler_.session_cpu_time());
+
+  if ( (CMD_EXEC_SUCCESS != write_runtime_report())
+    || (CMD_EXEC_SUCCESS != write_trace()) ) {
+    shell_exit_code |= CMD_EXEC_FATAL_ERROR;
+  }
 
   VTR_LOG("\nThank you for using %s!\n",
           name().c_str());
@@ -510,6 +600,25 @@ void Shell<T>::exit(const int& init_err) const {
 template <class T>
 int Shell<T>::execute_command(const char* cmd_line,
                                T& common_context, const bool& allow_hidden_command) {
+  std::vector<std::string> tokens;
+  ShellCommandId cmd_id = find_command_in_line(cmd_line, allow_hidden_command, tokens);
+  if (false == valid_command_id(cmd_id)) {
+    return CMD_EXEC_FATAL_ERROR;
+  }
+
+  /* Record the runtime of the command, including the failures */
+  TraceScope trace_scope(commands_[cmd_id].name());
+  size_t profile_id = profiler_.begin_command(commands_[cmd_id].name());
+  int status = execute_command_tokens(cmd_id, tokens, common_context);
+  profiler_.end_command(profile_id, status);
+
+  return status;
+}
+
+template <class T>
+ShellCommandId Shell<T>::find_command_in_line(const char* cmd_line,
+                                              const bool& allow_hidden_command,
+                                              std::vector<std::string>& tokens) const {
   openfpga::StringToken tokenizer(cmd_line);  
   tokenizer.add_delim(' ');
   /* Do not split the string in each quote "", as they should be a piece */
@@ -517,15 +626,14 @@ int Shell<T>::execute_command(const char* cmd_line,
   /* Quote should be not be started with! */
   if (!quote_anchors.empty() && quote_anchors.front() == 0) {
     VTR_LOG("Quotes (\") should NOT be the first charactor in command line: '%s'\n", cmd_line);
-    return CMD_EXEC_FATAL_ERROR;
+    return ShellCommandId::INVALID();
   }
   /* Quotes must be in pairs! */
   if (0 != quote_anchors.size() % 2) {
     VTR_LOG("Quotes (\") are not in pair in command line: '%s'\n", cmd_line);
-    return CMD_EXEC_FATAL_ERROR;
+    return ShellCommandId::INVALID();
   }
   /* Tokenize the line based on anchors */
-  std::vector<std::string> tokens;
   if (quote_anchors.empty()) {
     tokens = tokenizer.split(" ");
   } else {
@@ -537,28 +645,26 @@ int Shell<T>::execute_command(const char* cmd_line,
   if (ShellCommandId::INVALID() == cmd_id) {
     VTR_LOG("Try to call a command '%s' which is not defined!\n",
             tokens[0].c_str());
-    return CMD_EXEC_FATAL_ERROR;
+    return ShellCommandId::INVALID();
   }
   /* Do not allow hidden commands if specified */
   if (!allow_hidden_command) {
     if (command_hidden_[cmd_id]) {
       VTR_LOG("Try to call a command '%s' which is not defined!\n",
               tokens[0].c_str());
-      return CMD_EXEC_FATAL_ERROR;
+      return ShellCommandId::INVALID();
     }
   }
 
-  /* Check the dependency graph to see if all the prequistics have been met */
-  for (const ShellCommandId& dep_cmd : command_dependencies_[cmd_id]) {
-    if ( (CMD_EXEC_NONE == command_status_[dep_cmd])
-      || (CMD_EXEC_FATAL_ERROR == command_status_[dep_cmd]) ) {
-      VTR_LOG("Command '%s' is required to be executed before command '%s'!\n",
-              commands_[dep_cmd].name().c_str(), commands_[cmd_id].name().c_str());
-      /* Echo the command help desk */
-      print_command_options(commands_[cmd_id]);
-      command_status_[cmd_id] = CMD_EXEC_FATAL_ERROR;
-      return CMD_EXEC_FATAL_ERROR;
-    } 
+  return cmd_id;
+}
+
+template <class T>
+int Shell<T>::execute_command_tokens(const ShellCommandId& cmd_id,
+                                     const std::vector<std::string>& tokens,
+                                     T& common_context) {
+  if (CMD_EXEC_SUCCESS != check_command_dependency(cmd_id)) {
+    return CMD_EXEC_FATAL_ERROR;
   }
 
   /* Find the command! Parse the options 
@@ -584,6 +690,41 @@ int Shell<T>::execute_command(const char* cmd_line,
     return command_status_[cmd_id];
   }
  
+  if (CMD_EXEC_SUCCESS != parse_command_tokens(cmd_id, tokens)) {
+    return CMD_EXEC_FATAL_ERROR;
+  }
+
+  return run_command_function(cmd_id, common_context);
+}
+
+template <class T>
+int Shell<T>::check_command_dependency(const ShellCommandId& cmd_id) {
+  if (true == command_disabled(cmd_id)) {
+    VTR_LOG_ERROR("Command '%s' can not be executed as %s!\n",
+                  commands_[cmd_id].name().c_str(), command_disable_reasons_[cmd_id].c_str());
+    command_status_[cmd_id] = CMD_EXEC_FATAL_ERROR;
+    return CMD_EXEC_FATAL_ERROR;
+  }
+
+  /* Check the dependency graph to see if all the prequistics have been met */
+  for (const ShellCommandId& dep_cmd : command_dependencies_[cmd_id]) {
+    if ( (CMD_EXEC_NONE == command_status_[dep_cmd])
+      || (CMD_EXEC_FATAL_ERROR == command_status_[dep_cmd]) ) {
+      VTR_LOG("Command '%s' is required to be executed before command '%s'!\n",
+              commands_[dep_cmd].name().c_str(), commands_[cmd_id].name().c_str());
+      /* Echo the command help desk */
+      print_command_options(commands_[cmd_id]);
+      command_status_[cmd_id] = CMD_EXEC_FATAL_ERROR;
+      return CMD_EXEC_FATAL_ERROR;
+    } 
+  }
+
+  return CMD_EXEC_SUCCESS;
+}
+
+template <class T>
+int Shell<T>::parse_command_tokens(const ShellCommandId& cmd_id,
+                                   const std::vector<std::string>& tokens) {
   /* Reset the command parse results to initial status 
    * Avoid conflict when calling the same command in the second time 
    */
@@ -598,6 +739,12 @@ int Shell<T>::execute_command(const char* cmd_line,
   /* Parse succeed. Let user to confirm selected options */ 
   print_command_context(commands_[cmd_id], command_contexts_[cmd_id]);
 
+  return CMD_EXEC_SUCCESS;
+}
+
+template <class T>
+int Shell<T>::run_command_function(const ShellCommandId& cmd_id,
+                                   T& common_context) {
   /* Execute the command depending on the type of function ! */ 
   switch (command_execute_function_types_[cmd_id]) {
   case PLUGIN:
@@ -641,6 +788,99 @@ int Shell<T>::execute_command(const char* cmd_line,
   return command_status_[cmd_id];
 }
 
+/* Find if a command can be executed concurrently with a group of commands:
+ * - It only reads the common context
+ * - It does not depend on any command of the group, whose status is not known yet
+ * - It is not in the group, as its options are parsed into its own context
+ */
+template <class T>
+bool Shell<T>::concurrent_command(const ShellCommandId& cmd_id,
+                                  const std::vector<ShellCommandId>& concurrent_cmd_ids) const {
+  if (false == valid_command_id(cmd_id) || command_hidden_[cmd_id]) {
+    return false;
+  }
+  if ( (CONST_STANDARD != command_execute_function_types_[cmd_id])
+    && (CONST_SHORT != command_execute_function_types_[cmd_id]) ) {
+    return false;
+  }
+  for (const ShellCommandId& concurrent_cmd_id : concurrent_cmd_ids) {
+    if (concurrent_cmd_id == cmd_id) {
+      return false;
+    }
+    if (command_dependencies_[cmd_id].end() != std::find(command_dependencies_[cmd_id].begin(),
+                                                          command_dependencies_[cmd_id].end(),
+                                                          concurrent_cmd_id)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/* Execute a group of read-only commands, which are accepted by concurrent_command(),
+ * each in its own thread.
+ * The commands are parsed and echoed in order before any of them starts, and their
+ * statistics are reported in order once all of them finish. Note that the messages
+ * printed by the commands during the execution are not serialized.
+ * Return a fatal error if any command fails */
+template <class T>
+int Shell<T>::execute_concurrent_commands(const std::vector<std::string>& cmd_lines,
+                                          T& common_context) {
+  /* Do not start any thread for a single command */
+  if (1 == cmd_lines.size()) {
+    VTR_LOG("\nCommand line to execute: %s\n", cmd_lines[0].c_str());
+    return execute_command(cmd_lines[0].c_str(), common_context, false);
+  }
+
+  std::vector<ShellCommandId> cmd_ids(cmd_lines.size(), ShellCommandId::INVALID());
+  std::vector<int> statuses(cmd_lines.size(), CMD_EXEC_FATAL_ERROR);
+  std::vector<double> wall_times(cmd_lines.size(), 0.);
+  std::vector<double> cpu_times(cmd_lines.size(), 0.);
+
+  int status = CMD_EXEC_SUCCESS;
+  std::vector<std::thread> threads;
+  for (size_t icmd = 0; icmd < cmd_lines.size(); ++icmd) {
+    VTR_LOG("\nCommand line to execute concurrently: %s\n", cmd_lines[icmd].c_str());
+    std::vector<std::string> tokens;
+    cmd_ids[icmd] = find_command_in_line(cmd_lines[icmd].c_str(), false, tokens);
+    if ( (false == valid_command_id(cmd_ids[icmd]))
+      || (CMD_EXEC_SUCCESS != check_command_dependency(cmd_ids[icmd]))
+      || (CMD_EXEC_SUCCESS != parse_command_tokens(cmd_ids[icmd], tokens)) ) {
+      status = CMD_EXEC_FATAL_ERROR;
+    }
+  }
+  /* Do not start anything if a command is invalid */
+  if (CMD_EXEC_SUCCESS != status) {
+    return status;
+  }
+
+  for (size_t icmd = 0; icmd < cmd_lines.size(); ++icmd) {
+    threads.emplace_back([&, icmd]() {
+      TraceScope trace_scope(commands_[cmd_ids[icmd]].name());
+      std::chrono::steady_clock::time_point wall_start = std::chrono::steady_clock::now();
+      double cpu_start = get_thread_cpu_time();
+      statuses[icmd] = run_command_function(cmd_ids[icmd], common_context);
+      cpu_times[icmd] = get_thread_cpu_time() - cpu_start;
+      wall_times[icmd] = std::chrono::duration<double>(std::chrono::steady_clock::now()
+                                                       - wall_start).count();
+    });
+  }
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+
+  for (size_t icmd = 0; icmd < cmd_lines.size(); ++icmd) {
+    VTR_LOG("Command '%s' finished with status %d in %g seconds\n",
+            commands_[cmd_ids[icmd]].name().c_str(), statuses[icmd], wall_times[icmd]);
+    profiler_.add_command(commands_[cmd_ids[icmd]].name(), statuses[icmd],
+                          wall_times[icmd], cpu_times[icmd]);
+    if (CMD_EXEC_FATAL_ERROR == statuses[icmd]) {
+      status = CMD_EXEC_FATAL_ERROR;
+    }
+  }
+
+  return status;
+}
+
 /************************************************************************
  * Public invalidators/validators 
  ***********************************************************************/
@@ -654,4 +894,129 @@ bool Shell<T>::valid_command_class_id(const ShellCommandClassId& cmd_class_id) c
   return ( size_t(cmd_class_id) < command_class_ids_.size() ) && ( cmd_class_id == command_class_ids_[cmd_class_id] ); 
 }
 
+template <class T>
+int Shell<T>::execute_script(std::istream& fp, T& context,
+                             const bool& concurrent_mode) {
+  std::string line;
+
+  /* Consider that each line may not end due to the continued line charactor 
+   * Use cmd_line to conjunct multiple lines 
+   */
+  std::string cmd_line;
+
+  /* In concurrent mode, consecutive read-only commands are pending until
+   * a command which can not join them is reached */
+  std::vector<std::string> concurrent_cmd_lines;
+  std::vector<ShellCommandId> concurrent_cmd_ids;
+
+  bool fatal_error = false;
+
+  /* Read line by line */
+  while (getline(fp, line)) {
+    /* Skip empty line */
+    if (true == line.empty()) {
+      continue;
+    }
+
+    /* If the line that starts with '#', it is commented, we can skip */ 
+    if ('#' == line.front()) {
+      continue;
+    }
+    /* Try to split the line with '#', the string before '#' is the read command we want */
+    std::string cmd_part = line;
+    std::size_t cmd_end_pos = line.find_first_of('#');
+    /* If the full line has '#', we need the part before it */
+    if (cmd_end_pos != std::string::npos) {
+      cmd_part = line.substr(0, cmd_end_pos);
+    }
+
+    /* Remove the space at the end of the line
+     * So that we can check easily if there is a continued line in the end  
+     */
+    StringToken cmd_part_tokenizer(cmd_part);
+    cmd_part_tokenizer.rtrim(std::string(" "));
+    cmd_part = cmd_part_tokenizer.data();
+
+    /* If the line ends with '\', this is a continued line, parse the next until it ends */
+    if ('\\' == cmd_part.back()) {
+      /* Pop up the last charactor and conjunct to cmd_line */
+      cmd_part.pop_back();
+ 
+      if (!cmd_part.empty()) {
+        cmd_line += cmd_part; 
+      }
+      /* Not finished yet. Parse the next line */
+      continue;
+    } else {
+      /* End of this line, if cmd_line is empty, 
+       * there is no previous lines, cache the part we have
+       * and then execute the command 
+       */
+      cmd_line += cmd_part;
+    }
+
+    /* Remove the space at the beginning of the line */
+    StringToken cmd_line_tokenizer(cmd_line);
+    cmd_line_tokenizer.ltrim(std::string(" "));
+    cmd_line = cmd_line_tokenizer.data();
+
+    /* Process the command only when the full command line in ended */
+    if (!cmd_line.empty()) {
+      int status = CMD_EXEC_SUCCESS;
+      bool concurrent_cmd = false;
+      if (concurrent_mode) {
+        StringToken cmd_name_tokenizer(cmd_line);
+        ShellCommandId cmd_id = command(cmd_name_tokenizer.split(" ").front());
+        concurrent_cmd = concurrent_command(cmd_id, std::vector<ShellCommandId>());
+        /* A read-only command which can not join the pending commands starts a new group */
+        if ( (true == concurrent_cmd)
+          && (false == concurrent_command(cmd_id, concurrent_cmd_ids)) ) {
+          status = execute_concurrent_commands(concurrent_cmd_lines, context);
+          concurrent_cmd_lines.clear();
+          concurrent_cmd_ids.clear();
+        }
+        if ( (true == concurrent_cmd)
+          && (CMD_EXEC_FATAL_ERROR != status) ) {
+          concurrent_cmd_lines.push_back(cmd_line);
+          concurrent_cmd_ids.push_back(cmd_id);
+        }
+      }
+
+      /* The pending commands must finish before any other command */
+      if ( (false == concurrent_cmd)
+        && (!concurrent_cmd_lines.empty()) ) {
+        status = execute_concurrent_commands(concurrent_cmd_lines, context);
+        concurrent_cmd_lines.clear();
+        concurrent_cmd_ids.clear();
+      }
+      if ( (false == concurrent_cmd)
+        && (CMD_EXEC_FATAL_ERROR != status) ) {
+        VTR_LOG("\nCommand line to execute: %s\n", cmd_line.c_str());
+        /* Do not allow any hidden command to be directly called by users */
+        status = execute_command(cmd_line.c_str(), context, false);
+      }
+      /* Empty the line ready to start a new line */
+      cmd_line.clear();
+
+      /* Check the execution status of the command, 
+       * if fatal error happened, we should abort immediately 
+       */
+      if (CMD_EXEC_FATAL_ERROR == status) {
+        fatal_error = true;
+        break;
+      }
+    }
+  }
+
+  /* Execute the commands pending at the end of the script */
+  if ( (false == fatal_error) && (!concurrent_cmd_lines.empty()) ) {
+    fatal_error = (CMD_EXEC_FATAL_ERROR == execute_concurrent_commands(concurrent_cmd_lines, context));
+  }
+
+  if (true == fatal_error) {
+    return CMD_EXEC_FATAL_ERROR;
+  }
+  return CMD_EXEC_SUCCESS;
+}
+
 } /* End namespace openfpga */
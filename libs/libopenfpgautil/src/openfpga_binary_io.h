@@ -0,0 +1,468 @@
+#ifndef OPENFPGA_BINARY_IO_H
+#define OPENFPGA_BINARY_IO_H
+
+/********************************************************************
+ * Include header files that are required by function declaration
+ *******************************************************************/
+#include <array>
+#include <cstdint>
+#include <istream>
+#include <limits>
+#include <map>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "openfpga_port.h"
+#include "vtr_geometry.h"
+#include "vtr_strong_id.h"
+#include "vtr_vector.h"
+
+/********************************************************************
+ * Helpers to dump the internal data of a data structure to a binary
+ * stream and to load it back. Every container is written as its size
+ * followed by its elements; arrays of plain values are written in
+ * one shot, so that the file mostly contains flat arrays.
+ *
+ * The binary layout depends on the platform and is only meant to be
+ * read back by the same build, e.g., as a cache of the fabric.
+ *
+ * The size of a container is checked against the bytes left in the
+ * stream before anything is allocated. A truncated or corrupted file
+ * leaves the stream in a failed state, which readers are expected to
+ * check, instead of throwing or exhausting the memory.
+ *
+ * Usage:
+ *   write_binary_data(fp, my_vector);
+ *   read_binary_data(fp, my_vector);
+ *******************************************************************/
+/* namespace openfpga begins */
+namespace openfpga {
+
+/* Generic template, specialized for each supported type below */
+template <class T, class Enable = void>
+struct BinaryIO;
+
+/* Types which can be copied byte by byte */
+template <class T>
+struct is_binary_blittable
+  : std::integral_constant<bool, (std::is_arithmetic<T>::value ||
+                                  std::is_enum<T>::value) &&
+                                   !std::is_same<T, bool>::value> {};
+
+template <class tag, class T, T sentinel>
+struct is_binary_blittable<vtr::StrongId<tag, T, sentinel>>
+  : std::true_type {};
+
+template <class T>
+void write_binary_data(std::ostream& fp, const T& value) {
+  BinaryIO<T>::write(fp, value);
+}
+
+template <class T>
+void read_binary_data(std::istream& fp, T& value) {
+  BinaryIO<T>::read(fp, value);
+}
+
+/* Sizes of containers are always 64-bit whatever the platform is */
+inline void write_binary_size(std::ostream& fp, const size_t& size) {
+  uint64_t value = size;
+  fp.write(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+inline size_t read_binary_size(std::istream& fp) {
+  uint64_t value = 0;
+  fp.read(reinterpret_cast<char*>(&value), sizeof(value));
+  return size_t(value);
+}
+
+/* Check if a number of bytes can still be read from a stream. The buffer of
+ * the stream is checked first, so that the stream is seldom repositioned */
+inline bool binary_bytes_available(std::istream& fp, const size_t& num_bytes) {
+  if (0 == num_bytes) {
+    return true;
+  }
+  std::streamsize num_buffered = fp.rdbuf()->in_avail();
+  if ((0 < num_buffered) && (num_bytes <= size_t(num_buffered))) {
+    return true;
+  }
+  std::streampos curr_pos = fp.tellg();
+  if (std::streampos(-1) == curr_pos) {
+    return false;
+  }
+  fp.seekg(0, std::ios::end);
+  std::streampos end_pos = fp.tellg();
+  fp.seekg(curr_pos);
+  if ((std::streampos(-1) == end_pos) || (false == fp.good())) {
+    return false;
+  }
+  return num_bytes <= size_t(end_pos - curr_pos);
+}
+
+/* Read the size of a container whose elements take at least a given number
+ * of bytes each in the stream. A size which does not fit in the rest of the
+ * stream comes from a truncated or corrupted file: the stream is then put in
+ * a failed state and zero is returned, so that nothing is allocated */
+inline size_t read_binary_container_size(std::istream& fp,
+                                         const size_t& elem_num_bytes) {
+  size_t size = read_binary_size(fp);
+  if (false == fp.good()) {
+    return 0;
+  }
+  if ((0 < elem_num_bytes) &&
+      ((size > std::numeric_limits<size_t>::max() / elem_num_bytes) ||
+       (false == binary_bytes_available(fp, size * elem_num_bytes)))) {
+    fp.setstate(std::ios::failbit);
+    return 0;
+  }
+  return size;
+}
+
+/* Minimum number of bytes taken by a value in the stream: plain values are
+ * copied byte by byte, while any other value takes at least one byte */
+template <class T>
+constexpr size_t binary_min_num_bytes() {
+  return is_binary_blittable<T>::value ? sizeof(T) : 1;
+}
+
+/* Plain values */
+template <class T>
+struct BinaryIO<T,
+                typename std::enable_if<is_binary_blittable<T>::value>::type> {
+  static void write(std::ostream& fp, const T& value) {
+    fp.write(reinterpret_cast<const char*>(&value), sizeof(T));
+  }
+  static void read(std::istream& fp, T& value) {
+    fp.read(reinterpret_cast<char*>(&value), sizeof(T));
+  }
+};
+
+template <>
+struct BinaryIO<bool> {
+  static void write(std::ostream& fp, const bool& value) {
+    char byte = value ? 1 : 0;
+    fp.write(&byte, 1);
+  }
+  static void read(std::istream& fp, bool& value) {
+    char byte = 0;
+    fp.read(&byte, 1);
+    value = (0 != byte);
+  }
+};
+
+template <>
+struct BinaryIO<std::string> {
+  static void write(std::ostream& fp, const std::string& value) {
+    write_binary_size(fp, value.size());
+    fp.write(value.data(), value.size());
+  }
+  static void read(std::istream& fp, std::string& value) {
+    value.resize(read_binary_container_size(fp, 1));
+    fp.read(&value[0], value.size());
+  }
+};
+
+/* Sequences: both std::vector and vtr::vector share the same layout */
+template <class Seq, class V>
+void write_binary_sequence(std::ostream& fp, const Seq& seq) {
+  write_binary_size(fp, seq.size());
+  if (true == is_binary_blittable<V>::value) {
+    if (0 < seq.size()) {
+      fp.write(reinterpret_cast<const char*>(seq.data()),
+               seq.size() * sizeof(V));
+    }
+    return;
+  }
+  for (const V& elem : seq) {
+    BinaryIO<V>::write(fp, elem);
+  }
+}
+
+template <class Seq, class V>
+void read_binary_sequence(std::istream& fp, Seq& seq) {
+  size_t size = read_binary_container_size(fp, binary_min_num_bytes<V>());
+  seq.clear();
+  if (true == is_binary_blittable<V>::value) {
+    seq.resize(size);
+    if (0 < size) {
+      fp.read(reinterpret_cast<char*>(seq.data()), size * sizeof(V));
+    }
+    return;
+  }
+  seq.reserve(size);
+  for (size_t ielem = 0; (ielem < size) && (true == fp.good()); ++ielem) {
+    V elem;
+    BinaryIO<V>::read(fp, elem);
+    seq.push_back(std::move(elem));
+  }
+}
+
+template <class V, class A>
+struct BinaryIO<std::vector<V, A>,
+                typename std::enable_if<!std::is_same<V, bool>::value>::type> {
+  static void write(std::ostream& fp, const std::vector<V, A>& value) {
+    write_binary_sequence<std::vector<V, A>, V>(fp, value);
+  }
+  static void read(std::istream& fp, std::vector<V, A>& value) {
+    read_binary_sequence<std::vector<V, A>, V>(fp, value);
+  }
+};
+
+/* std::vector<bool> is packed and has no data(), go through its elements */
+template <class A>
+struct BinaryIO<std::vector<bool, A>> {
+  static void write(std::ostream& fp, const std::vector<bool, A>& value) {
+    write_binary_size(fp, value.size());
+    for (const bool elem : value) {
+      BinaryIO<bool>::write(fp, elem);
+    }
+  }
+  static void read(std::istream& fp, std::vector<bool, A>& value) {
+    value.resize(read_binary_container_size(fp, 1));
+    for (size_t ielem = 0; ielem < value.size(); ++ielem) {
+      bool elem = false;
+      BinaryIO<bool>::read(fp, elem);
+      value[ielem] = elem;
+    }
+  }
+};
+
+template <class K, class V, class A>
+struct BinaryIO<vtr::vector<K, V, A>,
+                typename std::enable_if<!std::is_same<V, bool>::value>::type> {
+  static void write(std::ostream& fp, const vtr::vector<K, V, A>& value) {
+    write_binary_sequence<vtr::vector<K, V, A>, V>(fp, value);
+  }
+  static void read(std::istream& fp, vtr::vector<K, V, A>& value) {
+    read_binary_sequence<vtr::vector<K, V, A>, V>(fp, value);
+  }
+};
+
+template <class K, class A>
+struct BinaryIO<vtr::vector<K, bool, A>> {
+  static void write(std::ostream& fp, const vtr::vector<K, bool, A>& value) {
+    write_binary_size(fp, value.size());
+    for (const bool elem : value) {
+      BinaryIO<bool>::write(fp, elem);
+    }
+  }
+  static void read(std::istream& fp, vtr::vector<K, bool, A>& value) {
+    value.resize(read_binary_container_size(fp, 1));
+    for (size_t ielem = 0; ielem < value.size(); ++ielem) {
+      bool elem = false;
+      BinaryIO<bool>::read(fp, elem);
+      value[K(ielem)] = elem;
+    }
+  }
+};
+
+/* Fixed-size arrays have no size to be written */
+template <class V, size_t N>
+struct BinaryIO<std::array<V, N>> {
+  static void write(std::ostream& fp, const std::array<V, N>& value) {
+    for (const V& elem : value) {
+      BinaryIO<V>::write(fp, elem);
+    }
+  }
+  static void read(std::istream& fp, std::array<V, N>& value) {
+    for (V& elem : value) {
+      BinaryIO<V>::read(fp, elem);
+    }
+  }
+};
+
+template <class F, class S>
+struct BinaryIO<std::pair<F, S>> {
+  static void write(std::ostream& fp, const std::pair<F, S>& value) {
+    BinaryIO<F>::write(fp, value.first);
+    BinaryIO<S>::write(fp, value.second);
+  }
+  static void read(std::istream& fp, std::pair<F, S>& value) {
+    BinaryIO<F>::read(fp, value.first);
+    BinaryIO<S>::read(fp, value.second);
+  }
+};
+
+/* Associative containers are written as a list of key-value pairs */
+template <class Map>
+void write_binary_map(std::ostream& fp, const Map& map) {
+  write_binary_size(fp, map.size());
+  for (const auto& pair : map) {
+    BinaryIO<typename Map::key_type>::write(fp, pair.first);
+    BinaryIO<typename Map::mapped_type>::write(fp, pair.second);
+  }
+}
+
+template <class Map>
+void read_binary_map(std::istream& fp, Map& map) {
+  size_t size = read_binary_container_size(
+    fp, binary_min_num_bytes<typename Map::key_type>() +
+          binary_min_num_bytes<typename Map::mapped_type>());
+  map.clear();
+  for (size_t ielem = 0; (ielem < size) && (true == fp.good()); ++ielem) {
+    typename Map::key_type key;
+    BinaryIO<typename Map::key_type>::read(fp, key);
+    BinaryIO<typename Map::mapped_type>::read(fp, map[key]);
+  }
+}
+
+template <class K, class V, class C, class A>
+struct BinaryIO<std::map<K, V, C, A>> {
+  static void write(std::ostream& fp, const std::map<K, V, C, A>& value) {
+    write_binary_map(fp, value);
+  }
+  static void read(std::istream& fp, std::map<K, V, C, A>& value) {
+    read_binary_map(fp, value);
+  }
+};
+
+template <class K, class V, class H, class E, class A>
+struct BinaryIO<std::unordered_map<K, V, H, E, A>> {
+  static void write(std::ostream& fp,
+                    const std::unordered_map<K, V, H, E, A>& value) {
+    write_binary_map(fp, value);
+  }
+  static void read(std::istream& fp, std::unordered_map<K, V, H, E, A>& value) {
+    read_binary_map(fp, value);
+  }
+};
+
+template <class V, class H, class E, class A>
+struct BinaryIO<std::unordered_set<V, H, E, A>> {
+  static void write(std::ostream& fp,
+                    const std::unordered_set<V, H, E, A>& value) {
+    write_binary_size(fp, value.size());
+    for (const V& elem : value) {
+      BinaryIO<V>::write(fp, elem);
+    }
+  }
+  static void read(std::istream& fp, std::unordered_set<V, H, E, A>& value) {
+    size_t size = read_binary_container_size(fp, binary_min_num_bytes<V>());
+    value.clear();
+    value.reserve(size);
+    for (size_t ielem = 0; (ielem < size) && (true == fp.good()); ++ielem) {
+      V elem;
+      BinaryIO<V>::read(fp, elem);
+      value.insert(elem);
+    }
+  }
+};
+
+template <class T>
+struct BinaryIO<vtr::Point<T>> {
+  static void write(std::ostream& fp, const vtr::Point<T>& value) {
+    BinaryIO<T>::write(fp, value.x());
+    BinaryIO<T>::write(fp, value.y());
+  }
+  static void read(std::istream& fp, vtr::Point<T>& value) {
+    T x;
+    T y;
+    BinaryIO<T>::read(fp, x);
+    BinaryIO<T>::read(fp, y);
+    value = vtr::Point<T>(x, y);
+  }
+};
+
+template <class T>
+struct BinaryIO<vtr::Rect<T>> {
+  static void write(std::ostream& fp, const vtr::Rect<T>& value) {
+    BinaryIO<T>::write(fp, value.xmin());
+    BinaryIO<T>::write(fp, value.ymin());
+    BinaryIO<T>::write(fp, value.xmax());
+    BinaryIO<T>::write(fp, value.ymax());
+  }
+  static void read(std::istream& fp, vtr::Rect<T>& value) {
+    T xmin;
+    T ymin;
+    T xmax;
+    T ymax;
+    BinaryIO<T>::read(fp, xmin);
+    BinaryIO<T>::read(fp, ymin);
+    BinaryIO<T>::read(fp, xmax);
+    BinaryIO<T>::read(fp, ymax);
+    value = vtr::Rect<T>(xmin, ymin, xmax, ymax);
+  }
+};
+
+/* Sequences of strings with many repeated entries, e.g., names of modules,
+ * are written as a table of the distinct strings, stored as a single block
+ * of characters with the offsets of each entry, followed by the index of the
+ * entry of each element. The whole table is loaded in two reads */
+template <class Seq>
+void write_binary_string_table(std::ostream& fp, const Seq& strings) {
+  std::unordered_map<std::string_view, uint32_t> table_ids;
+  std::string table;
+  std::vector<uint64_t> table_offsets(1, 0);
+  std::vector<uint32_t> ids;
+  ids.reserve(strings.size());
+  for (const std::string& str : strings) {
+    auto result = table_ids.emplace(std::string_view(str),
+                                    uint32_t(table_offsets.size() - 1));
+    if (true == result.second) {
+      table += str;
+      table_offsets.push_back(table.size());
+    }
+    ids.push_back(result.first->second);
+  }
+  BinaryIO<std::string>::write(fp, table);
+  BinaryIO<std::vector<uint64_t>>::write(fp, table_offsets);
+  BinaryIO<std::vector<uint32_t>>::write(fp, ids);
+}
+
+template <class Seq>
+void read_binary_string_table(std::istream& fp, Seq& strings) {
+  std::string table;
+  std::vector<uint64_t> table_offsets;
+  std::vector<uint32_t> ids;
+  BinaryIO<std::string>::read(fp, table);
+  BinaryIO<std::vector<uint64_t>>::read(fp, table_offsets);
+  BinaryIO<std::vector<uint32_t>>::read(fp, ids);
+  strings.clear();
+  strings.reserve(ids.size());
+  for (const uint32_t& id : ids) {
+    /* Corrupted table: leave the stream in a failed state */
+    if ((size_t(id) + 1 >= table_offsets.size()) ||
+        (table_offsets[id] > table_offsets[id + 1]) ||
+        (table_offsets[id + 1] > table.size())) {
+      fp.setstate(std::ios::failbit);
+      return;
+    }
+    strings.emplace_back(table, table_offsets[id],
+                         table_offsets[id + 1] - table_offsets[id]);
+  }
+}
+
+/* Port names are written as strings, as symbol ids are only valid in the
+ * process which creates them */
+template <>
+struct BinaryIO<BasicPort> {
+  static void write(std::ostream& fp, const BasicPort& value) {
+    BinaryIO<std::string>::write(fp, value.get_name());
+    BinaryIO<size_t>::write(fp, value.get_lsb());
+    BinaryIO<size_t>::write(fp, value.get_msb());
+    BinaryIO<size_t>::write(fp, value.get_origin_port_width());
+  }
+  static void read(std::istream& fp, BasicPort& value) {
+    std::string name;
+    size_t lsb = 0;
+    size_t msb = 0;
+    size_t origin_port_width = 0;
+    BinaryIO<std::string>::read(fp, name);
+    BinaryIO<size_t>::read(fp, lsb);
+    BinaryIO<size_t>::read(fp, msb);
+    BinaryIO<size_t>::read(fp, origin_port_width);
+    value.set_name(name);
+    value.set_lsb(lsb);
+    value.set_msb(msb);
+    value.set_origin_port_width(origin_port_width);
+  }
+};
+
+}  // namespace openfpga
+
+#endif
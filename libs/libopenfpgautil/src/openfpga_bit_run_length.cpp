@@ -0,0 +1,106 @@
+/********************************************************************
+ * Member functions for class BitRunLengthEncoder and the decoder
+ *******************************************************************/
+#include "openfpga_bit_run_length.h"
+
+/* namespace openfpga begins */
+namespace openfpga {
+
+/************************************************************************
+ * Constructors
+ ***********************************************************************/
+BitRunLengthEncoder::BitRunLengthEncoder() { clear(); }
+
+/************************************************************************
+ * Public Accessors
+ ***********************************************************************/
+const std::vector<uint8_t>& BitRunLengthEncoder::data() const {
+  return data_;
+}
+
+size_t BitRunLengthEncoder::num_bits() const { return num_bits_; }
+
+/************************************************************************
+ * Public Mutators
+ ***********************************************************************/
+void BitRunLengthEncoder::add_bit(const bool& bit) {
+  if (bit != curr_bit_) {
+    add_run(curr_run_length_);
+    curr_bit_ = bit;
+    curr_run_length_ = 0;
+  }
+  curr_run_length_++;
+  num_bits_++;
+}
+
+void BitRunLengthEncoder::add_bits(const std::vector<bool>& bits) {
+  for (const bool& bit : bits) {
+    add_bit(bit);
+  }
+}
+
+void BitRunLengthEncoder::finish() {
+  if (0 < curr_run_length_) {
+    add_run(curr_run_length_);
+    curr_run_length_ = 0;
+    /* A following bit starts a new run of the other value */
+    curr_bit_ = !curr_bit_;
+  }
+}
+
+void BitRunLengthEncoder::clear() {
+  data_.clear();
+  num_bits_ = 0;
+  curr_bit_ = false;
+  curr_run_length_ = 0;
+}
+
+/************************************************************************
+ * Internal utility
+ ***********************************************************************/
+void BitRunLengthEncoder::add_run(const size_t& run_length) {
+  size_t value = run_length;
+  while (0x80 <= value) {
+    data_.push_back(uint8_t(0x80 | (value & 0x7f)));
+    value >>= 7;
+  }
+  data_.push_back(uint8_t(value));
+}
+
+/************************************************************************
+ * Decoder
+ ***********************************************************************/
+bool decode_bit_run_length(const uint8_t* data, const size_t& num_bytes,
+                           const size_t& num_bits, std::vector<bool>& bits) {
+  bits.clear();
+  bits.reserve(num_bits);
+
+  size_t curr_byte = 0;
+  bool curr_bit = false;
+  while (bits.size() < num_bits) {
+    /* Decode the length of the next run */
+    size_t run_length = 0;
+    size_t shift = 0;
+    while (true) {
+      if ((curr_byte >= num_bytes) || (8 * sizeof(size_t) <= shift)) {
+        return false;
+      }
+      uint8_t byte = data[curr_byte++];
+      run_length |= size_t(byte & 0x7f) << shift;
+      shift += 7;
+      if (0 == (byte & 0x80)) {
+        break;
+      }
+    }
+    if (num_bits - bits.size() < run_length) {
+      return false;
+    }
+    bits.insert(bits.end(), run_length, curr_bit);
+    curr_bit = !curr_bit;
+  }
+
+  /* All the bytes should be consumed */
+  return curr_byte == num_bytes;
+}
+
+} /* end namespace openfpga */
@@ -0,0 +1,70 @@
+#ifndef OPENFPGA_BIT_RUN_LENGTH_H
+#define OPENFPGA_BIT_RUN_LENGTH_H
+
+/********************************************************************
+ * Include header files that are required by data structure declaration
+ *******************************************************************/
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/********************************************************************
+ * A run-length codec for bit streams, e.g., bitstreams dominated by
+ * default-value bits.
+ *
+ * A bit stream is split into runs of identical bits. The runs alternate
+ * between '0' and '1', where the first run is always a run of '0'
+ * (which is empty when the stream starts with a '1'). Each run is
+ * encoded by its length as an unsigned LEB128 integer, i.e., 7 bits per
+ * byte from the least significant ones, where the MSB of a byte is set
+ * when more bytes follow.
+ *
+ * For example, the bits 0000 0001 1000 0000 are encoded as the runs
+ * 7, 2 and 7, i.e., the bytes 0x07 0x02 0x07
+ *
+ * Typical usage:
+ *   BitRunLengthEncoder encoder;
+ *   encoder.add_bit(bit);
+ *   ...
+ *   encoder.finish();
+ *   encoder.data();
+ *******************************************************************/
+/* namespace openfpga begins */
+namespace openfpga {
+
+class BitRunLengthEncoder {
+ public: /* Constructors */
+  BitRunLengthEncoder();
+
+ public: /* Public accessors */
+  /* Encoded bytes, which are complete only after finish() */
+  const std::vector<uint8_t>& data() const;
+  /* Number of bits added */
+  size_t num_bits() const;
+
+ public: /* Public mutators */
+  void add_bit(const bool& bit);
+  void add_bits(const std::vector<bool>& bits);
+  /* Encode the last run */
+  void finish();
+  /* Clear all the content, so that a new stream can be encoded */
+  void clear();
+
+ private: /* Internal utility */
+  void add_run(const size_t& run_length);
+
+ private: /* Internal data */
+  std::vector<uint8_t> data_;
+  size_t num_bits_;
+  bool curr_bit_;
+  size_t curr_run_length_;
+};
+
+/* Decode a given number of bits from a run-length encoded stream.
+ * Return false if the stream is corrupted */
+bool decode_bit_run_length(const uint8_t* data, const size_t& num_bytes,
+                           const size_t& num_bits, std::vector<bool>& bits);
+
+} /* end namespace openfpga */
+
+#endif
@@ -5,6 +5,8 @@
 #include <sys/stat.h>
 
 #include <algorithm>
+#include <charconv>
+#include <cstdio>
 #include <vector>
 
 /* Headers from vtrutil library */
@@ -39,6 +41,86 @@ void check_file_stream(const char* fname, std::fstream& fp) {
   }
 }
 
+/********************************************************************
+ * Find the path of a staging file, to which the content of a file is
+ * written before being committed by commit_staging_file().
+ * When staging is not used, the file is written in place and its own path
+ * is returned.
+ *******************************************************************/
+std::string find_staging_file_path(const std::string& fname,
+                                   const bool& use_staging) {
+  if (false == use_staging) {
+    return fname;
+  }
+  return fname + std::string(".tmp");
+}
+
+/********************************************************************
+ * Check if two files have exactly the same content
+ * The sizes of the files are compared first, so that the content is read
+ * only when the files are likely to be the same
+ *******************************************************************/
+static bool same_file_content(const std::string& fname_a,
+                              const std::string& fname_b) {
+  std::ifstream fp_a(fname_a, std::ifstream::binary | std::ifstream::ate);
+  std::ifstream fp_b(fname_b, std::ifstream::binary | std::ifstream::ate);
+  if (!fp_a.is_open() || !fp_b.is_open()) {
+    return false;
+  }
+  if (fp_a.tellg() != fp_b.tellg()) {
+    return false;
+  }
+  fp_a.seekg(0);
+  fp_b.seekg(0);
+
+  constexpr size_t BLOCK_SIZE = 1 << 16;
+  std::vector<char> block_a(BLOCK_SIZE);
+  std::vector<char> block_b(BLOCK_SIZE);
+  while (fp_a.good() && fp_b.good()) {
+    fp_a.read(block_a.data(), BLOCK_SIZE);
+    fp_b.read(block_b.data(), BLOCK_SIZE);
+    if (fp_a.gcount() != fp_b.gcount()) {
+      return false;
+    }
+    if (false == std::equal(block_a.begin(), block_a.begin() + fp_a.gcount(),
+                            block_b.begin())) {
+      return false;
+    }
+  }
+  return fp_a.eof() && fp_b.eof();
+}
+
+/********************************************************************
+ * Commit a staging file to its final path
+ * The staging file replaces the file only when their contents are
+ * different. Otherwise, the file is left in place, with its timestamp, and
+ * the staging file is removed.
+ * Return true if the file is updated
+ *******************************************************************/
+bool commit_staging_file(const std::string& staging_fname,
+                         const std::string& fname) {
+  /* The file has been written in place */
+  if (staging_fname == fname) {
+    return true;
+  }
+
+  if (true == same_file_content(staging_fname, fname)) {
+    std::remove(staging_fname.c_str());
+    return false;
+  }
+
+#ifdef _WIN32
+  /* The file to be replaced must be removed first on windows */
+  std::remove(fname.c_str());
+#endif
+  if (0 != std::rename(staging_fname.c_str(), fname.c_str())) {
+    VTR_LOG_ERROR("Fail to rename file '%s' to '%s'\n", staging_fname.c_str(),
+                  fname.c_str());
+    exit(1);
+  }
+  return true;
+}
+
 /********************************************************************
  * Format a directory path:
  * 1. Replace "\" with "/"
@@ -264,4 +346,27 @@ bool write_tab_to_file(std::fstream& fp, const size_t& num_tab) {
   return true;
 }
 
+/********************************************************************
+ * Write the content of a string buffer to a file stream in one go,
+ * and empty the buffer so that its memory can be reused.
+ * This is the output backend of the netlist writers, which format
+ * large chunks of a netlist into a buffer instead of the file stream
+ ********************************************************************/
+void write_buffer_to_file(std::fstream& fp, std::string& buffer) {
+  fp.write(buffer.data(), buffer.size());
+  buffer.clear();
+}
+
+/********************************************************************
+ * Append the decimal digits of a number to a string buffer, without
+ * creating any temporary string
+ ********************************************************************/
+void append_number_to_buffer(std::string& buffer, const size_t& number) {
+  /* Large enough for the decimal digits of any 64-bit number */
+  char digits[20];
+  std::to_chars_result result =
+    std::to_chars(digits, digits + sizeof(digits), number);
+  buffer.append(digits, result.ptr);
+}
+
 }  // namespace openfpga
@@ -5,6 +5,7 @@
  * Include header files that are required by function declaration
  *******************************************************************/
 #include <fstream>
+#include <string>
 
 /********************************************************************
  * Function declaration
@@ -16,6 +17,12 @@ bool valid_file_stream(std::fstream& fp);
 
 void check_file_stream(const char* fname, std::fstream& fp);
 
+std::string find_staging_file_path(const std::string& fname,
+                                   const bool& use_staging);
+
+bool commit_staging_file(const std::string& staging_fname,
+                         const std::string& fname);
+
 std::string format_dir_path(const std::string& dir_path_to_format);
 
 std::string find_path_file_name(const std::string& file_name);
@@ -29,6 +36,10 @@ bool write_space_to_file(std::fstream& fp, const size_t& num_space);
 
 bool write_tab_to_file(std::fstream& fp, const size_t& num_tab);
 
+void write_buffer_to_file(std::fstream& fp, std::string& buffer);
+
+void append_number_to_buffer(std::string& buffer, const size_t& number);
+
 }  // namespace openfpga
 
 #endif
@@ -0,0 +1,45 @@
+#ifndef OPENFPGA_HASH_H
+#define OPENFPGA_HASH_H
+
+/********************************************************************
+ * Include header files that are required by function declaration
+ *******************************************************************/
+#include <array>
+#include <cstddef>
+#include <functional>
+
+/********************************************************************
+ * Function declaration
+ *******************************************************************/
+/* namespace openfpga begins */
+namespace openfpga {
+
+/********************************************************************
+ * @brief Mix the hash of a value into an existing seed
+ * This follows the well-known boost::hash_combine() recipe, so that
+ * a sequence of values can be folded into a single signature.
+ * @note The result depends on the order in which values are combined
+ ********************************************************************/
+template <class T>
+inline void hash_combine(size_t& seed, const T& value) {
+  seed ^= std::hash<T>()(value) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+}
+
+/********************************************************************
+ * @brief Hash functor for fixed-size arrays, which is not provided
+ *        by the standard library. Useful as a key of unordered_map
+ ********************************************************************/
+template <class T, size_t N>
+struct ArrayHash {
+  size_t operator()(const std::array<T, N>& arr) const {
+    size_t seed = 0;
+    for (const T& elem : arr) {
+      hash_combine<T>(seed, elem);
+    }
+    return seed;
+  }
+};
+
+}  // namespace openfpga
+
+#endif
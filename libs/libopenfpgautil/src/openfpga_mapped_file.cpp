@@ -0,0 +1,98 @@
+/********************************************************************
+ * Member functions for class MappedFile
+ *******************************************************************/
+#include "openfpga_mapped_file.h"
+
+#include <fstream>
+#include <iterator>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+/* namespace openfpga begins */
+namespace openfpga {
+
+/************************************************************************
+ * Constructors
+ ***********************************************************************/
+MappedFile::MappedFile()
+  : data_(nullptr), size_(0), is_open_(false), mapped_(false) {}
+
+MappedFile::~MappedFile() { close(); }
+
+/************************************************************************
+ * Public Accessors
+ ***********************************************************************/
+const char* MappedFile::data() const { return data_; }
+
+size_t MappedFile::size() const { return size_; }
+
+bool MappedFile::is_open() const { return is_open_; }
+
+/************************************************************************
+ * Public Mutators
+ ***********************************************************************/
+bool MappedFile::open(const std::string& fname) {
+  close();
+
+#ifndef _WIN32
+  int fd = ::open(fname.c_str(), O_RDONLY);
+  if (0 > fd) {
+    return false;
+  }
+  struct stat file_stat;
+  if (0 != ::fstat(fd, &file_stat)) {
+    ::close(fd);
+    return false;
+  }
+  size_ = size_t(file_stat.st_size);
+  /* An empty file can not be mapped */
+  if (0 < size_) {
+    void* addr = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (MAP_FAILED != addr) {
+      /* The content is expected to be parsed from the head to the tail */
+      ::madvise(addr, size_, MADV_SEQUENTIAL);
+      data_ = static_cast<const char*>(addr);
+      mapped_ = true;
+    }
+  }
+  ::close(fd);
+  if ((0 == size_) || (true == mapped_)) {
+    is_open_ = true;
+    return true;
+  }
+#endif
+
+  /* Fall back to read the whole file */
+  std::ifstream fp(fname, std::ios::in | std::ios::binary);
+  if (!fp.is_open()) {
+    size_ = 0;
+    return false;
+  }
+  buffer_.assign(std::istreambuf_iterator<char>(fp),
+                 std::istreambuf_iterator<char>());
+  data_ = buffer_.data();
+  size_ = buffer_.size();
+  is_open_ = true;
+  return true;
+}
+
+void MappedFile::close() {
+#ifndef _WIN32
+  if (true == mapped_) {
+    ::munmap(const_cast<char*>(data_), size_);
+  }
+#endif
+  buffer_.clear();
+  buffer_.shrink_to_fit();
+  data_ = nullptr;
+  size_ = 0;
+  is_open_ = false;
+  mapped_ = false;
+}
+
+} /* end namespace openfpga */
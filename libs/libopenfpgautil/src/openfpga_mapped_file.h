@@ -0,0 +1,49 @@
+#ifndef OPENFPGA_MAPPED_FILE_H
+#define OPENFPGA_MAPPED_FILE_H
+
+/********************************************************************
+ * Include header files that are required by data structure declaration
+ *******************************************************************/
+#include <cstddef>
+#include <string>
+#include <vector>
+
+/* namespace openfpga begins */
+namespace openfpga {
+
+/********************************************************************
+ * A read-only view on the content of a file, which is memory-mapped
+ * when the platform supports it, so that large files are paged in
+ * on demand rather than copied to memory.
+ * When memory mapping is not available, the content is read into a
+ * buffer owned by the object.
+ *******************************************************************/
+class MappedFile {
+ public: /* Constructors */
+  MappedFile();
+  ~MappedFile();
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+
+ public: /* Public accessors */
+  const char* data() const;
+  size_t size() const;
+  bool is_open() const;
+
+ public: /* Public mutators */
+  /* Open a file, return false if the file can not be read */
+  bool open(const std::string& fname);
+  void close();
+
+ private: /* Internal data */
+  const char* data_;
+  size_t size_;
+  bool is_open_;
+  bool mapped_;
+  /* Content of the file when it is not memory-mapped */
+  std::vector<char> buffer_;
+};
+
+} /* end namespace openfpga */
+
+#endif
@@ -0,0 +1,213 @@
+#ifndef OPENFPGA_MEMORY_USAGE_H
+#define OPENFPGA_MEMORY_USAGE_H
+
+/********************************************************************
+ * Include header files that are required by function declaration
+ *******************************************************************/
+#include <array>
+#include <cstddef>
+#include <iterator>
+#include <map>
+#include <set>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+/* Headers from vtrutil library */
+#include "vtr_vector.h"
+
+/* namespace openfpga begins */
+namespace openfpga {
+
+/********************************************************************
+ * Approximate heap footprint of a data structure, in bytes
+ * - used bytes are taken by the elements stored
+ * - allocated bytes include the capacity reserved but not used, as well as
+ *   the bookkeeping of node-based containers, e.g., buckets of hash tables
+ * The footprint of the object itself, e.g., sizeof(std::vector), is not
+ * included, as it is counted by its owner.
+ ********************************************************************/
+struct MemoryUsage {
+  size_t used_bytes = 0;
+  size_t allocated_bytes = 0;
+
+  MemoryUsage& operator+=(const MemoryUsage& other) {
+    used_bytes += other.used_bytes;
+    allocated_bytes += other.allocated_bytes;
+    return *this;
+  }
+};
+
+/********************************************************************
+ * Function declaration
+ * All the overloads are declared first so that they can find each other
+ * when containers are nested
+ *******************************************************************/
+/* Any type that does not own heap memory, e.g., plain numbers and ids */
+template <class T>
+MemoryUsage heap_memory_usage(const T& data);
+
+inline MemoryUsage heap_memory_usage(const std::string& data);
+
+template <class T1, class T2>
+MemoryUsage heap_memory_usage(const std::pair<T1, T2>& data);
+
+template <class T, size_t N>
+MemoryUsage heap_memory_usage(const std::array<T, N>& data);
+
+template <class T, class A>
+MemoryUsage heap_memory_usage(const std::vector<T, A>& data);
+
+template <class A>
+MemoryUsage heap_memory_usage(const std::vector<bool, A>& data);
+
+template <class K, class V, class A>
+MemoryUsage heap_memory_usage(const vtr::vector<K, V, A>& data);
+
+template <class K, class V, class C, class A>
+MemoryUsage heap_memory_usage(const std::map<K, V, C, A>& data);
+
+template <class K, class C, class A>
+MemoryUsage heap_memory_usage(const std::set<K, C, A>& data);
+
+template <class K, class V, class H, class E, class A>
+MemoryUsage heap_memory_usage(const std::unordered_map<K, V, H, E, A>& data);
+
+template <class K, class V, class H, class E, class A>
+MemoryUsage heap_memory_usage(
+  const std::unordered_multimap<K, V, H, E, A>& data);
+
+template <class K, class H, class E, class A>
+MemoryUsage heap_memory_usage(const std::unordered_set<K, H, E, A>& data);
+
+/********************************************************************
+ * Internal utilities
+ *******************************************************************/
+/* Sum up the heap memory owned by the elements of a container, which is
+ * skipped for the element types that never own any */
+template <class Iterator>
+MemoryUsage elements_heap_memory_usage(const Iterator& begin,
+                                       const Iterator& end) {
+  typedef typename std::iterator_traits<Iterator>::value_type value_type;
+  MemoryUsage usage;
+  if (std::is_trivially_copyable<value_type>::value) {
+    return usage;
+  }
+  for (Iterator it = begin; it != end; ++it) {
+    usage += heap_memory_usage(*it);
+  }
+  return usage;
+}
+
+/* Nodes of a tree or a hash table: the value with a few pointers */
+template <class Container>
+MemoryUsage node_container_memory_usage(const Container& data,
+                                        const size_t& num_node_pointers) {
+  typedef typename Container::value_type value_type;
+  MemoryUsage usage;
+  usage.used_bytes = data.size() * sizeof(value_type);
+  usage.allocated_bytes =
+    data.size() * (sizeof(value_type) + num_node_pointers * sizeof(void*));
+  usage += elements_heap_memory_usage(data.begin(), data.end());
+  return usage;
+}
+
+/* A hash table also allocates its buckets, and caches the hash in its
+ * nodes */
+template <class Container>
+MemoryUsage hash_container_memory_usage(const Container& data) {
+  MemoryUsage usage = node_container_memory_usage(data, 2);
+  usage.allocated_bytes += data.bucket_count() * sizeof(void*);
+  return usage;
+}
+
+/********************************************************************
+ * Function definition
+ *******************************************************************/
+template <class T>
+MemoryUsage heap_memory_usage(const T&) {
+  return MemoryUsage();
+}
+
+/* Short strings are stored in the object itself */
+inline MemoryUsage heap_memory_usage(const std::string& data) {
+  MemoryUsage usage;
+  if (data.capacity() > std::string().capacity()) {
+    usage.used_bytes = data.size() + 1;
+    usage.allocated_bytes = data.capacity() + 1;
+  }
+  return usage;
+}
+
+template <class T1, class T2>
+MemoryUsage heap_memory_usage(const std::pair<T1, T2>& data) {
+  MemoryUsage usage = heap_memory_usage(data.first);
+  usage += heap_memory_usage(data.second);
+  return usage;
+}
+
+template <class T, size_t N>
+MemoryUsage heap_memory_usage(const std::array<T, N>& data) {
+  return elements_heap_memory_usage(data.begin(), data.end());
+}
+
+template <class T, class A>
+MemoryUsage heap_memory_usage(const std::vector<T, A>& data) {
+  MemoryUsage usage;
+  usage.used_bytes = data.size() * sizeof(T);
+  usage.allocated_bytes = data.capacity() * sizeof(T);
+  usage += elements_heap_memory_usage(data.begin(), data.end());
+  return usage;
+}
+
+/* Bits are packed in a std::vector<bool> */
+template <class A>
+MemoryUsage heap_memory_usage(const std::vector<bool, A>& data) {
+  MemoryUsage usage;
+  usage.used_bytes = data.size() / 8;
+  usage.allocated_bytes = data.capacity() / 8;
+  return usage;
+}
+
+template <class K, class V, class A>
+MemoryUsage heap_memory_usage(const vtr::vector<K, V, A>& data) {
+  MemoryUsage usage;
+  usage.used_bytes = data.size() * sizeof(V);
+  usage.allocated_bytes = data.capacity() * sizeof(V);
+  usage += elements_heap_memory_usage(data.begin(), data.end());
+  return usage;
+}
+
+template <class K, class V, class C, class A>
+MemoryUsage heap_memory_usage(const std::map<K, V, C, A>& data) {
+  /* Parent, left, right and color */
+  return node_container_memory_usage(data, 4);
+}
+
+template <class K, class C, class A>
+MemoryUsage heap_memory_usage(const std::set<K, C, A>& data) {
+  return node_container_memory_usage(data, 4);
+}
+
+template <class K, class V, class H, class E, class A>
+MemoryUsage heap_memory_usage(const std::unordered_map<K, V, H, E, A>& data) {
+  return hash_container_memory_usage(data);
+}
+
+template <class K, class V, class H, class E, class A>
+MemoryUsage heap_memory_usage(
+  const std::unordered_multimap<K, V, H, E, A>& data) {
+  return hash_container_memory_usage(data);
+}
+
+template <class K, class H, class E, class A>
+MemoryUsage heap_memory_usage(const std::unordered_set<K, H, E, A>& data) {
+  return hash_container_memory_usage(data);
+}
+
+}  // namespace openfpga
+
+#endif
@@ -0,0 +1,132 @@
+/********************************************************************
+ * This file includes functions that help to run loops with multiple
+ * threads in OpenFPGA framework
+ *******************************************************************/
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <cstdlib>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/* Headers from vtrutil library */
+#include "vtr_log.h"
+
+/* Headers from openfpgautil library */
+#include "openfpga_parallel.h"
+
+namespace openfpga {
+
+/********************************************************************
+ * Find the actual number of threads to be used
+ *******************************************************************/
+size_t find_num_threads(const size_t& num_threads) {
+  if (0 < num_threads) {
+    return num_threads;
+  }
+  /* hardware_concurrency() may return 0 when it is not computable */
+  return std::max(size_t(1), size_t(std::thread::hardware_concurrency()));
+}
+
+/********************************************************************
+ * Parse a number of threads given by users. Unlike std::atoi(), any text
+ * which is not a number, e.g., 'abc' or '4k', is rejected instead of
+ * being read as 0 (which means all the hardware threads) or 4
+ *******************************************************************/
+bool parse_num_threads(const std::string& value, size_t& num_threads) {
+  if ((true == value.empty()) ||
+      (std::string::npos != value.find_first_not_of("0123456789"))) {
+    VTR_LOG_ERROR(
+      "Invalid number of threads '%s' which should be 0 or a positive "
+      "number!\n",
+      value.c_str());
+    return false;
+  }
+  errno = 0;
+  unsigned long long number = std::strtoull(value.c_str(), nullptr, 10);
+  if ((ERANGE == errno) || (size_t(number) != number)) {
+    VTR_LOG_ERROR("Number of threads '%s' is out of range!\n", value.c_str());
+    return false;
+  }
+  num_threads = size_t(number);
+  return true;
+}
+
+/********************************************************************
+ * Execute a function on each index of [0, num_items) with a pool of
+ * threads.
+ * Each worker grabs a chunk of consecutive indices from a shared
+ * counter until all the indices are consumed. The chunk size is
+ * chosen so that each thread gets several chunks, which balances the
+ * load when some items are much more expensive than others.
+ *******************************************************************/
+void parallel_for_with_thread_id(
+  const size_t& num_items, const size_t& num_threads,
+  const std::function<void(const size_t&, const size_t&)>& func) {
+  size_t num_workers = std::min(find_num_threads(num_threads), num_items);
+  /* Fast path: no need to spawn any thread */
+  if (1 >= num_workers) {
+    for (size_t index = 0; index < num_items; ++index) {
+      func(index, 0);
+    }
+    return;
+  }
+
+  const size_t chunk_size = std::max(size_t(1), num_items / (8 * num_workers));
+  std::atomic<size_t> next_index(0);
+  std::exception_ptr first_exception = nullptr;
+  std::mutex exception_mutex;
+
+  auto worker = [&](const size_t& thread_id) {
+    while (true) {
+      size_t begin = next_index.fetch_add(chunk_size);
+      if (begin >= num_items) {
+        return;
+      }
+      size_t end = std::min(begin + chunk_size, num_items);
+      try {
+        for (size_t index = begin; index < end; ++index) {
+          func(index, thread_id);
+        }
+      } catch (...) {
+        std::lock_guard<std::mutex> lock(exception_mutex);
+        if (nullptr == first_exception) {
+          first_exception = std::current_exception();
+        }
+        /* Stop dispatching the remaining items */
+        next_index.store(num_items);
+        return;
+      }
+    }
+  };
+
+  std::vector<std::thread> threads;
+  threads.reserve(num_workers - 1);
+  for (size_t ithread = 0; ithread < num_workers - 1; ++ithread) {
+    threads.emplace_back(worker, ithread + 1);
+  }
+  /* The calling thread also works, as the thread 0 */
+  worker(0);
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+
+  if (nullptr != first_exception) {
+    std::rethrow_exception(first_exception);
+  }
+}
+
+/********************************************************************
+ * Execute a function on each index of [0, num_items) with a pool of
+ * threads, when the function does not care about the thread id
+ *******************************************************************/
+void parallel_for(const size_t& num_items, const size_t& num_threads,
+                  const std::function<void(const size_t&)>& func) {
+  parallel_for_with_thread_id(
+    num_items, num_threads,
+    [&func](const size_t& index, const size_t&) { func(index); });
+}
+
+}  // namespace openfpga
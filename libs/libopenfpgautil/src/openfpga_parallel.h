@@ -0,0 +1,66 @@
+#ifndef OPENFPGA_PARALLEL_H
+#define OPENFPGA_PARALLEL_H
+
+/********************************************************************
+ * Include header files that are required by function declaration
+ *******************************************************************/
+#include <cstddef>
+#include <functional>
+#include <string>
+
+/********************************************************************
+ * Function declaration
+ *******************************************************************/
+/* namespace openfpga begins */
+namespace openfpga {
+
+/********************************************************************
+ * @brief Find the actual number of threads to be used
+ * @param num_threads the number of threads requested by users.
+ *        Zero means using all the hardware threads available
+ * @return a number which is always at least 1
+ ********************************************************************/
+size_t find_num_threads(const size_t& num_threads);
+
+/********************************************************************
+ * @brief Parse a number of threads (or processes) given by users,
+ *        e.g., the value of option --threads
+ * @param value the text to parse, which should be a decimal number
+ *        without any sign, space or suffix
+ * @param num_threads the number parsed, which is not touched when the
+ *        text is invalid
+ * @return true if the text is valid. Otherwise, an error is reported
+ ********************************************************************/
+bool parse_num_threads(const std::string& value, size_t& num_threads);
+
+/********************************************************************
+ * @brief Execute a function on each index of [0, num_items) with a
+ *        pool of threads. Items are dispatched to threads in small
+ *        chunks on demand, so that the load is balanced even when the
+ *        work per item is irregular.
+ * @param num_items the number of items to process
+ * @param num_threads the number of threads to use. When it is 1, or
+ *        there is no more than 1 item, everything runs in the
+ *        calling thread, in ascending order of indices
+ * @param func the function to execute on each index. It should only
+ *        write the data owned by the index, as no locking is applied
+ * @note The first exception thrown by a worker (if any) is rethrown
+ *       in the calling thread after all the workers are joined
+ ********************************************************************/
+void parallel_for(const size_t& num_items, const size_t& num_threads,
+                  const std::function<void(const size_t&)>& func);
+
+/********************************************************************
+ * @brief Same as parallel_for() but the function also receives the
+ *        index of the thread which executes it, in the range of
+ *        [0, find_num_threads(num_threads)). This is useful when each
+ *        thread owns a private context (e.g., a staging database)
+ * @note Each thread processes its items in ascending order of indices
+ ********************************************************************/
+void parallel_for_with_thread_id(
+  const size_t& num_items, const size_t& num_threads,
+  const std::function<void(const size_t&, const size_t&)>& func);
+
+}  // namespace openfpga
+
+#endif
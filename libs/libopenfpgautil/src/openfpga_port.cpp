@@ -1,6 +1,5 @@
 #include <algorithm>
 #include <limits>
-#include <numeric>
 
 /* Headers from vtrutil library */
 #include "openfpga_port.h"
@@ -19,6 +18,7 @@ namespace openfpga {
 /* Default constructor */
 BasicPort::BasicPort() {
   /* By default we set an invalid port, which size is 0 */
+  name_ = SymbolTable::EMPTY_SYMBOL;
   lsb_ = 1;
   msb_ = 0;
 
@@ -27,7 +27,7 @@ BasicPort::BasicPort() {
 
 /* Quick constructor */
 BasicPort::BasicPort(const char* name, const size_t& lsb, const size_t& msb) {
-  set_name(std::string(name));
+  set_name(std::string_view(name));
   set_width(lsb, msb);
   set_origin_port_width(-1);
 }
@@ -40,7 +40,7 @@ BasicPort::BasicPort(const std::string& name, const size_t& lsb,
 }
 
 BasicPort::BasicPort(const char* name, const size_t& width) {
-  set_name(std::string(name));
+  set_name(std::string_view(name));
   set_width(width);
   set_origin_port_width(-1);
 }
@@ -51,6 +51,19 @@ BasicPort::BasicPort(const std::string& name, const size_t& width) {
   set_origin_port_width(-1);
 }
 
+BasicPort::BasicPort(std::string_view name, const size_t& lsb,
+                     const size_t& msb) {
+  set_name(name);
+  set_width(lsb, msb);
+  set_origin_port_width(-1);
+}
+
+BasicPort::BasicPort(std::string_view name, const size_t& width) {
+  set_name(name);
+  set_width(width);
+  set_origin_port_width(-1);
+}
+
 /************************************************************************
  * Accessors
  ***********************************************************************/
@@ -69,30 +82,23 @@ size_t BasicPort::get_msb() const { return msb_; }
 size_t BasicPort::get_lsb() const { return lsb_; }
 
 /* get the name */
-std::string BasicPort::get_name() const { return name_; }
-
-/* Make a range of the pin indices */
-std::vector<size_t> BasicPort::pins() const {
-  std::vector<size_t> pin_indices;
+const std::string& BasicPort::get_name() const {
+  return symbol_string(name_);
+}
 
-  /* Return if the port is invalid */
-  if (false == is_valid()) {
-    return pin_indices; /* Return an empty vector */
-  }
-  /* For valid ports, create a vector whose length is the port width */
-  pin_indices.resize(get_width());
-  /* Fill in an incremental sequence */
-  std::iota(pin_indices.begin(), pin_indices.end(), get_lsb());
-  /* Ensure the last one is MSB */
-  VTR_ASSERT(get_msb() == pin_indices.back());
+/* get the interned handle of the name */
+SymbolId BasicPort::get_name_symbol() const { return name_; }
 
-  return pin_indices;
+/* Make a range of the pin indices */
+BasicPortPinRange BasicPort::pins() const {
+  /* An invalid port has an empty range */
+  return BasicPortPinRange(get_lsb(), get_width());
 }
 
 /* Check if a port can be merged with this port: their name should be the same
  */
 bool BasicPort::mergeable(const BasicPort& portA) const {
-  return (0 == this->get_name().compare(portA.get_name()));
+  return this->name_ == portA.name_;
 }
 
 /* Check if a port is contained by this port:
@@ -121,13 +127,11 @@ size_t BasicPort::find_ipin(const BasicPort& ref_port) const {
   if (!ref_port.is_valid() || ref_port.get_width() != 1) {
     return get_width(); /* Return an invalid range */
   }
-  /* Must cache the pin list otherwise the begin() and end() are not constant */
-  auto pin_list = pins();
-  auto it = std::find(pin_list.begin(), pin_list.end(), ref_port.get_lsb());
-  if (it == pin_list.end()) {
+  /* The pins are consecutive from the LSB */
+  if ((ref_port.get_lsb() < get_lsb()) || (ref_port.get_lsb() > get_msb())) {
     return get_width(); /* Out of range, return an invalid range */
   }
-  return it - pin_list.begin();
+  return ref_port.get_lsb() - get_lsb();
 }
 
 /************************************************************************
@@ -139,8 +143,7 @@ size_t BasicPort::find_ipin(const BasicPort& ref_port) const {
  * 3. MSBs are the same
  */
 bool BasicPort::operator==(const BasicPort& portA) const {
-  if ((0 == this->get_name().compare(portA.get_name())) &&
-      (this->get_lsb() == portA.get_lsb()) &&
+  if ((this->name_ == portA.name_) && (this->get_lsb() == portA.get_lsb()) &&
       (this->get_msb() == portA.get_msb())) {
     return true;
   }
@@ -148,8 +151,7 @@ bool BasicPort::operator==(const BasicPort& portA) const {
 }
 
 bool BasicPort::operator<(const BasicPort& portA) const {
-  if ((0 == this->get_name().compare(portA.get_name())) &&
-      (this->get_lsb() < portA.get_lsb()) &&
+  if ((this->name_ == portA.name_) && (this->get_lsb() < portA.get_lsb()) &&
       (this->get_msb() < portA.get_msb())) {
     return true;
   }
@@ -161,7 +163,7 @@ bool BasicPort::operator<(const BasicPort& portA) const {
  ***********************************************************************/
 /* copy */
 void BasicPort::set(const BasicPort& basic_port) {
-  name_ = basic_port.get_name();
+  name_ = basic_port.get_name_symbol();
   lsb_ = basic_port.get_lsb();
   msb_ = basic_port.get_msb();
   origin_port_width_ = basic_port.get_origin_port_width();
@@ -170,8 +172,8 @@ void BasicPort::set(const BasicPort& basic_port) {
 }
 
 /* set the port LSB and MSB */
-void BasicPort::set_name(const std::string& name) {
-  name_ = name;
+void BasicPort::set_name(std::string_view name) {
+  name_ = intern_symbol(name);
   return;
 }
 
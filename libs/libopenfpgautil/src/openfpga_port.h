@@ -4,12 +4,89 @@
 /********************************************************************
  * Include header files that are required by data structure declaration
  *******************************************************************/
+#include <cstddef>
+#include <iterator>
 #include <string>
+#include <string_view>
 #include <vector>
 
+#include "openfpga_symbol_table.h"
+
 /* namespace openfpga begins */
 namespace openfpga {
 
+/* A range of consecutive pin indices [lsb, lsb + width), which behaves as a
+ * read-only vector of indices without allocating any memory. The members are
+ * defined inline, as they are used in the innermost loops of net builders */
+class BasicPortPinRange {
+ public: /* Types */
+  class iterator {
+   public:
+    typedef std::random_access_iterator_tag iterator_category;
+    typedef size_t value_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef const size_t* pointer;
+    typedef size_t reference;
+
+    explicit iterator(const size_t& pin) : pin_(pin) {}
+    size_t operator*() const { return pin_; }
+    size_t operator[](const difference_type& offset) const {
+      return pin_ + offset;
+    }
+    iterator& operator++() {
+      ++pin_;
+      return *this;
+    }
+    iterator operator++(int) { return iterator(pin_++); }
+    iterator& operator--() {
+      --pin_;
+      return *this;
+    }
+    iterator operator--(int) { return iterator(pin_--); }
+    iterator& operator+=(const difference_type& offset) {
+      pin_ += offset;
+      return *this;
+    }
+    iterator& operator-=(const difference_type& offset) {
+      pin_ -= offset;
+      return *this;
+    }
+    iterator operator+(const difference_type& offset) const {
+      return iterator(pin_ + offset);
+    }
+    iterator operator-(const difference_type& offset) const {
+      return iterator(pin_ - offset);
+    }
+    difference_type operator-(const iterator& other) const {
+      return difference_type(pin_) - difference_type(other.pin_);
+    }
+    bool operator==(const iterator& other) const { return pin_ == other.pin_; }
+    bool operator!=(const iterator& other) const { return pin_ != other.pin_; }
+    bool operator<(const iterator& other) const { return pin_ < other.pin_; }
+
+   private:
+    size_t pin_;
+  };
+  typedef iterator const_iterator;
+
+ public: /* Constructors */
+  BasicPortPinRange(const size_t& lsb, const size_t& width)
+    : lsb_(lsb), width_(width) {}
+
+ public: /* Accessors */
+  iterator begin() const { return iterator(lsb_); }
+  iterator end() const { return iterator(lsb_ + width_); }
+  size_t size() const { return width_; }
+  bool empty() const { return 0 == width_; }
+  size_t operator[](const size_t& index) const { return lsb_ + index; }
+  size_t front() const { return lsb_; }
+  size_t back() const { return lsb_ + width_ - 1; }
+
+ private: /* Internal Data */
+  size_t lsb_;
+  size_t width_;
+};
+
 /* A basic port */
 class BasicPort {
  public: /* Constructors */
@@ -18,18 +95,22 @@ class BasicPort {
   BasicPort(const char* name, const size_t& width);
   BasicPort(const std::string& name, const size_t& lsb, const size_t& msb);
   BasicPort(const std::string& name, const size_t& width);
+  /* Build a port from a part of a string, without any copy of the name */
+  BasicPort(std::string_view name, const size_t& lsb, const size_t& msb);
+  BasicPort(std::string_view name, const size_t& width);
 
  public: /* Overloaded operators */
   bool operator==(const BasicPort& portA) const;
   bool operator<(const BasicPort& portA) const;
 
- public:                            /* Accessors */
-  size_t get_width() const;         /* get the port width */
-  size_t get_msb() const;           /* get the LSB */
-  size_t get_lsb() const;           /* get the LSB */
-  std::string get_name() const;     /* get the name */
-  bool is_valid() const;            /* check if port size is valid > 0 */
-  std::vector<size_t> pins() const; /* Make a range of the pin indices */
+ public:                               /* Accessors */
+  size_t get_width() const;            /* get the port width */
+  size_t get_msb() const;              /* get the LSB */
+  size_t get_lsb() const;              /* get the LSB */
+  const std::string& get_name() const; /* get the name, which is interned */
+  SymbolId get_name_symbol() const;    /* get the interned handle of the name */
+  bool is_valid() const;               /* check if port size is valid > 0 */
+  BasicPortPinRange pins() const;      /* Make a range of the pin indices */
   bool mergeable(const BasicPort& portA)
     const; /* Check if a port can be merged with this port */
   bool contained(const BasicPort& portA)
@@ -44,7 +125,7 @@ class BasicPort {
 
  public:                                  /* Mutators */
   void set(const BasicPort& basic_port);  /* copy */
-  void set_name(const std::string& name); /* set the port LSB and MSB */
+  void set_name(std::string_view name);   /* set the port LSB and MSB */
   void set_width(const size_t& width);    /* set the port LSB and MSB */
   void set_width(const size_t& lsb,
                  const size_t& msb); /* set the port LSB and MSB */
@@ -62,7 +143,7 @@ class BasicPort {
  private:                    /* internal functions */
   void make_invalid();       /* Make a port invalid */
  private:                    /* Internal Data */
-  std::string name_;         /* Name of this port */
+  SymbolId name_;            /* Name of this port, interned */
   size_t msb_;               /* Most Significant Bit of this port */
   size_t lsb_;               /* Least Significant Bit of this port */
   size_t origin_port_width_; /* Original port width of a port, used by traceback
@@ -4,6 +4,7 @@
 #include "openfpga_port_parser.h"
 
 #include <cstring>
+#include <string_view>
 
 #include "openfpga_tokenizer.h"
 #include "vtr_assert.h"
@@ -45,49 +46,56 @@ void PortParser::set_data(const std::string& data) {
 /************************************************************************
  * Internal Mutators
  ***********************************************************************/
-/* Parse the data */
-void PortParser::parse() {
-  /* Create a tokenizer */
-  StringToken tokenizer(data_);
-
+/* Parse a port string into a given port. The string is scanned in place, so
+ * that no token is allocated, as port strings are parsed by the millions
+ * from architecture and netlist files */
+static void parse_port_string(std::string_view data,
+                              const vtr::Point<char>& bracket,
+                              const char& delim, BasicPort& port) {
   /* Split the data into <port_name> and <pin_string> */
-  std::vector<std::string> port_tokens = tokenizer.split(bracket_.x());
+  std::string_view port_tokens[2];
+  size_t num_port_tokens = split_string_view(data, bracket.x(), port_tokens, 2);
   /* Make sure we have a port name! */
-  VTR_ASSERT_SAFE((1 == port_tokens.size()) || (2 == port_tokens.size()));
+  VTR_ASSERT_SAFE((1 == num_port_tokens) || (2 == num_port_tokens));
   /* Store the port name! */
-  port_.set_name(port_tokens[0]);
+  port.set_name(port_tokens[0]);
 
   /* If we only have one token */
-  if (1 == port_tokens.size()) {
-    port_.set_width(1);
+  if (1 >= num_port_tokens) {
+    port.set_width(1);
     return; /* We can finish here */
   }
 
   /* Chomp the ']' */
-  tokenizer.set_data(port_tokens[1]);
-  std::vector<std::string> pin_tokens = tokenizer.split(bracket_.y());
-  /* Make sure we have a valid string! */
-  VTR_ASSERT_SAFE(1 == port_tokens.size());
+  std::string_view pin_string;
+  split_string_view(port_tokens[1], bracket.y(), &pin_string, 1);
 
   /* Split the pin string now */
-  tokenizer.set_data(pin_tokens[0]);
-  pin_tokens = tokenizer.split(delim_);
+  std::string_view pin_tokens[2];
+  size_t num_pin_tokens = split_string_view(pin_string, delim, pin_tokens, 2);
 
   /* Check if we have LSB and MSB or just one */
-  if (1 == pin_tokens.size()) {
+  if (1 == num_pin_tokens) {
     /* Single pin */
-    port_.set_width(std::stoi(pin_tokens[0]), std::stoi(pin_tokens[0]));
-  } else if (2 == pin_tokens.size()) {
+    int pin = std::stoi(std::string(pin_tokens[0]));
+    port.set_width(pin, pin);
+  } else if (2 == num_pin_tokens) {
     /* A number of pins.
      * Note that we always use the LSB for token[0] and MSB for token[1]
      */
-    if (std::stoi(pin_tokens[1]) < std::stoi(pin_tokens[0])) {
-      port_.set_width(std::stoi(pin_tokens[1]), std::stoi(pin_tokens[0]));
+    int lsb = std::stoi(std::string(pin_tokens[0]));
+    int msb = std::stoi(std::string(pin_tokens[1]));
+    if (msb < lsb) {
+      port.set_width(msb, lsb);
     } else {
-      port_.set_width(std::stoi(pin_tokens[0]), std::stoi(pin_tokens[1]));
+      port.set_width(lsb, msb);
     }
   }
+}
 
+/* Parse the data */
+void PortParser::parse() {
+  parse_port_string(data_, bracket_, delim_, port_);
   return;
 }
 
@@ -139,17 +147,20 @@ void MultiPortParser::parse() {
   /* Clear content */
   clear();
 
-  /* Create a tokenizer */
-  StringToken tokenizer(data_);
-
-  /* Split the data into <port_name> and <pin_string> */
-  std::vector<std::string> port_tokens = tokenizer.split(delim_);
-
-  /* Use PortParser for each token */
-  for (const auto& port : port_tokens) {
-    PortParser port_parser(port);
+  /* Each port is parsed in place as PortParser does */
+  vtr::Point<char> bracket('[', ']');
+  std::string_view data(data_);
+  size_t token_start = data.find_first_not_of(delim_);
+  while (std::string_view::npos != token_start) {
+    size_t token_end = data.find(delim_, token_start);
     /* Get the port name, LSB and MSB */
-    ports_.push_back(port_parser.port());
+    ports_.emplace_back();
+    parse_port_string(data.substr(token_start, token_end - token_start),
+                      bracket, ':', ports_.back());
+    if (std::string_view::npos == token_end) {
+      break;
+    }
+    token_start = data.find_first_not_of(delim_, token_end);
   }
 
   return;
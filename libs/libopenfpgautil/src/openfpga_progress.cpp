@@ -0,0 +1,110 @@
+/********************************************************************
+ * Member functions for the progress reporter
+ *******************************************************************/
+#include <cmath>
+#include <cstdio>
+
+/* Headers from vtrutil library */
+#include "vtr_log.h"
+
+/* Headers from openfpgautil library */
+#include "openfpga_progress.h"
+
+/* namespace openfpga begins */
+namespace openfpga {
+
+/************************************************************************
+ * Constructor
+ ***********************************************************************/
+ProgressReporter::ProgressReporter(const std::string& title,
+                                   const size_t& num_items,
+                                   const double& interval)
+  : title_(title),
+    num_items_(num_items),
+    interval_(interval),
+    start_time_(std::chrono::steady_clock::now()),
+    num_done_(0),
+    next_report_time_(interval),
+    reported_(false) {}
+
+ProgressReporter::~ProgressReporter() { finish(); }
+
+/************************************************************************
+ * Public accessors
+ ***********************************************************************/
+size_t ProgressReporter::num_items() const { return num_items_; }
+
+size_t ProgressReporter::num_done() const { return num_done_.load(); }
+
+/************************************************************************
+ * Public mutators
+ ***********************************************************************/
+void ProgressReporter::increment(const size_t& num_items) {
+  size_t num_done =
+    num_done_.fetch_add(num_items, std::memory_order_relaxed) + num_items;
+  double elapsed = elapsed_time();
+  if (elapsed < next_report_time_.load(std::memory_order_relaxed)) {
+    return;
+  }
+  /* Other threads skip the report rather than waiting for the lock */
+  std::unique_lock<std::mutex> lock(mutex_, std::try_to_lock);
+  if ((false == lock.owns_lock()) ||
+      (elapsed < next_report_time_.load(std::memory_order_relaxed))) {
+    return;
+  }
+  next_report_time_.store(elapsed + interval_, std::memory_order_relaxed);
+  reported_ = true;
+  print_progress(num_done, elapsed);
+}
+
+void ProgressReporter::finish() {
+  /* Close the progress, so that the last line does not show an ETA */
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (true == reported_) {
+    print_progress(num_done_.load(), elapsed_time());
+    reported_ = false;
+  }
+}
+
+/************************************************************************
+ * Internal utilities
+ ***********************************************************************/
+double ProgressReporter::elapsed_time() const {
+  return std::chrono::duration<double>(std::chrono::steady_clock::now() -
+                                       start_time_)
+    .count();
+}
+
+/* Format a duration as [[h:]mm:]ss */
+static std::string format_duration(const double& seconds) {
+  size_t total = size_t(std::round(seconds));
+  char buffer[32];
+  if (3600 <= total) {
+    snprintf(buffer, sizeof(buffer), "%lu:%02lu:%02lu", total / 3600,
+             (total / 60) % 60, total % 60);
+  } else if (60 <= total) {
+    snprintf(buffer, sizeof(buffer), "%lu:%02lu", total / 60, total % 60);
+  } else {
+    snprintf(buffer, sizeof(buffer), "%lus", total);
+  }
+  return std::string(buffer);
+}
+
+void ProgressReporter::print_progress(const size_t& num_done,
+                                      const double& elapsed) const {
+  double percentage =
+    (0 == num_items_) ? 100. : 100. * double(num_done) / double(num_items_);
+  double throughput = (0. < elapsed) ? double(num_done) / elapsed : 0.;
+  if ((num_done >= num_items_) || (0. == throughput)) {
+    VTR_LOG("%s: %lu/%lu (%.1f%%), %.1f items/s, elapsed %s\n",
+            title_.c_str(), num_done, num_items_, percentage, throughput,
+            format_duration(elapsed).c_str());
+    return;
+  }
+  double eta = double(num_items_ - num_done) / throughput;
+  VTR_LOG("%s: %lu/%lu (%.1f%%), %.1f items/s, elapsed %s, ETA %s\n",
+          title_.c_str(), num_done, num_items_, percentage, throughput,
+          format_duration(elapsed).c_str(), format_duration(eta).c_str());
+}
+
+} /* end namespace openfpga */
@@ -0,0 +1,75 @@
+#ifndef OPENFPGA_PROGRESS_H
+#define OPENFPGA_PROGRESS_H
+
+/********************************************************************
+ * Include header files that are required by data structure declaration
+ *******************************************************************/
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <mutex>
+#include <string>
+
+/* namespace openfpga begins */
+namespace openfpga {
+
+/********************************************************************
+ * A reporter of the progress of a long loop, which prints the number of
+ * items done out of the total, the throughput and the estimated time
+ * to finish.
+ *
+ * The output is rate-limited: a line is printed at most once per
+ * interval, so that short loops print nothing and long loops do not
+ * flood the log. A final line is printed when the reporter is finished
+ * or destroyed, only if any progress has been printed before.
+ *
+ * An example of how to use
+ * -----------------------
+ *   ProgressReporter progress("Repack clustered blocks", blocks.size());
+ *   parallel_for(blocks.size(), num_threads, [&](const size_t& iblk) {
+ *     ...
+ *     progress.increment();
+ *   });
+ *
+ * The progress can be incremented by multiple threads.
+ ********************************************************************/
+class ProgressReporter {
+ public: /* Constructor */
+  /* Interval between two lines of progress in seconds */
+  ProgressReporter(const std::string& title, const size_t& num_items,
+                   const double& interval = 10.);
+  ~ProgressReporter();
+
+ public: /* Public accessors */
+  size_t num_items() const;
+  size_t num_done() const;
+
+ public: /* Public mutators */
+  /* Mark a number of items as done, and print the progress if the
+   * interval has passed since the last line */
+  void increment(const size_t& num_items = 1);
+  /* Print the final line now rather than when the reporter is destroyed,
+   * if any progress has been printed */
+  void finish();
+
+ private: /* Internal utilities */
+  /* Elapsed time since the reporter is created, in seconds */
+  double elapsed_time() const;
+  void print_progress(const size_t& num_done, const double& elapsed) const;
+
+ private: /* Internal data */
+  std::string title_;
+  size_t num_items_;
+  double interval_;
+  std::chrono::steady_clock::time_point start_time_;
+  std::atomic<size_t> num_done_;
+  /* Elapsed time when the next line can be printed */
+  std::atomic<double> next_report_time_;
+  bool reported_;
+  /* Only one thread prints at a time */
+  std::mutex mutex_;
+};
+
+} /* end namespace openfpga */
+
+#endif
@@ -0,0 +1,115 @@
+/********************************************************************
+ * Member functions for the process-wide table of interned strings
+ *******************************************************************/
+#include "openfpga_symbol_table.h"
+
+#include <functional>
+
+/* Headers from vtrutil library */
+#include "vtr_assert.h"
+
+/* namespace openfpga begins */
+namespace openfpga {
+
+/************************************************************************
+ * Constructors
+ ***********************************************************************/
+SymbolTable::SymbolTable() : num_symbols_(0) {
+  for (std::atomic<std::string*>& block : blocks_) {
+    block.store(nullptr);
+  }
+  /* Reserve the first handle for the empty string */
+  SymbolId empty_symbol = intern(std::string_view());
+  VTR_ASSERT(EMPTY_SYMBOL == empty_symbol);
+}
+
+SymbolTable::~SymbolTable() {
+  for (std::atomic<std::string*>& block : blocks_) {
+    delete[] block.load();
+  }
+}
+
+SymbolTable& SymbolTable::instance() {
+  static SymbolTable table;
+  return table;
+}
+
+/************************************************************************
+ * Public accessors
+ ***********************************************************************/
+const std::string& SymbolTable::str(const SymbolId& symbol) const {
+  VTR_ASSERT(symbol < num_symbols_.load(std::memory_order_relaxed));
+  const std::string* block =
+    blocks_[symbol >> BLOCK_BITS].load(std::memory_order_acquire);
+  return block[symbol & (BLOCK_SIZE - 1)];
+}
+
+SymbolId SymbolTable::find(std::string_view str) const {
+  Shard& shard = shards_[std::hash<std::string_view>()(str) % NUM_SHARDS];
+  std::lock_guard<std::mutex> lock(shard.mutex);
+  auto result = shard.symbol_lookup.find(str);
+  if (result == shard.symbol_lookup.end()) {
+    return INVALID_SYMBOL;
+  }
+  return result->second;
+}
+
+size_t SymbolTable::size() const { return num_symbols_.load(); }
+
+/************************************************************************
+ * Public mutators
+ ***********************************************************************/
+SymbolId SymbolTable::intern(std::string_view str) {
+  Shard& shard = shards_[std::hash<std::string_view>()(str) % NUM_SHARDS];
+  std::lock_guard<std::mutex> lock(shard.mutex);
+  auto result = shard.symbol_lookup.find(str);
+  if (result != shard.symbol_lookup.end()) {
+    return result->second;
+  }
+
+  /* Strings of other shards may be added at the same time, so the handle is
+   * reserved atomically. Run out of handles: this should never happen in
+   * practice */
+  size_t index = num_symbols_.fetch_add(1);
+  VTR_ASSERT(index < size_t(INVALID_SYMBOL));
+  SymbolId symbol = SymbolId(index);
+  std::string& stored_str = find_block(symbol)[symbol & (BLOCK_SIZE - 1)];
+  stored_str.assign(str.data(), str.size());
+
+  shard.symbol_lookup.emplace(std::string_view(stored_str), symbol);
+  return symbol;
+}
+
+/************************************************************************
+ * Internal functions
+ ***********************************************************************/
+std::string* SymbolTable::find_block(const SymbolId& symbol) {
+  std::atomic<std::string*>& block = blocks_[symbol >> BLOCK_BITS];
+  std::string* curr_block = block.load(std::memory_order_acquire);
+  if (nullptr != curr_block) {
+    return curr_block;
+  }
+  /* Another thread may allocate the same block at the same time. Only one of
+   * the blocks is kept */
+  std::string* new_block = new std::string[BLOCK_SIZE];
+  if (true == block.compare_exchange_strong(curr_block, new_block,
+                                            std::memory_order_acq_rel,
+                                            std::memory_order_acquire)) {
+    return new_block;
+  }
+  delete[] new_block;
+  return curr_block;
+}
+
+/************************************************************************
+ * Shortcuts
+ ***********************************************************************/
+SymbolId intern_symbol(std::string_view str) {
+  return SymbolTable::instance().intern(str);
+}
+
+const std::string& symbol_string(const SymbolId& symbol) {
+  return SymbolTable::instance().str(symbol);
+}
+
+}  // namespace openfpga
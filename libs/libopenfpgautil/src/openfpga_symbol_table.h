@@ -0,0 +1,99 @@
+#ifndef OPENFPGA_SYMBOL_TABLE_H
+#define OPENFPGA_SYMBOL_TABLE_H
+
+/********************************************************************
+ * Include header files that are required by data structure declaration
+ *******************************************************************/
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+/* namespace openfpga begins */
+namespace openfpga {
+
+/* A handle to an interned string */
+typedef uint32_t SymbolId;
+
+/********************************************************************
+ * @brief A process-wide table of interned strings.
+ * Each distinct string is stored only once and is represented by a 32-bit
+ * handle. Data structures which store a large number of repeated names
+ * (e.g., ports, instances and nets of modules) can keep the handles only:
+ * copies become integer copies and two names can be compared by their
+ * handles.
+ * @note
+ * - The handle of an empty string is always EMPTY_SYMBOL
+ * - Strings are never removed, so that a handle remains valid during the
+ *   whole execution
+ * - The table can be accessed by multiple threads. The look-up is split
+ *   into shards, each of which has its own lock, so that threads interning
+ *   different strings rarely wait for each other. Reading the string of a
+ *   handle does not require any lock
+ ********************************************************************/
+class SymbolTable {
+ public: /* Constants */
+  static constexpr SymbolId EMPTY_SYMBOL = 0;
+  static constexpr SymbolId INVALID_SYMBOL = SymbolId(-1);
+
+ public: /* Constructors */
+  /** @brief Get the table which is shared by the whole process */
+  static SymbolTable& instance();
+
+ public: /* Public accessors */
+  /** @brief Get the string of a handle. The reference remains valid during
+   * the whole execution. The handle should be given by the table */
+  const std::string& str(const SymbolId& symbol) const;
+  /** @brief Find the handle of a string. Return INVALID_SYMBOL if the string
+   * has never been interned */
+  SymbolId find(std::string_view str) const;
+  /** @brief Get the number of strings in the table */
+  size_t size() const;
+
+ public: /* Public mutators */
+  /** @brief Get the handle of a string. The string is added to the table if
+   * it does not exist yet */
+  SymbolId intern(std::string_view str);
+
+ private: /* Internal functions */
+  SymbolTable();
+  ~SymbolTable();
+  SymbolTable(const SymbolTable&) = delete;
+  SymbolTable& operator=(const SymbolTable&) = delete;
+  /* Get the block of strings where a handle is stored, which is created
+   * if not allocated yet */
+  std::string* find_block(const SymbolId& symbol);
+
+ private: /* Internal data */
+  /* Strings are stored in blocks which are never moved, so that reading a
+   * string does not require any lock */
+  static constexpr size_t BLOCK_BITS = 16;
+  static constexpr size_t BLOCK_SIZE = size_t(1) << BLOCK_BITS;
+  static constexpr size_t NUM_BLOCKS = size_t(1) << (32 - BLOCK_BITS);
+  std::array<std::atomic<std::string*>, NUM_BLOCKS> blocks_;
+  std::atomic<size_t> num_symbols_;
+
+  /* Fast look-up from string to handle, whose keys refer to the blocks.
+   * A string always belongs to the same shard, which is selected by its
+   * hash value */
+  static constexpr size_t NUM_SHARDS = 64;
+  struct Shard {
+    std::unordered_map<std::string_view, SymbolId> symbol_lookup;
+    std::mutex mutex;
+  };
+  mutable std::array<Shard, NUM_SHARDS> shards_;
+};
+
+/********************************************************************
+ * Shortcuts to use the process-wide symbol table
+ ********************************************************************/
+SymbolId intern_symbol(std::string_view str);
+
+const std::string& symbol_string(const SymbolId& symbol);
+
+}  // namespace openfpga
+
+#endif
@@ -1,7 +1,6 @@
 /************************************************************************
  * Member functions for StringToken class
  ***********************************************************************/
-#include <cstring>
 
 /* Headers from vtrutil library */
 #include "openfpga_tokenizer.h"
@@ -21,28 +20,25 @@ StringToken::StringToken(const std::string& data) { set_data(data); }
 /* Get the data string */
 std::string StringToken::data() const { return data_; }
 
-/* Split the string using a given delim */
+/* Split the string using a given delim
+ * Same as strtok, empty tokens are skipped. The string is scanned in place
+ * rather than by strtok, so that tokenizers can be used by multiple threads */
 std::vector<std::string> StringToken::split(const std::string& delims) const {
   /* Return vector */
   std::vector<std::string> ret;
 
-  /* Get a writable char array */
-  char* tmp = new char[data_.size() + 1];
-  std::copy(data_.begin(), data_.end(), tmp);
-  tmp[data_.size()] = '\0';
-  /* Split using strtok */
-  char* result = std::strtok(tmp, delims.c_str());
-  while (NULL != result) {
-    std::string result_str(result);
+  size_t token_start = data_.find_first_not_of(delims);
+  while (std::string::npos != token_start) {
+    size_t token_end = data_.find_first_of(delims, token_start);
     /* Store the token */
-    ret.push_back(result_str);
+    ret.push_back(data_.substr(token_start, token_end - token_start));
+    if (std::string::npos == token_end) {
+      break;
+    }
     /* Got to next */
-    result = std::strtok(NULL, delims.c_str());
+    token_start = data_.find_first_not_of(delims, token_end);
   }
 
-  /* Free the tmp */
-  delete[] tmp;
-
   return ret;
 }
 
@@ -164,4 +160,25 @@ void StringToken::add_default_delim() {
   return;
 }
 
+/************************************************************************
+ * Split a string into views
+ ***********************************************************************/
+size_t split_string_view(std::string_view data, const char& delim,
+                         std::string_view* tokens, const size_t& max_tokens) {
+  size_t num_tokens = 0;
+  size_t token_start = data.find_first_not_of(delim);
+  while (std::string_view::npos != token_start) {
+    size_t token_end = data.find(delim, token_start);
+    if (num_tokens < max_tokens) {
+      tokens[num_tokens] = data.substr(token_start, token_end - token_start);
+    }
+    num_tokens++;
+    if (std::string_view::npos == token_end) {
+      break;
+    }
+    token_start = data.find_first_not_of(delim, token_end);
+  }
+  return num_tokens;
+}
+
 }  // namespace openfpga
@@ -5,6 +5,7 @@
  * Include header files that are required by data structure declaration
  *******************************************************************/
 #include <string>
+#include <string_view>
 #include <vector>
 
 /* namespace openfpga begins */
@@ -65,6 +66,16 @@ class StringToken {
   std::vector<char> delims_;
 };
 
+/************************************************************************
+ * Split a string with a given delimiter without copying the tokens, which
+ * are views on the given string. Same as StringToken::split(), empty tokens
+ * are skipped. At most max_tokens tokens are stored in the given buffer,
+ * while the returned number of tokens may be larger. This is meant for
+ * parsers which expect a small and known number of tokens.
+ ***********************************************************************/
+size_t split_string_view(std::string_view data, const char& delim,
+                         std::string_view* tokens, const size_t& max_tokens);
+
 }  // namespace openfpga
 
 #endif
@@ -0,0 +1,167 @@
+/********************************************************************
+ * Member functions for the trace recorder and its scopes
+ *******************************************************************/
+#include <algorithm>
+#include <fstream>
+#include <functional>
+#include <thread>
+
+/* Headers from vtrutil library */
+#include "vtr_log.h"
+
+/* Headers from openfpgautil library */
+#include "openfpga_trace.h"
+
+/* namespace openfpga begins */
+namespace openfpga {
+
+/************************************************************************
+ * Singleton
+ ***********************************************************************/
+TraceRecorder& TraceRecorder::instance() {
+  static TraceRecorder recorder;
+  return recorder;
+}
+
+TraceRecorder::TraceRecorder()
+  : enabled_(false), start_time_(std::chrono::steady_clock::now()) {}
+
+/************************************************************************
+ * Public accessors
+ ***********************************************************************/
+bool TraceRecorder::enabled() const {
+  return enabled_.load(std::memory_order_relaxed);
+}
+
+size_t TraceRecorder::num_events() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return events_.size();
+}
+
+double TraceRecorder::timestamp() const {
+  return std::chrono::duration<double, std::micro>(
+           std::chrono::steady_clock::now() - start_time_)
+    .count();
+}
+
+/* Names are expected to be identifiers, but escape the characters which
+ * would break a JSON string anyway */
+static std::string escape_trace_name(const std::string& name) {
+  std::string escaped;
+  escaped.reserve(name.size());
+  for (const char& c : name) {
+    if (('"' == c) || ('\\' == c)) {
+      escaped.push_back('\\');
+    }
+    escaped.push_back(c);
+  }
+  return escaped;
+}
+
+int TraceRecorder::write_chrome_trace(const std::string& fname) const {
+  std::ofstream fp(fname, std::ofstream::out | std::ofstream::trunc);
+  if (false == fp.is_open()) {
+    VTR_LOG_ERROR("Fail to open file '%s' to write the trace!\n",
+                  fname.c_str());
+    return 1;
+  }
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  /* Timestamps are given in microseconds, which is the default unit */
+  fp << "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [";
+  for (size_t ievt = 0; ievt < events_.size(); ++ievt) {
+    const TraceEvent& event = events_[ievt];
+    fp << (0 == ievt ? "\n" : ",\n");
+    fp << "{\"name\": \"" << escape_trace_name(event.name) << "\"";
+    fp << ", \"pid\": 1, \"tid\": " << event.thread_id;
+    fp << ", \"ts\": " << std::fixed << event.timestamp;
+    if (TRACE_COUNTER == event.type) {
+      fp << ", \"ph\": \"C\", \"args\": {\"value\": "
+         << size_t(event.value) << "}}";
+    } else {
+      fp << ", \"ph\": \"X\", \"dur\": " << event.value << "}";
+    }
+  }
+  fp << "\n]}\n";
+
+  if (false == fp.good()) {
+    VTR_LOG_ERROR("Fail to write the trace to file '%s'!\n", fname.c_str());
+    return 1;
+  }
+  VTR_LOG("Wrote %lu trace events to file '%s'\n", events_.size(),
+          fname.c_str());
+  return 0;
+}
+
+/************************************************************************
+ * Public mutators
+ ***********************************************************************/
+void TraceRecorder::enable() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  events_.clear();
+  thread_hashes_.clear();
+  start_time_ = std::chrono::steady_clock::now();
+  enabled_.store(true, std::memory_order_relaxed);
+}
+
+void TraceRecorder::disable() {
+  enabled_.store(false, std::memory_order_relaxed);
+}
+
+/* Must be called with the mutex locked */
+size_t TraceRecorder::current_thread_index() {
+  size_t thread_hash =
+    std::hash<std::thread::id>()(std::this_thread::get_id());
+  auto result =
+    std::find(thread_hashes_.begin(), thread_hashes_.end(), thread_hash);
+  if (result != thread_hashes_.end()) {
+    return size_t(result - thread_hashes_.begin());
+  }
+  thread_hashes_.push_back(thread_hash);
+  return thread_hashes_.size() - 1;
+}
+
+void TraceRecorder::add_scope(const std::string& name,
+                              const double& start_timestamp,
+                              const double& end_timestamp) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  events_.push_back({TRACE_SCOPE, name, start_timestamp,
+                     end_timestamp - start_timestamp, current_thread_index()});
+}
+
+void TraceRecorder::add_counter(const std::string& name, const size_t& value) {
+  double curr_timestamp = timestamp();
+  std::lock_guard<std::mutex> lock(mutex_);
+  events_.push_back({TRACE_COUNTER, name, curr_timestamp, double(value),
+                     current_thread_index()});
+}
+
+/************************************************************************
+ * Scopes
+ ***********************************************************************/
+TraceScope::TraceScope(const char* name)
+  : enabled_(TraceRecorder::instance().enabled()), start_timestamp_(0.) {
+  /* Do not even copy the name when the recorder is disabled */
+  if (true == enabled_) {
+    name_ = name;
+    start_timestamp_ = TraceRecorder::instance().timestamp();
+  }
+}
+
+TraceScope::TraceScope(const std::string& name) : TraceScope(name.c_str()) {}
+
+TraceScope::~TraceScope() {
+  if (true == enabled_) {
+    TraceRecorder& recorder = TraceRecorder::instance();
+    recorder.add_scope(name_, start_timestamp_, recorder.timestamp());
+  }
+}
+
+void trace_counter(const char* name, const size_t& value) {
+  TraceRecorder& recorder = TraceRecorder::instance();
+  if (true == recorder.enabled()) {
+    recorder.add_counter(std::string(name), value);
+  }
+}
+
+} /* end namespace openfpga */
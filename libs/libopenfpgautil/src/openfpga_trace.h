@@ -0,0 +1,108 @@
+#ifndef OPENFPGA_TRACE_H
+#define OPENFPGA_TRACE_H
+
+/********************************************************************
+ * Include header files that are required by data structure declaration
+ *******************************************************************/
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/* namespace openfpga begins */
+namespace openfpga {
+
+/********************************************************************
+ * A lightweight recorder of nested timing scopes and counters, whose
+ * events can be written in the Chrome trace event format, which is
+ * loadable by chrome://tracing and Perfetto.
+ *
+ * The recorder is disabled by default. When disabled, opening a scope
+ * or updating a counter only costs the check of an atomic flag.
+ *
+ * An example of how to use
+ * -----------------------
+ *   void build_grid_bitstream(...) {
+ *     TraceScope trace_scope("build_grid_bitstream");
+ *     ...
+ *     trace_counter("bits", bitstream_manager.num_bits());
+ *   }
+ *
+ * Scopes and counters can be recorded by multiple threads.
+ ********************************************************************/
+class TraceRecorder {
+ public: /* Types */
+  enum e_trace_event_type { TRACE_SCOPE, TRACE_COUNTER };
+  struct TraceEvent {
+    e_trace_event_type type;
+    std::string name;
+    /* Start time in microseconds */
+    double timestamp;
+    /* Duration of a scope in microseconds, or value of a counter */
+    double value;
+    size_t thread_id;
+  };
+
+ public: /* Singleton */
+  static TraceRecorder& instance();
+
+ public: /* Public accessors */
+  bool enabled() const;
+  size_t num_events() const;
+  /* Elapsed time since the recorder was enabled, in microseconds */
+  double timestamp() const;
+  /* Write all the events in the Chrome trace event format (JSON).
+   * Return 0 if successful */
+  int write_chrome_trace(const std::string& fname) const;
+
+ public: /* Public mutators */
+  /* Start recording events; the events recorded before are cleared */
+  void enable();
+  void disable();
+  void add_scope(const std::string& name, const double& start_timestamp,
+                 const double& end_timestamp);
+  void add_counter(const std::string& name, const size_t& value);
+
+ private: /* Internal constructor */
+  TraceRecorder();
+  size_t current_thread_index();
+
+ private: /* Internal data */
+  std::atomic<bool> enabled_;
+  std::chrono::steady_clock::time_point start_time_;
+  std::vector<TraceEvent> events_;
+  /* Threads are numbered in the order they record their first event */
+  std::vector<size_t> thread_hashes_;
+  mutable std::mutex mutex_;
+};
+
+/********************************************************************
+ * A scope which is recorded from its creation to its destruction, when
+ * the recorder is enabled
+ ********************************************************************/
+class TraceScope {
+ public: /* Constructor */
+  explicit TraceScope(const char* name);
+  explicit TraceScope(const std::string& name);
+  ~TraceScope();
+  TraceScope(const TraceScope&) = delete;
+  TraceScope& operator=(const TraceScope&) = delete;
+
+ private: /* Internal data */
+  bool enabled_;
+  std::string name_;
+  double start_timestamp_;
+};
+
+/********************************************************************
+ * Function declaration
+ *******************************************************************/
+/* Record the value of a counter, e.g., the number of modules, nets, bits
+ * or bytes written, at the current time */
+void trace_counter(const char* name, const size_t& value);
+
+} /* end namespace openfpga */
+
+#endif
@@ -1,6 +1,7 @@
 /************************************************************************
  * Member functions for WildCardString class
  ***********************************************************************/
+#include <algorithm>
 #include <cstring>
 
 /* Headers from vtrutil library */
@@ -54,46 +55,30 @@ void WildCardString::set_default_sensitive_chars() {
 }
 
 void WildCardString::apply_wildcard_char() {
-  /* Step by step:
-   * For each sensitive character,
-   * replace all of its occurance in the string data_ with wildcard character
-   */
-  for (const char& char_to_replace : sensitive_chars_) {
-    size_t cur_pos = 0;
-    std::string::size_type found;
-    while (std::string::npos !=
-           (found = data_.find_first_of(char_to_replace, cur_pos))) {
-      data_.replace(found, 1, 1, wildcard_char_);
-      cur_pos = found + 1;
+  /* Replace all the occurances of sensitive characters in the string data_
+   * with wildcard character, in a single pass over the string */
+  for (char& curr_char : data_) {
+    if (sensitive_chars_.end() != std::find(sensitive_chars_.begin(),
+                                            sensitive_chars_.end(),
+                                            curr_char)) {
+      curr_char = wildcard_char_;
     }
   }
 }
 
 void WildCardString::compress() {
-  for (std::string::size_type i = 0; i < data_.size(); ++i) {
-    /* Care only wildcard character */
-    if (wildcard_char_ != data_[i]) {
+  /* Keep only the first wildcard character of each sequence, by moving the
+   * characters to be kept towards the beginning of the string */
+  size_t num_kept = 0;
+  for (size_t i = 0; i < data_.size(); ++i) {
+    if ((wildcard_char_ == data_[i]) && (0 < num_kept) &&
+        (wildcard_char_ == data_[num_kept - 1])) {
       continue;
     }
-
-    /* Finish if this is the end of string */
-    if (data_.size() - 1 == i) {
-      break;
-    }
-
-    /* Try to find the next element and see if the same as wild card
-     * Keep erase the next element until we have a non-wildcard character
-     */
-    while (data_[i] == data_[i + 1]) {
-      /* Erase the next element */
-      data_.erase(i + 1, 1);
-
-      /* Finish if this is the end of string */
-      if (data_.size() - 1 == i) {
-        break;
-      }
-    }
+    data_[num_kept] = data_[i];
+    num_kept++;
   }
+  data_.resize(num_kept);
 }
 
 }  // namespace openfpga
@@ -0,0 +1,375 @@
+/********************************************************************
+ * Member functions for class XmlPullParser
+ *******************************************************************/
+#include "openfpga_xml_pull_parser.h"
+
+#include <cstdlib>
+#include <cstring>
+
+/* namespace openfpga begins */
+namespace openfpga {
+
+/************************************************************************
+ * Local utilities
+ ***********************************************************************/
+static bool is_xml_space(const char& c) {
+  return (' ' == c) || ('\t' == c) || ('\n' == c) || ('\r' == c);
+}
+
+static bool is_xml_name_char(const char& c) {
+  return (false == is_xml_space(c)) && ('/' != c) && ('>' != c) &&
+         ('=' != c) && ('<' != c) && ('"' != c) && ('\'' != c);
+}
+
+/* Encode a unicode code point to UTF-8 */
+static void append_utf8(std::string& str, const unsigned long& code) {
+  if (code < 0x80) {
+    str.push_back(char(code));
+  } else if (code < 0x800) {
+    str.push_back(char(0xC0 | (code >> 6)));
+    str.push_back(char(0x80 | (code & 0x3F)));
+  } else if (code < 0x10000) {
+    str.push_back(char(0xE0 | (code >> 12)));
+    str.push_back(char(0x80 | ((code >> 6) & 0x3F)));
+    str.push_back(char(0x80 | (code & 0x3F)));
+  } else {
+    str.push_back(char(0xF0 | (code >> 18)));
+    str.push_back(char(0x80 | ((code >> 12) & 0x3F)));
+    str.push_back(char(0x80 | ((code >> 6) & 0x3F)));
+    str.push_back(char(0x80 | (code & 0x3F)));
+  }
+}
+
+/************************************************************************
+ * Constructors
+ ***********************************************************************/
+XmlPullParser::XmlPullParser(const char* begin, const char* end)
+  : curr_(begin),
+    end_(end),
+    curr_line_(1),
+    line_(1),
+    pending_end_(false),
+    root_closed_(false) {}
+
+/************************************************************************
+ * Public Accessors
+ ***********************************************************************/
+const std::string& XmlPullParser::name() const { return name_; }
+
+size_t XmlPullParser::line() const { return line_; }
+
+size_t XmlPullParser::depth() const {
+  /* The current start element is already pushed to the stack */
+  if (true == element_stack_.empty()) {
+    return 0;
+  }
+  return element_stack_.size() - 1;
+}
+
+bool XmlPullParser::has_attribute(const char* attr_name) const {
+  return nullptr != find_attribute(attr_name);
+}
+
+std::string XmlPullParser::attribute(const char* attr_name) const {
+  const AttributeRange* attr = find_attribute(attr_name);
+  if (nullptr == attr) {
+    throw_error(std::string("Missing attribute '") + attr_name +
+                "' in element <" + name_ + ">");
+  }
+  return decode_value(attr->value_begin, attr->value_end);
+}
+
+int XmlPullParser::int_attribute(const char* attr_name) const {
+  return decode_int_value(attr_name);
+}
+
+int XmlPullParser::int_attribute(const char* attr_name,
+                                 const int& default_value) const {
+  if (nullptr == find_attribute(attr_name)) {
+    return default_value;
+  }
+  return decode_int_value(attr_name);
+}
+
+/************************************************************************
+ * Public Mutators
+ ***********************************************************************/
+XmlPullParser::e_event XmlPullParser::next() {
+  attributes_.clear();
+
+  /* A self-closing element is closed right after it is reported */
+  if (true == pending_end_) {
+    pending_end_ = false;
+    name_ = element_stack_.back();
+    element_stack_.pop_back();
+    if (true == element_stack_.empty()) {
+      root_closed_ = true;
+    }
+    return e_event::END_ELEMENT;
+  }
+
+  while (curr_ < end_) {
+    if ('<' != *curr_) {
+      /* Texts are not reported */
+      if ('\n' == *curr_) {
+        curr_line_++;
+      }
+      curr_++;
+      continue;
+    }
+    line_ = curr_line_;
+    size_t remaining = size_t(end_ - curr_);
+    if ((4 <= remaining) && (0 == std::strncmp(curr_, "<!--", 4))) {
+      skip_until("-->");
+    } else if ((9 <= remaining) &&
+               (0 == std::strncmp(curr_, "<![CDATA[", 9))) {
+      skip_until("]]>");
+    } else if ((2 <= remaining) && ('?' == curr_[1])) {
+      skip_until("?>");
+    } else if ((2 <= remaining) && ('!' == curr_[1])) {
+      /* Document type declarations with internal subsets are not expected */
+      skip_until(">");
+    } else if ((2 <= remaining) && ('/' == curr_[1])) {
+      parse_end_element();
+      if (true == element_stack_.empty()) {
+        root_closed_ = true;
+      }
+      return e_event::END_ELEMENT;
+    } else {
+      if (true == root_closed_) {
+        throw_error("Multiple root elements in XML document");
+      }
+      parse_start_element();
+      return e_event::START_ELEMENT;
+    }
+  }
+
+  if (false == element_stack_.empty()) {
+    line_ = curr_line_;
+    throw_error(std::string("Unexpected end of document while element <") +
+                element_stack_.back() + "> is not closed");
+  }
+  name_.clear();
+  return e_event::END_DOCUMENT;
+}
+
+void XmlPullParser::skip_element() {
+  size_t target_depth = element_stack_.size();
+  while (true) {
+    e_event event = next();
+    if ((e_event::END_ELEMENT == event) &&
+        (target_depth - 1 == element_stack_.size())) {
+      return;
+    }
+    if (e_event::END_DOCUMENT == event) {
+      return;
+    }
+  }
+}
+
+/************************************************************************
+ * Internal utility
+ ***********************************************************************/
+void XmlPullParser::throw_error(const std::string& msg) const {
+  throw XmlPullParserError(msg, line_);
+}
+
+void XmlPullParser::skip_until(const char* pattern) {
+  size_t pattern_len = std::strlen(pattern);
+  while (curr_ < end_) {
+    if ((size_t(end_ - curr_) >= pattern_len) &&
+        (0 == std::strncmp(curr_, pattern, pattern_len))) {
+      curr_ += pattern_len;
+      return;
+    }
+    if ('\n' == *curr_) {
+      curr_line_++;
+    }
+    curr_++;
+  }
+  throw_error(std::string("Unexpected end of document while looking for '") +
+              pattern + "'");
+}
+
+void XmlPullParser::skip_spaces() {
+  while ((curr_ < end_) && (true == is_xml_space(*curr_))) {
+    if ('\n' == *curr_) {
+      curr_line_++;
+    }
+    curr_++;
+  }
+}
+
+const char* XmlPullParser::parse_name() {
+  const char* name_begin = curr_;
+  while ((curr_ < end_) && (true == is_xml_name_char(*curr_))) {
+    curr_++;
+  }
+  if (name_begin == curr_) {
+    throw_error("Expect a name in XML element");
+  }
+  return name_begin;
+}
+
+void XmlPullParser::parse_start_element() {
+  /* Skip '<' */
+  curr_++;
+  const char* name_begin = parse_name();
+  name_.assign(name_begin, curr_);
+
+  while (true) {
+    skip_spaces();
+    if (curr_ >= end_) {
+      throw_error(std::string("Unexpected end of document in element <") +
+                  name_ + ">");
+    }
+    if ('>' == *curr_) {
+      curr_++;
+      element_stack_.push_back(name_);
+      return;
+    }
+    if ('/' == *curr_) {
+      curr_++;
+      if ((curr_ >= end_) || ('>' != *curr_)) {
+        throw_error(std::string("Expect '>' after '/' in element <") + name_ +
+                    ">");
+      }
+      curr_++;
+      element_stack_.push_back(name_);
+      pending_end_ = true;
+      return;
+    }
+    /* An attribute */
+    AttributeRange attr;
+    attr.name_begin = parse_name();
+    attr.name_end = curr_;
+    skip_spaces();
+    if ((curr_ >= end_) || ('=' != *curr_)) {
+      throw_error(std::string("Expect '=' after attribute '") +
+                  std::string(attr.name_begin, attr.name_end) +
+                  "' in element <" + name_ + ">");
+    }
+    curr_++;
+    skip_spaces();
+    if ((curr_ >= end_) || (('"' != *curr_) && ('\'' != *curr_))) {
+      throw_error(std::string("Expect a quoted value for attribute '") +
+                  std::string(attr.name_begin, attr.name_end) +
+                  "' in element <" + name_ + ">");
+    }
+    char quote = *curr_;
+    curr_++;
+    attr.value_begin = curr_;
+    while ((curr_ < end_) && (quote != *curr_)) {
+      if ('\n' == *curr_) {
+        curr_line_++;
+      }
+      curr_++;
+    }
+    if (curr_ >= end_) {
+      throw_error(std::string("Unterminated value for attribute '") +
+                  std::string(attr.name_begin, attr.name_end) +
+                  "' in element <" + name_ + ">");
+    }
+    attr.value_end = curr_;
+    curr_++;
+    attributes_.push_back(attr);
+  }
+}
+
+void XmlPullParser::parse_end_element() {
+  /* Skip '</' */
+  curr_ += 2;
+  const char* name_begin = parse_name();
+  name_.assign(name_begin, curr_);
+  skip_spaces();
+  if ((curr_ >= end_) || ('>' != *curr_)) {
+    throw_error(std::string("Expect '>' in end element </") + name_ + ">");
+  }
+  curr_++;
+  if (true == element_stack_.empty()) {
+    throw_error(std::string("Unexpected end element </") + name_ + ">");
+  }
+  if (element_stack_.back() != name_) {
+    throw_error(std::string("End element </") + name_ +
+                "> does not match start element <" + element_stack_.back() +
+                ">");
+  }
+  element_stack_.pop_back();
+}
+
+const XmlPullParser::AttributeRange* XmlPullParser::find_attribute(
+  const char* attr_name) const {
+  size_t name_len = std::strlen(attr_name);
+  for (const AttributeRange& attr : attributes_) {
+    if ((size_t(attr.name_end - attr.name_begin) == name_len) &&
+        (0 == std::strncmp(attr.name_begin, attr_name, name_len))) {
+      return &attr;
+    }
+  }
+  return nullptr;
+}
+
+int XmlPullParser::decode_int_value(const char* attr_name) const {
+  std::string value = attribute(attr_name);
+  char* value_end = nullptr;
+  long result = std::strtol(value.c_str(), &value_end, 10);
+  if ((true == value.empty()) || ('\0' != *value_end)) {
+    throw_error(std::string("Invalid integer '") + value +
+                "' for attribute '" + attr_name + "' in element <" + name_ +
+                ">");
+  }
+  return int(result);
+}
+
+std::string XmlPullParser::decode_value(const char* begin,
+                                        const char* end) const {
+  std::string value;
+  value.reserve(end - begin);
+  const char* curr = begin;
+  while (curr < end) {
+    if ('&' != *curr) {
+      value.push_back(*curr);
+      curr++;
+      continue;
+    }
+    const char* entity_end = curr;
+    while ((entity_end < end) && (';' != *entity_end)) {
+      entity_end++;
+    }
+    if (entity_end >= end) {
+      throw_error("Unterminated entity in attribute value");
+    }
+    std::string entity(curr + 1, entity_end);
+    if ("lt" == entity) {
+      value.push_back('<');
+    } else if ("gt" == entity) {
+      value.push_back('>');
+    } else if ("amp" == entity) {
+      value.push_back('&');
+    } else if ("quot" == entity) {
+      value.push_back('"');
+    } else if ("apos" == entity) {
+      value.push_back('\'');
+    } else if ((1 < entity.size()) && ('#' == entity[0])) {
+      char* code_end = nullptr;
+      unsigned long code = 0;
+      if (('x' == entity[1]) || ('X' == entity[1])) {
+        code = std::strtoul(entity.c_str() + 2, &code_end, 16);
+      } else {
+        code = std::strtoul(entity.c_str() + 1, &code_end, 10);
+      }
+      if ('\0' != *code_end) {
+        throw_error(std::string("Invalid character reference '&") + entity +
+                    ";' in attribute value");
+      }
+      append_utf8(value, code);
+    } else {
+      throw_error(std::string("Unknown entity '&") + entity +
+                  ";' in attribute value");
+    }
+    curr = entity_end + 1;
+  }
+  return value;
+}
+
+} /* end namespace openfpga */
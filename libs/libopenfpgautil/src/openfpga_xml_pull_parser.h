@@ -0,0 +1,114 @@
+#ifndef OPENFPGA_XML_PULL_PARSER_H
+#define OPENFPGA_XML_PULL_PARSER_H
+
+/********************************************************************
+ * Include header files that are required by data structure declaration
+ *******************************************************************/
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+/* namespace openfpga begins */
+namespace openfpga {
+
+/********************************************************************
+ * Error raised by the XML pull parser, which records the line where
+ * the error is found
+ *******************************************************************/
+class XmlPullParserError : public std::runtime_error {
+ public:
+  XmlPullParserError(const std::string& msg, const size_t& line)
+    : std::runtime_error(msg), line_(line) {}
+  size_t line() const { return line_; }
+
+ private:
+  size_t line_;
+};
+
+/********************************************************************
+ * A pull-style XML parser which walks through a buffer of XML codes
+ * and reports the elements one by one, without building any document
+ * object model. Only the elements and their attributes are reported,
+ * while texts, comments, processing instructions, CDATA sections and
+ * document type declarations are skipped.
+ *
+ * The buffer must outlive the parser, as attributes are only decoded
+ * on demand from the buffer. A self-closing element is reported as a
+ * start element, followed by an end element.
+ *
+ * Typical usage:
+ *   XmlPullParser parser(data, data + size);
+ *   while (XmlPullParser::e_event::END_DOCUMENT != parser.next()) {
+ *     ...
+ *   }
+ *******************************************************************/
+class XmlPullParser {
+ public: /* Types */
+  enum class e_event { START_ELEMENT, END_ELEMENT, END_DOCUMENT };
+
+ public: /* Constructors */
+  XmlPullParser(const char* begin, const char* end);
+
+ public: /* Public accessors */
+  /* Name of the current element */
+  const std::string& name() const;
+  /* Line of the current element, starting from 1 */
+  size_t line() const;
+  /* Number of ancestors of the current element */
+  size_t depth() const;
+  /* Check if the current start element has a given attribute */
+  bool has_attribute(const char* attr_name) const;
+  /* Find the value of an attribute of the current start element, where
+   * the entities are decoded. Error out if the attribute is not found */
+  std::string attribute(const char* attr_name) const;
+  /* Find the value of an attribute as an integer. Error out if the
+   * attribute is not found */
+  int int_attribute(const char* attr_name) const;
+  /* Find the value of an attribute as an integer, or a default value if
+   * the attribute is not found */
+  int int_attribute(const char* attr_name, const int& default_value) const;
+
+ public: /* Public mutators */
+  /* Move to the next element */
+  e_event next();
+  /* Skip the children of the current start element, until its end element
+   * which becomes the current element */
+  void skip_element();
+
+ private: /* Internal utility */
+  struct AttributeRange {
+    const char* name_begin;
+    const char* name_end;
+    const char* value_begin;
+    const char* value_end;
+  };
+  [[noreturn]] void throw_error(const std::string& msg) const;
+  void skip_until(const char* pattern);
+  void skip_spaces();
+  const char* parse_name();
+  void parse_start_element();
+  void parse_end_element();
+  const AttributeRange* find_attribute(const char* attr_name) const;
+  std::string decode_value(const char* begin, const char* end) const;
+  int decode_int_value(const char* attr_name) const;
+
+ private: /* Internal data */
+  const char* curr_;
+  const char* end_;
+  size_t curr_line_;
+
+  std::string name_;
+  size_t line_;
+  std::vector<AttributeRange> attributes_;
+
+  /* Names of the elements which are not closed yet */
+  std::vector<std::string> element_stack_;
+  /* The current element is self-closing, so an end element is pending */
+  bool pending_end_;
+  bool root_closed_;
+};
+
+} /* end namespace openfpga */
+
+#endif
@@ -0,0 +1,52 @@
+#ifndef OPENFPGA_TEST_UTILS_H
+#define OPENFPGA_TEST_UTILS_H
+
+/********************************************************************
+ * Helper functions shared by the self-checking unit tests. Each test is
+ * a single executable, which counts the failed checks and reports them
+ * through its exit code
+ *******************************************************************/
+#include <cstddef>
+#include <fstream>
+#include <iterator>
+#include <string>
+
+/* Headers from vtrutils */
+#include "vtr_log.h"
+
+/* Number of failed checks of the test executable */
+inline size_t num_test_errors = 0;
+
+/* Report the message of a failed check */
+inline void check(const bool& condition, const char* message) {
+  if (false == condition) {
+    VTR_LOG_ERROR("%s\n", message);
+    num_test_errors++;
+  }
+}
+
+/* Read all the bytes of a file, or nothing if it cannot be opened */
+inline std::string read_file(const std::string& fname) {
+  std::ifstream fp(fname, std::ios::in | std::ios::binary);
+  return std::string(std::istreambuf_iterator<char>(fp),
+                     std::istreambuf_iterator<char>());
+}
+
+/* Replace the content of a file by the given bytes */
+inline void write_file(const std::string& fname, const std::string& data) {
+  std::ofstream fp(fname, std::ios::out | std::ios::binary | std::ios::trunc);
+  fp.write(data.data(), data.size());
+}
+
+/* Report the result of a test and return the exit code of its executable */
+inline int test_exit_code(const char* test_name) {
+  if (0 < num_test_errors) {
+    VTR_LOG_ERROR("%s test failed with %lu errors\n", test_name,
+                  num_test_errors);
+    return 1;
+  }
+  VTR_LOG("%s test passed\n", test_name);
+  return 0;
+}
+
+#endif
@@ -0,0 +1,119 @@
+/********************************************************************
+ * Unit test functions to validate the run-length codec of bit streams
+ * 1. encoded streams are decoded to the same bits
+ * 2. corrupted streams are rejected by the decoder
+ *******************************************************************/
+#include <cstdint>
+#include <vector>
+
+/* Headers from vtrutils */
+#include "vtr_assert.h"
+#include "vtr_log.h"
+
+/* Headers from openfpgautil library */
+#include "openfpga_bit_run_length.h"
+
+/* Headers shared by the unit tests */
+#include "openfpga_test_utils.h"
+
+static std::vector<uint8_t> encode(const std::vector<bool>& bits) {
+  openfpga::BitRunLengthEncoder encoder;
+  encoder.add_bits(bits);
+  encoder.finish();
+  VTR_ASSERT(bits.size() == encoder.num_bits());
+  return encoder.data();
+}
+
+static bool decode(const std::vector<uint8_t>& data, const size_t& num_bits,
+                   std::vector<bool>& bits) {
+  return openfpga::decode_bit_run_length(data.data(), data.size(), num_bits,
+                                         bits);
+}
+
+static void check_round_trip(const std::vector<bool>& bits,
+                             const char* message) {
+  std::vector<bool> decoded_bits;
+  check(true == decode(encode(bits), bits.size(), decoded_bits), message);
+  check(bits == decoded_bits, message);
+}
+
+/* Bits of a given density of ones from a linear congruential generator,
+ * which is reproducible on any platform */
+static std::vector<bool> random_bits(const size_t& num_bits,
+                                     const uint32_t& percent_ones,
+                                     uint32_t seed) {
+  std::vector<bool> bits;
+  for (size_t ibit = 0; ibit < num_bits; ++ibit) {
+    seed = seed * 1103515245 + 12345;
+    bits.push_back((seed >> 16) % 100 < percent_ones);
+  }
+  return bits;
+}
+
+int main(int argc, const char** argv) {
+  VTR_ASSERT(1 == argc);
+  (void)argv;
+
+  /* Examples of the format */
+  std::vector<bool> bits(16, false);
+  bits[7] = true;
+  bits[8] = true;
+  check(std::vector<uint8_t>({0x07, 0x02, 0x07}) == encode(bits),
+        "Mismatch in documented example");
+  check(std::vector<uint8_t>({0x00, 0x01}) == encode({true}),
+        "Mismatch in stream starting with '1'");
+  check(std::vector<uint8_t>() == encode({}), "Mismatch in empty stream");
+  /* Runs longer than 7 bits take several bytes */
+  check(std::vector<uint8_t>({0x80, 0x01}) ==
+          encode(std::vector<bool>(128, false)),
+        "Mismatch in run of 128 bits");
+
+  /* Round trips */
+  check_round_trip({}, "Failed round trip of empty stream");
+  check_round_trip({true}, "Failed round trip of single '1'");
+  check_round_trip(std::vector<bool>(100000, true),
+                   "Failed round trip of long run");
+  for (uint32_t percent_ones : {0, 1, 10, 50, 90, 100}) {
+    check_round_trip(random_bits(10000, percent_ones, percent_ones + 1),
+                     "Failed round trip of random stream");
+  }
+
+  /* A stream continued after finish() is the same as a stream encoded at
+   * once */
+  openfpga::BitRunLengthEncoder encoder;
+  std::vector<bool> first_bits = random_bits(100, 50, 7);
+  std::vector<bool> second_bits = random_bits(100, 50, 8);
+  encoder.add_bits(first_bits);
+  encoder.finish();
+  encoder.add_bits(second_bits);
+  encoder.finish();
+  std::vector<bool> all_bits = first_bits;
+  all_bits.insert(all_bits.end(), second_bits.begin(), second_bits.end());
+  std::vector<bool> decoded_bits;
+  check(true == decode(encoder.data(), all_bits.size(), decoded_bits),
+        "Failed to decode continued stream");
+  check(all_bits == decoded_bits, "Mismatch in continued stream");
+  encoder.clear();
+  check(0 == encoder.num_bits() && true == encoder.data().empty(),
+        "Encoder is not cleared");
+
+  /* Corrupted streams */
+  std::vector<uint8_t> data = encode(random_bits(1000, 50, 3));
+  check(false == decode(std::vector<uint8_t>(data.begin(), data.end() - 1),
+                        1000, decoded_bits),
+        "Truncated stream is accepted");
+  std::vector<uint8_t> extra_data = data;
+  extra_data.push_back(0x01);
+  check(false == decode(extra_data, 1000, decoded_bits),
+        "Stream with extra bytes is accepted");
+  check(false == decode(data, 1001, decoded_bits),
+        "Stream with missing bits is accepted");
+  check(false == decode(data, 999, decoded_bits),
+        "Stream with extra bits is accepted");
+  check(false == decode({0x80, 0x80}, 16, decoded_bits),
+        "Unterminated run is accepted");
+  check(false == decode(std::vector<uint8_t>(11, 0xff), 16, decoded_bits),
+        "Overflowing run is accepted");
+
+  return test_exit_code("Bit run-length");
+}
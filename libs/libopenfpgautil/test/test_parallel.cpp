@@ -0,0 +1,72 @@
+/********************************************************************
+ * Unit test functions to validate the multi-threading utilities
+ * 1. the number of threads given by users is parsed, while any text
+ *    which is not a number is rejected
+ * 2. a parallel loop visits each index exactly once
+ *******************************************************************/
+#include <atomic>
+#include <string>
+#include <vector>
+
+/* Headers from vtrutils */
+#include "vtr_assert.h"
+#include "vtr_log.h"
+
+/* Headers from openfpgautil library */
+#include "openfpga_parallel.h"
+
+/* Headers shared by the unit tests */
+#include "openfpga_test_utils.h"
+
+int main(int argc, const char** argv) {
+  VTR_ASSERT(1 == argc);
+  (void)argv;
+
+  /* Valid numbers */
+  size_t num_threads = 1;
+  check(true == openfpga::parse_num_threads("0", num_threads) &&
+          0 == num_threads,
+        "Fail to parse '0'");
+  check(true == openfpga::parse_num_threads("16", num_threads) &&
+          16 == num_threads,
+        "Fail to parse '16'");
+  check(true == openfpga::parse_num_threads("007", num_threads) &&
+          7 == num_threads,
+        "Fail to parse '007'");
+
+  /* Invalid texts leave the number untouched */
+  for (const char* value :
+       {"", "abc", "-1", "+2", "4k", " 4", "4 ", "1.5",
+        "99999999999999999999999"}) {
+    num_threads = 3;
+    check(false == openfpga::parse_num_threads(value, num_threads),
+          "Invalid number of threads is accepted");
+    check(3 == num_threads, "Number of threads is touched by invalid text");
+  }
+
+  check(1 <= openfpga::find_num_threads(0),
+        "No thread is found for hardware threads");
+  check(5 == openfpga::find_num_threads(5), "Mismatch in number of threads");
+
+  /* Each index is visited once, by a thread of the pool */
+  for (size_t num_workers : {size_t(1), size_t(4)}) {
+    std::vector<std::atomic<size_t>> visits(1000);
+    std::atomic<bool> valid_thread_ids(true);
+    openfpga::parallel_for_with_thread_id(
+      visits.size(), num_workers,
+      [&](const size_t& index, const size_t& thread_id) {
+        visits[index]++;
+        if (num_workers <= thread_id) {
+          valid_thread_ids = false;
+        }
+      });
+    bool visited_once = true;
+    for (const std::atomic<size_t>& visit : visits) {
+      visited_once = visited_once && (1 == visit);
+    }
+    check(true == visited_once, "Index is not visited exactly once");
+    check(true == valid_thread_ids, "Thread id is out of range");
+  }
+
+  return test_exit_code("Parallel");
+}
@@ -0,0 +1,85 @@
+/********************************************************************
+ * Unit test functions to validate the table of interned strings
+ * 1. a string is interned once, and its handle gives back the string
+ * 2. the empty string has a reserved handle
+ * 3. strings are interned and read by multiple threads at the same time
+ *******************************************************************/
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+/* Headers from vtrutils */
+#include "vtr_assert.h"
+#include "vtr_log.h"
+
+/* Headers from openfpgautil library */
+#include "openfpga_symbol_table.h"
+
+/* Headers shared by the unit tests */
+#include "openfpga_test_utils.h"
+
+int main(int argc, const char** argv) {
+  VTR_ASSERT(1 == argc);
+  (void)argv;
+
+  openfpga::SymbolTable& table = openfpga::SymbolTable::instance();
+
+  /* The empty string */
+  check(openfpga::SymbolTable::EMPTY_SYMBOL == openfpga::intern_symbol(""),
+        "Empty string is not interned as the empty symbol");
+  check(openfpga::symbol_string(openfpga::SymbolTable::EMPTY_SYMBOL).empty(),
+        "Empty symbol is not an empty string");
+
+  /* Interning and look-up */
+  check(openfpga::SymbolTable::INVALID_SYMBOL == table.find("test_symbol"),
+        "String is found before being interned");
+  size_t num_symbols = table.size();
+  openfpga::SymbolId symbol = openfpga::intern_symbol("test_symbol");
+  check(num_symbols + 1 == table.size(), "Mismatch in number of symbols");
+  check(symbol == openfpga::intern_symbol(std::string("test_symbol")),
+        "String is interned twice");
+  check(num_symbols + 1 == table.size(), "String is stored twice");
+  check(symbol == table.find("test_symbol"), "Mismatch in found symbol");
+  check("test_symbol" == openfpga::symbol_string(symbol),
+        "Mismatch in string of symbol");
+  check(symbol != openfpga::intern_symbol("test_symbol2"),
+        "Two strings share a symbol");
+
+  /* Threads intern the same strings in different orders, while reading the
+   * strings of their own handles. Each string should get a single handle.
+   * The number of strings is a power of 2, so that each odd step visits all
+   * the strings */
+  const size_t num_threads = 8;
+  const size_t num_strings = 1 << 14;
+  std::vector<std::vector<openfpga::SymbolId>> symbols(
+    num_threads, std::vector<openfpga::SymbolId>(num_strings));
+  std::atomic<bool> valid_strings(true);
+  std::vector<std::thread> threads;
+  for (size_t ithread = 0; ithread < num_threads; ++ithread) {
+    threads.emplace_back([&, ithread]() {
+      for (size_t istr = 0; istr < num_strings; ++istr) {
+        size_t index = (istr * (2 * ithread + 1)) % num_strings;
+        std::string str = "concurrent_" + std::to_string(index);
+        openfpga::SymbolId curr_symbol = openfpga::intern_symbol(str);
+        symbols[ithread][index] = curr_symbol;
+        if (str != openfpga::symbol_string(curr_symbol)) {
+          valid_strings = false;
+        }
+      }
+    });
+  }
+  for (std::thread& thread : threads) {
+    thread.join();
+  }
+  check(true == valid_strings, "Mismatch in string of concurrent symbol");
+  bool same_symbols = true;
+  for (size_t ithread = 1; ithread < num_threads; ++ithread) {
+    same_symbols = same_symbols && (symbols[0] == symbols[ithread]);
+  }
+  check(true == same_symbols, "String is interned twice by threads");
+  check(num_symbols + 2 + num_strings == table.size(),
+        "Mismatch in number of symbols after concurrent interning");
+
+  return test_exit_code("Symbol table");
+}
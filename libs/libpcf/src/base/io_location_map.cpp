@@ -41,36 +41,26 @@ size_t IoLocationMap::io_index(const size_t& x, const size_t& y,
 }
 
 size_t IoLocationMap::io_x(const BasicPort& io_port) const {
-  for (auto pair : io_indices_) {
-    for (const BasicPort& candidate : pair.second) {
-      if (candidate == io_port) {
-        return pair.first[0];
-      }
-    }
-  }
-  return size_t(-1);
+  return io_coordinate(io_port)[0];
 }
 
 size_t IoLocationMap::io_y(const BasicPort& io_port) const {
-  for (auto pair : io_indices_) {
-    for (const BasicPort& candidate : pair.second) {
-      if (candidate == io_port) {
-        return pair.first[1];
-      }
-    }
-  }
-  return size_t(-1);
+  return io_coordinate(io_port)[1];
 }
 
 size_t IoLocationMap::io_z(const BasicPort& io_port) const {
-  for (auto pair : io_indices_) {
-    for (const BasicPort& candidate : pair.second) {
-      if (candidate == io_port) {
-        return pair.first[2];
-      }
-    }
+  return io_coordinate(io_port)[2];
+}
+
+const std::vector<BasicPort>& IoLocationMap::io_ports(const size_t& x,
+                                                      const size_t& y,
+                                                      const size_t& z) const {
+  static const std::vector<BasicPort> EMPTY_IO_PORTS;
+  auto result = io_indices_.find({x, y, z});
+  if (result == io_indices_.end()) {
+    return EMPTY_IO_PORTS;
   }
-  return size_t(-1);
+  return result->second;
 }
 
 void IoLocationMap::set_io_index(const size_t& x, const size_t& y,
@@ -92,6 +82,32 @@ void IoLocationMap::set_io_index(const size_t& x, const size_t& y,
   }
 
   io_indices_[coord].push_back(port_to_add);
+
+  /* Update the reverse lookup */
+  auto coord_result =
+    io_coordinates_[io_port_name].emplace(io_index, coord).first;
+  coord_result->second = std::min(coord_result->second, coord);
+}
+
+/**************************************************
+ * Internal utilities
+ *************************************************/
+std::array<size_t, 3> IoLocationMap::io_coordinate(
+  const BasicPort& io_port) const {
+  std::array<size_t, 3> invalid_coord = {size_t(-1), size_t(-1), size_t(-1)};
+  /* Only single-pin ports are stored */
+  if (1 != io_port.get_width()) {
+    return invalid_coord;
+  }
+  auto name_result = io_coordinates_.find(io_port.get_name());
+  if (name_result == io_coordinates_.end()) {
+    return invalid_coord;
+  }
+  auto index_result = name_result->second.find(io_port.get_lsb());
+  if (index_result == name_result->second.end()) {
+    return invalid_coord;
+  }
+  return index_result->second;
 }
 
 int IoLocationMap::write_to_xml_file(const std::string& fname,
@@ -141,7 +157,7 @@ int IoLocationMap::write_to_xml_file(const std::string& fname,
   size_t io_cnt = 0;
 
   /* Walk through the fabric I/O location map data structure */
-  for (auto pair : io_indices_) {
+  for (const auto& pair : io_indices_) {
     for (const BasicPort& port : pair.second) {
       fp << "\t"
          << "<io pad=\"" << port.get_name().c_str() << "[" << port.get_lsb()
@@ -9,6 +9,7 @@
 #include <array>
 #include <map>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "openfpga_port.h"
@@ -39,6 +40,9 @@ class IoLocationMap {
   size_t io_x(const BasicPort& io_port) const;
   size_t io_y(const BasicPort& io_port) const;
   size_t io_z(const BasicPort& io_port) const;
+  /* Find all the I/Os assigned to a coordinate, in the order of assignment */
+  const std::vector<BasicPort>& io_ports(const size_t& x, const size_t& y,
+                                         const size_t& z) const;
 
  public: /* Public mutators */
   void set_io_index(const size_t& x, const size_t& y, const size_t& z,
@@ -49,11 +53,22 @@ class IoLocationMap {
                         const bool& include_time_stamp,
                         const bool& verbose) const;
 
+ private: /* Internal utilities */
+  /* Find the coordinate of an I/O, whose values are size_t(-1) if not found */
+  std::array<size_t, 3> io_coordinate(const BasicPort& io_port) const;
+
  private: /* Internal Data */
   /* I/O index fast lookup by [x][y][z] location
    * Note that multiple I/Os may be assigned to the same coordinate!
    */
   std::map<std::array<size_t, 3>, std::vector<BasicPort>> io_indices_;
+  /* Reverse lookup of the coordinate by I/O name and index [name][index]
+   * When an I/O is assigned to multiple coordinates, the smallest one is kept,
+   * which is the first one in the order of io_indices_
+   */
+  std::unordered_map<std::string,
+                     std::unordered_map<size_t, std::array<size_t, 3>>>
+    io_coordinates_;
 };
 
 } /* End namespace openfpga*/
@@ -103,7 +103,7 @@ int IoNetPlace::write_to_place_file(const std::string& fname,
   size_t io_cnt = 0;
 
   /* Walk through the fabric I/O location map data structure */
-  for (auto pair : io_coords_) {
+  for (const auto& pair : io_coords_) {
     fp << pair.first.c_str() << "\t";
     fp << pair.second[0] << "\t";
     fp << pair.second[1] << "\t";
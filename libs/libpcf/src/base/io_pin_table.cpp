@@ -55,7 +55,15 @@ IoPinTable::e_io_direction IoPinTable::pin_direction(
 std::vector<IoPinTableId> IoPinTable::find_internal_pin(
   const BasicPort& ext_pin, const e_io_direction& pin_direction) const {
   std::vector<IoPinTableId> int_pin_ids;
-  for (auto pin_id : pin_ids_) {
+  auto name_result = external_pin_lookup_.find(ext_pin.get_name());
+  if (name_result == external_pin_lookup_.end()) {
+    return int_pin_ids;
+  }
+  auto lsb_result = name_result->second.find(ext_pin.get_lsb());
+  if (lsb_result == name_result->second.end()) {
+    return int_pin_ids;
+  }
+  for (auto pin_id : lsb_result->second) {
     if ((external_pins_[pin_id] == ext_pin) &&
         (pin_directions_[pin_id] == pin_direction)) {
       int_pin_ids.push_back(pin_id);
@@ -99,7 +107,24 @@ void IoPinTable::set_internal_pin(const IoPinTableId& pin_id,
 void IoPinTable::set_external_pin(const IoPinTableId& pin_id,
                                   const BasicPort& pin) {
   VTR_ASSERT(valid_pin_id(pin_id));
+  /* Remove the pin from the lookup of its previous external pin */
+  const BasicPort& old_pin = external_pins_[pin_id];
+  auto name_result = external_pin_lookup_.find(old_pin.get_name());
+  if (name_result != external_pin_lookup_.end()) {
+    auto lsb_result = name_result->second.find(old_pin.get_lsb());
+    if (lsb_result != name_result->second.end()) {
+      std::vector<IoPinTableId>& old_pin_ids = lsb_result->second;
+      old_pin_ids.erase(
+        std::remove(old_pin_ids.begin(), old_pin_ids.end(), pin_id),
+        old_pin_ids.end());
+    }
+  }
   external_pins_[pin_id] = pin;
+  /* Keep the pin ids sorted, as the lookup is expected to follow their order */
+  std::vector<IoPinTableId>& pin_ids =
+    external_pin_lookup_[pin.get_name()][pin.get_lsb()];
+  pin_ids.insert(std::lower_bound(pin_ids.begin(), pin_ids.end(), pin_id),
+                 pin_id);
 }
 
 void IoPinTable::set_pin_side(const IoPinTableId& pin_id, const e_side& side) {
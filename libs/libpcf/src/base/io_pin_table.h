@@ -7,6 +7,8 @@
 #include <array>
 #include <map>
 #include <string>
+#include <unordered_map>
+#include <vector>
 
 /* Headers from vtrutil library */
 #include "vtr_geometry.h"
@@ -111,6 +113,12 @@ class IoPinTable {
   vtr::vector<IoPinTableId, BasicPort> external_pins_;
   vtr::vector<IoPinTableId, e_side> pin_sides_;
   vtr::vector<IoPinTableId, e_io_direction> pin_directions_;
+
+  /* Fast lookup of the pins mapped to an external pin [name][lsb], in the
+   * order of pin ids */
+  std::unordered_map<std::string,
+                     std::unordered_map<size_t, std::vector<IoPinTableId>>>
+    external_pin_lookup_;
 };
 
 } /* end namespace openfpga */
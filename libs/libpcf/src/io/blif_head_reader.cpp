@@ -2,6 +2,7 @@
 
 #include <cassert>
 #include <cstdio>
+#include <utility>
 
 namespace blifparse {
 
@@ -18,11 +19,11 @@ void BlifHeadReader::begin_model(std::string model_name) {
 }
 
 void BlifHeadReader::inputs(std::vector<std::string> input_conns) {
-  input_pins_ = input_conns;
+  input_pins_ = std::move(input_conns);
 }
 
 void BlifHeadReader::outputs(std::vector<std::string> output_conns) {
-  output_pins_ = output_conns;
+  output_pins_ = std::move(output_conns);
 }
 
 void BlifHeadReader::names(std::vector<std::string> nets,
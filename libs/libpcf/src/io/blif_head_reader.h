@@ -47,8 +47,8 @@ class BlifHeadReader : public Callback {
   }
 
   bool had_error() { return had_error_; }
-  std::vector<std::string> input_pins() { return input_pins_; }
-  std::vector<std::string> output_pins() { return output_pins_; }
+  const std::vector<std::string>& input_pins() const { return input_pins_; }
+  const std::vector<std::string>& output_pins() const { return output_pins_; }
 
  private:
   std::vector<std::string> input_pins_;
@@ -0,0 +1,116 @@
+/******************************************************************************
+ * A scanner which only reads the head of a .blif file, i.e., the .model,
+ * .inputs and .outputs lines of the top-level model, and stops at the first
+ * line of the netlist. This is much faster than parsing the whole file when
+ * only the I/Os of a design are required
+ ******************************************************************************/
+#include <algorithm>
+#include <array>
+#include <fstream>
+#include <sstream>
+
+/* Headers from vtrutil library */
+#include "vtr_log.h"
+#include "vtr_time.h"
+
+/* Headers from libpcf library */
+#include "read_blif_head.h"
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+/**************************************************
+ * Constants
+ *************************************************/
+constexpr const char BLIF_COMMENT = '#';
+constexpr const char BLIF_LINE_CONTINUATION = '\\';
+/* Keywords which start the netlist, after which no I/O can be declared */
+constexpr std::array<const char*, 7> BLIF_NETLIST_KEYWORDS = {
+  ".names", ".latch", ".subckt", ".gate", ".mlatch", ".blackbox", ".end"};
+
+/********************************************************************
+ * Read the inputs and outputs of the first model of a .blif file.
+ * Multiple .inputs and .outputs lines are merged.
+ *
+ * Return 0 if successful
+ * Return 1 if there is no model in the file
+ * Return 2 if fail when opening files
+ *******************************************************************/
+int read_blif_head(const char* fname, std::vector<std::string>& input_pins,
+                   std::vector<std::string>& output_pins) {
+  vtr::ScopedStartFinishTimer timer("Read head of " + std::string(fname));
+
+  /* Create a file handler */
+  std::ifstream fp(fname);
+  if (!fp.is_open()) {
+    VTR_LOG_ERROR("Fail to open blif file '%s'!\n", fname);
+    return 2;
+  }
+
+  input_pins.clear();
+  output_pins.clear();
+
+  bool found_model = false;
+  std::string line;
+  std::string statement;
+  while (std::getline(fp, line)) {
+    /* Remove comments and trailing spaces */
+    size_t comment_pos = line.find(BLIF_COMMENT);
+    if (std::string::npos != comment_pos) {
+      line.erase(comment_pos);
+    }
+    size_t last_pos = line.find_last_not_of(" \t\r");
+    line.erase(std::string::npos == last_pos ? 0 : last_pos + 1);
+    /* A statement may be split into multiple lines */
+    if ((false == line.empty()) && (BLIF_LINE_CONTINUATION == line.back())) {
+      line.pop_back();
+      statement += line;
+      statement += ' ';
+      continue;
+    }
+    statement += line;
+
+    std::stringstream ss(statement);
+    statement.clear();
+    std::string keyword;
+    if (!(ss >> keyword)) {
+      continue;
+    }
+    if (keyword == ".model") {
+      /* Only the first model is the top-level one */
+      if (true == found_model) {
+        break;
+      }
+      found_model = true;
+      continue;
+    }
+    std::vector<std::string>* pins = nullptr;
+    if (keyword == ".inputs") {
+      pins = &input_pins;
+    } else if (keyword == ".outputs") {
+      pins = &output_pins;
+    }
+    if (nullptr != pins) {
+      std::string pin;
+      while (ss >> pin) {
+        pins->push_back(pin);
+      }
+      continue;
+    }
+    /* Stop once the netlist starts */
+    if (BLIF_NETLIST_KEYWORDS.end() !=
+        std::find(BLIF_NETLIST_KEYWORDS.begin(), BLIF_NETLIST_KEYWORDS.end(),
+                  keyword)) {
+      break;
+    }
+  }
+
+  if (false == found_model) {
+    VTR_LOG_ERROR("No model is defined in blif file '%s'!\n", fname);
+    return 1;
+  }
+
+  return 0;
+}
+
+} /* end namespace openfpga */
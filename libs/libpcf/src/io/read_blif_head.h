@@ -0,0 +1,19 @@
+#ifndef READ_BLIF_HEAD_H
+#define READ_BLIF_HEAD_H
+/********************************************************************
+ * Include header files required by the data structure definition
+ *******************************************************************/
+#include <string>
+#include <vector>
+
+/* Begin namespace openfpga */
+namespace openfpga {
+
+/* Scan the head of a .blif file for the inputs and outputs of its top-level
+ * model, without parsing the netlist */
+int read_blif_head(const char* fname, std::vector<std::string>& input_pins,
+                   std::vector<std::string>& output_pins);
+
+} /* End namespace openfpga*/
+
+#endif
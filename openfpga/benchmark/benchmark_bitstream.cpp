@@ -0,0 +1,129 @@
+/********************************************************************
+ * Micro-benchmarks of the bitstream databases: adding bits to the
+ * architecture bitstream, finding the bits of blocks, setting the
+ * addresses of the fabric bitstream and the XML reader/writer
+ *******************************************************************/
+#include "benchmark_suites.h"
+
+/* Headers from vtrutil library */
+#include "vtr_assert.h"
+
+/* Headers from fpgabitstream library */
+#include "bitstream_manager.h"
+#include "read_xml_arch_bitstream.h"
+#include "write_xml_arch_bitstream.h"
+
+/* Headers from openfpga library */
+#include "fabric_bitstream.h"
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+/* Number of configuration bits of each block */
+constexpr size_t BLOCK_NUM_BITS = 64;
+/* Enough address bits to index all the bits */
+constexpr size_t FABRIC_ADDRESS_LENGTH = 32;
+
+/********************************************************************
+ * Build a bitstream with a top-level block, whose child blocks have
+ * a number of bits each
+ *******************************************************************/
+static void build_synthetic_arch_bitstream(BitstreamManager& bitstream_manager,
+                                           const size_t& num_blocks) {
+  bitstream_manager.reserve_blocks(num_blocks + 1);
+  bitstream_manager.reserve_bits(num_blocks * BLOCK_NUM_BITS);
+  ConfigBlockId top_block = bitstream_manager.add_block("top");
+  bitstream_manager.reserve_child_blocks(top_block, num_blocks);
+  for (size_t iblk = 0; iblk < num_blocks; ++iblk) {
+    ConfigBlockId block =
+      bitstream_manager.add_block(std::string("blk_") + std::to_string(iblk));
+    bitstream_manager.add_child_block(top_block, block);
+    for (size_t ibit = 0; ibit < BLOCK_NUM_BITS; ++ibit) {
+      bitstream_manager.add_bit(block, 0 == (iblk + ibit) % 3);
+    }
+  }
+}
+
+void add_bitstream_benchmarks(MicroBenchmarkSuite& suite, const size_t& scale,
+                              const std::string& work_dir) {
+  const size_t num_blocks = 1000 * scale;
+
+  suite.add_benchmark(
+    "bitstream_manager_add_bits", [num_blocks](MicroBenchmarkTimer& timer) {
+      BitstreamManager bitstream_manager;
+      timer.start();
+      build_synthetic_arch_bitstream(bitstream_manager, num_blocks);
+      timer.stop();
+      return bitstream_manager.num_bits();
+    });
+
+  suite.add_benchmark(
+    "bitstream_manager_block_bits", [num_blocks](MicroBenchmarkTimer& timer) {
+      BitstreamManager bitstream_manager;
+      build_synthetic_arch_bitstream(bitstream_manager, num_blocks);
+      timer.start();
+      size_t num_bits = 0;
+      for (const ConfigBlockId& block : bitstream_manager.blocks()) {
+        num_bits += bitstream_manager.block_bits(block).size();
+      }
+      timer.stop();
+      VTR_ASSERT(bitstream_manager.num_bits() == num_bits);
+      return num_bits;
+    });
+
+  suite.add_benchmark(
+    "fabric_bitstream_set_address", [num_blocks](MicroBenchmarkTimer& timer) {
+      const size_t num_bits = num_blocks * BLOCK_NUM_BITS;
+      /* Addresses are prepared ahead, as they are by the bitstream builder */
+      std::vector<std::vector<char>> addresses(num_bits);
+      for (size_t ibit = 0; ibit < num_bits; ++ibit) {
+        addresses[ibit].resize(FABRIC_ADDRESS_LENGTH);
+        for (size_t iaddr = 0; iaddr < FABRIC_ADDRESS_LENGTH; ++iaddr) {
+          addresses[ibit][iaddr] = (ibit >> iaddr) & 1 ? '1' : '0';
+        }
+      }
+
+      timer.start();
+      FabricBitstream fabric_bitstream;
+      fabric_bitstream.set_use_address(true);
+      fabric_bitstream.set_address_length(FABRIC_ADDRESS_LENGTH);
+      fabric_bitstream.reserve_bits(num_bits);
+      for (size_t ibit = 0; ibit < num_bits; ++ibit) {
+        FabricBitId bit = fabric_bitstream.add_bit(ConfigBitId(ibit));
+        fabric_bitstream.set_bit_address(bit, addresses[ibit]);
+      }
+      timer.stop();
+      return fabric_bitstream.num_bits();
+    });
+
+  const std::string xml_fname = work_dir + "/benchmark_arch_bitstream.xml";
+
+  suite.add_benchmark(
+    "xml_write_arch_bitstream",
+    [num_blocks, xml_fname](MicroBenchmarkTimer& timer) {
+      BitstreamManager bitstream_manager;
+      build_synthetic_arch_bitstream(bitstream_manager, num_blocks);
+      timer.start();
+      write_xml_architecture_bitstream(bitstream_manager, xml_fname, false);
+      timer.stop();
+      return bitstream_manager.num_bits();
+    });
+
+  /* The file is written again, so that the benchmark can be run alone */
+  suite.add_benchmark(
+    "xml_read_arch_bitstream",
+    [num_blocks, xml_fname](MicroBenchmarkTimer& timer) {
+      BitstreamManager bitstream_manager;
+      build_synthetic_arch_bitstream(bitstream_manager, num_blocks);
+      write_xml_architecture_bitstream(bitstream_manager, xml_fname, false);
+      timer.start();
+      BitstreamManager read_bitstream_manager =
+        read_xml_architecture_bitstream(xml_fname.c_str());
+      timer.stop();
+      VTR_ASSERT(bitstream_manager.num_bits() ==
+                 read_bitstream_manager.num_bits());
+      return read_bitstream_manager.num_bits();
+    });
+}
+
+} /* end namespace openfpga */
@@ -0,0 +1,118 @@
+/********************************************************************
+ * Run the micro-benchmarks of the core data structures of OpenFPGA on
+ * synthetic inputs, and write the results in a machine-readable format,
+ * so that the performance of the data structures can be tracked
+ *******************************************************************/
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+/* Headers from vtrutil library */
+#include "vtr_log.h"
+
+/* Headers from openfpgashell library */
+#include "command.h"
+#include "command_context.h"
+#include "command_echo.h"
+#include "command_parser.h"
+
+#include "benchmark_suites.h"
+#include "micro_benchmark.h"
+
+int main(int argc, char** argv) {
+  openfpga::Command bench_cmd("openfpga_benchmark");
+  openfpga::CommandOptionId opt_scale = bench_cmd.add_option(
+    "scale", false,
+    "Multiply the size of the synthetic inputs by a factor. Default: 10");
+  bench_cmd.set_option_require_value(opt_scale, openfpga::OPT_INT);
+
+  openfpga::CommandOptionId opt_repeat = bench_cmd.add_option(
+    "repeat", false, "Number of repetitions of each benchmark. Default: 3");
+  bench_cmd.set_option_require_value(opt_repeat, openfpga::OPT_INT);
+
+  openfpga::CommandOptionId opt_filter = bench_cmd.add_option(
+    "filter", false, "Only run the benchmarks whose names contain a string");
+  bench_cmd.set_option_require_value(opt_filter, openfpga::OPT_STRING);
+
+  openfpga::CommandOptionId opt_output = bench_cmd.add_option(
+    "output", false,
+    "Write the results to a file, in CSV format if the file ends with "
+    "'.csv', otherwise in JSON format");
+  bench_cmd.set_option_require_value(opt_output, openfpga::OPT_STRING);
+
+  openfpga::CommandOptionId opt_arch = bench_cmd.add_option(
+    "arch", false,
+    "OpenFPGA architecture file providing the multiplexer models. Default: "
+    "the one specified when building the benchmarks");
+  bench_cmd.set_option_require_value(opt_arch, openfpga::OPT_STRING);
+
+  openfpga::CommandOptionId opt_work_dir = bench_cmd.add_option(
+    "work_dir", false,
+    "Directory where the files of the reader/writer benchmarks are written. "
+    "Default: current directory");
+  bench_cmd.set_option_require_value(opt_work_dir, openfpga::OPT_STRING);
+
+  openfpga::CommandOptionId opt_help =
+    bench_cmd.add_option("help", false, "Help desk");
+  bench_cmd.set_option_short_name(opt_help, "h");
+
+  std::vector<std::string> cmd_opts;
+  cmd_opts.push_back(bench_cmd.name());
+  for (int iarg = 1; iarg < argc; ++iarg) {
+    cmd_opts.push_back(std::string(argv[iarg]));
+  }
+
+  openfpga::CommandContext bench_cmd_context(bench_cmd);
+  if (false == parse_command(cmd_opts, bench_cmd, bench_cmd_context)) {
+    openfpga::print_command_options(bench_cmd);
+    return 1;
+  }
+  if (true == bench_cmd_context.option_enable(bench_cmd, opt_help)) {
+    openfpga::print_command_options(bench_cmd);
+    return 0;
+  }
+
+  int scale = 10;
+  if (true == bench_cmd_context.option_enable(bench_cmd, opt_scale)) {
+    scale = std::atoi(
+      bench_cmd_context.option_value(bench_cmd, opt_scale).c_str());
+  }
+  int repeats = 3;
+  if (true == bench_cmd_context.option_enable(bench_cmd, opt_repeat)) {
+    repeats = std::atoi(
+      bench_cmd_context.option_value(bench_cmd, opt_repeat).c_str());
+  }
+  if ((0 >= scale) || (0 >= repeats)) {
+    VTR_LOG_ERROR(
+      "The scale and the number of repetitions must be positive!\n");
+    return 1;
+  }
+
+  std::string arch_file(OPENFPGA_BENCHMARK_ARCH_FILE);
+  if (true == bench_cmd_context.option_enable(bench_cmd, opt_arch)) {
+    arch_file = bench_cmd_context.option_value(bench_cmd, opt_arch);
+  }
+  std::string work_dir(".");
+  if (true == bench_cmd_context.option_enable(bench_cmd, opt_work_dir)) {
+    work_dir = bench_cmd_context.option_value(bench_cmd, opt_work_dir);
+  }
+  std::string filter;
+  if (true == bench_cmd_context.option_enable(bench_cmd, opt_filter)) {
+    filter = bench_cmd_context.option_value(bench_cmd, opt_filter);
+  }
+
+  openfpga::MicroBenchmarkSuite suite;
+  openfpga::add_module_manager_benchmarks(suite, size_t(scale));
+  openfpga::add_bitstream_benchmarks(suite, size_t(scale), work_dir);
+  openfpga::add_mux_graph_benchmarks(suite, size_t(scale), arch_file);
+  openfpga::add_port_parser_benchmarks(suite, size_t(scale));
+
+  suite.run(size_t(repeats), filter);
+  suite.print_report();
+
+  if (true == bench_cmd_context.option_enable(bench_cmd, opt_output)) {
+    return suite.write_report(
+      bench_cmd_context.option_value(bench_cmd, opt_output));
+  }
+  return 0;
+}
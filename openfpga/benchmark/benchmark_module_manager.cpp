@@ -0,0 +1,112 @@
+/********************************************************************
+ * Micro-benchmarks of the module graph: creating nets between the
+ * instances of a module and finding the nets of instance pins
+ *******************************************************************/
+#include "benchmark_suites.h"
+
+/* Headers from vtrutil library */
+#include "vtr_assert.h"
+
+/* Headers from openfpga library */
+#include "module_manager.h"
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+/* Width of the ports of the child modules */
+constexpr size_t MODULE_PORT_WIDTH = 16;
+
+/********************************************************************
+ * Build a parent module with a number of instances of a child module,
+ * which has an input and an output port
+ *******************************************************************/
+static ModuleId build_synthetic_module_instances(ModuleManager& module_manager,
+                                                 const size_t& num_instances) {
+  ModuleId child_module = module_manager.add_module("child");
+  module_manager.add_port(child_module, BasicPort("in", MODULE_PORT_WIDTH),
+                          ModuleManager::MODULE_INPUT_PORT);
+  module_manager.add_port(child_module, BasicPort("out", MODULE_PORT_WIDTH),
+                          ModuleManager::MODULE_OUTPUT_PORT);
+
+  ModuleId parent_module = module_manager.add_module("parent");
+  for (size_t inst = 0; inst < num_instances; ++inst) {
+    module_manager.add_child_module(parent_module, child_module, false);
+  }
+  return parent_module;
+}
+
+/********************************************************************
+ * Connect the output of each instance to the input of the next one, as a
+ * ring, pin by pin. Return the number of nets created
+ *******************************************************************/
+static size_t connect_synthetic_module_instances(ModuleManager& module_manager,
+                                                 const ModuleId& parent_module,
+                                                 const size_t& num_instances) {
+  ModuleId child_module = module_manager.find_module("child");
+  ModulePortId in_port = module_manager.find_module_port(child_module, "in");
+  ModulePortId out_port = module_manager.find_module_port(child_module, "out");
+  module_manager.reserve_module_nets(parent_module,
+                                     num_instances * MODULE_PORT_WIDTH);
+  for (size_t inst = 0; inst < num_instances; ++inst) {
+    for (size_t pin = 0; pin < MODULE_PORT_WIDTH; ++pin) {
+      ModuleNetId net = module_manager.create_module_net(parent_module);
+      module_manager.add_module_net_source(parent_module, net, child_module,
+                                           inst, out_port, pin);
+      module_manager.add_module_net_sink(parent_module, net, child_module,
+                                         (inst + 1) % num_instances, in_port,
+                                         pin);
+    }
+  }
+  return num_instances * MODULE_PORT_WIDTH;
+}
+
+void add_module_manager_benchmarks(MicroBenchmarkSuite& suite,
+                                   const size_t& scale) {
+  const size_t num_instances = 1000 * scale;
+
+  suite.add_benchmark(
+    "module_manager_create_nets", [num_instances](MicroBenchmarkTimer& timer) {
+      ModuleManager module_manager;
+      ModuleId parent_module =
+        build_synthetic_module_instances(module_manager, num_instances);
+      timer.start();
+      size_t num_nets = connect_synthetic_module_instances(
+        module_manager, parent_module, num_instances);
+      timer.stop();
+      return num_nets;
+    });
+
+  suite.add_benchmark(
+    "module_manager_find_nets", [num_instances](MicroBenchmarkTimer& timer) {
+      ModuleManager module_manager;
+      ModuleId parent_module =
+        build_synthetic_module_instances(module_manager, num_instances);
+      connect_synthetic_module_instances(module_manager, parent_module,
+                                         num_instances);
+      ModuleId child_module = module_manager.find_module("child");
+      ModulePortId in_port =
+        module_manager.find_module_port(child_module, "in");
+      ModulePortId out_port =
+        module_manager.find_module_port(child_module, "out");
+
+      timer.start();
+      size_t num_found = 0;
+      for (size_t inst = 0; inst < num_instances; ++inst) {
+        for (size_t pin = 0; pin < MODULE_PORT_WIDTH; ++pin) {
+          ModuleNetId src_net = module_manager.module_instance_port_net(
+            parent_module, child_module, inst, out_port, pin);
+          ModuleNetId sink_net = module_manager.module_instance_port_net(
+            parent_module, child_module, inst, in_port, pin);
+          num_found += size_t(module_manager.valid_module_net_id(
+                         parent_module, src_net)) +
+                       size_t(module_manager.valid_module_net_id(
+                         parent_module, sink_net));
+        }
+      }
+      timer.stop();
+      VTR_ASSERT(2 * num_instances * MODULE_PORT_WIDTH == num_found);
+      return num_found;
+    });
+}
+
+} /* end namespace openfpga */
@@ -0,0 +1,103 @@
+/********************************************************************
+ * Micro-benchmarks of the multiplexer graphs: building the graphs of
+ * a routing multiplexer and decoding the memory bits of each input.
+ * The circuit model of the multiplexer comes from an OpenFPGA
+ * architecture file, whose reader is measured as well. The file is read
+ * before the timer starts, so that only the benchmarks selected are
+ * affected by a missing file
+ *******************************************************************/
+#include "benchmark_suites.h"
+
+/* Headers from vtrutil library */
+#include "vtr_assert.h"
+#include "vtr_log.h"
+
+/* Headers from archopenfpga library */
+#include "read_xml_openfpga_arch.h"
+
+/* Headers from openfpga library */
+#include "mux_graph.h"
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+/* Sizes of the multiplexers, as found in the routing of a fabric */
+static const std::vector<size_t> MUX_SIZES = {4, 8, 16, 32, 64, 128};
+
+/********************************************************************
+ * Find the first multiplexer model of an architecture
+ * Return an invalid id if there is none
+ *******************************************************************/
+static CircuitModelId find_benchmark_mux_model(const Arch& openfpga_arch) {
+  std::vector<CircuitModelId> mux_models =
+    openfpga_arch.circuit_lib.models_by_type(CIRCUIT_MODEL_MUX);
+  if (true == mux_models.empty()) {
+    VTR_LOG_ERROR("The architecture has no multiplexer to benchmark!\n");
+    return CircuitModelId::INVALID();
+  }
+  return mux_models.front();
+}
+
+void add_mux_graph_benchmarks(MicroBenchmarkSuite& suite, const size_t& scale,
+                              const std::string& arch_file) {
+  suite.add_benchmark(
+    "xml_read_openfpga_arch", [arch_file](MicroBenchmarkTimer& timer) {
+      timer.start();
+      Arch openfpga_arch = read_xml_openfpga_arch(arch_file.c_str());
+      timer.stop();
+      return openfpga_arch.circuit_lib.num_models();
+    });
+
+  suite.add_benchmark(
+    "mux_graph_build",
+    [arch_file, scale](MicroBenchmarkTimer& timer) {
+      Arch openfpga_arch = read_xml_openfpga_arch(arch_file.c_str());
+      CircuitModelId mux_model = find_benchmark_mux_model(openfpga_arch);
+      if (false == openfpga_arch.circuit_lib.valid_model_id(mux_model)) {
+        return size_t(0);
+      }
+      size_t num_nodes = 0;
+      timer.start();
+      for (size_t iter = 0; iter < 10 * scale; ++iter) {
+        for (const size_t& mux_size : MUX_SIZES) {
+          MuxGraph mux_graph(openfpga_arch.circuit_lib, mux_model, mux_size);
+          num_nodes += mux_graph.nodes().size();
+        }
+      }
+      timer.stop();
+      return num_nodes;
+    });
+
+  suite.add_benchmark(
+    "mux_graph_decode_memory_bits",
+    [arch_file, scale](MicroBenchmarkTimer& timer) {
+      Arch openfpga_arch = read_xml_openfpga_arch(arch_file.c_str());
+      CircuitModelId mux_model = find_benchmark_mux_model(openfpga_arch);
+      if (false == openfpga_arch.circuit_lib.valid_model_id(mux_model)) {
+        return size_t(0);
+      }
+      std::vector<MuxGraph> mux_graphs;
+      for (const size_t& mux_size : MUX_SIZES) {
+        mux_graphs.emplace_back(openfpga_arch.circuit_lib, mux_model,
+                                mux_size);
+      }
+      size_t num_decodes = 0;
+      size_t num_mem_bits = 0;
+      timer.start();
+      for (size_t iter = 0; iter < 100 * scale; ++iter) {
+        for (const MuxGraph& mux_graph : mux_graphs) {
+          for (size_t input = 0; input < mux_graph.num_inputs(); ++input) {
+            num_mem_bits +=
+              mux_graph.decode_memory_bits(MuxInputId(input), MuxOutputId(0))
+                .size();
+            num_decodes++;
+          }
+        }
+      }
+      timer.stop();
+      VTR_ASSERT(0 < num_mem_bits);
+      return num_decodes;
+    });
+}
+
+} /* end namespace openfpga */
@@ -0,0 +1,48 @@
+/********************************************************************
+ * Micro-benchmarks of the parser of ports, which is called for each
+ * port of the architecture and of the constraint files
+ *******************************************************************/
+#include "benchmark_suites.h"
+
+#include <vector>
+
+/* Headers from vtrutil library */
+#include "vtr_assert.h"
+
+/* Headers from openfpgautil library */
+#include "openfpga_port_parser.h"
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+void add_port_parser_benchmarks(MicroBenchmarkSuite& suite,
+                                const size_t& scale) {
+  const size_t num_ports = 10000 * scale;
+
+  suite.add_benchmark("port_parser", [num_ports](MicroBenchmarkTimer& timer) {
+    /* Mix the ports with a range, with a single pin and without any pin */
+    std::vector<std::string> port_names;
+    port_names.reserve(num_ports);
+    for (size_t iport = 0; iport < num_ports; ++iport) {
+      std::string name = std::string("port_") + std::to_string(iport);
+      if (0 == iport % 3) {
+        name += std::string("[0:") + std::to_string(iport % 64) + "]";
+      } else if (1 == iport % 3) {
+        name += std::string("[") + std::to_string(iport % 64) + "]";
+      }
+      port_names.push_back(name);
+    }
+
+    size_t num_pins = 0;
+    timer.start();
+    for (const std::string& port_name : port_names) {
+      PortParser port_parser(port_name);
+      num_pins += port_parser.port().get_width();
+    }
+    timer.stop();
+    VTR_ASSERT(num_ports <= num_pins);
+    return num_ports;
+  });
+}
+
+} /* end namespace openfpga */
@@ -0,0 +1,33 @@
+#ifndef BENCHMARK_SUITES_H
+#define BENCHMARK_SUITES_H
+
+/********************************************************************
+ * Include header files that are required by function declaration
+ *******************************************************************/
+#include <string>
+
+#include "micro_benchmark.h"
+
+/********************************************************************
+ * Function declaration
+ * The size of the synthetic inputs is multiplied by the scale
+ *******************************************************************/
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+void add_module_manager_benchmarks(MicroBenchmarkSuite& suite,
+                                   const size_t& scale);
+
+void add_bitstream_benchmarks(MicroBenchmarkSuite& suite, const size_t& scale,
+                              const std::string& work_dir);
+
+void add_mux_graph_benchmarks(MicroBenchmarkSuite& suite, const size_t& scale,
+                              const std::string& arch_file);
+
+void add_port_parser_benchmarks(MicroBenchmarkSuite& suite,
+                                const size_t& scale);
+
+} /* end namespace openfpga */
+
+#endif
@@ -0,0 +1,164 @@
+/********************************************************************
+ * Member functions for the micro-benchmark suite
+ *******************************************************************/
+#include "micro_benchmark.h"
+
+#include <algorithm>
+#include <fstream>
+#include <limits>
+
+/* Headers from vtrutil library */
+#include "vtr_assert.h"
+#include "vtr_log.h"
+
+/* Headers from openfpgashell library */
+#include "command_profiler.h"
+
+/* Begin namespace openfpga */
+namespace openfpga {
+
+/************************************************************************
+ * Timer
+ ***********************************************************************/
+MicroBenchmarkTimer::MicroBenchmarkTimer()
+  : elapsed_(0.), running_(false), used_(false) {}
+
+double MicroBenchmarkTimer::elapsed() const { return elapsed_; }
+
+bool MicroBenchmarkTimer::used() const { return used_; }
+
+void MicroBenchmarkTimer::start() {
+  VTR_ASSERT(false == running_);
+  running_ = true;
+  used_ = true;
+  start_time_ = std::chrono::steady_clock::now();
+}
+
+void MicroBenchmarkTimer::stop() {
+  VTR_ASSERT(true == running_);
+  elapsed_ += std::chrono::duration<double>(std::chrono::steady_clock::now() -
+                                            start_time_)
+                .count();
+  running_ = false;
+}
+
+/************************************************************************
+ * Public accessors
+ ***********************************************************************/
+const std::vector<MicroBenchmarkResult>& MicroBenchmarkSuite::results() const {
+  return results_;
+}
+
+/* Time per operation in nanoseconds */
+static double time_per_operation(const MicroBenchmarkResult& result) {
+  if (0 == result.operations) {
+    return 0.;
+  }
+  return result.min_time * 1e9 / double(result.operations);
+}
+
+void MicroBenchmarkSuite::print_report() const {
+  VTR_LOG("Results of micro-benchmarks (best of the repetitions):\n");
+  VTR_LOG("%-40s %12s %12s %12s %12s\n", "Benchmark", "Operations",
+          "Min (ms)", "Mean (ms)", "ns/op");
+  for (const MicroBenchmarkResult& result : results_) {
+    VTR_LOG("%-40s %12lu %12.3f %12.3f %12.1f\n", result.name.c_str(),
+            result.operations, result.min_time * 1e3, result.mean_time * 1e3,
+            time_per_operation(result));
+  }
+  VTR_LOG("Peak RSS %.1f MB\n", double(get_peak_rss_kb()) / 1024.);
+}
+
+int MicroBenchmarkSuite::write_report(const std::string& fname) const {
+  std::ofstream fp(fname, std::ofstream::out | std::ofstream::trunc);
+  if (false == fp.is_open()) {
+    VTR_LOG_ERROR("Fail to open file '%s' to write the benchmark results!\n",
+                  fname.c_str());
+    return 1;
+  }
+
+  const std::string csv_suffix(".csv");
+  bool csv_format = (fname.size() >= csv_suffix.size()) &&
+                    (0 == fname.compare(fname.size() - csv_suffix.size(),
+                                        csv_suffix.size(), csv_suffix));
+  /* Benchmark names are identifiers, which need no escape */
+  if (true == csv_format) {
+    fp << "benchmark,operations,repeats,min_time_s,mean_time_s,max_time_s,"
+          "ns_per_op\n";
+    for (const MicroBenchmarkResult& result : results_) {
+      fp << result.name << "," << result.operations << "," << result.repeats
+         << "," << result.min_time << "," << result.mean_time << ","
+         << result.max_time << "," << time_per_operation(result) << "\n";
+    }
+  } else {
+    fp << "{\n";
+    fp << "  \"peak_rss_kb\": " << get_peak_rss_kb() << ",\n";
+    fp << "  \"benchmarks\": [";
+    for (size_t ires = 0; ires < results_.size(); ++ires) {
+      const MicroBenchmarkResult& result = results_[ires];
+      fp << (0 == ires ? "\n" : ",\n");
+      fp << "    {\"benchmark\": \"" << result.name << "\"";
+      fp << ", \"operations\": " << result.operations;
+      fp << ", \"repeats\": " << result.repeats;
+      fp << ", \"min_time_s\": " << result.min_time;
+      fp << ", \"mean_time_s\": " << result.mean_time;
+      fp << ", \"max_time_s\": " << result.max_time;
+      fp << ", \"ns_per_op\": " << time_per_operation(result) << "}";
+    }
+    fp << "\n  ]\n";
+    fp << "}\n";
+  }
+
+  if (false == fp.good()) {
+    VTR_LOG_ERROR("Fail to write the benchmark results to file '%s'!\n",
+                  fname.c_str());
+    return 1;
+  }
+  return 0;
+}
+
+/************************************************************************
+ * Public mutators
+ ***********************************************************************/
+void MicroBenchmarkSuite::add_benchmark(const std::string& name,
+                                        const benchmark_function& func) {
+  names_.push_back(name);
+  functions_.push_back(func);
+}
+
+void MicroBenchmarkSuite::run(const size_t& repeats,
+                              const std::string& filter) {
+  VTR_ASSERT(0 < repeats);
+  results_.clear();
+  for (size_t ibench = 0; ibench < names_.size(); ++ibench) {
+    if (std::string::npos == names_[ibench].find(filter)) {
+      continue;
+    }
+    VTR_LOG("Run benchmark '%s'...\n", names_[ibench].c_str());
+
+    MicroBenchmarkResult result;
+    result.name = names_[ibench];
+    result.operations = 0;
+    result.repeats = repeats;
+    result.min_time = std::numeric_limits<double>::max();
+    result.mean_time = 0.;
+    result.max_time = 0.;
+    for (size_t irep = 0; irep < repeats; ++irep) {
+      MicroBenchmarkTimer timer;
+      auto start_time = std::chrono::steady_clock::now();
+      result.operations = functions_[ibench](timer);
+      double elapsed = std::chrono::duration<double>(
+                         std::chrono::steady_clock::now() - start_time)
+                         .count();
+      if (true == timer.used()) {
+        elapsed = timer.elapsed();
+      }
+      result.min_time = std::min(result.min_time, elapsed);
+      result.max_time = std::max(result.max_time, elapsed);
+      result.mean_time += elapsed / double(repeats);
+    }
+    results_.push_back(result);
+  }
+}
+
+} /* End namespace openfpga */
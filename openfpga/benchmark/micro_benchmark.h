@@ -0,0 +1,97 @@
+#ifndef MICRO_BENCHMARK_H
+#define MICRO_BENCHMARK_H
+
+/********************************************************************
+ * Include header files required by the data structure definition
+ *******************************************************************/
+#include <chrono>
+#include <functional>
+#include <string>
+#include <vector>
+
+/* Begin namespace openfpga */
+namespace openfpga {
+
+/*********************************************************************
+ * A timer given to each benchmark, which measures only the code between
+ * start() and stop(), so that the preparation of synthetic inputs is not
+ * counted. If a benchmark never starts the timer, the whole benchmark is
+ * measured.
+ ********************************************************************/
+class MicroBenchmarkTimer {
+ public: /* Constructor */
+  MicroBenchmarkTimer();
+
+ public: /* Public accessors */
+  /* Measured time in seconds */
+  double elapsed() const;
+  bool used() const;
+
+ public: /* Public mutators */
+  void start();
+  void stop();
+
+ private: /* Internal data */
+  std::chrono::steady_clock::time_point start_time_;
+  double elapsed_;
+  bool running_;
+  bool used_;
+};
+
+/*********************************************************************
+ * Statistics of a benchmark over its repetitions
+ ********************************************************************/
+struct MicroBenchmarkResult {
+  std::string name;
+  /* Number of operations done by a repetition, e.g., the number of nets
+   * created, which normalizes the time */
+  size_t operations;
+  size_t repeats;
+  /* Wall time of a repetition in seconds */
+  double min_time;
+  double mean_time;
+  double max_time;
+};
+
+/*********************************************************************
+ * A suite of micro-benchmarks, which are run in the order they are added.
+ * Each benchmark returns the number of operations it has done.
+ *
+ * An example of how to use
+ * -----------------------
+ *   suite.add_benchmark("port_parser", [](MicroBenchmarkTimer& timer) {
+ *     timer.start();
+ *     ... parse 1000 ports ...
+ *     timer.stop();
+ *     return 1000;
+ *   });
+ *   suite.run(5, "");
+ *   suite.write_report("results.json");
+ ********************************************************************/
+class MicroBenchmarkSuite {
+ public: /* Types */
+  typedef std::function<size_t(MicroBenchmarkTimer&)> benchmark_function;
+
+ public: /* Public accessors */
+  const std::vector<MicroBenchmarkResult>& results() const;
+  /* Print the results to the log */
+  void print_report() const;
+  /* Write the results to a file. The format is CSV when the file ends with
+   * '.csv', otherwise JSON. Return 0 if successful */
+  int write_report(const std::string& fname) const;
+
+ public: /* Public mutators */
+  void add_benchmark(const std::string& name, const benchmark_function& func);
+  /* Run each benchmark whose name contains the filter, a number of times.
+   * An empty filter runs all the benchmarks */
+  void run(const size_t& repeats, const std::string& filter);
+
+ private: /* Internal data */
+  std::vector<std::string> names_;
+  std::vector<benchmark_function> functions_;
+  std::vector<MicroBenchmarkResult> results_;
+};
+
+} /* End namespace openfpga */
+
+#endif
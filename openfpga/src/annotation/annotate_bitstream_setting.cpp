@@ -27,7 +27,7 @@ namespace openfpga {
  *******************************************************************/
 static int annotate_bitstream_pb_type_setting(
   const BitstreamSetting& bitstream_setting,
-  const DeviceContext& vpr_device_ctx,
+  const PbTypePathIndex& pb_type_path_index,
   VprBitstreamAnnotation& vpr_bitstream_annotation) {
   for (const auto& bitstream_pb_type_setting_id :
        bitstream_setting.pb_type_settings()) {
@@ -43,30 +43,12 @@ static int annotate_bitstream_pb_type_setting(
       bitstream_setting.parent_mode_names(bitstream_pb_type_setting_id);
 
     /* Pb type information are located at the logic_block_types in the device
-     * context of VPR We iterate over the vectors and find the pb_type matches
-     * the parent_pb_type_name
-     */
+     * context of VPR, which are indexed by the full path of each pb_type */
     bool link_success = false;
 
-    for (const t_logical_block_type& lb_type :
-         vpr_device_ctx.logical_block_types) {
-      /* By pass nullptr for pb_type head */
-      if (nullptr == lb_type.pb_type) {
-        continue;
-      }
-      /* Check the name of the top-level pb_type, if it does not match, we can
-       * bypass */
-      if (target_pb_type_names[0] != std::string(lb_type.pb_type->name)) {
-        continue;
-      }
-      /* Match the name in the top-level, we go further to search the pb_type in
-       * the graph */
-      t_pb_type* target_pb_type = try_find_pb_type_with_given_path(
-        lb_type.pb_type, target_pb_type_names, target_pb_mode_names);
-      if (nullptr == target_pb_type) {
-        continue;
-      }
-
+    t_pb_type* target_pb_type = find_pb_type_in_path_index(
+      pb_type_path_index, target_pb_type_names, target_pb_mode_names);
+    if (nullptr != target_pb_type) {
       /* Found one, build annotation */
       if (std::string("eblif") != bitstream_setting.pb_type_bitstream_source(
                                     bitstream_pb_type_setting_id)) {
@@ -134,7 +116,7 @@ static int annotate_bitstream_pb_type_setting(
  *******************************************************************/
 static int annotate_bitstream_interconnect_setting(
   const BitstreamSetting& bitstream_setting,
-  const DeviceContext& vpr_device_ctx,
+  const PbTypePathIndex& pb_type_path_index,
   const VprDeviceAnnotation& vpr_device_annotation,
   VprBitstreamAnnotation& vpr_bitstream_annotation) {
   for (const auto& bitstream_interc_setting_id :
@@ -158,30 +140,12 @@ static int annotate_bitstream_interconnect_setting(
       bitstream_setting.default_path(bitstream_interc_setting_id);
 
     /* Pb type information are located at the logic_block_types in the device
-     * context of VPR We iterate over the vectors and find the pb_type matches
-     * the parent_pb_type_name
-     */
+     * context of VPR, which are indexed by the full path of each pb_type */
     bool link_success = false;
 
-    for (const t_logical_block_type& lb_type :
-         vpr_device_ctx.logical_block_types) {
-      /* By pass nullptr for pb_type head */
-      if (nullptr == lb_type.pb_type) {
-        continue;
-      }
-      /* Check the name of the top-level pb_type, if it does not match, we can
-       * bypass */
-      if (target_pb_type_names[0] != std::string(lb_type.pb_type->name)) {
-        continue;
-      }
-      /* Match the name in the top-level, we go further to search the pb_type in
-       * the graph */
-      t_pb_type* target_pb_type = try_find_pb_type_with_given_path(
-        lb_type.pb_type, target_pb_type_names, target_pb_mode_names);
-      if (nullptr == target_pb_type) {
-        continue;
-      }
-
+    t_pb_type* target_pb_type = find_pb_type_in_path_index(
+      pb_type_path_index, target_pb_type_names, target_pb_mode_names);
+    if (nullptr != target_pb_type) {
       /* Found one, build annotation */
       t_mode* physical_mode =
         vpr_device_annotation.physical_mode(target_pb_type);
@@ -263,14 +227,18 @@ int annotate_bitstream_setting(
   VprBitstreamAnnotation& vpr_bitstream_annotation) {
   int status = CMD_EXEC_SUCCESS;
 
-  status = annotate_bitstream_pb_type_setting(bitstream_setting, vpr_device_ctx,
-                                              vpr_bitstream_annotation);
+  /* Index the pb_types by their full paths, shared by all the settings */
+  PbTypePathIndex pb_type_path_index =
+    build_pb_type_path_index(vpr_device_ctx.logical_block_types);
+
+  status = annotate_bitstream_pb_type_setting(
+    bitstream_setting, pb_type_path_index, vpr_bitstream_annotation);
   if (status == CMD_EXEC_FATAL_ERROR) {
     return status;
   }
 
   status = annotate_bitstream_interconnect_setting(
-    bitstream_setting, vpr_device_ctx, vpr_device_annotation,
+    bitstream_setting, pb_type_path_index, vpr_device_annotation,
     vpr_bitstream_annotation);
 
   return status;
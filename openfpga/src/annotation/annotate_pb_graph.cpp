@@ -5,6 +5,8 @@
 /* Headers from vtrutil library */
 #include "annotate_pb_graph.h"
 
+#include <map>
+
 #include "check_pb_graph_annotation.h"
 #include "pb_graph_utils.h"
 #include "pb_type_utils.h"
@@ -336,63 +338,97 @@ static void annotate_primitive_pb_graph_node_unique_index(
 }
 
 /********************************************************************
- * Evaluate if the two pb_graph pins are matched by
- *  - pb_type port annotation
- *  - LSB/MSB and pin offset
+ * Pins of a port of a physical pb_graph_node
+ * The rank is the sequence of the port when the pins of the pb_graph_node
+ * are visited in the order of input, output and clock ports
  *******************************************************************/
-static bool try_match_pb_graph_pin(
-  t_pb_graph_pin* operating_pb_graph_pin, t_pb_graph_pin* physical_pb_graph_pin,
-  const VprDeviceAnnotation& vpr_device_annotation) {
-  /* If the parent ports of the two pins are not paired, fail */
-  for (t_port* candidate_port :
-       vpr_device_annotation.physical_pb_port(operating_pb_graph_pin->port)) {
-    if (physical_pb_graph_pin->port != candidate_port) {
-      /* Not the one we want, try the next candidate */
-      continue;
+struct PhysicalPbGraphPortPins {
+  t_pb_graph_pin* pins;
+  int num_pins;
+  size_t rank;
+};
+
+/********************************************************************
+ * Build a fast look-up from the ports of a physical pb_graph_node
+ * to their pins, so that a pin can be found without visiting all the
+ * pins of the physical pb_graph_node
+ *******************************************************************/
+static std::map<t_port*, PhysicalPbGraphPortPins>
+build_physical_pb_graph_node_port_pins(
+  t_pb_graph_node* physical_pb_graph_node) {
+  std::map<t_port*, PhysicalPbGraphPortPins> port_pins;
+  size_t rank = 0;
+  for (int iport = 0; iport < physical_pb_graph_node->num_input_ports;
+       ++iport) {
+    if (0 < physical_pb_graph_node->num_input_pins[iport]) {
+      port_pins[physical_pb_graph_node->input_pins[iport][0].port] = {
+        physical_pb_graph_node->input_pins[iport],
+        physical_pb_graph_node->num_input_pins[iport], rank};
     }
-    /* Check the pin number of physical pb_graph_pin matches the pin number of
-     * operating pb_graph_pin plus a rotation offset with an initial offset,
-     * which is to align the lsb between operating and physical ports
-     *
-     * For example:
-     *   We can align the operating_port[32] to physical_port[0] with an initial
-     * offset which is -32
-     *
-     *                                              operating port physical port
-     *                      LSB  port_range.lsb()    pin_number pin_number MSB
-     *                                 |                  | init_offset   |
-     *    Operating port     |         |                  +------         + | |
-     * |<----acc_offset--->| Physical port      |         + + +
-     *
-     * Note:
-     *   - accumulated offset is NOT the pin rotate offset specified by users
-     *     It is an aggregation of the offset during pin pairing
-     *     Each time, we manage to pair two pins, the accumulated offset will be
-     * incremented by the pin rotate offset value The accumulated offset will be
-     * reset to 0 when it exceeds the msb() of the physical port
-     */
-    int acc_offset = vpr_device_annotation.physical_pb_pin_offset(
-                       operating_pb_graph_pin->port, candidate_port) +
-                     vpr_device_annotation.physical_pb_port_offset(
-                       operating_pb_graph_pin->port, candidate_port);
-    int init_offset = vpr_device_annotation.physical_pb_pin_initial_offset(
-      operating_pb_graph_pin->port, candidate_port);
-    const BasicPort& physical_port_range =
-      vpr_device_annotation.physical_pb_port_range(operating_pb_graph_pin->port,
-                                                   candidate_port);
-    if (physical_pb_graph_pin->pin_number !=
-        operating_pb_graph_pin->pin_number +
-          (int)physical_port_range.get_lsb() + init_offset + acc_offset) {
-      /* Not the one we want, try the next candidate */
-      continue;
+    rank++;
+  }
+  for (int iport = 0; iport < physical_pb_graph_node->num_output_ports;
+       ++iport) {
+    if (0 < physical_pb_graph_node->num_output_pins[iport]) {
+      port_pins[physical_pb_graph_node->output_pins[iport][0].port] = {
+        physical_pb_graph_node->output_pins[iport],
+        physical_pb_graph_node->num_output_pins[iport], rank};
     }
-
-    /* Reach here, it means all the requirements have been met */
-    return true;
+    rank++;
+  }
+  for (int iport = 0; iport < physical_pb_graph_node->num_clock_ports;
+       ++iport) {
+    if (0 < physical_pb_graph_node->num_clock_pins[iport]) {
+      port_pins[physical_pb_graph_node->clock_pins[iport][0].port] = {
+        physical_pb_graph_node->clock_pins[iport],
+        physical_pb_graph_node->num_clock_pins[iport], rank};
+    }
+    rank++;
   }
+  return port_pins;
+}
 
-  /* If we reach here, we failed */
-  return false;
+/********************************************************************
+ * Find the pin number of the physical pb_graph_pin which matches an
+ * operating pb_graph_pin through a candidate physical port, by
+ *  - pb_type port annotation
+ *  - LSB/MSB and pin offset
+ *******************************************************************/
+static int find_physical_pb_graph_pin_number(
+  t_pb_graph_pin* operating_pb_graph_pin, t_port* candidate_port,
+  const VprDeviceAnnotation& vpr_device_annotation) {
+  /* The pin number of physical pb_graph_pin matches the pin number of
+   * operating pb_graph_pin plus a rotation offset with an initial offset,
+   * which is to align the lsb between operating and physical ports
+   *
+   * For example:
+   *   We can align the operating_port[32] to physical_port[0] with an initial
+   * offset which is -32
+   *
+   *                                              operating port physical port
+   *                      LSB  port_range.lsb()    pin_number pin_number MSB
+   *                                 |                  | init_offset   |
+   *    Operating port     |         |                  +------         + | |
+   * |<----acc_offset--->| Physical port      |         + + +
+   *
+   * Note:
+   *   - accumulated offset is NOT the pin rotate offset specified by users
+   *     It is an aggregation of the offset during pin pairing
+   *     Each time, we manage to pair two pins, the accumulated offset will be
+   * incremented by the pin rotate offset value The accumulated offset will be
+   * reset to 0 when it exceeds the msb() of the physical port
+   */
+  int acc_offset = vpr_device_annotation.physical_pb_pin_offset(
+                     operating_pb_graph_pin->port, candidate_port) +
+                   vpr_device_annotation.physical_pb_port_offset(
+                     operating_pb_graph_pin->port, candidate_port);
+  int init_offset = vpr_device_annotation.physical_pb_pin_initial_offset(
+    operating_pb_graph_pin->port, candidate_port);
+  const BasicPort& physical_port_range =
+    vpr_device_annotation.physical_pb_port_range(operating_pb_graph_pin->port,
+                                                 candidate_port);
+  return operating_pb_graph_pin->pin_number +
+         (int)physical_port_range.get_lsb() + init_offset + acc_offset;
 }
 
 /********************************************************************
@@ -417,94 +453,58 @@ static void print_success_bind_pb_graph_pin(
  * Bind a pb_graph_pin from an operating pb_graph_node to
  * a pb_graph_pin from a physical pb_graph_node
  * - the name matching rules are already defined in the vpr_device_annotation
+ * - only the candidate physical ports are visited through the fast look-up.
+ *   When several candidates match, the pin which comes first in the
+ *   sequence of input, output and clock ports is selected
  *******************************************************************/
 static void annotate_physical_pb_graph_pin(
   t_pb_graph_pin* operating_pb_graph_pin,
   t_pb_graph_node* physical_pb_graph_node,
+  const std::map<t_port*, PhysicalPbGraphPortPins>& physical_port_pins,
   VprDeviceAnnotation& vpr_device_annotation, const bool& verbose_output) {
-  /* Iterate over every port and pin of the operating pb_graph_node
-   * and find the physical pins
-   */
-  for (int iport = 0; iport < physical_pb_graph_node->num_input_ports;
-       ++iport) {
-    for (int ipin = 0; ipin < physical_pb_graph_node->num_input_pins[iport];
-         ++ipin) {
-      if (false == try_match_pb_graph_pin(
-                     operating_pb_graph_pin,
-                     &(physical_pb_graph_node->input_pins[iport][ipin]),
-                     vpr_device_annotation)) {
-        continue;
-      }
-      /* Reach here, it means the pins are matched by the annotation
-       * requirements We can pair the pin and return
-       */
-      vpr_device_annotation.add_physical_pb_graph_pin(
-        operating_pb_graph_pin,
-        &(physical_pb_graph_node->input_pins[iport][ipin]));
-      if (true == verbose_output) {
-        print_success_bind_pb_graph_pin(
-          operating_pb_graph_pin,
-          vpr_device_annotation.physical_pb_graph_pin(operating_pb_graph_pin));
-      }
-      return;
+  t_pb_graph_pin* physical_pb_graph_pin = nullptr;
+  size_t physical_pin_rank = 0;
+  for (t_port* candidate_port :
+       vpr_device_annotation.physical_pb_port(operating_pb_graph_pin->port)) {
+    auto port_result = physical_port_pins.find(candidate_port);
+    if (port_result == physical_port_pins.end()) {
+      /* Not the one we want, try the next candidate */
+      continue;
     }
-  }
-
-  for (int iport = 0; iport < physical_pb_graph_node->num_output_ports;
-       ++iport) {
-    for (int ipin = 0; ipin < physical_pb_graph_node->num_output_pins[iport];
-         ++ipin) {
-      if (false == try_match_pb_graph_pin(
-                     operating_pb_graph_pin,
-                     &(physical_pb_graph_node->output_pins[iport][ipin]),
-                     vpr_device_annotation)) {
-        continue;
-      }
-      /* Reach here, it means the pins are matched by the annotation
-       * requirements We can pair the pin and return
-       */
-      vpr_device_annotation.add_physical_pb_graph_pin(
-        operating_pb_graph_pin,
-        &(physical_pb_graph_node->output_pins[iport][ipin]));
-      if (true == verbose_output) {
-        print_success_bind_pb_graph_pin(
-          operating_pb_graph_pin,
-          vpr_device_annotation.physical_pb_graph_pin(operating_pb_graph_pin));
-      }
-      return;
+    const PhysicalPbGraphPortPins& port_pins = port_result->second;
+    if ((nullptr != physical_pb_graph_pin) &&
+        (physical_pin_rank <= port_pins.rank)) {
+      continue;
+    }
+    int pin_number = find_physical_pb_graph_pin_number(
+      operating_pb_graph_pin, candidate_port, vpr_device_annotation);
+    /* Pins are stored in the sequence of pin numbers */
+    if ((0 > pin_number) || (port_pins.num_pins <= pin_number)) {
+      continue;
     }
+    VTR_ASSERT(pin_number == port_pins.pins[pin_number].pin_number);
+    physical_pb_graph_pin = &(port_pins.pins[pin_number]);
+    physical_pin_rank = port_pins.rank;
   }
 
-  for (int iport = 0; iport < physical_pb_graph_node->num_clock_ports;
-       ++iport) {
-    for (int ipin = 0; ipin < physical_pb_graph_node->num_clock_pins[iport];
-         ++ipin) {
-      if (false == try_match_pb_graph_pin(
-                     operating_pb_graph_pin,
-                     &(physical_pb_graph_node->clock_pins[iport][ipin]),
-                     vpr_device_annotation)) {
-        continue;
-      }
-      /* Reach here, it means the pins are matched by the annotation
-       * requirements We can pair the pin and return
-       */
-      vpr_device_annotation.add_physical_pb_graph_pin(
-        operating_pb_graph_pin,
-        &(physical_pb_graph_node->clock_pins[iport][ipin]));
-      if (true == verbose_output) {
-        print_success_bind_pb_graph_pin(
-          operating_pb_graph_pin,
-          vpr_device_annotation.physical_pb_graph_pin(operating_pb_graph_pin));
-      }
-      return;
-    }
+  if (nullptr == physical_pb_graph_pin) {
+    /* If we reach here, it means that pin pairing fails, error out! */
+    VTR_LOG_ERROR(
+      "Fail to match a physical pin for '%s' from pb_graph_node '%s'!\n",
+      operating_pb_graph_pin->to_string().c_str(),
+      physical_pb_graph_node->hierarchical_type_name().c_str());
+    return;
   }
 
-  /* If we reach here, it means that pin pairing fails, error out! */
-  VTR_LOG_ERROR(
-    "Fail to match a physical pin for '%s' from pb_graph_node '%s'!\n",
-    operating_pb_graph_pin->to_string().c_str(),
-    physical_pb_graph_node->hierarchical_type_name().c_str());
+  /* Reach here, it means the pins are matched by the annotation
+   * requirements We can pair the pin and return
+   */
+  vpr_device_annotation.add_physical_pb_graph_pin(operating_pb_graph_pin,
+                                                  physical_pb_graph_pin);
+  if (true == verbose_output) {
+    print_success_bind_pb_graph_pin(operating_pb_graph_pin,
+                                    physical_pb_graph_pin);
+  }
 }
 
 /********************************************************************
@@ -517,6 +517,9 @@ static void annotate_physical_pb_graph_node_pins(
   t_pb_graph_node* operating_pb_graph_node,
   t_pb_graph_node* physical_pb_graph_node,
   VprDeviceAnnotation& vpr_device_annotation, const bool& verbose_output) {
+  std::map<t_port*, PhysicalPbGraphPortPins> physical_port_pins =
+    build_physical_pb_graph_node_port_pins(physical_pb_graph_node);
+
   /* Iterate over every port and pin of the operating pb_graph_node
    * and find the physical pins
    */
@@ -526,7 +529,8 @@ static void annotate_physical_pb_graph_node_pins(
          ++ipin) {
       annotate_physical_pb_graph_pin(
         &(operating_pb_graph_node->input_pins[iport][ipin]),
-        physical_pb_graph_node, vpr_device_annotation, verbose_output);
+        physical_pb_graph_node, physical_port_pins, vpr_device_annotation,
+        verbose_output);
     }
     /* Finish a port, accumulate the port-level offset affiliated to the port */
     if (0 == operating_pb_graph_node->num_input_pins[iport]) {
@@ -547,7 +551,8 @@ static void annotate_physical_pb_graph_node_pins(
          ++ipin) {
       annotate_physical_pb_graph_pin(
         &(operating_pb_graph_node->output_pins[iport][ipin]),
-        physical_pb_graph_node, vpr_device_annotation, verbose_output);
+        physical_pb_graph_node, physical_port_pins, vpr_device_annotation,
+        verbose_output);
     }
     /* Finish a port, accumulate the port-level offset affiliated to the port */
     if (0 == operating_pb_graph_node->num_output_pins[iport]) {
@@ -568,7 +573,8 @@ static void annotate_physical_pb_graph_node_pins(
          ++ipin) {
       annotate_physical_pb_graph_pin(
         &(operating_pb_graph_node->clock_pins[iport][ipin]),
-        physical_pb_graph_node, vpr_device_annotation, verbose_output);
+        physical_pb_graph_node, physical_port_pins, vpr_device_annotation,
+        verbose_output);
     }
     /* Finish a port, accumulate the port-level offset affiliated to the port */
     if (0 == operating_pb_graph_node->num_clock_pins[iport]) {
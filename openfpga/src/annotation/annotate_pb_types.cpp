@@ -22,7 +22,7 @@ namespace openfpga {
  * in OpenFPGA architecture XML
  *******************************************************************/
 static void build_vpr_physical_pb_mode_explicit_annotation(
-  const DeviceContext& vpr_device_ctx, const Arch& openfpga_arch,
+  const PbTypePathIndex& pb_type_path_index, const Arch& openfpga_arch,
   VprDeviceAnnotation& vpr_device_annotation, const bool& verbose_output) {
   /* Walk through the pb_type annotation stored in the openfpga arch */
   for (const PbTypeAnnotation& pb_type_annotation :
@@ -60,52 +60,26 @@ static void build_vpr_physical_pb_mode_explicit_annotation(
     VTR_ASSERT_SAFE(0 < target_pb_type_names.size());
 
     /* Pb type information are located at the logic_block_types in the device
-     * context of VPR We iterate over the vectors and find the pb_type matches
-     * the parent_pb_type_name
-     */
-    bool link_success = false;
-
-    for (const t_logical_block_type& lb_type :
-         vpr_device_ctx.logical_block_types) {
-      /* By pass nullptr for pb_type head */
-      if (nullptr == lb_type.pb_type) {
-        continue;
-      }
-      /* Check the name of the top-level pb_type, if it does not match, we can
-       * bypass */
-      if (target_pb_type_names[0] != std::string(lb_type.pb_type->name)) {
-        continue;
-      }
-      /* Match the name in the top-level, we go further to search the pb_type in
-       * the graph */
-      t_pb_type* target_pb_type = try_find_pb_type_with_given_path(
-        lb_type.pb_type, target_pb_type_names, target_pb_mode_names);
-      if (nullptr == target_pb_type) {
-        continue;
-      }
-
-      /* Found, we update the annotation by assigning the physical mode */
-      t_mode* physical_mode = find_pb_type_mode(
-        target_pb_type, pb_type_annotation.physical_mode_name().c_str());
-      vpr_device_annotation.add_pb_type_physical_mode(target_pb_type,
-                                                      physical_mode);
-
-      /* Give a message */
-      VTR_LOGV(verbose_output,
-               "Annotate pb_type '%s' with physical mode '%s'\n",
-               target_pb_type->name, physical_mode->name);
-
-      link_success = true;
-      break;
-    }
-
-    if (false == link_success) {
+     * context of VPR, which are indexed by the full path of each pb_type */
+    t_pb_type* target_pb_type = find_pb_type_in_path_index(
+      pb_type_path_index, target_pb_type_names, target_pb_mode_names);
+    if (nullptr == target_pb_type) {
       /* Not found, error out! */
       VTR_LOG_ERROR(
         "Unable to find the pb_type '%s' in VPR architecture definition!\n",
         target_pb_type_names.back().c_str());
       return;
     }
+
+    /* Found, we update the annotation by assigning the physical mode */
+    t_mode* physical_mode = find_pb_type_mode(
+      target_pb_type, pb_type_annotation.physical_mode_name().c_str());
+    vpr_device_annotation.add_pb_type_physical_mode(target_pb_type,
+                                                    physical_mode);
+
+    /* Give a message */
+    VTR_LOGV(verbose_output, "Annotate pb_type '%s' with physical mode '%s'\n",
+             target_pb_type->name, physical_mode->name);
   }
 }
 
@@ -296,7 +270,7 @@ static bool pair_operating_and_physical_pb_types(
  *   annotation is completed
  *******************************************************************/
 static void build_vpr_physical_pb_type_explicit_annotation(
-  const DeviceContext& vpr_device_ctx, const Arch& openfpga_arch,
+  const PbTypePathIndex& pb_type_path_index, const Arch& openfpga_arch,
   VprDeviceAnnotation& vpr_device_annotation, const bool& verbose_output) {
   /* Walk through the pb_type annotation stored in the openfpga arch */
   for (const PbTypeAnnotation& pb_type_annotation :
@@ -337,36 +311,18 @@ static void build_vpr_physical_pb_type_explicit_annotation(
     VTR_ASSERT_SAFE(0 < target_phy_pb_type_names.size());
 
     /* Pb type information are located at the logic_block_types in the device
-     * context of VPR We iterate over the vectors and find the pb_type matches
-     * the parent_pb_type_name
+     * context of VPR, which are indexed by the full path of each pb_type.
+     * The operating and physical pb_types must be under the same top-level
+     * pb_type
      */
     bool link_success = false;
 
-    for (const t_logical_block_type& lb_type :
-         vpr_device_ctx.logical_block_types) {
-      /* By pass nullptr for pb_type head */
-      if (nullptr == lb_type.pb_type) {
-        continue;
-      }
-      /* Check the name of the top-level pb_type, if it does not match, we can
-       * bypass */
-      if (target_op_pb_type_names[0] != std::string(lb_type.pb_type->name)) {
-        continue;
-      }
-      /* Match the name in the top-level, we go further to search the operating
-       * as well as physical pb_types in the graph */
-      t_pb_type* target_op_pb_type = try_find_pb_type_with_given_path(
-        lb_type.pb_type, target_op_pb_type_names, target_op_pb_mode_names);
-      if (nullptr == target_op_pb_type) {
-        continue;
-      }
-
-      t_pb_type* target_phy_pb_type = try_find_pb_type_with_given_path(
-        lb_type.pb_type, target_phy_pb_type_names, target_phy_pb_mode_names);
-      if (nullptr == target_phy_pb_type) {
-        continue;
-      }
-
+    t_pb_type* target_op_pb_type = find_pb_type_in_path_index(
+      pb_type_path_index, target_op_pb_type_names, target_op_pb_mode_names);
+    t_pb_type* target_phy_pb_type = find_pb_type_in_path_index(
+      pb_type_path_index, target_phy_pb_type_names, target_phy_pb_mode_names);
+    if ((nullptr != target_op_pb_type) && (nullptr != target_phy_pb_type) &&
+        (target_op_pb_type_names[0] == target_phy_pb_type_names[0])) {
       /* Both operating and physical pb_type have been found,
        * we update the annotation by assigning the physical mode
        */
@@ -380,7 +336,6 @@ static void build_vpr_physical_pb_type_explicit_annotation(
           target_op_pb_type->name, target_phy_pb_type->name);
 
         link_success = true;
-        break;
       }
     }
 
@@ -695,7 +650,7 @@ static bool link_physical_pb_interconnect_to_circuit_model(
  *   physical pb_type annotation is completed
  *******************************************************************/
 static void link_vpr_pb_type_to_circuit_model_explicit_annotation(
-  const DeviceContext& vpr_device_ctx, const Arch& openfpga_arch,
+  const PbTypePathIndex& pb_type_path_index, const Arch& openfpga_arch,
   VprDeviceAnnotation& vpr_device_annotation, const bool& verbose_output) {
   /* Walk through the pb_type annotation stored in the openfpga arch */
   for (const PbTypeAnnotation& pb_type_annotation :
@@ -728,48 +683,29 @@ static void link_vpr_pb_type_to_circuit_model_explicit_annotation(
     VTR_ASSERT_SAFE(0 < target_phy_pb_type_names.size());
 
     /* Pb type information are located at the logic_block_types in the device
-     * context of VPR We iterate over the vectors and find the pb_type matches
-     * the parent_pb_type_name
-     */
+     * context of VPR, which are indexed by the full path of each pb_type */
     bool link_success = false;
 
-    for (const t_logical_block_type& lb_type :
-         vpr_device_ctx.logical_block_types) {
-      /* By pass nullptr for pb_type head */
-      if (nullptr == lb_type.pb_type) {
-        continue;
-      }
-      /* Check the name of the top-level pb_type, if it does not match, we can
-       * bypass */
-      if (target_phy_pb_type_names[0] != std::string(lb_type.pb_type->name)) {
-        continue;
-      }
-      /* Match the name in the top-level, we go further to search the operating
-       * as well as physical pb_types in the graph */
-      t_pb_type* target_phy_pb_type = try_find_pb_type_with_given_path(
-        lb_type.pb_type, target_phy_pb_type_names, target_phy_pb_mode_names);
-      if (nullptr == target_phy_pb_type) {
-        continue;
-      }
+    t_pb_type* target_phy_pb_type = find_pb_type_in_path_index(
+      pb_type_path_index, target_phy_pb_type_names, target_phy_pb_mode_names);
 
-      /* Only try to bind pb_type to circuit model when it is defined by users
-       */
-      if (true == link_physical_pb_type_to_circuit_model(
-                    target_phy_pb_type, openfpga_arch.circuit_lib,
-                    pb_type_annotation, vpr_device_annotation,
-                    verbose_output)) {
-        /* Give a message */
-        VTR_LOGV(verbose_output,
-                 "Bind physical pb_type '%s' to its circuit model '%s'\n",
-                 target_phy_pb_type->name,
-                 openfpga_arch.circuit_lib
-                   .model_name(vpr_device_annotation.pb_type_circuit_model(
-                     target_phy_pb_type))
-                   .c_str());
+    /* Only try to bind pb_type to circuit model when it is defined by users
+     */
+    if ((nullptr != target_phy_pb_type) &&
+        (true == link_physical_pb_type_to_circuit_model(
+                   target_phy_pb_type, openfpga_arch.circuit_lib,
+                   pb_type_annotation, vpr_device_annotation,
+                   verbose_output))) {
+      /* Give a message */
+      VTR_LOGV(verbose_output,
+               "Bind physical pb_type '%s' to its circuit model '%s'\n",
+               target_phy_pb_type->name,
+               openfpga_arch.circuit_lib
+                 .model_name(vpr_device_annotation.pb_type_circuit_model(
+                   target_phy_pb_type))
+                 .c_str());
 
-        link_success = true;
-        break;
-      }
+      link_success = true;
     }
 
     if (false == link_success) {
@@ -793,7 +729,7 @@ static void link_vpr_pb_type_to_circuit_model_explicit_annotation(
  *   physical pb_type annotation is completed
  *******************************************************************/
 static void link_vpr_pb_interconnect_to_circuit_model_explicit_annotation(
-  const DeviceContext& vpr_device_ctx, const Arch& openfpga_arch,
+  const PbTypePathIndex& pb_type_path_index, const Arch& openfpga_arch,
   VprDeviceAnnotation& vpr_device_annotation, const bool& verbose_output) {
   /* Walk through the pb_type annotation stored in the openfpga arch */
   for (const PbTypeAnnotation& pb_type_annotation :
@@ -826,45 +762,29 @@ static void link_vpr_pb_interconnect_to_circuit_model_explicit_annotation(
     VTR_ASSERT_SAFE(0 < target_phy_pb_type_names.size());
 
     /* Pb type information are located at the logic_block_types in the device
-     * context of VPR We iterate over the vectors and find the pb_type matches
-     * the parent_pb_type_name
-     */
+     * context of VPR, which are indexed by the full path of each pb_type */
     bool link_success = true;
 
-    for (const t_logical_block_type& lb_type :
-         vpr_device_ctx.logical_block_types) {
-      /* By pass nullptr for pb_type head */
-      if (nullptr == lb_type.pb_type) {
-        continue;
-      }
-      /* Check the name of the top-level pb_type, if it does not match, we can
-       * bypass */
-      if (target_phy_pb_type_names[0] != std::string(lb_type.pb_type->name)) {
-        continue;
-      }
-      /* Match the name in the top-level, we go further to search the operating
-       * as well as physical pb_types in the graph */
-      t_pb_type* target_phy_pb_type = try_find_pb_type_with_given_path(
-        lb_type.pb_type, target_phy_pb_type_names, target_phy_pb_mode_names);
-      if (nullptr == target_phy_pb_type) {
-        continue;
-      }
+    t_pb_type* target_phy_pb_type = find_pb_type_in_path_index(
+      pb_type_path_index, target_phy_pb_type_names, target_phy_pb_mode_names);
+    if (nullptr == target_phy_pb_type) {
+      continue;
+    }
 
-      /* Only try to bind interconnect to circuit model when it is defined by
-       * users */
-      for (const std::string& interc_name :
-           pb_type_annotation.interconnect_names()) {
-        if (false == link_physical_pb_interconnect_to_circuit_model(
-                       target_phy_pb_type, interc_name,
-                       openfpga_arch.circuit_lib, pb_type_annotation,
-                       vpr_device_annotation, verbose_output)) {
-          VTR_LOG_ERROR(
-            "Unable to bind pb_type '%s' interconnect '%s' to circuit model "
-            "'%s'!\n",
-            target_phy_pb_type_names.back().c_str(), interc_name.c_str(),
-            pb_type_annotation.circuit_model_name().c_str());
-          link_success = false;
-        }
+    /* Only try to bind interconnect to circuit model when it is defined by
+     * users */
+    for (const std::string& interc_name :
+         pb_type_annotation.interconnect_names()) {
+      if (false == link_physical_pb_interconnect_to_circuit_model(
+                     target_phy_pb_type, interc_name, openfpga_arch.circuit_lib,
+                     pb_type_annotation, vpr_device_annotation,
+                     verbose_output)) {
+        VTR_LOG_ERROR(
+          "Unable to bind pb_type '%s' interconnect '%s' to circuit model "
+          "'%s'!\n",
+          target_phy_pb_type_names.back().c_str(), interc_name.c_str(),
+          pb_type_annotation.circuit_model_name().c_str());
+        link_success = false;
       }
     }
 
@@ -1007,7 +927,7 @@ static bool link_primitive_pb_type_to_mode_bits(
  *   the physical pb_type circuit model annotation is completed
  *******************************************************************/
 static void link_vpr_pb_type_to_mode_bits_explicit_annotation(
-  const DeviceContext& vpr_device_ctx, const Arch& openfpga_arch,
+  const PbTypePathIndex& pb_type_path_index, const Arch& openfpga_arch,
   VprDeviceAnnotation& vpr_device_annotation, const bool& verbose_output) {
   /* Walk through the pb_type annotation stored in the openfpga arch */
   for (const PbTypeAnnotation& pb_type_annotation :
@@ -1046,43 +966,24 @@ static void link_vpr_pb_type_to_mode_bits_explicit_annotation(
     VTR_ASSERT_SAFE(0 < target_pb_type_names.size());
 
     /* Pb type information are located at the logic_block_types in the device
-     * context of VPR We iterate over the vectors and find the pb_type matches
-     * the parent_pb_type_name
-     */
+     * context of VPR, which are indexed by the full path of each pb_type */
     bool link_success = false;
 
-    for (const t_logical_block_type& lb_type :
-         vpr_device_ctx.logical_block_types) {
-      /* By pass nullptr for pb_type head */
-      if (nullptr == lb_type.pb_type) {
-        continue;
-      }
-      /* Check the name of the top-level pb_type, if it does not match, we can
-       * bypass */
-      if (target_pb_type_names[0] != std::string(lb_type.pb_type->name)) {
-        continue;
-      }
-      /* Match the name in the top-level, we go further to search the operating
-       * as well as physical pb_types in the graph */
-      t_pb_type* target_pb_type = try_find_pb_type_with_given_path(
-        lb_type.pb_type, target_pb_type_names, target_pb_mode_names);
-      if (nullptr == target_pb_type) {
-        continue;
-      }
+    t_pb_type* target_pb_type = find_pb_type_in_path_index(
+      pb_type_path_index, target_pb_type_names, target_pb_mode_names);
 
-      /* Only try to bind pb_type to circuit model when it is defined by users
-       */
-      if (true == link_primitive_pb_type_to_mode_bits(target_pb_type,
-                                                      pb_type_annotation,
-                                                      vpr_device_annotation)) {
-        /* Give a message */
-        VTR_LOGV(verbose_output,
-                 "Bind physical pb_type '%s' to mode selection bits '%s'\n",
-                 target_pb_type->name, mode_bits_str.c_str());
+    /* Only try to bind pb_type to circuit model when it is defined by users
+     */
+    if ((nullptr != target_pb_type) &&
+        (true == link_primitive_pb_type_to_mode_bits(target_pb_type,
+                                                     pb_type_annotation,
+                                                     vpr_device_annotation))) {
+      /* Give a message */
+      VTR_LOGV(verbose_output,
+               "Bind physical pb_type '%s' to mode selection bits '%s'\n",
+               target_pb_type->name, mode_bits_str.c_str());
 
-        link_success = true;
-        break;
-      }
+      link_success = true;
     }
 
     if (false == link_success) {
@@ -1104,12 +1005,17 @@ void annotate_pb_types(const DeviceContext& vpr_device_ctx,
                        const Arch& openfpga_arch,
                        VprDeviceAnnotation& vpr_device_annotation,
                        const bool& verbose_output) {
+  /* Index the pb_types by their full paths, so that each annotation is
+   * resolved by a look-up rather than a walk through the pb_type graphs */
+  PbTypePathIndex pb_type_path_index =
+    build_pb_type_path_index(vpr_device_ctx.logical_block_types);
+
   /* Annotate physical mode to pb_type in the VPR pb_type graph */
   VTR_LOG("\n");
   VTR_LOG("Building annotation for physical modes in pb_type...");
   VTR_LOGV(verbose_output, "\n");
   build_vpr_physical_pb_mode_explicit_annotation(
-    vpr_device_ctx, openfpga_arch, vpr_device_annotation, verbose_output);
+    pb_type_path_index, openfpga_arch, vpr_device_annotation, verbose_output);
 
   build_vpr_physical_pb_mode_implicit_annotation(
     vpr_device_ctx, vpr_device_annotation, verbose_output);
@@ -1141,7 +1047,7 @@ void annotate_pb_types(const DeviceContext& vpr_device_ctx,
   VTR_LOG("Building annotation between operating and physical pb_types...");
   VTR_LOGV(verbose_output, "\n");
   build_vpr_physical_pb_type_explicit_annotation(
-    vpr_device_ctx, openfpga_arch, vpr_device_annotation, verbose_output);
+    pb_type_path_index, openfpga_arch, vpr_device_annotation, verbose_output);
 
   build_vpr_physical_pb_type_implicit_annotation(
     vpr_device_ctx, vpr_device_annotation, verbose_output);
@@ -1160,10 +1066,10 @@ void annotate_pb_types(const DeviceContext& vpr_device_ctx,
     "Building annotation between physical pb_types and circuit models...");
   VTR_LOGV(verbose_output, "\n");
   link_vpr_pb_type_to_circuit_model_explicit_annotation(
-    vpr_device_ctx, openfpga_arch, vpr_device_annotation, verbose_output);
+    pb_type_path_index, openfpga_arch, vpr_device_annotation, verbose_output);
 
   link_vpr_pb_interconnect_to_circuit_model_explicit_annotation(
-    vpr_device_ctx, openfpga_arch, vpr_device_annotation, verbose_output);
+    pb_type_path_index, openfpga_arch, vpr_device_annotation, verbose_output);
 
   link_vpr_pb_interconnect_to_circuit_model_implicit_annotation(
     vpr_device_ctx, openfpga_arch.circuit_lib, vpr_device_annotation,
@@ -1180,7 +1086,7 @@ void annotate_pb_types(const DeviceContext& vpr_device_ctx,
     "Building annotation between physical pb_types and mode selection bits...");
   VTR_LOGV(verbose_output, "\n");
   link_vpr_pb_type_to_mode_bits_explicit_annotation(
-    vpr_device_ctx, openfpga_arch, vpr_device_annotation, verbose_output);
+    pb_type_path_index, openfpga_arch, vpr_device_annotation, verbose_output);
   VTR_LOG("Done\n");
 
   check_vpr_pb_type_mode_bits_annotation(
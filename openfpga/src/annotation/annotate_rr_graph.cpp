@@ -8,6 +8,8 @@
 #include "vtr_time.h"
 
 /* Headers from openfpgautil library */
+#include "openfpga_parallel.h"
+#include "openfpga_progress.h"
 #include "openfpga_side_manager.h"
 
 /* Headers from vpr library */
@@ -408,6 +410,7 @@ static RRGSB build_rr_gsb(const DeviceContext& vpr_device_ctx,
 void annotate_device_rr_gsb(const DeviceContext& vpr_device_ctx,
                             DeviceRRGSB& device_rr_gsb,
                             const bool& include_clock,
+                            const size_t& num_threads,
                             const bool& verbose_output) {
   vtr::ScopedStartFinishTimer timer(
     "Build General Switch Block(GSB) annotation on top of routing resource "
@@ -422,11 +425,19 @@ void annotate_device_rr_gsb(const DeviceContext& vpr_device_ctx,
   VTR_LOGV(verbose_output, "Start annotation GSB up to [%lu][%lu]\n",
            gsb_range.x(), gsb_range.y());
 
+  /* Progress is printed only when running in a single thread, otherwise the
+   * outputs of threads interleave */
+  bool show_progress = (1 == find_num_threads(num_threads));
   size_t gsb_cnt = 0;
   size_t layer = 0;
-  /* For each switch block, determine the size of array */
-  for (size_t ix = 0; ix < gsb_range.x(); ++ix) {
-    for (size_t iy = 0; iy < gsb_range.y(); ++iy) {
+  /* For each switch block, determine the size of array
+   * Each GSB is built independently and stored at its own location (the array
+   * has been reserved), so they can be built with multiple threads.
+   */
+  parallel_for(
+    gsb_range.x() * gsb_range.y(), num_threads, [&](const size_t& index) {
+      size_t ix = index / gsb_range.y();
+      size_t iy = index % gsb_range.y();
       /* Here we give the builder the fringe coordinates so that it can handle
        * the GSBs at the borderside correctly sort drive_rr_nodes should be
        * called if required by users
@@ -438,13 +449,15 @@ void annotate_device_rr_gsb(const DeviceContext& vpr_device_ctx,
                      layer, vtr::Point<size_t>(ix, iy), include_clock);
       /* Add to device_rr_gsb */
       vtr::Point<size_t> gsb_coordinate = rr_gsb.get_sb_coordinate();
-      device_rr_gsb.add_rr_gsb(gsb_coordinate, rr_gsb);
+      device_rr_gsb.get_mutable_gsb(gsb_coordinate) = rr_gsb;
+      if (false == show_progress) {
+        return;
+      }
       gsb_cnt++; /* Update counter */
       /* Print info */
       VTR_LOG("[%lu%] Backannotated GSB[%lu][%lu]\r",
               100 * gsb_cnt / (gsb_range.x() * gsb_range.y()), ix, iy);
-    }
-  }
+    });
   /* Report number of unique mirrors */
   VTR_LOG("Backannotated %d General Switch Blocks (GSBs).\n",
           gsb_range.x() * gsb_range.y());
@@ -456,6 +469,7 @@ void annotate_device_rr_gsb(const DeviceContext& vpr_device_ctx,
  *******************************************************************/
 void sort_device_rr_gsb_chan_node_in_edges(const RRGraphView& rr_graph,
                                            DeviceRRGSB& device_rr_gsb,
+                                           const size_t& num_threads,
                                            const bool& verbose_output) {
   vtr::ScopedStartFinishTimer timer(
     "Sort incoming edges for each routing track output node of General Switch "
@@ -468,24 +482,20 @@ void sort_device_rr_gsb_chan_node_in_edges(const RRGraphView& rr_graph,
   VTR_LOGV(verbose_output, "Start sorting edges for GSBs up to [%lu][%lu]\n",
            gsb_range.x(), gsb_range.y());
 
-  size_t gsb_cnt = 0;
-
-  /* For each switch block, determine the size of array */
-  for (size_t ix = 0; ix < gsb_range.x(); ++ix) {
-    for (size_t iy = 0; iy < gsb_range.y(); ++iy) {
-      vtr::Point<size_t> gsb_coordinate(ix, iy);
+  /* Each GSB only sorts its own nodes while the routing resource graph is
+   * read-only, so GSBs can be sorted with multiple threads */
+  ProgressReporter progress(
+    "Sort incoming edges for each routing track output node of GSBs",
+    gsb_range.x() * gsb_range.y());
+  parallel_for(
+    gsb_range.x() * gsb_range.y(), num_threads, [&](const size_t& index) {
+      vtr::Point<size_t> gsb_coordinate(index / gsb_range.y(),
+                                        index % gsb_range.y());
       RRGSB& rr_gsb = device_rr_gsb.get_mutable_gsb(gsb_coordinate);
       rr_gsb.sort_chan_node_in_edges(rr_graph);
-
-      gsb_cnt++; /* Update counter */
-
-      /* Print info */
-      VTR_LOG(
-        "[%lu%] Sorted incoming edges for each routing track output node of "
-        "GSB[%lu][%lu]\r",
-        100 * gsb_cnt / (gsb_range.x() * gsb_range.y()), ix, iy);
-    }
-  }
+      progress.increment();
+    });
+  progress.finish();
 
   /* Report number of unique mirrors */
   VTR_LOG(
@@ -500,6 +510,7 @@ void sort_device_rr_gsb_chan_node_in_edges(const RRGraphView& rr_graph,
  *******************************************************************/
 void sort_device_rr_gsb_ipin_node_in_edges(const RRGraphView& rr_graph,
                                            DeviceRRGSB& device_rr_gsb,
+                                           const size_t& num_threads,
                                            const bool& verbose_output) {
   vtr::ScopedStartFinishTimer timer(
     "Sort incoming edges for each input pin node of General Switch Block(GSB)");
@@ -511,24 +522,20 @@ void sort_device_rr_gsb_ipin_node_in_edges(const RRGraphView& rr_graph,
   VTR_LOGV(verbose_output, "Start sorting edges for GSBs up to [%lu][%lu]\n",
            gsb_range.x(), gsb_range.y());
 
-  size_t gsb_cnt = 0;
-
-  /* For each switch block, determine the size of array */
-  for (size_t ix = 0; ix < gsb_range.x(); ++ix) {
-    for (size_t iy = 0; iy < gsb_range.y(); ++iy) {
-      vtr::Point<size_t> gsb_coordinate(ix, iy);
+  /* Each GSB only sorts its own nodes while the routing resource graph is
+   * read-only, so GSBs can be sorted with multiple threads */
+  ProgressReporter progress(
+    "Sort incoming edges for each input pin node of GSBs",
+    gsb_range.x() * gsb_range.y());
+  parallel_for(
+    gsb_range.x() * gsb_range.y(), num_threads, [&](const size_t& index) {
+      vtr::Point<size_t> gsb_coordinate(index / gsb_range.y(),
+                                        index % gsb_range.y());
       RRGSB& rr_gsb = device_rr_gsb.get_mutable_gsb(gsb_coordinate);
       rr_gsb.sort_ipin_node_in_edges(rr_graph);
-
-      gsb_cnt++; /* Update counter */
-
-      /* Print info */
-      VTR_LOG(
-        "[%lu%] Sorted incoming edges for each input pin node of "
-        "GSB[%lu][%lu]\r",
-        100 * gsb_cnt / (gsb_range.x() * gsb_range.y()), ix, iy);
-    }
-  }
+      progress.increment();
+    });
+  progress.finish();
 
   /* Report number of unique mirrors */
   VTR_LOG(
@@ -18,14 +18,17 @@ namespace openfpga {
 void annotate_device_rr_gsb(const DeviceContext& vpr_device_ctx,
                             DeviceRRGSB& device_rr_gsb,
                             const bool& include_clock,
+                            const size_t& num_threads,
                             const bool& verbose_output);
 
 void sort_device_rr_gsb_chan_node_in_edges(const RRGraphView& rr_graph,
                                            DeviceRRGSB& device_rr_gsb,
+                                           const size_t& num_threads,
                                            const bool& verbose_output);
 
 void sort_device_rr_gsb_ipin_node_in_edges(const RRGraphView& rr_graph,
                                            DeviceRRGSB& device_rr_gsb,
+                                           const size_t& num_threads,
                                            const bool& verbose_output);
 
 void annotate_rr_graph_circuit_models(
@@ -1,6 +1,11 @@
 #include "append_clock_rr_graph.h"
 
+#include <map>
+#include <string>
+#include <utility>
+
 #include "command_exit_codes.h"
+#include "openfpga_parallel.h"
 #include "openfpga_physical_tile_utils.h"
 #include "rr_graph_builder_utils.h"
 #include "rr_graph_cost.h"
@@ -12,6 +17,14 @@
 /* begin namespace openfpga */
 namespace openfpga {
 
+/* Pin indices of the clock taps in each physical tile type, which are indexed
+ * by [physical_tile_type_index][clock_tree][clock_pin] */
+typedef std::vector<std::vector<std::vector<std::vector<int>>>>
+  ClockTapPinLookup;
+
+/* A pair of source and sink nodes of an edge to be created */
+typedef std::pair<RRNodeId, RRNodeId> ClockEdge;
+
 /********************************************************************
  * Estimate the number of clock nodes to be added for a given tile and clock
  *structure For each layer/level of a clock network, we need
@@ -386,6 +399,70 @@ static std::vector<RRNodeId> find_clock_track2track_node(
   return des_nodes;
 }
 
+/********************************************************************
+ * Find the pin indices of the clock taps in each physical tile type.
+ * Tap names are parsed only once here, rather than for each connection block,
+ * so that the connection blocks can be visited with multiple threads.
+ * The taps are grouped by the name of their tile first, so that each tile
+ * type only resolves the taps which belong to it
+ *******************************************************************/
+static ClockTapPinLookup build_clock_tap_pin_lookup(
+  const std::vector<t_physical_tile_type>& physical_tile_types,
+  const ClockNetwork& clk_ntwk) {
+  /* Flatten taps by [tile_name][clock_tree][clock_pin] */
+  std::map<std::string, std::vector<std::vector<std::vector<std::string>>>>
+    tile_tap_names;
+  for (auto itree : clk_ntwk.trees()) {
+    for (auto ipin : clk_ntwk.pins(itree)) {
+      for (const std::string& tap_pin_name :
+           clk_ntwk.tree_flatten_taps(itree, ipin)) {
+        /* tap pin name could be 'io[5].a2f[0]' */
+        std::string tile_name =
+          tap_pin_name.substr(0, tap_pin_name.find_first_of("[."));
+        std::vector<std::vector<std::vector<std::string>>>& tree_tap_names =
+          tile_tap_names[tile_name];
+        if (tree_tap_names.empty()) {
+          tree_tap_names.resize(clk_ntwk.num_trees());
+        }
+        std::vector<std::vector<std::string>>& pin_tap_names =
+          tree_tap_names[size_t(itree)];
+        if (pin_tap_names.empty()) {
+          pin_tap_names.resize(clk_ntwk.tree_width(itree));
+        }
+        pin_tap_names[size_t(ipin)].push_back(tap_pin_name);
+      }
+    }
+  }
+
+  ClockTapPinLookup tap_pin_lookup(physical_tile_types.size());
+  for (const t_physical_tile_type& physical_tile : physical_tile_types) {
+    auto tile_result = tile_tap_names.find(std::string(physical_tile.name));
+    if (tile_result == tile_tap_names.end()) {
+      continue;
+    }
+    VTR_ASSERT(size_t(physical_tile.index) < tap_pin_lookup.size());
+    std::vector<std::vector<std::vector<int>>>& tile_taps =
+      tap_pin_lookup[physical_tile.index];
+    tile_taps.resize(clk_ntwk.num_trees());
+    for (auto itree : clk_ntwk.trees()) {
+      tile_taps[size_t(itree)].resize(clk_ntwk.tree_width(itree));
+      const std::vector<std::vector<std::string>>& pin_tap_names =
+        tile_result->second[size_t(itree)];
+      for (size_t ipin = 0; ipin < pin_tap_names.size(); ++ipin) {
+        for (const std::string& tap_pin_name : pin_tap_names[ipin]) {
+          int grid_pin_idx =
+            find_physical_tile_pin_index(&physical_tile, tap_pin_name);
+          if (grid_pin_idx == physical_tile.num_pins) {
+            continue;
+          }
+          tile_taps[size_t(itree)][ipin].push_back(grid_pin_idx);
+        }
+      }
+    }
+  }
+  return tap_pin_lookup;
+}
+
 /********************************************************************
  * Try to find an IPIN of a grid which satisfy the requirement of clock pins
  * that has been defined in clock network. If the IPIN does exist in a
@@ -395,17 +472,17 @@ static void try_find_and_add_clock_track2ipin_node(
   std::vector<RRNodeId>& des_nodes, const DeviceGrid& grids,
   const RRGraphView& rr_graph_view, const size_t& layer,
   const vtr::Point<size_t>& grid_coord, const e_side& pin_side,
-  const ClockNetwork& clk_ntwk, const ClockTreeId& clk_tree,
+  const ClockTapPinLookup& tap_pin_lookup, const ClockTreeId& clk_tree,
   const ClockTreePinId& clk_pin) {
   t_physical_tile_type_ptr grid_type = grids.get_physical_type(
     t_physical_tile_loc(grid_coord.x(), grid_coord.y(), layer));
-  for (std::string tap_pin_name :
-       clk_ntwk.tree_flatten_taps(clk_tree, clk_pin)) {
-    /* tap pin name could be 'io[5:5].a2f[0]' */
-    int grid_pin_idx = find_physical_tile_pin_index(grid_type, tap_pin_name);
-    if (grid_pin_idx == grid_type->num_pins) {
-      continue;
-    }
+  const std::vector<std::vector<std::vector<int>>>& tile_taps =
+    tap_pin_lookup[grid_type->index];
+  /* Tile types which are not tapped are empty */
+  if (tile_taps.empty()) {
+    return;
+  }
+  for (const int& grid_pin_idx : tile_taps[size_t(clk_tree)][size_t(clk_pin)]) {
     RRNodeId des_node = rr_graph_view.node_lookup().find_node(
       layer, grid_coord.x(), grid_coord.y(), IPIN, grid_pin_idx, pin_side);
     if (rr_graph_view.valid_node(des_node)) {
@@ -443,7 +520,7 @@ static void try_find_and_add_clock_track2ipin_node(
 static std::vector<RRNodeId> find_clock_track2ipin_node(
   const DeviceGrid& grids, const RRGraphView& rr_graph_view,
   const t_rr_type& chan_type, const size_t& layer,
-  const vtr::Point<size_t>& chan_coord, const ClockNetwork& clk_ntwk,
+  const vtr::Point<size_t>& chan_coord, const ClockTapPinLookup& tap_pin_lookup,
   const ClockTreeId& clk_tree, const ClockTreePinId& clk_pin) {
   std::vector<RRNodeId> des_nodes;
 
@@ -452,41 +529,43 @@ static std::vector<RRNodeId> find_clock_track2ipin_node(
     vtr::Point<size_t> bot_grid_coord(chan_coord.x(), chan_coord.y() + 1);
     try_find_and_add_clock_track2ipin_node(des_nodes, grids, rr_graph_view,
                                            layer, bot_grid_coord, BOTTOM,
-                                           clk_ntwk, clk_tree, clk_pin);
+                                           tap_pin_lookup, clk_tree, clk_pin);
 
     /* Get the clock IPINs at the TOP side of adjacent grids [x][y] */
     vtr::Point<size_t> top_grid_coord(chan_coord.x(), chan_coord.y());
     try_find_and_add_clock_track2ipin_node(des_nodes, grids, rr_graph_view,
-                                           layer, top_grid_coord, TOP, clk_ntwk,
-                                           clk_tree, clk_pin);
+                                           layer, top_grid_coord, TOP,
+                                           tap_pin_lookup, clk_tree, clk_pin);
   } else {
     VTR_ASSERT(chan_type == CHANY);
     /* Get the clock IPINs at the LEFT side of adjacent grids [x][y+1] */
     vtr::Point<size_t> left_grid_coord(chan_coord.x() + 1, chan_coord.y());
     try_find_and_add_clock_track2ipin_node(des_nodes, grids, rr_graph_view,
                                            layer, left_grid_coord, LEFT,
-                                           clk_ntwk, clk_tree, clk_pin);
+                                           tap_pin_lookup, clk_tree, clk_pin);
 
     /* Get the clock IPINs at the RIGHT side of adjacent grids [x][y] */
     vtr::Point<size_t> right_grid_coord(chan_coord.x(), chan_coord.y());
     try_find_and_add_clock_track2ipin_node(des_nodes, grids, rr_graph_view,
                                            layer, right_grid_coord, RIGHT,
-                                           clk_ntwk, clk_tree, clk_pin);
+                                           tap_pin_lookup, clk_tree, clk_pin);
   }
 
   return des_nodes;
 }
 
 /********************************************************************
- * Add edges for the clock nodes in a given connection block
+ * Find the edges for the clock nodes in a given connection block
+ * Only look-ups are read here, so that the connection blocks can be visited
+ * with multiple threads
  *******************************************************************/
-static void add_rr_graph_block_clock_edges(
-  RRGraphBuilder& rr_graph_builder, size_t& num_edges_to_create,
+static std::vector<ClockEdge> find_rr_graph_block_clock_edges(
   const RRClockSpatialLookup& clk_rr_lookup, const RRGraphView& rr_graph_view,
   const DeviceGrid& grids, const size_t& layer, const ClockNetwork& clk_ntwk,
+  const ClockTapPinLookup& tap_pin_lookup,
   const vtr::Point<size_t>& chan_coord, const t_rr_type& chan_type,
   const bool& verbose) {
-  size_t edge_count = 0;
+  std::vector<ClockEdge> edges;
   for (auto itree : clk_ntwk.trees()) {
     for (auto ilvl : clk_ntwk.levels(itree)) {
       /* As we want to keep uni-directional wires, clock routing tracks have to
@@ -519,42 +598,34 @@ static void add_rr_graph_block_clock_edges(
           VTR_ASSERT(rr_graph_view.valid_node(src_node));
           /* find the fan-out clock node through lookup */
           {
-            size_t curr_edge_count = edge_count;
+            size_t curr_edge_count = edges.size();
             for (RRNodeId des_node : find_clock_track2track_node(
                    rr_graph_view, clk_ntwk, clk_rr_lookup, chan_type,
                    chan_coord, itree, ilvl, ClockTreePinId(ipin), node_dir)) {
-              /* Create edges */
               VTR_ASSERT(rr_graph_view.valid_node(des_node));
-              rr_graph_builder.create_edge(src_node, des_node,
-                                           clk_ntwk.default_switch(), false);
-              edge_count++;
+              edges.emplace_back(src_node, des_node);
             }
             VTR_LOGV(verbose, "\tWill add %lu edges to other clock nodes\n",
-                     edge_count - curr_edge_count);
+                     edges.size() - curr_edge_count);
           }
           /* If this is the clock node at the last level of the tree,
            * should drive some grid IPINs which are clocks */
           if (clk_ntwk.is_last_level(itree, ilvl)) {
-            size_t curr_edge_count = edge_count;
+            size_t curr_edge_count = edges.size();
             for (RRNodeId des_node : find_clock_track2ipin_node(
-                   grids, rr_graph_view, chan_type, layer, chan_coord, clk_ntwk,
-                   itree, ClockTreePinId(ipin))) {
-              /* Create edges */
+                   grids, rr_graph_view, chan_type, layer, chan_coord,
+                   tap_pin_lookup, itree, ClockTreePinId(ipin))) {
               VTR_ASSERT(rr_graph_view.valid_node(des_node));
-              rr_graph_builder.create_edge(src_node, des_node,
-                                           clk_ntwk.default_switch(), false);
-              edge_count++;
+              edges.emplace_back(src_node, des_node);
             }
             VTR_LOGV(verbose, "\tWill add %lu edges to other IPIN\n",
-                     edge_count - curr_edge_count);
+                     edges.size() - curr_edge_count);
           }
         }
       }
     }
   }
-  /* Allocate edges */
-  rr_graph_builder.build_edges(true);
-  num_edges_to_create += edge_count;
+  return edges;
 }
 
 /********************************************************************
@@ -581,39 +652,62 @@ static void add_rr_graph_block_clock_edges(
 static void add_rr_graph_clock_edges(
   RRGraphBuilder& rr_graph_builder, size_t& num_edges_to_create,
   const RRClockSpatialLookup& clk_rr_lookup, const RRGraphView& rr_graph_view,
+  const std::vector<t_physical_tile_type>& physical_tile_types,
   const DeviceGrid& grids, const size_t& layer, const bool& through_channel,
-  const ClockNetwork& clk_ntwk, const bool& verbose) {
-  /* Add edges which is driven by X-direction clock routing tracks */
+  const ClockNetwork& clk_ntwk, const size_t& num_threads,
+  const bool& verbose) {
+  /* Collect the connection blocks whose clock nodes drive edges:
+   * - driven by X-direction clock routing tracks
+   * - driven by Y-direction clock routing tracks
+   * Bypass if the routing channel does not exist when through channels are not
+   * allowed */
+  std::vector<std::pair<vtr::Point<size_t>, t_rr_type>> chan_blocks;
   for (size_t iy = 0; iy < grids.height() - 1; ++iy) {
     for (size_t ix = 1; ix < grids.width() - 1; ++ix) {
       vtr::Point<size_t> chanx_coord(ix, iy);
-      /* Bypass if the routing channel does not exist when through channels are
-       * not allowed */
       if ((false == through_channel) &&
           (false == is_chanx_exist(grids, layer, chanx_coord))) {
         continue;
       }
-      add_rr_graph_block_clock_edges(rr_graph_builder, num_edges_to_create,
-                                     clk_rr_lookup, rr_graph_view, grids, layer,
-                                     clk_ntwk, chanx_coord, CHANX, verbose);
+      chan_blocks.emplace_back(chanx_coord, CHANX);
     }
   }
-
-  /* Add edges which is driven by Y-direction clock routing tracks */
   for (size_t ix = 0; ix < grids.width() - 1; ++ix) {
     for (size_t iy = 1; iy < grids.height() - 1; ++iy) {
       vtr::Point<size_t> chany_coord(ix, iy);
-      /* Bypass if the routing channel does not exist when through channel are
-       * not allowed */
       if ((false == through_channel) &&
           (false == is_chany_exist(grids, layer, chany_coord))) {
         continue;
       }
-      add_rr_graph_block_clock_edges(rr_graph_builder, num_edges_to_create,
-                                     clk_rr_lookup, rr_graph_view, grids, layer,
-                                     clk_ntwk, chany_coord, CHANY, verbose);
+      chan_blocks.emplace_back(chany_coord, CHANY);
     }
   }
+
+  ClockTapPinLookup tap_pin_lookup =
+    build_clock_tap_pin_lookup(physical_tile_types, clk_ntwk);
+
+  /* Each connection block only depends on the look-ups, so the edges of
+   * blocks are found with multiple threads. Verbose outputs are printed only
+   * when running in a single thread, otherwise the outputs of threads
+   * interleave */
+  bool verbose_block = verbose && (1 == find_num_threads(num_threads));
+  std::vector<std::vector<ClockEdge>> block_edges(chan_blocks.size());
+  parallel_for(chan_blocks.size(), num_threads, [&](const size_t& iblk) {
+    block_edges[iblk] = find_rr_graph_block_clock_edges(
+      clk_rr_lookup, rr_graph_view, grids, layer, clk_ntwk, tap_pin_lookup,
+      chan_blocks[iblk].first, chan_blocks[iblk].second, verbose_block);
+  });
+
+  /* Create all the edges in the sequence of blocks, and allocate them at
+   * once rather than block by block */
+  for (const std::vector<ClockEdge>& edges : block_edges) {
+    for (const ClockEdge& edge : edges) {
+      rr_graph_builder.create_edge(edge.first, edge.second,
+                                   clk_ntwk.default_switch(), false);
+    }
+    num_edges_to_create += edges.size();
+  }
+  rr_graph_builder.build_edges(true);
 }
 
 /********************************************************************
@@ -626,7 +720,8 @@ static void add_rr_graph_clock_edges(
  *******************************************************************/
 int append_clock_rr_graph(DeviceContext& vpr_device_ctx,
                           RRClockSpatialLookup& clk_rr_lookup,
-                          const ClockNetwork& clk_ntwk, const bool& verbose) {
+                          const ClockNetwork& clk_ntwk,
+                          const size_t& num_threads, const bool& verbose) {
   vtr::ScopedStartFinishTimer timer(
     "Appending programmable clock network to routing resource graph");
 
@@ -675,8 +770,9 @@ int append_clock_rr_graph(DeviceContext& vpr_device_ctx,
   add_rr_graph_clock_edges(
     vpr_device_ctx.rr_graph_builder, num_clock_edges,
     static_cast<const RRClockSpatialLookup&>(clk_rr_lookup),
-    vpr_device_ctx.rr_graph, vpr_device_ctx.grid, 0,
-    vpr_device_ctx.arch->through_channel, clk_ntwk, verbose);
+    vpr_device_ctx.rr_graph, vpr_device_ctx.physical_tile_types,
+    vpr_device_ctx.grid, 0, vpr_device_ctx.arch->through_channel, clk_ntwk,
+    num_threads, verbose);
   VTR_LOGV(verbose,
            "Added %lu clock edges to routing "
            "resource graph.\n",
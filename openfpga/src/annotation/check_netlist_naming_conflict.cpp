@@ -3,8 +3,12 @@
  * in the users' BLIF netlist that violates the syntax of OpenFPGA
  * fabric generator, i.e., Verilog generator and SPICE generator
  *******************************************************************/
+#include <algorithm>
+#include <array>
 #include <fstream>
 #include <string>
+#include <unordered_set>
+#include <utility>
 
 /* Headers from vtrutil library */
 #include "vtr_assert.h"
@@ -27,6 +31,46 @@
 /* begin namespace openfpga */
 namespace openfpga {
 
+/* Lookup tables indexed by character */
+typedef std::array<bool, 256> SensitiveCharLookup;
+typedef std::array<char, 256> FixCharLookup;
+
+/********************************************************************
+ * Build a lookup to spot any of the sensitive characters in one access
+ *******************************************************************/
+static SensitiveCharLookup build_sensitive_char_lookup(
+  const std::string& sensitive_chars) {
+  SensitiveCharLookup lookup;
+  lookup.fill(false);
+  for (const char& sensitive_char : sensitive_chars) {
+    lookup[static_cast<unsigned char>(sensitive_char)] = true;
+  }
+  return lookup;
+}
+
+/********************************************************************
+ * Build a lookup which gives the fixed character of each character.
+ * The sensitive characters are replaced one after another in the order of
+ * the list, so a fix character which is also sensitive will be replaced
+ * again by any later entry of the list
+ *******************************************************************/
+static FixCharLookup build_fix_char_lookup(const std::string& sensitive_chars,
+                                           const std::string& fix_chars) {
+  VTR_ASSERT(sensitive_chars.length() == fix_chars.length());
+
+  FixCharLookup lookup;
+  for (size_t ichar = 0; ichar < lookup.size(); ++ichar) {
+    char curr_char = static_cast<char>(ichar);
+    for (size_t isens = 0; isens < sensitive_chars.length(); ++isens) {
+      if (sensitive_chars[isens] == curr_char) {
+        curr_char = fix_chars[isens];
+      }
+    }
+    lookup[ichar] = curr_char;
+  }
+  return lookup;
+}
+
 /********************************************************************
  * This function aims to check if the name contains any of the
  * sensitive characters in the list
@@ -34,9 +78,17 @@ namespace openfpga {
  * in the name
  *******************************************************************/
 static std::string name_contain_sensitive_chars(
-  const std::string& name, const std::string& sensitive_chars) {
+  const std::string& name, const std::string& sensitive_chars,
+  const SensitiveCharLookup& sensitive_char_lookup) {
   std::string violation;
 
+  /* Most names are legal, so spot them in a single scan */
+  if (name.end() == std::find_if(name.begin(), name.end(), [&](char c) {
+        return sensitive_char_lookup[static_cast<unsigned char>(c)];
+      })) {
+    return violation;
+  }
+
   for (const char& sensitive_char : sensitive_chars) {
     /* Return true since we find a characters */
     if (std::string::npos != name.find(sensitive_char)) {
@@ -53,20 +105,11 @@ static std::string name_contain_sensitive_chars(
  * Return a string the fixed name
  *******************************************************************/
 static std::string fix_name_contain_sensitive_chars(
-  const std::string& name, const std::string& sensitive_chars,
-  const std::string& fix_chars) {
+  const std::string& name, const FixCharLookup& fix_char_lookup) {
   std::string fixed_name = name;
 
-  VTR_ASSERT(sensitive_chars.length() == fix_chars.length());
-
-  for (size_t ichar = 0; ichar < sensitive_chars.length(); ++ichar) {
-    /* Keep fixing the characters until we cannot find anymore */
-    std::string::size_type pos = 0u;
-    while (std::string::npos !=
-           (pos = fixed_name.find(sensitive_chars[ichar], pos))) {
-      fixed_name.replace(pos, 1, std::string(1, fix_chars[ichar]));
-      pos += 1;
-    }
+  for (char& curr_char : fixed_name) {
+    curr_char = fix_char_lookup[static_cast<unsigned char>(curr_char)];
   }
 
   return fixed_name;
@@ -84,11 +127,14 @@ size_t detect_netlist_naming_conflict(const AtomNetlist& atom_netlist,
                                       const std::string& sensitive_chars) {
   size_t num_conflicts = 0;
 
+  SensitiveCharLookup sensitive_char_lookup =
+    build_sensitive_char_lookup(sensitive_chars);
+
   /* Walk through blocks in the netlist */
   for (const auto& block : atom_netlist.blocks()) {
     const std::string& block_name = atom_netlist.block_name(block);
-    const std::string& violation =
-      name_contain_sensitive_chars(block_name, sensitive_chars);
+    const std::string& violation = name_contain_sensitive_chars(
+      block_name, sensitive_chars, sensitive_char_lookup);
     if (false == violation.empty()) {
       VTR_LOG("Block '%s' contains illegal characters '%s'\n",
               block_name.c_str(), violation.c_str());
@@ -99,8 +145,8 @@ size_t detect_netlist_naming_conflict(const AtomNetlist& atom_netlist,
   /* Walk through nets in the netlist */
   for (const auto& net : atom_netlist.nets()) {
     const std::string& net_name = atom_netlist.net_name(net);
-    const std::string& violation =
-      name_contain_sensitive_chars(net_name, sensitive_chars);
+    const std::string& violation = name_contain_sensitive_chars(
+      net_name, sensitive_chars, sensitive_char_lookup);
     if (false == violation.empty()) {
       VTR_LOG("Net '%s' contains illegal characters '%s'\n", net_name.c_str(),
               violation.c_str());
@@ -118,6 +164,8 @@ size_t detect_netlist_naming_conflict(const AtomNetlist& atom_netlist,
  *   any sensitive character
  * - Iterate over all the nets and correct any net name that contains
  *   any sensitive character
+ * A warning is given when a fixed name is the same as the name of another
+ * block or net, which makes the fixed netlist ambiguous
  *******************************************************************/
 void fix_netlist_naming_conflict(const AtomNetlist& atom_netlist,
                                  const std::string& sensitive_chars,
@@ -125,35 +173,72 @@ void fix_netlist_naming_conflict(const AtomNetlist& atom_netlist,
                                  VprNetlistAnnotation& vpr_netlist_annotation) {
   size_t num_fixes = 0;
 
+  SensitiveCharLookup sensitive_char_lookup =
+    build_sensitive_char_lookup(sensitive_chars);
+  FixCharLookup fix_char_lookup =
+    build_fix_char_lookup(sensitive_chars, fix_chars);
+
   /* Walk through blocks in the netlist */
+  std::unordered_set<std::string> fixed_block_names;
   for (const auto& block : atom_netlist.blocks()) {
     const std::string& block_name = atom_netlist.block_name(block);
-    const std::string& violation =
-      name_contain_sensitive_chars(block_name, sensitive_chars);
+    const std::string& violation = name_contain_sensitive_chars(
+      block_name, sensitive_chars, sensitive_char_lookup);
 
     if (false == violation.empty()) {
       /* Apply fix-up here */
-      vpr_netlist_annotation.rename_block(
-        block, fix_name_contain_sensitive_chars(block_name, sensitive_chars,
-                                                fix_chars));
+      std::string fixed_name =
+        fix_name_contain_sensitive_chars(block_name, fix_char_lookup);
+      vpr_netlist_annotation.rename_block(block, fixed_name);
+      fixed_block_names.insert(std::move(fixed_name));
       num_fixes++;
     }
   }
 
   /* Walk through nets in the netlist */
+  std::unordered_set<std::string> fixed_net_names;
   for (const auto& net : atom_netlist.nets()) {
     const std::string& net_name = atom_netlist.net_name(net);
-    const std::string& violation =
-      name_contain_sensitive_chars(net_name, sensitive_chars);
+    const std::string& violation = name_contain_sensitive_chars(
+      net_name, sensitive_chars, sensitive_char_lookup);
     if (false == violation.empty()) {
       /* Apply fix-up here */
-      vpr_netlist_annotation.rename_net(
-        net,
-        fix_name_contain_sensitive_chars(net_name, sensitive_chars, fix_chars));
+      std::string fixed_name =
+        fix_name_contain_sensitive_chars(net_name, fix_char_lookup);
+      vpr_netlist_annotation.rename_net(net, fixed_name);
+      fixed_net_names.insert(std::move(fixed_name));
       num_fixes++;
     }
   }
 
+  /* A fixed name conflicts with a name which is kept, or with another fixed
+   * name when several names are fixed to the same one */
+  size_t num_name_collisions = 0;
+  for (const std::string& fixed_name : fixed_block_names) {
+    AtomBlockId block = atom_netlist.find_block(fixed_name);
+    if ((AtomBlockId::INVALID() != block) &&
+        (false == vpr_netlist_annotation.is_block_renamed(block))) {
+      VTR_LOG_WARN("Fixed block name '%s' is already used by another block\n",
+                   fixed_name.c_str());
+      num_name_collisions++;
+    }
+  }
+  for (const std::string& fixed_name : fixed_net_names) {
+    AtomNetId net = atom_netlist.find_net(fixed_name);
+    if ((AtomNetId::INVALID() != net) &&
+        (false == vpr_netlist_annotation.is_net_renamed(net))) {
+      VTR_LOG_WARN("Fixed net name '%s' is already used by another net\n",
+                   fixed_name.c_str());
+      num_name_collisions++;
+    }
+  }
+  num_name_collisions += num_fixes - fixed_block_names.size() -
+                         fixed_net_names.size();
+  if (0 < num_name_collisions) {
+    VTR_LOG_WARN("Found %ld name collisions after fixing the netlist.\n",
+                 num_name_collisions);
+  }
+
   if (0 < num_fixes) {
     VTR_LOG("Fixed %ld naming conflicts in the netlist.\n", num_fixes);
   }
@@ -3,6 +3,13 @@
  ***********************************************************************/
 #include "device_rr_gsb.h"
 
+#include <algorithm>
+#include <array>
+#include <unordered_map>
+
+#include "openfpga_binary_io.h"
+#include "openfpga_hash.h"
+#include "openfpga_parallel.h"
 #include "rr_gsb_utils.h"
 #include "vtr_assert.h"
 #include "vtr_log.h"
@@ -156,6 +163,21 @@ const RRGSB& DeviceRRGSB::get_sb_unique_module(
   return get_sb_unique_module(get_sb_unique_module_index(coordinate));
 }
 
+/* Only the memory of the GSB objects is counted, as their internal data
+ * belong to the VPR library */
+MemoryUsage DeviceRRGSB::memory_usage() const {
+  MemoryUsage usage = heap_memory_usage(rr_gsb_);
+  usage += heap_memory_usage(gsb_unique_module_id_);
+  usage += heap_memory_usage(gsb_unique_module_);
+  usage += heap_memory_usage(sb_unique_module_id_);
+  usage += heap_memory_usage(sb_unique_module_);
+  usage += heap_memory_usage(cbx_unique_module_id_);
+  usage += heap_memory_usage(cbx_unique_module_);
+  usage += heap_memory_usage(cby_unique_module_id_);
+  usage += heap_memory_usage(cby_unique_module_);
+  return usage;
+}
+
 /************************************************************************
  * Public mutators
  ***********************************************************************/
@@ -227,24 +249,51 @@ RRGSB& DeviceRRGSB::get_mutable_gsb(const size_t& x, const size_t& y) {
 }
 
 /* Add a switch block to the array, which will automatically identify and update
- * the lists of unique mirrors and rotatable mirrors */
+ * the lists of unique mirrors and rotatable mirrors
+ * To avoid comparing each CB against every unique module found so far,
+ * unique modules are bucketed by their structural signature. Mirrors always
+ * share the same signature, so the full mirror check is only required
+ * against the unique modules in the same bucket. The buckets keep the
+ * unique modules in ascending order of id, so that the first mirror found is
+ * the same as a linear search would return.
+ */
 void DeviceRRGSB::build_cb_unique_module(const RRGraphView& rr_graph,
-                                         const t_rr_type& cb_type) {
+                                         const t_rr_type& cb_type,
+                                         const size_t& num_threads) {
   /* Make sure a clean start */
   clear_cb_unique_module(cb_type);
 
+  /* Signatures are independent from each other, compute them in parallel */
+  std::vector<vtr::Point<size_t>> gsb_coords = find_gsb_coordinates();
+  std::vector<size_t> signatures(gsb_coords.size(), 0);
+  parallel_for(gsb_coords.size(), num_threads, [&](const size_t& index) {
+    const RRGSB& rr_gsb = get_gsb(gsb_coords[index]);
+    if (true == rr_gsb.is_cb_exist(cb_type)) {
+      signatures[index] = compute_cb_signature(rr_graph, device_annotation_,
+                                               rr_gsb, cb_type);
+    }
+  });
+
+  std::unordered_map<size_t, std::vector<size_t>> signature2unique_ids;
+  size_t gsb_index = 0;
+
   for (size_t ix = 0; ix < rr_gsb_.size(); ++ix) {
     for (size_t iy = 0; iy < rr_gsb_[ix].size(); ++iy) {
       bool is_unique_module = true;
       vtr::Point<size_t> gsb_coordinate(ix, iy);
 
+      size_t signature = signatures[gsb_index++];
+
       /* Bypass non-exist CB */
       if (false == rr_gsb_[ix][iy].is_cb_exist(cb_type)) {
         continue;
       }
 
-      /* Traverse the unique_mirror list and check it is an mirror of another */
-      for (size_t id = 0; id < get_num_cb_unique_module(cb_type); ++id) {
+      std::vector<size_t>& candidate_ids = signature2unique_ids[signature];
+
+      /* Traverse the unique modules which share the same signature and check
+       * it is an mirror of another */
+      for (const size_t& id : candidate_ids) {
         const RRGSB& unique_module = get_cb_unique_module(cb_type, id);
         if (true == is_cb_mirror(rr_graph, device_annotation_, rr_gsb_[ix][iy],
                                  unique_module, cb_type)) {
@@ -261,37 +310,75 @@ void DeviceRRGSB::build_cb_unique_module(const RRGraphView& rr_graph,
         /* Record the id of unique mirror */
         set_cb_unique_module_id(cb_type, gsb_coordinate,
                                 get_num_cb_unique_module(cb_type) - 1);
+        candidate_ids.push_back(get_num_cb_unique_module(cb_type) - 1);
       }
     }
   }
 }
 
 /* Add a switch block to the array, which will automatically identify and update
- * the lists of unique mirrors and rotatable mirrors */
-void DeviceRRGSB::build_sb_unique_module(const RRGraphView& rr_graph) {
+ * the lists of unique mirrors and rotatable mirrors
+ * Similar to the connection blocks, unique modules are bucketed by their
+ * structural signature. The only exception is a switch block which has no
+ * routing tracks on some side: the mirror check skips such a side, so it has
+ * to be compared against all the unique modules.
+ */
+void DeviceRRGSB::build_sb_unique_module(const RRGraphView& rr_graph,
+                                         const size_t& num_threads) {
   /* Make sure a clean start */
   clear_sb_unique_module();
 
+  /* Signatures are independent from each other, compute them in parallel */
+  std::vector<vtr::Point<size_t>> gsb_coords = find_gsb_coordinates();
+  std::vector<size_t> signatures(gsb_coords.size(), 0);
+  parallel_for(gsb_coords.size(), num_threads, [&](const size_t& index) {
+    signatures[index] = compute_sb_signature(rr_graph, device_annotation_,
+                                             get_gsb(gsb_coords[index]));
+  });
+
+  std::unordered_map<size_t, std::vector<size_t>> signature2unique_ids;
+  size_t gsb_index = 0;
+
   /* Build the unique module */
   for (size_t ix = 0; ix < rr_gsb_.size(); ++ix) {
     for (size_t iy = 0; iy < rr_gsb_[ix].size(); ++iy) {
       bool is_unique_module = true;
       vtr::Point<size_t> sb_coordinate(ix, iy);
 
-      /* Traverse the unique_mirror list and check it is an mirror of another */
-      for (size_t id = 0; id < get_num_sb_unique_module(); ++id) {
-        /* Check if the two modules have the same submodules,
-         * if so, these two modules are the same, indicating the sb is not
-         * unique. else the sb is unique
-         */
-        const RRGSB& unique_module = get_sb_unique_module(id);
-        if (true == is_sb_mirror(rr_graph, device_annotation_, rr_gsb_[ix][iy],
-                                 unique_module)) {
-          /* This is a mirror, raise the flag and we finish */
-          is_unique_module = false;
-          /* Record the id of unique mirror */
-          sb_unique_module_id_[ix][iy] = id;
-          break;
+      size_t signature = signatures[gsb_index++];
+
+      /* Check if the two modules have the same submodules,
+       * if so, these two modules are the same, indicating the sb is not
+       * unique. else the sb is unique
+       */
+      if (true == is_sb_signature_complete(rr_gsb_[ix][iy])) {
+        /* Traverse the unique modules which share the same signature */
+        auto result = signature2unique_ids.find(signature);
+        if (result != signature2unique_ids.end()) {
+          for (const size_t& id : result->second) {
+            if (true == is_sb_mirror(rr_graph, device_annotation_,
+                                     rr_gsb_[ix][iy],
+                                     get_sb_unique_module(id))) {
+              /* This is a mirror, raise the flag and we finish */
+              is_unique_module = false;
+              /* Record the id of unique mirror */
+              sb_unique_module_id_[ix][iy] = id;
+              break;
+            }
+          }
+        }
+      } else {
+        /* Traverse the unique_mirror list and check it is an mirror of
+         * another */
+        for (size_t id = 0; id < get_num_sb_unique_module(); ++id) {
+          if (true == is_sb_mirror(rr_graph, device_annotation_,
+                                   rr_gsb_[ix][iy], get_sb_unique_module(id))) {
+            /* This is a mirror, raise the flag and we finish */
+            is_unique_module = false;
+            /* Record the id of unique mirror */
+            sb_unique_module_id_[ix][iy] = id;
+            break;
+          }
         }
       }
 
@@ -300,6 +387,8 @@ void DeviceRRGSB::build_sb_unique_module(const RRGraphView& rr_graph) {
         sb_unique_module_.push_back(sb_coordinate);
         /* Record the id of unique mirror */
         sb_unique_module_id_[ix][iy] = sb_unique_module_.size() - 1;
+        signature2unique_ids[signature].push_back(sb_unique_module_.size() -
+                                                  1);
       }
     }
   }
@@ -308,59 +397,65 @@ void DeviceRRGSB::build_sb_unique_module(const RRGraphView& rr_graph) {
 /* Add a switch block to the array, which will automatically identify and update
  * the lists of unique mirrors and rotatable mirrors */
 
-/* Find repeatable GSB block in the array */
+/* Find repeatable GSB block in the array
+ * A GSB is a mirror of another when their SB, CBX and CBY unique module ids
+ * are all the same. Therefore, the triple of ids is used as a hash key
+ */
 void DeviceRRGSB::build_gsb_unique_module() {
   /* Make sure a clean start */
   clear_gsb_unique_module();
 
+  std::unordered_map<std::array<size_t, 3>, size_t, ArrayHash<size_t, 3>>
+    unique_module_ids;
+
   for (size_t ix = 0; ix < rr_gsb_.size(); ++ix) {
     for (size_t iy = 0; iy < rr_gsb_[ix].size(); ++iy) {
-      bool is_unique_module = true;
       vtr::Point<size_t> gsb_coordinate(ix, iy);
 
-      /* Traverse the unique_mirror list and check it is an mirror of another */
-      for (size_t id = 0; id < get_num_gsb_unique_module(); ++id) {
-        /* We have alreay built sb and cb unique module list
-         * We just need to check if the unique module id of SBs, CBX and CBY are
-         * the same or not
-         */
-        const vtr::Point<size_t>& gsb_unique_module_coordinate =
-          gsb_unique_module_[id];
-        if ((sb_unique_module_id_[ix][iy] ==
-             sb_unique_module_id_[gsb_unique_module_coordinate.x()]
-                                 [gsb_unique_module_coordinate.y()]) &&
-            (cbx_unique_module_id_[ix][iy] ==
-             cbx_unique_module_id_[gsb_unique_module_coordinate.x()]
-                                  [gsb_unique_module_coordinate.y()]) &&
-            (cby_unique_module_id_[ix][iy] ==
-             cby_unique_module_id_[gsb_unique_module_coordinate.x()]
-                                  [gsb_unique_module_coordinate.y()])) {
-          /* This is a mirror, raise the flag and we finish */
-          is_unique_module = false;
-          /* Record the id of unique mirror */
-          gsb_unique_module_id_[ix][iy] = id;
-          break;
-        }
+      /* We have alreay built sb and cb unique module list
+       * We just need to check if the unique module id of SBs, CBX and CBY are
+       * the same or not
+       */
+      std::array<size_t, 3> key = {sb_unique_module_id_[ix][iy],
+                                   cbx_unique_module_id_[ix][iy],
+                                   cby_unique_module_id_[ix][iy]};
+      auto result = unique_module_ids.find(key);
+      if (result != unique_module_ids.end()) {
+        /* This is a mirror, record the id of unique mirror */
+        gsb_unique_module_id_[ix][iy] = result->second;
+        continue;
       }
       /* Add to list if this is a unique mirror*/
-      if (true == is_unique_module) {
-        add_gsb_unique_module(gsb_coordinate);
-        /* Record the id of unique mirror */
-        gsb_unique_module_id_[ix][iy] = get_num_gsb_unique_module() - 1;
-      }
+      add_gsb_unique_module(gsb_coordinate);
+      /* Record the id of unique mirror */
+      gsb_unique_module_id_[ix][iy] = get_num_gsb_unique_module() - 1;
+      unique_module_ids[key] = get_num_gsb_unique_module() - 1;
     }
   }
 }
 
-void DeviceRRGSB::build_unique_module(const RRGraphView& rr_graph) {
-  build_sb_unique_module(rr_graph);
+void DeviceRRGSB::build_unique_module(const RRGraphView& rr_graph,
+                                      const size_t& num_threads) {
+  build_sb_unique_module(rr_graph, num_threads);
 
-  build_cb_unique_module(rr_graph, CHANX);
-  build_cb_unique_module(rr_graph, CHANY);
+  build_cb_unique_module(rr_graph, CHANX, num_threads);
+  build_cb_unique_module(rr_graph, CHANY, num_threads);
 
   build_gsb_unique_module();
 }
 
+/* Collect the coordinates of all the GSBs in the order of traversal used by
+ * the unique module builders */
+std::vector<vtr::Point<size_t>> DeviceRRGSB::find_gsb_coordinates() const {
+  std::vector<vtr::Point<size_t>> gsb_coords;
+  for (size_t ix = 0; ix < rr_gsb_.size(); ++ix) {
+    for (size_t iy = 0; iy < rr_gsb_[ix].size(); ++iy) {
+      gsb_coords.push_back(vtr::Point<size_t>(ix, iy));
+    }
+  }
+  return gsb_coords;
+}
+
 void DeviceRRGSB::add_gsb_unique_module(const vtr::Point<size_t>& coordinate) {
   gsb_unique_module_.push_back(coordinate);
 }
@@ -400,6 +495,62 @@ void DeviceRRGSB::set_cb_unique_module_id(const t_rr_type& cb_type,
   }
 }
 
+/************************************************************************
+ * Public serializers
+ ***********************************************************************/
+void DeviceRRGSB::write_unique_modules_binary(std::ostream& fp) const {
+  write_binary_data(fp, gsb_unique_module_id_);
+  write_binary_data(fp, gsb_unique_module_);
+  write_binary_data(fp, sb_unique_module_id_);
+  write_binary_data(fp, sb_unique_module_);
+  write_binary_data(fp, cbx_unique_module_id_);
+  write_binary_data(fp, cbx_unique_module_);
+  write_binary_data(fp, cby_unique_module_id_);
+  write_binary_data(fp, cby_unique_module_);
+}
+
+void DeviceRRGSB::read_unique_modules_binary(std::istream& fp) {
+  std::vector<std::vector<size_t>> gsb_unique_module_id;
+  std::vector<vtr::Point<size_t>> gsb_unique_module;
+  std::vector<std::vector<size_t>> sb_unique_module_id;
+  std::vector<vtr::Point<size_t>> sb_unique_module;
+  std::vector<std::vector<size_t>> cbx_unique_module_id;
+  std::vector<vtr::Point<size_t>> cbx_unique_module;
+  std::vector<std::vector<size_t>> cby_unique_module_id;
+  std::vector<vtr::Point<size_t>> cby_unique_module;
+  read_binary_data(fp, gsb_unique_module_id);
+  read_binary_data(fp, gsb_unique_module);
+  read_binary_data(fp, sb_unique_module_id);
+  read_binary_data(fp, sb_unique_module);
+  read_binary_data(fp, cbx_unique_module_id);
+  read_binary_data(fp, cbx_unique_module);
+  read_binary_data(fp, cby_unique_module_id);
+  read_binary_data(fp, cby_unique_module);
+  if (false == fp.good()) {
+    return;
+  }
+  if ((false ==
+       validate_unique_modules(gsb_unique_module_id, gsb_unique_module)) ||
+      (false ==
+       validate_unique_modules(sb_unique_module_id, sb_unique_module)) ||
+      (false ==
+       validate_unique_modules(cbx_unique_module_id, cbx_unique_module)) ||
+      (false ==
+       validate_unique_modules(cby_unique_module_id, cby_unique_module))) {
+    fp.setstate(std::ios::failbit);
+    return;
+  }
+
+  gsb_unique_module_id_.swap(gsb_unique_module_id);
+  gsb_unique_module_.swap(gsb_unique_module);
+  sb_unique_module_id_.swap(sb_unique_module_id);
+  sb_unique_module_.swap(sb_unique_module);
+  cbx_unique_module_id_.swap(cbx_unique_module_id);
+  cbx_unique_module_.swap(cbx_unique_module);
+  cby_unique_module_id_.swap(cby_unique_module_id);
+  cby_unique_module_.swap(cby_unique_module);
+}
+
 /************************************************************************
  * Public clean-up functions:
  ***********************************************************************/
@@ -421,6 +572,23 @@ void DeviceRRGSB::clear() {
   clear_sb_unique_module_id();
 }
 
+/* Unlike clear(), the capacity of the containers is given back */
+void DeviceRRGSB::release_memory() {
+  std::vector<std::vector<RRGSB>>().swap(rr_gsb_);
+
+  std::vector<std::vector<size_t>>().swap(gsb_unique_module_id_);
+  std::vector<vtr::Point<size_t>>().swap(gsb_unique_module_);
+
+  std::vector<std::vector<size_t>>().swap(sb_unique_module_id_);
+  std::vector<vtr::Point<size_t>>().swap(sb_unique_module_);
+
+  std::vector<std::vector<size_t>>().swap(cbx_unique_module_id_);
+  std::vector<vtr::Point<size_t>>().swap(cbx_unique_module_);
+
+  std::vector<std::vector<size_t>>().swap(cby_unique_module_id_);
+  std::vector<vtr::Point<size_t>>().swap(cby_unique_module_);
+}
+
 void DeviceRRGSB::clear_gsb() {
   /* clean gsb array */
   for (size_t x = 0; x < rr_gsb_.size(); ++x) {
@@ -501,6 +669,36 @@ bool DeviceRRGSB::validate_coordinate(
   return (coordinate.y() < rr_gsb_[coordinate.x()].capacity());
 }
 
+/* Validate if the unique modules restored from a binary stream fit the
+ * array: the ids of all the GSBs are given and point to a unique module,
+ * which is a GSB of the array. The ids are left to 0 when no unique module
+ * has been built */
+bool DeviceRRGSB::validate_unique_modules(
+  const std::vector<std::vector<size_t>>& unique_module_ids,
+  const std::vector<vtr::Point<size_t>>& unique_modules) const {
+  if (rr_gsb_.size() != unique_module_ids.size()) {
+    return false;
+  }
+  size_t num_unique_modules = std::max(unique_modules.size(), size_t(1));
+  for (size_t x = 0; x < rr_gsb_.size(); ++x) {
+    if (rr_gsb_[x].size() != unique_module_ids[x].size()) {
+      return false;
+    }
+    for (const size_t& id : unique_module_ids[x]) {
+      if (num_unique_modules <= id) {
+        return false;
+      }
+    }
+  }
+  for (const vtr::Point<size_t>& coordinate : unique_modules) {
+    if ((rr_gsb_.size() <= coordinate.x()) ||
+        (rr_gsb_[coordinate.x()].size() <= coordinate.y())) {
+      return false;
+    }
+  }
+  return true;
+}
+
 /* Validate if the index in the range of unique_mirror vector*/
 bool DeviceRRGSB::validate_gsb_unique_module_index(const size_t& index) const {
   return (index < gsb_unique_module_.size());
@@ -4,6 +4,8 @@
 /********************************************************************
  * Include header files required by the data structure definition
  *******************************************************************/
+#include <iosfwd>
+
 /* Header files from vtrutil library */
 #include "vtr_geometry.h"
 
@@ -12,6 +14,9 @@
 #include "rr_gsb.h"
 #include "vpr_device_annotation.h"
 
+/* Header files from openfpgautil library */
+#include "openfpga_memory_usage.h"
+
 /* namespace openfpga begins */
 namespace openfpga {
 
@@ -68,6 +73,9 @@ class DeviceRRGSB {
   size_t get_cb_unique_module_index(const t_rr_type& cb_type,
                                     const vtr::Point<size_t>& coordinate) const;
 
+  /* Approximate heap memory used by the data structure */
+  MemoryUsage memory_usage() const;
+
  public: /* Mutators */
   void reserve(
     const vtr::Point<size_t>& coordinate); /* Pre-allocate the rr_switch_block
@@ -90,11 +98,23 @@ class DeviceRRGSB {
   RRGSB& get_mutable_gsb(
     const size_t& x,
     const size_t& y); /* Get a rr switch block in the array with a coordinate */
-  void build_unique_module(
-    const RRGraphView& rr_graph); /* Add a switch block to the array, which will
-                                     automatically identify and update the lists
-                                     of unique mirrors and rotatable mirrors */
+  /* Identify the unique mirrors of SBs, CBs and GSBs. The structural
+   * signatures of GSBs are computed with the given number of threads, while
+   * the classification is done in a deterministic order */
+  void build_unique_module(const RRGraphView& rr_graph,
+                           const size_t& num_threads = 1);
+  /** @brief Dump the unique modules of SBs, CBs and GSBs to a binary stream.
+   * The GSBs themselves are not included, as they are built from the routing
+   * resource graph */
+  void write_unique_modules_binary(std::ostream& fp) const;
+  /** @brief Restore the unique modules from a binary stream, which is created
+   * by write_unique_modules_binary(), instead of building them. The stream
+   * is put in a failed state, and the unique modules are left untouched, if
+   * they do not fit the array of GSBs */
+  void read_unique_modules_binary(std::istream& fp);
   void clear();                   /* clean the content */
+  /* Clean the content and release the memory it takes */
+  void release_memory();
  private:                         /* Internal cleaners */
   void clear_gsb();               /* clean the content */
   void clear_cb_unique_module(const t_rr_type& cb_type); /* clean the content */
@@ -117,22 +137,28 @@ class DeviceRRGSB {
                                        const size_t& index)
     const; /* Validate if the index in the range of unique_mirror vector*/
   bool validate_cb_type(const t_rr_type& cb_type) const;
+  bool validate_unique_modules(
+    const std::vector<std::vector<size_t>>& unique_module_ids,
+    const std::vector<vtr::Point<size_t>>& unique_modules)
+    const; /* Validate if restored unique modules fit the array */
 
  private: /* Internal builders */
+  std::vector<vtr::Point<size_t>> find_gsb_coordinates() const;
   void add_gsb_unique_module(const vtr::Point<size_t>& coordinate);
   void add_cb_unique_module(const t_rr_type& cb_type,
                             const vtr::Point<size_t>& coordinate);
   void set_cb_unique_module_id(const t_rr_type& cb_type,
                                const vtr::Point<size_t>& coordinate, size_t id);
   void build_sb_unique_module(
-    const RRGraphView& rr_graph); /* Add a switch block to the array, which will
-                                     automatically identify and update the lists
-                                     of unique mirrors and rotatable mirrors */
-  void build_cb_unique_module(
     const RRGraphView& rr_graph,
-    const t_rr_type&
-      cb_type); /* Add a switch block to the array, which will automatically
-                   identify and update the lists of unique side module */
+    const size_t& num_threads); /* Add a switch block to the array, which will
+                                   automatically identify and update the lists
+                                   of unique mirrors and rotatable mirrors */
+  void build_cb_unique_module(
+    const RRGraphView& rr_graph, const t_rr_type& cb_type,
+    const size_t& num_threads); /* Add a switch block to the array, which will
+                                   automatically identify and update the lists
+                                   of unique side module */
   void build_gsb_unique_module(); /* Add a switch block to the array, which will
                                      automatically identify and update the lists
                                      of unique mirrors and rotatable mirrors */
@@ -3,14 +3,49 @@
  ***********************************************************************/
 #include "fabric_tile.h"
 
+#include <unordered_map>
+
 #include "build_top_module_utils.h"
 #include "command_exit_codes.h"
+#include "openfpga_binary_io.h"
+#include "openfpga_hash.h"
+#include "openfpga_parallel.h"
 #include "vtr_assert.h"
 #include "vtr_log.h"
 
 /* namespace openfpga begins */
 namespace openfpga {
 
+/* Index of a block which is not in the list of any tile */
+constexpr size_t INVALID_BLOCK_INDEX_IN_TILE = size_t(-1);
+
+/************************************************************************
+ * Local utilities
+ ***********************************************************************/
+template <class T>
+static void set_coord_in_lookup(std::vector<std::vector<T>>& lookup,
+                                const vtr::Point<size_t>& coord,
+                                const T& value, const T& default_value) {
+  if (coord.x() >= lookup.size()) {
+    lookup.resize(coord.x() + 1);
+  }
+  if (coord.y() >= lookup[coord.x()].size()) {
+    lookup[coord.x()].resize(coord.y() + 1, default_value);
+  }
+  lookup[coord.x()][coord.y()] = value;
+}
+
+template <class T>
+static T find_coord_in_lookup(const std::vector<std::vector<T>>& lookup,
+                              const vtr::Point<size_t>& coord,
+                              const T& default_value) {
+  if ((coord.x() >= lookup.size()) ||
+      (coord.y() >= lookup[coord.x()].size())) {
+    return default_value;
+  }
+  return lookup[coord.x()][coord.y()];
+}
+
 vtr::Point<size_t> FabricTile::tile_coordinate(
   const FabricTileId& tile_id) const {
   VTR_ASSERT(valid_tile_id(tile_id));
@@ -206,7 +241,13 @@ size_t FabricTile::find_pb_index_in_tile(const FabricTileId& tile_id,
                                          const vtr::Point<size_t>& coord,
                                          const bool& use_gsb_coord) const {
   VTR_ASSERT(valid_tile_id(tile_id));
+  size_t index = INVALID_BLOCK_INDEX_IN_TILE;
   if (use_gsb_coord) {
+    if (find_index_in_lookup(pb_gsb_coord2id_lookup_,
+                             pb_gsb_coord2index_lookup_, tile_id, coord,
+                             pb_gsb_coords_[tile_id].size(), index)) {
+      return index;
+    }
     for (size_t idx = 0; idx < pb_gsb_coords_[tile_id].size(); ++idx) {
       vtr::Point<size_t> curr_coord = pb_gsb_coords_[tile_id][idx];
       if (curr_coord == coord) {
@@ -216,6 +257,11 @@ size_t FabricTile::find_pb_index_in_tile(const FabricTileId& tile_id,
     /* Not found, return an invalid index */
     return pb_gsb_coords_[tile_id].size();
   } else {
+    if (find_index_in_lookup(pb_coord2id_lookup_, pb_coord2index_lookup_,
+                             tile_id, coord, pb_coords_[tile_id].size(),
+                             index)) {
+      return index;
+    }
     for (size_t idx = 0; idx < pb_coords_[tile_id].size(); ++idx) {
       if (pb_coords_[tile_id][idx].coincident(coord)) {
         return idx;
@@ -235,6 +281,12 @@ bool FabricTile::sb_in_tile(const FabricTileId& tile_id,
 size_t FabricTile::find_sb_index_in_tile(
   const FabricTileId& tile_id, const vtr::Point<size_t>& coord) const {
   VTR_ASSERT(valid_tile_id(tile_id));
+  size_t index = INVALID_BLOCK_INDEX_IN_TILE;
+  if (find_index_in_lookup(sb_coord2id_lookup_, sb_coord2index_lookup_,
+                           tile_id, coord, sb_coords_[tile_id].size(),
+                           index)) {
+    return index;
+  }
   for (size_t idx = 0; idx < sb_coords_[tile_id].size(); ++idx) {
     vtr::Point<size_t> curr_coord = sb_coords_[tile_id][idx];
     if (curr_coord == coord) {
@@ -267,8 +319,14 @@ size_t FabricTile::find_cb_index_in_tile(
   const FabricTileId& tile_id, const t_rr_type& cb_type,
   const vtr::Point<size_t>& coord) const {
   VTR_ASSERT(valid_tile_id(tile_id));
+  size_t index = INVALID_BLOCK_INDEX_IN_TILE;
   switch (cb_type) {
     case CHANX:
+      if (find_index_in_lookup(cbx_coord2id_lookup_, cbx_coord2index_lookup_,
+                               tile_id, coord, cbx_coords_[tile_id].size(),
+                               index)) {
+        return index;
+      }
       for (size_t idx = 0; idx < cbx_coords_[tile_id].size(); ++idx) {
         vtr::Point<size_t> curr_coord = cbx_coords_[tile_id][idx];
         if (curr_coord == coord) {
@@ -277,6 +335,11 @@ size_t FabricTile::find_cb_index_in_tile(
       }
       return cbx_coords_[tile_id].size();
     case CHANY:
+      if (find_index_in_lookup(cby_coord2id_lookup_, cby_coord2index_lookup_,
+                               tile_id, coord, cby_coords_[tile_id].size(),
+                               index)) {
+        return index;
+      }
       for (size_t idx = 0; idx < cby_coords_[tile_id].size(); ++idx) {
         vtr::Point<size_t> curr_coord = cby_coords_[tile_id][idx];
         if (curr_coord == coord) {
@@ -296,21 +359,28 @@ vtr::Point<size_t> FabricTile::find_cb_coordinate_in_unique_tile(
   size_t cb_idx_in_curr_tile =
     find_cb_index_in_tile(tile_id, cb_type, cb_coord);
   FabricTileId unique_tile = find_unique_tile(tile_id);
-  return cb_coordinates(unique_tile, cb_type)[cb_idx_in_curr_tile];
+  VTR_ASSERT(valid_tile_id(unique_tile));
+  if (CHANX == cb_type) {
+    return cbx_coords_[unique_tile][cb_idx_in_curr_tile];
+  }
+  VTR_ASSERT(CHANY == cb_type);
+  return cby_coords_[unique_tile][cb_idx_in_curr_tile];
 }
 
 vtr::Point<size_t> FabricTile::find_pb_coordinate_in_unique_tile(
   const FabricTileId& tile_id, const vtr::Point<size_t>& pb_coord) const {
   size_t pb_idx_in_curr_tile = find_pb_index_in_tile(tile_id, pb_coord);
   FabricTileId unique_tile = find_unique_tile(tile_id);
-  return pb_coordinates(unique_tile)[pb_idx_in_curr_tile];
+  VTR_ASSERT(valid_tile_id(unique_tile));
+  return pb_coords_[unique_tile][pb_idx_in_curr_tile].bottom_left();
 }
 
 vtr::Point<size_t> FabricTile::find_sb_coordinate_in_unique_tile(
   const FabricTileId& tile_id, const vtr::Point<size_t>& sb_coord) const {
   size_t sb_idx_in_curr_tile = find_sb_index_in_tile(tile_id, sb_coord);
   FabricTileId unique_tile = find_unique_tile(tile_id);
-  return sb_coordinates(unique_tile)[sb_idx_in_curr_tile];
+  VTR_ASSERT(valid_tile_id(unique_tile));
+  return sb_coords_[unique_tile][sb_idx_in_curr_tile];
 }
 
 std::vector<FabricTileId> FabricTile::unique_tiles() const {
@@ -319,6 +389,30 @@ std::vector<FabricTileId> FabricTile::unique_tiles() const {
 
 bool FabricTile::empty() const { return ids_.empty(); }
 
+MemoryUsage FabricTile::memory_usage() const {
+  MemoryUsage usage = heap_memory_usage(ids_);
+  usage += heap_memory_usage(coords_);
+  usage += heap_memory_usage(pb_coords_);
+  usage += heap_memory_usage(pb_gsb_coords_);
+  usage += heap_memory_usage(cbx_coords_);
+  usage += heap_memory_usage(cby_coords_);
+  usage += heap_memory_usage(sb_coords_);
+  usage += heap_memory_usage(pb_coord2id_lookup_);
+  usage += heap_memory_usage(cbx_coord2id_lookup_);
+  usage += heap_memory_usage(cby_coord2id_lookup_);
+  usage += heap_memory_usage(sb_coord2id_lookup_);
+  usage += heap_memory_usage(pb_coord2index_lookup_);
+  usage += heap_memory_usage(pb_gsb_coord2id_lookup_);
+  usage += heap_memory_usage(pb_gsb_coord2index_lookup_);
+  usage += heap_memory_usage(cbx_coord2index_lookup_);
+  usage += heap_memory_usage(cby_coord2index_lookup_);
+  usage += heap_memory_usage(sb_coord2index_lookup_);
+  usage += heap_memory_usage(tile_coord2id_lookup_);
+  usage += heap_memory_usage(tile_coord2unique_tile_ids_);
+  usage += heap_memory_usage(unique_tile_ids_);
+  return usage;
+}
+
 FabricTileId FabricTile::create_tile(const vtr::Point<size_t>& coord) {
   FabricTileId tile_id = FabricTileId(ids_.size());
   ids_.push_back(tile_id);
@@ -497,6 +591,94 @@ bool FabricTile::register_sb_in_lookup(const FabricTileId& tile_id,
   return true;
 }
 
+bool FabricTile::find_index_in_lookup(
+  const std::vector<std::vector<FabricTileId>>& coord2id_lookup,
+  const std::vector<std::vector<size_t>>& coord2index_lookup,
+  const FabricTileId& tile_id, const vtr::Point<size_t>& coord,
+  const size_t& num_blocks, size_t& index) const {
+  FabricTileId owner_tile =
+    find_coord_in_lookup(coord2id_lookup, coord, FabricTileId::INVALID());
+  /* Without any owner, the coordinate may still be in the list, e.g., when
+   * it is shared by blocks of different tiles. Let the caller search */
+  if (!valid_tile_id(owner_tile)) {
+    return false;
+  }
+  /* The block belongs to another tile */
+  if (owner_tile != tile_id) {
+    index = num_blocks;
+    return true;
+  }
+  index = find_coord_in_lookup(coord2index_lookup, coord,
+                               INVALID_BLOCK_INDEX_IN_TILE);
+  return index < num_blocks;
+}
+
+void FabricTile::register_pb_gsb_in_lookup(const FabricTileId& tile_id,
+                                           const vtr::Point<size_t>& gsb_coord,
+                                           const size_t& index) {
+  FabricTileId owner_tile = find_coord_in_lookup(
+    pb_gsb_coord2id_lookup_, gsb_coord, FabricTileId::INVALID());
+  size_t owner_index = find_coord_in_lookup(
+    pb_gsb_coord2index_lookup_, gsb_coord, INVALID_BLOCK_INDEX_IN_TILE);
+  /* A coordinate shared by multiple blocks has no owner in the look-up, so
+   * that the lists are searched for it. Only the first block in a tile is
+   * kept, as the search does */
+  if (INVALID_BLOCK_INDEX_IN_TILE != owner_index) {
+    if (owner_tile != tile_id) {
+      set_coord_in_lookup(pb_gsb_coord2id_lookup_, gsb_coord,
+                          FabricTileId::INVALID(), FabricTileId::INVALID());
+    }
+    return;
+  }
+  set_coord_in_lookup(pb_gsb_coord2id_lookup_, gsb_coord, tile_id,
+                      FabricTileId::INVALID());
+  set_coord_in_lookup(pb_gsb_coord2index_lookup_, gsb_coord, index,
+                      INVALID_BLOCK_INDEX_IN_TILE);
+}
+
+void FabricTile::build_coord2index_lookups() {
+  pb_coord2index_lookup_.clear();
+  pb_gsb_coord2id_lookup_.clear();
+  pb_gsb_coord2index_lookup_.clear();
+  cbx_coord2index_lookup_.clear();
+  cby_coord2index_lookup_.clear();
+  sb_coord2index_lookup_.clear();
+  for (const FabricTileId& tile_id : ids_) {
+    for (size_t idx = 0; idx < pb_coords_[tile_id].size(); ++idx) {
+      const vtr::Rect<size_t>& pb_rect = pb_coords_[tile_id][idx];
+      for (size_t ix = pb_rect.xmin(); ix <= pb_rect.xmax(); ++ix) {
+        for (size_t iy = pb_rect.ymin(); iy <= pb_rect.ymax(); ++iy) {
+          vtr::Point<size_t> pb_coord(ix, iy);
+          /* Only the first block at a coordinate is kept, as the search does
+           */
+          if (INVALID_BLOCK_INDEX_IN_TILE !=
+              find_coord_in_lookup(pb_coord2index_lookup_, pb_coord,
+                                   INVALID_BLOCK_INDEX_IN_TILE)) {
+            continue;
+          }
+          set_coord_in_lookup(pb_coord2index_lookup_, pb_coord, idx,
+                              INVALID_BLOCK_INDEX_IN_TILE);
+        }
+      }
+    }
+    for (size_t idx = 0; idx < pb_gsb_coords_[tile_id].size(); ++idx) {
+      register_pb_gsb_in_lookup(tile_id, pb_gsb_coords_[tile_id][idx], idx);
+    }
+    for (size_t idx = 0; idx < cbx_coords_[tile_id].size(); ++idx) {
+      set_coord_in_lookup(cbx_coord2index_lookup_, cbx_coords_[tile_id][idx],
+                          idx, INVALID_BLOCK_INDEX_IN_TILE);
+    }
+    for (size_t idx = 0; idx < cby_coords_[tile_id].size(); ++idx) {
+      set_coord_in_lookup(cby_coord2index_lookup_, cby_coords_[tile_id][idx],
+                          idx, INVALID_BLOCK_INDEX_IN_TILE);
+    }
+    for (size_t idx = 0; idx < sb_coords_[tile_id].size(); ++idx) {
+      set_coord_in_lookup(sb_coord2index_lookup_, sb_coords_[tile_id][idx],
+                          idx, INVALID_BLOCK_INDEX_IN_TILE);
+    }
+  }
+}
+
 void FabricTile::invalidate_tile_in_lookup(const vtr::Point<size_t>& coord) {
   tile_coord2id_lookup_[coord.x()][coord.y()] = FabricTileId::INVALID();
 }
@@ -534,8 +716,21 @@ int FabricTile::add_pb_coordinate(const FabricTileId& tile_id,
   VTR_ASSERT(valid_tile_id(tile_id));
   pb_coords_[tile_id].push_back(vtr::Rect<size_t>(coord, coord));
   pb_gsb_coords_[tile_id].push_back(gsb_coord);
+  register_pb_gsb_in_lookup(tile_id, gsb_coord,
+                            pb_gsb_coords_[tile_id].size() - 1);
+  /* Only the first block at a coordinate is kept, as the search does */
+  FabricTileId prev_tile_id =
+    find_coord_in_lookup(pb_coord2id_lookup_, coord, FabricTileId::INVALID());
   /* Register in fast look-up */
-  return register_pb_in_lookup(tile_id, coord);
+  if (!register_pb_in_lookup(tile_id, coord)) {
+    return false;
+  }
+  if (tile_id != prev_tile_id) {
+    set_coord_in_lookup(pb_coord2index_lookup_, coord,
+                        pb_coords_[tile_id].size() - 1,
+                        INVALID_BLOCK_INDEX_IN_TILE);
+  }
+  return true;
 }
 
 int FabricTile::set_pb_max_coordinate(const FabricTileId& tile_id,
@@ -569,7 +764,10 @@ int FabricTile::set_pb_max_coordinate(const FabricTileId& tile_id,
        ix <= pb_coords_[tile_id][pb_index].xmax(); ++ix) {
     for (size_t iy = pb_coords_[tile_id][pb_index].ymin();
          iy <= pb_coords_[tile_id][pb_index].ymax(); ++iy) {
-      register_pb_in_lookup(tile_id, vtr::Point<size_t>(ix, iy));
+      if (register_pb_in_lookup(tile_id, vtr::Point<size_t>(ix, iy))) {
+        set_coord_in_lookup(pb_coord2index_lookup_, vtr::Point<size_t>(ix, iy),
+                            pb_index, INVALID_BLOCK_INDEX_IN_TILE);
+      }
     }
   }
   return CMD_EXEC_SUCCESS;
@@ -583,11 +781,23 @@ int FabricTile::add_cb_coordinate(const FabricTileId& tile_id,
     case CHANX:
       cbx_coords_[tile_id].push_back(coord);
       /* Register in fast look-up */
-      return register_cbx_in_lookup(tile_id, coord);
+      if (!register_cbx_in_lookup(tile_id, coord)) {
+        return false;
+      }
+      set_coord_in_lookup(cbx_coord2index_lookup_, coord,
+                          cbx_coords_[tile_id].size() - 1,
+                          INVALID_BLOCK_INDEX_IN_TILE);
+      return true;
     case CHANY:
       cby_coords_[tile_id].push_back(coord);
       /* Register in fast look-up */
-      return register_cby_in_lookup(tile_id, coord);
+      if (!register_cby_in_lookup(tile_id, coord)) {
+        return false;
+      }
+      set_coord_in_lookup(cby_coord2index_lookup_, coord,
+                          cby_coords_[tile_id].size() - 1,
+                          INVALID_BLOCK_INDEX_IN_TILE);
+      return true;
     default:
       VTR_LOG("Invalid type of connection block!\n");
       exit(1);
@@ -599,7 +809,13 @@ int FabricTile::add_sb_coordinate(const FabricTileId& tile_id,
   VTR_ASSERT(valid_tile_id(tile_id));
   sb_coords_[tile_id].push_back(coord);
   /* Register in fast look-up */
-  return register_sb_in_lookup(tile_id, coord);
+  if (!register_sb_in_lookup(tile_id, coord)) {
+    return false;
+  }
+  set_coord_in_lookup(sb_coord2index_lookup_, coord,
+                      sb_coords_[tile_id].size() - 1,
+                      INVALID_BLOCK_INDEX_IN_TILE);
+  return true;
 }
 
 void FabricTile::clear() {
@@ -615,10 +831,51 @@ void FabricTile::clear() {
   cbx_coord2id_lookup_.clear();
   cby_coord2id_lookup_.clear();
   sb_coord2id_lookup_.clear();
+  pb_coord2index_lookup_.clear();
+  pb_gsb_coord2id_lookup_.clear();
+  pb_gsb_coord2index_lookup_.clear();
+  cbx_coord2index_lookup_.clear();
+  cby_coord2index_lookup_.clear();
+  sb_coord2index_lookup_.clear();
   tile_coord2unique_tile_ids_.clear();
   unique_tile_ids_.clear();
 }
 
+void FabricTile::write_binary(std::ostream& fp) const {
+  write_binary_data(fp, ids_);
+  write_binary_data(fp, coords_);
+  write_binary_data(fp, pb_coords_);
+  write_binary_data(fp, pb_gsb_coords_);
+  write_binary_data(fp, cbx_coords_);
+  write_binary_data(fp, cby_coords_);
+  write_binary_data(fp, sb_coords_);
+  write_binary_data(fp, pb_coord2id_lookup_);
+  write_binary_data(fp, cbx_coord2id_lookup_);
+  write_binary_data(fp, cby_coord2id_lookup_);
+  write_binary_data(fp, sb_coord2id_lookup_);
+  write_binary_data(fp, tile_coord2id_lookup_);
+  write_binary_data(fp, tile_coord2unique_tile_ids_);
+  write_binary_data(fp, unique_tile_ids_);
+}
+
+void FabricTile::read_binary(std::istream& fp) {
+  read_binary_data(fp, ids_);
+  read_binary_data(fp, coords_);
+  read_binary_data(fp, pb_coords_);
+  read_binary_data(fp, pb_gsb_coords_);
+  read_binary_data(fp, cbx_coords_);
+  read_binary_data(fp, cby_coords_);
+  read_binary_data(fp, sb_coords_);
+  read_binary_data(fp, pb_coord2id_lookup_);
+  read_binary_data(fp, cbx_coord2id_lookup_);
+  read_binary_data(fp, cby_coord2id_lookup_);
+  read_binary_data(fp, sb_coord2id_lookup_);
+  read_binary_data(fp, tile_coord2id_lookup_);
+  read_binary_data(fp, tile_coord2unique_tile_ids_);
+  read_binary_data(fp, unique_tile_ids_);
+  build_coord2index_lookups();
+}
+
 bool FabricTile::valid_tile_id(const FabricTileId& tile_id) const {
   return (size_t(tile_id) < ids_.size()) && (tile_id == ids_[tile_id]);
 }
@@ -672,18 +929,67 @@ bool FabricTile::equivalent_tile(const FabricTileId& tile_a,
   return true;
 }
 
+size_t FabricTile::tile_signature(const FabricTileId& tile_id,
+                                  const DeviceGrid& grids,
+                                  const DeviceRRGSB& device_rr_gsb) const {
+  size_t signature = 0;
+  hash_combine<size_t>(signature, pb_coords_[tile_id].size());
+  hash_combine<size_t>(signature, pb_gsb_coords_[tile_id].size());
+  hash_combine<size_t>(signature, cbx_coords_[tile_id].size());
+  hash_combine<size_t>(signature, cby_coords_[tile_id].size());
+  hash_combine<size_t>(signature, sb_coords_[tile_id].size());
+  for (const vtr::Rect<size_t>& pb_coord : pb_coords_[tile_id]) {
+    hash_combine<std::string>(
+      signature, generate_grid_block_module_name_in_top_module(
+                   std::string(), grids, pb_coord.bottom_left()));
+  }
+  for (const vtr::Point<size_t>& cbx_coord : cbx_coords_[tile_id]) {
+    hash_combine<size_t>(
+      signature, device_rr_gsb.get_cb_unique_module_index(CHANX, cbx_coord));
+  }
+  for (const vtr::Point<size_t>& cby_coord : cby_coords_[tile_id]) {
+    hash_combine<size_t>(
+      signature, device_rr_gsb.get_cb_unique_module_index(CHANY, cby_coord));
+  }
+  for (const vtr::Point<size_t>& sb_coord : sb_coords_[tile_id]) {
+    hash_combine<size_t>(signature,
+                         device_rr_gsb.get_sb_unique_module_index(sb_coord));
+  }
+  return signature;
+}
+
+/* To avoid comparing each tile against every unique tile found so far, unique
+ * tiles are bucketed by their signature. Equivalent tiles always share the
+ * same signature, so the full check is only required against the unique tiles
+ * in the same bucket. The buckets keep the unique tiles in the order of
+ * creation, so that the unique tile found is the same as a linear search
+ * would return. */
 int FabricTile::build_unique_tiles(const DeviceGrid& grids,
                                    const DeviceRRGSB& device_rr_gsb,
+                                   const size_t& num_threads,
                                    const bool& verbose) {
+  /* Signatures are independent from each other, compute them in parallel */
+  vtr::vector<FabricTileId, size_t> signatures(ids_.size(), 0);
+  parallel_for(ids_.size(), num_threads, [&](const size_t& index) {
+    FabricTileId tile_id(index);
+    if (valid_tile_id(tile_id)) {
+      signatures[tile_id] = tile_signature(tile_id, grids, device_rr_gsb);
+    }
+  });
+
+  std::unordered_map<size_t, std::vector<FabricTileId>> signature2unique_ids;
   for (size_t ix = 0; ix < grids.width(); ++ix) {
     for (size_t iy = 0; iy < grids.height(); ++iy) {
-      if (!valid_tile_id(tile_coord2id_lookup_[ix][iy])) {
+      FabricTileId curr_tile_id = tile_coord2id_lookup_[ix][iy];
+      if (!valid_tile_id(curr_tile_id)) {
         continue; /* Skip invalid tile (which does not exist) */
       }
+      std::vector<FabricTileId>& candidate_ids =
+        signature2unique_ids[signatures[curr_tile_id]];
       bool is_unique_tile = true;
-      for (FabricTileId unique_tile_id : unique_tile_ids_) {
-        if (equivalent_tile(tile_coord2id_lookup_[ix][iy], unique_tile_id,
-                            grids, device_rr_gsb)) {
+      for (FabricTileId unique_tile_id : candidate_ids) {
+        if (equivalent_tile(curr_tile_id, unique_tile_id, grids,
+                            device_rr_gsb)) {
           VTR_LOGV(verbose,
                    "Tile[%lu][%lu] is a mirror to the unique tile[%lu][%lu]\n",
                    ix, iy, tile_coordinate(unique_tile_id).x(),
@@ -697,8 +1003,9 @@ int FabricTile::build_unique_tiles(const DeviceGrid& grids,
       if (is_unique_tile) {
         VTR_LOGV(verbose, "Tile[%lu][%lu] is added as a new unique tile\n", ix,
                  iy);
-        unique_tile_ids_.push_back(tile_coord2id_lookup_[ix][iy]);
-        tile_coord2unique_tile_ids_[ix][iy] = tile_coord2id_lookup_[ix][iy];
+        unique_tile_ids_.push_back(curr_tile_id);
+        candidate_ids.push_back(curr_tile_id);
+        tile_coord2unique_tile_ids_[ix][iy] = curr_tile_id;
       }
     }
   }
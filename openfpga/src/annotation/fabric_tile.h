@@ -4,11 +4,13 @@
 /********************************************************************
  * Include header files required by the data structure definition
  *******************************************************************/
+#include <iosfwd>
 #include <vector>
 
 #include "device_grid.h"
 #include "device_rr_gsb.h"
 #include "fabric_tile_fwd.h"
+#include "openfpga_memory_usage.h"
 #include "vtr_geometry.h"
 #include "vtr_vector.h"
 
@@ -110,6 +112,9 @@ class FabricTile {
   /** @brief Identify if the fabric tile is empty: no tiles are defined */
   bool empty() const;
 
+  /* Approximate heap memory used by the data structure */
+  MemoryUsage memory_usage() const;
+
  public: /* Mutators */
   FabricTileId create_tile(const vtr::Point<size_t>& coord);
   bool set_tile_coordinate(const FabricTileId& tile_id,
@@ -132,9 +137,18 @@ class FabricTile {
   void clear();
   /** @brief Initialize the data with a given range. Used by constructors */
   void init(const vtr::Point<size_t>& max_coord);
-  /** @brief Identify the number of unique tiles and keep in the lookup */
+  /** @brief Identify the number of unique tiles and keep in the lookup.
+   * The signatures of tiles are computed with a given number of threads */
   int build_unique_tiles(const DeviceGrid& grids,
-                         const DeviceRRGSB& device_rr_gsb, const bool& verbose);
+                         const DeviceRRGSB& device_rr_gsb,
+                         const size_t& num_threads, const bool& verbose);
+
+ public: /* Serializers */
+  /** @brief Dump the content to a binary stream */
+  void write_binary(std::ostream& fp) const;
+  /** @brief Replace the content by the one loaded from a binary stream, which
+   * is created by write_binary() */
+  void read_binary(std::istream& fp);
 
  public: /* Validators */
   bool valid_tile_id(const FabricTileId& tile_id) const;
@@ -145,8 +159,26 @@ class FabricTile {
   bool equivalent_tile(const FabricTileId& tile_a, const FabricTileId& tile_b,
                        const DeviceGrid& grids,
                        const DeviceRRGSB& device_rr_gsb) const;
+  /** @brief Compute a signature of a tile from the same features as
+   * equivalent_tile(), so that equivalent tiles always share a signature */
+  size_t tile_signature(const FabricTileId& tile_id, const DeviceGrid& grids,
+                        const DeviceRRGSB& device_rr_gsb) const;
 
  private: /* Internal builders */
+  /** @brief Find the index of a block in the list of a tile through the fast
+   * look-ups. Return false if the look-ups can not tell, so that the list
+   * should be searched */
+  bool find_index_in_lookup(
+    const std::vector<std::vector<FabricTileId>>& coord2id_lookup,
+    const std::vector<std::vector<size_t>>& coord2index_lookup,
+    const FabricTileId& tile_id, const vtr::Point<size_t>& coord,
+    const size_t& num_blocks, size_t& index) const;
+  /** @brief Rebuild the fast look-ups on block indices from the lists of
+   * coordinates */
+  void build_coord2index_lookups();
+  void register_pb_gsb_in_lookup(const FabricTileId& tile_id,
+                                 const vtr::Point<size_t>& gsb_coord,
+                                 const size_t& index);
   void invalidate_tile_in_lookup(const vtr::Point<size_t>& coord);
   void invalidate_pb_in_lookup(const vtr::Point<size_t>& coord);
   void invalidate_cbx_in_lookup(const vtr::Point<size_t>& coord);
@@ -185,6 +217,15 @@ class FabricTile {
   std::vector<std::vector<FabricTileId>> cbx_coord2id_lookup_;
   std::vector<std::vector<FabricTileId>> cby_coord2id_lookup_;
   std::vector<std::vector<FabricTileId>> sb_coord2id_lookup_;
+  /* A few fast lookup to spot the index of programmable blocks, connection
+   * blocks and switch blocks in the list of their tile by coordinate. They
+   * are derived from the lists above, and therefore not serialized */
+  std::vector<std::vector<size_t>> pb_coord2index_lookup_;
+  std::vector<std::vector<FabricTileId>> pb_gsb_coord2id_lookup_;
+  std::vector<std::vector<size_t>> pb_gsb_coord2index_lookup_;
+  std::vector<std::vector<size_t>> cbx_coord2index_lookup_;
+  std::vector<std::vector<size_t>> cby_coord2index_lookup_;
+  std::vector<std::vector<size_t>> sb_coord2index_lookup_;
   /* A fast lookup to spot tile by coordinate */
   std::vector<std::vector<FabricTileId>> tile_coord2id_lookup_;
   std::vector<std::vector<FabricTileId>>
@@ -4,8 +4,11 @@
  *******************************************************************/
 #include "openfpga_annotate_routing.h"
 
+#include <atomic>
+
 #include "annotate_routing.h"
-#include "old_traceback.h"
+#include "openfpga_parallel.h"
+#include "route_tree.h"
 #include "vtr_assert.h"
 #include "vtr_log.h"
 
@@ -16,151 +19,79 @@ namespace openfpga {
  * Create a mapping between each rr_node and its mapped nets
  * based on VPR routing results
  * - Unmapped rr_node will use invalid ids
+ * - The rr_nodes are annotated with a given number of threads
  *******************************************************************/
 void annotate_vpr_rr_node_nets(const DeviceContext& device_ctx,
                                const ClusteringContext& clustering_ctx,
                                const RoutingContext& routing_ctx,
                                VprRoutingAnnotation& vpr_routing_annotation,
+                               const size_t& num_threads,
                                const bool& verbose) {
   vtr::vector<RRNodeId, ParentNetId> node2net =
     annotate_rr_node_nets((const Netlist<>&)clustering_ctx.clb_nlist,
                           device_ctx, routing_ctx, verbose, false);
-  for (size_t node_id = 0; node_id < device_ctx.rr_graph.num_nodes();
-       ++node_id) {
-    vpr_routing_annotation.set_rr_node_net(
-      RRNodeId(node_id),
-      convert_to_cluster_net_id(node2net[RRNodeId(node_id)]));
-  }
+  /* The annotation has been sized to the number of rr_nodes by init(), and
+   * each rr_node only writes its own entry, so the rr_nodes can be annotated
+   * with multiple threads */
+  parallel_for(device_ctx.rr_graph.num_nodes(), num_threads,
+               [&](const size_t& node_id) {
+                 vpr_routing_annotation.set_rr_node_net(
+                   RRNodeId(node_id),
+                   convert_to_cluster_net_id(node2net[RRNodeId(node_id)]));
+               });
   VTR_LOG("Loaded node-to-net mapping\n");
 }
 
-/********************************************************************
- * This function will find a previous node for a given rr_node
- * from the routing traces
- *
- * It requires a candidate which provided by upstream functions
- * Try to validate a candidate by searching it from driving node list
- * If not validated, try to find a right one in the routing traces
- *******************************************************************/
-static RRNodeId find_previous_node_from_routing_traces(
-  const RRGraphView& rr_graph, t_trace* routing_trace_head,
-  const RRNodeId& prev_node_candidate, const RRNodeId& cur_rr_node) {
-  RRNodeId prev_node = prev_node_candidate;
-
-  /* For a valid prev_node, ensure prev node is one of the driving nodes for
-   * this rr_node! */
-  if (prev_node) {
-    /* Try to spot the previous node in the incoming node list of this rr_node
-     */
-    bool valid_prev_node = false;
-    for (const RREdgeId& in_edge : rr_graph.node_in_edges(cur_rr_node)) {
-      if (prev_node == rr_graph.edge_src_node(in_edge)) {
-        valid_prev_node = true;
-        break;
-      }
-    }
-
-    /* Early exit if we already validate the node */
-    if (true == valid_prev_node) {
-      return prev_node;
-    }
-
-    /* If we cannot find one, it could be possible that this rr_node branches
-     * from an earlier point in the routing tree
-     *
-     *            +----- ... --->prev_node
-     *            |
-     *  src_node->+
-     *            |
-     *            +-----+ rr_node
-     *
-     * Our job now is to start from the head of the traces and find the
-     * prev_node that drives this rr_node
-     *
-     * This search will find the first-fit and finish.
-     * This is reasonable because if there is a second-fit, it should be a
-     * longer path which should be considered in routing optimization
-     */
-    if (false == valid_prev_node) {
-      t_trace* tptr = routing_trace_head;
-      while (tptr != nullptr) {
-        RRNodeId cand_prev_node = RRNodeId(tptr->index);
-        bool is_good_cand = false;
-        for (const RREdgeId& in_edge : rr_graph.node_in_edges(cur_rr_node)) {
-          if (cand_prev_node == rr_graph.edge_src_node(in_edge)) {
-            is_good_cand = true;
-            break;
-          }
-        }
-
-        if (true == is_good_cand) {
-          /* Update prev_node */
-          prev_node = cand_prev_node;
-          break;
-        }
-
-        /* Move on to the next */
-        tptr = tptr->next;
-      }
-    }
-  }
-
-  return prev_node;
-}
-
 /********************************************************************
  * Create a mapping between each rr_node and its previous node
  * based on VPR routing results
  * - Unmapped rr_node will have an invalid id of previous rr_node
+ *
+ * The previous node of a rr_node is its parent in the route tree of the net,
+ * so the route trees are walked directly without being converted to
+ * tracebacks. Each net maps to a disjoint set of rr_nodes, so the nets are
+ * annotated with multiple threads.
  *******************************************************************/
 void annotate_rr_node_previous_nodes(
   const DeviceContext& device_ctx, const ClusteringContext& clustering_ctx,
   const RoutingContext& routing_ctx,
-  VprRoutingAnnotation& vpr_routing_annotation, const bool& verbose) {
-  size_t counter = 0;
+  VprRoutingAnnotation& vpr_routing_annotation, const size_t& num_threads,
+  const bool& verbose) {
+  std::atomic<size_t> counter(0);
   VTR_LOG("Annotating previous nodes for rr_node...");
   VTR_LOGV(verbose, "\n");
 
-  for (auto net_id : clustering_ctx.clb_nlist.nets()) {
+  std::vector<ClusterNetId> nets(clustering_ctx.clb_nlist.nets().begin(),
+                                 clustering_ctx.clb_nlist.nets().end());
+  parallel_for(nets.size(), num_threads, [&](const size_t& inet) {
+    ClusterNetId net_id = nets[inet];
     /* Ignore nets that are not routed */
     if (true == clustering_ctx.clb_nlist.net_is_ignored(net_id)) {
-      continue;
+      return;
     }
     /* Ignore used in local cluster only, reserved one CLB pin */
-    if (false == clustering_ctx.clb_nlist.net_sinks(net_id).size()) {
-      continue;
+    if (true == clustering_ctx.clb_nlist.net_sinks(net_id).empty()) {
+      return;
+    }
+    if (!routing_ctx.route_trees[net_id]) {
+      return;
     }
 
-    /* Cache Previous nodes */
-    RRNodeId prev_node = RRNodeId::INVALID();
-
-    t_trace* tptr = TracebackCompat::traceback_from_route_tree(
-      routing_ctx.route_trees[net_id].value());
-    t_trace* head = tptr;
-    while (tptr != nullptr) {
-      RRNodeId rr_node = RRNodeId(tptr->index);
-
-      /* Find the right previous node */
-      prev_node = find_previous_node_from_routing_traces(
-        device_ctx.rr_graph, head, prev_node, rr_node);
-
-      /* Only update mapped nodes */
-      if (prev_node) {
-        vpr_routing_annotation.set_rr_node_prev_node(device_ctx.rr_graph,
-                                                     rr_node, prev_node);
-        counter++;
+    size_t net_counter = 0;
+    for (const RouteTreeNode& rt_node :
+         routing_ctx.route_trees[net_id].value().all_nodes()) {
+      /* The root node (a SOURCE) is not driven by any node */
+      if (!rt_node.parent()) {
+        continue;
       }
-
-      /* Update prev_node */
-      prev_node = rr_node;
-
-      /* Move on to the next */
-      tptr = tptr->next;
+      vpr_routing_annotation.set_rr_node_prev_node(
+        device_ctx.rr_graph, rt_node.inode, rt_node.parent().value().inode);
+      net_counter++;
     }
-    free_traceback(head);
-  }
+    counter += net_counter;
+  });
 
-  VTR_LOG("Done with %d nodes mapping\n", counter);
+  VTR_LOG("Done with %lu nodes mapping\n", counter.load());
 }
 
 } /* end namespace openfpga */
@@ -78,25 +78,28 @@ static int build_clock_tree_net_map(
 }
 
 /********************************************************************
- * Route a clock tree on an existing routing resource graph
+ * Build the routing of a clock tree on an existing routing resource graph
  * The strategy is to route spine one by one
  * - route the spine from the starting point to the ending point
  * - route the spine-to-spine switching points
  * - route the spine-to-IPIN connections (only for the last level)
+ * The routing only depends on the fabric, so it is built once and cached,
+ * regardless of the nets mapped to the clock tree pins
  *******************************************************************/
-static int route_clock_tree_rr_graph(
-  VprRoutingAnnotation& vpr_routing_annotation, const RRGraphView& rr_graph,
-  const RRClockSpatialLookup& clk_rr_lookup,
-  const std::map<ClockTreePinId, ClusterNetId>& tree2clk_pin_map,
-  const ClockNetwork& clk_ntwk, const ClockTreeId& clk_tree,
-  const bool& verbose) {
+static int build_clock_tree_routes(RRClockRoutes& clk_routes,
+                                   const RRGraphView& rr_graph,
+                                   const RRClockSpatialLookup& clk_rr_lookup,
+                                   const ClockNetwork& clk_ntwk,
+                                   const ClockTreeId& clk_tree,
+                                   const bool& verbose) {
   for (auto ispine : clk_ntwk.spines(clk_tree)) {
     VTR_LOGV(verbose, "Routing spine '%s'...\n",
              clk_ntwk.spine_name(ispine).c_str());
+    /* The coordinates are the same for all the pins */
+    const std::vector<vtr::Point<int>>& spine_coords =
+      clk_ntwk.spine_coordinates(ispine);
     for (auto ipin : clk_ntwk.pins(clk_tree)) {
       /* Route the spine from starting point to ending point */
-      std::vector<vtr::Point<int>> spine_coords =
-        clk_ntwk.spine_coordinates(ispine);
       VTR_LOGV(verbose, "Routing backbone of spine '%s'...\n",
                clk_ntwk.spine_name(ispine).c_str());
       for (size_t icoord = 0; icoord < spine_coords.size() - 1; ++icoord) {
@@ -114,8 +117,7 @@ static int route_clock_tree_rr_graph(
                                   des_spine_level, ipin, des_spine_direction);
         VTR_ASSERT(rr_graph.valid_node(src_node));
         VTR_ASSERT(rr_graph.valid_node(des_node));
-        vpr_routing_annotation.set_rr_node_prev_node(rr_graph, des_node,
-                                                     src_node);
+        clk_routes.add_pin_edge(clk_tree, ipin, src_node, des_node);
       }
       /* Route the spine-to-spine switching points */
       VTR_LOGV(verbose, "Routing switch points of spine '%s'...\n",
@@ -139,16 +141,9 @@ static int route_clock_tree_rr_graph(
                                   des_spine_level, ipin, des_spine_direction);
         VTR_ASSERT(rr_graph.valid_node(src_node));
         VTR_ASSERT(rr_graph.valid_node(des_node));
-        vpr_routing_annotation.set_rr_node_prev_node(rr_graph, des_node,
-                                                     src_node);
-        /* It could happen that there is no net mapped some clock pin, skip the
-         * net mapping */
-        if (tree2clk_pin_map.find(ipin) != tree2clk_pin_map.end()) {
-          vpr_routing_annotation.set_rr_node_net(src_node,
-                                                 tree2clk_pin_map.at(ipin));
-          vpr_routing_annotation.set_rr_node_net(des_node,
-                                                 tree2clk_pin_map.at(ipin));
-        }
+        clk_routes.add_pin_edge(clk_tree, ipin, src_node, des_node);
+        clk_routes.add_pin_net_node(clk_tree, ipin, src_node);
+        clk_routes.add_pin_net_node(clk_tree, ipin, des_node);
       }
       /* Route the spine-to-IPIN connections (only for the last level) */
       if (clk_ntwk.is_last_level(ispine)) {
@@ -167,14 +162,9 @@ static int route_clock_tree_rr_graph(
             if (rr_graph.node_type(des_node) == IPIN) {
               VTR_ASSERT(rr_graph.valid_node(src_node));
               VTR_ASSERT(rr_graph.valid_node(des_node));
-              vpr_routing_annotation.set_rr_node_prev_node(rr_graph, des_node,
-                                                           src_node);
-              if (tree2clk_pin_map.find(ipin) != tree2clk_pin_map.end()) {
-                vpr_routing_annotation.set_rr_node_net(
-                  src_node, tree2clk_pin_map.at(ipin));
-                vpr_routing_annotation.set_rr_node_net(
-                  des_node, tree2clk_pin_map.at(ipin));
-              }
+              clk_routes.add_pin_edge(clk_tree, ipin, src_node, des_node);
+              clk_routes.add_pin_net_node(clk_tree, ipin, src_node);
+              clk_routes.add_pin_net_node(clk_tree, ipin, des_node);
             }
           }
         }
@@ -184,6 +174,41 @@ static int route_clock_tree_rr_graph(
   return CMD_EXEC_SUCCESS;
 }
 
+/********************************************************************
+ * Route a clock tree on an existing routing resource graph, by applying the
+ * cached routing of each clock pin to the routing annotation
+ * - the previous node of each routed node is always annotated
+ * - the nets are annotated only for the clock pins which are mapped to nets
+ *******************************************************************/
+static int route_clock_tree_rr_graph(
+  VprRoutingAnnotation& vpr_routing_annotation, const RRGraphView& rr_graph,
+  const RRClockRoutes& clk_routes,
+  const std::map<ClockTreePinId, ClusterNetId>& tree2clk_pin_map,
+  const ClockNetwork& clk_ntwk, const ClockTreeId& clk_tree,
+  const bool& verbose) {
+  for (auto ipin : clk_ntwk.pins(clk_tree)) {
+    if (false == clk_routes.valid_pin(clk_tree, ipin)) {
+      continue;
+    }
+    VTR_LOGV(verbose, "Applying routing of clock tree '%s' pin '%lu'...\n",
+             clk_ntwk.tree_name(clk_tree).c_str(), size_t(ipin));
+    for (const auto& edge : clk_routes.pin_edges(clk_tree, ipin)) {
+      vpr_routing_annotation.set_rr_node_prev_node(rr_graph, edge.second,
+                                                   edge.first);
+    }
+    /* It could happen that there is no net mapped some clock pin, skip the
+     * net mapping */
+    auto pin_net = tree2clk_pin_map.find(ipin);
+    if (pin_net == tree2clk_pin_map.end()) {
+      continue;
+    }
+    for (const RRNodeId& node : clk_routes.pin_net_nodes(clk_tree, ipin)) {
+      vpr_routing_annotation.set_rr_node_net(node, pin_net->second);
+    }
+  }
+  return CMD_EXEC_SUCCESS;
+}
+
 /********************************************************************
  * Route a clock network based on an existing routing resource graph
  * This function will do the following jobs:
@@ -196,6 +221,7 @@ int route_clock_rr_graph(VprRoutingAnnotation& vpr_routing_annotation,
                          const ClusteredNetlist& cluster_nlist,
                          const VprNetlistAnnotation& netlist_annotation,
                          const RRClockSpatialLookup& clk_rr_lookup,
+                         RRClockRoutes& clk_routes,
                          const ClockNetwork& clk_ntwk,
                          const PinConstraints& pin_constraints,
                          const bool& verbose) {
@@ -236,6 +262,23 @@ int route_clock_rr_graph(VprRoutingAnnotation& vpr_routing_annotation,
     return CMD_EXEC_FATAL_ERROR;
   }
 
+  /* The routing of spines is the same for any design. Build it only when it
+   * is not cached yet */
+  if (true == clk_routes.empty()) {
+    for (auto itree : clk_ntwk.trees()) {
+      VTR_LOGV(verbose, "Building routes of clock tree '%s'...\n",
+               clk_ntwk.tree_name(itree).c_str());
+      int status = build_clock_tree_routes(clk_routes, vpr_device_ctx.rr_graph,
+                                           clk_rr_lookup, clk_ntwk, itree,
+                                           verbose);
+      if (status == CMD_EXEC_FATAL_ERROR) {
+        return status;
+      }
+    }
+  } else {
+    VTR_LOGV(verbose, "Reuse cached routes of clock trees\n");
+  }
+
   /* Route spines one by one */
   for (auto itree : clk_ntwk.trees()) {
     VTR_LOGV(verbose, "Build clock name to clock tree '%s' pin mapping...\n",
@@ -252,7 +295,7 @@ int route_clock_rr_graph(VprRoutingAnnotation& vpr_routing_annotation,
     VTR_LOGV(verbose, "Routing clock tree '%s'...\n",
              clk_ntwk.tree_name(itree).c_str());
     status = route_clock_tree_rr_graph(
-      vpr_routing_annotation, vpr_device_ctx.rr_graph, clk_rr_lookup,
+      vpr_routing_annotation, vpr_device_ctx.rr_graph, clk_routes,
       tree2clk_pin_map, clk_ntwk, itree, verbose);
     if (status == CMD_EXEC_FATAL_ERROR) {
       return status;
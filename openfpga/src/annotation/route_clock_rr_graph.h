@@ -6,6 +6,7 @@
  *******************************************************************/
 #include "clock_network.h"
 #include "pin_constraints.h"
+#include "rr_clock_routes.h"
 #include "rr_clock_spatial_lookup.h"
 #include "vpr_context.h"
 #include "vpr_netlist_annotation.h"
@@ -24,6 +25,7 @@ int route_clock_rr_graph(VprRoutingAnnotation& vpr_routing_annotation,
                          const ClusteredNetlist& cluster_nlist,
                          const VprNetlistAnnotation& netlist_annotation,
                          const RRClockSpatialLookup& clk_rr_lookup,
+                         RRClockRoutes& clk_routes,
                          const ClockNetwork& clk_ntwk,
                          const PinConstraints& pin_constraints,
                          const bool& verbose);
@@ -27,6 +27,8 @@ class RRGSBWriterOption {
   bool include_cb_content(const t_rr_type& cb_type) const;
   bool include_sb_content() const;
   std::vector<std::string> include_gsb_names() const;
+  bool single_file() const;
+  size_t num_threads() const;
   bool verbose_output() const;
 
  public: /* Public mutators */
@@ -40,6 +42,10 @@ class RRGSBWriterOption {
    */
   void set_exclude_content(const std::string& content);
   void set_include_gsb_names(const std::string& gsb_names);
+  /* When enabled, all the GSBs are written to a single XML file, whose path
+   * is the output directory */
+  void set_single_file(const bool& enabled);
+  void set_num_threads(const size_t& num_threads);
   void set_verbose_output(const bool& enabled);
 
  public: /* Public validators */
@@ -61,6 +67,8 @@ class RRGSBWriterOption {
   std::array<bool, 4> exclude_content_;
 
   std::vector<std::string> include_gsb_names_;
+  bool single_file_;
+  size_t num_threads_;
   bool verbose_output_;
 
   /* A flag to indicate if the data parse is invalid or not */
@@ -20,80 +20,73 @@ VprBitstreamAnnotation::VprBitstreamAnnotation() { return; }
  ***********************************************************************/
 VprBitstreamAnnotation::e_bitstream_source_type
 VprBitstreamAnnotation::pb_type_bitstream_source(t_pb_type* pb_type) const {
-  auto result = bitstream_sources_.find(pb_type);
-  if (result != bitstream_sources_.end()) {
-    return result->second;
+  VprBitstreamPbTypeId pb_type_id = find_pb_type_id(pb_type);
+  if (VprBitstreamPbTypeId::INVALID() == pb_type_id) {
+    /* Not found, return an invalid type*/
+    return NUM_BITSTREAM_SOURCE_TYPES;
   }
-
-  /* Not found, return an invalid type*/
-  return NUM_BITSTREAM_SOURCE_TYPES;
+  return bitstream_sources_[pb_type_id];
 }
 
 std::string VprBitstreamAnnotation::pb_type_bitstream_content(
   t_pb_type* pb_type) const {
-  auto result = bitstream_contents_.find(pb_type);
-  if (result != bitstream_contents_.end()) {
-    return result->second;
+  VprBitstreamPbTypeId pb_type_id = find_pb_type_id(pb_type);
+  if (VprBitstreamPbTypeId::INVALID() == pb_type_id) {
+    /* Not found, return an invalid type */
+    return std::string();
   }
-
-  /* Not found, return an invalid type */
-  return std::string();
+  return bitstream_contents_[pb_type_id];
 }
 
 size_t VprBitstreamAnnotation::pb_type_bitstream_offset(
   t_pb_type* pb_type) const {
-  auto result = bitstream_offsets_.find(pb_type);
-  if (result != bitstream_offsets_.end()) {
-    return result->second;
+  VprBitstreamPbTypeId pb_type_id = find_pb_type_id(pb_type);
+  if (VprBitstreamPbTypeId::INVALID() == pb_type_id) {
+    /* Not found, return an zero offset */
+    return 0;
   }
-
-  /* Not found, return an zero offset */
-  return 0;
+  return bitstream_offsets_[pb_type_id];
 }
 
 VprBitstreamAnnotation::e_bitstream_source_type
 VprBitstreamAnnotation::pb_type_mode_select_bitstream_source(
   t_pb_type* pb_type) const {
-  auto result = mode_select_bitstream_sources_.find(pb_type);
-  if (result != mode_select_bitstream_sources_.end()) {
-    return result->second;
+  VprBitstreamPbTypeId pb_type_id = find_pb_type_id(pb_type);
+  if (VprBitstreamPbTypeId::INVALID() == pb_type_id) {
+    /* Not found, return an invalid type*/
+    return NUM_BITSTREAM_SOURCE_TYPES;
   }
-
-  /* Not found, return an invalid type*/
-  return NUM_BITSTREAM_SOURCE_TYPES;
+  return mode_select_bitstream_sources_[pb_type_id];
 }
 
 std::string VprBitstreamAnnotation::pb_type_mode_select_bitstream_content(
   t_pb_type* pb_type) const {
-  auto result = mode_select_bitstream_contents_.find(pb_type);
-  if (result != mode_select_bitstream_contents_.end()) {
-    return result->second;
+  VprBitstreamPbTypeId pb_type_id = find_pb_type_id(pb_type);
+  if (VprBitstreamPbTypeId::INVALID() == pb_type_id) {
+    /* Not found, return an invalid type */
+    return std::string();
   }
-
-  /* Not found, return an invalid type */
-  return std::string();
+  return mode_select_bitstream_contents_[pb_type_id];
 }
 
 size_t VprBitstreamAnnotation::pb_type_mode_select_bitstream_offset(
   t_pb_type* pb_type) const {
-  auto result = mode_select_bitstream_offsets_.find(pb_type);
-  if (result != mode_select_bitstream_offsets_.end()) {
-    return result->second;
+  VprBitstreamPbTypeId pb_type_id = find_pb_type_id(pb_type);
+  if (VprBitstreamPbTypeId::INVALID() == pb_type_id) {
+    /* Not found, return an zero offset */
+    return 0;
   }
-
-  /* Not found, return an zero offset */
-  return 0;
+  return mode_select_bitstream_offsets_[pb_type_id];
 }
 
 size_t VprBitstreamAnnotation::interconnect_default_path_id(
   t_interconnect* interconnect) const {
-  auto result = interconnect_default_path_ids_.find(interconnect);
-  if (result != interconnect_default_path_ids_.end()) {
-    return result->second;
+  VprBitstreamInterconnectId interc_id = find_interconnect_id(interconnect);
+  if (VprBitstreamInterconnectId::INVALID() == interc_id) {
+    /* Not found, return an invalid input id */
+    return DEFAULT_PATH_ID;
   }
-
-  /* Not found, return an invalid input id */
-  return DEFAULT_PATH_ID;
+  return interconnect_default_path_ids_[interc_id];
 }
 
 /************************************************************************
@@ -101,37 +94,97 @@ size_t VprBitstreamAnnotation::interconnect_default_path_id(
  ***********************************************************************/
 void VprBitstreamAnnotation::set_pb_type_bitstream_source(
   t_pb_type* pb_type, const e_bitstream_source_type& bitstream_source) {
-  bitstream_sources_[pb_type] = bitstream_source;
+  bitstream_sources_[find_or_create_pb_type_id(pb_type)] = bitstream_source;
 }
 
 void VprBitstreamAnnotation::set_pb_type_bitstream_content(
   t_pb_type* pb_type, const std::string& bitstream_content) {
-  bitstream_contents_[pb_type] = bitstream_content;
+  bitstream_contents_[find_or_create_pb_type_id(pb_type)] = bitstream_content;
 }
 
 void VprBitstreamAnnotation::set_pb_type_bitstream_offset(
   t_pb_type* pb_type, const size_t& offset) {
-  bitstream_offsets_[pb_type] = offset;
+  bitstream_offsets_[find_or_create_pb_type_id(pb_type)] = offset;
 }
 
 void VprBitstreamAnnotation::set_pb_type_mode_select_bitstream_source(
   t_pb_type* pb_type, const e_bitstream_source_type& bitstream_source) {
-  mode_select_bitstream_sources_[pb_type] = bitstream_source;
+  mode_select_bitstream_sources_[find_or_create_pb_type_id(pb_type)] =
+    bitstream_source;
 }
 
 void VprBitstreamAnnotation::set_pb_type_mode_select_bitstream_content(
   t_pb_type* pb_type, const std::string& bitstream_content) {
-  mode_select_bitstream_contents_[pb_type] = bitstream_content;
+  mode_select_bitstream_contents_[find_or_create_pb_type_id(pb_type)] =
+    bitstream_content;
 }
 
 void VprBitstreamAnnotation::set_pb_type_mode_select_bitstream_offset(
   t_pb_type* pb_type, const size_t& offset) {
-  mode_select_bitstream_offsets_[pb_type] = offset;
+  mode_select_bitstream_offsets_[find_or_create_pb_type_id(pb_type)] = offset;
 }
 
 void VprBitstreamAnnotation::set_interconnect_default_path_id(
   t_interconnect* interconnect, const size_t& default_path_id) {
-  interconnect_default_path_ids_[interconnect] = default_path_id;
+  interconnect_default_path_ids_[find_or_create_interconnect_id(
+    interconnect)] = default_path_id;
+}
+
+/************************************************************************
+ * Internal utility
+ ***********************************************************************/
+VprBitstreamPbTypeId VprBitstreamAnnotation::find_pb_type_id(
+  t_pb_type* pb_type) const {
+  auto it = pb_type_ids_.find(pb_type);
+  if (it == pb_type_ids_.end()) {
+    return VprBitstreamPbTypeId::INVALID();
+  }
+  return it->second;
+}
+
+VprBitstreamInterconnectId VprBitstreamAnnotation::find_interconnect_id(
+  t_interconnect* interconnect) const {
+  auto it = interconnect_ids_.find(interconnect);
+  if (it == interconnect_ids_.end()) {
+    return VprBitstreamInterconnectId::INVALID();
+  }
+  return it->second;
+}
+
+VprBitstreamPbTypeId VprBitstreamAnnotation::find_or_create_pb_type_id(
+  t_pb_type* pb_type) {
+  VprBitstreamPbTypeId pb_type_id = find_pb_type_id(pb_type);
+  if (VprBitstreamPbTypeId::INVALID() != pb_type_id) {
+    return pb_type_id;
+  }
+
+  /* Assign the next dense index and allocate the annotations with the
+   * default values of the accessors */
+  pb_type_id = VprBitstreamPbTypeId(bitstream_sources_.size());
+  pb_type_ids_[pb_type] = pb_type_id;
+  bitstream_sources_.push_back(NUM_BITSTREAM_SOURCE_TYPES);
+  bitstream_contents_.emplace_back();
+  bitstream_offsets_.push_back(0);
+  mode_select_bitstream_sources_.push_back(NUM_BITSTREAM_SOURCE_TYPES);
+  mode_select_bitstream_contents_.emplace_back();
+  mode_select_bitstream_offsets_.push_back(0);
+
+  return pb_type_id;
+}
+
+VprBitstreamInterconnectId
+VprBitstreamAnnotation::find_or_create_interconnect_id(
+  t_interconnect* interconnect) {
+  VprBitstreamInterconnectId interc_id = find_interconnect_id(interconnect);
+  if (VprBitstreamInterconnectId::INVALID() != interc_id) {
+    return interc_id;
+  }
+
+  interc_id = VprBitstreamInterconnectId(interconnect_default_path_ids_.size());
+  interconnect_ids_[interconnect] = interc_id;
+  interconnect_default_path_ids_.push_back(DEFAULT_PATH_ID);
+
+  return interc_id;
 }
 
 } /* End namespace openfpga*/
@@ -4,8 +4,12 @@
 /********************************************************************
  * Include header files required by the data structure definition
  *******************************************************************/
-#include <map>
 #include <string>
+#include <unordered_map>
+
+/* Header from vtrutil library */
+#include "vtr_strong_id.h"
+#include "vtr_vector.h"
 
 /* Header from vpr library */
 #include "vpr_context.h"
@@ -13,6 +17,15 @@
 /* Begin namespace openfpga */
 namespace openfpga {
 
+/* Dense indices of the pb_types and interconnects which have bitstream
+ * settings, so that the settings are stored in flat arrays */
+struct vpr_bitstream_pb_type_id_tag;
+struct vpr_bitstream_interconnect_id_tag;
+
+typedef vtr::StrongId<vpr_bitstream_pb_type_id_tag> VprBitstreamPbTypeId;
+typedef vtr::StrongId<vpr_bitstream_interconnect_id_tag>
+  VprBitstreamInterconnectId;
+
 /********************************************************************
  * This is the critical data structure to link the pb_type in VPR
  * to openfpga annotations
@@ -59,28 +72,50 @@ class VprBitstreamAnnotation {
   void set_interconnect_default_path_id(t_interconnect* interconnect,
                                         const size_t& default_path_id);
 
+ private: /* Internal utility */
+  /* Find the dense index of a pb_type/interconnect, return an invalid id if
+   * it has never been annotated */
+  VprBitstreamPbTypeId find_pb_type_id(t_pb_type* pb_type) const;
+  VprBitstreamInterconnectId find_interconnect_id(
+    t_interconnect* interconnect) const;
+  /* Assign a dense index to a pb_type/interconnect if it does not have one
+   * yet, and allocate its annotations */
+  VprBitstreamPbTypeId find_or_create_pb_type_id(t_pb_type* pb_type);
+  VprBitstreamInterconnectId find_or_create_interconnect_id(
+    t_interconnect* interconnect);
+
  private: /* Internal data */
+  /* Fast look-ups to the dense indices. The annotations below are stored in
+   * flat arrays which are indexed by the dense indices */
+  std::unordered_map<t_pb_type*, VprBitstreamPbTypeId> pb_type_ids_;
+  std::unordered_map<t_interconnect*, VprBitstreamInterconnectId>
+    interconnect_ids_;
+
   /* For regular bitstreams */
   /* A look up for pb type to find bitstream source type */
-  std::map<t_pb_type*, e_bitstream_source_type> bitstream_sources_;
+  vtr::vector<VprBitstreamPbTypeId, e_bitstream_source_type>
+    bitstream_sources_;
   /* Binding from pb type to bitstream content */
-  std::map<t_pb_type*, std::string> bitstream_contents_;
+  vtr::vector<VprBitstreamPbTypeId, std::string> bitstream_contents_;
   /* Offset to be applied to bitstream */
-  std::map<t_pb_type*, size_t> bitstream_offsets_;
+  vtr::vector<VprBitstreamPbTypeId, size_t> bitstream_offsets_;
 
   /* For mode-select bitstreams */
   /* A look up for pb type to find bitstream source type */
-  std::map<t_pb_type*, e_bitstream_source_type> mode_select_bitstream_sources_;
+  vtr::vector<VprBitstreamPbTypeId, e_bitstream_source_type>
+    mode_select_bitstream_sources_;
   /* Binding from pb type to bitstream content */
-  std::map<t_pb_type*, std::string> mode_select_bitstream_contents_;
+  vtr::vector<VprBitstreamPbTypeId, std::string>
+    mode_select_bitstream_contents_;
   /* Offset to be applied to mode-select bitstream */
-  std::map<t_pb_type*, size_t> mode_select_bitstream_offsets_;
+  vtr::vector<VprBitstreamPbTypeId, size_t> mode_select_bitstream_offsets_;
 
   /* A look up for interconnect to find default path indices
    * Note: this is different from the default path in bitstream setting which is
    * the index of inputs in the context of the interconnect input string
    */
-  std::map<t_interconnect*, size_t> interconnect_default_path_ids_;
+  vtr::vector<VprBitstreamInterconnectId, size_t>
+    interconnect_default_path_ids_;
 };
 
 } /* End namespace openfpga*/
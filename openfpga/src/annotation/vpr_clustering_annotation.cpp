@@ -3,6 +3,8 @@
  ***********************************************************************/
 #include "vpr_clustering_annotation.h"
 
+#include <utility>
+
 #include "vtr_assert.h"
 #include "vtr_log.h"
 
@@ -19,18 +21,18 @@ VprClusteringAnnotation::VprClusteringAnnotation() { return; }
  ***********************************************************************/
 bool VprClusteringAnnotation::is_net_renamed(const ClusterBlockId& block_id,
                                              const int& pin_index) const {
-  /* Ensure that the block_id is in the list */
-  if (net_names_.end() == net_names_.find(block_id)) {
+  /* Ensure that the block_id and pin_index are in the list */
+  if ((size_t(block_id) >= net_renamed_.size()) || (0 > pin_index) ||
+      (size_t(pin_index) >= net_renamed_[block_id].size())) {
     return false;
   }
-  return (net_names_.at(block_id).end() !=
-          net_names_.at(block_id).find(pin_index));
+  return net_renamed_[block_id][pin_index];
 }
 
 ClusterNetId VprClusteringAnnotation::net(const ClusterBlockId& block_id,
                                           const int& pin_index) const {
   VTR_ASSERT(true == is_net_renamed(block_id, pin_index));
-  return net_names_.at(block_id).at(pin_index);
+  return net_names_[block_id][pin_index];
 }
 
 bool VprClusteringAnnotation::is_truth_table_adapted(t_pb* pb) const {
@@ -43,13 +45,14 @@ AtomNetlist::TruthTable VprClusteringAnnotation::truth_table(t_pb* pb) const {
   return block_truth_tables_.at(pb);
 }
 
-PhysicalPb VprClusteringAnnotation::physical_pb(
+const PhysicalPb& VprClusteringAnnotation::physical_pb(
   const ClusterBlockId& block_id) const {
-  if (physical_pbs_.end() == physical_pbs_.find(block_id)) {
-    return PhysicalPb();
+  if (size_t(block_id) >= physical_pbs_.size()) {
+    static const PhysicalPb empty_physical_pb;
+    return empty_physical_pb;
   }
 
-  return physical_pbs_.at(block_id);
+  return physical_pbs_[block_id];
 }
 
 /************************************************************************
@@ -58,10 +61,20 @@ PhysicalPb VprClusteringAnnotation::physical_pb(
 void VprClusteringAnnotation::rename_net(const ClusterBlockId& block_id,
                                          const int& pin_index,
                                          const ClusterNetId& net_id) {
+  VTR_ASSERT(block_id);
+  VTR_ASSERT(0 <= pin_index);
+  /* Resize on demand, which is avoided when the remapping is allocated */
+  if (size_t(block_id) >= net_names_.size()) {
+    net_names_.resize(size_t(block_id) + 1);
+    net_renamed_.resize(size_t(block_id) + 1);
+  }
+  /* Pins of a block are only resized by the block itself */
+  if (size_t(pin_index) >= net_names_[block_id].size()) {
+    net_names_[block_id].resize(pin_index + 1, ClusterNetId::INVALID());
+    net_renamed_[block_id].resize(pin_index + 1, false);
+  }
   /* Warn any override attempt */
-  if ((net_names_.end() != net_names_.find(block_id)) &&
-      (net_names_.at(block_id).end() !=
-       net_names_.at(block_id).find(pin_index))) {
+  if (true == net_renamed_[block_id][pin_index]) {
     VTR_LOG_WARN(
       "Override the net '%ld' for block '%ld' pin '%d' with in clustering "
       "context annotation!\n",
@@ -69,6 +82,7 @@ void VprClusteringAnnotation::rename_net(const ClusterBlockId& block_id,
   }
 
   net_names_[block_id][pin_index] = net_id;
+  net_renamed_[block_id][pin_index] = true;
 }
 
 void VprClusteringAnnotation::adapt_truth_table(
@@ -86,24 +100,63 @@ void VprClusteringAnnotation::adapt_truth_table(
 
 void VprClusteringAnnotation::add_physical_pb(const ClusterBlockId& block_id,
                                               const PhysicalPb& physical_pb) {
-  /* Warn any override attempt */
-  if (physical_pbs_.end() != physical_pbs_.find(block_id)) {
-    VTR_LOG_WARN(
-      "Override the physical pb for clustered block %lu in clustering context "
-      "annotation!\n",
-      size_t(block_id));
-  }
-
+  alloc_physical_pb(block_id);
   physical_pbs_[block_id] = physical_pb;
 }
 
+void VprClusteringAnnotation::add_physical_pb(const ClusterBlockId& block_id,
+                                              PhysicalPb&& physical_pb) {
+  alloc_physical_pb(block_id);
+  physical_pbs_[block_id] = std::move(physical_pb);
+}
+
 PhysicalPb& VprClusteringAnnotation::mutable_physical_pb(
   const ClusterBlockId& block_id) {
-  VTR_ASSERT(physical_pbs_.end() != physical_pbs_.find(block_id));
+  VTR_ASSERT(size_t(block_id) < physical_pbs_.size());
+  VTR_ASSERT(false == physical_pbs_[block_id].empty());
+
+  return physical_pbs_[block_id];
+}
+
+MemoryUsage VprClusteringAnnotation::physical_pb_memory_usage() const {
+  MemoryUsage usage = heap_memory_usage(physical_pbs_);
+  for (const PhysicalPb& physical_pb : physical_pbs_) {
+    usage += physical_pb.memory_usage();
+  }
+  return usage;
+}
 
-  return physical_pbs_.at(block_id);
+void VprClusteringAnnotation::clear_net_remapping() {
+  net_names_.clear();
+  net_renamed_.clear();
 }
 
-void VprClusteringAnnotation::clear_net_remapping() { net_names_.clear(); }
+void VprClusteringAnnotation::init_net_remapping(const size_t& num_blocks) {
+  clear_net_remapping();
+  net_names_.resize(num_blocks);
+  net_renamed_.resize(num_blocks);
+}
+
+void VprClusteringAnnotation::clear_physical_pbs() {
+  vtr::vector<ClusterBlockId, PhysicalPb>().swap(physical_pbs_);
+}
+
+/************************************************************************
+ * Internal mutators
+ ***********************************************************************/
+void VprClusteringAnnotation::alloc_physical_pb(
+  const ClusterBlockId& block_id) {
+  VTR_ASSERT(block_id);
+  if (size_t(block_id) >= physical_pbs_.size()) {
+    physical_pbs_.resize(size_t(block_id) + 1);
+  }
+  /* Warn any override attempt */
+  if (false == physical_pbs_[block_id].empty()) {
+    VTR_LOG_WARN(
+      "Override the physical pb for clustered block %lu in clustering context "
+      "annotation!\n",
+      size_t(block_id));
+  }
+}
 
 } /* End namespace openfpga*/
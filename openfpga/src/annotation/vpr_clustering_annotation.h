@@ -4,11 +4,13 @@
 /********************************************************************
  * Include header files required by the data structure definition
  *******************************************************************/
-#include <map>
+#include <unordered_map>
+#include <vector>
 
 /* Header from vpr library */
 #include "clustered_netlist.h"
 #include "physical_pb.h"
+#include "vtr_vector.h"
 
 /* Begin namespace openfpga */
 namespace openfpga {
@@ -37,26 +39,45 @@ class VprClusteringAnnotation {
   ClusterNetId net(const ClusterBlockId& block_id, const int& pin_index) const;
   bool is_truth_table_adapted(t_pb* pb) const;
   AtomNetlist::TruthTable truth_table(t_pb* pb) const;
-  PhysicalPb physical_pb(const ClusterBlockId& block_id) const;
+  /* An empty physical pb is returned if the block has no physical pb */
+  const PhysicalPb& physical_pb(const ClusterBlockId& block_id) const;
+  /* Approximate heap memory used by the physical pbs of all the blocks */
+  MemoryUsage physical_pb_memory_usage() const;
 
  public: /* Public mutators */
+  /* Nets of different blocks can be renamed by multiple threads, only when
+   * the net remapping has been allocated for all the blocks */
   void rename_net(const ClusterBlockId& block_id, const int& pin_index,
                   const ClusterNetId& net_id);
   void adapt_truth_table(t_pb* pb, const AtomNetlist::TruthTable& tt);
   void add_physical_pb(const ClusterBlockId& block_id,
                        const PhysicalPb& physical_pb);
+  void add_physical_pb(const ClusterBlockId& block_id,
+                       PhysicalPb&& physical_pb);
   PhysicalPb& mutable_physical_pb(const ClusterBlockId& block_id);
 
  public: /* Clean-up */
   void clear_net_remapping();
+  /* Clear the net remapping and allocate it for a number of blocks */
+  void init_net_remapping(const size_t& num_blocks);
+  /* Remove the physical pbs of all the blocks and release their memory */
+  void clear_physical_pbs();
+
+ private: /* Internal mutators */
+  /* Allocate the physical pbs upon needs, and warn any override attempt */
+  void alloc_physical_pb(const ClusterBlockId& block_id);
 
  private: /* Internal data */
-  /* Pair a regular pb_type to its physical pb_type */
-  std::map<ClusterBlockId, std::map<int, ClusterNetId>> net_names_;
-  std::map<t_pb*, AtomNetlist::TruthTable> block_truth_tables_;
+  /* Nets remapped to the pins of clustered blocks, which are indexed by
+   * [block_id][pin_index]. Pins which are not renamed are flagged, as a net
+   * can be renamed to an invalid id */
+  vtr::vector<ClusterBlockId, std::vector<ClusterNetId>> net_names_;
+  vtr::vector<ClusterBlockId, std::vector<bool>> net_renamed_;
+  std::unordered_map<t_pb*, AtomNetlist::TruthTable> block_truth_tables_;
 
-  /* Link clustered blocks to physical pb (mapping results) */
-  std::map<ClusterBlockId, PhysicalPb> physical_pbs_;
+  /* Link clustered blocks to physical pb (mapping results). A block without
+   * physical pb has an empty one */
+  vtr::vector<ClusterBlockId, PhysicalPb> physical_pbs_;
 };
 
 } /* End namespace openfpga*/
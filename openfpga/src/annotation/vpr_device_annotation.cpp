@@ -21,156 +21,138 @@ VprDeviceAnnotation::VprDeviceAnnotation() { return; }
  ***********************************************************************/
 bool VprDeviceAnnotation::is_physical_pb_type(t_pb_type* pb_type) const {
   /* Ensure that the pb_type is in the list */
-  std::map<t_pb_type*, t_pb_type*>::const_iterator it =
-    physical_pb_types_.find(pb_type);
-  if (it == physical_pb_types_.end()) {
+  VprPbTypeId pb_type_id = find_pb_type_id(pb_type);
+  if (VprPbTypeId::INVALID() == pb_type_id) {
     return false;
   }
   /* A physical pb_type should be mapped to itself! Otherwise, it is an
    * operating pb_type */
-  return pb_type == physical_pb_types_.at(pb_type);
+  return pb_type == physical_pb_types_[pb_type_id];
 }
 
 t_mode* VprDeviceAnnotation::physical_mode(t_pb_type* pb_type) const {
   /* Ensure that the pb_type is in the list */
-  std::map<t_pb_type*, t_mode*>::const_iterator it =
-    physical_pb_modes_.find(pb_type);
-  if (it == physical_pb_modes_.end()) {
+  VprPbTypeId pb_type_id = find_pb_type_id(pb_type);
+  if (VprPbTypeId::INVALID() == pb_type_id) {
     return nullptr;
   }
-  return physical_pb_modes_.at(pb_type);
+  return physical_pb_modes_[pb_type_id];
 }
 
 t_pb_type* VprDeviceAnnotation::physical_pb_type(t_pb_type* pb_type) const {
   /* Ensure that the pb_type is in the list */
-  std::map<t_pb_type*, t_pb_type*>::const_iterator it =
-    physical_pb_types_.find(pb_type);
-  if (it == physical_pb_types_.end()) {
+  VprPbTypeId pb_type_id = find_pb_type_id(pb_type);
+  if (VprPbTypeId::INVALID() == pb_type_id) {
     return nullptr;
   }
-  return physical_pb_types_.at(pb_type);
+  return physical_pb_types_[pb_type_id];
 }
 
 std::vector<t_port*> VprDeviceAnnotation::physical_pb_port(
   t_port* pb_port) const {
-  /* Ensure that the pb_type is in the list */
-  std::map<t_port*, std::vector<t_port*>>::const_iterator it =
-    physical_pb_ports_.find(pb_port);
-  if (it == physical_pb_ports_.end()) {
+  /* Ensure that the pb_port is in the list */
+  VprPbPortId pb_port_id = find_pb_port_id(pb_port);
+  if (VprPbPortId::INVALID() == pb_port_id) {
     return std::vector<t_port*>();
   }
-  return physical_pb_ports_.at(pb_port);
+  return physical_pb_ports_[pb_port_id];
 }
 
 BasicPort VprDeviceAnnotation::physical_pb_port_range(
   t_port* operating_pb_port, t_port* physical_pb_port) const {
-  /* Ensure that the pb_type is in the list */
-  std::map<t_port*, std::map<t_port*, BasicPort>>::const_iterator it =
-    physical_pb_port_ranges_.find(operating_pb_port);
-  if (it == physical_pb_port_ranges_.end()) {
+  /* Ensure that the pair of pb_ports is in the list */
+  const PhysicalPbPortPair* port_pair =
+    find_physical_pb_port_pair(operating_pb_port, physical_pb_port);
+  if ((nullptr == port_pair) || (false == port_pair->has_port_range)) {
     /* Return an invalid port. As such the port width will be 0, which is an
      * invalid value */
     return BasicPort();
   }
-  if (0 ==
-      physical_pb_port_ranges_.at(operating_pb_port).count(physical_pb_port)) {
-    /* Return an invalid port. As such the port width will be 0, which is an
-     * invalid value */
-    return BasicPort();
-  }
-  return physical_pb_port_ranges_.at(operating_pb_port).at(physical_pb_port);
+  return port_pair->port_range;
 }
 
 CircuitModelId VprDeviceAnnotation::pb_type_circuit_model(
   t_pb_type* physical_pb_type) const {
   /* Ensure that the pb_type is in the list */
-  std::map<t_pb_type*, CircuitModelId>::const_iterator it =
-    pb_type_circuit_models_.find(physical_pb_type);
-  if (it == pb_type_circuit_models_.end()) {
+  VprPbTypeId pb_type_id = find_pb_type_id(physical_pb_type);
+  if (VprPbTypeId::INVALID() == pb_type_id) {
     /* Return an invalid circuit model id */
     return CircuitModelId::INVALID();
   }
-  return pb_type_circuit_models_.at(physical_pb_type);
+  return pb_type_circuit_models_[pb_type_id];
 }
 
 CircuitModelId VprDeviceAnnotation::interconnect_circuit_model(
   t_interconnect* pb_interconnect) const {
-  /* Ensure that the pb_type is in the list */
-  std::map<t_interconnect*, CircuitModelId>::const_iterator it =
-    interconnect_circuit_models_.find(pb_interconnect);
-  if (it == interconnect_circuit_models_.end()) {
+  /* Ensure that the interconnect is in the list */
+  VprInterconnectId interc_id = find_interconnect_id(pb_interconnect);
+  if (VprInterconnectId::INVALID() == interc_id) {
     /* Return an invalid circuit model id */
     return CircuitModelId::INVALID();
   }
-  return interconnect_circuit_models_.at(pb_interconnect);
+  return interconnect_circuit_models_[interc_id];
 }
 
 e_interconnect VprDeviceAnnotation::interconnect_physical_type(
   t_interconnect* pb_interconnect) const {
-  /* Ensure that the pb_type is in the list */
-  std::map<t_interconnect*, e_interconnect>::const_iterator it =
-    interconnect_physical_types_.find(pb_interconnect);
-  if (it == interconnect_physical_types_.end()) {
+  /* Ensure that the interconnect is in the list */
+  VprInterconnectId interc_id = find_interconnect_id(pb_interconnect);
+  if (VprInterconnectId::INVALID() == interc_id) {
     /* Return an invalid interconnect type */
     return NUM_INTERC_TYPES;
   }
-  return interconnect_physical_types_.at(pb_interconnect);
+  return interconnect_physical_types_[interc_id];
 }
 
 CircuitPortId VprDeviceAnnotation::pb_circuit_port(t_port* pb_port) const {
-  /* Ensure that the pb_type is in the list */
-  std::map<t_port*, CircuitPortId>::const_iterator it =
-    pb_circuit_ports_.find(pb_port);
-  if (it == pb_circuit_ports_.end()) {
+  /* Ensure that the pb_port is in the list */
+  VprPbPortId pb_port_id = find_pb_port_id(pb_port);
+  if (VprPbPortId::INVALID() == pb_port_id) {
     /* Return an invalid circuit port id */
     return CircuitPortId::INVALID();
   }
-  return pb_circuit_ports_.at(pb_port);
+  return pb_circuit_ports_[pb_port_id];
 }
 
 std::vector<size_t> VprDeviceAnnotation::pb_type_mode_bits(
   t_pb_type* pb_type) const {
   /* Ensure that the pb_type is in the list */
-  std::map<t_pb_type*, std::vector<size_t>>::const_iterator it =
-    pb_type_mode_bits_.find(pb_type);
-  if (it == pb_type_mode_bits_.end()) {
+  VprPbTypeId pb_type_id = find_pb_type_id(pb_type);
+  if (VprPbTypeId::INVALID() == pb_type_id) {
     /* Return an empty vector */
     return std::vector<size_t>();
   }
-  return pb_type_mode_bits_.at(pb_type);
+  return pb_type_mode_bits_[pb_type_id];
 }
 
 PbGraphNodeId VprDeviceAnnotation::pb_graph_node_unique_index(
   t_pb_graph_node* pb_graph_node) const {
   /* Ensure that the pb_type is in the list */
-  std::map<t_pb_type*, std::vector<t_pb_graph_node*>>::const_iterator it =
-    pb_graph_node_unique_index_.find(pb_graph_node->pb_type);
-  if (it == pb_graph_node_unique_index_.end()) {
+  VprPbTypeId pb_type_id = find_pb_type_id(pb_graph_node->pb_type);
+  if (VprPbTypeId::INVALID() == pb_type_id) {
     /* Invalid pb_type, return a null pointer */
     return PbGraphNodeId::INVALID();
   }
 
   /* Try to find the pb_graph_node in the vector */
+  const std::vector<t_pb_graph_node*>& pb_graph_nodes =
+    pb_graph_node_unique_index_[pb_type_id];
   std::vector<t_pb_graph_node*>::const_iterator it_node =
-    std::find(pb_graph_node_unique_index_.at(pb_graph_node->pb_type).begin(),
-              pb_graph_node_unique_index_.at(pb_graph_node->pb_type).end(),
-              pb_graph_node);
+    std::find(pb_graph_nodes.begin(), pb_graph_nodes.end(), pb_graph_node);
   /* If it exists, return the index
    * Otherwise, return an invalid id
    */
-  if (it_node == pb_graph_node_unique_index_.at(pb_graph_node->pb_type).end()) {
+  if (it_node == pb_graph_nodes.end()) {
     return PbGraphNodeId::INVALID();
   }
-  return PbGraphNodeId(
-    it_node - pb_graph_node_unique_index_.at(pb_graph_node->pb_type).begin());
+  return PbGraphNodeId(size_t(it_node - pb_graph_nodes.begin()));
 }
 
 t_pb_graph_node* VprDeviceAnnotation::pb_graph_node(
   t_pb_type* pb_type, const PbGraphNodeId& unique_index) const {
   /* Ensure that the pb_type is in the list */
-  std::map<t_pb_type*, std::vector<t_pb_graph_node*>>::const_iterator it =
-    pb_graph_node_unique_index_.find(pb_type);
-  if (it == pb_graph_node_unique_index_.end()) {
+  VprPbTypeId pb_type_id = find_pb_type_id(pb_type);
+  if (VprPbTypeId::INVALID() == pb_type_id) {
     /* Invalid pb_type, return a null pointer */
     return nullptr;
   }
@@ -178,146 +160,115 @@ t_pb_graph_node* VprDeviceAnnotation::pb_graph_node(
    *  - Out of range: return a null pointer
    *  - In range: return the pointer
    */
-  if ((size_t)unique_index >
-      pb_graph_node_unique_index_.at(pb_type).size() - 1) {
+  const std::vector<t_pb_graph_node*>& pb_graph_nodes =
+    pb_graph_node_unique_index_[pb_type_id];
+  if ((size_t)unique_index >= pb_graph_nodes.size()) {
     return nullptr;
   }
 
-  return pb_graph_node_unique_index_.at(pb_type)[size_t(unique_index)];
+  return pb_graph_nodes[size_t(unique_index)];
 }
 
 t_pb_graph_node* VprDeviceAnnotation::physical_pb_graph_node(
   t_pb_graph_node* pb_graph_node) const {
   /* Ensure that the pb_graph_node is in the list */
-  std::map<t_pb_graph_node*, t_pb_graph_node*>::const_iterator it =
-    physical_pb_graph_nodes_.find(pb_graph_node);
+  auto it = physical_pb_graph_nodes_.find(pb_graph_node);
   if (it == physical_pb_graph_nodes_.end()) {
     return nullptr;
   }
-  return physical_pb_graph_nodes_.at(pb_graph_node);
+  return it->second;
 }
 
 float VprDeviceAnnotation::physical_pb_type_index_factor(
   t_pb_type* pb_type) const {
   /* Ensure that the pb_type is in the list */
-  std::map<t_pb_type*, float>::const_iterator it =
-    physical_pb_type_index_factors_.find(pb_type);
-  if (it == physical_pb_type_index_factors_.end()) {
+  VprPbTypeId pb_type_id = find_pb_type_id(pb_type);
+  if (VprPbTypeId::INVALID() == pb_type_id) {
     /* Default value is 1 */
     return 1.;
   }
-  return physical_pb_type_index_factors_.at(pb_type);
+  return physical_pb_type_index_factors_[pb_type_id];
 }
 
 int VprDeviceAnnotation::physical_pb_type_index_offset(
   t_pb_type* pb_type) const {
   /* Ensure that the pb_type is in the list */
-  std::map<t_pb_type*, int>::const_iterator it =
-    physical_pb_type_index_offsets_.find(pb_type);
-  if (it == physical_pb_type_index_offsets_.end()) {
+  VprPbTypeId pb_type_id = find_pb_type_id(pb_type);
+  if (VprPbTypeId::INVALID() == pb_type_id) {
     /* Default value is 0 */
     return 0;
   }
-  return physical_pb_type_index_offsets_.at(pb_type);
+  return physical_pb_type_index_offsets_[pb_type_id];
 }
 
 int VprDeviceAnnotation::physical_pb_pin_initial_offset(
   t_port* operating_pb_port, t_port* physical_pb_port) const {
-  /* Ensure that the pb_type is in the list */
-  std::map<t_port*, std::map<t_port*, int>>::const_iterator it =
-    physical_pb_pin_initial_offsets_.find(operating_pb_port);
-  if (it == physical_pb_pin_initial_offsets_.end()) {
-    /* Default value is 0 */
-    return 0;
-  }
-  if (0 == physical_pb_pin_initial_offsets_.at(operating_pb_port)
-             .count(physical_pb_port)) {
+  /* Ensure that the pair of pb_ports is in the list */
+  const PhysicalPbPortPair* port_pair =
+    find_physical_pb_port_pair(operating_pb_port, physical_pb_port);
+  if (nullptr == port_pair) {
     /* Default value is 0 */
     return 0;
   }
-  return physical_pb_pin_initial_offsets_.at(operating_pb_port)
-    .at(physical_pb_port);
+  return port_pair->pin_initial_offset;
 }
 
 int VprDeviceAnnotation::physical_pb_pin_rotate_offset(
   t_port* operating_pb_port, t_port* physical_pb_port) const {
-  /* Ensure that the pb_type is in the list */
-  std::map<t_port*, std::map<t_port*, int>>::const_iterator it =
-    physical_pb_pin_rotate_offsets_.find(operating_pb_port);
-  if (it == physical_pb_pin_rotate_offsets_.end()) {
-    /* Default value is 0 */
-    return 0;
-  }
-  if (0 == physical_pb_pin_rotate_offsets_.at(operating_pb_port)
-             .count(physical_pb_port)) {
+  /* Ensure that the pair of pb_ports is in the list */
+  const PhysicalPbPortPair* port_pair =
+    find_physical_pb_port_pair(operating_pb_port, physical_pb_port);
+  if (nullptr == port_pair) {
     /* Default value is 0 */
     return 0;
   }
-  return physical_pb_pin_rotate_offsets_.at(operating_pb_port)
-    .at(physical_pb_port);
+  return port_pair->pin_rotate_offset;
 }
 
 int VprDeviceAnnotation::physical_pb_port_rotate_offset(
   t_port* operating_pb_port, t_port* physical_pb_port) const {
-  /* Ensure that the pb_type is in the list */
-  std::map<t_port*, std::map<t_port*, int>>::const_iterator it =
-    physical_pb_port_rotate_offsets_.find(operating_pb_port);
-  if (it == physical_pb_port_rotate_offsets_.end()) {
+  /* Ensure that the pair of pb_ports is in the list */
+  const PhysicalPbPortPair* port_pair =
+    find_physical_pb_port_pair(operating_pb_port, physical_pb_port);
+  if (nullptr == port_pair) {
     /* Default value is 0 */
     return 0;
   }
-  if (0 == physical_pb_port_rotate_offsets_.at(operating_pb_port)
-             .count(physical_pb_port)) {
-    /* Default value is 0 */
-    return 0;
-  }
-  return physical_pb_port_rotate_offsets_.at(operating_pb_port)
-    .at(physical_pb_port);
+  return port_pair->port_rotate_offset;
 }
 
 int VprDeviceAnnotation::physical_pb_pin_offset(
   t_port* operating_pb_port, t_port* physical_pb_port) const {
-  /* Ensure that the pb_type is in the list */
-  std::map<t_port*, std::map<t_port*, int>>::const_iterator it =
-    physical_pb_pin_offsets_.find(operating_pb_port);
-  if (it == physical_pb_pin_offsets_.end()) {
+  /* Ensure that the pair of pb_ports is in the list */
+  const PhysicalPbPortPair* port_pair =
+    find_physical_pb_port_pair(operating_pb_port, physical_pb_port);
+  if (nullptr == port_pair) {
     /* Default value is 0 */
     return 0;
   }
-  if (0 ==
-      physical_pb_pin_offsets_.at(operating_pb_port).count(physical_pb_port)) {
-    /* Default value is 0 */
-    return 0;
-  }
-  return physical_pb_pin_offsets_.at(operating_pb_port).at(physical_pb_port);
+  return port_pair->pin_offset;
 }
 
 int VprDeviceAnnotation::physical_pb_port_offset(
   t_port* operating_pb_port, t_port* physical_pb_port) const {
-  /* Ensure that the pb_type is in the list */
-  std::map<t_port*, std::map<t_port*, int>>::const_iterator it =
-    physical_pb_port_offsets_.find(operating_pb_port);
-  if (it == physical_pb_port_offsets_.end()) {
+  /* Ensure that the pair of pb_ports is in the list */
+  const PhysicalPbPortPair* port_pair =
+    find_physical_pb_port_pair(operating_pb_port, physical_pb_port);
+  if (nullptr == port_pair) {
     /* Default value is 0 */
     return 0;
   }
-  if (0 ==
-      physical_pb_port_offsets_.at(operating_pb_port).count(physical_pb_port)) {
-    /* Default value is 0 */
-    return 0;
-  }
-  return physical_pb_port_offsets_.at(operating_pb_port).at(physical_pb_port);
+  return port_pair->port_offset;
 }
 
 t_pb_graph_pin* VprDeviceAnnotation::physical_pb_graph_pin(
   const t_pb_graph_pin* pb_graph_pin) const {
-  /* Ensure that the pb_type is in the list */
-  std::map<const t_pb_graph_pin*, t_pb_graph_pin*>::const_iterator it =
-    physical_pb_graph_pins_.find(pb_graph_pin);
+  /* Ensure that the pb_graph_pin is in the list */
+  auto it = physical_pb_graph_pins_.find(pb_graph_pin);
   if (it == physical_pb_graph_pins_.end()) {
     return nullptr;
   }
-  return physical_pb_graph_pins_.at(pb_graph_pin);
+  return it->second;
 }
 
 CircuitModelId VprDeviceAnnotation::rr_switch_circuit_model(
@@ -451,37 +402,36 @@ int VprDeviceAnnotation::physical_tile_z_to_start_pin_index(
  ***********************************************************************/
 void VprDeviceAnnotation::add_pb_type_physical_mode(t_pb_type* pb_type,
                                                     t_mode* physical_mode) {
+  VprPbTypeId pb_type_id = find_or_create_pb_type_id(pb_type);
   /* Warn any override attempt */
-  std::map<t_pb_type*, t_mode*>::const_iterator it =
-    physical_pb_modes_.find(pb_type);
-  if (it != physical_pb_modes_.end()) {
+  if (nullptr != physical_pb_modes_[pb_type_id]) {
     VTR_LOG_WARN(
       "Override the annotation between pb_type '%s' and it physical mode "
       "'%s'!\n",
       pb_type->name, physical_mode->name);
   }
 
-  physical_pb_modes_[pb_type] = physical_mode;
+  physical_pb_modes_[pb_type_id] = physical_mode;
 }
 
 void VprDeviceAnnotation::add_physical_pb_type(t_pb_type* operating_pb_type,
                                                t_pb_type* physical_pb_type) {
+  VprPbTypeId pb_type_id = find_or_create_pb_type_id(operating_pb_type);
   /* Warn any override attempt */
-  std::map<t_pb_type*, t_pb_type*>::const_iterator it =
-    physical_pb_types_.find(operating_pb_type);
-  if (it != physical_pb_types_.end()) {
+  if (nullptr != physical_pb_types_[pb_type_id]) {
     VTR_LOG_WARN(
       "Override the annotation between operating pb_type '%s' and it physical "
       "pb_type '%s'!\n",
       operating_pb_type->name, physical_pb_type->name);
   }
 
-  physical_pb_types_[operating_pb_type] = physical_pb_type;
+  physical_pb_types_[pb_type_id] = physical_pb_type;
 }
 
 void VprDeviceAnnotation::add_physical_pb_port(t_port* operating_pb_port,
                                                t_port* physical_pb_port) {
-  physical_pb_ports_[operating_pb_port].push_back(physical_pb_port);
+  VprPbPortId pb_port_id = find_or_create_pb_port_id(operating_pb_port);
+  physical_pb_ports_[pb_port_id].push_back(physical_pb_port);
 }
 
 void VprDeviceAnnotation::add_physical_pb_port_range(
@@ -490,12 +440,10 @@ void VprDeviceAnnotation::add_physical_pb_port_range(
   /* The port range must satify the port width*/
   VTR_ASSERT((size_t)operating_pb_port->num_pins >= port_range.get_width());
 
+  PhysicalPbPortPair& port_pair =
+    find_or_create_physical_pb_port_pair(operating_pb_port, physical_pb_port);
   /* Warn any override attempt */
-  std::map<t_port*, std::map<t_port*, BasicPort>>::const_iterator it =
-    physical_pb_port_ranges_.find(operating_pb_port);
-  if ((it != physical_pb_port_ranges_.end()) &&
-      (0 <
-       physical_pb_port_ranges_[operating_pb_port].count(physical_pb_port))) {
+  if (true == port_pair.has_port_range) {
     VTR_LOG_WARN(
       "Override the annotation between operating pb_port '%s' and it physical "
       "pb_port range '%s[%ld:%ld]'!\n",
@@ -503,86 +451,82 @@ void VprDeviceAnnotation::add_physical_pb_port_range(
       port_range.get_msb());
   }
 
-  physical_pb_port_ranges_[operating_pb_port][physical_pb_port] = port_range;
+  port_pair.port_range = port_range;
+  port_pair.has_port_range = true;
 }
 
 void VprDeviceAnnotation::add_pb_type_circuit_model(
   t_pb_type* physical_pb_type, const CircuitModelId& circuit_model) {
+  VprPbTypeId pb_type_id = find_or_create_pb_type_id(physical_pb_type);
   /* Warn any override attempt */
-  std::map<t_pb_type*, CircuitModelId>::const_iterator it =
-    pb_type_circuit_models_.find(physical_pb_type);
-  if (it != pb_type_circuit_models_.end()) {
+  if (CircuitModelId::INVALID() != pb_type_circuit_models_[pb_type_id]) {
     VTR_LOG_WARN("Override the circuit model for physical pb_type '%s'!\n",
                  physical_pb_type->name);
   }
 
-  pb_type_circuit_models_[physical_pb_type] = circuit_model;
+  pb_type_circuit_models_[pb_type_id] = circuit_model;
 }
 
 void VprDeviceAnnotation::add_interconnect_circuit_model(
   t_interconnect* pb_interconnect, const CircuitModelId& circuit_model) {
+  VprInterconnectId interc_id = find_or_create_interconnect_id(pb_interconnect);
   /* Warn any override attempt */
-  std::map<t_interconnect*, CircuitModelId>::const_iterator it =
-    interconnect_circuit_models_.find(pb_interconnect);
-  if (it != interconnect_circuit_models_.end()) {
+  if (CircuitModelId::INVALID() != interconnect_circuit_models_[interc_id]) {
     VTR_LOG_WARN("Override the circuit model for interconnect '%s'!\n",
                  pb_interconnect->name);
   }
 
-  interconnect_circuit_models_[pb_interconnect] = circuit_model;
+  interconnect_circuit_models_[interc_id] = circuit_model;
 }
 
 void VprDeviceAnnotation::add_interconnect_physical_type(
   t_interconnect* pb_interconnect, const e_interconnect& physical_type) {
+  VprInterconnectId interc_id = find_or_create_interconnect_id(pb_interconnect);
   /* Warn any override attempt */
-  std::map<t_interconnect*, e_interconnect>::const_iterator it =
-    interconnect_physical_types_.find(pb_interconnect);
-  if (it != interconnect_physical_types_.end()) {
+  if (NUM_INTERC_TYPES != interconnect_physical_types_[interc_id]) {
     VTR_LOG_WARN("Override the physical interconnect for interconnect '%s'!\n",
                  pb_interconnect->name);
   }
 
-  interconnect_physical_types_[pb_interconnect] = physical_type;
+  interconnect_physical_types_[interc_id] = physical_type;
 }
 
 void VprDeviceAnnotation::add_pb_circuit_port(
   t_port* pb_port, const CircuitPortId& circuit_port) {
+  VprPbPortId pb_port_id = find_or_create_pb_port_id(pb_port);
   /* Warn any override attempt */
-  std::map<t_port*, CircuitPortId>::const_iterator it =
-    pb_circuit_ports_.find(pb_port);
-  if (it != pb_circuit_ports_.end()) {
+  if (CircuitPortId::INVALID() != pb_circuit_ports_[pb_port_id]) {
     VTR_LOG_WARN("Override the circuit port mapping for pb_type port '%s'!\n",
                  pb_port->name);
   }
 
-  pb_circuit_ports_[pb_port] = circuit_port;
+  pb_circuit_ports_[pb_port_id] = circuit_port;
 }
 
 void VprDeviceAnnotation::add_pb_type_mode_bits(
   t_pb_type* pb_type, const std::vector<size_t>& mode_bits) {
+  VprPbTypeId pb_type_id = find_or_create_pb_type_id(pb_type);
   /* Warn any override attempt */
-  std::map<t_pb_type*, std::vector<size_t>>::const_iterator it =
-    pb_type_mode_bits_.find(pb_type);
-  if (it != pb_type_mode_bits_.end()) {
+  if (true == pb_type_mode_bits_annotated_[pb_type_id]) {
     VTR_LOG_WARN("Override the mode bits mapping for pb_type '%s'!\n",
                  pb_type->name);
   }
 
-  pb_type_mode_bits_[pb_type] = mode_bits;
+  pb_type_mode_bits_[pb_type_id] = mode_bits;
+  pb_type_mode_bits_annotated_[pb_type_id] = true;
 }
 
 void VprDeviceAnnotation::add_pb_graph_node_unique_index(
   t_pb_graph_node* pb_graph_node) {
-  pb_graph_node_unique_index_[pb_graph_node->pb_type].push_back(pb_graph_node);
+  VprPbTypeId pb_type_id = find_or_create_pb_type_id(pb_graph_node->pb_type);
+  pb_graph_node_unique_index_[pb_type_id].push_back(pb_graph_node);
 }
 
 void VprDeviceAnnotation::add_physical_pb_graph_node(
   t_pb_graph_node* operating_pb_graph_node,
   t_pb_graph_node* physical_pb_graph_node) {
   /* Warn any override attempt */
-  std::map<t_pb_graph_node*, t_pb_graph_node*>::const_iterator it =
-    physical_pb_graph_nodes_.find(operating_pb_graph_node);
-  if (it != physical_pb_graph_nodes_.end()) {
+  if (0 < physical_pb_graph_nodes_.count(operating_pb_graph_node)) {
     VTR_LOG_WARN(
       "Override the annotation between operating pb_graph_node '%s[%d]' and it "
       "physical pb_graph_node '%s[%d]'!\n",
@@ -597,104 +541,98 @@ void VprDeviceAnnotation::add_physical_pb_graph_node(
 
 void VprDeviceAnnotation::add_physical_pb_type_index_factor(
   t_pb_type* pb_type, const float& factor) {
+  VprPbTypeId pb_type_id = find_or_create_pb_type_id(pb_type);
   /* Warn any override attempt */
-  std::map<t_pb_type*, float>::const_iterator it =
-    physical_pb_type_index_factors_.find(pb_type);
-  if (it != physical_pb_type_index_factors_.end()) {
+  if (true == physical_pb_type_index_factor_annotated_[pb_type_id]) {
     VTR_LOG_WARN(
       "Override the annotation between operating pb_type '%s' and it physical "
       "pb_type index factor '%f'!\n",
       pb_type->name, factor);
   }
 
-  physical_pb_type_index_factors_[pb_type] = factor;
+  physical_pb_type_index_factors_[pb_type_id] = factor;
+  physical_pb_type_index_factor_annotated_[pb_type_id] = true;
 }
 
 void VprDeviceAnnotation::add_physical_pb_type_index_offset(t_pb_type* pb_type,
                                                             const int& offset) {
+  VprPbTypeId pb_type_id = find_or_create_pb_type_id(pb_type);
   /* Warn any override attempt */
-  std::map<t_pb_type*, int>::const_iterator it =
-    physical_pb_type_index_offsets_.find(pb_type);
-  if (it != physical_pb_type_index_offsets_.end()) {
+  if (true == physical_pb_type_index_offset_annotated_[pb_type_id]) {
     VTR_LOG_WARN(
       "Override the annotation between operating pb_type '%s' and it physical "
       "pb_type index offset '%d'!\n",
       pb_type->name, offset);
   }
 
-  physical_pb_type_index_offsets_[pb_type] = offset;
+  physical_pb_type_index_offsets_[pb_type_id] = offset;
+  physical_pb_type_index_offset_annotated_[pb_type_id] = true;
 }
 
 void VprDeviceAnnotation::add_physical_pb_pin_initial_offset(
   t_port* operating_pb_port, t_port* physical_pb_port, const int& offset) {
+  PhysicalPbPortPair& port_pair =
+    find_or_create_physical_pb_port_pair(operating_pb_port, physical_pb_port);
   /* Warn any override attempt */
-  std::map<t_port*, std::map<t_port*, int>>::const_iterator it =
-    physical_pb_pin_initial_offsets_.find(operating_pb_port);
-  if ((it != physical_pb_pin_initial_offsets_.end()) &&
-      (0 < physical_pb_pin_initial_offsets_[operating_pb_port].count(
-             physical_pb_port))) {
+  if (true == port_pair.has_pin_initial_offset) {
     VTR_LOG_WARN(
       "Override the annotation between operating pb_port '%s' and it physical "
-      "pb_port '%s' pin rotate offset '%d'!\n",
-      operating_pb_port->name, offset);
+      "pb_port '%s' pin initial offset '%d'!\n",
+      operating_pb_port->name, physical_pb_port->name, offset);
   }
 
-  physical_pb_pin_initial_offsets_[operating_pb_port][physical_pb_port] =
-    offset;
+  port_pair.pin_initial_offset = offset;
+  port_pair.has_pin_initial_offset = true;
 }
 
 void VprDeviceAnnotation::add_physical_pb_port_rotate_offset(
   t_port* operating_pb_port, t_port* physical_pb_port, const int& offset) {
+  PhysicalPbPortPair& port_pair =
+    find_or_create_physical_pb_port_pair(operating_pb_port, physical_pb_port);
   /* Warn any override attempt */
-  std::map<t_port*, std::map<t_port*, int>>::const_iterator it =
-    physical_pb_port_rotate_offsets_.find(operating_pb_port);
-  if ((it != physical_pb_port_rotate_offsets_.end()) &&
-      (0 < physical_pb_port_rotate_offsets_[operating_pb_port].count(
-             physical_pb_port))) {
+  if (true == port_pair.has_port_rotate_offset) {
     VTR_LOG_WARN(
       "Override the annotation between operating pb_port '%s' and it physical "
       "pb_port '%s' port rotate offset '%d'!\n",
-      operating_pb_port->name, offset);
+      operating_pb_port->name, physical_pb_port->name, offset);
   }
 
-  physical_pb_port_rotate_offsets_[operating_pb_port][physical_pb_port] =
-    offset;
+  port_pair.port_rotate_offset = offset;
+  port_pair.has_port_rotate_offset = true;
   /* We initialize the accumulated offset to 0 */
-  physical_pb_port_offsets_[operating_pb_port][physical_pb_port] = 0;
+  port_pair.port_offset = 0;
 }
 
 void VprDeviceAnnotation::accumulate_physical_pb_port_rotate_offset(
   t_port* operating_pb_port, t_port* physical_pb_port) {
-  physical_pb_port_offsets_[operating_pb_port][physical_pb_port] +=
-    physical_pb_port_rotate_offsets_[operating_pb_port][physical_pb_port];
+  PhysicalPbPortPair& port_pair =
+    find_or_create_physical_pb_port_pair(operating_pb_port, physical_pb_port);
+  port_pair.port_offset += port_pair.port_rotate_offset;
 }
 
 void VprDeviceAnnotation::add_physical_pb_pin_rotate_offset(
   t_port* operating_pb_port, t_port* physical_pb_port, const int& offset) {
+  PhysicalPbPortPair& port_pair =
+    find_or_create_physical_pb_port_pair(operating_pb_port, physical_pb_port);
   /* Warn any override attempt */
-  std::map<t_port*, std::map<t_port*, int>>::const_iterator it =
-    physical_pb_pin_rotate_offsets_.find(operating_pb_port);
-  if ((it != physical_pb_pin_rotate_offsets_.end()) &&
-      (0 < physical_pb_pin_rotate_offsets_[operating_pb_port].count(
-             physical_pb_port))) {
+  if (true == port_pair.has_pin_rotate_offset) {
     VTR_LOG_WARN(
       "Override the annotation between operating pb_port '%s' and it physical "
       "pb_port '%s' pin rotate offset '%d'!\n",
-      operating_pb_port->name, offset);
+      operating_pb_port->name, physical_pb_port->name, offset);
   }
 
-  physical_pb_pin_rotate_offsets_[operating_pb_port][physical_pb_port] = offset;
+  port_pair.pin_rotate_offset = offset;
+  port_pair.has_pin_rotate_offset = true;
   /* We initialize the accumulated offset to 0 */
-  physical_pb_pin_offsets_[operating_pb_port][physical_pb_port] = 0;
+  port_pair.pin_offset = 0;
 }
 
 void VprDeviceAnnotation::add_physical_pb_graph_pin(
   const t_pb_graph_pin* operating_pb_graph_pin,
   t_pb_graph_pin* physical_pb_graph_pin) {
   /* Warn any override attempt */
-  std::map<const t_pb_graph_pin*, t_pb_graph_pin*>::const_iterator it =
-    physical_pb_graph_pins_.find(operating_pb_graph_pin);
-  if (it != physical_pb_graph_pins_.end()) {
+  if (0 < physical_pb_graph_pins_.count(operating_pb_graph_pin)) {
     VTR_LOG_WARN(
       "Override the annotation between operating pb_graph_pin '%s' and it "
       "physical pb_graph_pin '%s'!\n",
@@ -718,20 +656,14 @@ void VprDeviceAnnotation::add_physical_pb_graph_pin(
     return;
   }
 
-  physical_pb_pin_offsets_[operating_pb_graph_pin->port]
-                          [physical_pb_graph_pin->port] +=
-    physical_pb_pin_rotate_offset(operating_pb_graph_pin->port,
-                                  physical_pb_graph_pin->port);
+  PhysicalPbPortPair& port_pair = find_or_create_physical_pb_port_pair(
+    operating_pb_graph_pin->port, physical_pb_graph_pin->port);
+  port_pair.pin_offset += port_pair.pin_rotate_offset;
 
   if ((size_t)physical_pb_graph_pin->port->num_pins - 1 <
-      operating_pb_graph_pin->pin_number +
-        physical_pb_port_range(operating_pb_graph_pin->port,
-                               physical_pb_graph_pin->port)
-          .get_lsb() +
-        physical_pb_pin_offsets_[operating_pb_graph_pin->port]
-                                [physical_pb_graph_pin->port]) {
-    physical_pb_pin_offsets_[operating_pb_graph_pin->port]
-                            [physical_pb_graph_pin->port] = 0;
+      operating_pb_graph_pin->pin_number + port_pair.port_range.get_lsb() +
+        port_pair.pin_offset) {
+    port_pair.pin_offset = 0;
   }
 }
 
@@ -814,4 +746,119 @@ void VprDeviceAnnotation::add_physical_tile_z_to_start_pin_index(
     start_pin_index;
 }
 
+/************************************************************************
+ * Internal utility
+ ***********************************************************************/
+VprPbTypeId VprDeviceAnnotation::find_pb_type_id(t_pb_type* pb_type) const {
+  auto it = pb_type_ids_.find(pb_type);
+  if (it == pb_type_ids_.end()) {
+    return VprPbTypeId::INVALID();
+  }
+  return it->second;
+}
+
+VprPbPortId VprDeviceAnnotation::find_pb_port_id(t_port* pb_port) const {
+  auto it = pb_port_ids_.find(pb_port);
+  if (it == pb_port_ids_.end()) {
+    return VprPbPortId::INVALID();
+  }
+  return it->second;
+}
+
+VprInterconnectId VprDeviceAnnotation::find_interconnect_id(
+  t_interconnect* pb_interconnect) const {
+  auto it = interconnect_ids_.find(pb_interconnect);
+  if (it == interconnect_ids_.end()) {
+    return VprInterconnectId::INVALID();
+  }
+  return it->second;
+}
+
+VprPbTypeId VprDeviceAnnotation::find_or_create_pb_type_id(
+  t_pb_type* pb_type) {
+  VprPbTypeId pb_type_id = find_pb_type_id(pb_type);
+  if (VprPbTypeId::INVALID() != pb_type_id) {
+    return pb_type_id;
+  }
+
+  /* Assign the next dense index and allocate the annotations with the
+   * default values of the accessors */
+  pb_type_id = VprPbTypeId(physical_pb_types_.size());
+  pb_type_ids_[pb_type] = pb_type_id;
+  physical_pb_types_.push_back(nullptr);
+  physical_pb_type_index_factors_.push_back(1.);
+  physical_pb_type_index_factor_annotated_.push_back(false);
+  physical_pb_type_index_offsets_.push_back(0);
+  physical_pb_type_index_offset_annotated_.push_back(false);
+  physical_pb_modes_.push_back(nullptr);
+  pb_type_circuit_models_.push_back(CircuitModelId::INVALID());
+  pb_type_mode_bits_.emplace_back();
+  pb_type_mode_bits_annotated_.push_back(false);
+  pb_graph_node_unique_index_.emplace_back();
+
+  return pb_type_id;
+}
+
+VprPbPortId VprDeviceAnnotation::find_or_create_pb_port_id(t_port* pb_port) {
+  VprPbPortId pb_port_id = find_pb_port_id(pb_port);
+  if (VprPbPortId::INVALID() != pb_port_id) {
+    return pb_port_id;
+  }
+
+  pb_port_id = VprPbPortId(physical_pb_ports_.size());
+  pb_port_ids_[pb_port] = pb_port_id;
+  physical_pb_ports_.emplace_back();
+  physical_pb_port_pairs_.emplace_back();
+  pb_circuit_ports_.push_back(CircuitPortId::INVALID());
+
+  return pb_port_id;
+}
+
+VprInterconnectId VprDeviceAnnotation::find_or_create_interconnect_id(
+  t_interconnect* pb_interconnect) {
+  VprInterconnectId interc_id = find_interconnect_id(pb_interconnect);
+  if (VprInterconnectId::INVALID() != interc_id) {
+    return interc_id;
+  }
+
+  interc_id = VprInterconnectId(interconnect_circuit_models_.size());
+  interconnect_ids_[pb_interconnect] = interc_id;
+  interconnect_circuit_models_.push_back(CircuitModelId::INVALID());
+  interconnect_physical_types_.push_back(NUM_INTERC_TYPES);
+
+  return interc_id;
+}
+
+const VprDeviceAnnotation::PhysicalPbPortPair*
+VprDeviceAnnotation::find_physical_pb_port_pair(
+  t_port* operating_pb_port, t_port* physical_pb_port) const {
+  VprPbPortId pb_port_id = find_pb_port_id(operating_pb_port);
+  if (VprPbPortId::INVALID() == pb_port_id) {
+    return nullptr;
+  }
+  for (const PhysicalPbPortPair& port_pair :
+       physical_pb_port_pairs_[pb_port_id]) {
+    if (physical_pb_port == port_pair.physical_pb_port) {
+      return &port_pair;
+    }
+  }
+  return nullptr;
+}
+
+VprDeviceAnnotation::PhysicalPbPortPair&
+VprDeviceAnnotation::find_or_create_physical_pb_port_pair(
+  t_port* operating_pb_port, t_port* physical_pb_port) {
+  VprPbPortId pb_port_id = find_or_create_pb_port_id(operating_pb_port);
+  std::vector<PhysicalPbPortPair>& port_pairs =
+    physical_pb_port_pairs_[pb_port_id];
+  for (PhysicalPbPortPair& port_pair : port_pairs) {
+    if (physical_pb_port == port_pair.physical_pb_port) {
+      return port_pair;
+    }
+  }
+  port_pairs.emplace_back();
+  port_pairs.back().physical_pb_port = physical_pb_port;
+  return port_pairs.back();
+}
+
 } /* End namespace openfpga*/
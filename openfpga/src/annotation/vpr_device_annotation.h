@@ -5,9 +5,11 @@
  * Include header files required by the data structure definition
  *******************************************************************/
 #include <map>
+#include <unordered_map>
 
 /* Header from vtrutil library */
 #include "vtr_strong_id.h"
+#include "vtr_vector.h"
 
 /* Header from archfpga library */
 #include "physical_types.h"
@@ -26,6 +28,16 @@ struct pb_graph_node_id_tag;
 
 typedef vtr::StrongId<pb_graph_node_id_tag> PbGraphNodeId;
 
+/* Dense indices of the pb_types, pb_ports and interconnects which are
+ * annotated, so that the annotations are stored in flat arrays */
+struct vpr_pb_type_id_tag;
+struct vpr_pb_port_id_tag;
+struct vpr_interconnect_id_tag;
+
+typedef vtr::StrongId<vpr_pb_type_id_tag> VprPbTypeId;
+typedef vtr::StrongId<vpr_pb_port_id_tag> VprPbPortId;
+typedef vtr::StrongId<vpr_interconnect_id_tag> VprInterconnectId;
+
 /********************************************************************
  * This is the critical data structure to link the pb_type in VPR
  * to openfpga annotations
@@ -156,36 +168,81 @@ class VprDeviceAnnotation {
     t_physical_tile_type_ptr physical_tile, const int& subtile_z,
     const int& start_pin_index);
 
+ private: /* Internal data types */
+  /* Annotation between an operating pb_port and one of its physical pb_ports
+   */
+  struct PhysicalPbPortPair {
+    t_port* physical_pb_port = nullptr;
+    BasicPort port_range;
+    bool has_port_range = false;
+    int pin_initial_offset = 0;
+    bool has_pin_initial_offset = false;
+    int pin_rotate_offset = 0;
+    bool has_pin_rotate_offset = false;
+    int port_rotate_offset = 0;
+    bool has_port_rotate_offset = false;
+    /* Accumulated offsets, just for internal usage */
+    int port_offset = 0;
+    int pin_offset = 0;
+  };
+
+ private: /* Internal utility */
+  /* Find the dense index of a pb_type/pb_port/interconnect, return an invalid
+   * id if it has never been annotated */
+  VprPbTypeId find_pb_type_id(t_pb_type* pb_type) const;
+  VprPbPortId find_pb_port_id(t_port* pb_port) const;
+  VprInterconnectId find_interconnect_id(t_interconnect* pb_interconnect) const;
+  /* Assign a dense index to a pb_type/pb_port/interconnect if it does not
+   * have one yet, and allocate its annotations */
+  VprPbTypeId find_or_create_pb_type_id(t_pb_type* pb_type);
+  VprPbPortId find_or_create_pb_port_id(t_port* pb_port);
+  VprInterconnectId find_or_create_interconnect_id(
+    t_interconnect* pb_interconnect);
+  /* Find the annotation between a pair of pb_ports, return a null pointer if
+   * the pair has never been annotated */
+  const PhysicalPbPortPair* find_physical_pb_port_pair(
+    t_port* operating_pb_port, t_port* physical_pb_port) const;
+  PhysicalPbPortPair& find_or_create_physical_pb_port_pair(
+    t_port* operating_pb_port, t_port* physical_pb_port);
+
  private: /* Internal data */
+  /* Fast look-ups to the dense indices. The annotations below are stored in
+   * flat arrays which are indexed by the dense indices */
+  std::unordered_map<t_pb_type*, VprPbTypeId> pb_type_ids_;
+  std::unordered_map<t_port*, VprPbPortId> pb_port_ids_;
+  std::unordered_map<t_interconnect*, VprInterconnectId> interconnect_ids_;
+
   /* Pair a regular pb_type to its physical pb_type */
-  std::map<t_pb_type*, t_pb_type*> physical_pb_types_;
-  std::map<t_pb_type*, float> physical_pb_type_index_factors_;
-  std::map<t_pb_type*, int> physical_pb_type_index_offsets_;
+  vtr::vector<VprPbTypeId, t_pb_type*> physical_pb_types_;
+  vtr::vector<VprPbTypeId, float> physical_pb_type_index_factors_;
+  vtr::vector<VprPbTypeId, bool> physical_pb_type_index_factor_annotated_;
+  vtr::vector<VprPbTypeId, int> physical_pb_type_index_offsets_;
+  vtr::vector<VprPbTypeId, bool> physical_pb_type_index_offset_annotated_;
 
   /* Pair a physical mode for a pb_type
    * Note:
    * - the physical mode MUST be a child mode of the pb_type
    * - the pb_type MUST be a physical pb_type itself
    */
-  std::map<t_pb_type*, t_mode*> physical_pb_modes_;
+  vtr::vector<VprPbTypeId, t_mode*> physical_pb_modes_;
 
   /* Pair a physical pb_type to its circuit model
    * Note:
    * - the pb_type MUST be a physical pb_type itself
    */
-  std::map<t_pb_type*, CircuitModelId> pb_type_circuit_models_;
+  vtr::vector<VprPbTypeId, CircuitModelId> pb_type_circuit_models_;
 
   /* Pair a interconnect of a physical pb_type to its circuit model
    * Note:
    * - the pb_type MUST be a physical pb_type itself
    */
-  std::map<t_interconnect*, CircuitModelId> interconnect_circuit_models_;
+  vtr::vector<VprInterconnectId, CircuitModelId> interconnect_circuit_models_;
 
   /* Physical type of interconnect
    * Note:
    * - only applicable to an interconnect belongs to physical mode
    */
-  std::map<t_interconnect*, e_interconnect> interconnect_physical_types_;
+  vtr::vector<VprInterconnectId, e_interconnect> interconnect_physical_types_;
 
   /* Pair a pb_type to its mode selection bits
    * - if the pb_type is a physical pb_type, the mode bits are the default mode
@@ -193,48 +250,47 @@ class VprDeviceAnnotation {
    * - if the pb_type is an operating pb_type, the mode bits will be applied
    *   when the operating pb_type is used by packer
    */
-  std::map<t_pb_type*, std::vector<size_t>> pb_type_mode_bits_;
+  vtr::vector<VprPbTypeId, std::vector<size_t>> pb_type_mode_bits_;
+  vtr::vector<VprPbTypeId, bool> pb_type_mode_bits_annotated_;
 
   /* Pair a pb_port to its physical pb_port
    * Note:
    * - the parent of physical pb_port MUST be a physical pb_type
    */
-  std::map<t_port*, std::vector<t_port*>> physical_pb_ports_;
-  std::map<t_port*, std::map<t_port*, int>> physical_pb_pin_initial_offsets_;
-  std::map<t_port*, std::map<t_port*, int>> physical_pb_pin_rotate_offsets_;
-  std::map<t_port*, std::map<t_port*, int>> physical_pb_port_rotate_offsets_;
-
-  /* Accumulated offsets for a physical pb port, just for internal usage */
-  std::map<t_port*, std::map<t_port*, int>> physical_pb_port_offsets_;
-  /* Accumulated offsets for a physical pb_graph_pin, just for internal usage */
-  std::map<t_port*, std::map<t_port*, int>> physical_pb_pin_offsets_;
-
-  /* Pair a pb_port to its LSB and MSB of a physical pb_port
-   * Note:
-   * - the LSB and MSB MUST be in range of the physical pb_port
+  vtr::vector<VprPbPortId, std::vector<t_port*>> physical_pb_ports_;
+
+  /* Annotations between a pb_port and its physical pb_ports, including
+   * - the LSB and MSB of the physical pb_port, which MUST be in range of the
+   *   physical pb_port
+   * - the initial/rotate offsets of pins and ports
+   * There are only a few physical pb_ports per pb_port, so the pairs are
+   * stored in a short list per pb_port
    */
-  std::map<t_port*, std::map<t_port*, BasicPort>> physical_pb_port_ranges_;
+  vtr::vector<VprPbPortId, std::vector<PhysicalPbPortPair>>
+    physical_pb_port_pairs_;
 
   /* Pair a pb_port to a circuit port in circuit model
    * Note:
    * - the parent of physical pb_port MUST be a physical pb_type
    */
-  std::map<t_port*, CircuitPortId> pb_circuit_ports_;
+  vtr::vector<VprPbPortId, CircuitPortId> pb_circuit_ports_;
 
   /* Pair each pb_graph_node to an unique index in the graph
    * The unique index if the index in the array of t_pb_graph_node*
    */
-  std::map<t_pb_type*, std::vector<t_pb_graph_node*>>
+  vtr::vector<VprPbTypeId, std::vector<t_pb_graph_node*>>
     pb_graph_node_unique_index_;
 
   /* Pair a pb_graph_node to a physical pb_graph_node
    * Note:
    * - the pb_type of physical pb_graph_node must be a physical pb_type
    */
-  std::map<t_pb_graph_node*, t_pb_graph_node*> physical_pb_graph_nodes_;
+  std::unordered_map<t_pb_graph_node*, t_pb_graph_node*>
+    physical_pb_graph_nodes_;
 
   /* Pair a pb_graph_pin to a physical pb_graph_pin */
-  std::map<const t_pb_graph_pin*, t_pb_graph_pin*> physical_pb_graph_pins_;
+  std::unordered_map<const t_pb_graph_pin*, t_pb_graph_pin*>
+    physical_pb_graph_pins_;
 
   /* Pair a Routing Resource Switch (rr_switch) to a circuit model */
   std::map<RRSwitchId, CircuitModelId> rr_switch_circuit_models_;
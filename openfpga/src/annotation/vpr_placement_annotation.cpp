@@ -16,38 +16,65 @@ namespace openfpga {
 /************************************************************************
  * Public accessors
  ***********************************************************************/
-std::vector<ClusterBlockId> VprPlacementAnnotation::grid_blocks(
+VprPlacementAnnotation::grid_block_range VprPlacementAnnotation::grid_blocks(
   const vtr::Point<size_t>& grid_coord) const {
-  return blocks_[grid_coord.x()][grid_coord.y()];
+  size_t grid_id = grid_index(grid_coord);
+  return vtr::make_range(blocks_.begin() + grid_block_offsets_[grid_id],
+                         blocks_.begin() + grid_block_offsets_[grid_id + 1]);
+}
+
+ClusterBlockId VprPlacementAnnotation::grid_block(
+  const vtr::Point<size_t>& grid_coord, const size_t& z) const {
+  size_t grid_id = grid_index(grid_coord);
+  VTR_ASSERT(grid_block_offsets_[grid_id] + z <
+             grid_block_offsets_[grid_id + 1]);
+  return blocks_[grid_block_offsets_[grid_id] + z];
 }
 
 /************************************************************************
  * Public mutators
  ***********************************************************************/
 void VprPlacementAnnotation::init_mapped_blocks(const DeviceGrid& grids) {
-  /* Size the block array with grid sizes */
-  blocks_.resize({grids.width(), grids.height()});
+  grid_height_ = grids.height();
 
-  /* Resize the number of blocks allowed per grid by the capacity of the type */
+  /* Reserve a number of blocks per grid by the capacity of the type */
+  grid_block_offsets_.clear();
+  grid_block_offsets_.reserve(grids.width() * grids.height() + 1);
+  grid_block_offsets_.push_back(0);
   for (size_t x = 0; x < grids.width(); ++x) {
     for (size_t y = 0; y < grids.height(); ++y) {
-      /* Deposit invalid ids and we will fill later */
-      blocks_[x][y].resize(
-        grids.get_physical_type(t_physical_tile_loc(x, y, 0))->capacity,
-        ClusterBlockId::INVALID());
+      grid_block_offsets_.push_back(
+        grid_block_offsets_.back() +
+        grids.get_physical_type(t_physical_tile_loc(x, y, 0))->capacity);
     }
   }
+
+  /* Deposit invalid ids and we will fill later */
+  blocks_.assign(grid_block_offsets_.back(), ClusterBlockId::INVALID());
 }
 
 void VprPlacementAnnotation::add_mapped_block(
   const vtr::Point<size_t>& grid_coord, const size_t& z,
   const ClusterBlockId& mapped_block) {
-  VTR_ASSERT(z < grid_blocks(grid_coord).size());
-  if (ClusterBlockId::INVALID() != blocks_[grid_coord.x()][grid_coord.y()][z]) {
+  size_t grid_id = grid_index(grid_coord);
+  size_t block_id = grid_block_offsets_[grid_id] + z;
+  VTR_ASSERT(block_id < grid_block_offsets_[grid_id + 1]);
+  if (ClusterBlockId::INVALID() != blocks_[block_id]) {
     VTR_LOG("Override mapped blocks at grid[%lu][%lu][%lu]!\n", grid_coord.x(),
             grid_coord.y(), z);
   }
-  blocks_[grid_coord.x()][grid_coord.y()][z] = mapped_block;
+  blocks_[block_id] = mapped_block;
+}
+
+/************************************************************************
+ * Internal utility
+ ***********************************************************************/
+size_t VprPlacementAnnotation::grid_index(
+  const vtr::Point<size_t>& grid_coord) const {
+  VTR_ASSERT(grid_coord.y() < grid_height_);
+  size_t grid_id = grid_coord.x() * grid_height_ + grid_coord.y();
+  VTR_ASSERT(grid_id + 1 < grid_block_offsets_.size());
+  return grid_id;
 }
 
 } /* End namespace openfpga*/
@@ -5,9 +5,11 @@
  * Include header files required by the data structure definition
  *******************************************************************/
 #include <map>
+#include <vector>
 
 /* Header from vtrutil library */
 #include "vtr_geometry.h"
+#include "vtr_range.h"
 
 /* Header from vpr library */
 #include "clustered_netlist.h"
@@ -21,15 +23,24 @@ namespace openfpga {
  * in VPR context
  *******************************************************************/
 class VprPlacementAnnotation {
+ public: /* Types */
+  typedef std::vector<ClusterBlockId>::const_iterator grid_block_iterator;
+  typedef vtr::Range<grid_block_iterator> grid_block_range;
+
  public: /* Public accessors */
-  std::vector<ClusterBlockId> grid_blocks(
-    const vtr::Point<size_t>& grid_coord) const;
+  /* The blocks of a grid, indexed by z, which are contiguous in memory */
+  grid_block_range grid_blocks(const vtr::Point<size_t>& grid_coord) const;
+  ClusterBlockId grid_block(const vtr::Point<size_t>& grid_coord,
+                            const size_t& z) const;
 
  public: /* Public mutators */
   void init_mapped_blocks(const DeviceGrid& grids);
   void add_mapped_block(const vtr::Point<size_t>& grid_coord, const size_t& z,
                         const ClusterBlockId& mapped_block);
 
+ private: /* Internal utility */
+  size_t grid_index(const vtr::Point<size_t>& grid_coord) const;
+
  private: /* Internal data */
   /* A direct mapping show each mapped/unmapped blocks in grids
    * The blocks_ array represents each grid on the FPGA fabric
@@ -42,8 +53,14 @@ class VprPlacementAnnotation {
    * VPR considers only mapped blocks while this annotation
    * considers both unmapped and mapped blocks
    * Unmapped blocks will be labelled as an invalid id in the vector
+   *
+   * The blocks of all the grids are stored in a single array, grid by grid
+   * in the order of grid_index(), i.e., column by column. The blocks of a
+   * grid are in the range [grid_block_offsets_[i], grid_block_offsets_[i + 1])
    */
-  vtr::Matrix<std::vector<ClusterBlockId>> blocks_;
+  size_t grid_height_ = 0;
+  std::vector<size_t> grid_block_offsets_;
+  std::vector<ClusterBlockId> blocks_;
 };
 
 } /* End namespace openfpga*/
@@ -30,6 +30,12 @@ RRNodeId VprRoutingAnnotation::rr_node_prev_node(
   return rr_node_prev_nodes_[rr_node];
 }
 
+MemoryUsage VprRoutingAnnotation::memory_usage() const {
+  MemoryUsage usage = heap_memory_usage(rr_node_nets_);
+  usage += heap_memory_usage(rr_node_prev_nodes_);
+  return usage;
+}
+
 /************************************************************************
  * Public mutators
  ***********************************************************************/
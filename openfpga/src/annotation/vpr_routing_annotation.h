@@ -8,6 +8,7 @@
 
 /* Header from vpr library */
 #include "clustered_netlist_fwd.h"
+#include "openfpga_memory_usage.h"
 #include "rr_graph_view.h"
 #include "vtr_vector.h"
 
@@ -31,6 +32,9 @@ class VprRoutingAnnotation {
   ClusterNetId rr_node_net(const RRNodeId& rr_node) const;
   RRNodeId rr_node_prev_node(const RRNodeId& rr_node) const;
 
+  /* Approximate heap memory used by the data structure */
+  MemoryUsage memory_usage() const;
+
  public: /* Public mutators */
   void init(const RRGraphView& rr_graph);
   void set_rr_node_net(const RRNodeId& rr_node, const ClusterNetId& net_id);
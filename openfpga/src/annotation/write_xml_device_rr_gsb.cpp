@@ -1,6 +1,11 @@
 /***************************************************************************************
  * Output internal structure of DeviceRRGSB to XML format
  ***************************************************************************************/
+#include <algorithm>
+#include <fstream>
+#include <map>
+#include <sstream>
+
 /* Headers from vtrutil library */
 #include "vtr_assert.h"
 #include "vtr_log.h"
@@ -10,6 +15,7 @@
 #include "build_routing_module_utils.h"
 #include "openfpga_digest.h"
 #include "openfpga_naming.h"
+#include "openfpga_parallel.h"
 #include "openfpga_rr_graph_utils.h"
 #include "openfpga_side_manager.h"
 #include "write_xml_device_rr_gsb.h"
@@ -21,14 +27,11 @@ namespace openfpga {
  * Output the input pin of Programmable Blocks, e.g., CLBs inside a GSB to XML
  *format
  ***************************************************************************************/
-static void write_rr_gsb_ipin_connection_to_xml(std::fstream& fp,
+static void write_rr_gsb_ipin_connection_to_xml(std::ostream& fp,
                                                 const RRGraphView& rr_graph,
                                                 const RRGSB& rr_gsb,
                                                 const enum e_side& gsb_side,
                                                 const bool& include_rr_info) {
-  /* Validate the file stream */
-  valid_file_stream(fp);
-
   SideManager gsb_side_manager(gsb_side);
 
   for (size_t inode = 0; inode < rr_gsb.get_num_ipin_nodes(gsb_side); ++inode) {
@@ -41,7 +44,7 @@ static void write_rr_gsb_ipin_connection_to_xml(std::fstream& fp,
     }
     std::vector<RREdgeId> driver_rr_edges =
       rr_gsb.get_ipin_node_in_edges(rr_graph, gsb_side, inode);
-    fp << "\" mux_size=\"" << driver_rr_edges.size() << "\">" << std::endl;
+    fp << "\" mux_size=\"" << driver_rr_edges.size() << "\">\n";
     /* General information of each driving nodes */
     for (const RREdgeId& edge : driver_rr_edges) {
       RRNodeId driver_node = rr_graph.edge_src_node(edge);
@@ -72,10 +75,9 @@ static void write_rr_gsb_ipin_connection_to_xml(std::fstream& fp,
         fp << "\" node_id=\"" << size_t(driver_node);
       }
       fp << "\" index=\"" << driver_node_index << "\" segment_id=\""
-         << size_t(des_segment_id) << "\"/>" << std::endl;
+         << size_t(des_segment_id) << "\"/>\n";
     }
-    fp << "\t</" << rr_node_typename[rr_graph.node_type(cur_rr_node)] << ">"
-       << std::endl;
+    fp << "\t</" << rr_node_typename[rr_graph.node_type(cur_rr_node)] << ">\n";
   }
 }
 
@@ -83,13 +85,10 @@ static void write_rr_gsb_ipin_connection_to_xml(std::fstream& fp,
  * Output the routing tracks connections inside a GSB to XML format
  ***************************************************************************************/
 static void write_rr_gsb_chan_connection_to_xml(
-  std::fstream& fp, const DeviceGrid& vpr_device_grid,
+  std::ostream& fp, const DeviceGrid& vpr_device_grid,
   const VprDeviceAnnotation& vpr_device_annotation, const RRGraphView& rr_graph,
   const RRGSB& rr_gsb, const enum e_side& gsb_side,
   const bool& include_rr_info) {
-  /* Validate the file stream */
-  valid_file_stream(fp);
-
   SideManager gsb_side_manager(gsb_side);
 
   /* Output chan nodes */
@@ -128,7 +127,7 @@ static void write_rr_gsb_chan_connection_to_xml(
          << generate_sb_module_track_port_name(cur_node_type, gsb_side,
                                                OUT_PORT);
     }
-    fp << "\">" << std::endl;
+    fp << "\">\n";
 
     /* Direct connection: output the node on the opposite side */
     if (0 == driver_rr_edges.size()) {
@@ -145,7 +144,7 @@ static void write_rr_gsb_chan_connection_to_xml(
            << generate_sb_module_track_port_name(cur_node_type,
                                                  oppo_side.get_side(), IN_PORT);
       }
-      fp << "\"/>" << std::endl;
+      fp << "\"/>\n";
     } else {
       for (const RREdgeId& driver_rr_edge : driver_rr_edges) {
         const RRNodeId& driver_rr_node = rr_graph.edge_src_node(driver_rr_edge);
@@ -169,7 +168,7 @@ static void write_rr_gsb_chan_connection_to_xml(
                     gsb_side, driver_node_side, vpr_device_grid,
                     vpr_device_annotation, rr_graph, driver_rr_node);
           }
-          fp << "\"/>" << std::endl;
+          fp << "\"/>\n";
         } else {
           const RRSegmentId& des_segment_id =
             rr_gsb.get_chan_node_segment(driver_node_side, driver_node_index);
@@ -187,12 +186,11 @@ static void write_rr_gsb_chan_connection_to_xml(
                     rr_graph.node_type(driver_rr_node), driver_side.get_side(),
                     IN_PORT);
           }
-          fp << "\"/>" << std::endl;
+          fp << "\"/>\n";
         }
       }
     }
-    fp << "\t</" << rr_node_typename[rr_graph.node_type(cur_rr_node)] << ">"
-       << std::endl;
+    fp << "\t</" << rr_node_typename[rr_graph.node_type(cur_rr_node)] << ">\n";
   }
 }
 
@@ -201,40 +199,12 @@ static void write_rr_gsb_chan_connection_to_xml(
  *format
  ***************************************************************************************/
 static void write_rr_switch_block_to_xml(
-  const std::string fname_prefix, const DeviceGrid& vpr_device_grid,
+  std::ostream& fp, const DeviceGrid& vpr_device_grid,
   const VprDeviceAnnotation& vpr_device_annotation, const RRGraphView& rr_graph,
-  const RRGSB& rr_gsb, const RRGSBWriterOption& options) {
-  /* Prepare file name */
-  std::string fname(fname_prefix);
-  vtr::Point<size_t> sb_coordinate(rr_gsb.get_sb_x(), rr_gsb.get_sb_y());
-  std::string curr_sb_name = generate_switch_block_module_name(sb_coordinate);
-  fname += curr_sb_name;
-  fname += ".xml";
-
-  /* If there is a list of gsb list, we skip those which are not in the list */
-  std::vector<std::string> include_gsb_names = options.include_gsb_names();
-  if (!include_gsb_names.empty() &&
-      include_gsb_names.end() == std::find(include_gsb_names.begin(),
-                                           include_gsb_names.end(),
-                                           curr_sb_name)) {
-    return;
-  }
-
-  VTR_LOGV(options.verbose_output(),
-           "Output internal structure of Switch Block to '%s'\n",
-           fname.c_str());
-
-  /* Create a file handler*/
-  std::fstream fp;
-  /* Open a file */
-  fp.open(fname, std::fstream::out | std::fstream::trunc);
-
-  /* Validate the file stream */
-  check_file_stream(fname.c_str(), fp);
-
+  const RRGSB& rr_gsb, const bool& include_rr_info) {
   /* Output location of the Switch Block */
   fp << "<rr_sb x=\"" << rr_gsb.get_x() << "\" y=\"" << rr_gsb.get_y() << "\""
-     << " num_sides=\"" << rr_gsb.get_num_sides() << "\">" << std::endl;
+     << " num_sides=\"" << rr_gsb.get_num_sides() << "\">\n";
 
   /* Output each side */
   for (size_t side = 0; side < rr_gsb.get_num_sides(); ++side) {
@@ -244,81 +214,93 @@ static void write_rr_switch_block_to_xml(
     /* routing-track and related connections */
     write_rr_gsb_chan_connection_to_xml(fp, vpr_device_grid,
                                         vpr_device_annotation, rr_graph, rr_gsb,
-                                        gsb_side, options.include_rr_info());
+                                        gsb_side, include_rr_info);
   }
 
-  fp << "</rr_sb>" << std::endl;
-
-  /* close a file */
-  fp.close();
+  fp << "</rr_sb>\n";
 }
 
 /***************************************************************************************
  * Output internal structure (only the connection block part) of a RRGSB to XML
  *format
  ***************************************************************************************/
-static void write_rr_connection_block_to_xml(const std::string fname_prefix,
+static void write_rr_connection_block_to_xml(std::ostream& fp,
                                              const RRGraphView& rr_graph,
                                              const RRGSB& rr_gsb,
                                              const t_rr_type& cb_type,
-                                             const RRGSBWriterOption& options) {
-  /* Prepare file name */
-  std::string fname(fname_prefix);
-  vtr::Point<size_t> cb_coordinate(rr_gsb.get_cb_x(cb_type),
-                                   rr_gsb.get_cb_y(cb_type));
-  std::string curr_cb_name =
-    generate_connection_block_module_name(cb_type, cb_coordinate);
-  fname += curr_cb_name;
-  fname += ".xml";
-
-  /* If there is a list of gsb list, we skip those which are not in the list */
-  std::vector<std::string> include_gsb_names = options.include_gsb_names();
-  if (!include_gsb_names.empty() &&
-      include_gsb_names.end() == std::find(include_gsb_names.begin(),
-                                           include_gsb_names.end(),
-                                           curr_cb_name)) {
-    return;
-  }
-
-  VTR_LOGV(options.verbose_output(),
-           "Output internal structure of Connection Block to '%s'\n",
-           fname.c_str());
-
-  /* Create a file handler*/
-  std::fstream fp;
-  /* Open a file */
-  fp.open(fname, std::fstream::out | std::fstream::trunc);
-
-  /* Validate the file stream */
-  check_file_stream(fname.c_str(), fp);
-
-  /* Output location of the Switch Block */
+                                             const bool& include_rr_info) {
+  /* Output location of the Connection Block */
   fp << "<rr_cb x=\"" << rr_gsb.get_cb_x(cb_type) << "\" y=\""
      << rr_gsb.get_cb_y(cb_type) << "\""
-     << " num_sides=\"" << rr_gsb.get_num_sides() << "\">" << std::endl;
+     << " num_sides=\"" << rr_gsb.get_num_sides() << "\">\n";
 
   /* Output each side */
   for (e_side side : rr_gsb.get_cb_ipin_sides(cb_type)) {
     /* IPIN nodes and related connections */
     write_rr_gsb_ipin_connection_to_xml(fp, rr_graph, rr_gsb, side,
-                                        options.include_rr_info());
+                                        include_rr_info);
   }
 
-  fp << "</rr_cb>" << std::endl;
+  fp << "</rr_cb>\n";
+}
 
-  /* close a file */
-  fp.close();
+/***************************************************************************************
+ * A switch block or a connection block of a RRGSB to be written
+ * - The type of a switch block is NUM_RR_TYPES
+ * - The type of a connection block is either CHANX or CHANY
+ ***************************************************************************************/
+struct RRGSBXmlBlock {
+  const RRGSB* rr_gsb;
+  t_rr_type type;
+  std::string name;
+};
+
+static std::string rr_gsb_xml_block_name(const RRGSB& rr_gsb,
+                                         const t_rr_type& type) {
+  if (NUM_RR_TYPES == type) {
+    vtr::Point<size_t> sb_coordinate(rr_gsb.get_sb_x(), rr_gsb.get_sb_y());
+    return generate_switch_block_module_name(sb_coordinate);
+  }
+  vtr::Point<size_t> cb_coordinate(rr_gsb.get_cb_x(type),
+                                   rr_gsb.get_cb_y(type));
+  return generate_connection_block_module_name(type, cb_coordinate);
+}
+
+/***************************************************************************************
+ * Format a block into a buffer, so that a file is written by a single call
+ ***************************************************************************************/
+static std::string write_rr_gsb_xml_block_to_string(
+  const DeviceGrid& vpr_device_grid,
+  const VprDeviceAnnotation& vpr_device_annotation, const RRGraphView& rr_graph,
+  const RRGSBXmlBlock& block, const bool& include_rr_info) {
+  std::ostringstream buffer;
+  if (NUM_RR_TYPES == block.type) {
+    write_rr_switch_block_to_xml(buffer, vpr_device_grid, vpr_device_annotation,
+                                 rr_graph, *block.rr_gsb, include_rr_info);
+  } else {
+    write_rr_connection_block_to_xml(buffer, rr_graph, *block.rr_gsb,
+                                     block.type, include_rr_info);
+  }
+  return buffer.str();
 }
 
 /***************************************************************************************
  * Output internal structure (only the switch block part) of all the RRGSBs
  * in a DeviceRRGSB  to XML format
+ * - By default, each block is written to an XML file under the output
+ *   directory, named after the block
+ * - When a single file is required, all the blocks are written to the XML
+ *   file given as the output directory, under a <rr_gsbs> element
+ * Blocks are formatted in parallel, in the same order as they are listed
  ***************************************************************************************/
 void write_device_rr_gsb_to_xml(
   const DeviceGrid& vpr_device_grid,
   const VprDeviceAnnotation& vpr_device_annotation, const RRGraphView& rr_graph,
   const DeviceRRGSB& device_rr_gsb, const RRGSBWriterOption& options) {
   std::string xml_dir_name = format_dir_path(options.output_directory());
+  if (options.single_file()) {
+    xml_dir_name = find_path_dir_name(options.output_directory());
+  }
 
   /* Create directories */
   create_directory(xml_dir_name);
@@ -330,9 +312,8 @@ void write_device_rr_gsb_to_xml(
   std::map<t_rr_type, std::string> cb_names = {{CHANX, "X-direction"},
                                                {CHANY, "Y-direction"}};
 
-  std::vector<std::string> include_gsb_names = options.include_gsb_names();
-
-  /* For each switch block, an XML file will be outputted */
+  /* Find all the blocks to be written */
+  std::vector<RRGSBXmlBlock> blocks;
   if (options.unique_module_only()) {
     /* Only output unique GSB modules */
     VTR_LOG("Only output unique GSB modules to XML\n");
@@ -341,9 +322,7 @@ void write_device_rr_gsb_to_xml(
       const RRGSB& rr_gsb = device_rr_gsb.get_sb_unique_module(igsb);
       /* Write CBx, CBy, SB on need */
       if (options.include_sb_content()) {
-        write_rr_switch_block_to_xml(xml_dir_name, vpr_device_grid,
-                                     vpr_device_annotation, rr_graph, rr_gsb,
-                                     options);
+        blocks.push_back({&rr_gsb, NUM_RR_TYPES, std::string()});
       }
       sb_counter++;
     }
@@ -352,8 +331,7 @@ void write_device_rr_gsb_to_xml(
            igsb < device_rr_gsb.get_num_cb_unique_module(cb_type); ++igsb) {
         const RRGSB& rr_gsb = device_rr_gsb.get_cb_unique_module(cb_type, igsb);
         if (options.include_cb_content(cb_type)) {
-          write_rr_connection_block_to_xml(xml_dir_name, rr_graph, rr_gsb,
-                                           cb_type, options);
+          blocks.push_back({&rr_gsb, cb_type, std::string()});
           cb_counters[cb_type]++;
         }
       }
@@ -366,15 +344,12 @@ void write_device_rr_gsb_to_xml(
         const RRGSB& rr_gsb = device_rr_gsb.get_gsb(ix, iy);
         /* Write CBx, CBy, SB on need */
         if (options.include_sb_content()) {
-          write_rr_switch_block_to_xml(xml_dir_name, vpr_device_grid,
-                                       vpr_device_annotation, rr_graph, rr_gsb,
-                                       options);
+          blocks.push_back({&rr_gsb, NUM_RR_TYPES, std::string()});
           sb_counter++;
         }
         for (t_rr_type cb_type : {CHANX, CHANY}) {
           if (options.include_cb_content(cb_type)) {
-            write_rr_connection_block_to_xml(xml_dir_name, rr_graph, rr_gsb,
-                                             cb_type, options);
+            blocks.push_back({&rr_gsb, cb_type, std::string()});
             cb_counters[cb_type]++;
           }
         }
@@ -382,12 +357,76 @@ void write_device_rr_gsb_to_xml(
     }
   }
 
-  VTR_LOG("Output %lu Switch blocks to XML files under directory '%s'\n",
-          sb_counter, xml_dir_name.c_str());
+  /* If there is a list of gsb list, we skip those which are not in the list */
+  std::vector<std::string> include_gsb_names = options.include_gsb_names();
+  std::vector<RRGSBXmlBlock> blocks_to_write;
+  for (RRGSBXmlBlock& block : blocks) {
+    block.name = rr_gsb_xml_block_name(*block.rr_gsb, block.type);
+    if (!include_gsb_names.empty() &&
+        include_gsb_names.end() == std::find(include_gsb_names.begin(),
+                                             include_gsb_names.end(),
+                                             block.name)) {
+      continue;
+    }
+    VTR_LOGV(options.verbose_output(),
+             "Output internal structure of %s Block '%s'\n",
+             NUM_RR_TYPES == block.type ? "Switch" : "Connection",
+             block.name.c_str());
+    blocks_to_write.push_back(block);
+  }
+
+  std::string output_location = std::string("XML files under directory '") +
+                                xml_dir_name + std::string("'");
+  if (options.single_file()) {
+    std::string fname = options.output_directory();
+    std::fstream fp;
+    fp.open(fname, std::fstream::out | std::fstream::trunc);
+    check_file_stream(fname.c_str(), fp);
+
+    fp << "<rr_gsbs>\n";
+    /* Blocks are formatted by chunks, to bound the memory of the buffers */
+    const size_t chunk_size = 4096;
+    std::vector<std::string> buffers;
+    for (size_t chunk_begin = 0; chunk_begin < blocks_to_write.size();
+         chunk_begin += chunk_size) {
+      size_t chunk_end =
+        std::min(blocks_to_write.size(), chunk_begin + chunk_size);
+      buffers.assign(chunk_end - chunk_begin, std::string());
+      parallel_for(
+        buffers.size(), options.num_threads(), [&](const size_t& iblock) {
+          buffers[iblock] = write_rr_gsb_xml_block_to_string(
+            vpr_device_grid, vpr_device_annotation, rr_graph,
+            blocks_to_write[chunk_begin + iblock], options.include_rr_info());
+        });
+      for (const std::string& buffer : buffers) {
+        fp << buffer;
+      }
+    }
+    fp << "</rr_gsbs>\n";
+    fp.close();
+    output_location = std::string("XML file '") + fname + std::string("'");
+  } else {
+    parallel_for(
+      blocks_to_write.size(), options.num_threads(),
+      [&](const size_t& iblock) {
+        const RRGSBXmlBlock& block = blocks_to_write[iblock];
+        std::string buffer = write_rr_gsb_xml_block_to_string(
+          vpr_device_grid, vpr_device_annotation, rr_graph, block,
+          options.include_rr_info());
+        std::string fname = xml_dir_name + block.name + ".xml";
+        std::fstream fp;
+        fp.open(fname, std::fstream::out | std::fstream::trunc);
+        check_file_stream(fname.c_str(), fp);
+        fp << buffer;
+        fp.close();
+      });
+  }
+
+  VTR_LOG("Output %lu Switch blocks to %s\n", sb_counter,
+          output_location.c_str());
   for (t_rr_type cb_type : {CHANX, CHANY}) {
-    VTR_LOG(
-      "Output %lu %s Connection blocks to XML files under directory '%s'\n",
-      cb_counters[cb_type], cb_names[cb_type].c_str(), xml_dir_name.c_str());
+    VTR_LOG("Output %lu %s Connection blocks to %s\n", cb_counters[cb_type],
+            cb_names[cb_type].c_str(), output_location.c_str());
   }
 }
 
@@ -2,6 +2,7 @@
  * Add basic commands to the OpenFPGA shell interface, including:
  * - exit
  * - version
+ * - report_runtime
  * - help
  *******************************************************************/
 #include "basic_command.h"
@@ -80,6 +81,98 @@ static ShellCommandId add_openfpga_source_command(
   return shell_cmd_id;
 }
 
+/********************************************************************
+ * - Add a command to Shell environment: batch_design
+ * - Add associated options
+ * - Add command dependency
+ *******************************************************************/
+static ShellCommandId add_openfpga_batch_design_command(
+  openfpga::Shell<OpenfpgaContext>& shell,
+  const ShellCommandClassId& cmd_class_id,
+  const std::vector<ShellCommandId>& dependent_cmds) {
+  Command shell_cmd("batch_design");
+
+  /* Add an option '--design_list' */
+  CommandOptionId opt_design_list = shell_cmd.add_option(
+    "design_list", true,
+    "A file which lists the designs, one per line, each with a name followed "
+    "by variables in the format of <name>=<value>");
+  shell_cmd.set_option_require_value(opt_design_list, openfpga::OPT_STRING);
+
+  /* Add an option '--command_stream' */
+  CommandOptionId opt_cmdstream = shell_cmd.add_option(
+    "command_stream", true,
+    "A string stream which contains the commands to be executed for each "
+    "design, where ${DESIGN} and ${<name>} are replaced by the design name "
+    "and the values of variables");
+  shell_cmd.set_option_require_value(opt_cmdstream, openfpga::OPT_STRING);
+
+  /* Add an option '--keep_going' */
+  shell_cmd.add_option(
+    "keep_going", false,
+    "Continue with the next designs when the commands fail for a design");
+
+  /* Add an option '--processes' */
+  CommandOptionId opt_processes = shell_cmd.add_option(
+    "processes", false,
+    "Run the designs in parallel by child processes forked from the shell, "
+    "which share the data built by previous commands. Specify the maximum "
+    "number of processes, or 0 to use all the hardware threads");
+  shell_cmd.set_option_require_value(opt_processes, openfpga::OPT_INT);
+
+  /* Add an option '--log_dir' */
+  CommandOptionId opt_log_dir = shell_cmd.add_option(
+    "log_dir", false,
+    "Write the output of each child process to <log_dir>/<design>.log. Only "
+    "applicable with '--processes'");
+  shell_cmd.set_option_require_value(opt_log_dir, openfpga::OPT_STRING);
+
+  /* Add command to the Shell */
+  ShellCommandId shell_cmd_id = shell.add_command(
+    shell_cmd,
+    "Run a string of commands for each design of a list, sharing the data "
+    "built by previous commands, e.g., the fabric");
+  shell.set_command_class(shell_cmd_id, cmd_class_id);
+  shell.set_command_execute_function(shell_cmd_id, source_command_per_design);
+
+  /* Add command dependency to the Shell */
+  shell.set_command_dependency(shell_cmd_id, dependent_cmds);
+
+  return shell_cmd_id;
+}
+
+/********************************************************************
+ * - Add a command to Shell environment: report_runtime
+ * - Add associated options
+ * - Add command dependency
+ *******************************************************************/
+static ShellCommandId add_openfpga_report_runtime_command(
+  openfpga::Shell<OpenfpgaContext>& shell,
+  const ShellCommandClassId& cmd_class_id,
+  const std::vector<ShellCommandId>& dependent_cmds) {
+  Command shell_cmd("report_runtime");
+
+  /* Add an option '--file' */
+  CommandOptionId opt_file = shell_cmd.add_option(
+    "file", false,
+    "Write the report to a file as well, in CSV format if the file ends with "
+    "'.csv', otherwise in JSON format");
+  shell_cmd.set_option_require_value(opt_file, openfpga::OPT_STRING);
+
+  /* Add command to the Shell */
+  ShellCommandId shell_cmd_id = shell.add_command(
+    shell_cmd,
+    "Report the wall time, CPU time and memory usage of each command executed "
+    "so far");
+  shell.set_command_class(shell_cmd_id, cmd_class_id);
+  shell.set_command_execute_function(shell_cmd_id, report_runtime);
+
+  /* Add command dependency to the Shell */
+  shell.set_command_dependency(shell_cmd_id, dependent_cmds);
+
+  return shell_cmd_id;
+}
+
 void add_basic_commands(openfpga::Shell<OpenfpgaContext>& shell) {
   /* Add a new class of commands */
   ShellCommandClassId basic_cmd_class = shell.add_command_class("Basic");
@@ -88,8 +181,10 @@ void add_basic_commands(openfpga::Shell<OpenfpgaContext>& shell) {
   ShellCommandId shell_cmd_exit_id =
     shell.add_command(shell_cmd_exit, "Exit the shell");
   shell.set_command_class(shell_cmd_exit_id, basic_cmd_class);
+  /* Refer to the shell rather than a snapshot, so that the statistics of the
+   * executed commands are available when exiting */
   shell.set_command_execute_function(shell_cmd_exit_id,
-                                     [shell]() { shell.exit(); });
+                                     [&shell]() { shell.exit(); });
 
   /* Version */
   Command shell_cmd_version("version");
@@ -111,10 +206,18 @@ void add_basic_commands(openfpga::Shell<OpenfpgaContext>& shell) {
   add_openfpga_source_command(shell, basic_cmd_class,
                               std::vector<ShellCommandId>());
 
+  /* Add 'batch_design' command which can run a set of commands per design */
+  add_openfpga_batch_design_command(shell, basic_cmd_class,
+                                    std::vector<ShellCommandId>());
+
   /* Add 'exec_external command which can run system call */
   add_openfpga_ext_exec_command(shell, basic_cmd_class,
                                 std::vector<ShellCommandId>());
 
+  /* Add 'report_runtime' command which shows the statistics of commands */
+  add_openfpga_report_runtime_command(shell, basic_cmd_class,
+                                      std::vector<ShellCommandId>());
+
   /* Note:
    * help MUST be the last to add because the linking to execute function will
    * do a snapshot on the shell
@@ -18,6 +18,9 @@ NetlistManager::netlist_range NetlistManager::netlists() const {
   return vtr::make_range(netlist_ids_.begin(), netlist_ids_.end());
 }
 
+/* Find the number of netlists */
+size_t NetlistManager::num_netlists() const { return netlist_ids_.size(); }
+
 /* Find all the modules that are included in a netlist */
 std::vector<ModuleId> NetlistManager::netlist_modules(
   const NetlistId& netlist) const {
@@ -70,7 +73,7 @@ bool NetlistManager::is_module_in_netlist(const NetlistId& netlist,
 NetlistId NetlistManager::find_module_netlist(const ModuleId& module) const {
   /* Find if the module has been added to a netlist. If used, return false! */
   /* Not found, return an invalid value */
-  if (module_netlist_map_.end() != module_netlist_map_.find(module)) {
+  if (module_netlist_map_.end() == module_netlist_map_.find(module)) {
     return NetlistId::INVALID();
   }
   return module_netlist_map_.at(module);
@@ -110,6 +113,8 @@ std::vector<std::string> NetlistManager::netlist_preprocessing_flags(
  ******************************************************************************/
 /* Add a netlist to the library */
 NetlistId NetlistManager::add_netlist(const std::string& name) {
+  std::lock_guard<std::mutex> lock(mutex_);
+
   /* Find if the name has been used. If used, return an invalid Id! */
   std::map<std::string, NetlistId>::iterator it = name_id_map_.find(name);
   if (it != name_id_map_.end()) {
@@ -134,6 +139,8 @@ NetlistId NetlistManager::add_netlist(const std::string& name) {
 
 void NetlistManager::set_netlist_type(const NetlistId& netlist,
                                       const e_netlist_type& type) {
+  std::lock_guard<std::mutex> lock(mutex_);
+
   VTR_ASSERT(true == valid_netlist_id(netlist));
   netlist_types_[netlist] = type;
 }
@@ -141,6 +148,8 @@ void NetlistManager::set_netlist_type(const NetlistId& netlist,
 /* Add a module to a netlist in the library */
 bool NetlistManager::add_netlist_module(const NetlistId& netlist,
                                         const ModuleId& module) {
+  std::lock_guard<std::mutex> lock(mutex_);
+
   VTR_ASSERT(true == valid_netlist_id(netlist));
 
   /* Find if the module already in the netlist */
@@ -169,6 +178,8 @@ bool NetlistManager::add_netlist_module(const NetlistId& netlist,
 /* Add a pre-processing flag to a netlist */
 void NetlistManager::add_netlist_preprocessing_flag(
   const NetlistId& netlist, const std::string& preprocessing_flag) {
+  std::lock_guard<std::mutex> lock(mutex_);
+
   VTR_ASSERT(true == valid_netlist_id(netlist));
 
   PreprocessingFlagId flag =
@@ -200,6 +211,27 @@ void NetlistManager::add_netlist_preprocessing_flag(
   }
 }
 
+/* Add all the netlists of another netlist manager */
+void NetlistManager::import_netlists(
+  const NetlistManager& src_netlist_manager) {
+  for (const NetlistId& src_netlist : src_netlist_manager.netlists()) {
+    NetlistId netlist =
+      add_netlist(src_netlist_manager.netlist_names_[src_netlist]);
+    /* Each netlist should be registered once */
+    VTR_ASSERT(true == valid_netlist_id(netlist));
+    set_netlist_type(netlist, src_netlist_manager.netlist_types_[src_netlist]);
+    for (const ModuleId& module :
+         src_netlist_manager.included_module_ids_[src_netlist]) {
+      bool status = add_netlist_module(netlist, module);
+      VTR_ASSERT(true == status);
+    }
+    for (const std::string& flag :
+         src_netlist_manager.netlist_preprocessing_flags(src_netlist)) {
+      add_netlist_preprocessing_flag(netlist, flag);
+    }
+  }
+}
+
 /******************************************************************************
  * Public validators/invalidators
  ******************************************************************************/
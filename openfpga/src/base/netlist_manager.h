@@ -22,6 +22,7 @@
 #define NETLIST_MANAGER_H
 
 #include <map>
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -40,6 +41,7 @@ class NetlistManager {
     LOGIC_BLOCK_NETLIST,
     ROUTING_MODULE_NETLIST,
     TILE_MODULE_NETLIST,
+    PACKED_MODULE_NETLIST,
     TOP_MODULE_NETLIST,
     TESTBENCH_NETLIST,
     NUM_NETLIST_TYPES
@@ -52,6 +54,8 @@ class NetlistManager {
  public: /* Public aggregators */
   /* Find all the netlists */
   netlist_range netlists() const;
+  /* Find the number of netlists */
+  size_t num_netlists() const;
   /* Find all the modules that are included in a netlist */
   std::vector<ModuleId> netlist_modules(const NetlistId& netlist) const;
   /* Find all the preprocessing flags that are included in a netlist */
@@ -75,6 +79,9 @@ class NetlistManager {
   NetlistId find_module_netlist(const ModuleId& module) const;
 
  public: /* Public mutators */
+  /* Note that the mutators are thread-safe, so that netlist writers can
+   * register their netlists concurrently. The accessors are not, and should
+   * only be called when no writer is running */
   /* Add a netlist to the library */
   NetlistId add_netlist(const std::string& name);
   /* Set a netlist type */
@@ -84,6 +91,12 @@ class NetlistManager {
   /* Add a pre-processing flag to a netlist */
   void add_netlist_preprocessing_flag(const NetlistId& netlist,
                                       const std::string& preprocessing_flag);
+  /* Add all the netlists of another netlist manager, in their order, with
+   * their types, modules and pre-processing flags. Concurrent writers may
+   * register their netlists in netlist managers of their own, which are
+   * then imported in the order of the tasks, so that the list of netlists
+   * does not depend on the scheduling of threads */
+  void import_netlists(const NetlistManager& src_netlist_manager);
 
  public: /* Public validators/invalidators */
   bool valid_netlist_id(const NetlistId& netlist) const;
@@ -109,6 +122,9 @@ class NetlistManager {
   std::map<std::string, NetlistId> name_id_map_;
   /* fast look-up for modules in netlists */
   std::map<ModuleId, NetlistId> module_netlist_map_;
+
+  /* Serialize the mutators called by concurrent writers */
+  std::mutex mutex_;
 };
 
 } /* end namespace openfpga */
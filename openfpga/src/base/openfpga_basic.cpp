@@ -6,8 +6,20 @@
  *******************************************************************/
 #include "openfpga_basic.h"
 
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <fstream>
+#include <map>
+
 #include "command_exit_codes.h"
+#include "openfpga_digest.h"
+#include "openfpga_parallel.h"
 #include "openfpga_title.h"
+#include "vtr_log.h"
+#include "vtr_time.h"
 
 /* begin namespace openfpga */
 namespace openfpga {
@@ -56,6 +68,298 @@ int source_existing_command(openfpga::Shell<OpenfpgaContext>* shell,
   return CMD_EXEC_SUCCESS;
 }
 
+/********************************************************************
+ * A design in a design list, with the variables to be substituted in the
+ * commands to run for the design
+ *******************************************************************/
+struct BatchDesign {
+  std::string name;
+  std::map<std::string, std::string> variables;
+};
+
+/********************************************************************
+ * Read a list of designs from a file, where
+ * - each line describes a design, as a design name followed by a number of
+ *   variables in the format of <name>=<value>, separated by spaces
+ * - empty lines and lines starting with '#' are skipped
+ * Return false if the file can not be read or has an invalid line
+ *******************************************************************/
+static bool read_batch_design_list(const std::string& fname,
+                                   std::vector<BatchDesign>& designs) {
+  std::ifstream fp(fname);
+  if (!fp.is_open()) {
+    VTR_LOG_ERROR("Unable to open design list '%s'!\n", fname.c_str());
+    return false;
+  }
+
+  std::string line;
+  size_t line_num = 0;
+  while (std::getline(fp, line)) {
+    line_num++;
+    StringToken line_tokenizer(line);
+    std::vector<std::string> tokens = line_tokenizer.split(" \t\r");
+    if ((true == tokens.empty()) || ('#' == tokens[0][0])) {
+      continue;
+    }
+    BatchDesign design;
+    design.name = tokens[0];
+    design.variables["DESIGN"] = design.name;
+    for (size_t itok = 1; itok < tokens.size(); ++itok) {
+      size_t pos = tokens[itok].find('=');
+      if ((std::string::npos == pos) || (0 == pos)) {
+        VTR_LOG_ERROR(
+          "Invalid variable '%s' at line %lu of design list '%s'! Expect "
+          "<name>=<value>\n",
+          tokens[itok].c_str(), line_num, fname.c_str());
+        return false;
+      }
+      design.variables[tokens[itok].substr(0, pos)] =
+        tokens[itok].substr(pos + 1);
+    }
+    designs.push_back(design);
+  }
+  return true;
+}
+
+/********************************************************************
+ * Replace the variables ${<name>} in a string with the values of a design
+ * Return false if a variable is not defined by the design
+ *******************************************************************/
+static bool substitute_batch_design_variables(const BatchDesign& design,
+                                              const std::string& cmd_ss,
+                                              std::string& result) {
+  result.clear();
+  size_t curr = 0;
+  while (curr < cmd_ss.size()) {
+    size_t var_begin = cmd_ss.find("${", curr);
+    if (std::string::npos == var_begin) {
+      result += cmd_ss.substr(curr);
+      break;
+    }
+    size_t var_end = cmd_ss.find('}', var_begin);
+    if (std::string::npos == var_end) {
+      VTR_LOG_ERROR("Unterminated variable in command stream '%s'!\n",
+                    cmd_ss.c_str());
+      return false;
+    }
+    result += cmd_ss.substr(curr, var_begin - curr);
+    std::string var_name =
+      cmd_ss.substr(var_begin + 2, var_end - var_begin - 2);
+    auto var = design.variables.find(var_name);
+    if (var == design.variables.end()) {
+      VTR_LOG_ERROR("Variable '%s' is not defined for design '%s'!\n",
+                    var_name.c_str(), design.name.c_str());
+      return false;
+    }
+    result += var->second;
+    curr = var_end + 1;
+  }
+  return true;
+}
+
+/********************************************************************
+ * Run the string of commands of a design, whose variables are substituted
+ * Return a fatal error code if any command fails
+ *******************************************************************/
+static int run_batch_design_commands(openfpga::Shell<OpenfpgaContext>* shell,
+                                     OpenfpgaContext& openfpga_ctx,
+                                     const BatchDesign& design,
+                                     const std::string& cmd_ss) {
+  std::string design_cmd_ss;
+  if (false ==
+      substitute_batch_design_variables(design, cmd_ss, design_cmd_ss)) {
+    return CMD_EXEC_FATAL_ERROR;
+  }
+
+  /* Split the string with ';' and run each command */
+  int status = CMD_EXEC_SUCCESS;
+  StringToken cmd_ss_tokenizer(design_cmd_ss);
+  for (std::string cmd_part : cmd_ss_tokenizer.split(";")) {
+    StringToken cmd_part_tokenizer(cmd_part);
+    cmd_part_tokenizer.rtrim(std::string(" "));
+    std::string single_cmd_line = cmd_part_tokenizer.data();
+    if (!single_cmd_line.empty()) {
+      status = shell->execute_command(single_cmd_line.c_str(), openfpga_ctx);
+    }
+    if (CMD_EXEC_FATAL_ERROR == status) {
+      break;
+    }
+  }
+  return status;
+}
+
+/********************************************************************
+ * Run the commands of each design in a child process forked from the shell.
+ * The children share the memory of the data built so far, e.g., the module
+ * graph, until they modify it, so that many designs can be processed in
+ * parallel with the memory footprint of a single fabric.
+ * The output of each child is written to <log_dir>/<design>.log
+ * if a directory is specified, otherwise to the output of the shell.
+ * Return the number of designs which fail
+ *******************************************************************/
+static size_t run_batch_designs_in_processes(
+  openfpga::Shell<OpenfpgaContext>* shell, OpenfpgaContext& openfpga_ctx,
+  const std::vector<BatchDesign>& designs, const std::string& cmd_ss,
+  const size_t& num_processes, const std::string& log_dir,
+  const bool& keep_going) {
+  std::map<pid_t, size_t> running_designs;
+  size_t next_design = 0;
+  size_t num_failed_designs = 0;
+  while ((false == running_designs.empty()) ||
+         (next_design < designs.size())) {
+    /* Launch designs until all the processes are busy. No more design is
+     * launched after a failure, unless asked to keep going */
+    while ((running_designs.size() < num_processes) &&
+           (next_design < designs.size()) &&
+           ((true == keep_going) || (0 == num_failed_designs))) {
+      const BatchDesign& design = designs[next_design];
+      VTR_LOG("Run commands for design '%s' (%lu/%lu) in a child process\n",
+              design.name.c_str(), next_design + 1, designs.size());
+      /* Otherwise the buffered outputs are duplicated in the child */
+      fflush(stdout);
+      fflush(stderr);
+      pid_t pid = fork();
+      if (0 > pid) {
+        VTR_LOG_ERROR("Fail to fork a process for design '%s'!\n",
+                      design.name.c_str());
+        num_failed_designs++;
+        break;
+      }
+      if (0 == pid) {
+        if (!log_dir.empty()) {
+          std::string log_fname = log_dir + "/" + design.name + ".log";
+          int log_fd = open(log_fname.c_str(), O_WRONLY | O_CREAT | O_TRUNC,
+                            S_IRUSR | S_IWUSR | S_IRGRP | S_IROTH);
+          if (0 > log_fd) {
+            VTR_LOG_ERROR("Unable to open log file '%s'!\n",
+                          log_fname.c_str());
+            _exit(1);
+          }
+          dup2(log_fd, STDOUT_FILENO);
+          dup2(log_fd, STDERR_FILENO);
+          close(log_fd);
+        }
+        int status =
+          run_batch_design_commands(shell, openfpga_ctx, design, cmd_ss);
+        fflush(stdout);
+        fflush(stderr);
+        /* Quit without destroying the context, which is not needed any more
+         * and whose pages would be touched by the destructors */
+        _exit(CMD_EXEC_FATAL_ERROR == status ? 1 : 0);
+      }
+      running_designs[pid] = next_design;
+      next_design++;
+    }
+
+    if (true == running_designs.empty()) {
+      break;
+    }
+
+    /* Wait for any child to finish */
+    int child_status = 0;
+    pid_t pid = waitpid(-1, &child_status, 0);
+    if (0 > pid) {
+      VTR_LOG_ERROR("Fail to wait for the child processes!\n");
+      return num_failed_designs + running_designs.size();
+    }
+    auto result = running_designs.find(pid);
+    if (result == running_designs.end()) {
+      continue;
+    }
+    const BatchDesign& design = designs[result->second];
+    running_designs.erase(result);
+    if ((false == WIFEXITED(child_status)) ||
+        (0 != WEXITSTATUS(child_status))) {
+      num_failed_designs++;
+      VTR_LOG_ERROR("Commands failed for design '%s'!\n", design.name.c_str());
+    } else {
+      VTR_LOG("Finished commands for design '%s'\n", design.name.c_str());
+    }
+  }
+
+  /* Designs which are not launched are counted as failed */
+  return num_failed_designs + designs.size() - next_design;
+}
+
+/********************************************************************
+ * Run a string of commands for each design of a list, in the same shell.
+ * As the data built by previous commands, e.g., the fabric, is kept in the
+ * context, only the commands which depend on each design are required in
+ * the string, e.g., running VPR, repacking and building bitstreams.
+ * Designs can also be run in parallel by child processes, each of which
+ * runs a design on a copy of the context.
+ *******************************************************************/
+int source_command_per_design(openfpga::Shell<OpenfpgaContext>* shell,
+                              OpenfpgaContext& openfpga_ctx,
+                              const Command& cmd,
+                              const CommandContext& cmd_context) {
+  CommandOptionId opt_design_list = cmd.option("design_list");
+  CommandOptionId opt_ss = cmd.option("command_stream");
+  CommandOptionId opt_keep_going = cmd.option("keep_going");
+  CommandOptionId opt_processes = cmd.option("processes");
+  CommandOptionId opt_log_dir = cmd.option("log_dir");
+
+  std::vector<BatchDesign> designs;
+  if (false == read_batch_design_list(
+                 cmd_context.option_value(cmd, opt_design_list), designs)) {
+    return CMD_EXEC_FATAL_ERROR;
+  }
+
+  std::string cmd_ss = cmd_context.option_value(cmd, opt_ss);
+  bool keep_going = cmd_context.option_enable(cmd, opt_keep_going);
+
+  vtr::ScopedStartFinishTimer timer(std::string("Run commands for ") +
+                                    std::to_string(designs.size()) +
+                                    std::string(" designs"));
+
+  size_t num_failed_designs = 0;
+  if (true == cmd_context.option_enable(cmd, opt_processes)) {
+    /* Zero means as many processes as the hardware threads */
+    size_t num_processes = 1;
+    if (false ==
+        parse_num_threads(cmd_context.option_value(cmd, opt_processes),
+                          num_processes)) {
+      return CMD_EXEC_FATAL_ERROR;
+    }
+    num_processes = find_num_threads(num_processes);
+    /* Create the log directory once, before the children open their logs */
+    std::string log_dir;
+    if (true == cmd_context.option_enable(cmd, opt_log_dir)) {
+      log_dir = cmd_context.option_value(cmd, opt_log_dir);
+      create_directory(log_dir);
+    }
+    num_failed_designs = run_batch_designs_in_processes(
+      shell, openfpga_ctx, designs, cmd_ss, num_processes, log_dir,
+      keep_going);
+  } else {
+    for (size_t idesign = 0; idesign < designs.size(); ++idesign) {
+      const BatchDesign& design = designs[idesign];
+      VTR_LOG("Run commands for design '%s' (%lu/%lu)\n",
+              design.name.c_str(), idesign + 1, designs.size());
+
+      int status =
+        run_batch_design_commands(shell, openfpga_ctx, design, cmd_ss);
+      if (CMD_EXEC_FATAL_ERROR == status) {
+        num_failed_designs++;
+        VTR_LOG_ERROR("Commands failed for design '%s'!\n",
+                      design.name.c_str());
+        if (false == keep_going) {
+          return CMD_EXEC_FATAL_ERROR;
+        }
+      }
+    }
+  }
+
+  VTR_LOG("Ran commands for %lu designs: %lu succeeded, %lu failed\n",
+          designs.size(), designs.size() - num_failed_designs,
+          num_failed_designs);
+
+  if (0 < num_failed_designs) {
+    return CMD_EXEC_FATAL_ERROR;
+  }
+  return CMD_EXEC_SUCCESS;
+}
+
 /** Call an external command using system call */
 int call_external_command(const Command& cmd,
                           const CommandContext& cmd_context) {
@@ -72,4 +376,22 @@ int call_external_command(const Command& cmd,
   return system(cmd_ss.c_str());
 }
 
+/** Report the runtime and memory of the commands executed so far */
+int report_runtime(openfpga::Shell<OpenfpgaContext>* shell,
+                   OpenfpgaContext& openfpga_ctx, const Command& cmd,
+                   const CommandContext& cmd_context) {
+  /* The context is not used, but required by the type of function */
+  (void)openfpga_ctx;
+
+  CommandOptionId opt_file = cmd.option("file");
+
+  shell->profiler().print_report();
+
+  if (true == cmd_context.option_enable(cmd, opt_file)) {
+    return shell->profiler().write_report(
+      cmd_context.option_value(cmd, opt_file));
+  }
+  return CMD_EXEC_SUCCESS;
+}
+
 } /* end namespace openfpga */
@@ -20,9 +20,18 @@ int source_existing_command(openfpga::Shell<OpenfpgaContext>* shell,
                             OpenfpgaContext& openfpga_ctx, const Command& cmd,
                             const CommandContext& cmd_context);
 
+int source_command_per_design(openfpga::Shell<OpenfpgaContext>* shell,
+                              OpenfpgaContext& openfpga_ctx,
+                              const Command& cmd,
+                              const CommandContext& cmd_context);
+
 int call_external_command(const Command& cmd,
                           const CommandContext& cmd_context);
 
+int report_runtime(openfpga::Shell<OpenfpgaContext>* shell,
+                   OpenfpgaContext& openfpga_ctx, const Command& cmd,
+                   const CommandContext& cmd_context);
+
 } /* end namespace openfpga */
 
 #endif
@@ -7,6 +7,7 @@
  * - repack : create physical pbs and redo packing
  *******************************************************************/
 #include "openfpga_bitstream_template.h"
+#include "openfpga_checkpoint_template.h"
 #include "openfpga_repack_template.h"
 #include "shell.h"
 
@@ -38,6 +39,34 @@ ShellCommandId add_repack_command_template(
   shell_cmd.set_option_require_value(opt_ignore_global_nets,
                                      openfpga::OPT_STRING);
 
+  /* Add an option '--threads' */
+  CommandOptionId opt_threads = shell_cmd.add_option(
+    "threads", false,
+    "Number of threads used to repack clustered blocks. Use 0 to use all the "
+    "hardware threads. Default: 1");
+  shell_cmd.set_option_require_value(opt_threads, openfpga::OPT_INT);
+
+  /* Add an option '--lookahead' */
+  shell_cmd.add_option("lookahead", false,
+                       "Guide the routing of clustered blocks with a "
+                       "lookahead to the sinks, which expands fewer nodes");
+
+  /* Add an option '--max_stagnant_route_iterations' */
+  CommandOptionId opt_max_stagnant_route_iterations = shell_cmd.add_option(
+    "max_stagnant_route_iterations", false,
+    "Give up routing a clustered block when its congestion is not reduced "
+    "within this number of iterations. Default: 0 (no limit)");
+  shell_cmd.set_option_require_value(opt_max_stagnant_route_iterations,
+                                     openfpga::OPT_INT);
+
+  /* Add an option '--lb_rr_graph_cache' */
+  CommandOptionId opt_lb_rr_graph_cache = shell_cmd.add_option(
+    "lb_rr_graph_cache", false,
+    "load the routing resource graphs of logical blocks from a cache file. "
+    "The graphs are built and saved to the file if it is missing or outdated");
+  shell_cmd.set_option_require_value(opt_lb_rr_graph_cache,
+                                     openfpga::OPT_STRING);
+
   /* Add an option '--verbose' */
   shell_cmd.add_option("verbose", false, "Enable verbose output");
 
@@ -74,10 +103,23 @@ ShellCommandId add_build_arch_bitstream_command_template(
     "read_file", false, "file path to read the bitstream database");
   shell_cmd.set_option_require_value(opt_read_file, openfpga::OPT_STRING);
 
+  /* Add an option '--write_format' */
+  CommandOptionId opt_write_format = shell_cmd.add_option(
+    "write_format", false,
+    "file format of the output bitstream database [xml|bin]. Default: xml");
+  shell_cmd.set_option_require_value(opt_write_format, openfpga::OPT_STRING);
+
   /* Add an option '--no_time_stamp' */
   shell_cmd.add_option("no_time_stamp", false,
                        "Do not print time stamp in output files");
 
+  /* Add an option '--threads' */
+  CommandOptionId opt_threads = shell_cmd.add_option(
+    "threads", false,
+    "Number of threads used to build the bitstream and to write it to an "
+    "XML file. Use 0 to use all the hardware threads. Default: 1");
+  shell_cmd.set_option_require_value(opt_threads, openfpga::OPT_INT);
+
   /* Add an option '--verbose' */
   shell_cmd.add_option("verbose", false, "Enable verbose output");
 
@@ -116,6 +158,11 @@ ShellCommandId add_report_bitstream_distribution_command_template(
     "Specify the max. depth of blocks which will appear in report");
   shell_cmd.set_option_require_value(opt_depth, openfpga::OPT_STRING);
 
+  /* Add an option '--count_ones' */
+  shell_cmd.add_option("count_ones", false,
+                       "Report the number of configuration bits with value "
+                       "'1' for each region and block");
+
   /* Add an option '--no_time_stamp' */
   shell_cmd.add_option("no_time_stamp", false,
                        "Do not print time stamp in output files");
@@ -136,6 +183,44 @@ ShellCommandId add_report_bitstream_distribution_command_template(
   return shell_cmd_id;
 }
 
+/********************************************************************
+ * - Add a command to Shell environment: diff_architecture_bitstream
+ * - Add associated options
+ * - Add command dependency
+ *******************************************************************/
+template <class T>
+ShellCommandId add_diff_arch_bitstream_command_template(
+  openfpga::Shell<T>& shell, const ShellCommandClassId& cmd_class_id,
+  const std::vector<ShellCommandId>& dependent_cmds, const bool& hidden) {
+  Command shell_cmd("diff_architecture_bitstream");
+
+  /* Add an option '--reference' */
+  CommandOptionId opt_reference = shell_cmd.add_option(
+    "reference", true,
+    "file path to the reference bitstream database [xml|bin]");
+  shell_cmd.set_option_require_value(opt_reference, openfpga::OPT_STRING);
+
+  /* Add an option '--report' */
+  CommandOptionId opt_report = shell_cmd.add_option(
+    "report", false, "file path to output the blocks which differ");
+  shell_cmd.set_option_require_value(opt_report, openfpga::OPT_STRING);
+
+  /* Add an option '--verbose' */
+  shell_cmd.add_option("verbose", false, "Enable verbose output");
+
+  /* Add command 'diff_architecture_bitstream' to the Shell */
+  ShellCommandId shell_cmd_id = shell.add_command(
+    shell_cmd, "Compare the bitstream database to a reference one", hidden);
+  shell.set_command_class(shell_cmd_id, cmd_class_id);
+  shell.set_command_execute_function(shell_cmd_id,
+                                     diff_architecture_bitstream_template<T>);
+
+  /* Add command dependency to the Shell */
+  shell.set_command_dependency(shell_cmd_id, dependent_cmds);
+
+  return shell_cmd_id;
+}
+
 /********************************************************************
  * - Add a command to Shell environment: build_fabric_bitstream
  * - Add associated options
@@ -147,6 +232,43 @@ ShellCommandId add_build_fabric_bitstream_command_template(
   const std::vector<ShellCommandId>& dependent_cmds, const bool& hidden) {
   Command shell_cmd("build_fabric_bitstream");
 
+  /* Add an option '--incremental' */
+  shell_cmd.add_option("incremental", false,
+                       "Only update the values of the fabric bitstream built "
+                       "previously for the same FPGA fabric");
+
+  /* Add an option '--region' */
+  CommandOptionId opt_region = shell_cmd.add_option(
+    "region", false,
+    "Only build the bitstream of the configurable blocks whose coordinates "
+    "are in a rectangle <xmin>,<ymin>,<xmax>,<ymax>, for partial "
+    "reconfiguration");
+  shell_cmd.set_option_require_value(opt_region, openfpga::OPT_STRING);
+
+  /* Add an option '--tiles' */
+  CommandOptionId opt_tiles = shell_cmd.add_option(
+    "tiles", false,
+    "Only build the bitstream of a list of tiles <id0>,<id1>,..., for partial "
+    "reconfiguration. Only applicable when tiles are grouped");
+  shell_cmd.set_option_require_value(opt_tiles, openfpga::OPT_STRING);
+
+  /* Add an option '--template_file' */
+  CommandOptionId opt_template_file = shell_cmd.add_option(
+    "template_file", false,
+    "Load the sequence and the addresses of the configuration bits from a "
+    "template built for the same FPGA fabric, and only gather the values of "
+    "the bits. When the file does not exist or is outdated, the fabric "
+    "bitstream is built from scratch and its template is written to the "
+    "file");
+  shell_cmd.set_option_require_value(opt_template_file, openfpga::OPT_STRING);
+
+  /* Add an option '--threads' */
+  CommandOptionId opt_threads = shell_cmd.add_option(
+    "threads", false,
+    "Number of threads used to walk the configuration regions of memory "
+    "banks. Use 0 to use all the hardware threads. Default: 1");
+  shell_cmd.set_option_require_value(opt_threads, openfpga::OPT_INT);
+
   /* Add an option '--verbose' */
   shell_cmd.add_option("verbose", false, "Enable verbose output");
 
@@ -166,6 +288,86 @@ ShellCommandId add_build_fabric_bitstream_command_template(
   return shell_cmd_id;
 }
 
+/********************************************************************
+ * - Add a command to Shell environment: verify_fabric_bitstream
+ * - Add associated options
+ * - Add command dependency
+ *******************************************************************/
+template <class T>
+ShellCommandId add_verify_fabric_bitstream_command_template(
+  openfpga::Shell<T>& shell, const ShellCommandClassId& cmd_class_id,
+  const std::vector<ShellCommandId>& dependent_cmds, const bool& hidden) {
+  Command shell_cmd("verify_fabric_bitstream");
+
+  /* Add an option '--threads' */
+  CommandOptionId opt_threads = shell_cmd.add_option(
+    "threads", false,
+    "Number of threads used to check the configuration regions. Use 0 to use "
+    "all the hardware threads. Default: 1");
+  shell_cmd.set_option_require_value(opt_threads, openfpga::OPT_INT);
+
+  /* Add an option '--verbose' */
+  shell_cmd.add_option("verbose", false, "Enable verbose output");
+
+  /* Add command 'verify_fabric_bitstream' to the Shell */
+  ShellCommandId shell_cmd_id =
+    shell.add_command(shell_cmd,
+                      "Check that the fabric bitstream is consistent with the "
+                      "bitstream database and the module graph",
+                      hidden);
+  shell.set_command_class(shell_cmd_id, cmd_class_id);
+  shell.set_command_const_execute_function(
+    shell_cmd_id, verify_fabric_bitstream_template<T>);
+
+  /* Add command dependency to the Shell */
+  shell.set_command_dependency(shell_cmd_id, dependent_cmds);
+
+  return shell_cmd_id;
+}
+
+/********************************************************************
+ * - Add a command to Shell environment: simulate_fabric_configuration
+ * - Add associated options
+ * - Add command dependency
+ *******************************************************************/
+template <class T>
+ShellCommandId add_simulate_fabric_configuration_command_template(
+  openfpga::Shell<T>& shell, const ShellCommandClassId& cmd_class_id,
+  const std::vector<ShellCommandId>& dependent_cmds, const bool& hidden) {
+  Command shell_cmd("simulate_fabric_configuration");
+
+  /* Add an option '--file' */
+  CommandOptionId opt_file = shell_cmd.add_option(
+    "file", false,
+    "file path to output the state of the configuration memories after "
+    "configuration, which can be loaded by $readmemb");
+  shell_cmd.set_option_short_name(opt_file, "f");
+  shell_cmd.set_option_require_value(opt_file, openfpga::OPT_STRING);
+
+  /* Add an option '--fast_configuration' */
+  shell_cmd.add_option("fast_configuration", false,
+                       "Skip the programming cycles as the full testbench "
+                       "does with fast configuration");
+
+  /* Add an option '--verbose' */
+  shell_cmd.add_option("verbose", false, "Enable verbose output");
+
+  /* Add command 'simulate_fabric_configuration' to the Shell */
+  ShellCommandId shell_cmd_id =
+    shell.add_command(shell_cmd,
+                      "Model the configuration phase of the FPGA fabric and "
+                      "check the state of configuration memories",
+                      hidden);
+  shell.set_command_class(shell_cmd_id, cmd_class_id);
+  shell.set_command_const_execute_function(
+    shell_cmd_id, simulate_fabric_configuration_template<T>);
+
+  /* Add command dependency to the Shell */
+  shell.set_command_dependency(shell_cmd_id, dependent_cmds);
+
+  return shell_cmd_id;
+}
+
 /********************************************************************
  * - Add a command to Shell environment: write_fabric_bitstream
  * - Add associated options
@@ -187,7 +389,8 @@ ShellCommandId add_write_fabric_bitstream_command_template(
   /* Add an option '--file_format'*/
   CommandOptionId opt_file_format = shell_cmd.add_option(
     "format", false,
-    "file format of fabric bitstream [plain_text|xml]. Default: plain_text");
+    "file format of fabric bitstream [plain_text|xml|bin]. Default: "
+    "plain_text");
   shell_cmd.set_option_require_value(opt_file_format, openfpga::OPT_STRING);
 
   CommandOptionId opt_filter_value = shell_cmd.add_option(
@@ -211,6 +414,12 @@ ShellCommandId add_write_fabric_bitstream_command_template(
     "Trim the path by a level of 1 in the resulting fabric bitstream. Only "
     "applicable to XML file format. Default: off");
 
+  shell_cmd.add_option(
+    "shard_by_region", false,
+    "Write each configuration region to a separated file, while the file "
+    "given by '--file' lists the files of the regions. Only applicable to XML "
+    "file format. Default: off");
+
   /* Add an option '--fast_configuration' */
   shell_cmd.add_option("fast_configuration", false,
                        "Reduce the size of bitstream to be downloaded");
@@ -226,6 +435,41 @@ ShellCommandId add_write_fabric_bitstream_command_template(
     "wl_decremental_order", false,
     "Generate bitstream in WL decremental addressing order if supported");
 
+  /* Add an option '--reference_file' */
+  CommandOptionId opt_reference_file = shell_cmd.add_option(
+    "reference_file", false,
+    "Architecture bitstream file of a reference implementation on the same "
+    "fabric. Only the frames or word lines which are changed from the "
+    "reference are written. Only applicable to plain_text file format and to "
+    "memory bank and frame-based configuration protocols");
+  shell_cmd.set_option_require_value(opt_reference_file, openfpga::OPT_STRING);
+
+  /* Add an option '--region_hash' */
+  shell_cmd.add_option(
+    "region_hash", false,
+    "Write the hash of the bits of each configuration region in the head of "
+    "the file. Only applicable to plain_text file format");
+
+  /* Add an option '--compress' */
+  shell_cmd.add_option(
+    "compress", false,
+    "Run-length compress the bitstream. Only applicable to bin file format "
+    "and to standalone, scan-chain and frame-based configuration protocols");
+
+  /* Add an option '--threads' */
+  CommandOptionId opt_threads = shell_cmd.add_option(
+    "threads", false,
+    "Number of threads used to prepare the bitstream. Use 0 to use all the "
+    "hardware threads. Default: 1");
+  shell_cmd.set_option_require_value(opt_threads, openfpga::OPT_INT);
+
+  /* Add an option '--stream' */
+  shell_cmd.add_option(
+    "stream", false,
+    "Write the bitstream while walking the module graph, without requiring "
+    "the fabric bitstream to be built. Only applicable to plain_text file "
+    "format and to standalone and scan-chain configuration protocols");
+
   /* Add an option '--no_time_stamp' */
   shell_cmd.add_option("no_time_stamp", false,
                        "Do not print time stamp in output files");
@@ -246,6 +490,45 @@ ShellCommandId add_write_fabric_bitstream_command_template(
   return shell_cmd_id;
 }
 
+/********************************************************************
+ * - Add a command to Shell environment: read_fabric_bitstream
+ * - Add associated options
+ * - Add command dependency
+ *******************************************************************/
+template <class T>
+ShellCommandId add_read_fabric_bitstream_command_template(
+  openfpga::Shell<T>& shell, const ShellCommandClassId& cmd_class_id,
+  const std::vector<ShellCommandId>& dependent_cmds, const bool& hidden) {
+  Command shell_cmd("read_fabric_bitstream");
+
+  /* Add an option '--file' in short '-f'*/
+  CommandOptionId opt_file = shell_cmd.add_option(
+    "file", true, "file path to the fabric bitstream in plain text");
+  shell_cmd.set_option_short_name(opt_file, "f");
+  shell_cmd.set_option_require_value(opt_file, openfpga::OPT_STRING);
+
+  /* Add an option '--compare' */
+  shell_cmd.add_option("compare", false,
+                       "Compare the bits with the fabric bitstream in the "
+                       "database. Only applicable to the standalone "
+                       "configuration protocol");
+
+  /* Add an option '--verbose' */
+  shell_cmd.add_option("verbose", false, "Enable verbose output");
+
+  /* Add command 'read_fabric_bitstream' to the Shell */
+  ShellCommandId shell_cmd_id = shell.add_command(
+    shell_cmd, "Read and check a fabric bitstream in plain text", hidden);
+  shell.set_command_class(shell_cmd_id, cmd_class_id);
+  shell.set_command_const_execute_function(
+    shell_cmd_id, read_text_fabric_bitstream_template<T>);
+
+  /* Add command dependency to the Shell */
+  shell.set_command_dependency(shell_cmd_id, dependent_cmds);
+
+  return shell_cmd_id;
+}
+
 /********************************************************************
  * - Add a command to Shell environment: write_io_mapping
  * - Add associated options
@@ -283,6 +566,72 @@ ShellCommandId add_write_io_mapping_command_template(
   return shell_cmd_id;
 }
 
+/********************************************************************
+ * - Add a command to Shell environment: save_checkpoint
+ * - Add associated options
+ * - Add command dependency
+ *******************************************************************/
+template <class T>
+ShellCommandId add_save_checkpoint_command_template(
+  openfpga::Shell<T>& shell, const ShellCommandClassId& cmd_class_id,
+  const std::vector<ShellCommandId>& dependent_cmds, const bool& hidden) {
+  Command shell_cmd("save_checkpoint");
+
+  /* Add an option '--file' in short '-f'*/
+  CommandOptionId opt_file =
+    shell_cmd.add_option("file", true, "directory path of the checkpoint");
+  shell_cmd.set_option_short_name(opt_file, "f");
+  shell_cmd.set_option_require_value(opt_file, openfpga::OPT_STRING);
+
+  /* Add an option '--verbose' */
+  shell_cmd.add_option("verbose", false, "Enable verbose output");
+
+  /* Add command 'save_checkpoint' to the Shell */
+  ShellCommandId shell_cmd_id = shell.add_command(
+    shell_cmd, "Save the bitstream databases to a checkpoint", hidden);
+  shell.set_command_class(shell_cmd_id, cmd_class_id);
+  shell.set_command_const_execute_function(shell_cmd_id,
+                                           save_checkpoint_template<T>);
+
+  /* Add command dependency to the Shell */
+  shell.set_command_dependency(shell_cmd_id, dependent_cmds);
+
+  return shell_cmd_id;
+}
+
+/********************************************************************
+ * - Add a command to Shell environment: load_checkpoint
+ * - Add associated options
+ * - Add command dependency
+ *******************************************************************/
+template <class T>
+ShellCommandId add_load_checkpoint_command_template(
+  openfpga::Shell<T>& shell, const ShellCommandClassId& cmd_class_id,
+  const std::vector<ShellCommandId>& dependent_cmds, const bool& hidden) {
+  Command shell_cmd("load_checkpoint");
+
+  /* Add an option '--file' in short '-f'*/
+  CommandOptionId opt_file =
+    shell_cmd.add_option("file", true, "directory path of the checkpoint");
+  shell_cmd.set_option_short_name(opt_file, "f");
+  shell_cmd.set_option_require_value(opt_file, openfpga::OPT_STRING);
+
+  /* Add an option '--verbose' */
+  shell_cmd.add_option("verbose", false, "Enable verbose output");
+
+  /* Add command 'load_checkpoint' to the Shell */
+  ShellCommandId shell_cmd_id = shell.add_command(
+    shell_cmd, "Restore the bitstream databases from a checkpoint", hidden);
+  shell.set_command_class(shell_cmd_id, cmd_class_id);
+  shell.set_command_execute_function(shell_cmd_id,
+                                     load_checkpoint_template<T>);
+
+  /* Add command dependency to the Shell */
+  shell.set_command_dependency(shell_cmd_id, dependent_cmds);
+
+  return shell_cmd_id;
+}
+
 /********************************************************************
  * Top-level function to add all the commands related to FPGA-Bitstream
  *******************************************************************/
@@ -331,6 +680,18 @@ void add_bitstream_command_templates(openfpga::Shell<T>& shell,
     shell, openfpga_bitstream_cmd_class,
     cmd_dependency_report_bitstream_distribution, hidden);
 
+  /********************************
+   * Command 'diff_architecture_bitstream'
+   */
+  /* The 'diff_architecture_bitstream' command should NOT be executed before
+   * 'build_architecture_bitstream' */
+  std::vector<ShellCommandId> cmd_dependency_diff_arch_bitstream;
+  cmd_dependency_diff_arch_bitstream.push_back(
+    shell_cmd_build_arch_bitstream_id);
+  add_diff_arch_bitstream_command_template(
+    shell, openfpga_bitstream_cmd_class, cmd_dependency_diff_arch_bitstream,
+    hidden);
+
   /********************************
    * Command 'build_fabric_bitstream'
    */
@@ -344,18 +705,55 @@ void add_bitstream_command_templates(openfpga::Shell<T>& shell,
       shell, openfpga_bitstream_cmd_class,
       cmd_dependency_build_fabric_bitstream, hidden);
 
+  /********************************
+   * Command 'verify_fabric_bitstream'
+   */
+  /* The 'verify_fabric_bitstream' command should NOT be executed before
+   * 'build_fabric_bitstream' */
+  std::vector<ShellCommandId> cmd_dependency_verify_fabric_bitstream;
+  cmd_dependency_verify_fabric_bitstream.push_back(
+    shell_cmd_build_fabric_bitstream_id);
+  add_verify_fabric_bitstream_command_template(
+    shell, openfpga_bitstream_cmd_class, cmd_dependency_verify_fabric_bitstream,
+    hidden);
+
+  /********************************
+   * Command 'simulate_fabric_configuration'
+   */
+  /* The 'simulate_fabric_configuration' command should NOT be executed before
+   * 'build_fabric_bitstream' */
+  std::vector<ShellCommandId> cmd_dependency_simulate_fabric_configuration;
+  cmd_dependency_simulate_fabric_configuration.push_back(
+    shell_cmd_build_fabric_bitstream_id);
+  add_simulate_fabric_configuration_command_template(
+    shell, openfpga_bitstream_cmd_class,
+    cmd_dependency_simulate_fabric_configuration, hidden);
+
   /********************************
    * Command 'write_fabric_bitstream'
    */
   /* The 'write_fabric_bitstream' command should NOT be executed before
-   * 'build_fabric_bitstream' */
+   * 'build_architecture_bitstream'. Unless the option '--stream' is used,
+   * 'build_fabric_bitstream' should also be executed, which is checked by the
+   * command itself */
   std::vector<ShellCommandId> cmd_dependency_write_fabric_bitstream;
   cmd_dependency_write_fabric_bitstream.push_back(
-    shell_cmd_build_fabric_bitstream_id);
+    shell_cmd_build_arch_bitstream_id);
   add_write_fabric_bitstream_command_template(
     shell, openfpga_bitstream_cmd_class, cmd_dependency_write_fabric_bitstream,
     hidden);
 
+  /********************************
+   * Command 'read_fabric_bitstream'
+   */
+  /* The 'read_fabric_bitstream' command can be executed at any time. The
+   * option '--compare' requires 'build_fabric_bitstream', which is checked
+   * by the command itself */
+  std::vector<ShellCommandId> cmd_dependency_read_fabric_bitstream;
+  add_read_fabric_bitstream_command_template(
+    shell, openfpga_bitstream_cmd_class, cmd_dependency_read_fabric_bitstream,
+    hidden);
+
   /********************************
    * Command 'write_io_mapping'
    */
@@ -366,6 +764,26 @@ void add_bitstream_command_templates(openfpga::Shell<T>& shell,
   add_write_io_mapping_command_template(shell, openfpga_bitstream_cmd_class,
                                         cmd_dependency_write_io_mapping,
                                         hidden);
+
+  /********************************
+   * Command 'save_checkpoint'
+   */
+  /* The 'save_checkpoint' command should NOT be executed before
+   * 'build_fabric', as the checkpoint is bound to the fabric */
+  std::vector<ShellCommandId> cmd_dependency_save_checkpoint;
+  cmd_dependency_save_checkpoint.push_back(shell_cmd_build_fabric_id);
+  add_save_checkpoint_command_template(shell, openfpga_bitstream_cmd_class,
+                                       cmd_dependency_save_checkpoint, hidden);
+
+  /********************************
+   * Command 'load_checkpoint'
+   */
+  /* The 'load_checkpoint' command should NOT be executed before
+   * 'build_fabric', as the checkpoint is bound to the fabric */
+  std::vector<ShellCommandId> cmd_dependency_load_checkpoint;
+  cmd_dependency_load_checkpoint.push_back(shell_cmd_build_fabric_id);
+  add_load_checkpoint_command_template(shell, openfpga_bitstream_cmd_class,
+                                       cmd_dependency_load_checkpoint, hidden);
 }
 
 } /* end namespace openfpga */
@@ -11,14 +11,28 @@
 #include "command.h"
 #include "command_context.h"
 #include "command_exit_codes.h"
+#include "diff_arch_bitstream.h"
+#include "fabric_bitstream_template_file.h"
+#include "fast_configuration.h"
 #include "globals.h"
+#include "openfpga_decode.h"
 #include "openfpga_digest.h"
+#include "openfpga_hash.h"
 #include "openfpga_naming.h"
+#include "openfpga_parallel.h"
 #include "openfpga_reserved_words.h"
+#include "openfpga_tokenizer.h"
+#include "openfpga_version.h"
+#include "read_bin_arch_bitstream.h"
+#include "read_text_fabric_bitstream.h"
 #include "read_xml_arch_bitstream.h"
 #include "report_bitstream_distribution.h"
+#include "simulate_fabric_configuration.h"
+#include "verify_fabric_bitstream.h"
 #include "vtr_log.h"
 #include "vtr_time.h"
+#include "write_bin_arch_bitstream.h"
+#include "write_bin_fabric_bitstream.h"
 #include "write_text_fabric_bitstream.h"
 #include "write_xml_arch_bitstream.h"
 #include "write_xml_fabric_bitstream.h"
@@ -37,13 +51,46 @@ int fpga_bitstream_template(T& openfpga_ctx, const Command& cmd,
   CommandOptionId opt_no_time_stamp = cmd.option("no_time_stamp");
   CommandOptionId opt_write_file = cmd.option("write_file");
   CommandOptionId opt_read_file = cmd.option("read_file");
+  CommandOptionId opt_write_format = cmd.option("write_format");
+  CommandOptionId opt_threads = cmd.option("threads");
+
+  /* Default to be single-thread */
+  size_t num_threads = 1;
+  if ((true == cmd_context.option_enable(cmd, opt_threads)) &&
+      (false == parse_num_threads(cmd_context.option_value(cmd, opt_threads),
+                                  num_threads))) {
+    return CMD_EXEC_FATAL_ERROR;
+  }
+
+  /* Binary file is the only format other than XML */
+  bool write_bin_file = false;
+  if (true == cmd_context.option_enable(cmd, opt_write_format)) {
+    std::string write_format = cmd_context.option_value(cmd, opt_write_format);
+    if (std::string("bin") == write_format) {
+      write_bin_file = true;
+    } else if (std::string("xml") != write_format) {
+      VTR_LOG_ERROR(
+        "Invalid file format '%s' for the bitstream database! Expect "
+        "[xml|bin]\n",
+        write_format.c_str());
+      return CMD_EXEC_FATAL_ERROR;
+    }
+  }
 
   if (true == cmd_context.option_enable(cmd, opt_read_file)) {
-    openfpga_ctx.mutable_bitstream_manager() = read_xml_architecture_bitstream(
-      cmd_context.option_value(cmd, opt_read_file).c_str());
+    /* The format of the file is detected from its content */
+    std::string read_file = cmd_context.option_value(cmd, opt_read_file);
+    if (true == is_bin_architecture_bitstream_file(read_file.c_str())) {
+      openfpga_ctx.mutable_bitstream_manager() =
+        read_bin_architecture_bitstream(read_file.c_str());
+    } else {
+      openfpga_ctx.mutable_bitstream_manager() =
+        read_xml_architecture_bitstream(read_file.c_str());
+    }
   } else {
-    openfpga_ctx.mutable_bitstream_manager() = build_device_bitstream(
-      g_vpr_ctx, openfpga_ctx, cmd_context.option_enable(cmd, opt_verbose));
+    openfpga_ctx.mutable_bitstream_manager() =
+      build_device_bitstream(g_vpr_ctx, openfpga_ctx, num_threads,
+                             cmd_context.option_enable(cmd, opt_verbose));
   }
 
   if (true == cmd_context.option_enable(cmd, opt_write_file)) {
@@ -53,16 +100,50 @@ int fpga_bitstream_template(T& openfpga_ctx, const Command& cmd,
     /* Create directories */
     create_directory(src_dir_path);
 
-    write_xml_architecture_bitstream(
-      openfpga_ctx.bitstream_manager(),
-      cmd_context.option_value(cmd, opt_write_file),
-      !cmd_context.option_enable(cmd, opt_no_time_stamp));
+    if (true == write_bin_file) {
+      if (0 != write_bin_architecture_bitstream(
+                 openfpga_ctx.bitstream_manager(),
+                 cmd_context.option_value(cmd, opt_write_file))) {
+        return CMD_EXEC_FATAL_ERROR;
+      }
+    } else {
+      write_xml_architecture_bitstream(
+        openfpga_ctx.bitstream_manager(),
+        cmd_context.option_value(cmd, opt_write_file),
+        !cmd_context.option_enable(cmd, opt_no_time_stamp),
+        num_threads);
+    }
   }
 
   /* TODO: should identify the error code from internal function execution */
   return CMD_EXEC_SUCCESS;
 }
 
+/********************************************************************
+ * Compute the key of a fabric bitstream template from the FPGA fabric, i.e.,
+ * - the version of OpenFPGA
+ * - the device and the number of modules of the fabric
+ * - the configuration protocol
+ * - the size of the bitstream database
+ *******************************************************************/
+template <class T>
+size_t find_fabric_bitstream_template_key_template(const T& openfpga_ctx) {
+  size_t key = 0;
+  hash_combine<std::string>(key, std::string(VERSION));
+
+  hash_combine<size_t>(key, g_vpr_ctx.device().grid.width());
+  hash_combine<size_t>(key, g_vpr_ctx.device().grid.height());
+  hash_combine<size_t>(key, openfpga_ctx.module_graph().num_modules());
+
+  hash_combine<int>(key, int(openfpga_ctx.arch().config_protocol.type()));
+  hash_combine<int>(key, openfpga_ctx.arch().config_protocol.num_regions());
+
+  hash_combine<size_t>(key, openfpga_ctx.bitstream_manager().num_blocks());
+  hash_combine<size_t>(key, openfpga_ctx.bitstream_manager().num_bits());
+
+  return key;
+}
+
 /********************************************************************
  * A wrapper function to call the build_fabric_bitstream() in FPGA bitstream
  *******************************************************************/
@@ -70,14 +151,132 @@ template <class T>
 int build_fabric_bitstream_template(T& openfpga_ctx, const Command& cmd,
                                     const CommandContext& cmd_context) {
   CommandOptionId opt_verbose = cmd.option("verbose");
+  CommandOptionId opt_incremental = cmd.option("incremental");
+  CommandOptionId opt_region = cmd.option("region");
+  CommandOptionId opt_tiles = cmd.option("tiles");
+  CommandOptionId opt_template_file = cmd.option("template_file");
+  CommandOptionId opt_threads = cmd.option("threads");
+
+  /* Default to be single-thread */
+  size_t num_threads = 1;
+  if ((true == cmd_context.option_enable(cmd, opt_threads)) &&
+      (false == parse_num_threads(cmd_context.option_value(cmd, opt_threads),
+                                  num_threads))) {
+    return CMD_EXEC_FATAL_ERROR;
+  }
+
+  /* Collect the regions of a partial bitstream, in the coordinates of the
+   * configurable children of the top-level module */
+  std::vector<vtr::Rect<int>> child_regions;
+  if (true == cmd_context.option_enable(cmd, opt_region)) {
+    std::string region_str = cmd_context.option_value(cmd, opt_region);
+    std::vector<std::string> tokens = StringToken(region_str).split(',');
+    if (4 != tokens.size()) {
+      VTR_LOG_ERROR(
+        "Invalid region '%s'! Expect <xmin>,<ymin>,<xmax>,<ymax>\n",
+        region_str.c_str());
+      return CMD_EXEC_FATAL_ERROR;
+    }
+    child_regions.push_back(vtr::Rect<int>(
+      std::atoi(tokens[0].c_str()), std::atoi(tokens[1].c_str()),
+      std::atoi(tokens[2].c_str()), std::atoi(tokens[3].c_str())));
+  }
+  if (true == cmd_context.option_enable(cmd, opt_tiles)) {
+    if (true == openfpga_ctx.fabric_tile().empty()) {
+      VTR_LOG_ERROR(
+        "No tiles are defined! Option '--tiles' requires the fabric to be "
+        "built with tiles grouped\n");
+      return CMD_EXEC_FATAL_ERROR;
+    }
+    std::string tiles_str = cmd_context.option_value(cmd, opt_tiles);
+    for (const std::string& token : StringToken(tiles_str).split(',')) {
+      FabricTileId tile_id = FabricTileId(std::atoi(token.c_str()));
+      if (false == openfpga_ctx.fabric_tile().valid_tile_id(tile_id)) {
+        VTR_LOG_ERROR("Invalid tile id '%s'!\n", token.c_str());
+        return CMD_EXEC_FATAL_ERROR;
+      }
+      vtr::Point<size_t> tile_coord =
+        openfpga_ctx.fabric_tile().tile_coordinate(tile_id);
+      child_regions.push_back(vtr::Rect<int>(tile_coord.x(), tile_coord.y(),
+                                             tile_coord.x(), tile_coord.y()));
+    }
+  }
+  /* The bits of a configuration chain are shifted through all the blocks, so
+   * that a part of the fabric can not be programmed alone */
+  if ((false == child_regions.empty()) &&
+      ((CONFIG_MEM_STANDALONE == openfpga_ctx.arch().config_protocol.type()) ||
+       (CONFIG_MEM_SCAN_CHAIN == openfpga_ctx.arch().config_protocol.type()))) {
+    VTR_LOG_ERROR(
+      "Partial bitstream is only applicable to the configuration protocols "
+      "using addresses!\n");
+    return CMD_EXEC_FATAL_ERROR;
+  }
+  if ((false == child_regions.empty()) &&
+      (true == cmd_context.option_enable(cmd, opt_template_file))) {
+    VTR_LOG_ERROR("Option '%s' is not applicable to partial bitstreams!\n",
+                  cmd.option_name(opt_template_file).c_str());
+    return CMD_EXEC_FATAL_ERROR;
+  }
+
+  /* After an engineering change, the fabric bitstream of the previous
+   * implementation has the same addresses, and only the data inputs have to
+   * be updated. The fabric bitstream is rebuilt when it does not match the
+   * bitstream database, or when a partial bitstream is required */
+  if ((true == cmd_context.option_enable(cmd, opt_incremental)) &&
+      (true == child_regions.empty()) &&
+      (0 < openfpga_ctx.fabric_bitstream().num_bits()) &&
+      (openfpga_ctx.fabric_bitstream().num_bits() ==
+       openfpga_ctx.bitstream_manager().num_bits())) {
+    vtr::ScopedStartFinishTimer timer("\nUpdate fabric dependent bitstream\n");
+    size_t num_changed_bits =
+      update_fabric_bitstream_dins(openfpga_ctx.mutable_fabric_bitstream(),
+                                   openfpga_ctx.bitstream_manager());
+    VTR_LOG("Updated %lu configuration bits of fabric\n", num_changed_bits);
+    return CMD_EXEC_SUCCESS;
+  }
+  if (true == cmd_context.option_enable(cmd, opt_incremental)) {
+    VTR_LOG(
+      "No fabric bitstream matches the bitstream database. Rebuild it from "
+      "scratch\n");
+  }
+
+  /* The sequence and the addresses of the bits only depend on the fabric,
+   * which can be loaded from a template built for another design. Otherwise,
+   * the fabric bitstream is built as usual and the template is saved */
+  size_t template_key = 0;
+  if (true == cmd_context.option_enable(cmd, opt_template_file)) {
+    template_key = find_fabric_bitstream_template_key_template<T>(openfpga_ctx);
+    std::shared_ptr<const FabricBitstreamTemplate> bitstream_template;
+    int read_status = read_fabric_bitstream_template(
+      cmd_context.option_value(cmd, opt_template_file), template_key,
+      bitstream_template, cmd_context.option_enable(cmd, opt_verbose));
+    if (CMD_EXEC_FATAL_ERROR == read_status) {
+      return CMD_EXEC_FATAL_ERROR;
+    }
+    if (CMD_EXEC_SUCCESS == read_status) {
+      openfpga_ctx.mutable_fabric_bitstream() =
+        build_fabric_bitstream_from_template(
+          bitstream_template, openfpga_ctx.bitstream_manager(),
+          cmd_context.option_enable(cmd, opt_verbose));
+      return CMD_EXEC_SUCCESS;
+    }
+    VTR_LOG("Build the fabric bitstream from scratch\n");
+  }
 
   /* Build fabric bitstream here */
   openfpga_ctx.mutable_fabric_bitstream() = build_fabric_dependent_bitstream(
     openfpga_ctx.bitstream_manager(), openfpga_ctx.module_graph(),
     openfpga_ctx.module_name_map(), openfpga_ctx.arch().circuit_lib,
-    openfpga_ctx.arch().config_protocol,
+    openfpga_ctx.arch().config_protocol, child_regions, num_threads,
     cmd_context.option_enable(cmd, opt_verbose));
 
+  if (true == cmd_context.option_enable(cmd, opt_template_file)) {
+    return write_fabric_bitstream_template(
+      cmd_context.option_value(cmd, opt_template_file), template_key,
+      *openfpga_ctx.fabric_bitstream().bitstream_template(),
+      cmd_context.option_enable(cmd, opt_verbose));
+  }
+
   /* TODO: should identify the error code from internal function execution */
   return CMD_EXEC_SUCCESS;
 }
@@ -99,10 +298,24 @@ int write_fabric_bitstream_template(const T& openfpga_ctx, const Command& cmd,
   CommandOptionId opt_path_only = cmd.option("path_only");
   CommandOptionId opt_value_only = cmd.option("value_only");
   CommandOptionId opt_trim_path = cmd.option("trim_path");
+  CommandOptionId opt_shard_by_region = cmd.option("shard_by_region");
+  CommandOptionId opt_stream = cmd.option("stream");
+  CommandOptionId opt_reference_file = cmd.option("reference_file");
+  CommandOptionId opt_threads = cmd.option("threads");
+  CommandOptionId opt_compress = cmd.option("compress");
+  CommandOptionId opt_region_hash = cmd.option("region_hash");
 
   /* Write fabric bitstream if required */
   int status = CMD_EXEC_SUCCESS;
 
+  /* Default to be single-thread */
+  size_t num_threads = 1;
+  if ((true == cmd_context.option_enable(cmd, opt_threads)) &&
+      (false == parse_num_threads(cmd_context.option_value(cmd, opt_threads),
+                                  num_threads))) {
+    return CMD_EXEC_FATAL_ERROR;
+  }
+
   VTR_ASSERT(true == cmd_context.option_enable(cmd, opt_file));
 
   std::string src_dir_path =
@@ -132,26 +345,79 @@ int write_fabric_bitstream_template(const T& openfpga_ctx, const Command& cmd,
     cmd_context.option_enable(cmd, opt_path_only));
   bitfile_writer_opt.set_value_only(
     cmd_context.option_enable(cmd, opt_value_only));
+  bitfile_writer_opt.set_shard_by_region(
+    cmd_context.option_enable(cmd, opt_shard_by_region));
   bitfile_writer_opt.set_fast_configuration(
     cmd_context.option_enable(cmd, opt_fast_config));
   bitfile_writer_opt.set_keep_dont_care_bits(
     cmd_context.option_enable(cmd, opt_keep_dont_care_bits));
   bitfile_writer_opt.set_wl_decremental_order(
     cmd_context.option_enable(cmd, opt_wl_decremental_order));
+  bitfile_writer_opt.set_num_threads(num_threads);
+  bitfile_writer_opt.set_compress(cmd_context.option_enable(cmd, opt_compress));
+  bitfile_writer_opt.set_region_hash(
+    cmd_context.option_enable(cmd, opt_region_hash));
   if (cmd_context.option_enable(cmd, opt_filter_value)) {
     bitfile_writer_opt.set_filter_value(
       cmd_context.option_value(cmd, opt_filter_value));
   }
+  if (cmd_context.option_enable(cmd, opt_reference_file)) {
+    bitfile_writer_opt.set_reference_file(
+      cmd_context.option_value(cmd, opt_reference_file));
+  }
   if (!bitfile_writer_opt.validate(true)) {
     VTR_LOG_ERROR("Conflicts detected in options for bitstream writer!\n");
     return CMD_EXEC_FATAL_ERROR;
   }
 
+  if (true == cmd_context.option_enable(cmd, opt_stream)) {
+    if (bitfile_writer_opt.output_file_type() !=
+        BitstreamWriterOption::e_bitfile_type::TEXT) {
+      VTR_LOG_ERROR(
+        "Option '--stream' is only applicable to plain_text file format!\n");
+      return CMD_EXEC_FATAL_ERROR;
+    }
+    if (false == bitfile_writer_opt.reference_file().empty()) {
+      VTR_LOG_ERROR(
+        "Option '--reference_file' is not applicable with option "
+        "'--stream'!\n");
+      return CMD_EXEC_FATAL_ERROR;
+    }
+    if (true == bitfile_writer_opt.region_hash()) {
+      VTR_LOG_ERROR(
+        "Option '--region_hash' is not applicable with option "
+        "'--stream'!\n");
+      return CMD_EXEC_FATAL_ERROR;
+    }
+    status = stream_fabric_bitstream_to_text_file(
+      openfpga_ctx.bitstream_manager(), openfpga_ctx.module_graph(),
+      openfpga_ctx.module_name_map(), openfpga_ctx.arch().config_protocol,
+      openfpga_ctx.fabric_global_port_info(), bitfile_writer_opt);
+    return status;
+  }
+
+  /* The fabric bitstream is required when not streaming. Note that a partial
+   * fabric bitstream may have less bits than the bitstream database */
+  if ((0 == openfpga_ctx.fabric_bitstream().num_bits()) ||
+      (openfpga_ctx.fabric_bitstream().num_bits() >
+       openfpga_ctx.bitstream_manager().num_bits())) {
+    VTR_LOG_ERROR(
+      "Fabric bitstream is not built! Please run command "
+      "'build_fabric_bitstream' or use the option '--stream'\n");
+    return CMD_EXEC_FATAL_ERROR;
+  }
+
   if (bitfile_writer_opt.output_file_type() ==
       BitstreamWriterOption::e_bitfile_type::XML) {
     status = write_fabric_bitstream_to_xml_file(
       openfpga_ctx.bitstream_manager(), openfpga_ctx.fabric_bitstream(),
       openfpga_ctx.arch().config_protocol, bitfile_writer_opt);
+  } else if (bitfile_writer_opt.output_file_type() ==
+             BitstreamWriterOption::e_bitfile_type::BIN) {
+    status = write_fabric_bitstream_to_bin_file(
+      openfpga_ctx.bitstream_manager(), openfpga_ctx.fabric_bitstream(),
+      openfpga_ctx.arch().config_protocol,
+      openfpga_ctx.fabric_global_port_info(), bitfile_writer_opt);
   } else {
     VTR_ASSERT_SAFE(bitfile_writer_opt.output_file_type() ==
                     BitstreamWriterOption::e_bitfile_type::TEXT);
@@ -223,6 +489,7 @@ int report_bitstream_distribution_template(const T& openfpga_ctx,
                                            const CommandContext& cmd_context) {
   CommandOptionId opt_file = cmd.option("file");
   CommandOptionId opt_no_time_stamp = cmd.option("no_time_stamp");
+  CommandOptionId opt_count_ones = cmd.option("count_ones");
 
   int status = CMD_EXEC_SUCCESS;
 
@@ -250,11 +517,256 @@ int report_bitstream_distribution_template(const T& openfpga_ctx,
   status = report_bitstream_distribution(
     cmd_context.option_value(cmd, opt_file), openfpga_ctx.bitstream_manager(),
     openfpga_ctx.fabric_bitstream(),
-    !cmd_context.option_enable(cmd, opt_no_time_stamp), depth);
+    !cmd_context.option_enable(cmd, opt_no_time_stamp), depth,
+    cmd_context.option_enable(cmd, opt_count_ones));
 
   return status;
 }
 
+/********************************************************************
+ * A wrapper function to compare the bitstream database to a reference one
+ * read from a file, in either XML or binary format
+ *******************************************************************/
+template <class T>
+int diff_architecture_bitstream_template(const T& openfpga_ctx,
+                                         const Command& cmd,
+                                         const CommandContext& cmd_context) {
+  CommandOptionId opt_reference = cmd.option("reference");
+  CommandOptionId opt_report = cmd.option("report");
+  CommandOptionId opt_verbose = cmd.option("verbose");
+
+  VTR_ASSERT(true == cmd_context.option_enable(cmd, opt_reference));
+
+  /* The format of the file is detected from its content */
+  std::string ref_file = cmd_context.option_value(cmd, opt_reference);
+  BitstreamManager reference;
+  if (true == is_bin_architecture_bitstream_file(ref_file.c_str())) {
+    reference = read_bin_architecture_bitstream(ref_file.c_str());
+  } else {
+    reference = read_xml_architecture_bitstream(ref_file.c_str());
+  }
+
+  const BitstreamManager& bitstream_manager = openfpga_ctx.bitstream_manager();
+  ArchBitstreamDiff diff =
+    diff_architecture_bitstream(reference, bitstream_manager);
+
+  if (true == cmd_context.option_enable(cmd, opt_verbose)) {
+    for (size_t iblk = 0; iblk < diff.changed_blocks.size(); ++iblk) {
+      VTR_LOG("Block '%s': %lu bits changed\n",
+              bitstream_manager.block_path(diff.changed_blocks[iblk]).c_str(),
+              diff.num_changed_bits[iblk]);
+    }
+    for (const ConfigBlockId& block : diff.added_blocks) {
+      VTR_LOG("Block '%s': not in the reference\n",
+              bitstream_manager.block_path(block).c_str());
+    }
+    for (const ConfigBlockId& ref_block : diff.removed_blocks) {
+      VTR_LOG("Block '%s': only in the reference\n",
+              reference.block_path(ref_block).c_str());
+    }
+  }
+
+  VTR_LOG(
+    "Found %lu changed bits in %lu blocks, %lu added blocks and %lu removed "
+    "blocks compared to reference '%s'\n",
+    diff.num_total_changed_bits(), diff.changed_blocks.size(),
+    diff.added_blocks.size(), diff.removed_blocks.size(), ref_file.c_str());
+
+  if (true == cmd_context.option_enable(cmd, opt_report)) {
+    std::string report_file = cmd_context.option_value(cmd, opt_report);
+    create_directory(find_path_dir_name(report_file));
+    if (0 != write_architecture_bitstream_diff_to_file(
+               report_file, reference, bitstream_manager, diff)) {
+      return CMD_EXEC_FATAL_ERROR;
+    }
+  }
+
+  return CMD_EXEC_SUCCESS;
+}
+
+/********************************************************************
+ * A wrapper function to call the verify_fabric_bitstream() in FPGA bitstream
+ *******************************************************************/
+template <class T>
+int verify_fabric_bitstream_template(const T& openfpga_ctx, const Command& cmd,
+                                     const CommandContext& cmd_context) {
+  CommandOptionId opt_threads = cmd.option("threads");
+  CommandOptionId opt_verbose = cmd.option("verbose");
+
+  /* Default to be single-thread */
+  size_t num_threads = 1;
+  if ((true == cmd_context.option_enable(cmd, opt_threads)) &&
+      (false == parse_num_threads(cmd_context.option_value(cmd, opt_threads),
+                                  num_threads))) {
+    return CMD_EXEC_FATAL_ERROR;
+  }
+
+  if (0 == openfpga_ctx.fabric_bitstream().num_bits()) {
+    VTR_LOG_ERROR(
+      "No fabric bitstream is found! Please execute command "
+      "'build_fabric_bitstream' first\n");
+    return CMD_EXEC_FATAL_ERROR;
+  }
+
+  return verify_fabric_bitstream(
+    openfpga_ctx.fabric_bitstream(), openfpga_ctx.bitstream_manager(),
+    openfpga_ctx.module_graph(), openfpga_ctx.module_name_map(),
+    num_threads, cmd_context.option_enable(cmd, opt_verbose));
+}
+
+/********************************************************************
+ * A wrapper function to call the simulate_fabric_configuration() in FPGA
+ * bitstream
+ *******************************************************************/
+template <class T>
+int simulate_fabric_configuration_template(const T& openfpga_ctx,
+                                           const Command& cmd,
+                                           const CommandContext& cmd_context) {
+  CommandOptionId opt_file = cmd.option("file");
+  CommandOptionId opt_fast_configuration = cmd.option("fast_configuration");
+  CommandOptionId opt_verbose = cmd.option("verbose");
+
+  if (0 == openfpga_ctx.fabric_bitstream().num_bits()) {
+    VTR_LOG_ERROR(
+      "No fabric bitstream is found! Please execute command "
+      "'build_fabric_bitstream' first\n");
+    return CMD_EXEC_FATAL_ERROR;
+  }
+
+  /* Apply the same fast configuration as the full testbench */
+  bool apply_fast_configuration =
+    cmd_context.option_enable(cmd, opt_fast_configuration) &&
+    is_fast_configuration_applicable(openfpga_ctx.fabric_global_port_info());
+  bool bit_value_to_skip = false;
+  if (true == apply_fast_configuration) {
+    bit_value_to_skip = find_bit_value_to_skip_for_fast_configuration(
+      openfpga_ctx.arch().config_protocol.type(),
+      openfpga_ctx.fabric_global_port_info(), openfpga_ctx.bitstream_manager(),
+      openfpga_ctx.fabric_bitstream());
+  }
+
+  ConfigMemoryState memory_state;
+  size_t num_config_cycles = 0;
+  int status = simulate_fabric_configuration(
+    memory_state, num_config_cycles, openfpga_ctx.bitstream_manager(),
+    openfpga_ctx.fabric_bitstream(), openfpga_ctx.module_graph(),
+    openfpga_ctx.module_name_map(), openfpga_ctx.arch().config_protocol,
+    apply_fast_configuration, bit_value_to_skip);
+  if (CMD_EXEC_SUCCESS != status) {
+    return status;
+  }
+  VTR_LOG("Configuration takes %lu programming cycles\n", num_config_cycles);
+
+  if (true == cmd_context.option_enable(cmd, opt_file)) {
+    std::string fname = cmd_context.option_value(cmd, opt_file);
+    create_directory(find_path_dir_name(fname));
+    status = write_config_memory_state_to_file(
+      fname, openfpga_ctx.bitstream_manager(), memory_state);
+    if (CMD_EXEC_SUCCESS != status) {
+      return status;
+    }
+  }
+
+  size_t num_mismatches = report_config_memory_state_mismatches(
+    openfpga_ctx.bitstream_manager(), memory_state,
+    cmd_context.option_enable(cmd, opt_verbose));
+  if (0 < num_mismatches) {
+    VTR_LOG_ERROR(
+      "%lu configuration memories do not have the value of the bitstream "
+      "database after configuration!\n",
+      num_mismatches);
+    return CMD_EXEC_FATAL_ERROR;
+  }
+  VTR_LOG("All the %lu configuration memories are correctly configured\n",
+          memory_state.size());
+
+  return CMD_EXEC_SUCCESS;
+}
+
+/********************************************************************
+ * A wrapper function to read and check a fabric bitstream in plain text
+ *******************************************************************/
+template <class T>
+int read_text_fabric_bitstream_template(const T& openfpga_ctx,
+                                        const Command& cmd,
+                                        const CommandContext& cmd_context) {
+  CommandOptionId opt_file = cmd.option("file");
+  CommandOptionId opt_compare = cmd.option("compare");
+  CommandOptionId opt_verbose = cmd.option("verbose");
+
+  std::string fname = cmd_context.option_value(cmd, opt_file);
+  vtr::ScopedStartFinishTimer timer("Read fabric bitstream from '" + fname +
+                                    "'");
+
+  TextFabricBitstreamFile bitstream_file;
+  bitstream_file.open(fname);
+  if (true == cmd_context.option_enable(cmd, opt_verbose)) {
+    for (const auto& field : bitstream_file.fields()) {
+      VTR_LOG("%s: %s\n", std::string(field.first).c_str(),
+              std::string(field.second).c_str());
+    }
+  }
+  VTR_LOG(
+    "Found %lu bits in %lu lines, including %lu '1' and %lu don't care bits\n",
+    bitstream_file.num_bits(), bitstream_file.num_lines(),
+    bitstream_file.num_ones(), bitstream_file.num_dont_care_bits());
+
+  size_t num_errors = check_text_fabric_bitstream_file(bitstream_file);
+  if (0 < num_errors) {
+    VTR_LOG_ERROR("Found %lu errors in fabric bitstream '%s'!\n", num_errors,
+                  fname.c_str());
+    return CMD_EXEC_FATAL_ERROR;
+  }
+
+  if (false == cmd_context.option_enable(cmd, opt_compare)) {
+    return CMD_EXEC_SUCCESS;
+  }
+
+  /* Only the flatten bitstream of the standalone configuration protocol has
+   * a bit for each fabric bit in the order of the fabric bitstream */
+  if (CONFIG_MEM_STANDALONE != openfpga_ctx.arch().config_protocol.type()) {
+    VTR_LOG_ERROR(
+      "Option '--compare' is only applicable to the standalone configuration "
+      "protocol!\n");
+    return CMD_EXEC_FATAL_ERROR;
+  }
+  const FabricBitstream& fabric_bitstream = openfpga_ctx.fabric_bitstream();
+  const BitstreamManager& bitstream_manager = openfpga_ctx.bitstream_manager();
+  if (0 == fabric_bitstream.num_bits()) {
+    VTR_LOG_ERROR(
+      "Option '--compare' requires to run 'build_fabric_bitstream' first!\n");
+    return CMD_EXEC_FATAL_ERROR;
+  }
+  if ((1 != bitstream_file.num_lines()) ||
+      (fabric_bitstream.num_bits() != bitstream_file.num_bits())) {
+    VTR_LOG_ERROR("Expect %lu bits in a single line as the fabric bitstream!\n",
+                  fabric_bitstream.num_bits());
+    return CMD_EXEC_FATAL_ERROR;
+  }
+  std::string_view bits = bitstream_file.line(0);
+  size_t num_mismatches = 0;
+  size_t ibit = 0;
+  for (const FabricBitId& fabric_bit : fabric_bitstream.bits()) {
+    char expected_bit =
+      bitstream_manager.bit_value(fabric_bitstream.config_bit(fabric_bit))
+        ? '1'
+        : '0';
+    if ((DONT_CARE_CHAR != bits[ibit]) && (expected_bit != bits[ibit])) {
+      num_mismatches++;
+    }
+    ibit++;
+  }
+  if (0 < num_mismatches) {
+    VTR_LOG_ERROR("%lu bits are different from the fabric bitstream!\n",
+                  num_mismatches);
+    return CMD_EXEC_FATAL_ERROR;
+  }
+  VTR_LOG("Fabric bitstream '%s' matches the fabric bitstream\n",
+          fname.c_str());
+
+  return CMD_EXEC_SUCCESS;
+}
+
 } /* end namespace openfpga */
 
 #endif
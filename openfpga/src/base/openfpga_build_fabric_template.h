@@ -3,6 +3,11 @@
 /********************************************************************
  * This file includes functions to compress the hierachy of routing architecture
  *******************************************************************/
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <unordered_set>
+
 #include "build_device_module.h"
 #include "build_fabric_global_port_info.h"
 #include "build_fabric_io_location_map.h"
@@ -12,10 +17,17 @@
 #include "command_exit_codes.h"
 #include "device_rr_gsb.h"
 #include "device_rr_gsb_utils.h"
+#include "fabric_database.h"
 #include "fabric_hierarchy_writer.h"
 #include "fabric_key_writer.h"
 #include "globals.h"
+#include "merge_identical_modules.h"
+#include "module_circuit_model_dependency.h"
+#include "openfpga_hash.h"
 #include "openfpga_naming.h"
+#include "openfpga_parallel.h"
+#include "openfpga_version.h"
+#include "read_bin_fabric_key.h"
 #include "read_xml_fabric_key.h"
 #include "read_xml_io_name_map.h"
 #include "read_xml_module_name_map.h"
@@ -34,13 +46,14 @@ namespace openfpga {
  *******************************************************************/
 template <class T>
 void compress_routing_hierarchy_template(T& openfpga_ctx,
+                                         const size_t& num_threads,
                                          const bool& verbose_output) {
   vtr::ScopedStartFinishTimer timer(
     "Identify unique General Switch Blocks (GSBs)");
 
   /* Build unique module lists */
   openfpga_ctx.mutable_device_rr_gsb().build_unique_module(
-    g_vpr_ctx.device().rr_graph);
+    g_vpr_ctx.device().rr_graph, num_threads);
 
   /* Report the stats */
   VTR_LOGV(
@@ -91,6 +104,61 @@ void compress_routing_hierarchy_template(T& openfpga_ctx,
             1.));
 }
 
+/********************************************************************
+ * Compute the key of a fabric database from the inputs of the fabric
+ * generation, i.e.,
+ * - the version of OpenFPGA
+ * - the device and its routing resource graph
+ * - the configuration protocol
+ * - the options of build_fabric, as well as the content of the files
+ *   given to the options
+ * Options which do not change the fabric are excluded
+ * Circuit models are not part of the key but checked through their
+ * structural fingerprints, see module_circuit_model_dependency.h
+ *******************************************************************/
+template <class T>
+size_t find_fabric_database_key_template(const T& openfpga_ctx,
+                                         const Command& cmd,
+                                         const CommandContext& cmd_context) {
+  size_t key = 0;
+  hash_combine<std::string>(key, std::string(VERSION));
+
+  hash_combine<size_t>(key, g_vpr_ctx.device().grid.width());
+  hash_combine<size_t>(key, g_vpr_ctx.device().grid.height());
+  hash_combine<size_t>(key, g_vpr_ctx.device().rr_graph.num_nodes());
+
+  hash_combine<int>(key, int(openfpga_ctx.arch().config_protocol.type()));
+  hash_combine<int>(key, openfpga_ctx.arch().config_protocol.num_regions());
+
+  const std::unordered_set<std::string> ignored_options = {
+    "read_fabric_database", "write_fabric_database", "write_fabric_key",
+    "threads", "verbose"};
+  const std::unordered_set<std::string> file_options = {"load_fabric_key",
+                                                        "group_tile"};
+  for (const CommandOptionId& opt : cmd.options()) {
+    std::string opt_name = cmd.option_name(opt);
+    if (0 < ignored_options.count(opt_name)) {
+      continue;
+    }
+    hash_combine<std::string>(key, opt_name);
+    hash_combine<bool>(key, cmd_context.option_enable(cmd, opt));
+    if ((false == cmd_context.option_enable(cmd, opt)) ||
+        (false == cmd.option_require_value(opt))) {
+      continue;
+    }
+    hash_combine<std::string>(key, cmd_context.option_value(cmd, opt));
+    /* Files may be edited in place, so their content is considered */
+    if (0 < file_options.count(opt_name)) {
+      std::ifstream fp(cmd_context.option_value(cmd, opt));
+      std::stringstream content;
+      content << fp.rdbuf();
+      hash_combine<std::string>(key, content.str());
+    }
+  }
+
+  return key;
+}
+
 /********************************************************************
  * Build the module graph for FPGA device
  *******************************************************************/
@@ -102,14 +170,44 @@ int build_fabric_template(T& openfpga_ctx, const Command& cmd,
   CommandOptionId opt_duplicate_grid_pin = cmd.option("duplicate_grid_pin");
   CommandOptionId opt_gen_random_fabric_key =
     cmd.option("generate_random_fabric_key");
+  CommandOptionId opt_random_fabric_key_seed =
+    cmd.option("random_fabric_key_seed");
   CommandOptionId opt_write_fabric_key = cmd.option("write_fabric_key");
   CommandOptionId opt_load_fabric_key = cmd.option("load_fabric_key");
   CommandOptionId opt_group_tile = cmd.option("group_tile");
   CommandOptionId opt_group_config_block = cmd.option("group_config_block");
   CommandOptionId opt_name_module_using_index =
     cmd.option("name_module_using_index");
+  CommandOptionId opt_merge_identical_modules =
+    cmd.option("merge_identical_modules");
+  CommandOptionId opt_read_fabric_database =
+    cmd.option("read_fabric_database");
+  CommandOptionId opt_write_fabric_database =
+    cmd.option("write_fabric_database");
+  CommandOptionId opt_threads = cmd.option("threads");
   CommandOptionId opt_verbose = cmd.option("verbose");
 
+  /* Default to be single-thread */
+  size_t num_threads = 1;
+  if ((true == cmd_context.option_enable(cmd, opt_threads)) &&
+      (false == parse_num_threads(cmd_context.option_value(cmd, opt_threads),
+                                  num_threads))) {
+    return CMD_EXEC_FATAL_ERROR;
+  }
+
+  size_t random_fabric_key_seed = 0;
+  if (true == cmd_context.option_enable(cmd, opt_random_fabric_key_seed)) {
+    if (false == cmd_context.option_enable(cmd, opt_gen_random_fabric_key)) {
+      VTR_LOG_ERROR("Option '%s' requires option '%s' to be enabled!\n",
+                    cmd.option_name(opt_random_fabric_key_seed).c_str(),
+                    cmd.option_name(opt_gen_random_fabric_key).c_str());
+      return CMD_EXEC_FATAL_ERROR;
+    }
+    random_fabric_key_seed = std::strtoull(
+      cmd_context.option_value(cmd, opt_random_fabric_key_seed).c_str(),
+      nullptr, 10);
+  }
+
   /* Report conflicts with options:
    * - group tile does not support duplicate_grid_pin
    * - group tile requires compress_routing to be enabled
@@ -141,9 +239,49 @@ int build_fabric_template(T& openfpga_ctx, const Command& cmd,
     }
   }
 
+  /* Load the fabric from a database if it is built with the same inputs.
+   * Otherwise, the fabric is built as usual */
+  size_t fabric_database_key = 0;
+  std::map<std::string, size_t> circuit_model_fingerprints;
+  if ((true == cmd_context.option_enable(cmd, opt_read_fabric_database)) ||
+      (true == cmd_context.option_enable(cmd, opt_write_fabric_database))) {
+    fabric_database_key =
+      find_fabric_database_key_template<T>(openfpga_ctx, cmd, cmd_context);
+    circuit_model_fingerprints = find_circuit_library_structural_fingerprints(
+      openfpga_ctx.arch().circuit_lib);
+  }
+  /* The local wires found for any previous fabric are outdated */
+  openfpga_ctx.mutable_verilog_wire_layout().clear();
+
+  bool fabric_loaded = false;
+  if (true == cmd_context.option_enable(cmd, opt_read_fabric_database)) {
+    int read_status = read_fabric_database(
+      cmd_context.option_value(cmd, opt_read_fabric_database),
+      fabric_database_key, circuit_model_fingerprints,
+      openfpga_ctx.mutable_module_graph(),
+      openfpga_ctx.mutable_module_name_map(),
+      openfpga_ctx.mutable_decoder_lib(),
+      openfpga_ctx.mutable_blwl_shift_register_banks(),
+      openfpga_ctx.mutable_fabric_tile(),
+      openfpga_ctx.mutable_fabric_global_port_info(),
+      openfpga_ctx.mutable_device_rr_gsb(),
+      cmd_context.option_enable(cmd, opt_verbose));
+    if (CMD_EXEC_FATAL_ERROR == read_status) {
+      return CMD_EXEC_FATAL_ERROR;
+    }
+    fabric_loaded = (CMD_EXEC_SUCCESS == read_status);
+    if (false == fabric_loaded) {
+      VTR_LOG("Build the fabric from scratch\n");
+    }
+  }
+
   if (true == cmd_context.option_enable(cmd, opt_compress_routing)) {
-    compress_routing_hierarchy_template<T>(
-      openfpga_ctx, cmd_context.option_enable(cmd, opt_verbose));
+    /* Unique modules are restored from the fabric database */
+    if (false == fabric_loaded) {
+      compress_routing_hierarchy_template<T>(
+        openfpga_ctx, num_threads,
+        cmd_context.option_enable(cmd, opt_verbose));
+    }
     /* Update flow manager to enable compress routing */
     openfpga_ctx.mutable_flow_manager().set_compress_routing(true);
   }
@@ -161,7 +299,16 @@ int build_fabric_template(T& openfpga_ctx, const Command& cmd,
   if (true == cmd_context.option_enable(cmd, opt_load_fabric_key)) {
     std::string fkey_fname = cmd_context.option_value(cmd, opt_load_fabric_key);
     VTR_ASSERT(false == fkey_fname.empty());
-    predefined_fabric_key = read_xml_fabric_key(fkey_fname.c_str());
+    /* A binary fabric key is identified by its header */
+    if (true == is_bin_fabric_key_file(fkey_fname.c_str())) {
+      curr_status =
+        read_bin_fabric_key(fkey_fname.c_str(), predefined_fabric_key);
+      if (CMD_EXEC_SUCCESS != curr_status) {
+        return CMD_EXEC_FATAL_ERROR;
+      }
+    } else {
+      predefined_fabric_key = read_xml_fabric_key(fkey_fname.c_str());
+    }
   }
 
   VTR_LOG("\n");
@@ -185,24 +332,38 @@ int build_fabric_template(T& openfpga_ctx, const Command& cmd,
     }
   }
 
-  curr_status = build_device_module_graph(
-    openfpga_ctx.mutable_module_graph(), openfpga_ctx.mutable_decoder_lib(),
-    openfpga_ctx.mutable_blwl_shift_register_banks(),
-    openfpga_ctx.mutable_fabric_tile(), openfpga_ctx.mutable_module_name_map(),
-    const_cast<const T&>(openfpga_ctx), g_vpr_ctx.device(),
-    cmd_context.option_enable(cmd, opt_frame_view),
-    cmd_context.option_enable(cmd, opt_compress_routing),
-    cmd_context.option_enable(cmd, opt_duplicate_grid_pin),
-    predefined_fabric_key, tile_config,
-    cmd_context.option_enable(cmd, opt_group_config_block),
-    cmd_context.option_enable(cmd, opt_name_module_using_index),
-    cmd_context.option_enable(cmd, opt_gen_random_fabric_key),
-    cmd_context.option_enable(cmd, opt_verbose));
+  if (false == fabric_loaded) {
+    curr_status = build_device_module_graph(
+      openfpga_ctx.mutable_module_graph(), openfpga_ctx.mutable_decoder_lib(),
+      openfpga_ctx.mutable_blwl_shift_register_banks(),
+      openfpga_ctx.mutable_fabric_tile(),
+      openfpga_ctx.mutable_module_name_map(),
+      const_cast<const T&>(openfpga_ctx), g_vpr_ctx.device(),
+      cmd_context.option_enable(cmd, opt_frame_view),
+      cmd_context.option_enable(cmd, opt_compress_routing),
+      cmd_context.option_enable(cmd, opt_duplicate_grid_pin),
+      predefined_fabric_key, tile_config,
+      cmd_context.option_enable(cmd, opt_group_config_block),
+      cmd_context.option_enable(cmd, opt_name_module_using_index),
+      cmd_context.option_enable(cmd, opt_gen_random_fabric_key),
+      random_fabric_key_seed, num_threads,
+      cmd_context.option_enable(cmd, opt_verbose));
 
-  /* If there is any error, final status cannot be overwritten by a success flag
-   */
-  if (CMD_EXEC_SUCCESS != curr_status) {
-    final_status = curr_status;
+    /* If there is any error, final status cannot be overwritten by a success
+     * flag */
+    if (CMD_EXEC_SUCCESS != curr_status) {
+      final_status = curr_status;
+    }
+
+    /* Merged modules are restored from the fabric database */
+    if ((CMD_EXEC_SUCCESS == final_status) &&
+        (true ==
+         cmd_context.option_enable(cmd, opt_merge_identical_modules))) {
+      final_status = merge_identical_modules(
+        openfpga_ctx.mutable_module_graph(),
+        openfpga_ctx.mutable_module_name_map(),
+        cmd_context.option_enable(cmd, opt_verbose));
+    }
   }
 
   /* Build I/O location map */
@@ -211,10 +372,12 @@ int build_fabric_template(T& openfpga_ctx, const Command& cmd,
     cmd_context.option_enable(cmd, opt_group_tile));
 
   /* Build fabric global port information */
-  openfpga_ctx.mutable_fabric_global_port_info() =
-    build_fabric_global_port_info(
-      openfpga_ctx.module_graph(), openfpga_ctx.arch().config_protocol,
-      openfpga_ctx.arch().tile_annotations, openfpga_ctx.arch().circuit_lib);
+  if (false == fabric_loaded) {
+    openfpga_ctx.mutable_fabric_global_port_info() =
+      build_fabric_global_port_info(
+        openfpga_ctx.module_graph(), openfpga_ctx.arch().config_protocol,
+        openfpga_ctx.arch().tile_annotations, openfpga_ctx.arch().circuit_lib);
+  }
 
   /* Output fabric key if user requested */
   if (true == cmd_context.option_enable(cmd, opt_write_fabric_key)) {
@@ -224,8 +387,8 @@ int build_fabric_template(T& openfpga_ctx, const Command& cmd,
     curr_status = write_fabric_key_to_xml_file(
       openfpga_ctx.module_graph(), fkey_fname,
       openfpga_ctx.arch().config_protocol,
-      openfpga_ctx.blwl_shift_register_banks(), false,
-      cmd_context.option_enable(cmd, opt_verbose));
+      openfpga_ctx.blwl_shift_register_banks(), false, false,
+      num_threads, cmd_context.option_enable(cmd, opt_verbose));
     /* If there is any error, final status cannot be overwritten by a success
      * flag */
     if (CMD_EXEC_SUCCESS != curr_status) {
@@ -233,6 +396,22 @@ int build_fabric_template(T& openfpga_ctx, const Command& cmd,
     }
   }
 
+  /* Save the fabric to a database, so that it can be loaded next time */
+  if ((true == cmd_context.option_enable(cmd, opt_write_fabric_database)) &&
+      (CMD_EXEC_SUCCESS == final_status)) {
+    curr_status = write_fabric_database(
+      cmd_context.option_value(cmd, opt_write_fabric_database),
+      fabric_database_key, circuit_model_fingerprints,
+      openfpga_ctx.module_graph(), openfpga_ctx.module_name_map(),
+      openfpga_ctx.decoder_lib(), openfpga_ctx.blwl_shift_register_banks(),
+      openfpga_ctx.fabric_tile(), openfpga_ctx.fabric_global_port_info(),
+      openfpga_ctx.device_rr_gsb(),
+      cmd_context.option_enable(cmd, opt_verbose));
+    if (CMD_EXEC_SUCCESS != curr_status) {
+      final_status = curr_status;
+    }
+  }
+
   return final_status;
 }
 
@@ -244,6 +423,8 @@ int write_fabric_key_template(const T& openfpga_ctx, const Command& cmd,
                               const CommandContext& cmd_context) {
   CommandOptionId opt_verbose = cmd.option("verbose");
   CommandOptionId opt_include_module_keys = cmd.option("include_module_keys");
+  CommandOptionId opt_binary = cmd.option("binary");
+  CommandOptionId opt_threads = cmd.option("threads");
 
   /* Check the option '--file' is enabled or not
    * Actually, it must be enabled as the shell interface will check
@@ -253,12 +434,21 @@ int write_fabric_key_template(const T& openfpga_ctx, const Command& cmd,
   VTR_ASSERT(true == cmd_context.option_enable(cmd, opt_file));
   VTR_ASSERT(false == cmd_context.option_value(cmd, opt_file).empty());
 
+  /* Default to be single-thread */
+  size_t num_threads = 1;
+  if ((true == cmd_context.option_enable(cmd, opt_threads)) &&
+      (false == parse_num_threads(cmd_context.option_value(cmd, opt_threads),
+                                  num_threads))) {
+    return CMD_EXEC_FATAL_ERROR;
+  }
+
   /* Write fabric key to a file */
   return write_fabric_key_to_xml_file(
     openfpga_ctx.module_graph(), cmd_context.option_value(cmd, opt_file),
     openfpga_ctx.arch().config_protocol,
     openfpga_ctx.blwl_shift_register_banks(),
     cmd_context.option_enable(cmd, opt_include_module_keys),
+    cmd_context.option_enable(cmd, opt_binary), num_threads,
     cmd_context.option_enable(cmd, opt_verbose));
 }
 
@@ -269,6 +459,7 @@ template <class T>
 int write_fabric_hierarchy_template(const T& openfpga_ctx, const Command& cmd,
                                     const CommandContext& cmd_context) {
   CommandOptionId opt_verbose = cmd.option("verbose");
+  CommandOptionId opt_dag = cmd.option("dag");
 
   /* Check the option '--file' is enabled or not
    * Actually, it must be enabled as the shell interface will check
@@ -296,7 +487,8 @@ int write_fabric_hierarchy_template(const T& openfpga_ctx, const Command& cmd,
   /* Write hierarchy to a file */
   return write_fabric_hierarchy_to_text_file(
     openfpga_ctx.module_graph(), openfpga_ctx.module_name_map(), hie_file_name,
-    size_t(depth), cmd_context.option_enable(cmd, opt_verbose));
+    size_t(depth), cmd_context.option_enable(cmd, opt_dag),
+    cmd_context.option_enable(cmd, opt_verbose));
 }
 
 /********************************************************************
@@ -348,6 +540,9 @@ int add_fpga_core_to_fabric_template(T& openfpga_ctx, const Command& cmd,
                          openfpga_ctx.mutable_io_name_map());
   }
 
+  /* The local wires found for the top-level module are outdated */
+  openfpga_ctx.mutable_verilog_wire_layout().clear();
+
   return add_fpga_core_to_device_module_graph(
     openfpga_ctx.mutable_module_graph(), openfpga_ctx.mutable_module_name_map(),
     openfpga_ctx.io_name_map(), core_inst_name, frame_view, verbose_output);
@@ -378,6 +573,9 @@ int rename_modules_template(T& openfpga_ctx, const Command& cmd,
     return CMD_EXEC_FATAL_ERROR;
   }
 
+  /* The local wires named after the child modules are outdated */
+  openfpga_ctx.mutable_verilog_wire_layout().clear();
+
   /* Apply renaming on the user version */
   status = partial_rename_fabric_modules(
     openfpga_ctx.mutable_module_graph(), user_module_name_map,
@@ -0,0 +1,114 @@
+#ifndef OPENFPGA_CHECKPOINT_TEMPLATE_H
+#define OPENFPGA_CHECKPOINT_TEMPLATE_H
+/********************************************************************
+ * This file includes functions to save the bitstream databases of the
+ * OpenFPGA context to a checkpoint and to restore them, so that a script
+ * can resume after the expensive stages
+ *******************************************************************/
+#include <string>
+#include <vector>
+
+#include "bitstream_checkpoint.h"
+#include "command.h"
+#include "command_context.h"
+#include "command_exit_codes.h"
+#include "globals.h"
+#include "openfpga_hash.h"
+#include "openfpga_version.h"
+#include "shell.h"
+#include "vtr_log.h"
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+/********************************************************************
+ * Compute the key of a checkpoint, which identifies the fabric that the
+ * bitstream databases are built for
+ *******************************************************************/
+template <class T>
+size_t find_checkpoint_key_template(const T& openfpga_ctx) {
+  size_t key = 0;
+  hash_combine<std::string>(key, std::string(VERSION));
+
+  hash_combine<size_t>(key, g_vpr_ctx.device().grid.width());
+  hash_combine<size_t>(key, g_vpr_ctx.device().grid.height());
+  hash_combine<size_t>(key, openfpga_ctx.module_graph().num_modules());
+
+  hash_combine<int>(key, int(openfpga_ctx.arch().config_protocol.type()));
+  hash_combine<int>(key, openfpga_ctx.arch().config_protocol.num_regions());
+
+  return key;
+}
+
+/********************************************************************
+ * Save the bitstream databases to a checkpoint directory
+ *******************************************************************/
+template <class T>
+int save_checkpoint_template(const T& openfpga_ctx, const Command& cmd,
+                             const CommandContext& cmd_context) {
+  CommandOptionId opt_file = cmd.option("file");
+  CommandOptionId opt_verbose = cmd.option("verbose");
+
+  if (0 == openfpga_ctx.bitstream_manager().num_blocks()) {
+    VTR_LOG_WARN(
+      "No bitstream database has been built. Nothing is saved to the "
+      "checkpoint\n");
+    return CMD_EXEC_SUCCESS;
+  }
+
+  return write_bitstream_checkpoint(
+    cmd_context.option_value(cmd, opt_file),
+    find_checkpoint_key_template<T>(openfpga_ctx),
+    openfpga_ctx.bitstream_manager(), openfpga_ctx.fabric_bitstream(),
+    cmd_context.option_enable(cmd, opt_verbose));
+}
+
+/********************************************************************
+ * Restore the bitstream databases from a checkpoint directory.
+ * The commands which build the restored databases are marked as
+ * executed, so that the rest of a script can run as if they had been
+ * called
+ *******************************************************************/
+template <class T>
+int load_checkpoint_template(openfpga::Shell<T>* shell, T& openfpga_ctx,
+                             const Command& cmd,
+                             const CommandContext& cmd_context) {
+  CommandOptionId opt_file = cmd.option("file");
+  CommandOptionId opt_verbose = cmd.option("verbose");
+  bool verbose = cmd_context.option_enable(cmd, opt_verbose);
+
+  bool bitstream_manager_loaded = false;
+  bool fabric_bitstream_loaded = false;
+  int status = read_bitstream_checkpoint(
+    cmd_context.option_value(cmd, opt_file),
+    find_checkpoint_key_template<T>(openfpga_ctx),
+    openfpga_ctx.mutable_bitstream_manager(),
+    openfpga_ctx.mutable_fabric_bitstream(), bitstream_manager_loaded,
+    fabric_bitstream_loaded, verbose);
+  if (CMD_EXEC_SUCCESS != status) {
+    return status;
+  }
+
+  std::vector<std::string> restored_cmds;
+  if (true == bitstream_manager_loaded) {
+    restored_cmds.push_back("build_architecture_bitstream");
+  }
+  if (true == fabric_bitstream_loaded) {
+    restored_cmds.push_back("build_fabric_bitstream");
+  }
+  for (const std::string& restored_cmd : restored_cmds) {
+    /* Some commands may not be available in the shell */
+    ShellCommandId restored_cmd_id = shell->command(restored_cmd);
+    if (true == shell->valid_command_id(restored_cmd_id)) {
+      shell->set_command_executed(restored_cmd_id);
+      VTR_LOGV(verbose, "Marked command '%s' as executed\n",
+               restored_cmd.c_str());
+    }
+  }
+
+  return CMD_EXEC_SUCCESS;
+}
+
+} /* end namespace openfpga */
+
+#endif
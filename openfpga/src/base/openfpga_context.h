@@ -20,9 +20,11 @@
 #include "netlist_manager.h"
 #include "openfpga_arch.h"
 #include "openfpga_flow_manager.h"
+#include "rr_clock_routes.h"
 #include "rr_clock_spatial_lookup.h"
 #include "simulation_setting.h"
 #include "tile_direct.h"
+#include "verilog_module_wire_layout.h"
 #include "vpr_bitstream_annotation.h"
 #include "vpr_clustering_annotation.h"
 #include "vpr_context.h"
@@ -70,6 +72,9 @@ class OpenfpgaContext : public Context {
   const openfpga::RRClockSpatialLookup& clock_rr_lookup() const {
     return clock_rr_lookup_;
   }
+  const openfpga::RRClockRoutes& clock_rr_routes() const {
+    return clock_rr_routes_;
+  }
   const openfpga::VprDeviceAnnotation& vpr_device_annotation() const {
     return vpr_device_annotation_;
   }
@@ -121,6 +126,9 @@ class OpenfpgaContext : public Context {
   const openfpga::NetlistManager& spice_netlists() const {
     return spice_netlists_;
   }
+  const openfpga::VerilogModuleWireLayout& verilog_wire_layout() const {
+    return verilog_wire_layout_;
+  }
 
  public: /* Public mutators */
   openfpga::Arch& mutable_arch() { return arch_; }
@@ -134,6 +142,9 @@ class OpenfpgaContext : public Context {
   openfpga::RRClockSpatialLookup& mutable_clock_rr_lookup() {
     return clock_rr_lookup_;
   }
+  openfpga::RRClockRoutes& mutable_clock_rr_routes() {
+    return clock_rr_routes_;
+  }
   openfpga::VprDeviceAnnotation& mutable_vpr_device_annotation() {
     return vpr_device_annotation_;
   }
@@ -182,6 +193,9 @@ class OpenfpgaContext : public Context {
     return verilog_netlists_;
   }
   openfpga::NetlistManager& mutable_spice_netlists() { return spice_netlists_; }
+  openfpga::VerilogModuleWireLayout& mutable_verilog_wire_layout() {
+    return verilog_wire_layout_;
+  }
 
  private: /* Internal data */
   /* Data structure to store information from read_openfpga_arch library */
@@ -190,6 +204,8 @@ class OpenfpgaContext : public Context {
   openfpga::BitstreamSetting bitstream_setting_;
   openfpga::ClockNetwork clock_arch_;
   openfpga::RRClockSpatialLookup clock_rr_lookup_;
+  /* Routing of clock trees, which is shared by any design */
+  openfpga::RRClockRoutes clock_rr_routes_;
 
   /* Annotation to pb_type of VPR */
   openfpga::VprDeviceAnnotation vpr_device_annotation_;
@@ -244,6 +260,10 @@ class OpenfpgaContext : public Context {
   openfpga::NetlistManager verilog_netlists_;
   openfpga::NetlistManager spice_netlists_;
 
+  /* Local wires of the modules to be written in Verilog, which are built
+   * on request and must be cleared once the module graph is modified */
+  openfpga::VerilogModuleWireLayout verilog_wire_layout_;
+
   /* Flow status */
   openfpga::FlowManager flow_manager_;
 };
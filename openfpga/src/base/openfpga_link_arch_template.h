@@ -20,6 +20,7 @@
 #include "globals.h"
 #include "mux_library_builder.h"
 #include "openfpga_annotate_routing.h"
+#include "openfpga_parallel.h"
 #include "openfpga_rr_graph_support.h"
 #include "pb_type_utils.h"
 #include "read_activity.h"
@@ -49,8 +50,17 @@ int link_arch_template(T& openfpga_ctx, const Command& cmd,
 
   CommandOptionId opt_activity_file = cmd.option("activity_file");
   CommandOptionId opt_sort_edge = cmd.option("sort_gsb_chan_node_in_edges");
+  CommandOptionId opt_threads = cmd.option("threads");
   CommandOptionId opt_verbose = cmd.option("verbose");
 
+  /* Default to be single-thread */
+  size_t num_threads = 1;
+  if ((true == cmd_context.option_enable(cmd, opt_threads)) &&
+      (false == parse_num_threads(cmd_context.option_value(cmd, opt_threads),
+                                  num_threads))) {
+    return CMD_EXEC_FATAL_ERROR;
+  }
+
   /* Build fast look-up between physical tile pin index and port information */
   build_physical_tile_pin2port_info(
     g_vpr_ctx.device(), openfpga_ctx.mutable_vpr_device_annotation());
@@ -89,11 +99,13 @@ int link_arch_template(T& openfpga_ctx, const Command& cmd,
   annotate_vpr_rr_node_nets(g_vpr_ctx.device(), g_vpr_ctx.clustering(),
                             g_vpr_ctx.routing(),
                             openfpga_ctx.mutable_vpr_routing_annotation(),
+                            num_threads,
                             cmd_context.option_enable(cmd, opt_verbose));
 
   annotate_rr_node_previous_nodes(g_vpr_ctx.device(), g_vpr_ctx.clustering(),
                                   g_vpr_ctx.routing(),
                                   openfpga_ctx.mutable_vpr_routing_annotation(),
+                                  num_threads,
                                   cmd_context.option_enable(cmd, opt_verbose));
 
   /* Build the routing graph annotation
@@ -112,20 +124,22 @@ int link_arch_template(T& openfpga_ctx, const Command& cmd,
   annotate_device_rr_gsb(
     g_vpr_ctx.device(), openfpga_ctx.mutable_device_rr_gsb(),
     !openfpga_ctx.clock_arch().empty(), /* FIXME: consider to be more robust! */
-    cmd_context.option_enable(cmd, opt_verbose));
+    num_threads, cmd_context.option_enable(cmd, opt_verbose));
 
   if (true == cmd_context.option_enable(cmd, opt_sort_edge)) {
     sort_device_rr_gsb_chan_node_in_edges(
       g_vpr_ctx.device().rr_graph, openfpga_ctx.mutable_device_rr_gsb(),
-      cmd_context.option_enable(cmd, opt_verbose));
+      num_threads, cmd_context.option_enable(cmd, opt_verbose));
     sort_device_rr_gsb_ipin_node_in_edges(
       g_vpr_ctx.device().rr_graph, openfpga_ctx.mutable_device_rr_gsb(),
-      cmd_context.option_enable(cmd, opt_verbose));
+      num_threads, cmd_context.option_enable(cmd, opt_verbose));
   }
 
   /* Build multiplexer library */
-  openfpga_ctx.mutable_mux_lib() = build_device_mux_library(
-    g_vpr_ctx.device(), const_cast<const T&>(openfpga_ctx));
+  openfpga_ctx.mutable_mux_lib() =
+    build_device_mux_library(g_vpr_ctx.device(),
+                             const_cast<const T&>(openfpga_ctx),
+                             num_threads);
 
   /* Build tile direct annotation */
   openfpga_ctx.mutable_tile_direct() = build_device_tile_direct(
@@ -199,11 +213,24 @@ int append_clock_rr_graph_template(T& openfpga_ctx, const Command& cmd,
   vtr::ScopedStartFinishTimer timer(
     "Append clock network to routing resource graph");
 
+  CommandOptionId opt_threads = cmd.option("threads");
   CommandOptionId opt_verbose = cmd.option("verbose");
 
+  /* Default to be single-thread */
+  size_t num_threads = 1;
+  if ((true == cmd_context.option_enable(cmd, opt_threads)) &&
+      (false == parse_num_threads(cmd_context.option_value(cmd, opt_threads),
+                                  num_threads))) {
+    return CMD_EXEC_FATAL_ERROR;
+  }
+
+  /* Any cached clock routing is outdated once the clock nodes are rebuilt */
+  openfpga_ctx.mutable_clock_rr_routes().clear();
+
   return append_clock_rr_graph(
     g_vpr_ctx.mutable_device(), openfpga_ctx.mutable_clock_rr_lookup(),
-    openfpga_ctx.clock_arch(), cmd_context.option_enable(cmd, opt_verbose));
+    openfpga_ctx.clock_arch(), num_threads,
+    cmd_context.option_enable(cmd, opt_verbose));
 }
 
 /********************************************************************
@@ -230,7 +257,8 @@ int route_clock_rr_graph_template(T& openfpga_ctx, const Command& cmd,
     openfpga_ctx.mutable_vpr_routing_annotation(), g_vpr_ctx.device(),
     g_vpr_ctx.atom(), g_vpr_ctx.clustering().clb_nlist,
     openfpga_ctx.vpr_netlist_annotation(), openfpga_ctx.clock_rr_lookup(),
-    openfpga_ctx.clock_arch(), pin_constraints,
+    openfpga_ctx.mutable_clock_rr_routes(), openfpga_ctx.clock_arch(),
+    pin_constraints,
     cmd_context.option_enable(cmd, opt_verbose));
 }
 
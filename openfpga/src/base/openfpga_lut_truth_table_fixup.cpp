@@ -10,6 +10,7 @@
 /* Headers from vpr library */
 #include "lut_utils.h"
 #include "openfpga_lut_truth_table_fixup.h"
+#include "openfpga_parallel.h"
 #include "pb_type_utils.h"
 #include "vpr_utils.h"
 
@@ -19,16 +20,24 @@
 /* begin namespace openfpga */
 namespace openfpga {
 
+/* Truth tables adapted for the LUT pbs of a clustered block */
+typedef std::vector<std::pair<t_pb*, AtomNetlist::TruthTable>>
+  AdaptedLutTruthTables;
+
 /********************************************************************
  * Apply the fix-up to truth table of LUT according to its pin
  * rotation status by packer
  *
+ * The adapted truth table is recorded in a list, rather than in the
+ * clustering annotation, so that clustered blocks can be visited with multiple
+ * threads
+ *
  * Note:
  *   - pb must represents a LUT pb in the graph and it should be primitive
  *******************************************************************/
 static void fix_up_lut_atom_block_truth_table(
   const AtomContext& atom_ctx, t_pb* pb, const t_pb_routes& pb_route,
-  VprClusteringAnnotation& vpr_clustering_annotation, const bool& verbose) {
+  AdaptedLutTruthTables& adapted_tts, const bool& verbose) {
   t_pb_graph_node* pb_graph_node = pb->pb_graph_node;
   t_pb_type* pb_type = pb->pb_graph_node->pb_type;
 
@@ -90,7 +99,7 @@ static void fix_up_lut_atom_block_truth_table(
       atom_ctx.nlist.block_truth_table(atom_blk);
     const AtomNetlist::TruthTable& adapt_tt =
       lut_truth_table_adaption(orig_tt, rotated_pin_map);
-    vpr_clustering_annotation.adapt_truth_table(pb, adapt_tt);
+    adapted_tts.emplace_back(pb, adapt_tt);
 
     /* Print info is in the verbose mode */
     VTR_LOGV(verbose, "Original truth table\n");
@@ -132,9 +141,10 @@ static void fix_up_lut_atom_block_truth_table(
  * of LUT_CLASS
  * Once we find a LUT node, we will apply the fix-up
  *******************************************************************/
-static void rec_adapt_lut_pb_tt(
-  const AtomContext& atom_ctx, t_pb* pb, const t_pb_routes& pb_route,
-  VprClusteringAnnotation& vpr_clustering_annotation, const bool& verbose) {
+static void rec_adapt_lut_pb_tt(const AtomContext& atom_ctx, t_pb* pb,
+                                const t_pb_routes& pb_route,
+                                AdaptedLutTruthTables& adapted_tts,
+                                const bool& verbose) {
   t_pb_graph_node* pb_graph_node = pb->pb_graph_node;
 
   /* If we reach a primitive pb_graph node, we return */
@@ -148,7 +158,7 @@ static void rec_adapt_lut_pb_tt(
        */
       if (1 == pb->mode) {
         fix_up_lut_atom_block_truth_table(atom_ctx, pb->child_pbs[0], pb_route,
-                                          vpr_clustering_annotation, verbose);
+                                          adapted_tts, verbose);
       }
     }
     return;
@@ -163,7 +173,7 @@ static void rec_adapt_lut_pb_tt(
       if ((pb->child_pbs[ipb] != nullptr) &&
           (pb->child_pbs[ipb][jpb].name != nullptr)) {
         rec_adapt_lut_pb_tt(atom_ctx, &(pb->child_pbs[ipb][jpb]), pb_route,
-                            vpr_clustering_annotation, verbose);
+                            adapted_tts, verbose);
       }
     }
   }
@@ -171,15 +181,32 @@ static void rec_adapt_lut_pb_tt(
 
 /********************************************************************
  * Main function to fix up truth table for each LUT used in FPGA
- * This function will walk through each clustered block
+ * This function will walk through each clustered block with multiple threads.
+ * The adapted truth tables are then added to the clustering annotation in the
+ * sequence of clustered blocks
  *******************************************************************/
 void update_lut_tt_with_post_packing_results(
   const AtomContext& atom_ctx, const ClusteringContext& clustering_ctx,
-  VprClusteringAnnotation& vpr_clustering_annotation, const bool& verbose) {
-  for (auto blk_id : clustering_ctx.clb_nlist.blocks()) {
-    rec_adapt_lut_pb_tt(atom_ctx, clustering_ctx.clb_nlist.block_pb(blk_id),
-                        clustering_ctx.clb_nlist.block_pb(blk_id)->pb_route,
-                        vpr_clustering_annotation, verbose);
+  VprClusteringAnnotation& vpr_clustering_annotation,
+  const size_t& num_threads, const bool& verbose) {
+  std::vector<ClusterBlockId> blocks(clustering_ctx.clb_nlist.blocks().begin(),
+                                     clustering_ctx.clb_nlist.blocks().end());
+  std::vector<AdaptedLutTruthTables> block_adapted_tts(blocks.size());
+
+  /* Verbose outputs are printed only when running in a single thread,
+   * otherwise the outputs of threads interleave */
+  bool verbose_block = verbose && (1 == find_num_threads(num_threads));
+  parallel_for(blocks.size(), num_threads, [&](const size_t& iblk) {
+    t_pb* block_pb = clustering_ctx.clb_nlist.block_pb(blocks[iblk]);
+    rec_adapt_lut_pb_tt(atom_ctx, block_pb, block_pb->pb_route,
+                        block_adapted_tts[iblk], verbose_block);
+  });
+
+  for (const AdaptedLutTruthTables& adapted_tts : block_adapted_tts) {
+    for (const auto& adapted_tt : adapted_tts) {
+      vpr_clustering_annotation.adapt_truth_table(adapted_tt.first,
+                                                  adapted_tt.second);
+    }
   }
 }
 
@@ -17,7 +17,8 @@ namespace openfpga {
 
 void update_lut_tt_with_post_packing_results(
   const AtomContext& atom_ctx, const ClusteringContext& clustering_ctx,
-  VprClusteringAnnotation& vpr_clustering_annotation, const bool& verbose);
+  VprClusteringAnnotation& vpr_clustering_annotation,
+  const size_t& num_threads, const bool& verbose);
 
 } /* end namespace openfpga */
 
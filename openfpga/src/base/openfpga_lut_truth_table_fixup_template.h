@@ -9,6 +9,8 @@
 #include "command_exit_codes.h"
 #include "openfpga_context.h"
 #include "openfpga_lut_truth_table_fixup.h"
+#include "openfpga_parallel.h"
+#include "vtr_log.h"
 #include "vtr_time.h"
 
 /********************************************************************
@@ -35,12 +37,21 @@ int lut_truth_table_fixup_template(T& openfpga_context, const Command& cmd,
   vtr::ScopedStartFinishTimer timer(
     "Fix up LUT truth tables after packing optimization");
 
+  CommandOptionId opt_threads = cmd.option("threads");
   CommandOptionId opt_verbose = cmd.option("verbose");
 
+  /* Default to be single-thread */
+  size_t num_threads = 1;
+  if ((true == cmd_context.option_enable(cmd, opt_threads)) &&
+      (false == parse_num_threads(cmd_context.option_value(cmd, opt_threads),
+                                  num_threads))) {
+    return CMD_EXEC_FATAL_ERROR;
+  }
+
   /* Apply fix-up to each packed block */
   update_lut_tt_with_post_packing_results(
     g_vpr_ctx.atom(), g_vpr_ctx.clustering(),
-    openfpga_context.mutable_vpr_clustering_annotation(),
+    openfpga_context.mutable_vpr_clustering_annotation(), num_threads,
     cmd_context.option_enable(cmd, opt_verbose));
 
   /* TODO: should identify the error code from internal function execution */
@@ -0,0 +1,200 @@
+#ifndef OPENFPGA_MEMORY_USAGE_TEMPLATE_H
+#define OPENFPGA_MEMORY_USAGE_TEMPLATE_H
+/********************************************************************
+ * This file includes functions to report the memory taken by the data
+ * structures of the OpenFPGA context and to release them
+ *******************************************************************/
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "bitstream_manager.h"
+#include "command.h"
+#include "command_context.h"
+#include "command_exit_codes.h"
+#include "command_profiler.h"
+#include "fabric_bitstream.h"
+#include "fabric_tile.h"
+#include "mux_library.h"
+#include "openfpga_memory_usage.h"
+#include "shell.h"
+#include "vpr_clustering_annotation.h"
+#include "vpr_routing_annotation.h"
+#include "vtr_assert.h"
+#include "vtr_log.h"
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+/********************************************************************
+ * The data structures which can be released by the command
+ * 'free_data_structure', and the commands which require them.
+ * These commands are disabled once the data structure is released.
+ *******************************************************************/
+inline const std::map<std::string, std::vector<std::string>>&
+freeable_data_structure_consumers() {
+  static const std::map<std::string, std::vector<std::string>> consumers = {
+    {"device_rr_gsb",
+     {"build_fabric", "write_gsb_to_xml", "write_fabric_verilog",
+      "write_fabric_spice", "write_pnr_sdc", "write_analysis_sdc",
+      "build_architecture_bitstream"}},
+    {"fabric_tile",
+     {"write_fabric_verilog", "write_pnr_sdc", "build_architecture_bitstream",
+      "build_fabric_bitstream"}},
+    {"mux_lib",
+     {"build_fabric", "write_fabric_verilog", "write_fabric_spice",
+      "write_spice_characterization_testbench", "write_pnr_sdc",
+      "write_sdc_disable_timing_configure_ports",
+      "build_architecture_bitstream"}},
+    {"bitstream_manager",
+     {"build_fabric_bitstream", "verify_fabric_bitstream",
+      "simulate_fabric_configuration", "write_fabric_bitstream",
+      "report_bitstream_distribution", "write_full_testbench",
+      "write_preconfigured_fabric_wrapper", "write_simulation_task_info"}},
+    {"fabric_bitstream",
+     {"verify_fabric_bitstream", "simulate_fabric_configuration",
+      "write_fabric_bitstream", "report_bitstream_distribution",
+      "write_full_testbench"}},
+    {"vpr_routing_annotation",
+     {"pb_pin_fixup", "route_clock_rr_graph", "build_architecture_bitstream",
+      "write_analysis_sdc"}},
+    {"physical_pb", {"build_architecture_bitstream", "write_analysis_sdc"}}};
+  return consumers;
+}
+
+/********************************************************************
+ * Collect the memory usage of the major data structures of the context
+ *******************************************************************/
+template <class T>
+std::vector<std::pair<std::string, MemoryUsage>> collect_memory_usage(
+  const T& openfpga_ctx) {
+  std::vector<std::pair<std::string, MemoryUsage>> usages;
+  usages.emplace_back("module_graph",
+                      openfpga_ctx.module_graph().memory_usage());
+  usages.emplace_back("device_rr_gsb",
+                      openfpga_ctx.device_rr_gsb().memory_usage());
+  usages.emplace_back("fabric_tile", openfpga_ctx.fabric_tile().memory_usage());
+  usages.emplace_back("mux_lib", openfpga_ctx.mux_lib().memory_usage());
+  usages.emplace_back("bitstream_manager",
+                      openfpga_ctx.bitstream_manager().memory_usage());
+  usages.emplace_back("fabric_bitstream",
+                      openfpga_ctx.fabric_bitstream().memory_usage());
+  usages.emplace_back("vpr_routing_annotation",
+                      openfpga_ctx.vpr_routing_annotation().memory_usage());
+  usages.emplace_back(
+    "physical_pb",
+    openfpga_ctx.vpr_clustering_annotation().physical_pb_memory_usage());
+  return usages;
+}
+
+/********************************************************************
+ * Print the approximate heap memory of each major data structure, as well
+ * as the capacity which is reserved but not used
+ *******************************************************************/
+template <class T>
+int report_memory_usage_template(const T& openfpga_ctx, const Command& cmd,
+                                 const CommandContext& cmd_context) {
+  CommandOptionId opt_verbose = cmd.option("verbose");
+  bool verbose = cmd_context.option_enable(cmd, opt_verbose);
+
+  std::vector<std::pair<std::string, MemoryUsage>> usages =
+    collect_memory_usage<T>(openfpga_ctx);
+
+  const double mega_bytes = 1024. * 1024.;
+  VTR_LOG("Memory usage of data structures:\n");
+  VTR_LOG("%-24s %14s %14s %14s\n", "Data structure", "Used (MB)",
+          "Allocated (MB)", "Unused (MB)");
+  MemoryUsage total_usage;
+  for (const auto& usage : usages) {
+    total_usage += usage.second;
+    /* Skip the data structures which are not built yet */
+    if ((false == verbose) && (0 == usage.second.allocated_bytes)) {
+      continue;
+    }
+    VTR_LOG("%-24s %14.2f %14.2f %14.2f\n", usage.first.c_str(),
+            double(usage.second.used_bytes) / mega_bytes,
+            double(usage.second.allocated_bytes) / mega_bytes,
+            double(usage.second.allocated_bytes - usage.second.used_bytes) /
+              mega_bytes);
+  }
+  VTR_LOG("%-24s %14.2f %14.2f %14.2f\n", "Total",
+          double(total_usage.used_bytes) / mega_bytes,
+          double(total_usage.allocated_bytes) / mega_bytes,
+          double(total_usage.allocated_bytes - total_usage.used_bytes) /
+            mega_bytes);
+  /* The rest of the process memory is owned by VPR, the architecture, etc. */
+  VTR_LOG("Resident set size of the process: %.2f MB (peak %.2f MB)\n",
+          double(get_current_rss_kb()) / 1024.,
+          double(get_peak_rss_kb()) / 1024.);
+
+  return CMD_EXEC_SUCCESS;
+}
+
+/********************************************************************
+ * Release the memory of a data structure which is no longer needed by
+ * the rest of a script.
+ * The commands which require the data structure are disabled, so that
+ * they fail cleanly instead of accessing the released data
+ *******************************************************************/
+template <class T>
+int free_data_structure_template(openfpga::Shell<T>* shell, T& openfpga_ctx,
+                                 const Command& cmd,
+                                 const CommandContext& cmd_context) {
+  CommandOptionId opt_name = cmd.option("name");
+  CommandOptionId opt_verbose = cmd.option("verbose");
+  std::string name = cmd_context.option_value(cmd, opt_name);
+  bool verbose = cmd_context.option_enable(cmd, opt_verbose);
+
+  auto consumers = freeable_data_structure_consumers().find(name);
+  if (consumers == freeable_data_structure_consumers().end()) {
+    std::string candidates;
+    for (const auto& candidate : freeable_data_structure_consumers()) {
+      candidates += (candidates.empty() ? "" : "|") + candidate.first;
+    }
+    VTR_LOG_ERROR("Invalid data structure '%s'! Expect [%s]\n", name.c_str(),
+                  candidates.c_str());
+    return CMD_EXEC_FATAL_ERROR;
+  }
+
+  size_t rss_before = get_current_rss_kb();
+
+  if (std::string("device_rr_gsb") == name) {
+    openfpga_ctx.mutable_device_rr_gsb().release_memory();
+  } else if (std::string("fabric_tile") == name) {
+    openfpga_ctx.mutable_fabric_tile() = FabricTile();
+  } else if (std::string("mux_lib") == name) {
+    openfpga_ctx.mutable_mux_lib() = MuxLibrary();
+  } else if (std::string("bitstream_manager") == name) {
+    openfpga_ctx.mutable_bitstream_manager() = BitstreamManager();
+  } else if (std::string("fabric_bitstream") == name) {
+    openfpga_ctx.mutable_fabric_bitstream() = FabricBitstream();
+  } else if (std::string("vpr_routing_annotation") == name) {
+    openfpga_ctx.mutable_vpr_routing_annotation() = VprRoutingAnnotation();
+  } else {
+    VTR_ASSERT(std::string("physical_pb") == name);
+    openfpga_ctx.mutable_vpr_clustering_annotation().clear_physical_pbs();
+  }
+
+  std::string reason =
+    std::string("data structure '") + name + std::string("' has been released");
+  for (const std::string& consumer : consumers->second) {
+    /* Some commands may not be available in the shell */
+    ShellCommandId consumer_cmd_id = shell->command(consumer);
+    if (true == shell->valid_command_id(consumer_cmd_id)) {
+      shell->disable_command(consumer_cmd_id, reason);
+      VTR_LOGV(verbose, "Disabled command '%s'\n", consumer.c_str());
+    }
+  }
+
+  /* The memory may not be given back to the system immediately */
+  VTR_LOGV(verbose, "Released data structure '%s' (RSS %.2f MB -> %.2f MB)\n",
+           name.c_str(), double(rss_before) / 1024.,
+           double(get_current_rss_kb()) / 1024.);
+
+  return CMD_EXEC_SUCCESS;
+}
+
+} /* end namespace openfpga */
+
+#endif
@@ -7,6 +7,9 @@
  ********************************************************************/
 #include "openfpga_naming.h"
 
+#include <cstdint>
+#include <unordered_map>
+
 #include "circuit_library_utils.h"
 #include "openfpga_reserved_words.h"
 #include "openfpga_side_manager.h"
@@ -17,6 +20,31 @@
 /* begin namespace openfpga */
 namespace openfpga {
 
+/************************************************
+ * A cache of the names generated from small integers, e.g., coordinates
+ * and indices, which are requested many times by the fabric builders
+ * and the netlist writers. Caches are owned by each thread, as the
+ * naming functions are called by multi-threaded builders
+ ***********************************************/
+typedef std::unordered_map<uint64_t, std::string> NameCache;
+
+/* Pack two integers, e.g., a coordinate, into the key of a cache */
+static uint64_t name_cache_key(const size_t& high, const size_t& low) {
+  VTR_ASSERT((high <= UINT32_MAX) && (low <= UINT32_MAX));
+  return (uint64_t(high) << 32) | uint64_t(low);
+}
+
+/* Return the cached name of a key, or generate it if not cached */
+template <class NameGenerator>
+static std::string find_or_generate_name(NameCache& cache, const uint64_t& key,
+                                         const NameGenerator& generator) {
+  auto result = cache.find(key);
+  if (result != cache.end()) {
+    return result->second;
+  }
+  return cache.emplace(key, generator()).first->second;
+}
+
 /************************************************
  * A generic function to generate the instance name
  * in the following format:
@@ -53,16 +81,20 @@ std::string generate_instance_wildcard_name(const std::string& instance_name,
  ***********************************************/
 std::string generate_mux_node_name(const size_t& node_level,
                                    const bool& add_buffer_postfix) {
-  /* Generate the basic node_name */
-  std::string node_name = "mux_l" + std::to_string(node_level) + "_in";
-
-  /* Add a postfix upon requests */
-  if (true == add_buffer_postfix) {
-    /* '1' indicates that the location is needed */
-    node_name += "_buf";
-  }
+  static thread_local NameCache cache;
+  return find_or_generate_name(
+    cache, name_cache_key(node_level, size_t(add_buffer_postfix)), [&]() {
+      /* Generate the basic node_name */
+      std::string node_name = "mux_l" + std::to_string(node_level) + "_in";
+
+      /* Add a postfix upon requests */
+      if (true == add_buffer_postfix) {
+        /* '1' indicates that the location is needed */
+        node_name += "_buf";
+      }
 
-  return node_name;
+      return node_name;
+    });
 }
 
 /************************************************
@@ -75,8 +107,15 @@ std::string generate_mux_node_name(const size_t& node_level,
 std::string generate_mux_branch_instance_name(const size_t& node_level,
                                               const size_t& node_index_at_level,
                                               const bool& add_buffer_postfix) {
-  return std::string(generate_mux_node_name(node_level, add_buffer_postfix) +
-                     "_" + std::to_string(node_index_at_level) + "_");
+  /* Each buffer option has its own cache */
+  static thread_local NameCache caches[2];
+  return find_or_generate_name(
+    caches[add_buffer_postfix], name_cache_key(node_level, node_index_at_level),
+    [&]() {
+      return std::string(
+        generate_mux_node_name(node_level, add_buffer_postfix) + "_" +
+        std::to_string(node_index_at_level) + "_");
+    });
 }
 
 /************************************************
@@ -498,31 +537,45 @@ std::string generate_routing_track_middle_output_port_name(
  *********************************************************************/
 std::string generate_switch_block_module_name(
   const vtr::Point<size_t>& coordinate) {
-  return std::string("sb_" + std::to_string(coordinate.x()) +
-                     std::string("__") + std::to_string(coordinate.y()) +
-                     std::string("_"));
+  static thread_local NameCache cache;
+  return find_or_generate_name(
+    cache, name_cache_key(coordinate.x(), coordinate.y()), [&]() {
+      return std::string("sb_" + std::to_string(coordinate.x()) +
+                         std::string("__") + std::to_string(coordinate.y()) +
+                         std::string("_"));
+    });
 }
 
 /*********************************************************************
  * Generate the module name for a switch block with a given index
  *********************************************************************/
 std::string generate_switch_block_module_name_using_index(const size_t& index) {
-  return std::string("sb_" + std::to_string(index) + std::string("_"));
+  static thread_local NameCache cache;
+  return find_or_generate_name(cache, index, [&]() {
+    return std::string("sb_" + std::to_string(index) + std::string("_"));
+  });
 }
 
 /*********************************************************************
  * Generate the module name for a tile module with a given coordinate
  *********************************************************************/
 std::string generate_tile_module_name(const vtr::Point<size_t>& tile_coord) {
-  return std::string("tile_" + std::to_string(tile_coord.x()) + "__" +
-                     std::to_string(tile_coord.y()) + "_");
+  static thread_local NameCache cache;
+  return find_or_generate_name(
+    cache, name_cache_key(tile_coord.x(), tile_coord.y()), [&]() {
+      return std::string("tile_" + std::to_string(tile_coord.x()) + "__" +
+                         std::to_string(tile_coord.y()) + "_");
+    });
 }
 
 /*********************************************************************
  * Generate the module name for a tile module with a given index
  *********************************************************************/
 std::string generate_tile_module_name_using_index(const size_t& index) {
-  return std::string("tile_" + std::to_string(index) + "_");
+  static thread_local NameCache cache;
+  return find_or_generate_name(cache, index, [&]() {
+    return std::string("tile_" + std::to_string(index) + "_");
+  });
 }
 
 /*********************************************************************
@@ -569,9 +622,14 @@ std::string generate_connection_block_module_name(
       exit(1);
   }
 
-  return std::string(prefix + std::to_string(coordinate.x()) +
-                     std::string("__") + std::to_string(coordinate.y()) +
-                     std::string("_"));
+  /* Each type of connection block has its own cache */
+  static thread_local NameCache caches[NUM_RR_TYPES];
+  return find_or_generate_name(
+    caches[cb_type], name_cache_key(coordinate.x(), coordinate.y()), [&]() {
+      return std::string(prefix + std::to_string(coordinate.x()) +
+                         std::string("__") + std::to_string(coordinate.y()) +
+                         std::string("_"));
+    });
 }
 
 /*********************************************************************
@@ -592,7 +650,10 @@ std::string generate_connection_block_module_name_using_index(
       exit(1);
   }
 
-  return std::string(prefix + std::to_string(index) + std::string("_"));
+  static thread_local NameCache caches[NUM_RR_TYPES];
+  return find_or_generate_name(caches[cb_type], index, [&]() {
+    return std::string(prefix + std::to_string(index) + std::string("_"));
+  });
 }
 
 /*********************************************************************
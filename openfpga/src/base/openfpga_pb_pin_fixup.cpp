@@ -15,6 +15,7 @@
 
 /* Headers from openfpgautil library */
 #include "openfpga_device_grid_utils.h"
+#include "openfpga_parallel.h"
 #include "openfpga_pb_pin_fixup.h"
 #include "openfpga_physical_tile_utils.h"
 #include "openfpga_side_manager.h"
@@ -23,6 +24,12 @@
 /* begin namespace openfpga */
 namespace openfpga {
 
+/* A location where the pins of a clustered block should be fixed up */
+struct ClusterPinFixupSite {
+  vtr::Point<size_t> grid_coord;
+  e_side border_side;
+};
+
 /********************************************************************
  * Fix up the pb pin mapping results for a given clustered block
  * 1. For each input/output pin of a clustered pb,
@@ -180,18 +187,43 @@ static void update_cluster_pin_with_post_routing_results(
   }
 }
 
+/********************************************************************
+ * Register a location where a clustered block should be fixed up
+ * Blocks are listed in the sequence of their first locations
+ *******************************************************************/
+static void add_cluster_pin_fixup_site(
+  std::vector<ClusterBlockId>& fixup_blocks,
+  vtr::vector<ClusterBlockId, std::vector<ClusterPinFixupSite>>& block_sites,
+  const ClusterBlockId& blk_id, const vtr::Point<size_t>& grid_coord,
+  const e_side& border_side) {
+  if (true == block_sites[blk_id].empty()) {
+    fixup_blocks.push_back(blk_id);
+  }
+  block_sites[blk_id].push_back({grid_coord, border_side});
+}
+
 /********************************************************************
  * Main function to fix up the pb pin mapping results
- * This function will walk through each grid
+ * This function will walk through each grid to find the locations of clustered
+ * blocks, and then fix up the blocks with multiple threads.
+ * The fix-up of a block only updates its own net remapping, while all the
+ * locations of a block are fixed up in the same thread and sequence
  *******************************************************************/
 void update_pb_pin_with_post_routing_results(
   const DeviceContext& device_ctx, const ClusteringContext& clustering_ctx,
   const PlacementContext& placement_ctx,
   const VprRoutingAnnotation& vpr_routing_annotation,
-  VprClusteringAnnotation& vpr_clustering_annotation, const bool& verbose) {
+  VprClusteringAnnotation& vpr_clustering_annotation,
+  const size_t& num_threads, const bool& verbose) {
   /* Ensure a clean start: remove all the remapping results from VTR's
-   * post-routing clustering result sync-up */
-  vpr_clustering_annotation.clear_net_remapping();
+   * post-routing clustering result sync-up. Allocate the remapping for all the
+   * blocks so that they can be renamed by multiple threads */
+  vpr_clustering_annotation.init_net_remapping(
+    clustering_ctx.clb_nlist.blocks().size());
+
+  std::vector<ClusterBlockId> fixup_blocks;
+  vtr::vector<ClusterBlockId, std::vector<ClusterPinFixupSite>> block_sites(
+    clustering_ctx.clb_nlist.blocks().size());
 
   size_t layer = 0;
   /* Update the core logic (center blocks of the FPGA) */
@@ -215,11 +247,8 @@ void update_pb_pin_with_post_routing_results(
         /* We know the entrance to grid info and mapping results, do the fix-up
          * for this block */
         vtr::Point<size_t> grid_coord(x, y);
-        update_cluster_pin_with_post_routing_results(
-          device_ctx, clustering_ctx, vpr_routing_annotation,
-          vpr_clustering_annotation, layer, grid_coord, cluster_blk_id,
-          NUM_SIDES, placement_ctx.block_locs[cluster_blk_id].loc.sub_tile,
-          verbose);
+        add_cluster_pin_fixup_site(fixup_blocks, block_sites, cluster_blk_id,
+                                   grid_coord, NUM_SIDES);
       }
     }
   }
@@ -247,13 +276,25 @@ void update_pb_pin_with_post_routing_results(
           continue;
         }
         /* Update on I/O grid */
-        update_cluster_pin_with_post_routing_results(
-          device_ctx, clustering_ctx, vpr_routing_annotation,
-          vpr_clustering_annotation, layer, io_coord, cluster_blk_id, io_side,
-          placement_ctx.block_locs[cluster_blk_id].loc.sub_tile, verbose);
+        add_cluster_pin_fixup_site(fixup_blocks, block_sites, cluster_blk_id,
+                                   io_coord, io_side);
       }
     }
   }
+
+  /* Verbose outputs are printed only when running in a single thread,
+   * otherwise the outputs of threads interleave */
+  bool verbose_block = verbose && (1 == find_num_threads(num_threads));
+  parallel_for(fixup_blocks.size(), num_threads, [&](const size_t& iblk) {
+    const ClusterBlockId& cluster_blk_id = fixup_blocks[iblk];
+    for (const ClusterPinFixupSite& site : block_sites[cluster_blk_id]) {
+      update_cluster_pin_with_post_routing_results(
+        device_ctx, clustering_ctx, vpr_routing_annotation,
+        vpr_clustering_annotation, layer, site.grid_coord, cluster_blk_id,
+        site.border_side,
+        placement_ctx.block_locs[cluster_blk_id].loc.sub_tile, verbose_block);
+    }
+  });
 }
 
 } /* end namespace openfpga */
@@ -8,7 +8,9 @@
 #include "command_context.h"
 #include "command_exit_codes.h"
 #include "globals.h"
+#include "openfpga_parallel.h"
 #include "openfpga_pb_pin_fixup.h"
+#include "vtr_log.h"
 #include "vtr_time.h"
 
 /********************************************************************
@@ -35,13 +37,22 @@ int pb_pin_fixup_template(T& openfpga_context, const Command& cmd,
   vtr::ScopedStartFinishTimer timer(
     "Fix up pb pin mapping results after routing optimization");
 
+  CommandOptionId opt_threads = cmd.option("threads");
   CommandOptionId opt_verbose = cmd.option("verbose");
 
+  /* Default to be single-thread */
+  size_t num_threads = 1;
+  if ((true == cmd_context.option_enable(cmd, opt_threads)) &&
+      (false == parse_num_threads(cmd_context.option_value(cmd, opt_threads),
+                                  num_threads))) {
+    return CMD_EXEC_FATAL_ERROR;
+  }
+
   /* Apply fix-up to each grid */
   update_pb_pin_with_post_routing_results(
     g_vpr_ctx.device(), g_vpr_ctx.clustering(), g_vpr_ctx.placement(),
     openfpga_context.vpr_routing_annotation(),
-    openfpga_context.mutable_vpr_clustering_annotation(),
+    openfpga_context.mutable_vpr_clustering_annotation(), num_threads,
     cmd_context.option_enable(cmd, opt_verbose));
 
   /* TODO: should identify the error code from internal function execution */
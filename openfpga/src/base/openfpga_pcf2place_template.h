@@ -3,7 +3,6 @@
 /********************************************************************
  * This file includes functions to build bitstream database
  *******************************************************************/
-#include "blif_head_reader.h"
 #include "command.h"
 #include "command_context.h"
 #include "command_exit_codes.h"
@@ -11,6 +10,7 @@
 #include "openfpga_digest.h"
 #include "pcf2place.h"
 #include "pcf_reader.h"
+#include "read_blif_head.h"
 #include "read_csv_io_pin_table.h"
 #include "read_xml_io_location_map.h"
 #include "vtr_log.h"
@@ -75,13 +75,15 @@ int pcf2place_wrapper_template(const Command& cmd,
   VTR_LOG("Read the design constraints from a pcf file: %s.\n",
           pcf_fname.c_str());
 
-  blifparse::BlifHeadReader callback;
-  blifparse::blif_parse_filename(blif_fname.c_str(), callback);
-  VTR_LOG("Read the blif from a file: %s.\n", blif_fname.c_str());
-  if (callback.had_error()) {
+  /* Only the I/Os of the design are required, skip the netlist */
+  std::vector<std::string> blif_input_pins;
+  std::vector<std::string> blif_output_pins;
+  if (0 != openfpga::read_blif_head(blif_fname.c_str(), blif_input_pins,
+                                    blif_output_pins)) {
     VTR_LOG_ERROR("Read the blif ends with errors\n");
     return CMD_EXEC_FATAL_ERROR;
   }
+  VTR_LOG("Read the blif from a file: %s.\n", blif_fname.c_str());
 
   IoLocationMap io_location_map =
     read_xml_io_location_map(fpga_io_map_fname.c_str());
@@ -96,8 +98,8 @@ int pcf2place_wrapper_template(const Command& cmd,
   /* Convert */
   IoNetPlace io_net_place;
   int status =
-    pcf2place(pcf_data, callback.input_pins(), callback.output_pins(),
-              io_pin_table, io_location_map, io_net_place);
+    pcf2place(pcf_data, blif_input_pins, blif_output_pins, io_pin_table,
+              io_location_map, io_net_place);
   if (status) {
     return status;
   }
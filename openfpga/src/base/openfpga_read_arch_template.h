@@ -6,6 +6,7 @@
  *******************************************************************/
 #include "check_circuit_library.h"
 #include "check_config_protocol.h"
+#include "check_result_cache.h"
 #include "check_tile_annotation.h"
 #include "circuit_library_utils.h"
 #include "clock_network_utils.h"
@@ -13,6 +14,10 @@
 #include "command_context.h"
 #include "command_exit_codes.h"
 #include "globals.h"
+#include "openfpga_arch_bundle.h"
+#include "openfpga_hash.h"
+#include "openfpga_physical_tile_utils.h"
+#include "openfpga_version.h"
 #include "read_xml_clock_network.h"
 #include "read_xml_openfpga_arch.h"
 #include "vtr_log.h"
@@ -22,12 +27,51 @@
 /* begin namespace openfpga */
 namespace openfpga {
 
+/********************************************************************
+ * Compute the key of the checks on an OpenFPGA architecture, which covers
+ * the content of the architecture file and the properties of the physical
+ * tiles that the tile annotation is checked against
+ *******************************************************************/
+inline size_t find_openfpga_arch_check_key(
+  const std::string& arch_file_name,
+  const std::vector<t_physical_tile_type>& physical_tile_types) {
+  size_t key = 0;
+  hash_combine<std::string>(key, std::string(VERSION));
+  hash_combine<size_t>(key, find_file_content_hash(arch_file_name));
+
+  for (const t_physical_tile_type& physical_tile : physical_tile_types) {
+    hash_combine<std::string>(key, std::string(physical_tile.name));
+    for (const t_sub_tile& sub_tile : physical_tile.sub_tiles) {
+      hash_combine<int>(key, sub_tile.capacity.total());
+      for (const t_physical_tile_port& tile_port : sub_tile.ports) {
+        hash_combine<std::string>(key, std::string(tile_port.name));
+        hash_combine<int>(key, tile_port.num_pins);
+        hash_combine<int>(key, tile_port.absolute_first_pin_index);
+        hash_combine<bool>(key, tile_port.is_clock);
+        hash_combine<bool>(key, tile_port.is_non_clock_global);
+      }
+      for (const int& pin : sub_tile.sub_tile_to_tile_pin_indices) {
+        hash_combine<int>(key, pin);
+      }
+    }
+    for (int pin = 0; pin < physical_tile.num_pins; ++pin) {
+      hash_combine<float>(key, find_physical_tile_pin_Fc(&physical_tile, pin));
+    }
+  }
+
+  return key;
+}
+
 /********************************************************************
  * Top-level function to read an OpenFPGA architecture file
  * we use the APIs from the libarchopenfpga library
  *
  * The command will accept an option '--file' which is the architecture
  * file provided by users
+ *
+ * When a check cache is given, the checks are skipped if they have passed
+ * on the same architecture file and physical tiles, unless the option
+ * '--force_check' is enabled
  *******************************************************************/
 template <class T>
 int read_openfpga_arch_template(T& openfpga_context, const Command& cmd,
@@ -42,9 +86,38 @@ int read_openfpga_arch_template(T& openfpga_context, const Command& cmd,
 
   std::string arch_file_name = cmd_context.option_value(cmd, opt_file);
 
-  VTR_LOG("Reading XML architecture '%s'...\n", arch_file_name.c_str());
-  openfpga_context.mutable_arch() =
-    read_xml_openfpga_arch(arch_file_name.c_str());
+  /* A bundle is already linked and only has to be loaded */
+  CommandOptionId opt_bundle = cmd.option("bundle");
+  if (true == cmd_context.option_enable(cmd, opt_bundle)) {
+    VTR_LOG("Reading architecture bundle '%s'...\n", arch_file_name.c_str());
+    int status = read_openfpga_arch_bundle(arch_file_name,
+                                           openfpga_context.mutable_arch());
+    if (CMD_EXEC_SUCCESS != status) {
+      return status;
+    }
+  } else {
+    VTR_LOG("Reading XML architecture '%s'...\n", arch_file_name.c_str());
+    openfpga_context.mutable_arch() =
+      read_xml_openfpga_arch(arch_file_name.c_str());
+  }
+
+  CommandOptionId opt_check_cache = cmd.option("check_cache");
+  CommandOptionId opt_force_check = cmd.option("force_check");
+  std::string check_cache_fname;
+  size_t check_key = 0;
+  if (true == cmd_context.option_enable(cmd, opt_check_cache)) {
+    check_cache_fname = cmd_context.option_value(cmd, opt_check_cache);
+    check_key = find_openfpga_arch_check_key(
+      arch_file_name, g_vpr_ctx.device().physical_tile_types);
+    if ((false == cmd_context.option_enable(cmd, opt_force_check)) &&
+        (true == find_check_result_cache(check_cache_fname, check_key))) {
+      VTR_LOG(
+        "Skipped the checks on architecture '%s' which have passed before "
+        "(see check cache '%s')\n",
+        arch_file_name.c_str(), check_cache_fname.c_str());
+      return CMD_EXEC_SUCCESS;
+    }
+  }
 
   /* Check the architecture:
    * 1. Circuit library
@@ -67,6 +140,11 @@ int read_openfpga_arch_template(T& openfpga_context, const Command& cmd,
     return CMD_EXEC_FATAL_ERROR;
   }
 
+  /* Record the checks which have passed */
+  if (false == check_cache_fname.empty()) {
+    return write_check_result_cache(check_cache_fname, check_key);
+  }
+
   return CMD_EXEC_SUCCESS;
 }
 
@@ -97,6 +175,28 @@ int write_openfpga_arch_template(const T& openfpga_context, const Command& cmd,
   return CMD_EXEC_SUCCESS;
 }
 
+/********************************************************************
+ * A function to write an OpenFPGA architecture to a binary bundle, which can
+ * be loaded by command 'read_openfpga_arch' with option '--bundle'
+ *
+ * The command will accept an option '--file' which is the bundle file
+ * provided by users
+ *******************************************************************/
+template <class T>
+int write_openfpga_arch_bundle_template(const T& openfpga_context,
+                                        const Command& cmd,
+                                        const CommandContext& cmd_context) {
+  CommandOptionId opt_file = cmd.option("file");
+  VTR_ASSERT(true == cmd_context.option_enable(cmd, opt_file));
+  VTR_ASSERT(false == cmd_context.option_value(cmd, opt_file).empty());
+
+  std::string bundle_file_name = cmd_context.option_value(cmd, opt_file);
+
+  VTR_LOG("Writing architecture bundle to '%s'...\n",
+          bundle_file_name.c_str());
+  return write_openfpga_arch_bundle(bundle_file_name, openfpga_context.arch());
+}
+
 /********************************************************************
  * Top-level function to read an OpenFPGA simulation setting file
  * we use the APIs from the libarchopenfpga library
@@ -9,6 +9,7 @@
 #include "command_context.h"
 #include "command_exit_codes.h"
 #include "globals.h"
+#include "openfpga_parallel.h"
 #include "read_xml_repack_design_constraints.h"
 #include "repack.h"
 #include "repack_design_constraints.h"
@@ -27,8 +28,37 @@ int repack_template(T& openfpga_ctx, const Command& cmd,
   CommandOptionId opt_design_constraints = cmd.option("design_constraints");
   CommandOptionId opt_ignore_global_nets =
     cmd.option("ignore_global_nets_on_pins");
+  CommandOptionId opt_threads = cmd.option("threads");
+  CommandOptionId opt_lookahead = cmd.option("lookahead");
+  CommandOptionId opt_max_stagnant_route_iterations =
+    cmd.option("max_stagnant_route_iterations");
+  CommandOptionId opt_lb_rr_graph_cache = cmd.option("lb_rr_graph_cache");
   CommandOptionId opt_verbose = cmd.option("verbose");
 
+  /* Default to be single-thread */
+  size_t num_threads = 1;
+  if ((true == cmd_context.option_enable(cmd, opt_threads)) &&
+      (false == parse_num_threads(cmd_context.option_value(cmd, opt_threads),
+                                  num_threads))) {
+    return CMD_EXEC_FATAL_ERROR;
+  }
+
+  /* Default to be disabled */
+  int max_stagnant_route_iterations = 0;
+  if (true ==
+      cmd_context.option_enable(cmd, opt_max_stagnant_route_iterations)) {
+    max_stagnant_route_iterations = std::atoi(
+      cmd_context.option_value(cmd, opt_max_stagnant_route_iterations)
+        .c_str());
+    if (0 > max_stagnant_route_iterations) {
+      VTR_LOG_ERROR(
+        "Invalid number of stagnant routing iterations '%d' which should be 0 "
+        "or a positive number!\n",
+        max_stagnant_route_iterations);
+      return CMD_EXEC_FATAL_ERROR;
+    }
+  }
+
   /* Load design constraints from file */
   RepackDesignConstraints repack_design_constraints;
   if (true == cmd_context.option_enable(cmd, opt_design_constraints)) {
@@ -44,6 +74,13 @@ int repack_template(T& openfpga_ctx, const Command& cmd,
   options.set_design_constraints(repack_design_constraints);
   options.set_ignore_global_nets_on_pins(
     cmd_context.option_value(cmd, opt_ignore_global_nets));
+  options.set_num_threads(num_threads);
+  options.set_lookahead(cmd_context.option_enable(cmd, opt_lookahead));
+  options.set_max_stagnant_route_iterations(max_stagnant_route_iterations);
+  if (true == cmd_context.option_enable(cmd, opt_lb_rr_graph_cache)) {
+    options.set_lb_rr_graph_cache(
+      cmd_context.option_value(cmd, opt_lb_rr_graph_cache));
+  }
   options.set_verbose_output(cmd_context.option_enable(cmd, opt_verbose));
 
   if (!options.valid()) {
@@ -61,7 +98,8 @@ int repack_template(T& openfpga_ctx, const Command& cmd,
   build_physical_lut_truth_tables(
     openfpga_ctx.mutable_vpr_clustering_annotation(), g_vpr_ctx.atom(),
     g_vpr_ctx.clustering(), openfpga_ctx.vpr_device_annotation(),
-    openfpga_ctx.arch().circuit_lib, options.verbose_output());
+    openfpga_ctx.arch().circuit_lib, options.num_threads(),
+    options.verbose_output());
 
   /* TODO: should identify the error code from internal function execution */
   return CMD_EXEC_SUCCESS;
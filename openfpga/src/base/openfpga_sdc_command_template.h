@@ -90,6 +90,12 @@ ShellCommandId add_write_pnr_sdc_command_template(
   shell_cmd.add_option("constrain_zero_delay_paths", false,
                        "Constrain zero-delay paths in FPGA fabric");
 
+  /* Add an option '--group_grid_delays' */
+  shell_cmd.add_option(
+    "group_grid_delays", false,
+    "Group the pin-to-pin paths of grids with identical delays into regular "
+    "expressions");
+
   /* Add an option '--no_time_stamp' */
   shell_cmd.add_option("no_time_stamp", false,
                        "Do not print time stamp in output files");
@@ -145,6 +151,11 @@ ShellCommandId add_write_configuration_chain_sdc_command_template(
     "max_delay", false, "Specify the maximum delay to be used.");
   shell_cmd.set_option_require_value(max_dly_opt, openfpga::OPT_STRING);
 
+  /* Add an option '--hierarchical' */
+  shell_cmd.add_option("hierarchical", false,
+                       "Output SDC files for each unique module, whose paths "
+                       "are relative to the module");
+
   /* Add an option '--no_time_stamp' */
   shell_cmd.add_option("no_time_stamp", false,
                        "Do not print time stamp in output files");
@@ -242,6 +253,18 @@ ShellCommandId add_write_analysis_sdc_command_template(
   shell_cmd.add_option("no_time_stamp", false,
                        "Do not print time stamp in output files");
 
+  /* Add an option '--threads' */
+  CommandOptionId opt_threads = shell_cmd.add_option(
+    "threads", false,
+    "Number of threads used to write the constraints of routing blocks and "
+    "grids. Use 0 to use all the hardware threads. Default: 1");
+  shell_cmd.set_option_require_value(opt_threads, openfpga::OPT_INT);
+
+  /* Add an option '--compress_pin_ranges' */
+  shell_cmd.add_option("compress_pin_ranges", false,
+                       "Merge the pins disabled in each routing block and "
+                       "grid into ranges of pins");
+
   /* Add command 'write_fabric_verilog' to the Shell */
   ShellCommandId shell_cmd_id =
     shell.add_command(shell_cmd,
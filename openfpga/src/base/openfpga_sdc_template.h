@@ -12,6 +12,7 @@
 #include "configure_port_sdc_writer.h"
 #include "globals.h"
 #include "openfpga_digest.h"
+#include "openfpga_parallel.h"
 #include "openfpga_scale.h"
 #include "pnr_sdc_writer.h"
 #include "vtr_log.h"
@@ -46,6 +47,7 @@ int write_pnr_sdc_template(const T& openfpga_ctx, const Command& cmd,
     cmd.option("constrain_switch_block_outputs");
   CommandOptionId opt_constrain_zero_delay_paths =
     cmd.option("constrain_zero_delay_paths");
+  CommandOptionId opt_group_grid_delays = cmd.option("group_grid_delays");
   CommandOptionId opt_no_time_stamp = cmd.option("no_time_stamp");
 
   /* This is an intermediate data structure which is designed to modularize the
@@ -86,6 +88,8 @@ int write_pnr_sdc_template(const T& openfpga_ctx, const Command& cmd,
     cmd_context.option_enable(cmd, opt_constrain_switch_block_outputs));
   options.set_constrain_zero_delay_paths(
     cmd_context.option_enable(cmd, opt_constrain_zero_delay_paths));
+  options.set_group_grid_delays(
+    cmd_context.option_enable(cmd, opt_group_grid_delays));
   options.set_time_stamp(!cmd_context.option_enable(cmd, opt_no_time_stamp));
 
   /* We first turn on default sdc option and then disable part of them by
@@ -133,6 +137,7 @@ int write_configuration_chain_sdc_template(const T& openfpga_ctx,
   CommandOptionId opt_time_unit = cmd.option("time_unit");
   CommandOptionId opt_min_delay = cmd.option("min_delay");
   CommandOptionId opt_max_delay = cmd.option("max_delay");
+  CommandOptionId opt_hierarchical = cmd.option("hierarchical");
   CommandOptionId opt_no_time_stamp = cmd.option("no_time_stamp");
 
   std::string sdc_dir_path =
@@ -147,6 +152,7 @@ int write_configuration_chain_sdc_template(const T& openfpga_ctx,
     std::stof(cmd_context.option_value(cmd, opt_max_delay)),
     std::stof(cmd_context.option_value(cmd, opt_min_delay)),
     !cmd_context.option_enable(cmd, opt_no_time_stamp),
+    cmd_context.option_enable(cmd, opt_hierarchical),
     openfpga_ctx.module_graph());
 
   return CMD_EXEC_SUCCESS;
@@ -194,6 +200,16 @@ int write_analysis_sdc_template(const T& openfpga_ctx, const Command& cmd,
   CommandOptionId opt_flatten_names = cmd.option("flatten_names");
   CommandOptionId opt_time_unit = cmd.option("time_unit");
   CommandOptionId opt_no_time_stamp = cmd.option("no_time_stamp");
+  CommandOptionId opt_threads = cmd.option("threads");
+  CommandOptionId opt_compress_pin_ranges = cmd.option("compress_pin_ranges");
+
+  /* Default to be single-thread */
+  size_t num_threads = 1;
+  if ((true == cmd_context.option_enable(cmd, opt_threads)) &&
+      (false == parse_num_threads(cmd_context.option_value(cmd, opt_threads),
+                                  num_threads))) {
+    return CMD_EXEC_FATAL_ERROR;
+  }
 
   /* This is an intermediate data structure which is designed to modularize the
    * FPGA-SDC Keep it independent from any other outside data structures
@@ -208,6 +224,9 @@ int write_analysis_sdc_template(const T& openfpga_ctx, const Command& cmd,
   options.set_generate_sdc_analysis(true);
   options.set_flatten_names(cmd_context.option_enable(cmd, opt_flatten_names));
   options.set_time_stamp(!cmd_context.option_enable(cmd, opt_no_time_stamp));
+  options.set_num_threads(num_threads);
+  options.set_compress_pin_ranges(
+    cmd_context.option_enable(cmd, opt_compress_pin_ranges));
 
   if (true == cmd_context.option_enable(cmd, opt_time_unit)) {
     options.set_time_unit(
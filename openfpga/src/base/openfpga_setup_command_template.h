@@ -9,6 +9,7 @@
 #include "openfpga_build_fabric_template.h"
 #include "openfpga_link_arch_template.h"
 #include "openfpga_lut_truth_table_fixup_template.h"
+#include "openfpga_memory_usage_template.h"
 #include "openfpga_pb_pin_fixup_template.h"
 #include "openfpga_pcf2place_template.h"
 #include "openfpga_read_arch_template.h"
@@ -35,6 +36,23 @@ ShellCommandId add_read_openfpga_arch_command_template(
   shell_cmd.set_option_short_name(opt_arch_file, "f");
   shell_cmd.set_option_require_value(opt_arch_file, openfpga::OPT_STRING);
 
+  /* Add an option '--bundle' */
+  shell_cmd.add_option("bundle", false,
+                       "the file is a binary bundle created by command "
+                       "write_openfpga_arch_bundle");
+
+  /* Add an option '--check_cache' */
+  CommandOptionId opt_check_cache = shell_cmd.add_option(
+    "check_cache", false,
+    "file path to a cache of the checks passed. The checks on the "
+    "architecture are skipped if they have passed on the same inputs");
+  shell_cmd.set_option_require_value(opt_check_cache, openfpga::OPT_STRING);
+
+  /* Add an option '--force_check' */
+  shell_cmd.add_option("force_check", false,
+                       "always check the architecture, even if the check "
+                       "cache shows that the checks have passed");
+
   /* Add command 'read_openfpga_arch' to the Shell */
   ShellCommandId shell_cmd_id =
     shell.add_command(shell_cmd, "read OpenFPGA architecture file", hidden);
@@ -74,6 +92,35 @@ ShellCommandId add_write_openfpga_arch_command_template(
   return shell_cmd_id;
 }
 
+/********************************************************************
+ * - Add a command to Shell environment: write_openfpga_arch_bundle
+ * - Add associated options
+ * - Add command dependency
+ *******************************************************************/
+template <class T>
+ShellCommandId add_write_openfpga_arch_bundle_command_template(
+  openfpga::Shell<T>& shell, const ShellCommandClassId& cmd_class_id,
+  const std::vector<ShellCommandId>& dependent_cmds, const bool& hidden) {
+  Command shell_cmd("write_openfpga_arch_bundle");
+  /* Add an option '--file' in short '-f'*/
+  CommandOptionId opt_file = shell_cmd.add_option(
+    "file", true, "file path to the binary architecture bundle");
+  shell_cmd.set_option_short_name(opt_file, "f");
+  shell_cmd.set_option_require_value(opt_file, openfpga::OPT_STRING);
+
+  /* Add command 'write_openfpga_arch_bundle' to the Shell */
+  ShellCommandId shell_cmd_id = shell.add_command(
+    shell_cmd, "write OpenFPGA architecture to a binary bundle", hidden);
+  shell.set_command_class(shell_cmd_id, cmd_class_id);
+  shell.set_command_const_execute_function(
+    shell_cmd_id, write_openfpga_arch_bundle_template<T>);
+
+  /* Add command dependency to the Shell */
+  shell.set_command_dependency(shell_cmd_id, dependent_cmds);
+
+  return shell_cmd_id;
+}
+
 /********************************************************************
  * - Add a command to Shell environment: read_openfpga_simulation_setting
  * - Add associated options
@@ -207,6 +254,14 @@ ShellCommandId add_link_arch_command_template(
                        "Sort all the incoming edges for each routing track "
                        "output node in General Switch Blocks (GSBs)");
 
+  /* Add an option '--threads'*/
+  CommandOptionId opt_threads = shell_cmd.add_option(
+    "threads", false,
+    "Number of threads used to annotate routing results, to build General "
+    "Switch Blocks (GSBs) and to sort their incoming edges. Use 0 to use all "
+    "the hardware threads. Default: 1");
+  shell_cmd.set_option_require_value(opt_threads, openfpga::OPT_INT);
+
   /* Add an option '--verbose' */
   shell_cmd.add_option("verbose", false, "Show verbose outputs");
 
@@ -262,6 +317,18 @@ ShellCommandId add_write_gsb_command_template(
                          "specify multiple GSBs by using a splitter ``,``");
   shell_cmd.set_option_require_value(opt_gsb_names, openfpga::OPT_STRING);
 
+  /* Add an option '--single_file' */
+  shell_cmd.add_option("single_file", false,
+                       "Write all the GSBs to a single XML file, whose path is "
+                       "given by the option '--file'");
+
+  /* Add an option '--threads' */
+  CommandOptionId opt_threads = shell_cmd.add_option(
+    "threads", false,
+    "Number of threads used to write the GSBs. Use 0 to use all the hardware "
+    "threads. Default: 1");
+  shell_cmd.set_option_require_value(opt_threads, openfpga::OPT_INT);
+
   /* Add an option '--verbose' */
   shell_cmd.add_option("verbose", false, "Show verbose outputs");
 
@@ -324,6 +391,13 @@ ShellCommandId add_pb_pin_fixup_command_template(
   const std::vector<ShellCommandId>& dependent_cmds, const bool& hidden) {
   Command shell_cmd("pb_pin_fixup");
 
+  /* Add an option '--threads' */
+  CommandOptionId opt_threads = shell_cmd.add_option(
+    "threads", false,
+    "Number of threads used to fix up clustered blocks. Use 0 to use all the "
+    "hardware threads. Default: 1");
+  shell_cmd.set_option_require_value(opt_threads, openfpga::OPT_INT);
+
   /* Add an option '--verbose' */
   shell_cmd.add_option("verbose", false, "Show verbose outputs");
 
@@ -351,6 +425,14 @@ ShellCommandId add_lut_truth_table_fixup_command_template(
   openfpga::Shell<T>& shell, const ShellCommandClassId& cmd_class_id,
   const std::vector<ShellCommandId>& dependent_cmds, const bool& hidden) {
   Command shell_cmd("lut_truth_table_fixup");
+
+  /* Add an option '--threads' */
+  CommandOptionId opt_threads = shell_cmd.add_option(
+    "threads", false,
+    "Number of threads used to fix up clustered blocks. Use 0 to use all the "
+    "hardware threads. Default: 1");
+  shell_cmd.set_option_require_value(opt_threads, openfpga::OPT_INT);
+
   /* Add an option '--verbose' */
   shell_cmd.add_option("verbose", false, "Show verbose outputs");
 
@@ -400,6 +482,11 @@ ShellCommandId add_build_fabric_command_template(
                        "Use index to name modules, such as cbx_0_, rather than "
                        "coordinates, such as cbx_1__0_");
 
+  /* Add an option '--merge_identical_modules' */
+  shell_cmd.add_option("merge_identical_modules", false,
+                       "Merge the grid, routing and tile modules which are "
+                       "structurally identical but have different names");
+
   /* Add an option '--load_fabric_key' */
   CommandOptionId opt_load_fkey = shell_cmd.add_option(
     "load_fabric_key", false, "load the fabric key from the given file");
@@ -429,6 +516,34 @@ ShellCommandId add_build_fabric_command_template(
                        "Create a random fabric key which will shuffle the "
                        "memory address for encryption purpose");
 
+  /* Add an option '--random_fabric_key_seed' */
+  CommandOptionId opt_random_fabric_key_seed = shell_cmd.add_option(
+    "random_fabric_key_seed", false,
+    "Seed of the random fabric key. The same seed always produces the same "
+    "key, whatever the number of threads. Default: 0");
+  shell_cmd.set_option_require_value(opt_random_fabric_key_seed,
+                                     openfpga::OPT_INT);
+
+  /* Add an option '--read_fabric_database' */
+  CommandOptionId opt_read_fdb = shell_cmd.add_option(
+    "read_fabric_database", false,
+    "load the fabric from a database created by '--write_fabric_database'. "
+    "The fabric is built as usual if the database is missing or outdated");
+  shell_cmd.set_option_require_value(opt_read_fdb, openfpga::OPT_STRING);
+
+  /* Add an option '--write_fabric_database' */
+  CommandOptionId opt_write_fdb = shell_cmd.add_option(
+    "write_fabric_database", false,
+    "save the fabric to a binary database, which can be loaded next time");
+  shell_cmd.set_option_require_value(opt_write_fdb, openfpga::OPT_STRING);
+
+  /* Add an option '--threads' */
+  CommandOptionId opt_threads = shell_cmd.add_option(
+    "threads", false,
+    "Number of threads used to build the fabric. Use 0 to use all the "
+    "hardware threads. Default: 1");
+  shell_cmd.set_option_require_value(opt_threads, openfpga::OPT_INT);
+
   /* Add an option '--verbose' */
   shell_cmd.add_option("verbose", false, "Show verbose outputs");
 
@@ -467,6 +582,11 @@ ShellCommandId add_write_fabric_hierarchy_command_template(
     "Specify the depth of hierarchy to which the writer should stop");
   shell_cmd.set_option_require_value(opt_depth, openfpga::OPT_INT);
 
+  /* Add an option '--dag' */
+  shell_cmd.add_option("dag", false,
+                       "Write the subtree of each module only once, and refer "
+                       "to it elsewhere with a YAML alias");
+
   /* Add an option '--verbose' */
   shell_cmd.add_option("verbose", false, "Show verbose outputs");
 
@@ -658,6 +778,13 @@ ShellCommandId add_append_clock_rr_graph_command_template(
   const std::vector<ShellCommandId>& dependent_cmds, const bool& hidden) {
   Command shell_cmd("append_clock_rr_graph");
 
+  /* Add an option '--threads' */
+  CommandOptionId opt_threads = shell_cmd.add_option(
+    "threads", false,
+    "Number of threads used to find the edges of clock routing tracks. Use 0 "
+    "to use all the hardware threads. Default: 1");
+  shell_cmd.set_option_require_value(opt_threads, openfpga::OPT_INT);
+
   /* Add an option '--verbose' */
   shell_cmd.add_option("verbose", false, "Show verbose outputs");
 
@@ -776,6 +903,16 @@ ShellCommandId add_write_fabric_key_command_template(
   /* Add an option '--include_module_keys'*/
   shell_cmd.add_option("include_module_keys", false,
                        "Include module-level keys");
+  /* Add an option '--binary'*/
+  shell_cmd.add_option("binary", false,
+                       "Write the fabric key in a binary format, which can "
+                       "be loaded much faster than XML");
+  /* Add an option '--threads' */
+  CommandOptionId opt_threads = shell_cmd.add_option(
+    "threads", false,
+    "Number of threads used to collect the keys. Use 0 to use all the "
+    "hardware threads. Default: 1");
+  shell_cmd.set_option_require_value(opt_threads, openfpga::OPT_INT);
   shell_cmd.add_option("verbose", false, "Show verbose outputs");
 
   /* Add command to the Shell */
@@ -858,6 +995,65 @@ ShellCommandId add_write_module_naming_rules_command_template(
   return shell_cmd_id;
 }
 
+/********************************************************************
+ * - Add a command to Shell environment: report_memory_usage
+ * - Add associated options
+ * - Add command dependency
+ *******************************************************************/
+template <class T>
+ShellCommandId add_report_memory_usage_command_template(
+  openfpga::Shell<T>& shell, const ShellCommandClassId& cmd_class_id,
+  const bool& hidden) {
+  Command shell_cmd("report_memory_usage");
+
+  shell_cmd.add_option(
+    "verbose", false,
+    "Show verbose outputs, including the data structures not built yet");
+
+  /* Add command to the Shell */
+  ShellCommandId shell_cmd_id = shell.add_command(
+    shell_cmd,
+    "Report the approximate memory used by each major data structure of "
+    "OpenFPGA",
+    hidden);
+  shell.set_command_class(shell_cmd_id, cmd_class_id);
+  shell.set_command_const_execute_function(
+    shell_cmd_id, report_memory_usage_template<T>);
+
+  return shell_cmd_id;
+}
+
+/********************************************************************
+ * - Add a command to Shell environment: free_data_structure
+ * - Add associated options
+ * - Add command dependency
+ *******************************************************************/
+template <class T>
+ShellCommandId add_free_data_structure_command_template(
+  openfpga::Shell<T>& shell, const ShellCommandClassId& cmd_class_id,
+  const bool& hidden) {
+  Command shell_cmd("free_data_structure");
+  /* Add an option '--name' */
+  CommandOptionId opt_name = shell_cmd.add_option(
+    "name", true,
+    "Name of the data structure to release. Can be "
+    "[device_rr_gsb|fabric_tile|mux_lib|bitstream_manager|fabric_bitstream|"
+    "vpr_routing_annotation|physical_pb]");
+  shell_cmd.set_option_require_value(opt_name, openfpga::OPT_STRING);
+
+  shell_cmd.add_option("verbose", false, "Show verbose outputs");
+
+  /* Add command to the Shell */
+  ShellCommandId shell_cmd_id = shell.add_command(
+    shell_cmd,
+    "Release the memory of a data structure which is no longer needed", hidden);
+  shell.set_command_class(shell_cmd_id, cmd_class_id);
+  shell.set_command_execute_function(shell_cmd_id,
+                                     free_data_structure_template<T>);
+
+  return shell_cmd_id;
+}
+
 template <class T>
 void add_setup_command_templates(openfpga::Shell<T>& shell,
                                  const bool& hidden = false) {
@@ -889,6 +1085,14 @@ void add_setup_command_templates(openfpga::Shell<T>& shell,
   add_write_openfpga_arch_command_template<T>(
     shell, openfpga_setup_cmd_class, write_arch_dependent_cmds, hidden);
 
+  /********************************
+   * Command 'write_openfpga_arch_bundle'
+   */
+  /* The 'write_openfpga_arch_bundle' command should NOT be executed before
+   * 'read_openfpga_arch' */
+  add_write_openfpga_arch_bundle_command_template<T>(
+    shell, openfpga_setup_cmd_class, write_arch_dependent_cmds, hidden);
+
   /********************************
    * Command 'read_openfpga_simulation_setting'
    */
@@ -1098,6 +1302,18 @@ void add_setup_command_templates(openfpga::Shell<T>& shell,
   add_write_module_naming_rules_command_template<T>(
     shell, openfpga_setup_cmd_class, cmd_dependency_write_module_naming_rules,
     hidden);
+
+  /********************************
+   * Command 'report_memory_usage'
+   */
+  add_report_memory_usage_command_template<T>(shell, openfpga_setup_cmd_class,
+                                              hidden);
+
+  /********************************
+   * Command 'free_data_structure'
+   */
+  add_free_data_structure_command_template<T>(shell, openfpga_setup_cmd_class,
+                                              hidden);
 }
 
 } /* end namespace openfpga */
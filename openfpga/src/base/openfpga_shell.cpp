@@ -45,6 +45,28 @@ int OpenfpgaShell::run_command(const char* cmd_line) {
   return shell_.execute_command(cmd_line, openfpga_ctx_);
 }
 
+/********************************************************************
+ * Clear the data which is specific to a design, so that the next job of the
+ * server mode starts from the fabric built by the setup script
+ *******************************************************************/
+static void reset_design_context(OpenfpgaContext& openfpga_ctx) {
+  openfpga_ctx.mutable_vpr_netlist_annotation() =
+    openfpga::VprNetlistAnnotation();
+  openfpga_ctx.mutable_vpr_clustering_annotation() =
+    openfpga::VprClusteringAnnotation();
+  openfpga_ctx.mutable_vpr_placement_annotation() =
+    openfpga::VprPlacementAnnotation();
+  openfpga_ctx.mutable_vpr_routing_annotation() =
+    openfpga::VprRoutingAnnotation();
+  /* The bitstream annotation is rebuilt by link_openfpga_arch of each job,
+   * while the clock routes depend on the nets of the design */
+  openfpga_ctx.mutable_vpr_bitstream_annotation() =
+    openfpga::VprBitstreamAnnotation();
+  openfpga_ctx.mutable_clock_rr_routes().clear();
+  openfpga_ctx.mutable_bitstream_manager() = openfpga::BitstreamManager();
+  openfpga_ctx.mutable_fabric_bitstream() = openfpga::FabricBitstream();
+}
+
 void OpenfpgaShell::reset() {
   /* TODO: reset the shell status */
   /* TODO: reset the data storage */
@@ -75,6 +97,37 @@ int OpenfpgaShell::start(int argc, char** argv) {
                          "Launch OpenFPGA in batch  mode when running scripts");
   start_cmd.set_option_short_name(opt_batch_exec, "batch");
 
+  /* '--concurrent_execution': execute the consecutive read-only commands of
+   * the script in parallel
+   */
+  openfpga::CommandOptionId opt_concurrent_exec = start_cmd.add_option(
+    "concurrent_execution", false,
+    "Execute consecutive commands, which only read data and do not depend on "
+    "each other, in parallel when running scripts");
+
+  /* '--server': execute the scripts written to a named pipe */
+  openfpga::CommandOptionId opt_server = start_cmd.add_option(
+    "server", false,
+    "Launch OpenFPGA in server mode, which executes the scripts whose paths "
+    "are written to a named pipe. The script of '--file', if any, is executed "
+    "once before the first job");
+  start_cmd.set_option_require_value(opt_server, openfpga::OPT_STRING);
+
+  /* '--runtime_report': write the runtime of each command to a file */
+  openfpga::CommandOptionId opt_runtime_report = start_cmd.add_option(
+    "runtime_report", false,
+    "Write the wall time, CPU time and memory usage of each command to a "
+    "file when OpenFPGA quits, in CSV format if the file ends with '.csv', "
+    "otherwise in JSON format");
+  start_cmd.set_option_require_value(opt_runtime_report, openfpga::OPT_STRING);
+
+  /* '--trace': write a trace of commands and builders to a file */
+  openfpga::CommandOptionId opt_trace = start_cmd.add_option(
+    "trace", false,
+    "Write a trace of the commands and their internal steps to a file in the "
+    "Chrome trace event format when OpenFPGA quits");
+  start_cmd.set_option_require_value(opt_trace, openfpga::OPT_STRING);
+
   /* '--version', -v': print version information */
   openfpga::CommandOptionId opt_version =
     start_cmd.add_option("version", false, "Show OpenFPGA version");
@@ -104,18 +157,45 @@ int OpenfpgaShell::start(int argc, char** argv) {
       print_openfpga_version_info();
       return 0;
     }
+    if (true ==
+        start_cmd_context.option_enable(start_cmd, opt_runtime_report)) {
+      shell_.set_runtime_report_file(
+        start_cmd_context.option_value(start_cmd, opt_runtime_report));
+    }
+    if (true == start_cmd_context.option_enable(start_cmd, opt_trace)) {
+      shell_.set_trace_file(
+        start_cmd_context.option_value(start_cmd, opt_trace));
+    }
     /* Start a shell */
     if (true == start_cmd_context.option_enable(start_cmd, opt_interactive)) {
       shell_.run_interactive_mode(openfpga_ctx_);
-      return shell_.exit_code();
+      return shell_.exit_code() | shell_.write_runtime_report() |
+             shell_.write_trace();
+    }
+
+    if (true == start_cmd_context.option_enable(start_cmd, opt_server)) {
+      std::string setup_script;
+      if (true ==
+          start_cmd_context.option_enable(start_cmd, opt_script_mode)) {
+        setup_script =
+          start_cmd_context.option_value(start_cmd, opt_script_mode);
+      }
+      shell_.run_server_mode(
+        start_cmd_context.option_value(start_cmd, opt_server).c_str(),
+        setup_script.c_str(), openfpga_ctx_, reset_design_context,
+        start_cmd_context.option_enable(start_cmd, opt_concurrent_exec));
+      return shell_.exit_code() | shell_.write_runtime_report() |
+             shell_.write_trace();
     }
 
     if (true == start_cmd_context.option_enable(start_cmd, opt_script_mode)) {
       shell_.run_script_mode(
         start_cmd_context.option_value(start_cmd, opt_script_mode).c_str(),
         openfpga_ctx_,
-        start_cmd_context.option_enable(start_cmd, opt_batch_exec));
-      return shell_.exit_code();
+        start_cmd_context.option_enable(start_cmd, opt_batch_exec),
+        start_cmd_context.option_enable(start_cmd, opt_concurrent_exec));
+      return shell_.exit_code() | shell_.write_runtime_report() |
+             shell_.write_trace();
     }
     /* Reach here there is something wrong, show the help desk */
     openfpga::print_command_options(start_cmd);
@@ -6,6 +6,8 @@
  * in purpose of generate SPICE netlists modeling the full FPGA fabric
  * This is one of the core engine of openfpga, including:
  * - generate_fabric_spice : generate Verilog netlists about FPGA fabric
+ * - write_spice_characterization_testbench : generate SPICE testbenches
+ *characterizing routing multiplexers and Look-Up Tables
  * - TODO: generate_spice_top_testbench : generate SPICE testbenches for
  *top-level module
  * - TODO: generate_spice_grid_testbench : generate SPICE testbenches for grids
@@ -51,6 +53,14 @@ ShellCommandId add_write_fabric_spice_command_template(
   shell_cmd.add_option("explicit_port_mapping", false,
                        "Use explicit port mapping in Verilog netlists");
 
+  /* Add an option '--threads' */
+  CommandOptionId opt_threads = shell_cmd.add_option(
+    "threads", false,
+    "Number of threads used to write the netlists of primitive modules, "
+    "routing blocks and grids. Use 0 to use all the hardware threads. "
+    "Default: 1");
+  shell_cmd.set_option_require_value(opt_threads, openfpga::OPT_INT);
+
   /* Add an option '--verbose' */
   shell_cmd.add_option("verbose", false, "Enable verbose output");
 
@@ -67,6 +77,42 @@ ShellCommandId add_write_fabric_spice_command_template(
   return shell_cmd_id;
 }
 
+/********************************************************************
+ * - Add a command to Shell environment: write characterization testbenches
+ * - Add associated options
+ * - Add command dependency
+ *******************************************************************/
+template <class T>
+ShellCommandId add_write_spice_characterization_testbench_command_template(
+  openfpga::Shell<T>& shell, const ShellCommandClassId& cmd_class_id,
+  const std::vector<ShellCommandId>& dependent_cmds, const bool& hidden) {
+  Command shell_cmd("write_spice_characterization_testbench");
+
+  /* Add an option '--file' in short '-f'*/
+  CommandOptionId output_opt = shell_cmd.add_option(
+    "file", true, "Specify the output directory for SPICE testbenches");
+  shell_cmd.set_option_short_name(output_opt, "f");
+  shell_cmd.set_option_require_value(output_opt, openfpga::OPT_STRING);
+
+  /* Add an option '--verbose' */
+  shell_cmd.add_option("verbose", false, "Enable verbose output");
+
+  /* Add command 'write_spice_characterization_testbench' to the Shell */
+  ShellCommandId shell_cmd_id = shell.add_command(
+    shell_cmd,
+    "generate SPICE testbenches characterizing routing multiplexers and "
+    "Look-Up Tables under all the process corners",
+    hidden);
+  shell.set_command_class(shell_cmd_id, cmd_class_id);
+  shell.set_command_const_execute_function(
+    shell_cmd_id, write_spice_characterization_testbench_template<T>);
+
+  /* Add command dependency to the Shell */
+  shell.set_command_dependency(shell_cmd_id, dependent_cmds);
+
+  return shell_cmd_id;
+}
+
 template <class T>
 void add_spice_command_templates(openfpga::Shell<T>& shell,
                                  const bool& hidden = false) {
@@ -86,8 +132,20 @@ void add_spice_command_templates(openfpga::Shell<T>& shell,
    * 'build_fabric' */
   std::vector<ShellCommandId> fabric_spice_dependent_cmds;
   fabric_spice_dependent_cmds.push_back(build_fabric_cmd_id);
-  add_write_fabric_spice_command_template<T>(
-    shell, openfpga_spice_cmd_class, fabric_spice_dependent_cmds, hidden);
+  ShellCommandId write_fabric_spice_cmd_id =
+    add_write_fabric_spice_command_template<T>(
+      shell, openfpga_spice_cmd_class, fabric_spice_dependent_cmds, hidden);
+
+  /********************************
+   * Command 'write_spice_characterization_testbench'
+   */
+  /* The command 'write_spice_characterization_testbench' should NOT be
+   * executed before 'write_fabric_spice', whose netlists are included */
+  std::vector<ShellCommandId> characterization_tb_dependent_cmds;
+  characterization_tb_dependent_cmds.push_back(write_fabric_spice_cmd_id);
+  add_write_spice_characterization_testbench_command_template<T>(
+    shell, openfpga_spice_cmd_class, characterization_tb_dependent_cmds,
+    hidden);
 
   /********************************
    * TODO: Command 'write_spice_top_testbench'
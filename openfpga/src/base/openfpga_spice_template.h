@@ -5,6 +5,7 @@
 #include "command_context.h"
 #include "command_exit_codes.h"
 #include "globals.h"
+#include "openfpga_parallel.h"
 #include "spice_api.h"
 #include "vtr_log.h"
 #include "vtr_time.h"
@@ -21,8 +22,17 @@ int write_fabric_spice_template(T& openfpga_ctx, const Command& cmd,
   CommandOptionId opt_output_dir = cmd.option("file");
   CommandOptionId opt_explicit_port_mapping =
     cmd.option("explicit_port_mapping");
+  CommandOptionId opt_threads = cmd.option("threads");
   CommandOptionId opt_verbose = cmd.option("verbose");
 
+  /* Default to be single-thread */
+  size_t num_threads = 1;
+  if ((true == cmd_context.option_enable(cmd, opt_threads)) &&
+      (false == parse_num_threads(cmd_context.option_value(cmd, opt_threads),
+                                  num_threads))) {
+    return CMD_EXEC_FATAL_ERROR;
+  }
+
   /* This is an intermediate data structure which is designed to modularize the
    * FPGA-SPICE Keep it independent from any other outside data structures
    */
@@ -32,6 +42,7 @@ int write_fabric_spice_template(T& openfpga_ctx, const Command& cmd,
     cmd_context.option_enable(cmd, opt_explicit_port_mapping));
   options.set_verbose_output(cmd_context.option_enable(cmd, opt_verbose));
   options.set_compress_routing(openfpga_ctx.flow_manager().compress_routing());
+  options.set_num_threads(num_threads);
 
   int status = CMD_EXEC_SUCCESS;
   status = fpga_fabric_spice(
@@ -43,6 +54,24 @@ int write_fabric_spice_template(T& openfpga_ctx, const Command& cmd,
   return status;
 }
 
+/********************************************************************
+ * A wrapper function to call the characterization testbench generator of
+ * FPGA-SPICE
+ *******************************************************************/
+template <class T>
+int write_spice_characterization_testbench_template(
+  const T& openfpga_ctx, const Command& cmd,
+  const CommandContext& cmd_context) {
+  CommandOptionId opt_output_dir = cmd.option("file");
+  CommandOptionId opt_verbose = cmd.option("verbose");
+
+  return fpga_spice_characterization_testbench(
+    openfpga_ctx.spice_netlists(), openfpga_ctx.module_graph(),
+    openfpga_ctx.arch(), openfpga_ctx.mux_lib(),
+    cmd_context.option_value(cmd, opt_output_dir),
+    cmd_context.option_enable(cmd, opt_verbose));
+}
+
 } /* end namespace openfpga */
 
 #endif
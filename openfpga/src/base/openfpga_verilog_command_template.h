@@ -59,6 +59,73 @@ ShellCommandId add_write_fabric_verilog_command_template(
     "use_relative_path", false,
     "Force to use relative path in netlists when including other netlists");
 
+  /* Add an option '--compress_instance_arrays' */
+  shell_cmd.add_option("compress_instance_arrays", false,
+                       "Use generate loops to write the regular arrays of "
+                       "instances in the top-level netlists");
+
+  /* Add an option '--keep_unchanged_files' */
+  shell_cmd.add_option("keep_unchanged_files", false,
+                       "Do not overwrite the netlists whose content is "
+                       "unchanged since the last run");
+
+  /* Add an option '--pack_netlists' */
+  shell_cmd.add_option("pack_netlists", false,
+                       "Write the netlists of logic blocks, routing blocks "
+                       "and tiles to a few large files instead of a file each");
+
+  /* Add an option '--packed_netlist_size' */
+  CommandOptionId opt_packed_netlist_size = shell_cmd.add_option(
+    "packed_netlist_size", false,
+    "Maximum size (in MB) of each packed netlist. Use 0 to write all the "
+    "netlists to a single file. Default: 0");
+  shell_cmd.set_option_require_value(opt_packed_netlist_size,
+                                     openfpga::OPT_INT);
+
+  /* Add an option '--behavioral_muxes' */
+  shell_cmd.add_option("behavioral_muxes", false,
+                       "Write the routing and LUT multiplexers in behavioral "
+                       "Verilog for fast simulation");
+
+  /* Add an option '--skip_unused_modules' */
+  shell_cmd.add_option("skip_unused_modules", false,
+                       "Do not write the primitive modules and logical tiles "
+                       "which are not used under the top-level module");
+
+  /* Add an option '--two_state' */
+  shell_cmd.add_option("two_state", false,
+                       "Write the primitive modules without any high-impedance "
+                       "or unknown value for 2-state simulators");
+
+  /* Add an option '--submodule_library' */
+  CommandOptionId opt_submodule_library = shell_cmd.add_option(
+    "submodule_library", false,
+    "Write the submodule netlists to a library directory shared by fabrics, "
+    "where each netlist is named after the hash of its content");
+  shell_cmd.set_option_require_value(opt_submodule_library,
+                                     openfpga::OPT_STRING);
+
+  /* Add an option '--threads' */
+  CommandOptionId opt_threads = shell_cmd.add_option(
+    "threads", false,
+    "Number of threads used to write the netlists of routing blocks, grids "
+    "and tiles. Use 0 to use all the hardware threads. Default: 1");
+  shell_cmd.set_option_require_value(opt_threads, openfpga::OPT_INT);
+
+  /* Add an option '--num_partitions' */
+  CommandOptionId opt_num_partitions = shell_cmd.add_option(
+    "num_partitions", false,
+    "Spread the netlists of routing blocks, grids and tiles over a number of "
+    "partitions, which are written by separated processes. Default: 1");
+  shell_cmd.set_option_require_value(opt_num_partitions, openfpga::OPT_INT);
+
+  /* Add an option '--partition' */
+  CommandOptionId opt_partition = shell_cmd.add_option(
+    "partition", false,
+    "Index of the partition to be written, starting from 0. Partition 0 also "
+    "writes the submodules and the top-level modules. Default: 0");
+  shell_cmd.set_option_require_value(opt_partition, openfpga::OPT_INT);
+
   /* Add an option '--verbose' */
   shell_cmd.add_option("verbose", false, "Enable verbose output");
 
@@ -140,6 +207,12 @@ ShellCommandId add_write_full_testbench_command_template(
     "fast_configuration", false,
     "reduce the period of configuration by skip certain data points");
 
+  /* add an option '--hex_bitstream' */
+  shell_cmd.add_option(
+    "hex_bitstream", false,
+    "write the bitstream file in hexadecimal and load it with $readmemh. "
+    "Applicable to configuration chain and memory bank protocols");
+
   /* add an option '--explicit_port_mapping' */
   shell_cmd.add_option("explicit_port_mapping", false,
                        "use explicit port mapping in verilog netlists");
@@ -246,6 +319,26 @@ ShellCommandId add_write_preconfigured_fabric_wrapper_command_template(
                          "may cause a large netlist file size");
   shell_cmd.set_option_require_value(embed_bitstream_opt, openfpga::OPT_STRING);
 
+  /* Add an option '--embed_bitstream_memory' */
+  shell_cmd.add_option(
+    "embed_bitstream_memory", false,
+    "Load the embedded bitstream from a memory file with $readmemb, so that "
+    "the wrapper netlist does not contain bitstream values");
+
+  /* Add an option '--shared_bitstream_loader' */
+  shell_cmd.add_option(
+    "shared_bitstream_loader", false,
+    "Write the statements loading the bitstream memory file to a netlist "
+    "shared by all the designs, which reads the memory file given by "
+    "+bitstream_mem=<file> at simulation time");
+
+  /* Add an option '--threads' */
+  CommandOptionId opt_threads = shell_cmd.add_option(
+    "threads", false,
+    "Number of threads used to generate the statements of the embedded "
+    "bitstream. Use 0 to use all the hardware threads. Default: 1");
+  shell_cmd.set_option_require_value(opt_threads, openfpga::OPT_INT);
+
   /* add an option '--include_signal_init' */
   shell_cmd.add_option("include_signal_init", false,
                        "initialize all the signals in verilog testbenches");
@@ -8,6 +8,7 @@
 #include "command_context.h"
 #include "command_exit_codes.h"
 #include "globals.h"
+#include "openfpga_parallel.h"
 #include "openfpga_scale.h"
 #include "read_xml_bus_group.h"
 #include "read_xml_pin_constraints.h"
@@ -34,8 +35,77 @@ int write_fabric_verilog_template(T& openfpga_ctx, const Command& cmd,
   CommandOptionId opt_default_net_type = cmd.option("default_net_type");
   CommandOptionId opt_no_time_stamp = cmd.option("no_time_stamp");
   CommandOptionId opt_use_relative_path = cmd.option("use_relative_path");
+  CommandOptionId opt_compress_instance_arrays =
+    cmd.option("compress_instance_arrays");
+  CommandOptionId opt_keep_unchanged_files = cmd.option("keep_unchanged_files");
+  CommandOptionId opt_pack_netlists = cmd.option("pack_netlists");
+  CommandOptionId opt_packed_netlist_size = cmd.option("packed_netlist_size");
+  CommandOptionId opt_behavioral_muxes = cmd.option("behavioral_muxes");
+  CommandOptionId opt_skip_unused_modules = cmd.option("skip_unused_modules");
+  CommandOptionId opt_two_state = cmd.option("two_state");
+  CommandOptionId opt_submodule_library = cmd.option("submodule_library");
+  CommandOptionId opt_threads = cmd.option("threads");
+  CommandOptionId opt_num_partitions = cmd.option("num_partitions");
+  CommandOptionId opt_partition = cmd.option("partition");
   CommandOptionId opt_verbose = cmd.option("verbose");
 
+  /* Default to be single-thread */
+  size_t num_threads = 1;
+  if ((true == cmd_context.option_enable(cmd, opt_threads)) &&
+      (false == parse_num_threads(cmd_context.option_value(cmd, opt_threads),
+                                  num_threads))) {
+    return CMD_EXEC_FATAL_ERROR;
+  }
+
+  /* Default to be a single packed netlist */
+  int packed_netlist_size = 0;
+  if (true == cmd_context.option_enable(cmd, opt_packed_netlist_size)) {
+    packed_netlist_size = std::atoi(
+      cmd_context.option_value(cmd, opt_packed_netlist_size).c_str());
+    /* Error out if we have negative number */
+    if (0 > packed_netlist_size) {
+      VTR_LOG_ERROR(
+        "Invalid size of packed netlists '%d' which should be 0 or a positive "
+        "number!\n",
+        packed_netlist_size);
+      return CMD_EXEC_FATAL_ERROR;
+    }
+  }
+
+  /* Default to be a single partition */
+  int num_partitions = 1;
+  if (true == cmd_context.option_enable(cmd, opt_num_partitions)) {
+    num_partitions =
+      std::atoi(cmd_context.option_value(cmd, opt_num_partitions).c_str());
+    if (1 > num_partitions) {
+      VTR_LOG_ERROR(
+        "Invalid number of partitions '%d' which should be a positive "
+        "number!\n",
+        num_partitions);
+      return CMD_EXEC_FATAL_ERROR;
+    }
+  }
+  int partition = 0;
+  if (true == cmd_context.option_enable(cmd, opt_partition)) {
+    partition = std::atoi(cmd_context.option_value(cmd, opt_partition).c_str());
+    if ((0 > partition) || (num_partitions <= partition)) {
+      VTR_LOG_ERROR(
+        "Invalid partition '%d' which should be in the range [0, %d)!\n",
+        partition, num_partitions);
+      return CMD_EXEC_FATAL_ERROR;
+    }
+  }
+  /* The netlists of a pack are not separated files, which can not be
+   * written by different processes */
+  if ((1 < num_partitions) &&
+      (true == cmd_context.option_enable(cmd, opt_pack_netlists))) {
+    VTR_LOG_ERROR(
+      "Option '--%s' can not be used with option '--%s'!\n",
+      cmd.option_name(opt_num_partitions).c_str(),
+      cmd.option_name(opt_pack_netlists).c_str());
+    return CMD_EXEC_FATAL_ERROR;
+  }
+
   /* This is an intermediate data structure which is designed to modularize the
    * FPGA-Verilog Keep it independent from any other outside data structures
    */
@@ -54,12 +124,37 @@ int write_fabric_verilog_template(T& openfpga_ctx, const Command& cmd,
     options.set_default_net_type(
       cmd_context.option_value(cmd, opt_default_net_type));
   }
+  options.set_compress_instance_arrays(
+    cmd_context.option_enable(cmd, opt_compress_instance_arrays));
+  options.set_keep_unchanged_files(
+    cmd_context.option_enable(cmd, opt_keep_unchanged_files));
+  options.set_pack_netlists(cmd_context.option_enable(cmd, opt_pack_netlists));
+  options.set_packed_netlist_size(size_t(packed_netlist_size));
+  options.set_behavioral_muxes(
+    cmd_context.option_enable(cmd, opt_behavioral_muxes));
+  options.set_skip_unused_modules(
+    cmd_context.option_enable(cmd, opt_skip_unused_modules));
+  options.set_two_state(cmd_context.option_enable(cmd, opt_two_state));
+  if (true == cmd_context.option_enable(cmd, opt_submodule_library)) {
+    options.set_submodule_library(
+      cmd_context.option_value(cmd, opt_submodule_library));
+    /* Time stamps make the same netlists different from run to run */
+    if (true == options.time_stamp()) {
+      VTR_LOG_WARN(
+        "Submodule netlists with time stamps are never reused from the "
+        "library. Suggest to use option '--%s'\n",
+        cmd.option_name(opt_no_time_stamp).c_str());
+    }
+  }
+  options.set_num_threads(num_threads);
+  options.set_partition(size_t(partition), size_t(num_partitions));
   options.set_verbose_output(cmd_context.option_enable(cmd, opt_verbose));
   options.set_compress_routing(openfpga_ctx.flow_manager().compress_routing());
 
   return fpga_fabric_verilog(
     openfpga_ctx.mutable_module_graph(),
     openfpga_ctx.mutable_verilog_netlists(),
+    openfpga_ctx.mutable_verilog_wire_layout(),
     openfpga_ctx.blwl_shift_register_banks(), openfpga_ctx.arch().circuit_lib,
     openfpga_ctx.mux_lib(), openfpga_ctx.decoder_lib(), g_vpr_ctx.device(),
     openfpga_ctx.vpr_device_annotation(), openfpga_ctx.device_rr_gsb(),
@@ -82,6 +177,7 @@ int write_full_testbench_template(const T& openfpga_ctx, const Command& cmd,
   CommandOptionId opt_reference_benchmark =
     cmd.option("reference_benchmark_file_path");
   CommandOptionId opt_fast_configuration = cmd.option("fast_configuration");
+  CommandOptionId opt_hex_bitstream = cmd.option("hex_bitstream");
   CommandOptionId opt_explicit_port_mapping =
     cmd.option("explicit_port_mapping");
   CommandOptionId opt_default_net_type = cmd.option("default_net_type");
@@ -101,6 +197,7 @@ int write_full_testbench_template(const T& openfpga_ctx, const Command& cmd,
     cmd_context.option_value(cmd, opt_reference_benchmark));
   options.set_fast_configuration(
     cmd_context.option_enable(cmd, opt_fast_configuration));
+  options.set_hex_bitstream(cmd_context.option_enable(cmd, opt_hex_bitstream));
   options.set_explicit_port_mapping(
     cmd_context.option_enable(cmd, opt_explicit_port_mapping));
   options.set_verbose_output(cmd_context.option_enable(cmd, opt_verbose));
@@ -168,9 +265,31 @@ int write_preconfigured_fabric_wrapper_template(
   CommandOptionId opt_default_net_type = cmd.option("default_net_type");
   CommandOptionId opt_include_signal_init = cmd.option("include_signal_init");
   CommandOptionId opt_embed_bitstream = cmd.option("embed_bitstream");
+  CommandOptionId opt_embed_bitstream_memory =
+    cmd.option("embed_bitstream_memory");
+  CommandOptionId opt_shared_bitstream_loader =
+    cmd.option("shared_bitstream_loader");
+  CommandOptionId opt_threads = cmd.option("threads");
   CommandOptionId opt_no_time_stamp = cmd.option("no_time_stamp");
   CommandOptionId opt_verbose = cmd.option("verbose");
 
+  /* The loader reads a bitstream memory file */
+  if ((true == cmd_context.option_enable(cmd, opt_shared_bitstream_loader)) &&
+      (false == cmd_context.option_enable(cmd, opt_embed_bitstream_memory))) {
+    VTR_LOG_ERROR("Option '--%s' requires option '--%s'!\n",
+                  cmd.option_name(opt_shared_bitstream_loader).c_str(),
+                  cmd.option_name(opt_embed_bitstream_memory).c_str());
+    return CMD_EXEC_FATAL_ERROR;
+  }
+
+  /* Default to be single-thread */
+  size_t num_threads = 1;
+  if ((true == cmd_context.option_enable(cmd, opt_threads)) &&
+      (false == parse_num_threads(cmd_context.option_value(cmd, opt_threads),
+                                  num_threads))) {
+    return CMD_EXEC_FATAL_ERROR;
+  }
+
   /* This is an intermediate data structure which is designed to modularize the
    * FPGA-Verilog Keep it independent from any other outside data structures
    */
@@ -199,6 +318,11 @@ int write_preconfigured_fabric_wrapper_template(
     options.set_embedded_bitstream_hdl_type(
       cmd_context.option_value(cmd, opt_embed_bitstream));
   }
+  options.set_embed_bitstream_memory(
+    cmd_context.option_enable(cmd, opt_embed_bitstream_memory));
+  options.set_shared_bitstream_loader(
+    cmd_context.option_enable(cmd, opt_shared_bitstream_loader));
+  options.set_num_threads(num_threads);
 
   /* If pin constraints are enabled by command options, read the file */
   PinConstraints pin_constraints;
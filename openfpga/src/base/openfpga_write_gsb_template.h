@@ -7,6 +7,7 @@
 #include "command_context.h"
 #include "command_exit_codes.h"
 #include "globals.h"
+#include "openfpga_parallel.h"
 #include "vtr_log.h"
 #include "vtr_time.h"
 #include "write_xml_device_rr_gsb.h"
@@ -33,8 +34,18 @@ int write_gsb_template(const T& openfpga_ctx, const Command& cmd,
   CommandOptionId opt_exclude_rr_info = cmd.option("exclude_rr_info");
   CommandOptionId opt_exclude = cmd.option("exclude");
   CommandOptionId opt_gsb_names = cmd.option("gsb_names");
+  CommandOptionId opt_single_file = cmd.option("single_file");
+  CommandOptionId opt_threads = cmd.option("threads");
   CommandOptionId opt_verbose = cmd.option("verbose");
 
+  /* Default to be single-thread */
+  size_t num_threads = 1;
+  if ((true == cmd_context.option_enable(cmd, opt_threads)) &&
+      (false == parse_num_threads(cmd_context.option_value(cmd, opt_threads),
+                                  num_threads))) {
+    return CMD_EXEC_FATAL_ERROR;
+  }
+
   /* Build the options for the writer */
   RRGSBWriterOption options;
   options.set_output_directory(cmd_context.option_value(cmd, opt_file));
@@ -43,6 +54,8 @@ int write_gsb_template(const T& openfpga_ctx, const Command& cmd,
     cmd_context.option_enable(cmd, opt_exclude_rr_info));
   options.set_exclude_content(cmd_context.option_value(cmd, opt_exclude));
   options.set_include_gsb_names(cmd_context.option_value(cmd, opt_gsb_names));
+  options.set_single_file(cmd_context.option_enable(cmd, opt_single_file));
+  options.set_num_threads(num_threads);
   options.set_verbose_output(cmd_context.option_enable(cmd, opt_verbose));
 
   if (!options.valid()) {
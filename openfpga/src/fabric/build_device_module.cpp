@@ -23,6 +23,7 @@
 #include "build_wire_modules.h"
 #include "command_exit_codes.h"
 #include "openfpga_naming.h"
+#include "openfpga_trace.h"
 #include "rename_modules.h"
 
 /* begin namespace openfpga */
@@ -40,8 +41,11 @@ int build_device_module_graph(
   const bool& compress_routing, const bool& duplicate_grid_pin,
   const FabricKey& fabric_key, const TileConfig& tile_config,
   const bool& group_config_block, const bool& name_module_using_index,
-  const bool& generate_random_fabric_key, const bool& verbose) {
+  const bool& generate_random_fabric_key,
+  const size_t& random_fabric_key_seed, const size_t& num_threads,
+  const bool& verbose) {
   vtr::ScopedStartFinishTimer timer("Build fabric module graph");
+  TraceScope trace_scope("build_device_module_graph");
 
   int status = CMD_EXEC_SUCCESS;
 
@@ -69,10 +73,11 @@ int build_device_module_graph(
 
   /* Build multiplexer modules */
   build_mux_modules(module_manager, openfpga_ctx.mux_lib(),
-                    openfpga_ctx.arch().circuit_lib);
+                    openfpga_ctx.arch().circuit_lib, num_threads);
 
   /* Build LUT modules */
-  build_lut_modules(module_manager, openfpga_ctx.arch().circuit_lib);
+  build_lut_modules(module_manager, openfpga_ctx.arch().circuit_lib,
+                    num_threads);
 
   /* Build wire modules */
   build_wire_modules(module_manager, openfpga_ctx.arch().circuit_lib);
@@ -81,7 +86,7 @@ int build_device_module_graph(
   build_memory_modules(module_manager, decoder_lib, openfpga_ctx.mux_lib(),
                        openfpga_ctx.arch().circuit_lib,
                        openfpga_ctx.arch().config_protocol.type(),
-                       group_config_block, verbose);
+                       group_config_block, num_threads, verbose);
 
   /* Build grid and programmable block modules */
   status = build_grid_modules(
@@ -89,7 +94,7 @@ int build_device_module_graph(
     openfpga_ctx.vpr_device_annotation(), openfpga_ctx.arch().circuit_lib,
     openfpga_ctx.mux_lib(), openfpga_ctx.arch().tile_annotations,
     openfpga_ctx.arch().config_protocol.type(), sram_model, duplicate_grid_pin,
-    group_config_block, verbose);
+    group_config_block, num_threads, verbose);
   if (CMD_EXEC_FATAL_ERROR == status) {
     return status;
   }
@@ -100,7 +105,8 @@ int build_device_module_graph(
                                  openfpga_ctx.device_rr_gsb(),
                                  openfpga_ctx.arch().circuit_lib,
                                  openfpga_ctx.arch().config_protocol.type(),
-                                 sram_model, group_config_block, verbose);
+                                 sram_model, group_config_block, num_threads,
+                                 verbose);
   } else {
     VTR_ASSERT_SAFE(false == compress_routing);
     build_flatten_routing_modules(module_manager, decoder_lib, vpr_device_ctx,
@@ -116,7 +122,8 @@ int build_device_module_graph(
     /* Build detailed tile-level information */
     status = build_fabric_tile(fabric_tile, tile_config, vpr_device_ctx.grid,
                                vpr_device_ctx.rr_graph,
-                               openfpga_ctx.device_rr_gsb(), verbose);
+                               openfpga_ctx.device_rr_gsb(), num_threads,
+                               verbose);
     if (CMD_EXEC_FATAL_ERROR == status) {
       return status;
     }
@@ -130,6 +137,12 @@ int build_device_module_graph(
       name_module_using_index, frame_view, verbose);
   }
 
+  /* All the modules except the top-level one are finalized. Compress their
+   * nets to release memory before building the largest module */
+  for (const ModuleId& module : module_manager.modules()) {
+    module_manager.compress_module_nets(module);
+  }
+
   /* Build FPGA fabric top-level module */
   status = build_top_module(
     module_manager, decoder_lib, blwl_sr_banks, openfpga_ctx.arch().circuit_lib,
@@ -140,7 +153,8 @@ int build_device_module_graph(
     openfpga_ctx.arch().arch_direct, openfpga_ctx.arch().config_protocol,
     sram_model, fabric_tile, name_module_using_index, frame_view,
     compress_routing, duplicate_grid_pin, fabric_key,
-    generate_random_fabric_key, group_config_block, verbose);
+    generate_random_fabric_key, random_fabric_key_seed, group_config_block,
+    num_threads, verbose);
 
   if (CMD_EXEC_FATAL_ERROR == status) {
     return status;
@@ -176,6 +190,16 @@ int build_device_module_graph(
     }
   }
 
+  /* Compress the nets of the modules created by the top-level builder */
+  size_t num_nets = 0;
+  for (const ModuleId& module : module_manager.modules()) {
+    module_manager.compress_module_nets(module);
+    num_nets += module_manager.num_nets(module);
+  }
+
+  trace_counter("modules", module_manager.num_modules());
+  trace_counter("nets", num_nets);
+
   return status;
 }
 
@@ -27,7 +27,9 @@ int build_device_module_graph(
   const bool& compress_routing, const bool& duplicate_grid_pin,
   const FabricKey& fabric_key, const TileConfig& tile_config,
   const bool& group_config_block, const bool& name_module_using_index,
-  const bool& generate_random_fabric_key, const bool& verbose);
+  const bool& generate_random_fabric_key,
+  const size_t& random_fabric_key_seed, const size_t& num_threads,
+  const bool& verbose);
 
 } /* end namespace openfpga */
 
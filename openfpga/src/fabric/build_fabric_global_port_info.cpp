@@ -90,15 +90,9 @@ FabricGlobalPortInfo build_fabric_global_port_info(
       continue;
     }
     /* Avoid adding redundant ports */
-    bool already_in_list = false;
-    for (const FabricGlobalPortId& port :
-         fabric_global_port_info.global_ports()) {
-      if (module_port == fabric_global_port_info.global_module_port(port)) {
-        already_in_list = true;
-        break;
-      }
-    }
-    if (true == already_in_list) {
+    if (false ==
+        fabric_global_port_info.find_module_port_global_ports(module_port)
+          .empty()) {
       continue;
     }
     /* Add the port information */
@@ -17,6 +17,7 @@
 #include "build_fabric_tile.h"
 #include "openfpga_naming.h"
 #include "openfpga_reserved_words.h"
+#include "openfpga_trace.h"
 
 /* begin namespace openfpga */
 namespace openfpga {
@@ -140,9 +141,11 @@ static int build_fabric_tile_style_top_left(FabricTile& fabric_tile,
  *******************************************************************/
 int build_fabric_tile(FabricTile& fabric_tile, const TileConfig& tile_config,
                       const DeviceGrid& grids, const RRGraphView& rr_graph,
-                      const DeviceRRGSB& device_rr_gsb, const bool& verbose) {
+                      const DeviceRRGSB& device_rr_gsb,
+                      const size_t& num_threads, const bool& verbose) {
   vtr::ScopedStartFinishTimer timer(
     "Build tile-level information for the FPGA fabric");
+  TraceScope trace_scope("build_fabric_tile");
 
   int status_code = CMD_EXEC_SUCCESS;
 
@@ -165,7 +168,8 @@ int build_fabric_tile(FabricTile& fabric_tile, const TileConfig& tile_config,
 
   /* Build unique tiles to compress the number of tile modules to be built in
    * later steps */
-  status_code = fabric_tile.build_unique_tiles(grids, device_rr_gsb, verbose);
+  status_code = fabric_tile.build_unique_tiles(grids, device_rr_gsb,
+                                               num_threads, verbose);
   VTR_LOGV(verbose, "Extracted %lu uniques tiles from the FPGA fabric\n",
            fabric_tile.unique_tiles().size());
 
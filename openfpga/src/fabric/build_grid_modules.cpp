@@ -17,12 +17,15 @@
 #include "build_grid_module_utils.h"
 #include "build_grid_modules.h"
 #include "build_memory_modules.h"
+#include "build_module_staging.h"
 #include "circuit_library_utils.h"
 #include "module_manager_utils.h"
 #include "openfpga_interconnect_types.h"
 #include "openfpga_naming.h"
+#include "openfpga_parallel.h"
 #include "openfpga_physical_tile_utils.h"
 #include "openfpga_reserved_words.h"
+#include "openfpga_trace.h"
 #include "pb_graph_utils.h"
 #include "pb_type_utils.h"
 #include "vpr_utils.h"
@@ -1353,6 +1356,14 @@ static int build_physical_tile_module(
   return status;
 }
 
+/*****************************************************************************
+ * A physical tile module to be built, with the border side of I/O blocks
+ ****************************************************************************/
+struct PhysicalTileModuleTask {
+  t_physical_tile_type_ptr physical_tile;
+  e_side border_side;
+};
+
 /*****************************************************************************
  * Create logic block modules in a compact way
  * This function will achieve this goal in two step:
@@ -1365,6 +1376,10 @@ static int build_physical_tile_module(
  *   - Only one module for each I/O on each border side (IO_TYPE)
  *   - Only one module for each CLB (FILL_TYPE)
  *   - Only one module for each heterogeneous block
+ *
+ * When more than 1 thread is required, the logical tiles and then the
+ * physical tiles are built in parallel, see build_modules_with_staging().
+ * The resulting module graph is the same as the serial build.
  ****************************************************************************/
 int build_grid_modules(
   ModuleManager& module_manager, DecoderLibrary& decoder_lib,
@@ -1373,12 +1388,17 @@ int build_grid_modules(
   const TileAnnotation& tile_annotation,
   const e_config_protocol_type& sram_orgz_type,
   const CircuitModelId& sram_model, const bool& duplicate_grid_pin,
-  const bool& group_config_block, const bool& verbose) {
+  const bool& group_config_block, const size_t& num_threads,
+  const bool& verbose) {
+  TraceScope trace_scope("build_grid_modules");
   /* Start time count */
   vtr::ScopedStartFinishTimer timer("Build grid modules");
 
   int status = CMD_EXEC_SUCCESS;
 
+  /* Verbose outputs of the threads would be interleaved */
+  bool task_verbose = verbose && (1 == find_num_threads(num_threads));
+
   /* Enumerate the types of logical tiles, and build a module for each
    * Build modules for all the pb_types/pb_graph_nodes
    * use a Depth-First Search Algorithm to print the sub-modules
@@ -1390,16 +1410,29 @@ int build_grid_modules(
    * traverse the graph in a recursive way */
   VTR_LOG("Building logical tiles...");
   VTR_LOGV(verbose, "\n");
+  std::vector<t_pb_graph_node*> logical_tile_pb_graph_heads;
   for (const t_logical_block_type& logical_tile :
        device_ctx.logical_block_types) {
     /* Bypass empty pb_graph */
     if (nullptr == logical_tile.pb_graph_head) {
       continue;
     }
-    rec_build_logical_tile_modules(
-      module_manager, decoder_lib, device_annotation, circuit_lib, mux_lib,
-      sram_orgz_type, sram_model, logical_tile.pb_graph_head,
-      group_config_block, verbose);
+    logical_tile_pb_graph_heads.push_back(logical_tile.pb_graph_head);
+  }
+  status = build_modules_with_staging(
+    module_manager, decoder_lib, logical_tile_pb_graph_heads.size(),
+    num_threads,
+    [&](ModuleManager& task_module_manager, DecoderLibrary& task_decoder_lib,
+        const size_t& itask) {
+      rec_build_logical_tile_modules(
+        task_module_manager, task_decoder_lib, device_annotation, circuit_lib,
+        mux_lib, sram_orgz_type, sram_model,
+        logical_tile_pb_graph_heads[itask], group_config_block, task_verbose);
+      return CMD_EXEC_SUCCESS;
+    },
+    verbose);
+  if (status != CMD_EXEC_SUCCESS) {
+    return CMD_EXEC_FATAL_ERROR;
   }
   VTR_LOG("Done\n");
 
@@ -1408,6 +1441,7 @@ int build_grid_modules(
    */
   VTR_LOG("Building physical tiles...");
   VTR_LOGV(verbose, "\n");
+  std::vector<PhysicalTileModuleTask> physical_tile_tasks;
   for (const t_physical_tile_type& physical_tile :
        device_ctx.physical_tile_types) {
     /* Bypass empty type or nullptr */
@@ -1426,25 +1460,28 @@ int build_grid_modules(
       std::set<e_side> io_type_sides =
         find_physical_io_tile_located_sides(device_ctx.grid, &physical_tile);
       for (const e_side& io_type_side : io_type_sides) {
-        status = build_physical_tile_module(
-          module_manager, decoder_lib, device_annotation, circuit_lib,
-          sram_orgz_type, sram_model, &physical_tile, tile_annotation,
-          io_type_side, duplicate_grid_pin, group_config_block, verbose);
-        if (status != CMD_EXEC_SUCCESS) {
-          return CMD_EXEC_FATAL_ERROR;
-        }
+        physical_tile_tasks.push_back({&physical_tile, io_type_side});
       }
     } else {
       /* For CLB and heterogenenous blocks */
-      status = build_physical_tile_module(
-        module_manager, decoder_lib, device_annotation, circuit_lib,
-        sram_orgz_type, sram_model, &physical_tile, tile_annotation, NUM_SIDES,
-        duplicate_grid_pin, group_config_block, verbose);
-      if (status != CMD_EXEC_SUCCESS) {
-        return CMD_EXEC_FATAL_ERROR;
-      }
+      physical_tile_tasks.push_back({&physical_tile, NUM_SIDES});
     }
   }
+  status = build_modules_with_staging(
+    module_manager, decoder_lib, physical_tile_tasks.size(), num_threads,
+    [&](ModuleManager& task_module_manager, DecoderLibrary& task_decoder_lib,
+        const size_t& itask) {
+      const PhysicalTileModuleTask& task = physical_tile_tasks[itask];
+      return build_physical_tile_module(
+        task_module_manager, task_decoder_lib, device_annotation, circuit_lib,
+        sram_orgz_type, sram_model, task.physical_tile, tile_annotation,
+        task.border_side, duplicate_grid_pin, group_config_block,
+        task_verbose);
+    },
+    verbose);
+  if (status != CMD_EXEC_SUCCESS) {
+    return CMD_EXEC_FATAL_ERROR;
+  }
   VTR_LOG("Done\n");
 
   return status;
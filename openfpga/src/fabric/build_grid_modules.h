@@ -25,7 +25,8 @@ int build_grid_modules(
   const TileAnnotation& tile_annotation,
   const e_config_protocol_type& sram_orgz_type,
   const CircuitModelId& sram_model, const bool& duplicate_grid_pin,
-  const bool& group_config_block, const bool& verbose);
+  const bool& group_config_block, const size_t& num_threads,
+  const bool& verbose);
 
 } /* end namespace openfpga */
 
@@ -8,7 +8,9 @@
 /* Headers from vtrutil library */
 #include "build_lut_modules.h"
 #include "build_module_graph_utils.h"
+#include "build_module_staging.h"
 #include "circuit_library_utils.h"
+#include "command_exit_codes.h"
 #include "module_manager.h"
 #include "module_manager_utils.h"
 #include "openfpga_naming.h"
@@ -99,6 +101,8 @@ static void build_lut_module(ModuleManager& module_manager,
 
   /* Label module usage */
   module_manager.set_module_usage(lut_module, ModuleManager::MODULE_LUT);
+  module_manager.set_module_circuit_model(lut_module,
+                                          circuit_lib.model_name(lut_model));
 
   /* Add module ports */
   /* Add each global port */
@@ -505,12 +509,17 @@ static void build_lut_module(ModuleManager& module_manager,
 /********************************************************************
  * Print Verilog modules for the Look-Up Tables (LUTs)
  * in the circuit library
+ * Each LUT is built by an independent task, which can run in parallel
+ * on a staging module graph. Modules are committed in the order of the
+ * circuit models, which is the same order as the serial build
  ********************************************************************/
 void build_lut_modules(ModuleManager& module_manager,
-                       const CircuitLibrary& circuit_lib) {
+                       const CircuitLibrary& circuit_lib,
+                       const size_t& num_threads) {
   vtr::ScopedStartFinishTimer timer("Build Look-Up Table (LUT) modules");
 
   /* Search for each LUT circuit model */
+  std::vector<CircuitModelId> lut_models;
   for (const auto& lut_model : circuit_lib.models()) {
     /* Bypas non-LUT modules */
     if (CIRCUIT_MODEL_LUT != circuit_lib.model_type(lut_model)) {
@@ -521,8 +530,19 @@ void build_lut_modules(ModuleManager& module_manager,
         (false == circuit_lib.model_spice_netlist(lut_model).empty())) {
       continue;
     }
-    build_lut_module(module_manager, circuit_lib, lut_model);
+    lut_models.push_back(lut_model);
   }
+
+  /* LUT modules do not require any decoder */
+  DecoderLibrary decoder_lib;
+  build_modules_with_staging(
+    module_manager, decoder_lib, lut_models.size(), num_threads,
+    [&](ModuleManager& staging_module_manager, DecoderLibrary&,
+        const size_t& ilut) {
+      build_lut_module(staging_module_manager, circuit_lib, lut_models[ilut]);
+      return CMD_EXEC_SUCCESS;
+    },
+    false);
 }
 
 } /* end namespace openfpga */
@@ -15,7 +15,8 @@
 namespace openfpga {
 
 void build_lut_modules(ModuleManager& module_manager,
-                       const CircuitLibrary& circuit_lib);
+                       const CircuitLibrary& circuit_lib,
+                       const size_t& num_threads);
 
 } /* end namespace openfpga */
 
@@ -9,8 +9,10 @@
 #include <ctime>
 #include <map>
 #include <string>
+#include <vector>
 
 #include "build_decoder_modules.h"
+#include "build_module_staging.h"
 #include "circuit_library_utils.h"
 #include "command_exit_codes.h"
 #include "decoder_library_utils.h"
@@ -19,8 +21,10 @@
 #include "module_manager_utils.h"
 #include "mux_graph.h"
 #include "mux_utils.h"
+#include "openfpga_parallel.h"
 #include "openfpga_naming.h"
 #include "openfpga_reserved_words.h"
+#include "openfpga_trace.h"
 #include "vtr_assert.h"
 #include "vtr_log.h"
 #include "vtr_time.h"
@@ -461,6 +465,8 @@ static void build_memory_flatten_module(ModuleManager& module_manager,
 
   /* Label module usage */
   module_manager.set_module_usage(mem_module, ModuleManager::MODULE_CONFIG);
+  module_manager.set_module_circuit_model(mem_module,
+                                          circuit_lib.model_name(sram_model));
 
   /* Add module ports */
   /* Input: BL port */
@@ -577,6 +583,8 @@ static void build_memory_chain_module(ModuleManager& module_manager,
 
   /* Label module usage */
   module_manager.set_module_usage(mem_module, ModuleManager::MODULE_CONFIG);
+  module_manager.set_module_circuit_model(mem_module,
+                                          circuit_lib.model_name(sram_model));
 
   /* Add an input port, which is the head of configuration chain in the module
    */
@@ -766,6 +774,8 @@ static void build_frame_memory_module(ModuleManager& module_manager,
 
   /* Label module usage */
   module_manager.set_module_usage(mem_module, ModuleManager::MODULE_CONFIG);
+  module_manager.set_module_circuit_model(mem_module,
+                                          circuit_lib.model_name(sram_model));
 
   /* Find the specification of the decoder:
    * Size of address port and data input
@@ -1154,6 +1164,85 @@ static int build_mux_feedthrough_memory_module(
   return status;
 }
 
+/*********************************************************************
+ * A task to build the memory modules of either a multiplexer or another
+ * circuit model. The multiplexer is invalid for other circuit models
+ ********************************************************************/
+struct MemoryModuleTask {
+  MuxId mux;
+  CircuitModelId model;
+};
+
+/*********************************************************************
+ * Build the memory module, as well as the feedthrough memory module if
+ * required, for a multiplexer
+ ********************************************************************/
+static int build_mux_memory_modules(
+  ModuleManager& module_manager, DecoderLibrary& arch_decoder_lib,
+  const CircuitLibrary& circuit_lib,
+  const e_config_protocol_type& sram_orgz_type, const CircuitModelId& mux_model,
+  const MuxGraph& mux_graph, const bool& require_feedthrough_memory,
+  const bool& verbose) {
+  /* Create a Verilog module for the memories used by the multiplexer */
+  build_mux_memory_module(module_manager, arch_decoder_lib, circuit_lib,
+                          sram_orgz_type, mux_model, mux_graph, verbose);
+  /* Create feedthrough memory module */
+  if (require_feedthrough_memory) {
+    int status = build_mux_feedthrough_memory_module(
+      module_manager, circuit_lib, sram_orgz_type, mux_model, mux_graph,
+      verbose);
+    if (status != CMD_EXEC_SUCCESS) {
+      return CMD_EXEC_FATAL_ERROR;
+    }
+  }
+  return CMD_EXEC_SUCCESS;
+}
+
+/*********************************************************************
+ * Build the memory module, as well as the feedthrough memory module if
+ * required, for the mode-select ports of a non-MUX circuit model
+ ********************************************************************/
+static int build_circuit_model_memory_modules(
+  ModuleManager& module_manager, DecoderLibrary& arch_decoder_lib,
+  const CircuitLibrary& circuit_lib,
+  const e_config_protocol_type& sram_orgz_type, const CircuitModelId& model,
+  const bool& require_feedthrough_memory, const bool& verbose) {
+  std::vector<CircuitPortId> sram_ports =
+    circuit_lib.model_ports_by_type(model, CIRCUIT_MODEL_PORT_SRAM, true);
+  /* Find the name of memory module */
+  /* Get the total number of SRAMs */
+  size_t num_mems = 0;
+  for (const auto& port : sram_ports) {
+    num_mems += circuit_lib.port_size(port);
+  }
+  /* Get the circuit model for the memory circuit used by the multiplexer */
+  std::vector<CircuitModelId> sram_models =
+    find_circuit_sram_models(circuit_lib, model);
+  /* Should have only 1 SRAM model */
+  VTR_ASSERT(1 == sram_models.size());
+
+  /* Create the module name for the memory block */
+  std::string module_name = generate_memory_module_name(
+    circuit_lib, model, sram_models[0], std::string(MEMORY_MODULE_POSTFIX));
+
+  /* Create a Verilog module for the memories used by the circuit model */
+  build_memory_module(module_manager, arch_decoder_lib, circuit_lib,
+                      sram_orgz_type, module_name, sram_models[0], num_mems,
+                      verbose);
+  /* Create feedthrough memory module */
+  if (require_feedthrough_memory) {
+    module_name =
+      generate_memory_module_name(circuit_lib, model, sram_models[0],
+                                  std::string(MEMORY_MODULE_POSTFIX), true);
+    int status = build_feedthrough_memory_module(module_manager, module_name,
+                                                 num_mems, verbose);
+    if (status != CMD_EXEC_SUCCESS) {
+      return CMD_EXEC_FATAL_ERROR;
+    }
+  }
+  return CMD_EXEC_SUCCESS;
+}
+
 /*********************************************************************
  * Build modules for
  * the memories that are affiliated to multiplexers and other programmable
@@ -1178,13 +1267,13 @@ int build_memory_modules(ModuleManager& module_manager,
                          const CircuitLibrary& circuit_lib,
                          const e_config_protocol_type& sram_orgz_type,
                          const bool& require_feedthrough_memory,
-                         const bool& verbose) {
-  int status = CMD_EXEC_SUCCESS;
+                         const size_t& num_threads, const bool& verbose) {
+  TraceScope trace_scope("build_memory_modules");
   vtr::ScopedStartFinishTimer timer("Build memory modules");
 
   /* Create the memory circuits for the multiplexer */
+  std::vector<MemoryModuleTask> tasks;
   for (auto mux : mux_lib.muxes()) {
-    const MuxGraph& mux_graph = mux_lib.mux_graph(mux);
     CircuitModelId mux_model = mux_lib.mux_circuit_model(mux);
     /* Bypass the non-MUX circuit models (i.e., LUTs).
      * They should be handled in a different way
@@ -1193,18 +1282,7 @@ int build_memory_modules(ModuleManager& module_manager,
     if (CIRCUIT_MODEL_MUX != circuit_lib.model_type(mux_model)) {
       continue;
     }
-    /* Create a Verilog module for the memories used by the multiplexer */
-    build_mux_memory_module(module_manager, arch_decoder_lib, circuit_lib,
-                            sram_orgz_type, mux_model, mux_graph, verbose);
-    /* Create feedthrough memory module */
-    if (require_feedthrough_memory) {
-      status = build_mux_feedthrough_memory_module(module_manager, circuit_lib,
-                                                   sram_orgz_type, mux_model,
-                                                   mux_graph, verbose);
-      if (status != CMD_EXEC_SUCCESS) {
-        return CMD_EXEC_FATAL_ERROR;
-      }
-    }
+    tasks.push_back({mux, mux_model});
   }
 
   /* Create the memory circuits for non-MUX circuit models.
@@ -1217,44 +1295,35 @@ int build_memory_modules(ModuleManager& module_manager,
       continue;
     }
     /* Bypass those modules without any SRAM ports */
-    std::vector<CircuitPortId> sram_ports =
-      circuit_lib.model_ports_by_type(model, CIRCUIT_MODEL_PORT_SRAM, true);
-    if (0 == sram_ports.size()) {
+    if (0 == circuit_lib
+               .model_ports_by_type(model, CIRCUIT_MODEL_PORT_SRAM, true)
+               .size()) {
       continue;
     }
-    /* Find the name of memory module */
-    /* Get the total number of SRAMs */
-    size_t num_mems = 0;
-    for (const auto& port : sram_ports) {
-      num_mems += circuit_lib.port_size(port);
-    }
-    /* Get the circuit model for the memory circuit used by the multiplexer */
-    std::vector<CircuitModelId> sram_models =
-      find_circuit_sram_models(circuit_lib, model);
-    /* Should have only 1 SRAM model */
-    VTR_ASSERT(1 == sram_models.size());
-
-    /* Create the module name for the memory block */
-    std::string module_name = generate_memory_module_name(
-      circuit_lib, model, sram_models[0], std::string(MEMORY_MODULE_POSTFIX));
-
-    /* Create a Verilog module for the memories used by the circuit model */
-    build_memory_module(module_manager, arch_decoder_lib, circuit_lib,
-                        sram_orgz_type, module_name, sram_models[0], num_mems,
-                        verbose);
-    /* Create feedthrough memory module */
-    if (require_feedthrough_memory) {
-      module_name =
-        generate_memory_module_name(circuit_lib, model, sram_models[0],
-                                    std::string(MEMORY_MODULE_POSTFIX), true);
-      status = build_feedthrough_memory_module(module_manager, module_name,
-                                               num_mems, verbose);
-      if (status != CMD_EXEC_SUCCESS) {
-        return CMD_EXEC_FATAL_ERROR;
-      }
-    }
+    tasks.push_back({MuxId::INVALID(), model});
   }
-  return status;
+
+  /* Each memory module is built by an independent task, which can run in
+   * parallel on a staging module graph. Modules are committed in the order
+   * of the tasks, i.e., multiplexers by MuxId and then the other circuit
+   * models, which is the same order as the serial build */
+  bool task_verbose = verbose && (1 == find_num_threads(num_threads));
+  return build_modules_with_staging(
+    module_manager, arch_decoder_lib, tasks.size(), num_threads,
+    [&](ModuleManager& staging_module_manager,
+        DecoderLibrary& staging_decoder_lib, const size_t& itask) {
+      const MemoryModuleTask& task = tasks[itask];
+      if (MuxId::INVALID() != task.mux) {
+        return build_mux_memory_modules(
+          staging_module_manager, staging_decoder_lib, circuit_lib,
+          sram_orgz_type, task.model, mux_lib.mux_graph(task.mux),
+          require_feedthrough_memory, task_verbose);
+      }
+      return build_circuit_model_memory_modules(
+        staging_module_manager, staging_decoder_lib, circuit_lib,
+        sram_orgz_type, task.model, require_feedthrough_memory, task_verbose);
+    },
+    verbose);
 }
 
 /*********************************************************************
@@ -0,0 +1,158 @@
+/********************************************************************
+ * This file includes functions to build independent modules with
+ * multiple threads, where each thread builds modules into its own
+ * staging module graph
+ *******************************************************************/
+#include <memory>
+#include <vector>
+
+/* Headers from vtrutil library */
+#include "vtr_assert.h"
+#include "vtr_log.h"
+#include "vtr_vector.h"
+
+/* Headers from openfpgautil library */
+#include "build_module_staging.h"
+#include "command_exit_codes.h"
+#include "openfpga_parallel.h"
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+/********************************************************************
+ * A staging database owned by a thread when building modules
+ * in parallel. It includes
+ * - a module manager with the interfaces of the modules built before,
+ *   i.e., without any net, under the same module ids as the final module
+ *   manager. New modules are built there without any locking
+ * - a copy of the decoder library, which only includes a few numbers
+ *   per decoder
+ * - the translation from the module ids of the staging module manager
+ *   to the module ids of the final module manager
+ *******************************************************************/
+struct ModuleStaging {
+  ModuleManager module_manager;
+  DecoderLibrary decoder_lib;
+  vtr::vector<ModuleId, ModuleId> module_map;
+};
+
+/********************************************************************
+ * The range of modules and decoders a task has created in a staging
+ * database
+ *******************************************************************/
+struct ModuleStagingTaskResult {
+  int status;
+  size_t staging_id;
+  size_t module_begin;
+  size_t module_end;
+  size_t decoder_begin;
+  size_t decoder_end;
+};
+
+/********************************************************************
+ * Build modules with multiple threads, by running each task once
+ * Each thread builds modules in its own staging database, which starts
+ * from the interfaces of the modules and the decoder library before any
+ * task is run. The nets of these modules are never copied, as the tasks
+ * only instantiate them.
+ * Afterwards, the new modules and decoders are committed to the
+ * final databases in the order of the tasks, which is the same order
+ * as the serial build.
+ * Shared modules (e.g., the decoders of frame-based memories) may be
+ * created in several staging databases. Only the first one in the
+ * commit order is kept, so that module ids remain the same as when a
+ * single thread is used.
+ * With a single thread, the tasks are run on the final databases directly
+ *******************************************************************/
+int build_modules_with_staging(ModuleManager& module_manager,
+                               DecoderLibrary& decoder_lib,
+                               const size_t& num_tasks,
+                               const size_t& num_threads,
+                               const module_staging_task& build_task,
+                               const bool& verbose) {
+  if (1 == find_num_threads(num_threads)) {
+    for (size_t itask = 0; itask < num_tasks; ++itask) {
+      if (CMD_EXEC_SUCCESS != build_task(module_manager, decoder_lib, itask)) {
+        return CMD_EXEC_FATAL_ERROR;
+      }
+    }
+    return CMD_EXEC_SUCCESS;
+  }
+
+  /* Build modules into staging databases. Stagings are created on demand,
+   * as some threads may not get any task */
+  std::vector<ModuleStagingTaskResult> results(num_tasks);
+  std::vector<std::unique_ptr<ModuleStaging>> stagings(
+    find_num_threads(num_threads));
+  const ModuleManager& base_module_manager = module_manager;
+  const DecoderLibrary& base_decoder_lib = decoder_lib;
+  parallel_for_with_thread_id(
+    num_tasks, num_threads, [&](const size_t& itask, const size_t& thread_id) {
+      std::unique_ptr<ModuleStaging>& staging = stagings[thread_id];
+      if (nullptr == staging) {
+        staging.reset(new ModuleStaging());
+        staging->module_manager = base_module_manager.interface_copy();
+        staging->decoder_lib = base_decoder_lib;
+        /* Modules built before are shared by all the databases */
+        for (const ModuleId& module : base_module_manager.modules()) {
+          staging->module_map.push_back(module);
+        }
+      }
+
+      ModuleStagingTaskResult& result = results[itask];
+      result.staging_id = thread_id;
+      result.module_begin = staging->module_manager.num_modules();
+      result.decoder_begin = staging->decoder_lib.decoders().size();
+      result.status =
+        build_task(staging->module_manager, staging->decoder_lib, itask);
+      result.module_end = staging->module_manager.num_modules();
+      result.decoder_end = staging->decoder_lib.decoders().size();
+    });
+
+  for (const ModuleStagingTaskResult& result : results) {
+    if (CMD_EXEC_SUCCESS != result.status) {
+      return CMD_EXEC_FATAL_ERROR;
+    }
+  }
+
+  /* Commit the staging results in a fixed order. Each thread processes its
+   * tasks in ascending order, so the modules of a staging database are
+   * committed in the order they were created */
+  for (const ModuleStagingTaskResult& result : results) {
+    ModuleStaging& staging = *stagings[result.staging_id];
+    for (size_t idecoder = result.decoder_begin; idecoder < result.decoder_end;
+         ++idecoder) {
+      DecoderId decoder = DecoderId(idecoder);
+      const DecoderLibrary& src_lib = staging.decoder_lib;
+      DecoderId existing_decoder = decoder_lib.find_decoder(
+        src_lib.addr_size(decoder), src_lib.data_size(decoder),
+        src_lib.use_enable(decoder), src_lib.use_data_in(decoder),
+        src_lib.use_data_inv_port(decoder), src_lib.use_readback(decoder));
+      if (DecoderId::INVALID() == existing_decoder) {
+        decoder_lib.add_decoder(
+          src_lib.addr_size(decoder), src_lib.data_size(decoder),
+          src_lib.use_enable(decoder), src_lib.use_data_in(decoder),
+          src_lib.use_data_inv_port(decoder), src_lib.use_readback(decoder));
+      }
+    }
+    for (size_t imodule = result.module_begin; imodule < result.module_end;
+         ++imodule) {
+      ModuleId staging_module = ModuleId(imodule);
+      VTR_ASSERT(imodule == staging.module_map.size());
+      std::string module_name =
+        staging.module_manager.module_name(staging_module);
+      ModuleId module = module_manager.find_module(module_name);
+      if (ModuleId::INVALID() == module) {
+        VTR_LOGV(verbose, "Committing module '%s'...\n", module_name.c_str());
+        module = module_manager.import_module(
+          staging.module_manager, staging_module, staging.module_map);
+      }
+      VTR_ASSERT(true == module_manager.valid_module_id(module));
+      staging.module_map.push_back(module);
+    }
+  }
+
+  return CMD_EXEC_SUCCESS;
+}
+
+} /* end namespace openfpga */
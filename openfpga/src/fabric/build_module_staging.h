@@ -0,0 +1,33 @@
+#ifndef BUILD_MODULE_STAGING_H
+#define BUILD_MODULE_STAGING_H
+
+/********************************************************************
+ * Include header files that are required by function declaration
+ *******************************************************************/
+#include <functional>
+
+#include "decoder_library.h"
+#include "module_manager.h"
+
+/********************************************************************
+ * Function declaration
+ *******************************************************************/
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+/* A task which builds modules into the given module manager and decoder
+ * library. Return CMD_EXEC_SUCCESS if successful */
+typedef std::function<int(ModuleManager&, DecoderLibrary&, const size_t&)>
+  module_staging_task;
+
+int build_modules_with_staging(ModuleManager& module_manager,
+                               DecoderLibrary& decoder_lib,
+                               const size_t& num_tasks,
+                               const size_t& num_threads,
+                               const module_staging_task& build_task,
+                               const bool& verbose);
+
+} /* end namespace openfpga */
+
+#endif
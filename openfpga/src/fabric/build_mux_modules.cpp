@@ -7,11 +7,14 @@
  **********************************************/
 #include <algorithm>
 #include <string>
+#include <vector>
 
 /* Headers from vtrutil library */
 #include "build_module_graph_utils.h"
+#include "build_module_staging.h"
 #include "build_mux_modules.h"
 #include "circuit_library_utils.h"
+#include "command_exit_codes.h"
 #include "decoder_library_utils.h"
 #include "module_manager.h"
 #include "module_manager_utils.h"
@@ -19,6 +22,7 @@
 #include "mux_utils.h"
 #include "openfpga_naming.h"
 #include "openfpga_reserved_words.h"
+#include "openfpga_trace.h"
 #include "vtr_assert.h"
 #include "vtr_log.h"
 #include "vtr_time.h"
@@ -262,6 +266,8 @@ static void build_cmos_mux_branch_module(ModuleManager& module_manager,
    * manager */
   ModuleId mux_module = module_manager.add_module(module_name);
   VTR_ASSERT(true == module_manager.valid_module_id(mux_module));
+  module_manager.set_module_circuit_model(mux_module,
+                                          circuit_lib.model_name(mux_model));
   /* Add module ports */
   /* Add each input port */
   BasicPort input_port("in", num_inputs);
@@ -341,6 +347,8 @@ static void build_rram_mux_branch_module(ModuleManager& module_manager,
    * manager */
   ModuleId mux_module = module_manager.add_module(module_name);
   VTR_ASSERT(ModuleId::INVALID() != mux_module);
+  module_manager.set_module_circuit_model(mux_module,
+                                          circuit_lib.model_name(mux_model));
 
   /* Add module ports */
   /* Add each global programming enable/disable ports */
@@ -1406,6 +1414,8 @@ static void build_cmos_mux_module(ModuleManager& module_manager,
     VTR_ASSERT_SAFE(CIRCUIT_MODEL_LUT == circuit_lib.model_type(mux_model));
     module_manager.set_module_usage(mux_module, ModuleManager::MODULE_LUT);
   }
+  module_manager.set_module_circuit_model(mux_module,
+                                          circuit_lib.model_name(mux_model));
 
   /* Add module ports */
   /* Add each input port
@@ -1582,6 +1592,8 @@ static void build_rram_mux_module(ModuleManager& module_manager,
 
   /* Label module usage */
   module_manager.set_module_usage(module_id, ModuleManager::MODULE_INTERC);
+  module_manager.set_module_circuit_model(
+    module_id, circuit_lib.model_name(circuit_model));
 
   /* Add module ports */
   /* Add each global port */
@@ -1680,33 +1692,59 @@ static void build_mux_module(ModuleManager& module_manager,
 /***********************************************
  * Generate Verilog modules for all the unique
  * multiplexers in the FPGA device
+ * Each multiplexer is built by an independent task, which can run in
+ * parallel on a staging module graph. Modules are committed in the order
+ * of MuxId, which is the same order as the serial build
  **********************************************/
 void build_mux_modules(ModuleManager& module_manager, const MuxLibrary& mux_lib,
-                       const CircuitLibrary& circuit_lib) {
+                       const CircuitLibrary& circuit_lib,
+                       const size_t& num_threads) {
   vtr::ScopedStartFinishTimer timer("Building multiplexer modules");
+  TraceScope trace_scope("build_mux_modules");
 
-  /* Generate basis sub-circuit for unique branches shared by the multiplexers
-   */
+  std::vector<MuxId> muxes;
   for (auto mux : mux_lib.muxes()) {
-    const MuxGraph& mux_graph = mux_lib.mux_graph(mux);
-    CircuitModelId mux_circuit_model = mux_lib.mux_circuit_model(mux);
-    /* Create a mux graph for the branch circuit */
-    std::vector<MuxGraph> branch_mux_graphs =
-      mux_graph.build_mux_branch_graphs();
-    /* Create branch circuits, which are N:1 one-level or 2:1 tree-like MUXes */
-    for (auto branch_mux_graph : branch_mux_graphs) {
-      build_mux_branch_module(module_manager, circuit_lib, mux_circuit_model,
-                              branch_mux_graph);
-    }
+    muxes.push_back(mux);
   }
 
+  /* Multiplexer modules do not require any decoder */
+  DecoderLibrary decoder_lib;
+
+  /* Generate basis sub-circuit for unique branches shared by the multiplexers
+   * Branches shared by several multiplexers are kept only once
+   */
+  build_modules_with_staging(
+    module_manager, decoder_lib, muxes.size(), num_threads,
+    [&](ModuleManager& staging_module_manager, DecoderLibrary&,
+        const size_t& imux) {
+      const MuxGraph& mux_graph = mux_lib.mux_graph(muxes[imux]);
+      CircuitModelId mux_circuit_model = mux_lib.mux_circuit_model(muxes[imux]);
+      /* Create a mux graph for the branch circuit */
+      std::vector<MuxGraph> branch_mux_graphs =
+        mux_graph.build_mux_branch_graphs();
+      /* Create branch circuits, which are N:1 one-level or 2:1 tree-like MUXes
+       */
+      for (auto branch_mux_graph : branch_mux_graphs) {
+        build_mux_branch_module(staging_module_manager, circuit_lib,
+                                mux_circuit_model, branch_mux_graph);
+      }
+      return CMD_EXEC_SUCCESS;
+    },
+    false);
+
   /* Generate unique Verilog modules for the multiplexers */
-  for (auto mux : mux_lib.muxes()) {
-    const MuxGraph& mux_graph = mux_lib.mux_graph(mux);
-    CircuitModelId mux_circuit_model = mux_lib.mux_circuit_model(mux);
-    /* Create MUX circuits */
-    build_mux_module(module_manager, circuit_lib, mux_circuit_model, mux_graph);
-  }
+  build_modules_with_staging(
+    module_manager, decoder_lib, muxes.size(), num_threads,
+    [&](ModuleManager& staging_module_manager, DecoderLibrary&,
+        const size_t& imux) {
+      const MuxGraph& mux_graph = mux_lib.mux_graph(muxes[imux]);
+      CircuitModelId mux_circuit_model = mux_lib.mux_circuit_model(muxes[imux]);
+      /* Create MUX circuits */
+      build_mux_module(staging_module_manager, circuit_lib, mux_circuit_model,
+                       mux_graph);
+      return CMD_EXEC_SUCCESS;
+    },
+    false);
 }
 
 } /* end namespace openfpga */
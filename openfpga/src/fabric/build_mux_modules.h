@@ -16,7 +16,8 @@
 namespace openfpga {
 
 void build_mux_modules(ModuleManager& module_manager, const MuxLibrary& mux_lib,
-                       const CircuitLibrary& circuit_lib);
+                       const CircuitLibrary& circuit_lib,
+                       const size_t& num_threads);
 
 } /* end namespace openfpga */
 
@@ -16,13 +16,18 @@
 /* Headers from openfpgautil library */
 #include "build_memory_modules.h"
 #include "build_module_graph_utils.h"
+#include "build_module_staging.h"
 #include "build_routing_module_utils.h"
 #include "build_routing_modules.h"
+#include "command_exit_codes.h"
 #include "module_manager_utils.h"
 #include "openfpga_naming.h"
+#include "openfpga_parallel.h"
+#include "openfpga_progress.h"
 #include "openfpga_reserved_words.h"
 #include "openfpga_rr_graph_utils.h"
 #include "openfpga_side_manager.h"
+#include "openfpga_trace.h"
 #include "rr_gsb_utils.h"
 
 /* begin namespace openfpga */
@@ -386,6 +391,7 @@ static void build_switch_block_module(
   const e_config_protocol_type& sram_orgz_type,
   const CircuitModelId& sram_model, const DeviceRRGSB& device_rr_gsb,
   const RRGSB& rr_gsb, const bool& group_config_block, const bool& verbose) {
+  TraceScope trace_scope("build_switch_block_module");
   /* Create a Module of Switch Block and add to module manager */
   vtr::Point<size_t> gsb_coordinate(rr_gsb.get_sb_x(), rr_gsb.get_sb_y());
   ModuleId sb_module = module_manager.add_module(
@@ -897,6 +903,7 @@ static void build_connection_block_module(
   const CircuitModelId& sram_model, const DeviceRRGSB& device_rr_gsb,
   const RRGSB& rr_gsb, const t_rr_type& cb_type, const bool& group_config_block,
   const bool& verbose) {
+  TraceScope trace_scope("build_connection_block_module");
   /* Create the netlist */
   vtr::Point<size_t> gsb_coordinate(rr_gsb.get_cb_x(cb_type),
                                     rr_gsb.get_cb_y(cb_type));
@@ -1096,12 +1103,14 @@ static void build_flatten_connection_block_modules(
   const DeviceRRGSB& device_rr_gsb, const CircuitLibrary& circuit_lib,
   const e_config_protocol_type& sram_orgz_type,
   const CircuitModelId& sram_model, const t_rr_type& cb_type,
-  const bool& group_config_block, const bool& verbose) {
+  const bool& group_config_block, ProgressReporter& progress,
+  const bool& verbose) {
   /* Build unique X-direction connection block modules */
   vtr::Point<size_t> cb_range = device_rr_gsb.get_gsb_range();
 
   for (size_t ix = 0; ix < cb_range.x(); ++ix) {
     for (size_t iy = 0; iy < cb_range.y(); ++iy) {
+      progress.increment();
       /* Check if the connection block exists in the device!
        * Some of them do NOT exist due to heterogeneous blocks (height > 1)
        * We will skip those modules
@@ -1135,12 +1144,18 @@ void build_flatten_routing_modules(
   const CircuitModelId& sram_model, const bool& group_config_block,
   const bool& verbose) {
   vtr::ScopedStartFinishTimer timer("Build routing modules...");
+  TraceScope trace_scope("build_flatten_routing_modules");
 
   vtr::Point<size_t> sb_range = device_rr_gsb.get_gsb_range();
+  /* Each GSB is visited once for its switch block and once for each of its
+   * connection blocks */
+  ProgressReporter progress("Build routing modules",
+                            3 * sb_range.x() * sb_range.y());
 
   /* Build unique switch block modules */
   for (size_t ix = 0; ix < sb_range.x(); ++ix) {
     for (size_t iy = 0; iy < sb_range.y(); ++iy) {
+      progress.increment();
       const RRGSB& rr_gsb = device_rr_gsb.get_gsb(ix, iy);
       if (false == rr_gsb.is_sb_exist(device_ctx.rr_graph)) {
         continue;
@@ -1155,11 +1170,73 @@ void build_flatten_routing_modules(
   build_flatten_connection_block_modules(
     module_manager, decoder_lib, device_ctx, device_annotation, device_rr_gsb,
     circuit_lib, sram_orgz_type, sram_model, CHANX, group_config_block,
-    verbose);
+    progress, verbose);
 
   build_flatten_connection_block_modules(
     module_manager, decoder_lib, device_ctx, device_annotation, device_rr_gsb,
     circuit_lib, sram_orgz_type, sram_model, CHANY, group_config_block,
+    progress, verbose);
+}
+
+/********************************************************************
+ * A unique routing module to be built
+ *******************************************************************/
+struct RoutingModuleTask {
+  bool is_sb;
+  t_rr_type cb_type;
+  size_t unique_module_index;
+};
+
+/********************************************************************
+ * Build all the unique routing modules with multiple threads
+ * Each thread builds modules in its own staging database, see
+ * build_modules_with_staging(). The modules are committed in the same
+ * order as the serial build: switch blocks first and then X- and
+ * Y-direction connection blocks.
+ *******************************************************************/
+static void build_unique_routing_modules_in_parallel(
+  ModuleManager& module_manager, DecoderLibrary& decoder_lib,
+  const DeviceContext& device_ctx, const VprDeviceAnnotation& device_annotation,
+  const DeviceRRGSB& device_rr_gsb, const CircuitLibrary& circuit_lib,
+  const e_config_protocol_type& sram_orgz_type,
+  const CircuitModelId& sram_model, const bool& group_config_block,
+  const size_t& num_threads, const bool& verbose) {
+  std::vector<RoutingModuleTask> tasks;
+  for (size_t isb = 0; isb < device_rr_gsb.get_num_sb_unique_module(); ++isb) {
+    tasks.push_back({true, NUM_RR_TYPES, isb});
+  }
+  for (const t_rr_type& cb_type : {CHANX, CHANY}) {
+    for (size_t icb = 0; icb < device_rr_gsb.get_num_cb_unique_module(cb_type);
+         ++icb) {
+      tasks.push_back({false, cb_type, icb});
+    }
+  }
+
+  ProgressReporter progress("Build unique routing modules", tasks.size());
+  build_modules_with_staging(
+    module_manager, decoder_lib, tasks.size(), num_threads,
+    [&](ModuleManager& staging_module_manager,
+        DecoderLibrary& staging_decoder_lib, const size_t& itask) {
+      const RoutingModuleTask& task = tasks[itask];
+      if (true == task.is_sb) {
+        build_switch_block_module(
+          staging_module_manager, staging_decoder_lib, device_annotation,
+          device_ctx.grid, device_ctx.rr_graph, circuit_lib, sram_orgz_type,
+          sram_model, device_rr_gsb,
+          device_rr_gsb.get_sb_unique_module(task.unique_module_index),
+          group_config_block, false);
+      } else {
+        build_connection_block_module(
+          staging_module_manager, staging_decoder_lib, device_annotation,
+          device_ctx.grid, device_ctx.rr_graph, circuit_lib, sram_orgz_type,
+          sram_model, device_rr_gsb,
+          device_rr_gsb.get_cb_unique_module(task.cb_type,
+                                             task.unique_module_index),
+          task.cb_type, group_config_block, false);
+      }
+      progress.increment();
+      return CMD_EXEC_SUCCESS;
+    },
     verbose);
 }
 
@@ -1171,6 +1248,9 @@ void build_flatten_routing_modules(
  * 1. Connection blocks
  * 2. Switch blocks
  *
+ * When more than 1 thread is required, the modules are built in parallel
+ * and the resulting module graph is the same as the serial build.
+ *
  * Note: this function SHOULD be called only when
  * the option compact_routing_hierarchy is turned on!!!
  *******************************************************************/
@@ -1180,8 +1260,22 @@ void build_unique_routing_modules(
   const DeviceRRGSB& device_rr_gsb, const CircuitLibrary& circuit_lib,
   const e_config_protocol_type& sram_orgz_type,
   const CircuitModelId& sram_model, const bool& group_config_block,
-  const bool& verbose) {
+  const size_t& num_threads, const bool& verbose) {
   vtr::ScopedStartFinishTimer timer("Build unique routing modules...");
+  TraceScope trace_scope("build_unique_routing_modules");
+
+  if (1 < find_num_threads(num_threads)) {
+    build_unique_routing_modules_in_parallel(
+      module_manager, decoder_lib, device_ctx, device_annotation,
+      device_rr_gsb, circuit_lib, sram_orgz_type, sram_model,
+      group_config_block, num_threads, verbose);
+    return;
+  }
+
+  ProgressReporter progress("Build unique routing modules",
+                            device_rr_gsb.get_num_sb_unique_module() +
+                              device_rr_gsb.get_num_cb_unique_module(CHANX) +
+                              device_rr_gsb.get_num_cb_unique_module(CHANY));
 
   /* Build unique switch block modules */
   for (size_t isb = 0; isb < device_rr_gsb.get_num_sb_unique_module(); ++isb) {
@@ -1190,6 +1284,7 @@ void build_unique_routing_modules(
                               device_ctx.grid, device_ctx.rr_graph, circuit_lib,
                               sram_orgz_type, sram_model, device_rr_gsb,
                               unique_mirror, group_config_block, verbose);
+    progress.increment();
   }
 
   /* Build unique X-direction connection block modules */
@@ -1201,6 +1296,7 @@ void build_unique_routing_modules(
       module_manager, decoder_lib, device_annotation, device_ctx.grid,
       device_ctx.rr_graph, circuit_lib, sram_orgz_type, sram_model,
       device_rr_gsb, unique_mirror, CHANX, group_config_block, verbose);
+    progress.increment();
   }
 
   /* Build unique X-direction connection block modules */
@@ -1212,6 +1308,7 @@ void build_unique_routing_modules(
       module_manager, decoder_lib, device_annotation, device_ctx.grid,
       device_ctx.rr_graph, circuit_lib, sram_orgz_type, sram_model,
       device_rr_gsb, unique_mirror, CHANY, group_config_block, verbose);
+    progress.increment();
   }
 }
 
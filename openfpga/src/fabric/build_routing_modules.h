@@ -33,7 +33,7 @@ void build_unique_routing_modules(
   const DeviceRRGSB& device_rr_gsb, const CircuitLibrary& circuit_lib,
   const e_config_protocol_type& sram_orgz_type,
   const CircuitModelId& sram_model, const bool& group_config_block,
-  const bool& verbose);
+  const size_t& num_threads, const bool& verbose);
 
 } /* end namespace openfpga */
 
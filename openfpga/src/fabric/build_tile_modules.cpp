@@ -19,6 +19,7 @@
 #include "openfpga_reserved_words.h"
 #include "openfpga_rr_graph_utils.h"
 #include "openfpga_side_manager.h"
+#include "openfpga_trace.h"
 #include "rr_gsb_utils.h"
 #include "vtr_assert.h"
 #include "vtr_log.h"
@@ -1539,6 +1540,7 @@ int build_tile_modules(ModuleManager& module_manager,
                        const bool& name_module_using_index,
                        const bool& frame_view, const bool& verbose) {
   vtr::ScopedStartFinishTimer timer("Build tile modules for the FPGA fabric");
+  TraceScope trace_scope("build_tile_modules");
 
   int status_code = CMD_EXEC_SUCCESS;
 
@@ -29,6 +29,7 @@
 #include "openfpga_device_grid_utils.h"
 #include "openfpga_naming.h"
 #include "openfpga_reserved_words.h"
+#include "openfpga_trace.h"
 #include "rr_gsb_utils.h"
 
 /* begin namespace openfpga */
@@ -58,8 +59,10 @@ int build_top_module(
   const bool& name_module_using_index, const bool& frame_view,
   const bool& compact_routing_hierarchy, const bool& duplicate_grid_pin,
   const FabricKey& fabric_key, const bool& generate_random_fabric_key,
-  const bool& group_config_block, const bool& verbose) {
+  const size_t& random_fabric_key_seed, const bool& group_config_block,
+  const size_t& num_threads, const bool& verbose) {
   vtr::ScopedStartFinishTimer timer("Build FPGA fabric module");
+  TraceScope trace_scope("build_top_module");
 
   int status = CMD_EXEC_SUCCESS;
 
@@ -79,7 +82,7 @@ int build_top_module(
       rr_clock_lookup, vpr_device_annotation, grids, layer, tile_annotation,
       rr_graph, device_rr_gsb, tile_direct, arch_direct, config_protocol,
       sram_model, frame_view, compact_routing_hierarchy, duplicate_grid_pin,
-      fabric_key, group_config_block);
+      fabric_key, group_config_block, num_threads);
   } else {
     /* Build the tile instances under the top module */
     status = build_top_module_tile_child_instances(
@@ -87,7 +90,7 @@ int build_top_module(
       rr_clock_lookup, vpr_device_annotation, grids, layer, tile_annotation,
       rr_graph, device_rr_gsb, tile_direct, arch_direct, fabric_tile,
       config_protocol, sram_model, fabric_key, group_config_block,
-      name_module_using_index, frame_view, verbose);
+      name_module_using_index, frame_view, num_threads, verbose);
   }
 
   if (status != CMD_EXEC_SUCCESS) {
@@ -96,8 +99,8 @@ int build_top_module(
 
   /* Shuffle the configurable children in a random sequence */
   if (true == generate_random_fabric_key) {
-    shuffle_top_module_configurable_children(module_manager, top_module,
-                                             config_protocol);
+    shuffle_top_module_configurable_children(
+      module_manager, top_module, random_fabric_key_seed, num_threads);
   }
 
   /* Build shift register bank detailed connections */
@@ -146,7 +149,7 @@ int build_top_module(
       add_top_module_nets_memory_config_bus(
         module_manager, decoder_lib, blwl_sr_banks, top_module, circuit_lib,
         config_protocol, circuit_lib.design_tech_type(sram_model),
-        top_module_num_config_bits);
+        top_module_num_config_bits, num_threads);
     }
   }
 
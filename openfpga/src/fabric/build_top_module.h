@@ -45,7 +45,8 @@ int build_top_module(
   const bool& name_module_using_index, const bool& frame_view,
   const bool& compact_routing_hierarchy, const bool& duplicate_grid_pin,
   const FabricKey& fabric_key, const bool& generate_random_fabric_key,
-  const bool& group_config_block, const bool& verbose);
+  const size_t& random_fabric_key_seed, const bool& group_config_block,
+  const size_t& num_threads, const bool& verbose);
 
 } /* end namespace openfpga */
 
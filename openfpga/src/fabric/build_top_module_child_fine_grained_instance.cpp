@@ -445,7 +445,7 @@ int build_top_module_fine_grained_child_instances(
   const ConfigProtocol& config_protocol, const CircuitModelId& sram_model,
   const bool& frame_view, const bool& compact_routing_hierarchy,
   const bool& duplicate_grid_pin, const FabricKey& fabric_key,
-  const bool& group_config_block) {
+  const bool& group_config_block, const size_t& num_threads) {
   int status = CMD_EXEC_SUCCESS;
   std::map<t_rr_type, vtr::Matrix<size_t>> cb_instance_ids;
 
@@ -480,11 +480,12 @@ int build_top_module_fine_grained_child_instances(
     add_top_module_nets_connect_grids_and_gsbs(
       module_manager, top_module, vpr_device_annotation, grids, layer,
       grid_instance_ids, rr_graph, device_rr_gsb, sb_instance_ids,
-      cb_instance_ids, compact_routing_hierarchy, duplicate_grid_pin);
+      cb_instance_ids, compact_routing_hierarchy, duplicate_grid_pin,
+      num_threads);
     /* Add inter-CLB direct connections */
     add_top_module_nets_tile_direct_connections(
       module_manager, top_module, circuit_lib, vpr_device_annotation, grids,
-      layer, grid_instance_ids, tile_direct, arch_direct);
+      layer, grid_instance_ids, tile_direct, arch_direct, num_threads);
   }
 
   /* Add global ports from grid ports that are defined as global in tile
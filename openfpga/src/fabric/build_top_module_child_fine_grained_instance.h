@@ -44,7 +44,7 @@ int build_top_module_fine_grained_child_instances(
   const ConfigProtocol& config_protocol, const CircuitModelId& sram_model,
   const bool& frame_view, const bool& compact_routing_hierarchy,
   const bool& duplicate_grid_pin, const FabricKey& fabric_key,
-  const bool& group_config_block);
+  const bool& group_config_block, const size_t& num_threads);
 
 } /* end namespace openfpga */
 
@@ -27,6 +27,7 @@
 #include "module_manager_utils.h"
 #include "openfpga_device_grid_utils.h"
 #include "openfpga_naming.h"
+#include "openfpga_parallel.h"
 #include "openfpga_physical_tile_utils.h"
 #include "openfpga_reserved_words.h"
 #include "openfpga_rr_graph_utils.h"
@@ -281,7 +282,7 @@ static void add_top_module_tile_io_children(
  *
  *******************************************************************/
 static int build_top_module_tile_nets_between_sb_and_pb(
-  ModuleManager& module_manager, const ModuleId& top_module,
+  const ModuleManager& module_manager, ModuleNetBuffer& net_buffer,
   const ModuleId& curr_tile_module,
   const vtr::Matrix<size_t>& tile_instance_ids,
   const size_t& curr_tile_instance_id, const DeviceGrid& grids,
@@ -452,13 +453,13 @@ static int build_top_module_tile_nets_between_sb_and_pb(
       /* Create a net for each pin */
       for (size_t pin_id = 0; pin_id < src_tile_grid_port.pins().size();
            ++pin_id) {
-        ModuleNetId net = create_module_source_pin_net(
-          module_manager, top_module, src_tile_module, src_tile_instance,
-          src_tile_grid_port_id, src_tile_grid_port.pins()[pin_id]);
+        size_t net = net_buffer.add_net(src_tile_module, src_tile_instance,
+                                        src_tile_grid_port_id,
+                                        src_tile_grid_port.pins()[pin_id]);
         /* Configure the net sink */
-        module_manager.add_module_net_sink(
-          top_module, net, curr_tile_module, curr_tile_instance_id,
-          sink_tile_sb_port_id, sink_tile_sb_port.pins()[pin_id]);
+        net_buffer.add_net_sink(net, curr_tile_module, curr_tile_instance_id,
+                                sink_tile_sb_port_id,
+                                sink_tile_sb_port.pins()[pin_id]);
       }
     }
   }
@@ -523,7 +524,7 @@ static int build_top_module_tile_nets_between_sb_and_pb(
  *
  *******************************************************************/
 static int build_top_module_tile_nets_between_cb_and_pb(
-  ModuleManager& module_manager, const ModuleId& top_module,
+  const ModuleManager& module_manager, ModuleNetBuffer& net_buffer,
   const ModuleId& tile_module, const vtr::Matrix<size_t>& tile_instance_ids,
   const size_t& tile_instance_id, const DeviceGrid& grids,
   const VprDeviceAnnotation& vpr_device_annotation,
@@ -665,13 +666,13 @@ static int build_top_module_tile_nets_between_cb_and_pb(
 
       /* Create a net for each pin */
       for (size_t pin_id = 0; pin_id < src_cb_port.pins().size(); ++pin_id) {
-        ModuleNetId net = create_module_source_pin_net(
-          module_manager, top_module, tile_module, tile_instance_id,
-          src_cb_port_id, src_cb_port.pins()[pin_id]);
+        size_t net =
+          net_buffer.add_net(tile_module, tile_instance_id, src_cb_port_id,
+                             src_cb_port.pins()[pin_id]);
         /* Configure the net sink */
-        module_manager.add_module_net_sink(
-          top_module, net, sink_tile_module, sink_tile_instance_id,
-          sink_grid_port_id, sink_grid_port.pins()[pin_id]);
+        net_buffer.add_net_sink(net, sink_tile_module, sink_tile_instance_id,
+                                sink_grid_port_id,
+                                sink_grid_port.pins()[pin_id]);
       }
       VTR_LOGV(verbose,
                "Built nets between connection block of tile[%lu][%lu] and grid "
@@ -725,7 +726,7 @@ static int build_top_module_tile_nets_between_cb_and_pb(
  *
  *******************************************************************/
 static int build_top_module_tile_nets_between_sb_and_cb(
-  ModuleManager& module_manager, const ModuleId& top_module,
+  const ModuleManager& module_manager, ModuleNetBuffer& net_buffer,
   const ModuleId& tile_module, const vtr::Matrix<size_t>& tile_instance_ids,
   const size_t& tile_instance_id, const DeviceRRGSB& device_rr_gsb,
   const RRGraphView& rr_graph, const RRGSB& rr_gsb,
@@ -917,21 +918,17 @@ static int build_top_module_tile_nets_between_sb_and_cb(
        */
       if (OUT_PORT ==
           module_sb.get_chan_node_direction(side_manager.get_side(), itrack)) {
-        ModuleNetId net = create_module_source_pin_net(
-          module_manager, top_module, tile_module, tile_instance_id, sb_port_id,
-          itrack / 2);
-        module_manager.add_module_net_sink(top_module, net, cb_tile_module,
-                                           cb_tile_instance, cb_port_id,
-                                           itrack / 2);
+        size_t net = net_buffer.add_net(tile_module, tile_instance_id,
+                                        sb_port_id, itrack / 2);
+        net_buffer.add_net_sink(net, cb_tile_module, cb_tile_instance,
+                                cb_port_id, itrack / 2);
       } else {
         VTR_ASSERT(IN_PORT == module_sb.get_chan_node_direction(
                                 side_manager.get_side(), itrack));
-        ModuleNetId net = create_module_source_pin_net(
-          module_manager, top_module, cb_tile_module, cb_tile_instance,
-          cb_port_id, itrack / 2);
-        module_manager.add_module_net_sink(top_module, net, tile_module,
-                                           tile_instance_id, sb_port_id,
-                                           itrack / 2);
+        size_t net = net_buffer.add_net(cb_tile_module, cb_tile_instance,
+                                        cb_port_id, itrack / 2);
+        net_buffer.add_net_sink(net, tile_module, tile_instance_id, sb_port_id,
+                                itrack / 2);
       }
       VTR_LOGV(verbose,
                "Built nets between switch block of tile[%lu][%lu] and "
@@ -971,7 +968,7 @@ static int build_top_module_tile_nets_between_sb_and_cb(
  *
  *******************************************************************/
 static int add_top_module_nets_around_one_tile(
-  ModuleManager& module_manager, const ModuleId& top_module,
+  const ModuleManager& module_manager, ModuleNetBuffer& net_buffer,
   const VprDeviceAnnotation& vpr_device_annotation, const DeviceGrid& grids,
   const vtr::Matrix<size_t>& tile_instance_ids,
   const RRGraphView& rr_graph_view, const DeviceRRGSB& device_rr_gsb,
@@ -1001,7 +998,7 @@ static int add_top_module_nets_around_one_tile(
       fabric_tile.sb_coordinates(curr_fabric_tile_id)[isb];
     const RRGSB& rr_gsb = device_rr_gsb.get_gsb(sb_coord);
     status = build_top_module_tile_nets_between_sb_and_pb(
-      module_manager, top_module, tile_module, tile_instance_ids,
+      module_manager, net_buffer, tile_module, tile_instance_ids,
       tile_instance_id, grids, vpr_device_annotation, device_rr_gsb,
       rr_graph_view, rr_gsb, fabric_tile, curr_fabric_tile_id, isb, true,
       name_module_using_index, verbose);
@@ -1019,7 +1016,7 @@ static int add_top_module_nets_around_one_tile(
         fabric_tile.cb_coordinates(curr_fabric_tile_id, cb_type)[icb];
       const RRGSB& rr_gsb = device_rr_gsb.get_gsb(cb_coord);
       status = build_top_module_tile_nets_between_cb_and_pb(
-        module_manager, top_module, tile_module, tile_instance_ids,
+        module_manager, net_buffer, tile_module, tile_instance_ids,
         tile_instance_id, grids, vpr_device_annotation, device_rr_gsb,
         rr_graph_view, rr_gsb, fabric_tile, curr_fabric_tile_id, cb_type, icb,
         true, name_module_using_index, verbose);
@@ -1036,7 +1033,7 @@ static int add_top_module_nets_around_one_tile(
       fabric_tile.sb_coordinates(curr_fabric_tile_id)[isb];
     const RRGSB& rr_gsb = device_rr_gsb.get_gsb(sb_coord);
     status = build_top_module_tile_nets_between_sb_and_cb(
-      module_manager, top_module, tile_module, tile_instance_ids,
+      module_manager, net_buffer, tile_module, tile_instance_ids,
       tile_instance_id, device_rr_gsb, rr_graph_view, rr_gsb, fabric_tile,
       curr_fabric_tile_id, isb, true, name_module_using_index, verbose);
     if (status != CMD_EXEC_SUCCESS) {
@@ -1056,27 +1053,40 @@ static int add_top_module_nets_connect_tiles(
   const VprDeviceAnnotation& vpr_device_annotation, const DeviceGrid& grids,
   const vtr::Matrix<size_t>& tile_instance_ids, const RRGraphView& rr_graph,
   const DeviceRRGSB& device_rr_gsb, const FabricTile& fabric_tile,
-  const bool& name_module_using_index, const bool& verbose) {
+  const bool& name_module_using_index, const size_t& num_threads,
+  const bool& verbose) {
   vtr::ScopedStartFinishTimer timer("Add module nets between tiles");
-  int status = CMD_EXEC_SUCCESS;
 
-  for (size_t ix = 0; ix < grids.width(); ++ix) {
+  /* Each column of tiles is a region whose nets are staged in its own buffer,
+   * while the module graph is only read. Buffers are merged in the order of
+   * columns, so that the nets are the same whatever the number of threads */
+  std::vector<ModuleNetBuffer> net_buffers(grids.width());
+  std::vector<int> column_status(grids.width(), CMD_EXEC_SUCCESS);
+  parallel_for(grids.width(), num_threads, [&](const size_t& ix) {
     for (size_t iy = 0; iy < grids.height(); ++iy) {
       vtr::Point<size_t> curr_coord(ix, iy);
       FabricTileId curr_fabric_tile_id = fabric_tile.find_tile(curr_coord);
       if (!fabric_tile.valid_tile_id(curr_fabric_tile_id)) {
         continue;
       }
-      status = add_top_module_nets_around_one_tile(
-        module_manager, top_module, vpr_device_annotation, grids,
+      column_status[ix] = add_top_module_nets_around_one_tile(
+        module_manager, net_buffers[ix], vpr_device_annotation, grids,
         tile_instance_ids, rr_graph, device_rr_gsb, fabric_tile,
         curr_fabric_tile_id, name_module_using_index, verbose);
-      if (status != CMD_EXEC_SUCCESS) {
-        return CMD_EXEC_FATAL_ERROR;
+      if (column_status[ix] != CMD_EXEC_SUCCESS) {
+        return;
       }
     }
+  });
+
+  for (const int& status : column_status) {
+    if (status != CMD_EXEC_SUCCESS) {
+      return CMD_EXEC_FATAL_ERROR;
+    }
   }
 
+  module_manager.append_nets(top_module, net_buffers);
+
   return CMD_EXEC_SUCCESS;
 }
 
@@ -1905,7 +1915,7 @@ int build_top_module_tile_child_instances(
   const FabricTile& fabric_tile, const ConfigProtocol& config_protocol,
   const CircuitModelId& sram_model, const FabricKey& fabric_key,
   const bool& group_config_block, const bool& name_module_using_index,
-  const bool& frame_view, const bool& verbose) {
+  const bool& frame_view, const size_t& num_threads, const bool& verbose) {
   int status = CMD_EXEC_SUCCESS;
   vtr::Matrix<size_t> tile_instance_ids;
   status = add_top_module_tile_instances(module_manager, top_module,
@@ -1926,7 +1936,7 @@ int build_top_module_tile_child_instances(
     status = add_top_module_nets_connect_tiles(
       module_manager, top_module, vpr_device_annotation, grids,
       tile_instance_ids, rr_graph, device_rr_gsb, fabric_tile,
-      name_module_using_index, verbose);
+      name_module_using_index, num_threads, verbose);
     if (status != CMD_EXEC_SUCCESS) {
       return CMD_EXEC_FATAL_ERROR;
     }
@@ -2,6 +2,9 @@
  * This file include most utilized functions for building connections
  * inside the module graph for FPGA fabric
  *******************************************************************/
+#include <map>
+#include <vector>
+
 /* Headers from vtrutil library */
 #include "vtr_assert.h"
 #include "vtr_time.h"
@@ -10,6 +13,7 @@
 #include "command_exit_codes.h"
 
 /* Headers from openfpgautil library */
+#include "openfpga_parallel.h"
 #include "openfpga_side_manager.h"
 
 /* Headers from vpr library */
@@ -62,7 +66,7 @@ namespace openfpga {
  *
  *******************************************************************/
 static void add_top_module_nets_connect_grids_and_sb(
-  ModuleManager& module_manager, const ModuleId& top_module,
+  const ModuleManager& module_manager, ModuleNetBuffer& net_buffer,
   const VprDeviceAnnotation& vpr_device_annotation, const DeviceGrid& grids,
   const size_t& layer, const vtr::Matrix<size_t>& grid_instance_ids,
   const RRGraphView& rr_graph, const DeviceRRGSB& device_rr_gsb,
@@ -176,13 +180,12 @@ static void add_top_module_nets_connect_grids_and_sb(
 
       /* Create a net for each pin */
       for (size_t pin_id = 0; pin_id < src_grid_port.pins().size(); ++pin_id) {
-        ModuleNetId net = create_module_source_pin_net(
-          module_manager, top_module, src_grid_module, src_grid_instance,
-          src_grid_port_id, src_grid_port.pins()[pin_id]);
+        size_t net = net_buffer.add_net(src_grid_module, src_grid_instance,
+                                        src_grid_port_id,
+                                        src_grid_port.pins()[pin_id]);
         /* Configure the net sink */
-        module_manager.add_module_net_sink(top_module, net, sink_sb_module,
-                                           sink_sb_instance, sink_sb_port_id,
-                                           sink_sb_port.pins()[pin_id]);
+        net_buffer.add_net_sink(net, sink_sb_module, sink_sb_instance,
+                                sink_sb_port_id, sink_sb_port.pins()[pin_id]);
       }
     }
   }
@@ -225,7 +228,7 @@ static void add_top_module_nets_connect_grids_and_sb(
  *
  *******************************************************************/
 static void add_top_module_nets_connect_grids_and_sb_with_duplicated_pins(
-  ModuleManager& module_manager, const ModuleId& top_module,
+  const ModuleManager& module_manager, ModuleNetBuffer& net_buffer,
   const VprDeviceAnnotation& vpr_device_annotation, const DeviceGrid& grids,
   const size_t& layer, const vtr::Matrix<size_t>& grid_instance_ids,
   const RRGraphView& rr_graph, const DeviceRRGSB& device_rr_gsb,
@@ -369,13 +372,12 @@ static void add_top_module_nets_connect_grids_and_sb_with_duplicated_pins(
 
       /* Create a net for each pin */
       for (size_t pin_id = 0; pin_id < src_grid_port.pins().size(); ++pin_id) {
-        ModuleNetId net = create_module_source_pin_net(
-          module_manager, top_module, src_grid_module, src_grid_instance,
-          src_grid_port_id, src_grid_port.pins()[pin_id]);
+        size_t net = net_buffer.add_net(src_grid_module, src_grid_instance,
+                                        src_grid_port_id,
+                                        src_grid_port.pins()[pin_id]);
         /* Configure the net sink */
-        module_manager.add_module_net_sink(top_module, net, sink_sb_module,
-                                           sink_sb_instance, sink_sb_port_id,
-                                           sink_sb_port.pins()[pin_id]);
+        net_buffer.add_net_sink(net, sink_sb_module, sink_sb_instance,
+                                sink_sb_port_id, sink_sb_port.pins()[pin_id]);
       }
     }
   }
@@ -437,7 +439,7 @@ static void add_top_module_nets_connect_grids_and_sb_with_duplicated_pins(
  *
  *******************************************************************/
 static void add_top_module_nets_connect_grids_and_cb(
-  ModuleManager& module_manager, const ModuleId& top_module,
+  const ModuleManager& module_manager, ModuleNetBuffer& net_buffer,
   const VprDeviceAnnotation& vpr_device_annotation, const DeviceGrid& grids,
   const size_t& layer, const vtr::Matrix<size_t>& grid_instance_ids,
   const RRGraphView& rr_graph, const DeviceRRGSB& device_rr_gsb,
@@ -553,13 +555,13 @@ static void add_top_module_nets_connect_grids_and_cb(
 
       /* Create a net for each pin */
       for (size_t pin_id = 0; pin_id < src_cb_port.pins().size(); ++pin_id) {
-        ModuleNetId net = create_module_source_pin_net(
-          module_manager, top_module, src_cb_module, src_cb_instance,
-          src_cb_port_id, src_cb_port.pins()[pin_id]);
+        size_t net = net_buffer.add_net(src_cb_module, src_cb_instance,
+                                        src_cb_port_id,
+                                        src_cb_port.pins()[pin_id]);
         /* Configure the net sink */
-        module_manager.add_module_net_sink(
-          top_module, net, sink_grid_module, sink_grid_instance,
-          sink_grid_port_id, sink_grid_port.pins()[pin_id]);
+        net_buffer.add_net_sink(net, sink_grid_module, sink_grid_instance,
+                                sink_grid_port_id,
+                                sink_grid_port.pins()[pin_id]);
       }
     }
   }
@@ -605,7 +607,7 @@ static void add_top_module_nets_connect_grids_and_cb(
  *
  *******************************************************************/
 static void add_top_module_nets_connect_sb_and_cb(
-  ModuleManager& module_manager, const ModuleId& top_module,
+  const ModuleManager& module_manager, ModuleNetBuffer& net_buffer,
   const RRGraphView& rr_graph, const DeviceRRGSB& device_rr_gsb,
   const RRGSB& rr_gsb, const vtr::Matrix<size_t>& sb_instance_ids,
   const std::map<t_rr_type, vtr::Matrix<size_t>>& cb_instance_ids,
@@ -751,19 +753,17 @@ static void add_top_module_nets_connect_sb_and_cb(
        */
       if (OUT_PORT ==
           module_sb.get_chan_node_direction(side_manager.get_side(), itrack)) {
-        ModuleNetId net =
-          create_module_source_pin_net(module_manager, top_module, sb_module_id,
-                                       sb_instance, sb_port_id, itrack / 2);
-        module_manager.add_module_net_sink(top_module, net, cb_module_id,
-                                           cb_instance, cb_port_id, itrack / 2);
+        size_t net = net_buffer.add_net(sb_module_id, sb_instance, sb_port_id,
+                                        itrack / 2);
+        net_buffer.add_net_sink(net, cb_module_id, cb_instance, cb_port_id,
+                                itrack / 2);
       } else {
         VTR_ASSERT(IN_PORT == module_sb.get_chan_node_direction(
                                 side_manager.get_side(), itrack));
-        ModuleNetId net =
-          create_module_source_pin_net(module_manager, top_module, cb_module_id,
-                                       cb_instance, cb_port_id, itrack / 2);
-        module_manager.add_module_net_sink(top_module, net, sb_module_id,
-                                           sb_instance, sb_port_id, itrack / 2);
+        size_t net = net_buffer.add_net(cb_module_id, cb_instance, cb_port_id,
+                                        itrack / 2);
+        net_buffer.add_net_sink(net, sb_module_id, sb_instance, sb_port_id,
+                                itrack / 2);
       }
     }
   }
@@ -809,61 +809,82 @@ void add_top_module_nets_connect_grids_and_gsbs(
   const RRGraphView& rr_graph, const DeviceRRGSB& device_rr_gsb,
   const vtr::Matrix<size_t>& sb_instance_ids,
   const std::map<t_rr_type, vtr::Matrix<size_t>>& cb_instance_ids,
-  const bool& compact_routing_hierarchy, const bool& duplicate_grid_pin) {
+  const bool& compact_routing_hierarchy, const bool& duplicate_grid_pin,
+  const size_t& num_threads) {
   vtr::ScopedStartFinishTimer timer("Add module nets between grids and GSBs");
 
   vtr::Point<size_t> gsb_range = device_rr_gsb.get_gsb_range();
 
-  for (size_t ix = 0; ix < gsb_range.x(); ++ix) {
+  /* Each column of GSBs is a region whose nets are staged in its own buffer,
+   * while the module graph is only read. Buffers are merged in the order of
+   * columns, so that the nets are the same whatever the number of threads */
+  std::vector<ModuleNetBuffer> net_buffers(gsb_range.x());
+  parallel_for(gsb_range.x(), num_threads, [&](const size_t& ix) {
+    ModuleNetBuffer& net_buffer = net_buffers[ix];
     for (size_t iy = 0; iy < gsb_range.y(); ++iy) {
-      vtr::Point<size_t> gsb_coordinate(ix, iy);
       const RRGSB& rr_gsb = device_rr_gsb.get_gsb(ix, iy);
 
       /* Connect the grid pins of the GSB to adjacent grids */
       if (false == duplicate_grid_pin) {
         add_top_module_nets_connect_grids_and_sb(
-          module_manager, top_module, vpr_device_annotation, grids, layer,
+          module_manager, net_buffer, vpr_device_annotation, grids, layer,
           grid_instance_ids, rr_graph, device_rr_gsb, rr_gsb, sb_instance_ids,
           compact_routing_hierarchy);
       } else {
         VTR_ASSERT_SAFE(true == duplicate_grid_pin);
         add_top_module_nets_connect_grids_and_sb_with_duplicated_pins(
-          module_manager, top_module, vpr_device_annotation, grids, layer,
+          module_manager, net_buffer, vpr_device_annotation, grids, layer,
           grid_instance_ids, rr_graph, device_rr_gsb, rr_gsb, sb_instance_ids,
           compact_routing_hierarchy);
       }
 
       add_top_module_nets_connect_grids_and_cb(
-        module_manager, top_module, vpr_device_annotation, grids, layer,
+        module_manager, net_buffer, vpr_device_annotation, grids, layer,
         grid_instance_ids, rr_graph, device_rr_gsb, rr_gsb, CHANX,
         cb_instance_ids.at(CHANX), compact_routing_hierarchy);
 
       add_top_module_nets_connect_grids_and_cb(
-        module_manager, top_module, vpr_device_annotation, grids, layer,
+        module_manager, net_buffer, vpr_device_annotation, grids, layer,
         grid_instance_ids, rr_graph, device_rr_gsb, rr_gsb, CHANY,
         cb_instance_ids.at(CHANY), compact_routing_hierarchy);
 
       add_top_module_nets_connect_sb_and_cb(
-        module_manager, top_module, rr_graph, device_rr_gsb, rr_gsb,
+        module_manager, net_buffer, rr_graph, device_rr_gsb, rr_gsb,
         sb_instance_ids, cb_instance_ids, compact_routing_hierarchy);
     }
-  }
+  });
+
+  module_manager.append_nets(top_module, net_buffers);
 }
 
 /********************************************************************
- * Add global port connection for a given port of a physical tile
+ * The pins of a grid module to be driven by a global port of the top-level
+ * module. The pins only depend on the type of the grid module, and are
+ * shared by all its instances
+ *******************************************************************/
+struct GridGlobalNetSink {
+  ModulePortId grid_port;
+  size_t grid_pin;
+  /* The pin of the global port at the top-level module */
+  size_t src_pin;
+};
+
+struct GridGlobalNetSinks {
+  ModuleId grid_module;
+  std::vector<GridGlobalNetSink> sinks;
+};
+
+/********************************************************************
+ * Find the pins of a grid module for a given port of a physical tile
  * that are defined as global in tile annotation
  *******************************************************************/
-static int build_top_module_global_net_for_given_grid_module(
-  ModuleManager& module_manager, const ModuleId& top_module,
-  const ModulePortId& top_module_port, const TileAnnotation& tile_annotation,
+static int find_top_module_global_net_grid_sinks(
+  GridGlobalNetSinks& grid_sinks, const ModuleManager& module_manager,
+  const BasicPort& src_port, const TileAnnotation& tile_annotation,
   const TileGlobalPortId& tile_global_port,
   const BasicPort& tile_port_to_connect,
-  const VprDeviceAnnotation& vpr_device_annotation, const DeviceGrid& grids,
-  const size_t& layer, const vtr::Point<size_t>& grid_coordinate,
-  const e_side& border_side, const vtr::Matrix<size_t>& grid_instance_ids) {
-  t_physical_tile_type_ptr physical_tile = grids.get_physical_type(
-    t_physical_tile_loc(grid_coordinate.x(), grid_coordinate.y(), layer));
+  const VprDeviceAnnotation& vpr_device_annotation,
+  t_physical_tile_type_ptr physical_tile, const e_side& border_side) {
   /* Find the module name for this type of grid */
   std::string grid_module_name_prefix(GRID_MODULE_NAME_PREFIX);
   std::string grid_module_name = generate_grid_block_module_name(
@@ -871,10 +892,7 @@ static int build_top_module_global_net_for_given_grid_module(
     is_io_type(physical_tile), border_side);
   ModuleId grid_module = module_manager.find_module(grid_module_name);
   VTR_ASSERT(true == module_manager.valid_module_id(grid_module));
-  size_t grid_instance =
-    grid_instance_ids[grid_coordinate.x()][grid_coordinate.y()];
-  /* Find the source port at the top-level module */
-  BasicPort src_port = module_manager.module_port(top_module, top_module_port);
+  grid_sinks.grid_module = grid_module;
 
   /* Walk through each instance considering the unique sub tile and capacity
    * range, each instance may have an independent pin to be driven by a global
@@ -929,7 +947,7 @@ static int build_top_module_global_net_for_given_grid_module(
         sink2src_pin_map[sink_pin] = src_pin;
       }
 
-      /* Create the connections */
+      /* Find the sinks of the connections */
       for (size_t pin_id = tile_port_to_connect.get_lsb();
            pin_id < tile_port_to_connect.get_msb() + 1; ++pin_id) {
         int grid_pin_index = grid_pin_start_index + pin_id;
@@ -945,7 +963,6 @@ static int build_top_module_global_net_for_given_grid_module(
                                                             grid_pin_index);
         VTR_ASSERT(true == grid_pin_info.is_valid());
 
-        /* Build nets */
         for (const e_side& pin_side : pin_sides) {
           std::string grid_port_name =
             generate_grid_port_name(grid_pin_width, grid_pin_height,
@@ -965,21 +982,13 @@ static int build_top_module_global_net_for_given_grid_module(
           VTR_ASSERT(true == module_manager.valid_module_port_id(grid_module,
                                                                  grid_port_id));
 
-          VTR_ASSERT(
-            1 ==
-            module_manager.module_port(grid_module, grid_port_id).get_width());
-
-          ModuleNetId net = create_module_source_pin_net(
-            module_manager, top_module, top_module, 0, top_module_port,
-            src_port.pins()[sink2src_pin_map[pin_id]]);
-          VTR_ASSERT(ModuleNetId::INVALID() != net);
-
-          /* Configure the net sink */
           BasicPort sink_port =
             module_manager.module_port(grid_module, grid_port_id);
-          module_manager.add_module_net_sink(top_module, net, grid_module,
-                                             grid_instance, grid_port_id,
-                                             sink_port.pins()[0]);
+          VTR_ASSERT(1 == sink_port.get_width());
+
+          grid_sinks.sinks.push_back(
+            {grid_port_id, sink_port.pins()[0],
+             src_port.pins()[sink2src_pin_map[pin_id]]});
         }
       }
     }
@@ -988,6 +997,57 @@ static int build_top_module_global_net_for_given_grid_module(
   return CMD_EXEC_SUCCESS;
 }
 
+/********************************************************************
+ * Add global port connection for a given port of a physical tile
+ * that are defined as global in tile annotation
+ * The sinks of each type of grid module, i.e., each border side of the
+ * tile, are found once and cached, so that the nets of the other
+ * instances of the same module are created without any lookup
+ *******************************************************************/
+static int build_top_module_global_net_for_given_grid_module(
+  ModuleManager& module_manager, const ModuleId& top_module,
+  const ModulePortId& top_module_port, const TileAnnotation& tile_annotation,
+  const TileGlobalPortId& tile_global_port,
+  const BasicPort& tile_port_to_connect,
+  const VprDeviceAnnotation& vpr_device_annotation, const DeviceGrid& grids,
+  const size_t& layer, const vtr::Point<size_t>& grid_coordinate,
+  const e_side& border_side, const vtr::Matrix<size_t>& grid_instance_ids,
+  std::map<e_side, GridGlobalNetSinks>& grid_sinks_cache) {
+  auto grid_sinks = grid_sinks_cache.find(border_side);
+  if (grid_sinks == grid_sinks_cache.end()) {
+    t_physical_tile_type_ptr physical_tile = grids.get_physical_type(
+      t_physical_tile_loc(grid_coordinate.x(), grid_coordinate.y(), layer));
+    GridGlobalNetSinks new_grid_sinks;
+    int status = find_top_module_global_net_grid_sinks(
+      new_grid_sinks, module_manager,
+      module_manager.module_port(top_module, top_module_port),
+      tile_annotation, tile_global_port, tile_port_to_connect,
+      vpr_device_annotation, physical_tile, border_side);
+    if (CMD_EXEC_SUCCESS != status) {
+      return status;
+    }
+    grid_sinks = grid_sinks_cache.emplace(border_side, new_grid_sinks).first;
+  }
+
+  size_t grid_instance =
+    grid_instance_ids[grid_coordinate.x()][grid_coordinate.y()];
+  /* Build nets */
+  for (const GridGlobalNetSink& sink : grid_sinks->second.sinks) {
+    ModuleNetId net =
+      create_module_source_pin_net(module_manager, top_module, top_module, 0,
+                                   top_module_port, sink.src_pin);
+    VTR_ASSERT(ModuleNetId::INVALID() != net);
+
+    /* Configure the net sink */
+    module_manager.add_module_net_sink(top_module, net,
+                                       grid_sinks->second.grid_module,
+                                       grid_instance, sink.grid_port,
+                                       sink.grid_pin);
+  }
+
+  return CMD_EXEC_SUCCESS;
+}
+
 /********************************************************************
  * Add nets between a global port and its sinks at each grid modules
  *******************************************************************/
@@ -1049,6 +1109,10 @@ static int build_top_module_global_net_from_grid_modules(
       return CMD_EXEC_FATAL_ERROR;
     }
 
+    /* All the tiles have the same type, i.e., the name of the tile, so the
+     * grid modules are told apart by their border side */
+    std::map<e_side, GridGlobalNetSinks> grid_sinks_cache;
+
     /* Spot the port from child modules from core grids */
     for (size_t ix = start_coord.x(); ix < end_coord.x(); ++ix) {
       for (size_t iy = start_coord.y(); iy < end_coord.y(); ++iy) {
@@ -1074,7 +1138,8 @@ static int build_top_module_global_net_from_grid_modules(
         status = build_top_module_global_net_for_given_grid_module(
           module_manager, top_module, top_module_port, tile_annotation,
           tile_global_port, tile_port, vpr_device_annotation, grids, layer,
-          vtr::Point<size_t>(ix, iy), NUM_SIDES, grid_instance_ids);
+          vtr::Point<size_t>(ix, iy), NUM_SIDES, grid_instance_ids,
+          grid_sinks_cache);
         if (CMD_EXEC_FATAL_ERROR == status) {
           return status;
         }
@@ -1121,7 +1186,7 @@ static int build_top_module_global_net_from_grid_modules(
         status = build_top_module_global_net_for_given_grid_module(
           module_manager, top_module, top_module_port, tile_annotation,
           tile_global_port, tile_port, vpr_device_annotation, grids, layer,
-          io_coordinate, io_side, grid_instance_ids);
+          io_coordinate, io_side, grid_instance_ids, grid_sinks_cache);
         if (CMD_EXEC_FATAL_ERROR == status) {
           return status;
         }
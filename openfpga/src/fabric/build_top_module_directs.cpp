@@ -4,6 +4,7 @@
  * in the top-level module of a FPGA fabric
  *******************************************************************/
 #include <algorithm>
+#include <vector>
 
 /* Headers from vtrutil library */
 #include "vtr_assert.h"
@@ -11,11 +12,13 @@
 #include "vtr_time.h"
 
 /* Headers from openfpgautil library */
+#include "openfpga_parallel.h"
 #include "openfpga_port.h"
 
 /* Headers from vpr library */
 #include "build_top_module_directs.h"
 #include "module_manager_utils.h"
+#include "module_net_buffer.h"
 #include "openfpga_naming.h"
 #include "openfpga_reserved_words.h"
 #include "vpr_utils.h"
@@ -24,20 +27,32 @@
 namespace openfpga {
 
 /********************************************************************
- * Add module net for one direction connection between two CLBs or
+ * The terminals of a direct connection between two grids in the
+ * top module, which are resolved from a tile direct
+ *******************************************************************/
+struct TileDirectTerminals {
+  /* Pin of the source grid, where the instance is its instance id */
+  ModuleNetTerminal src;
+  /* Pin of the sink grid */
+  ModuleNetTerminal sink;
+  /* The direct connection module and its input and output ports */
+  ModuleId direct_module;
+  ModulePortId direct_input_port;
+  ModulePortId direct_output_port;
+};
+
+/********************************************************************
+ * Resolve the terminals of one direction connection between two CLBs or
  * two grids
  * This function will
  * 1. find the pin id and port id of the source clb port in module manager
  * 2. find the pin id and port id of the destination clb port in module manager
- * 3. add a direct connection module to the top module
- * 4. add a first module net and configure its source and sink,
- * in order to connect the source pin to the input of the top module
- * 4. add a second module net and configure its source and sink,
- * in order to connect the sink pin to the output of the top module
+ * 3. find the direct connection module and its ports
+ * The module manager is only read, so that the directs can be resolved by
+ * multiple threads
  *******************************************************************/
-static void add_module_nets_tile_direct_connection(
-  ModuleManager& module_manager, const ModuleId& top_module,
-  const CircuitLibrary& circuit_lib,
+static TileDirectTerminals find_tile_direct_terminals(
+  const ModuleManager& module_manager, const CircuitLibrary& circuit_lib,
   const VprDeviceAnnotation& vpr_device_annotation, const DeviceGrid& grids,
   const size_t& layer, const vtr::Matrix<size_t>& grid_instance_ids,
   const TileDirect& tile_direct, const TileDirectId& tile_direct_id,
@@ -177,30 +192,13 @@ static void add_module_nets_tile_direct_connection(
     1 ==
     module_manager.module_port(sink_grid_module, sink_port_id).get_width());
 
-  /* Add a submodule of direct connection module to the top-level module */
-  size_t direct_instance_id =
-    module_manager.num_instance(top_module, direct_module);
-  module_manager.add_child_module(top_module, direct_module, false);
-
-  /* Create the 1st module net */
-  ModuleNetId net_direct_src = module_manager.create_module_net(top_module);
-  /* Connect the wire between src_pin of clb and direct_instance input*/
-  module_manager.add_module_net_source(top_module, net_direct_src,
-                                       src_grid_module, src_grid_instance,
-                                       src_port_id, 0);
-  module_manager.add_module_net_sink(top_module, net_direct_src, direct_module,
-                                     direct_instance_id, direct_input_port_id,
-                                     0);
-
-  /* Create the 2nd module net
-   * Connect the wire between direct_instance output and sink_pin of clb
-   */
-  ModuleNetId net_direct_sink =
-    create_module_source_pin_net(module_manager, top_module, direct_module,
-                                 direct_instance_id, direct_output_port_id, 0);
-  module_manager.add_module_net_sink(top_module, net_direct_sink,
-                                     sink_grid_module, sink_grid_instance,
-                                     sink_port_id, 0);
+  TileDirectTerminals terminals;
+  terminals.src = {src_grid_module, src_grid_instance, src_port_id, 0};
+  terminals.sink = {sink_grid_module, sink_grid_instance, sink_port_id, 0};
+  terminals.direct_module = direct_module;
+  terminals.direct_input_port = direct_input_port_id;
+  terminals.direct_output_port = direct_output_port_id;
+  return terminals;
 }
 
 /********************************************************************
@@ -214,15 +212,56 @@ void add_top_module_nets_tile_direct_connections(
   const CircuitLibrary& circuit_lib,
   const VprDeviceAnnotation& vpr_device_annotation, const DeviceGrid& grids,
   const size_t& layer, const vtr::Matrix<size_t>& grid_instance_ids,
-  const TileDirect& tile_direct, const ArchDirect& arch_direct) {
+  const TileDirect& tile_direct, const ArchDirect& arch_direct,
+  const size_t& num_threads) {
   vtr::ScopedStartFinishTimer timer(
     "Add module nets for inter-tile connections");
 
-  for (const TileDirectId& tile_direct_id : tile_direct.directs()) {
-    add_module_nets_tile_direct_connection(
-      module_manager, top_module, circuit_lib, vpr_device_annotation, grids,
-      layer, grid_instance_ids, tile_direct, tile_direct_id, arch_direct);
+  /* Resolve the module ports of each direct with multiple threads */
+  std::vector<TileDirectId> tile_direct_ids(tile_direct.directs().begin(),
+                                            tile_direct.directs().end());
+  std::vector<TileDirectTerminals> terminals(tile_direct_ids.size());
+  const ModuleManager& const_module_manager = module_manager;
+  parallel_for(tile_direct_ids.size(), num_threads, [&](const size_t& idir) {
+    terminals[idir] = find_tile_direct_terminals(
+      const_module_manager, circuit_lib, vpr_device_annotation, grids, layer,
+      grid_instance_ids, tile_direct, tile_direct_ids[idir], arch_direct);
+  });
+
+  /* Add a direct connection module to the top module for each direct, and
+   * stage two nets:
+   * - the 1st net connects the source pin of the grid to the input of the
+   *   direct module
+   * - the 2nd net connects the output of the direct module to the sink pin
+   *   of the grid
+   * Instances are added in the sequence of directs, and so are the nets */
+  ModuleNetBuffer net_buffer;
+  net_buffer.reserve(2 * terminals.size(), 2 * terminals.size());
+  for (const TileDirectTerminals& direct_terminals : terminals) {
+    size_t direct_instance_id =
+      module_manager.num_instance(top_module, direct_terminals.direct_module);
+    module_manager.add_child_module(top_module, direct_terminals.direct_module,
+                                    false);
+
+    const ModuleNetTerminal& src = direct_terminals.src;
+    size_t net_direct_src =
+      net_buffer.add_net(src.module, src.instance, src.port, src.pin);
+    net_buffer.add_net_sink(net_direct_src, direct_terminals.direct_module,
+                            direct_instance_id,
+                            direct_terminals.direct_input_port, 0);
+
+    const ModuleNetTerminal& sink = direct_terminals.sink;
+    size_t net_direct_sink = net_buffer.add_net(
+      direct_terminals.direct_module, direct_instance_id,
+      direct_terminals.direct_output_port, 0);
+    net_buffer.add_net_sink(net_direct_sink, sink.module, sink.instance,
+                            sink.port, sink.pin);
   }
+
+  /* The source pin of a grid may already drive a net to the routing blocks.
+   * A separated net is still created for the direct, rather than merging it
+   * into the existing net */
+  module_manager.append_nets(top_module, net_buffer, false);
 }
 
 } /* end namespace openfpga */
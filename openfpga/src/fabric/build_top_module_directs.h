@@ -27,7 +27,8 @@ void add_top_module_nets_tile_direct_connections(
   const CircuitLibrary& circuit_lib,
   const VprDeviceAnnotation& vpr_device_annotation, const DeviceGrid& grids,
   const size_t& layer, const vtr::Matrix<size_t>& grid_instance_ids,
-  const TileDirect& tile_direct, const ArchDirect& arch_direct);
+  const TileDirect& tile_direct, const ArchDirect& arch_direct,
+  const size_t& num_threads);
 
 } /* end namespace openfpga */
 
@@ -3,6 +3,7 @@
  * in the top module of FPGA fabric
  *******************************************************************/
 #include <cmath>
+#include <cstdint>
 
 /* Headers from vtrutil library */
 #include "vtr_assert.h"
@@ -22,6 +23,7 @@
 #include "memory_utils.h"
 #include "module_manager_utils.h"
 #include "openfpga_naming.h"
+#include "openfpga_parallel.h"
 #include "openfpga_reserved_words.h"
 #include "rr_gsb_utils.h"
 
@@ -537,61 +539,98 @@ void organize_top_module_memory_modules(
                                         config_protocol);
 }
 
+/********************************************************************
+ * A counter-based random number generator: the n-th number of a stream
+ * only depends on the seed, the stream and the counter, so that streams
+ * can be drawn in any order and by any thread.
+ * The mixing function is the finalizer of SplitMix64
+ ********************************************************************/
+static uint64_t counter_based_random(const uint64_t& seed,
+                                     const uint64_t& stream,
+                                     const uint64_t& counter) {
+  uint64_t z = seed + (stream + 1) * 0x9e3779b97f4a7c15ULL +
+               counter * 0xd1b54a32d192ed03ULL;
+  for (size_t iround = 0; iround < 2; ++iround) {
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    z = z ^ (z >> 31);
+  }
+  return z;
+}
+
 /********************************************************************
  * Shuffle the configurable children in a random sequence
  *
- * TODO: May use a more customized shuffle mechanism
- * TODO: Apply region-based shuffling
- *       The shuffling will be applied to each separated regions
- *       Configurable children will not shuffled from a region
- *       to another, instead they should stay in the same region
+ * The shuffling is applied to each configurable region separately:
+ * configurable children are not shuffled from a region to another;
+ * instead they stay in the same region.
+ * Each region draws its own random stream from the seed, so the regions
+ * are shuffled in parallel and the fabric key only depends on the seed,
+ * not on the number of threads.
  *
  * Note:
  *   - This function should NOT be called
- *     before allocating any configurable child
+ *     before allocating any configurable child and region
  ********************************************************************/
-void shuffle_top_module_configurable_children(
-  ModuleManager& module_manager, const ModuleId& top_module,
-  const ConfigProtocol& config_protocol) {
-  size_t num_keys =
-    module_manager
-      .configurable_children(top_module,
-                             ModuleManager::e_config_child_type::PHYSICAL)
-      .size();
-  std::vector<size_t> shuffled_keys;
-  shuffled_keys.reserve(num_keys);
-  for (size_t ikey = 0; ikey < num_keys; ++ikey) {
-    shuffled_keys.push_back(ikey);
+void shuffle_top_module_configurable_children(ModuleManager& module_manager,
+                                              const ModuleId& top_module,
+                                              const size_t& seed,
+                                              const size_t& num_threads) {
+  /* Cache the configurable children and their instances of each region */
+  std::vector<ConfigRegionId> config_regions;
+  for (const ConfigRegionId& config_region :
+       module_manager.regions(top_module)) {
+    config_regions.push_back(config_region);
+  }
+  std::vector<std::vector<ModuleId>> region_children(config_regions.size());
+  std::vector<std::vector<size_t>> region_child_instances(
+    config_regions.size());
+  std::vector<std::vector<vtr::Point<int>>> region_child_coordinates(
+    config_regions.size());
+  for (size_t iregion = 0; iregion < config_regions.size(); ++iregion) {
+    region_children[iregion] = module_manager.region_configurable_children(
+      top_module, config_regions[iregion]);
+    region_child_instances[iregion] =
+      module_manager.region_configurable_child_instances(
+        top_module, config_regions[iregion]);
+    region_child_coordinates[iregion] =
+      module_manager.region_configurable_child_coordinates(
+        top_module, config_regions[iregion]);
   }
 
-  std::random_shuffle(shuffled_keys.begin(), shuffled_keys.end());
-
-  /* Cache the configurable children and their instances */
-  std::vector<ModuleId> orig_configurable_children =
-    module_manager.configurable_children(
-      top_module, ModuleManager::e_config_child_type::PHYSICAL);
-  std::vector<size_t> orig_configurable_child_instances =
-    module_manager.configurable_child_instances(
-      top_module, ModuleManager::e_config_child_type::PHYSICAL);
-  std::vector<vtr::Point<int>> orig_configurable_child_coordinates =
-    module_manager.configurable_child_coordinates(
-      top_module, ModuleManager::e_config_child_type::PHYSICAL);
+  /* Fisher-Yates shuffle of each region with its own random stream */
+  std::vector<std::vector<size_t>> shuffled_keys(config_regions.size());
+  parallel_for(config_regions.size(), num_threads, [&](const size_t& iregion) {
+    size_t num_keys = region_children[iregion].size();
+    shuffled_keys[iregion].resize(num_keys);
+    for (size_t ikey = 0; ikey < num_keys; ++ikey) {
+      shuffled_keys[iregion][ikey] = ikey;
+    }
+    for (size_t ikey = num_keys; ikey > 1; --ikey) {
+      size_t jkey = counter_based_random(seed, iregion, ikey) % ikey;
+      std::swap(shuffled_keys[iregion][ikey - 1], shuffled_keys[iregion][jkey]);
+    }
+  });
 
-  /* Reorganize the configurable children */
+  /* Reorganize the configurable children region by region */
   module_manager.clear_configurable_children(top_module);
+  module_manager.clear_config_region(top_module);
 
-  for (size_t ikey = 0; ikey < num_keys; ++ikey) {
-    module_manager.add_configurable_child(
-      top_module, orig_configurable_children[shuffled_keys[ikey]],
-      orig_configurable_child_instances[shuffled_keys[ikey]],
-      ModuleManager::e_config_child_type::UNIFIED,
-      orig_configurable_child_coordinates[shuffled_keys[ikey]]);
+  size_t num_children = 0;
+  for (size_t iregion = 0; iregion < config_regions.size(); ++iregion) {
+    ConfigRegionId curr_region = module_manager.add_config_region(top_module);
+    for (const size_t& ikey : shuffled_keys[iregion]) {
+      module_manager.add_configurable_child(
+        top_module, region_children[iregion][ikey],
+        region_child_instances[iregion][ikey],
+        ModuleManager::e_config_child_type::UNIFIED,
+        region_child_coordinates[iregion][ikey]);
+      module_manager.add_configurable_child_to_region(
+        top_module, curr_region, region_children[iregion][ikey],
+        region_child_instances[iregion][ikey], num_children);
+      ++num_children;
+    }
   }
-
-  /* Reset configurable regions */
-  module_manager.clear_config_region(top_module);
-  build_top_module_configurable_regions(module_manager, top_module,
-                                        config_protocol);
 }
 
 /********************************************************************
@@ -613,6 +652,10 @@ int load_top_module_memory_modules_from_fabric_key(
 
   size_t curr_configurable_child_id = 0;
 
+  /* Index the instance names once, rather than searching them for each key */
+  ModuleInstanceNameLookup instance_lookup =
+    build_module_manager_instance_name_lookup(module_manager, top_module);
+
   for (const FabricRegionId& region : fabric_key.regions()) {
     /* Create a configurable region in the top module */
     ConfigRegionId top_module_config_region =
@@ -628,11 +671,14 @@ int load_top_module_memory_modules_from_fabric_key(
         if (!fabric_key.key_name(key).empty()) {
           instance_info.first =
             module_manager.find_module(fabric_key.key_name(key));
-          instance_info.second = module_manager.instance_id(
-            top_module, instance_info.first, fabric_key.key_alias(key));
+          if (true == module_manager.valid_module_id(instance_info.first)) {
+            instance_info.second = find_module_manager_instance_id(
+              module_manager, top_module, instance_lookup, instance_info.first,
+              fabric_key.key_alias(key));
+          }
         } else {
           instance_info = find_module_manager_instance_module_info(
-            module_manager, top_module, fabric_key.key_alias(key));
+            instance_lookup, fabric_key.key_alias(key));
         }
       } else {
         /* If we do not have an alias, we use the name and value to build the
@@ -1969,7 +2015,7 @@ static void add_top_module_nets_cmos_memory_config_bus(
   ModuleManager& module_manager, DecoderLibrary& decoder_lib,
   MemoryBankShiftRegisterBanks& blwl_sr_banks, const ModuleId& parent_module,
   const CircuitLibrary& circuit_lib, const ConfigProtocol& config_protocol,
-  const TopModuleNumConfigBits& num_config_bits) {
+  const TopModuleNumConfigBits& num_config_bits, const size_t& num_threads) {
   switch (config_protocol.type()) {
     case CONFIG_MEM_STANDALONE:
       add_module_nets_cmos_flatten_memory_config_bus(
@@ -1991,7 +2037,7 @@ static void add_top_module_nets_cmos_memory_config_bus(
     case CONFIG_MEM_QL_MEMORY_BANK:
       add_top_module_nets_cmos_ql_memory_bank_config_bus(
         module_manager, decoder_lib, blwl_sr_banks, parent_module, circuit_lib,
-        config_protocol, num_config_bits);
+        config_protocol, num_config_bits, num_threads);
       break;
     case CONFIG_MEM_FRAME_BASED:
       add_top_module_nets_cmos_memory_frame_config_bus(
@@ -2040,14 +2086,14 @@ void add_top_module_nets_memory_config_bus(
   MemoryBankShiftRegisterBanks& blwl_sr_banks, const ModuleId& parent_module,
   const CircuitLibrary& circuit_lib, const ConfigProtocol& config_protocol,
   const e_circuit_model_design_tech& mem_tech,
-  const TopModuleNumConfigBits& num_config_bits) {
+  const TopModuleNumConfigBits& num_config_bits, const size_t& num_threads) {
   vtr::ScopedStartFinishTimer timer("Add module nets for configuration buses");
 
   switch (mem_tech) {
     case CIRCUIT_MODEL_DESIGN_CMOS:
       add_top_module_nets_cmos_memory_config_bus(
         module_manager, decoder_lib, blwl_sr_banks, parent_module, circuit_lib,
-        config_protocol, num_config_bits);
+        config_protocol, num_config_bits, num_threads);
       break;
     case CIRCUIT_MODEL_DESIGN_RRAM:
       /* TODO: */
@@ -43,9 +43,10 @@ void build_top_module_configurable_regions(
   ModuleManager& module_manager, const ModuleId& top_module,
   const ConfigProtocol& config_protocol);
 
-void shuffle_top_module_configurable_children(
-  ModuleManager& module_manager, const ModuleId& top_module,
-  const ConfigProtocol& config_protocol);
+void shuffle_top_module_configurable_children(ModuleManager& module_manager,
+                                              const ModuleId& top_module,
+                                              const size_t& seed,
+                                              const size_t& num_threads);
 
 int load_top_module_memory_modules_from_fabric_key(
   ModuleManager& module_manager, const ModuleId& top_module,
@@ -69,7 +70,7 @@ void add_top_module_nets_memory_config_bus(
   MemoryBankShiftRegisterBanks& blwl_sr_banks, const ModuleId& parent_module,
   const CircuitLibrary& circuit_lib, const ConfigProtocol& config_protocol,
   const e_circuit_model_design_tech& mem_tech,
-  const TopModuleNumConfigBits& num_config_bits);
+  const TopModuleNumConfigBits& num_config_bits, const size_t& num_threads);
 
 } /* end namespace openfpga */
 
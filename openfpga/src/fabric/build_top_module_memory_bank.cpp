@@ -4,12 +4,16 @@
  *******************************************************************/
 #include <cmath>
 #include <limits>
+#include <vector>
 
 /* Headers from vtrutil library */
 #include "vtr_assert.h"
 #include "vtr_log.h"
 #include "vtr_time.h"
 
+/* Headers from openfpgautil library */
+#include "openfpga_parallel.h"
+
 /* Headers from vpr library */
 #include "vpr_utils.h"
 
@@ -23,6 +27,7 @@
 #include "memory_bank_utils.h"
 #include "memory_utils.h"
 #include "module_manager_utils.h"
+#include "module_net_buffer.h"
 #include "openfpga_naming.h"
 #include "openfpga_reserved_words.h"
 #include "rr_gsb_utils.h"
@@ -416,6 +421,68 @@ static ModuleId build_wl_shift_register_chain_module(
   return mem_module;
 }
 
+/*********************************************************************
+ * Stage the nets from a BL/WL bus, i.e., a port of the top-level module or
+ * the data outputs of a decoder, to the BL/WL ports of the configurable
+ * children of a region.
+ * For all the children in the same column (BL) or row (WL), their pins are
+ * driven by the same range of the bus, starting from the index of the tile.
+ * Each child pin is staged as a net with a single sink, which is merged
+ * with the other nets of the same bus pin by ModuleManager::append_nets()
+ *
+ * Note that children without the BL/WL port, e.g., decoders, are bypassed
+ **********************************************************************/
+static void stage_top_module_regional_blwl_nets(
+  ModuleNetBuffer& net_buffer, const ModuleManager& module_manager,
+  const ModuleId& top_module, const ConfigRegionId& config_region,
+  const ModuleId& bus_module, const size_t& bus_instance,
+  const ModulePortId& bus_port, const std::string& child_port_name,
+  const std::map<int, size_t>& start_index_per_tile,
+  const bool& index_by_column) {
+  BasicPort bus_port_info = module_manager.module_port(bus_module, bus_port);
+
+  /* These are copies, so fetch them once rather than per child */
+  std::vector<ModuleId> children =
+    module_manager.region_configurable_children(top_module, config_region);
+  std::vector<size_t> child_instances =
+    module_manager.region_configurable_child_instances(top_module,
+                                                       config_region);
+  std::vector<vtr::Point<int>> child_coords =
+    module_manager.region_configurable_child_coordinates(top_module,
+                                                         config_region);
+
+  for (size_t child_id = 0; child_id < children.size(); ++child_id) {
+    ModulePortId child_port =
+      module_manager.find_module_port(children[child_id], child_port_name);
+    if (!child_port) {
+      continue;
+    }
+    BasicPort child_port_info =
+      module_manager.module_port(children[child_id], child_port);
+    if (0 == child_port_info.get_width()) {
+      continue;
+    }
+
+    int tile_index = true == index_by_column ? child_coords[child_id].x()
+                                             : child_coords[child_id].y();
+    auto start_index = start_index_per_tile.find(tile_index);
+    VTR_ASSERT(start_index != start_index_per_tile.end());
+    VTR_ASSERT(start_index->second + child_port_info.get_width() <=
+               bus_port_info.get_width());
+
+    size_t cur_index = 0;
+    for (const size_t& sink_pin : child_port_info.pins()) {
+      size_t net = net_buffer.add_net(
+        bus_module, bus_instance, bus_port,
+        bus_port_info.pins()[start_index->second + cur_index]);
+      net_buffer.add_net_sink(net, children[child_id],
+                              child_instances[child_id], child_port,
+                              sink_pin);
+      cur_index++;
+    }
+  }
+}
+
 /*********************************************************************
  * This function to add nets for quicklogic memory banks
  * Each configuration region has independent memory bank circuitry
@@ -657,55 +724,13 @@ static void add_top_module_nets_cmos_ql_memory_bank_bl_decoder_config_bus(
      */
     ModulePortId bl_decoder_dout_port = module_manager.find_module_port(
       bl_decoder_module, std::string(DECODER_DATA_OUT_PORT_NAME));
-    BasicPort bl_decoder_dout_port_info =
-      module_manager.module_port(bl_decoder_module, bl_decoder_dout_port);
-
-    for (size_t child_id = 0;
-         child_id <
-         module_manager.region_configurable_children(top_module, config_region)
-           .size();
-         ++child_id) {
-      ModuleId child_module = module_manager.region_configurable_children(
-        top_module, config_region)[child_id];
-      vtr::Point<int> coord =
-        module_manager.region_configurable_child_coordinates(
-          top_module, config_region)[child_id];
-
-      size_t child_instance =
-        module_manager.region_configurable_child_instances(
-          top_module, config_region)[child_id];
 
-      /* Find the BL port */
-      ModulePortId child_bl_port = module_manager.find_module_port(
-        child_module, std::string(MEMORY_BL_PORT_NAME));
-      BasicPort child_bl_port_info =
-        module_manager.module_port(child_module, child_bl_port);
-
-      size_t cur_bl_index = 0;
-
-      for (const size_t& sink_bl_pin : child_bl_port_info.pins()) {
-        size_t bl_pin_id = bl_start_index_per_tile[coord.x()] + cur_bl_index;
-        /* Find the BL decoder data index:
-         * It should be the starting index plus an offset which is the residual
-         * when divided by the number of BLs in this tile
-         */
-        VTR_ASSERT(bl_pin_id < bl_decoder_dout_port_info.pins().size());
-
-        /* Create net */
-        ModuleNetId net = create_module_source_pin_net(
-          module_manager, top_module, bl_decoder_module,
-          curr_bl_decoder_instance_id, bl_decoder_dout_port,
-          bl_decoder_dout_port_info.pins()[bl_pin_id]);
-        VTR_ASSERT(ModuleNetId::INVALID() != net);
-
-        /* Add net sink */
-        module_manager.add_module_net_sink(top_module, net, child_module,
-                                           child_instance, child_bl_port,
-                                           sink_bl_pin);
-
-        cur_bl_index++;
-      }
-    }
+    ModuleNetBuffer bl_net_buffer;
+    stage_top_module_regional_blwl_nets(
+      bl_net_buffer, module_manager, top_module, config_region,
+      bl_decoder_module, curr_bl_decoder_instance_id, bl_decoder_dout_port,
+      std::string(MEMORY_BL_PORT_NAME), bl_start_index_per_tile, true);
+    module_manager.append_nets(top_module, bl_net_buffer);
 
     /**************************************************************
      * Add the BL and WL decoders to the end of configurable children list
@@ -872,114 +897,27 @@ static void add_top_module_nets_cmos_ql_memory_bank_wl_decoder_config_bus(
      */
     ModulePortId wl_decoder_dout_port = module_manager.find_module_port(
       wl_decoder_module, std::string(DECODER_DATA_OUT_PORT_NAME));
-    BasicPort wl_decoder_dout_port_info =
-      module_manager.module_port(wl_decoder_module, wl_decoder_dout_port);
-
-    /* Note we skip the last child which is the bl decoder added */
-    for (size_t child_id = 0;
-         child_id <
-         module_manager.region_configurable_children(top_module, config_region)
-           .size();
-         ++child_id) {
-      ModuleId child_module = module_manager.region_configurable_children(
-        top_module, config_region)[child_id];
-      vtr::Point<int> coord =
-        module_manager.region_configurable_child_coordinates(
-          top_module, config_region)[child_id];
-
-      size_t child_instance =
-        module_manager.region_configurable_child_instances(
-          top_module, config_region)[child_id];
-
-      /* Find the WL port. If the child does not have WL port, bypass it. It is
-       * usually a decoder module */
-      ModulePortId child_wl_port = module_manager.find_module_port(
-        child_module, std::string(MEMORY_WL_PORT_NAME));
-      if (!child_wl_port) {
-        continue;
-      }
-      BasicPort child_wl_port_info =
-        module_manager.module_port(child_module, child_wl_port);
-
-      size_t cur_wl_index = 0;
-
-      for (const size_t& sink_wl_pin : child_wl_port_info.pins()) {
-        size_t wl_pin_id = wl_start_index_per_tile[coord.y()] + cur_wl_index;
-        VTR_ASSERT(wl_pin_id < wl_decoder_dout_port_info.pins().size());
-
-        /* Create net */
-        ModuleNetId net = create_module_source_pin_net(
-          module_manager, top_module, wl_decoder_module,
-          curr_wl_decoder_instance_id, wl_decoder_dout_port,
-          wl_decoder_dout_port_info.pins()[wl_pin_id]);
-        VTR_ASSERT(ModuleNetId::INVALID() != net);
-
-        /* Add net sink */
-        module_manager.add_module_net_sink(top_module, net, child_module,
-                                           child_instance, child_wl_port,
-                                           sink_wl_pin);
 
-        cur_wl_index++;
-      }
-    }
+    /* The BL decoder added to the region has no WL port and is bypassed */
+    ModuleNetBuffer wl_net_buffer;
+    stage_top_module_regional_blwl_nets(
+      wl_net_buffer, module_manager, top_module, config_region,
+      wl_decoder_module, curr_wl_decoder_instance_id, wl_decoder_dout_port,
+      std::string(MEMORY_WL_PORT_NAME), wl_start_index_per_tile, false);
 
     /**************************************************************
      * Optional: Add nets from WLR data out to each configurable child
      */
     ModulePortId wl_decoder_data_ren_port = module_manager.find_module_port(
       wl_decoder_module, std::string(DECODER_DATA_READ_ENABLE_PORT_NAME));
-    BasicPort wl_decoder_data_ren_port_info;
     if (wl_decoder_data_ren_port) {
-      wl_decoder_data_ren_port_info =
-        module_manager.module_port(wl_decoder_module, wl_decoder_data_ren_port);
-      for (size_t child_id = 0;
-           child_id < module_manager
-                        .region_configurable_children(top_module, config_region)
-                        .size();
-           ++child_id) {
-        ModuleId child_module = module_manager.region_configurable_children(
-          top_module, config_region)[child_id];
-        vtr::Point<int> coord =
-          module_manager.region_configurable_child_coordinates(
-            top_module, config_region)[child_id];
-
-        size_t child_instance =
-          module_manager.region_configurable_child_instances(
-            top_module, config_region)[child_id];
-
-        /* Find the WLR port. If the child does not have WLR port, bypass it. It
-         * is usually a decoder module */
-        ModulePortId child_wlr_port = module_manager.find_module_port(
-          child_module, std::string(MEMORY_WLR_PORT_NAME));
-        if (!child_wlr_port) {
-          continue;
-        }
-        BasicPort child_wlr_port_info =
-          module_manager.module_port(child_module, child_wlr_port);
-
-        size_t cur_wlr_index = 0;
-
-        for (const size_t& sink_wlr_pin : child_wlr_port_info.pins()) {
-          size_t wlr_pin_id =
-            wl_start_index_per_tile[coord.y()] + cur_wlr_index;
-          VTR_ASSERT(wlr_pin_id < wl_decoder_data_ren_port_info.pins().size());
-
-          /* Create net */
-          ModuleNetId net = create_module_source_pin_net(
-            module_manager, top_module, wl_decoder_module,
-            curr_wl_decoder_instance_id, wl_decoder_data_ren_port,
-            wl_decoder_data_ren_port_info.pins()[wlr_pin_id]);
-          VTR_ASSERT(ModuleNetId::INVALID() != net);
-
-          /* Add net sink */
-          module_manager.add_module_net_sink(top_module, net, child_module,
-                                             child_instance, child_wlr_port,
-                                             sink_wlr_pin);
-
-          cur_wlr_index++;
-        }
-      }
+      stage_top_module_regional_blwl_nets(
+        wl_net_buffer, module_manager, top_module, config_region,
+        wl_decoder_module, curr_wl_decoder_instance_id,
+        wl_decoder_data_ren_port, std::string(MEMORY_WLR_PORT_NAME),
+        wl_start_index_per_tile, false);
     }
+    module_manager.append_nets(top_module, wl_net_buffer);
 
     /**************************************************************
      * Add the BL and WL decoders to the end of configurable children list
@@ -1046,11 +984,22 @@ static void add_top_module_nets_cmos_ql_memory_bank_wl_decoder_config_bus(
  **********************************************************************/
 static void add_top_module_nets_cmos_ql_memory_bank_bl_flatten_config_bus(
   ModuleManager& module_manager, const ModuleId& top_module,
-  const CircuitLibrary& circuit_lib, const CircuitModelId& sram_model) {
+  const CircuitLibrary& circuit_lib, const CircuitModelId& sram_model,
+  const size_t& num_threads) {
   /* Create connections between BLs of top-level module and BLs of child modules
-   * for each region */
+   * for each region. Regions are independent from each other, so that their
+   * nets are staged in parallel, while the module manager is only read, and
+   * then added to the top module in the order of regions */
+  std::vector<ConfigRegionId> config_regions;
   for (const ConfigRegionId& config_region :
        module_manager.regions(top_module)) {
+    config_regions.push_back(config_region);
+  }
+  std::vector<ModuleNetBuffer> net_buffers(config_regions.size());
+
+  const ModuleManager& const_module_manager = module_manager;
+  parallel_for(config_regions.size(), num_threads, [&](const size_t& ireg) {
+    const ConfigRegionId& config_region = config_regions[ireg];
     /**************************************************************
      * Precompute the BLs and WLs distribution across the FPGA fabric
      * The distribution is a matrix which contains the starting index of BL/WL
@@ -1058,10 +1007,11 @@ static void add_top_module_nets_cmos_ql_memory_bank_bl_flatten_config_bus(
      */
     std::pair<int, int> child_x_range =
       compute_memory_bank_regional_configurable_child_x_range(
-        module_manager, top_module, config_region);
+        const_module_manager, top_module, config_region);
     std::map<int, size_t> num_bls_per_tile =
       compute_memory_bank_regional_bitline_numbers_per_tile(
-        module_manager, top_module, config_region, circuit_lib, sram_model);
+        const_module_manager, top_module, config_region, circuit_lib,
+        sram_model);
     std::map<int, size_t> bl_start_index_per_tile =
       compute_memory_bank_regional_blwl_start_index_per_tile(child_x_range,
                                                              num_bls_per_tile);
@@ -1088,54 +1038,16 @@ static void add_top_module_nets_cmos_ql_memory_bank_bl_flatten_config_bus(
      *     |   +---------+
      *     |
      */
-    ModulePortId top_module_bl_port = module_manager.find_module_port(
+    ModulePortId top_module_bl_port = const_module_manager.find_module_port(
       top_module, generate_regional_blwl_port_name(
                     std::string(MEMORY_BL_PORT_NAME), config_region));
-    BasicPort top_module_bl_port_info =
-      module_manager.module_port(top_module, top_module_bl_port);
-
-    for (size_t child_id = 0;
-         child_id <
-         module_manager.region_configurable_children(top_module, config_region)
-           .size();
-         ++child_id) {
-      ModuleId child_module = module_manager.region_configurable_children(
-        top_module, config_region)[child_id];
-      vtr::Point<int> coord =
-        module_manager.region_configurable_child_coordinates(
-          top_module, config_region)[child_id];
-
-      size_t child_instance =
-        module_manager.region_configurable_child_instances(
-          top_module, config_region)[child_id];
-
-      /* Find the BL port */
-      ModulePortId child_bl_port = module_manager.find_module_port(
-        child_module, std::string(MEMORY_BL_PORT_NAME));
-      BasicPort child_bl_port_info =
-        module_manager.module_port(child_module, child_bl_port);
-
-      size_t cur_bl_index = 0;
+    stage_top_module_regional_blwl_nets(
+      net_buffers[ireg], const_module_manager, top_module, config_region,
+      top_module, 0, top_module_bl_port, std::string(MEMORY_BL_PORT_NAME),
+      bl_start_index_per_tile, true);
+  });
 
-      for (const size_t& sink_bl_pin : child_bl_port_info.pins()) {
-        size_t bl_pin_id = bl_start_index_per_tile[coord.x()] + cur_bl_index;
-        VTR_ASSERT(bl_pin_id < top_module_bl_port_info.pins().size());
-
-        /* Create net */
-        ModuleNetId net = create_module_source_pin_net(
-          module_manager, top_module, top_module, 0, top_module_bl_port,
-          top_module_bl_port_info.pins()[bl_pin_id]);
-        VTR_ASSERT(ModuleNetId::INVALID() != net);
-
-        /* Add net sink */
-        module_manager.add_module_net_sink(top_module, net, child_module,
-                                           child_instance, child_bl_port,
-                                           sink_bl_pin);
-
-        cur_bl_index++;
-      }
-    }
-  }
+  module_manager.append_nets(top_module, net_buffers);
 }
 
 /*********************************************************************
@@ -1152,11 +1064,21 @@ static void add_top_module_nets_cmos_ql_memory_bank_bl_flatten_config_bus(
  **********************************************************************/
 static void add_top_module_nets_cmos_ql_memory_bank_wl_flatten_config_bus(
   ModuleManager& module_manager, const ModuleId& top_module,
-  const CircuitLibrary& circuit_lib, const CircuitModelId& sram_model) {
+  const CircuitLibrary& circuit_lib, const CircuitModelId& sram_model,
+  const size_t& num_threads) {
   /* Create connections between WLs of top-level module and WLs of child modules
-   * for each region */
+   * for each region. Same as the BLs, the nets of each region are staged in
+   * parallel and then added to the top module in the order of regions */
+  std::vector<ConfigRegionId> config_regions;
   for (const ConfigRegionId& config_region :
        module_manager.regions(top_module)) {
+    config_regions.push_back(config_region);
+  }
+  std::vector<ModuleNetBuffer> net_buffers(config_regions.size());
+
+  const ModuleManager& const_module_manager = module_manager;
+  parallel_for(config_regions.size(), num_threads, [&](const size_t& ireg) {
+    const ConfigRegionId& config_region = config_regions[ireg];
     /**************************************************************
      * Precompute the BLs and WLs distribution across the FPGA fabric
      * The distribution is a matrix which contains the starting index of BL/WL
@@ -1164,10 +1086,11 @@ static void add_top_module_nets_cmos_ql_memory_bank_wl_flatten_config_bus(
      */
     std::pair<int, int> child_y_range =
       compute_memory_bank_regional_configurable_child_y_range(
-        module_manager, top_module, config_region);
+        const_module_manager, top_module, config_region);
     std::map<int, size_t> num_wls_per_tile =
       compute_memory_bank_regional_wordline_numbers_per_tile(
-        module_manager, top_module, config_region, circuit_lib, sram_model);
+        const_module_manager, top_module, config_region, circuit_lib,
+        sram_model);
     std::map<int, size_t> wl_start_index_per_tile =
       compute_memory_bank_regional_blwl_start_index_per_tile(child_y_range,
                                                              num_wls_per_tile);
@@ -1175,108 +1098,29 @@ static void add_top_module_nets_cmos_ql_memory_bank_wl_flatten_config_bus(
     /**************************************************************
      * Add WL nets from top module to each configurable child
      */
-    ModulePortId top_module_wl_port = module_manager.find_module_port(
+    ModulePortId top_module_wl_port = const_module_manager.find_module_port(
       top_module, generate_regional_blwl_port_name(
                     std::string(MEMORY_WL_PORT_NAME), config_region));
-    BasicPort top_module_wl_port_info =
-      module_manager.module_port(top_module, top_module_wl_port);
-
-    for (size_t child_id = 0;
-         child_id <
-         module_manager.region_configurable_children(top_module, config_region)
-           .size();
-         ++child_id) {
-      ModuleId child_module = module_manager.region_configurable_children(
-        top_module, config_region)[child_id];
-      vtr::Point<int> coord =
-        module_manager.region_configurable_child_coordinates(
-          top_module, config_region)[child_id];
-
-      size_t child_instance =
-        module_manager.region_configurable_child_instances(
-          top_module, config_region)[child_id];
-
-      /* Find the WL port */
-      ModulePortId child_wl_port = module_manager.find_module_port(
-        child_module, std::string(MEMORY_WL_PORT_NAME));
-      BasicPort child_wl_port_info =
-        module_manager.module_port(child_module, child_wl_port);
-
-      size_t cur_wl_index = 0;
-
-      for (const size_t& sink_wl_pin : child_wl_port_info.pins()) {
-        size_t wl_pin_id = wl_start_index_per_tile[coord.y()] + cur_wl_index;
-        VTR_ASSERT(wl_pin_id < top_module_wl_port_info.pins().size());
-
-        /* Create net */
-        ModuleNetId net = create_module_source_pin_net(
-          module_manager, top_module, top_module, 0, top_module_wl_port,
-          top_module_wl_port_info.pins()[wl_pin_id]);
-        VTR_ASSERT(ModuleNetId::INVALID() != net);
-
-        /* Add net sink */
-        module_manager.add_module_net_sink(top_module, net, child_module,
-                                           child_instance, child_wl_port,
-                                           sink_wl_pin);
-
-        cur_wl_index++;
-      }
-    }
+    stage_top_module_regional_blwl_nets(
+      net_buffers[ireg], const_module_manager, top_module, config_region,
+      top_module, 0, top_module_wl_port, std::string(MEMORY_WL_PORT_NAME),
+      wl_start_index_per_tile, false);
 
     /**************************************************************
      * Optional: Add WLR nets from top module to each configurable child
      */
-    ModulePortId top_module_wlr_port = module_manager.find_module_port(
+    ModulePortId top_module_wlr_port = const_module_manager.find_module_port(
       top_module, generate_regional_blwl_port_name(
                     std::string(MEMORY_WLR_PORT_NAME), config_region));
-    BasicPort top_module_wlr_port_info;
     if (top_module_wlr_port) {
-      top_module_wlr_port_info =
-        module_manager.module_port(top_module, top_module_wlr_port);
-      for (size_t child_id = 0;
-           child_id < module_manager
-                        .region_configurable_children(top_module, config_region)
-                        .size();
-           ++child_id) {
-        ModuleId child_module = module_manager.region_configurable_children(
-          top_module, config_region)[child_id];
-        vtr::Point<int> coord =
-          module_manager.region_configurable_child_coordinates(
-            top_module, config_region)[child_id];
-
-        size_t child_instance =
-          module_manager.region_configurable_child_instances(
-            top_module, config_region)[child_id];
-
-        /* Find the WL port */
-        ModulePortId child_wlr_port = module_manager.find_module_port(
-          child_module, std::string(MEMORY_WLR_PORT_NAME));
-        BasicPort child_wlr_port_info =
-          module_manager.module_port(child_module, child_wlr_port);
-
-        size_t cur_wlr_index = 0;
-
-        for (const size_t& sink_wlr_pin : child_wlr_port_info.pins()) {
-          size_t wlr_pin_id =
-            wl_start_index_per_tile[coord.y()] + cur_wlr_index;
-          VTR_ASSERT(wlr_pin_id < top_module_wlr_port_info.pins().size());
-
-          /* Create net */
-          ModuleNetId net = create_module_source_pin_net(
-            module_manager, top_module, top_module, 0, top_module_wlr_port,
-            top_module_wlr_port_info.pins()[wlr_pin_id]);
-          VTR_ASSERT(ModuleNetId::INVALID() != net);
-
-          /* Add net sink */
-          module_manager.add_module_net_sink(top_module, net, child_module,
-                                             child_instance, child_wlr_port,
-                                             sink_wlr_pin);
-
-          cur_wlr_index++;
-        }
-      }
+      stage_top_module_regional_blwl_nets(
+        net_buffers[ireg], const_module_manager, top_module, config_region,
+        top_module, 0, top_module_wlr_port, std::string(MEMORY_WLR_PORT_NAME),
+        wl_start_index_per_tile, false);
     }
-  }
+  });
+
+  module_manager.append_nets(top_module, net_buffers);
 }
 
 /*********************************************************************
@@ -1979,12 +1823,14 @@ add_top_module_nets_cmos_ql_memory_bank_wl_shift_register_config_bus(
  *modules
  *   - TODO: Shift registers: add blocks of shift register chain (could be
  *multi-head); Connect shift register outputs to configurable child modules
+ *
+ * - The flatten BL/WLs of the regions are built by up to num_threads threads
  ********************************************************************/
 void add_top_module_nets_cmos_ql_memory_bank_config_bus(
   ModuleManager& module_manager, DecoderLibrary& decoder_lib,
   MemoryBankShiftRegisterBanks& blwl_sr_banks, const ModuleId& top_module,
   const CircuitLibrary& circuit_lib, const ConfigProtocol& config_protocol,
-  const TopModuleNumConfigBits& num_config_bits) {
+  const TopModuleNumConfigBits& num_config_bits, const size_t& num_threads) {
   VTR_ASSERT_SAFE(CONFIG_MEM_QL_MEMORY_BANK == config_protocol.type());
   CircuitModelId sram_model = config_protocol.memory_model();
 
@@ -1997,7 +1843,7 @@ void add_top_module_nets_cmos_ql_memory_bank_config_bus(
     }
     case BLWL_PROTOCOL_FLATTEN: {
       add_top_module_nets_cmos_ql_memory_bank_bl_flatten_config_bus(
-        module_manager, top_module, circuit_lib, sram_model);
+        module_manager, top_module, circuit_lib, sram_model, num_threads);
       break;
     }
     case BLWL_PROTOCOL_SHIFT_REGISTER: {
@@ -2021,7 +1867,7 @@ void add_top_module_nets_cmos_ql_memory_bank_config_bus(
     }
     case BLWL_PROTOCOL_FLATTEN: {
       add_top_module_nets_cmos_ql_memory_bank_wl_flatten_config_bus(
-        module_manager, top_module, circuit_lib, sram_model);
+        module_manager, top_module, circuit_lib, sram_model, num_threads);
       break;
     }
     case BLWL_PROTOCOL_SHIFT_REGISTER: {
@@ -29,7 +29,7 @@ void add_top_module_nets_cmos_ql_memory_bank_config_bus(
   ModuleManager& module_manager, DecoderLibrary& decoder_lib,
   MemoryBankShiftRegisterBanks& blwl_sr_banks, const ModuleId& top_module,
   const CircuitLibrary& circuit_lib, const ConfigProtocol& config_protocol,
-  const TopModuleNumConfigBits& num_config_bits);
+  const TopModuleNumConfigBits& num_config_bits, const size_t& num_threads);
 
 void add_top_module_ql_memory_bank_sram_ports(
   ModuleManager& module_manager, const ModuleId& module_id,
@@ -0,0 +1,384 @@
+/***************************************************************************************
+ * Save the module graph of a FPGA fabric and all its companion data structures
+ * to a binary database, and load them back. This allows a flow to skip the
+ * fabric generation when the inputs are not changed.
+ *
+ * The database is organized as follows:
+ *   - a header: a magic word, the format version and a key which is computed
+ *     by the caller from the inputs of the fabric generation
+ *   - a list of sections, each starts with a section id and the number of
+ *     bytes of its payload, so that a corrupted file can be detected.
+ * The circuit models are not part of the key. Instead, the first section
+ * contains the structural fingerprints of the circuit models (see
+ * module_circuit_model_dependency.h), so that a fabric can still be reused
+ * when only non-structural attributes of circuit models are changed, and the
+ * modules to be rebuilt can be reported otherwise.
+ * The payloads mostly contain flat arrays (see openfpga_binary_io.h).
+ ***************************************************************************************/
+#include <cstring>
+#include <fstream>
+#include <sstream>
+
+/* Headers from vtrutil library */
+#include "vtr_assert.h"
+#include "vtr_log.h"
+#include "vtr_time.h"
+
+/* Headers from openfpgautil library */
+#include "command_exit_codes.h"
+#include "fabric_database.h"
+#include "module_circuit_model_dependency.h"
+#include "openfpga_binary_io.h"
+#include "openfpga_digest.h"
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+/* Identify the type of file; change the version whenever the layout of any
+ * data structure in the database changes */
+constexpr char FABRIC_DATABASE_MAGIC[] = "OFPGAFDB";
+constexpr size_t FABRIC_DATABASE_MAGIC_SIZE = sizeof(FABRIC_DATABASE_MAGIC) - 1;
+constexpr uint32_t FABRIC_DATABASE_VERSION = 3;
+
+/* Sections of the database, which are stored in this order */
+enum e_fabric_database_section : uint32_t {
+  FABRIC_DATABASE_CIRCUIT_MODELS,
+  FABRIC_DATABASE_MODULE_GRAPH,
+  FABRIC_DATABASE_MODULE_NAME_MAP,
+  FABRIC_DATABASE_DECODER_LIBRARY,
+  FABRIC_DATABASE_SHIFT_REGISTER_BANKS,
+  FABRIC_DATABASE_FABRIC_TILE,
+  FABRIC_DATABASE_GLOBAL_PORT_INFO,
+  FABRIC_DATABASE_UNIQUE_GSB,
+  NUM_FABRIC_DATABASE_SECTIONS
+};
+
+/***************************************************************************************
+ * The module name map only has string pairs and aliases, which can be saved
+ * through its public accessors
+ ***************************************************************************************/
+static void write_module_name_map_binary(std::ostream& fp,
+                                         const ModuleNameMap& module_name_map) {
+  std::vector<std::string> tags = module_name_map.tags();
+  write_binary_size(fp, tags.size());
+  for (const std::string& tag : tags) {
+    write_binary_data(fp, tag);
+    write_binary_data(fp, module_name_map.name(tag));
+  }
+  std::vector<std::string> alias_tags = module_name_map.alias_tags();
+  write_binary_size(fp, alias_tags.size());
+  for (const std::string& alias : alias_tags) {
+    write_binary_data(fp, alias);
+    write_binary_data(fp, module_name_map.alias_tag(alias));
+  }
+}
+
+static int read_module_name_map_binary(std::istream& fp,
+                                       ModuleNameMap& module_name_map) {
+  module_name_map.clear();
+  size_t num_tags = read_binary_container_size(fp, 2);
+  for (size_t itag = 0; itag < num_tags; ++itag) {
+    std::string tag;
+    std::string name;
+    read_binary_data(fp, tag);
+    read_binary_data(fp, name);
+    int status = module_name_map.set_tag_to_name_pair(tag, name);
+    if (CMD_EXEC_SUCCESS != status) {
+      return status;
+    }
+  }
+  size_t num_aliases = read_binary_container_size(fp, 2);
+  for (size_t ialias = 0; ialias < num_aliases; ++ialias) {
+    std::string alias;
+    std::string tag;
+    read_binary_data(fp, alias);
+    read_binary_data(fp, tag);
+    int status = module_name_map.set_tag_alias(alias, tag);
+    if (CMD_EXEC_SUCCESS != status) {
+      return status;
+    }
+  }
+  return CMD_EXEC_SUCCESS;
+}
+
+/***************************************************************************************
+ * Write a section: the payload is built in memory first, as its size has to
+ * be written ahead
+ ***************************************************************************************/
+static void write_fabric_database_section(
+  std::ostream& fp, const e_fabric_database_section& section,
+  const std::ostringstream& payload) {
+  std::string data = payload.str();
+  write_binary_data(fp, uint32_t(section));
+  write_binary_size(fp, data.size());
+  fp.write(data.data(), data.size());
+}
+
+/***************************************************************************************
+ * Check the header of a section before reading its payload
+ ***************************************************************************************/
+static bool read_fabric_database_section_header(
+  std::istream& fp, const e_fabric_database_section& section,
+  size_t& num_bytes) {
+  uint32_t section_id = NUM_FABRIC_DATABASE_SECTIONS;
+  read_binary_data(fp, section_id);
+  num_bytes = read_binary_container_size(fp, 1);
+  return fp.good() && (uint32_t(section) == section_id);
+}
+
+/***************************************************************************************
+ * Report the circuit models whose structures are changed since the database
+ * was written, and the modules which depend on them and would be rebuilt.
+ * The module graph is loaded aside, which does not touch the fabric
+ ***************************************************************************************/
+static void report_fabric_database_changed_circuit_models(
+  std::istream& fp, const std::vector<std::string>& changed_models,
+  const bool& verbose) {
+  VTR_LOG("Structures of %lu circuit models are changed since the fabric "
+          "database was written:\n",
+          changed_models.size());
+  for (const std::string& model : changed_models) {
+    VTR_LOG("\t%s\n", model.c_str());
+  }
+
+  size_t num_bytes = 0;
+  if (false == read_fabric_database_section_header(
+                 fp, FABRIC_DATABASE_MODULE_GRAPH, num_bytes)) {
+    return;
+  }
+  ModuleManager module_manager;
+  module_manager.read_binary(fp);
+  if (false == fp.good()) {
+    return;
+  }
+  std::vector<ModuleId> modules =
+    find_modules_depending_on_circuit_models(module_manager, changed_models);
+  VTR_LOG("%lu out of %lu modules depend on these circuit models\n",
+          modules.size(), module_manager.num_modules());
+  for (const ModuleId& module : modules) {
+    VTR_LOGV(verbose, "\t%s\n", module_manager.module_name(module).c_str());
+  }
+}
+
+/***************************************************************************************
+ * Write the fabric database to a binary file.
+ * The key should be computed from all the inputs of the fabric generation. It
+ * will be compared with the key of the current inputs when loading the file.
+ *
+ * Return 0 if successful
+ * Return 1 if fail when creating files
+ ***************************************************************************************/
+int write_fabric_database(
+  const std::string& fname, const size_t& key,
+  const std::map<std::string, size_t>& circuit_model_fingerprints,
+  const ModuleManager& module_manager, const ModuleNameMap& module_name_map,
+  const DecoderLibrary& decoder_lib,
+  const MemoryBankShiftRegisterBanks& blwl_sr_banks,
+  const FabricTile& fabric_tile, const FabricGlobalPortInfo& global_ports,
+  const DeviceRRGSB& device_rr_gsb, const bool& verbose) {
+  std::string timer_message =
+    std::string("Write fabric database to binary file '") + fname +
+    std::string("'");
+
+  std::string dir_path = format_dir_path(find_path_dir_name(fname));
+
+  /* Create directories */
+  create_directory(dir_path);
+
+  /* Start time count */
+  vtr::ScopedStartFinishTimer timer(timer_message);
+
+  VTR_ASSERT(true != fname.empty());
+
+  /* Create a file handler*/
+  std::fstream fp;
+  /* Open a file */
+  fp.open(fname, std::fstream::out | std::fstream::trunc |
+                   std::fstream::binary);
+
+  /* Validate the file stream */
+  check_file_stream(fname.c_str(), fp);
+
+  /* Header */
+  fp.write(FABRIC_DATABASE_MAGIC, FABRIC_DATABASE_MAGIC_SIZE);
+  write_binary_data(fp, FABRIC_DATABASE_VERSION);
+  write_binary_data(fp, uint64_t(key));
+
+  /* Sections */
+  std::ostringstream payload(std::ios::binary);
+  write_binary_data(payload, circuit_model_fingerprints);
+  write_fabric_database_section(fp, FABRIC_DATABASE_CIRCUIT_MODELS, payload);
+
+  payload.str(std::string());
+  module_manager.write_binary(payload);
+  write_fabric_database_section(fp, FABRIC_DATABASE_MODULE_GRAPH, payload);
+  VTR_LOGV(verbose, "Written %lu modules\n", module_manager.num_modules());
+
+  payload.str(std::string());
+  write_module_name_map_binary(payload, module_name_map);
+  write_fabric_database_section(fp, FABRIC_DATABASE_MODULE_NAME_MAP, payload);
+
+  payload.str(std::string());
+  decoder_lib.write_binary(payload);
+  write_fabric_database_section(fp, FABRIC_DATABASE_DECODER_LIBRARY, payload);
+
+  payload.str(std::string());
+  blwl_sr_banks.write_binary(payload);
+  write_fabric_database_section(fp, FABRIC_DATABASE_SHIFT_REGISTER_BANKS,
+                                payload);
+
+  payload.str(std::string());
+  fabric_tile.write_binary(payload);
+  write_fabric_database_section(fp, FABRIC_DATABASE_FABRIC_TILE, payload);
+
+  payload.str(std::string());
+  global_ports.write_binary(payload);
+  write_fabric_database_section(fp, FABRIC_DATABASE_GLOBAL_PORT_INFO, payload);
+
+  payload.str(std::string());
+  device_rr_gsb.write_unique_modules_binary(payload);
+  write_fabric_database_section(fp, FABRIC_DATABASE_UNIQUE_GSB, payload);
+
+  if (false == fp.good()) {
+    VTR_LOG_ERROR("Fail to write fabric database to file '%s'!\n",
+                  fname.c_str());
+    fp.close();
+    return CMD_EXEC_FATAL_ERROR;
+  }
+
+  /* close a file */
+  fp.close();
+
+  return CMD_EXEC_SUCCESS;
+}
+
+/***************************************************************************************
+ * Read the fabric database from a binary file.
+ * The data structures are not touched unless the file is created by the same
+ * version of the database, with the same key as the given one and with the
+ * same structural fingerprints of circuit models.
+ *
+ * Return 0 if successful
+ * Return 1 if the file is corrupted. The data structures are then incomplete
+ * Return 2 if the file does not exist or is outdated, which means that the
+ * fabric should be built again
+ ***************************************************************************************/
+int read_fabric_database(
+  const std::string& fname, const size_t& key,
+  const std::map<std::string, size_t>& circuit_model_fingerprints,
+  ModuleManager& module_manager, ModuleNameMap& module_name_map,
+  DecoderLibrary& decoder_lib, MemoryBankShiftRegisterBanks& blwl_sr_banks,
+  FabricTile& fabric_tile, FabricGlobalPortInfo& global_ports,
+  DeviceRRGSB& device_rr_gsb, const bool& verbose) {
+  std::string timer_message =
+    std::string("Read fabric database from binary file '") + fname +
+    std::string("'");
+
+  /* Start time count */
+  vtr::ScopedStartFinishTimer timer(timer_message);
+
+  std::fstream fp;
+  fp.open(fname, std::fstream::in | std::fstream::binary);
+  if (false == valid_file_stream(fp)) {
+    VTR_LOG("Fabric database '%s' does not exist\n", fname.c_str());
+    return CMD_EXEC_MINOR_ERROR;
+  }
+
+  /* Header */
+  char magic[FABRIC_DATABASE_MAGIC_SIZE];
+  uint32_t version = 0;
+  uint64_t file_key = 0;
+  fp.read(magic, FABRIC_DATABASE_MAGIC_SIZE);
+  read_binary_data(fp, version);
+  read_binary_data(fp, file_key);
+  if ((false == fp.good()) ||
+      (0 != std::memcmp(magic, FABRIC_DATABASE_MAGIC,
+                        FABRIC_DATABASE_MAGIC_SIZE))) {
+    VTR_LOG_ERROR("File '%s' is not a fabric database!\n", fname.c_str());
+    return CMD_EXEC_FATAL_ERROR;
+  }
+  if (FABRIC_DATABASE_VERSION != version) {
+    VTR_LOG("Fabric database '%s' has version %u while version %u is "
+            "expected\n",
+            fname.c_str(), version, FABRIC_DATABASE_VERSION);
+    return CMD_EXEC_MINOR_ERROR;
+  }
+  if (uint64_t(key) != file_key) {
+    VTR_LOG(
+      "Fabric database '%s' was not created with the current inputs\n",
+      fname.c_str());
+    return CMD_EXEC_MINOR_ERROR;
+  }
+
+  /* Circuit models are checked before touching any data structure */
+  size_t num_bytes = 0;
+  std::map<std::string, size_t> file_fingerprints;
+  if (false == read_fabric_database_section_header(
+                 fp, FABRIC_DATABASE_CIRCUIT_MODELS, num_bytes)) {
+    VTR_LOG_ERROR("Fabric database '%s' is corrupted: section %u is "
+                  "missing!\n",
+                  fname.c_str(), uint32_t(FABRIC_DATABASE_CIRCUIT_MODELS));
+    return CMD_EXEC_FATAL_ERROR;
+  }
+  read_binary_data(fp, file_fingerprints);
+  std::vector<std::string> changed_models =
+    find_changed_circuit_models(file_fingerprints, circuit_model_fingerprints);
+  if (false == changed_models.empty()) {
+    report_fabric_database_changed_circuit_models(fp, changed_models, verbose);
+    return CMD_EXEC_MINOR_ERROR;
+  }
+
+  /* Sections */
+  for (uint32_t isec = FABRIC_DATABASE_MODULE_GRAPH;
+       isec < NUM_FABRIC_DATABASE_SECTIONS; ++isec) {
+    e_fabric_database_section section = e_fabric_database_section(isec);
+    if (false == read_fabric_database_section_header(fp, section, num_bytes)) {
+      VTR_LOG_ERROR("Fabric database '%s' is corrupted: section %u is "
+                    "missing!\n",
+                    fname.c_str(), isec);
+      return CMD_EXEC_FATAL_ERROR;
+    }
+    std::streampos start = fp.tellg();
+
+    int status = CMD_EXEC_SUCCESS;
+    switch (section) {
+      case FABRIC_DATABASE_MODULE_GRAPH:
+        module_manager.read_binary(fp);
+        break;
+      case FABRIC_DATABASE_MODULE_NAME_MAP:
+        status = read_module_name_map_binary(fp, module_name_map);
+        break;
+      case FABRIC_DATABASE_DECODER_LIBRARY:
+        decoder_lib.read_binary(fp);
+        break;
+      case FABRIC_DATABASE_SHIFT_REGISTER_BANKS:
+        blwl_sr_banks.read_binary(fp);
+        break;
+      case FABRIC_DATABASE_FABRIC_TILE:
+        fabric_tile.read_binary(fp);
+        break;
+      case FABRIC_DATABASE_GLOBAL_PORT_INFO:
+        global_ports.read_binary(fp);
+        break;
+      case FABRIC_DATABASE_UNIQUE_GSB:
+        device_rr_gsb.read_unique_modules_binary(fp);
+        break;
+      default:
+        VTR_ASSERT_MSG(false, "Invalid fabric database section");
+    }
+
+    if ((CMD_EXEC_SUCCESS != status) || (false == fp.good()) ||
+        (size_t(fp.tellg() - start) != num_bytes)) {
+      VTR_LOG_ERROR("Fabric database '%s' is corrupted in section %u!\n",
+                    fname.c_str(), isec);
+      return CMD_EXEC_FATAL_ERROR;
+    }
+  }
+  VTR_LOGV(verbose, "Read %lu modules\n", module_manager.num_modules());
+
+  fp.close();
+
+  return CMD_EXEC_SUCCESS;
+}
+
+} /* end namespace openfpga */
@@ -0,0 +1,44 @@
+#ifndef FABRIC_DATABASE_H
+#define FABRIC_DATABASE_H
+
+/********************************************************************
+ * Include header files that are required by function declaration
+ *******************************************************************/
+#include <map>
+#include <string>
+
+#include "decoder_library.h"
+#include "device_rr_gsb.h"
+#include "fabric_global_port_info.h"
+#include "fabric_tile.h"
+#include "memory_bank_shift_register_banks.h"
+#include "module_manager.h"
+#include "module_name_map.h"
+
+/********************************************************************
+ * Function declaration
+ *******************************************************************/
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+int write_fabric_database(
+  const std::string& fname, const size_t& key,
+  const std::map<std::string, size_t>& circuit_model_fingerprints,
+  const ModuleManager& module_manager, const ModuleNameMap& module_name_map,
+  const DecoderLibrary& decoder_lib,
+  const MemoryBankShiftRegisterBanks& blwl_sr_banks,
+  const FabricTile& fabric_tile, const FabricGlobalPortInfo& global_ports,
+  const DeviceRRGSB& device_rr_gsb, const bool& verbose);
+
+int read_fabric_database(
+  const std::string& fname, const size_t& key,
+  const std::map<std::string, size_t>& circuit_model_fingerprints,
+  ModuleManager& module_manager, ModuleNameMap& module_name_map,
+  DecoderLibrary& decoder_lib, MemoryBankShiftRegisterBanks& blwl_sr_banks,
+  FabricTile& fabric_tile, FabricGlobalPortInfo& global_ports,
+  DeviceRRGSB& device_rr_gsb, const bool& verbose);
+
+} /* end namespace openfpga */
+
+#endif
@@ -3,6 +3,7 @@
  ***********************************************************************/
 #include "fabric_global_port_info.h"
 
+#include "openfpga_binary_io.h"
 #include "vtr_assert.h"
 
 /* namespace openfpga begins */
@@ -90,6 +91,17 @@ size_t FabricGlobalPortInfo::global_port_default_value(
   return global_port_default_values_[global_port_id];
 }
 
+const std::vector<FabricGlobalPortId>&
+FabricGlobalPortInfo::find_module_port_global_ports(
+  const ModulePortId& module_port) const {
+  static const std::vector<FabricGlobalPortId> empty_global_ports;
+  if ((ModulePortId::INVALID() == module_port) ||
+      (size_t(module_port) >= module_port_lookup_.size())) {
+    return empty_global_ports;
+  }
+  return module_port_lookup_[module_port];
+}
+
 /************************************************************************
  * Public Mutators
  ***********************************************************************/
@@ -110,6 +122,8 @@ FabricGlobalPortId FabricGlobalPortInfo::create_global_port(
   global_port_is_config_enable_.push_back(false);
   global_port_default_values_.push_back(0);
 
+  add_module_port_lookup(port_id);
+
   return port_id;
 }
 
@@ -173,6 +187,59 @@ void FabricGlobalPortInfo::set_global_port_default_value(
   global_port_default_values_[global_port_id] = default_value;
 }
 
+/************************************************************************
+ * Public Serializers
+ ***********************************************************************/
+void FabricGlobalPortInfo::write_binary(std::ostream& fp) const {
+  write_binary_data(fp, global_port_ids_);
+  write_binary_data(fp, global_module_ports_);
+  write_binary_data(fp, global_port_is_clock_);
+  write_binary_data(fp, global_port_is_reset_);
+  write_binary_data(fp, global_port_is_set_);
+  write_binary_data(fp, global_port_is_prog_);
+  write_binary_data(fp, global_port_is_shift_register_);
+  write_binary_data(fp, global_port_is_bl_);
+  write_binary_data(fp, global_port_is_wl_);
+  write_binary_data(fp, global_port_is_config_enable_);
+  write_binary_data(fp, global_port_is_io_);
+  write_binary_data(fp, global_port_default_values_);
+}
+
+void FabricGlobalPortInfo::read_binary(std::istream& fp) {
+  read_binary_data(fp, global_port_ids_);
+  read_binary_data(fp, global_module_ports_);
+  read_binary_data(fp, global_port_is_clock_);
+  read_binary_data(fp, global_port_is_reset_);
+  read_binary_data(fp, global_port_is_set_);
+  read_binary_data(fp, global_port_is_prog_);
+  read_binary_data(fp, global_port_is_shift_register_);
+  read_binary_data(fp, global_port_is_bl_);
+  read_binary_data(fp, global_port_is_wl_);
+  read_binary_data(fp, global_port_is_config_enable_);
+  read_binary_data(fp, global_port_is_io_);
+  read_binary_data(fp, global_port_default_values_);
+
+  module_port_lookup_.clear();
+  for (const FabricGlobalPortId& global_port_id : global_port_ids_) {
+    add_module_port_lookup(global_port_id);
+  }
+}
+
+/************************************************************************
+ * Internal builders
+ ***********************************************************************/
+void FabricGlobalPortInfo::add_module_port_lookup(
+  const FabricGlobalPortId& global_port_id) {
+  ModulePortId module_port = global_module_ports_[global_port_id];
+  if (ModulePortId::INVALID() == module_port) {
+    return;
+  }
+  if (size_t(module_port) >= module_port_lookup_.size()) {
+    module_port_lookup_.resize(size_t(module_port) + 1);
+  }
+  module_port_lookup_[module_port].push_back(global_port_id);
+}
+
 /************************************************************************
  * Internal invalidators/validators
  ***********************************************************************/
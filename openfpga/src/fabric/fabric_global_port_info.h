@@ -4,6 +4,7 @@
 /********************************************************************
  * Include header files required by the data structure definition
  *******************************************************************/
+#include <iosfwd>
 #include <string>
 #include <vector>
 
@@ -49,6 +50,11 @@ class FabricGlobalPortInfo {
   bool global_port_is_io(const FabricGlobalPortId& global_port_id) const;
   size_t global_port_default_value(
     const FabricGlobalPortId& global_port_id) const;
+  /* Find the global ports which are created from a given port of the
+   * top-level module, in the order of creation. Return an empty list if
+   * the port is not a global port */
+  const std::vector<FabricGlobalPortId>& find_module_port_global_ports(
+    const ModulePortId& module_port) const;
 
  public: /* Public mutators */
   /* By default, we do not set it as a clock.
@@ -76,9 +82,19 @@ class FabricGlobalPortInfo {
   void set_global_port_default_value(const FabricGlobalPortId& global_port_id,
                                      const size_t& default_value);
 
+ public: /* Public serializers */
+  /** @brief Dump the content to a binary stream */
+  void write_binary(std::ostream& fp) const;
+  /** @brief Replace the content by the one loaded from a binary stream, which
+   * is created by write_binary() */
+  void read_binary(std::istream& fp);
+
  public: /* Public validator */
   bool valid_global_port_id(const FabricGlobalPortId& global_port_id) const;
 
+ private: /* Internal builders */
+  void add_module_port_lookup(const FabricGlobalPortId& global_port_id);
+
  private: /* Internal data */
   /* Global port information for tiles */
   vtr::vector<FabricGlobalPortId, FabricGlobalPortId> global_port_ids_;
@@ -93,6 +109,10 @@ class FabricGlobalPortInfo {
   vtr::vector<FabricGlobalPortId, bool> global_port_is_config_enable_;
   vtr::vector<FabricGlobalPortId, bool> global_port_is_io_;
   vtr::vector<FabricGlobalPortId, size_t> global_port_default_values_;
+
+  /* Fast lookup from the ports of the top-level module to global ports */
+  vtr::vector<ModulePortId, std::vector<FabricGlobalPortId>>
+    module_port_lookup_;
 };
 
 }  // namespace openfpga
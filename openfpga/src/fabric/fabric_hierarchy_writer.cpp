@@ -1,10 +1,13 @@
 /***************************************************************************************
  * Output internal structure of Module Graph hierarchy to file formats
  ***************************************************************************************/
+#include <algorithm>
+
 /* Headers from vtrutil library */
 #include "vtr_assert.h"
 #include "vtr_log.h"
 #include "vtr_time.h"
+#include "vtr_vector.h"
 
 /* Headers from openfpgautil library */
 #include "fabric_hierarchy_writer.h"
@@ -14,16 +17,50 @@
 /* begin namespace openfpga */
 namespace openfpga {
 
+/***************************************************************************************
+ * Find the depth of the subtree under a module, where a module without any
+ * child has a depth of 0. Depths are memoized, as modules are shared
+ * by many parents
+ ***************************************************************************************/
+static size_t rec_find_module_subtree_depth(
+  const ModuleManager& module_manager, const ModuleId& parent_module,
+  vtr::vector<ModuleId, size_t>& subtree_depths) {
+  if (size_t(-1) != subtree_depths[parent_module]) {
+    return subtree_depths[parent_module];
+  }
+  size_t depth = 0;
+  for (const ModuleId& child_module :
+       module_manager.child_modules(parent_module)) {
+    /* Invalid modules are reported when writing the hierarchy */
+    if (true != module_manager.valid_module_id(child_module)) {
+      continue;
+    }
+    size_t child_depth = rec_find_module_subtree_depth(
+      module_manager, child_module, subtree_depths);
+    depth = std::max(depth, child_depth + 1);
+  }
+  subtree_depths[parent_module] = depth;
+  return depth;
+}
+
 /***************************************************************************************
  * Recursively output child module of the parent_module to a text file
  * We use Depth-First Search (DFS) here so that we can output a tree down to
  *leaf first Add space (indent) based on the depth in hierarchy e.g. depth = 1
  *means a space as indent
+ *
+ * When the subtree depths are given, the tree is written as a Directed
+ *Acyclic Graph (DAG): the subtree of a module is written only once, with a
+ *YAML anchor, and is refered by an alias anywhere else. Only the subtrees
+ *which are complete, i.e., not cut by the depth to stop, are shared, so that
+ *each reference is the same as the subtree it replaces
  ***************************************************************************************/
 static int rec_output_module_hierarchy_to_text_file(
   std::fstream& fp, const size_t& hie_depth_to_stop,
   const size_t& current_hie_depth, const ModuleManager& module_manager,
-  const ModuleId& parent_module, const bool& verbose) {
+  const ModuleId& parent_module, const bool& verbose,
+  const vtr::vector<ModuleId, size_t>* subtree_depths,
+  vtr::vector<ModuleId, bool>& written_modules) {
   /* Stop if hierarchy depth is beyond the stop line */
   if (hie_depth_to_stop < current_hie_depth) {
     return 0;
@@ -55,6 +92,17 @@ static int rec_output_module_hierarchy_to_text_file(
     if ((0 != module_manager.child_modules(child_module).size()) &&
         (hie_depth_to_stop >= current_hie_depth + 1)) {
       fp << ":";
+      /* A complete subtree which has been written is refered by an alias */
+      if ((nullptr != subtree_depths) &&
+          (hie_depth_to_stop >=
+           current_hie_depth + (*subtree_depths)[child_module])) {
+        if (true == written_modules[child_module]) {
+          fp << " *" << module_manager.module_name(child_module) << "\n";
+          continue;
+        }
+        fp << " &" << module_manager.module_name(child_module);
+        written_modules[child_module] = true;
+      }
     }
     fp << "\n";
 
@@ -62,7 +110,7 @@ static int rec_output_module_hierarchy_to_text_file(
     int status = rec_output_module_hierarchy_to_text_file(
       fp, hie_depth_to_stop,
       current_hie_depth + 1, /* Increment the depth for the next level */
-      module_manager, child_module, verbose);
+      module_manager, child_module, verbose, subtree_depths, written_modules);
     if (0 != status) {
       return status;
     }
@@ -79,6 +127,14 @@ static int rec_output_module_hierarchy_to_text_file(
  *        ...
  * This file is mainly used by hierarchical P&R flow
  *
+ * In the DAG mode, the subtree of each module is written once, so that the
+ * file size is linear in the number of unique modules, e.g.,
+ *    <module_name>:
+ *      - <child_module_name>: &<child_module_name>
+ *        - <grandchild_module_name>
+ *      - <another_child_module_name>:
+ *        - <child_module_name>: *<child_module_name>
+ *
  * Return 0 if successful
  * Return 1 if there are more serious bugs in the architecture
  * Return 2 if fail when creating files
@@ -87,7 +143,7 @@ int write_fabric_hierarchy_to_text_file(const ModuleManager& module_manager,
                                         const ModuleNameMap& module_name_map,
                                         const std::string& fname,
                                         const size_t& hie_depth_to_stop,
-                                        const bool& verbose) {
+                                        const bool& dag, const bool& verbose) {
   std::string timer_message =
     std::string("Write fabric hierarchy to plain-text file '") + fname +
     std::string("'");
@@ -131,10 +187,20 @@ int write_fabric_hierarchy_to_text_file(const ModuleManager& module_manager,
   fp << top_module_name << ":"
      << "\n";
 
+  /* Depths of the subtrees are only required to share subtrees */
+  vtr::vector<ModuleId, size_t> subtree_depths;
+  if (true == dag) {
+    subtree_depths.resize(module_manager.num_modules(), size_t(-1));
+    rec_find_module_subtree_depth(module_manager, top_module, subtree_depths);
+  }
+  vtr::vector<ModuleId, bool> written_modules(module_manager.num_modules(),
+                                              false);
+
   /* Visit child module recursively and output the hierarchy */
   int err_code = rec_output_module_hierarchy_to_text_file(
     fp, hie_depth_to_stop, hie_depth + 1, /* Start with level 1 */
-    module_manager, top_module, verbose);
+    module_manager, top_module, verbose, dag ? &subtree_depths : nullptr,
+    written_modules);
 
   /* close a file */
   fp.close();
@@ -1,6 +1,8 @@
 /***************************************************************************************
  * Output fabric key of Module Graph to file formats
  ***************************************************************************************/
+#include <vector>
+
 /* Headers from vtrutil library */
 #include "vtr_assert.h"
 #include "vtr_log.h"
@@ -9,62 +11,96 @@
 /* Headers from openfpgautil library */
 #include "command_exit_codes.h"
 #include "openfpga_digest.h"
+#include "openfpga_parallel.h"
 
 /* Headers from archopenfpga library */
 #include "fabric_key_writer.h"
 #include "memory_utils.h"
 #include "openfpga_naming.h"
+#include "write_bin_fabric_key.h"
 #include "write_xml_fabric_key.h"
 
 /* begin namespace openfpga */
 namespace openfpga {
 
 /***************************************************************************************
- * Add module-level keys to fabric key
+ * The content of a key, which is resolved from the module graph before the
+ * key is created in the fabric key database
+ ***************************************************************************************/
+struct FabricKeyContent {
+  std::string name;
+  size_t value;
+  std::string alias;
+  vtr::Point<int> coordinate;
+};
+
+/***************************************************************************************
+ * Resolve the keys of the first configurable children of a module. The
+ * coordinates are only given for the top-level module
+ ***************************************************************************************/
+static std::vector<FabricKeyContent> find_configurable_children_key_contents(
+  const ModuleManager& module_manager, const ModuleId& parent_module,
+  const std::vector<ModuleId>& children, const std::vector<size_t>& instances,
+  const std::vector<vtr::Point<int>>* coordinates, const size_t& num_keys) {
+  std::vector<FabricKeyContent> contents(num_keys);
+  for (size_t ichild = 0; ichild < num_keys; ++ichild) {
+    FabricKeyContent& content = contents[ichild];
+    content.name = module_manager.module_name(children[ichild]);
+    content.value = instances[ichild];
+    content.alias = module_manager.instance_name(
+      parent_module, children[ichild], instances[ichild]);
+    if (nullptr != coordinates) {
+      content.coordinate = (*coordinates)[ichild];
+    }
+  }
+  return contents;
+}
+
+/***************************************************************************************
+ * Resolve the module-level keys of a module. Keys are empty for the modules
+ * to bypass
  ***************************************************************************************/
-static int add_module_keys_to_fabric_key(const ModuleManager& module_manager,
-                                         const ModuleId& curr_module,
-                                         FabricKey& fabric_key) {
+static std::vector<FabricKeyContent> find_module_key_contents(
+  const ModuleManager& module_manager, const ModuleId& curr_module) {
   /* Bypass top-level module */
   std::string module_name = module_manager.module_name(curr_module);
   if (module_name == generate_fpga_top_module_name() ||
       module_name == generate_fpga_core_module_name()) {
-    return CMD_EXEC_SUCCESS;
+    return std::vector<FabricKeyContent>();
   }
+  const std::vector<ModuleId>& children = module_manager.configurable_children(
+    curr_module, ModuleManager::e_config_child_type::PHYSICAL);
+  const std::vector<size_t>& instances =
+    module_manager.configurable_child_instances(
+      curr_module, ModuleManager::e_config_child_type::PHYSICAL);
+  return find_configurable_children_key_contents(
+    module_manager, curr_module, children, instances, nullptr,
+    children.size());
+}
+
+/***************************************************************************************
+ * Add module-level keys to fabric key
+ ***************************************************************************************/
+static int add_module_keys_to_fabric_key(
+  const ModuleManager& module_manager, const ModuleId& curr_module,
+  const std::vector<FabricKeyContent>& contents, FabricKey& fabric_key) {
   /* Bypass modules which does not have any configurable children */
-  if (module_manager
-        .configurable_children(curr_module,
-                               ModuleManager::e_config_child_type::PHYSICAL)
-        .empty()) {
+  if (contents.empty()) {
     return CMD_EXEC_SUCCESS;
   }
   /* Now create the module and add subkey one by one */
-  FabricKeyModuleId key_module_id = fabric_key.create_module(module_name);
+  FabricKeyModuleId key_module_id =
+    fabric_key.create_module(module_manager.module_name(curr_module));
   if (!key_module_id) {
     return CMD_EXEC_FATAL_ERROR;
   }
-  size_t num_config_child =
-    module_manager
-      .configurable_children(curr_module,
-                             ModuleManager::e_config_child_type::PHYSICAL)
-      .size();
-  for (size_t ichild = 0; ichild < num_config_child; ++ichild) {
-    ModuleId child_module = module_manager.configurable_children(
-      curr_module, ModuleManager::e_config_child_type::PHYSICAL)[ichild];
-    size_t child_instance = module_manager.configurable_child_instances(
-      curr_module, ModuleManager::e_config_child_type::PHYSICAL)[ichild];
-
+  for (const FabricKeyContent& content : contents) {
     FabricSubKeyId sub_key = fabric_key.create_module_key(key_module_id);
-    fabric_key.set_sub_key_name(sub_key,
-                                module_manager.module_name(child_module));
-    fabric_key.set_sub_key_value(sub_key, child_instance);
-
-    if (false ==
-        module_manager.instance_name(curr_module, child_module, child_instance)
-          .empty()) {
-      fabric_key.set_sub_key_alias(
-        sub_key, module_manager.instance_name(curr_module, child_module,
-                                              child_instance));
+    fabric_key.set_sub_key_name(sub_key, content.name);
+    fabric_key.set_sub_key_value(sub_key, content.value);
+
+    if (false == content.alias.empty()) {
+      fabric_key.set_sub_key_alias(sub_key, content.alias);
     }
   }
   return CMD_EXEC_SUCCESS;
@@ -73,6 +109,10 @@ static int add_module_keys_to_fabric_key(const ModuleManager& module_manager,
 /***************************************************************************************
  * Write the fabric key of top module to an XML file
  * We will use the writer API in libfabrickey
+ * When binary is enabled, the key is written in the binary format, which is
+ * much faster to load
+ * The keys are resolved from the module graph in parallel, region by region,
+ * and then created in order
  *
  * Return 0 if successful
  * Return 1 if there are more serious bugs in the architecture
@@ -82,10 +122,13 @@ int write_fabric_key_to_xml_file(
   const ModuleManager& module_manager, const std::string& fname,
   const ConfigProtocol& config_protocol,
   const MemoryBankShiftRegisterBanks& blwl_sr_banks,
-  const bool& include_module_keys, const bool& verbose) {
+  const bool& include_module_keys, const bool& binary,
+  const size_t& num_threads, const bool& verbose) {
   int err_code = CMD_EXEC_SUCCESS;
-  std::string timer_message =
-    std::string("Write fabric key to XML file '") + fname + std::string("'");
+  std::string timer_message = std::string("Write fabric key to ") +
+                              std::string(binary ? "binary" : "XML") +
+                              std::string(" file '") + fname +
+                              std::string("'");
 
   std::string dir_path = format_dir_path(find_path_dir_name(fname));
 
@@ -136,54 +179,60 @@ int write_fabric_key_to_xml_file(
     region_id_map[config_region] = fabric_region;
   }
 
-  /* Create regions for the keys and load keys by region */
-  for (const ConfigRegionId& config_region :
-       module_manager.regions(top_module)) {
+  /* Resolve the keys of each region in parallel. Each configuration
+   * protocol has some child which should not be in the list. They are
+   * typically decoders */
+  std::vector<ConfigRegionId> config_regions(
+    module_manager.regions(top_module).begin(),
+    module_manager.regions(top_module).end());
+  std::vector<std::vector<FabricKeyContent>> region_contents(
+    config_regions.size());
+  parallel_for(config_regions.size(), num_threads, [&](const size_t& iregion) {
+    const ConfigRegionId& config_region = config_regions[iregion];
+    std::vector<ModuleId> children =
+      module_manager.region_configurable_children(top_module, config_region);
+    std::vector<size_t> instances =
+      module_manager.region_configurable_child_instances(top_module,
+                                                         config_region);
+    std::vector<vtr::Point<int>> coordinates =
+      module_manager.region_configurable_child_coordinates(top_module,
+                                                           config_region);
+    size_t num_child_to_skip =
+      estimate_num_configurable_children_to_skip_by_config_protocol(
+        config_protocol, children.size());
+    region_contents[iregion] = find_configurable_children_key_contents(
+      module_manager, top_module, children, instances, &coordinates,
+      children.size() - num_child_to_skip);
+  });
+
+  /* Create the keys region by region, so that keys are in the same order as
+   * they are visited */
+  for (size_t iregion = 0; iregion < config_regions.size(); ++iregion) {
     /* Must have a valid one-to-one region mapping  */
-    auto result = region_id_map.find(config_region);
+    auto result = region_id_map.find(config_regions[iregion]);
     VTR_ASSERT_SAFE(result != region_id_map.end());
     FabricRegionId fabric_region = result->second;
 
-    /* Each configuration protocol has some child which should not be in the
-     * list. They are typically decoders */
-    size_t curr_region_num_config_child =
-      module_manager.region_configurable_children(top_module, config_region)
-        .size();
-    size_t num_child_to_skip =
-      estimate_num_configurable_children_to_skip_by_config_protocol(
-        config_protocol, curr_region_num_config_child);
-    curr_region_num_config_child -= num_child_to_skip;
-
-    fabric_key.reserve_region_keys(fabric_region, curr_region_num_config_child);
-
-    for (size_t ichild = 0; ichild < curr_region_num_config_child; ++ichild) {
-      ModuleId child_module = module_manager.region_configurable_children(
-        top_module, config_region)[ichild];
-      size_t child_instance =
-        module_manager.region_configurable_child_instances(
-          top_module, config_region)[ichild];
-      vtr::Point<int> child_coord =
-        module_manager.region_configurable_child_coordinates(
-          top_module, config_region)[ichild];
+    fabric_key.reserve_region_keys(fabric_region,
+                                   region_contents[iregion].size());
 
+    for (const FabricKeyContent& content : region_contents[iregion]) {
       FabricKeyId key = fabric_key.create_key();
-      fabric_key.set_key_name(key, module_manager.module_name(child_module));
-      fabric_key.set_key_value(key, child_instance);
-
-      if (false ==
-          module_manager.instance_name(top_module, child_module, child_instance)
-            .empty()) {
-        fabric_key.set_key_alias(
-          key, module_manager.instance_name(top_module, child_module,
-                                            child_instance));
+      fabric_key.set_key_name(key, content.name);
+      fabric_key.set_key_value(key, content.value);
+
+      if (false == content.alias.empty()) {
+        fabric_key.set_key_alias(key, content.alias);
       }
 
       /* Add key coordinate */
-      fabric_key.set_key_coordinate(key, child_coord);
+      fabric_key.set_key_coordinate(key, content.coordinate);
 
       /* Add keys to the region */
       fabric_key.add_key_to_region(fabric_region, key);
     }
+    /* Release the memory of the region as soon as it is created */
+    std::vector<FabricKeyContent>().swap(region_contents[iregion]);
   }
 
   /* Skip invalid region, some architecture may not have BL/WL banks */
@@ -233,17 +282,30 @@ int write_fabric_key_to_xml_file(
 
   /* Output module subkeys if specified */
   if (include_module_keys) {
-    for (ModuleId submodule : module_manager.modules()) {
-      err_code =
-        add_module_keys_to_fabric_key(module_manager, submodule, fabric_key);
+    std::vector<ModuleId> submodules(module_manager.modules().begin(),
+                                     module_manager.modules().end());
+    std::vector<std::vector<FabricKeyContent>> module_contents(
+      submodules.size());
+    parallel_for(submodules.size(), num_threads, [&](const size_t& imodule) {
+      module_contents[imodule] =
+        find_module_key_contents(module_manager, submodules[imodule]);
+    });
+    for (size_t imodule = 0; imodule < submodules.size(); ++imodule) {
+      err_code = add_module_keys_to_fabric_key(
+        module_manager, submodules[imodule], module_contents[imodule],
+        fabric_key);
       if (err_code != CMD_EXEC_SUCCESS) {
         return CMD_EXEC_FATAL_ERROR;
       }
     }
   }
 
-  /* Call the XML writer for fabric key */
-  err_code = write_xml_fabric_key(fname.c_str(), fabric_key);
+  /* Call the binary or XML writer for fabric key */
+  if (true == binary) {
+    err_code = write_bin_fabric_key(fname.c_str(), fabric_key);
+  } else {
+    err_code = write_xml_fabric_key(fname.c_str(), fabric_key);
+  }
 
   return err_code;
 }
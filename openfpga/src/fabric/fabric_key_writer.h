@@ -21,7 +21,8 @@ int write_fabric_key_to_xml_file(
   const ModuleManager& module_manager, const std::string& fname,
   const ConfigProtocol& config_protocol,
   const MemoryBankShiftRegisterBanks& blwl_sr_banks,
-  const bool& include_module_keys, const bool& verbose);
+  const bool& include_module_keys, const bool& binary,
+  const size_t& num_threads, const bool& verbose);
 
 } /* end namespace openfpga */
 
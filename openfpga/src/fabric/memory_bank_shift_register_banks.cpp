@@ -2,7 +2,9 @@
 
 #include <algorithm>
 
+#include "openfpga_binary_io.h"
 #include "openfpga_reserved_words.h"
+#include "openfpga_symbol_table.h"
 #include "vtr_assert.h"
 
 /* begin namespace openfpga */
@@ -123,30 +125,42 @@ std::vector<BasicPort> MemoryBankShiftRegisterBanks::wl_bank_data_ports(
 FabricBitLineBankId
 MemoryBankShiftRegisterBanks::find_bl_shift_register_bank_id(
   const ConfigRegionId& region, const BasicPort& bl_port) const {
+  /* Only single-bit BL ports are connected to the banks */
+  if ((intern_symbol(MEMORY_BL_PORT_NAME) != bl_port.get_name_symbol()) ||
+      (1 != bl_port.get_width())) {
+    return FabricBitLineBankId::INVALID();
+  }
+  return find_bl_shift_register_bank_id(region, bl_port.get_lsb());
+}
+
+FabricBitLineBankId
+MemoryBankShiftRegisterBanks::find_bl_shift_register_bank_id(
+  const ConfigRegionId& region, const size_t& bl_pin) const {
   if (is_bl_bank_dirty_) {
     build_bl_port_fast_lookup();
   }
 
   VTR_ASSERT(valid_region_id(region));
-  const auto& result = bl_ports_to_sr_bank_ids_[region].find(bl_port);
-  if (result == bl_ports_to_sr_bank_ids_[region].end()) {
+  if (bl_pin >= bl_pins_to_sr_bank_ids_[region].size()) {
     return FabricBitLineBankId::INVALID();
   }
-  return result->second;
+  return bl_pins_to_sr_bank_ids_[region][bl_pin];
 }
 
 BasicPort MemoryBankShiftRegisterBanks::find_bl_shift_register_bank_data_port(
   const ConfigRegionId& region, const BasicPort& bl_port) const {
-  if (is_bl_bank_dirty_) {
-    build_bl_port_fast_lookup();
-  }
-
-  VTR_ASSERT(valid_region_id(region));
-  const auto& result = bl_ports_to_sr_bank_ports_[region].find(bl_port);
-  if (result == bl_ports_to_sr_bank_ports_[region].end()) {
+  FabricBitLineBankId bank_id = find_bl_shift_register_bank_id(region, bl_port);
+  if (!bank_id) {
     return BasicPort();
   }
-  return result->second;
+  size_t sr_bl_pin = bl_pins_to_sr_bank_pins_[region][bl_port.get_lsb()];
+  return BasicPort(std::string(MEMORY_BL_PORT_NAME), sr_bl_pin, sr_bl_pin);
+}
+
+size_t MemoryBankShiftRegisterBanks::find_bl_shift_register_bank_data_pin(
+  const ConfigRegionId& region, const size_t& bl_pin) const {
+  VTR_ASSERT(find_bl_shift_register_bank_id(region, bl_pin));
+  return bl_pins_to_sr_bank_pins_[region][bl_pin];
 }
 
 std::vector<size_t>
@@ -206,30 +220,43 @@ size_t MemoryBankShiftRegisterBanks::bl_shift_register_bank_instance(
 FabricWordLineBankId
 MemoryBankShiftRegisterBanks::find_wl_shift_register_bank_id(
   const ConfigRegionId& region, const BasicPort& wl_port) const {
+  /* Only single-bit WL ports are connected to the banks */
+  if ((intern_symbol(MEMORY_WL_PORT_NAME) != wl_port.get_name_symbol()) ||
+      (1 != wl_port.get_width())) {
+    return FabricWordLineBankId::INVALID();
+  }
+  return find_wl_shift_register_bank_id(region, wl_port.get_lsb());
+}
+
+FabricWordLineBankId
+MemoryBankShiftRegisterBanks::find_wl_shift_register_bank_id(
+  const ConfigRegionId& region, const size_t& wl_pin) const {
   if (is_wl_bank_dirty_) {
     build_wl_port_fast_lookup();
   }
 
   VTR_ASSERT(valid_region_id(region));
-  const auto& result = wl_ports_to_sr_bank_ids_[region].find(wl_port);
-  if (result == wl_ports_to_sr_bank_ids_[region].end()) {
+  if (wl_pin >= wl_pins_to_sr_bank_ids_[region].size()) {
     return FabricWordLineBankId::INVALID();
   }
-  return result->second;
+  return wl_pins_to_sr_bank_ids_[region][wl_pin];
 }
 
 BasicPort MemoryBankShiftRegisterBanks::find_wl_shift_register_bank_data_port(
   const ConfigRegionId& region, const BasicPort& wl_port) const {
-  if (is_wl_bank_dirty_) {
-    build_wl_port_fast_lookup();
-  }
-
-  VTR_ASSERT(valid_region_id(region));
-  const auto& result = wl_ports_to_sr_bank_ports_[region].find(wl_port);
-  if (result == wl_ports_to_sr_bank_ports_[region].end()) {
+  FabricWordLineBankId bank_id =
+    find_wl_shift_register_bank_id(region, wl_port);
+  if (!bank_id) {
     return BasicPort();
   }
-  return result->second;
+  size_t sr_wl_pin = wl_pins_to_sr_bank_pins_[region][wl_port.get_lsb()];
+  return BasicPort(std::string(MEMORY_WL_PORT_NAME), sr_wl_pin, sr_wl_pin);
+}
+
+size_t MemoryBankShiftRegisterBanks::find_wl_shift_register_bank_data_pin(
+  const ConfigRegionId& region, const size_t& wl_pin) const {
+  VTR_ASSERT(find_wl_shift_register_bank_id(region, wl_pin));
+  return wl_pins_to_sr_bank_pins_[region][wl_pin];
 }
 
 void MemoryBankShiftRegisterBanks::resize_regions(const size_t& num_regions) {
@@ -493,24 +520,69 @@ bool MemoryBankShiftRegisterBanks::empty() const {
   return bl_bank_ids_.empty() && wl_bank_ids_.empty();
 }
 
+void MemoryBankShiftRegisterBanks::write_binary(std::ostream& fp) const {
+  write_binary_data(fp, config_region_ids_);
+  write_binary_data(fp, bl_bank_ids_);
+  write_binary_data(fp, bl_bank_data_ports_);
+  write_binary_data(fp, bl_bank_modules_);
+  write_binary_data(fp, bl_bank_instances_);
+  write_binary_data(fp, bl_bank_sink_child_ids_);
+  write_binary_data(fp, bl_bank_sink_child_pin_ids_);
+  write_binary_data(fp, wl_bank_ids_);
+  write_binary_data(fp, wl_bank_data_ports_);
+  write_binary_data(fp, wl_bank_modules_);
+  write_binary_data(fp, wl_bank_instances_);
+  write_binary_data(fp, wl_bank_sink_child_ids_);
+  write_binary_data(fp, wl_bank_sink_child_pin_ids_);
+}
+
+void MemoryBankShiftRegisterBanks::read_binary(std::istream& fp) {
+  read_binary_data(fp, config_region_ids_);
+  read_binary_data(fp, bl_bank_ids_);
+  read_binary_data(fp, bl_bank_data_ports_);
+  read_binary_data(fp, bl_bank_modules_);
+  read_binary_data(fp, bl_bank_instances_);
+  read_binary_data(fp, bl_bank_sink_child_ids_);
+  read_binary_data(fp, bl_bank_sink_child_pin_ids_);
+  read_binary_data(fp, wl_bank_ids_);
+  read_binary_data(fp, wl_bank_data_ports_);
+  read_binary_data(fp, wl_bank_modules_);
+  read_binary_data(fp, wl_bank_instances_);
+  read_binary_data(fp, wl_bank_sink_child_ids_);
+  read_binary_data(fp, wl_bank_sink_child_pin_ids_);
+  /* Force the fast look-ups to be rebuilt */
+  is_bl_bank_dirty_ = true;
+  is_wl_bank_dirty_ = true;
+}
+
 void MemoryBankShiftRegisterBanks::build_bl_port_fast_lookup() const {
-  bl_ports_to_sr_bank_ids_.resize(bl_bank_data_ports_.size());
-  bl_ports_to_sr_bank_ports_.resize(bl_bank_data_ports_.size());
+  bl_pins_to_sr_bank_ids_.clear();
+  bl_pins_to_sr_bank_pins_.clear();
+  bl_pins_to_sr_bank_ids_.resize(bl_bank_data_ports_.size());
+  bl_pins_to_sr_bank_pins_.resize(bl_bank_data_ports_.size());
   for (const auto& region : bl_bank_data_ports_) {
+    ConfigRegionId region_id =
+      ConfigRegionId(&region - &bl_bank_data_ports_[ConfigRegionId(0)]);
+    /* Size the look-up by the largest BL index of the region */
+    size_t num_bls = 0;
+    for (const auto& bank : region) {
+      for (const auto& port : bank) {
+        if (port.is_valid()) {
+          num_bls = std::max(num_bls, port.get_msb() + 1);
+        }
+      }
+    }
+    bl_pins_to_sr_bank_ids_[region_id].assign(num_bls,
+                                              FabricBitLineBankId::INVALID());
+    bl_pins_to_sr_bank_pins_[region_id].assign(num_bls, 0);
     for (const auto& bank : region) {
+      FabricBitLineBankId bank_id =
+        FabricBitLineBankId(&bank - &region[FabricBitLineBankId(0)]);
       size_t cur_pin = 0;
       for (const auto& port : bank) {
         for (const size_t& bl_index : port.pins()) {
-          BasicPort bl_port(std::string(MEMORY_BL_PORT_NAME), bl_index,
-                            bl_index);
-          BasicPort sr_bl_port(std::string(MEMORY_BL_PORT_NAME), cur_pin,
-                               cur_pin);
-          ConfigRegionId region_id =
-            ConfigRegionId(&region - &bl_bank_data_ports_[ConfigRegionId(0)]);
-          FabricBitLineBankId bank_id =
-            FabricBitLineBankId(&bank - &region[FabricBitLineBankId(0)]);
-          bl_ports_to_sr_bank_ids_[region_id][bl_port] = bank_id;
-          bl_ports_to_sr_bank_ports_[region_id][bl_port] = sr_bl_port;
+          bl_pins_to_sr_bank_ids_[region_id][bl_index] = bank_id;
+          bl_pins_to_sr_bank_pins_[region_id][bl_index] = cur_pin;
           cur_pin++;
         }
       }
@@ -521,23 +593,33 @@ void MemoryBankShiftRegisterBanks::build_bl_port_fast_lookup() const {
 }
 
 void MemoryBankShiftRegisterBanks::build_wl_port_fast_lookup() const {
-  wl_ports_to_sr_bank_ids_.resize(wl_bank_data_ports_.size());
-  wl_ports_to_sr_bank_ports_.resize(wl_bank_data_ports_.size());
+  wl_pins_to_sr_bank_ids_.clear();
+  wl_pins_to_sr_bank_pins_.clear();
+  wl_pins_to_sr_bank_ids_.resize(wl_bank_data_ports_.size());
+  wl_pins_to_sr_bank_pins_.resize(wl_bank_data_ports_.size());
   for (const auto& region : wl_bank_data_ports_) {
+    ConfigRegionId region_id =
+      ConfigRegionId(&region - &wl_bank_data_ports_[ConfigRegionId(0)]);
+    /* Size the look-up by the largest WL index of the region */
+    size_t num_wls = 0;
+    for (const auto& bank : region) {
+      for (const auto& port : bank) {
+        if (port.is_valid()) {
+          num_wls = std::max(num_wls, port.get_msb() + 1);
+        }
+      }
+    }
+    wl_pins_to_sr_bank_ids_[region_id].assign(num_wls,
+                                              FabricWordLineBankId::INVALID());
+    wl_pins_to_sr_bank_pins_[region_id].assign(num_wls, 0);
     for (const auto& bank : region) {
+      FabricWordLineBankId bank_id =
+        FabricWordLineBankId(&bank - &region[FabricWordLineBankId(0)]);
       size_t cur_pin = 0;
       for (const auto& port : bank) {
         for (const size_t& wl_index : port.pins()) {
-          BasicPort wl_port(std::string(MEMORY_WL_PORT_NAME), wl_index,
-                            wl_index);
-          BasicPort sr_wl_port(std::string(MEMORY_WL_PORT_NAME), cur_pin,
-                               cur_pin);
-          ConfigRegionId region_id =
-            ConfigRegionId(&region - &wl_bank_data_ports_[ConfigRegionId(0)]);
-          FabricWordLineBankId bank_id =
-            FabricWordLineBankId(&bank - &region[FabricWordLineBankId(0)]);
-          wl_ports_to_sr_bank_ids_[region_id][wl_port] = bank_id;
-          wl_ports_to_sr_bank_ports_[region_id][wl_port] = sr_wl_port;
+          wl_pins_to_sr_bank_ids_[region_id][wl_index] = bank_id;
+          wl_pins_to_sr_bank_pins_[region_id][wl_index] = cur_pin;
           cur_pin++;
         }
       }
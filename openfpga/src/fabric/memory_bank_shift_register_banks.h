@@ -1,6 +1,7 @@
 #ifndef MEMORY_BANK_SHIFT_REGISTER_BANKS_H
 #define MEMORY_BANK_SHIFT_REGISTER_BANKS_H
 
+#include <iosfwd>
 #include <map>
 #include <vector>
 
@@ -62,6 +63,17 @@ class MemoryBankShiftRegisterBanks {
   BasicPort find_bl_shift_register_bank_data_port(
     const ConfigRegionId& region, const BasicPort& bl_port) const;
 
+  /** @brief Same as find_bl_shift_register_bank_id() but the BL is given by
+   * its index, i.e., i of bl[i], which avoids building a port */
+  FabricBitLineBankId find_bl_shift_register_bank_id(
+    const ConfigRegionId& region, const size_t& bl_pin) const;
+
+  /** @brief find the data pin of a BL shift register bank to which a BL,
+   * given by its index, is connected to
+   *  @note the BL must be driven by a shift register bank */
+  size_t find_bl_shift_register_bank_data_pin(const ConfigRegionId& region,
+                                              const size_t& bl_pin) const;
+
   /** @brief Return the module id of a BL shift register bank */
   ModuleId bl_shift_register_bank_module(
     const ConfigRegionId& region_id, const FabricBitLineBankId& bank_id) const;
@@ -120,6 +132,17 @@ class MemoryBankShiftRegisterBanks {
   BasicPort find_wl_shift_register_bank_data_port(
     const ConfigRegionId& region, const BasicPort& wl_port) const;
 
+  /** @brief Same as find_wl_shift_register_bank_id() but the WL is given by
+   * its index, i.e., i of wl[i], which avoids building a port */
+  FabricWordLineBankId find_wl_shift_register_bank_id(
+    const ConfigRegionId& region, const size_t& wl_pin) const;
+
+  /** @brief find the data pin of a WL shift register bank to which a WL,
+   * given by its index, is connected to
+   *  @note the WL must be driven by a shift register bank */
+  size_t find_wl_shift_register_bank_data_pin(const ConfigRegionId& region,
+                                              const size_t& wl_pin) const;
+
   /** @brief Return the module id of a WL shift register bank */
   ModuleId wl_shift_register_bank_module(
     const ConfigRegionId& region_id, const FabricWordLineBankId& bank_id) const;
@@ -230,6 +253,14 @@ class MemoryBankShiftRegisterBanks {
                                             const size_t& sink_child_id,
                                             const size_t& sink_child_pin_id);
 
+ public: /* Serializers */
+  /** @brief Dump the content to a binary stream. Fast look-ups are not
+   * included, as they are built on request */
+  void write_binary(std::ostream& fp) const;
+  /** @brief Replace the content by the one loaded from a binary stream, which
+   * is created by write_binary() */
+  void read_binary(std::istream& fp);
+
  public: /* Validators */
   bool valid_region_id(const ConfigRegionId& region) const;
   bool valid_bl_bank_id(const ConfigRegionId& region_id,
@@ -294,15 +325,18 @@ class MemoryBankShiftRegisterBanks {
   /* Fast look-up: given a BL/Wl port, e.g., bl[i], find out
    * - the shift register bank id
    * - the output pin id of the shift register bank
+   * The BL/WLs of a region are densely indexed, so the look-ups are
+   * indexed by i directly. A BL/WL which is not driven by any bank has an
+   * invalid bank id
    */
-  mutable vtr::vector<ConfigRegionId, std::map<BasicPort, FabricBitLineBankId>>
-    bl_ports_to_sr_bank_ids_;
-  mutable vtr::vector<ConfigRegionId, std::map<BasicPort, BasicPort>>
-    bl_ports_to_sr_bank_ports_;
-  mutable vtr::vector<ConfigRegionId, std::map<BasicPort, FabricWordLineBankId>>
-    wl_ports_to_sr_bank_ids_;
-  mutable vtr::vector<ConfigRegionId, std::map<BasicPort, BasicPort>>
-    wl_ports_to_sr_bank_ports_;
+  mutable vtr::vector<ConfigRegionId, std::vector<FabricBitLineBankId>>
+    bl_pins_to_sr_bank_ids_;
+  mutable vtr::vector<ConfigRegionId, std::vector<size_t>>
+    bl_pins_to_sr_bank_pins_;
+  mutable vtr::vector<ConfigRegionId, std::vector<FabricWordLineBankId>>
+    wl_pins_to_sr_bank_ids_;
+  mutable vtr::vector<ConfigRegionId, std::vector<size_t>>
+    wl_pins_to_sr_bank_pins_;
 
   /* A flag to indicate that the general information of the shift register banks
    * have been modified, fast look-up has to be updated */
@@ -0,0 +1,302 @@
+/********************************************************************
+ * This file includes functions to merge the modules which have the
+ * same structure but different names in a module graph, e.g., the
+ * border-side variants of grids, connection blocks and tiles which
+ * happen to be identical. The instances of a merged module are
+ * replaced by the instances of its identical module, while its name
+ * becomes an alias in the module name map
+ *******************************************************************/
+#include "merge_identical_modules.h"
+
+#include <unordered_map>
+#include <vector>
+
+/* Headers from vtrutil library */
+#include "vtr_assert.h"
+#include "vtr_log.h"
+#include "vtr_time.h"
+
+/* Headers from openfpgautil library */
+#include "command_exit_codes.h"
+#include "openfpga_hash.h"
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+/********************************************************************
+ * Sort the modules so that any child module comes before its parents.
+ * Modules are visited in the order of the module manager, so that the
+ * result is deterministic
+ *******************************************************************/
+static std::vector<ModuleId> find_modules_in_bottom_up_order(
+  const ModuleManager& module_manager) {
+  std::vector<ModuleId> ordered_modules;
+  ordered_modules.reserve(module_manager.num_modules());
+  vtr::vector<ModuleId, bool> visited(module_manager.num_modules(), false);
+  /* Each entry is a module and the index of its next child to visit */
+  std::vector<std::pair<ModuleId, size_t>> stack;
+  for (const ModuleId& root : module_manager.modules()) {
+    if (true == visited[root]) {
+      continue;
+    }
+    visited[root] = true;
+    stack.emplace_back(root, 0);
+    while (!stack.empty()) {
+      ModuleId curr_module = stack.back().first;
+      size_t ichild = stack.back().second;
+      const std::vector<ModuleId>& children =
+        module_manager.child_modules(curr_module);
+      if (ichild == children.size()) {
+        ordered_modules.push_back(curr_module);
+        stack.pop_back();
+        continue;
+      }
+      stack.back().second++;
+      if (false == visited[children[ichild]]) {
+        visited[children[ichild]] = true;
+        stack.emplace_back(children[ichild], 0);
+      }
+    }
+  }
+  return ordered_modules;
+}
+
+/********************************************************************
+ * Only the building blocks of the fabric are considered: routing
+ * blocks, as well as grid and tile modules which have no specific
+ * usage. The top-level module and the modules which are not
+ * instantiated are never merged. Unnamed instances are named after
+ * their module when outputting netlists, so that modules with any
+ * unnamed instance are skipped
+ *******************************************************************/
+static bool is_mergeable_module(const ModuleManager& module_manager,
+                                const ModuleNameMap& module_name_map,
+                                const ModuleId& module) {
+  ModuleManager::e_module_usage_type usage =
+    module_manager.module_usage(module);
+  if ((ModuleManager::MODULE_SB != usage) &&
+      (ModuleManager::MODULE_CB != usage) &&
+      (ModuleManager::NUM_MODULE_USAGE_TYPES != usage)) {
+    return false;
+  }
+  if (true == module_manager.parent_modules(module).empty()) {
+    return false;
+  }
+  if (false == module_name_map.tag_exist(module_manager.module_name(module))) {
+    return false;
+  }
+  for (const ModuleId& parent : module_manager.parent_modules(module)) {
+    for (const size_t& inst :
+         module_manager.child_module_instances(parent, module)) {
+      if (true ==
+          module_manager.instance_name(parent, module, inst).empty()) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+/********************************************************************
+ * Flatten the structure of a module into a list of integers, including
+ * its ports, child instances, configurable children, I/O children and
+ * nets. Names are represented by their interned symbols. Two modules
+ * are identical when their lists are the same. Note that the names of
+ * nets are not considered, as they do not change the connectivity
+ *******************************************************************/
+static std::vector<size_t> find_module_structure(
+  const ModuleManager& module_manager, const ModuleId& module) {
+  std::vector<size_t> structure;
+  structure.push_back(size_t(module_manager.module_usage(module)));
+  structure.push_back(
+    intern_symbol(module_manager.module_circuit_model(module)));
+
+  /* Ports */
+  structure.push_back(module_manager.module_ports(module).size());
+  for (const ModulePortId& port : module_manager.module_ports(module)) {
+    const BasicPort& port_info = module_manager.module_port(module, port);
+    structure.push_back(port_info.get_name_symbol());
+    structure.push_back(port_info.get_lsb());
+    structure.push_back(port_info.get_msb());
+    structure.push_back(size_t(module_manager.port_type(module, port)));
+    structure.push_back(module_manager.port_is_wire(module, port));
+    structure.push_back(module_manager.port_is_register(module, port));
+    structure.push_back(module_manager.port_is_mappable_io(module, port));
+    structure.push_back(
+      intern_symbol(module_manager.port_preproc_flag(module, port)));
+  }
+
+  /* Child instances */
+  structure.push_back(module_manager.child_modules(module).size());
+  for (const ModuleId& child : module_manager.child_modules(module)) {
+    structure.push_back(size_t(child));
+    structure.push_back(module_manager.num_instance(module, child));
+    for (const size_t& inst :
+         module_manager.child_module_instances(module, child)) {
+      structure.push_back(
+        intern_symbol(module_manager.instance_name(module, child, inst)));
+    }
+  }
+
+  /* Configurable children */
+  for (const ModuleManager::e_config_child_type& type :
+       {ModuleManager::e_config_child_type::LOGICAL,
+        ModuleManager::e_config_child_type::PHYSICAL}) {
+    const std::vector<ModuleId>& children =
+      module_manager.configurable_children(module, type);
+    const std::vector<size_t>& instances =
+      module_manager.configurable_child_instances(module, type);
+    structure.push_back(children.size());
+    for (size_t ichild = 0; ichild < children.size(); ++ichild) {
+      structure.push_back(size_t(children[ichild]));
+      structure.push_back(instances[ichild]);
+    }
+  }
+  for (const vtr::Point<int>& coord :
+       module_manager.configurable_child_coordinates(
+         module, ModuleManager::e_config_child_type::PHYSICAL)) {
+    structure.push_back(size_t(coord.x()));
+    structure.push_back(size_t(coord.y()));
+  }
+  for (const ModuleId& child :
+       module_manager.logical2physical_configurable_children(module)) {
+    structure.push_back(size_t(child));
+  }
+  for (const std::string& inst_name :
+       module_manager.logical2physical_configurable_child_instance_names(
+         module)) {
+    structure.push_back(intern_symbol(inst_name));
+  }
+  structure.push_back(module_manager.regions(module).size());
+  for (const ConfigRegionId& region : module_manager.regions(module)) {
+    std::vector<size_t> instances =
+      module_manager.region_configurable_child_instances(module, region);
+    structure.push_back(instances.size());
+    for (const size_t& inst : instances) {
+      structure.push_back(inst);
+    }
+  }
+
+  /* I/O children */
+  structure.push_back(module_manager.io_children(module).size());
+  for (size_t ichild = 0; ichild < module_manager.io_children(module).size();
+       ++ichild) {
+    structure.push_back(size_t(module_manager.io_children(module)[ichild]));
+    structure.push_back(module_manager.io_child_instances(module)[ichild]);
+    structure.push_back(
+      size_t(module_manager.io_child_coordinates(module)[ichild].x()));
+    structure.push_back(
+      size_t(module_manager.io_child_coordinates(module)[ichild].y()));
+  }
+
+  /* Nets: the module itself is marked as 0 in the terminals */
+  structure.push_back(module_manager.num_nets(module));
+  for (const ModuleNetId& net : module_manager.module_nets(module)) {
+    auto src_modules = module_manager.net_source_modules(module, net);
+    auto src_instances = module_manager.net_source_instances(module, net);
+    auto src_ports = module_manager.net_source_ports(module, net);
+    auto src_pins = module_manager.net_source_pins(module, net);
+    structure.push_back(src_modules.size());
+    for (const ModuleNetSrcId& src :
+         module_manager.module_net_sources(module, net)) {
+      if (module == src_modules[src]) {
+        structure.push_back(0);
+      } else {
+        structure.push_back(size_t(src_modules[src]) + 1);
+      }
+      structure.push_back(src_instances[src]);
+      structure.push_back(size_t(src_ports[src]));
+      structure.push_back(src_pins[src]);
+    }
+    auto sink_modules = module_manager.net_sink_modules(module, net);
+    auto sink_instances = module_manager.net_sink_instances(module, net);
+    auto sink_ports = module_manager.net_sink_ports(module, net);
+    auto sink_pins = module_manager.net_sink_pins(module, net);
+    structure.push_back(sink_modules.size());
+    for (const ModuleNetSinkId& sink :
+         module_manager.module_net_sinks(module, net)) {
+      if (module == sink_modules[sink]) {
+        structure.push_back(0);
+      } else {
+        structure.push_back(size_t(sink_modules[sink]) + 1);
+      }
+      structure.push_back(sink_instances[sink]);
+      structure.push_back(size_t(sink_ports[sink]));
+      structure.push_back(sink_pins[sink]);
+    }
+  }
+
+  return structure;
+}
+
+/********************************************************************
+ * Merge the modules which are structurally identical.
+ * Modules are processed from the bottom to the top of the hierarchy,
+ * so that the parents of merged modules instantiate the same children,
+ * and can be merged in turn.
+ * Each module is hashed by its structure; the modules with the same
+ * hash are compared in details before merging, so that hash collisions
+ * never merge different modules.
+ * A merged module stays in the module manager without any parent,
+ * and its built-in name becomes an alias of the built-in name of the
+ * module it is merged into. As a result, any look-up through the
+ * module name map finds the remaining module
+ *******************************************************************/
+int merge_identical_modules(ModuleManager& module_manager,
+                            ModuleNameMap& module_name_map,
+                            const bool& verbose) {
+  vtr::ScopedStartFinishTimer timer("Merge identical modules");
+
+  /* Unique modules with the same hash of structure */
+  std::unordered_map<size_t, std::vector<ModuleId>> unique_modules;
+  size_t num_merged_modules = 0;
+  for (const ModuleId& curr_module :
+       find_modules_in_bottom_up_order(module_manager)) {
+    if (false ==
+        is_mergeable_module(module_manager, module_name_map, curr_module)) {
+      continue;
+    }
+    std::vector<size_t> structure =
+      find_module_structure(module_manager, curr_module);
+    size_t key = 0;
+    for (const size_t& value : structure) {
+      hash_combine<size_t>(key, value);
+    }
+
+    std::vector<ModuleId>& candidates = unique_modules[key];
+    ModuleId unique_module = ModuleId::INVALID();
+    for (const ModuleId& candidate : candidates) {
+      if (structure == find_module_structure(module_manager, candidate)) {
+        unique_module = candidate;
+        break;
+      }
+    }
+    if (false == module_manager.valid_module_id(unique_module)) {
+      candidates.push_back(curr_module);
+      continue;
+    }
+
+    /* Take a copy, as the parents are updated when replacing instances */
+    std::vector<ModuleId> parents =
+      module_manager.parent_modules(curr_module);
+    for (const ModuleId& parent : parents) {
+      module_manager.replace_child_module(parent, curr_module, unique_module);
+    }
+    int status = module_name_map.set_tag_alias(
+      module_name_map.tag(module_manager.module_name(curr_module)),
+      module_name_map.tag(module_manager.module_name(unique_module)));
+    if (CMD_EXEC_SUCCESS != status) {
+      return CMD_EXEC_FATAL_ERROR;
+    }
+    VTR_LOGV(verbose, "Merged module '%s' into identical module '%s'\n",
+             module_manager.module_name(curr_module).c_str(),
+             module_manager.module_name(unique_module).c_str());
+    num_merged_modules++;
+  }
+
+  VTR_LOG("Merged %lu modules into identical modules\n", num_merged_modules);
+
+  return CMD_EXEC_SUCCESS;
+}
+
+} /* end namespace openfpga */
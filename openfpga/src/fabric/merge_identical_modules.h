@@ -0,0 +1,23 @@
+#ifndef MERGE_IDENTICAL_MODULES_H
+#define MERGE_IDENTICAL_MODULES_H
+
+/********************************************************************
+ * Include header files that are required by function declaration
+ *******************************************************************/
+#include "module_manager.h"
+#include "module_name_map.h"
+
+/********************************************************************
+ * Function declaration
+ *******************************************************************/
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+int merge_identical_modules(ModuleManager& module_manager,
+                            ModuleNameMap& module_name_map,
+                            const bool& verbose);
+
+} /* end namespace openfpga */
+
+#endif
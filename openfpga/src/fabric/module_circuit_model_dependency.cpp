@@ -0,0 +1,221 @@
+/********************************************************************
+ * This file includes functions to track the dependency between the
+ * circuit models of an architecture and the modules of a fabric.
+ *
+ * Each circuit model gets a structural fingerprint, which only covers
+ * the attributes which are used when building the module graph, e.g.,
+ * ports, structures and the circuit models it refers to. Other
+ * attributes, such as transistor sizes, delays, buffer sizes or the
+ * paths of user-defined netlists, are only used when outputting
+ * netlists and do not have any impact on the fabric. When the
+ * fingerprints of a fabric still match an architecture, the fabric
+ * can be reused as is.
+ *******************************************************************/
+#include <algorithm>
+#include <queue>
+
+/* Headers from vtrutil library */
+#include "vtr_assert.h"
+
+/* Headers from openfpgautil library */
+#include "openfpga_hash.h"
+
+#include "module_circuit_model_dependency.h"
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+/********************************************************************
+ * Circuit models are referred by names, as their ids depend on the
+ * order in which they are defined
+ *******************************************************************/
+static void hash_combine_circuit_model(size_t& seed,
+                                       const CircuitLibrary& circuit_lib,
+                                       const CircuitModelId& circuit_model) {
+  if (false == circuit_lib.valid_model_id(circuit_model)) {
+    hash_combine<std::string>(seed, std::string());
+    return;
+  }
+  hash_combine<std::string>(seed, circuit_lib.model_name(circuit_model));
+}
+
+/********************************************************************
+ * Compute the structural fingerprint of a circuit model.
+ * Note that the set of attributes should be updated when a builder
+ * of the module graph starts using a new attribute of circuit models
+ *******************************************************************/
+size_t find_circuit_model_structural_fingerprint(
+  const CircuitLibrary& circuit_lib, const CircuitModelId& circuit_model) {
+  VTR_ASSERT(true == circuit_lib.valid_model_id(circuit_model));
+  const CircuitModelId& model = circuit_model;
+  const e_circuit_model_type& model_type = circuit_lib.model_type(model);
+
+  size_t seed = 0;
+  hash_combine<std::string>(seed, circuit_lib.model_name(model));
+  hash_combine<int>(seed, int(model_type));
+  hash_combine<int>(seed, int(circuit_lib.design_tech_type(model)));
+  hash_combine<bool>(seed, circuit_lib.model_is_default(model));
+  hash_combine<bool>(seed, circuit_lib.is_power_gated(model));
+  /* Only the existence of user-defined netlists matters, not their paths */
+  bool user_defined =
+    (false == circuit_lib.model_verilog_netlist(model).empty()) ||
+    (false == circuit_lib.model_spice_netlist(model).empty());
+  hash_combine<bool>(seed, user_defined);
+
+  hash_combine<bool>(seed, circuit_lib.is_input_buffered(model));
+  hash_combine_circuit_model(seed, circuit_lib,
+                             circuit_lib.input_buffer_model(model));
+  hash_combine<bool>(seed, circuit_lib.is_output_buffered(model));
+  hash_combine_circuit_model(seed, circuit_lib,
+                             circuit_lib.output_buffer_model(model));
+
+  if (CIRCUIT_MODEL_LUT == model_type) {
+    hash_combine<bool>(seed, circuit_lib.is_lut_fracturable(model));
+    hash_combine<bool>(seed, circuit_lib.is_lut_intermediate_buffered(model));
+    hash_combine_circuit_model(
+      seed, circuit_lib, circuit_lib.lut_intermediate_buffer_model(model));
+    hash_combine<std::string>(
+      seed, circuit_lib.lut_intermediate_buffer_location_map(model));
+    /* Input buffers and inverters are mandatory for the LUTs to be built */
+    if (false == user_defined) {
+      hash_combine_circuit_model(seed, circuit_lib,
+                                 circuit_lib.lut_input_buffer_model(model));
+      hash_combine_circuit_model(seed, circuit_lib,
+                                 circuit_lib.lut_input_inverter_model(model));
+    }
+  }
+
+  if ((CIRCUIT_MODEL_MUX == model_type) || (CIRCUIT_MODEL_LUT == model_type)) {
+    hash_combine<int>(seed, int(circuit_lib.mux_structure(model)));
+    hash_combine<size_t>(seed, circuit_lib.mux_num_levels(model));
+    hash_combine<bool>(seed, circuit_lib.mux_add_const_input(model));
+    if (true == circuit_lib.mux_add_const_input(model)) {
+      hash_combine<size_t>(seed, circuit_lib.mux_const_input_value(model));
+    }
+    hash_combine<bool>(seed, circuit_lib.mux_use_local_encoder(model));
+    hash_combine_circuit_model(seed, circuit_lib,
+                               circuit_lib.pass_gate_logic_model(model));
+  }
+
+  if (CIRCUIT_MODEL_PASSGATE == model_type) {
+    hash_combine<int>(seed, int(circuit_lib.pass_gate_logic_type(model)));
+  }
+
+  if (CIRCUIT_MODEL_GATE == model_type) {
+    hash_combine<int>(seed, int(circuit_lib.gate_type(model)));
+  }
+
+  for (const CircuitPortId& port : circuit_lib.model_ports(model)) {
+    hash_combine<int>(seed, int(circuit_lib.port_type(port)));
+    hash_combine<size_t>(seed, circuit_lib.port_size(port));
+    hash_combine<std::string>(seed, circuit_lib.port_prefix(port));
+    hash_combine<std::string>(seed, circuit_lib.port_lib_name(port));
+    hash_combine<size_t>(seed, circuit_lib.port_default_value(port));
+    hash_combine<bool>(seed, circuit_lib.port_is_io(port));
+    hash_combine<bool>(seed, circuit_lib.port_is_data_io(port));
+    hash_combine<bool>(seed, circuit_lib.port_is_mode_select(port));
+    hash_combine<bool>(seed, circuit_lib.port_is_global(port));
+    hash_combine<bool>(seed, circuit_lib.port_is_reset(port));
+    hash_combine<bool>(seed, circuit_lib.port_is_set(port));
+    hash_combine<bool>(seed, circuit_lib.port_is_config_enable(port));
+    hash_combine<bool>(seed, circuit_lib.port_is_prog(port));
+    hash_combine<bool>(seed, circuit_lib.port_is_shift_register(port));
+    hash_combine<bool>(seed, circuit_lib.port_is_harden_lut_port(port));
+    hash_combine<size_t>(seed, circuit_lib.port_lut_frac_level(port));
+    for (const size_t& mask : circuit_lib.port_lut_output_mask(port)) {
+      hash_combine<size_t>(seed, mask);
+    }
+    hash_combine<std::string>(seed, circuit_lib.port_tri_state_map(port));
+    hash_combine_circuit_model(seed, circuit_lib,
+                               circuit_lib.port_tri_state_model(port));
+  }
+
+  return seed;
+}
+
+/********************************************************************
+ * Compute the structural fingerprints of all the circuit models,
+ * indexed by the names of circuit models
+ *******************************************************************/
+std::map<std::string, size_t> find_circuit_library_structural_fingerprints(
+  const CircuitLibrary& circuit_lib) {
+  std::map<std::string, size_t> fingerprints;
+  for (const CircuitModelId& model : circuit_lib.models()) {
+    fingerprints[circuit_lib.model_name(model)] =
+      find_circuit_model_structural_fingerprint(circuit_lib, model);
+  }
+  return fingerprints;
+}
+
+/********************************************************************
+ * Find the circuit models whose fingerprints are different between
+ * two sets, including the circuit models which are added or removed
+ *******************************************************************/
+std::vector<std::string> find_changed_circuit_models(
+  const std::map<std::string, size_t>& ref_fingerprints,
+  const std::map<std::string, size_t>& curr_fingerprints) {
+  std::vector<std::string> changed_models;
+  for (const auto& ref : ref_fingerprints) {
+    auto result = curr_fingerprints.find(ref.first);
+    if ((result == curr_fingerprints.end()) || (result->second != ref.second)) {
+      changed_models.push_back(ref.first);
+    }
+  }
+  for (const auto& curr : curr_fingerprints) {
+    if (0 == ref_fingerprints.count(curr.first)) {
+      changed_models.push_back(curr.first);
+    }
+  }
+  std::sort(changed_models.begin(), changed_models.end());
+  return changed_models;
+}
+
+/********************************************************************
+ * Find the modules which depend on a list of circuit models:
+ * - the modules which are built from any of the circuit models
+ * - the modules which instanciate any of the modules above, up to
+ *   the top-level module
+ * The modules are sorted by their ids
+ *******************************************************************/
+std::vector<ModuleId> find_modules_depending_on_circuit_models(
+  const ModuleManager& module_manager,
+  const std::vector<std::string>& circuit_models) {
+  std::vector<bool> visited(module_manager.num_modules(), false);
+  std::queue<ModuleId> to_visit;
+
+  for (const ModuleId& module : module_manager.modules()) {
+    std::string circuit_model = module_manager.module_circuit_model(module);
+    if (true == circuit_model.empty()) {
+      continue;
+    }
+    if (circuit_models.end() != std::find(circuit_models.begin(),
+                                          circuit_models.end(),
+                                          circuit_model)) {
+      visited[size_t(module)] = true;
+      to_visit.push(module);
+    }
+  }
+
+  /* Propagate to the parents */
+  while (false == to_visit.empty()) {
+    ModuleId module = to_visit.front();
+    to_visit.pop();
+    for (const ModuleId& parent : module_manager.parent_modules(module)) {
+      if (true == visited[size_t(parent)]) {
+        continue;
+      }
+      visited[size_t(parent)] = true;
+      to_visit.push(parent);
+    }
+  }
+
+  std::vector<ModuleId> modules;
+  for (const ModuleId& module : module_manager.modules()) {
+    if (true == visited[size_t(module)]) {
+      modules.push_back(module);
+    }
+  }
+  return modules;
+}
+
+} /* end namespace openfpga */
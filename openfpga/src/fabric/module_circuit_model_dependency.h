@@ -0,0 +1,37 @@
+#ifndef MODULE_CIRCUIT_MODEL_DEPENDENCY_H
+#define MODULE_CIRCUIT_MODEL_DEPENDENCY_H
+
+/********************************************************************
+ * Include header files that are required by function declaration
+ *******************************************************************/
+#include <map>
+#include <string>
+#include <vector>
+
+#include "circuit_library.h"
+#include "module_manager.h"
+
+/********************************************************************
+ * Function declaration
+ *******************************************************************/
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+size_t find_circuit_model_structural_fingerprint(
+  const CircuitLibrary& circuit_lib, const CircuitModelId& circuit_model);
+
+std::map<std::string, size_t> find_circuit_library_structural_fingerprints(
+  const CircuitLibrary& circuit_lib);
+
+std::vector<std::string> find_changed_circuit_models(
+  const std::map<std::string, size_t>& ref_fingerprints,
+  const std::map<std::string, size_t>& curr_fingerprints);
+
+std::vector<ModuleId> find_modules_depending_on_circuit_models(
+  const ModuleManager& module_manager,
+  const std::vector<std::string>& circuit_models);
+
+} /* end namespace openfpga */
+
+#endif
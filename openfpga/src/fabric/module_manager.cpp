@@ -4,16 +4,141 @@
 #include "module_manager.h"
 
 #include <algorithm>
-#include <numeric>
 #include <string>
 
 #include "circuit_library.h"
+#include "openfpga_binary_io.h"
 #include "vtr_assert.h"
 #include "vtr_log.h"
 
 /* begin namespace openfpga */
 namespace openfpga {
 
+/******************************************************************************
+ * Find the data of the sources/sinks of a net, either from the per-net
+ * array or from the compressed flat array when the offsets are available
+ ******************************************************************************/
+template <class NetTermId>
+static vtr::Range<const size_t*> find_net_terminal_data(
+  const vtr::vector<ModuleNetId, vtr::vector<NetTermId, size_t>>& net_data,
+  const std::vector<size_t>& offsets, const std::vector<size_t>& flat_data,
+  const ModuleNetId& net) {
+  if (false == offsets.empty()) {
+    const size_t* begin = flat_data.data();
+    return vtr::make_range(begin + offsets[size_t(net)],
+                           begin + offsets[size_t(net) + 1]);
+  }
+  const vtr::vector<NetTermId, size_t>& data = net_data[net];
+  if (true == data.empty()) {
+    return vtr::make_range<const size_t*>(nullptr, nullptr);
+  }
+  const size_t* begin = &(data[NetTermId(0)]);
+  return vtr::make_range(begin, begin + data.size());
+}
+
+/******************************************************************************
+ * Move the sources/sinks of all the nets to flat arrays
+ ******************************************************************************/
+template <class NetTermId>
+static void compress_net_terminals(
+  vtr::vector<ModuleNetId, vtr::vector<NetTermId, NetTermId>>& ids,
+  vtr::vector<ModuleNetId, vtr::vector<NetTermId, size_t>>& terminal_ids,
+  vtr::vector<ModuleNetId, vtr::vector<NetTermId, size_t>>& instance_ids,
+  vtr::vector<ModuleNetId, vtr::vector<NetTermId, size_t>>& pin_ids,
+  std::vector<size_t>& offsets, vtr::vector<NetTermId, NetTermId>& flat_ids,
+  std::vector<size_t>& flat_terminal_ids,
+  std::vector<size_t>& flat_instance_ids, std::vector<size_t>& flat_pin_ids) {
+  size_t num_terms = 0;
+  for (const auto& net_ids : ids) {
+    num_terms += net_ids.size();
+  }
+  offsets.reserve(ids.size() + 1);
+  flat_ids.reserve(num_terms);
+  flat_terminal_ids.reserve(num_terms);
+  flat_instance_ids.reserve(num_terms);
+  flat_pin_ids.reserve(num_terms);
+
+  offsets.push_back(0);
+  for (size_t inet = 0; inet < ids.size(); ++inet) {
+    ModuleNetId net = ModuleNetId(inet);
+    for (const NetTermId& term : ids[net]) {
+      flat_ids.push_back(term);
+      flat_terminal_ids.push_back(terminal_ids[net][term]);
+      flat_instance_ids.push_back(instance_ids[net][term]);
+      flat_pin_ids.push_back(pin_ids[net][term]);
+    }
+    offsets.push_back(flat_ids.size());
+  }
+
+  /* Release the memory of per-net arrays */
+  ids = vtr::vector<ModuleNetId, vtr::vector<NetTermId, NetTermId>>();
+  terminal_ids = vtr::vector<ModuleNetId, vtr::vector<NetTermId, size_t>>();
+  instance_ids = vtr::vector<ModuleNetId, vtr::vector<NetTermId, size_t>>();
+  pin_ids = vtr::vector<ModuleNetId, vtr::vector<NetTermId, size_t>>();
+}
+
+/******************************************************************************
+ * Move the sources/sinks of all the nets from flat arrays back to per-net
+ * arrays, which is the reverse of compress_net_terminals()
+ ******************************************************************************/
+template <class NetTermId>
+static void expand_net_terminals(
+  vtr::vector<ModuleNetId, vtr::vector<NetTermId, NetTermId>>& ids,
+  vtr::vector<ModuleNetId, vtr::vector<NetTermId, size_t>>& terminal_ids,
+  vtr::vector<ModuleNetId, vtr::vector<NetTermId, size_t>>& instance_ids,
+  vtr::vector<ModuleNetId, vtr::vector<NetTermId, size_t>>& pin_ids,
+  std::vector<size_t>& offsets, vtr::vector<NetTermId, NetTermId>& flat_ids,
+  std::vector<size_t>& flat_terminal_ids,
+  std::vector<size_t>& flat_instance_ids, std::vector<size_t>& flat_pin_ids) {
+  VTR_ASSERT(false == offsets.empty());
+  size_t num_nets = offsets.size() - 1;
+  ids.resize(num_nets);
+  terminal_ids.resize(num_nets);
+  instance_ids.resize(num_nets);
+  pin_ids.resize(num_nets);
+  for (size_t inet = 0; inet < num_nets; ++inet) {
+    ModuleNetId net = ModuleNetId(inet);
+    size_t num_terms = offsets[inet + 1] - offsets[inet];
+    ids[net].reserve(num_terms);
+    terminal_ids[net].reserve(num_terms);
+    instance_ids[net].reserve(num_terms);
+    pin_ids[net].reserve(num_terms);
+    for (size_t iterm = offsets[inet]; iterm < offsets[inet + 1]; ++iterm) {
+      ids[net].push_back(flat_ids[NetTermId(iterm)]);
+      terminal_ids[net].push_back(flat_terminal_ids[iterm]);
+      instance_ids[net].push_back(flat_instance_ids[iterm]);
+      pin_ids[net].push_back(flat_pin_ids[iterm]);
+    }
+  }
+
+  offsets = std::vector<size_t>();
+  flat_ids = vtr::vector<NetTermId, NetTermId>();
+  flat_terminal_ids = std::vector<size_t>();
+  flat_instance_ids = std::vector<size_t>();
+  flat_pin_ids = std::vector<size_t>();
+}
+
+/******************************************************************************
+ * Replace the terminal ids of the sources/sinks of nets through a map, and
+ * shift the instance ids of the replaced terminals. Both the per-net arrays
+ * and the flat arrays are accepted
+ ******************************************************************************/
+template <class T>
+static void replace_net_terminal_data(
+  T& terminal_ids, T& instance_ids,
+  const std::unordered_map<size_t, size_t>& terminal_map,
+  const size_t& instance_offset) {
+  auto instance_it = instance_ids.begin();
+  for (size_t& terminal_id : terminal_ids) {
+    auto result = terminal_map.find(terminal_id);
+    if (result != terminal_map.end()) {
+      terminal_id = result->second;
+      *instance_it += instance_offset;
+    }
+    ++instance_it;
+  }
+}
+
 /******************************************************************************
  * Public Constructors
  ******************************************************************************/
@@ -57,15 +182,23 @@ ModuleManager::module_net_range ModuleManager::module_nets(
 }
 
 /* Find all the child modules under a parent module */
-std::vector<ModuleId> ModuleManager::child_modules(
+const std::vector<ModuleId>& ModuleManager::child_modules(
   const ModuleId& parent_module) const {
   /* Validate the module_id */
   VTR_ASSERT(valid_module_id(parent_module));
   return children_[parent_module];
 }
 
+/* Find all the parent modules which instanciate a child module */
+const std::vector<ModuleId>& ModuleManager::parent_modules(
+  const ModuleId& child_module) const {
+  /* Validate the module_id */
+  VTR_ASSERT(valid_module_id(child_module));
+  return parents_[child_module];
+}
+
 /* Find all the instances under a parent module */
-std::vector<size_t> ModuleManager::child_module_instances(
+ModuleManager::child_instance_range ModuleManager::child_module_instances(
   const ModuleId& parent_module, const ModuleId& child_module) const {
   /* Validate the module_id */
   VTR_ASSERT(valid_module_id(parent_module));
@@ -79,16 +212,12 @@ std::vector<size_t> ModuleManager::child_module_instances(
   }
   VTR_ASSERT(child_index != children_[parent_module].size());
 
-  /* Create a vector, with sequentially increasing numbers */
-  std::vector<size_t> instance_range(
-    num_child_instances_[parent_module][child_index], 0);
-  std::iota(instance_range.begin(), instance_range.end(), 0);
-
-  return instance_range;
+  return child_instance_range(0,
+                              num_child_instances_[parent_module][child_index]);
 }
 
 /* Find all the configurable child modules under a parent module */
-std::vector<ModuleId> ModuleManager::configurable_children(
+const std::vector<ModuleId>& ModuleManager::configurable_children(
   const ModuleId& parent_module, const e_config_child_type& type) const {
   /* Validate the module_id */
   VTR_ASSERT(valid_module_id(parent_module));
@@ -101,7 +230,7 @@ std::vector<ModuleId> ModuleManager::configurable_children(
 }
 
 /* Find all the instances of configurable child modules under a parent module */
-std::vector<size_t> ModuleManager::configurable_child_instances(
+const std::vector<size_t>& ModuleManager::configurable_child_instances(
   const ModuleId& parent_module, const e_config_child_type& type) const {
   /* Validate the module_id */
   VTR_ASSERT(valid_module_id(parent_module));
@@ -113,7 +242,8 @@ std::vector<size_t> ModuleManager::configurable_child_instances(
   return physical_configurable_child_instances_[parent_module];
 }
 
-std::vector<vtr::Point<int>> ModuleManager::configurable_child_coordinates(
+const std::vector<vtr::Point<int>>&
+ModuleManager::configurable_child_coordinates(
   const ModuleId& parent_module, const e_config_child_type& type) const {
   /* Validate the module_id */
   VTR_ASSERT(valid_module_id(parent_module));
@@ -123,7 +253,8 @@ std::vector<vtr::Point<int>> ModuleManager::configurable_child_coordinates(
 }
 
 /* Find all the configurable child modules under a parent module */
-std::vector<ModuleId> ModuleManager::logical2physical_configurable_children(
+const std::vector<ModuleId>&
+ModuleManager::logical2physical_configurable_children(
   const ModuleId& parent_module) const {
   /* Validate the module_id */
   VTR_ASSERT(valid_module_id(parent_module));
@@ -138,11 +269,18 @@ ModuleManager::logical2physical_configurable_child_instance_names(
   /* Validate the module_id */
   VTR_ASSERT(valid_module_id(parent_module));
 
-  return logical2physical_configurable_child_instance_names_[parent_module];
+  std::vector<std::string> instance_names;
+  instance_names.reserve(
+    logical2physical_configurable_child_instance_names_[parent_module].size());
+  for (const SymbolId& name :
+       logical2physical_configurable_child_instance_names_[parent_module]) {
+    instance_names.push_back(symbol_string(name));
+  }
+  return instance_names;
 }
 
 /* Find all the configurable child modules under a parent module */
-std::vector<ModuleId> ModuleManager::io_children(
+const std::vector<ModuleId>& ModuleManager::io_children(
   const ModuleId& parent_module) const {
   /* Validate the module_id */
   VTR_ASSERT(valid_module_id(parent_module));
@@ -151,7 +289,7 @@ std::vector<ModuleId> ModuleManager::io_children(
 }
 
 /* Find all the instances of configurable child modules under a parent module */
-std::vector<size_t> ModuleManager::io_child_instances(
+const std::vector<size_t>& ModuleManager::io_child_instances(
   const ModuleId& parent_module) const {
   /* Validate the module_id */
   VTR_ASSERT(valid_module_id(parent_module));
@@ -159,7 +297,7 @@ std::vector<size_t> ModuleManager::io_child_instances(
   return io_child_instances_[parent_module];
 }
 
-std::vector<vtr::Point<int>> ModuleManager::io_child_coordinates(
+const std::vector<vtr::Point<int>>& ModuleManager::io_child_coordinates(
   const ModuleId& parent_module) const {
   /* Validate the module_id */
   VTR_ASSERT(valid_module_id(parent_module));
@@ -172,6 +310,12 @@ ModuleManager::module_net_src_range ModuleManager::module_net_sources(
   const ModuleId& module, const ModuleNetId& net) const {
   /* Validate the module_id */
   VTR_ASSERT(valid_module_net_id(module, net));
+  if (true == module_nets_compressed(module)) {
+    const std::vector<size_t>& offsets = net_src_offsets_[module];
+    return vtr::make_range(
+      flat_net_src_ids_[module].begin() + offsets[size_t(net)],
+      flat_net_src_ids_[module].begin() + offsets[size_t(net) + 1]);
+  }
   return vtr::make_range(net_src_ids_[module][net].begin(),
                          net_src_ids_[module][net].end());
 }
@@ -181,6 +325,12 @@ ModuleManager::module_net_sink_range ModuleManager::module_net_sinks(
   const ModuleId& module, const ModuleNetId& net) const {
   /* Validate the module_id */
   VTR_ASSERT(valid_module_net_id(module, net));
+  if (true == module_nets_compressed(module)) {
+    const std::vector<size_t>& offsets = net_sink_offsets_[module];
+    return vtr::make_range(
+      flat_net_sink_ids_[module].begin() + offsets[size_t(net)],
+      flat_net_sink_ids_[module].begin() + offsets[size_t(net) + 1]);
+  }
   return vtr::make_range(net_sink_ids_[module][net].begin(),
                          net_sink_ids_[module][net].end());
 }
@@ -267,7 +417,7 @@ size_t ModuleManager::num_nets(const ModuleId& module) const {
 std::string ModuleManager::module_name(const ModuleId& module_id) const {
   /* Validate the module_id */
   VTR_ASSERT(valid_module_id(module_id));
-  return names_[module_id];
+  return symbol_string(names_[module_id]);
 }
 
 ModuleManager::e_module_usage_type ModuleManager::module_usage(
@@ -277,6 +427,13 @@ ModuleManager::e_module_usage_type ModuleManager::module_usage(
   return usages_[module_id];
 }
 
+std::string ModuleManager::module_circuit_model(
+  const ModuleId& module_id) const {
+  /* Validate the module_id */
+  VTR_ASSERT(valid_module_id(module_id));
+  return symbol_string(circuit_models_[module_id]);
+}
+
 /* Get the string of a module port type */
 std::string ModuleManager::module_port_type_str(
   const enum e_module_port_type& port_type) const {
@@ -348,10 +505,11 @@ BasicPort ModuleManager::module_port(const ModuleId& module_id,
 }
 
 /* Find the module id by a given name, return invalid if not found */
-ModuleId ModuleManager::find_module(const std::string& name) const {
-  if (name_id_map_.find(name) != name_id_map_.end()) {
+ModuleId ModuleManager::find_module(std::string_view name) const {
+  auto result = name_id_map_.find(name);
+  if (result != name_id_map_.end()) {
     /* Find it, return the id */
-    return name_id_map_.at(name);
+    return result->second;
   }
   /* Not found, return an invalid id */
   return ModuleId::INVALID();
@@ -384,7 +542,8 @@ std::string ModuleManager::instance_name(const ModuleId& parent_module,
   VTR_ASSERT(child_index < children_[parent_module].size());
   /* Ensure that instance id is valid */
   VTR_ASSERT(instance_id < num_instance(parent_module, child_module));
-  return child_instance_names_[parent_module][child_index][instance_id];
+  return symbol_string(
+    child_instance_names_[parent_module][child_index][instance_id]);
 }
 
 /* Find the instance id of a given instance name */
@@ -400,13 +559,16 @@ size_t ModuleManager::instance_id(const ModuleId& parent_module,
     find_child_module_index_in_parent_module(parent_module, child_module);
   VTR_ASSERT(child_index < children_[parent_module].size());
 
-  /* Search the instance name list and try to find a match */
+  /* Search the instance name list and try to find a match. A name which has
+   * never been interned cannot be used by any instance */
+  SymbolId name = SymbolTable::instance().find(instance_name);
+  if (SymbolTable::INVALID_SYMBOL == name) {
+    return size_t(-1);
+  }
   for (size_t name_id = 0;
        name_id < child_instance_names_[parent_module][child_index].size();
        ++name_id) {
-    const std::string& name =
-      child_instance_names_[parent_module][child_index][name_id];
-    if (0 == name.compare(instance_name)) {
+    if (name == child_instance_names_[parent_module][child_index][name_id]) {
       return name_id;
     }
   }
@@ -489,8 +651,12 @@ ModuleNetId ModuleManager::module_instance_port_net(
   /* Validate child_pin */
   VTR_ASSERT(child_pin < module_port(child_module, child_port).get_width());
 
-  return net_lookup_[parent_module][child_module][child_instance][child_port]
-                    [child_pin];
+  size_t index = net_lookup_index(parent_module, child_module, child_instance,
+                                  child_port, child_pin);
+  if (child_module == parent_module) {
+    return self_net_lookup_[parent_module][index];
+  }
+  return instance_net_lookup_[parent_module][index];
 }
 
 /* Find the name of net */
@@ -499,7 +665,7 @@ std::string ModuleManager::net_name(const ModuleId& module,
   /* Validate module net */
   VTR_ASSERT(valid_module_net_id(module, net));
 
-  return net_names_[module][net];
+  return symbol_string(net_names_[module][net]);
 }
 
 /* Find the source modules of a net */
@@ -509,8 +675,7 @@ vtr::vector<ModuleNetSrcId, ModuleId> ModuleManager::net_source_modules(
   VTR_ASSERT(valid_module_net_id(module, net));
 
   vtr::vector<ModuleNetSrcId, ModuleId> src_modules;
-  src_modules.reserve(net_src_terminal_ids_[module][net].size());
-  for (const size_t& id : net_src_terminal_ids_[module][net]) {
+  for (const size_t& id : net_src_terminal_ids(module, net)) {
     src_modules.push_back(net_terminal_storage_[id].first);
   }
 
@@ -523,7 +688,12 @@ vtr::vector<ModuleNetSrcId, size_t> ModuleManager::net_source_instances(
   /* Validate module net */
   VTR_ASSERT(valid_module_net_id(module, net));
 
-  return net_src_instance_ids_[module][net];
+  vtr::vector<ModuleNetSrcId, size_t> src_instances;
+  for (const size_t& id : net_src_instance_ids(module, net)) {
+    src_instances.push_back(id);
+  }
+
+  return src_instances;
 }
 
 /* Find the source ports of a net */
@@ -533,8 +703,7 @@ vtr::vector<ModuleNetSrcId, ModulePortId> ModuleManager::net_source_ports(
   VTR_ASSERT(valid_module_net_id(module, net));
 
   vtr::vector<ModuleNetSrcId, ModulePortId> src_ports;
-  src_ports.reserve(net_src_terminal_ids_[module][net].size());
-  for (const size_t& id : net_src_terminal_ids_[module][net]) {
+  for (const size_t& id : net_src_terminal_ids(module, net)) {
     src_ports.push_back(net_terminal_storage_[id].second);
   }
 
@@ -547,7 +716,12 @@ vtr::vector<ModuleNetSrcId, size_t> ModuleManager::net_source_pins(
   /* Validate module net */
   VTR_ASSERT(valid_module_net_id(module, net));
 
-  return net_src_pin_ids_[module][net];
+  vtr::vector<ModuleNetSrcId, size_t> src_pins;
+  for (const size_t& id : net_src_pin_ids(module, net)) {
+    src_pins.push_back(id);
+  }
+
+  return src_pins;
 }
 
 /* Identify if a pin of a port in a module already exists in the net source
@@ -565,15 +739,16 @@ bool ModuleManager::net_source_exist(const ModuleId& module,
    * If a net source has the same src_module, instance_id, src_port and src_pin,
    * we can say that the source has already been added to this net!
    */
+  vtr::Range<const size_t*> terminal_ids = net_src_terminal_ids(module, net);
+  vtr::Range<const size_t*> instance_ids = net_src_instance_ids(module, net);
+  vtr::Range<const size_t*> pin_ids = net_src_pin_ids(module, net);
   for (const ModuleNetSrcId& net_src : module_net_sources(module, net)) {
-    if ((src_module ==
-         net_terminal_storage_[net_src_terminal_ids_[module][net][net_src]]
-           .first) &&
-        (instance_id == net_source_instances(module, net)[net_src]) &&
-        (src_port ==
-         net_terminal_storage_[net_src_terminal_ids_[module][net][net_src]]
-           .second) &&
-        (src_pin == net_source_pins(module, net)[net_src])) {
+    const std::pair<ModuleId, ModulePortId>& terminal =
+      net_terminal_storage_[terminal_ids.begin()[size_t(net_src)]];
+    if ((src_module == terminal.first) &&
+        (instance_id == instance_ids.begin()[size_t(net_src)]) &&
+        (src_port == terminal.second) &&
+        (src_pin == pin_ids.begin()[size_t(net_src)])) {
       return true;
     }
   }
@@ -589,8 +764,7 @@ vtr::vector<ModuleNetSinkId, ModuleId> ModuleManager::net_sink_modules(
   VTR_ASSERT(valid_module_net_id(module, net));
 
   vtr::vector<ModuleNetSinkId, ModuleId> sink_modules;
-  sink_modules.reserve(net_sink_terminal_ids_[module][net].size());
-  for (const size_t& id : net_sink_terminal_ids_[module][net]) {
+  for (const size_t& id : net_sink_terminal_ids(module, net)) {
     sink_modules.push_back(net_terminal_storage_[id].first);
   }
 
@@ -603,7 +777,12 @@ vtr::vector<ModuleNetSinkId, size_t> ModuleManager::net_sink_instances(
   /* Validate module net */
   VTR_ASSERT(valid_module_net_id(module, net));
 
-  return net_sink_instance_ids_[module][net];
+  vtr::vector<ModuleNetSinkId, size_t> sink_instances;
+  for (const size_t& id : net_sink_instance_ids(module, net)) {
+    sink_instances.push_back(id);
+  }
+
+  return sink_instances;
 }
 
 /* Find the sink ports of a net */
@@ -613,8 +792,7 @@ vtr::vector<ModuleNetSinkId, ModulePortId> ModuleManager::net_sink_ports(
   VTR_ASSERT(valid_module_net_id(module, net));
 
   vtr::vector<ModuleNetSinkId, ModulePortId> sink_ports;
-  sink_ports.reserve(net_sink_terminal_ids_[module][net].size());
-  for (const size_t& id : net_sink_terminal_ids_[module][net]) {
+  for (const size_t& id : net_sink_terminal_ids(module, net)) {
     sink_ports.push_back(net_terminal_storage_[id].second);
   }
 
@@ -627,7 +805,12 @@ vtr::vector<ModuleNetSinkId, size_t> ModuleManager::net_sink_pins(
   /* Validate module net */
   VTR_ASSERT(valid_module_net_id(module, net));
 
-  return net_sink_pin_ids_[module][net];
+  vtr::vector<ModuleNetSinkId, size_t> sink_pins;
+  for (const size_t& id : net_sink_pin_ids(module, net)) {
+    sink_pins.push_back(id);
+  }
+
+  return sink_pins;
 }
 
 /* Identify if a pin of a port in a module already exists in the net sink list*/
@@ -644,15 +827,16 @@ bool ModuleManager::net_sink_exist(const ModuleId& module,
    * If a net sink has the same sink_module, instance_id, sink_port and
    * sink_pin, we can say that the sink has already been added to this net!
    */
+  vtr::Range<const size_t*> terminal_ids = net_sink_terminal_ids(module, net);
+  vtr::Range<const size_t*> instance_ids = net_sink_instance_ids(module, net);
+  vtr::Range<const size_t*> pin_ids = net_sink_pin_ids(module, net);
   for (const ModuleNetSinkId& net_sink : module_net_sinks(module, net)) {
-    if ((sink_module ==
-         net_terminal_storage_[net_sink_terminal_ids_[module][net][net_sink]]
-           .first) &&
-        (instance_id == net_sink_instances(module, net)[net_sink]) &&
-        (sink_port ==
-         net_terminal_storage_[net_sink_terminal_ids_[module][net][net_sink]]
-           .second) &&
-        (sink_pin == net_sink_pins(module, net)[net_sink])) {
+    const std::pair<ModuleId, ModulePortId>& terminal =
+      net_terminal_storage_[terminal_ids.begin()[size_t(net_sink)]];
+    if ((sink_module == terminal.first) &&
+        (instance_id == instance_ids.begin()[size_t(net_sink)]) &&
+        (sink_port == terminal.second) &&
+        (sink_pin == pin_ids.begin()[size_t(net_sink)])) {
       return true;
     }
   }
@@ -661,6 +845,17 @@ bool ModuleManager::net_sink_exist(const ModuleId& module,
   return false;
 }
 
+bool ModuleManager::module_nets_compressed(const ModuleId& module) const {
+  VTR_ASSERT(valid_module_id(module));
+  return false == net_src_offsets_[module].empty();
+}
+
+bool ModuleManager::is_last_compressed_net(const ModuleId& module,
+                                           const ModuleNetId& net) const {
+  return (true == module_nets_compressed(module)) &&
+         (size_t(net) + 1 == num_nets_[module]);
+}
+
 bool ModuleManager::unified_configurable_children(
   const ModuleId& curr_module) const {
   if (logical_configurable_children_[curr_module].size() !=
@@ -681,6 +876,161 @@ bool ModuleManager::unified_configurable_children(
   return true;
 }
 
+MemoryUsage ModuleManager::memory_usage() const {
+  MemoryUsage usage = heap_memory_usage(ids_);
+  usage += heap_memory_usage(names_);
+  usage += heap_memory_usage(usages_);
+  usage += heap_memory_usage(circuit_models_);
+  usage += heap_memory_usage(parents_);
+  usage += heap_memory_usage(children_);
+  usage += heap_memory_usage(num_child_instances_);
+  usage += heap_memory_usage(child_instance_names_);
+  usage += heap_memory_usage(logical_configurable_children_);
+  usage += heap_memory_usage(logical_configurable_child_instances_);
+  usage += heap_memory_usage(logical2physical_configurable_children_);
+  usage +=
+    heap_memory_usage(logical2physical_configurable_child_instance_names_);
+  usage += heap_memory_usage(physical_configurable_children_);
+  usage += heap_memory_usage(physical_configurable_child_instances_);
+  usage += heap_memory_usage(physical_configurable_child_regions_);
+  usage += heap_memory_usage(physical_configurable_child_coordinates_);
+  usage += heap_memory_usage(config_region_ids_);
+  usage += heap_memory_usage(config_region_children_);
+  usage += heap_memory_usage(io_children_);
+  usage += heap_memory_usage(io_child_instances_);
+  usage += heap_memory_usage(io_child_coordinates_);
+  usage += heap_memory_usage(port_ids_);
+  usage += heap_memory_usage(ports_);
+  usage += heap_memory_usage(port_types_);
+  usage += heap_memory_usage(port_is_mappable_io_);
+  usage += heap_memory_usage(port_is_wire_);
+  usage += heap_memory_usage(port_is_register_);
+  usage += heap_memory_usage(port_preproc_flags_);
+  usage += heap_memory_usage(num_nets_);
+  usage += heap_memory_usage(invalid_net_ids_);
+  usage += heap_memory_usage(net_names_);
+  usage += heap_memory_usage(net_src_ids_);
+  usage += heap_memory_usage(net_src_terminal_ids_);
+  usage += heap_memory_usage(net_src_instance_ids_);
+  usage += heap_memory_usage(net_src_pin_ids_);
+  usage += heap_memory_usage(net_sink_ids_);
+  usage += heap_memory_usage(net_sink_terminal_ids_);
+  usage += heap_memory_usage(net_sink_instance_ids_);
+  usage += heap_memory_usage(net_sink_pin_ids_);
+  usage += heap_memory_usage(net_src_offsets_);
+  usage += heap_memory_usage(flat_net_src_ids_);
+  usage += heap_memory_usage(flat_net_src_terminal_ids_);
+  usage += heap_memory_usage(flat_net_src_instance_ids_);
+  usage += heap_memory_usage(flat_net_src_pin_ids_);
+  usage += heap_memory_usage(net_sink_offsets_);
+  usage += heap_memory_usage(flat_net_sink_ids_);
+  usage += heap_memory_usage(flat_net_sink_terminal_ids_);
+  usage += heap_memory_usage(flat_net_sink_instance_ids_);
+  usage += heap_memory_usage(flat_net_sink_pin_ids_);
+  usage += heap_memory_usage(name_id_map_);
+  usage += heap_memory_usage(port_lookup_);
+  usage += heap_memory_usage(port_pin_offsets_);
+  usage += heap_memory_usage(num_pins_);
+  usage += heap_memory_usage(child_index_lookup_);
+  usage += heap_memory_usage(instance_net_offsets_);
+  usage += heap_memory_usage(instance_net_lookup_);
+  usage += heap_memory_usage(self_net_lookup_);
+  usage += heap_memory_usage(net_terminal_storage_);
+  usage += heap_memory_usage(net_terminal_lookup_);
+  return usage;
+}
+
+ModuleManager ModuleManager::interface_copy() const {
+  ModuleManager interfaces;
+
+  /* Module-level data */
+  interfaces.ids_ = ids_;
+  interfaces.names_ = names_;
+  interfaces.usages_ = usages_;
+  interfaces.circuit_models_ = circuit_models_;
+  interfaces.parents_ = parents_;
+  interfaces.children_ = children_;
+  interfaces.num_child_instances_ = num_child_instances_;
+  interfaces.child_instance_names_ = child_instance_names_;
+  interfaces.logical_configurable_children_ = logical_configurable_children_;
+  interfaces.logical_configurable_child_instances_ =
+    logical_configurable_child_instances_;
+  interfaces.logical2physical_configurable_children_ =
+    logical2physical_configurable_children_;
+  interfaces.logical2physical_configurable_child_instance_names_ =
+    logical2physical_configurable_child_instance_names_;
+  interfaces.physical_configurable_children_ = physical_configurable_children_;
+  interfaces.physical_configurable_child_instances_ =
+    physical_configurable_child_instances_;
+  interfaces.physical_configurable_child_regions_ =
+    physical_configurable_child_regions_;
+  interfaces.physical_configurable_child_coordinates_ =
+    physical_configurable_child_coordinates_;
+  interfaces.config_region_ids_ = config_region_ids_;
+  interfaces.config_region_children_ = config_region_children_;
+  interfaces.io_children_ = io_children_;
+  interfaces.io_child_instances_ = io_child_instances_;
+  interfaces.io_child_coordinates_ = io_child_coordinates_;
+
+  /* Port-level data */
+  interfaces.port_ids_ = port_ids_;
+  interfaces.ports_ = ports_;
+  interfaces.port_types_ = port_types_;
+  interfaces.port_is_mappable_io_ = port_is_mappable_io_;
+  interfaces.port_is_wire_ = port_is_wire_;
+  interfaces.port_is_register_ = port_is_register_;
+  interfaces.port_preproc_flags_ = port_preproc_flags_;
+
+  /* Graph-level data: every module is left without any net, as a new module
+   * does. The nets are not required to instantiate a module */
+  size_t num_modules = ids_.size();
+  interfaces.num_nets_.resize(num_modules, 0);
+  interfaces.invalid_net_ids_.resize(num_modules);
+  interfaces.net_names_.resize(num_modules);
+  interfaces.net_src_ids_.resize(num_modules);
+  interfaces.net_src_terminal_ids_.resize(num_modules);
+  interfaces.net_src_instance_ids_.resize(num_modules);
+  interfaces.net_src_pin_ids_.resize(num_modules);
+  interfaces.net_sink_ids_.resize(num_modules);
+  interfaces.net_sink_terminal_ids_.resize(num_modules);
+  interfaces.net_sink_instance_ids_.resize(num_modules);
+  interfaces.net_sink_pin_ids_.resize(num_modules);
+  interfaces.net_src_offsets_.resize(num_modules, std::vector<size_t>(1, 0));
+  interfaces.flat_net_src_ids_.resize(num_modules);
+  interfaces.flat_net_src_terminal_ids_.resize(num_modules);
+  interfaces.flat_net_src_instance_ids_.resize(num_modules);
+  interfaces.flat_net_src_pin_ids_.resize(num_modules);
+  interfaces.net_sink_offsets_.resize(num_modules, std::vector<size_t>(1, 0));
+  interfaces.flat_net_sink_ids_.resize(num_modules);
+  interfaces.flat_net_sink_terminal_ids_.resize(num_modules);
+  interfaces.flat_net_sink_instance_ids_.resize(num_modules);
+  interfaces.flat_net_sink_pin_ids_.resize(num_modules);
+
+  /* Fast look-ups. The name-to-id map refers to the interned names, which are
+   * shared by all the module managers */
+  interfaces.name_id_map_ = name_id_map_;
+  interfaces.port_lookup_ = port_lookup_;
+  interfaces.port_pin_offsets_ = port_pin_offsets_;
+  interfaces.num_pins_ = num_pins_;
+  interfaces.child_index_lookup_ = child_index_lookup_;
+  /* The pins are kept in the net look-up, without any net connected */
+  interfaces.instance_net_offsets_ = instance_net_offsets_;
+  interfaces.instance_net_lookup_.resize(instance_net_lookup_.size());
+  for (size_t imodule = 0; imodule < instance_net_lookup_.size(); ++imodule) {
+    ModuleId module = ModuleId(imodule);
+    interfaces.instance_net_lookup_[module].resize(
+      instance_net_lookup_[module].size(), ModuleNetId::INVALID());
+  }
+  interfaces.self_net_lookup_.resize(self_net_lookup_.size());
+  for (size_t imodule = 0; imodule < self_net_lookup_.size(); ++imodule) {
+    ModuleId module = ModuleId(imodule);
+    interfaces.self_net_lookup_[module].resize(self_net_lookup_[module].size(),
+                                               ModuleNetId::INVALID());
+  }
+
+  return interfaces;
+}
+
 /******************************************************************************
  * Private Accessors
  ******************************************************************************/
@@ -690,16 +1040,72 @@ size_t ModuleManager::find_child_module_index_in_parent_module(
   VTR_ASSERT(valid_module_id(parent_module));
   VTR_ASSERT(valid_module_id(child_module));
   /* Try to find the child_module in the children list of parent_module*/
-  for (size_t i = 0; i < children_[parent_module].size(); ++i) {
-    if (child_module == children_[parent_module][i]) {
-      /* Found, return the number of instances */
-      return i;
-    }
+  auto result = child_index_lookup_[parent_module].find(child_module);
+  if (result != child_index_lookup_[parent_module].end()) {
+    return result->second;
   }
   /* Not found: return an valid value */
   return size_t(-1);
 }
 
+size_t ModuleManager::net_lookup_index(const ModuleId& parent_module,
+                                       const ModuleId& child_module,
+                                       const size_t& child_instance,
+                                       const ModulePortId& child_port,
+                                       const size_t& child_pin) const {
+  size_t pin_index = port_pin_offsets_[child_module][child_port] + child_pin;
+  if (child_module == parent_module) {
+    return pin_index;
+  }
+  size_t child_index =
+    find_child_module_index_in_parent_module(parent_module, child_module);
+  VTR_ASSERT(size_t(-1) != child_index);
+  return instance_net_offsets_[parent_module][child_index][child_instance] +
+         pin_index;
+}
+
+vtr::Range<const size_t*> ModuleManager::net_src_terminal_ids(
+  const ModuleId& module, const ModuleNetId& net) const {
+  return find_net_terminal_data(net_src_terminal_ids_[module],
+                                net_src_offsets_[module],
+                                flat_net_src_terminal_ids_[module], net);
+}
+
+vtr::Range<const size_t*> ModuleManager::net_src_instance_ids(
+  const ModuleId& module, const ModuleNetId& net) const {
+  return find_net_terminal_data(net_src_instance_ids_[module],
+                                net_src_offsets_[module],
+                                flat_net_src_instance_ids_[module], net);
+}
+
+vtr::Range<const size_t*> ModuleManager::net_src_pin_ids(
+  const ModuleId& module, const ModuleNetId& net) const {
+  return find_net_terminal_data(net_src_pin_ids_[module],
+                                net_src_offsets_[module],
+                                flat_net_src_pin_ids_[module], net);
+}
+
+vtr::Range<const size_t*> ModuleManager::net_sink_terminal_ids(
+  const ModuleId& module, const ModuleNetId& net) const {
+  return find_net_terminal_data(net_sink_terminal_ids_[module],
+                                net_sink_offsets_[module],
+                                flat_net_sink_terminal_ids_[module], net);
+}
+
+vtr::Range<const size_t*> ModuleManager::net_sink_instance_ids(
+  const ModuleId& module, const ModuleNetId& net) const {
+  return find_net_terminal_data(net_sink_instance_ids_[module],
+                                net_sink_offsets_[module],
+                                flat_net_sink_instance_ids_[module], net);
+}
+
+vtr::Range<const size_t*> ModuleManager::net_sink_pin_ids(
+  const ModuleId& module, const ModuleNetId& net) const {
+  return find_net_terminal_data(net_sink_pin_ids_[module],
+                                net_sink_offsets_[module],
+                                flat_net_sink_pin_ids_[module], net);
+}
+
 /******************************************************************************
  * Public Mutators
  ******************************************************************************/
@@ -707,7 +1113,7 @@ size_t ModuleManager::find_child_module_index_in_parent_module(
 ModuleId ModuleManager::add_module(const std::string& name) {
   /* Find if the name has been used. If used, return an invalid Id and report
    * error! */
-  std::map<std::string, ModuleId>::iterator it = name_id_map_.find(name);
+  auto it = name_id_map_.find(name);
   if (it != name_id_map_.end()) {
     return ModuleId::INVALID();
   }
@@ -717,8 +1123,9 @@ ModuleId ModuleManager::add_module(const std::string& name) {
   ids_.push_back(module);
 
   /* Allocate other attributes */
-  names_.push_back(name);
+  names_.push_back(intern_symbol(name));
   usages_.push_back(NUM_MODULE_USAGE_TYPES);
+  circuit_models_.push_back(SymbolTable::EMPTY_SYMBOL);
   parents_.emplace_back();
   children_.emplace_back();
   num_child_instances_.emplace_back();
@@ -761,17 +1168,34 @@ ModuleId ModuleManager::add_module(const std::string& name) {
   net_sink_instance_ids_.emplace_back();
   net_sink_pin_ids_.emplace_back();
 
-  /* Register in the name-to-id map */
-  name_id_map_[name] = module;
+  /* Nets are created in the compressed layout, which grows at its end as long
+   * as the nets are built one after another */
+  net_src_offsets_.push_back(std::vector<size_t>(1, 0));
+  flat_net_src_ids_.emplace_back();
+  flat_net_src_terminal_ids_.emplace_back();
+  flat_net_src_instance_ids_.emplace_back();
+  flat_net_src_pin_ids_.emplace_back();
+
+  net_sink_offsets_.push_back(std::vector<size_t>(1, 0));
+  flat_net_sink_ids_.emplace_back();
+  flat_net_sink_terminal_ids_.emplace_back();
+  flat_net_sink_instance_ids_.emplace_back();
+  flat_net_sink_pin_ids_.emplace_back();
+
+  /* Register in the name-to-id map. The key refers to the interned name */
+  name_id_map_[symbol_string(names_[module])] = module;
 
   /* Build port lookup */
   port_lookup_.emplace_back();
   port_lookup_[module].resize(NUM_MODULE_PORT_TYPES);
 
   /* Build fast look-up for nets */
-  net_lookup_.emplace_back();
-  /* Reserve the instance 0 for the module */
-  net_lookup_[module][module].emplace_back();
+  port_pin_offsets_.emplace_back();
+  num_pins_.push_back(0);
+  child_index_lookup_.emplace_back();
+  instance_net_offsets_.emplace_back();
+  instance_net_lookup_.emplace_back();
+  self_net_lookup_.emplace_back();
 
   /* Return the new id */
   return module;
@@ -799,9 +1223,9 @@ ModulePortId ModuleManager::add_port(const ModuleId& module,
   port_lookup_[module][port_type].push_back(port);
 
   /* Update fast look-up for nets */
-  VTR_ASSERT_SAFE(1 == net_lookup_[module][module].size());
-  net_lookup_[module][module][0][port].resize(port_info.get_width(),
-                                              ModuleNetId::INVALID());
+  port_pin_offsets_[module].push_back(num_pins_[module]);
+  num_pins_[module] += port_info.get_width();
+  self_net_lookup_[module].resize(num_pins_[module], ModuleNetId::INVALID());
 
   return port;
 }
@@ -821,13 +1245,32 @@ void ModuleManager::set_module_name(const ModuleId& module,
                                     const std::string& name) {
   /* Validate the id of module */
   VTR_ASSERT(valid_module_id(module));
-  std::string old_name = names_[module];
-  names_[module] = name;
+  std::string_view old_name = symbol_string(names_[module]);
+  names_[module] = intern_symbol(name);
 
   /* Unregister the old name */
   name_id_map_.erase(old_name);
   /* Register the new name */
-  name_id_map_[name] = module;
+  name_id_map_[symbol_string(names_[module])] = module;
+}
+
+void ModuleManager::set_module_names(
+  const std::vector<std::pair<ModuleId, std::string>>& module_names) {
+  /* Unregister all the old names first, so that a new name which is the old
+   * name of another module in the group is not removed afterwards */
+  for (const auto& module_name : module_names) {
+    VTR_ASSERT(valid_module_id(module_name.first));
+    auto result = name_id_map_.find(symbol_string(names_[module_name.first]));
+    if ((result != name_id_map_.end()) &&
+        (module_name.first == result->second)) {
+      name_id_map_.erase(result);
+    }
+  }
+  /* Register the new names */
+  for (const auto& module_name : module_names) {
+    names_[module_name.first] = intern_symbol(module_name.second);
+    name_id_map_[symbol_string(names_[module_name.first])] = module_name.first;
+  }
 }
 
 void ModuleManager::set_module_usage(const ModuleId& module,
@@ -837,6 +1280,13 @@ void ModuleManager::set_module_usage(const ModuleId& module,
   usages_[module] = usage;
 }
 
+void ModuleManager::set_module_circuit_model(
+  const ModuleId& module, const std::string& circuit_model_name) {
+  /* Validate the id of module */
+  VTR_ASSERT(valid_module_id(module));
+  circuit_models_[module] = intern_symbol(circuit_model_name);
+}
+
 /* Set a port to be a wire */
 void ModuleManager::set_port_is_wire(const ModuleId& module,
                                      const std::string& port_name,
@@ -910,28 +1360,25 @@ void ModuleManager::add_child_module(const ModuleId& parent_module,
     parents_[child_module].push_back(parent_module);
   }
 
-  std::vector<ModuleId>::iterator child_it =
-    std::find(children_[parent_module].begin(), children_[parent_module].end(),
-              child_module);
+  size_t child_index =
+    find_child_module_index_in_parent_module(parent_module, child_module);
   int child_instance_id = -1;
-  if (child_it == children_[parent_module].end()) {
+  if (size_t(-1) == child_index) {
     /* Update the child module of parent module */
+    child_index = children_[parent_module].size();
     children_[parent_module].push_back(child_module);
+    child_index_lookup_[parent_module][child_module] = child_index;
     num_child_instances_[parent_module].push_back(1); /* By default give one */
     child_instance_id = 0;
     /* Update the instance name list */
     child_instance_names_[parent_module].emplace_back();
     child_instance_names_[parent_module].back().emplace_back();
+    instance_net_offsets_[parent_module].emplace_back();
   } else {
     /* Increase the counter of instances */
-    child_instance_id =
-      num_child_instances_[parent_module]
-                          [child_it - children_[parent_module].begin()];
-    num_child_instances_[parent_module]
-                        [child_it - children_[parent_module].begin()]++;
-    child_instance_names_[parent_module]
-                         [child_it - children_[parent_module].begin()]
-                           .emplace_back();
+    child_instance_id = num_child_instances_[parent_module][child_index];
+    num_child_instances_[parent_module][child_index]++;
+    child_instance_names_[parent_module][child_index].emplace_back();
   }
 
   /* Add to I/O child if needed */
@@ -939,13 +1386,132 @@ void ModuleManager::add_child_module(const ModuleId& parent_module,
     add_io_child(parent_module, child_module, child_instance_id);
   }
 
-  /* Update fast look-up for nets */
-  size_t instance_id = net_lookup_[parent_module][child_module].size();
-  net_lookup_[parent_module][child_module].emplace_back();
-  /* Find the ports for the child module and update the fast look-up */
-  for (ModulePortId child_port : port_ids_[child_module]) {
-    net_lookup_[parent_module][child_module][instance_id][child_port].resize(
-      ports_[child_module][child_port].get_width(), ModuleNetId::INVALID());
+  /* Update fast look-up for nets: allocate a slice for all the pins of the
+   * new instance */
+  std::vector<ModuleNetId>& instance_nets = instance_net_lookup_[parent_module];
+  instance_net_offsets_[parent_module][child_index].push_back(
+    instance_nets.size());
+  instance_nets.resize(instance_nets.size() + num_pins_[child_module],
+                       ModuleNetId::INVALID());
+}
+
+/* Replace the instances of a child module by the ones of another module */
+void ModuleManager::replace_child_module(const ModuleId& parent_module,
+                                         const ModuleId& old_child_module,
+                                         const ModuleId& new_child_module) {
+  VTR_ASSERT(valid_module_id(parent_module));
+  VTR_ASSERT(valid_module_id(old_child_module));
+  VTR_ASSERT(valid_module_id(new_child_module));
+  VTR_ASSERT(old_child_module != new_child_module);
+  VTR_ASSERT(num_pins_[old_child_module] == num_pins_[new_child_module]);
+
+  size_t old_index =
+    find_child_module_index_in_parent_module(parent_module, old_child_module);
+  VTR_ASSERT(size_t(-1) != old_index);
+  size_t new_index =
+    find_child_module_index_in_parent_module(parent_module, new_child_module);
+
+  /* The instances of the old child are appended to the ones of the new child,
+   * if the new child is already under the parent */
+  size_t instance_offset = 0;
+  if (size_t(-1) == new_index) {
+    children_[parent_module][old_index] = new_child_module;
+    child_index_lookup_[parent_module].erase(old_child_module);
+    child_index_lookup_[parent_module][new_child_module] = old_index;
+  } else {
+    instance_offset = num_child_instances_[parent_module][new_index];
+    num_child_instances_[parent_module][new_index] +=
+      num_child_instances_[parent_module][old_index];
+    std::vector<SymbolId>& new_names =
+      child_instance_names_[parent_module][new_index];
+    const std::vector<SymbolId>& old_names =
+      child_instance_names_[parent_module][old_index];
+    new_names.insert(new_names.end(), old_names.begin(), old_names.end());
+    /* The nets of each instance are stored in its own slice, which is moved
+     * with the instance */
+    std::vector<size_t>& new_offsets =
+      instance_net_offsets_[parent_module][new_index];
+    const std::vector<size_t>& old_offsets =
+      instance_net_offsets_[parent_module][old_index];
+    new_offsets.insert(new_offsets.end(), old_offsets.begin(),
+                       old_offsets.end());
+
+    children_[parent_module].erase(children_[parent_module].begin() +
+                                   old_index);
+    num_child_instances_[parent_module].erase(
+      num_child_instances_[parent_module].begin() + old_index);
+    child_instance_names_[parent_module].erase(
+      child_instance_names_[parent_module].begin() + old_index);
+    instance_net_offsets_[parent_module].erase(
+      instance_net_offsets_[parent_module].begin() + old_index);
+    child_index_lookup_[parent_module].clear();
+    for (size_t ichild = 0; ichild < children_[parent_module].size();
+         ++ichild) {
+      child_index_lookup_[parent_module][children_[parent_module][ichild]] =
+        ichild;
+    }
+  }
+
+  /* Update the parents of both child modules */
+  std::vector<ModuleId>& old_parents = parents_[old_child_module];
+  old_parents.erase(
+    std::remove(old_parents.begin(), old_parents.end(), parent_module),
+    old_parents.end());
+  if (parents_[new_child_module].end() ==
+      std::find(parents_[new_child_module].begin(),
+                parents_[new_child_module].end(), parent_module)) {
+    parents_[new_child_module].push_back(parent_module);
+  }
+
+  /* Update configurable children and I/O children */
+  auto replace_children = [&](std::vector<ModuleId>& children,
+                              std::vector<size_t>& instances) {
+    for (size_t ichild = 0; ichild < children.size(); ++ichild) {
+      if (old_child_module == children[ichild]) {
+        children[ichild] = new_child_module;
+        instances[ichild] += instance_offset;
+      }
+    }
+  };
+  replace_children(logical_configurable_children_[parent_module],
+                   logical_configurable_child_instances_[parent_module]);
+  replace_children(physical_configurable_children_[parent_module],
+                   physical_configurable_child_instances_[parent_module]);
+  replace_children(io_children_[parent_module],
+                   io_child_instances_[parent_module]);
+  std::replace(logical2physical_configurable_children_[parent_module].begin(),
+               logical2physical_configurable_children_[parent_module].end(),
+               old_child_module, new_child_module);
+
+  /* Update the terminals of nets which are the pins of the old child. Note
+   * that new terminals may be added to the storage during the loop */
+  std::unordered_map<size_t, size_t> terminal_map;
+  size_t num_terminals = net_terminal_storage_.size();
+  for (size_t iterm = 0; iterm < num_terminals; ++iterm) {
+    if (old_child_module == net_terminal_storage_[iterm].first) {
+      terminal_map[iterm] = find_net_terminal_id(
+        new_child_module, net_terminal_storage_[iterm].second);
+    }
+  }
+  replace_net_terminal_data(flat_net_src_terminal_ids_[parent_module],
+                            flat_net_src_instance_ids_[parent_module],
+                            terminal_map, instance_offset);
+  replace_net_terminal_data(flat_net_sink_terminal_ids_[parent_module],
+                            flat_net_sink_instance_ids_[parent_module],
+                            terminal_map, instance_offset);
+  for (size_t inet = 0; inet < net_src_terminal_ids_[parent_module].size();
+       ++inet) {
+    ModuleNetId net = ModuleNetId(inet);
+    replace_net_terminal_data(net_src_terminal_ids_[parent_module][net],
+                              net_src_instance_ids_[parent_module][net],
+                              terminal_map, instance_offset);
+  }
+  for (size_t inet = 0; inet < net_sink_terminal_ids_[parent_module].size();
+       ++inet) {
+    ModuleNetId net = ModuleNetId(inet);
+    replace_net_terminal_data(net_sink_terminal_ids_[parent_module][net],
+                              net_sink_instance_ids_[parent_module][net],
+                              terminal_map, instance_offset);
   }
 }
 
@@ -966,7 +1532,7 @@ void ModuleManager::set_child_instance_name(const ModuleId& parent_module,
   VTR_ASSERT(size_t(-1) != child_index);
   /* Set the name */
   child_instance_names_[parent_module][child_index][instance_id] =
-    instance_name;
+    intern_symbol(instance_name);
 }
 
 /* Add a configurable child module to module
@@ -1036,7 +1602,8 @@ void ModuleManager::set_logical2physical_configurable_child_instance_name(
                parent_module, ModuleManager::e_config_child_type::LOGICAL));
   /* Create the pair */
   logical2physical_configurable_child_instance_names_
-    [parent_module][logical_child_id] = physical_child_instance_name;
+    [parent_module][logical_child_id] =
+      intern_symbol(physical_child_instance_name);
 }
 
 void ModuleManager::reserve_configurable_child(
@@ -1182,6 +1749,11 @@ void ModuleManager::reserve_module_nets(const ModuleId& module,
   VTR_ASSERT(valid_module_id(module));
 
   net_names_[module].reserve(num_nets);
+  if (true == module_nets_compressed(module)) {
+    net_src_offsets_[module].reserve(num_nets + 1);
+    net_sink_offsets_[module].reserve(num_nets + 1);
+    return;
+  }
   net_src_ids_[module].reserve(num_nets);
   net_src_terminal_ids_[module].reserve(num_nets);
   net_src_instance_ids_[module].reserve(num_nets);
@@ -1204,6 +1776,12 @@ ModuleNetId ModuleManager::create_module_net(const ModuleId& module) {
 
   /* Allocate net-related data structures */
   net_names_[module].emplace_back();
+  if (true == module_nets_compressed(module)) {
+    /* The new net has no source and sink yet */
+    net_src_offsets_[module].push_back(net_src_offsets_[module].back());
+    net_sink_offsets_[module].push_back(net_sink_offsets_[module].back());
+    return net;
+  }
   net_src_ids_[module].emplace_back();
   net_src_terminal_ids_[module].emplace_back();
   net_src_instance_ids_[module].emplace_back();
@@ -1229,7 +1807,7 @@ void ModuleManager::set_net_name(const ModuleId& module, const ModuleNetId& net,
   /* Validate module net */
   VTR_ASSERT(valid_module_net_id(module, net));
 
-  net_names_[module][net] = name;
+  net_names_[module][net] = intern_symbol(name);
 }
 
 void ModuleManager::reserve_module_net_sources(const ModuleId& module,
@@ -1237,6 +1815,11 @@ void ModuleManager::reserve_module_net_sources(const ModuleId& module,
                                                const size_t& num_sources) {
   /* Validate module net */
   VTR_ASSERT(valid_module_net_id(module, net));
+  /* The terminals of the last net are appended to the compressed layout */
+  if (true == is_last_compressed_net(module, net)) {
+    return;
+  }
+  expand_module_nets(module);
 
   net_src_ids_[module][net].reserve(num_sources);
   net_src_terminal_ids_[module][net].reserve(num_sources);
@@ -1252,49 +1835,53 @@ ModuleNetSrcId ModuleManager::add_module_net_source(
   /* Validate the module and net id */
   VTR_ASSERT(valid_module_net_id(module, net));
 
-  /* Create a new id for src node */
-  ModuleNetSrcId net_src = ModuleNetSrcId(net_src_ids_[module][net].size());
-  net_src_ids_[module][net].push_back(net_src);
-
   /* Validate the source module */
   VTR_ASSERT(valid_module_id(src_module));
 
   /* Validate the port exists in the src module */
   VTR_ASSERT(valid_module_port_id(src_module, src_port));
 
-  /* Create pair of module and port
-   * Search in the storage. If found, use the existing pair
-   * Otherwise, add the pair
-   */
-  std::pair<ModuleId, ModulePortId> terminal(src_module, src_port);
-  std::vector<std::pair<ModuleId, ModulePortId>>::iterator it = std::find(
-    net_terminal_storage_.begin(), net_terminal_storage_.end(), terminal);
-  if (it == net_terminal_storage_.end()) {
-    net_src_terminal_ids_[module][net].push_back(net_terminal_storage_.size());
-    net_terminal_storage_.push_back(terminal);
-  } else {
-    VTR_ASSERT_SAFE(it != net_terminal_storage_.end());
-    net_src_terminal_ids_[module][net].push_back(
-      std::distance(net_terminal_storage_.begin(), it));
-  }
-
   /* if it has the same id as module, our instance id will be by default 0 */
   size_t src_instance_id = instance_id;
   if (src_module == module) {
     src_instance_id = 0;
-    net_src_instance_ids_[module][net].push_back(src_instance_id);
   } else {
     /* Check the instance id of the src module */
     VTR_ASSERT(src_instance_id < num_instance(module, src_module));
-    net_src_instance_ids_[module][net].push_back(src_instance_id);
   }
 
   /* Validate the pin id is in the range of the port width */
   VTR_ASSERT(src_pin < module_port(src_module, src_port).get_width());
-  net_src_pin_ids_[module][net].push_back(src_pin);
+
+  size_t terminal_id = find_net_terminal_id(src_module, src_port);
+
+  /* Create a new id for src node */
+  ModuleNetSrcId net_src;
+  if (true == is_last_compressed_net(module, net)) {
+    std::vector<size_t>& offsets = net_src_offsets_[module];
+    net_src = ModuleNetSrcId(offsets.back() - offsets[size_t(net)]);
+    flat_net_src_ids_[module].push_back(net_src);
+    flat_net_src_terminal_ids_[module].push_back(terminal_id);
+    flat_net_src_instance_ids_[module].push_back(src_instance_id);
+    flat_net_src_pin_ids_[module].push_back(src_pin);
+    offsets.back()++;
+  } else {
+    expand_module_nets(module);
+    net_src = ModuleNetSrcId(net_src_ids_[module][net].size());
+    net_src_ids_[module][net].push_back(net_src);
+    net_src_terminal_ids_[module][net].push_back(terminal_id);
+    net_src_instance_ids_[module][net].push_back(src_instance_id);
+    net_src_pin_ids_[module][net].push_back(src_pin);
+  }
 
   /* Update fast look-up for nets */
-  net_lookup_[module][src_module][src_instance_id][src_port][src_pin] = net;
+  size_t lookup_index = net_lookup_index(module, src_module, src_instance_id,
+                                         src_port, src_pin);
+  if (src_module == module) {
+    self_net_lookup_[module][lookup_index] = net;
+  } else {
+    instance_net_lookup_[module][lookup_index] = net;
+  }
 
   return net_src;
 }
@@ -1304,6 +1891,11 @@ void ModuleManager::reserve_module_net_sinks(const ModuleId& module,
                                              const size_t& num_sinks) {
   /* Validate module net */
   VTR_ASSERT(valid_module_net_id(module, net));
+  /* The terminals of the last net are appended to the compressed layout */
+  if (true == is_last_compressed_net(module, net)) {
+    return;
+  }
+  expand_module_nets(module);
 
   net_sink_ids_[module][net].reserve(num_sinks);
   net_sink_terminal_ids_[module][net].reserve(num_sinks);
@@ -1319,53 +1911,87 @@ ModuleNetSinkId ModuleManager::add_module_net_sink(
   /* Validate the module and net id */
   VTR_ASSERT(valid_module_net_id(module, net));
 
-  /* Create a new id for sink node */
-  ModuleNetSinkId net_sink = ModuleNetSinkId(net_sink_ids_[module][net].size());
-  net_sink_ids_[module][net].push_back(net_sink);
-
   /* Validate the source module */
   VTR_ASSERT(valid_module_id(sink_module));
 
   /* Validate the port exists in the sink module */
   VTR_ASSERT(valid_module_port_id(sink_module, sink_port));
 
-  /* Create pair of module and port
-   * Search in the storage. If found, use the existing pair
-   * Otherwise, add the pair
-   */
-  std::pair<ModuleId, ModulePortId> terminal(sink_module, sink_port);
-  std::vector<std::pair<ModuleId, ModulePortId>>::iterator it = std::find(
-    net_terminal_storage_.begin(), net_terminal_storage_.end(), terminal);
-  if (it == net_terminal_storage_.end()) {
-    net_sink_terminal_ids_[module][net].push_back(net_terminal_storage_.size());
-    net_terminal_storage_.push_back(terminal);
-  } else {
-    VTR_ASSERT_SAFE(it != net_terminal_storage_.end());
-    net_sink_terminal_ids_[module][net].push_back(
-      std::distance(net_terminal_storage_.begin(), it));
-  }
-
   /* if it has the same id as module, our instance id will be by default 0 */
   size_t sink_instance_id = instance_id;
   if (sink_module == module) {
     sink_instance_id = 0;
-    net_sink_instance_ids_[module][net].push_back(sink_instance_id);
   } else {
     /* Check the instance id of the src module */
     VTR_ASSERT(sink_instance_id < num_instance(module, sink_module));
-    net_sink_instance_ids_[module][net].push_back(sink_instance_id);
   }
 
   /* Validate the pin id is in the range of the port width */
   VTR_ASSERT(sink_pin < module_port(sink_module, sink_port).get_width());
-  net_sink_pin_ids_[module][net].push_back(sink_pin);
+
+  size_t terminal_id = find_net_terminal_id(sink_module, sink_port);
+
+  /* Create a new id for sink node */
+  ModuleNetSinkId net_sink;
+  if (true == is_last_compressed_net(module, net)) {
+    std::vector<size_t>& offsets = net_sink_offsets_[module];
+    net_sink = ModuleNetSinkId(offsets.back() - offsets[size_t(net)]);
+    flat_net_sink_ids_[module].push_back(net_sink);
+    flat_net_sink_terminal_ids_[module].push_back(terminal_id);
+    flat_net_sink_instance_ids_[module].push_back(sink_instance_id);
+    flat_net_sink_pin_ids_[module].push_back(sink_pin);
+    offsets.back()++;
+  } else {
+    expand_module_nets(module);
+    net_sink = ModuleNetSinkId(net_sink_ids_[module][net].size());
+    net_sink_ids_[module][net].push_back(net_sink);
+    net_sink_terminal_ids_[module][net].push_back(terminal_id);
+    net_sink_instance_ids_[module][net].push_back(sink_instance_id);
+    net_sink_pin_ids_[module][net].push_back(sink_pin);
+  }
 
   /* Update fast look-up for nets */
-  net_lookup_[module][sink_module][sink_instance_id][sink_port][sink_pin] = net;
+  size_t lookup_index = net_lookup_index(module, sink_module, sink_instance_id,
+                                         sink_port, sink_pin);
+  if (sink_module == module) {
+    self_net_lookup_[module][lookup_index] = net;
+  } else {
+    instance_net_lookup_[module][lookup_index] = net;
+  }
 
   return net_sink;
 }
 
+size_t ModuleManager::append_nets(const ModuleId& module,
+                                  const ModuleNetBuffer& buffer,
+                                  const bool& merge_source_nets) {
+  /* Validate the module id */
+  VTR_ASSERT(valid_module_id(module));
+
+  reserve_appended_module_nets(module, buffer.num_nets());
+  return append_buffered_nets(module, buffer, merge_source_nets);
+}
+
+size_t ModuleManager::append_nets(const ModuleId& module,
+                                  const std::vector<ModuleNetBuffer>& buffers,
+                                  const bool& merge_source_nets) {
+  /* Validate the module id */
+  VTR_ASSERT(valid_module_id(module));
+
+  size_t num_staged_nets = 0;
+  for (const ModuleNetBuffer& buffer : buffers) {
+    num_staged_nets += buffer.num_nets();
+  }
+  reserve_appended_module_nets(module, num_staged_nets);
+
+  size_t num_created_nets = 0;
+  for (const ModuleNetBuffer& buffer : buffers) {
+    num_created_nets +=
+      append_buffered_nets(module, buffer, merge_source_nets);
+  }
+  return num_created_nets;
+}
+
 ModuleId ModuleManager::create_wrapper_module(
   const ModuleId& existing_module, const std::string& wrapper_module_name,
   const std::string& instance_name, const bool& add_nets) {
@@ -1452,6 +2078,251 @@ ModuleId ModuleManager::create_wrapper_module(
   return wrapper_module;
 }
 
+ModuleId ModuleManager::import_module(
+  const ModuleManager& src_module_manager, const ModuleId& src_module,
+  const vtr::vector<ModuleId, ModuleId>& module_map) {
+  const ModuleManager& src = src_module_manager;
+  VTR_ASSERT(src.valid_module_id(src_module));
+
+  ModuleId module = add_module(symbol_string(src.names_[src_module]));
+  if (!module) {
+    return module;
+  }
+  usages_[module] = src.usages_[src_module];
+  circuit_models_[module] = src.circuit_models_[src_module];
+
+  /* Translate a module id of the source module manager to this one */
+  auto map_module = [&](const ModuleId& src_id) {
+    if (src_id == src_module) {
+      return module;
+    }
+    /* Logical configurable children may not be mapped to physical ones */
+    if (!src_id) {
+      return ModuleId::INVALID();
+    }
+    VTR_ASSERT(size_t(src_id) < module_map.size());
+    ModuleId mapped_id = module_map[src_id];
+    VTR_ASSERT(valid_module_id(mapped_id));
+    return mapped_id;
+  };
+
+  /* Child modules. The new module is added to the parents of a child when
+   * the child is first seen in the look-up */
+  for (const ModuleId& src_child : src.children_[src_module]) {
+    ModuleId child = map_module(src_child);
+    if (true == child_index_lookup_[module]
+                  .emplace(child, children_[module].size())
+                  .second) {
+      parents_[child].push_back(module);
+    }
+    children_[module].push_back(child);
+  }
+  num_child_instances_[module] = src.num_child_instances_[src_module];
+  child_instance_names_[module] = src.child_instance_names_[src_module];
+
+  /* Configurable children */
+  for (const ModuleId& src_child :
+       src.logical_configurable_children_[src_module]) {
+    logical_configurable_children_[module].push_back(map_module(src_child));
+  }
+  logical_configurable_child_instances_[module] =
+    src.logical_configurable_child_instances_[src_module];
+  for (const ModuleId& src_child :
+       src.logical2physical_configurable_children_[src_module]) {
+    logical2physical_configurable_children_[module].push_back(
+      map_module(src_child));
+  }
+  logical2physical_configurable_child_instance_names_[module] =
+    src.logical2physical_configurable_child_instance_names_[src_module];
+  for (const ModuleId& src_child :
+       src.physical_configurable_children_[src_module]) {
+    physical_configurable_children_[module].push_back(map_module(src_child));
+  }
+  physical_configurable_child_instances_[module] =
+    src.physical_configurable_child_instances_[src_module];
+  physical_configurable_child_regions_[module] =
+    src.physical_configurable_child_regions_[src_module];
+  physical_configurable_child_coordinates_[module] =
+    src.physical_configurable_child_coordinates_[src_module];
+  config_region_ids_[module] = src.config_region_ids_[src_module];
+  config_region_children_[module] = src.config_region_children_[src_module];
+
+  /* I/O children */
+  for (const ModuleId& src_child : src.io_children_[src_module]) {
+    io_children_[module].push_back(map_module(src_child));
+  }
+  io_child_instances_[module] = src.io_child_instances_[src_module];
+  io_child_coordinates_[module] = src.io_child_coordinates_[src_module];
+
+  /* Ports */
+  port_ids_[module] = src.port_ids_[src_module];
+  ports_[module] = src.ports_[src_module];
+  port_types_[module] = src.port_types_[src_module];
+  port_is_mappable_io_[module] = src.port_is_mappable_io_[src_module];
+  port_is_wire_[module] = src.port_is_wire_[src_module];
+  port_is_register_[module] = src.port_is_register_[src_module];
+  port_preproc_flags_[module] = src.port_preproc_flags_[src_module];
+  port_lookup_[module] = src.port_lookup_[src_module];
+
+  /* Nets */
+  num_nets_[module] = src.num_nets_[src_module];
+  invalid_net_ids_[module] = src.invalid_net_ids_[src_module];
+  net_names_[module] = src.net_names_[src_module];
+  net_src_ids_[module] = src.net_src_ids_[src_module];
+  net_src_terminal_ids_[module] = src.net_src_terminal_ids_[src_module];
+  net_src_instance_ids_[module] = src.net_src_instance_ids_[src_module];
+  net_src_pin_ids_[module] = src.net_src_pin_ids_[src_module];
+  net_sink_ids_[module] = src.net_sink_ids_[src_module];
+  net_sink_terminal_ids_[module] = src.net_sink_terminal_ids_[src_module];
+  net_sink_instance_ids_[module] = src.net_sink_instance_ids_[src_module];
+  net_sink_pin_ids_[module] = src.net_sink_pin_ids_[src_module];
+  net_src_offsets_[module] = src.net_src_offsets_[src_module];
+  flat_net_src_ids_[module] = src.flat_net_src_ids_[src_module];
+  flat_net_src_terminal_ids_[module] =
+    src.flat_net_src_terminal_ids_[src_module];
+  flat_net_src_instance_ids_[module] =
+    src.flat_net_src_instance_ids_[src_module];
+  flat_net_src_pin_ids_[module] = src.flat_net_src_pin_ids_[src_module];
+  net_sink_offsets_[module] = src.net_sink_offsets_[src_module];
+  flat_net_sink_ids_[module] = src.flat_net_sink_ids_[src_module];
+  flat_net_sink_terminal_ids_[module] =
+    src.flat_net_sink_terminal_ids_[src_module];
+  flat_net_sink_instance_ids_[module] =
+    src.flat_net_sink_instance_ids_[src_module];
+  flat_net_sink_pin_ids_[module] = src.flat_net_sink_pin_ids_[src_module];
+
+  /* Net terminals are indices in the storage of each module manager, which
+   * should be translated as well */
+  std::unordered_map<size_t, size_t> terminal_map;
+  auto map_terminal = [&](const size_t& src_terminal) {
+    auto result = terminal_map.find(src_terminal);
+    if (result != terminal_map.end()) {
+      return result->second;
+    }
+    size_t terminal_id = find_net_terminal_id(
+      map_module(src.net_terminal_storage_[src_terminal].first),
+      src.net_terminal_storage_[src_terminal].second);
+    terminal_map[src_terminal] = terminal_id;
+    return terminal_id;
+  };
+  for (auto& net_terminals : net_src_terminal_ids_[module]) {
+    for (size_t& terminal : net_terminals) {
+      terminal = map_terminal(terminal);
+    }
+  }
+  for (auto& net_terminals : net_sink_terminal_ids_[module]) {
+    for (size_t& terminal : net_terminals) {
+      terminal = map_terminal(terminal);
+    }
+  }
+  for (size_t& terminal : flat_net_src_terminal_ids_[module]) {
+    terminal = map_terminal(terminal);
+  }
+  for (size_t& terminal : flat_net_sink_terminal_ids_[module]) {
+    terminal = map_terminal(terminal);
+  }
+
+  /* Fast look-up for nets. The children and ports are in the same order as
+   * in the source, so the look-up can be copied as it is */
+  port_pin_offsets_[module] = src.port_pin_offsets_[src_module];
+  num_pins_[module] = src.num_pins_[src_module];
+  instance_net_offsets_[module] = src.instance_net_offsets_[src_module];
+  instance_net_lookup_[module] = src.instance_net_lookup_[src_module];
+  self_net_lookup_[module] = src.self_net_lookup_[src_module];
+
+  return module;
+}
+
+void ModuleManager::compress_module_nets(const ModuleId& module) {
+  VTR_ASSERT(valid_module_id(module));
+  if (true == module_nets_compressed(module)) {
+    return;
+  }
+  compress_net_terminals(
+    net_src_ids_[module], net_src_terminal_ids_[module],
+    net_src_instance_ids_[module], net_src_pin_ids_[module],
+    net_src_offsets_[module], flat_net_src_ids_[module],
+    flat_net_src_terminal_ids_[module], flat_net_src_instance_ids_[module],
+    flat_net_src_pin_ids_[module]);
+  compress_net_terminals(
+    net_sink_ids_[module], net_sink_terminal_ids_[module],
+    net_sink_instance_ids_[module], net_sink_pin_ids_[module],
+    net_sink_offsets_[module], flat_net_sink_ids_[module],
+    flat_net_sink_terminal_ids_[module], flat_net_sink_instance_ids_[module],
+    flat_net_sink_pin_ids_[module]);
+}
+
+/******************************************************************************
+ * Private mutators
+ ******************************************************************************/
+/* Find the index of a pair of module and port in the storage of net
+ * terminals. The pair is added to the storage if not found */
+size_t ModuleManager::find_net_terminal_id(const ModuleId& module,
+                                           const ModulePortId& port) {
+  auto result = net_terminal_lookup_.emplace(
+    std::array<size_t, 2>{size_t(module), size_t(port)},
+    net_terminal_storage_.size());
+  if (true == result.second) {
+    net_terminal_storage_.emplace_back(module, port);
+  }
+  return result.first->second;
+}
+
+void ModuleManager::expand_module_nets(const ModuleId& module) {
+  if (false == module_nets_compressed(module)) {
+    return;
+  }
+  expand_net_terminals(
+    net_src_ids_[module], net_src_terminal_ids_[module],
+    net_src_instance_ids_[module], net_src_pin_ids_[module],
+    net_src_offsets_[module], flat_net_src_ids_[module],
+    flat_net_src_terminal_ids_[module], flat_net_src_instance_ids_[module],
+    flat_net_src_pin_ids_[module]);
+  expand_net_terminals(
+    net_sink_ids_[module], net_sink_terminal_ids_[module],
+    net_sink_instance_ids_[module], net_sink_pin_ids_[module],
+    net_sink_offsets_[module], flat_net_sink_ids_[module],
+    flat_net_sink_terminal_ids_[module], flat_net_sink_instance_ids_[module],
+    flat_net_sink_pin_ids_[module]);
+}
+
+/* Reserve the nets of a module for the worst case where none of the appended
+ * nets is merged. Grow geometrically, so that repeated appending does not
+ * reallocate the nets every time */
+void ModuleManager::reserve_appended_module_nets(const ModuleId& module,
+                                                 const size_t& num_nets) {
+  size_t num_required_nets = num_nets_[module] + num_nets;
+  if (num_required_nets > net_names_[module].capacity()) {
+    reserve_module_nets(module, std::max(num_required_nets,
+                                         2 * net_names_[module].capacity()));
+  }
+}
+
+size_t ModuleManager::append_buffered_nets(const ModuleId& module,
+                                           const ModuleNetBuffer& buffer,
+                                           const bool& merge_source_nets) {
+  size_t num_created_nets = 0;
+  for (size_t inet = 0; inet < buffer.num_nets(); ++inet) {
+    const ModuleNetTerminal& src = buffer.net_source(inet);
+    ModuleNetId net = ModuleNetId::INVALID();
+    if (true == merge_source_nets) {
+      net = module_instance_port_net(module, src.module, src.instance,
+                                     src.port, src.pin);
+    }
+    if (ModuleNetId::INVALID() == net) {
+      net = create_module_net(module);
+      add_module_net_source(module, net, src.module, src.instance, src.port,
+                            src.pin);
+      num_created_nets++;
+    }
+    for (const ModuleNetTerminal& sink : buffer.net_sinks(inet)) {
+      add_module_net_sink(module, net, sink.module, sink.instance, sink.port,
+                          sink.pin);
+    }
+  }
+  return num_created_nets;
+}
+
 /******************************************************************************
  * Public Deconstructor
  ******************************************************************************/
@@ -1487,12 +2358,228 @@ void ModuleManager::clear_io_children(const ModuleId& parent_module) {
 void ModuleManager::clear_module_net_sinks(const ModuleId& parent_module,
                                            const ModuleNetId& net) {
   VTR_ASSERT(valid_module_net_id(parent_module, net));
+  expand_module_nets(parent_module);
   net_sink_ids_[parent_module][net].clear();
   net_sink_terminal_ids_[parent_module][net].clear();
   net_sink_instance_ids_[parent_module][net].clear();
   net_sink_pin_ids_[parent_module][net].clear();
 }
 
+/******************************************************************************
+ * Public Serializers
+ ******************************************************************************/
+/* Remap the symbols loaded from a binary stream to the current symbol table */
+/* Return false if a symbol does not exist in the dumped symbol table */
+static bool remap_symbol(SymbolId& symbol,
+                         const std::vector<SymbolId>& symbol_map) {
+  if (size_t(symbol) >= symbol_map.size()) {
+    return false;
+  }
+  symbol = symbol_map[symbol];
+  return true;
+}
+
+template <class SymbolContainer>
+static bool remap_symbols(SymbolContainer& symbols,
+                          const std::vector<SymbolId>& symbol_map) {
+  for (SymbolId& symbol : symbols) {
+    if (false == remap_symbol(symbol, symbol_map)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void ModuleManager::write_binary(std::ostream& fp) const {
+  /* Names are stored as symbol ids, which are only meaningful with the symbol
+   * table of this process. Dump the strings first, so that the reader can
+   * intern them again */
+  size_t num_symbols = SymbolTable::instance().size();
+  write_binary_size(fp, num_symbols);
+  for (size_t isym = 0; isym < num_symbols; ++isym) {
+    write_binary_data(fp, symbol_string(SymbolId(isym)));
+  }
+
+  write_binary_data(fp, ids_);
+  write_binary_data(fp, names_);
+  write_binary_data(fp, usages_);
+  write_binary_data(fp, circuit_models_);
+  write_binary_data(fp, parents_);
+  write_binary_data(fp, children_);
+  write_binary_data(fp, num_child_instances_);
+  write_binary_data(fp, child_instance_names_);
+  write_binary_data(fp, logical_configurable_children_);
+  write_binary_data(fp, logical_configurable_child_instances_);
+  write_binary_data(fp, logical2physical_configurable_children_);
+  write_binary_data(fp, logical2physical_configurable_child_instance_names_);
+  write_binary_data(fp, physical_configurable_children_);
+  write_binary_data(fp, physical_configurable_child_instances_);
+  write_binary_data(fp, physical_configurable_child_regions_);
+  write_binary_data(fp, physical_configurable_child_coordinates_);
+  write_binary_data(fp, config_region_ids_);
+  write_binary_data(fp, config_region_children_);
+  write_binary_data(fp, io_children_);
+  write_binary_data(fp, io_child_instances_);
+  write_binary_data(fp, io_child_coordinates_);
+
+  write_binary_data(fp, port_ids_);
+  write_binary_data(fp, ports_);
+  write_binary_data(fp, port_types_);
+  write_binary_data(fp, port_is_mappable_io_);
+  write_binary_data(fp, port_is_wire_);
+  write_binary_data(fp, port_is_register_);
+  write_binary_data(fp, port_preproc_flags_);
+
+  write_binary_data(fp, num_nets_);
+  write_binary_data(fp, invalid_net_ids_);
+  write_binary_data(fp, net_names_);
+  write_binary_data(fp, net_src_ids_);
+  write_binary_data(fp, net_src_terminal_ids_);
+  write_binary_data(fp, net_src_instance_ids_);
+  write_binary_data(fp, net_src_pin_ids_);
+  write_binary_data(fp, net_sink_ids_);
+  write_binary_data(fp, net_sink_terminal_ids_);
+  write_binary_data(fp, net_sink_instance_ids_);
+  write_binary_data(fp, net_sink_pin_ids_);
+  write_binary_data(fp, net_src_offsets_);
+  write_binary_data(fp, flat_net_src_ids_);
+  write_binary_data(fp, flat_net_src_terminal_ids_);
+  write_binary_data(fp, flat_net_src_instance_ids_);
+  write_binary_data(fp, flat_net_src_pin_ids_);
+  write_binary_data(fp, net_sink_offsets_);
+  write_binary_data(fp, flat_net_sink_ids_);
+  write_binary_data(fp, flat_net_sink_terminal_ids_);
+  write_binary_data(fp, flat_net_sink_instance_ids_);
+  write_binary_data(fp, flat_net_sink_pin_ids_);
+
+  /* Fast look-ups are saved as well, which is cheaper than rebuilding them */
+  write_binary_data(fp, port_lookup_);
+  write_binary_data(fp, port_pin_offsets_);
+  write_binary_data(fp, num_pins_);
+  write_binary_data(fp, child_index_lookup_);
+  write_binary_data(fp, instance_net_offsets_);
+  write_binary_data(fp, instance_net_lookup_);
+  write_binary_data(fp, self_net_lookup_);
+  write_binary_data(fp, net_terminal_storage_);
+}
+
+void ModuleManager::read_binary(std::istream& fp) {
+  /* Intern the names again, which may result in different symbol ids */
+  std::vector<SymbolId> symbol_map(read_binary_container_size(fp, 1));
+  for (SymbolId& symbol : symbol_map) {
+    std::string name;
+    read_binary_data(fp, name);
+    symbol = intern_symbol(name);
+  }
+
+  read_binary_data(fp, ids_);
+  read_binary_data(fp, names_);
+  read_binary_data(fp, usages_);
+  read_binary_data(fp, circuit_models_);
+  read_binary_data(fp, parents_);
+  read_binary_data(fp, children_);
+  read_binary_data(fp, num_child_instances_);
+  read_binary_data(fp, child_instance_names_);
+  read_binary_data(fp, logical_configurable_children_);
+  read_binary_data(fp, logical_configurable_child_instances_);
+  read_binary_data(fp, logical2physical_configurable_children_);
+  read_binary_data(fp, logical2physical_configurable_child_instance_names_);
+  read_binary_data(fp, physical_configurable_children_);
+  read_binary_data(fp, physical_configurable_child_instances_);
+  read_binary_data(fp, physical_configurable_child_regions_);
+  read_binary_data(fp, physical_configurable_child_coordinates_);
+  read_binary_data(fp, config_region_ids_);
+  read_binary_data(fp, config_region_children_);
+  read_binary_data(fp, io_children_);
+  read_binary_data(fp, io_child_instances_);
+  read_binary_data(fp, io_child_coordinates_);
+
+  read_binary_data(fp, port_ids_);
+  read_binary_data(fp, ports_);
+  read_binary_data(fp, port_types_);
+  read_binary_data(fp, port_is_mappable_io_);
+  read_binary_data(fp, port_is_wire_);
+  read_binary_data(fp, port_is_register_);
+  read_binary_data(fp, port_preproc_flags_);
+
+  read_binary_data(fp, num_nets_);
+  read_binary_data(fp, invalid_net_ids_);
+  read_binary_data(fp, net_names_);
+  read_binary_data(fp, net_src_ids_);
+  read_binary_data(fp, net_src_terminal_ids_);
+  read_binary_data(fp, net_src_instance_ids_);
+  read_binary_data(fp, net_src_pin_ids_);
+  read_binary_data(fp, net_sink_ids_);
+  read_binary_data(fp, net_sink_terminal_ids_);
+  read_binary_data(fp, net_sink_instance_ids_);
+  read_binary_data(fp, net_sink_pin_ids_);
+  read_binary_data(fp, net_src_offsets_);
+  read_binary_data(fp, flat_net_src_ids_);
+  read_binary_data(fp, flat_net_src_terminal_ids_);
+  read_binary_data(fp, flat_net_src_instance_ids_);
+  read_binary_data(fp, flat_net_src_pin_ids_);
+  read_binary_data(fp, net_sink_offsets_);
+  read_binary_data(fp, flat_net_sink_ids_);
+  read_binary_data(fp, flat_net_sink_terminal_ids_);
+  read_binary_data(fp, flat_net_sink_instance_ids_);
+  read_binary_data(fp, flat_net_sink_pin_ids_);
+
+  read_binary_data(fp, port_lookup_);
+  read_binary_data(fp, port_pin_offsets_);
+  read_binary_data(fp, num_pins_);
+  read_binary_data(fp, child_index_lookup_);
+  read_binary_data(fp, instance_net_offsets_);
+  read_binary_data(fp, instance_net_lookup_);
+  read_binary_data(fp, self_net_lookup_);
+  read_binary_data(fp, net_terminal_storage_);
+
+  /* A truncated or corrupted stream leaves the arrays inconsistent, which
+   * must be rejected before any of them is indexed by module */
+  if (!fp.good()) {
+    return;
+  }
+  size_t num_modules = ids_.size();
+  if ((names_.size() != num_modules) ||
+      (circuit_models_.size() != num_modules) ||
+      (child_instance_names_.size() != num_modules) ||
+      (logical2physical_configurable_child_instance_names_.size() !=
+       num_modules) ||
+      (net_names_.size() != num_modules)) {
+    fp.setstate(std::ios::failbit);
+    return;
+  }
+
+  /* Translate the symbols to the current symbol table */
+  bool valid_symbols = true;
+  for (const ModuleId& module : ids_) {
+    valid_symbols &= remap_symbol(names_[module], symbol_map);
+    valid_symbols &= remap_symbol(circuit_models_[module], symbol_map);
+    for (std::vector<SymbolId>& instance_names :
+         child_instance_names_[module]) {
+      valid_symbols &= remap_symbols(instance_names, symbol_map);
+    }
+    valid_symbols &= remap_symbols(
+      logical2physical_configurable_child_instance_names_[module], symbol_map);
+    valid_symbols &= remap_symbols(net_names_[module], symbol_map);
+  }
+  if (false == valid_symbols) {
+    fp.setstate(std::ios::failbit);
+    return;
+  }
+
+  /* The keys of the name look-up refer to the interned names */
+  name_id_map_.clear();
+  for (const ModuleId& module : ids_) {
+    name_id_map_[symbol_string(names_[module])] = module;
+  }
+  /* The look-up of net terminals is rebuilt from the storage */
+  net_terminal_lookup_.clear();
+  for (size_t iterm = 0; iterm < net_terminal_storage_.size(); ++iterm) {
+    net_terminal_lookup_[{size_t(net_terminal_storage_[iterm].first),
+                          size_t(net_terminal_storage_[iterm].second)}] = iterm;
+  }
+}
+
 /******************************************************************************
  * Private validators/invalidators
  ******************************************************************************/
@@ -1540,6 +2627,10 @@ void ModuleManager::invalidate_name2id_map() { name_id_map_.clear(); }
 
 void ModuleManager::invalidate_port_lookup() { port_lookup_.clear(); }
 
-void ModuleManager::invalidate_net_lookup() { net_lookup_.clear(); }
+void ModuleManager::invalidate_net_lookup() {
+  instance_net_offsets_.clear();
+  instance_net_lookup_.clear();
+  self_net_lookup_.clear();
+}
 
 } /* end namespace openfpga */
@@ -1,15 +1,23 @@
 #ifndef MODULE_MANAGER_H
 #define MODULE_MANAGER_H
 
+#include <array>
+#include <iosfwd>
 #include <map>
 #include <string>
+#include <string_view>
 #include <tuple>
 #include <unordered_map>
 #include <unordered_set>
 
 #include "module_manager_fwd.h"
+#include "module_net_buffer.h"
+#include "openfpga_hash.h"
+#include "openfpga_memory_usage.h"
 #include "openfpga_port.h"
+#include "openfpga_symbol_table.h"
 #include "vtr_geometry.h"
+#include "vtr_range.h"
 #include "vtr_vector.h"
 
 /* begin namespace openfpga */
@@ -162,6 +170,8 @@ class ModuleManager {
   typedef vtr::Range<module_net_src_iterator> module_net_src_range;
   typedef vtr::Range<module_net_sink_iterator> module_net_sink_range;
   typedef vtr::Range<region_iterator> region_range;
+  /* Instances of a child module are numbered from 0 to num_instance - 1 */
+  typedef BasicPortPinRange child_instance_range;
 
  public: /* Public aggregators */
   /* Find all the modules */
@@ -175,21 +185,29 @@ class ModuleManager {
   module_port_range module_ports(const ModuleId& module) const;
   /* Find all the nets belonging to a module */
   module_net_range module_nets(const ModuleId& module) const;
+  /* The lists of children below are returned by reference to the internal
+   * storage. They remain valid until the children of the parent module are
+   * modified, or a new module is added. Take a copy when the parent module
+   * is going to be updated while the list is in use */
   /* Find all the child modules under a parent module */
-  std::vector<ModuleId> child_modules(const ModuleId& parent_module) const;
+  const std::vector<ModuleId>& child_modules(
+    const ModuleId& parent_module) const;
+  /* Find all the parent modules which instanciate a child module */
+  const std::vector<ModuleId>& parent_modules(
+    const ModuleId& child_module) const;
   /* Find all the instances under a parent module */
-  std::vector<size_t> child_module_instances(
+  child_instance_range child_module_instances(
     const ModuleId& parent_module, const ModuleId& child_module) const;
   /* Find all the configurable child modules under a parent module */
-  std::vector<ModuleId> configurable_children(
+  const std::vector<ModuleId>& configurable_children(
     const ModuleId& parent_module, const e_config_child_type& type) const;
   /* Find all the instances of configurable child modules under a parent module
    */
-  std::vector<size_t> configurable_child_instances(
+  const std::vector<size_t>& configurable_child_instances(
     const ModuleId& parent_module, const e_config_child_type& type) const;
   /* Find the coordindate of a configurable child module under a parent module
    */
-  std::vector<vtr::Point<int>> configurable_child_coordinates(
+  const std::vector<vtr::Point<int>>& configurable_child_coordinates(
     const ModuleId& parent_module, const e_config_child_type& type) const;
 
   /* Find all the configurable child modules under a parent module
@@ -197,7 +215,7 @@ class ModuleManager {
    * another module; Only the logical child module is under the current parent
    * module
    */
-  std::vector<ModuleId> logical2physical_configurable_children(
+  const std::vector<ModuleId>& logical2physical_configurable_children(
     const ModuleId& parent_module) const;
   /* Find all the instance names of configurable child modules under a parent
    * module
@@ -206,11 +224,13 @@ class ModuleManager {
     const ModuleId& parent_module) const;
 
   /* Find all the I/O child modules under a parent module */
-  std::vector<ModuleId> io_children(const ModuleId& parent_module) const;
+  const std::vector<ModuleId>& io_children(
+    const ModuleId& parent_module) const;
   /* Find all the instances of I/O child modules under a parent module */
-  std::vector<size_t> io_child_instances(const ModuleId& parent_module) const;
+  const std::vector<size_t>& io_child_instances(
+    const ModuleId& parent_module) const;
   /* Find the coordindate of an I/O child module under a parent module */
-  std::vector<vtr::Point<int>> io_child_coordinates(
+  const std::vector<vtr::Point<int>>& io_child_coordinates(
     const ModuleId& parent_module) const;
 
   /* Find the source ids of modules */
@@ -242,6 +262,9 @@ class ModuleManager {
   size_t num_nets(const ModuleId& module) const;
   std::string module_name(const ModuleId& module_id) const;
   e_module_usage_type module_usage(const ModuleId& module_id) const;
+  /* Find the name of the circuit model from which a module is built.
+   * Return an empty string if the module is not built from a circuit model */
+  std::string module_circuit_model(const ModuleId& module_id) const;
   std::string module_port_type_str(
     const enum e_module_port_type& port_type) const;
   std::vector<BasicPort> module_ports_by_type(
@@ -255,7 +278,7 @@ class ModuleManager {
   BasicPort module_port(const ModuleId& module_id,
                         const ModulePortId& port_id) const;
   /* Find a module by a given name */
-  ModuleId find_module(const std::string& name) const;
+  ModuleId find_module(std::string_view name) const;
   /* Find the number of instances of a child module in the parent module */
   size_t num_instance(const ModuleId& parent_module,
                       const ModuleId& child_module) const;
@@ -326,15 +349,53 @@ class ModuleManager {
   bool net_sink_exist(const ModuleId& module, const ModuleNetId& net,
                       const ModuleId& sink_module, const size_t& instance_id,
                       const ModulePortId& sink_port, const size_t& sink_pin);
+  /* Identify if the sources and sinks of the nets in a module are stored in
+   * the compressed layout. See compress_module_nets() for details */
+  bool module_nets_compressed(const ModuleId& module) const;
 
   /** @brief Check if the configurable children under a given module are unified
    * or not. If unified, it means that the logical configurable children are the
    * same as the physical configurable children */
   bool unified_configurable_children(const ModuleId& curr_module) const;
 
+  /* Approximate heap memory used by the data structure */
+  MemoryUsage memory_usage() const;
+  /** @brief Create a module manager with the same modules as this one but
+   * without any net. The names, usages, ports and children of the modules are
+   * copied, so that the module ids remain valid in the new module manager and
+   * new modules can instantiate the existing ones. As the nets take most of
+   * the memory, this is a cheap base to build new modules in a separate
+   * module manager, e.g., see build_modules_with_staging(). The nets of the
+   * existing modules are not available in the new module manager */
+  ModuleManager interface_copy() const;
+
  private: /* Private accessors */
   size_t find_child_module_index_in_parent_module(
     const ModuleId& parent_module, const ModuleId& child_module) const;
+  /* Identify if a net is the last one of a module whose nets are compressed,
+   * so that its sources and sinks can be appended to the flat arrays */
+  bool is_last_compressed_net(const ModuleId& module,
+                              const ModuleNetId& net) const;
+  /* Find the terminal/instance/pin ids of the sources or sinks of a net,
+   * regardless of the storage layout */
+  vtr::Range<const size_t*> net_src_terminal_ids(const ModuleId& module,
+                                                 const ModuleNetId& net) const;
+  vtr::Range<const size_t*> net_src_instance_ids(const ModuleId& module,
+                                                 const ModuleNetId& net) const;
+  vtr::Range<const size_t*> net_src_pin_ids(const ModuleId& module,
+                                            const ModuleNetId& net) const;
+  vtr::Range<const size_t*> net_sink_terminal_ids(
+    const ModuleId& module, const ModuleNetId& net) const;
+  vtr::Range<const size_t*> net_sink_instance_ids(
+    const ModuleId& module, const ModuleNetId& net) const;
+  vtr::Range<const size_t*> net_sink_pin_ids(const ModuleId& module,
+                                             const ModuleNetId& net) const;
+  /* Find the index of a pin in the fast look-up of nets */
+  size_t net_lookup_index(const ModuleId& parent_module,
+                          const ModuleId& child_module,
+                          const size_t& child_instance,
+                          const ModulePortId& child_port,
+                          const size_t& child_pin) const;
 
  public: /* Public mutators */
   /* Add a module */
@@ -348,9 +409,16 @@ class ModuleManager {
                             const std::string& port_name);
   /* Set a name for a module */
   void set_module_name(const ModuleId& module, const std::string& name);
+  /* Set new names for a group of modules at once. Names can be swapped
+   * between the modules of the group */
+  void set_module_names(
+    const std::vector<std::pair<ModuleId, std::string>>& module_names);
   /* Set a usage for a module */
   void set_module_usage(const ModuleId& module,
                         const e_module_usage_type& usage);
+  /* Record the circuit model from which a module is built */
+  void set_module_circuit_model(const ModuleId& module,
+                                const std::string& circuit_model_name);
   /* Set a port to be a wire */
   void set_port_is_wire(const ModuleId& module, const std::string& port_name,
                         const bool& is_wire);
@@ -381,6 +449,15 @@ class ModuleManager {
   void add_child_module(const ModuleId& parent_module,
                         const ModuleId& child_module,
                         const bool& is_io_child = true);
+  /** @brief Replace all the instances of a child module under a parent module
+   * by instances of another child module, which must have the same ports.
+   * If the new child module is already a child of the parent module, the
+   * instances of the old child module are appended to its instances.
+   * The nets, the configurable children and the I/O children of the parent
+   * module are updated accordingly, while the instance names are kept */
+  void replace_child_module(const ModuleId& parent_module,
+                            const ModuleId& old_child_module,
+                            const ModuleId& new_child_module);
   /* Set the instance name of a child module */
   void set_child_instance_name(const ModuleId& parent_module,
                                const ModuleId& child_module,
@@ -475,6 +552,20 @@ class ModuleManager {
                                       const ModulePortId& sink_port,
                                       const size_t& sink_pin);
 
+  /** @brief Add the nets staged in buffers to a module at once. The buffers
+   * are merged in the given order, and the space of nets is reserved ahead.
+   * Similar to create_module_source_pin_net(), a staged net whose source pin
+   * already has a net in the module is merged into the existing net. As a
+   * result, the nets are the same as if they were added one by one.
+   * When merging is disabled, each staged net creates a new net, as
+   * create_module_net() does, even if its source pin already drives a net.
+   * Return the number of nets which are created */
+  size_t append_nets(const ModuleId& module, const ModuleNetBuffer& buffer,
+                     const bool& merge_source_nets = true);
+  size_t append_nets(const ModuleId& module,
+                     const std::vector<ModuleNetBuffer>& buffers,
+                     const bool& merge_source_nets = true);
+
   /** @brief Create a wrapper module on an existing module. The wrapper module
    * will herit all the ports with the same direction, width and names from the
    * selected module. The wrapper module will contain the existing module. For
@@ -494,6 +585,39 @@ class ModuleManager {
                                  const std::string& wrapper_module_name,
                                  const std::string& instance_name,
                                  const bool& add_nets);
+  /** @brief Copy a module from another module manager to this one, including
+   * its ports, child instances, configurable children, I/O children and nets.
+   * The ids of ports, nets and instances are kept as they are in the source.
+   * The child modules are translated by the module_map, which maps a module id
+   * of the source module manager to a module id of this module manager. All
+   * the child modules should be valid in this module manager.
+   * Return an invalid id if a module with the same name already exists */
+  ModuleId import_module(const ModuleManager& src_module_manager,
+                         const ModuleId& src_module,
+                         const vtr::vector<ModuleId, ModuleId>& module_map);
+  /** @brief Move the sources and sinks of all the nets in a module to a
+   * compressed layout, where each type of data is stored in a flat array and
+   * the data of a net is located by an offset array (Compressed Sparse Row).
+   * This saves the memory of small per-net arrays and is recommended once a
+   * module is finalized. All the accessors work as usual on compressed nets.
+   * A new module starts in the compressed layout: a new net and the sources
+   * and sinks of the last net are appended to the flat arrays. If any other
+   * net of the module is modified, the nets are expanded to the default
+   * layout automatically */
+  void compress_module_nets(const ModuleId& module);
+
+ private: /* Private mutators */
+  /* Find or add a pair of module and port in the storage of net terminals */
+  size_t find_net_terminal_id(const ModuleId& module, const ModulePortId& port);
+  /* Restore the default layout of net sources and sinks for a module */
+  void expand_module_nets(const ModuleId& module);
+  /* Reserve the space for the nets to be appended to a module */
+  void reserve_appended_module_nets(const ModuleId& module,
+                                    const size_t& num_nets);
+  /* Add the nets of a buffer to a module, see append_nets() */
+  size_t append_buffered_nets(const ModuleId& module,
+                              const ModuleNetBuffer& buffer,
+                              const bool& merge_source_nets);
 
  public: /* Public deconstructors */
   /* This is a strong function which will remove all the configurable children
@@ -521,6 +645,14 @@ class ModuleManager {
   void clear_module_net_sinks(const ModuleId& parent_module,
                               const ModuleNetId& net);
 
+ public: /* Public serializers */
+  /** @brief Dump all the modules to a binary stream. Names are written as
+   * strings, so that the stream can be loaded by another process */
+  void write_binary(std::ostream& fp) const;
+  /** @brief Replace all the modules by those loaded from a binary stream,
+   * which is created by write_binary() */
+  void read_binary(std::istream& fp);
+
  public: /* Public validators/invalidators */
   bool valid_module_id(const ModuleId& module) const;
   bool valid_module_port_id(const ModuleId& module,
@@ -541,16 +673,21 @@ class ModuleManager {
  private: /* Internal data */
   /* Module-level data */
   vtr::vector<ModuleId, ModuleId> ids_; /* Unique identifier for each Module */
-  vtr::vector<ModuleId, std::string>
+  /* Names are interned in the symbol table to save memory, as the same names
+   * are repeated many times over instances and nets */
+  vtr::vector<ModuleId, SymbolId>
     names_; /* Unique identifier for each Module */
   vtr::vector<ModuleId, e_module_usage_type> usages_; /* Usage of each module */
+  vtr::vector<ModuleId, SymbolId>
+    circuit_models_; /* Name of the circuit model that each module is built
+                        from, which is empty if not built from any */
   vtr::vector<ModuleId, std::vector<ModuleId>>
     parents_; /* Parent modules that include the module */
   vtr::vector<ModuleId, std::vector<ModuleId>>
     children_; /* Child modules that this module contain */
   vtr::vector<ModuleId, std::vector<size_t>>
     num_child_instances_; /* Number of children instance in each child module */
-  vtr::vector<ModuleId, std::vector<std::vector<std::string>>>
+  vtr::vector<ModuleId, std::vector<std::vector<SymbolId>>>
     child_instance_names_; /* Number of children instance in each child module
                             */
 
@@ -579,7 +716,7 @@ class ModuleManager {
   vtr::vector<ModuleId, std::vector<ModuleId>>
     logical2physical_configurable_children_; /* Child modules with configurable
                                memory bits that this module contain */
-  vtr::vector<ModuleId, std::vector<std::string>>
+  vtr::vector<ModuleId, std::vector<SymbolId>>
     logical2physical_configurable_child_instance_names_; /* Instances of child
                                       modules with configurable memory bits that
                                       this module contain */
@@ -649,7 +786,7 @@ class ModuleManager {
   vtr::vector<ModuleId, size_t> num_nets_; /* List of nets for each Module */
   vtr::vector<ModuleId, std::unordered_set<ModuleNetId>>
     invalid_net_ids_; /* Invalid net ids */
-  vtr::vector<ModuleId, vtr::vector<ModuleNetId, std::string>>
+  vtr::vector<ModuleId, vtr::vector<ModuleNetId, SymbolId>>
     net_names_; /* Name of net */
 
   vtr::vector<
@@ -680,26 +817,62 @@ class ModuleManager {
               vtr::vector<ModuleNetId, vtr::vector<ModuleNetSinkId, size_t>>>
     net_sink_pin_ids_; /* Pin ids that drive the net */
 
-  /* fast look-up for module */
-  std::map<std::string, ModuleId> name_id_map_;
+  /* Compressed layout of net sources and sinks (see compress_module_nets()):
+   * the sources of a net are stored in the range
+   * [net_src_offsets_[net], net_src_offsets_[net + 1]) of the flat arrays,
+   * and so are the sinks. The offsets are empty when a module is expanded,
+   * and then the per-net arrays above are used instead.
+   * The id lists are kept so that the ranges of source/sink ids can be
+   * returned as usual */
+  vtr::vector<ModuleId, std::vector<size_t>> net_src_offsets_;
+  vtr::vector<ModuleId, vtr::vector<ModuleNetSrcId, ModuleNetSrcId>>
+    flat_net_src_ids_;
+  vtr::vector<ModuleId, std::vector<size_t>> flat_net_src_terminal_ids_;
+  vtr::vector<ModuleId, std::vector<size_t>> flat_net_src_instance_ids_;
+  vtr::vector<ModuleId, std::vector<size_t>> flat_net_src_pin_ids_;
+
+  vtr::vector<ModuleId, std::vector<size_t>> net_sink_offsets_;
+  vtr::vector<ModuleId, vtr::vector<ModuleNetSinkId, ModuleNetSinkId>>
+    flat_net_sink_ids_;
+  vtr::vector<ModuleId, std::vector<size_t>> flat_net_sink_terminal_ids_;
+  vtr::vector<ModuleId, std::vector<size_t>> flat_net_sink_instance_ids_;
+  vtr::vector<ModuleId, std::vector<size_t>> flat_net_sink_pin_ids_;
+
+  /* fast look-up for module. The keys refer to the interned names, which
+   * remain valid during the whole execution */
+  std::unordered_map<std::string_view, ModuleId> name_id_map_;
   /* fast look-up for ports */
   typedef vtr::vector<ModuleId, std::vector<std::vector<ModulePortId>>>
     PortLookup;
   mutable PortLookup port_lookup_; /* [module_ids][port_types][port_ids] */
 
-  /* fast look-up for nets */
-  typedef vtr::vector<
-    ModuleId,
-    std::map<ModuleId,
-             std::vector<std::map<ModulePortId, std::vector<ModuleNetId>>>>>
-    NetLookup;
-  mutable NetLookup
-    net_lookup_; /* [module_ids][module_ids][instance_ids][port_ids][pin_ids] */
+  /* fast look-up for nets
+   * The pins of a module are numbered consecutively in the order of its
+   * ports: the first pin of a port is port_pin_offsets_[module][port].
+   * Under a parent module, the nets connected to all the child instances are
+   * stored in a flat array, where each instance owns a slice starting from
+   * instance_net_offsets_[parent][child_index][instance].
+   * The nets connected to the pins of the parent module itself are stored in
+   * a separate array, because ports can be added to a module at any time.
+   */
+  vtr::vector<ModuleId, vtr::vector<ModulePortId, size_t>> port_pin_offsets_;
+  vtr::vector<ModuleId, size_t> num_pins_;
+  /* [parent_module][child_module] -> index in the children list */
+  vtr::vector<ModuleId, std::unordered_map<ModuleId, size_t>>
+    child_index_lookup_;
+  /* [parent_module][child_index][instance_id] -> offset */
+  vtr::vector<ModuleId, std::vector<std::vector<size_t>>>
+    instance_net_offsets_;
+  vtr::vector<ModuleId, std::vector<ModuleNetId>> instance_net_lookup_;
+  vtr::vector<ModuleId, std::vector<ModuleNetId>> self_net_lookup_;
 
   /* Store pairs of a module and a port, which are frequently used in net
    * terminals (either source or sink)
    */
   std::vector<std::pair<ModuleId, ModulePortId>> net_terminal_storage_;
+  /* fast look-up for net terminals: [module, port] -> index in the storage */
+  std::unordered_map<std::array<size_t, 2>, size_t, ArrayHash<size_t, 2>>
+    net_terminal_lookup_;
 };
 
 } /* end namespace openfpga */
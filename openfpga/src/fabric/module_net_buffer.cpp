@@ -0,0 +1,81 @@
+/************************************************************************
+ * Member functions for class ModuleNetBuffer
+ ***********************************************************************/
+#include "module_net_buffer.h"
+
+#include "vtr_assert.h"
+
+/* namespace openfpga begins */
+namespace openfpga {
+
+/************************************************************************
+ * Constructors
+ ***********************************************************************/
+ModuleNetBuffer::ModuleNetBuffer() { sink_offsets_.push_back(0); }
+
+/************************************************************************
+ * Public Accessors
+ ***********************************************************************/
+size_t ModuleNetBuffer::num_nets() const { return sources_.size(); }
+
+size_t ModuleNetBuffer::num_sinks() const { return sinks_.size(); }
+
+const ModuleNetTerminal& ModuleNetBuffer::net_source(const size_t& net) const {
+  VTR_ASSERT(valid_net(net));
+  return sources_[net];
+}
+
+ModuleNetBuffer::terminal_range ModuleNetBuffer::net_sinks(
+  const size_t& net) const {
+  VTR_ASSERT(valid_net(net));
+  return vtr::make_range(sinks_.begin() + sink_offsets_[net],
+                         sinks_.begin() + sink_offsets_[net + 1]);
+}
+
+bool ModuleNetBuffer::empty() const { return sources_.empty(); }
+
+/************************************************************************
+ * Public Mutators
+ ***********************************************************************/
+void ModuleNetBuffer::reserve(const size_t& num_nets,
+                              const size_t& num_sinks) {
+  sources_.reserve(num_nets);
+  sink_offsets_.reserve(num_nets + 1);
+  sinks_.reserve(num_sinks);
+}
+
+size_t ModuleNetBuffer::add_net(const ModuleId& src_module,
+                                const size_t& src_instance,
+                                const ModulePortId& src_port,
+                                const size_t& src_pin) {
+  size_t net = sources_.size();
+  sources_.push_back({src_module, src_instance, src_port, src_pin});
+  sink_offsets_.push_back(sinks_.size());
+  return net;
+}
+
+void ModuleNetBuffer::add_net_sink(const size_t& net,
+                                   const ModuleId& sink_module,
+                                   const size_t& sink_instance,
+                                   const ModulePortId& sink_port,
+                                   const size_t& sink_pin) {
+  /* Only the latest net can get new sinks */
+  VTR_ASSERT(net + 1 == sources_.size());
+  sinks_.push_back({sink_module, sink_instance, sink_port, sink_pin});
+  sink_offsets_.back() = sinks_.size();
+}
+
+void ModuleNetBuffer::clear() {
+  sources_.clear();
+  sink_offsets_.assign(1, 0);
+  sinks_.clear();
+}
+
+/************************************************************************
+ * Public Validators
+ ***********************************************************************/
+bool ModuleNetBuffer::valid_net(const size_t& net) const {
+  return net < sources_.size();
+}
+
+} /* end namespace openfpga */
@@ -0,0 +1,77 @@
+#ifndef MODULE_NET_BUFFER_H
+#define MODULE_NET_BUFFER_H
+
+/********************************************************************
+ * Include header files required by the data structure definition
+ *******************************************************************/
+#include <cstddef>
+#include <vector>
+
+#include "module_manager_fwd.h"
+#include "vtr_range.h"
+
+/* namespace openfpga begins */
+namespace openfpga {
+
+/********************************************************************
+ * A pin of a port of a module instance, which is a source or a sink
+ * of a net
+ *******************************************************************/
+struct ModuleNetTerminal {
+  ModuleId module;
+  size_t instance;
+  ModulePortId port;
+  size_t pin;
+};
+
+/********************************************************************
+ * A data structure to stage the nets of a module outside of the
+ * module manager, which are then added to the module at once by
+ * ModuleManager::append_nets().
+ *
+ * Each net has a single source and a list of sinks. It allows the
+ * nets of a large module to be built by multiple threads, each of
+ * which fills its own buffer, while the module manager is only
+ * read. The sinks of a net are stored contiguously, so a sink can
+ * only be added to the latest net of the buffer.
+ *******************************************************************/
+class ModuleNetBuffer {
+ public: /* Types */
+  typedef std::vector<ModuleNetTerminal>::const_iterator terminal_iterator;
+  typedef vtr::Range<terminal_iterator> terminal_range;
+
+ public: /* Constructor */
+  ModuleNetBuffer();
+
+ public: /* Public accessors */
+  size_t num_nets() const;
+  size_t num_sinks() const;
+  const ModuleNetTerminal& net_source(const size_t& net) const;
+  terminal_range net_sinks(const size_t& net) const;
+  bool empty() const;
+
+ public: /* Public mutators */
+  void reserve(const size_t& num_nets, const size_t& num_sinks);
+  /* Add a net driven by a given pin, and return its index in the buffer */
+  size_t add_net(const ModuleId& src_module, const size_t& src_instance,
+                 const ModulePortId& src_port, const size_t& src_pin);
+  /* Add a sink to the latest net of the buffer */
+  void add_net_sink(const size_t& net, const ModuleId& sink_module,
+                    const size_t& sink_instance, const ModulePortId& sink_port,
+                    const size_t& sink_pin);
+  void clear();
+
+ public: /* Public validators */
+  bool valid_net(const size_t& net) const;
+
+ private: /* Internal data */
+  std::vector<ModuleNetTerminal> sources_;
+  /* Sinks of net i are in the range [sink_offsets_[i], sink_offsets_[i + 1])
+   */
+  std::vector<size_t> sink_offsets_;
+  std::vector<ModuleNetTerminal> sinks_;
+};
+
+} /* end namespace openfpga */
+
+#endif
@@ -99,6 +99,8 @@ int rename_fabric_modules(ModuleManager& module_manager,
                           const bool& verbose) {
   int status = CMD_EXEC_SUCCESS;
   size_t cnt = 0;
+  /* Collect all the new names and apply them at once */
+  std::vector<std::pair<ModuleId, std::string>> new_module_names;
   for (ModuleId curr_module : module_manager.modules()) {
     std::string curr_module_name = module_manager.module_name(curr_module);
     /* Error out if the new name does not exist ! */
@@ -112,10 +114,11 @@ int rename_fabric_modules(ModuleManager& module_manager,
     if (new_name != curr_module_name) {
       VTR_LOGV(verbose, "Rename module '%s' to its new name '%s'\n",
                curr_module_name.c_str(), new_name.c_str());
-      module_manager.set_module_name(curr_module, new_name);
+      new_module_names.emplace_back(curr_module, new_name);
     }
     cnt++;
   }
+  module_manager.set_module_names(new_module_names);
   VTR_LOG("Renamed %lu modules\n", cnt);
   return status;
 }
@@ -128,7 +131,10 @@ int partial_rename_fabric_modules(ModuleManager& module_manager,
                                   const bool& verbose) {
   int status = CMD_EXEC_SUCCESS;
   size_t cnt = 0;
-  for (std::string built_in_name : module_name_map.tags()) {
+  /* Collect all the new names and apply them at once, as a built-in name may
+   * be the new name of another module */
+  std::vector<std::pair<ModuleId, std::string>> new_module_names;
+  for (const std::string& built_in_name : module_name_map.tags()) {
     ModuleId curr_module = module_manager.find_module(built_in_name);
     if (!module_manager.valid_module_id(curr_module)) {
       VTR_LOG_ERROR(
@@ -140,10 +146,11 @@ int partial_rename_fabric_modules(ModuleManager& module_manager,
     if (new_name != built_in_name) {
       VTR_LOGV(verbose, "Rename module '%s' to its new name '%s'\n",
                built_in_name.c_str(), new_name.c_str());
-      module_manager.set_module_name(curr_module, new_name);
+      new_module_names.emplace_back(curr_module, new_name);
     }
     cnt++;
   }
+  module_manager.set_module_names(new_module_names);
   VTR_LOG("Renamed %lu modules\n", cnt);
   return status;
 }
@@ -0,0 +1,268 @@
+/********************************************************************
+ * Save the bitstream databases of a design to a checkpoint directory, and
+ * load them back. This allows a flow which fails in a late stage, e.g.,
+ * when writing netlists or bitstream files, to resume without repacking
+ * and rebuilding the bitstreams.
+ *
+ * The checkpoint directory contains:
+ *   - a manifest: a magic word, the format version, a key which is computed
+ *     by the caller from the fabric, and the list of the databases saved
+ *   - the architecture bitstream database in the binary format (see
+ *     write_bin_arch_bitstream.h)
+ *   - the template of the fabric bitstream (see
+ *     fabric_bitstream_template_file.h). The values of the fabric bits are
+ *     gathered from the architecture bitstream database when loading
+ *******************************************************************/
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+
+/* Headers from vtrutil library */
+#include "vtr_assert.h"
+#include "vtr_error.h"
+#include "vtr_log.h"
+#include "vtr_time.h"
+
+/* Headers from openfpgautil library */
+#include "bitstream_checkpoint.h"
+#include "build_fabric_bitstream.h"
+#include "command_exit_codes.h"
+#include "fabric_bitstream_template_file.h"
+#include "openfpga_binary_io.h"
+#include "openfpga_digest.h"
+#include "read_bin_arch_bitstream.h"
+#include "write_bin_arch_bitstream.h"
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+/* Identify the type of file; change the version whenever the content of the
+ * checkpoint changes */
+constexpr char BITSTREAM_CHECKPOINT_MAGIC[] = "OFPGACKP";
+constexpr size_t BITSTREAM_CHECKPOINT_MAGIC_SIZE =
+  sizeof(BITSTREAM_CHECKPOINT_MAGIC) - 1;
+constexpr uint32_t BITSTREAM_CHECKPOINT_VERSION = 1;
+
+/* Files of a checkpoint directory */
+constexpr char BITSTREAM_CHECKPOINT_MANIFEST_FILE[] = "checkpoint.bin";
+constexpr char BITSTREAM_CHECKPOINT_ARCH_BITSTREAM_FILE[] =
+  "arch_bitstream.bin";
+constexpr char BITSTREAM_CHECKPOINT_FABRIC_BITSTREAM_FILE[] =
+  "fabric_bitstream_template.bin";
+
+/********************************************************************
+ * Write the bitstream databases to a checkpoint directory. Only the
+ * databases which have been built are saved. The manifest is written last,
+ * so that a checkpoint interrupted in the middle is never loaded
+ *
+ * Return 0 if successful
+ * Return 1 if fail when creating files
+ *******************************************************************/
+int write_bitstream_checkpoint(const std::string& dir_path, const size_t& key,
+                               const BitstreamManager& bitstream_manager,
+                               const FabricBitstream& fabric_bitstream,
+                               const bool& verbose) {
+  std::string timer_message =
+    std::string("Write bitstream checkpoint to directory '") + dir_path +
+    std::string("'");
+
+  /* Start time count */
+  vtr::ScopedStartFinishTimer timer(timer_message);
+
+  VTR_ASSERT(true != dir_path.empty());
+  std::string formatted_dir_path = format_dir_path(dir_path);
+
+  /* Create directories */
+  create_directory(formatted_dir_path);
+
+  uint8_t has_arch_bitstream = 0 < bitstream_manager.num_blocks();
+  uint8_t has_fabric_bitstream = 0 < fabric_bitstream.num_bits();
+  if ((0 == has_arch_bitstream) && (0 != has_fabric_bitstream)) {
+    VTR_LOG_ERROR(
+      "A fabric bitstream can not be saved without its architecture "
+      "bitstream!\n");
+    return CMD_EXEC_FATAL_ERROR;
+  }
+
+  /* Remove the manifest of an older checkpoint first, in case the new one
+   * fails in the middle */
+  std::string manifest_fname =
+    formatted_dir_path + std::string(BITSTREAM_CHECKPOINT_MANIFEST_FILE);
+  std::remove(manifest_fname.c_str());
+
+  if (0 != has_arch_bitstream) {
+    if (0 != write_bin_architecture_bitstream(
+               bitstream_manager,
+               formatted_dir_path +
+                 std::string(BITSTREAM_CHECKPOINT_ARCH_BITSTREAM_FILE))) {
+      return CMD_EXEC_FATAL_ERROR;
+    }
+  }
+  if (0 != has_fabric_bitstream) {
+    int status = write_fabric_bitstream_template(
+      formatted_dir_path +
+        std::string(BITSTREAM_CHECKPOINT_FABRIC_BITSTREAM_FILE),
+      key, *fabric_bitstream.bitstream_template(), verbose);
+    if (CMD_EXEC_SUCCESS != status) {
+      return status;
+    }
+  }
+
+  /* Create a file handler*/
+  std::fstream fp;
+  /* Open a file */
+  fp.open(manifest_fname, std::fstream::out | std::fstream::trunc |
+                            std::fstream::binary);
+
+  /* Validate the file stream */
+  check_file_stream(manifest_fname.c_str(), fp);
+
+  fp.write(BITSTREAM_CHECKPOINT_MAGIC, BITSTREAM_CHECKPOINT_MAGIC_SIZE);
+  write_binary_data(fp, BITSTREAM_CHECKPOINT_VERSION);
+  write_binary_data(fp, uint64_t(key));
+  write_binary_data(fp, has_arch_bitstream);
+  write_binary_data(fp, has_fabric_bitstream);
+
+  if (false == fp.good()) {
+    VTR_LOG_ERROR("Fail to write checkpoint manifest to file '%s'!\n",
+                  manifest_fname.c_str());
+    fp.close();
+    return CMD_EXEC_FATAL_ERROR;
+  }
+  VTR_LOGV(verbose,
+           "Saved architecture bitstream: %s\nSaved fabric bitstream: %s\n",
+           has_arch_bitstream ? "yes" : "no",
+           has_fabric_bitstream ? "yes" : "no");
+
+  /* close a file */
+  fp.close();
+
+  return CMD_EXEC_SUCCESS;
+}
+
+/********************************************************************
+ * Read the bitstream databases from a checkpoint directory.
+ * The databases are not touched unless the checkpoint is created by the
+ * same version with the same key as the given one. The flags indicate which
+ * databases have been loaded
+ *
+ * Return 0 if successful
+ * Return 1 if the checkpoint is corrupted. The databases are then incomplete
+ * Return 2 if the checkpoint does not exist or is outdated, which means that
+ * the databases should be built again
+ *******************************************************************/
+int read_bitstream_checkpoint(const std::string& dir_path, const size_t& key,
+                              BitstreamManager& bitstream_manager,
+                              FabricBitstream& fabric_bitstream,
+                              bool& bitstream_manager_loaded,
+                              bool& fabric_bitstream_loaded,
+                              const bool& verbose) {
+  std::string timer_message =
+    std::string("Read bitstream checkpoint from directory '") + dir_path +
+    std::string("'");
+
+  /* Start time count */
+  vtr::ScopedStartFinishTimer timer(timer_message);
+
+  bitstream_manager_loaded = false;
+  fabric_bitstream_loaded = false;
+
+  std::string formatted_dir_path = format_dir_path(dir_path);
+  std::string manifest_fname =
+    formatted_dir_path + std::string(BITSTREAM_CHECKPOINT_MANIFEST_FILE);
+
+  std::fstream fp;
+  fp.open(manifest_fname, std::fstream::in | std::fstream::binary);
+  if (false == valid_file_stream(fp)) {
+    VTR_LOG("Bitstream checkpoint '%s' does not exist\n", dir_path.c_str());
+    return CMD_EXEC_MINOR_ERROR;
+  }
+
+  /* Header */
+  char magic[BITSTREAM_CHECKPOINT_MAGIC_SIZE];
+  uint32_t version = 0;
+  uint64_t file_key = 0;
+  uint8_t has_arch_bitstream = 0;
+  uint8_t has_fabric_bitstream = 0;
+  fp.read(magic, BITSTREAM_CHECKPOINT_MAGIC_SIZE);
+  read_binary_data(fp, version);
+  read_binary_data(fp, file_key);
+  read_binary_data(fp, has_arch_bitstream);
+  read_binary_data(fp, has_fabric_bitstream);
+  bool valid_manifest = fp.good();
+  fp.close();
+  if ((false == valid_manifest) ||
+      (0 != std::memcmp(magic, BITSTREAM_CHECKPOINT_MAGIC,
+                        BITSTREAM_CHECKPOINT_MAGIC_SIZE))) {
+    VTR_LOG_ERROR("Directory '%s' does not contain a bitstream checkpoint!\n",
+                  dir_path.c_str());
+    return CMD_EXEC_FATAL_ERROR;
+  }
+  if ((BITSTREAM_CHECKPOINT_VERSION != version) ||
+      (uint64_t(key) != file_key)) {
+    VTR_LOG(
+      "Bitstream checkpoint '%s' was not created for the current fabric\n",
+      dir_path.c_str());
+    return CMD_EXEC_MINOR_ERROR;
+  }
+  if ((0 == has_arch_bitstream) && (0 != has_fabric_bitstream)) {
+    VTR_LOG_ERROR(
+      "Bitstream checkpoint '%s' is corrupted: fabric bitstream is saved "
+      "without its architecture bitstream!\n",
+      dir_path.c_str());
+    return CMD_EXEC_FATAL_ERROR;
+  }
+
+  /* Architecture bitstream */
+  if (0 != has_arch_bitstream) {
+    std::string arch_bitstream_fname =
+      formatted_dir_path +
+      std::string(BITSTREAM_CHECKPOINT_ARCH_BITSTREAM_FILE);
+    if (false ==
+        is_bin_architecture_bitstream_file(arch_bitstream_fname.c_str())) {
+      VTR_LOG_ERROR(
+        "Bitstream checkpoint '%s' is corrupted: architecture bitstream '%s' "
+        "is missing!\n",
+        dir_path.c_str(), arch_bitstream_fname.c_str());
+      return CMD_EXEC_FATAL_ERROR;
+    }
+    /* The database is left untouched when the file is corrupted */
+    try {
+      bitstream_manager =
+        read_bin_architecture_bitstream(arch_bitstream_fname.c_str());
+    } catch (const vtr::VtrError&) {
+      VTR_LOG_ERROR(
+        "Bitstream checkpoint '%s' is corrupted: architecture bitstream '%s' "
+        "can not be loaded!\n",
+        dir_path.c_str(), arch_bitstream_fname.c_str());
+      return CMD_EXEC_FATAL_ERROR;
+    }
+    bitstream_manager_loaded = true;
+    VTR_LOGV(verbose, "Loaded %lu architecture bits\n",
+             bitstream_manager.num_bits());
+  }
+
+  /* Fabric bitstream, whose bits are gathered from the architecture
+   * bitstream */
+  if (0 != has_fabric_bitstream) {
+    std::shared_ptr<const FabricBitstreamTemplate> bitstream_template;
+    int status = read_fabric_bitstream_template(
+      formatted_dir_path +
+        std::string(BITSTREAM_CHECKPOINT_FABRIC_BITSTREAM_FILE),
+      key, bitstream_template, verbose);
+    if (CMD_EXEC_SUCCESS != status) {
+      VTR_LOG_ERROR(
+        "Bitstream checkpoint '%s' is corrupted: fabric bitstream can not be "
+        "loaded!\n",
+        dir_path.c_str());
+      return CMD_EXEC_FATAL_ERROR;
+    }
+    fabric_bitstream = build_fabric_bitstream_from_template(
+      bitstream_template, bitstream_manager, verbose);
+    fabric_bitstream_loaded = true;
+  }
+
+  return CMD_EXEC_SUCCESS;
+}
+
+} /* end namespace openfpga */
@@ -0,0 +1,33 @@
+#ifndef BITSTREAM_CHECKPOINT_H
+#define BITSTREAM_CHECKPOINT_H
+
+/********************************************************************
+ * Include header files that are required by function declaration
+ *******************************************************************/
+#include <string>
+
+#include "bitstream_manager.h"
+#include "fabric_bitstream.h"
+
+/********************************************************************
+ * Function declaration
+ *******************************************************************/
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+int write_bitstream_checkpoint(const std::string& dir_path, const size_t& key,
+                               const BitstreamManager& bitstream_manager,
+                               const FabricBitstream& fabric_bitstream,
+                               const bool& verbose);
+
+int read_bitstream_checkpoint(const std::string& dir_path, const size_t& key,
+                              BitstreamManager& bitstream_manager,
+                              FabricBitstream& fabric_bitstream,
+                              bool& bitstream_manager_loaded,
+                              bool& fabric_bitstream_loaded,
+                              const bool& verbose);
+
+} /* end namespace openfpga */
+
+#endif
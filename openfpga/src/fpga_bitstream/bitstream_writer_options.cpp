@@ -14,10 +14,11 @@ namespace openfpga {
  *************************************************/
 BitstreamWriterOption::BitstreamWriterOption() {
   file_type_ = BitstreamWriterOption::e_bitfile_type::NUM_TYPES;
-  BITFILE_TYPE_STRING_ = {"plain_text", "xml"};
+  BITFILE_TYPE_STRING_ = {"plain_text", "xml", "bin"};
   output_file_.clear();
   time_stamp_ = true;
   verbose_output_ = false;
+  num_threads_ = 1;
 
   filter_value_ = "";
   trim_path_ = false;
@@ -27,6 +28,12 @@ BitstreamWriterOption::BitstreamWriterOption() {
   fast_config_ = false;
   keep_dont_care_bits_ = false;
   wl_decremental_order_ = false;
+  reference_file_.clear();
+  region_hash_ = false;
+
+  compress_ = false;
+
+  shard_by_region_ = false;
 }
 
 /**************************************************
@@ -75,6 +82,20 @@ bool BitstreamWriterOption::wl_decremental_order() const {
   return wl_decremental_order_;
 }
 
+std::string BitstreamWriterOption::reference_file() const {
+  return reference_file_;
+}
+
+bool BitstreamWriterOption::region_hash() const { return region_hash_; }
+
+bool BitstreamWriterOption::compress() const { return compress_; }
+
+bool BitstreamWriterOption::shard_by_region() const {
+  return shard_by_region_;
+}
+
+size_t BitstreamWriterOption::num_threads() const { return num_threads_; }
+
 /******************************************************************************
  * Private Mutators
  ******************************************************************************/
@@ -123,6 +144,27 @@ void BitstreamWriterOption::set_wl_decremental_order(const bool& enabled) {
   wl_decremental_order_ = enabled;
 }
 
+void BitstreamWriterOption::set_reference_file(
+  const std::string& reference_file) {
+  reference_file_ = reference_file;
+}
+
+void BitstreamWriterOption::set_region_hash(const bool& enabled) {
+  region_hash_ = enabled;
+}
+
+void BitstreamWriterOption::set_compress(const bool& enabled) {
+  compress_ = enabled;
+}
+
+void BitstreamWriterOption::set_shard_by_region(const bool& enabled) {
+  shard_by_region_ = enabled;
+}
+
+void BitstreamWriterOption::set_num_threads(const size_t& num_threads) {
+  num_threads_ = num_threads;
+}
+
 bool BitstreamWriterOption::validate(bool show_err_msg) const {
   /* Check file type */
   if (!valid_file_type(file_type_)) {
@@ -149,6 +191,42 @@ bool BitstreamWriterOption::validate(bool show_err_msg) const {
       return false;
     }
   }
+  if ((!reference_file_.empty()) &&
+      (file_type_ != BitstreamWriterOption::e_bitfile_type::TEXT)) {
+    VTR_LOGV_ERROR(show_err_msg,
+                   "Reference bitstream is only applicable to plain text file "
+                   "format!\n");
+    return false;
+  }
+  if ((true == region_hash_) &&
+      (file_type_ != BitstreamWriterOption::e_bitfile_type::TEXT)) {
+    VTR_LOGV_ERROR(show_err_msg,
+                   "Region hashes are only applicable to plain text file "
+                   "format!\n");
+    return false;
+  }
+  if ((true == shard_by_region_) &&
+      (file_type_ != BitstreamWriterOption::e_bitfile_type::XML)) {
+    VTR_LOGV_ERROR(show_err_msg,
+                   "Sharding by region is only applicable to XML file "
+                   "format!\n");
+    return false;
+  }
+  if ((true == compress_) &&
+      (file_type_ != BitstreamWriterOption::e_bitfile_type::BIN)) {
+    VTR_LOGV_ERROR(show_err_msg,
+                   "Compression is only applicable to binary file format!\n");
+    return false;
+  }
+  if (file_type_ == BitstreamWriterOption::e_bitfile_type::BIN) {
+    /* A binary file can only contain logic '0' and '1' */
+    if (keep_dont_care_bits_) {
+      VTR_LOGV_ERROR(
+        show_err_msg,
+        "Don't care bits can not be kept in binary file format!\n");
+      return false;
+    }
+  }
   return true;
 }
 
@@ -16,7 +16,7 @@ namespace openfpga {
 class BitstreamWriterOption {
  public: /* Private data structures */
   /* A type to define the bitstream file format */
-  enum class e_bitfile_type { TEXT, XML, NUM_TYPES };
+  enum class e_bitfile_type { TEXT, XML, BIN, NUM_TYPES };
 
  public: /* Public constructor */
   /* Set default options */
@@ -42,6 +42,21 @@ class BitstreamWriterOption {
   bool fast_configuration() const;
   bool keep_dont_care_bits() const;
   bool wl_decremental_order() const;
+  /* File of the architecture bitstream of a reference implementation. When
+   * defined, only the configuration cycles changed from it are written */
+  std::string reference_file() const;
+  /* Check if the hash of each configuration region should be written in the
+   * head of the file */
+  bool region_hash() const;
+
+  /* Check if the binary bitstream should be run-length compressed */
+  bool compress() const;
+
+  /* Check if each configuration region should be written to a separated file,
+   * while the output file lists the files of the regions */
+  bool shard_by_region() const;
+
+  size_t num_threads() const;
 
  public: /* Public mutators */
   void set_output_file_type(const std::string& val);
@@ -54,6 +69,11 @@ class BitstreamWriterOption {
   void set_fast_configuration(const bool& enabled);
   void set_keep_dont_care_bits(const bool& enabled);
   void set_wl_decremental_order(const bool& enabled);
+  void set_reference_file(const std::string& reference_file);
+  void set_region_hash(const bool& enabled);
+  void set_compress(const bool& enabled);
+  void set_shard_by_region(const bool& enabled);
+  void set_num_threads(const size_t& num_threads);
 
   void set_filter_value(const std::string& val);
 
@@ -82,17 +102,24 @@ class BitstreamWriterOption {
   std::string output_file_;
   bool time_stamp_;
   bool verbose_output_;
+  size_t num_threads_;
 
   /* XML-specific options */
   std::string filter_value_;
   bool trim_path_;
   bool path_only_;
   bool value_only_;
+  bool shard_by_region_;
 
   /* Plain-text options */
   bool fast_config_;
   bool keep_dont_care_bits_;
   bool wl_decremental_order_;
+  std::string reference_file_;
+  bool region_hash_;
+
+  /* Binary options */
+  bool compress_;
 
   /* Constants */
   std::array<const char*, size_t(e_bitfile_type::NUM_TYPES)>
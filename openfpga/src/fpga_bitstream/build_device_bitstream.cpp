@@ -14,6 +14,7 @@
 #include "memory_utils.h"
 #include "module_manager_utils.h"
 #include "openfpga_naming.h"
+#include "openfpga_trace.h"
 #include "vtr_assert.h"
 #include "vtr_log.h"
 #include "vtr_time.h"
@@ -149,7 +150,9 @@ static size_t rec_estimate_device_bitstream_num_bits(
  *******************************************************************/
 BitstreamManager build_device_bitstream(const VprContext& vpr_ctx,
                                         const OpenfpgaContext& openfpga_ctx,
+                                        const size_t& num_threads,
                                         const bool& verbose) {
+  TraceScope trace_scope("build_device_bitstream");
   std::string timer_message =
     std::string("\nBuild fabric-independent bitstream for implementation '") +
     vpr_ctx.atom().nlist.netlist_name() + std::string("'\n");
@@ -218,7 +221,7 @@ BitstreamManager build_device_bitstream(const VprContext& vpr_ctx,
     openfpga_ctx.vpr_device_annotation(),
     openfpga_ctx.vpr_clustering_annotation(),
     openfpga_ctx.vpr_placement_annotation(),
-    openfpga_ctx.vpr_bitstream_annotation(), verbose);
+    openfpga_ctx.vpr_bitstream_annotation(), num_threads, verbose);
   VTR_LOGV(verbose, "Done\n");
 
   /* Create bitstream from routing architectures */
@@ -229,7 +232,7 @@ BitstreamManager build_device_bitstream(const VprContext& vpr_ctx,
     openfpga_ctx.arch().circuit_lib, openfpga_ctx.mux_lib(), vpr_ctx.atom(),
     openfpga_ctx.vpr_device_annotation(), openfpga_ctx.vpr_routing_annotation(),
     vpr_ctx.device().rr_graph, openfpga_ctx.device_rr_gsb(),
-    openfpga_ctx.flow_manager().compress_routing(), verbose);
+    openfpga_ctx.flow_manager().compress_routing(), num_threads, verbose);
   VTR_LOGV(verbose, "Done\n");
 
   VTR_LOGV(verbose, "Decoded %lu configuration bits into %lu blocks\n",
@@ -238,6 +241,9 @@ BitstreamManager build_device_bitstream(const VprContext& vpr_ctx,
   VTR_ASSERT(num_blocks_to_reserve == bitstream_manager.num_blocks());
   VTR_ASSERT(num_bits_to_reserve == bitstream_manager.num_bits());
 
+  trace_counter("bits", bitstream_manager.num_bits());
+  trace_counter("blocks", bitstream_manager.num_blocks());
+
   return bitstream_manager;
 }
 
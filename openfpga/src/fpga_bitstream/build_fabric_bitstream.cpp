@@ -3,6 +3,8 @@
  *******************************************************************/
 #include <algorithm>
 #include <cmath>
+#include <functional>
+#include <map>
 #include <string>
 
 /* Headers from vtrutil library */
@@ -15,9 +17,11 @@
 #include "build_fabric_bitstream.h"
 #include "build_fabric_bitstream_memory_bank.h"
 #include "decoder_library_utils.h"
+#include "fabric_bitstream_utils.h"
 #include "openfpga_decode.h"
 #include "openfpga_naming.h"
 #include "openfpga_reserved_words.h"
+#include "openfpga_trace.h"
 
 /* begin namespace openfpga */
 namespace openfpga {
@@ -33,13 +37,16 @@ namespace openfpga {
  * We use this link to reorganize the bitstream in the sequence of memories as
  *we stored in the configurable_children() and configurable_child_instances() of
  *each module of module manager
+ *
+ * The function adding each bit is a template parameter, so that it is
+ * inlined in the loop over the bits of each leaf block
  *******************************************************************/
+template <class AddConfigBit>
 static void rec_build_module_fabric_dependent_chain_bitstream(
   const BitstreamManager& bitstream_manager, const ConfigBlockId& parent_block,
   const ModuleManager& module_manager, const ModuleId& top_module,
   const ModuleId& parent_module, const ConfigRegionId& config_region,
-  FabricBitstream& fabric_bitstream,
-  const FabricBitRegionId& fabric_bitstream_region, const bool& verbose) {
+  const AddConfigBit& add_config_bit, const bool& verbose) {
   /* Depth-first search: if we have any children in the parent_block,
    * we dive to the next level first!
    */
@@ -68,8 +75,7 @@ static void rec_build_module_fabric_dependent_chain_bitstream(
         /* Go recursively */
         rec_build_module_fabric_dependent_chain_bitstream(
           bitstream_manager, child_block, module_manager, top_module,
-          child_module, config_region, fabric_bitstream,
-          fabric_bitstream_region, verbose);
+          child_module, config_region, add_config_bit, verbose);
       }
     } else {
       for (size_t child_id = 0;
@@ -103,8 +109,7 @@ static void rec_build_module_fabric_dependent_chain_bitstream(
         /* Go recursively */
         rec_build_module_fabric_dependent_chain_bitstream(
           bitstream_manager, child_block, module_manager, top_module,
-          child_module, config_region, fabric_bitstream,
-          fabric_bitstream_region, verbose);
+          child_module, config_region, add_config_bit, verbose);
       }
     }
     /* Ensure that there should be no configuration bits in the parent block */
@@ -117,8 +122,7 @@ static void rec_build_module_fabric_dependent_chain_bitstream(
    */
   for (const ConfigBitId& config_bit :
        bitstream_manager.block_bits(parent_block)) {
-    FabricBitId fabric_bit = fabric_bitstream.add_bit(config_bit);
-    fabric_bitstream.add_bit_to_region(fabric_bitstream_region, fabric_bit);
+    add_config_bit(config_bit);
   }
 }
 
@@ -144,6 +148,7 @@ static void rec_build_module_fabric_dependent_memory_bank_bitstream(
   const ModuleId& parent_module, const ConfigRegionId& config_region,
   const size_t& bl_addr_size, const size_t& wl_addr_size, const size_t& num_bls,
   const size_t& num_wls, size_t& cur_mem_index,
+  const std::vector<vtr::Rect<int>>& child_regions,
   FabricBitstream& fabric_bitstream,
   const FabricBitRegionId& fabric_bitstream_region) {
   /* Depth-first search: if we have any children in the parent_block,
@@ -188,11 +193,23 @@ static void rec_build_module_fabric_dependent_memory_bank_bitstream(
         /* We must have one valid block id! */
         VTR_ASSERT(true == bitstream_manager.valid_block_id(child_block));
 
+        /* For a partial bitstream, the children outside the regions are not
+         * visited, but their memory cells still occupy the BLs and WLs */
+        if (false == is_configurable_child_in_regions(
+                       module_manager.region_configurable_child_coordinates(
+                         parent_module, config_region)[child_id],
+                       child_regions)) {
+          cur_mem_index += rec_find_bitstream_manager_block_sum_of_bits(
+            bitstream_manager, child_block);
+          continue;
+        }
+
         /* Go recursively */
         rec_build_module_fabric_dependent_memory_bank_bitstream(
           bitstream_manager, child_block, module_manager, top_module,
           child_module, config_region, bl_addr_size, wl_addr_size, num_bls,
-          num_wls, cur_mem_index, fabric_bitstream, fabric_bitstream_region);
+          num_wls, cur_mem_index, child_regions, fabric_bitstream,
+          fabric_bitstream_region);
       }
     } else {
       VTR_ASSERT(parent_module != top_module);
@@ -200,9 +217,12 @@ static void rec_build_module_fabric_dependent_memory_bank_bitstream(
        *   - Use configurable children directly
        *   - no need to exclude decoders as they are not there
        */
-      std::vector<ModuleId> configurable_children =
+      const std::vector<ModuleId>& configurable_children =
         module_manager.configurable_children(
           parent_module, ModuleManager::e_config_child_type::PHYSICAL);
+      const std::vector<size_t>& configurable_child_instances =
+        module_manager.configurable_child_instances(
+          parent_module, ModuleManager::e_config_child_type::PHYSICAL);
 
       size_t num_configurable_children = configurable_children.size();
 
@@ -217,9 +237,7 @@ static void rec_build_module_fabric_dependent_memory_bank_bitstream(
       for (size_t child_id = 0; child_id < num_configurable_children;
            ++child_id) {
         ModuleId child_module = configurable_children[child_id];
-        size_t child_instance = module_manager.configurable_child_instances(
-          parent_module,
-          ModuleManager::e_config_child_type::PHYSICAL)[child_id];
+        size_t child_instance = configurable_child_instances[child_id];
 
         /* Get the instance name and ensure it is not empty */
         std::string instance_name = module_manager.instance_name(
@@ -235,7 +253,8 @@ static void rec_build_module_fabric_dependent_memory_bank_bitstream(
         rec_build_module_fabric_dependent_memory_bank_bitstream(
           bitstream_manager, child_block, module_manager, top_module,
           child_module, config_region, bl_addr_size, wl_addr_size, num_bls,
-          num_wls, cur_mem_index, fabric_bitstream, fabric_bitstream_region);
+          num_wls, cur_mem_index, child_regions, fabric_bitstream,
+          fabric_bitstream_region);
       }
     }
     /* Ensure that there should be no configuration bits in the parent block */
@@ -280,6 +299,171 @@ static void rec_build_module_fabric_dependent_memory_bank_bitstream(
   }
 }
 
+/********************************************************************
+ * Address codes of the configurable children of a module, which are used
+ * to build the addresses of configuration bits for the frame-based
+ * configuration protocol. Address codes are stored in the reversed order of
+ * bits. See build_frame_module_address_codes() for details.
+ *******************************************************************/
+struct FrameModuleAddressCodes {
+  std::vector<ModuleId> children;
+  std::vector<size_t> child_instances;
+  /* Only available for the top-level module */
+  std::vector<vtr::Point<int>> child_coordinates;
+  /* Number of children to visit, excluding the decoder if any */
+  size_t num_children = 0;
+  /* If there is a decoder to access the children */
+  bool has_decoder = false;
+  /* Address size of the decoder, if any */
+  size_t decoder_addr_size = 0;
+  /* Codes to be added to the head and the tail of the address of each child */
+  std::vector<std::vector<char>> child_rev_head_codes;
+  std::vector<std::vector<char>> child_rev_tail_codes;
+};
+
+/********************************************************************
+ * Precompute the address codes of the configurable children of a module
+ * for the frame-based configuration protocol. The address codes only depend
+ * on the module (and on the configuration region for the top-level module),
+ * so that they are computed once rather than for each configuration bit.
+ *
+ * The address of a configuration bit is built from the top-level module
+ * down to the leaf module, by adding the address codes of each level to the
+ * head of the address. To add codes in constant time, the address is
+ * built in the reversed order of bits, where the head codes are reversed
+ * as well.
+ *******************************************************************/
+static FrameModuleAddressCodes build_frame_module_address_codes(
+  const ModuleManager& module_manager, const ModuleId& top_module,
+  const ConfigRegionId& config_region, const ModuleId& parent_module,
+  const char& bitstream_dont_care_char) {
+  FrameModuleAddressCodes addr_codes;
+  if (top_module == parent_module) {
+    addr_codes.children =
+      module_manager.region_configurable_children(parent_module, config_region);
+    addr_codes.child_instances =
+      module_manager.region_configurable_child_instances(parent_module,
+                                                         config_region);
+    addr_codes.child_coordinates =
+      module_manager.region_configurable_child_coordinates(parent_module,
+                                                           config_region);
+  } else {
+    VTR_ASSERT(top_module != parent_module);
+    addr_codes.children = module_manager.configurable_children(
+      parent_module, ModuleManager::e_config_child_type::PHYSICAL);
+    addr_codes.child_instances = module_manager.configurable_child_instances(
+      parent_module, ModuleManager::e_config_child_type::PHYSICAL);
+  }
+
+  addr_codes.num_children = addr_codes.children.size();
+  /* For only 1 configurable child, there is no frame decoder here, we can
+   * pass on addr code directly.
+   * For more than 2 children, there is a decoder in the tail of the list
+   * We will not decode that, but will access the address size from that
+   * module So, we reduce the number of children by 1
+   * Leaf modules are not checked here, as their configurable children are
+   * not visited
+   */
+  if (2 >= addr_codes.num_children) {
+    return addr_codes;
+  }
+  addr_codes.has_decoder = true;
+  addr_codes.num_children--;
+
+  ModuleId decoder_module = addr_codes.children.back();
+  const ModulePortId& decoder_addr_port_id = module_manager.find_module_port(
+    decoder_module, std::string(DECODER_ADDRESS_PORT_NAME));
+  const BasicPort& decoder_addr_port =
+    module_manager.module_port(decoder_module, decoder_addr_port_id);
+  addr_codes.decoder_addr_size = decoder_addr_port.get_width();
+
+  /* The max address code size is the max address code size of all the
+   * configurable children in all the regions
+   */
+  size_t max_child_addr_code_size = 0;
+  for (const ModuleId& child_module : module_manager.configurable_children(
+         parent_module, ModuleManager::e_config_child_type::PHYSICAL)) {
+    /* Bypass any decoder module (which no configurable children */
+    if (module_manager
+          .configurable_children(child_module,
+                                 ModuleManager::e_config_child_type::PHYSICAL)
+          .empty()) {
+      continue;
+    }
+    const ModulePortId& child_addr_port_id = module_manager.find_module_port(
+      child_module, std::string(DECODER_ADDRESS_PORT_NAME));
+    const BasicPort& child_addr_port =
+      module_manager.module_port(child_module, child_addr_port_id);
+    max_child_addr_code_size =
+      std::max(child_addr_port.get_width(), max_child_addr_code_size);
+  }
+
+  addr_codes.child_rev_head_codes.resize(addr_codes.num_children);
+  addr_codes.child_rev_tail_codes.resize(addr_codes.num_children);
+  for (size_t child_id = 0; child_id < addr_codes.num_children; ++child_id) {
+    std::vector<char> addr_bits_vec =
+      itobin_charvec(child_id, addr_codes.decoder_addr_size);
+
+    /* For top-level module, the child address should be added to the tail
+     * For other modules, the child address should be added to the head
+     */
+    std::vector<char> head_code;
+    if (top_module == parent_module) {
+      addr_codes.child_rev_tail_codes[child_id].assign(addr_bits_vec.rbegin(),
+                                                       addr_bits_vec.rend());
+    } else {
+      head_code = addr_bits_vec;
+    }
+
+    /* Note that the address port size of the child module may be smaller
+     * than the maximum of other child modules at this level. We will add
+     * dummy '0's to the head of addr_bit_vec.
+     *
+     * For example:
+     *  Decoder is the decoder to access all the child modules
+     *  whose address is decoded by the addr_bits_vec
+     *  The child modules may use part of the address lines,
+     *  we should add dummy '0' to fill the gap
+     *
+     *  Addr_code for child[0]: '000' + addr_bits_vec
+     *  Addr_code for child[1]: '00'  + addr_bits_vec
+     *  Addr_code for child[2]: '0' + addr_bits_vec
+     *
+     *                   Addr[6:8]
+     *                     |
+     *                     v
+     *  +-------------------------------------------+
+     *  |            Decoder Module                 |
+     *  +-------------------------------------------+
+     *
+     *     Addr[0:2]       Addr[0:3]        Addr[0:4]
+     *        |                |               |
+     *        v                v               v
+     * +-----------+  +-------------+  +------------+
+     * | Child[0]  |  |  Child[1]   |  |  Child[2]  |
+     * +-----------+  +-------------+  +------------+
+     *
+     * Child[2] has the maximum address lines among the children
+     *
+     */
+    ModuleId child_module = addr_codes.children[child_id];
+    const ModulePortId& child_addr_port_id = module_manager.find_module_port(
+      child_module, std::string(DECODER_ADDRESS_PORT_NAME));
+    const BasicPort& child_addr_port =
+      module_manager.module_port(child_module, child_addr_port_id);
+    if (0 < max_child_addr_code_size - child_addr_port.get_width()) {
+      /* Deposit don't care state for the dummy bits */
+      head_code.insert(head_code.begin(),
+                       max_child_addr_code_size - child_addr_port.get_width(),
+                       bitstream_dont_care_char);
+    }
+    addr_codes.child_rev_head_codes[child_id].assign(head_code.rbegin(),
+                                                     head_code.rend());
+  }
+
+  return addr_codes;
+}
+
 /********************************************************************
  * This function aims to build a bitstream for frame-based configuration
  *protocol It will walk through all the configurable children under a module in
@@ -305,92 +489,65 @@ static void rec_build_module_fabric_dependent_memory_bank_bitstream(
  * the same as the configuration bit in bitstream manager.
  *******************************************************************/
 static void rec_build_module_fabric_dependent_frame_bitstream(
-  const BitstreamManager& bitstream_manager,
-  const std::vector<ConfigBlockId>& parent_blocks,
+  const BitstreamManager& bitstream_manager, const ConfigBlockId& parent_block,
   const ModuleManager& module_manager, const ModuleId& top_module,
-  const ConfigRegionId& config_region,
-  const std::vector<ModuleId>& parent_modules,
-  const std::vector<char>& addr_code, const char& bitstream_dont_care_char,
+  const ConfigRegionId& config_region, const ModuleId& parent_module,
+  std::vector<char>& rev_addr_code, const char& bitstream_dont_care_char,
+  const std::vector<vtr::Rect<int>>& child_regions,
+  std::map<ModuleId, FrameModuleAddressCodes>& module_addr_codes,
   FabricBitstream& fabric_bitstream,
   FabricBitRegionId& fabric_bitstream_region) {
+  /* The address codes of the top-level module depend on the configuration
+   * region, so they are not cached */
+  FrameModuleAddressCodes top_addr_codes;
+  const FrameModuleAddressCodes* addr_codes = nullptr;
+  if (top_module == parent_module) {
+    top_addr_codes = build_frame_module_address_codes(
+      module_manager, top_module, config_region, parent_module,
+      bitstream_dont_care_char);
+    addr_codes = &top_addr_codes;
+  } else {
+    auto result = module_addr_codes.find(parent_module);
+    if (result == module_addr_codes.end()) {
+      result = module_addr_codes
+                 .emplace(parent_module,
+                          build_frame_module_address_codes(
+                            module_manager, top_module, config_region,
+                            parent_module, bitstream_dont_care_char))
+                 .first;
+    }
+    addr_codes = &(result->second);
+  }
+
   /* Depth-first search: if we have any children in the parent_block,
    * we dive to the next level first!
    */
-  if (0 < bitstream_manager.block_children(parent_blocks.back()).size()) {
-    const ConfigBlockId& parent_block = parent_blocks.back();
-    const ModuleId& parent_module = parent_modules.back();
-
-    std::vector<ModuleId> configurable_children;
-    std::vector<size_t> configurable_child_instances;
-    if (top_module == parent_module) {
-      configurable_children = module_manager.region_configurable_children(
-        parent_module, config_region);
-      configurable_child_instances =
-        module_manager.region_configurable_child_instances(parent_module,
-                                                           config_region);
-    } else {
-      VTR_ASSERT(top_module != parent_module);
-      configurable_children = module_manager.configurable_children(
-        parent_module, ModuleManager::e_config_child_type::PHYSICAL);
-      configurable_child_instances =
-        module_manager.configurable_child_instances(
-          parent_module, ModuleManager::e_config_child_type::PHYSICAL);
-    }
-
-    size_t num_configurable_children = configurable_children.size();
-
-    size_t max_child_addr_code_size = 0;
-    bool add_addr_code = true;
-    ModuleId decoder_module = ModuleId::INVALID();
-
+  if (0 < bitstream_manager.block_children(parent_block).size()) {
     /* Early exit if there is no configurable children */
-    if (0 == num_configurable_children) {
+    if (0 == addr_codes->children.size()) {
       /* Ensure that there should be no configuration bits in the parent block
        */
       VTR_ASSERT(0 == bitstream_manager.block_bits(parent_block).size());
       return;
     }
+    VTR_ASSERT((1 == addr_codes->children.size()) ||
+               (true == addr_codes->has_decoder));
 
-    /* For only 1 configurable child,
-     * there is no frame decoder here, we can pass on addr code directly
-     */
-    if (1 == num_configurable_children) {
-      add_addr_code = false;
-    } else {
-      /* For more than 2 children, there is a decoder in the tail of the list
-       * We will not decode that, but will access the address size from that
-       * module So, we reduce the number of children by 1
-       */
-      VTR_ASSERT(2 < num_configurable_children);
-      num_configurable_children--;
-      decoder_module = configurable_children.back();
-
-      /* The max address code size is the max address code size of all the
-       * configurable children in all the regions
-       */
-      for (const ModuleId& child_module : module_manager.configurable_children(
-             parent_module, ModuleManager::e_config_child_type::PHYSICAL)) {
-        /* Bypass any decoder module (which no configurable children */
-        if (module_manager
-              .configurable_children(
-                child_module, ModuleManager::e_config_child_type::PHYSICAL)
-              .empty()) {
-          continue;
-        }
-        const ModulePortId& child_addr_port_id =
-          module_manager.find_module_port(
-            child_module, std::string(DECODER_ADDRESS_PORT_NAME));
-        const BasicPort& child_addr_port =
-          module_manager.module_port(child_module, child_addr_port_id);
-        max_child_addr_code_size =
-          std::max(child_addr_port.get_width(), max_child_addr_code_size);
+    size_t parent_addr_size = rev_addr_code.size();
+    for (size_t child_id = 0; child_id < addr_codes->num_children;
+         ++child_id) {
+      /* For a partial bitstream, the children outside the regions are not
+       * visited. The addresses of the others are not changed, as they only
+       * depend on the child index */
+      if ((top_module == parent_module) &&
+          (false ==
+           is_configurable_child_in_regions(
+             addr_codes->child_coordinates[child_id], child_regions))) {
+        continue;
       }
-    }
 
-    for (size_t child_id = 0; child_id < num_configurable_children;
-         ++child_id) {
-      ModuleId child_module = configurable_children[child_id];
-      size_t child_instance = configurable_child_instances[child_id];
+      ModuleId child_module = addr_codes->children[child_id];
+      size_t child_instance = addr_codes->child_instances[child_id];
       /* Get the instance name and ensure it is not empty */
       std::string instance_name = module_manager.instance_name(
         parent_module, child_module, child_instance);
@@ -401,90 +558,36 @@ static void rec_build_module_fabric_dependent_frame_bitstream(
       /* We must have one valid block id! */
       VTR_ASSERT(true == bitstream_manager.valid_block_id(child_block));
 
-      /* Pass on the list of blocks, modules and address lists */
-      std::vector<ConfigBlockId> child_blocks = parent_blocks;
-      child_blocks.push_back(child_block);
-
-      std::vector<ModuleId> child_modules = parent_modules;
-      child_modules.push_back(child_module);
-
-      /* Set address, apply binary conversion from the first to the last element
-       * in the address list */
-      std::vector<char> child_addr_code = addr_code;
-
-      if (true == add_addr_code) {
-        /* Find the address port from the decoder module */
-        const ModulePortId& decoder_addr_port_id =
-          module_manager.find_module_port(
-            decoder_module, std::string(DECODER_ADDRESS_PORT_NAME));
-        const BasicPort& decoder_addr_port =
-          module_manager.module_port(decoder_module, decoder_addr_port_id);
-        std::vector<char> addr_bits_vec =
-          itobin_charvec(child_id, decoder_addr_port.get_width());
-
-        /* For top-level module, the child address should be added to the tail
-         * For other modules, the child address should be added to the head
-         */
-        if (top_module == parent_module) {
-          child_addr_code.insert(child_addr_code.end(), addr_bits_vec.begin(),
-                                 addr_bits_vec.end());
-        } else {
-          VTR_ASSERT_SAFE(top_module != parent_module);
-          child_addr_code.insert(child_addr_code.begin(), addr_bits_vec.begin(),
-                                 addr_bits_vec.end());
-        }
-
-        /* Note that the address port size of the child module may be smaller
-         * than the maximum of other child modules at this level. We will add
-         * dummy '0's to the head of addr_bit_vec.
-         *
-         * For example:
-         *  Decoder is the decoder to access all the child modules
-         *  whose address is decoded by the addr_bits_vec
-         *  The child modules may use part of the address lines,
-         *  we should add dummy '0' to fill the gap
-         *
-         *  Addr_code for child[0]: '000' + addr_bits_vec
-         *  Addr_code for child[1]: '00'  + addr_bits_vec
-         *  Addr_code for child[2]: '0' + addr_bits_vec
-         *
-         *                   Addr[6:8]
-         *                     |
-         *                     v
-         *  +-------------------------------------------+
-         *  |            Decoder Module                 |
-         *  +-------------------------------------------+
-         *
-         *     Addr[0:2]       Addr[0:3]        Addr[0:4]
-         *        |                |               |
-         *        v                v               v
-         * +-----------+  +-------------+  +------------+
-         * | Child[0]  |  |  Child[1]   |  |  Child[2]  |
-         * +-----------+  +-------------+  +------------+
-         *
-         * Child[2] has the maximum address lines among the children
-         *
-         */
-        const ModulePortId& child_addr_port_id =
-          module_manager.find_module_port(
-            child_module, std::string(DECODER_ADDRESS_PORT_NAME));
-        const BasicPort& child_addr_port =
-          module_manager.module_port(child_module, child_addr_port_id);
-        if (0 < max_child_addr_code_size - child_addr_port.get_width()) {
-          /* Deposit don't care state for the dummy bits */
-          std::vector<char> dummy_codes(
-            max_child_addr_code_size - child_addr_port.get_width(),
-            bitstream_dont_care_char);
-          child_addr_code.insert(child_addr_code.begin(), dummy_codes.begin(),
-                                 dummy_codes.end());
-        }
+      /* Set address: the address code of the child is added to the head of
+       * the address, which is the tail of the reversed address. For the
+       * top-level module, the child address is also added to the tail of the
+       * address */
+      if (true == addr_codes->has_decoder) {
+        const std::vector<char>& rev_tail_code =
+          addr_codes->child_rev_tail_codes[child_id];
+        rev_addr_code.insert(rev_addr_code.begin(), rev_tail_code.begin(),
+                             rev_tail_code.end());
+        const std::vector<char>& rev_head_code =
+          addr_codes->child_rev_head_codes[child_id];
+        rev_addr_code.insert(rev_addr_code.end(), rev_head_code.begin(),
+                             rev_head_code.end());
       }
 
       /* Go recursively */
       rec_build_module_fabric_dependent_frame_bitstream(
-        bitstream_manager, child_blocks, module_manager, top_module,
-        config_region, child_modules, child_addr_code, bitstream_dont_care_char,
-        fabric_bitstream, fabric_bitstream_region);
+        bitstream_manager, child_block, module_manager, top_module,
+        config_region, child_module, rev_addr_code, bitstream_dont_care_char,
+        child_regions, module_addr_codes, fabric_bitstream,
+        fabric_bitstream_region);
+
+      /* Restore the address of the parent */
+      if (true == addr_codes->has_decoder) {
+        rev_addr_code.erase(
+          rev_addr_code.begin(),
+          rev_addr_code.begin() +
+            addr_codes->child_rev_tail_codes[child_id].size());
+        rev_addr_code.resize(parent_addr_size);
+      }
     }
     /* Ensure that there should be no configuration bits in the parent block */
     VTR_ASSERT(0 == bitstream_manager.block_bits(parent_block).size());
@@ -497,41 +600,36 @@ static void rec_build_module_fabric_dependent_frame_bitstream(
    * which is the last of configurable children.
    * We will find the address bit and add it to addr_code
    * Then we can add the configuration bits to the fabric_bitstream.
+   * The address of the parent is the same for all the bits, so only the
+   * address bits of the leaf decoder are updated for each bit
    */
-  std::vector<ModuleId> configurable_children;
-  if (top_module == parent_modules.back()) {
-    configurable_children = module_manager.region_configurable_children(
-      parent_modules.back(), config_region);
-  } else {
-    VTR_ASSERT(top_module != parent_modules.back());
-    configurable_children = module_manager.configurable_children(
-      parent_modules.back(), ModuleManager::e_config_child_type::PHYSICAL);
-  }
-
-  ModuleId decoder_module = configurable_children.back();
+  VTR_ASSERT(false == addr_codes->children.empty());
+  ModuleId decoder_module = addr_codes->children.back();
   /* Find the address port from the decoder module */
   const ModulePortId& decoder_addr_port_id = module_manager.find_module_port(
     decoder_module, std::string(DECODER_ADDRESS_PORT_NAME));
   const BasicPort& decoder_addr_port =
     module_manager.module_port(decoder_module, decoder_addr_port_id);
-
-  for (size_t ibit = 0;
-       ibit < bitstream_manager.block_bits(parent_blocks.back()).size();
-       ++ibit) {
-    ConfigBitId config_bit =
-      bitstream_manager.block_bits(parent_blocks.back())[ibit];
-    std::vector<char> addr_bits_vec =
-      itobin_charvec(ibit, decoder_addr_port.get_width());
-
-    std::vector<char> child_addr_code = addr_code;
-
-    child_addr_code.insert(child_addr_code.begin(), addr_bits_vec.begin(),
-                           addr_bits_vec.end());
+  size_t decoder_addr_size = decoder_addr_port.get_width();
+  std::vector<char> addr_code(decoder_addr_size + rev_addr_code.size(), '0');
+  std::copy(rev_addr_code.rbegin(), rev_addr_code.rend(),
+            addr_code.begin() + decoder_addr_size);
+
+  std::vector<ConfigBitId> block_bits =
+    bitstream_manager.block_bits(parent_block);
+  VTR_ASSERT((64 <= decoder_addr_size) ||
+             (block_bits.size() <= (size_t(1) << decoder_addr_size)));
+  for (size_t ibit = 0; ibit < block_bits.size(); ++ibit) {
+    const ConfigBitId& config_bit = block_bits[ibit];
+    /* Binary code of the bit index, LSB first */
+    for (size_t iaddr = 0; iaddr < decoder_addr_size; ++iaddr) {
+      addr_code[iaddr] = ((ibit >> iaddr) & 1) ? '1' : '0';
+    }
 
     const FabricBitId& fabric_bit = fabric_bitstream.add_bit(config_bit);
 
     /* Set address */
-    fabric_bitstream.set_bit_address(fabric_bit, child_addr_code);
+    fabric_bitstream.set_bit_address(fabric_bit, addr_code);
 
     /* Set data input */
     fabric_bitstream.set_bit_din(fabric_bit,
@@ -550,9 +648,14 @@ static void build_module_fabric_dependent_bitstream(
   const ConfigProtocol& config_protocol, const CircuitLibrary& circuit_lib,
   const BitstreamManager& bitstream_manager, const ConfigBlockId& top_block,
   const ModuleManager& module_manager, const ModuleId& top_module,
-  FabricBitstream& fabric_bitstream, const bool& verbose) {
+  const std::vector<vtr::Rect<int>>& child_regions,
+  FabricBitstream& fabric_bitstream, const size_t& num_threads,
+  const bool& verbose) {
   switch (config_protocol.type()) {
     case CONFIG_MEM_STANDALONE: {
+      /* A configuration chain can not be partially programmed */
+      VTR_ASSERT(true == child_regions.empty());
+
       /* Reserve bits before build-up */
       fabric_bitstream.reserve_bits(bitstream_manager.num_bits());
 
@@ -562,12 +665,20 @@ static void build_module_fabric_dependent_bitstream(
           fabric_bitstream.add_region();
         rec_build_module_fabric_dependent_chain_bitstream(
           bitstream_manager, top_block, module_manager, top_module, top_module,
-          config_region, fabric_bitstream, fabric_bitstream_region, verbose);
+          config_region,
+          [&](const ConfigBitId& config_bit) {
+            FabricBitId fabric_bit = fabric_bitstream.add_bit(config_bit);
+            fabric_bitstream.add_bit_to_region(fabric_bitstream_region,
+                                               fabric_bit);
+          },
+          verbose);
       }
 
       break;
     }
     case CONFIG_MEM_SCAN_CHAIN: {
+      VTR_ASSERT(true == child_regions.empty());
+
       /* Reserve bits before build-up */
       fabric_bitstream.reserve_bits(bitstream_manager.num_bits());
 
@@ -577,7 +688,13 @@ static void build_module_fabric_dependent_bitstream(
           fabric_bitstream.add_region();
         rec_build_module_fabric_dependent_chain_bitstream(
           bitstream_manager, top_block, module_manager, top_module, top_module,
-          config_region, fabric_bitstream, fabric_bitstream_region, verbose);
+          config_region,
+          [&](const ConfigBitId& config_bit) {
+            FabricBitId fabric_bit = fabric_bitstream.add_bit(config_bit);
+            fabric_bitstream.add_bit_to_region(fabric_bitstream_region,
+                                               fabric_bit);
+          },
+          verbose);
         fabric_bitstream.reverse_region_bits(fabric_bitstream_region);
       }
       break;
@@ -634,15 +751,16 @@ static void build_module_fabric_dependent_bitstream(
           bitstream_manager, top_block, module_manager, top_module, top_module,
           config_region, bl_addr_port_info.get_width(),
           wl_addr_port_info.get_width(), bl_port_info.get_width(),
-          wl_port_info.get_width(), cur_mem_index, fabric_bitstream,
-          fabric_bitstream_region);
+          wl_port_info.get_width(), cur_mem_index, child_regions,
+          fabric_bitstream, fabric_bitstream_region);
       }
       break;
     }
     case CONFIG_MEM_QL_MEMORY_BANK: {
       build_module_fabric_dependent_bitstream_ql_memory_bank(
         config_protocol, circuit_lib, bitstream_manager, top_block,
-        module_manager, top_module, fabric_bitstream);
+        module_manager, top_module, child_regions, fabric_bitstream,
+        num_threads);
       break;
     }
     case CONFIG_MEM_FRAME_BASED: {
@@ -684,6 +802,8 @@ static void build_module_fabric_dependent_bitstream(
           std::max(max_decoder_addr_size, decoder_addr_port.get_width());
       }
 
+      /* Address codes of the modules, shared by all the regions */
+      std::map<ModuleId, FrameModuleAddressCodes> module_addr_codes;
       for (const ConfigRegionId& config_region :
            module_manager.regions(top_module)) {
         std::vector<ModuleId> configurable_children =
@@ -717,11 +837,13 @@ static void build_module_fabric_dependent_bitstream(
 
         FabricBitRegionId fabric_bitstream_region =
           fabric_bitstream.add_region();
+        std::vector<char> rev_addr_code(idle_addr_bits.rbegin(),
+                                        idle_addr_bits.rend());
         rec_build_module_fabric_dependent_frame_bitstream(
-          bitstream_manager, std::vector<ConfigBlockId>(1, top_block),
-          module_manager, top_module, config_region,
-          std::vector<ModuleId>(1, top_module), idle_addr_bits,
-          bitstream_dont_care_char, fabric_bitstream, fabric_bitstream_region);
+          bitstream_manager, top_block, module_manager, top_module,
+          config_region, top_module, rev_addr_code, bitstream_dont_care_char,
+          child_regions, module_addr_codes, fabric_bitstream,
+          fabric_bitstream_region);
       }
       break;
     }
@@ -751,38 +873,28 @@ static void build_module_fabric_dependent_bitstream(
   }
    */
 
-  /* Ensure our fabric bitstream is in the same size as device bistream */
-  VTR_ASSERT(bitstream_manager.num_bits() == fabric_bitstream.num_bits());
+  /* Ensure our fabric bitstream is in the same size as device bistream,
+   * unless only a part of the fabric is considered */
+  if (true == child_regions.empty()) {
+    VTR_ASSERT(bitstream_manager.num_bits() == fabric_bitstream.num_bits());
+  } else {
+    VTR_ASSERT(bitstream_manager.num_bits() >= fabric_bitstream.num_bits());
+  }
 }
 
 /********************************************************************
- * A top-level function re-organizes the bitstream for a specific
- * FPGA fabric, where configuration bits are organized in the sequence
- * that can be directly loaded to the FPGA configuration protocol.
- * Support:
- * 1. Configuration chain
- * 2. Memory decoders
- * This function does NOT modify the bitstream database
- * Instead, it builds a vector of ids for configuration bits in bitstream
- *manager
- *
- * This function can be called ONLY after the function build_device_bitstream()
- * Note that this function does NOT decode bitstreams from circuit
- *implementation It was done in the function build_device_bitstream()
+ * Find the top block in bitstream manager and the top module in module
+ * manager, which are the starting points of fabric-dependent bitstreams.
+ * When the fpga_core is added, the core block and the core module are used
  *******************************************************************/
-FabricBitstream build_fabric_dependent_bitstream(
+void find_fabric_dependent_bitstream_top(
   const BitstreamManager& bitstream_manager,
   const ModuleManager& module_manager, const ModuleNameMap& module_name_map,
-  const CircuitLibrary& circuit_lib, const ConfigProtocol& config_protocol,
-  const bool& verbose) {
-  FabricBitstream fabric_bitstream;
-
-  vtr::ScopedStartFinishTimer timer("\nBuild fabric dependent bitstream\n");
-
+  ConfigBlockId& top_block, ModuleId& top_module) {
   /* Get the top module name in module manager, which is our starting point */
   std::string top_module_name =
     module_name_map.name(generate_fpga_top_module_name());
-  ModuleId top_module = module_manager.find_module(top_module_name);
+  top_module = module_manager.find_module(top_module_name);
   VTR_ASSERT(true == module_manager.valid_module_id(top_module));
 
   /* Find the top block in bitstream manager, which has not parents */
@@ -792,7 +904,7 @@ FabricBitstream build_fabric_dependent_bitstream(
   VTR_ASSERT(1 == top_blocks.size());
   VTR_ASSERT(
     0 == top_module_name.compare(bitstream_manager.block_name(top_blocks[0])));
-  ConfigBlockId top_block = top_blocks[0];
+  top_block = top_blocks[0];
 
   /* Create the core block when the fpga_core is added */
   std::string core_block_name = generate_fpga_core_module_name();
@@ -808,11 +920,49 @@ FabricBitstream build_fabric_dependent_bitstream(
     top_module = core_module;
     top_block = core_block;
   }
+}
+
+/********************************************************************
+ * A top-level function re-organizes the bitstream for a specific
+ * FPGA fabric, where configuration bits are organized in the sequence
+ * that can be directly loaded to the FPGA configuration protocol.
+ * Support:
+ * 1. Configuration chain
+ * 2. Memory decoders
+ * This function does NOT modify the bitstream database
+ * Instead, it builds a vector of ids for configuration bits in bitstream
+ *manager
+ *
+ * This function can be called ONLY after the function build_device_bitstream()
+ * Note that this function does NOT decode bitstreams from circuit
+ *implementation It was done in the function build_device_bitstream()
+ *
+ * When regions are given, a partial bitstream is built, which only includes
+ * the configurable children of the top-level module whose coordinates are in
+ * any of the regions. The children outside the regions are not visited at all.
+ * This is only valid for the protocols using addresses, where the addresses of
+ * the bits in the regions are the same as in the full bitstream
+ *******************************************************************/
+FabricBitstream build_fabric_dependent_bitstream(
+  const BitstreamManager& bitstream_manager,
+  const ModuleManager& module_manager, const ModuleNameMap& module_name_map,
+  const CircuitLibrary& circuit_lib, const ConfigProtocol& config_protocol,
+  const std::vector<vtr::Rect<int>>& child_regions, const size_t& num_threads,
+  const bool& verbose) {
+  TraceScope trace_scope("build_fabric_dependent_bitstream");
+  FabricBitstream fabric_bitstream;
+
+  vtr::ScopedStartFinishTimer timer("\nBuild fabric dependent bitstream\n");
+
+  ModuleId top_module;
+  ConfigBlockId top_block;
+  find_fabric_dependent_bitstream_top(bitstream_manager, module_manager,
+                                      module_name_map, top_block, top_module);
 
   /* Start build-up formally */
   build_module_fabric_dependent_bitstream(
     config_protocol, circuit_lib, bitstream_manager, top_block, module_manager,
-    top_module, fabric_bitstream, verbose);
+    top_module, child_regions, fabric_bitstream, num_threads, verbose);
 
   VTR_LOGV(verbose, "Built %lu configuration bits for fabric\n",
            fabric_bitstream.num_bits());
@@ -820,4 +970,94 @@ FabricBitstream build_fabric_dependent_bitstream(
   return fabric_bitstream;
 }
 
+/********************************************************************
+ * Update the data inputs of a fabric bitstream with the values of the
+ * configuration bits in a bitstream database, while the addresses are
+ * kept. This is valid when the bitstream database has the same structure
+ * as the one used to build the fabric bitstream, e.g., the bitstream of
+ * another implementation on the same FPGA fabric, and it is much faster
+ * than rebuilding the fabric bitstream.
+ * Note that only the protocols using addresses store data inputs, the
+ * fabric bitstream of the others is always up-to-date.
+ *
+ * Return the number of fabric bits whose data input is changed
+ *******************************************************************/
+size_t update_fabric_bitstream_dins(FabricBitstream& fabric_bitstream,
+                                    const BitstreamManager& bitstream_manager) {
+  if (false == fabric_bitstream.use_address()) {
+    return 0;
+  }
+
+  size_t num_changed_bits = 0;
+  for (const FabricBitId& fabric_bit : fabric_bitstream.bits()) {
+    char din =
+      bitstream_manager.bit_value(fabric_bitstream.config_bit(fabric_bit));
+    if (din != fabric_bitstream.bit_din(fabric_bit)) {
+      fabric_bitstream.set_bit_din(fabric_bit, din);
+      num_changed_bits++;
+    }
+  }
+
+  return num_changed_bits;
+}
+
+/********************************************************************
+ * Build a fabric bitstream on a template, which only gathers the values
+ * of the configuration bits from a bitstream database, while the sequence
+ * and the addresses of the bits are shared with the template.
+ * The template should be built for the same FPGA fabric as the bitstream
+ * database, e.g., by another design, see FabricBitstreamTemplate
+ *******************************************************************/
+FabricBitstream build_fabric_bitstream_from_template(
+  const std::shared_ptr<const FabricBitstreamTemplate>& bitstream_template,
+  const BitstreamManager& bitstream_manager, const bool& verbose) {
+  vtr::ScopedStartFinishTimer timer(
+    "\nBuild fabric dependent bitstream from template\n");
+  TraceScope trace_scope("build_fabric_bitstream_from_template");
+
+  FabricBitstream fabric_bitstream(bitstream_template);
+  size_t num_set_bits =
+    update_fabric_bitstream_dins(fabric_bitstream, bitstream_manager);
+
+  VTR_LOGV(verbose, "Gathered %lu configuration bits for fabric (%lu set)\n",
+           fabric_bitstream.num_bits(), num_set_bits);
+
+  return fabric_bitstream;
+}
+
+/********************************************************************
+ * Walk through the configuration bits of a fabric whose configuration
+ * protocol is a chain-like one, i.e., standalone or scan-chain,
+ * in the same order as build_fabric_dependent_bitstream() adds them to
+ * the fabric bitstream, but without storing them.
+ * The function is called on each bit with the index of its configurable
+ * region. Note that the bits of a scan-chain region are visited from the
+ * head of the chain, i.e., before they are reversed
+ *******************************************************************/
+void walk_chain_fabric_dependent_bitstream(
+  const BitstreamManager& bitstream_manager,
+  const ModuleManager& module_manager, const ModuleNameMap& module_name_map,
+  const ConfigProtocol& config_protocol,
+  const std::function<void(const size_t&, const ConfigBitId&)>& func,
+  const bool& verbose) {
+  VTR_ASSERT((CONFIG_MEM_STANDALONE == config_protocol.type()) ||
+             (CONFIG_MEM_SCAN_CHAIN == config_protocol.type()));
+
+  ModuleId top_module;
+  ConfigBlockId top_block;
+  find_fabric_dependent_bitstream_top(bitstream_manager, module_manager,
+                                      module_name_map, top_block, top_module);
+
+  size_t region_index = 0;
+  for (const ConfigRegionId& config_region :
+       module_manager.regions(top_module)) {
+    rec_build_module_fabric_dependent_chain_bitstream(
+      bitstream_manager, top_block, module_manager, top_module, top_module,
+      config_region,
+      [&](const ConfigBitId& config_bit) { func(region_index, config_bit); },
+      verbose);
+    region_index++;
+  }
+}
+
 } /* end namespace openfpga */
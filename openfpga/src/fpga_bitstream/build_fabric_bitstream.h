@@ -4,6 +4,8 @@
 /********************************************************************
  * Include header files that are required by function declaration
  *******************************************************************/
+#include <functional>
+#include <memory>
 #include <vector>
 
 #include "bitstream_manager.h"
@@ -12,6 +14,7 @@
 #include "fabric_bitstream.h"
 #include "module_manager.h"
 #include "module_name_map.h"
+#include "vtr_geometry.h"
 
 /********************************************************************
  * Function declaration
@@ -20,10 +23,30 @@
 /* begin namespace openfpga */
 namespace openfpga {
 
+void find_fabric_dependent_bitstream_top(
+  const BitstreamManager& bitstream_manager,
+  const ModuleManager& module_manager, const ModuleNameMap& module_name_map,
+  ConfigBlockId& top_block, ModuleId& top_module);
+
 FabricBitstream build_fabric_dependent_bitstream(
   const BitstreamManager& bitstream_manager,
   const ModuleManager& module_manager, const ModuleNameMap& module_name_map,
   const CircuitLibrary& circuit_lib, const ConfigProtocol& config_protocol,
+  const std::vector<vtr::Rect<int>>& child_regions, const size_t& num_threads,
+  const bool& verbose);
+
+size_t update_fabric_bitstream_dins(FabricBitstream& fabric_bitstream,
+                                    const BitstreamManager& bitstream_manager);
+
+FabricBitstream build_fabric_bitstream_from_template(
+  const std::shared_ptr<const FabricBitstreamTemplate>& bitstream_template,
+  const BitstreamManager& bitstream_manager, const bool& verbose);
+
+void walk_chain_fabric_dependent_bitstream(
+  const BitstreamManager& bitstream_manager,
+  const ModuleManager& module_manager, const ModuleNameMap& module_name_map,
+  const ConfigProtocol& config_protocol,
+  const std::function<void(const size_t&, const ConfigBitId&)>& func,
   const bool& verbose);
 
 } /* end namespace openfpga */
@@ -5,6 +5,7 @@
 #include <algorithm>
 #include <cmath>
 #include <string>
+#include <vector>
 
 /* Headers from vtrutil library */
 #include "vtr_assert.h"
@@ -15,15 +16,28 @@
 #include "bitstream_manager_utils.h"
 #include "build_fabric_bitstream_memory_bank.h"
 #include "decoder_library_utils.h"
+#include "fabric_bitstream_utils.h"
 #include "memory_bank_utils.h"
 #include "memory_utils.h"
 #include "openfpga_decode.h"
 #include "openfpga_naming.h"
+#include "openfpga_parallel.h"
 #include "openfpga_reserved_words.h"
 
 /* begin namespace openfpga */
 namespace openfpga {
 
+/********************************************************************
+ * A configuration bit of a region with its BL and WL indices, which are
+ * found by walking through the region and then added to the fabric
+ * bitstream
+ *******************************************************************/
+struct QlMemoryBankRegionalBit {
+  ConfigBitId config_bit;
+  size_t bl;
+  size_t wl;
+};
+
 /********************************************************************
  * This function aims to build a bitstream for memory-bank protocol
  * It will walk through all the configurable children under a module
@@ -39,20 +53,23 @@ namespace openfpga {
  * In such configuration organization, each memory cell has an unique index.
  * Using this index, we can infer the address codes for both BL and WL decoders.
  * Note that, we must get the number of BLs and WLs before using this function!
+ *
+ * The bits are collected in the regional bits with their BL/WL indices,
+ * while the module manager and bitstream manager are only read, so that
+ * regions can be walked in parallel
  *******************************************************************/
 static void rec_build_module_fabric_dependent_ql_memory_bank_regional_bitstream(
   const BitstreamManager& bitstream_manager, const ConfigBlockId& parent_block,
   const ModuleManager& module_manager, const ModuleId& top_module,
   const ModuleId& parent_module, const ConfigRegionId& config_region,
   const ConfigProtocol& config_protocol, const CircuitLibrary& circuit_lib,
-  const CircuitModelId& sram_model, const size_t& bl_addr_size,
-  const size_t& wl_addr_size, size_t& num_bls_cur_tile,
+  const CircuitModelId& sram_model, size_t& num_bls_cur_tile,
   const std::map<int, size_t>& bl_start_index_per_tile,
   size_t& num_wls_cur_tile,
   const std::map<int, size_t>& wl_start_index_per_tile,
   vtr::Point<int>& tile_coord, std::map<vtr::Point<int>, size_t>& cur_mem_index,
-  FabricBitstream& fabric_bitstream,
-  const FabricBitRegionId& fabric_bitstream_region) {
+  const std::vector<vtr::Rect<int>>& child_regions,
+  std::vector<QlMemoryBankRegionalBit>& regional_bits) {
   /* Depth-first search: if we have any children in the parent_block,
    * we dive to the next level first!
    */
@@ -108,13 +125,23 @@ static void rec_build_module_fabric_dependent_ql_memory_bank_regional_bitstream(
         /* We must have one valid block id! */
         VTR_ASSERT(true == bitstream_manager.valid_block_id(child_block));
 
+        /* For a partial bitstream, the children outside the regions are not
+         * visited, but their memory cells still occupy the BLs and WLs */
+        if (false ==
+            is_configurable_child_in_regions(tile_coord, child_regions)) {
+          cur_mem_index[tile_coord] +=
+            rec_find_bitstream_manager_block_sum_of_bits(bitstream_manager,
+                                                         child_block);
+          continue;
+        }
+
         /* Go recursively */
         rec_build_module_fabric_dependent_ql_memory_bank_regional_bitstream(
           bitstream_manager, child_block, module_manager, top_module,
           child_module, config_region, config_protocol, circuit_lib, sram_model,
-          bl_addr_size, wl_addr_size, num_bls_cur_tile, bl_start_index_per_tile,
-          num_wls_cur_tile, wl_start_index_per_tile, tile_coord, cur_mem_index,
-          fabric_bitstream, fabric_bitstream_region);
+          num_bls_cur_tile, bl_start_index_per_tile, num_wls_cur_tile,
+          wl_start_index_per_tile, tile_coord, cur_mem_index, child_regions,
+          regional_bits);
       }
     } else {
       VTR_ASSERT(parent_module != top_module);
@@ -122,9 +149,12 @@ static void rec_build_module_fabric_dependent_ql_memory_bank_regional_bitstream(
        *   - Use configurable children directly
        *   - no need to exclude decoders as they are not there
        */
-      std::vector<ModuleId> configurable_children =
+      const std::vector<ModuleId>& configurable_children =
         module_manager.configurable_children(
           parent_module, ModuleManager::e_config_child_type::PHYSICAL);
+      const std::vector<size_t>& configurable_child_instances =
+        module_manager.configurable_child_instances(
+          parent_module, ModuleManager::e_config_child_type::PHYSICAL);
 
       size_t num_configurable_children = configurable_children.size();
 
@@ -139,9 +169,7 @@ static void rec_build_module_fabric_dependent_ql_memory_bank_regional_bitstream(
       for (size_t child_id = 0; child_id < num_configurable_children;
            ++child_id) {
         ModuleId child_module = configurable_children[child_id];
-        size_t child_instance = module_manager.configurable_child_instances(
-          parent_module,
-          ModuleManager::e_config_child_type::PHYSICAL)[child_id];
+        size_t child_instance = configurable_child_instances[child_id];
 
         /* Get the instance name and ensure it is not empty */
         std::string instance_name = module_manager.instance_name(
@@ -157,9 +185,9 @@ static void rec_build_module_fabric_dependent_ql_memory_bank_regional_bitstream(
         rec_build_module_fabric_dependent_ql_memory_bank_regional_bitstream(
           bitstream_manager, child_block, module_manager, top_module,
           child_module, config_region, config_protocol, circuit_lib, sram_model,
-          bl_addr_size, wl_addr_size, num_bls_cur_tile, bl_start_index_per_tile,
-          num_wls_cur_tile, wl_start_index_per_tile, tile_coord, cur_mem_index,
-          fabric_bitstream, fabric_bitstream_region);
+          num_bls_cur_tile, bl_start_index_per_tile, num_wls_cur_tile,
+          wl_start_index_per_tile, tile_coord, cur_mem_index, child_regions,
+          regional_bits);
       }
     }
     /* Ensure that there should be no configuration bits in the parent block */
@@ -169,75 +197,87 @@ static void rec_build_module_fabric_dependent_ql_memory_bank_regional_bitstream(
   }
 
   /* Note that, reach here, it means that this is a leaf node.
-   * We add the configuration bits to the fabric_bitstream,
+   * We collect the configuration bits with their BL/WL indices,
    * And then, we can return
    */
   for (const ConfigBitId& config_bit :
        bitstream_manager.block_bits(parent_block)) {
-    FabricBitId fabric_bit = fabric_bitstream.add_bit(config_bit);
-
-    /*
-      If both BL and WL protocols are Flatten, we will have new way of
-      storing information in fabric_bitstream. This will save high
-      memory usage, as well as fast processing
-    */
-    /* The BL address to be decoded depends on the protocol
-     * - flatten BLs: use 1-hot decoding
-     * - BL decoders: fully encoded
-     * - Shift register: use 1-hot decoding
-     */
     size_t cur_bl_index = bl_start_index_per_tile.at(tile_coord.x()) +
                           cur_mem_index[tile_coord] % num_bls_cur_tile;
-    if (BLWL_PROTOCOL_FLATTEN != config_protocol.bl_protocol_type() ||
-        BLWL_PROTOCOL_FLATTEN != config_protocol.wl_protocol_type()) {
+    size_t cur_wl_index =
+      wl_start_index_per_tile.at(tile_coord.y()) +
+      std::floor(cur_mem_index[tile_coord] / num_bls_cur_tile);
+    regional_bits.push_back({config_bit, cur_bl_index, cur_wl_index});
+
+    /* Increase the memory index */
+    cur_mem_index[tile_coord]++;
+  }
+}
+
+/********************************************************************
+ * Add the bits collected in a region to the fabric bitstream, in the order
+ * they have been visited, and set their addresses
+ * The BL and WL protocols are template parameters, so that the addresses
+ * are built without checking the protocols for each bit
+ *******************************************************************/
+template <e_blwl_protocol_type BL_PROTOCOL, e_blwl_protocol_type WL_PROTOCOL>
+static void add_ql_memory_bank_regional_bits_to_fabric_bitstream(
+  const BitstreamManager& bitstream_manager,
+  const std::vector<QlMemoryBankRegionalBit>& regional_bits,
+  const size_t& bl_addr_size, const size_t& wl_addr_size,
+  FabricBitstream& fabric_bitstream,
+  const FabricBitRegionId& fabric_bitstream_region) {
+  /*
+    If both BL and WL protocols are Flatten, we will have new way of
+    storing information in fabric_bitstream. This will save high
+    memory usage, as well as fast processing
+  */
+  constexpr bool use_memory_bank_info =
+    (BLWL_PROTOCOL_FLATTEN == BL_PROTOCOL) &&
+    (BLWL_PROTOCOL_FLATTEN == WL_PROTOCOL);
+  for (const QlMemoryBankRegionalBit& regional_bit : regional_bits) {
+    const ConfigBitId& config_bit = regional_bit.config_bit;
+    const size_t& cur_bl_index = regional_bit.bl;
+    const size_t& cur_wl_index = regional_bit.wl;
+    FabricBitId fabric_bit = fabric_bitstream.add_bit(config_bit);
+
+    if (true == use_memory_bank_info) {
+      // New way of storing information in compact way
+      // Only for Flatten protocol (can easily support shift register as well)
+      // Need to understand decoder to better assessment
+      fabric_bitstream.set_memory_bank_info(
+        fabric_bit, fabric_bitstream_region, cur_bl_index, cur_wl_index,
+        bl_addr_size, wl_addr_size, bitstream_manager.bit_value(config_bit));
+    } else {
       // This is using old way
       // We only do this kind of resource wasting storing if
       // either protocol is not flatten
+      /* The BL address to be decoded depends on the protocol
+       * - flatten BLs: use 1-hot decoding
+       * - BL decoders: fully encoded
+       * - Shift register: use 1-hot decoding
+       */
       std::vector<char> bl_addr_bits_vec;
-      if (BLWL_PROTOCOL_DECODER == config_protocol.bl_protocol_type()) {
+      if (BLWL_PROTOCOL_DECODER == BL_PROTOCOL) {
         bl_addr_bits_vec = itobin_charvec(cur_bl_index, bl_addr_size);
-      } else if (BLWL_PROTOCOL_FLATTEN == config_protocol.bl_protocol_type() ||
-                 BLWL_PROTOCOL_SHIFT_REGISTER ==
-                   config_protocol.bl_protocol_type()) {
+      } else {
         bl_addr_bits_vec =
           ito1hot_charvec(cur_bl_index, bl_addr_size, DONT_CARE_CHAR);
       }
       /* Set BL address */
       fabric_bitstream.set_bit_bl_address(
-        fabric_bit, bl_addr_bits_vec,
-        BLWL_PROTOCOL_DECODER != config_protocol.bl_protocol_type());
-    }
+        fabric_bit, bl_addr_bits_vec, BLWL_PROTOCOL_DECODER != BL_PROTOCOL);
 
-    /* Find WL address */
-    size_t cur_wl_index =
-      wl_start_index_per_tile.at(tile_coord.y()) +
-      std::floor(cur_mem_index[tile_coord] / num_bls_cur_tile);
-    if (BLWL_PROTOCOL_FLATTEN != config_protocol.bl_protocol_type() ||
-        BLWL_PROTOCOL_FLATTEN != config_protocol.wl_protocol_type()) {
-      // This is using old way
-      // We only do this kind of resource wasting storing if
-      // either protocol is not flatten
+      /* Find WL address */
       std::vector<char> wl_addr_bits_vec;
-      if (BLWL_PROTOCOL_DECODER == config_protocol.wl_protocol_type()) {
+      if (BLWL_PROTOCOL_DECODER == WL_PROTOCOL) {
         wl_addr_bits_vec = itobin_charvec(cur_wl_index, wl_addr_size);
-      } else if (BLWL_PROTOCOL_FLATTEN == config_protocol.wl_protocol_type() ||
-                 BLWL_PROTOCOL_SHIFT_REGISTER ==
-                   config_protocol.wl_protocol_type()) {
+      } else {
         wl_addr_bits_vec = ito1hot_charvec(cur_wl_index, wl_addr_size);
       }
       /* Set WL address */
       fabric_bitstream.set_bit_wl_address(
-        fabric_bit, wl_addr_bits_vec,
-        BLWL_PROTOCOL_DECODER != config_protocol.wl_protocol_type());
-    }
-    if (BLWL_PROTOCOL_FLATTEN == config_protocol.bl_protocol_type() &&
-        BLWL_PROTOCOL_FLATTEN == config_protocol.wl_protocol_type()) {
-      // New way of storing information in compact way
-      // Only for Flatten protocol (can easily support shift register as well)
-      // Need to understand decoder to better assessment
-      fabric_bitstream.set_memory_bank_info(
-        fabric_bit, fabric_bitstream_region, cur_bl_index, cur_wl_index,
-        bl_addr_size, wl_addr_size, bitstream_manager.bit_value(config_bit));
+        fabric_bit, wl_addr_bits_vec, BLWL_PROTOCOL_DECODER != WL_PROTOCOL);
     }
 
     /* Set data input */
@@ -246,21 +286,94 @@ static void rec_build_module_fabric_dependent_ql_memory_bank_regional_bitstream(
 
     /* Add the bit to the region */
     fabric_bitstream.add_bit_to_region(fabric_bitstream_region, fabric_bit);
+  }
+}
 
-    /* Increase the memory index */
-    cur_mem_index[tile_coord]++;
+/********************************************************************
+ * Select the function adding the regional bits to the fabric bitstream
+ * which is specialized for the WL protocol
+ *******************************************************************/
+template <e_blwl_protocol_type BL_PROTOCOL>
+static void add_ql_memory_bank_regional_bits_to_fabric_bitstream_by_wl(
+  const BitstreamManager& bitstream_manager,
+  const ConfigProtocol& config_protocol,
+  const std::vector<QlMemoryBankRegionalBit>& regional_bits,
+  const size_t& bl_addr_size, const size_t& wl_addr_size,
+  FabricBitstream& fabric_bitstream,
+  const FabricBitRegionId& fabric_bitstream_region) {
+  switch (config_protocol.wl_protocol_type()) {
+    case BLWL_PROTOCOL_FLATTEN:
+      add_ql_memory_bank_regional_bits_to_fabric_bitstream<
+        BL_PROTOCOL, BLWL_PROTOCOL_FLATTEN>(
+        bitstream_manager, regional_bits, bl_addr_size, wl_addr_size,
+        fabric_bitstream, fabric_bitstream_region);
+      break;
+    case BLWL_PROTOCOL_DECODER:
+      add_ql_memory_bank_regional_bits_to_fabric_bitstream<
+        BL_PROTOCOL, BLWL_PROTOCOL_DECODER>(
+        bitstream_manager, regional_bits, bl_addr_size, wl_addr_size,
+        fabric_bitstream, fabric_bitstream_region);
+      break;
+    case BLWL_PROTOCOL_SHIFT_REGISTER:
+      add_ql_memory_bank_regional_bits_to_fabric_bitstream<
+        BL_PROTOCOL, BLWL_PROTOCOL_SHIFT_REGISTER>(
+        bitstream_manager, regional_bits, bl_addr_size, wl_addr_size,
+        fabric_bitstream, fabric_bitstream_region);
+      break;
+    default:
+      VTR_LOGF_ERROR(__FILE__, __LINE__, "Invalid WL protocol.\n");
+      exit(1);
+  }
+}
+
+/********************************************************************
+ * Select the function adding the regional bits to the fabric bitstream
+ * which is specialized for the BL and WL protocols
+ *******************************************************************/
+static void add_ql_memory_bank_regional_bits_to_fabric_bitstream(
+  const BitstreamManager& bitstream_manager,
+  const ConfigProtocol& config_protocol,
+  const std::vector<QlMemoryBankRegionalBit>& regional_bits,
+  const size_t& bl_addr_size, const size_t& wl_addr_size,
+  FabricBitstream& fabric_bitstream,
+  const FabricBitRegionId& fabric_bitstream_region) {
+  switch (config_protocol.bl_protocol_type()) {
+    case BLWL_PROTOCOL_FLATTEN:
+      add_ql_memory_bank_regional_bits_to_fabric_bitstream_by_wl<
+        BLWL_PROTOCOL_FLATTEN>(bitstream_manager, config_protocol,
+                               regional_bits, bl_addr_size, wl_addr_size,
+                               fabric_bitstream, fabric_bitstream_region);
+      break;
+    case BLWL_PROTOCOL_DECODER:
+      add_ql_memory_bank_regional_bits_to_fabric_bitstream_by_wl<
+        BLWL_PROTOCOL_DECODER>(bitstream_manager, config_protocol,
+                               regional_bits, bl_addr_size, wl_addr_size,
+                               fabric_bitstream, fabric_bitstream_region);
+      break;
+    case BLWL_PROTOCOL_SHIFT_REGISTER:
+      add_ql_memory_bank_regional_bits_to_fabric_bitstream_by_wl<
+        BLWL_PROTOCOL_SHIFT_REGISTER>(bitstream_manager, config_protocol,
+                                      regional_bits, bl_addr_size,
+                                      wl_addr_size, fabric_bitstream,
+                                      fabric_bitstream_region);
+      break;
+    default:
+      VTR_LOGF_ERROR(__FILE__, __LINE__, "Invalid BL protocol.\n");
+      exit(1);
   }
 }
 
 /********************************************************************
  * Main function to build a fabric-dependent bitstream
  * by considering the QuickLogic memory banks
+ * The regions are walked by up to num_threads threads
  *******************************************************************/
 void build_module_fabric_dependent_bitstream_ql_memory_bank(
   const ConfigProtocol& config_protocol, const CircuitLibrary& circuit_lib,
   const BitstreamManager& bitstream_manager, const ConfigBlockId& top_block,
   const ModuleManager& module_manager, const ModuleId& top_module,
-  FabricBitstream& fabric_bitstream) {
+  const std::vector<vtr::Rect<int>>& child_regions,
+  FabricBitstream& fabric_bitstream, const size_t& num_threads) {
   /* Ensure we are in the correct type of configuration protocol*/
   VTR_ASSERT(config_protocol.type() == CONFIG_MEM_QL_MEMORY_BANK);
 
@@ -361,17 +474,26 @@ void build_module_fabric_dependent_bitstream_ql_memory_bank(
   fabric_bitstream.set_wl_address_length(wl_addr_port_info.get_width());
   fabric_bitstream.reserve_bits(bitstream_manager.num_bits());
 
-  /* Build bitstreams by region */
+  /* Build bitstreams by region. Each region has its own BL/WLs, so that the
+   * regions are walked in parallel, while the bits are added to the fabric
+   * bitstream in the order of regions */
+  std::vector<ConfigRegionId> config_regions;
   for (const ConfigRegionId& config_region :
        module_manager.regions(top_module)) {
+    config_regions.push_back(config_region);
+  }
+  std::vector<std::vector<QlMemoryBankRegionalBit>> regional_bits(
+    config_regions.size());
+  std::vector<size_t> regional_bl_addr_sizes(config_regions.size(), 0);
+  std::vector<size_t> regional_wl_addr_sizes(config_regions.size(), 0);
+
+  parallel_for(config_regions.size(), num_threads, [&](const size_t& ireg) {
+    const ConfigRegionId& config_region = config_regions[ireg];
     /* Find port information for local BL and WL decoder in this region */
     std::vector<ModuleId> configurable_children =
       module_manager.region_configurable_children(top_module, config_region);
     VTR_ASSERT(2 <= configurable_children.size());
 
-    /* Build the bitstream for all the blocks in this region */
-    FabricBitRegionId fabric_bitstream_region = fabric_bitstream.add_region();
-
     /* Find the BL/WL port (different region may have different sizes of BL/WLs)
      */
     ModulePortId cur_bl_addr_port;
@@ -449,13 +571,25 @@ void build_module_fabric_dependent_bitstream_ql_memory_bank(
     size_t temp_num_bls_cur_tile = 0;
     size_t temp_num_wls_cur_tile = 0;
 
+    regional_bl_addr_sizes[ireg] = cur_bl_addr_port_info.get_width();
+    regional_wl_addr_sizes[ireg] = cur_wl_addr_port_info.get_width();
     rec_build_module_fabric_dependent_ql_memory_bank_regional_bitstream(
       bitstream_manager, top_block, module_manager, top_module, top_module,
       config_region, config_protocol, circuit_lib,
-      config_protocol.memory_model(), cur_bl_addr_port_info.get_width(),
-      cur_wl_addr_port_info.get_width(), temp_num_bls_cur_tile,
+      config_protocol.memory_model(), temp_num_bls_cur_tile,
       bl_start_index_per_tile, temp_num_wls_cur_tile, wl_start_index_per_tile,
-      temp_coord, cur_mem_index, fabric_bitstream, fabric_bitstream_region);
+      temp_coord, cur_mem_index, child_regions, regional_bits[ireg]);
+  });
+
+  for (size_t ireg = 0; ireg < config_regions.size(); ++ireg) {
+    /* Build the bitstream for all the blocks in this region */
+    FabricBitRegionId fabric_bitstream_region = fabric_bitstream.add_region();
+    add_ql_memory_bank_regional_bits_to_fabric_bitstream(
+      bitstream_manager, config_protocol, regional_bits[ireg],
+      regional_bl_addr_sizes[ireg], regional_wl_addr_sizes[ireg],
+      fabric_bitstream, fabric_bitstream_region);
+    /* Release the bits of the region as soon as they are added */
+    std::vector<QlMemoryBankRegionalBit>().swap(regional_bits[ireg]);
   }
 }
 
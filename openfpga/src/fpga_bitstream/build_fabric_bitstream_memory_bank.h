@@ -11,6 +11,7 @@
 #include "config_protocol.h"
 #include "fabric_bitstream.h"
 #include "module_manager.h"
+#include "vtr_geometry.h"
 
 /********************************************************************
  * Function declaration
@@ -23,7 +24,8 @@ void build_module_fabric_dependent_bitstream_ql_memory_bank(
   const ConfigProtocol& config_protocol, const CircuitLibrary& circuit_lib,
   const BitstreamManager& bitstream_manager, const ConfigBlockId& top_block,
   const ModuleManager& module_manager, const ModuleId& top_module,
-  FabricBitstream& fabric_bitstream);
+  const std::vector<vtr::Rect<int>>& child_regions,
+  FabricBitstream& fabric_bitstream, const size_t& num_threads);
 
 } /* end namespace openfpga */
 
@@ -4,6 +4,8 @@
  *******************************************************************/
 #include <cmath>
 #include <string>
+#include <unordered_map>
+#include <unordered_set>
 
 /* Headers from vtrutil library */
 #include "vtr_assert.h"
@@ -21,7 +23,10 @@
 #include "openfpga_device_grid_utils.h"
 #include "openfpga_interconnect_types.h"
 #include "openfpga_naming.h"
+#include "openfpga_parallel.h"
+#include "openfpga_progress.h"
 #include "openfpga_reserved_words.h"
+#include "openfpga_trace.h"
 #include "pb_graph_utils.h"
 #include "pb_type_utils.h"
 #include "vpr_utils.h"
@@ -46,100 +51,379 @@ static std::vector<bool> generate_mode_select_bitstream(
 }
 
 /********************************************************************
- * Generate bitstream for a primitive node and add it to bitstream manager
+ * The memory block of a configurable element in a physical block, i.e.,
+ * a LUT, a primitive with mode-select bits or a routing multiplexer
  *******************************************************************/
-static void build_primitive_bitstream(
-  BitstreamManager& bitstream_manager,
-  std::map<std::string, size_t>& grouped_mem_inst_scoreboard,
-  const ConfigBlockId& parent_configurable_block,
-  const ModuleManager& module_manager, const CircuitLibrary& circuit_lib,
-  const VprDeviceAnnotation& device_annotation, const PhysicalPb& physical_pb,
-  const PhysicalPbId& primitive_pb_id, t_pb_type* primitive_pb_type,
-  const bool& verbose) {
-  /* Ensure a valid physical pritimive pb */
-  if (nullptr == primitive_pb_type) {
-    VTR_LOGF_ERROR(__FILE__, __LINE__, "Invalid primitive_pb_type!\n");
-    exit(1);
-  }
+struct PbMemoryTemplate {
+  /* Name of the memory block, without the index given by the scoreboard */
+  std::string mem_block_name;
+  /* Width of the data output port of the memory module */
+  size_t num_mem_bits = 0;
+  /* Memory blocks under a feedthrough memory module should be indexed by the
+   * scoreboard */
+  bool feedthru_mem = false;
+  /* Bitstream of an unused LUT or primitive */
+  std::vector<bool> default_bits;
+  /* Routing multiplexers only */
+  t_interconnect* interc = nullptr;
+  CircuitModelId mux_model;
+  size_t datapath_mux_size = 0;
+};
 
+/********************************************************************
+ * All the module lookups, names of memory blocks and default bits which only
+ * depend on the pb_graph, rather than on the clustering results.
+ * Since the pb_graph of a logical block type is shared by all the grids of
+ * the same type, the template is built once and each grid only applies its
+ * nets, truth tables and mode bits on top of it
+ *******************************************************************/
+struct GridBitstreamTemplate {
+  /* Module of each physical pb_type */
+  std::unordered_map<t_pb_type*, ModuleId> pb_modules;
+  /* Memory of each LUT and primitive with mode-select bits */
+  std::unordered_map<t_pb_type*, PbMemoryTemplate> primitive_mems;
+  /* Memory of the routing multiplexer which drives a pb_graph pin */
+  std::unordered_map<t_pb_graph_pin*, PbMemoryTemplate> interc_mems;
+  /* Bitstream of the physical blocks of an unused grid, under a root block
+   * which stands for the grid block */
+  std::unordered_map<t_physical_tile_type_ptr, BitstreamManager>
+    unused_grid_bitstreams;
+};
+
+/********************************************************************
+ * Find the memory module of a LUT or a primitive with mode-select bits, as
+ * well as the bitstream of the LUT or primitive when it is unused
+ *******************************************************************/
+static void build_primitive_memory_template(
+  GridBitstreamTemplate& grid_template, const ModuleManager& module_manager,
+  const CircuitLibrary& circuit_lib,
+  const VprDeviceAnnotation& device_annotation, t_pb_type* primitive_pb_type) {
   CircuitModelId primitive_model =
     device_annotation.pb_type_circuit_model(primitive_pb_type);
   VTR_ASSERT(CircuitModelId::INVALID() != primitive_model);
-  VTR_ASSERT(
-    (CIRCUIT_MODEL_IOPAD == circuit_lib.model_type(primitive_model)) ||
-    (CIRCUIT_MODEL_HARDLOGIC == circuit_lib.model_type(primitive_model)) ||
-    (CIRCUIT_MODEL_FF == circuit_lib.model_type(primitive_model)));
 
-  /* Find SRAM ports for mode-selection */
-  std::vector<CircuitPortId> primitive_mode_select_ports =
+  std::vector<CircuitPortId> mode_select_ports =
     find_circuit_mode_select_sram_ports(circuit_lib, primitive_model);
-
   /* We may have a port for mode select or not. */
-  VTR_ASSERT((0 == primitive_mode_select_ports.size()) ||
-             (1 == primitive_mode_select_ports.size()));
-
-  /* Generate bitstream for mode-select ports */
-  if (0 == primitive_mode_select_ports.size()) {
-    return; /* Nothing to do, return directly */
+  VTR_ASSERT((0 == mode_select_ports.size()) ||
+             (1 == mode_select_ports.size()));
+
+  PbMemoryTemplate mem_template;
+  if (CIRCUIT_MODEL_LUT == circuit_lib.model_type(primitive_model)) {
+    /* An unused LUT has an empty truth table, which are full of default values
+     * (defined by users) */
+    std::vector<CircuitPortId> lut_regular_sram_ports =
+      find_circuit_regular_sram_ports(circuit_lib, primitive_model);
+    VTR_ASSERT(1 == lut_regular_sram_ports.size());
+    size_t default_value =
+      circuit_lib.port_default_value(lut_regular_sram_ports[0]);
+    VTR_ASSERT((0 == default_value) || (1 == default_value));
+    mem_template.default_bits.assign(
+      circuit_lib.port_size(lut_regular_sram_ports[0]), 1 == default_value);
+  } else if (0 == mode_select_ports.size()) {
+    /* Nothing to configure */
+    return;
   }
 
-  std::vector<bool> mode_select_bitstream;
-  if (true == physical_pb.valid_pb_id(primitive_pb_id)) {
-    mode_select_bitstream =
-      generate_mode_select_bitstream(physical_pb.mode_bits(primitive_pb_id));
-    /* If the physical pb contains fixed mode-select bitstream, overload here */
-    if (false ==
-        physical_pb.fixed_mode_select_bitstream(primitive_pb_id).empty()) {
-      std::string fixed_mode_select_bitstream =
-        physical_pb.fixed_mode_select_bitstream(primitive_pb_id);
-      size_t mode_bits_start_index =
-        physical_pb.fixed_mode_select_bitstream_offset(primitive_pb_id);
-      /* Ensure the length matches!!! */
-      if (mode_select_bitstream.size() - mode_bits_start_index <
-          fixed_mode_select_bitstream.size()) {
-        VTR_LOG_ERROR(
-          "Unmatched length of fixed mode_select_bitstream %s!Expected to be "
-          "less than %ld bits\n",
-          fixed_mode_select_bitstream.c_str(),
-          mode_select_bitstream.size() - mode_bits_start_index);
-        exit(1);
-      }
-      /* Overload the bitstream here */
-      for (size_t bit_index = 0; bit_index < fixed_mode_select_bitstream.size();
-           ++bit_index) {
-        VTR_ASSERT('0' == fixed_mode_select_bitstream[bit_index] ||
-                   '1' == fixed_mode_select_bitstream[bit_index]);
-        mode_select_bitstream[bit_index + mode_bits_start_index] =
-          ('1' == fixed_mode_select_bitstream[bit_index]);
-      }
-    }
-  } else { /* get default mode_bits */
-    mode_select_bitstream = generate_mode_select_bitstream(
+  /* An unused primitive is in its default mode */
+  if (0 != mode_select_ports.size()) {
+    std::vector<bool> mode_select_bitstream = generate_mode_select_bitstream(
       device_annotation.pb_type_mode_bits(primitive_pb_type));
+    mem_template.default_bits.insert(mem_template.default_bits.end(),
+                                     mode_select_bitstream.begin(),
+                                     mode_select_bitstream.end());
   }
 
-  /* Ensure the length of bitstream matches the side of memory circuits */
   std::vector<CircuitModelId> sram_models =
     find_circuit_sram_models(circuit_lib, primitive_model);
   VTR_ASSERT(1 == sram_models.size());
-  std::string mem_block_name =
+  mem_template.mem_block_name =
     generate_memory_module_name(circuit_lib, primitive_model, sram_models[0],
                                 std::string(MEMORY_MODULE_POSTFIX));
-  ModuleId mem_module = module_manager.find_module(mem_block_name);
-  VTR_ASSERT(true == module_manager.valid_module_id(mem_module));
+  ModuleId mem_module =
+    module_manager.find_module(mem_template.mem_block_name);
+  /* The bitstream is only required for the memory modules in the fabric */
+  if (false == module_manager.valid_module_id(mem_module)) {
+    return;
+  }
   ModulePortId mem_out_port_id = module_manager.find_module_port(
     mem_module, generate_configurable_memory_data_out_name());
-  VTR_ASSERT(
-    mode_select_bitstream.size() ==
-    module_manager.module_port(mem_module, mem_out_port_id).get_width());
+  mem_template.num_mem_bits =
+    module_manager.module_port(mem_module, mem_out_port_id).get_width();
 
   /* If there is a feedthrough module, we should consider the scoreboard */
   std::string feedthru_mem_block_name =
     generate_memory_module_name(circuit_lib, primitive_model, sram_models[0],
                                 std::string(MEMORY_MODULE_POSTFIX), true);
-  ModuleId feedthru_mem_module =
-    module_manager.find_module(feedthru_mem_block_name);
-  if (module_manager.valid_module_id(feedthru_mem_module)) {
+  mem_template.feedthru_mem = module_manager.valid_module_id(
+    module_manager.find_module(feedthru_mem_block_name));
+
+  grid_template.primitive_mems[primitive_pb_type] = mem_template;
+}
+
+/********************************************************************
+ * Find the memory module of the programmable routing multiplexer which
+ * drives a pin of a pb_graph node
+ *******************************************************************/
+static void build_pin_interc_memory_template(
+  GridBitstreamTemplate& grid_template, const ModuleManager& module_manager,
+  const ModuleNameMap& module_name_map, const CircuitLibrary& circuit_lib,
+  const VprDeviceAnnotation& device_annotation,
+  t_pb_graph_pin* des_pb_graph_pin, t_mode* physical_mode) {
+  /* Identify the number of fan-in (Consider interconnection edges of only
+   * selected mode) */
+  t_interconnect* cur_interc =
+    pb_graph_pin_interc(des_pb_graph_pin, physical_mode);
+  size_t fan_in = pb_graph_pin_inputs(des_pb_graph_pin, cur_interc).size();
+
+  if ((nullptr == cur_interc) || (0 == fan_in)) {
+    /* No interconnection matched */
+    return;
+  }
+
+  /* Identify pin interconnection type */
+  enum e_interconnect interc_type =
+    device_annotation.interconnect_physical_type(cur_interc);
+  switch (interc_type) {
+    case DIRECT_INTERC:
+      /* Nothing to do, return */
+      return;
+    case COMPLETE_INTERC:
+    case MUX_INTERC:
+      break;
+    default:
+      VTR_LOGF_ERROR(__FILE__, __LINE__,
+                     "Invalid interconnection type for %s (Arch[LINE%d])!\n",
+                     cur_interc->name, cur_interc->line_num);
+      exit(1);
+  }
+
+  PbMemoryTemplate mem_template;
+  mem_template.interc = cur_interc;
+
+  /* Find the circuit model id of the mux, we need its design technology
+   * which matters the bitstream generation */
+  mem_template.mux_model =
+    device_annotation.interconnect_circuit_model(cur_interc);
+  VTR_ASSERT(CIRCUIT_MODEL_MUX ==
+             circuit_lib.model_type(mem_template.mux_model));
+
+  /* Find the input size of the implementation of a routing multiplexer */
+  mem_template.datapath_mux_size = fan_in;
+  VTR_ASSERT(true == valid_mux_implementation_num_inputs(fan_in));
+
+  /* Name of the block denoting the memory instances that drives this node in
+   * physical_block */
+  mem_template.mem_block_name = generate_pb_memory_instance_name(
+    GRID_MEM_INSTANCE_PREFIX, des_pb_graph_pin, std::string(""));
+
+  /* Find the module in module manager */
+  std::string mem_module_name = generate_mux_subckt_name(
+    circuit_lib, mem_template.mux_model, mem_template.datapath_mux_size,
+    std::string(MEMORY_MODULE_POSTFIX));
+  mem_module_name = module_name_map.name(mem_module_name);
+  ModuleId mux_mem_module = module_manager.find_module(mem_module_name);
+  VTR_ASSERT(true == module_manager.valid_module_id(mux_mem_module));
+  ModulePortId mux_mem_out_port_id = module_manager.find_module_port(
+    mux_mem_module, generate_configurable_memory_data_out_name());
+  mem_template.num_mem_bits =
+    module_manager.module_port(mux_mem_module, mux_mem_out_port_id)
+      .get_width();
+
+  /* If there is a feedthrough module, we should consider the scoreboard */
+  std::string feedthru_mem_block_name = generate_mux_subckt_name(
+    circuit_lib, mem_template.mux_model, mem_template.datapath_mux_size,
+    std::string(MEMORY_FEEDTHROUGH_MODULE_POSTFIX));
+  if (module_name_map.name_exist(feedthru_mem_block_name)) {
+    feedthru_mem_block_name = module_name_map.name(feedthru_mem_block_name);
+  }
+  mem_template.feedthru_mem = module_manager.valid_module_id(
+    module_manager.find_module(feedthru_mem_block_name));
+
+  grid_template.interc_mems[des_pb_graph_pin] = mem_template;
+}
+
+/********************************************************************
+ * Find the memory modules of the programmable routing multiplexers which
+ * drive a given type of ports of a pb_graph node
+ *******************************************************************/
+static void build_pb_port_interc_memory_templates(
+  GridBitstreamTemplate& grid_template, const ModuleManager& module_manager,
+  const ModuleNameMap& module_name_map, const CircuitLibrary& circuit_lib,
+  const VprDeviceAnnotation& device_annotation,
+  t_pb_graph_node* physical_pb_graph_node,
+  const e_circuit_pb_port_type& pb_port_type, t_mode* physical_mode) {
+  switch (pb_port_type) {
+    case CIRCUIT_PB_PORT_INPUT:
+      for (int iport = 0; iport < physical_pb_graph_node->num_input_ports;
+           ++iport) {
+        for (int ipin = 0; ipin < physical_pb_graph_node->num_input_pins[iport];
+             ++ipin) {
+          build_pin_interc_memory_template(
+            grid_template, module_manager, module_name_map, circuit_lib,
+            device_annotation,
+            &(physical_pb_graph_node->input_pins[iport][ipin]), physical_mode);
+        }
+      }
+      break;
+    case CIRCUIT_PB_PORT_OUTPUT:
+      for (int iport = 0; iport < physical_pb_graph_node->num_output_ports;
+           ++iport) {
+        for (int ipin = 0;
+             ipin < physical_pb_graph_node->num_output_pins[iport]; ++ipin) {
+          build_pin_interc_memory_template(
+            grid_template, module_manager, module_name_map, circuit_lib,
+            device_annotation,
+            &(physical_pb_graph_node->output_pins[iport][ipin]), physical_mode);
+        }
+      }
+      break;
+    case CIRCUIT_PB_PORT_CLOCK:
+      for (int iport = 0; iport < physical_pb_graph_node->num_clock_ports;
+           ++iport) {
+        for (int ipin = 0; ipin < physical_pb_graph_node->num_clock_pins[iport];
+             ++ipin) {
+          build_pin_interc_memory_template(
+            grid_template, module_manager, module_name_map, circuit_lib,
+            device_annotation,
+            &(physical_pb_graph_node->clock_pins[iport][ipin]), physical_mode);
+        }
+      }
+      break;
+    default:
+      VTR_LOGF_ERROR(__FILE__, __LINE__, "Invalid pb port type!\n");
+      exit(1);
+  }
+}
+
+/********************************************************************
+ * Visit a pb_graph in the same sequence as rec_build_physical_block_bitstream()
+ * and record the modules and memories of each physical block
+ *******************************************************************/
+static void rec_build_grid_bitstream_template(
+  GridBitstreamTemplate& grid_template, const ModuleManager& module_manager,
+  const ModuleNameMap& module_name_map, const CircuitLibrary& circuit_lib,
+  const VprDeviceAnnotation& device_annotation,
+  t_pb_graph_node* physical_pb_graph_node) {
+  /* Get the physical pb_type that is linked to the pb_graph node */
+  t_pb_type* physical_pb_type = physical_pb_graph_node->pb_type;
+
+  /* Find the mode that define_idle_mode*/
+  t_mode* physical_mode = device_annotation.physical_mode(physical_pb_type);
+
+  if (0 == grid_template.pb_modules.count(physical_pb_type)) {
+    std::string pb_module_name =
+      generate_physical_block_module_name(physical_pb_type);
+    pb_module_name = module_name_map.name(pb_module_name);
+    ModuleId pb_module = module_manager.find_module(pb_module_name);
+    VTR_ASSERT(true == module_manager.valid_module_id(pb_module));
+    grid_template.pb_modules[physical_pb_type] = pb_module;
+  }
+
+  /* Skip module with no configurable children */
+  if (0 == module_manager.num_configurable_children(
+             grid_template.pb_modules.at(physical_pb_type),
+             ModuleManager::e_config_child_type::LOGICAL)) {
+    return;
+  }
+
+  if (true == is_primitive_pb_type(physical_pb_type)) {
+    if (0 == grid_template.primitive_mems.count(physical_pb_type)) {
+      build_primitive_memory_template(grid_template, module_manager,
+                                      circuit_lib, device_annotation,
+                                      physical_pb_type);
+    }
+    return;
+  }
+
+  for (int ipb = 0; ipb < physical_mode->num_pb_type_children; ++ipb) {
+    for (int jpb = 0; jpb < physical_mode->pb_type_children[ipb].num_pb;
+         ++jpb) {
+      t_pb_graph_node* child_pb_graph_node =
+        &(physical_pb_graph_node
+            ->child_pb_graph_nodes[physical_mode->index][ipb][jpb]);
+      rec_build_grid_bitstream_template(grid_template, module_manager,
+                                        module_name_map, circuit_lib,
+                                        device_annotation, child_pb_graph_node);
+    }
+  }
+
+  /* Routing multiplexers driving the outputs of the pb_graph node and the
+   * inputs of its children, see build_physical_block_interc_bitstream() */
+  build_pb_port_interc_memory_templates(
+    grid_template, module_manager, module_name_map, circuit_lib,
+    device_annotation, physical_pb_graph_node, CIRCUIT_PB_PORT_OUTPUT,
+    physical_mode);
+  for (int ipb = 0; ipb < physical_mode->num_pb_type_children; ipb++) {
+    for (int jpb = 0; jpb < physical_mode->pb_type_children[ipb].num_pb;
+         jpb++) {
+      t_pb_graph_node* child_pb_graph_node =
+        &(physical_pb_graph_node
+            ->child_pb_graph_nodes[physical_mode->index][ipb][jpb]);
+      build_pb_port_interc_memory_templates(
+        grid_template, module_manager, module_name_map, circuit_lib,
+        device_annotation, child_pb_graph_node, CIRCUIT_PB_PORT_INPUT,
+        physical_mode);
+      build_pb_port_interc_memory_templates(
+        grid_template, module_manager, module_name_map, circuit_lib,
+        device_annotation, child_pb_graph_node, CIRCUIT_PB_PORT_CLOCK,
+        physical_mode);
+    }
+  }
+}
+
+/********************************************************************
+ * Build the bitstream template of all the pb_graphs used by the grids
+ *******************************************************************/
+static GridBitstreamTemplate build_grid_bitstream_template(
+  const ModuleManager& module_manager, const ModuleNameMap& module_name_map,
+  const CircuitLibrary& circuit_lib,
+  const VprDeviceAnnotation& device_annotation, const DeviceGrid& grids,
+  const size_t& layer) {
+  GridBitstreamTemplate grid_template;
+
+  std::unordered_set<t_physical_tile_type_ptr> visited_grid_types;
+  for (size_t ix = 0; ix < grids.width(); ++ix) {
+    for (size_t iy = 0; iy < grids.height(); ++iy) {
+      t_physical_tile_type_ptr grid_type =
+        grids.get_physical_type(t_physical_tile_loc(ix, iy, layer));
+      if (false == visited_grid_types.insert(grid_type).second) {
+        continue;
+      }
+      for (const t_sub_tile& sub_tile : grid_type->sub_tiles) {
+        for (t_logical_block_type_ptr lb_type : sub_tile.equivalent_sites) {
+          /* Bypass empty pb_graph */
+          if (nullptr == lb_type->pb_graph_head) {
+            continue;
+          }
+          rec_build_grid_bitstream_template(
+            grid_template, module_manager, module_name_map, circuit_lib,
+            device_annotation, lb_type->pb_graph_head);
+        }
+      }
+    }
+  }
+
+  return grid_template;
+}
+
+/********************************************************************
+ * Add a memory block with a given number of bits to the bitstream manager
+ * The bits are added by the caller.
+ * Memory blocks under a feedthrough memory module are indexed by the
+ * scoreboard
+ *******************************************************************/
+static ConfigBlockId add_pb_memory_block(
+  BitstreamManager& bitstream_manager,
+  std::map<std::string, size_t>& grouped_mem_inst_scoreboard,
+  const ConfigBlockId& parent_configurable_block,
+  const PbMemoryTemplate& mem_template, const size_t& num_mem_bits,
+  const bool& verbose) {
+  /* Ensure the length of bitstream matches the side of memory circuits */
+  VTR_ASSERT(num_mem_bits == mem_template.num_mem_bits);
+
+  std::string mem_block_name = mem_template.mem_block_name;
+  if (true == mem_template.feedthru_mem) {
     auto result = grouped_mem_inst_scoreboard.find(mem_block_name);
     if (result == grouped_mem_inst_scoreboard.end()) {
       /* Update scoreboard */
@@ -151,18 +435,109 @@ static void build_primitive_bitstream(
     }
   }
 
-  /* Create a block for the bitstream which corresponds to the memory module
-   * associated to the LUT */
   ConfigBlockId mem_block = bitstream_manager.add_block(mem_block_name);
   bitstream_manager.add_child_block(parent_configurable_block, mem_block);
 
-  VTR_LOGV(verbose, "Added %lu bits to '%s' under '%s'\n",
-           mode_select_bitstream.size(),
+  VTR_LOGV(verbose, "Added %lu bits to '%s' under '%s'\n", num_mem_bits,
            bitstream_manager.block_name(mem_block).c_str(),
            bitstream_manager.block_name(parent_configurable_block).c_str());
 
+  return mem_block;
+}
+
+/********************************************************************
+ * Add the bitstream of a memory block to the bitstream manager
+ *******************************************************************/
+static ConfigBlockId add_pb_memory_block_bitstream(
+  BitstreamManager& bitstream_manager,
+  std::map<std::string, size_t>& grouped_mem_inst_scoreboard,
+  const ConfigBlockId& parent_configurable_block,
+  const PbMemoryTemplate& mem_template, const std::vector<bool>& mem_bitstream,
+  const bool& verbose) {
+  ConfigBlockId mem_block = add_pb_memory_block(
+    bitstream_manager, grouped_mem_inst_scoreboard, parent_configurable_block,
+    mem_template, mem_bitstream.size(), verbose);
+
   /* Add the bitstream to the bitstream manager */
-  bitstream_manager.add_block_bits(mem_block, mode_select_bitstream);
+  bitstream_manager.add_block_bits(mem_block, mem_bitstream);
+
+  return mem_block;
+}
+
+/********************************************************************
+ * Generate bitstream for a primitive node and add it to bitstream manager
+ *******************************************************************/
+static void build_primitive_bitstream(
+  BitstreamManager& bitstream_manager,
+  std::map<std::string, size_t>& grouped_mem_inst_scoreboard,
+  const ConfigBlockId& parent_configurable_block,
+  const GridBitstreamTemplate& grid_template, const CircuitLibrary& circuit_lib,
+  const VprDeviceAnnotation& device_annotation, const PhysicalPb& physical_pb,
+  const PhysicalPbId& primitive_pb_id, t_pb_type* primitive_pb_type,
+  const bool& verbose) {
+  /* Ensure a valid physical pritimive pb */
+  if (nullptr == primitive_pb_type) {
+    VTR_LOGF_ERROR(__FILE__, __LINE__, "Invalid primitive_pb_type!\n");
+    exit(1);
+  }
+
+  CircuitModelId primitive_model =
+    device_annotation.pb_type_circuit_model(primitive_pb_type);
+  VTR_ASSERT(CircuitModelId::INVALID() != primitive_model);
+  VTR_ASSERT(
+    (CIRCUIT_MODEL_IOPAD == circuit_lib.model_type(primitive_model)) ||
+    (CIRCUIT_MODEL_HARDLOGIC == circuit_lib.model_type(primitive_model)) ||
+    (CIRCUIT_MODEL_FF == circuit_lib.model_type(primitive_model)));
+
+  /* Generate bitstream for mode-select ports */
+  if (true == find_circuit_mode_select_sram_ports(circuit_lib, primitive_model)
+                .empty()) {
+    return; /* Nothing to do, return directly */
+  }
+
+  auto mem_template = grid_template.primitive_mems.find(primitive_pb_type);
+  VTR_ASSERT(mem_template != grid_template.primitive_mems.end());
+
+  /* Unused primitives are in their default mode */
+  if (false == physical_pb.valid_pb_id(primitive_pb_id)) {
+    add_pb_memory_block_bitstream(
+      bitstream_manager, grouped_mem_inst_scoreboard, parent_configurable_block,
+      mem_template->second, mem_template->second.default_bits, verbose);
+    return;
+  }
+
+  std::vector<bool> mode_select_bitstream =
+    generate_mode_select_bitstream(physical_pb.mode_bits(primitive_pb_id));
+  /* If the physical pb contains fixed mode-select bitstream, overload here */
+  if (false ==
+      physical_pb.fixed_mode_select_bitstream(primitive_pb_id).empty()) {
+    std::string fixed_mode_select_bitstream =
+      physical_pb.fixed_mode_select_bitstream(primitive_pb_id);
+    size_t mode_bits_start_index =
+      physical_pb.fixed_mode_select_bitstream_offset(primitive_pb_id);
+    /* Ensure the length matches!!! */
+    if (mode_select_bitstream.size() - mode_bits_start_index <
+        fixed_mode_select_bitstream.size()) {
+      VTR_LOG_ERROR(
+        "Unmatched length of fixed mode_select_bitstream %s!Expected to be "
+        "less than %ld bits\n",
+        fixed_mode_select_bitstream.c_str(),
+        mode_select_bitstream.size() - mode_bits_start_index);
+      exit(1);
+    }
+    /* Overload the bitstream here */
+    for (size_t bit_index = 0; bit_index < fixed_mode_select_bitstream.size();
+         ++bit_index) {
+      VTR_ASSERT('0' == fixed_mode_select_bitstream[bit_index] ||
+                 '1' == fixed_mode_select_bitstream[bit_index]);
+      mode_select_bitstream[bit_index + mode_bits_start_index] =
+        ('1' == fixed_mode_select_bitstream[bit_index]);
+    }
+  }
+
+  add_pb_memory_block_bitstream(
+    bitstream_manager, grouped_mem_inst_scoreboard, parent_configurable_block,
+    mem_template->second, mode_select_bitstream, verbose);
 }
 
 /********************************************************************
@@ -180,195 +555,114 @@ static void build_physical_block_pin_interc_bitstream(
   BitstreamManager& bitstream_manager,
   std::map<std::string, size_t>& grouped_mem_inst_scoreboard,
   const ConfigBlockId& parent_configurable_block,
-  const ModuleManager& module_manager, const ModuleNameMap& module_name_map,
-  const CircuitLibrary& circuit_lib, const MuxLibrary& mux_lib,
-  const AtomContext& atom_ctx, const VprDeviceAnnotation& device_annotation,
+  const GridBitstreamTemplate& grid_template, const MuxLibrary& mux_lib,
+  const CircuitLibrary& circuit_lib, const AtomContext& atom_ctx,
   const VprBitstreamAnnotation& bitstream_annotation,
   const PhysicalPb& physical_pb, t_pb_graph_pin* des_pb_graph_pin,
-  t_mode* physical_mode, const bool& verbose) {
-  /* Identify the number of fan-in (Consider interconnection edges of only
-   * selected mode) */
-  t_interconnect* cur_interc =
-    pb_graph_pin_interc(des_pb_graph_pin, physical_mode);
-  size_t fan_in = pb_graph_pin_inputs(des_pb_graph_pin, cur_interc).size();
-
-  if ((nullptr == cur_interc) || (0 == fan_in)) {
-    /* No interconnection matched */
+  const bool& verbose) {
+  /* Pins which are not driven by any routing multiplexer have no memory */
+  auto mem_template = grid_template.interc_mems.find(des_pb_graph_pin);
+  if (mem_template == grid_template.interc_mems.end()) {
     return;
   }
+  t_interconnect* cur_interc = mem_template->second.interc;
+  size_t fan_in = mem_template->second.datapath_mux_size;
+
+  /* Cache input and output nets */
+  std::vector<AtomNetId> input_nets;
+  AtomNetId output_net = AtomNetId::INVALID();
+
+  /* Find the path id:
+   * - if des pb is not valid, this is an unmapped pb, we can set a default
+   * path_id
+   * - There is no net mapped to des_pb_graph_pin we use default path id
+   * - There is a net mapped to des_pin_graph_pin: we find the path id
+   */
+  const PhysicalPbId& des_pb_id =
+    physical_pb.find_pb(des_pb_graph_pin->parent_node);
+  size_t mux_input_pin_id = 0;
+  if (true != physical_pb.valid_pb_id(des_pb_id)) {
+    mux_input_pin_id = DEFAULT_PATH_ID;
+  } else if (AtomNetId::INVALID() ==
+             physical_pb.pb_graph_pin_atom_net(des_pb_id, des_pb_graph_pin)) {
+    mux_input_pin_id = DEFAULT_PATH_ID;
+  } else {
+    output_net = physical_pb.pb_graph_pin_atom_net(des_pb_id, des_pb_graph_pin);
+
+    for (t_pb_graph_pin* src_pb_graph_pin :
+         pb_graph_pin_inputs(des_pb_graph_pin, cur_interc)) {
+      const PhysicalPbId& src_pb_id =
+        physical_pb.find_pb(src_pb_graph_pin->parent_node);
+      input_nets.push_back(
+        physical_pb.pb_graph_pin_atom_net(src_pb_id, src_pb_graph_pin));
+    }
 
-  /* Identify pin interconnection type */
-  enum e_interconnect interc_type =
-    device_annotation.interconnect_physical_type(cur_interc);
-  switch (interc_type) {
-    case DIRECT_INTERC:
-      /* Nothing to do, return */
-      break;
-    case COMPLETE_INTERC:
-    case MUX_INTERC: {
-      /* Find the circuit model id of the mux, we need its design technology
-       * which matters the bitstream generation */
-      CircuitModelId mux_model =
-        device_annotation.interconnect_circuit_model(cur_interc);
-      VTR_ASSERT(CIRCUIT_MODEL_MUX == circuit_lib.model_type(mux_model));
-
-      /* Find the input size of the implementation of a routing multiplexer */
-      size_t datapath_mux_size = fan_in;
-      VTR_ASSERT(true ==
-                 valid_mux_implementation_num_inputs(datapath_mux_size));
-
-      /* Cache input and output nets */
-      std::vector<AtomNetId> input_nets;
-      AtomNetId output_net = AtomNetId::INVALID();
-
-      /* Find the path id:
-       * - if des pb is not valid, this is an unmapped pb, we can set a default
-       * path_id
-       * - There is no net mapped to des_pb_graph_pin we use default path id
-       * - There is a net mapped to des_pin_graph_pin: we find the path id
-       */
-      const PhysicalPbId& des_pb_id =
-        physical_pb.find_pb(des_pb_graph_pin->parent_node);
-      size_t mux_input_pin_id = 0;
-      if (true != physical_pb.valid_pb_id(des_pb_id)) {
-        mux_input_pin_id = DEFAULT_PATH_ID;
-      } else if (AtomNetId::INVALID() == physical_pb.pb_graph_pin_atom_net(
-                                           des_pb_id, des_pb_graph_pin)) {
-        mux_input_pin_id = DEFAULT_PATH_ID;
-      } else {
-        output_net =
-          physical_pb.pb_graph_pin_atom_net(des_pb_id, des_pb_graph_pin);
-
-        for (t_pb_graph_pin* src_pb_graph_pin :
-             pb_graph_pin_inputs(des_pb_graph_pin, cur_interc)) {
-          const PhysicalPbId& src_pb_id =
-            physical_pb.find_pb(src_pb_graph_pin->parent_node);
-          input_nets.push_back(
-            physical_pb.pb_graph_pin_atom_net(src_pb_id, src_pb_graph_pin));
-        }
-
-        for (t_pb_graph_pin* src_pb_graph_pin :
-             pb_graph_pin_inputs(des_pb_graph_pin, cur_interc)) {
-          const PhysicalPbId& src_pb_id =
-            physical_pb.find_pb(src_pb_graph_pin->parent_node);
-          /* If the src pb id is not valid, we bypass it */
-          if ((true == physical_pb.valid_pb_id(src_pb_id)) &&
-              (AtomNetId::INVALID() != output_net) &&
-              (physical_pb.pb_graph_pin_atom_net(src_pb_id, src_pb_graph_pin) ==
-               output_net)) {
-            break;
-          }
-          mux_input_pin_id++;
-        }
-        VTR_ASSERT(mux_input_pin_id <= fan_in);
-        /* Unmapped pin, use default path id */
-        if (fan_in == mux_input_pin_id) {
-          mux_input_pin_id = DEFAULT_PATH_ID;
-        }
-      }
-
-      /* Overwrite the default path if defined in bitstream annotation */
-      if ((size_t(DEFAULT_PATH_ID) == mux_input_pin_id) &&
-          (mux_input_pin_id !=
-           bitstream_annotation.interconnect_default_path_id(cur_interc))) {
-        mux_input_pin_id =
-          bitstream_annotation.interconnect_default_path_id(cur_interc);
+    for (t_pb_graph_pin* src_pb_graph_pin :
+         pb_graph_pin_inputs(des_pb_graph_pin, cur_interc)) {
+      const PhysicalPbId& src_pb_id =
+        physical_pb.find_pb(src_pb_graph_pin->parent_node);
+      /* If the src pb id is not valid, we bypass it */
+      if ((true == physical_pb.valid_pb_id(src_pb_id)) &&
+          (AtomNetId::INVALID() != output_net) &&
+          (physical_pb.pb_graph_pin_atom_net(src_pb_id, src_pb_graph_pin) ==
+           output_net)) {
+        break;
       }
+      mux_input_pin_id++;
+    }
+    VTR_ASSERT(mux_input_pin_id <= fan_in);
+    /* Unmapped pin, use default path id */
+    if (fan_in == mux_input_pin_id) {
+      mux_input_pin_id = DEFAULT_PATH_ID;
+    }
+  }
 
-      /* Generate bitstream depend on both technology and structure of this MUX
-       */
-      std::vector<bool> mux_bitstream = build_mux_bitstream(
-        circuit_lib, mux_model, mux_lib, datapath_mux_size, mux_input_pin_id);
-
-      /* Create the block denoting the memory instances that drives this node in
-       * physical_block */
-      std::string mem_block_name = generate_pb_memory_instance_name(
-        GRID_MEM_INSTANCE_PREFIX, des_pb_graph_pin, std::string(""));
-
-      /* Find the module in module manager and ensure the bitstream size
-       * matches! */
-      std::string mem_module_name =
-        generate_mux_subckt_name(circuit_lib, mux_model, datapath_mux_size,
-                                 std::string(MEMORY_MODULE_POSTFIX));
-      mem_module_name = module_name_map.name(mem_module_name);
-      ModuleId mux_mem_module = module_manager.find_module(mem_module_name);
-      VTR_ASSERT(true == module_manager.valid_module_id(mux_mem_module));
-      ModulePortId mux_mem_out_port_id = module_manager.find_module_port(
-        mux_mem_module, generate_configurable_memory_data_out_name());
-      VTR_ASSERT(mux_bitstream.size() ==
-                 module_manager.module_port(mux_mem_module, mux_mem_out_port_id)
-                   .get_width());
-
-      /* If there is a feedthrough module, we should consider the scoreboard */
-      std::string feedthru_mem_block_name = generate_mux_subckt_name(
-        circuit_lib, mux_model, datapath_mux_size,
-        std::string(MEMORY_FEEDTHROUGH_MODULE_POSTFIX));
-      if (module_name_map.name_exist(feedthru_mem_block_name)) {
-        feedthru_mem_block_name = module_name_map.name(feedthru_mem_block_name);
-      }
-      ModuleId feedthru_mem_module =
-        module_manager.find_module(feedthru_mem_block_name);
-      if (module_manager.valid_module_id(feedthru_mem_module)) {
-        auto result = grouped_mem_inst_scoreboard.find(mem_block_name);
-        if (result == grouped_mem_inst_scoreboard.end()) {
-          /* Update scoreboard */
-          grouped_mem_inst_scoreboard[mem_block_name] = 0;
-        } else {
-          grouped_mem_inst_scoreboard[mem_block_name]++;
-          mem_block_name = generate_instance_name(
-            mem_block_name, grouped_mem_inst_scoreboard[mem_block_name]);
-        }
-      }
-      ConfigBlockId mux_mem_block = bitstream_manager.add_block(mem_block_name);
-      bitstream_manager.add_child_block(parent_configurable_block,
-                                        mux_mem_block);
-
-      VTR_LOGV(verbose, "Added %lu bits to '%s' under '%s'\n",
-               mux_bitstream.size(),
-               bitstream_manager.block_name(mux_mem_block).c_str(),
-               bitstream_manager.block_name(parent_configurable_block).c_str());
-
-      /* Add the bistream to the bitstream manager */
-      bitstream_manager.add_block_bits(mux_mem_block, mux_bitstream);
-      /* Record path ids, input and output nets */
-      bitstream_manager.add_path_id_to_block(mux_mem_block, mux_input_pin_id);
-
-      /* Add input nets */
-      std::string input_net_ids;
-
-      bool need_splitter = false;
-      for (const AtomNetId& input_net : input_nets) {
-        /* Add a space as a splitter*/
-        if (true == need_splitter) {
-          input_net_ids += std::string(" ");
-        }
-        if (true == atom_ctx.nlist.valid_net_id(input_net)) {
-          input_net_ids += atom_ctx.nlist.net_name(input_net);
-        } else {
-          input_net_ids += std::string("unmapped");
-        }
-        need_splitter = true;
-      }
-      bitstream_manager.add_input_net_id_to_block(mux_mem_block, input_net_ids);
+  /* Overwrite the default path if defined in bitstream annotation, which is
+   * the default path itself otherwise */
+  if (size_t(DEFAULT_PATH_ID) == mux_input_pin_id) {
+    mux_input_pin_id =
+      bitstream_annotation.interconnect_default_path_id(cur_interc);
+  }
 
-      /* Add output nets */
-      std::string output_net_ids;
-      if (true == atom_ctx.nlist.valid_net_id(output_net)) {
-        output_net_ids += atom_ctx.nlist.net_name(output_net);
-      } else {
-        output_net_ids += std::string("unmapped");
-      }
-      bitstream_manager.add_output_net_id_to_block(mux_mem_block,
-                                                   output_net_ids);
+  /* Generate bitstream depend on both technology and structure of this MUX */
+  std::vector<bool> mux_bitstream = build_mux_bitstream(
+    circuit_lib, mem_template->second.mux_model, mux_lib,
+    mem_template->second.datapath_mux_size, mux_input_pin_id);
 
-      break;
+  /* Create the block denoting the memory instances that drives this node in
+   * physical_block */
+  ConfigBlockId mux_mem_block = add_pb_memory_block_bitstream(
+    bitstream_manager, grouped_mem_inst_scoreboard, parent_configurable_block,
+    mem_template->second, mux_bitstream, verbose);
+  /* Record path ids, input and output nets */
+  bitstream_manager.add_path_id_to_block(mux_mem_block, mux_input_pin_id);
+
+  /* Add input nets */
+  std::string input_net_ids;
+
+  bool need_splitter = false;
+  for (const AtomNetId& input_net : input_nets) {
+    /* Add a space as a splitter*/
+    if (true == need_splitter) {
+      input_net_ids += std::string(" ");
     }
-    default:
-      VTR_LOGF_ERROR(__FILE__, __LINE__,
-                     "Invalid interconnection type for %s (Arch[LINE%d])!\n",
-                     cur_interc->name, cur_interc->line_num);
-      exit(1);
+    if (true == atom_ctx.nlist.valid_net_id(input_net)) {
+      input_net_ids += atom_ctx.nlist.net_name(input_net);
+    } else {
+      input_net_ids += std::string("unmapped");
+    }
+    need_splitter = true;
   }
+  bitstream_manager.add_input_net_id_to_block(mux_mem_block, input_net_ids);
+
+  /* Add output nets */
+  std::string output_net_ids;
+  if (true == atom_ctx.nlist.valid_net_id(output_net)) {
+    output_net_ids += atom_ctx.nlist.net_name(output_net);
+  } else {
+    output_net_ids += std::string("unmapped");
+  }
+  bitstream_manager.add_output_net_id_to_block(mux_mem_block, output_net_ids);
 }
 
 /********************************************************************
@@ -379,13 +673,11 @@ static void build_physical_block_interc_port_bitstream(
   BitstreamManager& bitstream_manager,
   std::map<std::string, size_t>& grouped_mem_inst_scoreboard,
   const ConfigBlockId& parent_configurable_block,
-  const ModuleManager& module_manager, const ModuleNameMap& module_name_map,
-  const CircuitLibrary& circuit_lib, const MuxLibrary& mux_lib,
-  const AtomContext& atom_ctx, const VprDeviceAnnotation& device_annotation,
+  const GridBitstreamTemplate& grid_template, const MuxLibrary& mux_lib,
+  const CircuitLibrary& circuit_lib, const AtomContext& atom_ctx,
   const VprBitstreamAnnotation& bitstream_annotation,
   t_pb_graph_node* physical_pb_graph_node, const PhysicalPb& physical_pb,
-  const e_circuit_pb_port_type& pb_port_type, t_mode* physical_mode,
-  const bool& verbose) {
+  const e_circuit_pb_port_type& pb_port_type, const bool& verbose) {
   switch (pb_port_type) {
     case CIRCUIT_PB_PORT_INPUT:
       for (int iport = 0; iport < physical_pb_graph_node->num_input_ports;
@@ -394,11 +686,9 @@ static void build_physical_block_interc_port_bitstream(
              ++ipin) {
           build_physical_block_pin_interc_bitstream(
             bitstream_manager, grouped_mem_inst_scoreboard,
-            parent_configurable_block, module_manager, module_name_map,
-            circuit_lib, mux_lib, atom_ctx, device_annotation,
-            bitstream_annotation, physical_pb,
-            &(physical_pb_graph_node->input_pins[iport][ipin]), physical_mode,
-            verbose);
+            parent_configurable_block, grid_template, mux_lib, circuit_lib,
+            atom_ctx, bitstream_annotation, physical_pb,
+            &(physical_pb_graph_node->input_pins[iport][ipin]), verbose);
         }
       }
       break;
@@ -409,11 +699,9 @@ static void build_physical_block_interc_port_bitstream(
              ipin < physical_pb_graph_node->num_output_pins[iport]; ++ipin) {
           build_physical_block_pin_interc_bitstream(
             bitstream_manager, grouped_mem_inst_scoreboard,
-            parent_configurable_block, module_manager, module_name_map,
-            circuit_lib, mux_lib, atom_ctx, device_annotation,
-            bitstream_annotation, physical_pb,
-            &(physical_pb_graph_node->output_pins[iport][ipin]), physical_mode,
-            verbose);
+            parent_configurable_block, grid_template, mux_lib, circuit_lib,
+            atom_ctx, bitstream_annotation, physical_pb,
+            &(physical_pb_graph_node->output_pins[iport][ipin]), verbose);
         }
       }
       break;
@@ -424,11 +712,9 @@ static void build_physical_block_interc_port_bitstream(
              ++ipin) {
           build_physical_block_pin_interc_bitstream(
             bitstream_manager, grouped_mem_inst_scoreboard,
-            parent_configurable_block, module_manager, module_name_map,
-            circuit_lib, mux_lib, atom_ctx, device_annotation,
-            bitstream_annotation, physical_pb,
-            &(physical_pb_graph_node->clock_pins[iport][ipin]), physical_mode,
-            verbose);
+            parent_configurable_block, grid_template, mux_lib, circuit_lib,
+            atom_ctx, bitstream_annotation, physical_pb,
+            &(physical_pb_graph_node->clock_pins[iport][ipin]), verbose);
         }
       }
       break;
@@ -446,9 +732,8 @@ static void build_physical_block_interc_bitstream(
   BitstreamManager& bitstream_manager,
   std::map<std::string, size_t>& grouped_mem_inst_scoreboard,
   const ConfigBlockId& parent_configurable_block,
-  const ModuleManager& module_manager, const ModuleNameMap& module_name_map,
-  const CircuitLibrary& circuit_lib, const MuxLibrary& mux_lib,
-  const AtomContext& atom_ctx, const VprDeviceAnnotation& device_annotation,
+  const GridBitstreamTemplate& grid_template, const MuxLibrary& mux_lib,
+  const CircuitLibrary& circuit_lib, const AtomContext& atom_ctx,
   const VprBitstreamAnnotation& bitstream_annotation,
   t_pb_graph_node* physical_pb_graph_node, const PhysicalPb& physical_pb,
   t_mode* physical_mode, const bool& verbose) {
@@ -470,9 +755,8 @@ static void build_physical_block_interc_bitstream(
    */
   build_physical_block_interc_port_bitstream(
     bitstream_manager, grouped_mem_inst_scoreboard, parent_configurable_block,
-    module_manager, module_name_map, circuit_lib, mux_lib, atom_ctx,
-    device_annotation, bitstream_annotation, physical_pb_graph_node,
-    physical_pb, CIRCUIT_PB_PORT_OUTPUT, physical_mode, verbose);
+    grid_template, mux_lib, circuit_lib, atom_ctx, bitstream_annotation,
+    physical_pb_graph_node, physical_pb, CIRCUIT_PB_PORT_OUTPUT, verbose);
 
   /* We check input_pins of child_pb_graph_node and its the input_edges
    * Iterate over the interconnections between inputs of physical_pb_graph_node
@@ -493,17 +777,15 @@ static void build_physical_block_interc_bitstream(
       /* For each child_pb_graph_node input pins*/
       build_physical_block_interc_port_bitstream(
         bitstream_manager, grouped_mem_inst_scoreboard,
-        parent_configurable_block, module_manager, module_name_map, circuit_lib,
-        mux_lib, atom_ctx, device_annotation, bitstream_annotation,
-        child_pb_graph_node, physical_pb, CIRCUIT_PB_PORT_INPUT, physical_mode,
-        verbose);
+        parent_configurable_block, grid_template, mux_lib, circuit_lib,
+        atom_ctx, bitstream_annotation, child_pb_graph_node, physical_pb,
+        CIRCUIT_PB_PORT_INPUT, verbose);
       /* For clock pins, we should do the same work */
       build_physical_block_interc_port_bitstream(
         bitstream_manager, grouped_mem_inst_scoreboard,
-        parent_configurable_block, module_manager, module_name_map, circuit_lib,
-        mux_lib, atom_ctx, device_annotation, bitstream_annotation,
-        child_pb_graph_node, physical_pb, CIRCUIT_PB_PORT_CLOCK, physical_mode,
-        verbose);
+        parent_configurable_block, grid_template, mux_lib, circuit_lib,
+        atom_ctx, bitstream_annotation, child_pb_graph_node, physical_pb,
+        CIRCUIT_PB_PORT_CLOCK, verbose);
     }
   }
 }
@@ -517,7 +799,7 @@ static void build_lut_bitstream(
   std::map<std::string, size_t>& grouped_mem_inst_scoreboard,
   const ConfigBlockId& parent_configurable_block,
   const VprDeviceAnnotation& device_annotation,
-  const ModuleManager& module_manager, const CircuitLibrary& circuit_lib,
+  const GridBitstreamTemplate& grid_template, const CircuitLibrary& circuit_lib,
   const MuxLibrary& mux_lib, const PhysicalPb& physical_pb,
   const PhysicalPbId& lut_pb_id, t_pb_type* lut_pb_type, const bool& verbose) {
   /* Ensure a valid physical pritimive pb */
@@ -531,6 +813,18 @@ static void build_lut_bitstream(
   VTR_ASSERT(CircuitModelId::INVALID() != lut_model);
   VTR_ASSERT(CIRCUIT_MODEL_LUT == circuit_lib.model_type(lut_model));
 
+  auto mem_template = grid_template.primitive_mems.find(lut_pb_type);
+  VTR_ASSERT(mem_template != grid_template.primitive_mems.end());
+
+  /* An empty pb means that this is an unused LUT, whose truth table and
+   * mode-select bits are all in default values */
+  if (false == physical_pb.valid_pb_id(lut_pb_id)) {
+    add_pb_memory_block_bitstream(
+      bitstream_manager, grouped_mem_inst_scoreboard, parent_configurable_block,
+      mem_template->second, mem_template->second.default_bits, verbose);
+    return;
+  }
+
   /* Find the input ports for LUT size, this is used to decode the LUT memory
    * bits! */
   std::vector<CircuitPortId> model_input_ports =
@@ -550,145 +844,93 @@ static void build_lut_bitstream(
   VTR_ASSERT((0 == lut_mode_select_ports.size()) ||
              (1 == lut_mode_select_ports.size()));
 
+  /* Find MUX graph correlated to the LUT */
+  MuxId lut_mux_id = mux_lib.mux_graph(lut_model, (size_t)pow(2., lut_size));
+  const MuxGraph& mux_graph = mux_lib.mux_graph(lut_mux_id);
+  /* Ensure the LUT MUX has the expected input and SRAM port sizes */
+  VTR_ASSERT(mux_graph.num_memory_bits() == lut_size);
+  VTR_ASSERT(mux_graph.num_inputs() == (size_t)pow(2., lut_size));
+  /* Generate LUT bitstream. The packed bits are added to the bitstream
+   * manager directly, unless they are overloaded by a fixed bitstream */
+  size_t num_lut_bits = mux_graph.num_inputs();
+  std::vector<uint64_t> lut_bitstream_words;
   std::vector<bool> lut_bitstream;
-  /* Generate bitstream for the LUT */
-  if (false == physical_pb.valid_pb_id(lut_pb_id)) {
-    /* An empty pb means that this is an unused LUT,
-     * we give an empty truth table, which are full of default values (defined
-     * by users)
-     */
-    for (size_t i = 0; i < circuit_lib.port_size(lut_regular_sram_ports[0]);
-         ++i) {
-      VTR_ASSERT(
-        (0 == circuit_lib.port_default_value(lut_regular_sram_ports[0])) ||
-        (1 == circuit_lib.port_default_value(lut_regular_sram_ports[0])));
-      lut_bitstream.push_back(
-        1 == circuit_lib.port_default_value(lut_regular_sram_ports[0]));
-    }
+  if (true == physical_pb.fixed_bitstream(lut_pb_id).empty()) {
+    build_frac_lut_bitstream(
+      lut_bitstream_words, circuit_lib, mux_graph, device_annotation,
+      physical_pb.truth_tables(lut_pb_id),
+      circuit_lib.port_default_value(lut_regular_sram_ports[0]));
   } else {
-    VTR_ASSERT(true == physical_pb.valid_pb_id(lut_pb_id));
-
-    /* Find MUX graph correlated to the LUT */
-    MuxId lut_mux_id = mux_lib.mux_graph(lut_model, (size_t)pow(2., lut_size));
-    const MuxGraph& mux_graph = mux_lib.mux_graph(lut_mux_id);
-    /* Ensure the LUT MUX has the expected input and SRAM port sizes */
-    VTR_ASSERT(mux_graph.num_memory_bits() == lut_size);
-    VTR_ASSERT(mux_graph.num_inputs() == (size_t)pow(2., lut_size));
-    /* Generate LUT bitstream */
+    /* If the physical pb contains fixed bitstream, overload here */
     lut_bitstream = build_frac_lut_bitstream(
       circuit_lib, mux_graph, device_annotation,
       physical_pb.truth_tables(lut_pb_id),
       circuit_lib.port_default_value(lut_regular_sram_ports[0]));
-    /* If the physical pb contains fixed bitstream, overload here */
-    if (false == physical_pb.fixed_bitstream(lut_pb_id).empty()) {
-      std::string fixed_bitstream = physical_pb.fixed_bitstream(lut_pb_id);
-      size_t start_index = physical_pb.fixed_bitstream_offset(lut_pb_id);
+    std::string fixed_bitstream = physical_pb.fixed_bitstream(lut_pb_id);
+    size_t start_index = physical_pb.fixed_bitstream_offset(lut_pb_id);
+    /* Ensure the length matches!!! */
+    if (lut_bitstream.size() - start_index < fixed_bitstream.size()) {
+      VTR_LOG_ERROR(
+        "Unmatched length of fixed bitstream %s!Expected to be less than %ld "
+        "bits\n",
+        fixed_bitstream.c_str(), lut_bitstream.size() - start_index);
+      exit(1);
+    }
+    /* Overload the bitstream here */
+    for (size_t bit_index = 0; bit_index < lut_bitstream.size(); ++bit_index) {
+      VTR_ASSERT('0' == fixed_bitstream[bit_index] ||
+                 '1' == fixed_bitstream[bit_index]);
+      lut_bitstream[bit_index + start_index] =
+        ('1' == fixed_bitstream[bit_index]);
+    }
+  }
+
+  /* Generate bitstream for mode-select ports */
+  std::vector<bool> mode_select_bitstream;
+  if (0 != lut_mode_select_ports.size()) {
+    mode_select_bitstream =
+      generate_mode_select_bitstream(physical_pb.mode_bits(lut_pb_id));
+
+    /* If the physical pb contains fixed mode-select bitstream, overload here
+     */
+    if (false == physical_pb.fixed_mode_select_bitstream(lut_pb_id).empty()) {
+      std::string fixed_mode_select_bitstream =
+        physical_pb.fixed_mode_select_bitstream(lut_pb_id);
+      size_t mode_bits_start_index =
+        physical_pb.fixed_mode_select_bitstream_offset(lut_pb_id);
       /* Ensure the length matches!!! */
-      if (lut_bitstream.size() - start_index < fixed_bitstream.size()) {
+      if (mode_select_bitstream.size() - mode_bits_start_index <
+          fixed_mode_select_bitstream.size()) {
         VTR_LOG_ERROR(
-          "Unmatched length of fixed bitstream %s!Expected to be less than %ld "
-          "bits\n",
-          fixed_bitstream.c_str(), lut_bitstream.size() - start_index);
+          "Unmatched length of fixed mode_select_bitstream %s!Expected to be "
+          "less than %ld bits\n",
+          fixed_mode_select_bitstream.c_str(),
+          mode_select_bitstream.size() - mode_bits_start_index);
         exit(1);
       }
       /* Overload the bitstream here */
-      for (size_t bit_index = 0; bit_index < lut_bitstream.size();
+      for (size_t bit_index = 0; bit_index < fixed_mode_select_bitstream.size();
            ++bit_index) {
-        VTR_ASSERT('0' == fixed_bitstream[bit_index] ||
-                   '1' == fixed_bitstream[bit_index]);
-        lut_bitstream[bit_index + start_index] =
-          ('1' == fixed_bitstream[bit_index]);
+        VTR_ASSERT('0' == fixed_mode_select_bitstream[bit_index] ||
+                   '1' == fixed_mode_select_bitstream[bit_index]);
+        mode_select_bitstream[bit_index + mode_bits_start_index] =
+          ('1' == fixed_mode_select_bitstream[bit_index]);
       }
     }
   }
 
-  /* Generate bitstream for mode-select ports */
-  if (0 != lut_mode_select_ports.size()) {
-    std::vector<bool> mode_select_bitstream;
-    if (true == physical_pb.valid_pb_id(lut_pb_id)) {
-      mode_select_bitstream =
-        generate_mode_select_bitstream(physical_pb.mode_bits(lut_pb_id));
-
-      /* If the physical pb contains fixed mode-select bitstream, overload here
-       */
-      if (false == physical_pb.fixed_mode_select_bitstream(lut_pb_id).empty()) {
-        std::string fixed_mode_select_bitstream =
-          physical_pb.fixed_mode_select_bitstream(lut_pb_id);
-        size_t mode_bits_start_index =
-          physical_pb.fixed_mode_select_bitstream_offset(lut_pb_id);
-        /* Ensure the length matches!!! */
-        if (mode_select_bitstream.size() - mode_bits_start_index <
-            fixed_mode_select_bitstream.size()) {
-          VTR_LOG_ERROR(
-            "Unmatched length of fixed mode_select_bitstream %s!Expected to be "
-            "less than %ld bits\n",
-            fixed_mode_select_bitstream.c_str(),
-            mode_select_bitstream.size() - mode_bits_start_index);
-          exit(1);
-        }
-        /* Overload the bitstream here */
-        for (size_t bit_index = 0;
-             bit_index < fixed_mode_select_bitstream.size(); ++bit_index) {
-          VTR_ASSERT('0' == fixed_mode_select_bitstream[bit_index] ||
-                     '1' == fixed_mode_select_bitstream[bit_index]);
-          mode_select_bitstream[bit_index + mode_bits_start_index] =
-            ('1' == fixed_mode_select_bitstream[bit_index]);
-        }
-      }
-    } else { /* get default mode_bits */
-      mode_select_bitstream = generate_mode_select_bitstream(
-        device_annotation.pb_type_mode_bits(lut_pb_type));
-    }
-
-    /* Conjunct the mode-select bitstream to the lut bitstream */
-    for (const bool& bit : mode_select_bitstream) {
-      lut_bitstream.push_back(bit);
-    }
-  }
-
-  /* Ensure the length of bitstream matches the side of memory circuits */
-  std::vector<CircuitModelId> sram_models =
-    find_circuit_sram_models(circuit_lib, lut_model);
-  VTR_ASSERT(1 == sram_models.size());
-  std::string mem_block_name = generate_memory_module_name(
-    circuit_lib, lut_model, sram_models[0], std::string(MEMORY_MODULE_POSTFIX));
-  ModuleId mem_module = module_manager.find_module(mem_block_name);
-  VTR_ASSERT(true == module_manager.valid_module_id(mem_module));
-  ModulePortId mem_out_port_id = module_manager.find_module_port(
-    mem_module, generate_configurable_memory_data_out_name());
-  VTR_ASSERT(
-    lut_bitstream.size() ==
-    module_manager.module_port(mem_module, mem_out_port_id).get_width());
-
-  /* If there is a feedthrough module, we should consider the scoreboard */
-  std::string feedthru_mem_block_name =
-    generate_memory_module_name(circuit_lib, lut_model, sram_models[0],
-                                std::string(MEMORY_MODULE_POSTFIX), true);
-  ModuleId feedthru_mem_module =
-    module_manager.find_module(feedthru_mem_block_name);
-  if (module_manager.valid_module_id(feedthru_mem_module)) {
-    auto result = grouped_mem_inst_scoreboard.find(mem_block_name);
-    if (result == grouped_mem_inst_scoreboard.end()) {
-      /* Update scoreboard */
-      grouped_mem_inst_scoreboard[mem_block_name] = 0;
-    } else {
-      grouped_mem_inst_scoreboard[mem_block_name]++;
-      mem_block_name = generate_instance_name(
-        mem_block_name, grouped_mem_inst_scoreboard[mem_block_name]);
-    }
+  /* Conjunct the mode-select bitstream to the lut bitstream */
+  ConfigBlockId mem_block = add_pb_memory_block(
+    bitstream_manager, grouped_mem_inst_scoreboard, parent_configurable_block,
+    mem_template->second, num_lut_bits + mode_select_bitstream.size(),
+    verbose);
+  if (true == lut_bitstream.empty()) {
+    bitstream_manager.add_block_bits(mem_block, lut_bitstream_words.data(),
+                                     num_lut_bits);
+  } else {
+    bitstream_manager.add_block_bits(mem_block, lut_bitstream);
   }
-
-  /* Create a block for the bitstream which corresponds to the memory module
-   * associated to the LUT */
-  ConfigBlockId mem_block = bitstream_manager.add_block(mem_block_name);
-  bitstream_manager.add_child_block(parent_configurable_block, mem_block);
-
-  VTR_LOGV(verbose, "Added %lu bits to '%s' under '%s'\n", lut_bitstream.size(),
-           bitstream_manager.block_name(mem_block).c_str(),
-           bitstream_manager.block_name(parent_configurable_block).c_str());
-
-  /* Add the bitstream to the bitstream manager */
-  bitstream_manager.add_block_bits(mem_block, lut_bitstream);
+  bitstream_manager.add_block_bits(mem_block, mode_select_bitstream);
 }
 
 /********************************************************************
@@ -706,9 +948,10 @@ static void rec_build_physical_block_bitstream(
   BitstreamManager& bitstream_manager,
   std::map<std::string, size_t>& grouped_mem_inst_scoreboard,
   const ConfigBlockId& parent_configurable_block,
-  const ModuleManager& module_manager, const ModuleNameMap& module_name_map,
-  const CircuitLibrary& circuit_lib, const MuxLibrary& mux_lib,
-  const AtomContext& atom_ctx, const VprDeviceAnnotation& device_annotation,
+  const ModuleManager& module_manager,
+  const GridBitstreamTemplate& grid_template, const CircuitLibrary& circuit_lib,
+  const MuxLibrary& mux_lib, const AtomContext& atom_ctx,
+  const VprDeviceAnnotation& device_annotation,
   const VprBitstreamAnnotation& bitstream_annotation, const e_side& border_side,
   const PhysicalPb& physical_pb, const PhysicalPbId& pb_id,
   t_pb_graph_node* physical_pb_graph_node, const size_t& pb_graph_node_index,
@@ -720,11 +963,9 @@ static void rec_build_physical_block_bitstream(
   t_mode* physical_mode = device_annotation.physical_mode(physical_pb_type);
 
   /* Early exit if this parent module has no configurable child modules */
-  std::string pb_module_name =
-    generate_physical_block_module_name(physical_pb_type);
-  pb_module_name = module_name_map.name(pb_module_name);
-  ModuleId pb_module = module_manager.find_module(pb_module_name);
-  VTR_ASSERT(true == module_manager.valid_module_id(pb_module));
+  auto pb_module_result = grid_template.pb_modules.find(physical_pb_type);
+  VTR_ASSERT(pb_module_result != grid_template.pb_modules.end());
+  ModuleId pb_module = pb_module_result->second;
 
   /* Skip module with no configurable children */
   if (0 == module_manager.num_configurable_children(
@@ -768,7 +1009,7 @@ static void rec_build_physical_block_bitstream(
         /* Go recursively */
         rec_build_physical_block_bitstream(
           bitstream_manager, grouped_mem_inst_scoreboard, pb_configurable_block,
-          module_manager, module_name_map, circuit_lib, mux_lib, atom_ctx,
+          module_manager, grid_template, circuit_lib, mux_lib, atom_ctx,
           device_annotation, bitstream_annotation, border_side, physical_pb,
           child_pb,
           &(physical_pb_graph_node
@@ -790,7 +1031,7 @@ static void rec_build_physical_block_bitstream(
          */
         build_lut_bitstream(bitstream_manager, grouped_mem_inst_scoreboard,
                             pb_configurable_block, device_annotation,
-                            module_manager, circuit_lib, mux_lib, physical_pb,
+                            grid_template, circuit_lib, mux_lib, physical_pb,
                             pb_id, physical_pb_type, verbose);
         break;
       case CIRCUIT_MODEL_FF:
@@ -799,7 +1040,7 @@ static void rec_build_physical_block_bitstream(
         /* For other types of blocks, we can apply a generic therapy */
         build_primitive_bitstream(
           bitstream_manager, grouped_mem_inst_scoreboard, pb_configurable_block,
-          module_manager, circuit_lib, device_annotation, physical_pb, pb_id,
+          grid_template, circuit_lib, device_annotation, physical_pb, pb_id,
           physical_pb_type, verbose);
         break;
       default:
@@ -815,9 +1056,57 @@ static void rec_build_physical_block_bitstream(
   /* Generate the bitstream for the interconnection in this physical block */
   build_physical_block_interc_bitstream(
     bitstream_manager, grouped_mem_inst_scoreboard, pb_configurable_block,
-    module_manager, module_name_map, circuit_lib, mux_lib, atom_ctx,
-    device_annotation, bitstream_annotation, physical_pb_graph_node,
-    physical_pb, physical_mode, verbose);
+    grid_template, mux_lib, circuit_lib, atom_ctx, bitstream_annotation,
+    physical_pb_graph_node, physical_pb, physical_mode, verbose);
+}
+
+/********************************************************************
+ * Build the bitstream of the physical blocks of an unused grid for each type
+ * of grids. Most of the grids are unused in a small design on a large device,
+ * and they only differ in the name of the grid block
+ *******************************************************************/
+static void build_unused_grid_bitstreams(
+  GridBitstreamTemplate& grid_template, const ModuleManager& module_manager,
+  const CircuitLibrary& circuit_lib, const MuxLibrary& mux_lib,
+  const AtomContext& atom_ctx, const VprDeviceAnnotation& device_annotation,
+  const VprBitstreamAnnotation& bitstream_annotation, const DeviceGrid& grids,
+  const size_t& layer) {
+  std::unordered_map<t_physical_tile_type_ptr, BitstreamManager>
+    unused_grid_bitstreams;
+  for (size_t ix = 0; ix < grids.width(); ++ix) {
+    for (size_t iy = 0; iy < grids.height(); ++iy) {
+      t_physical_tile_type_ptr grid_type =
+        grids.get_physical_type(t_physical_tile_loc(ix, iy, layer));
+      if ((true == is_empty_type(grid_type)) ||
+          (0 < unused_grid_bitstreams.count(grid_type))) {
+        continue;
+      }
+      BitstreamManager& unused_grid_bitstream =
+        unused_grid_bitstreams[grid_type];
+      ConfigBlockId grid_block =
+        unused_grid_bitstream.add_block(std::string(grid_type->name));
+
+      /* Follow the same sequence as build_physical_block_bitstream() */
+      std::map<std::string, size_t> grouped_mem_inst_scoreboard;
+      for (int z = 0; z < grid_type->capacity; ++z) {
+        int sub_tile_index =
+          device_annotation.physical_tile_z_to_subtile_index(grid_type, z);
+        for (t_logical_block_type_ptr lb_type :
+             grid_type->sub_tiles[sub_tile_index].equivalent_sites) {
+          /* Bypass empty pb_graph */
+          if (nullptr == lb_type->pb_graph_head) {
+            continue;
+          }
+          rec_build_physical_block_bitstream(
+            unused_grid_bitstream, grouped_mem_inst_scoreboard, grid_block,
+            module_manager, grid_template, circuit_lib, mux_lib, atom_ctx,
+            device_annotation, bitstream_annotation, NUM_SIDES, PhysicalPb(),
+            PhysicalPbId::INVALID(), lb_type->pb_graph_head, z, false);
+        }
+      }
+    }
+  }
+  grid_template.unused_grid_bitstreams = std::move(unused_grid_bitstreams);
 }
 
 /********************************************************************
@@ -829,9 +1118,10 @@ static void rec_build_physical_block_bitstream(
 static void build_physical_block_bitstream(
   BitstreamManager& bitstream_manager, const ConfigBlockId& top_block,
   const ModuleManager& module_manager, const ModuleNameMap& module_name_map,
-  const FabricTile& fabric_tile, const FabricTileId& curr_tile,
-  const CircuitLibrary& circuit_lib, const MuxLibrary& mux_lib,
-  const AtomContext& atom_ctx, const VprDeviceAnnotation& device_annotation,
+  const GridBitstreamTemplate& grid_template, const FabricTile& fabric_tile,
+  const FabricTileId& curr_tile, const CircuitLibrary& circuit_lib,
+  const MuxLibrary& mux_lib, const AtomContext& atom_ctx,
+  const VprDeviceAnnotation& device_annotation,
   const VprClusteringAnnotation& cluster_annotation,
   const VprPlacementAnnotation& place_annotation,
   const VprBitstreamAnnotation& bitstream_annotation, const DeviceGrid& grids,
@@ -910,8 +1200,29 @@ static void build_physical_block_bitstream(
    * If you need different equivalent sites, you can always define
    * it as a mode under a <pb_type>
    */
+  VprPlacementAnnotation::grid_block_range grid_blocks =
+    place_annotation.grid_blocks(grid_coord);
+
+  /* Unused grids of the same type have the same bitstream, which is copied
+   * in bulk rather than built again */
+  bool unused_grid = (size_t(grid_type->capacity) == grid_blocks.size());
+  for (const ClusterBlockId& grid_block : grid_blocks) {
+    if (ClusterBlockId::INVALID() != grid_block) {
+      unused_grid = false;
+      break;
+    }
+  }
+  auto unused_grid_bitstream =
+    grid_template.unused_grid_bitstreams.find(grid_type);
+  if ((true == unused_grid) &&
+      (unused_grid_bitstream != grid_template.unused_grid_bitstreams.end())) {
+    bitstream_manager.append_bitstream(grid_configurable_block,
+                                       unused_grid_bitstream->second);
+    return;
+  }
+
   std::map<std::string, size_t> grouped_mem_inst_scoreboard;
-  for (size_t z = 0; z < place_annotation.grid_blocks(grid_coord).size(); ++z) {
+  for (size_t z = 0; z < grid_blocks.size(); ++z) {
     int sub_tile_index =
       device_annotation.physical_tile_z_to_subtile_index(grid_type, z);
     VTR_ASSERT(1 ==
@@ -924,17 +1235,17 @@ static void build_physical_block_bitstream(
       }
 
       if (ClusterBlockId::INVALID() ==
-          place_annotation.grid_blocks(grid_coord)[z]) {
+          place_annotation.grid_block(grid_coord, z)) {
         /* Recursively traverse the pb_graph and generate bitstream */
         rec_build_physical_block_bitstream(
           bitstream_manager, grouped_mem_inst_scoreboard,
-          grid_configurable_block, module_manager, module_name_map, circuit_lib,
+          grid_configurable_block, module_manager, grid_template, circuit_lib,
           mux_lib, atom_ctx, device_annotation, bitstream_annotation,
           border_side, PhysicalPb(), PhysicalPbId::INVALID(),
           lb_type->pb_graph_head, z, verbose);
       } else {
         const PhysicalPb& phy_pb = cluster_annotation.physical_pb(
-          place_annotation.grid_blocks(grid_coord)[z]);
+          place_annotation.grid_block(grid_coord, z));
 
         /* Get the top-level node of the pb_graph */
         t_pb_graph_node* pb_graph_head = lb_type->pb_graph_head;
@@ -944,7 +1255,7 @@ static void build_physical_block_bitstream(
         /* Recursively traverse the pb_graph and generate bitstream */
         rec_build_physical_block_bitstream(
           bitstream_manager, grouped_mem_inst_scoreboard,
-          grid_configurable_block, module_manager, module_name_map, circuit_lib,
+          grid_configurable_block, module_manager, grid_template, circuit_lib,
           mux_lib, atom_ctx, device_annotation, bitstream_annotation,
           border_side, phy_pb, top_pb_id, pb_graph_head, z, verbose);
       }
@@ -952,6 +1263,76 @@ static void build_physical_block_bitstream(
   }
 }
 
+/********************************************************************
+ * Generate bitstreams for a list of grids with multiple threads.
+ * The bitstream of each grid is built in a separated bitstream manager,
+ * whose root block stands for the parent block of the grid. Then, the
+ * bitstreams are appended to the device bitstream in the order of the list,
+ * so that the device bitstream is the same whatever the number of threads
+ *******************************************************************/
+static void build_grid_bitstreams(
+  BitstreamManager& bitstream_manager, const ConfigBlockId& top_block,
+  const ModuleManager& module_manager, const ModuleNameMap& module_name_map,
+  const GridBitstreamTemplate& grid_template, const FabricTile& fabric_tile,
+  const CircuitLibrary& circuit_lib, const MuxLibrary& mux_lib,
+  const DeviceGrid& grids, const size_t& layer,
+  const AtomContext& atom_ctx, const VprDeviceAnnotation& device_annotation,
+  const VprClusteringAnnotation& cluster_annotation,
+  const VprPlacementAnnotation& place_annotation,
+  const VprBitstreamAnnotation& bitstream_annotation,
+  const std::vector<vtr::Point<size_t>>& grid_coords,
+  const std::vector<e_side>& border_sides, const std::string& progress_title,
+  const size_t& num_threads, const bool& verbose) {
+  VTR_ASSERT(grid_coords.size() == border_sides.size());
+
+  std::vector<BitstreamManager> grid_bitstreams(grid_coords.size());
+  ProgressReporter progress(progress_title, grid_coords.size());
+  parallel_for(grid_coords.size(), num_threads, [&](const size_t& igrid) {
+    /* TODO: If the fabric tile is not empty, find the tile module and create
+     * the block accordingly. Also to support future hierarchy changes, when
+     * creating the blocks, trace backward until reach the current top block.
+     * If any block is missing during the back tracing, create it. */
+    std::string parent_block_name = bitstream_manager.block_name(top_block);
+    FabricTileId curr_tile =
+      fabric_tile.find_tile_by_pb_coordinate(grid_coords[igrid]);
+    if (fabric_tile.valid_tile_id(curr_tile)) {
+      parent_block_name =
+        generate_tile_module_name(fabric_tile.tile_coordinate(curr_tile));
+    }
+    BitstreamManager& grid_bitstream = grid_bitstreams[igrid];
+    ConfigBlockId parent_block = grid_bitstream.add_block(parent_block_name);
+
+    build_physical_block_bitstream(
+      grid_bitstream, parent_block, module_manager, module_name_map,
+      grid_template, fabric_tile, curr_tile, circuit_lib, mux_lib, atom_ctx,
+      device_annotation, cluster_annotation, place_annotation,
+      bitstream_annotation, grids, layer, grid_coords[igrid],
+      border_sides[igrid], verbose);
+    progress.increment();
+  });
+
+  /* Append the bitstreams of grids in order */
+  for (size_t igrid = 0; igrid < grid_coords.size(); ++igrid) {
+    ConfigBlockId parent_block = top_block;
+    FabricTileId curr_tile =
+      fabric_tile.find_tile_by_pb_coordinate(grid_coords[igrid]);
+    if (fabric_tile.valid_tile_id(curr_tile)) {
+      vtr::Point<size_t> tile_coord = fabric_tile.tile_coordinate(curr_tile);
+      std::string tile_inst_name = generate_tile_module_name(tile_coord);
+      parent_block =
+        bitstream_manager.find_or_create_child_block(top_block, tile_inst_name);
+      VTR_LOGV(verbose,
+               "Add configurable block '%s' as a child under configurable "
+               "block '%s'\n",
+               tile_inst_name.c_str(),
+               bitstream_manager.block_name(top_block).c_str());
+    }
+    bitstream_manager.append_bitstream(parent_block, grid_bitstreams[igrid]);
+    /* Release memory as soon as possible */
+    grid_bitstreams[igrid] = BitstreamManager();
+  }
+}
+
 /********************************************************************
  * Top-level function of this file:
  * Generate bitstreams for all the grids, including
@@ -966,10 +1347,23 @@ void build_grid_bitstream(
   const AtomContext& atom_ctx, const VprDeviceAnnotation& device_annotation,
   const VprClusteringAnnotation& cluster_annotation,
   const VprPlacementAnnotation& place_annotation,
-  const VprBitstreamAnnotation& bitstream_annotation, const bool& verbose) {
+  const VprBitstreamAnnotation& bitstream_annotation,
+  const size_t& num_threads, const bool& verbose) {
+  TraceScope trace_scope("build_grid_bitstream");
+
+  /* The modules and memories of physical blocks are the same for all the grids
+   * of a type, so they are resolved once and shared by all the threads */
+  GridBitstreamTemplate grid_template =
+    build_grid_bitstream_template(module_manager, module_name_map, circuit_lib,
+                                  device_annotation, grids, layer);
+  build_unused_grid_bitstreams(grid_template, module_manager, circuit_lib,
+                               mux_lib, atom_ctx, device_annotation,
+                               bitstream_annotation, grids, layer);
+
   VTR_LOGV(verbose, "Generating bitstream for core grids...");
 
   /* Generate bitstream for the core logic block one by one */
+  std::vector<vtr::Point<size_t>> core_coords;
   for (size_t ix = 1; ix < grids.width() - 1; ++ix) {
     for (size_t iy = 1; iy < grids.height() - 1; ++iy) {
       t_physical_tile_loc phy_tile_loc(ix, iy, layer);
@@ -982,34 +1376,16 @@ void build_grid_bitstream(
           (0 < grids.get_height_offset(phy_tile_loc))) {
         continue;
       }
-      /* Add a grid module to top_module*/
-      vtr::Point<size_t> grid_coord(ix, iy);
-      /* TODO: If the fabric tile is not empty, find the tile module and create
-       * the block accordingly. Also to support future hierarchy changes, when
-       * creating the blocks, trace backward until reach the current top block.
-       * If any block is missing during the back tracing, create it. */
-      ConfigBlockId parent_block = top_block;
-      FabricTileId curr_tile =
-        fabric_tile.find_tile_by_pb_coordinate(grid_coord);
-      if (fabric_tile.valid_tile_id(curr_tile)) {
-        vtr::Point<size_t> tile_coord = fabric_tile.tile_coordinate(curr_tile);
-        std::string tile_inst_name = generate_tile_module_name(tile_coord);
-        parent_block = bitstream_manager.find_or_create_child_block(
-          top_block, tile_inst_name);
-        VTR_LOGV(verbose,
-                 "Add configurable block '%s' as a child under configurable "
-                 "block '%s'\n",
-                 tile_inst_name.c_str(),
-                 bitstream_manager.block_name(top_block).c_str());
-      }
-
-      build_physical_block_bitstream(
-        bitstream_manager, parent_block, module_manager, module_name_map,
-        fabric_tile, curr_tile, circuit_lib, mux_lib, atom_ctx,
-        device_annotation, cluster_annotation, place_annotation,
-        bitstream_annotation, grids, layer, grid_coord, NUM_SIDES, verbose);
+      core_coords.push_back(vtr::Point<size_t>(ix, iy));
     }
   }
+  build_grid_bitstreams(
+    bitstream_manager, top_block, module_manager, module_name_map,
+    grid_template, fabric_tile, circuit_lib, mux_lib, grids, layer, atom_ctx,
+    device_annotation, cluster_annotation, place_annotation,
+    bitstream_annotation, core_coords,
+    std::vector<e_side>(core_coords.size(), NUM_SIDES),
+    "Build bitstream of core grids", num_threads, verbose);
   VTR_LOGV(verbose, "Done\n");
 
   VTR_LOGV(verbose, "Generating bitstream for I/O grids...");
@@ -1019,6 +1395,8 @@ void build_grid_bitstream(
     generate_perimeter_grid_coordinates(grids);
 
   /* Add instances of I/O grids to top_module */
+  std::vector<vtr::Point<size_t>> io_coords;
+  std::vector<e_side> io_sides;
   for (const e_side& io_side : FPGA_SIDES_CLOCKWISE) {
     for (const vtr::Point<size_t>& io_coordinate : io_coordinates[io_side]) {
       t_physical_tile_loc phy_tile_loc(io_coordinate.x(), io_coordinate.y(),
@@ -1032,32 +1410,17 @@ void build_grid_bitstream(
           (0 < grids.get_height_offset(phy_tile_loc))) {
         continue;
       }
-      /* TODO: If the fabric tile is not empty, find the tile module and create
-       * the block accordingly. Also to support future hierarchy changes, when
-       * creating the blocks, trace backward until reach the current top block.
-       * If any block is missing during the back tracing, create it. */
-      ConfigBlockId parent_block = top_block;
-      FabricTileId curr_tile =
-        fabric_tile.find_tile_by_pb_coordinate(io_coordinate);
-      if (fabric_tile.valid_tile_id(curr_tile)) {
-        vtr::Point<size_t> tile_coord = fabric_tile.tile_coordinate(curr_tile);
-        std::string tile_inst_name = generate_tile_module_name(tile_coord);
-        parent_block = bitstream_manager.find_or_create_child_block(
-          top_block, tile_inst_name);
-        VTR_LOGV(verbose,
-                 "Add configurable block '%s' as a child under configurable "
-                 "block '%s'\n",
-                 tile_inst_name.c_str(),
-                 bitstream_manager.block_name(parent_block).c_str());
-      }
-
-      build_physical_block_bitstream(
-        bitstream_manager, parent_block, module_manager, module_name_map,
-        fabric_tile, curr_tile, circuit_lib, mux_lib, atom_ctx,
-        device_annotation, cluster_annotation, place_annotation,
-        bitstream_annotation, grids, layer, io_coordinate, io_side, verbose);
+      io_coords.push_back(io_coordinate);
+      io_sides.push_back(io_side);
     }
   }
+  build_grid_bitstreams(bitstream_manager, top_block, module_manager,
+                        module_name_map, grid_template, fabric_tile,
+                        circuit_lib, mux_lib, grids, layer, atom_ctx,
+                        device_annotation, cluster_annotation,
+                        place_annotation, bitstream_annotation, io_coords,
+                        io_sides,
+                        "Build bitstream of I/O grids", num_threads, verbose);
   VTR_LOGV(verbose, "Done\n");
 }
 
@@ -1,6 +1,7 @@
 /********************************************************************
  * This file includes functions that build io mapping information
  *******************************************************************/
+#include <algorithm>
 #include <chrono>
 #include <ctime>
 #include <fstream>
@@ -55,65 +56,66 @@ IoMap build_fpga_io_mapping_info(
     }
   }
 
-  /* Type mapping between VPR block and Module port */
-  std::map<AtomBlockType, ModuleManager::e_module_port_type>
-    atom_block_type_to_module_port_type;
-  atom_block_type_to_module_port_type[AtomBlockType::INPAD] =
-    ModuleManager::MODULE_GPIN_PORT;
-  atom_block_type_to_module_port_type[AtomBlockType::OUTPAD] =
-    ModuleManager::MODULE_GPOUT_PORT;
-
-  /* Type mapping between VPR block and io mapping direction */
-  std::map<AtomBlockType, IoMap::e_direction>
-    atom_block_type_to_io_map_direction;
-  atom_block_type_to_io_map_direction[AtomBlockType::INPAD] =
-    IoMap::IO_MAP_DIR_INPUT;
-  atom_block_type_to_io_map_direction[AtomBlockType::OUTPAD] =
-    IoMap::IO_MAP_DIR_OUTPUT;
+  /* Index the names and types of the ports once, as they are visited for
+   * each I/O block */
+  std::vector<std::string> module_io_port_names;
+  std::vector<ModuleManager::e_module_port_type> module_io_port_types;
+  module_io_port_names.reserve(module_io_ports.size());
+  module_io_port_types.reserve(module_io_ports.size());
+  for (const ModulePortId& module_io_port_id : module_io_ports) {
+    module_io_port_names.push_back(
+      module_manager.module_port(top_module, module_io_port_id).get_name());
+    module_io_port_types.push_back(
+      module_manager.port_type(top_module, module_io_port_id));
+  }
 
   for (const AtomBlockId& atom_blk : atom_ctx.nlist.blocks()) {
+    AtomBlockType atom_blk_type = atom_ctx.nlist.block_type(atom_blk);
     /* Bypass non-I/O atom blocks ! */
-    if ((AtomBlockType::INPAD != atom_ctx.nlist.block_type(atom_blk)) &&
-        (AtomBlockType::OUTPAD != atom_ctx.nlist.block_type(atom_blk))) {
+    if ((AtomBlockType::INPAD != atom_blk_type) &&
+        (AtomBlockType::OUTPAD != atom_blk_type)) {
       continue;
     }
 
+    /* Type mapping between VPR block and Module port */
+    ModuleManager::e_module_port_type atom_blk_port_type =
+      ModuleManager::MODULE_GPIN_PORT;
+    if (AtomBlockType::OUTPAD == atom_blk_type) {
+      atom_blk_port_type = ModuleManager::MODULE_GPOUT_PORT;
+    }
+
+    /* All the I/Os placed at the location of the block */
+    const t_pl_loc& atom_blk_loc =
+      place_ctx.block_locs[atom_ctx.lookup.atom_clb(atom_blk)].loc;
+    const std::vector<BasicPort>& placed_io_ports = io_location_map.io_ports(
+      atom_blk_loc.x, atom_blk_loc.y, atom_blk_loc.sub_tile);
+
     /* If there is a GPIO port, use it directly
      * Otherwise, should find a GPIN for INPAD
      *         or should find a GPOUT for OUTPAD
      */
     std::pair<ModulePortId, size_t> mapped_module_io_info =
       std::make_pair(ModulePortId::INVALID(), -1);
-    for (const ModulePortId& module_io_port_id : module_io_ports) {
-      const BasicPort& module_io_port =
-        module_manager.module_port(top_module, module_io_port_id);
-
-      /* Find the index of the mapped GPIO in top-level FPGA fabric */
-      size_t temp_io_index = io_location_map.io_index(
-        place_ctx.block_locs[atom_ctx.lookup.atom_clb(atom_blk)].loc.x,
-        place_ctx.block_locs[atom_ctx.lookup.atom_clb(atom_blk)].loc.y,
-        place_ctx.block_locs[atom_ctx.lookup.atom_clb(atom_blk)].loc.sub_tile,
-        module_io_port.get_name());
+    for (size_t iport = 0; iport < module_io_ports.size(); ++iport) {
+      /* Find the index of the mapped GPIO in top-level FPGA fabric. The first
+       * I/O in the same name is used, as IoLocationMap::io_index() does */
+      auto placed_io_port = std::find_if(
+        placed_io_ports.begin(), placed_io_ports.end(),
+        [&](const BasicPort& candidate) {
+          return candidate.get_name() == module_io_port_names[iport];
+        });
 
       /* Bypass invalid index (not mapped to this GPIO port) */
-      if (size_t(-1) == temp_io_index) {
+      if (placed_io_ports.end() == placed_io_port) {
         continue;
       }
 
-      /* If the port is an GPIO port, just use it */
-      if (ModuleManager::MODULE_GPIO_PORT ==
-          module_manager.port_type(top_module, module_io_port_id)) {
-        mapped_module_io_info =
-          std::make_pair(module_io_port_id, temp_io_index);
-        break;
-      }
-
-      /* If this is an INPAD, we can use an GPIN port (if available) */
-      if (atom_block_type_to_module_port_type[atom_ctx.nlist.block_type(
-            atom_blk)] ==
-          module_manager.port_type(top_module, module_io_port_id)) {
+      /* If the port is an GPIO port, just use it
+       * If this is an INPAD, we can use an GPIN port (if available) */
+      if ((ModuleManager::MODULE_GPIO_PORT == module_io_port_types[iport]) ||
+          (atom_blk_port_type == module_io_port_types[iport])) {
         mapped_module_io_info =
-          std::make_pair(module_io_port_id, temp_io_index);
+          std::make_pair(module_io_ports[iport], placed_io_port->get_lsb());
         break;
       }
     }
@@ -145,12 +147,13 @@ IoMap build_fpga_io_mapping_info(
      * full customization on naming
      */
     BasicPort benchmark_io_port;
-    if (AtomBlockType::INPAD == atom_ctx.nlist.block_type(atom_blk)) {
+    IoMap::e_direction io_map_direction = IoMap::IO_MAP_DIR_INPUT;
+    if (AtomBlockType::INPAD == atom_blk_type) {
       benchmark_io_port.set_name(
         std::string(block_name + io_input_port_name_postfix));
       benchmark_io_port.set_width(1);
     } else {
-      VTR_ASSERT(AtomBlockType::OUTPAD == atom_ctx.nlist.block_type(atom_blk));
+      VTR_ASSERT(AtomBlockType::OUTPAD == atom_blk_type);
       /* VPR may have added a prefix to the output ports, remove them here */
       std::string output_block_name = block_name;
       for (const std::string& prefix_to_remove : output_port_prefix_to_remove) {
@@ -165,11 +168,11 @@ IoMap build_fpga_io_mapping_info(
       benchmark_io_port.set_name(
         std::string(output_block_name + io_output_port_name_postfix));
       benchmark_io_port.set_width(1);
+      io_map_direction = IoMap::IO_MAP_DIR_OUTPUT;
     }
 
-    io_map.create_io_mapping(
-      module_mapped_io_port, benchmark_io_port,
-      atom_block_type_to_io_map_direction[atom_ctx.nlist.block_type(atom_blk)]);
+    io_map.create_io_mapping(module_mapped_io_port, benchmark_io_port,
+                             io_map_direction);
   }
 
   return io_map;
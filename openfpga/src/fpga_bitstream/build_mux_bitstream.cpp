@@ -54,12 +54,15 @@ size_t find_mux_default_path_id(const CircuitLibrary& circuit_lib,
  * to from a given input to the output
  * All the memory bits can be generated by an API of MuxGraph
  *
- * To be generic, this function only returns a vector bit values
+ * To be generic, this function only fills a vector bit values
  * without touching an bitstream-relate data structure
  *******************************************************************/
-static std::vector<bool> build_cmos_mux_bitstream(
-  const CircuitLibrary& circuit_lib, const CircuitModelId& mux_model,
-  const MuxLibrary& mux_lib, const size_t& mux_size, const int& path_id) {
+static void build_cmos_mux_bitstream(std::vector<bool>& mux_bitstream,
+                                     const CircuitLibrary& circuit_lib,
+                                     const CircuitModelId& mux_model,
+                                     const MuxLibrary& mux_lib,
+                                     const size_t& mux_size,
+                                     const int& path_id) {
   /* Note that the size of implemented mux could be different than the mux size
    * we see here, due to the constant inputs We will find the input size of
    * implemented MUX and fetch the graph-based representation in MUX library
@@ -71,7 +74,7 @@ static std::vector<bool> build_cmos_mux_bitstream(
   if (!mux_lib.valid_mux_id(mux_graph_id)) {
     VTR_ASSERT(mux_lib.valid_mux_id(mux_graph_id));
   }
-  const MuxGraph mux_graph = mux_lib.mux_graph(mux_graph_id);
+  const MuxGraph& mux_graph = mux_lib.mux_graph(mux_graph_id);
 
   size_t datapath_id = path_id;
 
@@ -87,22 +90,19 @@ static std::vector<bool> build_cmos_mux_bitstream(
   /* We should have only one output for this MUX! */
   VTR_ASSERT(1 == mux_graph.outputs().size());
 
-  /* Generate the memory bits */
-  vtr::vector<MuxMemId, bool> raw_bitstream = mux_graph.decode_memory_bits(
-    MuxInputId(datapath_id), mux_graph.output_id(mux_graph.outputs()[0]));
-
-  std::vector<bool> mux_bitstream;
-  for (const bool& bit : raw_bitstream) {
-    mux_bitstream.push_back(bit);
-  }
+  /* Generate the memory bits, which are found in the decode table of the
+   * mux */
+  mux_lib.append_mux_memory_bits(mux_graph_id, MuxInputId(datapath_id),
+                                 mux_bitstream);
 
   /* Consider local encoder support, we need further encode the bitstream */
   if (false == circuit_lib.mux_use_local_encoder(mux_model)) {
-    return mux_bitstream;
+    return;
   }
 
-  /* Clear the mux_bitstream, we need to apply encoding */
-  mux_bitstream.clear();
+  /* Move the memory bits aside, we need to apply encoding */
+  std::vector<bool> raw_bitstream;
+  raw_bitstream.swap(mux_bitstream);
 
   /* Encode the memory bits level by level,
    * One local encoder is used for each level of multiplexers
@@ -118,7 +118,7 @@ static std::vector<bool> build_cmos_mux_bitstream(
      * changed!!! */
     if (1 == mux_graph.memories_at_level(level).size()) {
       mux_bitstream.push_back(
-        raw_bitstream[mux_graph.memories_at_level(level)[0]]);
+        raw_bitstream[size_t(mux_graph.memories_at_level(level)[0])]);
       continue;
     }
 
@@ -126,8 +126,8 @@ static std::vector<bool> build_cmos_mux_bitstream(
     for (size_t mem_index = 0;
          mem_index < mux_graph.memories_at_level(level).size(); ++mem_index) {
       /* Conversion rule: true = 1, false = 0 */
-      if (true ==
-          raw_bitstream[mux_graph.memories_at_level(level)[mem_index]]) {
+      if (true == raw_bitstream[size_t(
+                    mux_graph.memories_at_level(level)[mem_index])]) {
         encoder_data.push_back(mem_index);
       }
     }
@@ -150,25 +150,25 @@ static std::vector<bool> build_cmos_mux_bitstream(
       mux_bitstream.push_back(1 == bit);
     }
   }
-
-  return mux_bitstream;
 }
 
 /********************************************************************
  * This function generates bitstream for a routing multiplexer
  * supporting both CMOS and ReRAM multiplexer designs
+ * The bits are written to a buffer given by the caller, so that the buffer
+ * can be reused for all the multiplexers
  *******************************************************************/
-std::vector<bool> build_mux_bitstream(const CircuitLibrary& circuit_lib,
-                                      const CircuitModelId& mux_model,
-                                      const MuxLibrary& mux_lib,
-                                      const size_t& mux_size,
-                                      const int& path_id) {
-  std::vector<bool> mux_bitstream;
+void build_mux_bitstream(std::vector<bool>& mux_bitstream,
+                         const CircuitLibrary& circuit_lib,
+                         const CircuitModelId& mux_model,
+                         const MuxLibrary& mux_lib, const size_t& mux_size,
+                         const int& path_id) {
+  mux_bitstream.clear();
 
   switch (circuit_lib.design_tech_type(mux_model)) {
     case CIRCUIT_MODEL_DESIGN_CMOS:
-      mux_bitstream = build_cmos_mux_bitstream(circuit_lib, mux_model, mux_lib,
-                                               mux_size, path_id);
+      build_cmos_mux_bitstream(mux_bitstream, circuit_lib, mux_model, mux_lib,
+                               mux_size, path_id);
       break;
     case CIRCUIT_MODEL_DESIGN_RRAM:
       /* TODO: ReRAM MUX needs a different bitstream generation strategy */
@@ -179,6 +179,20 @@ std::vector<bool> build_mux_bitstream(const CircuitLibrary& circuit_lib,
                      circuit_lib.model_name(mux_model).c_str());
       exit(1);
   }
+}
+
+/********************************************************************
+ * This function generates bitstream for a routing multiplexer
+ * supporting both CMOS and ReRAM multiplexer designs
+ *******************************************************************/
+std::vector<bool> build_mux_bitstream(const CircuitLibrary& circuit_lib,
+                                      const CircuitModelId& mux_model,
+                                      const MuxLibrary& mux_lib,
+                                      const size_t& mux_size,
+                                      const int& path_id) {
+  std::vector<bool> mux_bitstream;
+  build_mux_bitstream(mux_bitstream, circuit_lib, mux_model, mux_lib, mux_size,
+                      path_id);
   return mux_bitstream;
 }
 
@@ -20,6 +20,12 @@ size_t find_mux_default_path_id(const CircuitLibrary& circuit_lib,
                                 const CircuitModelId& mux_model,
                                 const size_t& mux_size);
 
+void build_mux_bitstream(std::vector<bool>& mux_bitstream,
+                         const CircuitLibrary& circuit_lib,
+                         const CircuitModelId& mux_model,
+                         const MuxLibrary& mux_lib, const size_t& mux_size,
+                         const int& path_id);
+
 std::vector<bool> build_mux_bitstream(const CircuitLibrary& circuit_lib,
                                       const CircuitModelId& mux_model,
                                       const MuxLibrary& mux_lib,
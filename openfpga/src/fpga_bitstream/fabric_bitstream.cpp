@@ -4,8 +4,11 @@
 #include "fabric_bitstream.h"
 
 #include <algorithm>
+#include <cstring>
 
-#include "openfpga_decode.h"
+#include "openfpga_binary_io.h"
+#include "openfpga_hash.h"
+#include "openfpga_parallel.h"
 #include "vtr_assert.h"
 
 /* begin namespace openfpga */
@@ -63,39 +66,73 @@ void FabricBitstreamMemoryBank::add_bit(const fabric_size_t& bit_id,
   masks[region_id][wl][bl >> 3] |= (1 << (bl & 7));
 }
 
+void FabricBitstreamMemoryBank::set_bit(const fabric_size_t& bit_id,
+                                        bool bit) {
+  VTR_ASSERT(true == has_bit(bit_id));
+  fabric_bit_data& bit_data = fabric_bit_datas[bit_id];
+  bit_data.bit = bit;
+  if (bit) {
+    datas[bit_data.region][bit_data.wl][bit_data.bl >> 3] |=
+      (1 << (bit_data.bl & 7));
+  } else {
+    datas[bit_data.region][bit_data.wl][bit_data.bl >> 3] &=
+      ~(1 << (bit_data.bl & 7));
+  }
+}
+
+bool FabricBitstreamMemoryBank::has_bit(const fabric_size_t& bit_id) const {
+  return (size_t)(bit_id) < fabric_bit_datas.size();
+}
+
+/* A WL can be skipped when all the BLs being used (marked in the mask) have
+ * the value to skip, while the others are just don't care. This is checked
+ * on 64-bit words, i.e., 64 BLs at a time, as the bits beyond the BL length
+ * are never marked in the mask */
+static bool is_memory_bank_wl_skippable(const std::vector<uint8_t>& data,
+                                        const std::vector<uint8_t>& mask,
+                                        const bool& bit_value_to_skip) {
+  VTR_ASSERT_SAFE(data.size() == mask.size());
+  const uint64_t skip_pattern = bit_value_to_skip ? ~uint64_t(0) : 0;
+  size_t num_bytes = data.size();
+  size_t ibyte = 0;
+  for (; ibyte + sizeof(uint64_t) <= num_bytes; ibyte += sizeof(uint64_t)) {
+    uint64_t data_word;
+    uint64_t mask_word;
+    std::memcpy(&data_word, data.data() + ibyte, sizeof(uint64_t));
+    std::memcpy(&mask_word, mask.data() + ibyte, sizeof(uint64_t));
+    if (0 != ((data_word ^ skip_pattern) & mask_word)) {
+      return false;
+    }
+  }
+  for (; ibyte < num_bytes; ++ibyte) {
+    if (0 != ((data[ibyte] ^ uint8_t(skip_pattern)) & mask[ibyte])) {
+      return false;
+    }
+  }
+  return true;
+}
+
 void FabricBitstreamMemoryBank::fast_configuration(
-  const bool& fast, const bool& bit_value_to_skip) {
+  const bool& fast, const bool& bit_value_to_skip, const size_t& num_threads) {
   for (auto& wls : wls_to_skip) {
     wls.clear();
   }
   wls_to_skip.clear();
-  for (size_t region = 0; region < datas.size(); region++) {
-    wls_to_skip.emplace_back();
-    if (fast) {
-      for (fabric_size_t wl = 0; wl < blwl_lengths[region].wl; wl++) {
-        VTR_ASSERT((size_t)(wl) < datas[region].size());
-        bool skip_wl = true;
-        for (fabric_size_t bl = 0; bl < blwl_lengths[region].bl && skip_wl;
-             bl++) {
-          // Only check the bit that being used (marked in the mask),
-          // otherwise it is just a don't care, we can skip
-          if (masks[region][wl][bl >> 3] & (1 << (bl & 7))) {
-            if (datas[region][wl][bl >> 3] & (1 << (bl & 7))) {
-              // If bit_value_to_skip=true, and yet the din (recorded in
-              // datas) also 1, then we can skip
-              skip_wl = bit_value_to_skip;
-            } else {
-              skip_wl = !bit_value_to_skip;
-            }
-          }
-        }
-        if (skip_wl) {
-          // Record down that for this region, we will skip this WL
-          wls_to_skip[region].push_back(wl);
-        }
+  wls_to_skip.resize(datas.size());
+  if (false == fast) {
+    return;
+  }
+  /* Regions are independent and each of them only writes its own list */
+  parallel_for(datas.size(), num_threads, [&](const size_t& region) {
+    for (fabric_size_t wl = 0; wl < blwl_lengths[region].wl; wl++) {
+      VTR_ASSERT((size_t)(wl) < datas[region].size());
+      if (is_memory_bank_wl_skippable(datas[region][wl], masks[region][wl],
+                                      bit_value_to_skip)) {
+        // Record down that for this region, we will skip this WL
+        wls_to_skip[region].push_back(wl);
       }
     }
-  }
+  });
 }
 
 fabric_size_t FabricBitstreamMemoryBank::get_longest_effective_wl_count()
@@ -115,6 +152,30 @@ fabric_size_t FabricBitstreamMemoryBank::get_longest_effective_wl_count()
   return longest_wl;
 }
 
+size_t FabricBitstreamMemoryBank::wl_hash(const fabric_size_t& region,
+                                          const fabric_size_t& wl) const {
+  VTR_ASSERT((size_t)(region) < datas.size());
+  VTR_ASSERT((size_t)(wl) < datas[region].size());
+  const std::vector<uint8_t>& data = datas[region][wl];
+  const std::vector<uint8_t>& mask = masks[region][wl];
+  VTR_ASSERT_SAFE(data.size() == mask.size());
+  size_t hash = 0;
+  size_t num_bytes = data.size();
+  size_t ibyte = 0;
+  for (; ibyte + sizeof(uint64_t) <= num_bytes; ibyte += sizeof(uint64_t)) {
+    uint64_t data_word;
+    uint64_t mask_word;
+    std::memcpy(&data_word, data.data() + ibyte, sizeof(uint64_t));
+    std::memcpy(&mask_word, mask.data() + ibyte, sizeof(uint64_t));
+    hash_combine<uint64_t>(hash, data_word & mask_word);
+  }
+  for (; ibyte < num_bytes; ++ibyte) {
+    hash_combine<uint8_t>(hash, data[ibyte] & mask[ibyte]);
+  }
+  hash_combine<size_t>(hash, num_bytes);
+  return hash;
+}
+
 fabric_size_t FabricBitstreamMemoryBank::get_total_bl_addr_size() const {
   // Simply total up all the BL addr size
   fabric_size_t bl = 0;
@@ -133,41 +194,184 @@ fabric_size_t FabricBitstreamMemoryBank::get_total_wl_addr_size() const {
   return wl;
 }
 
+MemoryUsage FabricBitstreamMemoryBank::memory_usage() const {
+  MemoryUsage usage = heap_memory_usage(blwl_lengths);
+  usage += heap_memory_usage(fabric_bit_datas);
+  usage += heap_memory_usage(datas);
+  usage += heap_memory_usage(masks);
+  usage += heap_memory_usage(wls_to_skip);
+  return usage;
+}
+
 /**************************************************
- * Public Constructor
+ * FabricBitAddressView
  *************************************************/
-FabricBitstream::FabricBitstream() {
-  num_bits_ = 0;
-  invalid_bit_ids_.clear();
-  address_length_ = 0;
-  wl_address_length_ = 0;
+FabricBitAddressView::FabricBitAddressView(const uint64_t* bits1,
+                                           const uint64_t* bitsx,
+                                           const size_t& num_words,
+                                           const size_t& length)
+  : bits1_(bits1), bitsx_(bitsx), num_words_(num_words), length_(length) {
+  VTR_ASSERT(length_ <= 64 * num_words_);
+}
+
+size_t FabricBitAddressView::size() const { return length_; }
+
+char FabricBitAddressView::operator[](const size_t& ibit) const {
+  VTR_ASSERT_SAFE(ibit < length_);
+  size_t iword = ibit / 64;
+  uint64_t mask = uint64_t(1) << (ibit % 64);
+  if (bitsx_[iword] & mask) {
+    return 'x';
+  }
+  return (bits1_[iword] & mask) ? '1' : '0';
+}
+
+std::string FabricBitAddressView::to_string() const {
+  std::string addr_str(length_, '0');
+  for (size_t ibit = 0; ibit < length_; ++ibit) {
+    addr_str[ibit] = (*this)[ibit];
+  }
+  return addr_str;
+}
+
+size_t FabricBitAddressView::num_words() const { return num_words_; }
+
+size_t FabricBitAddressView::word_size(const size_t& iword) const {
+  VTR_ASSERT_SAFE(iword < num_words_);
+  return std::min(size_t(64), length_ - iword * 64);
+}
 
-  num_regions_ = 0;
-  invalid_region_ids_.clear();
+uint64_t FabricBitAddressView::word_1bits(const size_t& iword) const {
+  VTR_ASSERT_SAFE(iword < num_words_);
+  return bits1_[iword];
+}
+
+uint64_t FabricBitAddressView::word_xbits(const size_t& iword) const {
+  VTR_ASSERT_SAFE(iword < num_words_);
+  return bitsx_[iword];
+}
+
+/**************************************************
+ * FabricBitstreamTemplate
+ *************************************************/
+void FabricBitstreamTemplate::write_binary(std::ostream& fp) const {
+  write_binary_data(fp, region_bit_ids);
+  write_binary_data(fp, config_bit_ids);
+
+  write_binary_data(fp, use_address);
+  write_binary_data(fp, use_wl_address);
+  write_binary_size(fp, address_length);
+  write_binary_size(fp, wl_address_length);
+
+  write_binary_data(fp, bit_address_offsets);
+  write_binary_data(fp, bit_address_num_words);
+  write_binary_data(fp, address_1bits);
+  write_binary_data(fp, address_xbits);
+  write_binary_data(fp, bit_wl_address_offsets);
+  write_binary_data(fp, bit_wl_address_num_words);
+  write_binary_data(fp, wl_address_1bits);
+  write_binary_data(fp, wl_address_xbits);
+
+  /* Only the locations of the memory bank bits are required, the masks are
+   * restored from them */
+  std::vector<fabric_size_t> region_lengths;
+  for (const fabric_blwl_length& lengths : memory_bank.blwl_lengths) {
+    region_lengths.push_back(lengths.bl);
+    region_lengths.push_back(lengths.wl);
+  }
+  write_binary_data(fp, region_lengths);
+  std::vector<fabric_size_t> bit_locations;
+  bit_locations.reserve(3 * memory_bank.fabric_bit_datas.size());
+  for (const fabric_bit_data& bit : memory_bank.fabric_bit_datas) {
+    bit_locations.push_back(bit.region);
+    bit_locations.push_back(bit.bl);
+    bit_locations.push_back(bit.wl);
+  }
+  write_binary_data(fp, bit_locations);
+}
+
+void FabricBitstreamTemplate::read_binary(std::istream& fp) {
+  read_binary_data(fp, region_bit_ids);
+  read_binary_data(fp, config_bit_ids);
+
+  read_binary_data(fp, use_address);
+  read_binary_data(fp, use_wl_address);
+  address_length = read_binary_size(fp);
+  wl_address_length = read_binary_size(fp);
+
+  read_binary_data(fp, bit_address_offsets);
+  read_binary_data(fp, bit_address_num_words);
+  read_binary_data(fp, address_1bits);
+  read_binary_data(fp, address_xbits);
+  read_binary_data(fp, bit_wl_address_offsets);
+  read_binary_data(fp, bit_wl_address_num_words);
+  read_binary_data(fp, wl_address_1bits);
+  read_binary_data(fp, wl_address_xbits);
+
+  std::vector<fabric_size_t> region_lengths;
+  std::vector<fabric_size_t> bit_locations;
+  read_binary_data(fp, region_lengths);
+  read_binary_data(fp, bit_locations);
+  memory_bank = FabricBitstreamMemoryBank();
+  if ((false == fp.good()) || (0 != region_lengths.size() % 2) ||
+      (0 != bit_locations.size() % 3)) {
+    return;
+  }
+  for (size_t ilen = 0; ilen < region_lengths.size(); ilen += 2) {
+    memory_bank.blwl_lengths.push_back(
+      fabric_blwl_length(region_lengths[ilen], region_lengths[ilen + 1]));
+  }
+  for (size_t iloc = 0; iloc < bit_locations.size(); iloc += 3) {
+    fabric_size_t region = bit_locations[iloc];
+    VTR_ASSERT((size_t)(region) < memory_bank.blwl_lengths.size());
+    memory_bank.add_bit(
+      fabric_size_t(iloc / 3), region, bit_locations[iloc + 1],
+      bit_locations[iloc + 2], memory_bank.blwl_lengths[region].bl,
+      memory_bank.blwl_lengths[region].wl, false);
+  }
+}
 
-  use_address_ = false;
-  use_wl_address_ = false;
+/**************************************************
+ * Public Constructor
+ *************************************************/
+FabricBitstream::FabricBitstream()
+  : template_(std::make_shared<FabricBitstreamTemplate>()) {}
+
+FabricBitstream::FabricBitstream(
+  const std::shared_ptr<const FabricBitstreamTemplate>& bitstream_template)
+  : template_(
+      std::const_pointer_cast<FabricBitstreamTemplate>(bitstream_template)),
+    memory_bank_data_(bitstream_template->memory_bank) {
+  /* The template is never modified through this object unless it is copied
+   * first, see mutable_template() */
+  if (true == template_->use_address) {
+    bit_dins_.resize(template_->config_bit_ids.size(), 0);
+  }
 }
 
 /**************************************************
  * Public Accessors : Aggregates
  *************************************************/
-size_t FabricBitstream::num_bits() const { return num_bits_; }
+size_t FabricBitstream::num_bits() const {
+  return template_->config_bit_ids.size();
+}
 
 /* Find all the configuration bits */
 FabricBitstream::fabric_bit_range FabricBitstream::bits() const {
   return vtr::make_range(
     fabric_bit_iterator(FabricBitId(0), invalid_bit_ids_),
-    fabric_bit_iterator(FabricBitId(num_bits_), invalid_bit_ids_));
+    fabric_bit_iterator(FabricBitId(num_bits()), invalid_bit_ids_));
 }
 
-size_t FabricBitstream::num_regions() const { return num_regions_; }
+size_t FabricBitstream::num_regions() const {
+  return template_->region_bit_ids.size();
+}
 
 /* Find all the configuration bits */
 FabricBitstream::fabric_bit_region_range FabricBitstream::regions() const {
   return vtr::make_range(
     fabric_bit_region_iterator(FabricBitRegionId(0), invalid_region_ids_),
-    fabric_bit_region_iterator(FabricBitRegionId(num_regions_),
+    fabric_bit_region_iterator(FabricBitRegionId(num_regions()),
                                invalid_region_ids_));
 }
 
@@ -176,7 +380,15 @@ std::vector<FabricBitId> FabricBitstream::region_bits(
   /* Ensure a valid id */
   VTR_ASSERT(true == valid_region_id(region_id));
 
-  return region_bit_ids_[region_id];
+  return template_->region_bit_ids[region_id];
+}
+
+size_t FabricBitstream::num_region_bits(
+  const FabricBitRegionId& region_id) const {
+  /* Ensure a valid id */
+  VTR_ASSERT(true == valid_region_id(region_id));
+
+  return template_->region_bit_ids[region_id].size();
 }
 
 /******************************************************************************
@@ -186,27 +398,15 @@ ConfigBitId FabricBitstream::config_bit(const FabricBitId& bit_id) const {
   /* Ensure a valid id */
   VTR_ASSERT(true == valid_bit_id(bit_id));
 
-  return config_bit_ids_[bit_id];
+  return template_->config_bit_ids[bit_id];
 }
 
 std::vector<char> FabricBitstream::bit_address(
   const FabricBitId& bit_id) const {
-  /* Ensure a valid id */
-  VTR_ASSERT(true == valid_bit_id(bit_id));
-  VTR_ASSERT(true == use_address_);
-
-  /* Decode address bits */
-  std::vector<char> addr_bits;
-  addr_bits.reserve(address_length_);
-  for (size_t curr_idx = 0; curr_idx < bit_address_1bits_[bit_id].size();
-       curr_idx++) {
-    size_t curr_addr_len =
-      std::min(size_t(64), address_length_ - curr_idx * 64);
-    std::vector<char> curr_addr_vec =
-      decode_address_bits(bit_address_1bits_[bit_id][curr_idx],
-                          bit_address_xbits_[bit_id][curr_idx], curr_addr_len);
-    addr_bits.insert(addr_bits.end(), curr_addr_vec.begin(),
-                     curr_addr_vec.end());
+  FabricBitAddressView addr_view = bit_address_view(bit_id);
+  std::vector<char> addr_bits(addr_view.size());
+  for (size_t ibit = 0; ibit < addr_view.size(); ++ibit) {
+    addr_bits[ibit] = addr_view[ibit];
   }
   return addr_bits;
 }
@@ -218,80 +418,137 @@ std::vector<char> FabricBitstream::bit_bl_address(
 
 std::vector<char> FabricBitstream::bit_wl_address(
   const FabricBitId& bit_id) const {
-  /* Ensure a valid id */
-  VTR_ASSERT(true == valid_bit_id(bit_id));
-  VTR_ASSERT(true == use_address_);
-  VTR_ASSERT(true == use_wl_address_);
-
-  /* Decode address bits */
-  std::vector<char> addr_bits;
-  addr_bits.reserve(wl_address_length_);
-  for (size_t curr_idx = 0; curr_idx < bit_wl_address_1bits_[bit_id].size();
-       curr_idx++) {
-    size_t curr_addr_len =
-      std::min(size_t(64), wl_address_length_ - curr_idx * 64);
-    std::vector<char> curr_addr_vec = decode_address_bits(
-      bit_wl_address_1bits_[bit_id][curr_idx],
-      bit_wl_address_xbits_[bit_id][curr_idx], curr_addr_len);
-    addr_bits.insert(addr_bits.end(), curr_addr_vec.begin(),
-                     curr_addr_vec.end());
+  FabricBitAddressView addr_view = bit_wl_address_view(bit_id);
+  std::vector<char> addr_bits(addr_view.size());
+  for (size_t ibit = 0; ibit < addr_view.size(); ++ibit) {
+    addr_bits[ibit] = addr_view[ibit];
   }
   return addr_bits;
 }
 
+/* Note that a short address is padded with '0' up to the end of its last
+ * word, as the encoded words do not record its length */
+FabricBitAddressView FabricBitstream::bit_address_view(
+  const FabricBitId& bit_id) const {
+  /* Ensure a valid id */
+  VTR_ASSERT(true == valid_bit_id(bit_id));
+  VTR_ASSERT(true == template_->use_address);
+
+  size_t offset = template_->bit_address_offsets[bit_id];
+  size_t num_words = template_->bit_address_num_words[bit_id];
+  return FabricBitAddressView(
+    template_->address_1bits.data() + offset,
+    template_->address_xbits.data() + offset, num_words,
+    std::min(template_->address_length, 64 * num_words));
+}
+
+FabricBitAddressView FabricBitstream::bit_bl_address_view(
+  const FabricBitId& bit_id) const {
+  return bit_address_view(bit_id);
+}
+
+FabricBitAddressView FabricBitstream::bit_wl_address_view(
+  const FabricBitId& bit_id) const {
+  /* Ensure a valid id */
+  VTR_ASSERT(true == valid_bit_id(bit_id));
+  VTR_ASSERT(true == template_->use_address);
+  VTR_ASSERT(true == template_->use_wl_address);
+
+  size_t offset = template_->bit_wl_address_offsets[bit_id];
+  size_t num_words = template_->bit_wl_address_num_words[bit_id];
+  return FabricBitAddressView(
+    template_->wl_address_1bits.data() + offset,
+    template_->wl_address_xbits.data() + offset, num_words,
+    std::min(template_->wl_address_length, 64 * num_words));
+}
+
 char FabricBitstream::bit_din(const FabricBitId& bit_id) const {
   /* Ensure a valid id */
   VTR_ASSERT(true == valid_bit_id(bit_id));
-  VTR_ASSERT(true == use_address_);
+  VTR_ASSERT(true == template_->use_address);
 
   return bit_dins_[bit_id];
 }
 
-bool FabricBitstream::use_address() const { return use_address_; }
+bool FabricBitstream::use_address() const { return template_->use_address; }
 
-bool FabricBitstream::use_wl_address() const { return use_wl_address_; }
+bool FabricBitstream::use_wl_address() const {
+  return template_->use_wl_address;
+}
 
 const FabricBitstreamMemoryBank& FabricBitstream::memory_bank_info(
-  const bool& fast, const bool& bit_value_to_skip) const {
-  VTR_ASSERT(true == use_address_);
-  VTR_ASSERT(true == use_wl_address_);
+  const bool& fast, const bool& bit_value_to_skip,
+  const size_t& num_threads) const {
+  VTR_ASSERT(true == template_->use_address);
+  VTR_ASSERT(true == template_->use_wl_address);
   (const_cast<FabricBitstreamMemoryBank*>(&memory_bank_data_))
-    ->fast_configuration(fast, bit_value_to_skip);
+    ->fast_configuration(fast, bit_value_to_skip, num_threads);
   return memory_bank_data_;
 }
 
+std::shared_ptr<const FabricBitstreamTemplate>
+FabricBitstream::bitstream_template() const {
+  return template_;
+}
+
+/* The template may be shared with other fabric bitstreams, but it is
+ * accounted as owned by each of them */
+MemoryUsage FabricBitstream::memory_usage() const {
+  MemoryUsage usage = heap_memory_usage(invalid_region_ids_);
+  usage += heap_memory_usage(invalid_bit_ids_);
+  usage += heap_memory_usage(bit_dins_);
+  usage += memory_bank_data_.memory_usage();
+  if (nullptr != template_) {
+    usage.used_bytes += sizeof(FabricBitstreamTemplate);
+    usage.allocated_bytes += sizeof(FabricBitstreamTemplate);
+    usage += heap_memory_usage(template_->region_bit_ids);
+    usage += heap_memory_usage(template_->config_bit_ids);
+    usage += heap_memory_usage(template_->bit_address_offsets);
+    usage += heap_memory_usage(template_->bit_address_num_words);
+    usage += heap_memory_usage(template_->address_1bits);
+    usage += heap_memory_usage(template_->address_xbits);
+    usage += heap_memory_usage(template_->bit_wl_address_offsets);
+    usage += heap_memory_usage(template_->bit_wl_address_num_words);
+    usage += heap_memory_usage(template_->wl_address_1bits);
+    usage += heap_memory_usage(template_->wl_address_xbits);
+    usage += template_->memory_bank.memory_usage();
+  }
+  return usage;
+}
+
 /******************************************************************************
  * Public Mutators
  ******************************************************************************/
 void FabricBitstream::reserve_bits(const size_t& num_bits) {
-  config_bit_ids_.reserve(num_bits);
+  FabricBitstreamTemplate& bitstream_template = mutable_template();
+  bitstream_template.config_bit_ids.reserve(num_bits);
 
-  if (true == use_address_) {
-    bit_address_1bits_.reserve(num_bits);
-    bit_address_xbits_.reserve(num_bits);
+  if (true == bitstream_template.use_address) {
+    bitstream_template.bit_address_offsets.reserve(num_bits);
+    bitstream_template.bit_address_num_words.reserve(num_bits);
     bit_dins_.reserve(num_bits);
 
-    if (true == use_wl_address_) {
-      bit_wl_address_1bits_.reserve(num_bits);
-      bit_wl_address_xbits_.reserve(num_bits);
+    if (true == bitstream_template.use_wl_address) {
+      bitstream_template.bit_wl_address_offsets.reserve(num_bits);
+      bitstream_template.bit_wl_address_num_words.reserve(num_bits);
     }
   }
 }
 
 FabricBitId FabricBitstream::add_bit(const ConfigBitId& config_bit_id) {
-  FabricBitId bit = FabricBitId(num_bits_);
+  FabricBitstreamTemplate& bitstream_template = mutable_template();
+  FabricBitId bit = FabricBitId(bitstream_template.config_bit_ids.size());
   /* Add a new bit, and allocate associated data structures */
-  num_bits_++;
-  config_bit_ids_.push_back(config_bit_id);
+  bitstream_template.config_bit_ids.push_back(config_bit_id);
 
-  if (true == use_address_) {
-    bit_address_1bits_.emplace_back();
-    bit_address_xbits_.emplace_back();
+  if (true == bitstream_template.use_address) {
+    bitstream_template.bit_address_offsets.push_back(0);
+    bitstream_template.bit_address_num_words.push_back(0);
     bit_dins_.emplace_back();
 
-    if (true == use_wl_address_) {
-      bit_wl_address_1bits_.emplace_back();
-      bit_wl_address_xbits_.emplace_back();
+    if (true == bitstream_template.use_wl_address) {
+      bitstream_template.bit_wl_address_offsets.push_back(0);
+      bitstream_template.bit_wl_address_num_words.push_back(0);
     }
   }
 
@@ -302,22 +559,18 @@ void FabricBitstream::set_bit_address(const FabricBitId& bit_id,
                                       const std::vector<char>& address,
                                       const bool& tolerant_short_address) {
   VTR_ASSERT(true == valid_bit_id(bit_id));
-  VTR_ASSERT(true == use_address_);
+  VTR_ASSERT(true == use_address());
+  FabricBitstreamTemplate& bitstream_template = mutable_template();
   if (tolerant_short_address) {
-    VTR_ASSERT(address_length_ >= address.size());
+    VTR_ASSERT(bitstream_template.address_length >= address.size());
   } else {
-    VTR_ASSERT(address_length_ == address.size());
-  }
-  /* Split the address into several 64 vectors */
-  for (size_t start_idx = 0; start_idx < address.size();
-       start_idx = start_idx + 64) {
-    size_t curr_end_idx = std::min(address.size(), start_idx + 64);
-    std::vector<char> curr_addr_vec64(address.begin() + start_idx,
-                                      address.begin() + curr_end_idx);
-    /* Encode bit '1' and bit 'x' into two numbers */
-    bit_address_1bits_[bit_id].push_back(encode_address_1bits(curr_addr_vec64));
-    bit_address_xbits_[bit_id].push_back(encode_address_xbits(curr_addr_vec64));
+    VTR_ASSERT(bitstream_template.address_length == address.size());
   }
+  bitstream_template.bit_address_offsets[bit_id] =
+    bitstream_template.address_1bits.size();
+  bitstream_template.bit_address_num_words[bit_id] =
+    encode_address(address, bitstream_template.address_1bits,
+                   bitstream_template.address_xbits);
 }
 
 void FabricBitstream::set_bit_bl_address(const FabricBitId& bit_id,
@@ -330,43 +583,41 @@ void FabricBitstream::set_bit_wl_address(const FabricBitId& bit_id,
                                          const std::vector<char>& address,
                                          const bool& tolerant_short_address) {
   VTR_ASSERT(true == valid_bit_id(bit_id));
-  VTR_ASSERT(true == use_address_);
-  VTR_ASSERT(true == use_wl_address_);
+  VTR_ASSERT(true == use_address());
+  VTR_ASSERT(true == use_wl_address());
+  FabricBitstreamTemplate& bitstream_template = mutable_template();
   if (tolerant_short_address) {
-    VTR_ASSERT(wl_address_length_ >= address.size());
+    VTR_ASSERT(bitstream_template.wl_address_length >= address.size());
   } else {
-    VTR_ASSERT(wl_address_length_ == address.size());
-  }
-  /* Split the address into several 64 vectors */
-  for (size_t start_idx = 0; start_idx < address.size();
-       start_idx = start_idx + 64) {
-    size_t curr_end_idx = std::min(address.size(), start_idx + 64);
-    std::vector<char> curr_addr_vec64(address.begin() + start_idx,
-                                      address.begin() + curr_end_idx);
-    /* Encode bit '1' and bit 'x' into two numbers */
-    bit_wl_address_1bits_[bit_id].push_back(
-      encode_address_1bits(curr_addr_vec64));
-    bit_wl_address_xbits_[bit_id].push_back(
-      encode_address_xbits(curr_addr_vec64));
+    VTR_ASSERT(bitstream_template.wl_address_length == address.size());
   }
+  bitstream_template.bit_wl_address_offsets[bit_id] =
+    bitstream_template.wl_address_1bits.size();
+  bitstream_template.bit_wl_address_num_words[bit_id] =
+    encode_address(address, bitstream_template.wl_address_1bits,
+                   bitstream_template.wl_address_xbits);
 }
 
 void FabricBitstream::set_bit_din(const FabricBitId& bit_id, const char& din) {
   VTR_ASSERT(true == valid_bit_id(bit_id));
-  VTR_ASSERT(true == use_address_);
+  VTR_ASSERT(true == use_address());
   bit_dins_[bit_id] = din;
+  /* Keep the compact memory bank database in sync */
+  if (true == memory_bank_data_.has_bit((fabric_size_t)(size_t)(bit_id))) {
+    memory_bank_data_.set_bit((fabric_size_t)(size_t)(bit_id), 0 != din);
+  }
 }
 
 void FabricBitstream::set_use_address(const bool& enable) {
   /* Add a lock, only can be modified when num bits are zero*/
-  if (0 == num_bits_) {
-    use_address_ = enable;
+  if (0 == num_bits()) {
+    mutable_template().use_address = enable;
   }
 }
 
 void FabricBitstream::set_address_length(const size_t& length) {
-  if (true == use_address_) {
-    address_length_ = length;
+  if (true == use_address()) {
+    mutable_template().address_length = length;
   }
 }
 
@@ -383,8 +634,8 @@ void FabricBitstream::set_memory_bank_info(const FabricBitId& bit_id,
   // Bit must be valid one
   // We only support this in protocol that use BL and WL address
   VTR_ASSERT(true == valid_bit_id(bit_id));
-  VTR_ASSERT(true == use_address_);
-  VTR_ASSERT(true == use_wl_address_);
+  VTR_ASSERT(true == use_address());
+  VTR_ASSERT(true == use_wl_address());
   VTR_ASSERT(bl_addr_size);
   VTR_ASSERT(wl_addr_size);
   // All the basic checking had passed, we can add the data into
@@ -393,30 +644,36 @@ void FabricBitstream::set_memory_bank_info(const FabricBitId& bit_id,
     (fabric_size_t)(size_t)(bit_id), (fabric_size_t)(size_t)(region_id),
     (fabric_size_t)(bl), (fabric_size_t)(wl), (fabric_size_t)(bl_addr_size),
     (fabric_size_t)(wl_addr_size), bit);
+  // The template only records the location of the bit
+  mutable_template().memory_bank.add_bit(
+    (fabric_size_t)(size_t)(bit_id), (fabric_size_t)(size_t)(region_id),
+    (fabric_size_t)(bl), (fabric_size_t)(wl), (fabric_size_t)(bl_addr_size),
+    (fabric_size_t)(wl_addr_size), false);
 }
 
 void FabricBitstream::set_use_wl_address(const bool& enable) {
   /* Add a lock, only can be modified when num bits are zero*/
-  if (0 == num_bits_) {
-    use_wl_address_ = enable;
+  if (0 == num_bits()) {
+    mutable_template().use_wl_address = enable;
   }
 }
 
 void FabricBitstream::set_wl_address_length(const size_t& length) {
-  if (true == use_address_) {
-    wl_address_length_ = length;
+  if (true == use_address()) {
+    mutable_template().wl_address_length = length;
   }
 }
 
 void FabricBitstream::reserve_regions(const size_t& num_regions) {
-  region_bit_ids_.reserve(num_regions);
+  mutable_template().region_bit_ids.reserve(num_regions);
 }
 
 FabricBitRegionId FabricBitstream::add_region() {
-  FabricBitRegionId region = FabricBitRegionId(num_regions_);
+  FabricBitstreamTemplate& bitstream_template = mutable_template();
+  FabricBitRegionId region =
+    FabricBitRegionId(bitstream_template.region_bit_ids.size());
   /* Add a new bit, and allocate associated data structures */
-  num_regions_++;
-  region_bit_ids_.emplace_back();
+  bitstream_template.region_bit_ids.emplace_back();
 
   return region;
 }
@@ -426,20 +683,26 @@ void FabricBitstream::add_bit_to_region(const FabricBitRegionId& region_id,
   VTR_ASSERT(true == valid_region_id(region_id));
   VTR_ASSERT(true == valid_bit_id(bit_id));
 
-  region_bit_ids_[region_id].push_back(bit_id);
+  mutable_template().region_bit_ids[region_id].push_back(bit_id);
 }
 
 void FabricBitstream::reverse() {
-  std::reverse(config_bit_ids_.begin(), config_bit_ids_.end());
-
-  if (true == use_address_) {
-    std::reverse(bit_address_1bits_.begin(), bit_address_1bits_.end());
-    std::reverse(bit_address_xbits_.begin(), bit_address_xbits_.end());
+  FabricBitstreamTemplate& bitstream_template = mutable_template();
+  std::reverse(bitstream_template.config_bit_ids.begin(),
+               bitstream_template.config_bit_ids.end());
+
+  if (true == bitstream_template.use_address) {
+    std::reverse(bitstream_template.bit_address_offsets.begin(),
+                 bitstream_template.bit_address_offsets.end());
+    std::reverse(bitstream_template.bit_address_num_words.begin(),
+                 bitstream_template.bit_address_num_words.end());
     std::reverse(bit_dins_.begin(), bit_dins_.end());
 
-    if (true == use_wl_address_) {
-      std::reverse(bit_wl_address_1bits_.begin(), bit_wl_address_1bits_.end());
-      std::reverse(bit_wl_address_xbits_.begin(), bit_wl_address_xbits_.end());
+    if (true == bitstream_template.use_wl_address) {
+      std::reverse(bitstream_template.bit_wl_address_offsets.begin(),
+                   bitstream_template.bit_wl_address_offsets.end());
+      std::reverse(bitstream_template.bit_wl_address_num_words.begin(),
+                   bitstream_template.bit_wl_address_num_words.end());
     }
   }
 }
@@ -447,64 +710,55 @@ void FabricBitstream::reverse() {
 void FabricBitstream::reverse_region_bits(const FabricBitRegionId& region_id) {
   VTR_ASSERT(true == valid_region_id(region_id));
 
-  std::reverse(region_bit_ids_[region_id].begin(),
-               region_bit_ids_[region_id].end());
+  FabricBitstreamTemplate& bitstream_template = mutable_template();
+  std::reverse(bitstream_template.region_bit_ids[region_id].begin(),
+               bitstream_template.region_bit_ids[region_id].end());
 }
 
 /******************************************************************************
  * Public Validators
  ******************************************************************************/
 bool FabricBitstream::valid_bit_id(const FabricBitId& bit_id) const {
-  return (size_t(bit_id) < num_bits_);
+  return (size_t(bit_id) < num_bits());
 }
 
 bool FabricBitstream::valid_region_id(
   const FabricBitRegionId& region_id) const {
-  return (size_t(region_id) < num_regions_);
+  return (size_t(region_id) < num_regions());
 }
 
-uint64_t FabricBitstream::encode_address_1bits(
-  const std::vector<char>& address) const {
-  /* Convert all the 'x' bit into 0 */
-  std::vector<char> binary_address = address;
-  for (char& bit : binary_address) {
-    if (bit == 'x') {
-      bit = '0';
-    }
-  }
-  /* Convert the binary address to a number */
-  return (uint64_t)bintoi_charvec(binary_address);
-}
-
-uint64_t FabricBitstream::encode_address_xbits(
-  const std::vector<char>& address) const {
-  /* Convert all the '1' bit into 0 and Convert all the 'x' bit into 1 */
-  std::vector<char> binary_address = address;
-  for (char& bit : binary_address) {
-    if (bit == '1') {
-      bit = '0';
-    }
-    if (bit == 'x') {
-      bit = '1';
+/******************************************************************************
+ * Private APIs
+ ******************************************************************************/
+size_t FabricBitstream::encode_address(const std::vector<char>& address,
+                                       std::vector<uint64_t>& bits1,
+                                       std::vector<uint64_t>& bitsx) const {
+  /* Split the address into several 64-bit words, where the first bit of the
+   * address is the LSB of the first word */
+  size_t num_words = 0;
+  for (size_t start_idx = 0; start_idx < address.size();
+       start_idx = start_idx + 64) {
+    size_t curr_end_idx = std::min(address.size(), start_idx + 64);
+    /* Encode bit '1' and bit 'x' into two numbers */
+    uint64_t curr_bits1 = 0;
+    uint64_t curr_bitsx = 0;
+    for (size_t idx = start_idx; idx < curr_end_idx; ++idx) {
+      curr_bits1 |= uint64_t('1' == address[idx]) << (idx - start_idx);
+      curr_bitsx |= uint64_t('x' == address[idx]) << (idx - start_idx);
     }
+    bits1.push_back(curr_bits1);
+    bitsx.push_back(curr_bitsx);
+    num_words++;
   }
-  /* Convert the binary address to a number */
-  return (uint64_t)bintoi_charvec(binary_address);
+  return num_words;
 }
 
-std::vector<char> FabricBitstream::decode_address_bits(
-  const size_t& bit1, const size_t& bitx, const size_t& addr_len) const {
-  /* Decode the bit1 number to a binary vector */
-  std::vector<char> ret_vec = itobin_charvec(bit1, addr_len);
-  /* Decode the bitx number to a binary vector */
-  std::vector<char> bitx_vec = itobin_charvec(bitx, addr_len);
-  /* Combine the two vectors: 'x' overwrite any bit '0' and '1' */
-  for (size_t ibit = 0; ibit < ret_vec.size(); ++ibit) {
-    if (bitx_vec[ibit] == '1') {
-      ret_vec[ibit] = 'x';
-    }
+FabricBitstreamTemplate& FabricBitstream::mutable_template() {
+  /* Copy on write: other fabric bitstreams still see the original one */
+  if (1 < template_.use_count()) {
+    template_ = std::make_shared<FabricBitstreamTemplate>(*template_);
   }
-  return ret_vec;
+  return *template_;
 }
 
 } /* end namespace openfpga */
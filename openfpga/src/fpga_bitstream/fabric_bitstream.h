@@ -30,12 +30,17 @@
 #ifndef FABRIC_BITSTREAM_H
 #define FABRIC_BITSTREAM_H
 
+#include <istream>
+#include <memory>
+#include <ostream>
+#include <string>
 #include <unordered_map>
 #include <unordered_set>
 #include <vector>
 
 #include "bitstream_manager_fwd.h"
 #include "fabric_bitstream_fwd.h"
+#include "openfpga_memory_usage.h"
 #include "vtr_vector.h"
 
 /* begin namespace openfpga */
@@ -51,7 +56,7 @@ struct fabric_bit_data {
   const fabric_size_t region = 0;
   const fabric_size_t bl = 0;
   const fabric_size_t wl = 0;
-  const bool bit = false;
+  bool bit = false;
 };
 struct fabric_blwl_length {
   fabric_blwl_length(fabric_size_t b, fabric_size_t w) : bl(b), wl(w) {}
@@ -67,10 +72,21 @@ struct FabricBitstreamMemoryBank {
                const fabric_size_t& bl, const fabric_size_t& wl,
                const fabric_size_t& bl_addr_size,
                const fabric_size_t& wl_addr_size, bool bit);
-  void fast_configuration(const bool& fast, const bool& bit_value_to_skip);
+  /* Change the value of a bit which is already added */
+  void set_bit(const fabric_size_t& bit_id, bool bit);
+  /* Check if a bit is already added */
+  bool has_bit(const fabric_size_t& bit_id) const;
+  void fast_configuration(const bool& fast, const bool& bit_value_to_skip,
+                          const size_t& num_threads = 1);
   fabric_size_t get_longest_effective_wl_count() const;
   fabric_size_t get_total_bl_addr_size() const;
   fabric_size_t get_total_wl_addr_size() const;
+  /* Hash of the values of the bits used by a WL of a region, e.g., to find
+   * the WLs which are not changed between two bitstreams of the same fabric.
+   * Don't care bits do not change the hash */
+  size_t wl_hash(const fabric_size_t& region, const fabric_size_t& wl) const;
+  /* Approximate heap memory used by the database */
+  MemoryUsage memory_usage() const;
 
   /*************************
    * All the database (except fabric_bit_datas) is sorted by region
@@ -120,6 +136,100 @@ struct FabricBitstreamMemoryBank {
   std::vector<std::vector<fabric_size_t>> wls_to_skip;
 };
 
+/********************************************************************
+ * A read-only view on the encoded address of a configuration bit, which
+ * decodes the address bits on demand without copying the encoded words.
+ * See the encoding strategy of addresses in FabricBitstream
+ *******************************************************************/
+class FabricBitAddressView {
+ public: /* Public constructor */
+  FabricBitAddressView(const uint64_t* bits1, const uint64_t* bitsx,
+                       const size_t& num_words, const size_t& length);
+
+ public: /* Public accessors */
+  /* Number of bits of the decoded address */
+  size_t size() const;
+  /* Decode a bit of the address to '0', '1' or 'x' */
+  char operator[](const size_t& ibit) const;
+  std::string to_string() const;
+
+  /* Encoded words: each word contains up to 64 address bits, where the
+   * first bit of the word is the LSB */
+  size_t num_words() const;
+  size_t word_size(const size_t& iword) const;
+  uint64_t word_1bits(const size_t& iword) const;
+  uint64_t word_xbits(const size_t& iword) const;
+
+ private: /* Internal data */
+  const uint64_t* bits1_;
+  const uint64_t* bitsx_;
+  size_t num_words_;
+  size_t length_;
+};
+
+/********************************************************************
+ * The fabric-only part of a fabric bitstream, i.e., the sequence of the
+ * configuration bits, their regions and their addresses, which only depend
+ * on the FPGA fabric and its configuration protocol but not on the user
+ * design. A template is shared by the fabric bitstreams of all the designs
+ * implemented on the same fabric, which only own the values of the bits.
+ *******************************************************************/
+struct FabricBitstreamTemplate {
+  /* Fabric bits of each configuration region */
+  vtr::vector<FabricBitRegionId, std::vector<FabricBitId>> region_bit_ids;
+
+  /* Configuration bit id in architecture bitstream database of each fabric
+   * bit */
+  vtr::vector<FabricBitId, ConfigBitId> config_bit_ids;
+
+  /* Flags to indicate if the addresses and din should be enabled */
+  bool use_address = false;
+  bool use_wl_address = false;
+
+  size_t address_length = 0;
+  size_t wl_address_length = 0;
+
+  /* Address bits: this is designed for memory decoders
+   * Here we store the encoded format of the address, and decoded to binary
+   * format which can be loaded to the configuration protocol directly
+   *
+   * Encoding strategy is as follows:
+   * - An address bit which may contain '0', '1', 'x'. For example
+   *     101x1
+   * - The string can be encoded into two integer numbers:
+   *   - bit-one number: which encodes the '0' and '1' bits into a number. For
+   * example, 101x1 -> 10101 -> 21
+   *   - bit-x number: which encodes the 'x' bits into a number. For example,
+   *       101x1 -> 00010 -> 2
+   *
+   * Note that when the length of address vector is more than 64, we use
+   * multiple 64-bit data to store the encoded values
+   *
+   * The encoded words of all the bits are stored contiguously in pools,
+   * while each bit only keeps the offset of its first word and the number of
+   * its words. This avoids a heap allocation per bit.
+   */
+  vtr::vector<FabricBitId, size_t> bit_address_offsets;
+  vtr::vector<FabricBitId, fabric_size_t> bit_address_num_words;
+  std::vector<uint64_t> address_1bits;
+  std::vector<uint64_t> address_xbits;
+  vtr::vector<FabricBitId, size_t> bit_wl_address_offsets;
+  vtr::vector<FabricBitId, fabric_size_t> bit_wl_address_num_words;
+  std::vector<uint64_t> wl_address_1bits;
+  std::vector<uint64_t> wl_address_xbits;
+
+  /* BL/WL of each bit for the memory bank protocol, where all the bits are
+   * kept as '0' */
+  FabricBitstreamMemoryBank memory_bank;
+
+  /* Dump the template to a binary stream, to be loaded back by read_binary()
+   */
+  void write_binary(std::ostream& fp) const;
+  /* Load a template from a binary stream, which is created by write_binary()
+   */
+  void read_binary(std::istream& fp);
+};
+
 class FabricBitstream {
  public: /* Type implementations */
   /*
@@ -195,6 +305,9 @@ class FabricBitstream {
 
  public: /* Public constructor */
   FabricBitstream();
+  /* Create a fabric bitstream on a template, where all the bits are '0' */
+  explicit FabricBitstream(
+    const std::shared_ptr<const FabricBitstreamTemplate>& bitstream_template);
 
  public: /* Public aggregators */
   /* Find all the configuration bits */
@@ -206,6 +319,8 @@ class FabricBitstream {
   fabric_bit_region_range regions() const;
   std::vector<FabricBitId> region_bits(
     const FabricBitRegionId& region_id) const;
+  /* Find the number of bits of a region, without listing them */
+  size_t num_region_bits(const FabricBitRegionId& region_id) const;
 
  public: /* Public Accessors */
   /* Find the configuration bit id in architecture bitstream database */
@@ -216,6 +331,12 @@ class FabricBitstream {
   std::vector<char> bit_bl_address(const FabricBitId& bit_id) const;
   std::vector<char> bit_wl_address(const FabricBitId& bit_id) const;
 
+  /* Find the address of bitstream without decoding it. The view is valid
+   * until any address is added to the fabric bitstream */
+  FabricBitAddressView bit_address_view(const FabricBitId& bit_id) const;
+  FabricBitAddressView bit_bl_address_view(const FabricBitId& bit_id) const;
+  FabricBitAddressView bit_wl_address_view(const FabricBitId& bit_id) const;
+
   /* Find the data-in of bitstream */
   char bit_din(const FabricBitId& bit_id) const;
 
@@ -224,7 +345,15 @@ class FabricBitstream {
   bool use_wl_address() const;
 
   const FabricBitstreamMemoryBank& memory_bank_info(
-    const bool& fast = false, const bool& bit_value_to_skip = false) const;
+    const bool& fast = false, const bool& bit_value_to_skip = false,
+    const size_t& num_threads = 1) const;
+
+  /* The fabric-only part of the bitstream, which can be reused to create
+   * the fabric bitstreams of other designs on the same fabric */
+  std::shared_ptr<const FabricBitstreamTemplate> bitstream_template() const;
+
+  /* Approximate heap memory used by the data structure */
+  MemoryUsage memory_usage() const;
 
  public: /* Public Mutators */
   /* Reserve config bits */
@@ -298,49 +427,22 @@ class FabricBitstream {
   bool valid_region_id(const FabricBitRegionId& bit_id) const;
 
  private: /* Private APIs */
-  uint64_t encode_address_1bits(const std::vector<char>& address) const;
-  uint64_t encode_address_xbits(const std::vector<char>& address) const;
-  std::vector<char> decode_address_bits(const size_t& bit1, const size_t& bitx,
-                                        const size_t& addr_len) const;
+  /* Encode an address and append the words to the given pools. Return the
+   * number of words */
+  size_t encode_address(const std::vector<char>& address,
+                        std::vector<uint64_t>& bits1,
+                        std::vector<uint64_t>& bitsx) const;
+  /* Template to be modified, which is copied first when it is shared with
+   * other fabric bitstreams */
+  FabricBitstreamTemplate& mutable_template();
 
  private: /* Internal data */
-  /* Unique id of a region in the Bitstream */
-  size_t num_regions_;
+  /* Ids are never invalidated, the sets are kept for the lazy iterators */
   std::unordered_set<FabricBitRegionId> invalid_region_ids_;
-  vtr::vector<FabricBitRegionId, std::vector<FabricBitId>> region_bit_ids_;
-
-  /* Unique id of a bit in the Bitstream */
-  size_t num_bits_;
   std::unordered_set<FabricBitId> invalid_bit_ids_;
-  vtr::vector<FabricBitId, ConfigBitId> config_bit_ids_;
 
-  /* Flags to indicate if the addresses and din should be enabled */
-  bool use_address_;
-  bool use_wl_address_;
-
-  size_t address_length_;
-  size_t wl_address_length_;
-
-  /* Address bits: this is designed for memory decoders
-   * Here we store the encoded format of the address, and decoded to binary
-   * format which can be loaded to the configuration protocol directly
-   *
-   * Encoding strategy is as follows:
-   * - An address bit which may contain '0', '1', 'x'. For example
-   *     101x1
-   * - The string can be encoded into two integer numbers:
-   *   - bit-one number: which encodes the '0' and '1' bits into a number. For
-   * example, 101x1 -> 10101 -> 21
-   *   - bit-x number: which encodes the 'x' bits into a number. For example,
-   *       101x1 -> 00010 -> 2
-   *
-   * Note that when the length of address vector is more than 64, we use
-   * multiple 64-bit data to store the encoded values
-   */
-  vtr::vector<FabricBitId, std::vector<uint64_t>> bit_address_1bits_;
-  vtr::vector<FabricBitId, std::vector<uint64_t>> bit_address_xbits_;
-  vtr::vector<FabricBitId, std::vector<uint64_t>> bit_wl_address_1bits_;
-  vtr::vector<FabricBitId, std::vector<uint64_t>> bit_wl_address_xbits_;
+  /* Sequence, regions and addresses of the bits */
+  std::shared_ptr<FabricBitstreamTemplate> template_;
 
   /* Data input (Din) bits: this is designed for memory decoders */
   vtr::vector<FabricBitId, char> bit_dins_;
@@ -0,0 +1,156 @@
+/********************************************************************
+ * Save the template of a fabric bitstream, i.e., the sequence, the regions and
+ * the addresses of its bits, to a binary file, and load it back. As the
+ * template only depends on the FPGA fabric, a flow implementing many designs
+ * on the same fabric can skip the walk through the fabric and only gather the
+ * values of the bits from the bitstream database of each design.
+ *
+ * The file starts with a magic word, the format version and a key which is
+ * computed by the caller from the fabric, followed by the template (see
+ * FabricBitstreamTemplate::write_binary())
+ *******************************************************************/
+#include <cstring>
+#include <fstream>
+
+/* Headers from vtrutil library */
+#include "vtr_assert.h"
+#include "vtr_log.h"
+#include "vtr_time.h"
+
+/* Headers from openfpgautil library */
+#include "command_exit_codes.h"
+#include "fabric_bitstream_template_file.h"
+#include "openfpga_binary_io.h"
+#include "openfpga_digest.h"
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+/* Identify the type of file; change the version whenever the layout of the
+ * template changes */
+constexpr char FABRIC_BITSTREAM_TEMPLATE_MAGIC[] = "OFPGAFBT";
+constexpr size_t FABRIC_BITSTREAM_TEMPLATE_MAGIC_SIZE =
+  sizeof(FABRIC_BITSTREAM_TEMPLATE_MAGIC) - 1;
+constexpr uint32_t FABRIC_BITSTREAM_TEMPLATE_VERSION = 1;
+
+/********************************************************************
+ * Write the template of a fabric bitstream to a binary file
+ *
+ * Return 0 if successful
+ * Return 1 if fail when creating files
+ *******************************************************************/
+int write_fabric_bitstream_template(
+  const std::string& fname, const size_t& key,
+  const FabricBitstreamTemplate& bitstream_template, const bool& verbose) {
+  std::string timer_message =
+    std::string("Write fabric bitstream template to binary file '") + fname +
+    std::string("'");
+
+  std::string dir_path = format_dir_path(find_path_dir_name(fname));
+
+  /* Create directories */
+  create_directory(dir_path);
+
+  /* Start time count */
+  vtr::ScopedStartFinishTimer timer(timer_message);
+
+  VTR_ASSERT(true != fname.empty());
+
+  /* Create a file handler*/
+  std::fstream fp;
+  /* Open a file */
+  fp.open(fname, std::fstream::out | std::fstream::trunc |
+                   std::fstream::binary);
+
+  /* Validate the file stream */
+  check_file_stream(fname.c_str(), fp);
+
+  fp.write(FABRIC_BITSTREAM_TEMPLATE_MAGIC,
+           FABRIC_BITSTREAM_TEMPLATE_MAGIC_SIZE);
+  write_binary_data(fp, FABRIC_BITSTREAM_TEMPLATE_VERSION);
+  write_binary_data(fp, uint64_t(key));
+  bitstream_template.write_binary(fp);
+
+  if (false == fp.good()) {
+    VTR_LOG_ERROR("Fail to write fabric bitstream template to file '%s'!\n",
+                  fname.c_str());
+    fp.close();
+    return CMD_EXEC_FATAL_ERROR;
+  }
+  VTR_LOGV(verbose, "Written %lu configuration bits\n",
+           bitstream_template.config_bit_ids.size());
+
+  /* close a file */
+  fp.close();
+
+  return CMD_EXEC_SUCCESS;
+}
+
+/********************************************************************
+ * Read the template of a fabric bitstream from a binary file.
+ * The template is not touched unless the file is created by the same version
+ * with the same key as the given one.
+ *
+ * Return 0 if successful
+ * Return 1 if the file is corrupted
+ * Return 2 if the file does not exist or is outdated, which means that the
+ * fabric bitstream should be built from scratch
+ *******************************************************************/
+int read_fabric_bitstream_template(
+  const std::string& fname, const size_t& key,
+  std::shared_ptr<const FabricBitstreamTemplate>& bitstream_template,
+  const bool& verbose) {
+  std::string timer_message =
+    std::string("Read fabric bitstream template from binary file '") + fname +
+    std::string("'");
+
+  /* Start time count */
+  vtr::ScopedStartFinishTimer timer(timer_message);
+
+  std::fstream fp;
+  fp.open(fname, std::fstream::in | std::fstream::binary);
+  if (false == valid_file_stream(fp)) {
+    VTR_LOG("Fabric bitstream template '%s' does not exist\n", fname.c_str());
+    return CMD_EXEC_MINOR_ERROR;
+  }
+
+  /* Header */
+  char magic[FABRIC_BITSTREAM_TEMPLATE_MAGIC_SIZE];
+  uint32_t version = 0;
+  uint64_t file_key = 0;
+  fp.read(magic, FABRIC_BITSTREAM_TEMPLATE_MAGIC_SIZE);
+  read_binary_data(fp, version);
+  read_binary_data(fp, file_key);
+  if ((false == fp.good()) ||
+      (0 != std::memcmp(magic, FABRIC_BITSTREAM_TEMPLATE_MAGIC,
+                        FABRIC_BITSTREAM_TEMPLATE_MAGIC_SIZE))) {
+    VTR_LOG_ERROR("File '%s' is not a fabric bitstream template!\n",
+                  fname.c_str());
+    return CMD_EXEC_FATAL_ERROR;
+  }
+  if ((FABRIC_BITSTREAM_TEMPLATE_VERSION != version) ||
+      (uint64_t(key) != file_key)) {
+    VTR_LOG(
+      "Fabric bitstream template '%s' was not created for the current "
+      "fabric\n",
+      fname.c_str());
+    return CMD_EXEC_MINOR_ERROR;
+  }
+
+  std::shared_ptr<FabricBitstreamTemplate> file_template =
+    std::make_shared<FabricBitstreamTemplate>();
+  file_template->read_binary(fp);
+  if (false == fp.good()) {
+    VTR_LOG_ERROR("Fabric bitstream template '%s' is corrupted!\n",
+                  fname.c_str());
+    return CMD_EXEC_FATAL_ERROR;
+  }
+  VTR_LOGV(verbose, "Read %lu configuration bits\n",
+           file_template->config_bit_ids.size());
+
+  bitstream_template = file_template;
+
+  return CMD_EXEC_SUCCESS;
+}
+
+} /* end namespace openfpga */
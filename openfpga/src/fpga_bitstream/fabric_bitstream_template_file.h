@@ -0,0 +1,30 @@
+#ifndef FABRIC_BITSTREAM_TEMPLATE_FILE_H
+#define FABRIC_BITSTREAM_TEMPLATE_FILE_H
+
+/********************************************************************
+ * Include header files that are required by function declaration
+ *******************************************************************/
+#include <memory>
+#include <string>
+
+#include "fabric_bitstream.h"
+
+/********************************************************************
+ * Function declaration
+ *******************************************************************/
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+int write_fabric_bitstream_template(
+  const std::string& fname, const size_t& key,
+  const FabricBitstreamTemplate& bitstream_template, const bool& verbose);
+
+int read_fabric_bitstream_template(
+  const std::string& fname, const size_t& key,
+  std::shared_ptr<const FabricBitstreamTemplate>& bitstream_template,
+  const bool& verbose);
+
+} /* end namespace openfpga */
+
+#endif
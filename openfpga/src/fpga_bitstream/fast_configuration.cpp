@@ -36,6 +36,34 @@ bool is_fast_configuration_applicable(
   return true;
 }
 
+/********************************************************************
+ * Pick the signal which brings the bigger reduction, given the number of
+ * logic '0' and logic '1' bits that can be skipped by either signal
+ *******************************************************************/
+static bool select_bit_value_to_skip_for_fast_configuration(
+  const size_t& num_zeros_to_skip, const size_t& num_ones_to_skip,
+  const size_t& num_bits) {
+  bool bit_value_to_skip = false;
+
+  VTR_LOG("Using reset will skip %g% (%lu/%lu) of configuration bitstream.\n",
+          100. * (float)num_zeros_to_skip / (float)num_bits, num_zeros_to_skip,
+          num_bits);
+
+  VTR_LOG("Using set will skip %g% (%lu/%lu) of configuration bitstream.\n",
+          100. * (float)num_ones_to_skip / (float)num_bits, num_ones_to_skip,
+          num_bits);
+
+  /* By default, we prefer to skip zeros (when the numbers are the same */
+  if (num_ones_to_skip > num_zeros_to_skip) {
+    VTR_LOG("Will use set signal in fast configuration\n");
+    bit_value_to_skip = true;
+  } else {
+    VTR_LOG("Will use reset signal in fast configuration\n");
+  }
+
+  return bit_value_to_skip;
+}
+
 /********************************************************************
  * Decide if we should use reset or set signal to acheive fast configuration
  * - If only one type signal is specified, we use that type
@@ -66,7 +94,6 @@ bool find_bit_value_to_skip_for_fast_configuration(
    * applicable */
   VTR_ASSERT(!global_prog_set_ports.empty() &&
              !global_prog_reset_ports.empty());
-  bool bit_value_to_skip = false;
 
   VTR_LOG(
     "Both reset and set ports are defined for programming controls, selecting "
@@ -125,23 +152,71 @@ bool find_bit_value_to_skip_for_fast_configuration(
       exit(1);
   }
 
-  VTR_LOG("Using reset will skip %g% (%lu/%lu) of configuration bitstream.\n",
-          100. * (float)num_zeros_to_skip / (float)fabric_bitstream.num_bits(),
-          num_zeros_to_skip, fabric_bitstream.num_bits());
+  return select_bit_value_to_skip_for_fast_configuration(
+    num_zeros_to_skip, num_ones_to_skip, fabric_bitstream.num_bits());
+}
 
-  VTR_LOG("Using set will skip %g% (%lu/%lu) of configuration bitstream.\n",
-          100. * (float)num_ones_to_skip / (float)fabric_bitstream.num_bits(),
-          num_ones_to_skip, fabric_bitstream.num_bits());
+/********************************************************************
+ * Count the number of bits with a given value at the beginning of the
+ * regional bit values, when the regions are put one after another
+ *******************************************************************/
+static size_t count_leading_bits_in_regions(
+  const std::vector<std::vector<bool>>& region_bit_values,
+  const bool& bit_value) {
+  size_t num_bits = 0;
+  for (const std::vector<bool>& bit_values : region_bit_values) {
+    for (const bool& curr_bit_value : bit_values) {
+      if (bit_value != curr_bit_value) {
+        return num_bits;
+      }
+      num_bits++;
+    }
+  }
+  return num_bits;
+}
 
-  /* By default, we prefer to skip zeros (when the numbers are the same */
-  if (num_ones_to_skip > num_zeros_to_skip) {
-    VTR_LOG("Will use set signal in fast configuration\n");
-    bit_value_to_skip = true;
-  } else {
-    VTR_LOG("Will use reset signal in fast configuration\n");
+/********************************************************************
+ * Same as find_bit_value_to_skip_for_fast_configuration() for a
+ * configuration chain, whose bit values are given per region, in the order
+ * in which the regions and their bits are added to a fabric bitstream.
+ * This is used when no fabric bitstream is built
+ *******************************************************************/
+bool find_config_chain_bit_value_to_skip_for_fast_configuration(
+  const FabricGlobalPortInfo& global_ports,
+  const std::vector<std::vector<bool>>& region_bit_values) {
+  /* Preparation: find all the reset/set ports for programming usage */
+  std::vector<FabricGlobalPortId> global_prog_reset_ports =
+    find_fabric_global_programming_reset_ports(global_ports);
+  std::vector<FabricGlobalPortId> global_prog_set_ports =
+    find_fabric_global_programming_set_ports(global_ports);
+
+  /* Early exit conditions */
+  if (!global_prog_reset_ports.empty() && global_prog_set_ports.empty()) {
+    return false;
+  } else if (!global_prog_set_ports.empty() &&
+             global_prog_reset_ports.empty()) {
+    return true;
   }
 
-  return bit_value_to_skip;
+  VTR_ASSERT(!global_prog_set_ports.empty() &&
+             !global_prog_reset_ports.empty());
+
+  VTR_LOG(
+    "Both reset and set ports are defined for programming controls, selecting "
+    "the best-fit one...\n");
+
+  /* We can only skip the ones/zeros at the beginning of the bitstream */
+  size_t num_bits = 0;
+  for (const std::vector<bool>& bit_values : region_bit_values) {
+    num_bits += bit_values.size();
+  }
+  size_t num_zeros_to_skip =
+    count_leading_bits_in_regions(region_bit_values, false);
+  size_t num_ones_to_skip =
+    count_leading_bits_in_regions(region_bit_values, true);
+
+  return select_bit_value_to_skip_for_fast_configuration(
+    num_zeros_to_skip, num_ones_to_skip, num_bits);
 }
 
 } /* end namespace openfpga */
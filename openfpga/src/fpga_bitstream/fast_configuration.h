@@ -27,6 +27,10 @@ bool find_bit_value_to_skip_for_fast_configuration(
   const BitstreamManager& bitstream_manager,
   const FabricBitstream& fabric_bitstream);
 
+bool find_config_chain_bit_value_to_skip_for_fast_configuration(
+  const FabricGlobalPortInfo& global_ports,
+  const std::vector<std::vector<bool>>& region_bit_values);
+
 } /* end namespace openfpga */
 
 #endif
@@ -19,40 +19,70 @@ size_t MemoryBankShiftRegisterFabricBitstream::bl_word_size() const {
   /* For a fast runtime, we just inspect the last element
    * It is the validator which should ensure all the words have a uniform size
    */
-  return bitstream_word_bls_[bitstream_word_ids_.back()].size();
+  return bitstream_word_bls_[bitstream_word_ids_.back()].num_vectors;
 }
 
 size_t MemoryBankShiftRegisterFabricBitstream::wl_word_size() const {
   /* For a fast runtime, we just inspect the last element
    * It is the validator which should ensure all the words have a uniform size
    */
-  return bitstream_word_wls_[bitstream_word_ids_.back()].size();
+  return bitstream_word_wls_[bitstream_word_ids_.back()].num_vectors;
 }
 
 size_t MemoryBankShiftRegisterFabricBitstream::bl_width() const {
   /* For a fast runtime, we just inspect the last element
    * It is the validator which should ensure all the words have a uniform size
    */
-  return bitstream_word_bls_[bitstream_word_ids_.back()].back().size();
+  return bitstream_word_bls_[bitstream_word_ids_.back()].width;
 }
 
 size_t MemoryBankShiftRegisterFabricBitstream::wl_width() const {
   /* For a fast runtime, we just inspect the last element
    * It is the validator which should ensure all the words have a uniform size
    */
-  return bitstream_word_wls_[bitstream_word_ids_.back()].back().size();
+  return bitstream_word_wls_[bitstream_word_ids_.back()].width;
 }
 
 std::vector<std::string> MemoryBankShiftRegisterFabricBitstream::bl_vectors(
   const MemoryBankShiftRegisterFabricBitstreamWordId& word_id) const {
   VTR_ASSERT(valid_word_id(word_id));
-  return bitstream_word_bls_[word_id];
+  const BitMatrix& matrix = bitstream_word_bls_[word_id];
+  std::vector<std::string> vectors;
+  vectors.reserve(matrix.num_vectors);
+  for (size_t ivec = 0; ivec < matrix.num_vectors; ++ivec) {
+    vectors.push_back(bit_matrix_vector(matrix, ivec));
+  }
+  return vectors;
 }
 
 std::vector<std::string> MemoryBankShiftRegisterFabricBitstream::wl_vectors(
   const MemoryBankShiftRegisterFabricBitstreamWordId& word_id) const {
   VTR_ASSERT(valid_word_id(word_id));
-  return bitstream_word_wls_[word_id];
+  const BitMatrix& matrix = bitstream_word_wls_[word_id];
+  std::vector<std::string> vectors;
+  vectors.reserve(matrix.num_vectors);
+  for (size_t ivec = 0; ivec < matrix.num_vectors; ++ivec) {
+    vectors.push_back(bit_matrix_vector(matrix, ivec));
+  }
+  return vectors;
+}
+
+std::string MemoryBankShiftRegisterFabricBitstream::bl_vector(
+  const MemoryBankShiftRegisterFabricBitstreamWordId& word_id,
+  const size_t& vec_index) const {
+  VTR_ASSERT(valid_word_id(word_id));
+  return bit_matrix_vector(bitstream_word_bls_[word_id], vec_index);
+}
+
+std::string MemoryBankShiftRegisterFabricBitstream::wl_vector(
+  const MemoryBankShiftRegisterFabricBitstreamWordId& word_id,
+  const size_t& vec_index) const {
+  VTR_ASSERT(valid_word_id(word_id));
+  return bit_matrix_vector(bitstream_word_wls_[word_id], vec_index);
+}
+
+char MemoryBankShiftRegisterFabricBitstream::dont_care_bit() const {
+  return dont_care_bit_;
 }
 
 MemoryBankShiftRegisterFabricBitstreamWordId
@@ -70,18 +100,41 @@ MemoryBankShiftRegisterFabricBitstream::create_word() {
   return word_id;
 }
 
-void MemoryBankShiftRegisterFabricBitstream::add_bl_vectors(
+void MemoryBankShiftRegisterFabricBitstream::set_dont_care_bit(
+  const char& dont_care_bit) {
+  dont_care_bit_ = dont_care_bit;
+}
+
+void MemoryBankShiftRegisterFabricBitstream::resize_bl_vectors(
+  const MemoryBankShiftRegisterFabricBitstreamWordId& word_id,
+  const size_t& num_vectors, const size_t& width) {
+  VTR_ASSERT(valid_word_id(word_id));
+  resize_bit_matrix(bitstream_word_bls_[word_id], num_vectors, width);
+}
+
+void MemoryBankShiftRegisterFabricBitstream::resize_wl_vectors(
+  const MemoryBankShiftRegisterFabricBitstreamWordId& word_id,
+  const size_t& num_vectors, const size_t& width) {
+  VTR_ASSERT(valid_word_id(word_id));
+  resize_bit_matrix(bitstream_word_wls_[word_id], num_vectors, width);
+}
+
+void MemoryBankShiftRegisterFabricBitstream::set_bl_vector_block(
   const MemoryBankShiftRegisterFabricBitstreamWordId& word_id,
-  const std::string& bl_vec) {
+  const size_t& vec_index, const size_t& block_index, const uint64_t& values,
+  const uint64_t& care_mask) {
   VTR_ASSERT(valid_word_id(word_id));
-  return bitstream_word_bls_[word_id].push_back(bl_vec);
+  set_bit_matrix_block(bitstream_word_bls_[word_id], vec_index, block_index,
+                       values, care_mask);
 }
 
-void MemoryBankShiftRegisterFabricBitstream::add_wl_vectors(
+void MemoryBankShiftRegisterFabricBitstream::set_wl_vector_block(
   const MemoryBankShiftRegisterFabricBitstreamWordId& word_id,
-  const std::string& wl_vec) {
+  const size_t& vec_index, const size_t& block_index, const uint64_t& values,
+  const uint64_t& care_mask) {
   VTR_ASSERT(valid_word_id(word_id));
-  return bitstream_word_wls_[word_id].push_back(wl_vec);
+  set_bit_matrix_block(bitstream_word_wls_[word_id], vec_index, block_index,
+                       values, care_mask);
 }
 
 bool MemoryBankShiftRegisterFabricBitstream::valid_word_id(
@@ -90,4 +143,42 @@ bool MemoryBankShiftRegisterFabricBitstream::valid_word_id(
          (word_id == bitstream_word_ids_[word_id]);
 }
 
+/******************************************************************************
+ * Internal utility
+ ******************************************************************************/
+void MemoryBankShiftRegisterFabricBitstream::resize_bit_matrix(
+  BitMatrix& matrix, const size_t& num_vectors, const size_t& width) {
+  matrix.num_vectors = num_vectors;
+  matrix.width = width;
+  matrix.num_blocks_per_vector = (width + 63) / 64;
+  matrix.values.assign(num_vectors * matrix.num_blocks_per_vector, 0);
+  matrix.care_masks.assign(num_vectors * matrix.num_blocks_per_vector, 0);
+}
+
+void MemoryBankShiftRegisterFabricBitstream::set_bit_matrix_block(
+  BitMatrix& matrix, const size_t& vec_index, const size_t& block_index,
+  const uint64_t& values, const uint64_t& care_mask) {
+  VTR_ASSERT(vec_index < matrix.num_vectors);
+  VTR_ASSERT(block_index < matrix.num_blocks_per_vector);
+  size_t offset = vec_index * matrix.num_blocks_per_vector + block_index;
+  matrix.values[offset] = values & care_mask;
+  matrix.care_masks[offset] = care_mask;
+}
+
+std::string MemoryBankShiftRegisterFabricBitstream::bit_matrix_vector(
+  const BitMatrix& matrix, const size_t& vec_index) const {
+  VTR_ASSERT(vec_index < matrix.num_vectors);
+  std::string vec(matrix.width, dont_care_bit_);
+  size_t offset = vec_index * matrix.num_blocks_per_vector;
+  for (size_t ibit = 0; ibit < matrix.width; ++ibit) {
+    uint64_t mask = uint64_t(1) << (ibit % 64);
+    size_t iblock = offset + ibit / 64;
+    if (0 == (matrix.care_masks[iblock] & mask)) {
+      continue;
+    }
+    vec[ibit] = (0 == (matrix.values[iblock] & mask)) ? '0' : '1';
+  }
+  return vec;
+}
+
 } /* end namespace openfpga */
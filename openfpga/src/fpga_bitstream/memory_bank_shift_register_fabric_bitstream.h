@@ -1,6 +1,7 @@
 #ifndef MEMORY_BANK_SHIFT_REGISTER_FABRIC_BITSTREAM_H
 #define MEMORY_BANK_SHIFT_REGISTER_FABRIC_BITSTREAM_H
 
+#include <cstdint>
 #include <map>
 #include <string>
 #include <vector>
@@ -57,24 +58,81 @@ class MemoryBankShiftRegisterFabricBitstream {
   std::vector<std::string> wl_vectors(
     const MemoryBankShiftRegisterFabricBitstreamWordId& word_id) const;
 
+  /* @brief Return a BL vector with a given index in a given word id, where
+   * don't care bits are represented by the don't care character */
+  std::string bl_vector(
+    const MemoryBankShiftRegisterFabricBitstreamWordId& word_id,
+    const size_t& vec_index) const;
+
+  /* @brief Return a WL vector with a given index in a given word id, where
+   * don't care bits are represented by the don't care character */
+  std::string wl_vector(
+    const MemoryBankShiftRegisterFabricBitstreamWordId& word_id,
+    const size_t& vec_index) const;
+
+  /* @brief Return the character used to represent don't care bits */
+  char dont_care_bit() const;
+
  public: /* Mutators */
   /* @brief Create a new word */
   MemoryBankShiftRegisterFabricBitstreamWordId create_word();
 
-  /* @brief Add BLs to a given word */
-  void add_bl_vectors(
+  /* @brief Set the character used to represent don't care bits */
+  void set_dont_care_bit(const char& dont_care_bit);
+
+  /* @brief Allocate the BL vectors of a given word, where all the bits are
+   * don't care */
+  void resize_bl_vectors(
     const MemoryBankShiftRegisterFabricBitstreamWordId& word_id,
-    const std::string& bl_vec);
+    const size_t& num_vectors, const size_t& width);
 
-  /* @brief Add WLs to a given word */
-  void add_wl_vectors(
+  /* @brief Allocate the WL vectors of a given word, where all the bits are
+   * don't care */
+  void resize_wl_vectors(
     const MemoryBankShiftRegisterFabricBitstreamWordId& word_id,
-    const std::string& wl_vec);
+    const size_t& num_vectors, const size_t& width);
+
+  /* @brief Set a block of 64 bits of a BL vector in a given word. The block
+   * covers the bits [64 * block_index, 64 * block_index + 63] of the vector,
+   * where the LSB of the values is the first bit. A bit is a don't care if
+   * its care mask is 0 */
+  void set_bl_vector_block(
+    const MemoryBankShiftRegisterFabricBitstreamWordId& word_id,
+    const size_t& vec_index, const size_t& block_index, const uint64_t& values,
+    const uint64_t& care_mask);
+
+  /* @brief Set a block of 64 bits of a WL vector in a given word */
+  void set_wl_vector_block(
+    const MemoryBankShiftRegisterFabricBitstreamWordId& word_id,
+    const size_t& vec_index, const size_t& block_index, const uint64_t& values,
+    const uint64_t& care_mask);
 
  public: /* Validators */
   bool valid_word_id(
     const MemoryBankShiftRegisterFabricBitstreamWordId& word_id) const;
 
+ private: /* Internal types */
+  /* The vectors of a BL or WL part of a word, where each vector is packed
+   * into blocks of 64 bits. Each bit is stored with a value and a care mask,
+   * so that don't care bits can be represented */
+  struct BitMatrix {
+    size_t num_vectors = 0;
+    size_t width = 0;
+    size_t num_blocks_per_vector = 0;
+    std::vector<uint64_t> values;
+    std::vector<uint64_t> care_masks;
+  };
+
+ private: /* Internal utility */
+  static void resize_bit_matrix(BitMatrix& matrix, const size_t& num_vectors,
+                                const size_t& width);
+  static void set_bit_matrix_block(BitMatrix& matrix, const size_t& vec_index,
+                                   const size_t& block_index,
+                                   const uint64_t& values,
+                                   const uint64_t& care_mask);
+  std::string bit_matrix_vector(const BitMatrix& matrix,
+                                const size_t& vec_index) const;
+
  private: /* Internal data */
   /* Organization of the bitstream
    *
@@ -103,12 +161,12 @@ class MemoryBankShiftRegisterFabricBitstream {
   vtr::vector<MemoryBankShiftRegisterFabricBitstreamWordId,
               MemoryBankShiftRegisterFabricBitstreamWordId>
     bitstream_word_ids_;
-  vtr::vector<MemoryBankShiftRegisterFabricBitstreamWordId,
-              std::vector<std::string>>
+  vtr::vector<MemoryBankShiftRegisterFabricBitstreamWordId, BitMatrix>
     bitstream_word_bls_;
-  vtr::vector<MemoryBankShiftRegisterFabricBitstreamWordId,
-              std::vector<std::string>>
+  vtr::vector<MemoryBankShiftRegisterFabricBitstreamWordId, BitMatrix>
     bitstream_word_wls_;
+  /* Character to represent don't care bits when outputting vectors */
+  char dont_care_bit_ = 'x';
 };
 
 } /* end namespace openfpga */
@@ -53,7 +53,8 @@ int report_bitstream_distribution(const std::string& fname,
                                   const BitstreamManager& bitstream_manager,
                                   const FabricBitstream& fabric_bitstream,
                                   const bool& include_time_stamp,
-                                  const size_t& max_hierarchy_level) {
+                                  const size_t& max_hierarchy_level,
+                                  const bool& count_ones) {
   /* Ensure that we have a valid file name */
   if (true == fname.empty()) {
     VTR_LOG_ERROR(
@@ -81,13 +82,13 @@ int report_bitstream_distribution(const std::string& fname,
   fp << "<bitstream_distribution>" << std::endl;
 
   int status = 0;
-  status =
-    report_fabric_bitstream_distribution(fp, fabric_bitstream, curr_level + 1);
+  status = report_fabric_bitstream_distribution(
+    fp, bitstream_manager, fabric_bitstream, count_ones, curr_level + 1);
   if (status == 1) {
     return status;
   }
   status = report_architecture_bitstream_distribution(
-    fp, bitstream_manager, max_hierarchy_level, curr_level + 1);
+    fp, bitstream_manager, max_hierarchy_level, curr_level + 1, count_ones);
 
   fp << "</bitstream_distribution>" << std::endl;
 
@@ -19,7 +19,8 @@ int report_bitstream_distribution(const std::string& fname,
                                   const BitstreamManager& bitstream_manager,
                                   const FabricBitstream& fabric_bitstream,
                                   const bool& include_time_stamp,
-                                  const size_t& max_hierarchy_level = 1);
+                                  const size_t& max_hierarchy_level = 1,
+                                  const bool& count_ones = false);
 
 } /* end namespace openfpga */
 
@@ -22,24 +22,32 @@
 namespace openfpga {
 
 /********************************************************************
- * Recursively report the bitstream distribution of a block to a file
- * This function will use a Depth-First Search in outputting bitstream
- * for each block
- * For block with child blocks, we visit each child recursively
- * The reporting can be stopped at a given maximum hierarchy level
- * which is used to limit the length of the report
+ * Report the bitstream distribution of a region to a file
+ * Optionally, the number of bits with value '1' in the region is reported,
+ * which are looked up in the bitstream database
  *******************************************************************/
 static void report_region_bitstream_distribution_to_xml_file(
-  std::fstream& fp, const FabricBitstream& fabric_bitstream,
-  const FabricBitRegionId& region, const int& hierarchy_level) {
+  std::fstream& fp, const BitstreamManager& bitstream_manager,
+  const FabricBitstream& fabric_bitstream, const FabricBitRegionId& region,
+  const bool& count_ones, const int& hierarchy_level) {
   valid_file_stream(fp);
 
   /* Write the bitstream distribution of this block */
   write_tab_to_file(fp, hierarchy_level);
   fp << "<region";
   fp << " id=\"" << size_t(region) << "\"";
-  fp << " number_of_bits=\"" << fabric_bitstream.region_bits(region).size()
+  fp << " number_of_bits=\"" << fabric_bitstream.num_region_bits(region)
      << "\"";
+  if (true == count_ones) {
+    size_t num_ones = 0;
+    for (const FabricBitId& fabric_bit : fabric_bitstream.region_bits(region)) {
+      ConfigBitId config_bit = fabric_bitstream.config_bit(fabric_bit);
+      if (true == bitstream_manager.bit_value(config_bit)) {
+        num_ones++;
+      }
+    }
+    fp << " number_of_ones=\"" << num_ones << "\"";
+  }
   fp << ">" << std::endl;
 
   write_tab_to_file(fp, hierarchy_level);
@@ -51,7 +59,8 @@ static void report_region_bitstream_distribution_to_xml_file(
  * This function can generate a report to a file
  *******************************************************************/
 int report_fabric_bitstream_distribution(
-  std::fstream& fp, const FabricBitstream& fabric_bitstream,
+  std::fstream& fp, const BitstreamManager& bitstream_manager,
+  const FabricBitstream& fabric_bitstream, const bool& count_ones,
   const int& hierarchy_level) {
   std::string timer_message =
     std::string("Report fabric bitstream distribution");
@@ -64,8 +73,9 @@ int report_fabric_bitstream_distribution(
   for (const FabricBitRegionId& region : fabric_bitstream.regions()) {
     write_tab_to_file(fp, curr_level);
     fp << "<regions>" << std::endl;
-    report_region_bitstream_distribution_to_xml_file(fp, fabric_bitstream,
-                                                     region, curr_level + 1);
+    report_region_bitstream_distribution_to_xml_file(
+      fp, bitstream_manager, fabric_bitstream, region, count_ones,
+      curr_level + 1);
     write_tab_to_file(fp, curr_level);
     fp << "</regions>" << std::endl;
   }
@@ -6,6 +6,7 @@
  *******************************************************************/
 #include <string>
 
+#include "bitstream_manager.h"
 #include "fabric_bitstream.h"
 
 /********************************************************************
@@ -16,7 +17,8 @@
 namespace openfpga {
 
 int report_fabric_bitstream_distribution(
-  std::fstream& fp, const FabricBitstream& fabric_bitstream,
+  std::fstream& fp, const BitstreamManager& bitstream_manager,
+  const FabricBitstream& fabric_bitstream, const bool& count_ones,
   const int& hierarchy_level);
 
 } /* end namespace openfpga */
@@ -0,0 +1,456 @@
+/********************************************************************
+ * This file includes functions to model the configuration phase of an
+ * FPGA fabric in C++, as an alternative to simulating the full testbench.
+ *
+ * The model applies the sequence of data, as the full testbench loads it
+ * through the configuration protocol, to the configuration memories of the
+ * fabric, and computes the value of each memory at the end of the
+ * configuration phase:
+ * - configuration chains are shifted, where the memories of a chain are
+ *   found from the module graph
+ * - frame-based decoders and memory banks are written address by address,
+ *   where each memory only responds to its own address
+ * - flatten memory banks are written wordline by wordline
+ * Fast configuration is modelled by skipping the same cycles as the full
+ * testbench, while the memories are reset to the value to skip first.
+ *
+ * The state can be compared to the bitstream database, and be written to
+ * a memory file to start simulations from the post-configuration state
+ *******************************************************************/
+#include <algorithm>
+#include <fstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/* Headers from vtrutil library */
+#include "vtr_assert.h"
+#include "vtr_log.h"
+#include "vtr_time.h"
+
+/* Headers from openfpgashell library */
+#include "command_exit_codes.h"
+
+/* Headers from openfpgautil library */
+#include "openfpga_decode.h"
+
+/* Headers from fpgabitstream library */
+#include "build_fabric_bitstream.h"
+#include "fabric_bitstream_utils.h"
+#include "simulate_fabric_configuration.h"
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+/* Value of a memory which is never written */
+static const char UNKNOWN_MEMORY_VALUE = 'x';
+
+/********************************************************************
+ * Model a configuration chain protocol, i.e., standalone or scan-chain
+ * - Standalone memories are loaded in parallel in a single cycle
+ * - Each region of a scan-chain is a shift register, where the data applied
+ *   at the i-th cycle ends up at the (N-1-i)-th memory from the head of the
+ *   chain, N being the number of cycles.
+ * The data are the regional bitstreams aligned to the longest region, as
+ * loaded by the full testbench. With fast configuration, the first cycles
+ * (which only contain the value to skip) are not applied
+ *******************************************************************/
+static int simulate_config_chain_configuration(
+  ConfigMemoryState& memory_state, size_t& num_config_cycles,
+  const BitstreamManager& bitstream_manager,
+  const FabricBitstream& fabric_bitstream,
+  const ModuleManager& module_manager, const ModuleNameMap& module_name_map,
+  const ConfigProtocol& config_protocol, const bool& fast_configuration,
+  const bool& bit_value_to_skip) {
+  /* The memories of each chain, from its head */
+  std::vector<std::vector<ConfigBitId>> chain_memories;
+  walk_chain_fabric_dependent_bitstream(
+    bitstream_manager, module_manager, module_name_map, config_protocol,
+    [&](const size_t& region_index, const ConfigBitId& config_bit) {
+      if (chain_memories.size() <= region_index) {
+        chain_memories.resize(region_index + 1);
+      }
+      chain_memories[region_index].push_back(config_bit);
+    },
+    false);
+
+  ConfigChainFabricBitstream regional_bitstreams =
+    build_config_chain_fabric_bitstream_by_region(bitstream_manager,
+                                                  fabric_bitstream, 1);
+  if (regional_bitstreams.size() < chain_memories.size()) {
+    VTR_LOG_ERROR(
+      "Fabric bitstream has %lu regions while the fabric has %lu "
+      "configuration chains!\n",
+      regional_bitstreams.size(), chain_memories.size());
+    return CMD_EXEC_FATAL_ERROR;
+  }
+  size_t num_cycles = find_fabric_regional_bitstream_max_size(fabric_bitstream);
+
+  if (CONFIG_MEM_STANDALONE == config_protocol.type()) {
+    std::vector<FabricBitRegionId> regions(fabric_bitstream.regions().begin(),
+                                           fabric_bitstream.regions().end());
+    for (size_t ichain = 0; ichain < chain_memories.size(); ++ichain) {
+      const std::vector<ConfigBitId>& memories = chain_memories[ichain];
+      /* Shorter regions are aligned to the tail of the bitstream */
+      size_t num_region_bits =
+        fabric_bitstream.num_region_bits(regions[ichain]);
+      size_t offset = num_cycles - num_region_bits;
+      for (size_t imem = 0;
+           (imem < memories.size()) && (imem < num_region_bits); ++imem) {
+        memory_state[memories[imem]] =
+          regional_bitstreams[ichain][offset + imem] ? '1' : '0';
+      }
+    }
+    num_config_cycles = 1;
+    return CMD_EXEC_SUCCESS;
+  }
+
+  size_t num_skipped_cycles = 0;
+  if (true == fast_configuration) {
+    num_skipped_cycles =
+      find_configuration_chain_fabric_bitstream_size_to_be_skipped(
+        fabric_bitstream, bitstream_manager, bit_value_to_skip);
+  }
+  for (size_t ichain = 0; ichain < chain_memories.size(); ++ichain) {
+    const std::vector<ConfigBitId>& memories = chain_memories[ichain];
+    const std::vector<bool>& chain_data = regional_bitstreams[ichain];
+    /* The memories beyond the number of cycles are never reached */
+    for (size_t imem = 0; (imem < memories.size()) && (imem < num_cycles);
+         ++imem) {
+      size_t icycle = num_cycles - 1 - imem;
+      if (icycle < num_skipped_cycles) {
+        continue;
+      }
+      memory_state[memories[imem]] = chain_data[icycle] ? '1' : '0';
+    }
+  }
+  num_config_cycles = num_cycles - num_skipped_cycles;
+
+  return CMD_EXEC_SUCCESS;
+}
+
+/********************************************************************
+ * Find the key of a memory which responds to an address in a region
+ *******************************************************************/
+static std::string config_memory_address_key(const size_t& region_index,
+                                             const std::string& address) {
+  return std::to_string(region_index) + std::string(":") + address;
+}
+
+/* Check if all the data written in a cycle are the value to skip */
+static bool is_config_cycle_skippable(const std::vector<bool>& region_dins,
+                                      const bool& bit_value_to_skip) {
+  for (const bool& din : region_dins) {
+    if (bit_value_to_skip != din) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/********************************************************************
+ * Model a frame-based configuration protocol, where an address is applied
+ * to all the regions at each cycle, with the data of each region.
+ * The decoder of a region does not see the address bits which are don't
+ * care for its memories, i.e., the idle bits of the regions with fewer
+ * address bits than the fabric, so that the memories respond to all the
+ * values of these bits. The addresses are applied in the same order as
+ * the full testbench
+ *******************************************************************/
+static void simulate_frame_based_configuration(
+  ConfigMemoryState& memory_state, size_t& num_config_cycles,
+  const FabricBitstream& fabric_bitstream, const bool& fast_configuration,
+  const bool& bit_value_to_skip) {
+  std::unordered_map<std::string, ConfigBitId> memories;
+  std::vector<std::vector<size_t>> region_idle_bits;
+  for (const FabricBitRegionId& region : fabric_bitstream.regions()) {
+    size_t region_index = region_idle_bits.size();
+    region_idle_bits.emplace_back();
+    bool first_bit = true;
+    for (const FabricBitId& fabric_bit : fabric_bitstream.region_bits(region)) {
+      std::string address =
+        fabric_bitstream.bit_address_view(fabric_bit).to_string();
+      /* The idle bits are the same for all the memories of a region */
+      if (true == first_bit) {
+        for (size_t ibit = 0; ibit < address.size(); ++ibit) {
+          if (DONT_CARE_CHAR == address[ibit]) {
+            region_idle_bits[region_index].push_back(ibit);
+          }
+        }
+        first_bit = false;
+      }
+      memories[config_memory_address_key(region_index, address)] =
+        fabric_bitstream.config_bit(fabric_bit);
+    }
+  }
+
+  num_config_cycles = 0;
+  FrameFabricBitstream fabric_bits_by_addr =
+    build_frame_based_fabric_bitstream_by_address(fabric_bitstream);
+  for (const auto& addr_din_pair : fabric_bits_by_addr) {
+    if ((true == fast_configuration) &&
+        (true ==
+         is_config_cycle_skippable(addr_din_pair.second, bit_value_to_skip))) {
+      continue;
+    }
+    num_config_cycles++;
+    for (size_t iregion = 0; iregion < addr_din_pair.second.size();
+         ++iregion) {
+      std::string address = addr_din_pair.first;
+      for (const size_t& ibit : region_idle_bits[iregion]) {
+        address[ibit] = DONT_CARE_CHAR;
+      }
+      auto memory =
+        memories.find(config_memory_address_key(iregion, address));
+      if (memory != memories.end()) {
+        memory_state[memory->second] =
+          addr_din_pair.second[iregion] ? '1' : '0';
+      }
+    }
+  }
+}
+
+/********************************************************************
+ * Model a memory bank protocol where BLs and WLs are addressed, i.e.,
+ * decoders or shift registers, where a pair of BL and WL addresses is
+ * applied to all the regions at each cycle, with the data of each region.
+ * The addresses are applied in the same order as the full testbench
+ *******************************************************************/
+static void simulate_memory_bank_configuration(
+  ConfigMemoryState& memory_state, size_t& num_config_cycles,
+  const FabricBitstream& fabric_bitstream, const bool& fast_configuration,
+  const bool& bit_value_to_skip) {
+  std::unordered_map<std::string, ConfigBitId> memories;
+  size_t region_index = 0;
+  for (const FabricBitRegionId& region : fabric_bitstream.regions()) {
+    for (const FabricBitId& fabric_bit : fabric_bitstream.region_bits(region)) {
+      std::string address =
+        fabric_bitstream.bit_bl_address_view(fabric_bit).to_string() +
+        std::string(",") +
+        fabric_bitstream.bit_wl_address_view(fabric_bit).to_string();
+      memories[config_memory_address_key(region_index, address)] =
+        fabric_bitstream.config_bit(fabric_bit);
+    }
+    region_index++;
+  }
+
+  num_config_cycles = 0;
+  MemoryBankFabricBitstream fabric_bits_by_addr =
+    build_memory_bank_fabric_bitstream_by_address(fabric_bitstream);
+  for (const auto& addr_din_pair : fabric_bits_by_addr) {
+    if ((true == fast_configuration) &&
+        (true ==
+         is_config_cycle_skippable(addr_din_pair.second, bit_value_to_skip))) {
+      continue;
+    }
+    num_config_cycles++;
+    std::string address = addr_din_pair.first.first + std::string(",") +
+                          addr_din_pair.first.second;
+    for (size_t iregion = 0; iregion < addr_din_pair.second.size();
+         ++iregion) {
+      auto memory =
+        memories.find(config_memory_address_key(iregion, address));
+      if (memory != memories.end()) {
+        memory_state[memory->second] =
+          addr_din_pair.second[iregion] ? '1' : '0';
+      }
+    }
+  }
+}
+
+/********************************************************************
+ * Model a memory bank protocol whose BLs and WLs are flatten, where a WL
+ * of each region and all the BLs of the region are applied at each cycle.
+ * The BLs which are not used by the WL do not write any memory
+ *******************************************************************/
+static void simulate_flatten_memory_bank_configuration(
+  ConfigMemoryState& memory_state, size_t& num_config_cycles,
+  const FabricBitstream& fabric_bitstream, const bool& fast_configuration,
+  const bool& bit_value_to_skip) {
+  const FabricBitstreamMemoryBank& memory_bank =
+    fabric_bitstream.memory_bank_info(fast_configuration, bit_value_to_skip);
+
+  /* Memories of each region indexed by their BL and WL */
+  std::vector<std::unordered_map<uint64_t, ConfigBitId>> memories(
+    memory_bank.datas.size());
+  for (size_t ibit = 0; ibit < memory_bank.fabric_bit_datas.size(); ++ibit) {
+    const fabric_bit_data& bit_data = memory_bank.fabric_bit_datas[ibit];
+    VTR_ASSERT(bit_data.region < memories.size());
+    memories[bit_data.region][(uint64_t(bit_data.bl) << 32) | bit_data.wl] =
+      fabric_bitstream.config_bit(FabricBitId(ibit));
+  }
+
+  num_config_cycles = 0;
+  for (size_t region = 0; region < memory_bank.datas.size(); ++region) {
+    const std::vector<fabric_size_t>& wls_to_skip =
+      memory_bank.wls_to_skip[region];
+    size_t iskip = 0;
+    size_t num_region_cycles = 0;
+    for (size_t wl = 0; wl < memory_bank.datas[region].size(); ++wl) {
+      /* The WLs to skip are sorted */
+      if ((iskip < wls_to_skip.size()) && (wl == wls_to_skip[iskip])) {
+        iskip++;
+        continue;
+      }
+      num_region_cycles++;
+      const std::vector<uint8_t>& data = memory_bank.datas[region][wl];
+      const std::vector<uint8_t>& mask = memory_bank.masks[region][wl];
+      for (size_t ibyte = 0; ibyte < mask.size(); ++ibyte) {
+        for (size_t ibl = 0; ibl < 8; ++ibl) {
+          if (0 == ((mask[ibyte] >> ibl) & 1)) {
+            continue;
+          }
+          uint64_t bl = ibyte * 8 + ibl;
+          auto memory = memories[region].find((bl << 32) | wl);
+          if (memory != memories[region].end()) {
+            memory_state[memory->second] = ((data[ibyte] >> ibl) & 1) ? '1'
+                                                                      : '0';
+          }
+        }
+      }
+    }
+    /* Regions are configured in parallel */
+    num_config_cycles = std::max(num_config_cycles, num_region_cycles);
+  }
+}
+
+/********************************************************************
+ * Top-level function to model the configuration phase of an FPGA fabric,
+ * which computes the value of each configuration memory after the fabric
+ * bitstream is loaded, as well as the number of programming cycles.
+ * With fast configuration, the memories are reset to the value to skip
+ * before the configuration starts, otherwise they are unknown.
+ *
+ * Return 0 if the model is applicable to the fabric bitstream
+ *******************************************************************/
+int simulate_fabric_configuration(
+  ConfigMemoryState& memory_state, size_t& num_config_cycles,
+  const BitstreamManager& bitstream_manager,
+  const FabricBitstream& fabric_bitstream,
+  const ModuleManager& module_manager, const ModuleNameMap& module_name_map,
+  const ConfigProtocol& config_protocol, const bool& fast_configuration,
+  const bool& bit_value_to_skip) {
+  vtr::ScopedStartFinishTimer timer("Simulate fabric configuration");
+
+  char initial_value = UNKNOWN_MEMORY_VALUE;
+  if (true == fast_configuration) {
+    initial_value = bit_value_to_skip ? '1' : '0';
+  }
+  memory_state.clear();
+  memory_state.resize(bitstream_manager.num_bits(), initial_value);
+  num_config_cycles = 0;
+
+  switch (config_protocol.type()) {
+    case CONFIG_MEM_STANDALONE:
+    case CONFIG_MEM_SCAN_CHAIN:
+      return simulate_config_chain_configuration(
+        memory_state, num_config_cycles, bitstream_manager, fabric_bitstream,
+        module_manager, module_name_map, config_protocol, fast_configuration,
+        bit_value_to_skip);
+    case CONFIG_MEM_FRAME_BASED:
+      simulate_frame_based_configuration(memory_state, num_config_cycles,
+                                         fabric_bitstream, fast_configuration,
+                                         bit_value_to_skip);
+      break;
+    case CONFIG_MEM_MEMORY_BANK:
+      simulate_memory_bank_configuration(memory_state, num_config_cycles,
+                                         fabric_bitstream, fast_configuration,
+                                         bit_value_to_skip);
+      break;
+    case CONFIG_MEM_QL_MEMORY_BANK:
+      /* Flatten BLs and WLs are only stored in the compact database */
+      if ((BLWL_PROTOCOL_FLATTEN == config_protocol.bl_protocol_type()) &&
+          (BLWL_PROTOCOL_FLATTEN == config_protocol.wl_protocol_type())) {
+        simulate_flatten_memory_bank_configuration(
+          memory_state, num_config_cycles, fabric_bitstream,
+          fast_configuration, bit_value_to_skip);
+      } else {
+        simulate_memory_bank_configuration(memory_state, num_config_cycles,
+                                           fabric_bitstream,
+                                           fast_configuration,
+                                           bit_value_to_skip);
+      }
+      break;
+    default:
+      VTR_LOG_ERROR("Invalid type of configuration protocol!\n");
+      return CMD_EXEC_FATAL_ERROR;
+  }
+
+  return CMD_EXEC_SUCCESS;
+}
+
+/********************************************************************
+ * Compare the state of the configuration memories with the bitstream
+ * database, and report the memories whose value is wrong or unknown.
+ * Return the number of such memories
+ *******************************************************************/
+size_t report_config_memory_state_mismatches(
+  const BitstreamManager& bitstream_manager,
+  const ConfigMemoryState& memory_state, const bool& verbose) {
+  size_t num_mismatches = 0;
+  for (const ConfigBitId& config_bit : bitstream_manager.bits()) {
+    char expected_value = bitstream_manager.bit_value(config_bit) ? '1' : '0';
+    if (expected_value == memory_state[config_bit]) {
+      continue;
+    }
+    num_mismatches++;
+    VTR_LOGV(verbose,
+             "Configuration memory %lu of block '%s' is '%c' while '%c' is "
+             "expected\n",
+             size_t(config_bit),
+             bitstream_manager
+               .block_path(bitstream_manager.bit_parent_block(config_bit))
+               .c_str(),
+             memory_state[config_bit], expected_value);
+  }
+  return num_mismatches;
+}
+
+/********************************************************************
+ * Write the state of the configuration memories to a file which can be
+ * loaded by $readmemb. The file has the same organization as the bitstream
+ * memory of the pre-configured wrapper (see the option
+ * '--embed_bitstream_memory' of 'write_preconfigured_fabric_wrapper'):
+ * each line is a word containing the memories of a block with configuration
+ * bits, in the order of the bitstream database, and the words are padded
+ * with '0' to the largest block.
+ *
+ * Return 0 if successful
+ *******************************************************************/
+int write_config_memory_state_to_file(const std::string& fname,
+                                      const BitstreamManager& bitstream_manager,
+                                      const ConfigMemoryState& memory_state) {
+  std::fstream fp;
+  fp.open(fname, std::fstream::out | std::fstream::trunc);
+  if (false == fp.is_open()) {
+    VTR_LOG_ERROR("Fail to open file '%s' to write the memory state!\n",
+                  fname.c_str());
+    return CMD_EXEC_FATAL_ERROR;
+  }
+
+  size_t memory_width = 0;
+  for (const ConfigBlockId& config_block : bitstream_manager.blocks()) {
+    memory_width =
+      std::max(memory_width, bitstream_manager.num_block_bits(config_block));
+  }
+
+  std::string word;
+  for (const ConfigBlockId& config_block : bitstream_manager.blocks()) {
+    if (0 == bitstream_manager.num_block_bits(config_block)) {
+      continue;
+    }
+    word.clear();
+    for (const ConfigBitId& config_bit :
+         bitstream_manager.block_bits(config_block)) {
+      word += memory_state[config_bit];
+    }
+    word.append(memory_width - word.size(), '0');
+    fp << word << '\n';
+  }
+
+  fp.close();
+
+  return CMD_EXEC_SUCCESS;
+}
+
+} /* end namespace openfpga */
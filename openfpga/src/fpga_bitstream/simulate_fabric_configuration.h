@@ -0,0 +1,45 @@
+#ifndef SIMULATE_FABRIC_CONFIGURATION_H
+#define SIMULATE_FABRIC_CONFIGURATION_H
+
+/********************************************************************
+ * Include header files that are required by function declaration
+ *******************************************************************/
+#include <string>
+
+#include "bitstream_manager.h"
+#include "config_protocol.h"
+#include "fabric_bitstream.h"
+#include "module_manager.h"
+#include "module_name_map.h"
+#include "vtr_vector.h"
+
+/********************************************************************
+ * Function declaration
+ *******************************************************************/
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+/* Value of each configuration memory at the end of the configuration phase:
+ * '0', '1', or 'x' when the memory is never written */
+typedef vtr::vector<ConfigBitId, char> ConfigMemoryState;
+
+int simulate_fabric_configuration(
+  ConfigMemoryState& memory_state, size_t& num_config_cycles,
+  const BitstreamManager& bitstream_manager,
+  const FabricBitstream& fabric_bitstream,
+  const ModuleManager& module_manager, const ModuleNameMap& module_name_map,
+  const ConfigProtocol& config_protocol, const bool& fast_configuration,
+  const bool& bit_value_to_skip);
+
+size_t report_config_memory_state_mismatches(
+  const BitstreamManager& bitstream_manager,
+  const ConfigMemoryState& memory_state, const bool& verbose);
+
+int write_config_memory_state_to_file(
+  const std::string& fname, const BitstreamManager& bitstream_manager,
+  const ConfigMemoryState& memory_state);
+
+} /* end namespace openfpga */
+
+#endif
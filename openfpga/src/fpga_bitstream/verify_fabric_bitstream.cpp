@@ -0,0 +1,441 @@
+/********************************************************************
+ * This file includes functions to check that a fabric bitstream is
+ * consistent with the bitstream database and the module graph, i.e.,
+ * the configuration bits are organized as the configurable children
+ * and the configuration regions of the FPGA fabric.
+ * This catches the mistakes in the sequence of configuration bits without
+ * running any simulation
+ *******************************************************************/
+#include <limits>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+/* Headers from vtrutil library */
+#include "vtr_assert.h"
+#include "vtr_log.h"
+#include "vtr_time.h"
+
+/* Headers from openfpgashell library */
+#include "command_exit_codes.h"
+
+/* Headers from openfpgautil library */
+#include "openfpga_parallel.h"
+
+/* Headers from fpgabitstream library */
+#include "bitstream_manager_utils.h"
+#include "build_fabric_bitstream.h"
+#include "verify_fabric_bitstream.h"
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+/* Index of a block which is not under any configurable child */
+static const size_t NO_CONFIGURABLE_CHILD = std::numeric_limits<size_t>::max();
+
+/* Only the first errors of a region are printed, the others are counted */
+static const size_t MAX_NUM_REPORTED_ERRORS_PER_REGION = 10;
+
+/********************************************************************
+ * A configurable child of the top-level module, and its block in the
+ * bitstream database
+ *******************************************************************/
+struct VerifiedConfigChild {
+  ConfigRegionId region;
+  ConfigBlockId block;
+};
+
+/********************************************************************
+ * Outcome of the checks on a region of a fabric bitstream, which is
+ * owned by the thread checking the region
+ *******************************************************************/
+struct FabricRegionVerification {
+  /* The configuration region of the module graph where the bits are */
+  ConfigRegionId config_region = ConfigRegionId::INVALID();
+  size_t num_errors = 0;
+  std::vector<std::string> error_messages;
+};
+
+static void add_fabric_region_verification_error(
+  FabricRegionVerification& verification, const std::string& message) {
+  verification.num_errors++;
+  if (MAX_NUM_REPORTED_ERRORS_PER_REGION >
+      verification.error_messages.size()) {
+    verification.error_messages.push_back(message);
+  }
+}
+
+/********************************************************************
+ * Find the configurable children of the top-level module which have
+ * configuration bits, as well as the child that each block of the bitstream
+ * database belongs to.
+ * Children without block, e.g., the decoders of memory banks, are skipped
+ *******************************************************************/
+static void find_verified_config_children(
+  const BitstreamManager& bitstream_manager, const ConfigBlockId& top_block,
+  const ModuleManager& module_manager, const ModuleId& top_module,
+  std::vector<VerifiedConfigChild>& config_children,
+  vtr::vector<ConfigBlockId, size_t>& block_config_children) {
+  block_config_children.clear();
+  block_config_children.resize(bitstream_manager.num_blocks(),
+                               NO_CONFIGURABLE_CHILD);
+
+  std::vector<ConfigBlockId> block_stack;
+  for (const ConfigRegionId& config_region :
+       module_manager.regions(top_module)) {
+    std::vector<ModuleId> child_modules =
+      module_manager.region_configurable_children(top_module, config_region);
+    std::vector<size_t> child_instances =
+      module_manager.region_configurable_child_instances(top_module,
+                                                         config_region);
+    for (size_t ichild = 0; ichild < child_modules.size(); ++ichild) {
+      std::string instance_name = module_manager.instance_name(
+        top_module, child_modules[ichild], child_instances[ichild]);
+      ConfigBlockId child_block =
+        bitstream_manager.find_child_block(top_block, instance_name);
+      if (false == bitstream_manager.valid_block_id(child_block)) {
+        continue;
+      }
+
+      /* Spread the child to all the blocks underneath */
+      size_t child_index = config_children.size();
+      config_children.push_back({config_region, child_block});
+      block_stack.push_back(child_block);
+      while (false == block_stack.empty()) {
+        ConfigBlockId block = block_stack.back();
+        block_stack.pop_back();
+        block_config_children[block] = child_index;
+        for (const ConfigBlockId& grandchild_block :
+             bitstream_manager.block_children(block)) {
+          block_stack.push_back(grandchild_block);
+        }
+      }
+    }
+  }
+}
+
+/********************************************************************
+ * Check the bits of a region of a fabric bitstream in a single pass:
+ * - each bit belongs to a configurable child in the same configuration
+ *   region of the module graph
+ * - the bits of each configurable child are contiguous, and there are as
+ *   many of them as in the bitstream database
+ * - the data input of each bit is the value in the bitstream database
+ * - no two bits share the same address
+ *******************************************************************/
+static void verify_fabric_bitstream_region(
+  const FabricBitstream& fabric_bitstream,
+  const BitstreamManager& bitstream_manager,
+  const std::vector<VerifiedConfigChild>& config_children,
+  const vtr::vector<ConfigBlockId, size_t>& block_config_children,
+  const vtr::vector<ConfigBlockId, size_t>& block_num_bits,
+  const FabricBitRegionId& fabric_region,
+  FabricRegionVerification& verification) {
+  /* The template is read-only, unlike memory_bank_info() */
+  const FabricBitstreamMemoryBank& memory_bank =
+    fabric_bitstream.bitstream_template()->memory_bank;
+
+  std::unordered_set<size_t> visited_children;
+  std::unordered_set<std::string> visited_addresses;
+  size_t cur_child = NO_CONFIGURABLE_CHILD;
+  size_t num_cur_child_bits = 0;
+
+  /* Ensure that all the bits of the child walked through are found */
+  auto finish_child = [&]() {
+    if (NO_CONFIGURABLE_CHILD == cur_child) {
+      return;
+    }
+    const ConfigBlockId& child_block = config_children[cur_child].block;
+    if (num_cur_child_bits != block_num_bits[child_block]) {
+      add_fabric_region_verification_error(
+        verification,
+        std::string("Block '") + bitstream_manager.block_path(child_block) +
+          std::string("' has ") + std::to_string(num_cur_child_bits) +
+          std::string(" bits in fabric bitstream but ") +
+          std::to_string(block_num_bits[child_block]) +
+          std::string(" bits in bitstream database"));
+    }
+  };
+
+  for (const FabricBitId& fabric_bit :
+       fabric_bitstream.region_bits(fabric_region)) {
+    ConfigBitId config_bit = fabric_bitstream.config_bit(fabric_bit);
+    if (false == bitstream_manager.valid_bit_id(config_bit)) {
+      add_fabric_region_verification_error(
+        verification, std::string("Fabric bit ") +
+                        std::to_string(size_t(fabric_bit)) +
+                        std::string(" has an invalid configuration bit"));
+      continue;
+    }
+
+    ConfigBlockId parent_block = bitstream_manager.bit_parent_block(config_bit);
+    size_t child = block_config_children[parent_block];
+    if (NO_CONFIGURABLE_CHILD == child) {
+      add_fabric_region_verification_error(
+        verification,
+        std::string("Fabric bit ") + std::to_string(size_t(fabric_bit)) +
+          std::string(" comes from block '") +
+          bitstream_manager.block_path(parent_block) +
+          std::string("' which is not under any configurable child"));
+      continue;
+    }
+
+    /* All the bits of a region should be in the same region of the module
+     * graph, which is the one of the first bit */
+    if (ConfigRegionId::INVALID() == verification.config_region) {
+      verification.config_region = config_children[child].region;
+    } else if (verification.config_region != config_children[child].region) {
+      add_fabric_region_verification_error(
+        verification,
+        std::string("Fabric bit ") + std::to_string(size_t(fabric_bit)) +
+          std::string(" comes from configuration region ") +
+          std::to_string(size_t(config_children[child].region)) +
+          std::string(" while the region has bits of configuration region ") +
+          std::to_string(size_t(verification.config_region)));
+    }
+
+    if (child != cur_child) {
+      finish_child();
+      if (false == visited_children.insert(child).second) {
+        add_fabric_region_verification_error(
+          verification,
+          std::string("Bits of block '") +
+            bitstream_manager.block_path(config_children[child].block) +
+            std::string("' are not contiguous in fabric bitstream"));
+      }
+      cur_child = child;
+      num_cur_child_bits = 0;
+    }
+    num_cur_child_bits++;
+
+    if (false == fabric_bitstream.use_address()) {
+      continue;
+    }
+
+    if (char(bitstream_manager.bit_value(config_bit)) !=
+        fabric_bitstream.bit_din(fabric_bit)) {
+      add_fabric_region_verification_error(
+        verification, std::string("Fabric bit ") +
+                        std::to_string(size_t(fabric_bit)) +
+                        std::string(" has a data input different from the "
+                                    "bitstream database"));
+    }
+
+    /* The BL/WLs of flatten memory banks are stored in a compact database
+     * instead of the addresses */
+    std::string address;
+    if (true == memory_bank.has_bit((fabric_size_t)(size_t)(fabric_bit))) {
+      const fabric_bit_data& bit_data =
+        memory_bank.fabric_bit_datas[size_t(fabric_bit)];
+      address = std::to_string(bit_data.bl) + std::string(",") +
+                std::to_string(bit_data.wl);
+    } else {
+      address = fabric_bitstream.bit_address_view(fabric_bit).to_string();
+      if (true == fabric_bitstream.use_wl_address()) {
+        address += std::string(",") +
+                   fabric_bitstream.bit_wl_address_view(fabric_bit).to_string();
+      }
+    }
+    if (false == visited_addresses.insert(address).second) {
+      add_fabric_region_verification_error(
+        verification, std::string("Fabric bit ") +
+                        std::to_string(size_t(fabric_bit)) +
+                        std::string(" has the same address '") + address +
+                        std::string("' as another bit of the region"));
+    }
+  }
+  finish_child();
+}
+
+/********************************************************************
+ * Check that each configuration bit of the bitstream database is used
+ * at most once by the fabric bitstream, and exactly once for a full
+ * bitstream. Return the number of errors
+ *******************************************************************/
+static size_t verify_fabric_bitstream_config_bit_usage(
+  const FabricBitstream& fabric_bitstream,
+  const BitstreamManager& bitstream_manager, const bool& full_bitstream) {
+  size_t num_errors = 0;
+  vtr::vector<ConfigBitId, char> used_bits(bitstream_manager.num_bits(),
+                                           false);
+  for (const FabricBitId& fabric_bit : fabric_bitstream.bits()) {
+    ConfigBitId config_bit = fabric_bitstream.config_bit(fabric_bit);
+    /* Invalid bits have been reported by the regions */
+    if (false == bitstream_manager.valid_bit_id(config_bit)) {
+      continue;
+    }
+    if (true == bool(used_bits[config_bit])) {
+      VTR_LOG_ERROR(
+        "Configuration bit %lu of block '%s' is used more than once in "
+        "fabric bitstream!\n",
+        size_t(config_bit),
+        bitstream_manager
+          .block_path(bitstream_manager.bit_parent_block(config_bit))
+          .c_str());
+      num_errors++;
+    }
+    used_bits[config_bit] = true;
+  }
+
+  if (false == full_bitstream) {
+    return num_errors;
+  }
+  for (const ConfigBitId& config_bit : bitstream_manager.bits()) {
+    if (false == bool(used_bits[config_bit])) {
+      VTR_LOG_ERROR(
+        "Configuration bit %lu of block '%s' is missing in fabric bitstream!\n",
+        size_t(config_bit),
+        bitstream_manager
+          .block_path(bitstream_manager.bit_parent_block(config_bit))
+          .c_str());
+      num_errors++;
+    }
+  }
+  return num_errors;
+}
+
+/********************************************************************
+ * Top-level function to check that a fabric bitstream is consistent with
+ * the bitstream database and the module graph of the FPGA fabric.
+ * The regions of the fabric bitstream are checked in parallel, while each
+ * check is done in a single pass over the bits, so that it can be applied
+ * to large fabrics.
+ * Partial bitstreams are supported, where only the configurable children
+ * included should have all their bits
+ *
+ * Return 0 if the fabric bitstream is consistent
+ *******************************************************************/
+int verify_fabric_bitstream(const FabricBitstream& fabric_bitstream,
+                            const BitstreamManager& bitstream_manager,
+                            const ModuleManager& module_manager,
+                            const ModuleNameMap& module_name_map,
+                            const size_t& num_threads, const bool& verbose) {
+  vtr::ScopedStartFinishTimer timer("Verify fabric bitstream");
+
+  if (bitstream_manager.num_bits() < fabric_bitstream.num_bits()) {
+    VTR_LOG_ERROR(
+      "Fabric bitstream has %lu bits, more than the bitstream database "
+      "(%lu bits)!\n",
+      fabric_bitstream.num_bits(), bitstream_manager.num_bits());
+    return CMD_EXEC_FATAL_ERROR;
+  }
+  bool full_bitstream =
+    (bitstream_manager.num_bits() == fabric_bitstream.num_bits());
+
+  ModuleId top_module;
+  ConfigBlockId top_block;
+  find_fabric_dependent_bitstream_top(bitstream_manager, module_manager,
+                                      module_name_map, top_block, top_module);
+
+  vtr::vector<ConfigBlockId, size_t> block_num_bits;
+  vtr::vector<ConfigBlockId, size_t> block_num_ones;
+  find_bitstream_manager_subtree_bit_counts(bitstream_manager, block_num_bits,
+                                            block_num_ones);
+
+  std::vector<VerifiedConfigChild> config_children;
+  vtr::vector<ConfigBlockId, size_t> block_config_children;
+  find_verified_config_children(bitstream_manager, top_block, module_manager,
+                                top_module, config_children,
+                                block_config_children);
+  VTR_LOGV(verbose,
+           "Found %lu configurable children with bits in %lu configuration "
+           "regions\n",
+           config_children.size(), module_manager.regions(top_module).size());
+
+  /* Build the paths of blocks before they are used by threads */
+  if (0 < bitstream_manager.num_blocks()) {
+    bitstream_manager.block_path(top_block);
+  }
+
+  std::vector<FabricBitRegionId> fabric_regions;
+  for (const FabricBitRegionId& fabric_region : fabric_bitstream.regions()) {
+    fabric_regions.push_back(fabric_region);
+  }
+  std::vector<FabricRegionVerification> verifications(fabric_regions.size());
+  parallel_for(fabric_regions.size(), num_threads, [&](const size_t& ireg) {
+    verify_fabric_bitstream_region(fabric_bitstream, bitstream_manager,
+                                   config_children, block_config_children,
+                                   block_num_bits, fabric_regions[ireg],
+                                   verifications[ireg]);
+  });
+
+  size_t num_errors = 0;
+  vtr::vector<ConfigRegionId, FabricBitRegionId> config_region_owners(
+    module_manager.regions(top_module).size(), FabricBitRegionId::INVALID());
+  for (size_t ireg = 0; ireg < fabric_regions.size(); ++ireg) {
+    const FabricRegionVerification& verification = verifications[ireg];
+    for (const std::string& message : verification.error_messages) {
+      VTR_LOG_ERROR("[Region %lu] %s!\n", size_t(fabric_regions[ireg]),
+                    message.c_str());
+    }
+    if (verification.error_messages.size() < verification.num_errors) {
+      VTR_LOG_ERROR("[Region %lu] %lu more errors are not shown!\n",
+                    size_t(fabric_regions[ireg]),
+                    verification.num_errors -
+                      verification.error_messages.size());
+    }
+    num_errors += verification.num_errors;
+
+    /* Each region of the module graph is mapped to one region only */
+    if (ConfigRegionId::INVALID() == verification.config_region) {
+      continue;
+    }
+    if (FabricBitRegionId::INVALID() !=
+        config_region_owners[verification.config_region]) {
+      VTR_LOG_ERROR(
+        "Fabric regions %lu and %lu both have bits of configuration region "
+        "%lu!\n",
+        size_t(config_region_owners[verification.config_region]),
+        size_t(fabric_regions[ireg]), size_t(verification.config_region));
+      num_errors++;
+      continue;
+    }
+    config_region_owners[verification.config_region] = fabric_regions[ireg];
+  }
+
+  /* The sizes of the regions are known only when all the children are
+   * included */
+  if (true == full_bitstream) {
+    vtr::vector<ConfigRegionId, size_t> config_region_num_bits(
+      config_region_owners.size(), 0);
+    for (const VerifiedConfigChild& config_child : config_children) {
+      config_region_num_bits[config_child.region] +=
+        block_num_bits[config_child.block];
+    }
+    for (const ConfigRegionId& config_region :
+         module_manager.regions(top_module)) {
+      size_t num_fabric_bits = 0;
+      if (FabricBitRegionId::INVALID() != config_region_owners[config_region]) {
+        num_fabric_bits = fabric_bitstream.num_region_bits(
+          config_region_owners[config_region]);
+      }
+      if (num_fabric_bits != config_region_num_bits[config_region]) {
+        VTR_LOG_ERROR(
+          "Configuration region %lu has %lu bits in fabric bitstream but %lu "
+          "bits in module graph!\n",
+          size_t(config_region), num_fabric_bits,
+          config_region_num_bits[config_region]);
+        num_errors++;
+      }
+    }
+  }
+
+  num_errors += verify_fabric_bitstream_config_bit_usage(
+    fabric_bitstream, bitstream_manager, full_bitstream);
+
+  if (0 < num_errors) {
+    VTR_LOG_ERROR(
+      "Fabric bitstream is inconsistent with bitstream database and module "
+      "graph: %lu errors found!\n",
+      num_errors);
+    return CMD_EXEC_FATAL_ERROR;
+  }
+
+  VTR_LOG("Verified %lu configuration bits in %lu regions of %s bitstream\n",
+          fabric_bitstream.num_bits(), fabric_regions.size(),
+          full_bitstream ? "full" : "partial");
+
+  return CMD_EXEC_SUCCESS;
+}
+
+} /* end namespace openfpga */
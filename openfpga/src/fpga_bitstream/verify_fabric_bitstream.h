@@ -0,0 +1,27 @@
+#ifndef VERIFY_FABRIC_BITSTREAM_H
+#define VERIFY_FABRIC_BITSTREAM_H
+
+/********************************************************************
+ * Include header files that are required by function declaration
+ *******************************************************************/
+#include "bitstream_manager.h"
+#include "fabric_bitstream.h"
+#include "module_manager.h"
+#include "module_name_map.h"
+
+/********************************************************************
+ * Function declaration
+ *******************************************************************/
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+int verify_fabric_bitstream(const FabricBitstream& fabric_bitstream,
+                            const BitstreamManager& bitstream_manager,
+                            const ModuleManager& module_manager,
+                            const ModuleNameMap& module_name_map,
+                            const size_t& num_threads, const bool& verbose);
+
+} /* end namespace openfpga */
+
+#endif
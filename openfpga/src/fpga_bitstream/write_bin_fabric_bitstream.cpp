@@ -0,0 +1,617 @@
+/********************************************************************
+ * This file includes functions that output a fabric-dependent
+ * bitstream database to files in a packed binary format
+ *
+ * The file starts with a header, where all the fields are in little endian
+ *   - magic number "OFBS" (4 bytes)
+ *   - format version (uint32), which is 2 when the bitstream is compressed
+ *   - configuration protocol type (uint32)
+ *   - BL protocol type (uint32)
+ *   - WL protocol type (uint32)
+ *   - number of configuration regions (uint32)
+ *   - flags of fast configuration (uint32)
+ *     - bit 0: fast configuration is applied
+ *     - bit 1: the value of the configuration bits which are skipped
+ *     - bit 2: the bitstream is compressed
+ *   - total width of BL addresses (uint64)
+ *   - total width of WL addresses (uint64)
+ *   - width of a row of the bitstream in bits (uint64)
+ *   - number of rows of the bitstream (uint64)
+ * The header is followed by the rows of the bitstream, which are the same
+ * as the lines of the plain text file. The bits are packed contiguously,
+ * i.e., without any padding between rows, where the first bit of the
+ * bitstream is the LSB of the first byte. The last byte is padded with
+ * zeros.
+ *
+ * When the bitstream is compressed, the header is followed by blocks of
+ * run-length encoded bits (see openfpga_bit_run_length.h), where each block
+ * starts with the number of bits (uint64) and the number of encoded bytes
+ * (uint64). The blocks are
+ *   - standalone: a block of all the rows
+ *   - scan-chain: a block per configuration region, which contains the bits
+ *     to be shifted in the region. The rows are restored by taking a bit of
+ *     each block in the order of the regions
+ *   - frame-based: a block of the addresses of all the rows, followed by a
+ *     block of the data inputs of all the rows
+ *******************************************************************/
+#include <algorithm>
+#include <cstdint>
+#include <fstream>
+
+/* Headers from vtrutil library */
+#include "vtr_assert.h"
+#include "vtr_log.h"
+#include "vtr_time.h"
+
+/* Headers from openfpgautil library */
+#include "fabric_bitstream_utils.h"
+#include "fast_configuration.h"
+#include "openfpga_bit_run_length.h"
+#include "openfpga_digest.h"
+#include "write_bin_fabric_bitstream.h"
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+constexpr char BIN_FABRIC_BITSTREAM_MAGIC[] = "OFBS";
+constexpr uint32_t BIN_FABRIC_BITSTREAM_VERSION = 1;
+constexpr uint32_t BIN_FABRIC_BITSTREAM_COMPRESSED_VERSION = 2;
+constexpr size_t BIN_FABRIC_BITSTREAM_BUFFER_SIZE = 1 << 20;
+
+/********************************************************************
+ * A buffered writer which packs bits into bytes before writing them to
+ * a binary file stream
+ *******************************************************************/
+class BinaryBitWriter {
+ public: /* Constructor */
+  BinaryBitWriter(std::fstream& fp) : fp_(fp), curr_byte_(0), num_bits_(0) {
+    buffer_.reserve(BIN_FABRIC_BITSTREAM_BUFFER_SIZE);
+  }
+  ~BinaryBitWriter() { flush(); }
+
+ public: /* Mutators */
+  void add_bit(const bool& bit) {
+    if (true == bit) {
+      curr_byte_ |= uint8_t(1 << (num_bits_ & 7));
+    }
+    ++num_bits_;
+    if (0 == (num_bits_ & 7)) {
+      buffer_.push_back(char(curr_byte_));
+      curr_byte_ = 0;
+      if (buffer_.size() == BIN_FABRIC_BITSTREAM_BUFFER_SIZE) {
+        write_buffer();
+      }
+    }
+  }
+  /* Add the bits of a string of '0' and '1', where any other character, e.g.,
+   * a don't care bit, is written as '0' */
+  void add_bits(const std::string& bits) {
+    for (const char& bit : bits) {
+      add_bit('1' == bit);
+    }
+  }
+  void add_bits(const std::vector<bool>& bits) {
+    for (const bool& bit : bits) {
+      add_bit(bit);
+    }
+  }
+  /* Write all the pending bits, where the last byte is padded with zeros */
+  void flush() {
+    if (0 != (num_bits_ & 7)) {
+      buffer_.push_back(char(curr_byte_));
+      curr_byte_ = 0;
+      num_bits_ += 8 - (num_bits_ & 7);
+    }
+    write_buffer();
+  }
+
+ private: /* Internal utility */
+  void write_buffer() {
+    fp_.write(buffer_.data(), buffer_.size());
+    buffer_.clear();
+  }
+
+ private: /* Internal data */
+  std::fstream& fp_;
+  std::vector<char> buffer_;
+  uint8_t curr_byte_;
+  size_t num_bits_;
+};
+
+/********************************************************************
+ * Write an unsigned integer in little endian
+ *******************************************************************/
+static void write_bin_uint(std::fstream& fp, const uint64_t& value,
+                           const size_t& num_bytes) {
+  for (size_t ibyte = 0; ibyte < num_bytes; ++ibyte) {
+    fp.put(char((value >> (8 * ibyte)) & 0xff));
+  }
+}
+
+/********************************************************************
+ * Write a block of run-length encoded bits
+ *******************************************************************/
+static void write_bin_compressed_block(std::fstream& fp,
+                                       BitRunLengthEncoder& encoder) {
+  encoder.finish();
+  write_bin_uint(fp, encoder.num_bits(), 8);
+  write_bin_uint(fp, encoder.data().size(), 8);
+  fp.write(reinterpret_cast<const char*>(encoder.data().data()),
+           encoder.data().size());
+}
+
+/********************************************************************
+ * The information required by the header of a binary bitstream file
+ *******************************************************************/
+struct BinFabricBitstreamHeader {
+  uint32_t num_regions = 0;
+  bool fast_configuration = false;
+  bool bit_value_to_skip = false;
+  bool compressed = false;
+  uint64_t bl_width = 0;
+  uint64_t wl_width = 0;
+  uint64_t row_width = 0;
+  uint64_t num_rows = 0;
+};
+
+/********************************************************************
+ * This function write header information to a binary bitstream file
+ *******************************************************************/
+static void write_fabric_bitstream_bin_file_head(
+  std::fstream& fp, const ConfigProtocol& config_protocol,
+  const BinFabricBitstreamHeader& header) {
+  valid_file_stream(fp);
+
+  fp.write(BIN_FABRIC_BITSTREAM_MAGIC, 4);
+  if (true == header.compressed) {
+    write_bin_uint(fp, BIN_FABRIC_BITSTREAM_COMPRESSED_VERSION, 4);
+  } else {
+    write_bin_uint(fp, BIN_FABRIC_BITSTREAM_VERSION, 4);
+  }
+  write_bin_uint(fp, uint32_t(config_protocol.type()), 4);
+  write_bin_uint(fp, uint32_t(config_protocol.bl_protocol_type()), 4);
+  write_bin_uint(fp, uint32_t(config_protocol.wl_protocol_type()), 4);
+  write_bin_uint(fp, header.num_regions, 4);
+  uint32_t flags = 0;
+  if (true == header.fast_configuration) {
+    flags |= 1;
+    if (true == header.bit_value_to_skip) {
+      flags |= 2;
+    }
+  }
+  if (true == header.compressed) {
+    flags |= 4;
+  }
+  write_bin_uint(fp, flags, 4);
+  write_bin_uint(fp, header.bl_width, 8);
+  write_bin_uint(fp, header.wl_width, 8);
+  write_bin_uint(fp, header.row_width, 8);
+  write_bin_uint(fp, header.num_rows, 8);
+}
+
+/********************************************************************
+ * Write the flatten fabric bitstream to a binary file, where each row
+ * contains a single bit
+ *******************************************************************/
+static int write_flatten_fabric_bitstream_to_bin_file(
+  std::fstream& fp, const ConfigProtocol& config_protocol,
+  const bool& compress, const BitstreamManager& bitstream_manager,
+  const FabricBitstream& fabric_bitstream) {
+  BinFabricBitstreamHeader header;
+  header.num_regions = fabric_bitstream.num_regions();
+  header.compressed = compress;
+  header.row_width = 1;
+  header.num_rows = fabric_bitstream.num_bits();
+  write_fabric_bitstream_bin_file_head(fp, config_protocol, header);
+
+  if (true == compress) {
+    BitRunLengthEncoder encoder;
+    for (const FabricBitId& fabric_bit : fabric_bitstream.bits()) {
+      encoder.add_bit(
+        bitstream_manager.bit_value(fabric_bitstream.config_bit(fabric_bit)));
+    }
+    write_bin_compressed_block(fp, encoder);
+    return 0;
+  }
+
+  BinaryBitWriter writer(fp);
+  for (const FabricBitId& fabric_bit : fabric_bitstream.bits()) {
+    writer.add_bit(
+      bitstream_manager.bit_value(fabric_bitstream.config_bit(fabric_bit)));
+  }
+
+  return 0;
+}
+
+/********************************************************************
+ * Write the fabric bitstream fitting a configuration chain protocol
+ * to a binary file, where each row contains a bit of each region
+ *******************************************************************/
+static int write_config_chain_fabric_bitstream_to_bin_file(
+  std::fstream& fp, const ConfigProtocol& config_protocol,
+  const bool& fast_configuration, const bool& bit_value_to_skip,
+  const bool& compress, const BitstreamManager& bitstream_manager,
+  const FabricBitstream& fabric_bitstream, const size_t& num_threads) {
+  size_t regional_bitstream_max_size =
+    find_fabric_regional_bitstream_max_size(fabric_bitstream);
+  ConfigChainFabricBitstream regional_bitstreams =
+    build_config_chain_fabric_bitstream_by_region(
+      bitstream_manager, fabric_bitstream, num_threads);
+
+  size_t num_bits_to_skip = 0;
+  if (true == fast_configuration) {
+    num_bits_to_skip =
+      find_configuration_chain_fabric_bitstream_size_to_be_skipped(
+        fabric_bitstream, bitstream_manager, bit_value_to_skip);
+    VTR_ASSERT(num_bits_to_skip < regional_bitstream_max_size);
+  }
+
+  BinFabricBitstreamHeader header;
+  header.num_regions = regional_bitstreams.size();
+  header.fast_configuration = fast_configuration;
+  header.bit_value_to_skip = bit_value_to_skip;
+  header.compressed = compress;
+  header.row_width = regional_bitstreams.size();
+  header.num_rows = regional_bitstream_max_size - num_bits_to_skip;
+  write_fabric_bitstream_bin_file_head(fp, config_protocol, header);
+
+  /* Each region is compressed alone, as the bits of a region are shifted
+   * through its own configuration chain */
+  if (true == compress) {
+    BitRunLengthEncoder encoder;
+    for (const auto& region_bitstream : regional_bitstreams) {
+      encoder.clear();
+      for (size_t ibit = num_bits_to_skip; ibit < regional_bitstream_max_size;
+           ++ibit) {
+        encoder.add_bit(region_bitstream[ibit]);
+      }
+      write_bin_compressed_block(fp, encoder);
+    }
+    return 0;
+  }
+
+  BinaryBitWriter writer(fp);
+  for (size_t ibit = num_bits_to_skip; ibit < regional_bitstream_max_size;
+       ++ibit) {
+    for (const auto& region_bitstream : regional_bitstreams) {
+      writer.add_bit(region_bitstream[ibit]);
+    }
+  }
+
+  return 0;
+}
+
+/********************************************************************
+ * Write the fabric bitstream fitting a memory bank protocol using
+ * decoders to a binary file, where each row contains the BL address,
+ * the WL address and the data input
+ *******************************************************************/
+static int write_memory_bank_fabric_bitstream_to_bin_file(
+  std::fstream& fp, const ConfigProtocol& config_protocol,
+  const bool& fast_configuration, const bool& bit_value_to_skip,
+  const FabricBitstream& fabric_bitstream) {
+  MemoryBankFabricBitstream fabric_bits_by_addr =
+    build_memory_bank_fabric_bitstream_by_address(fabric_bitstream);
+
+  size_t bl_addr_size = fabric_bits_by_addr.begin()->first.first.size();
+  size_t wl_addr_size = fabric_bits_by_addr.begin()->first.second.size();
+  size_t din_size = fabric_bits_by_addr.begin()->second.size();
+
+  size_t num_rows = fabric_bits_by_addr.size();
+  if (true == fast_configuration) {
+    num_rows = find_memory_bank_fast_configuration_fabric_bitstream_size(
+      fabric_bitstream, bit_value_to_skip);
+  }
+
+  BinFabricBitstreamHeader header;
+  header.num_regions = fabric_bitstream.num_regions();
+  header.fast_configuration = fast_configuration;
+  header.bit_value_to_skip = bit_value_to_skip;
+  header.bl_width = bl_addr_size;
+  header.wl_width = wl_addr_size;
+  header.row_width = bl_addr_size + wl_addr_size + din_size;
+  header.num_rows = num_rows;
+  write_fabric_bitstream_bin_file_head(fp, config_protocol, header);
+
+  BinaryBitWriter writer(fp);
+  for (const auto& addr_din_pair : fabric_bits_by_addr) {
+    /* Same rule as the plain text file: a row is skipped only when all the
+     * bits of its data input match the value to be skipped */
+    if (true == fast_configuration) {
+      if (addr_din_pair.second ==
+          std::vector<bool>(addr_din_pair.second.size(), bit_value_to_skip)) {
+        continue;
+      }
+    }
+    writer.add_bits(addr_din_pair.first.first);
+    writer.add_bits(addr_din_pair.first.second);
+    writer.add_bits(addr_din_pair.second);
+  }
+
+  return 0;
+}
+
+/********************************************************************
+ * Write the fabric bitstream fitting a memory bank protocol using
+ * flatten BLs and WLs to a binary file, where each row contains the BLs
+ * and then the WLs of all the regions.
+ * The rows are the same as fast_write_memory_bank_flatten_fabric_bitstream_
+ * to_text_file(), while don't care bits are always written as '0'
+ *******************************************************************/
+static int write_memory_bank_flatten_fabric_bitstream_to_bin_file(
+  std::fstream& fp, const ConfigProtocol& config_protocol,
+  const bool& fast_configuration, const bool& bit_value_to_skip,
+  const FabricBitstream& fabric_bitstream, const bool& wl_incremental_order,
+  const size_t& num_threads) {
+  const FabricBitstreamMemoryBank& memory_bank =
+    fabric_bitstream.memory_bank_info(fast_configuration, bit_value_to_skip,
+                                      num_threads);
+
+  fabric_size_t longest_effective_wl_count =
+    memory_bank.get_longest_effective_wl_count();
+
+  BinFabricBitstreamHeader header;
+  header.num_regions = memory_bank.datas.size();
+  header.fast_configuration = fast_configuration;
+  header.bit_value_to_skip = bit_value_to_skip;
+  header.bl_width = memory_bank.get_total_bl_addr_size();
+  header.wl_width = memory_bank.get_total_wl_addr_size();
+  header.row_width = header.bl_width + header.wl_width;
+  header.num_rows = longest_effective_wl_count;
+  write_fabric_bitstream_bin_file_head(fp, config_protocol, header);
+
+  /* The WL to be configured in each region, see the plain text writer
+   * for details */
+  std::vector<fabric_size_t> wl_indexes;
+  for (size_t region = 0; region < memory_bank.datas.size(); region++) {
+    if (wl_incremental_order) {
+      wl_indexes.push_back(0);
+    } else {
+      wl_indexes.push_back(
+        (fabric_size_t)(memory_bank.datas[region].size() - 1));
+    }
+  }
+
+  BinaryBitWriter writer(fp);
+  for (size_t wl_index = 0; wl_index < longest_effective_wl_count; wl_index++) {
+    /* Write BLs of each region */
+    for (size_t region = 0; region < memory_bank.datas.size(); region++) {
+      const fabric_blwl_length& lengths = memory_bank.blwl_lengths[region];
+      const std::vector<fabric_size_t>& wls_to_skip =
+        memory_bank.wls_to_skip[region];
+      while (std::find(wls_to_skip.begin(), wls_to_skip.end(),
+                       wl_indexes[region]) != wls_to_skip.end()) {
+        if (wl_incremental_order) {
+          wl_indexes[region]++;
+        } else {
+          wl_indexes[region]--;
+        }
+      }
+      fabric_size_t current_wl = wl_indexes[region];
+      if (current_wl < memory_bank.datas[region].size()) {
+        const std::vector<uint8_t>& data =
+          memory_bank.datas[region][current_wl];
+        const std::vector<uint8_t>& mask =
+          memory_bank.masks[region][current_wl];
+        for (size_t bl = 0; bl < lengths.bl; bl++) {
+          writer.add_bit(data[bl >> 3] & mask[bl >> 3] & (1 << (bl & 7)));
+        }
+      } else {
+        for (size_t bl = 0; bl < lengths.bl; bl++) {
+          writer.add_bit(false);
+        }
+      }
+    }
+    /* Write one-hot WLs of each region */
+    for (size_t region = 0; region < memory_bank.datas.size(); region++) {
+      const fabric_blwl_length& lengths = memory_bank.blwl_lengths[region];
+      fabric_size_t current_wl = wl_indexes[region];
+      bool valid_wl = current_wl < memory_bank.datas[region].size();
+      for (size_t wl_temp = 0; wl_temp < lengths.wl; wl_temp++) {
+        writer.add_bit(valid_wl && (wl_temp == current_wl));
+      }
+      if (true == valid_wl) {
+        if (wl_incremental_order) {
+          wl_indexes[region]++;
+        } else {
+          wl_indexes[region]--;
+        }
+      }
+    }
+  }
+
+  return 0;
+}
+
+/********************************************************************
+ * Write the fabric bitstream fitting a frame-based protocol to a binary
+ * file, where each row contains the address and the data input
+ *******************************************************************/
+static int write_frame_based_fabric_bitstream_to_bin_file(
+  std::fstream& fp, const ConfigProtocol& config_protocol,
+  const bool& fast_configuration, const bool& bit_value_to_skip,
+  const bool& compress, const FabricBitstream& fabric_bitstream) {
+  FrameFabricBitstream fabric_bits_by_addr =
+    build_frame_based_fabric_bitstream_by_address(fabric_bitstream);
+
+  size_t addr_size = fabric_bits_by_addr.begin()->first.size();
+  size_t din_size = fabric_bits_by_addr.begin()->second.size();
+
+  size_t num_rows = fabric_bits_by_addr.size();
+  if (true == fast_configuration) {
+    num_rows = find_frame_based_fast_configuration_fabric_bitstream_size(
+      fabric_bitstream, bit_value_to_skip);
+  }
+
+  BinFabricBitstreamHeader header;
+  header.num_regions = fabric_bitstream.num_regions();
+  header.fast_configuration = fast_configuration;
+  header.bit_value_to_skip = bit_value_to_skip;
+  header.compressed = compress;
+  header.row_width = addr_size + din_size;
+  header.num_rows = num_rows;
+  write_fabric_bitstream_bin_file_head(fp, config_protocol, header);
+
+  /* The addresses and the data inputs are compressed separately, as the data
+   * inputs are mostly the default values */
+  if (true == compress) {
+    BitRunLengthEncoder addr_encoder;
+    BitRunLengthEncoder din_encoder;
+    for (const auto& addr_din_pair : fabric_bits_by_addr) {
+      if (true == fast_configuration) {
+        if (addr_din_pair.second ==
+            std::vector<bool>(addr_din_pair.second.size(), bit_value_to_skip)) {
+          continue;
+        }
+      }
+      for (const char& bit : addr_din_pair.first) {
+        addr_encoder.add_bit('1' == bit);
+      }
+      din_encoder.add_bits(addr_din_pair.second);
+    }
+    write_bin_compressed_block(fp, addr_encoder);
+    write_bin_compressed_block(fp, din_encoder);
+    return 0;
+  }
+
+  BinaryBitWriter writer(fp);
+  for (const auto& addr_din_pair : fabric_bits_by_addr) {
+    if (true == fast_configuration) {
+      if (addr_din_pair.second ==
+          std::vector<bool>(addr_din_pair.second.size(), bit_value_to_skip)) {
+        continue;
+      }
+    }
+    writer.add_bits(addr_din_pair.first);
+    writer.add_bits(addr_din_pair.second);
+  }
+
+  return 0;
+}
+
+/********************************************************************
+ * Write the fabric bitstream to a binary file
+ * Notes:
+ *   - This is the same bitstream as the plain text file, which is packed
+ *     to be directly loaded by a programmer
+ *   - Don't care bits are always written as '0'
+ *
+ * Return:
+ *  - 0 if succeed
+ *  - 1 if critical errors occured
+ *******************************************************************/
+int write_fabric_bitstream_to_bin_file(
+  const BitstreamManager& bitstream_manager,
+  const FabricBitstream& fabric_bitstream,
+  const ConfigProtocol& config_protocol,
+  const FabricGlobalPortInfo& global_ports,
+  const BitstreamWriterOption& options) {
+  VTR_ASSERT(options.output_file_type() ==
+             BitstreamWriterOption::e_bitfile_type::BIN);
+  std::string fname = options.output_file_name();
+  /* Ensure that we have a valid file name */
+  if (true == fname.empty()) {
+    VTR_LOG_ERROR(
+      "Received empty file name to output bitstream!\n\tPlease specify a valid "
+      "file name.\n");
+  }
+
+  /* Compression is not supported by memory banks, whose rows are mostly
+   * addresses */
+  if ((true == options.compress()) &&
+      ((CONFIG_MEM_QL_MEMORY_BANK == config_protocol.type()) ||
+       (CONFIG_MEM_MEMORY_BANK == config_protocol.type()))) {
+    VTR_LOG_ERROR(
+      "Compression is only applicable to standalone, scan-chain and "
+      "frame-based configuration protocols!\n");
+    return 1;
+  }
+
+  std::string timer_message =
+    std::string("Write ") + std::to_string(fabric_bitstream.num_bits()) +
+    std::string(" fabric bitstream into binary file '") + fname +
+    std::string("'");
+  vtr::ScopedStartFinishTimer timer(timer_message);
+
+  /* Create the file stream */
+  std::fstream fp;
+  fp.open(fname,
+          std::fstream::out | std::fstream::trunc | std::fstream::binary);
+
+  check_file_stream(fname.c_str(), fp);
+
+  bool apply_fast_configuration =
+    is_fast_configuration_applicable(global_ports) &&
+    options.fast_configuration();
+  if (options.fast_configuration() &&
+      apply_fast_configuration != options.fast_configuration()) {
+    VTR_LOG_WARN("Disable fast configuration even it is enabled by user\n");
+  }
+
+  bool bit_value_to_skip = false;
+  if (apply_fast_configuration) {
+    bit_value_to_skip = find_bit_value_to_skip_for_fast_configuration(
+      config_protocol.type(), global_ports, bitstream_manager,
+      fabric_bitstream);
+  }
+
+  /* Output fabric bitstream to the file */
+  int status = 0;
+  switch (config_protocol.type()) {
+    case CONFIG_MEM_STANDALONE:
+      status = write_flatten_fabric_bitstream_to_bin_file(
+        fp, config_protocol, options.compress(), bitstream_manager,
+        fabric_bitstream);
+      break;
+    case CONFIG_MEM_SCAN_CHAIN:
+      status = write_config_chain_fabric_bitstream_to_bin_file(
+        fp, config_protocol, apply_fast_configuration, bit_value_to_skip,
+        options.compress(), bitstream_manager, fabric_bitstream,
+        options.num_threads());
+      break;
+    case CONFIG_MEM_QL_MEMORY_BANK:
+      if (BLWL_PROTOCOL_DECODER == config_protocol.bl_protocol_type()) {
+        status = write_memory_bank_fabric_bitstream_to_bin_file(
+          fp, config_protocol, apply_fast_configuration, bit_value_to_skip,
+          fabric_bitstream);
+      } else if (BLWL_PROTOCOL_FLATTEN == config_protocol.bl_protocol_type() &&
+                 BLWL_PROTOCOL_FLATTEN == config_protocol.wl_protocol_type()) {
+        status = write_memory_bank_flatten_fabric_bitstream_to_bin_file(
+          fp, config_protocol, apply_fast_configuration, bit_value_to_skip,
+          fabric_bitstream, !options.wl_decremental_order(),
+          options.num_threads());
+      } else {
+        VTR_LOG_ERROR(
+          "Binary file format is not supported by memory banks using "
+          "shift registers or mixed BL/WL protocols! Please use plain_text "
+          "file format\n");
+        status = 1;
+      }
+      break;
+    case CONFIG_MEM_MEMORY_BANK:
+      status = write_memory_bank_fabric_bitstream_to_bin_file(
+        fp, config_protocol, apply_fast_configuration, bit_value_to_skip,
+        fabric_bitstream);
+      break;
+    case CONFIG_MEM_FRAME_BASED:
+      status = write_frame_based_fabric_bitstream_to_bin_file(
+        fp, config_protocol, apply_fast_configuration, bit_value_to_skip,
+        options.compress(), fabric_bitstream);
+      break;
+    default:
+      VTR_LOGF_ERROR(__FILE__, __LINE__,
+                     "Invalid configuration protocol type!\n");
+      status = 1;
+  }
+
+  /* Close file handler */
+  fp.close();
+
+  VTR_LOGV(options.verbose_output(),
+           "Outputted %lu configuration bits to binary file: %s\n",
+           fabric_bitstream.bits().size(), fname.c_str());
+
+  return status;
+}
+
+} /* end namespace openfpga */
@@ -0,0 +1,164 @@
+/********************************************************************
+ * This file includes functions that output a fabric-dependent
+ * bitstream database to files in hexadecimal, which can be loaded by
+ * the $readmemh() task of Verilog simulators
+ *
+ * Each line of the file is a word of the virtual memory in testbenches,
+ * whose MSB is the first bit of the word. Words whose width is not a
+ * multiple of 4 are padded with zeros on the MSB side, as $readmemh()
+ * does.
+ *******************************************************************/
+#include <algorithm>
+#include <fstream>
+
+/* Headers from vtrutil library */
+#include "vtr_assert.h"
+#include "vtr_log.h"
+#include "vtr_time.h"
+
+/* Headers from openfpgautil library */
+#include "openfpga_digest.h"
+#include "write_hex_fabric_bitstream.h"
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+/* Number of bytes to be buffered before writing to the file */
+constexpr size_t HEX_FILE_BLOCK_SIZE = 1 << 16;
+
+/********************************************************************
+ * Append a word, whose bits are given from MSB to LSB as characters
+ * '0', '1' or 'x', to a buffer in hexadecimal. A digit is 'x' when any of
+ * its bits is neither '0' nor '1'
+ *******************************************************************/
+static void append_hex_word(std::string& buffer, const char* bits,
+                            const size_t& width) {
+  static const char* HEX_DIGITS = "0123456789abcdef";
+  size_t num_digits = (width + 3) / 4;
+  /* Bits of the first digit, which may be padded */
+  size_t num_digit_bits = width - 4 * (num_digits - 1);
+  size_t ibit = 0;
+  for (size_t idigit = 0; idigit < num_digits; ++idigit) {
+    size_t value = 0;
+    bool unknown = false;
+    for (size_t jbit = 0; jbit < num_digit_bits; ++jbit) {
+      value <<= 1;
+      if ('1' == bits[ibit]) {
+        value |= 1;
+      } else if ('0' != bits[ibit]) {
+        unknown = true;
+      }
+      ibit++;
+    }
+    buffer.push_back(unknown ? 'x' : HEX_DIGITS[value]);
+    num_digit_bits = 4;
+  }
+  buffer.push_back('\n');
+}
+
+/********************************************************************
+ * Write the fabric bitstream fitting a configuration chain protocol
+ * to a hex file. Each line contains a bit of each region, the first region
+ * being the MSB. The first bits of each region, which are skipped by fast
+ * configuration, are not written.
+ *******************************************************************/
+void write_config_chain_fabric_bitstream_to_hex_file(
+  const std::string& fname, const BitstreamManager& bitstream_manager,
+  const FabricBitstream& fabric_bitstream, const size_t& num_bits_to_skip) {
+  std::string timer_message =
+    std::string("Write configuration chain bitstream into hex file '") +
+    fname + std::string("'");
+  vtr::ScopedStartFinishTimer timer(timer_message);
+
+  std::fstream fp;
+  fp.open(fname, std::fstream::out | std::fstream::trunc);
+  check_file_stream(fname.c_str(), fp);
+
+  size_t regional_bitstream_max_size =
+    find_fabric_regional_bitstream_max_size(fabric_bitstream);
+  ConfigChainFabricBitstream regional_bitstreams =
+    build_config_chain_fabric_bitstream_by_region(bitstream_manager,
+                                                  fabric_bitstream);
+  VTR_ASSERT(num_bits_to_skip < regional_bitstream_max_size);
+
+  size_t num_regions = regional_bitstreams.size();
+  size_t num_lines_per_block = std::max(
+    size_t(1), HEX_FILE_BLOCK_SIZE / std::max(size_t(1), num_regions));
+  /* The bits of a block are gathered region by region first, so that each
+   * regional bitstream is visited in order */
+  std::string block_bits;
+  std::string block_buffer;
+
+  for (size_t block_start = num_bits_to_skip;
+       block_start < regional_bitstream_max_size;
+       block_start += num_lines_per_block) {
+    size_t block_end = std::min(block_start + num_lines_per_block,
+                                regional_bitstream_max_size);
+    block_bits.assign((block_end - block_start) * num_regions, '0');
+    for (size_t iregion = 0; iregion < num_regions; ++iregion) {
+      const std::vector<bool>& region_bitstream = regional_bitstreams[iregion];
+      size_t pos = iregion;
+      for (size_t ibit = block_start; ibit < block_end; ++ibit) {
+        block_bits[pos] = region_bitstream[ibit] ? '1' : '0';
+        pos += num_regions;
+      }
+    }
+    block_buffer.clear();
+    for (size_t iline = 0; iline < block_end - block_start; ++iline) {
+      append_hex_word(block_buffer, block_bits.data() + iline * num_regions,
+                      num_regions);
+    }
+    fp.write(block_buffer.data(), block_buffer.size());
+  }
+
+  fp.close();
+}
+
+/********************************************************************
+ * Write the fabric bitstream fitting a memory bank protocol
+ * to a hex file. Each line contains the BL address, the WL address and the
+ * data input, from MSB to LSB. When fast configuration is enabled, the
+ * addresses whose data input bits are all the value to be skipped are not
+ * written, as the plain text bitstream does.
+ *******************************************************************/
+void write_memory_bank_fabric_bitstream_to_hex_file(
+  const std::string& fname,
+  const MemoryBankFabricBitstream& fabric_bits_by_addr,
+  const bool& fast_configuration, const bool& bit_value_to_skip) {
+  std::string timer_message =
+    std::string("Write memory bank bitstream into hex file '") + fname +
+    std::string("'");
+  vtr::ScopedStartFinishTimer timer(timer_message);
+
+  std::fstream fp;
+  fp.open(fname, std::fstream::out | std::fstream::trunc);
+  check_file_stream(fname.c_str(), fp);
+
+  std::string word;
+  std::string block_buffer;
+  for (const auto& addr_din_pair : fabric_bits_by_addr) {
+    const std::vector<bool>& din_values = addr_din_pair.second;
+    /* Only all the bits in the din port match the value to be skipped, the
+     * programming cycle can be skipped! */
+    if ((true == fast_configuration) &&
+        (din_values.end() == std::find(din_values.begin(), din_values.end(),
+                                       !bit_value_to_skip))) {
+      continue;
+    }
+    word = addr_din_pair.first.first;
+    word += addr_din_pair.first.second;
+    for (const bool& din_value : din_values) {
+      word.push_back(din_value ? '1' : '0');
+    }
+    append_hex_word(block_buffer, word.data(), word.size());
+    if (HEX_FILE_BLOCK_SIZE <= block_buffer.size()) {
+      fp.write(block_buffer.data(), block_buffer.size());
+      block_buffer.clear();
+    }
+  }
+  fp.write(block_buffer.data(), block_buffer.size());
+
+  fp.close();
+}
+
+} /* end namespace openfpga */
@@ -0,0 +1,31 @@
+#ifndef WRITE_HEX_FABRIC_BITSTREAM_H
+#define WRITE_HEX_FABRIC_BITSTREAM_H
+
+/********************************************************************
+ * Include header files that are required by function declaration
+ *******************************************************************/
+#include <string>
+
+#include "bitstream_manager.h"
+#include "fabric_bitstream.h"
+#include "fabric_bitstream_utils.h"
+
+/********************************************************************
+ * Function declaration
+ *******************************************************************/
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+void write_config_chain_fabric_bitstream_to_hex_file(
+  const std::string& fname, const BitstreamManager& bitstream_manager,
+  const FabricBitstream& fabric_bitstream, const size_t& num_bits_to_skip);
+
+void write_memory_bank_fabric_bitstream_to_hex_file(
+  const std::string& fname,
+  const MemoryBankFabricBitstream& fabric_bits_by_addr,
+  const bool& fast_configuration, const bool& bit_value_to_skip);
+
+} /* end namespace openfpga */
+
+#endif
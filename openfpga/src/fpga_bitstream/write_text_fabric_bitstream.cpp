@@ -2,9 +2,13 @@
  * This file includes functions that output a fabric-dependent
  * bitstream database to files in plain text
  *******************************************************************/
+#include <algorithm>
 #include <chrono>
+#include <cstring>
 #include <ctime>
 #include <fstream>
+#include <iomanip>
+#include <memory>
 
 /* Headers from vtrutil library */
 #include "vtr_assert.h"
@@ -13,12 +17,17 @@
 
 /* Headers from openfpgautil library */
 #include "bitstream_manager_utils.h"
+#include "build_fabric_bitstream.h"
 #include "fabric_bitstream_utils.h"
 #include "fast_configuration.h"
 #include "openfpga_decode.h"
 #include "openfpga_digest.h"
 #include "openfpga_naming.h"
+#include "openfpga_parallel.h"
+#include "openfpga_trace.h"
 #include "openfpga_version.h"
+#include "read_bin_arch_bitstream.h"
+#include "read_xml_arch_bitstream.h"
 #include "write_text_fabric_bitstream.h"
 
 /* begin namespace openfpga */
@@ -42,6 +51,72 @@ static void write_fabric_bitstream_text_file_head(
   }
 }
 
+/********************************************************************
+ * This function writes the hash of each configuration region to a bitstream
+ * file, as fields '// Region <id> hash: <hexadecimal number>', so that
+ * the regions which are not changed between two bitstreams can be found
+ * without reading the data. See find_fabric_bitstream_region_hash()
+ *******************************************************************/
+static void write_fabric_bitstream_text_file_region_hashes(
+  std::fstream& fp, const BitstreamManager& bitstream_manager,
+  const FabricBitstream& fabric_bitstream) {
+  valid_file_stream(fp);
+
+  for (const FabricBitRegionId& region : fabric_bitstream.regions()) {
+    size_t hash = find_fabric_bitstream_region_hash(fabric_bitstream,
+                                                    bitstream_manager, region);
+    fp << "// Region " << size_t(region) << " hash: " << std::hex
+       << std::setw(16) << std::setfill('0') << hash << std::dec
+       << std::setfill(' ') << std::endl;
+  }
+}
+
+/********************************************************************
+ * Find which addresses of a fabric bitstream organized by addresses have
+ * data inputs different from a reference fabric bitstream, organized in
+ * the same way. Both fabric bitstreams share the same addresses, as they
+ * are built for the same FPGA fabric
+ *******************************************************************/
+template <class T>
+static std::vector<bool> find_fabric_bitstream_changed_addresses(
+  const T& fabric_bits_by_addr, const T& reference_fabric_bits_by_addr) {
+  VTR_ASSERT(fabric_bits_by_addr.size() ==
+             reference_fabric_bits_by_addr.size());
+  std::vector<bool> addr_changed;
+  addr_changed.reserve(fabric_bits_by_addr.size());
+  auto ref_it = reference_fabric_bits_by_addr.begin();
+  for (const auto& addr_din_pair : fabric_bits_by_addr) {
+    VTR_ASSERT(addr_din_pair.first == ref_it->first);
+    addr_changed.push_back(addr_din_pair.second != ref_it->second);
+    ++ref_it;
+  }
+  return addr_changed;
+}
+
+/********************************************************************
+ * Count the addresses to be written when only the addresses changed from a
+ * reference are written. The fast configuration may skip more of them.
+ *******************************************************************/
+template <class T>
+static size_t count_fabric_bitstream_changed_addresses(
+  const T& fabric_bits_by_addr, const std::vector<bool>& addr_changed,
+  const bool& fast_configuration, const bool& bit_value_to_skip) {
+  size_t num_addr_to_write = 0;
+  size_t iaddr = 0;
+  for (const auto& addr_din_pair : fabric_bits_by_addr) {
+    if ((true == addr_changed[iaddr]) &&
+        ((false == fast_configuration) ||
+         (addr_din_pair.second != std::vector<bool>(addr_din_pair.second.size(),
+                                                    bit_value_to_skip)))) {
+      num_addr_to_write++;
+    }
+    iaddr++;
+  }
+  VTR_LOG("Write %lu/%lu configuration cycles changed from reference.\n",
+          num_addr_to_write, fabric_bits_by_addr.size());
+  return num_addr_to_write;
+}
+
 /********************************************************************
  * Write the flatten fabric bitstream to a plain text file
  *
@@ -67,6 +142,51 @@ static int write_flatten_fabric_bitstream_to_text_file(
   return 0;
 }
 
+/********************************************************************
+ * Write the aligned regional bitstreams of a configuration chain protocol,
+ * where each line contains a bit of each region
+ *
+ * The regional bitstreams are transposed by blocks of lines, where each
+ * region is read in sequence and the characters of a block are gathered in
+ * a buffer which fits in cache, before being written in one shot
+ *******************************************************************/
+static void write_config_chain_regional_bitstreams_to_text_file(
+  std::fstream& fp, const ConfigChainFabricBitstream& regional_bitstreams,
+  const size_t& regional_bitstream_max_size, const size_t& num_bits_to_skip) {
+  /* Output bitstream size information */
+  fp << "// Bitstream length: "
+     << regional_bitstream_max_size - num_bits_to_skip << std::endl;
+  fp << "// Bitstream width (LSB -> MSB): " << regional_bitstreams.size()
+     << std::endl;
+
+  /* Each line contains a bit of each region and a line break */
+  size_t line_size = regional_bitstreams.size() + 1;
+  size_t num_lines_per_block = std::max(size_t(1), (1 << 16) / line_size);
+  std::string block_buffer;
+
+  /* Output bitstream data */
+  for (size_t block_start = num_bits_to_skip;
+       block_start < regional_bitstream_max_size;
+       block_start += num_lines_per_block) {
+    size_t block_end = std::min(block_start + num_lines_per_block,
+                                regional_bitstream_max_size);
+    block_buffer.assign((block_end - block_start) * line_size, '\n');
+    for (size_t iregion = 0; iregion < regional_bitstreams.size(); ++iregion) {
+      const std::vector<bool>& region_bitstream = regional_bitstreams[iregion];
+      size_t pos = iregion;
+      for (size_t ibit = block_start; ibit < block_end; ++ibit) {
+        block_buffer[pos] = region_bitstream[ibit] ? '1' : '0';
+        pos += line_size;
+      }
+    }
+    /* No line break after the last line */
+    if (block_end == regional_bitstream_max_size) {
+      block_buffer.pop_back();
+    }
+    fp.write(block_buffer.data(), block_buffer.size());
+  }
+}
+
 /********************************************************************
  * Write the fabric bitstream fitting a configuration chain protocol
  * to a plain text file
@@ -78,14 +198,14 @@ static int write_flatten_fabric_bitstream_to_text_file(
 static int write_config_chain_fabric_bitstream_to_text_file(
   std::fstream& fp, const bool& fast_configuration,
   const bool& bit_value_to_skip, const BitstreamManager& bitstream_manager,
-  const FabricBitstream& fabric_bitstream) {
+  const FabricBitstream& fabric_bitstream, const size_t& num_threads) {
   int status = 0;
 
   size_t regional_bitstream_max_size =
     find_fabric_regional_bitstream_max_size(fabric_bitstream);
   ConfigChainFabricBitstream regional_bitstreams =
-    build_config_chain_fabric_bitstream_by_region(bitstream_manager,
-                                                  fabric_bitstream);
+    build_config_chain_fabric_bitstream_by_region(
+      bitstream_manager, fabric_bitstream, num_threads);
 
   /* For fast configuration, the bitstream size counts from the first bit '1' */
   size_t num_bits_to_skip = 0;
@@ -101,22 +221,8 @@ static int write_config_chain_fabric_bitstream_to_text_file(
       num_bits_to_skip, regional_bitstream_max_size);
   }
 
-  /* Output bitstream size information */
-  fp << "// Bitstream length: "
-     << regional_bitstream_max_size - num_bits_to_skip << std::endl;
-  fp << "// Bitstream width (LSB -> MSB): " << fabric_bitstream.num_regions()
-     << std::endl;
-
-  /* Output bitstream data */
-  for (size_t ibit = num_bits_to_skip; ibit < regional_bitstream_max_size;
-       ++ibit) {
-    for (const auto& region_bitstream : regional_bitstreams) {
-      fp << region_bitstream[ibit];
-    }
-    if (ibit < regional_bitstream_max_size - 1) {
-      fp << std::endl;
-    }
-  }
+  write_config_chain_regional_bitstreams_to_text_file(
+    fp, regional_bitstreams, regional_bitstream_max_size, num_bits_to_skip);
 
   return status;
 }
@@ -131,12 +237,21 @@ static int write_config_chain_fabric_bitstream_to_text_file(
  *******************************************************************/
 static int write_memory_bank_fabric_bitstream_to_text_file(
   std::fstream& fp, const bool& fast_configuration,
-  const bool& bit_value_to_skip, const FabricBitstream& fabric_bitstream) {
+  const bool& bit_value_to_skip, const FabricBitstream& fabric_bitstream,
+  const FabricBitstream* reference_fabric_bitstream) {
   int status = 0;
 
   MemoryBankFabricBitstream fabric_bits_by_addr =
     build_memory_bank_fabric_bitstream_by_address(fabric_bitstream);
 
+  /* Only the addresses changed from the reference are written, if defined */
+  std::vector<bool> addr_changed;
+  if (nullptr != reference_fabric_bitstream) {
+    addr_changed = find_fabric_bitstream_changed_addresses(
+      fabric_bits_by_addr, build_memory_bank_fabric_bitstream_by_address(
+                             *reference_fabric_bitstream));
+  }
+
   /* The address sizes and data input sizes are the same across any element,
    * just get it from the 1st element to save runtime
    */
@@ -159,16 +274,29 @@ static int write_memory_bank_fabric_bitstream_to_text_file(
       num_bits_to_skip, fabric_bits_by_addr.size());
   }
 
+  size_t num_addr_to_write = fabric_bits_by_addr.size() - num_bits_to_skip;
+  if (false == addr_changed.empty()) {
+    num_addr_to_write = count_fabric_bitstream_changed_addresses(
+      fabric_bits_by_addr, addr_changed, fast_configuration, bit_value_to_skip);
+  }
+
   /* Output information about how to intepret the bitstream */
-  fp << "// Bitstream length: " << fabric_bits_by_addr.size() - num_bits_to_skip
-     << std::endl;
+  fp << "// Bitstream length: " << num_addr_to_write << std::endl;
   fp << "// Bitstream width (LSB -> MSB): ";
   fp << "<bl_address " << bl_addr_size << " bits>";
   fp << "<wl_address " << wl_addr_size << " bits>";
   fp << "<data input " << din_size << " bits>";
   fp << std::endl;
 
+  size_t iaddr = 0;
   for (const auto& addr_din_pair : fabric_bits_by_addr) {
+    /* Skip the addresses which are not changed from the reference */
+    bool addr_unchanged =
+      (false == addr_changed.empty()) && (false == addr_changed[iaddr]);
+    iaddr++;
+    if (true == addr_unchanged) {
+      continue;
+    }
     /* When fast configuration is enabled,
      * the rule to skip any configuration bit should consider the whole data
      * input values. Only all the bits in the din port match the value to be
@@ -245,6 +373,108 @@ static int write_memory_bank_flatten_fabric_bitstream_to_text_file(
   return status;
 }
 
+/********************************************************************
+ * Lookup tables to expand a byte of the BL data of a memory bank into
+ * 8 characters at once, the LSB first
+ * - The data table gives '0' or '1' for each bit of the byte
+ * - The mask table gives 0xFF for each bit of the byte which is valid,
+ *   and 0x00 otherwise, so that a valid character is selected by a mere
+ *   bitwise and
+ * Characters are combined lane by lane, so the result is the same whatever
+ * the endianness of the host
+ *******************************************************************/
+struct MemoryBankByteExpansionTables {
+  MemoryBankByteExpansionTables() {
+    for (size_t byte = 0; byte < 256; byte++) {
+      for (size_t bit = 0; bit < 8; bit++) {
+        bool bit_set = (byte >> bit) & 1;
+        datas[byte][bit] = bit_set ? '1' : '0';
+        masks[byte][bit] = bit_set ? char(0xFF) : char(0x00);
+      }
+    }
+  }
+  char datas[256][8];
+  char masks[256][8];
+};
+
+static const MemoryBankByteExpansionTables& memory_bank_byte_expansion() {
+  static const MemoryBankByteExpansionTables tables;
+  return tables;
+}
+
+/********************************************************************
+ * Expand the BLs of a WL of a memory bank into characters, where the
+ * invalid BLs are written as the don't care character
+ *******************************************************************/
+static void expand_memory_bank_bls_to_chars(const std::vector<uint8_t>& data,
+                                            const std::vector<uint8_t>& mask,
+                                            const size_t& num_bls,
+                                            const char& dont_care_bit,
+                                            char* chars) {
+  const MemoryBankByteExpansionTables& tables = memory_bank_byte_expansion();
+  VTR_ASSERT(8 * data.size() >= num_bls);
+  VTR_ASSERT(mask.size() == data.size());
+  uint64_t dont_care_word;
+  std::memset(&dont_care_word, dont_care_bit, sizeof(dont_care_word));
+  for (size_t ibyte = 0; 8 * ibyte < num_bls; ibyte++) {
+    uint64_t data_word;
+    uint64_t mask_word;
+    std::memcpy(&data_word, tables.datas[data[ibyte]], sizeof(data_word));
+    std::memcpy(&mask_word, tables.masks[mask[ibyte]], sizeof(mask_word));
+    uint64_t word = (data_word & mask_word) | (dont_care_word & ~mask_word);
+    /* The last byte may be partially used */
+    std::memcpy(chars + 8 * ibyte, &word,
+                std::min(size_t(8), num_bls - 8 * ibyte));
+  }
+}
+
+/********************************************************************
+ * Find the WL of a region to be written on each line of the bitstream
+ * file. A WL which is out of the region is given when the region has
+ * less WLs than the longest one, whose line is written as don't care
+ *******************************************************************/
+static std::vector<fabric_size_t> find_memory_bank_region_wls_to_write(
+  const size_t& num_wls, const std::vector<fabric_size_t>& wls_to_skip,
+  const size_t& num_lines, const bool& wl_incremental_order) {
+  std::vector<bool> skip_wls(num_wls, false);
+  for (const fabric_size_t& wl : wls_to_skip) {
+    if (wl < num_wls) {
+      skip_wls[wl] = true;
+    }
+  }
+  // The intialization depends the ordering of WL
+  // It could either be 0 (if wl_incremental_order=true) or
+  // last WL index (if wl_incremental_order=false)
+  // Since fabric_size_t is unsigned, an underflow of -1 is considered as an
+  // overflow too
+  fabric_size_t current_wl = 0;
+  if (!wl_incremental_order) {
+    current_wl = (fabric_size_t)(num_wls - 1);
+  }
+  std::vector<fabric_size_t> wls_to_write;
+  wls_to_write.reserve(num_lines);
+  for (size_t line = 0; line < num_lines; line++) {
+    // If it happen that current WL is one of the WLs that we had determined
+    // to skip, the we will increment or decrement to next
+    while (current_wl < num_wls && skip_wls[current_wl]) {
+      if (wl_incremental_order) {
+        current_wl++;
+      } else {
+        current_wl--;
+      }
+    }
+    wls_to_write.push_back(current_wl);
+    if (current_wl < num_wls) {
+      if (wl_incremental_order) {
+        current_wl++;
+      } else {
+        current_wl--;
+      }
+    }
+  }
+  return wls_to_write;
+}
+
 /********************************************************************
  * Write the fabric bitstream fitting a memory bank protocol
  * to a plain text file in efficient method
@@ -276,18 +506,49 @@ static int write_memory_bank_flatten_fabric_bitstream_to_text_file(
 static int fast_write_memory_bank_flatten_fabric_bitstream_to_text_file(
   std::fstream& fp, const bool& fast_configuration,
   const bool& bit_value_to_skip, const FabricBitstream& fabric_bitstream,
-  const bool& keep_dont_care_bits, const bool& wl_incremental_order) {
+  const bool& keep_dont_care_bits, const bool& wl_incremental_order,
+  const size_t& num_threads,
+  const FabricBitstream* reference_fabric_bitstream) {
   int status = 0;
 
-  std::string dont_care_bit = "0";
+  char dont_care_bit = '0';
   if (keep_dont_care_bits) {
-    dont_care_bit = "x";
+    dont_care_bit = DONT_CARE_CHAR;
   }
   const FabricBitstreamMemoryBank& memory_bank =
-    fabric_bitstream.memory_bank_info(fast_configuration, bit_value_to_skip);
+    fabric_bitstream.memory_bank_info(fast_configuration, bit_value_to_skip,
+                                      num_threads);
 
   fabric_size_t longest_effective_wl_count =
     memory_bank.get_longest_effective_wl_count();
+  std::vector<std::vector<fabric_size_t>> wls_to_skip =
+    memory_bank.wls_to_skip;
+
+  /* Only the WLs changed from the reference are written, if defined. A WL is
+   * changed when any of its BLs has a different value */
+  if (nullptr != reference_fabric_bitstream) {
+    const FabricBitstreamMemoryBank& reference_memory_bank =
+      reference_fabric_bitstream->memory_bank_info();
+    VTR_ASSERT(reference_memory_bank.datas.size() == memory_bank.datas.size());
+    longest_effective_wl_count = 0;
+    for (size_t region = 0; region < memory_bank.datas.size(); region++) {
+      const std::vector<fabric_size_t> fast_wls_to_skip = wls_to_skip[region];
+      for (size_t wl = 0; wl < memory_bank.datas[region].size(); wl++) {
+        if ((memory_bank.datas[region][wl] ==
+             reference_memory_bank.datas[region][wl]) &&
+            (std::find(fast_wls_to_skip.begin(), fast_wls_to_skip.end(),
+                       fabric_size_t(wl)) == fast_wls_to_skip.end())) {
+          wls_to_skip[region].push_back(fabric_size_t(wl));
+        }
+      }
+      longest_effective_wl_count = std::max(
+        longest_effective_wl_count,
+        fabric_size_t(memory_bank.datas[region].size() -
+                      wls_to_skip[region].size()));
+    }
+    VTR_LOG("Write %lu WLs changed from reference.\n",
+            size_t(longest_effective_wl_count));
+  }
   /* Output information about how to intepret the bitstream */
   fp << "// Bitstream length: " << longest_effective_wl_count << std::endl;
   fp << "// Bitstream width (LSB -> MSB): ";
@@ -296,139 +557,84 @@ static int fast_write_memory_bank_flatten_fabric_bitstream_to_text_file(
   fp << std::endl;
 
   // Step 1
-  // Initialize wl_indexes for every region
-  // The intialization depends the ordering of WL
-  // It could either be 0 (if wl_incremental_order=true) or
-  // last WL index (if wl_incremental_order=false)
-  std::vector<fabric_size_t> wl_indexes;
-  for (size_t region = 0; region < memory_bank.datas.size(); region++) {
-    if (wl_incremental_order) {
-      wl_indexes.push_back(0);
-    } else {
-      wl_indexes.push_back(
-        (fabric_size_t)(memory_bank.datas[region].size() - 1));
-    }
+  // Find the WL to be written on each line for every region
+  // The sequence of configuration of each region WL is not the same
+  //   since WL to skip for each region is not the same
+  const size_t num_regions = memory_bank.datas.size();
+  std::vector<std::vector<fabric_size_t>> wls_to_write(num_regions);
+  parallel_for(num_regions, num_threads, [&](const size_t& region) {
+    wls_to_write[region] = find_memory_bank_region_wls_to_write(
+      memory_bank.datas[region].size(), wls_to_skip[region],
+      longest_effective_wl_count, wl_incremental_order);
+  });
+
+  size_t line_length = 1;
+  for (size_t region = 0; region < num_regions; region++) {
+    line_length +=
+      memory_bank.blwl_lengths[region].bl + memory_bank.blwl_lengths[region].wl;
   }
-  // Step 2
-  // Loop through total WL count that we would like to configure
-  for (size_t wl_index = 0; wl_index < longest_effective_wl_count; wl_index++) {
-    // Step 3
-    // Write BL address
-    // We cascade all regions: 0, 1, 2 ...
-    for (size_t region = 0; region < memory_bank.datas.size(); region++) {
-      // Step 3a
-      // The sequence of configuration of each region WL is not the same
-      //   since WL to skip for each region is not the same
-      // If it happen that current WL that we are going to program is
-      //   one of the WLs (stored in wls_to_skip) that we had determined
-      //   to skip, the we will increment or decrement to next
-      //   depending on wl_incremental_order
+  /* Lines are written by chunks of about 16MB, to bound the memory */
+  const size_t lines_per_chunk =
+    std::max(size_t(1), size_t(16 * 1024 * 1024) / line_length);
+  std::vector<std::string> region_bls(num_regions);
+  std::vector<std::string> region_wls(num_regions);
+  std::string chunk;
+
+  for (size_t chunk_begin = 0; chunk_begin < longest_effective_wl_count;
+       chunk_begin += lines_per_chunk) {
+    const size_t chunk_end = std::min(size_t(longest_effective_wl_count),
+                                      chunk_begin + lines_per_chunk);
+    const size_t num_lines = chunk_end - chunk_begin;
+    // Step 2
+    // Expand the BL and WL addresses of the lines of the chunk, each region
+    // into its own buffer
+    parallel_for(num_regions, num_threads, [&](const size_t& region) {
       const fabric_blwl_length& lengths = memory_bank.blwl_lengths[region];
-      fabric_size_t current_wl = wl_indexes[region];
-      while (std::find(memory_bank.wls_to_skip[region].begin(),
-                       memory_bank.wls_to_skip[region].end(),
-                       current_wl) != memory_bank.wls_to_skip[region].end()) {
-        // We would like to skip this
-        if (wl_incremental_order) {
-          wl_indexes[region]++;
-        } else {
-          wl_indexes[region]--;
+      std::string& bls = region_bls[region];
+      std::string& wls = region_wls[region];
+      bls.assign(num_lines * lengths.bl, dont_care_bit);
+      wls.assign(num_lines * lengths.wl, dont_care_bit);
+      for (size_t line = 0; line < num_lines; line++) {
+        fabric_size_t current_wl = wls_to_write[region][chunk_begin + line];
+        // If current WL is out of the range, it is because not all region
+        // has equal WL. For those that is shorter, print don't care for all
+        // BL and WL
+        if (current_wl >= memory_bank.datas[region].size()) {
+          continue;
         }
-        current_wl = wl_indexes[region];
-      }
-      // Step 3b
-      // If current WL still within the valid range, we will print BL
-      // Otherwise it is either
-      //   overflow (wl_incremental_order=true) or
-      //   underflow (to max fabric_blwl_length when wl_incremental_order=false)
-      // Since fabric_blwl_length is unsigned, hence underflow of -1 will be
-      //   considered as overflow too
-      // If it is overflow/underflow, then we just print don't care
-      if (current_wl < memory_bank.datas[region].size()) {
-        const std::vector<uint8_t>& data =
-          memory_bank.datas[region][current_wl];
-        const std::vector<uint8_t>& mask =
-          memory_bank.masks[region][current_wl];
-        // Step 3c
-        // Real code to print BL data that we had stored
         // mask tell you each BL is valid
         //   for invalid BL, we will print don't care
         // data tell you the real din value
-        // (bl >> 3) - This is to find Byte index of the BL
-        // (1 << (bl & 7)) - This is to find Bit index of the BL
-        //                   within that Byte index
-        // When we '&' both, we can know if that BL is set or unset
-        /*
-          -----------------------------------------------------------------
-          |  bit (bl)  |  Byte index (bl >> 3) | Bit index (1 << (bl & 7)) |
-          |----------------------------------------------------------------
-          |  0         |             0         |    b0000_0001 (or 0x01)   |
-          |  1         |             0         |    b0000_0010 (or 0x02)   |
-          |  2         |             0         |    b0000_0100 (or 0x04)   |
-          |  3         |             0         |    b0000_1000 (or 0x08)   |
-          |  4         |             0         |    b0001_0000 (or 0x10)   |
-          |  5         |             0         |    b0010_0000 (or 0x20)   |
-          |  6         |             0         |    b0100_0000 (or 0x40)   |
-          |  7         |             0         |    b1000_0000 (or 0x80)   |
-          |  8         |             1         |    b0000_0001 (or 0x01)   |
-          | ...        |            ...        |          ...              |
-          ------------------------------------------------------------------
-          Each BL can be uniquely represented by bit slice in byte array
-        */
-        for (size_t bl = 0; bl < lengths.bl; bl++) {
-          if (mask[bl >> 3] & (1 << (bl & 7))) {
-            if (data[bl >> 3] & (1 << (bl & 7))) {
-              fp << "1";
-            } else {
-              fp << "0";
-            }
-          } else {
-            fp << dont_care_bit.c_str();
-          }
-        }
-      } else {
-        /* However not all region has equal WL, for those that is shorter,
-         * print 'x' for all BL*/
-        for (size_t bl = 0; bl < lengths.bl; bl++) {
-          fp << dont_care_bit.c_str();
-        }
-      }
-    }
-    // Step 4
-    // Write WL address
-    // We cascade all regions: 0, 1, 2 ...
-    for (size_t region = 0; region < memory_bank.datas.size(); region++) {
-      const fabric_blwl_length& lengths = memory_bank.blwl_lengths[region];
-      fabric_size_t current_wl = wl_indexes[region];
-      // Step 4a
-      // If current WL still within the valid range, we will print WL
-      // Otherwise it is overflow/underflow then we will print don't care
-      if (current_wl < memory_bank.datas[region].size()) {
-        // Step 4b
+        // Bit (bl & 7) of Byte (bl >> 3) represents a BL
+        expand_memory_bank_bls_to_chars(
+          memory_bank.datas[region][current_wl],
+          memory_bank.masks[region][current_wl], lengths.bl, dont_care_bit,
+          &bls[line * lengths.bl]);
         // One hot printing
-        for (size_t wl_temp = 0; wl_temp < lengths.wl; wl_temp++) {
-          if (wl_temp == current_wl) {
-            fp << "1";
-          } else {
-            fp << "0";
-          }
-        }
-        // Step 4b
-        // Increment or decrement to next depending on wl_incremental_order
-        if (wl_incremental_order) {
-          wl_indexes[region]++;
-        } else {
-          wl_indexes[region]--;
-        }
-      } else {
-        /* However not all region has equal WL, for those that is shorter,
-         * print 'x' for all WL */
-        for (size_t wl_temp = 0; wl_temp < lengths.wl; wl_temp++) {
-          fp << dont_care_bit.c_str();
+        char* wl_chars = &wls[line * lengths.wl];
+        std::fill(wl_chars, wl_chars + lengths.wl, '0');
+        if (current_wl < lengths.wl) {
+          wl_chars[current_wl] = '1';
         }
       }
+    });
+    // Step 3
+    // Cascade the regions of each line: BL addresses of regions 0, 1, 2 ...
+    // then WL addresses of regions 0, 1, 2 ...
+    chunk.clear();
+    chunk.reserve(num_lines * line_length);
+    for (size_t line = 0; line < num_lines; line++) {
+      for (size_t region = 0; region < num_regions; region++) {
+        const size_t bl_length = memory_bank.blwl_lengths[region].bl;
+        chunk.append(region_bls[region], line * bl_length, bl_length);
+      }
+      for (size_t region = 0; region < num_regions; region++) {
+        const size_t wl_length = memory_bank.blwl_lengths[region].wl;
+        chunk.append(region_wls[region], line * wl_length, wl_length);
+      }
+      chunk.push_back('\n');
     }
-    fp << std::endl;
+    fp.write(chunk.data(), chunk.size());
   }
   return status;
 }
@@ -475,15 +681,15 @@ static int write_memory_bank_shift_register_fabric_bitstream_to_text_file(
 
     /* Write BL address code */
     fp << "// BL part " << std::endl;
-    for (const auto& bl_vec : fabric_bits.bl_vectors(word)) {
-      fp << bl_vec;
+    for (size_t ivec = 0; ivec < fabric_bits.bl_word_size(); ++ivec) {
+      fp << fabric_bits.bl_vector(word, ivec);
       fp << std::endl;
     }
 
     /* Write WL address code */
     fp << "// WL part " << std::endl;
-    for (const auto& wl_vec : fabric_bits.wl_vectors(word)) {
-      fp << wl_vec;
+    for (size_t ivec = 0; ivec < fabric_bits.wl_word_size(); ++ivec) {
+      fp << fabric_bits.wl_vector(word, ivec);
       fp << std::endl;
     }
 
@@ -503,12 +709,21 @@ static int write_memory_bank_shift_register_fabric_bitstream_to_text_file(
  *******************************************************************/
 static int write_frame_based_fabric_bitstream_to_text_file(
   std::fstream& fp, const bool& fast_configuration,
-  const bool& bit_value_to_skip, const FabricBitstream& fabric_bitstream) {
+  const bool& bit_value_to_skip, const FabricBitstream& fabric_bitstream,
+  const FabricBitstream* reference_fabric_bitstream) {
   int status = 0;
 
   FrameFabricBitstream fabric_bits_by_addr =
     build_frame_based_fabric_bitstream_by_address(fabric_bitstream);
 
+  /* Only the frames changed from the reference are written, if defined */
+  std::vector<bool> addr_changed;
+  if (nullptr != reference_fabric_bitstream) {
+    addr_changed = find_fabric_bitstream_changed_addresses(
+      fabric_bits_by_addr, build_frame_based_fabric_bitstream_by_address(
+                             *reference_fabric_bitstream));
+  }
+
   /* The address sizes and data input sizes are the same across any element,
    * just get it from the 1st element to save runtime
    */
@@ -530,13 +745,26 @@ static int write_frame_based_fabric_bitstream_to_text_file(
       num_bits_to_skip, fabric_bits_by_addr.size());
   }
 
+  size_t num_addr_to_write = fabric_bits_by_addr.size() - num_bits_to_skip;
+  if (false == addr_changed.empty()) {
+    num_addr_to_write = count_fabric_bitstream_changed_addresses(
+      fabric_bits_by_addr, addr_changed, fast_configuration, bit_value_to_skip);
+  }
+
   /* Output information about how to intepret the bitstream */
-  fp << "// Bitstream length: " << fabric_bits_by_addr.size() - num_bits_to_skip
-     << std::endl;
+  fp << "// Bitstream length: " << num_addr_to_write << std::endl;
   fp << "// Bitstream width (LSB -> MSB): <address " << addr_size
      << " bits><data input " << din_size << " bits>" << std::endl;
 
+  size_t iaddr = 0;
   for (const auto& addr_din_pair : fabric_bits_by_addr) {
+    /* Skip the addresses which are not changed from the reference */
+    bool addr_unchanged =
+      (false == addr_changed.empty()) && (false == addr_changed[iaddr]);
+    iaddr++;
+    if (true == addr_unchanged) {
+      continue;
+    }
     /* When fast configuration is enabled,
      * the rule to skip any configuration bit should consider the whole data
      * input values. Only all the bits in the din port match the value to be
@@ -562,6 +790,61 @@ static int write_frame_based_fabric_bitstream_to_text_file(
   return status;
 }
 
+/********************************************************************
+ * Read the architecture bitstream of a reference implementation, which
+ * should be built for the same FPGA fabric as the current one.
+ * This is only applicable to the configuration protocols where each
+ * configuration cycle is addressed, so that the cycles unchanged from the
+ * reference can be skipped
+ *
+ * Return:
+ *  - 0 if succeed
+ *  - 1 if critical errors occured
+ *******************************************************************/
+static int read_reference_architecture_bitstream(
+  BitstreamManager& reference_bitstream_manager,
+  const BitstreamManager& bitstream_manager,
+  const ConfigProtocol& config_protocol, const BitstreamWriterOption& options) {
+  bool addressed_protocol =
+    (CONFIG_MEM_MEMORY_BANK == config_protocol.type()) ||
+    (CONFIG_MEM_FRAME_BASED == config_protocol.type());
+  if (CONFIG_MEM_QL_MEMORY_BANK == config_protocol.type()) {
+    addressed_protocol =
+      (BLWL_PROTOCOL_DECODER == config_protocol.bl_protocol_type()) ||
+      ((BLWL_PROTOCOL_FLATTEN == config_protocol.bl_protocol_type()) &&
+       (BLWL_PROTOCOL_FLATTEN == config_protocol.wl_protocol_type()));
+  }
+  if (false == addressed_protocol) {
+    VTR_LOG_ERROR(
+      "Reference bitstream is only applicable to memory bank and frame-based "
+      "configuration protocols!\n");
+    return 1;
+  }
+
+  std::string reference_file = options.reference_file();
+  if (true == is_bin_architecture_bitstream_file(reference_file.c_str())) {
+    reference_bitstream_manager =
+      read_bin_architecture_bitstream(reference_file.c_str());
+  } else {
+    reference_bitstream_manager =
+      read_xml_architecture_bitstream(reference_file.c_str());
+  }
+  if (false == is_bitstream_manager_structure_equal(
+                 reference_bitstream_manager, bitstream_manager)) {
+    VTR_LOG_ERROR(
+      "Reference bitstream '%s' is not built for the same FPGA fabric!\n",
+      reference_file.c_str());
+    return 1;
+  }
+  VTR_LOGV(options.verbose_output(),
+           "%lu configuration bits are changed from reference bitstream\n",
+           find_bitstream_manager_changed_bits(reference_bitstream_manager,
+                                               bitstream_manager)
+             .size());
+
+  return 0;
+}
+
 /********************************************************************
  * Write the fabric bitstream to a plain text file
  * Notes:
@@ -581,6 +864,7 @@ int write_fabric_bitstream_to_text_file(
   const ConfigProtocol& config_protocol,
   const FabricGlobalPortInfo& global_ports,
   const BitstreamWriterOption& options) {
+  TraceScope trace_scope("write_fabric_bitstream_to_text_file");
   VTR_ASSERT(options.output_file_type() ==
              BitstreamWriterOption::e_bitfile_type::TEXT);
   std::string fname = options.output_file_name();
@@ -618,8 +902,31 @@ int write_fabric_bitstream_to_text_file(
       fabric_bitstream);
   }
 
+  /* The fabric bitstream of a reference implementation shares the addresses
+   * of the current one, while the data inputs are the values of the
+   * reference architecture bitstream */
+  std::unique_ptr<FabricBitstream> reference_fabric_bitstream;
+  if (false == options.reference_file().empty()) {
+    BitstreamManager reference_bitstream_manager;
+    if (0 != read_reference_architecture_bitstream(
+               reference_bitstream_manager, bitstream_manager,
+               config_protocol, options)) {
+      fp.close();
+      return 1;
+    }
+    reference_fabric_bitstream =
+      std::make_unique<FabricBitstream>(fabric_bitstream);
+    update_fabric_bitstream_dins(*reference_fabric_bitstream,
+                                 reference_bitstream_manager);
+  }
+  const FabricBitstream* reference = reference_fabric_bitstream.get();
+
   /* Write file head */
   write_fabric_bitstream_text_file_head(fp, options.time_stamp());
+  if (true == options.region_hash()) {
+    write_fabric_bitstream_text_file_region_hashes(fp, bitstream_manager,
+                                                   fabric_bitstream);
+  }
 
   /* Output fabric bitstream to the file */
   int status = 0;
@@ -631,7 +938,7 @@ int write_fabric_bitstream_to_text_file(
     case CONFIG_MEM_SCAN_CHAIN:
       status = write_config_chain_fabric_bitstream_to_text_file(
         fp, apply_fast_configuration, bit_value_to_skip, bitstream_manager,
-        fabric_bitstream);
+        fabric_bitstream, options.num_threads());
       break;
     case CONFIG_MEM_QL_MEMORY_BANK: {
       /* Bitstream organization depends on the BL/WL protocols
@@ -645,14 +952,16 @@ int write_fabric_bitstream_to_text_file(
        */
       if (BLWL_PROTOCOL_DECODER == config_protocol.bl_protocol_type()) {
         status = write_memory_bank_fabric_bitstream_to_text_file(
-          fp, apply_fast_configuration, bit_value_to_skip, fabric_bitstream);
+          fp, apply_fast_configuration, bit_value_to_skip, fabric_bitstream,
+          reference);
       } else if (BLWL_PROTOCOL_FLATTEN == config_protocol.bl_protocol_type() &&
                  BLWL_PROTOCOL_FLATTEN == config_protocol.wl_protocol_type()) {
         // If both BL and WL protocols are flatten, use new way to write the
         // bitstream
         status = fast_write_memory_bank_flatten_fabric_bitstream_to_text_file(
           fp, apply_fast_configuration, bit_value_to_skip, fabric_bitstream,
-          options.keep_dont_care_bits(), !options.wl_decremental_order());
+          options.keep_dont_care_bits(), !options.wl_decremental_order(),
+          options.num_threads(), reference);
 
       } else if (BLWL_PROTOCOL_FLATTEN == config_protocol.bl_protocol_type()) {
         status = write_memory_bank_flatten_fabric_bitstream_to_text_file(
@@ -669,11 +978,13 @@ int write_fabric_bitstream_to_text_file(
     }
     case CONFIG_MEM_MEMORY_BANK:
       status = write_memory_bank_fabric_bitstream_to_text_file(
-        fp, apply_fast_configuration, bit_value_to_skip, fabric_bitstream);
+        fp, apply_fast_configuration, bit_value_to_skip, fabric_bitstream,
+        reference);
       break;
     case CONFIG_MEM_FRAME_BASED:
       status = write_frame_based_fabric_bitstream_to_text_file(
-        fp, apply_fast_configuration, bit_value_to_skip, fabric_bitstream);
+        fp, apply_fast_configuration, bit_value_to_skip, fabric_bitstream,
+        reference);
       break;
     default:
       VTR_LOGF_ERROR(__FILE__, __LINE__,
@@ -684,6 +995,8 @@ int write_fabric_bitstream_to_text_file(
   /* Print an end to the file here */
   fp << std::endl;
 
+  trace_counter("bytes_written", size_t(fp.tellp()));
+
   /* Close file handler */
   fp.close();
 
@@ -694,4 +1007,150 @@ int write_fabric_bitstream_to_text_file(
   return status;
 }
 
+/********************************************************************
+ * Write the fabric bitstream of a chain-like configuration protocol, i.e.,
+ * standalone or scan-chain, to a plain text file without building a
+ * fabric bitstream database. The configuration bits are visited in the
+ * module graph in the same order as build_fabric_dependent_bitstream(),
+ * and the file is the same as write_fabric_bitstream_to_text_file()
+ * - For the standalone protocol, each bit is written as soon as it is visited
+ * - For the scan-chain protocol, only the values of the bits are kept, as
+ *   regions have to be aligned before being written
+ *
+ * Return:
+ *  - 0 if succeed
+ *  - 1 if critical errors occured
+ *******************************************************************/
+int stream_fabric_bitstream_to_text_file(
+  const BitstreamManager& bitstream_manager,
+  const ModuleManager& module_manager, const ModuleNameMap& module_name_map,
+  const ConfigProtocol& config_protocol,
+  const FabricGlobalPortInfo& global_ports,
+  const BitstreamWriterOption& options) {
+  TraceScope trace_scope("stream_fabric_bitstream_to_text_file");
+  VTR_ASSERT(options.output_file_type() ==
+             BitstreamWriterOption::e_bitfile_type::TEXT);
+  if ((CONFIG_MEM_STANDALONE != config_protocol.type()) &&
+      (CONFIG_MEM_SCAN_CHAIN != config_protocol.type())) {
+    VTR_LOG_ERROR(
+      "Streaming fabric bitstream is only supported by standalone and "
+      "scan-chain configuration protocols!\n");
+    return 1;
+  }
+  std::string fname = options.output_file_name();
+  /* Ensure that we have a valid file name */
+  if (true == fname.empty()) {
+    VTR_LOG_ERROR(
+      "Received empty file name to output bitstream!\n\tPlease specify a valid "
+      "file name.\n");
+  }
+
+  std::string timer_message =
+    std::string("Stream ") + std::to_string(bitstream_manager.num_bits()) +
+    std::string(" fabric bitstream into plain text file '") + fname +
+    std::string("'");
+  vtr::ScopedStartFinishTimer timer(timer_message);
+
+  /* Create the file stream */
+  std::fstream fp;
+  fp.open(fname, std::fstream::out | std::fstream::trunc);
+
+  check_file_stream(fname.c_str(), fp);
+
+  bool apply_fast_configuration =
+    is_fast_configuration_applicable(global_ports) &&
+    options.fast_configuration();
+  if (options.fast_configuration() &&
+      apply_fast_configuration != options.fast_configuration()) {
+    VTR_LOG_WARN("Disable fast configuration even it is enabled by user\n");
+  }
+
+  /* Write file head */
+  write_fabric_bitstream_text_file_head(fp, options.time_stamp());
+
+  if (CONFIG_MEM_STANDALONE == config_protocol.type()) {
+    /* Output bitstream size information */
+    fp << "// Bitstream length: " << bitstream_manager.num_bits() << std::endl;
+
+    /* Output bitstream data */
+    walk_chain_fabric_dependent_bitstream(
+      bitstream_manager, module_manager, module_name_map, config_protocol,
+      [&](const size_t&, const ConfigBitId& config_bit) {
+        fp << bitstream_manager.bit_value(config_bit);
+      },
+      options.verbose_output());
+  } else {
+    VTR_ASSERT(CONFIG_MEM_SCAN_CHAIN == config_protocol.type());
+    ConfigChainFabricBitstream regional_bitstreams;
+    walk_chain_fabric_dependent_bitstream(
+      bitstream_manager, module_manager, module_name_map, config_protocol,
+      [&](const size_t& region, const ConfigBitId& config_bit) {
+        if (region >= regional_bitstreams.size()) {
+          regional_bitstreams.resize(region + 1);
+        }
+        regional_bitstreams[region].push_back(
+          bitstream_manager.bit_value(config_bit));
+      },
+      options.verbose_output());
+
+    bool bit_value_to_skip = false;
+    if (apply_fast_configuration) {
+      bit_value_to_skip =
+        find_config_chain_bit_value_to_skip_for_fast_configuration(
+          global_ports, regional_bitstreams);
+    }
+
+    /* The head of the chain is loaded last. Align the regions by adding
+     * zeros to the head of the shorter ones */
+    size_t regional_bitstream_max_size = 0;
+    for (const std::vector<bool>& region_bitstream : regional_bitstreams) {
+      regional_bitstream_max_size =
+        std::max(regional_bitstream_max_size, region_bitstream.size());
+    }
+    size_t num_bits_to_skip = size_t(-1);
+    for (std::vector<bool>& region_bitstream : regional_bitstreams) {
+      std::reverse(region_bitstream.begin(), region_bitstream.end());
+      size_t offset = regional_bitstream_max_size - region_bitstream.size();
+      region_bitstream.insert(region_bitstream.begin(), offset, false);
+      /* For fast configuration, the bitstream size counts from the first bit
+       * which can not be skipped in any region */
+      size_t curr_region_num_bits_to_skip = offset;
+      while ((curr_region_num_bits_to_skip < region_bitstream.size()) &&
+             (bit_value_to_skip ==
+              region_bitstream[curr_region_num_bits_to_skip])) {
+        curr_region_num_bits_to_skip++;
+      }
+      num_bits_to_skip =
+        std::min(curr_region_num_bits_to_skip, num_bits_to_skip);
+    }
+    if (false == apply_fast_configuration) {
+      num_bits_to_skip = 0;
+    } else {
+      VTR_ASSERT(num_bits_to_skip < regional_bitstream_max_size);
+      VTR_LOG(
+        "Fast configuration will skip %g% (%lu/%lu) of configuration "
+        "bitstream.\n",
+        100. * (float)num_bits_to_skip / (float)regional_bitstream_max_size,
+        num_bits_to_skip, regional_bitstream_max_size);
+    }
+
+    write_config_chain_regional_bitstreams_to_text_file(
+      fp, regional_bitstreams, regional_bitstream_max_size, num_bits_to_skip);
+  }
+
+  /* Print an end to the file here */
+  fp << std::endl;
+
+  trace_counter("bytes_written", size_t(fp.tellp()));
+
+  /* Close file handler */
+  fp.close();
+
+  VTR_LOGV(options.verbose_output(),
+           "Outputted %lu configuration bits to plain text file: %s\n",
+           bitstream_manager.num_bits(), fname.c_str());
+
+  return 0;
+}
+
 } /* end namespace openfpga */
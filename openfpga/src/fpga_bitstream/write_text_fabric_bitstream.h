@@ -13,6 +13,8 @@
 #include "fabric_bitstream.h"
 #include "fabric_global_port_info.h"
 #include "memory_bank_shift_register_banks.h"
+#include "module_manager.h"
+#include "module_name_map.h"
 
 /********************************************************************
  * Function declaration
@@ -29,6 +31,13 @@ int write_fabric_bitstream_to_text_file(
   const FabricGlobalPortInfo& global_ports,
   const BitstreamWriterOption& options);
 
+int stream_fabric_bitstream_to_text_file(
+  const BitstreamManager& bitstream_manager,
+  const ModuleManager& module_manager, const ModuleNameMap& module_name_map,
+  const ConfigProtocol& config_protocol,
+  const FabricGlobalPortInfo& global_ports,
+  const BitstreamWriterOption& options);
+
 } /* end namespace openfpga */
 
 #endif
@@ -2,9 +2,12 @@
  * This file includes functions that output a fabric-dependent
  * bitstream database to files in XML format
  *******************************************************************/
+#include <algorithm>
 #include <chrono>
 #include <ctime>
 #include <fstream>
+#include <string>
+#include <vector>
 
 /* Headers from vtrutil library */
 #include "vtr_assert.h"
@@ -13,11 +16,13 @@
 
 /* Headers from openfpgautil library */
 #include "openfpga_digest.h"
+#include "openfpga_parallel.h"
 
 /* Headers from archopenfpga library */
 
 #include "bitstream_manager_utils.h"
 #include "openfpga_naming.h"
+#include "openfpga_trace.h"
 #include "write_xml_fabric_bitstream.h"
 
 /* begin namespace openfpga */
@@ -46,7 +51,52 @@ static void write_fabric_bitstream_xml_file_head(
 }
 
 /********************************************************************
- * Write a configuration bit into a plain text file
+ * The hierarchical path of the configuration bits of a parent block, which
+ * is cached so that the path is not rebuilt for every bit.
+ * Since the bits of a block have consecutive ids, the index of a bit in its
+ * parent (or grandparent) block is its offset to the first bit of the block
+ * plus the index of the first bit
+ *******************************************************************/
+struct XmlBitPathCache {
+  ConfigBlockId block = ConfigBlockId::INVALID();
+  std::string prefix;
+  size_t first_bit = 0;
+  size_t first_bit_index = 0;
+};
+
+static void update_xml_bit_path_cache(XmlBitPathCache& cache,
+                                      const BitstreamManager& bitstream_manager,
+                                      const ConfigBlockId& config_block,
+                                      const BitstreamWriterOption& options) {
+  if (cache.block == config_block) {
+    return;
+  }
+  cache.block = config_block;
+  cache.prefix.clear();
+  /* If enabled, pop the last block name */
+  ConfigBlockId path_block = config_block;
+  if (options.trim_path()) {
+    path_block = bitstream_manager.block_parent(config_block);
+  }
+  if (true == bitstream_manager.valid_block_id(path_block)) {
+    cache.prefix += bitstream_manager.block_path(path_block);
+    cache.prefix += std::string(".");
+  }
+  cache.prefix += generate_configurable_memory_data_out_name();
+  cache.prefix += std::string("[");
+
+  ConfigBitId first_bit = bitstream_manager.block_bits(config_block).front();
+  cache.first_bit = size_t(first_bit);
+  cache.first_bit_index = 0;
+  if (options.trim_path()) {
+    cache.first_bit_index =
+      find_bitstream_manager_config_bit_index_in_grandparent_block(
+        bitstream_manager, first_bit);
+  }
+}
+
+/********************************************************************
+ * Write a configuration bit into a buffer in XML format
  * General format
  *   <bit id="<fabric_bit>" value="<config_bit_value>">
  *     <hierarchy>
@@ -68,61 +118,40 @@ static void write_fabric_bitstream_xml_file_head(
  *  - 0 if succeed
  *  - 1 if critical errors occured
  *******************************************************************/
-static int write_fabric_config_bit_to_xml_file(
-  std::fstream& fp, const BitstreamManager& bitstream_manager,
+static int write_fabric_config_bit_to_xml_buffer(
+  std::string& buffer, const BitstreamManager& bitstream_manager,
   const FabricBitstream& fabric_bitstream, const FabricBitId& fabric_bit,
   const e_config_protocol_type& config_type, bool fast_xml,
   const int& xml_hierarchy_depth, std::string& bl_addr, std::string& wl_addr,
-  const BitstreamWriterOption& options) {
-  if (false == valid_file_stream(fp)) {
-    return 1;
-  }
-  if (options.value_to_skip(
-        bitstream_manager.bit_value(fabric_bitstream.config_bit(fabric_bit)))) {
+  XmlBitPathCache& path_cache, const BitstreamWriterOption& options) {
+  const ConfigBitId& config_bit = fabric_bitstream.config_bit(fabric_bit);
+  bool bit_value = bitstream_manager.bit_value(config_bit);
+  if (options.value_to_skip(bit_value)) {
     return 0;
   }
 
-  write_tab_to_file(fp, xml_hierarchy_depth);
-  fp << "<bit id=\"" << size_t(fabric_bit) << "\"";
+  buffer.append(xml_hierarchy_depth, '\t');
+  buffer += "<bit id=\"";
+  buffer += std::to_string(size_t(fabric_bit));
+  buffer += "\"";
   if (options.output_value()) {
-    fp << " value=\"";
-    fp << bitstream_manager.bit_value(fabric_bitstream.config_bit(fabric_bit));
-    fp << "\"";
+    buffer += " value=\"";
+    buffer += bit_value ? '1' : '0';
+    buffer += "\"";
   }
 
   /* Output hierarchy of this parent*/
-  const ConfigBitId& config_bit = fabric_bitstream.config_bit(fabric_bit);
-  const ConfigBlockId& config_block =
-    bitstream_manager.bit_parent_block(config_bit);
-
   if (options.output_path()) {
-    std::vector<ConfigBlockId> block_hierarchy =
-      find_bitstream_manager_block_hierarchy(bitstream_manager, config_block);
-    std::string hie_path;
-    for (size_t iblk = 0; iblk < block_hierarchy.size(); ++iblk) {
-      /* If enabled, pop the last block name */
-      if (options.trim_path() && iblk == block_hierarchy.size() - 1) {
-        break;
-      }
-      hie_path += bitstream_manager.block_name(block_hierarchy[iblk]);
-      hie_path += std::string(".");
-    }
-    hie_path += generate_configurable_memory_data_out_name();
-    hie_path += std::string("[");
-    size_t bit_idx_in_parent_block =
-      find_bitstream_manager_config_bit_index_in_parent_block(bitstream_manager,
-                                                              config_bit);
-    if (options.trim_path()) {
-      bit_idx_in_parent_block =
-        find_bitstream_manager_config_bit_index_in_grandparent_block(
-          bitstream_manager, config_bit);
-    }
-    hie_path += std::to_string(bit_idx_in_parent_block);
-    hie_path += std::string("]");
-
-    fp << " path=\"" << hie_path << "\"";
+    update_xml_bit_path_cache(path_cache, bitstream_manager,
+                              bitstream_manager.bit_parent_block(config_bit),
+                              options);
+    buffer += " path=\"";
+    buffer += path_cache.prefix;
+    buffer += std::to_string(size_t(config_bit) - path_cache.first_bit +
+                             path_cache.first_bit_index);
+    buffer += "]\"";
   }
-  fp << ">\n";
+  buffer += ">\n";
 
   switch (config_type) {
     case CONFIG_MEM_STANDALONE:
@@ -137,60 +166,50 @@ static int write_fabric_config_bit_to_xml_file(
         const FabricBitstreamMemoryBank& memory_bank =
           fabric_bitstream.memory_bank_info();
         /* Bit line address */
-        write_tab_to_file(fp, xml_hierarchy_depth + 1);
+        buffer.append(xml_hierarchy_depth + 1, '\t');
         const fabric_bit_data& bit =
           memory_bank.fabric_bit_datas[(size_t)(fabric_bit)];
         const fabric_blwl_length& lengths =
           memory_bank.blwl_lengths[bit.region];
         if (bl_addr.size() == 0) {
           VTR_ASSERT(wl_addr.size() == 0);
-          bl_addr.resize(lengths.bl);
-          wl_addr.resize(lengths.wl);
           bl_addr.assign(lengths.bl, 'x');
           wl_addr.assign(lengths.wl, '0');
         } else {
           VTR_ASSERT((fabric_size_t)(bl_addr.size()) == lengths.bl);
           VTR_ASSERT((fabric_size_t)(wl_addr.size()) == lengths.wl);
         }
-        fp << "<bl address=\"";
-        bl_addr.replace(bit.bl, 1, "1");
-        fp << bl_addr.c_str();
-        bl_addr.replace(bit.bl, 1, "x");
-        fp << "\"/>\n";
+        buffer += "<bl address=\"";
+        bl_addr[bit.bl] = '1';
+        buffer += bl_addr;
+        bl_addr[bit.bl] = 'x';
+        buffer += "\"/>\n";
         /* Word line address */
-        write_tab_to_file(fp, xml_hierarchy_depth + 1);
-        fp << "<wl address=\"";
-        wl_addr.replace(bit.wl, 1, "1");
-        fp << wl_addr.c_str();
-        wl_addr.replace(bit.wl, 1, "0");
-        fp << "\"/>\n";
+        buffer.append(xml_hierarchy_depth + 1, '\t');
+        buffer += "<wl address=\"";
+        wl_addr[bit.wl] = '1';
+        buffer += wl_addr;
+        wl_addr[bit.wl] = '0';
+        buffer += "\"/>\n";
       } else {
         /* Bit line address */
-        write_tab_to_file(fp, xml_hierarchy_depth + 1);
-        fp << "<bl address=\"";
-        for (const char& addr_bit :
-             fabric_bitstream.bit_bl_address(fabric_bit)) {
-          fp << addr_bit;
-        }
-        fp << "\"/>\n";
-
-        write_tab_to_file(fp, xml_hierarchy_depth + 1);
-        fp << "<wl address=\"";
-        for (const char& addr_bit :
-             fabric_bitstream.bit_wl_address(fabric_bit)) {
-          fp << addr_bit;
-        }
-        fp << "\"/>\n";
+        buffer.append(xml_hierarchy_depth + 1, '\t');
+        buffer += "<bl address=\"";
+        buffer += fabric_bitstream.bit_bl_address_view(fabric_bit).to_string();
+        buffer += "\"/>\n";
+
+        buffer.append(xml_hierarchy_depth + 1, '\t');
+        buffer += "<wl address=\"";
+        buffer += fabric_bitstream.bit_wl_address_view(fabric_bit).to_string();
+        buffer += "\"/>\n";
       }
       break;
     }
     case CONFIG_MEM_FRAME_BASED: {
-      write_tab_to_file(fp, xml_hierarchy_depth + 1);
-      fp << "<frame address=\"";
-      for (const char& addr_bit : fabric_bitstream.bit_address(fabric_bit)) {
-        fp << addr_bit;
-      }
-      fp << "\"/>\n";
+      buffer.append(xml_hierarchy_depth + 1, '\t');
+      buffer += "<frame address=\"";
+      buffer += fabric_bitstream.bit_address_view(fabric_bit).to_string();
+      buffer += "\"/>\n";
       break;
     }
     default:
@@ -199,14 +218,17 @@ static int write_fabric_config_bit_to_xml_file(
       return 1;
   }
 
-  write_tab_to_file(fp, xml_hierarchy_depth);
-  fp << "</bit>\n";
+  buffer.append(xml_hierarchy_depth, '\t');
+  buffer += "</bit>\n";
 
   return 0;
 }
 
 /********************************************************************
  * Write the fabric bitstream in a specific configuration region to an XML file
+ * The bits are split into chunks, which are formatted into independent
+ * buffers by a pool of threads. To limit the memory footprint, only a batch
+ * of chunks is formatted at a time, and then written to the file in order.
  *
  * Return:
  *  - 0 if succeed
@@ -217,24 +239,12 @@ static int write_fabric_regional_config_bit_to_xml_file(
   const FabricBitstream& fabric_bitstream,
   const FabricBitRegionId& fabric_region,
   const e_config_protocol_type& config_type, bool fast_xml,
-  const int& xml_hierarchy_depth, const BitstreamWriterOption& options) {
+  const int& xml_hierarchy_depth, const BitstreamWriterOption& options,
+  const bool& show_progress) {
   if (false == valid_file_stream(fp)) {
     return 1;
   }
 
-  int status = 0;
-  // Use string to print, instead of char by char
-  // This is for Flatten BL/WL protocol
-  // You will find this much more faster than char by char
-  // We do not need to build the string for every BL/WL
-  // It is one-hot and sequal addr
-  // We start with all '0' (WL) or 'x' (BL)
-  // By setting "1' and resettting ('0' or 'x') at approriate bit position
-  // We could create one-hot string much faster
-  // Use FPGA 100K as example: old way needs 1300seconds to write 85Gig XML
-  // New way only needs 80seconds to write identical XML
-  std::string bl_addr = "";
-  std::string wl_addr = "";
   write_tab_to_file(fp, xml_hierarchy_depth);
   fp << "<region ";
   fp << "id=\"";
@@ -242,32 +252,208 @@ static int write_fabric_regional_config_bit_to_xml_file(
   fp << "\"";
   fp << ">\n";
 
-  size_t bit_index = 0;
-  size_t total_bits = fabric_bitstream.region_bits(fabric_region).size();
-  size_t percentage = 0;
-  for (const FabricBitId& fabric_bit :
-       fabric_bitstream.region_bits(fabric_region)) {
-    status = write_fabric_config_bit_to_xml_file(
-      fp, bitstream_manager, fabric_bitstream, fabric_bit, config_type,
-      fast_xml, xml_hierarchy_depth + 1, bl_addr, wl_addr, options);
-    if (1 == status) {
-      return status;
+  std::vector<FabricBitId> region_bits =
+    fabric_bitstream.region_bits(fabric_region);
+  size_t total_bits = region_bits.size();
+  const size_t chunk_size = 4096;
+  size_t num_chunks = (total_bits + chunk_size - 1) / chunk_size;
+  size_t batch_size = 8 * find_num_threads(options.num_threads());
+  std::vector<std::string> buffers(batch_size);
+  std::vector<int> statuses(batch_size, 0);
+
+  for (size_t batch_start = 0; batch_start < num_chunks;
+       batch_start += batch_size) {
+    size_t curr_batch_size = std::min(batch_size, num_chunks - batch_start);
+    parallel_for(
+      curr_batch_size, options.num_threads(), [&](const size_t& ichunk) {
+        // Use string to print, instead of char by char
+        // This is for Flatten BL/WL protocol
+        // You will find this much more faster than char by char
+        // We do not need to build the string for every BL/WL
+        // It is one-hot and sequal addr
+        // We start with all '0' (WL) or 'x' (BL)
+        // By setting "1' and resettting ('0' or 'x') at approriate bit
+        // position, we could create one-hot string much faster
+        // Use FPGA 100K as example: old way needs 1300seconds to write 85Gig
+        // XML. New way only needs 80seconds to write identical XML
+        std::string bl_addr = "";
+        std::string wl_addr = "";
+        XmlBitPathCache path_cache;
+        std::string& buffer = buffers[ichunk];
+        buffer.clear();
+        statuses[ichunk] = 0;
+        size_t bit_start = (batch_start + ichunk) * chunk_size;
+        size_t bit_end = std::min(bit_start + chunk_size, total_bits);
+        for (size_t ibit = bit_start; ibit < bit_end; ++ibit) {
+          statuses[ichunk] = write_fabric_config_bit_to_xml_buffer(
+            buffer, bitstream_manager, fabric_bitstream, region_bits[ibit],
+            config_type, fast_xml, xml_hierarchy_depth + 1, bl_addr, wl_addr,
+            path_cache, options);
+          if (1 == statuses[ichunk]) {
+            return;
+          }
+        }
+      });
+
+    for (size_t ichunk = 0; ichunk < curr_batch_size; ++ichunk) {
+      if (1 == statuses[ichunk]) {
+        return 1;
+      }
+      fp << buffers[ichunk];
     }
+
     // Misc to print percentage of the process
-    bit_index++;
-    size_t temp = (bit_index * 100) / total_bits;
-    if (temp != percentage) {
-      VTR_LOG("  Progress: %lu%\r", percentage);
-      percentage = temp;
+    if (false == show_progress) {
+      continue;
     }
+    size_t bit_index =
+      std::min((batch_start + curr_batch_size) * chunk_size, total_bits);
+    VTR_LOG("  Progress: %lu%\r", (bit_index * 100) / total_bits);
   }
 
   write_tab_to_file(fp, xml_hierarchy_depth);
   fp << "</region>\n";
 
+  return 0;
+}
+
+/********************************************************************
+ * Find the path of the file of a configuration region, which is the path of
+ * the output file with the index of the region, e.g., 'fabric_bitstream.xml'
+ * becomes 'fabric_bitstream_region_0.xml'
+ *******************************************************************/
+static std::string find_fabric_bitstream_xml_shard_file_path(
+  const std::string& fname, const FabricBitRegionId& fabric_region) {
+  std::string base_name = fname;
+  std::string extension(".xml");
+  if ((base_name.size() > extension.size()) &&
+      (0 == base_name.compare(base_name.size() - extension.size(),
+                              extension.size(), extension))) {
+    base_name.erase(base_name.size() - extension.size());
+  }
+  return base_name + std::string("_region_") +
+         std::to_string(size_t(fabric_region)) + extension;
+}
+
+/********************************************************************
+ * Write the fabric bitstream of a configuration region to its own XML file,
+ * which has the same format as a complete fabric bitstream file
+ *
+ * Return:
+ *  - 0 if succeed
+ *  - 1 if critical errors occured
+ *******************************************************************/
+static int write_fabric_bitstream_region_to_xml_file(
+  const std::string& fname, const BitstreamManager& bitstream_manager,
+  const FabricBitstream& fabric_bitstream,
+  const FabricBitRegionId& fabric_region,
+  const ConfigProtocol& config_protocol, const BitstreamWriterOption& options) {
+  std::fstream fp;
+  fp.open(fname, std::fstream::out | std::fstream::trunc);
+  if (false == valid_file_stream(fp)) {
+    VTR_LOG_ERROR("Fail to create fabric bitstream file '%s'!\n",
+                  fname.c_str());
+    return 1;
+  }
+
+  write_fabric_bitstream_xml_file_head(fp, options.time_stamp());
+
+  int xml_hierarchy_depth = 0;
+  fp << "<fabric_bitstream>\n";
+  int status = write_fabric_regional_config_bit_to_xml_file(
+    fp, bitstream_manager, fabric_bitstream, fabric_region,
+    config_protocol.type(),
+    BLWL_PROTOCOL_FLATTEN == config_protocol.bl_protocol_type() &&
+      BLWL_PROTOCOL_FLATTEN == config_protocol.wl_protocol_type(),
+    xml_hierarchy_depth + 1, options, false);
+  fp << "</fabric_bitstream>\n";
+
+  trace_counter("bytes_written", size_t(fp.tellp()));
+
+  if (false == fp.good()) {
+    VTR_LOG_ERROR("Fail to write fabric bitstream file '%s'!\n",
+                  fname.c_str());
+    status = 1;
+  }
+  fp.close();
+
   return status;
 }
 
+/********************************************************************
+ * Write the fabric bitstream of each configuration region to a separated
+ * XML file, so that the regions can be loaded independently.
+ * The regions are written by a pool of threads. When there are more threads
+ * than regions, the remaining threads are shared by the regions to format
+ * their bits.
+ * The output file is a manifest listing the files of the regions, which is
+ * written after all the regions, so that a complete manifest always refers
+ * to complete files
+ *
+ * Return:
+ *  - 0 if succeed
+ *  - 1 if critical errors occured
+ *******************************************************************/
+static int write_fabric_bitstream_to_xml_shards(
+  const BitstreamManager& bitstream_manager,
+  const FabricBitstream& fabric_bitstream,
+  const ConfigProtocol& config_protocol, const BitstreamWriterOption& options) {
+  std::string fname = options.output_file_name();
+  std::vector<FabricBitRegionId> regions;
+  for (const FabricBitRegionId& region : fabric_bitstream.regions()) {
+    regions.push_back(region);
+  }
+
+  BitstreamWriterOption region_options = options;
+  region_options.set_num_threads(
+    std::max(size_t(1), find_num_threads(options.num_threads()) /
+                          std::max(size_t(1), regions.size())));
+
+  std::vector<int> statuses(regions.size(), 0);
+  parallel_for(
+    regions.size(), options.num_threads(), [&](const size_t& iregion) {
+      statuses[iregion] = write_fabric_bitstream_region_to_xml_file(
+        find_fabric_bitstream_xml_shard_file_path(fname, regions[iregion]),
+        bitstream_manager, fabric_bitstream, regions[iregion],
+        config_protocol, region_options);
+    });
+  for (const int& status : statuses) {
+    if (1 == status) {
+      return 1;
+    }
+  }
+
+  /* Write the manifest */
+  std::fstream fp;
+  fp.open(fname, std::fstream::out | std::fstream::trunc);
+
+  check_file_stream(fname.c_str(), fp);
+
+  write_fabric_bitstream_xml_file_head(fp, options.time_stamp());
+
+  fp << "<fabric_bitstream_shards>\n";
+  for (const FabricBitRegionId& region : regions) {
+    write_tab_to_file(fp, 1);
+    fp << "<region id=\"" << size_t(region) << "\"";
+    fp << " num_bits=\"" << fabric_bitstream.num_region_bits(region) << "\"";
+    fp << " file=\""
+       << find_path_file_name(
+            find_fabric_bitstream_xml_shard_file_path(fname, region))
+       << "\"";
+    fp << "/>\n";
+  }
+  fp << "</fabric_bitstream_shards>\n";
+
+  fp.close();
+
+  VTR_LOGV(options.verbose_output(),
+           "Outputted %lu configuration bits of %lu regions to XML files "
+           "listed in: %s\n",
+           fabric_bitstream.bits().size(), regions.size(), fname.c_str());
+
+  return 0;
+}
+
 /********************************************************************
  * Write the fabric bitstream to an XML file
  * Notes:
@@ -283,6 +469,7 @@ int write_fabric_bitstream_to_xml_file(
   const BitstreamManager& bitstream_manager,
   const FabricBitstream& fabric_bitstream,
   const ConfigProtocol& config_protocol, const BitstreamWriterOption& options) {
+  TraceScope trace_scope("write_fabric_bitstream_to_xml_file");
   VTR_ASSERT(options.output_file_type() ==
              BitstreamWriterOption::e_bitfile_type::XML);
   /* Ensure that we have a valid file name */
@@ -298,6 +485,11 @@ int write_fabric_bitstream_to_xml_file(
     std::string(" fabric bitstream into xml file '") + fname + std::string("'");
   vtr::ScopedStartFinishTimer timer(timer_message);
 
+  if (true == options.shard_by_region()) {
+    return write_fabric_bitstream_to_xml_shards(
+      bitstream_manager, fabric_bitstream, config_protocol, options);
+  }
+
   /* Create the file stream */
   std::fstream fp;
   fp.open(fname, std::fstream::out | std::fstream::trunc);
@@ -317,7 +509,7 @@ int write_fabric_bitstream_to_xml_file(
       fp, bitstream_manager, fabric_bitstream, region, config_protocol.type(),
       BLWL_PROTOCOL_FLATTEN == config_protocol.bl_protocol_type() &&
         BLWL_PROTOCOL_FLATTEN == config_protocol.wl_protocol_type(),
-      xml_hierarchy_depth + 1, options);
+      xml_hierarchy_depth + 1, options, true);
     if (1 == status) {
       break;
     }
@@ -326,6 +518,8 @@ int write_fabric_bitstream_to_xml_file(
   /* Print an end to the file here */
   fp << "</fabric_bitstream>\n";
 
+  trace_counter("bytes_written", size_t(fp.tellp()));
+
   /* Close file handler */
   fp.close();
 
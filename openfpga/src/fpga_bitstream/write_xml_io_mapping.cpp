@@ -45,46 +45,41 @@ static void write_io_mapping_xml_file_head(std::fstream& fp,
   fp << std::endl;
 }
 
+/* Number of bytes to be buffered before writing to the file */
+constexpr size_t IO_MAPPING_FILE_BUFFER_SIZE = 1 << 16;
+
 /********************************************************************
- * Write an io mapping pair to an XML file
- *
- * Return:
- *  - 0 if succeed
- *  - 1 if critical errors occured
+ * Append an io mapping pair in XML format to a buffer
  *******************************************************************/
-static int write_io_mapping_pair_to_xml_file(std::fstream& fp,
+static void append_io_mapping_pair_to_buffer(std::string& buffer,
                                              const IoMap& io_map,
                                              const IoMapId& io_map_id,
                                              int xml_hierarchy_depth) {
-  if (false == valid_file_stream(fp)) {
-    return 1;
-  }
-
-  write_tab_to_file(fp, xml_hierarchy_depth);
+  buffer.append(xml_hierarchy_depth, '\t');
 
   BasicPort io_port = io_map.io_port(io_map_id);
-  fp << "<io ";
-  fp << "name=\"" << io_port.get_name().c_str() << "[" << io_port.get_lsb()
-     << ":" << io_port.get_msb() << "]"
-     << "\"";
-
-  VTR_ASSERT(1 == io_map.io_net(io_map_id).get_width());
-  fp << " net=\"" << io_map.io_net(io_map_id).get_name().c_str() << "\"";
+  buffer += "<io name=\"";
+  buffer += io_port.get_name();
+  buffer += '[';
+  append_number_to_buffer(buffer, io_port.get_lsb());
+  buffer += ':';
+  append_number_to_buffer(buffer, io_port.get_msb());
+  buffer += "]\"";
+
+  BasicPort io_net = io_map.io_net(io_map_id);
+  VTR_ASSERT(1 == io_net.get_width());
+  buffer += " net=\"";
+  buffer += io_net.get_name();
+  buffer += '"';
 
   if (io_map.is_io_input(io_map_id)) {
-    fp << " dir=\""
-       << "input"
-       << "\"";
+    buffer += " dir=\"input\"";
   } else {
     VTR_ASSERT_SAFE(io_map.is_io_output(io_map_id));
-    fp << " dir=\""
-       << "output"
-       << "\"";
+    buffer += " dir=\"output\"";
   }
 
-  fp << "/>\n";
-
-  return 0;
+  buffer += "/>\n";
 }
 
 /********************************************************************
@@ -125,17 +120,19 @@ int write_io_mapping_to_xml_file(const IoMap& io_map, const std::string& fname,
   int xml_hierarchy_depth = 0;
   fp << "<io_mapping>\n";
 
-  /* Output fabric bitstream to the file */
-  int status = 0;
+  /* Output io mapping to the file, which is formatted in a buffer first */
   int io_map_cnt = 0;
+  std::string buffer;
+  buffer.reserve(IO_MAPPING_FILE_BUFFER_SIZE);
   for (const auto& io_map_id : io_map.io_map()) {
-    status = write_io_mapping_pair_to_xml_file(fp, io_map, io_map_id,
-                                               xml_hierarchy_depth + 1);
+    append_io_mapping_pair_to_buffer(buffer, io_map, io_map_id,
+                                     xml_hierarchy_depth + 1);
     io_map_cnt++;
-    if (1 == status) {
-      break;
+    if (IO_MAPPING_FILE_BUFFER_SIZE <= buffer.size()) {
+      write_buffer_to_file(fp, buffer);
     }
   }
+  write_buffer_to_file(fp, buffer);
 
   /* Print an end to the file here */
   fp << "</io_mapping>\n";
@@ -143,6 +140,12 @@ int write_io_mapping_to_xml_file(const IoMap& io_map, const std::string& fname,
   VTR_LOGV(verbose, "Outputted %d I/O mapping to file '%s'\n", io_map_cnt,
            fname.c_str());
 
+  int status = 0;
+  if (false == fp.good()) {
+    VTR_LOG_ERROR("Fail to write I/O mapping to file '%s'!\n", fname.c_str());
+    status = 1;
+  }
+
   /* Close file handler */
   fp.close();
 
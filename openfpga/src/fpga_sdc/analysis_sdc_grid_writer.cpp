@@ -3,6 +3,9 @@
  * to disable unused ports of grids, such as Configurable Logic Block
  * (CLBs), heterogeneous blocks, etc.
  *******************************************************************/
+#include <utility>
+#include <vector>
+
 /* Headers from vtrutil library */
 #include "vtr_assert.h"
 
@@ -31,14 +34,11 @@ namespace openfpga {
  * combinatinal path inside an unused grid, when finding critical paths!!!
  *******************************************************************/
 static void rec_print_analysis_sdc_disable_unused_pb_graph_nodes(
-  std::fstream& fp, const VprDeviceAnnotation& device_annotation,
+  std::ostream& fp, const VprDeviceAnnotation& device_annotation,
   const ModuleManager& module_manager, const ModuleId& parent_module,
   const std::string& hierarchy_name, t_pb_graph_node* physical_pb_graph_node) {
   t_pb_type* physical_pb_type = physical_pb_graph_node->pb_type;
 
-  /* Validate file stream */
-  valid_file_stream(fp);
-
   /* Disable all the ports of current module (parent_module)!
    * Hierarchy name already includes the instance name of parent_module
    */
@@ -97,13 +97,10 @@ static void rec_print_analysis_sdc_disable_unused_pb_graph_nodes(
  * Disable an unused pin of a pb_graph_node (parent_module)
  *******************************************************************/
 static void disable_pb_graph_node_unused_pin(
-  std::fstream& fp, const ModuleManager& module_manager,
+  std::ostream& fp, const ModuleManager& module_manager,
   const ModuleId& parent_module, const std::string& hierarchy_name,
   const t_pb_graph_pin* pb_graph_pin, const PhysicalPb& physical_pb,
   const PhysicalPbId& pb_id) {
-  /* Validate file stream */
-  valid_file_stream(fp);
-
   /* Identify if the pb_graph_pin has been used or not
    * TODO: identify if this is a parasitic net
    */
@@ -139,7 +136,7 @@ static void disable_pb_graph_node_unused_pin(
  *disable them
  *******************************************************************/
 static void disable_pb_graph_node_unused_pins(
-  std::fstream& fp, const ModuleManager& module_manager,
+  std::ostream& fp, const ModuleManager& module_manager,
   const ModuleId& parent_module, const std::string& hierarchy_name,
   t_pb_graph_node* physical_pb_graph_node, const PhysicalPb& physical_pb) {
   const PhysicalPbId& pb_id = physical_pb.find_pb(physical_pb_graph_node);
@@ -192,7 +189,7 @@ static void disable_pb_graph_node_unused_pins(
  * and store the results in a mux_name-to-net mapping
  *******************************************************************/
 static void disable_pb_graph_node_unused_mux_inputs(
-  std::fstream& fp, const VprDeviceAnnotation& device_annotation,
+  std::ostream& fp, const VprDeviceAnnotation& device_annotation,
   const ModuleManager& module_manager, const ModuleId& parent_module,
   const std::string& hierarchy_name, t_pb_graph_node* physical_pb_graph_node,
   const PhysicalPb& physical_pb) {
@@ -445,7 +442,7 @@ static void disable_pb_graph_node_unused_mux_inputs(
  * combinatinal path inside an unused grid, when finding critical paths!!!
  *******************************************************************/
 static void rec_print_analysis_sdc_disable_pb_graph_node_unused_resources(
-  std::fstream& fp, const VprDeviceAnnotation& device_annotation,
+  std::ostream& fp, const VprDeviceAnnotation& device_annotation,
   const ModuleManager& module_manager, const ModuleId& parent_module,
   const std::string& hierarchy_name, t_pb_graph_node* physical_pb_graph_node,
   const PhysicalPb& physical_pb) {
@@ -526,7 +523,7 @@ static void rec_print_analysis_sdc_disable_pb_graph_node_unused_resources(
  * Just walk through each pb_type and disable all the ports using wildcards
  *******************************************************************/
 static void print_analysis_sdc_disable_pb_block_unused_resources(
-  std::fstream& fp, t_physical_tile_type_ptr grid_type,
+  std::ostream& fp, t_physical_tile_type_ptr grid_type,
   const vtr::Point<size_t>& grid_coordinate,
   const VprDeviceAnnotation& device_annotation,
   const ModuleManager& module_manager, const std::string& grid_instance_name,
@@ -595,14 +592,11 @@ static void print_analysis_sdc_disable_pb_block_unused_resources(
  * Just walk through each pb_type and disable all the ports using wildcards
  *******************************************************************/
 static void print_analysis_sdc_disable_unused_grid(
-  std::fstream& fp, const vtr::Point<size_t>& grid_coordinate,
+  std::ostream& fp, const vtr::Point<size_t>& grid_coordinate,
   const DeviceGrid& grids, const VprDeviceAnnotation& device_annotation,
   const VprClusteringAnnotation& cluster_annotation,
   const VprPlacementAnnotation& place_annotation,
   const ModuleManager& module_manager, const e_side& border_side) {
-  /* Validate file stream */
-  valid_file_stream(fp);
-
   t_physical_tile_loc phy_tile_loc(grid_coordinate.x(), grid_coordinate.y(), 0);
   t_physical_tile_type_ptr grid_type = grids.get_physical_type(phy_tile_loc);
   /* Bypass conditions for grids :
@@ -687,13 +681,16 @@ void print_analysis_sdc_disable_unused_grids(
   const VprDeviceAnnotation& device_annotation,
   const VprClusteringAnnotation& cluster_annotation,
   const VprPlacementAnnotation& place_annotation,
-  const ModuleManager& module_manager) {
+  const ModuleManager& module_manager, const size_t& num_threads,
+  const bool& compress_pin_ranges) {
+  /* Collect the grids in the order of output, along with their border side */
+  std::vector<std::pair<vtr::Point<size_t>, e_side>> grid_coordinates;
+
   /* Process unused core grids */
   for (size_t ix = 1; ix < grids.width() - 1; ++ix) {
     for (size_t iy = 1; iy < grids.height() - 1; ++iy) {
-      print_analysis_sdc_disable_unused_grid(
-        fp, vtr::Point<size_t>(ix, iy), grids, device_annotation,
-        cluster_annotation, place_annotation, module_manager, NUM_SIDES);
+      grid_coordinates.push_back(
+        std::make_pair(vtr::Point<size_t>(ix, iy), NUM_SIDES));
     }
   }
 
@@ -705,11 +702,19 @@ void print_analysis_sdc_disable_unused_grids(
   /* Add instances of I/O grids to top_module */
   for (const e_side& io_side : FPGA_SIDES_CLOCKWISE) {
     for (const vtr::Point<size_t>& io_coordinate : io_coordinates[io_side]) {
-      print_analysis_sdc_disable_unused_grid(
-        fp, io_coordinate, grids, device_annotation, cluster_annotation,
-        place_annotation, module_manager, io_side);
+      grid_coordinates.push_back(std::make_pair(io_coordinate, io_side));
     }
   }
+
+  /* The grids are only read, so they can be processed in parallel */
+  print_analysis_sdc_blocks(
+    fp, grid_coordinates.size(), num_threads, compress_pin_ranges,
+    [&](std::ostream& block_fp, const size_t& igrid) {
+      print_analysis_sdc_disable_unused_grid(
+        block_fp, grid_coordinates[igrid].first, grids, device_annotation,
+        cluster_annotation, place_annotation, module_manager,
+        grid_coordinates[igrid].second);
+    });
 }
 
 } /* end namespace openfpga */
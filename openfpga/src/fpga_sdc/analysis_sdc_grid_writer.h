@@ -25,7 +25,8 @@ void print_analysis_sdc_disable_unused_grids(
   const VprDeviceAnnotation& device_annotation,
   const VprClusteringAnnotation& cluster_annotation,
   const VprPlacementAnnotation& place_annotation,
-  const ModuleManager& module_manager);
+  const ModuleManager& module_manager, const size_t& num_threads,
+  const bool& compress_pin_ranges);
 
 } /* end namespace openfpga */
 
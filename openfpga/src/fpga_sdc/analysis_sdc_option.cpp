@@ -16,6 +16,8 @@ AnalysisSdcOption::AnalysisSdcOption(const std::string& sdc_dir) {
   time_unit_ = 1.;
   time_stamp_ = true;
   generate_sdc_analysis_ = false;
+  num_threads_ = 1;
+  compress_pin_ranges_ = false;
 }
 
 /********************************************************************
@@ -33,6 +35,12 @@ bool AnalysisSdcOption::generate_sdc_analysis() const {
   return generate_sdc_analysis_;
 }
 
+size_t AnalysisSdcOption::num_threads() const { return num_threads_; }
+
+bool AnalysisSdcOption::compress_pin_ranges() const {
+  return compress_pin_ranges_;
+}
+
 /********************************************************************
  * Public mutators
  ********************************************************************/
@@ -57,4 +65,13 @@ void AnalysisSdcOption::set_generate_sdc_analysis(
   generate_sdc_analysis_ = generate_sdc_analysis;
 }
 
+void AnalysisSdcOption::set_num_threads(const size_t& num_threads) {
+  num_threads_ = num_threads;
+}
+
+void AnalysisSdcOption::set_compress_pin_ranges(
+  const bool& compress_pin_ranges) {
+  compress_pin_ranges_ = compress_pin_ranges;
+}
+
 } /* end namespace openfpga */
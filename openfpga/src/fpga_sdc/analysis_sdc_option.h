@@ -21,6 +21,8 @@ class AnalysisSdcOption {
   float time_unit() const;
   bool generate_sdc_analysis() const;
   bool time_stamp() const;
+  size_t num_threads() const;
+  bool compress_pin_ranges() const;
 
  public: /* Public mutators */
   void set_sdc_dir(const std::string& sdc_dir);
@@ -28,6 +30,8 @@ class AnalysisSdcOption {
   void set_time_stamp(const bool& time_stamp);
   void set_time_unit(const float& time_unit);
   void set_generate_sdc_analysis(const bool& generate_sdc_analysis);
+  void set_num_threads(const size_t& num_threads);
+  void set_compress_pin_ranges(const bool& compress_pin_ranges);
 
  private: /* Internal data */
   std::string sdc_dir_;
@@ -35,6 +39,11 @@ class AnalysisSdcOption {
   bool flatten_names_;
   float time_unit_;
   bool time_stamp_;
+  /* Number of threads to write the constraints of grids and routing blocks,
+   * 0 means all the hardware threads */
+  size_t num_threads_;
+  /* Merge the pins disabled in each block into ranges of pins */
+  bool compress_pin_ranges_;
 };
 
 } /* end namespace openfpga */
@@ -4,6 +4,7 @@
  * using a benchmark
  *******************************************************************/
 #include <map>
+#include <vector>
 
 /* Headers from vtrutil library */
 #include "vtr_assert.h"
@@ -30,15 +31,12 @@ namespace openfpga {
  *    in a connection block
  *******************************************************************/
 static void print_analysis_sdc_disable_cb_unused_resources(
-  std::fstream& fp, const AtomContext& atom_ctx,
+  std::ostream& fp, const AtomContext& atom_ctx,
   const ModuleManager& module_manager,
   const VprDeviceAnnotation& device_annotation, const DeviceGrid& grids,
   const RRGraphView& rr_graph, const VprRoutingAnnotation& routing_annotation,
   const DeviceRRGSB& device_rr_gsb, const RRGSB& rr_gsb,
   const t_rr_type& cb_type, const bool& compact_routing_hierarchy) {
-  /* Validate file stream */
-  valid_file_stream(fp);
-
   vtr::Point<size_t> gsb_coordinate(rr_gsb.get_cb_x(cb_type),
                                     rr_gsb.get_cb_y(cb_type));
 
@@ -244,10 +242,13 @@ static void print_analysis_sdc_disable_unused_cb_ports(
   const VprDeviceAnnotation& device_annotation, const DeviceGrid& grids,
   const RRGraphView& rr_graph, const VprRoutingAnnotation& routing_annotation,
   const DeviceRRGSB& device_rr_gsb, const t_rr_type& cb_type,
-  const bool& compact_routing_hierarchy) {
+  const bool& compact_routing_hierarchy, const size_t& num_threads,
+  const bool& compress_pin_ranges) {
   /* Build unique X-direction connection block modules */
   vtr::Point<size_t> cb_range = device_rr_gsb.get_gsb_range();
 
+  /* Collect the connection blocks in the order of output */
+  std::vector<vtr::Point<size_t>> gsb_coordinates;
   for (size_t ix = 0; ix < cb_range.x(); ++ix) {
     for (size_t iy = 0; iy < cb_range.y(); ++iy) {
       /* Check if the connection block exists in the device!
@@ -259,12 +260,21 @@ static void print_analysis_sdc_disable_unused_cb_ports(
         continue;
       }
 
-      print_analysis_sdc_disable_cb_unused_resources(
-        fp, atom_ctx, module_manager, device_annotation, grids, rr_graph,
-        routing_annotation, device_rr_gsb, rr_gsb, cb_type,
-        compact_routing_hierarchy);
+      gsb_coordinates.push_back(vtr::Point<size_t>(ix, iy));
     }
   }
+
+  /* The connection blocks are only read, so they can be processed in
+   * parallel */
+  print_analysis_sdc_blocks(
+    fp, gsb_coordinates.size(), num_threads, compress_pin_ranges,
+    [&](std::ostream& block_fp, const size_t& icb) {
+      print_analysis_sdc_disable_cb_unused_resources(
+        block_fp, atom_ctx, module_manager, device_annotation, grids, rr_graph,
+        routing_annotation, device_rr_gsb,
+        device_rr_gsb.get_gsb(gsb_coordinates[icb]), cb_type,
+        compact_routing_hierarchy);
+    });
 }
 
 /********************************************************************
@@ -276,14 +286,17 @@ void print_analysis_sdc_disable_unused_cbs(
   const ModuleManager& module_manager,
   const VprDeviceAnnotation& device_annotation, const DeviceGrid& grids,
   const RRGraphView& rr_graph, const VprRoutingAnnotation& routing_annotation,
-  const DeviceRRGSB& device_rr_gsb, const bool& compact_routing_hierarchy) {
+  const DeviceRRGSB& device_rr_gsb, const bool& compact_routing_hierarchy,
+  const size_t& num_threads, const bool& compress_pin_ranges) {
   print_analysis_sdc_disable_unused_cb_ports(
     fp, atom_ctx, module_manager, device_annotation, grids, rr_graph,
-    routing_annotation, device_rr_gsb, CHANX, compact_routing_hierarchy);
+    routing_annotation, device_rr_gsb, CHANX, compact_routing_hierarchy,
+    num_threads, compress_pin_ranges);
 
   print_analysis_sdc_disable_unused_cb_ports(
     fp, atom_ctx, module_manager, device_annotation, grids, rr_graph,
-    routing_annotation, device_rr_gsb, CHANY, compact_routing_hierarchy);
+    routing_annotation, device_rr_gsb, CHANY, compact_routing_hierarchy,
+    num_threads, compress_pin_ranges);
 }
 
 /********************************************************************
@@ -293,15 +306,12 @@ void print_analysis_sdc_disable_unused_cbs(
  *    in a switch block
  *******************************************************************/
 static void print_analysis_sdc_disable_sb_unused_resources(
-  std::fstream& fp, const AtomContext& atom_ctx,
+  std::ostream& fp, const AtomContext& atom_ctx,
   const ModuleManager& module_manager,
   const VprDeviceAnnotation& device_annotation, const DeviceGrid& grids,
   const RRGraphView& rr_graph, const VprRoutingAnnotation& routing_annotation,
   const DeviceRRGSB& device_rr_gsb, const RRGSB& rr_gsb,
   const bool& compact_routing_hierarchy) {
-  /* Validate file stream */
-  valid_file_stream(fp);
-
   vtr::Point<size_t> gsb_coordinate(rr_gsb.get_sb_x(), rr_gsb.get_sb_y());
 
   std::string sb_instance_name =
@@ -568,10 +578,13 @@ void print_analysis_sdc_disable_unused_sbs(
   const ModuleManager& module_manager,
   const VprDeviceAnnotation& device_annotation, const DeviceGrid& grids,
   const RRGraphView& rr_graph, const VprRoutingAnnotation& routing_annotation,
-  const DeviceRRGSB& device_rr_gsb, const bool& compact_routing_hierarchy) {
+  const DeviceRRGSB& device_rr_gsb, const bool& compact_routing_hierarchy,
+  const size_t& num_threads, const bool& compress_pin_ranges) {
   /* Build unique X-direction connection block modules */
   vtr::Point<size_t> sb_range = device_rr_gsb.get_gsb_range();
 
+  /* Collect the switch blocks in the order of output */
+  std::vector<vtr::Point<size_t>> gsb_coordinates;
   for (size_t ix = 0; ix < sb_range.x(); ++ix) {
     for (size_t iy = 0; iy < sb_range.y(); ++iy) {
       /* Check if the connection block exists in the device!
@@ -583,11 +596,20 @@ void print_analysis_sdc_disable_unused_sbs(
         continue;
       }
 
-      print_analysis_sdc_disable_sb_unused_resources(
-        fp, atom_ctx, module_manager, device_annotation, grids, rr_graph,
-        routing_annotation, device_rr_gsb, rr_gsb, compact_routing_hierarchy);
+      gsb_coordinates.push_back(vtr::Point<size_t>(ix, iy));
     }
   }
+
+  /* The switch blocks are only read, so they can be processed in parallel */
+  print_analysis_sdc_blocks(
+    fp, gsb_coordinates.size(), num_threads, compress_pin_ranges,
+    [&](std::ostream& block_fp, const size_t& isb) {
+      print_analysis_sdc_disable_sb_unused_resources(
+        block_fp, atom_ctx, module_manager, device_annotation, grids, rr_graph,
+        routing_annotation, device_rr_gsb,
+        device_rr_gsb.get_gsb(gsb_coordinates[isb]),
+        compact_routing_hierarchy);
+    });
 }
 
 } /* end namespace openfpga */
@@ -25,14 +25,16 @@ void print_analysis_sdc_disable_unused_cbs(
   const ModuleManager& module_manager,
   const VprDeviceAnnotation& device_annotation, const DeviceGrid& grids,
   const RRGraphView& rr_graph, const VprRoutingAnnotation& routing_annotation,
-  const DeviceRRGSB& device_rr_gsb, const bool& compact_routing_hierarchy);
+  const DeviceRRGSB& device_rr_gsb, const bool& compact_routing_hierarchy,
+  const size_t& num_threads, const bool& compress_pin_ranges);
 
 void print_analysis_sdc_disable_unused_sbs(
   std::fstream& fp, const AtomContext& atom_ctx,
   const ModuleManager& module_manager,
   const VprDeviceAnnotation& device_annotation, const DeviceGrid& grids,
   const RRGraphView& rr_graph, const VprRoutingAnnotation& routing_annotation,
-  const DeviceRRGSB& device_rr_gsb, const bool& compact_routing_hierarchy);
+  const DeviceRRGSB& device_rr_gsb, const bool& compact_routing_hierarchy,
+  const size_t& num_threads, const bool& compress_pin_ranges);
 
 } /* end namespace openfpga */
 
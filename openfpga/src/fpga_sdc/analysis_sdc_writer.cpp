@@ -294,21 +294,24 @@ void print_analysis_sdc(const AnalysisSdcOption& option,
     fp, vpr_ctx.atom(), openfpga_ctx.module_graph(),
     openfpga_ctx.vpr_device_annotation(), vpr_ctx.device().grid,
     vpr_ctx.device().rr_graph, openfpga_ctx.vpr_routing_annotation(),
-    openfpga_ctx.device_rr_gsb(), compact_routing_hierarchy);
+    openfpga_ctx.device_rr_gsb(), compact_routing_hierarchy,
+    option.num_threads(), option.compress_pin_ranges());
 
   /* Disable timing for unused routing resources in switch blocks */
   print_analysis_sdc_disable_unused_sbs(
     fp, vpr_ctx.atom(), openfpga_ctx.module_graph(),
     openfpga_ctx.vpr_device_annotation(), vpr_ctx.device().grid,
     vpr_ctx.device().rr_graph, openfpga_ctx.vpr_routing_annotation(),
-    openfpga_ctx.device_rr_gsb(), compact_routing_hierarchy);
+    openfpga_ctx.device_rr_gsb(), compact_routing_hierarchy,
+    option.num_threads(), option.compress_pin_ranges());
 
   /* Disable timing for unused routing resources in grids (programmable blocks)
    */
   print_analysis_sdc_disable_unused_grids(
     fp, vpr_ctx.device().grid, openfpga_ctx.vpr_device_annotation(),
     openfpga_ctx.vpr_clustering_annotation(),
-    openfpga_ctx.vpr_placement_annotation(), openfpga_ctx.module_graph());
+    openfpga_ctx.vpr_placement_annotation(), openfpga_ctx.module_graph(),
+    option.num_threads(), option.compress_pin_ranges());
 
   /* Close file handler */
   fp.close();
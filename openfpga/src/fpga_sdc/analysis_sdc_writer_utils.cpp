@@ -3,6 +3,11 @@
  * that are used to output a SDC file
  * in order to constrain a FPGA fabric (P&Red netlist) mapped to a benchmark
  *******************************************************************/
+#include <algorithm>
+#include <sstream>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 /* Headers from vtrutil library */
 #include "vtr_assert.h"
@@ -10,6 +15,7 @@
 /* Headers from openfpgautil library */
 #include "analysis_sdc_writer_utils.h"
 #include "openfpga_digest.h"
+#include "openfpga_parallel.h"
 #include "sdc_writer_utils.h"
 
 /* begin namespace openfpga */
@@ -48,14 +54,11 @@ bool is_rr_node_to_be_disable_for_analysis(
  *
  *******************************************************************/
 void disable_analysis_module_input_pin_net_sinks(
-  std::fstream& fp, const ModuleManager& module_manager,
+  std::ostream& fp, const ModuleManager& module_manager,
   const ModuleId& parent_module, const std::string& parent_instance_name,
   const ModulePortId& module_input_port, const size_t& module_input_pin,
   const AtomNetId& mapped_net,
   const std::map<std::string, AtomNetId> mux_instance_to_net_map) {
-  /* Validate file stream */
-  valid_file_stream(fp);
-
   /* Find the module net which sources from this port! */
   ModuleNetId module_net = module_manager.module_instance_port_net(
     parent_module, parent_module, 0, module_input_port, module_input_pin);
@@ -139,13 +142,10 @@ void disable_analysis_module_input_pin_net_sinks(
  *
  *******************************************************************/
 void disable_analysis_module_input_port_net_sinks(
-  std::fstream& fp, const ModuleManager& module_manager,
+  std::ostream& fp, const ModuleManager& module_manager,
   const ModuleId& parent_module, const std::string& parent_instance_name,
   const ModulePortId& module_input_port, const AtomNetId& mapped_net,
   const std::map<std::string, AtomNetId> mux_instance_to_net_map) {
-  /* Validate file stream */
-  valid_file_stream(fp);
-
   /* Find the module net which sources from this port! */
   for (const size_t& pin :
        module_manager.module_port(parent_module, module_input_port).pins()) {
@@ -182,15 +182,12 @@ void disable_analysis_module_input_port_net_sinks(
  *
  *******************************************************************/
 void disable_analysis_module_output_pin_net_sinks(
-  std::fstream& fp, const ModuleManager& module_manager,
+  std::ostream& fp, const ModuleManager& module_manager,
   const ModuleId& parent_module, const std::string& parent_instance_name,
   const ModuleId& child_module, const size_t& child_instance,
   const ModulePortId& child_module_port, const size_t& child_module_pin,
   const AtomNetId& mapped_net,
   const std::map<std::string, AtomNetId> mux_instance_to_net_map) {
-  /* Validate file stream */
-  valid_file_stream(fp);
-
   /* Find the module net which sources from this port! */
   ModuleNetId module_net = module_manager.module_instance_port_net(
     parent_module, child_module, child_instance, child_module_port,
@@ -253,4 +250,158 @@ void disable_analysis_module_output_pin_net_sinks(
   }
 }
 
+/********************************************************************
+ * Parse a command disabling the timing of a pin or a range of pins, i.e.,
+ *   set_disable_timing <path>[<lsb>]
+ *   set_disable_timing <path>[<lsb>:<msb>]
+ * Return false if the command is in any other format, e.g., a wildcard
+ *******************************************************************/
+static bool parse_analysis_sdc_disable_timing_pins(const std::string& command,
+                                                   std::string& path,
+                                                   size_t& lsb, size_t& msb) {
+  const std::string keyword("set_disable_timing ");
+  if ((0 != command.compare(0, keyword.size(), keyword)) ||
+      (']' != command.back())) {
+    return false;
+  }
+  size_t range_start = command.rfind('[');
+  if ((std::string::npos == range_start) || (range_start <= keyword.size())) {
+    return false;
+  }
+  std::string range =
+    command.substr(range_start + 1, command.size() - range_start - 2);
+  size_t colon = range.find(':');
+  std::string lsb_str = range.substr(0, colon);
+  std::string msb_str =
+    (std::string::npos == colon) ? lsb_str : range.substr(colon + 1);
+  if ((lsb_str.empty()) || (msb_str.empty()) ||
+      (std::string::npos != lsb_str.find_first_not_of("0123456789")) ||
+      (std::string::npos != msb_str.find_first_not_of("0123456789"))) {
+    return false;
+  }
+  lsb = std::stoul(lsb_str);
+  msb = std::stoul(msb_str);
+  if (lsb > msb) {
+    return false;
+  }
+  path = command.substr(keyword.size(), range_start - keyword.size());
+  return true;
+}
+
+/********************************************************************
+ * Merge the commands disabling the timing of single pins into commands
+ * disabling ranges of pins. For example,
+ *   set_disable_timing cbx_1__0_/chanx_left_in[0]
+ *   set_disable_timing cbx_1__0_/chanx_right_in[0]
+ *   set_disable_timing cbx_1__0_/chanx_left_in[1]
+ *   set_disable_timing cbx_1__0_/chanx_left_in[2]
+ * is merged into
+ *   set_disable_timing cbx_1__0_/chanx_left_in[0:2]
+ *   set_disable_timing cbx_1__0_/chanx_right_in[0]
+ *
+ * Only the consecutive commands, which are not separated by any comment or
+ * other command, are merged, while the pins are grouped by their paths in
+ * the order of the first command on each path. The disabled pins are the
+ * same as the original commands, since the order of set_disable_timing
+ * commands does not matter.
+ *******************************************************************/
+std::string compress_analysis_sdc_disable_timing_pins(
+  const std::string& sdc_commands) {
+  std::string compressed;
+  compressed.reserve(sdc_commands.size());
+
+  /* Pin ranges of the current group of commands, by path */
+  std::vector<std::string> paths;
+  std::unordered_map<std::string, std::vector<std::pair<size_t, size_t>>>
+    path_ranges;
+
+  auto flush_paths = [&]() {
+    for (const std::string& path : paths) {
+      std::vector<std::pair<size_t, size_t>>& ranges = path_ranges[path];
+      std::sort(ranges.begin(), ranges.end());
+      size_t irange = 0;
+      while (irange < ranges.size()) {
+        size_t lsb = ranges[irange].first;
+        size_t msb = ranges[irange].second;
+        ++irange;
+        while ((irange < ranges.size()) && (ranges[irange].first <= msb + 1)) {
+          msb = std::max(msb, ranges[irange].second);
+          ++irange;
+        }
+        compressed += "set_disable_timing ";
+        compressed += generate_sdc_port(BasicPort(path, lsb, msb));
+        compressed += "\n";
+      }
+    }
+    paths.clear();
+    path_ranges.clear();
+  };
+
+  size_t line_start = 0;
+  while (line_start < sdc_commands.size()) {
+    size_t line_end = sdc_commands.find('\n', line_start);
+    if (std::string::npos == line_end) {
+      line_end = sdc_commands.size();
+    }
+    std::string line = sdc_commands.substr(line_start, line_end - line_start);
+    line_start = line_end + 1;
+
+    std::string path;
+    size_t lsb = 0;
+    size_t msb = 0;
+    if (true == parse_analysis_sdc_disable_timing_pins(line, path, lsb, msb)) {
+      if (path_ranges.end() == path_ranges.find(path)) {
+        paths.push_back(path);
+      }
+      path_ranges[path].push_back(std::make_pair(lsb, msb));
+      continue;
+    }
+    flush_paths();
+    compressed += line;
+    if (line_end < sdc_commands.size()) {
+      compressed += "\n";
+    }
+  }
+  flush_paths();
+
+  return compressed;
+}
+
+/********************************************************************
+ * Write the SDC commands of a number of blocks (e.g., grids or routing
+ * blocks), whose commands are independent from each other.
+ * The commands of each block are printed to a separated buffer by a pool of
+ * threads, and the buffers are written to the file in the order of blocks.
+ * So the file does not depend on the number of threads. To limit the memory
+ * footprint, only a batch of blocks per thread is buffered at a time.
+ * When required, the pins disabled in each block are merged into ranges.
+ *******************************************************************/
+void print_analysis_sdc_blocks(
+  std::fstream& fp, const size_t& num_blocks, const size_t& num_threads,
+  const bool& compress_pin_ranges,
+  const std::function<void(std::ostream&, const size_t&)>& print_block) {
+  /* Validate file stream */
+  valid_file_stream(fp);
+
+  size_t batch_size = 8 * find_num_threads(num_threads);
+  std::vector<std::string> buffers(batch_size);
+  for (size_t batch_start = 0; batch_start < num_blocks;
+       batch_start += batch_size) {
+    size_t curr_batch_size = std::min(batch_size, num_blocks - batch_start);
+    parallel_for(curr_batch_size, num_threads, [&](const size_t& iblock) {
+      std::ostringstream block_fp;
+      print_block(block_fp, batch_start + iblock);
+      buffers[iblock] = block_fp.str();
+      if (true == compress_pin_ranges) {
+        buffers[iblock] =
+          compress_analysis_sdc_disable_timing_pins(buffers[iblock]);
+      }
+    });
+    for (size_t iblock = 0; iblock < curr_batch_size; ++iblock) {
+      fp << buffers[iblock];
+      buffers[iblock].clear();
+    }
+  }
+}
+
 } /* end namespace openfpga */
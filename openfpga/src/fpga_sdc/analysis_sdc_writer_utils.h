@@ -5,6 +5,7 @@
  * Include header files that are required by function declaration
  *******************************************************************/
 #include <fstream>
+#include <functional>
 #include <map>
 #include <string>
 
@@ -24,26 +25,34 @@ bool is_rr_node_to_be_disable_for_analysis(
   const VprRoutingAnnotation& routing_annotation, const RRNodeId& cur_rr_node);
 
 void disable_analysis_module_input_pin_net_sinks(
-  std::fstream& fp, const ModuleManager& module_manager,
+  std::ostream& fp, const ModuleManager& module_manager,
   const ModuleId& parent_module, const std::string& parent_instance_name,
   const ModulePortId& module_input_port, const size_t& module_input_pin,
   const AtomNetId& mapped_net,
   const std::map<std::string, AtomNetId> mux_instance_to_net_map);
 
 void disable_analysis_module_input_port_net_sinks(
-  std::fstream& fp, const ModuleManager& module_manager,
+  std::ostream& fp, const ModuleManager& module_manager,
   const ModuleId& parent_module, const std::string& parent_instance_name,
   const ModulePortId& module_input_port, const AtomNetId& mapped_net,
   const std::map<std::string, AtomNetId> mux_instance_to_net_map);
 
 void disable_analysis_module_output_pin_net_sinks(
-  std::fstream& fp, const ModuleManager& module_manager,
+  std::ostream& fp, const ModuleManager& module_manager,
   const ModuleId& parent_module, const std::string& parent_instance_name,
   const ModuleId& child_module, const size_t& child_instance,
   const ModulePortId& child_module_port, const size_t& child_module_pin,
   const AtomNetId& mapped_net,
   const std::map<std::string, AtomNetId> mux_instance_to_net_map);
 
+std::string compress_analysis_sdc_disable_timing_pins(
+  const std::string& sdc_commands);
+
+void print_analysis_sdc_blocks(
+  std::fstream& fp, const size_t& num_blocks, const size_t& num_threads,
+  const bool& compress_pin_ranges,
+  const std::function<void(std::ostream&, const size_t&)>& print_block);
+
 } /* end namespace openfpga */
 
 #endif
@@ -9,6 +9,9 @@
 #include <ctime>
 #include <fstream>
 #include <iomanip>
+#include <map>
+#include <utility>
+#include <vector>
 
 /* Headers from vtrutil library */
 #include "vtr_assert.h"
@@ -21,11 +24,58 @@
 #include "openfpga_naming.h"
 #include "openfpga_port.h"
 #include "openfpga_scale.h"
+#include "sdc_writer_naming.h"
 #include "sdc_writer_utils.h"
 
 /* begin namespace openfpga */
 namespace openfpga {
 
+/********************************************************************
+ * Find the name of a configurable child instance under its parent module
+ *******************************************************************/
+static std::string find_configurable_child_instance_name(
+  const ModuleManager& module_manager, const ModuleId& parent_module,
+  const ModuleId& child_module, const size_t& child_instance) {
+  std::string child_instance_name =
+    module_manager.instance_name(parent_module, child_module, child_instance);
+  if (true == child_instance_name.empty()) {
+    child_instance_name = generate_instance_name(
+      module_manager.module_name(child_module), child_instance);
+  }
+  return child_instance_name;
+}
+
+/********************************************************************
+ * Print the SDC commands to constrain the timing between two consecutive
+ * configurable memories in a chain, i.e., from the first output of the
+ * previous memory to each input of the next memory
+ *******************************************************************/
+static void print_pnr_sdc_constrain_configurable_chain_pair(
+  std::fstream& fp, const float& tmax, const float& tmin,
+  const ModuleManager& module_manager, const std::string& previous_module_path,
+  const ModuleId& previous_module, const std::string& module_path,
+  const ModuleId& module_id) {
+  std::vector<BasicPort> output_ports = module_manager.module_ports_by_type(
+    previous_module, ModuleManager::MODULE_OUTPUT_PORT);
+  /* Only the first output port will be considered,
+   * being consistent with build_memory_module.cpp:395
+   */
+  if (true == output_ports.empty()) {
+    return;
+  }
+
+  for (const BasicPort& input_port : module_manager.module_ports_by_type(
+         module_id, ModuleManager::MODULE_INPUT_PORT)) {
+    print_pnr_sdc_constrain_max_delay(fp, previous_module_path,
+                                      output_ports[0].get_name(), module_path,
+                                      input_port.get_name(), tmax);
+
+    print_pnr_sdc_constrain_min_delay(fp, previous_module_path,
+                                      output_ports[0].get_name(), module_path,
+                                      input_port.get_name(), tmin);
+  }
+}
+
 /********************************************************************
  * Print SDC commands to constrain the timing between outputs and inputs
  * of all the configurable memory modules
@@ -60,19 +110,8 @@ static void rec_print_pnr_sdc_constrain_configurable_chain(
       parent_module, ModuleManager::e_config_child_type::PHYSICAL)[child_index];
     size_t child_instance_id = module_manager.configurable_child_instances(
       parent_module, ModuleManager::e_config_child_type::PHYSICAL)[child_index];
-    std::string child_instance_name;
-    if (true ==
-        module_manager
-          .instance_name(parent_module, child_module_id, child_instance_id)
-          .empty()) {
-      child_instance_name = generate_instance_name(
-        module_manager.module_name(child_module_id), child_instance_id);
-    } else {
-      child_instance_name = module_manager.instance_name(
-        parent_module, child_module_id, child_instance_id);
-    }
-
-    child_module_path += child_instance_name;
+    child_module_path += find_configurable_child_instance_name(
+      module_manager, parent_module, child_module_id, child_instance_id);
 
     child_module_path = format_dir_path(child_module_path);
 
@@ -95,34 +134,241 @@ static void rec_print_pnr_sdc_constrain_configurable_chain(
 
   /* Disable timing for each output port of this module */
   if (!previous_module_path.empty()) {
-    bool first_port = true;
-    for (const BasicPort& output_port : module_manager.module_ports_by_type(
-           previous_module, ModuleManager::MODULE_OUTPUT_PORT)) {
-      /* Only the first output port will be considered,
-       * being consistent with build_memory_module.cpp:395
-       */
-      if (false == first_port) {
+    print_pnr_sdc_constrain_configurable_chain_pair(
+      fp, tmax, tmin, module_manager, previous_module_path, previous_module,
+      parent_module_path, parent_module);
+  }
+
+  /* Update previous module */
+  previous_module_path = parent_module_path;
+  previous_module = parent_module;
+}
+
+/********************************************************************
+ * The first or the last configurable memory of the chain inside a module:
+ * the path of the memory relative to the module and the memory module
+ *******************************************************************/
+typedef std::pair<std::string, ModuleId> ConfigurableChainEnd;
+
+/********************************************************************
+ * Find the first (head) or the last (tail) configurable memory of the chain
+ * inside a module. The ends of each module are cached, so that the path
+ * prefixes are built once for each unique module rather than for each
+ * pair of memories
+ *******************************************************************/
+static const ConfigurableChainEnd& find_configurable_chain_end(
+  std::map<ModuleId, ConfigurableChainEnd>& chain_ends,
+  const ModuleManager& module_manager, const ModuleId& module_id,
+  const bool& head) {
+  auto result = chain_ends.find(module_id);
+  if (result != chain_ends.end()) {
+    return result->second;
+  }
+
+  const std::vector<ModuleId>& children = module_manager.configurable_children(
+    module_id, ModuleManager::e_config_child_type::PHYSICAL);
+  /* A leaf module is a configurable memory itself */
+  if (true == children.empty()) {
+    return chain_ends
+      .emplace(module_id, ConfigurableChainEnd(std::string(), module_id))
+      .first->second;
+  }
+
+  size_t child_index = (true == head) ? 0 : children.size() - 1;
+  size_t child_instance = module_manager.configurable_child_instances(
+    module_id, ModuleManager::e_config_child_type::PHYSICAL)[child_index];
+  const ConfigurableChainEnd& child_end = find_configurable_chain_end(
+    chain_ends, module_manager, children[child_index], head);
+  std::string path =
+    format_dir_path(find_configurable_child_instance_name(
+      module_manager, module_id, children[child_index], child_instance)) +
+    child_end.first;
+  return chain_ends
+    .emplace(module_id, ConfigurableChainEnd(path, child_end.second))
+    .first->second;
+}
+
+/********************************************************************
+ * Print SDC commands to constrain the timing between the consecutive
+ * configurable children of a module, i.e., from the last memory of a
+ * child to the first memory of the next child. The paths are relative to
+ * the module, after a given prefix
+ *******************************************************************/
+static void print_pnr_sdc_constrain_configurable_chain_children(
+  std::fstream& fp, const float& tmax, const float& tmin,
+  const ModuleManager& module_manager, const ModuleId& module_id,
+  const std::string& module_path, const std::vector<ModuleId>& children,
+  const std::vector<size_t>& child_instances,
+  std::map<ModuleId, ConfigurableChainEnd>& chain_heads,
+  std::map<ModuleId, ConfigurableChainEnd>& chain_tails) {
+  VTR_ASSERT(children.size() == child_instances.size());
+  for (size_t ichild = 1; ichild < children.size(); ++ichild) {
+    const ConfigurableChainEnd& previous_tail = find_configurable_chain_end(
+      chain_tails, module_manager, children[ichild - 1], false);
+    const ConfigurableChainEnd& current_head = find_configurable_chain_end(
+      chain_heads, module_manager, children[ichild], true);
+    std::string previous_path =
+      module_path +
+      format_dir_path(find_configurable_child_instance_name(
+        module_manager, module_id, children[ichild - 1],
+        child_instances[ichild - 1])) +
+      previous_tail.first;
+    std::string current_path =
+      module_path +
+      format_dir_path(find_configurable_child_instance_name(
+        module_manager, module_id, children[ichild], child_instances[ichild])) +
+      current_head.first;
+    print_pnr_sdc_constrain_configurable_chain_pair(
+      fp, tmax, tmin, module_manager, previous_path, previous_tail.second,
+      current_path, current_head.second);
+  }
+}
+
+/********************************************************************
+ * Print SDC commands to constrain the chain segments inside a module.
+ * When the module is split into configuration regions, each region is a
+ * separated chain and no timing is constrained between regions
+ *******************************************************************/
+static void print_pnr_sdc_constrain_module_configurable_chain(
+  std::fstream& fp, const float& tmax, const float& tmin,
+  const ModuleManager& module_manager, const ModuleId& module_id,
+  const std::string& module_path,
+  std::map<ModuleId, ConfigurableChainEnd>& chain_heads,
+  std::map<ModuleId, ConfigurableChainEnd>& chain_tails) {
+  if (0 == module_manager.regions(module_id).size()) {
+    print_pnr_sdc_constrain_configurable_chain_children(
+      fp, tmax, tmin, module_manager, module_id, module_path,
+      module_manager.configurable_children(
+        module_id, ModuleManager::e_config_child_type::PHYSICAL),
+      module_manager.configurable_child_instances(
+        module_id, ModuleManager::e_config_child_type::PHYSICAL),
+      chain_heads, chain_tails);
+    return;
+  }
+
+  for (const ConfigRegionId& config_region :
+       module_manager.regions(module_id)) {
+    print_pnr_sdc_constrain_configurable_chain_children(
+      fp, tmax, tmin, module_manager, module_id, module_path,
+      module_manager.region_configurable_children(module_id, config_region),
+      module_manager.region_configurable_child_instances(module_id,
+                                                         config_region),
+      chain_heads, chain_tails);
+  }
+}
+
+/********************************************************************
+ * Constrain the timing of configuration chains with hierarchical SDC files
+ * - The segments of the chains between the children of the top-level
+ *   module are constrained in the given SDC file, for each configuration
+ *   region
+ * - The segments inside any other module are constrained once for each
+ *   unique module, in a SDC file dedicated to the module, e.g.,
+ *     <sdc_dir>/<module_name>_configurable_chain.sdc
+ *   whose paths are relative to the module
+ * - The instances of each unique module are output to a plain text file
+ *     <sdc_dir>/config_chain_hierarchy.txt
+ * As a result, the time and size of SDC generation follow the number of
+ * unique modules rather than the number of configurable memories
+ *******************************************************************/
+static void print_pnr_sdc_hierarchical_constrain_configurable_chain(
+  const std::string& sdc_fname, const float& time_unit, const float& max_delay,
+  const float& min_delay, const bool& include_time_stamp,
+  const ModuleManager& module_manager, const ModuleId& top_module) {
+  std::string sdc_dir = format_dir_path(find_path_dir_name(sdc_fname));
+
+  /* Find the unique modules in a Depth-First Search, as well as the
+   * instances of each module in its parent modules. Leaf modules are the
+   * memories, which contain no chain segment */
+  std::vector<ModuleId> unique_modules;
+  std::map<ModuleId, std::vector<std::string>> module_instances;
+  std::vector<ModuleId> module_stack(1, top_module);
+  module_instances[top_module];
+  while (!module_stack.empty()) {
+    ModuleId parent_module = module_stack.back();
+    module_stack.pop_back();
+    unique_modules.push_back(parent_module);
+
+    const std::vector<ModuleId>& children =
+      module_manager.configurable_children(
+        parent_module, ModuleManager::e_config_child_type::PHYSICAL);
+    const std::vector<size_t>& child_instances =
+      module_manager.configurable_child_instances(
+        parent_module, ModuleManager::e_config_child_type::PHYSICAL);
+    for (size_t ichild = 0; ichild < children.size(); ++ichild) {
+      ModuleId child_module = children[ichild];
+      if (0 == module_manager
+                 .configurable_children(
+                   child_module, ModuleManager::e_config_child_type::PHYSICAL)
+                 .size()) {
         continue;
       }
+      if (0 == module_instances.count(child_module)) {
+        module_stack.push_back(child_module);
+      }
+      module_instances[child_module].push_back(
+        module_manager.module_name(parent_module) + std::string("/") +
+        find_configurable_child_instance_name(module_manager, parent_module,
+                                              child_module,
+                                              child_instances[ichild]));
+    }
+  }
 
-      for (const BasicPort& input_port : module_manager.module_ports_by_type(
-             parent_module, ModuleManager::MODULE_INPUT_PORT)) {
-        print_pnr_sdc_constrain_max_delay(
-          fp, previous_module_path, output_port.get_name(), parent_module_path,
-          input_port.get_name(), tmax);
+  std::map<ModuleId, ConfigurableChainEnd> chain_heads;
+  std::map<ModuleId, ConfigurableChainEnd> chain_tails;
 
-        print_pnr_sdc_constrain_min_delay(
-          fp, previous_module_path, output_port.get_name(), parent_module_path,
-          input_port.get_name(), tmin);
-      }
+  for (const ModuleId& module_id : unique_modules) {
+    /* The top-level module is constrained in the given SDC file */
+    std::string module_sdc_fname = sdc_fname;
+    std::string module_path;
+    if (top_module == module_id) {
+      module_path = format_dir_path(module_manager.module_name(top_module));
+    } else {
+      module_sdc_fname = sdc_dir + module_manager.module_name(module_id) +
+                         std::string(SDC_CONFIG_CHAIN_FILE_POSTFIX);
+    }
+
+    std::fstream fp;
+    fp.open(module_sdc_fname, std::fstream::out | std::fstream::trunc);
+    check_file_stream(module_sdc_fname.c_str(), fp);
+
+    print_sdc_file_header(
+      fp,
+      std::string("Timing constraints for configurable chains of module ") +
+        module_manager.module_name(module_id) + std::string(" used in PnR"),
+      include_time_stamp);
 
-      first_port = false;
+    /* Print time unit for the SDC file */
+    print_sdc_timescale(fp, time_unit_to_string(time_unit));
+
+    print_pnr_sdc_constrain_module_configurable_chain(
+      fp, max_delay, min_delay, module_manager, module_id, module_path,
+      chain_heads, chain_tails);
+
+    fp.close();
+  }
+
+  /* Output the instances of each unique module to a plain text file */
+  std::string fname(sdc_dir +
+                    std::string(SDC_CONFIG_CHAIN_HIERARCHY_FILE_NAME));
+  std::fstream fp;
+  fp.open(fname, std::fstream::out | std::fstream::trunc);
+  check_file_stream(fname.c_str(), fp);
+
+  for (const ModuleId& module_id : unique_modules) {
+    if (top_module == module_id) {
+      continue;
     }
+    fp << "- " << module_manager.module_name(module_id) << ":"
+       << "\n";
+    for (const std::string& instance_path : module_instances.at(module_id)) {
+      fp << "  ";
+      fp << "- " << instance_path << "\n";
+    }
+    fp << "\n";
   }
 
-  /* Update previous module */
-  previous_module_path = parent_module_path;
-  previous_module = parent_module;
+  fp.close();
 }
 
 /********************************************************************
@@ -133,7 +379,7 @@ static void rec_print_pnr_sdc_constrain_configurable_chain(
 void print_pnr_sdc_constrain_configurable_chain(
   const std::string& sdc_fname, const float& time_unit, const float& max_delay,
   const float& min_delay, const bool& include_time_stamp,
-  const ModuleManager& module_manager) {
+  const bool& hierarchical, const ModuleManager& module_manager) {
   /* Create the directory */
   create_directory(find_path_dir_name(sdc_fname));
 
@@ -143,6 +389,17 @@ void print_pnr_sdc_constrain_configurable_chain(
     sdc_fname + std::string("'");
   vtr::ScopedStartFinishTimer timer(timer_message);
 
+  std::string top_module_name = generate_fpga_top_module_name();
+  ModuleId top_module = module_manager.find_module(top_module_name);
+  VTR_ASSERT(true == module_manager.valid_module_id(top_module));
+
+  if (true == hierarchical) {
+    print_pnr_sdc_hierarchical_constrain_configurable_chain(
+      sdc_fname, time_unit, max_delay, min_delay, include_time_stamp,
+      module_manager, top_module);
+    return;
+  }
+
   /* Create the file stream */
   std::fstream fp;
   fp.open(sdc_fname, std::fstream::out | std::fstream::trunc);
@@ -157,10 +414,6 @@ void print_pnr_sdc_constrain_configurable_chain(
   /* Print time unit for the SDC file */
   print_sdc_timescale(fp, time_unit_to_string(time_unit));
 
-  std::string top_module_name = generate_fpga_top_module_name();
-  ModuleId top_module = module_manager.find_module(top_module_name);
-  VTR_ASSERT(true == module_manager.valid_module_id(top_module));
-
   /* Go recursively in the module manager, starting from the top-level module:
    * instance id of the top-level module is 0 by default */
   std::string previous_module_path;
@@ -19,7 +19,7 @@ namespace openfpga {
 void print_pnr_sdc_constrain_configurable_chain(
   const std::string& sdc_fname, const float& time_unit, const float& max_delay,
   const float& min_delay, const bool& include_time_stamp,
-  const ModuleManager& module_manager);
+  const bool& hierarchical, const ModuleManager& module_manager);
 
 } /* end namespace openfpga */
 
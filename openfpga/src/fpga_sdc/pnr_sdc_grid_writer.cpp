@@ -9,6 +9,9 @@
  *******************************************************************/
 #include <ctime>
 #include <fstream>
+#include <map>
+#include <set>
+#include <vector>
 
 /* Headers from vtrutil library */
 #include "vtr_assert.h"
@@ -35,15 +38,60 @@
 /* begin namespace openfpga */
 namespace openfpga {
 
+/********************************************************************
+ * The pin-to-pin paths to be constrained in a grid, grouped by their
+ * maximum delay: for each delay, the sink pins of each source pin
+ *******************************************************************/
+typedef std::map<float, std::map<std::string, std::set<std::string>>>
+  PnrSdcMaxDelayGroups;
+
+/********************************************************************
+ * Print the grouped pin-to-pin paths of a grid.
+ * The source pins sharing the same sink pins under the same delay are
+ * merged, so that each group is constrained by a single regular expression
+ * on both ends. Note that only the paths which are found in the grid are
+ * covered by a group:
+ *   set_max_delay -from [get_pins -regexp "(a|b)"]
+ *                 -to [get_pins -regexp "(c|d)"] <delay>
+ *******************************************************************/
+static void print_pnr_sdc_grouped_max_delays(
+  std::fstream& fp, const PnrSdcMaxDelayGroups& max_delay_groups) {
+  for (const auto& delay_group : max_delay_groups) {
+    std::map<std::set<std::string>, std::vector<std::string>> sources_by_sinks;
+    for (const auto& src_sinks : delay_group.second) {
+      sources_by_sinks[src_sinks.second].push_back(src_sinks.first);
+    }
+    for (const auto& sinks_sources : sources_by_sinks) {
+      const std::vector<std::string>& src_pins = sinks_sources.second;
+      std::vector<std::string> des_pins(sinks_sources.first.begin(),
+                                        sinks_sources.first.end());
+      /* A single path does not require any regular expression */
+      if ((1 == src_pins.size()) && (1 == des_pins.size())) {
+        print_pnr_sdc_constrain_max_delay(fp, std::string(), src_pins[0],
+                                          std::string(), des_pins[0],
+                                          delay_group.first);
+        continue;
+      }
+      print_pnr_sdc_regexp_constrain_max_delay(
+        fp, std::string(), generate_sdc_regexp_alternatives(src_pins),
+        std::string(), generate_sdc_regexp_alternatives(des_pins),
+        delay_group.first);
+    }
+  }
+}
+
 /********************************************************************
  * Print pin-to-pin timing constraints for a given interconnection
  * at an output port of a pb_graph node
+ * When grouping is enabled, the paths are added to the groups rather than
+ * printed
  *******************************************************************/
 static void print_pnr_sdc_constrain_pb_pin_interc_timing(
   std::fstream& fp, const float& time_unit, const bool& hierarchical,
   const std::string& module_path, const ModuleManager& module_manager,
   const ModuleId& parent_module, t_pb_graph_pin* des_pb_graph_pin,
-  t_mode* physical_mode, const bool& constrain_zero_delay_paths) {
+  t_mode* physical_mode, const bool& constrain_zero_delay_paths,
+  const bool& group_delays, PnrSdcMaxDelayGroups& max_delay_groups) {
   /* Validate file stream */
   valid_file_stream(fp);
 
@@ -177,6 +225,21 @@ static void print_pnr_sdc_constrain_pb_pin_interc_timing(
       des_module_path = module_path + des_instance_name;
     }
 
+    if (true == group_delays) {
+      std::string src_pin_name = generate_sdc_port(src_port);
+      if (!src_module_path.empty()) {
+        src_pin_name = format_dir_path(src_module_path) + src_pin_name;
+      }
+      std::string des_pin_name = generate_sdc_port(des_port);
+      if (!des_module_path.empty()) {
+        des_pin_name = format_dir_path(des_module_path) + des_pin_name;
+      }
+      max_delay_groups[des_pb_graph_pin->input_edges[iedge]->delay_max /
+                       time_unit][src_pin_name]
+        .insert(des_pin_name);
+      continue;
+    }
+
     /* Print a SDC timing constraint */
     print_pnr_sdc_constrain_max_delay(
       fp, src_module_path, generate_sdc_port(src_port), des_module_path,
@@ -194,7 +257,8 @@ static void print_pnr_sdc_constrain_pb_interc_timing(
   const std::string& module_path, const ModuleManager& module_manager,
   const ModuleId& parent_module, t_pb_graph_node* des_pb_graph_node,
   const e_circuit_pb_port_type& pb_port_type, t_mode* physical_mode,
-  const bool& constrain_zero_delay_paths) {
+  const bool& constrain_zero_delay_paths, const bool& group_delays,
+  PnrSdcMaxDelayGroups& max_delay_groups) {
   /* Validate file stream */
   valid_file_stream(fp);
 
@@ -208,7 +272,8 @@ static void print_pnr_sdc_constrain_pb_interc_timing(
           print_pnr_sdc_constrain_pb_pin_interc_timing(
             fp, time_unit, hierarchical, module_path, module_manager,
             parent_module, &(des_pb_graph_node->input_pins[iport][ipin]),
-            physical_mode, constrain_zero_delay_paths);
+            physical_mode, constrain_zero_delay_paths, group_delays,
+            max_delay_groups);
         }
       }
       break;
@@ -221,7 +286,8 @@ static void print_pnr_sdc_constrain_pb_interc_timing(
           print_pnr_sdc_constrain_pb_pin_interc_timing(
             fp, time_unit, hierarchical, module_path, module_manager,
             parent_module, &(des_pb_graph_node->output_pins[iport][ipin]),
-            physical_mode, constrain_zero_delay_paths);
+            physical_mode, constrain_zero_delay_paths, group_delays,
+            max_delay_groups);
         }
       }
       break;
@@ -254,6 +320,8 @@ static void print_pnr_sdc_constrain_pb_graph_node_timing(
   bool hierarchical = options.hierarchical();
   bool include_time_stamp = options.time_stamp();
   bool constrain_zero_delay_paths = options.constrain_zero_delay_paths();
+  bool group_delays = options.group_grid_delays();
+  PnrSdcMaxDelayGroups max_delay_groups;
 
   /* Get the pb_type definition related to the node */
   t_pb_type* physical_pb_type = parent_pb_graph_node->pb_type;
@@ -294,7 +362,7 @@ static void print_pnr_sdc_constrain_pb_graph_node_timing(
   print_pnr_sdc_constrain_pb_interc_timing(
     fp, time_unit, hierarchical, module_path, module_manager, pb_module,
     parent_pb_graph_node, CIRCUIT_PB_PORT_OUTPUT, physical_mode,
-    constrain_zero_delay_paths);
+    constrain_zero_delay_paths, group_delays, max_delay_groups);
 
   /* We check input_pins of child_pb_graph_node and its the input_edges
    * Built the interconnections between inputs of cur_pb_graph_node and inputs
@@ -314,12 +382,14 @@ static void print_pnr_sdc_constrain_pb_graph_node_timing(
       print_pnr_sdc_constrain_pb_interc_timing(
         fp, time_unit, hierarchical, module_path, module_manager, pb_module,
         child_pb_graph_node, CIRCUIT_PB_PORT_INPUT, physical_mode,
-        constrain_zero_delay_paths);
+        constrain_zero_delay_paths, group_delays, max_delay_groups);
       /* Do NOT constrain clock here, it should be handled by Clock Tree
        * Synthesis */
     }
   }
 
+  print_pnr_sdc_grouped_max_delays(fp, max_delay_groups);
+
   /* Close file handler */
   fp.close();
 }
@@ -24,6 +24,7 @@ PnrSdcOption::PnrSdcOption(const std::string& sdc_dir) {
   constrain_routing_multiplexer_outputs_ = false;
   constrain_switch_block_outputs_ = false;
   constrain_zero_delay_paths_ = false;
+  group_grid_delays_ = false;
   time_stamp_ = true;
 }
 
@@ -77,6 +78,8 @@ bool PnrSdcOption::constrain_zero_delay_paths() const {
   return constrain_zero_delay_paths_;
 }
 
+bool PnrSdcOption::group_grid_delays() const { return group_grid_delays_; }
+
 bool PnrSdcOption::time_stamp() const { return time_stamp_; }
 
 /********************************************************************
@@ -154,6 +157,10 @@ void PnrSdcOption::set_constrain_zero_delay_paths(
   constrain_zero_delay_paths_ = constrain_zero_delay_paths;
 }
 
+void PnrSdcOption::set_group_grid_delays(const bool& group_grid_delays) {
+  group_grid_delays_ = group_grid_delays;
+}
+
 void PnrSdcOption::set_time_stamp(const bool& enable) { time_stamp_ = enable; }
 
 } /* end namespace openfpga */
@@ -31,6 +31,7 @@ class PnrSdcOption {
   bool constrain_routing_multiplexer_outputs() const;
   bool constrain_switch_block_outputs() const;
   bool constrain_zero_delay_paths() const;
+  bool group_grid_delays() const;
   bool time_stamp() const;
 
  public: /* Public mutators */
@@ -52,6 +53,7 @@ class PnrSdcOption {
     const bool& constrain_routing_mux_outputs);
   void set_constrain_switch_block_outputs(const bool& constrain_sb_outputs);
   void set_constrain_zero_delay_paths(const bool& constrain_zero_delay_paths);
+  void set_group_grid_delays(const bool& group_grid_delays);
   void set_time_stamp(const bool& enable);
 
  private: /* Internal data */
@@ -69,6 +71,7 @@ class PnrSdcOption {
   bool constrain_routing_multiplexer_outputs_;
   bool constrain_switch_block_outputs_;
   bool constrain_zero_delay_paths_;
+  bool group_grid_delays_;
   bool time_stamp_;
 };
 
@@ -10,6 +10,9 @@
  *******************************************************************/
 #include <ctime>
 #include <fstream>
+#include <iomanip>
+#include <map>
+#include <sstream>
 
 /* Headers from vtrutil library */
 #include "vtr_assert.h"
@@ -40,12 +43,102 @@ static float find_pnr_sdc_switch_tmax(const t_rr_switch_inf& switch_inf) {
   return switch_inf.R * switch_inf.Cout + switch_inf.Tdel;
 }
 
+/********************************************************************
+ * A cache of the timing data which are shared by the SDC writers of all the
+ * routing blocks:
+ * - The delay of each switch, scaled by the time unit and formatted for SDC
+ *   files. A switch is used by many multiplexers of each routing block, and
+ *   the same switches are found in the routing blocks across the fabric
+ * - The SDC names of the pins of the routing module being written, as a pin
+ *   is usually an input of several multiplexers. The names are cleared once
+ *   another module is requested
+ *******************************************************************/
+class PnrSdcRoutingTimingCache {
+ public: /* Public constructors */
+  PnrSdcRoutingTimingCache(const float& time_unit) : time_unit_(time_unit) {}
+
+ public: /* Public accessors */
+  /* Find the delay of a switch, in the time unit of SDC files */
+  float switch_delay(const RRGraphView& rr_graph,
+                     const RRSwitchId& switch_id) {
+    return switch_data(rr_graph, switch_id).first;
+  }
+  /* Find the delay of a switch, formatted for SDC files */
+  const std::string& switch_delay_string(const RRGraphView& rr_graph,
+                                         const RRSwitchId& switch_id) {
+    return switch_data(rr_graph, switch_id).second;
+  }
+  /* Find the SDC name of a pin of a module */
+  const std::string& module_pin_name(const ModuleManager& module_manager,
+                                     const ModuleId& module_id,
+                                     const ModulePinInfo& module_pin) {
+    select_module(module_id);
+    auto result = pin_names_.find(module_pin);
+    if (result == pin_names_.end()) {
+      BasicPort pin(
+        module_manager.module_port(module_id, module_pin.first).get_name(),
+        module_pin.second, module_pin.second);
+      result =
+        pin_names_.emplace(module_pin, generate_sdc_port(pin)).first;
+    }
+    return result->second;
+  }
+  /* Find the SDC name of a port of a module */
+  const std::string& module_port_name(const ModuleManager& module_manager,
+                                      const ModuleId& module_id,
+                                      const ModulePortId& module_port) {
+    select_module(module_id);
+    auto result = port_names_.find(module_port);
+    if (result == port_names_.end()) {
+      result = port_names_
+                 .emplace(module_port,
+                          generate_sdc_port(module_manager.module_port(
+                            module_id, module_port)))
+                 .first;
+    }
+    return result->second;
+  }
+
+ private: /* Internal functions */
+  const std::pair<float, std::string>& switch_data(
+    const RRGraphView& rr_graph, const RRSwitchId& switch_id) {
+    auto result = switch_data_.find(switch_id);
+    if (result == switch_data_.end()) {
+      float delay =
+        find_pnr_sdc_switch_tmax(rr_graph.rr_switch_inf(switch_id)) /
+        time_unit_;
+      std::ostringstream delay_str;
+      delay_str << std::setprecision(10) << delay;
+      result =
+        switch_data_.emplace(switch_id, std::make_pair(delay, delay_str.str()))
+          .first;
+    }
+    return result->second;
+  }
+
+  void select_module(const ModuleId& module_id) {
+    if (module_id != module_id_) {
+      module_id_ = module_id;
+      pin_names_.clear();
+      port_names_.clear();
+    }
+  }
+
+ private: /* Internal data */
+  float time_unit_;
+  std::map<RRSwitchId, std::pair<float, std::string>> switch_data_;
+  ModuleId module_id_;
+  std::map<ModulePinInfo, std::string> pin_names_;
+  std::map<ModulePortId, std::string> port_names_;
+};
+
 /********************************************************************
  * Set timing constraints between the inputs and outputs of a routing
  * multiplexer in a Switch Block
  *******************************************************************/
 static void print_pnr_sdc_constrain_sb_mux_timing(
-  std::fstream& fp, const float& time_unit, const bool& hierarchical,
+  std::fstream& fp, PnrSdcRoutingTimingCache& timing_cache,
+  const bool& hierarchical,
   const std::string& module_path, const ModuleManager& module_manager,
   const ModuleId& sb_module, const VprDeviceAnnotation& device_annotation,
   const DeviceGrid& grids, const RRGraphView& rr_graph, const RRGSB& rr_gsb,
@@ -69,49 +162,44 @@ static void print_pnr_sdc_constrain_sb_mux_timing(
       module_manager, sb_module, grids, device_annotation, rr_graph, rr_gsb,
       get_rr_graph_configurable_driver_nodes(rr_graph, output_rr_node));
 
-  /* Find timing constraints for each path (edge) */
-  std::map<ModulePinInfo, float> switch_delays;
+  /* Find the switch of each path (edge), whose delay is the timing
+   * constraint */
+  std::map<ModulePinInfo, RRSwitchId> driver_switches;
   size_t edge_counter = 0;
   for (const RREdgeId& edge :
        rr_graph.node_configurable_in_edges(output_rr_node)) {
-    /* Get the switch delay */
-    const RRSwitchId& driver_switch = rr_graph.edge_switch(edge);
-    switch_delays[module_input_ports[edge_counter]] =
-      find_pnr_sdc_switch_tmax(rr_graph.rr_switch_inf(driver_switch));
+    driver_switches[module_input_ports[edge_counter]] =
+      rr_graph.edge_switch(edge);
     edge_counter++;
   }
 
+  const std::string& sink_port_name = timing_cache.module_pin_name(
+    module_manager, sb_module, module_output_port);
+
   /* Find the starting points */
   for (const ModulePinInfo& module_input_port : module_input_ports) {
+    const RRSwitchId& driver_switch = driver_switches[module_input_port];
     /* If we have a zero-delay path to contrain, we will skip unless users want
      * so */
     if ((false == constrain_zero_delay_paths) &&
-        (0. == switch_delays[module_input_port])) {
+        (0. == timing_cache.switch_delay(rr_graph, driver_switch))) {
       continue;
     }
 
-    BasicPort src_port(
-      module_manager.module_port(sb_module, module_input_port.first).get_name(),
-      module_input_port.second, module_input_port.second);
-
-    BasicPort sink_port(
-      module_manager.module_port(sb_module, module_output_port.first)
-        .get_name(),
-      module_output_port.second, module_output_port.second);
+    const std::string& src_port_name = timing_cache.module_pin_name(
+      module_manager, sb_module, module_input_port);
 
     /* Constrain a path */
     if (false == hierarchical) {
       print_pnr_sdc_constrain_max_delay(
-        fp, module_path, generate_sdc_port(src_port), module_path,
-        generate_sdc_port(sink_port),
-        switch_delays[module_input_port] / time_unit);
+        fp, module_path, src_port_name, module_path, sink_port_name,
+        timing_cache.switch_delay_string(rr_graph, driver_switch));
 
     } else {
       VTR_ASSERT_SAFE(true == hierarchical);
       print_pnr_sdc_constrain_max_delay(
-        fp, std::string(), generate_sdc_port(src_port), std::string(),
-        generate_sdc_port(sink_port),
-        switch_delays[module_input_port] / time_unit);
+        fp, std::string(), src_port_name, std::string(), sink_port_name,
+        timing_cache.switch_delay_string(rr_graph, driver_switch));
     }
   }
 }
@@ -125,7 +213,8 @@ static void print_pnr_sdc_constrain_sb_mux_timing(
  * file for each unique SB module
  *******************************************************************/
 static void print_pnr_sdc_constrain_sb_timing(
-  const PnrSdcOption& options, const std::string& module_path,
+  const PnrSdcOption& options, PnrSdcRoutingTimingCache& timing_cache,
+  const std::string& module_path,
   const ModuleManager& module_manager,
   const VprDeviceAnnotation& device_annotation, const DeviceGrid& grids,
   const RRGraphView& rr_graph, const RRGSB& rr_gsb) {
@@ -180,7 +269,7 @@ static void print_pnr_sdc_constrain_sb_timing(
       }
       /* This is a MUX, constrain all the paths from an input to an output */
       print_pnr_sdc_constrain_sb_mux_timing(
-        fp, time_unit, hierarchical, module_path, module_manager, sb_module,
+        fp, timing_cache, hierarchical, module_path, module_manager, sb_module,
         device_annotation, grids, rr_graph, rr_gsb, side_manager.get_side(),
         chan_rr_node, constrain_zero_delay_paths);
     }
@@ -203,6 +292,8 @@ void print_pnr_sdc_flatten_routing_constrain_sb_timing(
   vtr::ScopedStartFinishTimer timer(
     "Write SDC for constrain Switch Block timing for P&R flow");
 
+  PnrSdcRoutingTimingCache timing_cache(options.time_unit());
+
   std::string root_path = module_manager.module_name(top_module);
 
   /* Get the range of SB array */
@@ -224,9 +315,9 @@ void print_pnr_sdc_flatten_routing_constrain_sb_timing(
 
       std::string module_path = format_dir_path(root_path) + sb_instance_name;
 
-      print_pnr_sdc_constrain_sb_timing(options, module_path, module_manager,
-                                        device_annotation, grids, rr_graph,
-                                        rr_gsb);
+      print_pnr_sdc_constrain_sb_timing(options, timing_cache, module_path,
+                                        module_manager, device_annotation,
+                                        grids, rr_graph, rr_gsb);
     }
   }
 }
@@ -244,6 +335,8 @@ void print_pnr_sdc_compact_routing_constrain_sb_timing(
   vtr::ScopedStartFinishTimer timer(
     "Write SDC for constrain Switch Block timing for P&R flow");
 
+  PnrSdcRoutingTimingCache timing_cache(options.time_unit());
+
   std::string root_path = module_manager.module_name(top_module);
 
   for (size_t isb = 0; isb < device_rr_gsb.get_num_sb_unique_module(); ++isb) {
@@ -264,9 +357,9 @@ void print_pnr_sdc_compact_routing_constrain_sb_timing(
 
     std::string module_path = format_dir_path(root_path) + sb_module_name;
 
-    print_pnr_sdc_constrain_sb_timing(options, module_path, module_manager,
-                                      device_annotation, grids, rr_graph,
-                                      rr_gsb);
+    print_pnr_sdc_constrain_sb_timing(options, timing_cache, module_path,
+                                      module_manager, device_annotation, grids,
+                                      rr_graph, rr_gsb);
   }
 }
 
@@ -275,7 +368,8 @@ void print_pnr_sdc_compact_routing_constrain_sb_timing(
  * multiplexer in a Connection Block
  *******************************************************************/
 static void print_pnr_sdc_constrain_cb_mux_timing(
-  std::fstream& fp, const float& time_unit, const bool& hierarchical,
+  std::fstream& fp, PnrSdcRoutingTimingCache& timing_cache,
+  const bool& hierarchical,
   const std::string& module_path, const ModuleManager& module_manager,
   const ModuleId& cb_module, const VprDeviceAnnotation& device_annotation,
   const DeviceGrid& grids, const RRGraphView& rr_graph, const RRGSB& rr_gsb,
@@ -320,46 +414,45 @@ static void print_pnr_sdc_constrain_cb_mux_timing(
     find_connection_block_module_input_ports(
       module_manager, cb_module, rr_graph, rr_gsb, cb_type, input_rr_nodes);
 
-  /* Find timing constraints for each path (edge) */
-  std::map<ModulePinInfo, float> switch_delays;
+  /* Find the switch of each path (edge), whose delay is the timing
+   * constraint */
+  std::map<ModulePinInfo, RRSwitchId> driver_switches;
   size_t edge_counter = 0;
   for (const RREdgeId& edge :
        rr_graph.node_configurable_in_edges(output_rr_node)) {
-    /* Get the switch delay */
-    const RRSwitchId& driver_switch = rr_graph.edge_switch(edge);
-    switch_delays[module_input_ports[edge_counter]] =
-      find_pnr_sdc_switch_tmax(rr_graph.rr_switch_inf(driver_switch));
+    driver_switches[module_input_ports[edge_counter]] =
+      rr_graph.edge_switch(edge);
     edge_counter++;
   }
 
+  const std::string& output_port_name = timing_cache.module_port_name(
+    module_manager, cb_module, module_output_port);
+
   /* Find the starting points */
   for (const ModulePinInfo& module_input_port : module_input_ports) {
+    const RRSwitchId& driver_switch = driver_switches[module_input_port];
     /* If we have a zero-delay path to contrain, we will skip unless users want
      * so */
     if ((false == constrain_zero_delay_paths) &&
-        (0. == switch_delays[module_input_port])) {
+        (0. == timing_cache.switch_delay(rr_graph, driver_switch))) {
       continue;
     }
 
-    BasicPort input_port(
-      module_manager.module_port(cb_module, module_input_port.first).get_name(),
-      module_input_port.second, module_input_port.second);
-    BasicPort output_port =
-      module_manager.module_port(cb_module, module_output_port);
+    const std::string& input_port_name = timing_cache.module_pin_name(
+      module_manager, cb_module, module_input_port);
 
     /* Constrain a path */
     if (true == hierarchical) {
       print_pnr_sdc_constrain_max_delay(
-        fp, std::string(), generate_sdc_port(input_port), std::string(),
-        generate_sdc_port(output_port),
-        switch_delays[module_input_port] / time_unit);
+        fp, std::string(), input_port_name, std::string(), output_port_name,
+        timing_cache.switch_delay_string(rr_graph, driver_switch));
 
     } else {
       VTR_ASSERT_SAFE(false == hierarchical);
       print_pnr_sdc_constrain_max_delay(
-        fp, std::string(module_path), generate_sdc_port(input_port),
-        std::string(module_path), generate_sdc_port(output_port),
-        switch_delays[module_input_port] / time_unit);
+        fp, std::string(module_path), input_port_name,
+        std::string(module_path), output_port_name,
+        timing_cache.switch_delay_string(rr_graph, driver_switch));
     }
   }
 }
@@ -369,7 +462,8 @@ static void print_pnr_sdc_constrain_cb_mux_timing(
  * This function is designed for compact routing hierarchy
  *******************************************************************/
 static void print_pnr_sdc_constrain_cb_timing(
-  const PnrSdcOption& options, const std::string& module_path,
+  const PnrSdcOption& options, PnrSdcRoutingTimingCache& timing_cache,
+  const std::string& module_path,
   const ModuleManager& module_manager,
   const VprDeviceAnnotation& device_annotation, const DeviceGrid& grids,
   const RRGraphView& rr_graph, const RRGSB& rr_gsb, const t_rr_type& cb_type) {
@@ -474,7 +568,7 @@ static void print_pnr_sdc_constrain_cb_timing(
          ++inode) {
       const RRNodeId& ipin_rr_node = rr_gsb.get_ipin_node(cb_ipin_side, inode);
       print_pnr_sdc_constrain_cb_mux_timing(
-        fp, time_unit, hierarchical, module_path, module_manager, cb_module,
+        fp, timing_cache, hierarchical, module_path, module_manager, cb_module,
         device_annotation, grids, rr_graph, rr_gsb, cb_type, ipin_rr_node,
         constrain_zero_delay_paths);
     }
@@ -489,7 +583,8 @@ static void print_pnr_sdc_constrain_cb_timing(
  * and print SDC file for each of them
  *******************************************************************/
 static void print_pnr_sdc_flatten_routing_constrain_cb_timing(
-  const PnrSdcOption& options, const ModuleManager& module_manager,
+  const PnrSdcOption& options, PnrSdcRoutingTimingCache& timing_cache,
+  const ModuleManager& module_manager,
   const ModuleId& top_module, const VprDeviceAnnotation& device_annotation,
   const DeviceGrid& grids, const RRGraphView& rr_graph,
   const DeviceRRGSB& device_rr_gsb, const t_rr_type& cb_type) {
@@ -521,9 +616,9 @@ static void print_pnr_sdc_flatten_routing_constrain_cb_timing(
 
       std::string module_path = format_dir_path(root_path) + cb_instance_name;
 
-      print_pnr_sdc_constrain_cb_timing(options, module_path, module_manager,
-                                        device_annotation, grids, rr_graph,
-                                        rr_gsb, cb_type);
+      print_pnr_sdc_constrain_cb_timing(options, timing_cache, module_path,
+                                        module_manager, device_annotation,
+                                        grids, rr_graph, rr_gsb, cb_type);
     }
   }
 }
@@ -541,13 +636,15 @@ void print_pnr_sdc_flatten_routing_constrain_cb_timing(
   vtr::ScopedStartFinishTimer timer(
     "Write SDC for constrain Connection Block timing for P&R flow");
 
+  PnrSdcRoutingTimingCache timing_cache(options.time_unit());
+
   print_pnr_sdc_flatten_routing_constrain_cb_timing(
-    options, module_manager, top_module, device_annotation, grids, rr_graph,
-    device_rr_gsb, CHANX);
+    options, timing_cache, module_manager, top_module, device_annotation,
+    grids, rr_graph, device_rr_gsb, CHANX);
 
   print_pnr_sdc_flatten_routing_constrain_cb_timing(
-    options, module_manager, top_module, device_annotation, grids, rr_graph,
-    device_rr_gsb, CHANY);
+    options, timing_cache, module_manager, top_module, device_annotation,
+    grids, rr_graph, device_rr_gsb, CHANY);
 }
 
 /********************************************************************
@@ -563,6 +660,8 @@ void print_pnr_sdc_compact_routing_constrain_cb_timing(
   vtr::ScopedStartFinishTimer timer(
     "Write SDC for constrain Connection Block timing for P&R flow");
 
+  PnrSdcRoutingTimingCache timing_cache(options.time_unit());
+
   std::string root_path = module_manager.module_name(top_module);
 
   /* Print SDC for unique X-direction connection block modules */
@@ -582,9 +681,9 @@ void print_pnr_sdc_compact_routing_constrain_cb_timing(
 
     std::string module_path = format_dir_path(root_path) + cb_module_name;
 
-    print_pnr_sdc_constrain_cb_timing(options, module_path, module_manager,
-                                      device_annotation, grids, rr_graph,
-                                      unique_mirror, CHANX);
+    print_pnr_sdc_constrain_cb_timing(options, timing_cache, module_path,
+                                      module_manager, device_annotation, grids,
+                                      rr_graph, unique_mirror, CHANX);
   }
 
   /* Print SDC for unique Y-direction connection block modules */
@@ -604,9 +703,9 @@ void print_pnr_sdc_compact_routing_constrain_cb_timing(
 
     std::string module_path = format_dir_path(root_path) + cb_module_name;
 
-    print_pnr_sdc_constrain_cb_timing(options, module_path, module_manager,
-                                      device_annotation, grids, rr_graph,
-                                      unique_mirror, CHANY);
+    print_pnr_sdc_constrain_cb_timing(options, timing_cache, module_path,
+                                      module_manager, device_annotation, grids,
+                                      rr_graph, unique_mirror, CHANY);
   }
 }
 
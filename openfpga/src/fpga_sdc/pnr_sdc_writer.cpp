@@ -11,6 +11,7 @@
 #include <ctime>
 #include <fstream>
 #include <iomanip>
+#include <unordered_set>
 
 /* Headers from vtrutil library */
 #include "command_exit_codes.h"
@@ -78,6 +79,47 @@ static void print_pnr_sdc_constrain_configurable_memory_outputs(
   fp.close();
 }
 
+/********************************************************************
+ * Disable the timing at all the outputs of a module, whose instance is
+ * given by its path. An empty path refers to the module itself, which is
+ * used by hierarchical SDC files
+ *******************************************************************/
+static void print_pnr_sdc_disable_module_outputs(
+  std::fstream& fp, const bool& flatten_names,
+  const ModuleManager& module_manager, const ModuleId& module_id,
+  const std::string& module_path) {
+  std::unordered_set<std::string> port_wildcard_names;
+
+  /* Disable the outputs of the module */
+  for (const BasicPort& output_port : module_manager.module_ports_by_type(
+         module_id, ModuleManager::MODULE_OUTPUT_PORT)) {
+    std::string port_name = output_port.get_name();
+
+    if (false == flatten_names) {
+      /* Try to adapt to a wildcard name: replace all the numbers with a
+       * wildcard character '*' */
+      WildCardString port_wildcard_str(output_port.get_name());
+      /* If the wildcard name is already in the list, we can skip this
+       * Otherwise, we have to
+       *   - output this port
+       *   - record the wildcard name in the vector
+       */
+      if (false ==
+          port_wildcard_names.insert(port_wildcard_str.data()).second) {
+        continue;
+      }
+
+      port_name = port_wildcard_str.data();
+    }
+
+    fp << "set_disable_timing ";
+    fp << module_path;
+    fp << port_name << std::endl;
+
+    fp << std::endl;
+  }
+}
+
 /********************************************************************
  * Break combinational loops in FPGA fabric, which mainly come from
  * loops of multiplexers.
@@ -116,7 +158,7 @@ static void print_pnr_sdc_flatten_routing_disable_switch_block_outputs(
    * (MIB) We will find all the instance names and see there are common prefix
    * If so, we can use wildcards
    */
-  std::map<ModuleId, std::vector<std::string>> wildcard_names;
+  std::map<ModuleId, std::unordered_set<std::string>> wildcard_names;
 
   /* Get the range of SB array */
   vtr::Point<size_t> sb_range = device_rr_gsb.get_gsb_range();
@@ -147,56 +189,20 @@ static void print_pnr_sdc_flatten_routing_disable_switch_block_outputs(
          *   - output this instance
          *   - record the wildcard name in the map
          */
-        if ((0 < wildcard_names.count(sb_module)) &&
-            (wildcard_names.at(sb_module).end() !=
-             std::find(wildcard_names.at(sb_module).begin(),
-                       wildcard_names.at(sb_module).end(),
-                       wildcard_str.data()))) {
+        if (false ==
+            wildcard_names[sb_module].insert(wildcard_str.data()).second) {
           continue;
         }
 
         module_path += wildcard_str.data();
-
-        wildcard_names[sb_module].push_back(wildcard_str.data());
       } else {
         module_path += sb_instance_name;
       }
 
       module_path = format_dir_path(module_path);
 
-      std::vector<std::string> port_wildcard_names;
-
-      /* Disable the outputs of the module */
-      for (const BasicPort& output_port : module_manager.module_ports_by_type(
-             sb_module, ModuleManager::MODULE_OUTPUT_PORT)) {
-        std::string port_name = output_port.get_name();
-
-        if (false == flatten_names) {
-          /* Try to adapt to a wildcard name: replace all the numbers with a
-           * wildcard character '*' */
-          WildCardString port_wildcard_str(output_port.get_name());
-          /* If the wildcard name is already in the list, we can skip this
-           * Otherwise, we have to
-           *   - output this port
-           *   - record the wildcard name in the vector
-           */
-          if (port_wildcard_names.end() !=
-              std::find(port_wildcard_names.begin(), port_wildcard_names.end(),
-                        port_wildcard_str.data())) {
-            continue;
-          }
-
-          port_name = port_wildcard_str.data();
-
-          port_wildcard_names.push_back(port_wildcard_str.data());
-        }
-
-        fp << "set_disable_timing ";
-        fp << module_path;
-        fp << port_name << std::endl;
-
-        fp << std::endl;
-      }
+      print_pnr_sdc_disable_module_outputs(fp, flatten_names, module_manager,
+                                           sb_module, module_path);
     }
   }
 
@@ -242,7 +248,7 @@ static void print_pnr_sdc_compact_routing_disable_switch_block_outputs(
    * (MIB) We will find all the instance names and see there are common prefix
    * If so, we can use wildcards
    */
-  std::map<ModuleId, std::vector<std::string>> wildcard_names;
+  std::map<ModuleId, std::unordered_set<std::string>> wildcard_names;
 
   /* Build unique switch block modules */
   for (size_t isb = 0; isb < device_rr_gsb.get_num_sb_unique_module(); ++isb) {
@@ -276,63 +282,207 @@ static void print_pnr_sdc_compact_routing_disable_switch_block_outputs(
          *   - output this instance
          *   - record the wildcard name in the map
          */
-        if ((0 < wildcard_names.count(sb_module)) &&
-            (wildcard_names.at(sb_module).end() !=
-             std::find(wildcard_names.at(sb_module).begin(),
-                       wildcard_names.at(sb_module).end(),
-                       wildcard_str.data()))) {
+        if (false ==
+            wildcard_names[sb_module].insert(wildcard_str.data()).second) {
           continue;
         }
 
         module_path += wildcard_str.data();
-
-        wildcard_names[sb_module].push_back(wildcard_str.data());
       } else {
         module_path += sb_instance_name;
       }
 
       module_path = format_dir_path(module_path);
 
-      std::vector<std::string> port_wildcard_names;
-
-      /* Disable the outputs of the module */
-      for (const BasicPort& output_port : module_manager.module_ports_by_type(
-             sb_module, ModuleManager::MODULE_OUTPUT_PORT)) {
-        std::string port_name = output_port.get_name();
-
-        if (false == flatten_names) {
-          /* Try to adapt to a wildcard name: replace all the numbers with a
-           * wildcard character '*' */
-          WildCardString port_wildcard_str(output_port.get_name());
-          /* If the wildcard name is already in the list, we can skip this
-           * Otherwise, we have to
-           *   - output this port
-           *   - record the wildcard name in the vector
-           */
-          if (port_wildcard_names.end() !=
-              std::find(port_wildcard_names.begin(), port_wildcard_names.end(),
-                        port_wildcard_str.data())) {
-            continue;
-          }
-
-          port_name = port_wildcard_str.data();
-
-          port_wildcard_names.push_back(port_wildcard_str.data());
-        }
+      print_pnr_sdc_disable_module_outputs(fp, flatten_names, module_manager,
+                                           sb_module, module_path);
+    }
+  }
 
-        fp << "set_disable_timing ";
-        fp << module_path;
-        fp << port_name << std::endl;
+  /* Close file handler */
+  fp.close();
+}
+
+/********************************************************************
+ * Break combinational loops in FPGA fabric, which mainly come from
+ * configurable memory cells.
+ * This function is designed for hierarchical SDC files: the outputs of
+ * memory cells are disabled once for each unique module which contains
+ * them, in a SDC file dedicated to the module, e.g.,
+ *   <sdc_dir>/<module_name>_disable_configurable_memory_outputs.sdc
+ * whose paths are relative to the module. The instances of each module
+ * can be output to a plain text file, so that the time and size of SDC
+ * generation follow the number of unique modules rather than the size of
+ * the fabric
+ *******************************************************************/
+static void print_pnr_sdc_hierarchical_constrain_configurable_memory_outputs(
+  const std::string& sdc_dir, const bool& flatten_names,
+  const bool& include_time_stamp, const bool& output_hierarchy,
+  const ModuleManager& module_manager, const ModuleId& top_module) {
+  /* Start time count */
+  std::string timer_message =
+    std::string(
+      "Write hierarchical SDC to disable configurable memory outputs for P&R "
+      "flow in '") +
+    sdc_dir + std::string("'");
+  vtr::ScopedStartFinishTimer timer(timer_message);
 
-        fp << std::endl;
+  /* Find the unique modules in a Depth-First Search, as well as the
+   * instances of each module in its parent modules */
+  std::vector<ModuleId> unique_modules;
+  std::map<ModuleId, std::vector<std::string>> module_instances;
+  std::vector<ModuleId> module_stack(1, top_module);
+  module_instances[top_module];
+  while (!module_stack.empty()) {
+    ModuleId parent_module = module_stack.back();
+    module_stack.pop_back();
+    unique_modules.push_back(parent_module);
+
+    const std::vector<ModuleId>& children =
+      module_manager.configurable_children(
+        parent_module, ModuleManager::e_config_child_type::PHYSICAL);
+    const std::vector<size_t>& child_instances =
+      module_manager.configurable_child_instances(
+        parent_module, ModuleManager::e_config_child_type::PHYSICAL);
+    for (size_t ichild = 0; ichild < children.size(); ++ichild) {
+      ModuleId child_module = children[ichild];
+      /* Leaf modules are constrained by their parents */
+      if (0 == module_manager
+                 .configurable_children(
+                   child_module, ModuleManager::e_config_child_type::PHYSICAL)
+                 .size()) {
+        continue;
+      }
+      if (0 == module_instances.count(child_module)) {
+        module_stack.push_back(child_module);
+      }
+      std::string instance_name = module_manager.instance_name(
+        parent_module, child_module, child_instances[ichild]);
+      if (true == instance_name.empty()) {
+        instance_name = generate_instance_name(
+          module_manager.module_name(child_module), child_instances[ichild]);
       }
+      module_instances[child_module].push_back(
+        module_manager.module_name(parent_module) + std::string("/") +
+        instance_name);
     }
   }
 
-  /* Close file handler */
+  /* Write a SDC file for each unique module */
+  for (const ModuleId& module_id : unique_modules) {
+    std::string sdc_fname(
+      sdc_dir + module_manager.module_name(module_id) +
+      std::string(SDC_DISABLE_CONFIG_MEM_OUTPUTS_FILE_POSTFIX));
+
+    std::fstream fp;
+    fp.open(sdc_fname, std::fstream::out | std::fstream::trunc);
+    check_file_stream(sdc_fname.c_str(), fp);
+
+    print_sdc_file_header(
+      fp,
+      std::string("Disable configurable memory outputs of module ") +
+        module_manager.module_name(module_id) + std::string(" for PnR"),
+      include_time_stamp);
+
+    print_pnr_sdc_disable_configurable_memory_child_outputs(
+      fp, flatten_names, module_manager, module_id);
+
+    fp.close();
+  }
+
+  if (false == output_hierarchy) {
+    return;
+  }
+
+  /* Output the instances of each unique module to a plain text file */
+  std::string fname(sdc_dir + std::string(SDC_CONFIG_MEM_HIERARCHY_FILE_NAME));
+  std::fstream fp;
+  fp.open(fname, std::fstream::out | std::fstream::trunc);
+  check_file_stream(fname.c_str(), fp);
+
+  for (const ModuleId& module_id : unique_modules) {
+    fp << "- " << module_manager.module_name(module_id) << ":"
+       << "\n";
+    for (const std::string& instance_path : module_instances.at(module_id)) {
+      fp << "  ";
+      fp << "- " << instance_path << "\n";
+    }
+    fp << "\n";
+  }
+
   fp.close();
 }
 
+/********************************************************************
+ * Break combinational loops in FPGA fabric, which mainly come from
+ * loops of multiplexers.
+ * To handle this, we disable the timing at outputs of Switch blocks
+ * This function is designed for hierarchical SDC files: the outputs are
+ * disabled in a SDC file dedicated to each unique Switch Block module, e.g.,
+ *   <sdc_dir>/<module_name>_disable_outputs.sdc
+ * The instances of each module are found in the hierarchy file of Switch
+ * Blocks
+ *******************************************************************/
+static void print_pnr_sdc_hierarchical_disable_switch_block_outputs(
+  const std::string& sdc_dir, const bool& flatten_names,
+  const bool& include_time_stamp, const ModuleManager& module_manager,
+  const DeviceRRGSB& device_rr_gsb, const RRGraphView& rr_graph,
+  const bool& compact_routing_hierarchy) {
+  /* Start time count */
+  std::string timer_message =
+    std::string(
+      "Write hierarchical SDC to disable switch block outputs for P&R flow "
+      "in '") +
+    sdc_dir + std::string("'");
+  vtr::ScopedStartFinishTimer timer(timer_message);
+
+  /* Only unique modules are considered when routing hierarchy is compact */
+  std::vector<const RRGSB*> sb_modules;
+  if (true == compact_routing_hierarchy) {
+    for (size_t isb = 0; isb < device_rr_gsb.get_num_sb_unique_module();
+         ++isb) {
+      sb_modules.push_back(&device_rr_gsb.get_sb_unique_module(isb));
+    }
+  } else {
+    vtr::Point<size_t> sb_range = device_rr_gsb.get_gsb_range();
+    for (size_t ix = 0; ix < sb_range.x(); ++ix) {
+      for (size_t iy = 0; iy < sb_range.y(); ++iy) {
+        sb_modules.push_back(&device_rr_gsb.get_gsb(ix, iy));
+      }
+    }
+  }
+
+  for (const RRGSB* rr_gsb : sb_modules) {
+    if (false == rr_gsb->is_sb_exist(rr_graph)) {
+      continue;
+    }
+
+    vtr::Point<size_t> gsb_coordinate(rr_gsb->get_sb_x(), rr_gsb->get_sb_y());
+    std::string sb_module_name =
+      generate_switch_block_module_name(gsb_coordinate);
+
+    ModuleId sb_module = module_manager.find_module(sb_module_name);
+    VTR_ASSERT(true == module_manager.valid_module_id(sb_module));
+
+    std::string sdc_fname(sdc_dir + sb_module_name +
+                          std::string(SDC_DISABLE_SB_OUTPUTS_FILE_POSTFIX));
+
+    std::fstream fp;
+    fp.open(sdc_fname, std::fstream::out | std::fstream::trunc);
+    check_file_stream(sdc_fname.c_str(), fp);
+
+    print_sdc_file_header(fp,
+                          std::string("Disable outputs of Switch Block ") +
+                            sb_module_name + std::string(" for PnR"),
+                          include_time_stamp);
+
+    print_pnr_sdc_disable_module_outputs(fp, flatten_names, module_manager,
+                                         sb_module, std::string());
+
+    fp.close();
+  }
+}
+
 /********************************************************************
  * Top-level function to print a number of SDC files in different purpose
  * This function will generate files upon the options provided by users
@@ -374,7 +524,13 @@ int print_pnr_sdc(
   }
 
   /* Output Design Constraints to disable outputs of memory cells */
-  if (true == sdc_options.constrain_configurable_memory_outputs()) {
+  if ((true == sdc_options.constrain_configurable_memory_outputs()) &&
+      (true == sdc_options.hierarchical())) {
+    print_pnr_sdc_hierarchical_constrain_configurable_memory_outputs(
+      sdc_options.sdc_dir(), sdc_options.flatten_names(),
+      sdc_options.time_stamp(), sdc_options.output_hierarchy(),
+      module_manager, top_module);
+  } else if (true == sdc_options.constrain_configurable_memory_outputs()) {
     print_pnr_sdc_constrain_configurable_memory_outputs(
       sdc_options.sdc_dir(), sdc_options.flatten_names(),
       sdc_options.time_stamp(), module_manager, top_module);
@@ -390,7 +546,12 @@ int print_pnr_sdc(
 
   /* Break loops from any SB output */
   if (true == sdc_options.constrain_switch_block_outputs()) {
-    if (true == compact_routing_hierarchy) {
+    if (true == sdc_options.hierarchical()) {
+      print_pnr_sdc_hierarchical_disable_switch_block_outputs(
+        sdc_options.sdc_dir(), sdc_options.flatten_names(),
+        sdc_options.time_stamp(), module_manager, device_rr_gsb,
+        device_ctx.rr_graph, compact_routing_hierarchy);
+    } else if (true == compact_routing_hierarchy) {
       print_pnr_sdc_compact_routing_disable_switch_block_outputs(
         sdc_options.sdc_dir(), sdc_options.flatten_names(),
         sdc_options.time_stamp(), module_manager, top_module, device_rr_gsb,
@@ -418,8 +579,11 @@ int print_pnr_sdc(
     }
   }
 
-  /* Output hierachy to plain text file */
-  if ((true == sdc_options.constrain_sb()) &&
+  /* Output hierachy to plain text file, which is also the instance mapping
+   * of the hierarchical SDC files for Switch Block outputs */
+  if (((true == sdc_options.constrain_sb()) ||
+       ((true == sdc_options.constrain_switch_block_outputs()) &&
+        (true == sdc_options.hierarchical()))) &&
       (true == sdc_options.output_hierarchy()) &&
       (true == compact_routing_hierarchy)) {
     print_pnr_sdc_routing_sb_hierarchy(sdc_options.sdc_dir(), module_manager,
@@ -2,6 +2,8 @@
  * Most utilized function used to constrain memory cells in FPGA
  * fabric using SDC commands
  *******************************************************************/
+#include <map>
+#include <unordered_set>
 
 /* Headers from vtrutil library */
 #include "vtr_assert.h"
@@ -41,7 +43,7 @@ void rec_print_pnr_sdc_disable_configurable_memory_module_output(
    * (MIB) We will find all the instance names and see there are common prefix
    * If so, we can use wildcards
    */
-  std::map<ModuleId, std::vector<std::string>> wildcard_names;
+  std::map<ModuleId, std::unordered_set<std::string>> wildcard_names;
 
   /* For each configurable child, we will go one level down in priority */
   for (size_t child_index = 0;
@@ -77,17 +79,12 @@ void rec_print_pnr_sdc_disable_configurable_memory_module_output(
        *   - output this instance
        *   - record the wildcard name in the map
        */
-      if ((0 < wildcard_names.count(child_module_id)) &&
-          (wildcard_names.at(child_module_id).end() !=
-           std::find(wildcard_names.at(child_module_id).begin(),
-                     wildcard_names.at(child_module_id).end(),
-                     wildcard_str.data()))) {
+      if (false ==
+          wildcard_names[child_module_id].insert(wildcard_str.data()).second) {
         continue;
       }
 
       child_module_path += wildcard_str.data();
-
-      wildcard_names[child_module_id].push_back(wildcard_str.data());
     } else {
       child_module_path += child_instance_name;
     }
@@ -119,4 +116,75 @@ void rec_print_pnr_sdc_disable_configurable_memory_module_output(
   }
 }
 
+
+/********************************************************************
+ * Print SDC commands to disable outputs of the configurable memory modules
+ * which are the direct configurable children of a given module.
+ * Only the children which do not have any configurable children (leaf
+ * modules) are considered, the others are expected to be constrained in
+ * their own module. The paths are relative to the given module, so that
+ * the commands are written once for each unique module, regardless of its
+ * number of instances in the fabric
+ *
+ * Note:
+ *   - When flatten_names is true
+ *     this function will not apply any wildcard to names
+ *   - When flatten_names is false
+ *     This function will try to apply wildcard to names
+ *     so that SDC file size can be minimal
+ *******************************************************************/
+void print_pnr_sdc_disable_configurable_memory_child_outputs(
+  std::fstream& fp, const bool& flatten_names,
+  const ModuleManager& module_manager, const ModuleId& parent_module) {
+  /* Validate file stream */
+  valid_file_stream(fp);
+
+  std::map<ModuleId, std::unordered_set<std::string>> wildcard_names;
+
+  const std::vector<ModuleId>& children = module_manager.configurable_children(
+    parent_module, ModuleManager::e_config_child_type::PHYSICAL);
+  const std::vector<size_t>& child_instances =
+    module_manager.configurable_child_instances(
+      parent_module, ModuleManager::e_config_child_type::PHYSICAL);
+  for (size_t child_index = 0; child_index < children.size(); ++child_index) {
+    ModuleId child_module_id = children[child_index];
+    /* Non-leaf children have their own constraints */
+    if (0 < module_manager
+              .configurable_children(
+                child_module_id, ModuleManager::e_config_child_type::PHYSICAL)
+              .size()) {
+      continue;
+    }
+    size_t child_instance_id = child_instances[child_index];
+    std::string child_instance_name = module_manager.instance_name(
+      parent_module, child_module_id, child_instance_id);
+    if (true == child_instance_name.empty()) {
+      child_instance_name = generate_instance_name(
+        module_manager.module_name(child_module_id), child_instance_id);
+    }
+
+    if (false == flatten_names) {
+      /* Try to adapt to a wildcard name: replace all the numbers with a
+       * wildcard character '*' */
+      WildCardString wildcard_str(child_instance_name);
+      std::unordered_set<std::string>& child_wildcard_names =
+        wildcard_names[child_module_id];
+      if (false == child_wildcard_names.insert(wildcard_str.data()).second) {
+        continue;
+      }
+      child_instance_name = wildcard_str.data();
+    }
+
+    std::string child_module_path = format_dir_path(child_instance_name);
+
+    /* Disable timing for each output port of this child */
+    for (const BasicPort& output_port : module_manager.module_ports_by_type(
+           child_module_id, ModuleManager::MODULE_OUTPUT_PORT)) {
+      fp << "set_disable_timing ";
+      fp << child_module_path << output_port.get_name();
+      fp << std::endl;
+    }
+  }
+}
+
 } /* end namespace openfpga */
@@ -21,6 +21,10 @@ void rec_print_pnr_sdc_disable_configurable_memory_module_output(
   const ModuleManager& module_manager, const ModuleId& parent_module,
   const std::string& parent_module_path);
 
+void print_pnr_sdc_disable_configurable_memory_child_outputs(
+  std::fstream& fp, const bool& flatten_names,
+  const ModuleManager& module_manager, const ModuleId& parent_module);
+
 } /* end namespace openfpga */
 
 #endif
@@ -16,11 +16,21 @@ constexpr const char* SDC_DISABLE_MUX_OUTPUTS_FILE_NAME =
 constexpr const char* SDC_DISABLE_SB_OUTPUTS_FILE_NAME =
   "disable_sb_outputs.sdc";
 constexpr const char* SDC_CB_FILE_NAME = "cb.sdc";
+constexpr const char* SDC_DISABLE_CONFIG_MEM_OUTPUTS_FILE_POSTFIX =
+  "_disable_configurable_memory_outputs.sdc";
+constexpr const char* SDC_DISABLE_SB_OUTPUTS_FILE_POSTFIX =
+  "_disable_outputs.sdc";
+constexpr const char* SDC_CONFIG_CHAIN_FILE_POSTFIX =
+  "_configurable_chain.sdc";
 
 constexpr const char* SDC_GRID_HIERARCHY_FILE_NAME = "grid_hierarchy.txt";
 constexpr const char* SDC_SB_HIERARCHY_FILE_NAME = "sb_hierarchy.txt";
 constexpr const char* SDC_CBX_HIERARCHY_FILE_NAME = "cbx_hierarchy.txt";
 constexpr const char* SDC_CBY_HIERARCHY_FILE_NAME = "cby_hierarchy.txt";
+constexpr const char* SDC_CONFIG_MEM_HIERARCHY_FILE_NAME =
+  "config_mem_hierarchy.txt";
+constexpr const char* SDC_CONFIG_CHAIN_HIERARCHY_FILE_NAME =
+  "config_chain_hierarchy.txt";
 
 constexpr const char* SDC_ANALYSIS_FILE_NAME = "fpga_top_analysis.sdc";
 
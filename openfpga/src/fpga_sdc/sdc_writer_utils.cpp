@@ -5,6 +5,7 @@
 #include <ctime>
 #include <iomanip>
 #include <map>
+#include <unordered_set>
 
 /* Headers from vtrutil library */
 #include "vtr_assert.h"
@@ -82,6 +83,43 @@ std::string generate_sdc_port(const BasicPort& port) {
   return sdc_line;
 }
 
+/********************************************************************
+ * Generate a regular expression matching any of the given names, e.g.,
+ *   (a/in\\\[0\\\]|a/in\\\[1\\\])
+ * to be used with get_pins -regexp in a double-quoted string.
+ * The special characters of regular expressions are escaped, as well as
+ * those of Tcl, so that each name is matched literally
+ *******************************************************************/
+std::string generate_sdc_regexp_alternatives(
+  const std::vector<std::string>& names) {
+  std::string regexp;
+  if (1 < names.size()) {
+    regexp.push_back('(');
+  }
+  for (size_t iname = 0; iname < names.size(); ++iname) {
+    if (0 < iname) {
+      regexp.push_back('|');
+    }
+    for (const char& c : names[iname]) {
+      if (std::string::npos == std::string(".*+?^$|(){}[]\\").find(c)) {
+        regexp.push_back(c);
+        continue;
+      }
+      /* Escape for the regular expression, where the backslash itself and
+       * the characters substituted by Tcl are escaped again */
+      regexp += "\\\\";
+      if (std::string::npos != std::string("[]$\\").find(c)) {
+        regexp.push_back('\\');
+      }
+      regexp.push_back(c);
+    }
+  }
+  if (1 < names.size()) {
+    regexp.push_back(')');
+  }
+  return regexp;
+}
+
 /********************************************************************
  * Constrain a path between two ports of a module with a given maximum timing
  *value
@@ -115,6 +153,40 @@ void print_pnr_sdc_constrain_max_delay(std::fstream& fp,
   fp << std::endl;
 }
 
+/********************************************************************
+ * Constrain a path between two ports of a module with a maximum timing
+ * value which is already formatted, e.g., when the value is shared by
+ * many paths
+ *******************************************************************/
+void print_pnr_sdc_constrain_max_delay(std::fstream& fp,
+                                       const std::string& src_instance_name,
+                                       const std::string& src_port_name,
+                                       const std::string& des_instance_name,
+                                       const std::string& des_port_name,
+                                       const std::string& delay) {
+  /* Validate file stream */
+  valid_file_stream(fp);
+
+  fp << "set_max_delay";
+
+  fp << " -from ";
+  if (!src_instance_name.empty()) {
+    fp << format_dir_path(src_instance_name);
+  }
+  fp << src_port_name;
+
+  fp << " -to ";
+
+  if (!des_instance_name.empty()) {
+    fp << format_dir_path(des_instance_name);
+  }
+  fp << des_port_name;
+
+  fp << " " << delay;
+
+  fp << std::endl;
+}
+
 /********************************************************************
  * Constrain a path between two ports of a module with a given maximum timing
  *value This function use regular expression and get_pins which are from
@@ -328,7 +400,7 @@ int rec_print_sdc_disable_timing_for_module_ports(
    * (MIB) We will find all the instance names and see there are common prefix
    * If so, we can use wildcards
    */
-  std::map<ModuleId, std::vector<std::string>> wildcard_names;
+  std::map<ModuleId, std::unordered_set<std::string>> wildcard_names;
 
   /* For each child, we will go one level down in priority */
   for (const ModuleId& child_module :
@@ -358,17 +430,12 @@ int rec_print_sdc_disable_timing_for_module_ports(
          *   - output this instance
          *   - record the wildcard name in the map
          */
-        if ((0 < wildcard_names.count(child_module)) &&
-            (wildcard_names.at(child_module).end() !=
-             std::find(wildcard_names.at(child_module).begin(),
-                       wildcard_names.at(child_module).end(),
-                       wildcard_str.data()))) {
+        if (false ==
+            wildcard_names[child_module].insert(wildcard_str.data()).second) {
           continue;
         }
 
         child_module_path += wildcard_str.data();
-
-        wildcard_names[child_module].push_back(wildcard_str.data());
       } else {
         child_module_path += child_instance_name;
       }
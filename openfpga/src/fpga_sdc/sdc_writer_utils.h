@@ -6,6 +6,7 @@
  *******************************************************************/
 #include <fstream>
 #include <string>
+#include <vector>
 
 #include "module_manager.h"
 #include "openfpga_port.h"
@@ -24,6 +25,9 @@ void print_sdc_timescale(std::fstream& fp, const std::string& timescale);
 
 std::string generate_sdc_port(const BasicPort& port);
 
+std::string generate_sdc_regexp_alternatives(
+  const std::vector<std::string>& names);
+
 void print_pnr_sdc_constrain_max_delay(std::fstream& fp,
                                        const std::string& src_instance_name,
                                        const std::string& src_port_name,
@@ -31,6 +35,13 @@ void print_pnr_sdc_constrain_max_delay(std::fstream& fp,
                                        const std::string& des_port_name,
                                        const float& delay);
 
+void print_pnr_sdc_constrain_max_delay(std::fstream& fp,
+                                       const std::string& src_instance_name,
+                                       const std::string& src_port_name,
+                                       const std::string& des_instance_name,
+                                       const std::string& des_port_name,
+                                       const std::string& delay);
+
 void print_pnr_sdc_regexp_constrain_max_delay(
   std::fstream& fp, const std::string& src_instance_name,
   const std::string& src_port_name, const std::string& des_instance_name,
@@ -14,6 +14,7 @@
 #include "openfpga_digest.h"
 #include "openfpga_reserved_words.h"
 #include "spice_auxiliary_netlists.h"
+#include "spice_characterization_testbench.h"
 #include "spice_constants.h"
 #include "spice_grid.h"
 #include "spice_routing.h"
@@ -82,7 +83,8 @@ int fpga_fabric_spice(const ModuleManager& module_manager,
   int status = CMD_EXEC_SUCCESS;
 
   status = print_spice_submodule(netlist_manager, module_manager, openfpga_arch,
-                                 mux_lib, submodule_dir_path);
+                                 mux_lib, submodule_dir_path,
+                                 options.num_threads());
 
   if (CMD_EXEC_SUCCESS != status) {
     return status;
@@ -91,17 +93,19 @@ int fpga_fabric_spice(const ModuleManager& module_manager,
   /* Generate routing blocks */
   if (true == options.compress_routing()) {
     print_spice_unique_routing_modules(netlist_manager, module_manager,
-                                       device_rr_gsb, rr_dir_path);
+                                       device_rr_gsb, rr_dir_path,
+                                       options.num_threads());
   } else {
     VTR_ASSERT(false == options.compress_routing());
     print_spice_flatten_routing_modules(netlist_manager, module_manager,
                                         device_rr_gsb, device_ctx.rr_graph,
-                                        rr_dir_path);
+                                        rr_dir_path, options.num_threads());
   }
 
   /* Generate grids */
   print_spice_grids(netlist_manager, module_manager, device_ctx,
-                    device_annotation, lb_dir_path, options.verbose_output());
+                    device_annotation, lb_dir_path, options.num_threads(),
+                    options.verbose_output());
 
   /* Generate FPGA fabric */
   print_spice_top_module(netlist_manager, module_manager, src_dir_path);
@@ -118,4 +122,34 @@ int fpga_fabric_spice(const ModuleManager& module_manager,
   return CMD_EXEC_SUCCESS;
 }
 
+/********************************************************************
+ * A top-level function of FPGA-SPICE which generates the testbenches to
+ * characterize the routing multiplexers and Look-Up Tables of the fabric
+ * One testbench is generated for each circuit model, which sweeps all the
+ * sizes of the circuit model and all the process corners of the technology
+ * library in a single simulation
+ *
+ * Note:
+ *  - The testbenches include the primitive netlists of the fabric,
+ *    which should have been generated by fpga_fabric_spice()
+ ********************************************************************/
+int fpga_spice_characterization_testbench(const NetlistManager& netlist_manager,
+                                          const ModuleManager& module_manager,
+                                          const Arch& openfpga_arch,
+                                          const MuxLibrary& mux_lib,
+                                          const std::string& output_dir,
+                                          const bool& verbose) {
+  vtr::ScopedStartFinishTimer timer(
+    "Write SPICE characterization testbenches for primitive circuits\n");
+
+  std::string tb_dir_path = format_dir_path(output_dir);
+
+  /* Create directories */
+  create_directory(tb_dir_path);
+
+  return print_spice_characterization_testbenches(
+    netlist_manager, module_manager, openfpga_arch, mux_lib, tb_dir_path,
+    verbose);
+}
+
 } /* end namespace openfpga */
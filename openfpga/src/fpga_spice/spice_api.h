@@ -32,6 +32,13 @@ int fpga_fabric_spice(const ModuleManager& module_manager,
                       const DeviceRRGSB& device_rr_gsb,
                       const FabricSpiceOption& options);
 
+int fpga_spice_characterization_testbench(const NetlistManager& netlist_manager,
+                                          const ModuleManager& module_manager,
+                                          const Arch& openfpga_arch,
+                                          const MuxLibrary& mux_lib,
+                                          const std::string& output_dir,
+                                          const bool& verbose);
+
 } /* end namespace openfpga */
 
 #endif
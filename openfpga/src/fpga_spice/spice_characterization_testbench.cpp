@@ -0,0 +1,505 @@
+/********************************************************************
+ * This file includes functions to generate SPICE testbenches which
+ * characterize the primitive circuits of a FPGA fabric, i.e., the routing
+ * multiplexers and the Look-Up Tables.
+ *
+ * A testbench is created for each circuit model, where
+ * - all the sizes of the circuit model are instanciated as devices under
+ *   test in the same netlist, each of which is driven by its own stimuli
+ * - the configuration memories of the devices under test are swept by a
+ *   .DATA table, e.g., each path of a multiplexer is selected in turn
+ * - the first process corner of the technology library is simulated by
+ *   the main netlist, while each of the other corners is simulated by an
+ *   .ALTER block
+ * As a result, a single simulator run characterizes a family of circuits
+ * under all the process corners.
+ *******************************************************************/
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+
+/* Headers from vtrutil library */
+#include "vtr_assert.h"
+#include "vtr_log.h"
+
+/* Headers from openfpgautil library */
+#include "build_mux_bitstream.h"
+#include "circuit_library_utils.h"
+#include "command_exit_codes.h"
+#include "mux_utils.h"
+#include "openfpga_digest.h"
+#include "openfpga_naming.h"
+#include "openfpga_reserved_words.h"
+#include "spice_characterization_testbench.h"
+#include "spice_constants.h"
+#include "spice_writer_utils.h"
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+/********************************************************************
+ * Local constant variables
+ *******************************************************************/
+/* Name of the parameters which can be overwritten by users */
+constexpr const char* SPICE_TB_VDD_PARAM_NAME = "vdd";
+constexpr const char* SPICE_TB_PERIOD_PARAM_NAME = "tb_period";
+/* Name of the .DATA table sweeping the configuration memories */
+constexpr const char* SPICE_TB_MEM_DATA_NAME = "mem_configs";
+/* Default period of the fastest stimulus, in second */
+constexpr float SPICE_TB_DEFAULT_PERIOD = 1e-9;
+/* The stimuli of the inputs of a device under test form a binary counter,
+ * whose number of bits is limited to keep the simulation time tractable.
+ * Inputs beyond the limit reuse the stimuli of the lower bits */
+constexpr size_t SPICE_TB_MAX_NUM_STIMULUS_BITS = 8;
+
+/********************************************************************
+ * A device under test of a characterization testbench
+ *******************************************************************/
+struct SpiceCharacterizationDut {
+  ModuleId module;
+  /* The configuration memory port to be swept, whose complementary port
+   * '<mem_port_name>_inv' is driven accordingly */
+  std::string mem_port_name;
+  /* The configurations to be applied to the memory port, each of which
+   * is a row of the .DATA table */
+  std::vector<std::vector<bool>> mem_configs;
+};
+
+/********************************************************************
+ * Find the process corners to be characterized, i.e., the transistor
+ * models of the technology library with a unique library and corner.
+ * The corners are sorted in the order of the technology library
+ *******************************************************************/
+static std::vector<TechnologyModelId> find_spice_characterization_corners(
+  const TechnologyLibrary& tech_lib) {
+  std::vector<TechnologyModelId> corners;
+  std::set<std::pair<std::string, std::string>> visited_corners;
+
+  for (const TechnologyModelId& tech_model : tech_lib.models()) {
+    if (TECH_LIB_MODEL_TRANSISTOR != tech_lib.model_type(tech_model)) {
+      continue;
+    }
+    auto result = visited_corners.insert(std::make_pair(
+      tech_lib.model_lib_path(tech_model), tech_lib.model_corner(tech_model)));
+    if (true == result.second) {
+      corners.push_back(tech_model);
+    }
+  }
+
+  return corners;
+}
+
+/********************************************************************
+ * Print the technology library and the supply voltage of a process corner
+ * - An industry library is loaded with a given corner
+ *   .lib "<lib_path>" <corner>
+ * - An academia library is included as a netlist
+ *   .include "<lib_path>"
+ *******************************************************************/
+static void print_spice_characterization_corner(
+  std::fstream& fp, const TechnologyLibrary& tech_lib,
+  const TechnologyModelId& tech_model) {
+  VTR_ASSERT(true == valid_file_stream(fp));
+
+  if (TECH_LIB_INDUSTRY == tech_lib.model_lib_type(tech_model)) {
+    fp << ".lib \"" << tech_lib.model_lib_path(tech_model) << "\" "
+       << tech_lib.model_corner(tech_model) << std::endl;
+  } else {
+    VTR_ASSERT(TECH_LIB_ACADEMIA == tech_lib.model_lib_type(tech_model));
+    print_spice_include_netlist(fp, tech_lib.model_lib_path(tech_model));
+  }
+
+  fp << ".param " << SPICE_TB_VDD_PARAM_NAME << "=" << std::setprecision(10)
+     << tech_lib.model_vdd(tech_model) << std::endl;
+}
+
+/********************************************************************
+ * Generate the name of the net connected to a port of a device under test
+ *******************************************************************/
+static std::string generate_spice_characterization_net_name(
+  const std::string& instance_name, const std::string& port_name) {
+  return instance_name + std::string("_") + port_name;
+}
+
+/********************************************************************
+ * Generate the name of the parameter setting a memory bit of a device under
+ * test, which is a column of the .DATA table
+ *******************************************************************/
+static std::string generate_spice_characterization_mem_param_name(
+  const std::string& instance_name, const std::string& port_name,
+  const size_t& pin) {
+  return generate_spice_characterization_net_name(instance_name, port_name) +
+         std::string("_") + std::to_string(pin);
+}
+
+/********************************************************************
+ * Print a device under test, whose ports are connected to the nets
+ * '<instance_name>_<port_name>', and the stimuli driving its inputs
+ * - The memory port to be swept is driven by the parameters of the .DATA
+ *   table, while its complementary port is driven by the inverted values
+ * - Other configuration memories, i.e., ports with a complementary port,
+ *   are tied to logic '0'
+ * - Global ports are tied to logic '0'
+ * - Any other input pin is driven by a pulse whose period doubles from
+ *   one pin to the next one, so that the inputs go through all the
+ *   combinations of a binary counter:
+ *   V<net> <net> 0 PULSE(0 'vdd' <delay> <rise> <fall> <width> <period>)
+ *
+ * Return the number of stimulus periods required by the device
+ *******************************************************************/
+static size_t print_spice_characterization_dut(
+  std::fstream& fp, const ModuleManager& module_manager,
+  const SpiceCharacterizationDut& dut, const std::string& instance_name) {
+  VTR_ASSERT(true == valid_file_stream(fp));
+
+  std::map<std::string, BasicPort> port2port_name_map;
+  for (const ModulePortId& port_id :
+       module_manager.module_ports(dut.module)) {
+    BasicPort port = module_manager.module_port(dut.module, port_id);
+    port2port_name_map[port.get_name()] =
+      BasicPort(generate_spice_characterization_net_name(instance_name,
+                                                         port.get_name()),
+                port.get_width());
+  }
+
+  print_spice_comment(fp, std::string("Device under test: " +
+                                      module_manager.module_name(dut.module)));
+  print_spice_subckt_instance(fp, module_manager, dut.module, instance_name,
+                              port2port_name_map);
+
+  size_t num_stimulus_pins = 0;
+  size_t stimulus_bit = 0;
+  for (int port_type = ModuleManager::MODULE_GLOBAL_PORT;
+       port_type < ModuleManager::NUM_MODULE_PORT_TYPES; ++port_type) {
+    /* Outputs are left to be probed */
+    if ((ModuleManager::MODULE_OUTPUT_PORT == port_type) ||
+        (ModuleManager::MODULE_GPOUT_PORT == port_type)) {
+      continue;
+    }
+    for (const BasicPort& port : module_manager.module_ports_by_type(
+           dut.module,
+           static_cast<ModuleManager::e_module_port_type>(port_type))) {
+      const BasicPort& net = port2port_name_map.at(port.get_name());
+      /* Complementary memory ports are driven with their memory ports */
+      std::string mem_port_name = port.get_name();
+      bool inverted = false;
+      size_t inv_postfix_length = std::string(INV_PORT_POSTFIX).length();
+      if ((mem_port_name.length() > inv_postfix_length) &&
+          (0 == mem_port_name.compare(
+                  mem_port_name.length() - inv_postfix_length,
+                  inv_postfix_length, INV_PORT_POSTFIX))) {
+        mem_port_name.resize(mem_port_name.length() - inv_postfix_length);
+        inverted = true;
+      }
+      bool is_mem_port =
+        (true == inverted) ||
+        (ModulePortId::INVALID() !=
+         module_manager.find_module_port(
+           dut.module, port.get_name() + std::string(INV_PORT_POSTFIX)));
+
+      for (const size_t& pin : net.pins()) {
+        std::string net_pin = generate_spice_port(
+          BasicPort(net.get_name(), pin, pin), 1 == net.get_width());
+        fp << "V" << net_pin << " " << net_pin << " 0 ";
+        if ((true == is_mem_port) && (mem_port_name == dut.mem_port_name)) {
+          std::string param = generate_spice_characterization_mem_param_name(
+            instance_name, mem_port_name, pin);
+          if (true == inverted) {
+            param = "(1-" + param + ")";
+          }
+          fp << "'" << param << "*" << SPICE_TB_VDD_PARAM_NAME << "'";
+        } else if (true == is_mem_port) {
+          fp << "'" << (true == inverted ? SPICE_TB_VDD_PARAM_NAME : "0")
+             << "'";
+        } else if (ModuleManager::MODULE_GLOBAL_PORT == port_type) {
+          fp << "0";
+        } else {
+          /* The pulse is high during half of its period */
+          size_t num_half_periods = size_t(1) << stimulus_bit;
+          fp << "PULSE(0 '" << SPICE_TB_VDD_PARAM_NAME << "' '"
+             << num_half_periods << "*" << SPICE_TB_PERIOD_PARAM_NAME
+             << "' '0.01*" << SPICE_TB_PERIOD_PARAM_NAME << "' '0.01*"
+             << SPICE_TB_PERIOD_PARAM_NAME << "' '" << num_half_periods << "*"
+             << SPICE_TB_PERIOD_PARAM_NAME << "' '" << 2 * num_half_periods
+             << "*" << SPICE_TB_PERIOD_PARAM_NAME << "')";
+          stimulus_bit = (stimulus_bit + 1) % SPICE_TB_MAX_NUM_STIMULUS_BITS;
+          num_stimulus_pins++;
+        }
+        fp << std::endl;
+      }
+    }
+  }
+  fp << std::endl;
+
+  /* All the combinations are visited once the slowest pulse goes through
+   * a full period */
+  size_t num_bits =
+    std::min(num_stimulus_pins, SPICE_TB_MAX_NUM_STIMULUS_BITS);
+  return size_t(1) << num_bits;
+}
+
+/********************************************************************
+ * Print the .DATA table which sweeps the memory configurations of all the
+ * devices under test. A row applies a configuration to each device, while
+ * the devices with fewer configurations repeat their last one
+ *   .DATA mem_configs
+ *   + <param> <param> ...
+ *   + <value> <value> ...
+ *   .ENDDATA
+ *******************************************************************/
+static void print_spice_characterization_mem_data(
+  std::fstream& fp, const ModuleManager& module_manager,
+  const std::vector<SpiceCharacterizationDut>& duts,
+  const std::vector<std::string>& instance_names) {
+  VTR_ASSERT(true == valid_file_stream(fp));
+  VTR_ASSERT(duts.size() == instance_names.size());
+
+  size_t num_rows = 0;
+  std::vector<std::string> params;
+  for (size_t idut = 0; idut < duts.size(); ++idut) {
+    num_rows = std::max(num_rows, duts[idut].mem_configs.size());
+    ModulePortId mem_port_id = module_manager.find_module_port(
+      duts[idut].module, duts[idut].mem_port_name);
+    VTR_ASSERT(ModulePortId::INVALID() != mem_port_id);
+    BasicPort mem_port =
+      module_manager.module_port(duts[idut].module, mem_port_id);
+    for (const size_t& pin : mem_port.pins()) {
+      params.push_back(generate_spice_characterization_mem_param_name(
+        instance_names[idut], mem_port.get_name(), pin));
+    }
+  }
+
+  print_spice_comment(fp, std::string("Configurations of the memories"));
+  fp << ".DATA " << SPICE_TB_MEM_DATA_NAME;
+  for (size_t iparam = 0; iparam < params.size(); ++iparam) {
+    if (0 == iparam % SPICE_NETLIST_MAX_NUM_PORTS_PER_LINE) {
+      fp << std::endl << "+";
+    }
+    fp << " " << params[iparam];
+  }
+  fp << std::endl;
+
+  for (size_t irow = 0; irow < num_rows; ++irow) {
+    size_t num_values = 0;
+    for (const SpiceCharacterizationDut& dut : duts) {
+      const std::vector<bool>& config =
+        dut.mem_configs[std::min(irow, dut.mem_configs.size() - 1)];
+      for (const bool& bit : config) {
+        if (0 == num_values % SPICE_NETLIST_MAX_NUM_PORTS_PER_LINE) {
+          if (0 != num_values) {
+            fp << std::endl;
+          }
+          fp << "+";
+        }
+        fp << " " << (true == bit ? "1" : "0");
+        num_values++;
+      }
+    }
+    VTR_ASSERT(params.size() == num_values);
+    fp << std::endl;
+  }
+  fp << ".ENDDATA" << std::endl;
+  fp << std::endl;
+}
+
+/********************************************************************
+ * Print a testbench characterizing a circuit model, where all the given
+ * devices, i.e., the sizes of the circuit model, are instanciated.
+ * The first process corner is simulated by the main netlist, while the
+ * others are swept by .ALTER blocks
+ *******************************************************************/
+static int print_spice_characterization_testbench(
+  const NetlistManager& netlist_manager, const ModuleManager& module_manager,
+  const CircuitLibrary& circuit_lib, const TechnologyLibrary& tech_lib,
+  const std::vector<TechnologyModelId>& corners,
+  const CircuitModelId& circuit_model,
+  const std::vector<SpiceCharacterizationDut>& duts,
+  const std::string& tb_dir, const bool& verbose) {
+  std::string spice_fname = tb_dir + circuit_lib.model_name(circuit_model) +
+                            std::string(SPICE_CHARACTERIZATION_TB_FILE_POSTFIX);
+
+  VTR_LOGV(verbose,
+           "Writing SPICE characterization testbench for circuit model "
+           "'%s' with %lu sizes and %lu corners to '%s'...",
+           circuit_lib.model_name(circuit_model).c_str(), duts.size(),
+           corners.size(), spice_fname.c_str());
+
+  /* Create the file stream */
+  std::fstream fp;
+  fp.open(spice_fname, std::fstream::out | std::fstream::trunc);
+
+  check_file_stream(spice_fname.c_str(), fp);
+
+  print_spice_file_header(
+    fp, std::string("Characterization testbench for circuit model '" +
+                    circuit_lib.model_name(circuit_model) + "'"));
+
+  /* Include the netlists of the primitive modules, which are enough to model
+   * any device under test */
+  print_spice_comment(fp, std::string("Include user-defined netlists"));
+  for (const std::string& user_defined_netlist :
+       find_circuit_library_unique_spice_netlists(circuit_lib)) {
+    print_spice_include_netlist(fp, user_defined_netlist);
+  }
+  print_spice_comment(fp, std::string("Include primitive module netlists"));
+  for (const NetlistId& nlist_id :
+       netlist_manager.netlists_by_type(NetlistManager::SUBMODULE_NETLIST)) {
+    print_spice_include_netlist(fp, netlist_manager.netlist_name(nlist_id));
+  }
+  fp << std::endl;
+
+  print_spice_comment(fp, std::string("Process corner: " +
+                                      tech_lib.model_name(corners[0])));
+  print_spice_characterization_corner(fp, tech_lib, corners[0]);
+  fp << ".param " << SPICE_TB_PERIOD_PARAM_NAME << "=" << std::setprecision(10)
+     << SPICE_TB_DEFAULT_PERIOD << std::endl;
+  fp << std::endl;
+
+  /* Supplies are shared by all the devices under test */
+  print_spice_comment(fp, std::string("Power supplies"));
+  fp << "V" << SPICE_SUBCKT_VDD_PORT_NAME << " " << SPICE_SUBCKT_VDD_PORT_NAME
+     << " 0 '" << SPICE_TB_VDD_PARAM_NAME << "'" << std::endl;
+  fp << "V" << SPICE_SUBCKT_GND_PORT_NAME << " " << SPICE_SUBCKT_GND_PORT_NAME
+     << " 0 0" << std::endl;
+  fp << std::endl;
+
+  std::vector<std::string> instance_names;
+  size_t num_periods = 1;
+  for (const SpiceCharacterizationDut& dut : duts) {
+    instance_names.push_back(module_manager.module_name(dut.module) +
+                             std::string("_dut"));
+    num_periods = std::max(
+      num_periods, print_spice_characterization_dut(fp, module_manager, dut,
+                                                    instance_names.back()));
+  }
+
+  print_spice_characterization_mem_data(fp, module_manager, duts,
+                                        instance_names);
+
+  print_spice_comment(fp, std::string("Simulation settings"));
+  fp << ".option post" << std::endl;
+  fp << ".tran '0.01*" << SPICE_TB_PERIOD_PARAM_NAME << "' '" << num_periods
+     << "*" << SPICE_TB_PERIOD_PARAM_NAME << "' sweep DATA="
+     << SPICE_TB_MEM_DATA_NAME << std::endl;
+  fp << ".measure tran avg_supply_current avg I(V"
+     << SPICE_SUBCKT_VDD_PORT_NAME << ")" << std::endl;
+  fp << std::endl;
+
+  /* Sweep the other process corners */
+  for (size_t icorner = 1; icorner < corners.size(); ++icorner) {
+    fp << ".alter " << tech_lib.model_name(corners[icorner]) << std::endl;
+    print_spice_characterization_corner(fp, tech_lib, corners[icorner]);
+    fp << std::endl;
+  }
+
+  fp << ".end" << std::endl;
+
+  /* Close the file stream */
+  fp.close();
+
+  VTR_LOGV(verbose, "Done\n");
+
+  return CMD_EXEC_SUCCESS;
+}
+
+/********************************************************************
+ * Generate a SPICE characterization testbench for each unique
+ * routing multiplexer and Look-Up Table circuit model
+ * - The testbench of a multiplexer model contains all its sizes found in
+ *   the multiplexer library, whose paths are selected in turn
+ * - The testbench of a LUT model contains the LUT, which is configured
+ *   as a buffer of each of its inputs in turn
+ *
+ * Note:
+ * - This function should be called only after the primitive modules have
+ *   been written, as the testbenches include their netlists
+ *******************************************************************/
+int print_spice_characterization_testbenches(
+  const NetlistManager& netlist_manager, const ModuleManager& module_manager,
+  const Arch& openfpga_arch, const MuxLibrary& mux_lib,
+  const std::string& tb_dir, const bool& verbose) {
+  const CircuitLibrary& circuit_lib = openfpga_arch.circuit_lib;
+  const TechnologyLibrary& tech_lib = openfpga_arch.tech_lib;
+
+  std::vector<TechnologyModelId> corners =
+    find_spice_characterization_corners(tech_lib);
+  if (true == corners.empty()) {
+    VTR_LOG_ERROR(
+      "No transistor model is defined in the technology library to "
+      "characterize circuits!\n");
+    return CMD_EXEC_FATAL_ERROR;
+  }
+
+  /* Collect the devices under test for each circuit model, in the order of
+   * the circuit library */
+  std::map<CircuitModelId, std::vector<SpiceCharacterizationDut>> model_duts;
+  for (auto mux : mux_lib.muxes()) {
+    const MuxGraph& mux_graph = mux_lib.mux_graph(mux);
+    CircuitModelId mux_model = mux_lib.mux_circuit_model(mux);
+    /* Only CMOS multiplexers are modeled by the primitive netlists */
+    if (CIRCUIT_MODEL_DESIGN_CMOS != circuit_lib.design_tech_type(mux_model)) {
+      continue;
+    }
+    size_t mux_size = find_mux_num_datapath_inputs(circuit_lib, mux_model,
+                                                   mux_graph.num_inputs());
+    SpiceCharacterizationDut dut;
+    dut.module = module_manager.find_module(generate_mux_subckt_name(
+      circuit_lib, mux_model, mux_size, std::string("")));
+    VTR_ASSERT(true == module_manager.valid_module_id(dut.module));
+    std::vector<CircuitPortId> mux_sram_ports =
+      find_circuit_regular_sram_ports(circuit_lib, mux_model);
+    VTR_ASSERT(1 == mux_sram_ports.size());
+    dut.mem_port_name = circuit_lib.port_prefix(mux_sram_ports[0]);
+    /* Select each path of the multiplexer */
+    for (size_t path_id = 0; path_id < mux_size; ++path_id) {
+      dut.mem_configs.push_back(build_mux_bitstream(
+        circuit_lib, mux_model, mux_lib, mux_size, path_id));
+    }
+    model_duts[mux_model].push_back(dut);
+  }
+  for (const CircuitModelId& lut_model :
+       circuit_lib.models_by_type(CIRCUIT_MODEL_LUT)) {
+    SpiceCharacterizationDut dut;
+    dut.module = module_manager.find_module(circuit_lib.model_name(lut_model));
+    VTR_ASSERT(true == module_manager.valid_module_id(dut.module));
+    std::vector<CircuitPortId> lut_sram_ports =
+      find_circuit_regular_sram_ports(circuit_lib, lut_model);
+    VTR_ASSERT(1 == lut_sram_ports.size());
+    dut.mem_port_name = circuit_lib.port_prefix(lut_sram_ports[0]);
+    /* Configure the LUT as a buffer of each input, i.e., the output is the
+     * bit <ipin> of the address */
+    size_t num_mems = circuit_lib.port_size(lut_sram_ports[0]);
+    for (size_t ipin = 0; (size_t(1) << ipin) < num_mems; ++ipin) {
+      std::vector<bool> config(num_mems, false);
+      for (size_t addr = 0; addr < num_mems; ++addr) {
+        config[addr] = (1 == ((addr >> ipin) & 1));
+      }
+      dut.mem_configs.push_back(config);
+    }
+    if (true == dut.mem_configs.empty()) {
+      dut.mem_configs.push_back(std::vector<bool>(num_mems, false));
+    }
+    model_duts[lut_model].push_back(dut);
+  }
+
+  int status = CMD_EXEC_SUCCESS;
+  for (const auto& kv : model_duts) {
+    status = print_spice_characterization_testbench(
+      netlist_manager, module_manager, circuit_lib, tech_lib, corners, kv.first,
+      kv.second, tb_dir, verbose);
+    if (CMD_EXEC_SUCCESS != status) {
+      break;
+    }
+  }
+
+  VTR_LOG("Written %lu SPICE characterization testbenches\n",
+          model_duts.size());
+
+  return status;
+}
+
+} /* end namespace openfpga */
@@ -0,0 +1,28 @@
+#ifndef SPICE_CHARACTERIZATION_TESTBENCH_H
+#define SPICE_CHARACTERIZATION_TESTBENCH_H
+
+/********************************************************************
+ * Include header files that are required by function declaration
+ *******************************************************************/
+#include <string>
+
+#include "module_manager.h"
+#include "mux_library.h"
+#include "netlist_manager.h"
+#include "openfpga_arch.h"
+
+/********************************************************************
+ * Function declaration
+ *******************************************************************/
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+int print_spice_characterization_testbenches(
+  const NetlistManager& netlist_manager, const ModuleManager& module_manager,
+  const Arch& openfpga_arch, const MuxLibrary& mux_lib,
+  const std::string& tb_dir, const bool& verbose);
+
+} /* end namespace openfpga */
+
+#endif
@@ -4,6 +4,10 @@
 /* global parameters for dumping spice netlists */
 constexpr size_t SPICE_NETLIST_MAX_NUM_PORTS_PER_LINE = 10;
 
+/* Size of the output buffer of the SPICE subckt writer, in bytes. The
+ * buffer is written to the file stream once its content exceeds the size */
+constexpr size_t SPICE_WRITER_BUFFER_SIZE = 1 << 16;
+
 constexpr const char* SPICE_NETLIST_FILE_POSTFIX = ".sp";
 
 constexpr const char* TRANSISTOR_WRAPPER_POSTFIX = "_wrapper";
@@ -16,6 +20,8 @@ constexpr const char* LUTS_SPICE_FILE_NAME = "luts.sp";
 constexpr const char* MEMORIES_SPICE_FILE_NAME = "memories.sp";
 constexpr const char* FABRIC_INCLUDE_SPICE_NETLIST_FILE_NAME =
   "fabric_netlists.sp";
+constexpr const char* SPICE_CHARACTERIZATION_TB_FILE_POSTFIX =
+  "_characterization_tb.sp";
 
 constexpr const char* SPICE_SUBCKT_VDD_PORT_NAME = "VDD";
 constexpr const char* SPICE_SUBCKT_GND_PORT_NAME = "VSS";
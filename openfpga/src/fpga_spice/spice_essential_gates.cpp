@@ -79,7 +79,8 @@ static void print_spice_supply_wrapper_subckt(
  *******************************************************************/
 int print_spice_supply_wrappers(NetlistManager& netlist_manager,
                                 const ModuleManager& module_manager,
-                                const std::string& submodule_dir) {
+                                const std::string& submodule_dir,
+                                const bool& show_progress) {
   int status = CMD_EXEC_SUCCESS;
 
   /* Create file stream */
@@ -94,8 +95,9 @@ int print_spice_supply_wrappers(NetlistManager& netlist_manager,
   check_file_stream(spice_fname.c_str(), fp);
 
   /* Create file */
-  VTR_LOG("Generating SPICE netlist '%s' for voltage supply wrappers...",
-          spice_fname.c_str());
+  VTR_LOGV(show_progress,
+           "Generating SPICE netlist '%s' for voltage supply wrappers...",
+           spice_fname.c_str());
 
   print_spice_file_header(fp, std::string("Voltage Supply Wrappers"));
 
@@ -112,7 +114,7 @@ int print_spice_supply_wrappers(NetlistManager& netlist_manager,
   VTR_ASSERT(NetlistId::INVALID() != nlist_id);
   netlist_manager.set_netlist_type(nlist_id, NetlistManager::SUBMODULE_NETLIST);
 
-  VTR_LOG("Done\n");
+  VTR_LOGV(show_progress, "Done\n");
 
   return status;
 }
@@ -128,7 +130,7 @@ int print_spice_essential_gates(
   NetlistManager& netlist_manager, const ModuleManager& module_manager,
   const CircuitLibrary& circuit_lib, const TechnologyLibrary& tech_lib,
   const std::map<CircuitModelId, TechnologyModelId>& circuit_tech_binding,
-  const std::string& submodule_dir) {
+  const std::string& submodule_dir, const bool& show_progress) {
   int status = CMD_EXEC_SUCCESS;
 
   /* Iterate over the circuit models */
@@ -183,8 +185,10 @@ int print_spice_essential_gates(
     check_file_stream(spice_fname.c_str(), fp);
 
     /* Create file */
-    VTR_LOG("Generating SPICE netlist '%s' for circuit model '%s'...",
-            spice_fname.c_str(), circuit_lib.model_name(circuit_model).c_str());
+    VTR_LOGV(show_progress,
+             "Generating SPICE netlist '%s' for circuit model '%s'...",
+             spice_fname.c_str(),
+             circuit_lib.model_name(circuit_model).c_str());
 
     print_spice_file_header(fp, circuit_lib.model_name(circuit_model));
 
@@ -276,7 +280,7 @@ int print_spice_essential_gates(
     netlist_manager.set_netlist_type(nlist_id,
                                      NetlistManager::SUBMODULE_NETLIST);
 
-    VTR_LOG("Done\n");
+    VTR_LOGV(show_progress, "Done\n");
   }
 
   return status;
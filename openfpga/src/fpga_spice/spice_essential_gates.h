@@ -21,13 +21,14 @@ namespace openfpga {
 
 int print_spice_supply_wrappers(NetlistManager& netlist_manager,
                                 const ModuleManager& module_manager,
-                                const std::string& submodule_dir);
+                                const std::string& submodule_dir,
+                                const bool& show_progress);
 
 int print_spice_essential_gates(
   NetlistManager& netlist_manager, const ModuleManager& module_manager,
   const CircuitLibrary& circuit_lib, const TechnologyLibrary& tech_lib,
   const std::map<CircuitModelId, TechnologyModelId>& circuit_tech_binding,
-  const std::string& submodule_dir);
+  const std::string& submodule_dir, const bool& show_progress);
 
 } /* end namespace openfpga */
 
@@ -16,6 +16,7 @@
 
 /* Headers from openfpgautil library */
 #include "openfpga_digest.h"
+#include "openfpga_parallel.h"
 #include "openfpga_side_manager.h"
 
 /* Headers from vpr library */
@@ -64,7 +65,7 @@ namespace openfpga {
 static void print_spice_primitive_block(
   NetlistManager& netlist_manager, const ModuleManager& module_manager,
   const std::string& subckt_dir, t_pb_graph_node* primitive_pb_graph_node,
-  const bool& verbose) {
+  const bool& verbose, const bool& show_progress) {
   /* Ensure a valid pb_graph_node */
   if (nullptr == primitive_pb_graph_node) {
     VTR_LOGF_ERROR(__FILE__, __LINE__, "Invalid primitive_pb_graph_node!\n");
@@ -78,8 +79,9 @@ static void print_spice_primitive_block(
                             std::string(), primitive_pb_graph_node,
                             std::string(SPICE_NETLIST_FILE_POSTFIX)));
 
-  VTR_LOG("Writing SPICE netlist '%s' for primitive pb_type '%s' ...",
-          spice_fname.c_str(), primitive_pb_graph_node->pb_type->name);
+  VTR_LOGV(show_progress,
+           "Writing SPICE netlist '%s' for primitive pb_type '%s' ...",
+           spice_fname.c_str(), primitive_pb_graph_node->pb_type->name);
   VTR_LOGV(verbose, "\n");
 
   /* Create the file stream */
@@ -139,7 +141,8 @@ static void print_spice_primitive_block(
 static void rec_print_spice_logical_tile(
   NetlistManager& netlist_manager, const ModuleManager& module_manager,
   const VprDeviceAnnotation& device_annotation, const std::string& subckt_dir,
-  t_pb_graph_node* physical_pb_graph_node, const bool& verbose) {
+  t_pb_graph_node* physical_pb_graph_node, const bool& verbose,
+  const bool& show_progress) {
   /* Check cur_pb_graph_node*/
   if (nullptr == physical_pb_graph_node) {
     VTR_LOGF_ERROR(__FILE__, __LINE__, "Invalid physical_pb_graph_node\n");
@@ -162,7 +165,7 @@ static void rec_print_spice_logical_tile(
         netlist_manager, module_manager, device_annotation, subckt_dir,
         &(physical_pb_graph_node
             ->child_pb_graph_nodes[physical_mode->index][ipb][0]),
-        verbose);
+        verbose, show_progress);
     }
   }
 
@@ -172,7 +175,7 @@ static void rec_print_spice_logical_tile(
    */
   if (true == is_primitive_pb_type(physical_pb_type)) {
     print_spice_primitive_block(netlist_manager, module_manager, subckt_dir,
-                                physical_pb_graph_node, verbose);
+                                physical_pb_graph_node, verbose, show_progress);
     /* Finish for primitive node, return */
     return;
   }
@@ -184,8 +187,8 @@ static void rec_print_spice_logical_tile(
                             std::string(), physical_pb_graph_node,
                             std::string(SPICE_NETLIST_FILE_POSTFIX)));
 
-  VTR_LOG("Writing SPICE netlist '%s' for pb_type '%s' ...",
-          spice_fname.c_str(), physical_pb_type->name);
+  VTR_LOGV(show_progress, "Writing SPICE netlist '%s' for pb_type '%s' ...",
+           spice_fname.c_str(), physical_pb_type->name);
   VTR_LOGV(verbose, "\n");
 
   /* Create the file stream */
@@ -239,10 +242,11 @@ static void rec_print_spice_logical_tile(
 static void print_spice_logical_tile_netlist(
   NetlistManager& netlist_manager, const ModuleManager& module_manager,
   const VprDeviceAnnotation& device_annotation, const std::string& subckt_dir,
-  t_pb_graph_node* pb_graph_head, const bool& verbose) {
-  VTR_LOG("Writing Verilog netlists for logic tile '%s' ...",
-          pb_graph_head->pb_type->name);
-  VTR_LOG("\n");
+  t_pb_graph_node* pb_graph_head, const bool& verbose,
+  const bool& show_progress) {
+  VTR_LOGV(show_progress, "Writing Verilog netlists for logic tile '%s' ...",
+           pb_graph_head->pb_type->name);
+  VTR_LOGV(show_progress, "\n");
 
   /* Print SPICE subckts for all the pb_types/pb_graph_nodes
    * use a Depth-First Search Algorithm to print the sub-modules
@@ -254,10 +258,10 @@ static void print_spice_logical_tile_netlist(
    * traverse the graph in a recursive way */
   rec_print_spice_logical_tile(netlist_manager, module_manager,
                                device_annotation, subckt_dir, pb_graph_head,
-                               verbose);
+                               verbose, show_progress);
 
-  VTR_LOG("Done\n");
-  VTR_LOG("\n");
+  VTR_LOGV(show_progress, "Done\n");
+  VTR_LOGV(show_progress, "\n");
 }
 
 /*****************************************************************************
@@ -271,7 +275,7 @@ static void print_spice_logical_tile_netlist(
 static void print_spice_physical_tile_netlist(
   NetlistManager& netlist_manager, const ModuleManager& module_manager,
   const std::string& subckt_dir, t_physical_tile_type_ptr phy_block_type,
-  const e_side& border_side) {
+  const e_side& border_side, const bool& show_progress) {
   /* Check code: if this is an IO block, the border side MUST be valid */
   if (true == is_io_type(phy_block_type)) {
     VTR_ASSERT(NUM_SIDES != border_side);
@@ -289,11 +293,13 @@ static void print_spice_physical_tile_netlist(
   /* Echo status */
   if (true == is_io_type(phy_block_type)) {
     SideManager side_manager(border_side);
-    VTR_LOG("Writing SPICE Netlist '%s' for physical tile '%s' at %s side ...",
-            spice_fname.c_str(), phy_block_type->name, side_manager.c_str());
+    VTR_LOGV(show_progress,
+             "Writing SPICE Netlist '%s' for physical tile '%s' at %s side ...",
+             spice_fname.c_str(), phy_block_type->name, side_manager.c_str());
   } else {
-    VTR_LOG("Writing SPICE Netlist '%s' for physical_tile '%s'...",
-            spice_fname.c_str(), phy_block_type->name);
+    VTR_LOGV(show_progress,
+             "Writing SPICE Netlist '%s' for physical_tile '%s'...",
+             spice_fname.c_str(), phy_block_type->name);
   }
 
   /* Create the file stream */
@@ -334,7 +340,7 @@ static void print_spice_physical_tile_netlist(
   netlist_manager.set_netlist_type(nlist_id,
                                    NetlistManager::LOGIC_BLOCK_NETLIST);
 
-  VTR_LOG("Done\n");
+  VTR_LOGV(show_progress, "Done\n");
 }
 
 /*****************************************************************************
@@ -347,10 +353,13 @@ void print_spice_grids(NetlistManager& netlist_manager,
                        const ModuleManager& module_manager,
                        const DeviceContext& device_ctx,
                        const VprDeviceAnnotation& device_annotation,
-                       const std::string& subckt_dir, const bool& verbose) {
-  /* Create a vector to contain all the Verilog netlist names that have been
-   * generated in this function */
-  std::vector<std::string> netlist_names;
+                       const std::string& subckt_dir,
+                       const size_t& num_threads, const bool& verbose) {
+  /* Each module is written to a separated netlist while the module manager is
+   * only read, so the netlists can be written by a pool of threads. Progress
+   * is only reported when a single thread is used, to avoid interleaved logs
+   */
+  bool show_progress = (1 == find_num_threads(num_threads));
 
   /* Enumerate the types of logical tiles, and build a module for each
    * Write modules for all the pb_types/pb_graph_nodes
@@ -360,16 +369,28 @@ void print_spice_grids(NetlistManager& netlist_manager,
    * to its parent in module manager
    */
   VTR_LOG("Writing logical tiles...");
-  VTR_LOGV(verbose, "\n");
+  VTR_LOGV(verbose && show_progress, "\n");
+  std::vector<t_pb_graph_node*> pb_graph_heads;
   for (const t_logical_block_type& logical_tile :
        device_ctx.logical_block_types) {
     /* Bypass empty pb_graph */
     if (nullptr == logical_tile.pb_graph_head) {
       continue;
     }
-    print_spice_logical_tile_netlist(netlist_manager, module_manager,
-                                     device_annotation, subckt_dir,
-                                     logical_tile.pb_graph_head, verbose);
+    pb_graph_heads.push_back(logical_tile.pb_graph_head);
+  }
+  /* Each task registers its netlists in its own netlist manager. They are
+   * imported in the order of the tasks, as a single thread does */
+  std::vector<NetlistManager> logical_tile_netlists(pb_graph_heads.size());
+  parallel_for(
+    pb_graph_heads.size(), num_threads, [&](const size_t& itile) {
+      print_spice_logical_tile_netlist(
+        logical_tile_netlists[itile], module_manager, device_annotation,
+        subckt_dir, pb_graph_heads[itile], verbose && show_progress,
+        show_progress);
+    });
+  for (const NetlistManager& netlists : logical_tile_netlists) {
+    netlist_manager.import_netlists(netlists);
   }
   VTR_LOG("Writing logical tiles...");
   VTR_LOG("Done\n");
@@ -380,7 +401,8 @@ void print_spice_grids(NetlistManager& netlist_manager,
    * Use the logical tile module to build the physical tiles
    */
   VTR_LOG("Building physical tiles...");
-  VTR_LOGV(verbose, "\n");
+  VTR_LOGV(verbose && show_progress, "\n");
+  std::vector<std::pair<t_physical_tile_type_ptr, e_side>> physical_tiles;
   for (const t_physical_tile_type& physical_tile :
        device_ctx.physical_tile_types) {
     /* Bypass empty type or nullptr */
@@ -399,31 +421,28 @@ void print_spice_grids(NetlistManager& netlist_manager,
       std::set<e_side> io_type_sides =
         find_physical_io_tile_located_sides(device_ctx.grid, &physical_tile);
       for (const e_side& io_type_side : io_type_sides) {
-        print_spice_physical_tile_netlist(netlist_manager, module_manager,
-                                          subckt_dir, &physical_tile,
-                                          io_type_side);
+        physical_tiles.push_back(std::make_pair(&physical_tile, io_type_side));
       }
       continue;
     } else {
       /* For CLB and heterogenenous blocks */
-      print_spice_physical_tile_netlist(netlist_manager, module_manager,
-                                        subckt_dir, &physical_tile, NUM_SIDES);
+      physical_tiles.push_back(std::make_pair(&physical_tile, NUM_SIDES));
     }
   }
+  std::vector<NetlistManager> physical_tile_netlists(physical_tiles.size());
+  parallel_for(
+    physical_tiles.size(), num_threads, [&](const size_t& itile) {
+      print_spice_physical_tile_netlist(
+        physical_tile_netlists[itile], module_manager, subckt_dir,
+        physical_tiles[itile].first, physical_tiles[itile].second,
+        show_progress);
+    });
+  for (const NetlistManager& netlists : physical_tile_netlists) {
+    netlist_manager.import_netlists(netlists);
+  }
   VTR_LOG("Building physical tiles...");
   VTR_LOG("Done\n");
   VTR_LOG("\n");
-
-  /* Output a header file for all the logic blocks */
-  /*
-  std::string grid_spice_fname(LOGIC_BLOCK_VERILOG_FILE_NAME);
-  VTR_LOG("Writing header file for grid SPICE subckts '%s' ...",
-          grid_spice_fname.c_str());
-  print_spice_netlist_include_header_file(netlist_names,
-                                          subckt_dir.c_str(),
-                                          grid_spice_fname.c_str());
-  VTR_LOG("Done\n");
-   */
 }
 
 } /* end namespace openfpga */
@@ -32,7 +32,8 @@ namespace openfpga {
 int print_spice_submodule_luts(NetlistManager& netlist_manager,
                                const ModuleManager& module_manager,
                                const CircuitLibrary& circuit_lib,
-                               const std::string& submodule_dir) {
+                               const std::string& submodule_dir,
+                               const bool& show_progress) {
   int status = CMD_EXEC_SUCCESS;
 
   std::string spice_fname = submodule_dir + std::string(LUTS_SPICE_FILE_NAME);
@@ -45,7 +46,8 @@ int print_spice_submodule_luts(NetlistManager& netlist_manager,
   check_file_stream(spice_fname.c_str(), fp);
 
   /* Create file */
-  VTR_LOG("Writing SPICE netlist for LUTs '%s'...", spice_fname.c_str());
+  VTR_LOGV(show_progress, "Writing SPICE netlist for LUTs '%s'...",
+           spice_fname.c_str());
 
   print_spice_file_header(fp, "Look-Up Tables");
 
@@ -71,7 +73,7 @@ int print_spice_submodule_luts(NetlistManager& netlist_manager,
   VTR_ASSERT(NetlistId::INVALID() != nlist_id);
   netlist_manager.set_netlist_type(nlist_id, NetlistManager::SUBMODULE_NETLIST);
 
-  VTR_LOG("Done\n");
+  VTR_LOGV(show_progress, "Done\n");
 
   return status;
 }
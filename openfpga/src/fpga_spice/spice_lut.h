@@ -21,7 +21,8 @@ namespace openfpga {
 int print_spice_submodule_luts(NetlistManager& netlist_manager,
                                const ModuleManager& module_manager,
                                const CircuitLibrary& circuit_lib,
-                               const std::string& submodule_dir);
+                               const std::string& submodule_dir,
+                               const bool& show_progress);
 
 } /* end namespace openfpga */
 
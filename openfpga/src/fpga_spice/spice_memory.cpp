@@ -99,7 +99,8 @@ int print_spice_submodule_memories(NetlistManager& netlist_manager,
                                    const ModuleManager& module_manager,
                                    const MuxLibrary& mux_lib,
                                    const CircuitLibrary& circuit_lib,
-                                   const std::string& submodule_dir) {
+                                   const std::string& submodule_dir,
+                                   const bool& show_progress) {
   int status = CMD_EXEC_SUCCESS;
 
   /* Plug in with the mux subckt */
@@ -114,7 +115,8 @@ int print_spice_submodule_memories(NetlistManager& netlist_manager,
 
   /* Print out debugging information for if the file is not opened/created
    * properly */
-  VTR_LOG("Writing SPICE netlist for memories '%s' ...", spice_fname.c_str());
+  VTR_LOGV(show_progress, "Writing SPICE netlist for memories '%s' ...",
+           spice_fname.c_str());
 
   print_spice_file_header(fp, "Memories used in FPGA");
 
@@ -192,7 +194,7 @@ int print_spice_submodule_memories(NetlistManager& netlist_manager,
   VTR_ASSERT(NetlistId::INVALID() != nlist_id);
   netlist_manager.set_netlist_type(nlist_id, NetlistManager::SUBMODULE_NETLIST);
 
-  VTR_LOG("Done\n");
+  VTR_LOGV(show_progress, "Done\n");
 
   return status;
 }
@@ -145,7 +145,7 @@ static void generate_spice_mux_subckt(const ModuleManager& module_manager,
 static int print_spice_submodule_mux_primitives(
   NetlistManager& netlist_manager, const ModuleManager& module_manager,
   const MuxLibrary& mux_lib, const CircuitLibrary& circuit_lib,
-  const std::string& submodule_dir) {
+  const std::string& submodule_dir, const bool& show_progress) {
   int status = CMD_EXEC_SUCCESS;
 
   std::string spice_fname(submodule_dir +
@@ -159,8 +159,9 @@ static int print_spice_submodule_mux_primitives(
 
   /* Print out debugging information for if the file is not opened/created
    * properly */
-  VTR_LOG("Writing SPICE netlist for Multiplexer primitives '%s' ...",
-          spice_fname.c_str());
+  VTR_LOGV(show_progress,
+           "Writing SPICE netlist for Multiplexer primitives '%s' ...",
+           spice_fname.c_str());
 
   print_spice_file_header(fp, "Multiplexer primitives");
 
@@ -194,7 +195,7 @@ static int print_spice_submodule_mux_primitives(
   VTR_ASSERT(NetlistId::INVALID() != nlist_id);
   netlist_manager.set_netlist_type(nlist_id, NetlistManager::SUBMODULE_NETLIST);
 
-  VTR_LOG("Done\n");
+  VTR_LOGV(show_progress, "Done\n");
 
   return status;
 }
@@ -206,7 +207,7 @@ static int print_spice_submodule_mux_primitives(
 static int print_spice_submodule_mux_top_subckt(
   NetlistManager& netlist_manager, const ModuleManager& module_manager,
   const MuxLibrary& mux_lib, const CircuitLibrary& circuit_lib,
-  const std::string& submodule_dir) {
+  const std::string& submodule_dir, const bool& show_progress) {
   int status = CMD_EXEC_SUCCESS;
 
   std::string spice_fname(submodule_dir + std::string(MUXES_SPICE_FILE_NAME));
@@ -219,8 +220,8 @@ static int print_spice_submodule_mux_top_subckt(
 
   /* Print out debugging information for if the file is not opened/created
    * properly */
-  VTR_LOG("Writing SPICE netlist for Multiplexers '%s' ...",
-          spice_fname.c_str());
+  VTR_LOGV(show_progress, "Writing SPICE netlist for Multiplexers '%s' ...",
+           spice_fname.c_str());
 
   print_spice_file_header(fp, "Multiplexers");
 
@@ -241,7 +242,7 @@ static int print_spice_submodule_mux_top_subckt(
   VTR_ASSERT(NetlistId::INVALID() != nlist_id);
   netlist_manager.set_netlist_type(nlist_id, NetlistManager::SUBMODULE_NETLIST);
 
-  VTR_LOG("Done\n");
+  VTR_LOGV(show_progress, "Done\n");
 
   return status;
 }
@@ -259,18 +260,21 @@ int print_spice_submodule_muxes(NetlistManager& netlist_manager,
                                 const ModuleManager& module_manager,
                                 const MuxLibrary& mux_lib,
                                 const CircuitLibrary& circuit_lib,
-                                const std::string& submodule_dir) {
+                                const std::string& submodule_dir,
+                                const bool& show_progress) {
   int status = CMD_EXEC_SUCCESS;
 
   status = print_spice_submodule_mux_primitives(
-    netlist_manager, module_manager, mux_lib, circuit_lib, submodule_dir);
+    netlist_manager, module_manager, mux_lib, circuit_lib, submodule_dir,
+    show_progress);
 
   if (CMD_EXEC_FATAL_ERROR == status) {
     return status;
   }
 
   status = print_spice_submodule_mux_top_subckt(
-    netlist_manager, module_manager, mux_lib, circuit_lib, submodule_dir);
+    netlist_manager, module_manager, mux_lib, circuit_lib, submodule_dir,
+    show_progress);
 
   if (CMD_EXEC_FATAL_ERROR == status) {
     return status;
@@ -24,7 +24,8 @@ int print_spice_submodule_muxes(NetlistManager& netlist_manager,
                                 const ModuleManager& module_manager,
                                 const MuxLibrary& mux_lib,
                                 const CircuitLibrary& circuit_lib,
-                                const std::string& submodule_dir);
+                                const std::string& submodule_dir,
+                                const bool& show_progress);
 
 } /* end namespace openfpga */
 
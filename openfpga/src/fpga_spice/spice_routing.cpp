@@ -9,6 +9,7 @@
 
 /* Headers from openfpgautil library */
 #include "openfpga_digest.h"
+#include "openfpga_parallel.h"
 
 /* Include FPGA-Verilog header files*/
 #include "openfpga_naming.h"
@@ -221,14 +222,45 @@ static void print_spice_routing_switch_box_unique_module(
 }
 
 /********************************************************************
- * Iterate over all the connection blocks in a device
- * and build a module for each of them
+ * Write a list of routing modules, each of which is a pair of a GSB and
+ * the type of the block to be written. A switch block is denoted by the
+ * type NUM_RR_TYPES, while a connection block is denoted by its channel
+ * type.
+ * Each module is written to a separated netlist while the module manager
+ * is only read, so the netlists can be written by a pool of threads.
  *******************************************************************/
-static void print_spice_flatten_connection_block_modules(
+static void print_spice_routing_modules(
   NetlistManager& netlist_manager, const ModuleManager& module_manager,
-  const DeviceRRGSB& device_rr_gsb, const std::string& subckt_dir,
-  const t_rr_type& cb_type) {
-  /* Build unique X-direction connection block modules */
+  const std::vector<std::pair<const RRGSB*, t_rr_type>>& routing_modules,
+  const std::string& subckt_dir, const size_t& num_threads) {
+  /* Each task registers its netlists in its own netlist manager. They are
+   * imported in the order of the tasks, as a single thread does */
+  std::vector<NetlistManager> task_netlists(routing_modules.size());
+  parallel_for(
+    routing_modules.size(), num_threads, [&](const size_t& imodule) {
+      const RRGSB& rr_gsb = *(routing_modules[imodule].first);
+      const t_rr_type& block_type = routing_modules[imodule].second;
+      if (NUM_RR_TYPES == block_type) {
+        print_spice_routing_switch_box_unique_module(
+          task_netlists[imodule], module_manager, subckt_dir, rr_gsb);
+      } else {
+        print_spice_routing_connection_box_unique_module(
+          task_netlists[imodule], module_manager, subckt_dir, rr_gsb,
+          block_type);
+      }
+    });
+  for (const NetlistManager& netlists : task_netlists) {
+    netlist_manager.import_netlists(netlists);
+  }
+}
+
+/********************************************************************
+ * Iterate over all the connection blocks in a device
+ * and collect those to be written as modules
+ *******************************************************************/
+static void collect_flatten_connection_block_modules(
+  std::vector<std::pair<const RRGSB*, t_rr_type>>& routing_modules,
+  const DeviceRRGSB& device_rr_gsb, const t_rr_type& cb_type) {
   vtr::Point<size_t> cb_range = device_rr_gsb.get_gsb_range();
 
   for (size_t ix = 0; ix < cb_range.x(); ++ix) {
@@ -241,8 +273,7 @@ static void print_spice_flatten_connection_block_modules(
       if (true != rr_gsb.is_cb_exist(cb_type)) {
         continue;
       }
-      print_spice_routing_connection_box_unique_module(
-        netlist_manager, module_manager, subckt_dir, rr_gsb, cb_type);
+      routing_modules.push_back(std::make_pair(&rr_gsb, cb_type));
     }
   }
 }
@@ -260,10 +291,9 @@ void print_spice_flatten_routing_modules(NetlistManager& netlist_manager,
                                          const ModuleManager& module_manager,
                                          const DeviceRRGSB& device_rr_gsb,
                                          const RRGraphView& rr_graph,
-                                         const std::string& subckt_dir) {
-  /* Create a vector to contain all the Verilog netlist names that have been
-   * generated in this function */
-  std::vector<std::string> netlist_names;
+                                         const std::string& subckt_dir,
+                                         const size_t& num_threads) {
+  std::vector<std::pair<const RRGSB*, t_rr_type>> routing_modules;
 
   vtr::Point<size_t> sb_range = device_rr_gsb.get_gsb_range();
 
@@ -274,26 +304,18 @@ void print_spice_flatten_routing_modules(NetlistManager& netlist_manager,
       if (true != rr_gsb.is_sb_exist(rr_graph)) {
         continue;
       }
-      print_spice_routing_switch_box_unique_module(
-        netlist_manager, module_manager, subckt_dir, rr_gsb);
+      routing_modules.push_back(std::make_pair(&rr_gsb, NUM_RR_TYPES));
     }
   }
 
-  print_spice_flatten_connection_block_modules(
-    netlist_manager, module_manager, device_rr_gsb, subckt_dir, CHANX);
+  collect_flatten_connection_block_modules(routing_modules, device_rr_gsb,
+                                           CHANX);
 
-  print_spice_flatten_connection_block_modules(
-    netlist_manager, module_manager, device_rr_gsb, subckt_dir, CHANY);
+  collect_flatten_connection_block_modules(routing_modules, device_rr_gsb,
+                                           CHANY);
 
-  /*
-  VTR_LOG("Writing header file for routing submodules '%s'...",
-          ROUTING_VERILOG_FILE_NAME);
-  print_spice_netlist_include_header_file(netlist_names,
-                                          subckt_dir.c_str(),
-                                          ROUTING_VERILOG_FILE_NAME);
-  VTR_LOG("Done\n");
-  VTR_LOG("\n");
-   */
+  print_spice_routing_modules(netlist_manager, module_manager,
+                              routing_modules, subckt_dir, num_threads);
 }
 
 /********************************************************************
@@ -309,44 +331,33 @@ void print_spice_flatten_routing_modules(NetlistManager& netlist_manager,
 void print_spice_unique_routing_modules(NetlistManager& netlist_manager,
                                         const ModuleManager& module_manager,
                                         const DeviceRRGSB& device_rr_gsb,
-                                        const std::string& subckt_dir) {
-  /* Create a vector to contain all the Verilog netlist names that have been
-   * generated in this function */
-  std::vector<std::string> netlist_names;
+                                        const std::string& subckt_dir,
+                                        const size_t& num_threads) {
+  std::vector<std::pair<const RRGSB*, t_rr_type>> routing_modules;
 
   /* Build unique switch block modules */
   for (size_t isb = 0; isb < device_rr_gsb.get_num_sb_unique_module(); ++isb) {
     const RRGSB& unique_mirror = device_rr_gsb.get_sb_unique_module(isb);
-    print_spice_routing_switch_box_unique_module(
-      netlist_manager, module_manager, subckt_dir, unique_mirror);
+    routing_modules.push_back(std::make_pair(&unique_mirror, NUM_RR_TYPES));
   }
 
   /* Build unique X-direction connection block modules */
   for (size_t icb = 0; icb < device_rr_gsb.get_num_cb_unique_module(CHANX);
        ++icb) {
     const RRGSB& unique_mirror = device_rr_gsb.get_cb_unique_module(CHANX, icb);
-
-    print_spice_routing_connection_box_unique_module(
-      netlist_manager, module_manager, subckt_dir, unique_mirror, CHANX);
+    routing_modules.push_back(std::make_pair(&unique_mirror, CHANX));
   }
 
   /* Build unique X-direction connection block modules */
   for (size_t icb = 0; icb < device_rr_gsb.get_num_cb_unique_module(CHANY);
        ++icb) {
     const RRGSB& unique_mirror = device_rr_gsb.get_cb_unique_module(CHANY, icb);
-
-    print_spice_routing_connection_box_unique_module(
-      netlist_manager, module_manager, subckt_dir, unique_mirror, CHANY);
+    routing_modules.push_back(std::make_pair(&unique_mirror, CHANY));
   }
 
-  /*
-  VTR_LOG("Writing header file for routing submodules '%s'...",
-          ROUTING_VERILOG_FILE_NAME);
-  print_spice_netlist_include_header_file(netlist_names,
-                                          subckt_dir.c_str(),
-                                          ROUTING_VERILOG_FILE_NAME);
-  VTR_LOG("Done\n");
-   */
+  print_spice_routing_modules(netlist_manager, module_manager,
+                              routing_modules, subckt_dir, num_threads);
+
   VTR_LOG("\n");
 }
 
@@ -8,6 +8,8 @@
  * Please use const keyword to restrict this!
  *******************************************************************/
 #include <algorithm>
+#include <string>
+#include <unordered_map>
 
 /* Headers from vtrutil library */
 #include "vtr_assert.h"
@@ -130,6 +132,46 @@ static BasicPort generate_spice_port_for_module_net(
   return BasicPort(net_name, net_src_pin, net_src_pin);
 }
 
+/********************************************************************
+ * The ports of the nets of a SPICE subckt, which are named on their first
+ * use. A net is connected to many instance pins, so that each net is named
+ * only once rather than for each of its pins
+ *******************************************************************/
+typedef std::unordered_map<ModuleNetId, BasicPort> SpiceModuleNetPorts;
+
+static const BasicPort& find_spice_port_for_module_net(
+  SpiceModuleNetPorts& net_ports, const ModuleManager& module_manager,
+  const ModuleId& module_id, const ModuleNetId& module_net) {
+  auto result = net_ports.find(module_net);
+  if (result == net_ports.end()) {
+    result = net_ports
+               .emplace(module_net, generate_spice_port_for_module_net(
+                                      module_manager, module_id, module_net))
+               .first;
+  }
+  return result->second;
+}
+
+/********************************************************************
+ * Append a SPICE wire connection between each pin of two ports
+ *******************************************************************/
+static void append_spice_port_short_connection(std::string& buffer,
+                                               const BasicPort& src_port,
+                                               const BasicPort& sink_port) {
+  VTR_ASSERT(src_port.get_width() == sink_port.get_width());
+  std::string src_spice_pin;
+  std::string sink_spice_pin;
+  for (size_t ipin = 0; ipin < src_port.pins().size(); ++ipin) {
+    src_spice_pin.clear();
+    append_spice_port(src_spice_pin, src_port.get_name(),
+                      src_port.pins()[ipin]);
+    sink_spice_pin.clear();
+    append_spice_port(sink_spice_pin, sink_port.get_name(),
+                      sink_port.pins()[ipin]);
+    append_spice_short_connection(buffer, src_spice_pin, sink_spice_pin);
+  }
+}
+
 /********************************************************************
  * Print a SPICE wire connection
  * We search all the sinks of the net,
@@ -137,12 +179,9 @@ static BasicPort generate_spice_port_for_module_net(
  * among the sinks of the net
  * For each module output (except the first one), we print a wire connection
  *******************************************************************/
-static void print_spice_subckt_output_short_connection(
-  std::fstream& fp, const ModuleManager& module_manager,
+static void append_spice_subckt_output_short_connection(
+  std::string& buffer, const ModuleManager& module_manager,
   const ModuleId& module_id, const ModuleNetId& module_net) {
-  /* Ensure a valid file stream */
-  VTR_ASSERT(true == valid_file_stream(fp));
-
   bool first_port = true;
   BasicPort src_port;
 
@@ -174,15 +213,7 @@ static void print_spice_subckt_output_short_connection(
     }
 
     /* We need to print a wire connection here */
-    VTR_ASSERT(src_port.get_width() == sink_port.get_width());
-    for (size_t ipin = 0; ipin < src_port.pins().size(); ++ipin) {
-      BasicPort src_spice_pin(src_port.get_name(), src_port.pins()[ipin],
-                              src_port.pins()[ipin]);
-      BasicPort sink_spice_pin(sink_port.get_name(), sink_port.pins()[ipin],
-                               sink_port.pins()[ipin]);
-      print_spice_short_connection(fp, generate_spice_port(src_spice_pin),
-                                   generate_spice_port(sink_spice_pin));
-    }
+    append_spice_port_short_connection(buffer, src_port, sink_port);
   }
 }
 
@@ -193,12 +224,9 @@ static void print_spice_subckt_output_short_connection(
  * among the sinks of the net
  * If we find such a pair, we print a wire connection
  *******************************************************************/
-static void print_spice_subckt_local_short_connection(
-  std::fstream& fp, const ModuleManager& module_manager,
+static void append_spice_subckt_local_short_connection(
+  std::string& buffer, const ModuleManager& module_manager,
   const ModuleId& module_id, const ModuleNetId& module_net) {
-  /* Ensure a valid file stream */
-  VTR_ASSERT(true == valid_file_stream(fp));
-
   for (ModuleNetSrcId net_src :
        module_manager.module_net_sources(module_id, module_net)) {
     ModuleId src_module =
@@ -207,8 +235,8 @@ static void print_spice_subckt_local_short_connection(
       continue;
     }
     /* Find the source port and pin information */
-    print_spice_comment(
-      fp, std::string("Net source id " + std::to_string(size_t(net_src))));
+    append_spice_comment(
+      buffer, std::string("Net source id " + std::to_string(size_t(net_src))));
     ModulePortId src_port_id =
       module_manager.net_source_ports(module_id, module_net)[net_src];
     size_t src_pin =
@@ -228,8 +256,8 @@ static void print_spice_subckt_local_short_connection(
       }
 
       /* Find the sink port and pin information */
-      print_spice_comment(
-        fp, std::string("Net sink id " + std::to_string(size_t(net_sink))));
+      append_spice_comment(
+        buffer, std::string("Net sink id " + std::to_string(size_t(net_sink))));
       ModulePortId sink_port_id =
         module_manager.net_sink_ports(module_id, module_net)[net_sink];
       size_t sink_pin =
@@ -239,15 +267,7 @@ static void print_spice_subckt_local_short_connection(
         sink_pin, sink_pin);
 
       /* We need to print a wire connection here */
-      VTR_ASSERT(src_port.get_width() == sink_port.get_width());
-      for (size_t ipin = 0; ipin < src_port.pins().size(); ++ipin) {
-        BasicPort src_spice_pin(src_port.get_name(), src_port.pins()[ipin],
-                                src_port.pins()[ipin]);
-        BasicPort sink_spice_pin(sink_port.get_name(), sink_port.pins()[ipin],
-                                 sink_port.pins()[ipin]);
-        print_spice_short_connection(fp, generate_spice_port(src_spice_pin),
-                                     generate_spice_port(sink_spice_pin));
-      }
+      append_spice_port_short_connection(buffer, src_port, sink_port);
     }
   }
 }
@@ -268,8 +288,8 @@ static void print_spice_subckt_local_short_connection(
  *            |                             |
  *            +-----------------------------+
  *******************************************************************/
-static void print_spice_subckt_local_short_connections(
-  std::fstream& fp, const ModuleManager& module_manager,
+static void append_spice_subckt_local_short_connections(
+  std::string& buffer, const ModuleManager& module_manager,
   const ModuleId& module_id) {
   /* Local wires come from the child modules */
   for (ModuleNetId module_net : module_manager.module_nets(module_id)) {
@@ -278,10 +298,11 @@ static void print_spice_subckt_local_short_connections(
                    module_manager, module_id, module_net)) {
       continue;
     }
-    print_spice_comment(fp, std::string("Local connection due to Wire " +
-                                        std::to_string(size_t(module_net))));
-    print_spice_subckt_local_short_connection(fp, module_manager, module_id,
-                                              module_net);
+    append_spice_comment(buffer,
+                         std::string("Local connection due to Wire " +
+                                     std::to_string(size_t(module_net))));
+    append_spice_subckt_local_short_connection(buffer, module_manager,
+                                               module_id, module_net);
   }
 }
 
@@ -301,8 +322,8 @@ static void print_spice_subckt_local_short_connections(
  *                         +--------------->|--->outputB
  *            +-----------------------------+
  *******************************************************************/
-static void print_spice_subckt_output_short_connections(
-  std::fstream& fp, const ModuleManager& module_manager,
+static void append_spice_subckt_output_short_connections(
+  std::string& buffer, const ModuleManager& module_manager,
   const ModuleId& module_id) {
   /* Local wires come from the child modules */
   for (ModuleNetId module_net : module_manager.module_nets(module_id)) {
@@ -311,13 +332,13 @@ static void print_spice_subckt_output_short_connections(
                    module_manager, module_id, module_net)) {
       continue;
     }
-    print_spice_subckt_output_short_connection(fp, module_manager, module_id,
-                                               module_net);
+    append_spice_subckt_output_short_connection(buffer, module_manager,
+                                                module_id, module_net);
   }
 }
 
 /********************************************************************
- * Write a SPICE instance to a file
+ * Append a SPICE instance to a string buffer
  * This function will name the input and output connections to
  * the inputs/output or local wires available in the parent module
  *
@@ -333,30 +354,30 @@ static void print_spice_subckt_output_short_connections(
  *    +-----------------------------+
  *
  *******************************************************************/
-static void write_spice_instance_to_file(std::fstream& fp,
-                                         const ModuleManager& module_manager,
-                                         const ModuleId& parent_module,
-                                         const ModuleId& child_module,
-                                         const size_t& instance_id) {
-  /* Ensure a valid file stream */
-  VTR_ASSERT(true == valid_file_stream(fp));
-
+static void append_spice_instance(std::string& buffer,
+                                  SpiceModuleNetPorts& net_ports,
+                                  const ModuleManager& module_manager,
+                                  const ModuleId& parent_module,
+                                  const ModuleId& child_module,
+                                  const size_t& instance_id) {
   /* Print instance name:
    * if we have an instance name, use it;
    * if not, we use a default name <name>_<num_instance_in_parent_module>
    */
-  std::string instance_head_line = "X ";
+  size_t instance_head_start = buffer.size();
+  buffer += 'X';
   if (true ==
       module_manager.instance_name(parent_module, child_module, instance_id)
         .empty()) {
-    instance_head_line += generate_instance_name(
-      module_manager.module_name(child_module), instance_id);
+    buffer += generate_instance_name(module_manager.module_name(child_module),
+                                     instance_id);
   } else {
-    instance_head_line +=
+    buffer +=
       module_manager.instance_name(parent_module, child_module, instance_id);
   }
-  instance_head_line += " ";
-  fp << instance_head_line;
+  buffer += ' ';
+  /* Continued lines are aligned to the first port */
+  std::string port_whitespace(buffer.size() - instance_head_start - 2, ' ');
 
   /* Port sequence: global, inout, input, output and clock ports, */
   bool fit_one_line = true;
@@ -370,48 +391,40 @@ static void write_spice_instance_to_file(std::fstream& fp,
       BasicPort child_port =
         module_manager.module_port(child_module, child_port_id);
 
-      /* Create the port name and width to be used by the instance */
-      std::vector<BasicPort> instance_ports;
+      /* Find the port name of each pin to be used by the instance */
       for (size_t child_pin : child_port.pins()) {
-        /* Find the net linked to the pin */
-        ModuleNetId net = module_manager.module_instance_port_net(
-          parent_module, child_module, instance_id, child_port_id, child_pin);
-        BasicPort instance_port;
-        if (ModuleNetId::INVALID() == net) {
-          /* We give the same port name as child module, this case happens to
-           * global ports */
-          instance_port.set_name(generate_spice_undriven_local_wire_name(
-            module_manager, parent_module, child_module, instance_id,
-            child_port_id));
-          instance_port.set_width(child_pin, child_pin);
-        } else {
-          /* Find the name for this child port */
-          instance_port = generate_spice_port_for_module_net(
-            module_manager, parent_module, net);
-        }
-
         if (true == new_line) {
-          std::string port_whitespace(instance_head_line.length() - 2, ' ');
-          fp << "+ " << port_whitespace;
+          buffer += "+ ";
+          buffer += port_whitespace;
         }
 
         if (0 != pin_cnt) {
-          write_space_to_file(fp, 1);
+          buffer += ' ';
         }
 
-        VTR_ASSERT(1 == instance_port.get_width());
-
+        /* Find the net linked to the pin */
+        ModuleNetId net = module_manager.module_instance_port_net(
+          parent_module, child_module, instance_id, child_port_id, child_pin);
         /* For single-bit port,
          * we can print the port name directly
          */
-        bool omit_pin_zero = false;
-        if ((1 == instance_port.pins().size()) &&
-            (0 == instance_port.get_lsb())) {
-          omit_pin_zero = true;
+        if (ModuleNetId::INVALID() == net) {
+          /* We give the same port name as child module, this case happens to
+           * global ports */
+          append_spice_port(buffer,
+                            generate_spice_undriven_local_wire_name(
+                              module_manager, parent_module, child_module,
+                              instance_id, child_port_id),
+                            child_pin, true);
+        } else {
+          /* Find the name for this child port */
+          const BasicPort& instance_port = find_spice_port_for_module_net(
+            net_ports, module_manager, parent_module, net);
+          VTR_ASSERT(1 == instance_port.get_width());
+          append_spice_port(buffer, instance_port.get_name(),
+                            instance_port.get_lsb(), true);
         }
 
-        fp << generate_spice_port(instance_port, omit_pin_zero);
-
         /* Increase the counter */
         pin_cnt++;
 
@@ -419,7 +432,7 @@ static void write_spice_instance_to_file(std::fstream& fp,
         new_line = false;
         if (SPICE_NETLIST_MAX_NUM_PORTS_PER_LINE == pin_cnt) {
           pin_cnt = 0;
-          fp << std::endl;
+          buffer += '\n';
           new_line = true;
           fit_one_line = false;
         }
@@ -431,13 +444,13 @@ static void write_spice_instance_to_file(std::fstream& fp,
    * TODO: the supply ports should be derived from module manager
    */
   if (true == new_line) {
-    std::string port_whitespace(instance_head_line.length() - 2, ' ');
-    fp << "+ " << port_whitespace;
+    buffer += "+ ";
+    buffer += port_whitespace;
   }
-  write_space_to_file(fp, 1);
-  fp << SPICE_SUBCKT_VDD_PORT_NAME;
-  write_space_to_file(fp, 1);
-  fp << SPICE_SUBCKT_GND_PORT_NAME;
+  buffer += ' ';
+  buffer += SPICE_SUBCKT_VDD_PORT_NAME;
+  buffer += ' ';
+  buffer += SPICE_SUBCKT_GND_PORT_NAME;
 
   pin_cnt += 2;
 
@@ -445,7 +458,7 @@ static void write_spice_instance_to_file(std::fstream& fp,
   new_line = false;
   if (SPICE_NETLIST_MAX_NUM_PORTS_PER_LINE == pin_cnt) {
     pin_cnt = 0;
-    fp << std::endl;
+    buffer += '\n';
     new_line = true;
     fit_one_line = false;
   }
@@ -455,20 +468,24 @@ static void write_spice_instance_to_file(std::fstream& fp,
    * a clean format
    */
   if (false == fit_one_line) {
-    fp << std::endl;
-    fp << "+";
+    buffer += "\n+";
   }
-  write_space_to_file(fp, 1);
-  fp << module_manager.module_name(child_module);
+  buffer += ' ';
+  buffer += module_manager.module_name(child_module);
 
   /* Print an end to the instance */
-  fp << std::endl;
+  buffer += '\n';
 }
 
 /********************************************************************
  * Write a SPICE sub-circuit to a file
  * This is a key function, maybe most frequently called in our SPICE writer
  * Note that file stream must be valid
+ *
+ * The short connections and instances, which are the bulk of a subckt,
+ * are formatted into an output buffer and written to the file stream in
+ * large chunks. The buffer is owned by the thread, so that its memory is
+ * reused by all the subckts to be written
  *******************************************************************/
 void write_spice_subckt_to_file(std::fstream& fp,
                                 const ModuleManager& module_manager,
@@ -481,35 +498,48 @@ void write_spice_subckt_to_file(std::fstream& fp,
   /* Print module declaration */
   print_spice_subckt_definition(fp, module_manager, module_id);
 
+  thread_local std::string buffer;
+  buffer.clear();
+  buffer.reserve(SPICE_WRITER_BUFFER_SIZE);
+
   /* Print an empty line as splitter */
-  fp << std::endl;
+  buffer += '\n';
 
   /* Print an empty line as splitter */
-  fp << std::endl;
+  buffer += '\n';
 
   /* Print local connection (from module inputs to output! */
-  print_spice_comment(fp, std::string("BEGIN Local short connections"));
-  print_spice_subckt_local_short_connections(fp, module_manager, module_id);
-  print_spice_comment(fp, std::string("END Local short connections"));
-
-  print_spice_comment(fp, std::string("BEGIN Local output short connections"));
-  print_spice_subckt_output_short_connections(fp, module_manager, module_id);
-
-  print_spice_comment(fp, std::string("END Local output short connections"));
+  append_spice_comment(buffer, std::string("BEGIN Local short connections"));
+  append_spice_subckt_local_short_connections(buffer, module_manager,
+                                              module_id);
+  append_spice_comment(buffer, std::string("END Local short connections"));
+
+  append_spice_comment(buffer,
+                       std::string("BEGIN Local output short connections"));
+  append_spice_subckt_output_short_connections(buffer, module_manager,
+                                               module_id);
+
+  append_spice_comment(buffer,
+                       std::string("END Local output short connections"));
   /* Print an empty line as splitter */
-  fp << std::endl;
+  buffer += '\n';
 
   /* Print instances */
+  SpiceModuleNetPorts net_ports;
   for (ModuleId child_module : module_manager.child_modules(module_id)) {
     for (size_t instance :
          module_manager.child_module_instances(module_id, child_module)) {
       /* Print an instance */
-      write_spice_instance_to_file(fp, module_manager, module_id, child_module,
-                                   instance);
+      append_spice_instance(buffer, net_ports, module_manager, module_id,
+                            child_module, instance);
       /* Print an empty line as splitter */
-      fp << std::endl;
+      buffer += '\n';
+      if (SPICE_WRITER_BUFFER_SIZE <= buffer.size()) {
+        write_buffer_to_file(fp, buffer);
+      }
     }
   }
+  write_buffer_to_file(fp, buffer);
 
   /* Print an end for the module */
   print_spice_subckt_end(fp, module_manager.module_name(module_id));
@@ -2,6 +2,8 @@
  * This file includes top-level function to generate SPICE primitive modules
  * and print them to files
  ********************************************************************/
+#include <functional>
+#include <vector>
 
 /* Headers from vtrutil library */
 #include "vtr_assert.h"
@@ -9,6 +11,7 @@
 
 /* Headers from openfpgashell library */
 #include "command_exit_codes.h"
+#include "openfpga_parallel.h"
 #include "spice_constants.h"
 #include "spice_essential_gates.h"
 #include "spice_lut.h"
@@ -29,30 +32,32 @@ namespace openfpga {
  * 4. TODO: Local encoders for routing multiplexers
  * 5. Wires
  * 6. Configuration memory blocks
+ *
+ * Each kind of primitive modules is written to its own netlists while the
+ * module manager is only read, so the writers can run in a pool of threads.
+ * Progress is only reported when a single thread is used, to avoid
+ * interleaved logs
  ********************************************************************/
 int print_spice_submodule(NetlistManager& netlist_manager,
                           const ModuleManager& module_manager,
                           const Arch& openfpga_arch, const MuxLibrary& mux_lib,
-                          const std::string& submodule_dir) {
-  int status = CMD_EXEC_SUCCESS;
+                          const std::string& submodule_dir,
+                          const size_t& num_threads) {
+  bool show_progress = (1 == find_num_threads(num_threads));
 
-  /* Transistor wrapper */
-  status = print_spice_transistor_wrapper(
-    netlist_manager, openfpga_arch.tech_lib, submodule_dir);
+  std::vector<std::function<int(NetlistManager&)>> writers;
 
-  /* Error out if fatal errors have been reported */
-  if (CMD_EXEC_SUCCESS != status) {
-    return CMD_EXEC_FATAL_ERROR;
-  }
+  /* Transistor wrapper */
+  writers.push_back([&](NetlistManager& writer_netlists) {
+    return print_spice_transistor_wrapper(
+      writer_netlists, openfpga_arch.tech_lib, submodule_dir, show_progress);
+  });
 
   /* Constant modules: VDD and GND */
-  status =
-    print_spice_supply_wrappers(netlist_manager, module_manager, submodule_dir);
-
-  /* Error out if fatal errors have been reported */
-  if (CMD_EXEC_SUCCESS != status) {
-    return CMD_EXEC_FATAL_ERROR;
-  }
+  writers.push_back([&](NetlistManager& writer_netlists) {
+    return print_spice_supply_wrappers(writer_netlists, module_manager,
+                                       submodule_dir, show_progress);
+  });
 
   /* Logic gates:
    *   - AND/OR,
@@ -60,49 +65,57 @@ int print_spice_submodule(NetlistManager& netlist_manager,
    *   - transmission-gate/pass-transistor
    *   - wires
    */
-  status = print_spice_essential_gates(
-    netlist_manager, module_manager, openfpga_arch.circuit_lib,
-    openfpga_arch.tech_lib, openfpga_arch.circuit_tech_binding, submodule_dir);
-
-  /* Error out if fatal errors have been reported */
-  if (CMD_EXEC_SUCCESS != status) {
-    return CMD_EXEC_FATAL_ERROR;
-  }
+  writers.push_back([&](NetlistManager& writer_netlists) {
+    return print_spice_essential_gates(
+      writer_netlists, module_manager, openfpga_arch.circuit_lib,
+      openfpga_arch.tech_lib, openfpga_arch.circuit_tech_binding,
+      submodule_dir, show_progress);
+  });
 
   /* TODO: local decoders for routing multiplexers */
 
   /* Routing multiplexers */
-  status =
-    print_spice_submodule_muxes(netlist_manager, module_manager, mux_lib,
-                                openfpga_arch.circuit_lib, submodule_dir);
-
-  /* Error out if fatal errors have been reported */
-  if (CMD_EXEC_SUCCESS != status) {
-    return CMD_EXEC_FATAL_ERROR;
-  }
+  writers.push_back([&](NetlistManager& writer_netlists) {
+    return print_spice_submodule_muxes(writer_netlists, module_manager,
+                                       mux_lib, openfpga_arch.circuit_lib,
+                                       submodule_dir, show_progress);
+  });
 
   /* Look-Up Tables */
-  status = print_spice_submodule_luts(netlist_manager, module_manager,
-                                      openfpga_arch.circuit_lib, submodule_dir);
-
-  /* Error out if fatal errors have been reported */
-  if (CMD_EXEC_SUCCESS != status) {
-    return CMD_EXEC_FATAL_ERROR;
-  }
+  writers.push_back([&](NetlistManager& writer_netlists) {
+    return print_spice_submodule_luts(writer_netlists, module_manager,
+                                      openfpga_arch.circuit_lib,
+                                      submodule_dir, show_progress);
+  });
 
   /* Memories */
-  status =
-    print_spice_submodule_memories(netlist_manager, module_manager, mux_lib,
-                                   openfpga_arch.circuit_lib, submodule_dir);
+  writers.push_back([&](NetlistManager& writer_netlists) {
+    return print_spice_submodule_memories(writer_netlists, module_manager,
+                                          mux_lib, openfpga_arch.circuit_lib,
+                                          submodule_dir, show_progress);
+  });
 
-  /* Error out if fatal errors have been reported */
-  if (CMD_EXEC_SUCCESS != status) {
-    return CMD_EXEC_FATAL_ERROR;
+  /* TODO: architecture decoders */
+
+  std::vector<int> status(writers.size(), CMD_EXEC_SUCCESS);
+  /* Each task registers its netlists in its own netlist manager. They are
+   * imported in the order of the tasks, as a single thread does */
+  std::vector<NetlistManager> writer_netlists(writers.size());
+  parallel_for(writers.size(), num_threads, [&](const size_t& iwriter) {
+    status[iwriter] = writers[iwriter](writer_netlists[iwriter]);
+  });
+  for (const NetlistManager& netlists : writer_netlists) {
+    netlist_manager.import_netlists(netlists);
   }
 
-  /* TODO: architecture decoders */
+  /* Error out if fatal errors have been reported */
+  for (const int& writer_status : status) {
+    if (CMD_EXEC_SUCCESS != writer_status) {
+      return CMD_EXEC_FATAL_ERROR;
+    }
+  }
 
-  return status;
+  return CMD_EXEC_SUCCESS;
 }
 
 } /* end namespace openfpga */
@@ -19,7 +19,8 @@ namespace openfpga {
 int print_spice_submodule(NetlistManager& netlist_manager,
                           const ModuleManager& module_manager,
                           const Arch& openfpga_arch, const MuxLibrary& mux_lib,
-                          const std::string& submodule_dir);
+                          const std::string& submodule_dir,
+                          const size_t& num_threads);
 
 } /* end namespace openfpga */
 
@@ -72,7 +72,8 @@ static int print_spice_transistor_model_wrapper(
  *******************************************************************/
 int print_spice_transistor_wrapper(NetlistManager& netlist_manager,
                                    const TechnologyLibrary& tech_lib,
-                                   const std::string& submodule_dir) {
+                                   const std::string& submodule_dir,
+                                   const bool& show_progress) {
   std::string spice_fname =
     submodule_dir + std::string(TRANSISTORS_SPICE_FILE_NAME);
 
@@ -84,8 +85,8 @@ int print_spice_transistor_wrapper(NetlistManager& netlist_manager,
   check_file_stream(spice_fname.c_str(), fp);
 
   /* Create file */
-  VTR_LOG("Generating SPICE netlist '%s' for transistors...",
-          spice_fname.c_str());
+  VTR_LOGV(show_progress, "Generating SPICE netlist '%s' for transistors...",
+           spice_fname.c_str());
 
   print_spice_file_header(fp, std::string("Transistor wrappers"));
 
@@ -110,7 +111,7 @@ int print_spice_transistor_wrapper(NetlistManager& netlist_manager,
   VTR_ASSERT(NetlistId::INVALID() != nlist_id);
   netlist_manager.set_netlist_type(nlist_id, NetlistManager::SUBMODULE_NETLIST);
 
-  VTR_LOG("Done\n");
+  VTR_LOGV(show_progress, "Done\n");
 
   return CMD_EXEC_SUCCESS;
 }
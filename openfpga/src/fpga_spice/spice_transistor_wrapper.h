@@ -19,7 +19,8 @@ namespace openfpga {
 
 int print_spice_transistor_wrapper(NetlistManager& netlist_manager,
                                    const TechnologyLibrary& tech_lib,
-                                   const std::string& submodule_dir);
+                                   const std::string& submodule_dir,
+                                   const bool& show_progress);
 
 int print_spice_generic_pmos_modeling(
   std::fstream& fp, const std::string& trans_name_postfix,
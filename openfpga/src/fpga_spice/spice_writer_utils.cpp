@@ -65,6 +65,18 @@ void print_spice_comment(std::fstream& fp, const std::string& comment) {
   fp << comment_cover << std::endl;
 }
 
+/************************************************
+ * Append a Spice comment line to a string buffer
+ ***********************************************/
+void append_spice_comment(std::string& buffer, const std::string& comment) {
+  buffer.append(comment.length() + 4, '*');
+  buffer += "\n* ";
+  buffer += comment;
+  buffer += " *\n";
+  buffer.append(comment.length() + 4, '*');
+  buffer += '\n';
+}
+
 /************************************************
  * Generate a string for a port in SPICE format
  * If the pin id is zero, e.g., A[0], the option
@@ -88,6 +100,24 @@ std::string generate_spice_port(const BasicPort& port,
   return ret;
 }
 
+/************************************************
+ * Append a pin of a port to a string buffer in SPICE format,
+ * which is the same as generate_spice_port()
+ * but without creating any temporary string
+ ***********************************************/
+void append_spice_port(std::string& buffer, const std::string& port_name,
+                       const size_t& pin, const bool& omit_pin_zero) {
+  buffer += port_name;
+
+  if ((true == omit_pin_zero) && (0 == pin)) {
+    return;
+  }
+
+  buffer += '[';
+  append_number_to_buffer(buffer, pin);
+  buffer += ']';
+}
+
 /************************************************
  * Print a SPICE subckt definition
  * We use the following format:
@@ -225,6 +255,24 @@ void print_spice_short_connection(std::fstream& fp,
   print_spice_resistor(fp, input_port, output_port, 0.);
 }
 
+/************************************************
+ * Append a short-connected wire to a string buffer,
+ * which is the same as print_spice_short_connection()
+ ***********************************************/
+void append_spice_short_connection(std::string& buffer,
+                                   const std::string& input_port,
+                                   const std::string& output_port) {
+  buffer += 'R';
+  buffer += input_port;
+  buffer += "_to_";
+  buffer += output_port;
+  buffer += ' ';
+  buffer += input_port;
+  buffer += ' ';
+  buffer += output_port;
+  buffer += " 0\n";
+}
+
 /********************************************************************
  * Print an instance in SPICE format (a generic version)
  * This function will require user to provide an instance name
@@ -257,7 +305,7 @@ void print_spice_subckt_instance(
   }
 
   /* Print instance name */
-  std::string instance_head_line = "X " + instance_name + " ";
+  std::string instance_head_line = "X" + instance_name + " ";
   fp << instance_head_line;
 
   /* Port sequence: global, inout, input, output and clock ports, */
@@ -298,13 +346,13 @@ void print_spice_subckt_instance(
           write_space_to_file(fp, 1);
         }
 
-        BasicPort port_pin(port.get_name(), pin, pin);
+        BasicPort port_pin(port_to_print.get_name(), pin, pin);
 
         /* For single-bit port,
          * we can print the port name directly
          */
         bool omit_pin_zero = false;
-        if ((1 == port.pins().size()) && (0 == pin)) {
+        if ((1 == port_to_print.pins().size()) && (0 == pin)) {
           omit_pin_zero = true;
         }
 
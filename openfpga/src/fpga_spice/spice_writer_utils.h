@@ -42,6 +42,15 @@ void print_spice_comment(std::fstream& fp, const std::string& comment);
 std::string generate_spice_port(const BasicPort& port,
                                 const bool& omit_pin_zero = false);
 
+void append_spice_comment(std::string& buffer, const std::string& comment);
+
+void append_spice_port(std::string& buffer, const std::string& port_name,
+                       const size_t& pin, const bool& omit_pin_zero = false);
+
+void append_spice_short_connection(std::string& buffer,
+                                   const std::string& input_port,
+                                   const std::string& output_port);
+
 void print_spice_subckt_definition(std::fstream& fp,
                                    const ModuleManager& module_manager,
                                    const ModuleId& module_id,
@@ -3,6 +3,8 @@
  ******************************************************************************/
 #include "fabric_verilog_options.h"
 
+#include <functional>
+
 #include "vtr_assert.h"
 #include "vtr_log.h"
 
@@ -17,10 +19,21 @@ FabricVerilogOption::FabricVerilogOption() {
   include_timing_ = false;
   explicit_port_mapping_ = false;
   compress_routing_ = false;
+  compress_instance_arrays_ = false;
+  keep_unchanged_files_ = false;
+  pack_netlists_ = false;
+  packed_netlist_size_ = 0;
+  behavioral_muxes_ = false;
+  skip_unused_modules_ = false;
+  two_state_ = false;
+  submodule_library_.clear();
   print_user_defined_template_ = false;
   default_net_type_ = VERILOG_DEFAULT_NET_TYPE_NONE;
   time_stamp_ = true;
   use_relative_path_ = false;
+  num_threads_ = 1;
+  num_partitions_ = 1;
+  partition_ = 0;
   verbose_output_ = false;
 }
 
@@ -45,6 +58,34 @@ bool FabricVerilogOption::explicit_port_mapping() const {
 
 bool FabricVerilogOption::compress_routing() const { return compress_routing_; }
 
+bool FabricVerilogOption::compress_instance_arrays() const {
+  return compress_instance_arrays_;
+}
+
+bool FabricVerilogOption::keep_unchanged_files() const {
+  return keep_unchanged_files_;
+}
+
+bool FabricVerilogOption::pack_netlists() const { return pack_netlists_; }
+
+size_t FabricVerilogOption::packed_netlist_size() const {
+  return packed_netlist_size_;
+}
+
+bool FabricVerilogOption::behavioral_muxes() const {
+  return behavioral_muxes_;
+}
+
+bool FabricVerilogOption::skip_unused_modules() const {
+  return skip_unused_modules_;
+}
+
+bool FabricVerilogOption::two_state() const { return two_state_; }
+
+std::string FabricVerilogOption::submodule_library() const {
+  return submodule_library_;
+}
+
 bool FabricVerilogOption::print_user_defined_template() const {
   return print_user_defined_template_;
 }
@@ -53,6 +94,27 @@ e_verilog_default_net_type FabricVerilogOption::default_net_type() const {
   return default_net_type_;
 }
 
+size_t FabricVerilogOption::num_threads() const { return num_threads_; }
+
+size_t FabricVerilogOption::num_partitions() const { return num_partitions_; }
+
+size_t FabricVerilogOption::partition() const { return partition_; }
+
+/* Netlists are assigned to the partitions by the hash of their names, so
+ * that every process finds the same assignment without any communication */
+bool FabricVerilogOption::netlist_in_partition(
+  const std::string& netlist_name) const {
+  if (1 == num_partitions_) {
+    return true;
+  }
+  return partition_ ==
+         std::hash<std::string>()(netlist_name) % num_partitions_;
+}
+
+bool FabricVerilogOption::write_shared_netlists() const {
+  return 0 == partition_;
+}
+
 bool FabricVerilogOption::verbose_output() const { return verbose_output_; }
 
 /******************************************************************************
@@ -82,6 +144,39 @@ void FabricVerilogOption::set_compress_routing(const bool& enabled) {
   compress_routing_ = enabled;
 }
 
+void FabricVerilogOption::set_compress_instance_arrays(const bool& enabled) {
+  compress_instance_arrays_ = enabled;
+}
+
+void FabricVerilogOption::set_keep_unchanged_files(const bool& enabled) {
+  keep_unchanged_files_ = enabled;
+}
+
+void FabricVerilogOption::set_pack_netlists(const bool& enabled) {
+  pack_netlists_ = enabled;
+}
+
+void FabricVerilogOption::set_packed_netlist_size(const size_t& size) {
+  packed_netlist_size_ = size;
+}
+
+void FabricVerilogOption::set_behavioral_muxes(const bool& enabled) {
+  behavioral_muxes_ = enabled;
+}
+
+void FabricVerilogOption::set_skip_unused_modules(const bool& enabled) {
+  skip_unused_modules_ = enabled;
+}
+
+void FabricVerilogOption::set_two_state(const bool& enabled) {
+  two_state_ = enabled;
+}
+
+void FabricVerilogOption::set_submodule_library(
+  const std::string& library_dir) {
+  submodule_library_ = library_dir;
+}
+
 void FabricVerilogOption::set_print_user_defined_template(const bool& enabled) {
   print_user_defined_template_ = enabled;
 }
@@ -106,6 +201,17 @@ void FabricVerilogOption::set_default_net_type(
   }
 }
 
+void FabricVerilogOption::set_num_threads(const size_t& num_threads) {
+  num_threads_ = num_threads;
+}
+
+void FabricVerilogOption::set_partition(const size_t& partition,
+                                        const size_t& num_partitions) {
+  VTR_ASSERT(partition < num_partitions);
+  partition_ = partition;
+  num_partitions_ = num_partitions;
+}
+
 void FabricVerilogOption::set_verbose_output(const bool& enabled) {
   verbose_output_ = enabled;
 }
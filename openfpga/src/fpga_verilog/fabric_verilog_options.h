@@ -26,8 +26,24 @@ class FabricVerilogOption {
   bool include_timing() const;
   bool explicit_port_mapping() const;
   bool compress_routing() const;
+  bool compress_instance_arrays() const;
+  bool keep_unchanged_files() const;
+  bool pack_netlists() const;
+  size_t packed_netlist_size() const;
+  bool behavioral_muxes() const;
+  bool skip_unused_modules() const;
+  bool two_state() const;
+  std::string submodule_library() const;
   e_verilog_default_net_type default_net_type() const;
   bool print_user_defined_template() const;
+  size_t num_threads() const;
+  size_t num_partitions() const;
+  size_t partition() const;
+  /* Identify if a netlist is written by the partition of the process */
+  bool netlist_in_partition(const std::string& netlist_name) const;
+  /* Identify if the netlists shared by all the partitions, e.g., the
+   * submodules and the top-level modules, are written by the process */
+  bool write_shared_netlists() const;
   bool verbose_output() const;
 
  public: /* Public mutators */
@@ -37,8 +53,18 @@ class FabricVerilogOption {
   void set_include_timing(const bool& enabled);
   void set_explicit_port_mapping(const bool& enabled);
   void set_compress_routing(const bool& enabled);
+  void set_compress_instance_arrays(const bool& enabled);
+  void set_keep_unchanged_files(const bool& enabled);
+  void set_pack_netlists(const bool& enabled);
+  void set_packed_netlist_size(const size_t& size);
+  void set_behavioral_muxes(const bool& enabled);
+  void set_skip_unused_modules(const bool& enabled);
+  void set_two_state(const bool& enabled);
+  void set_submodule_library(const std::string& library_dir);
   void set_print_user_defined_template(const bool& enabled);
   void set_default_net_type(const std::string& default_net_type);
+  void set_num_threads(const size_t& num_threads);
+  void set_partition(const size_t& partition, const size_t& num_partitions);
   void set_verbose_output(const bool& enabled);
 
  private: /* Internal Data */
@@ -46,10 +72,41 @@ class FabricVerilogOption {
   bool include_timing_;
   bool explicit_port_mapping_;
   bool compress_routing_;
+  /* Write the regular arrays of instances in the top-level modules with
+   * generate loops */
+  bool compress_instance_arrays_;
+  /* Leave the netlists whose content is unchanged in place, instead of
+   * rewriting them */
+  bool keep_unchanged_files_;
+  /* Write the netlists of logic blocks, routing blocks and tiles to a few
+   * large files, whose maximum size is given in MB. 0 means a single file */
+  bool pack_netlists_;
+  size_t packed_netlist_size_;
+  /* Write the CMOS multiplexers and LUT multiplexers in behavioral Verilog,
+   * for fast simulation */
+  bool behavioral_muxes_;
+  /* Do not write the modules which are not instantiated under the top-level
+   * module, e.g., the memories of unused circuit models */
+  bool skip_unused_modules_;
+  /* Write the primitive modules without any high-impedance or unknown
+   * value, so that the fabric can be simulated by 2-state simulators */
+  bool two_state_;
+  /* Write the netlists of submodules to a directory shared by fabrics,
+   * where each netlist is named after the hash of its content. Empty means
+   * the submodules are written under the output directory */
+  std::string submodule_library_;
   bool print_user_defined_template_;
   e_verilog_default_net_type default_net_type_;
   bool time_stamp_;
   bool use_relative_path_;
+  /* Number of threads to write the netlists, 0 means all the hardware
+   * threads */
+  size_t num_threads_;
+  /* The netlists of routing blocks, grids and tiles are spread over a
+   * number of partitions, each of which is written by a separated process.
+   * The first partition also writes the shared netlists */
+  size_t num_partitions_;
+  size_t partition_;
   bool verbose_output_;
 };
 
@@ -14,11 +14,13 @@
 #include "openfpga_digest.h"
 #include "openfpga_naming.h"
 #include "openfpga_reserved_words.h"
+#include "openfpga_trace.h"
 #include "verilog_auxiliary_netlists.h"
 #include "verilog_constants.h"
 #include "verilog_formal_random_top_testbench.h"
 #include "verilog_grid.h"
 #include "verilog_mock_fpga_wrapper.h"
+#include "verilog_netlist_pack.h"
 #include "verilog_preconfig_top_module.h"
 #include "verilog_routing.h"
 #include "verilog_simulation_info_writer.h"
@@ -58,6 +60,7 @@ namespace openfpga {
  ********************************************************************/
 int fpga_fabric_verilog(
   ModuleManager &module_manager, NetlistManager &netlist_manager,
+  VerilogModuleWireLayout &wire_layout,
   const MemoryBankShiftRegisterBanks &blwl_sr_banks,
   const CircuitLibrary &circuit_lib, const MuxLibrary &mux_lib,
   const DecoderLibrary &decoder_lib, const DeviceContext &device_ctx,
@@ -65,6 +68,7 @@ int fpga_fabric_verilog(
   const DeviceRRGSB &device_rr_gsb, const FabricTile &fabric_tile,
   const ModuleNameMap &module_name_map, const FabricVerilogOption &options) {
   vtr::ScopedStartFinishTimer timer("Write Verilog netlists for FPGA fabric\n");
+  TraceScope trace_scope("fpga_fabric_verilog");
 
   int status_code = CMD_EXEC_SUCCESS;
 
@@ -79,81 +83,139 @@ int fpga_fabric_verilog(
     src_dir_path + std::string(DEFAULT_SUBMODULE_DIR_NAME);
   create_directory(submodule_dir_path);
 
+  /* The submodules may be written to a library shared by other fabrics */
+  if (false == options.submodule_library().empty()) {
+    create_directory(format_dir_path(options.submodule_library()));
+  }
+
+  /* When required, the netlists of logic blocks, routing blocks and tiles are
+   * packed into a few files under the SRC directory, and their sub
+   * directories are not needed */
+  VerilogNetlistPack netlist_pack(
+    src_dir_path + std::string(PACKED_VERILOG_NETLIST_FILE_PREFIX),
+    options.packed_netlist_size(), options.keep_unchanged_files());
+  VerilogNetlistPack *netlist_pack_ptr =
+    options.pack_netlists() ? &netlist_pack : nullptr;
+
   /* Sub directory under SRC directory to contain all the logic block netlists
    */
   std::string lb_dir_path = src_dir_path + std::string(DEFAULT_LB_DIR_NAME);
-  create_directory(lb_dir_path);
+  if (false == options.pack_netlists()) {
+    create_directory(lb_dir_path);
+  }
 
   /* Sub directory under SRC directory to contain all the routing block netlists
    */
   std::string rr_dir_path = src_dir_path + std::string(DEFAULT_RR_DIR_NAME);
-  create_directory(rr_dir_path);
+  if (false == options.pack_netlists()) {
+    create_directory(rr_dir_path);
+  }
 
   /* Sub directory under SRC directory to contain all the tile netlists
    */
   std::string tile_dir_path = src_dir_path + std::string(DEFAULT_TILE_DIR_NAME);
-  if (!fabric_tile.empty()) {
+  if (!fabric_tile.empty() && false == options.pack_netlists()) {
     create_directory(tile_dir_path);
   }
 
-  /* Print Verilog files containing preprocessing flags */
-  print_verilog_preprocessing_flags_netlist(std::string(src_dir_path), options);
+  /* When the netlists are written by a number of partitions, only the
+   * first one writes the netlists which are shared by all of them */
+  if (1 < options.num_partitions()) {
+    VTR_LOG("Write the netlists of partition %lu out of %lu partitions\n",
+            options.partition(), options.num_partitions());
+  }
 
-  /* Generate primitive Verilog modules, which are corner stones of FPGA fabric
-   * Note that this function MUST be called before Verilog generation of
-   * core logic (i.e., logic blocks and routing resources) !!!
-   * This is because that this function will add the primitive Verilog modules
-   * to the module manager. Without the modules in the module manager, core
-   * logic generation is not possible!!!
-   */
-  print_verilog_submodule(module_manager, netlist_manager, blwl_sr_banks,
-                          mux_lib, decoder_lib, circuit_lib, module_name_map,
-                          submodule_dir_path,
-                          std::string(DEFAULT_SUBMODULE_DIR_NAME), options);
+  if (true == options.write_shared_netlists()) {
+    /* Print Verilog files containing preprocessing flags */
+    print_verilog_preprocessing_flags_netlist(std::string(src_dir_path),
+                                              options);
+
+    /* Generate primitive Verilog modules, which are corner stones of FPGA
+     * fabric.
+     * Note that this function MUST be called before Verilog generation of
+     * core logic (i.e., logic blocks and routing resources) !!!
+     * This is because that this function will add the primitive Verilog
+     * modules to the module manager. Without the modules in the module
+     * manager, core logic generation is not possible!!!
+     */
+    print_verilog_submodule(module_manager, netlist_manager, blwl_sr_banks,
+                            mux_lib, decoder_lib, circuit_lib, module_name_map,
+                            submodule_dir_path,
+                            std::string(DEFAULT_SUBMODULE_DIR_NAME), options);
+  }
 
   /* Generate routing blocks */
   if (true == options.compress_routing()) {
     print_verilog_unique_routing_modules(
       netlist_manager, const_cast<const ModuleManager &>(module_manager),
-      module_name_map, device_rr_gsb, rr_dir_path,
-      std::string(DEFAULT_RR_DIR_NAME), options);
+      wire_layout, netlist_pack_ptr, module_name_map, device_rr_gsb,
+      rr_dir_path, std::string(DEFAULT_RR_DIR_NAME), options);
   } else {
     VTR_ASSERT(false == options.compress_routing());
     print_verilog_flatten_routing_modules(
       netlist_manager, const_cast<const ModuleManager &>(module_manager),
-      module_name_map, device_rr_gsb, device_ctx.rr_graph, rr_dir_path,
-      std::string(DEFAULT_RR_DIR_NAME), options);
+      wire_layout, netlist_pack_ptr, module_name_map, device_rr_gsb,
+      device_ctx.rr_graph, rr_dir_path, std::string(DEFAULT_RR_DIR_NAME),
+      options);
   }
 
   /* Generate grids */
   print_verilog_grids(
     netlist_manager, const_cast<const ModuleManager &>(module_manager),
-    module_name_map, device_ctx, device_annotation, lb_dir_path,
-    std::string(DEFAULT_LB_DIR_NAME), options, options.verbose_output());
+    wire_layout, netlist_pack_ptr, module_name_map, device_ctx,
+    device_annotation, lb_dir_path, std::string(DEFAULT_LB_DIR_NAME), options,
+    options.verbose_output());
 
   /* Generate tiles */
   if (!fabric_tile.empty()) {
     status_code = print_verilog_tiles(
       netlist_manager, const_cast<const ModuleManager &>(module_manager),
-      module_name_map, tile_dir_path, fabric_tile,
-      std::string(DEFAULT_TILE_DIR_NAME), options);
+      wire_layout, netlist_pack_ptr, module_name_map, tile_dir_path,
+      fabric_tile, std::string(DEFAULT_TILE_DIR_NAME), options);
     if (status_code != CMD_EXEC_SUCCESS) {
       return CMD_EXEC_FATAL_ERROR;
     }
   }
 
+  /* Register the packed netlists, once all of them have been written */
+  if (true == options.pack_netlists()) {
+    netlist_pack.close();
+    for (const std::string &shard_fpath : netlist_pack.shards()) {
+      NetlistId nlist_id = NetlistId::INVALID();
+      if (options.use_relative_path()) {
+        nlist_id =
+          netlist_manager.add_netlist(find_path_file_name(shard_fpath));
+      } else {
+        nlist_id = netlist_manager.add_netlist(shard_fpath);
+      }
+      VTR_ASSERT(nlist_id);
+      netlist_manager.set_netlist_type(nlist_id,
+                                       NetlistManager::PACKED_MODULE_NETLIST);
+    }
+  }
+
+  /* The other partitions are done. The top-level modules only instantiate
+   * the netlists of all the partitions, and are written as a final stitch */
+  if (false == options.write_shared_netlists()) {
+    return CMD_EXEC_SUCCESS;
+  }
+
   /* Generate FPGA fabric */
   print_verilog_core_module(netlist_manager,
                             const_cast<const ModuleManager &>(module_manager),
-                            module_name_map, src_dir_path, options);
+                            wire_layout, module_name_map, src_dir_path,
+                            options);
   print_verilog_top_module(netlist_manager,
                            const_cast<const ModuleManager &>(module_manager),
-                           module_name_map, src_dir_path, options);
+                           wire_layout, module_name_map, src_dir_path,
+                           options);
 
-  /* Generate an netlist including all the fabric-related netlists */
+  /* Generate an netlist including all the fabric-related netlists, including
+   * those written by other partitions */
   print_verilog_fabric_include_netlist(
     const_cast<const NetlistManager &>(netlist_manager), src_dir_path,
-    circuit_lib, options.use_relative_path(), options.time_stamp());
+    circuit_lib, options.use_relative_path(), options.time_stamp(),
+    options.keep_unchanged_files());
 
   /* Given a brief stats on how many Verilog modules have been written to files
    */
@@ -186,6 +248,7 @@ int fpga_verilog_full_testbench(
   const VerilogTestbenchOption &options) {
   vtr::ScopedStartFinishTimer timer(
     "Write Verilog full testbenches for FPGA fabric\n");
+  TraceScope trace_scope("fpga_verilog_full_testbench");
 
   std::string src_dir_path = format_dir_path(options.output_directory());
 
@@ -234,6 +297,7 @@ int fpga_verilog_preconfigured_fabric_wrapper(
   const VerilogTestbenchOption &options) {
   vtr::ScopedStartFinishTimer timer(
     "Write a wrapper module for a preconfigured FPGA fabric\n");
+  TraceScope trace_scope("fpga_verilog_preconfigured_fabric_wrapper");
 
   std::string src_dir_path = format_dir_path(options.output_directory());
 
@@ -249,11 +313,18 @@ int fpga_verilog_preconfigured_fabric_wrapper(
   std::string formal_verification_top_netlist_file_path =
     src_dir_path + netlist_name +
     std::string(FORMAL_VERIFICATION_VERILOG_FILE_POSTFIX);
+  std::string bitstream_memory_file_path =
+    src_dir_path + netlist_name +
+    std::string(FORMAL_VERIFICATION_BITSTREAM_MEMORY_FILE_POSTFIX);
+  /* The bitstream loader is shared by all the designs */
+  std::string bitstream_loader_file_path =
+    src_dir_path + std::string(FORMAL_VERIFICATION_BITSTREAM_LOADER_FILE_NAME);
   status = print_verilog_preconfig_top_module(
     module_manager, bitstream_manager, config_protocol, circuit_lib,
     fabric_global_port_info, atom_ctx, place_ctx, pin_constraints, bus_group,
     io_location_map, io_name_map, module_name_map, netlist_annotation,
-    netlist_name, formal_verification_top_netlist_file_path, options);
+    netlist_name, formal_verification_top_netlist_file_path,
+    bitstream_memory_file_path, bitstream_loader_file_path, options);
 
   return status;
 }
@@ -396,6 +467,7 @@ int fpga_verilog_preconfigured_testbench(
   const VerilogTestbenchOption &options) {
   vtr::ScopedStartFinishTimer timer(
     "Write Verilog testbenches for a preconfigured FPGA fabric\n");
+  TraceScope trace_scope("fpga_verilog_preconfigured_testbench");
 
   std::string src_dir_path = format_dir_path(options.output_directory());
 
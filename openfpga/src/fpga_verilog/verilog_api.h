@@ -27,6 +27,7 @@
 #include "netlist_manager.h"
 #include "pin_constraints.h"
 #include "simulation_setting.h"
+#include "verilog_module_wire_layout.h"
 #include "verilog_testbench_options.h"
 #include "vpr_context.h"
 #include "vpr_device_annotation.h"
@@ -41,6 +42,7 @@ namespace openfpga {
 
 int fpga_fabric_verilog(
   ModuleManager& module_manager, NetlistManager& netlist_manager,
+  VerilogModuleWireLayout& wire_layout,
   const MemoryBankShiftRegisterBanks& blwl_sr_banks,
   const CircuitLibrary& circuit_lib, const MuxLibrary& mux_lib,
   const DecoderLibrary& decoder_lib, const DeviceContext& device_ctx,
@@ -75,7 +75,8 @@ void print_verilog_fabric_include_netlist(const NetlistManager& netlist_manager,
                                           const std::string& src_dir_path,
                                           const CircuitLibrary& circuit_lib,
                                           const bool& use_relative_path,
-                                          const bool& include_time_stamp) {
+                                          const bool& include_time_stamp,
+                                          const bool& keep_unchanged_file) {
   /* If we force the use of relative path, the src dir path should NOT be
    * included in any output */
   std::string src_dir = src_dir_path;
@@ -87,10 +88,12 @@ void print_verilog_fabric_include_netlist(const NetlistManager& netlist_manager,
 
   /* Create the file stream */
   std::fstream fp;
-  fp.open(verilog_fpath, std::fstream::out | std::fstream::trunc);
+  std::string verilog_staging_fpath =
+    find_staging_file_path(verilog_fpath, keep_unchanged_file);
+  fp.open(verilog_staging_fpath, std::fstream::out | std::fstream::trunc);
 
   /* Validate the file stream */
-  check_file_stream(verilog_fpath.c_str(), fp);
+  check_file_stream(verilog_staging_fpath.c_str(), fp);
 
   /* Print the title */
   print_verilog_file_header(fp, std::string("Fabric Netlist Summary"),
@@ -147,6 +150,19 @@ void print_verilog_fabric_include_netlist(const NetlistManager& netlist_manager,
   }
   fp << std::endl;
 
+  /* Include all the packed netlists */
+  if (false ==
+      netlist_manager.netlists_by_type(NetlistManager::PACKED_MODULE_NETLIST)
+        .empty()) {
+    print_verilog_comment(
+      fp, std::string("------ Include packed module netlists -----"));
+    for (const NetlistId& nlist_id : netlist_manager.netlists_by_type(
+           NetlistManager::PACKED_MODULE_NETLIST)) {
+      print_verilog_include_netlist(fp, netlist_manager.netlist_name(nlist_id));
+    }
+    fp << std::endl;
+  }
+
   /* Include FPGA top module */
   print_verilog_comment(
     fp, std::string("------ Include fabric top-level netlists -----"));
@@ -158,6 +174,7 @@ void print_verilog_fabric_include_netlist(const NetlistManager& netlist_manager,
 
   /* Close the file stream */
   fp.close();
+  commit_staging_file(verilog_staging_fpath, verilog_fpath);
 }
 
 /********************************************************************
@@ -299,10 +316,12 @@ void print_verilog_preprocessing_flags_netlist(
 
   /* Create the file stream */
   std::fstream fp;
-  fp.open(verilog_fname, std::fstream::out | std::fstream::trunc);
+  std::string verilog_staging_fname = find_staging_file_path(
+    verilog_fname, fabric_verilog_opts.keep_unchanged_files());
+  fp.open(verilog_staging_fname, std::fstream::out | std::fstream::trunc);
 
   /* Validate the file stream */
-  check_file_stream(verilog_fname.c_str(), fp);
+  check_file_stream(verilog_staging_fname.c_str(), fp);
 
   /* Print the title */
   print_verilog_file_header(
@@ -319,6 +338,7 @@ void print_verilog_preprocessing_flags_netlist(
 
   /* Close the file stream */
   fp.close();
+  commit_staging_file(verilog_staging_fname, verilog_fname);
 }
 
 } /* end namespace openfpga */
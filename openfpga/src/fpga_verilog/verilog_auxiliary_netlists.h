@@ -26,7 +26,8 @@ void print_verilog_fabric_include_netlist(const NetlistManager& netlist_manager,
                                           const std::string& src_dir_path,
                                           const CircuitLibrary& circuit_lib,
                                           const bool& use_relative_path,
-                                          const bool& include_time_stamp);
+                                          const bool& include_time_stamp,
+                                          const bool& keep_unchanged_file);
 
 void print_verilog_full_testbench_include_netlists(
   const std::string& src_dir_path, const std::string& circuit_name,
@@ -1,6 +1,8 @@
 #ifndef VERILOG_CONSTANTS_H
 #define VERILOG_CONSTANTS_H
 
+#include <cstddef>
+
 /* global parameters for dumping synthesizable verilog */
 
 constexpr const char* VERILOG_NETLIST_FILE_POSTFIX = ".v";
@@ -18,6 +20,10 @@ constexpr const char* TOP_VERILOG_TESTBENCH_INCLUDE_NETLIST_FILE_NAME_POSTFIX =
 constexpr const char* VERILOG_TOP_POSTFIX = "_top.v";
 constexpr const char* FORMAL_VERIFICATION_VERILOG_FILE_POSTFIX =
   "_top_formal_verification.v";
+constexpr const char* FORMAL_VERIFICATION_BITSTREAM_MEMORY_FILE_POSTFIX =
+  "_top_formal_verification_bitstream.mem";
+constexpr const char* FORMAL_VERIFICATION_BITSTREAM_LOADER_FILE_NAME =
+  "fpga_bitstream_loader.v";
 constexpr const char* TOP_TESTBENCH_VERILOG_FILE_POSTFIX =
   "_top_tb.v"; /* !!! must be consist with the modelsim_testbench_module_postfix
                 */
@@ -27,6 +33,8 @@ constexpr const char* AUTOCHECK_TOP_TESTBENCH_VERILOG_FILE_POSTFIX =
 constexpr const char* RANDOM_TOP_TESTBENCH_VERILOG_FILE_POSTFIX =
   "_formal_random_top_tb.v";
 constexpr const char* DEFINES_VERILOG_FILE_NAME = "fpga_defines.v";
+constexpr const char* PACKED_VERILOG_NETLIST_FILE_PREFIX =
+  "fabric_packed_netlist_";
 constexpr const char* SUBMODULE_VERILOG_FILE_NAME = "sub_module.v";
 constexpr const char* LOGIC_BLOCK_VERILOG_FILE_NAME = "logic_blocks.v";
 constexpr const char* LUTS_VERILOG_FILE_NAME = "luts.v";
@@ -57,10 +65,29 @@ constexpr const char* FORMAL_VERIFICATION_TOP_MODULE_POSTFIX =
 constexpr const char* FORMAL_VERIFICATION_TOP_MODULE_PORT_POSTFIX = "_fm";
 constexpr const char* FORMAL_VERIFICATION_TOP_MODULE_UUT_NAME =
   "U0_formal_verification";
+constexpr const char* FORMAL_VERIFICATION_BITSTREAM_MEM_REG_NAME =
+  "bitstream_mem";
+/* The name of the plusarg giving the bitstream memory file to the shared
+ * bitstream loader, e.g., +bitstream_mem=<file>, as well as the maximum
+ * length of the file path */
+constexpr const char* FORMAL_VERIFICATION_BITSTREAM_MEM_PLUSARG =
+  "bitstream_mem";
+constexpr const char* FORMAL_VERIFICATION_BITSTREAM_MEM_FILE_REG_NAME =
+  "bitstream_mem_file";
+constexpr size_t FORMAL_VERIFICATION_BITSTREAM_MEM_FILE_MAX_LENGTH = 1024;
 
 constexpr const char* FORMAL_RANDOM_TOP_TESTBENCH_POSTFIX =
   "_top_formal_verification_random_tb";
 
 #define VERILOG_DEFAULT_SIGNAL_INIT_VALUE 0
 
+/* Size of the output buffer of the Verilog module writer, in bytes. The
+ * buffer is written to the file stream once its content exceeds the size */
+constexpr size_t VERILOG_WRITER_BUFFER_SIZE = 1 << 16;
+
+/* Arrays of instances written with generate loops */
+constexpr const char* VERILOG_INSTANCE_ARRAY_POSTFIX = "_array_";
+constexpr const char* VERILOG_INSTANCE_ARRAY_INDEX_NAME = "instance_index";
+constexpr const char* VERILOG_INSTANCE_ARRAY_INSTANCE_NAME = "inst";
+
 #endif
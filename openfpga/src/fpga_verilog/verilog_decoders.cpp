@@ -16,6 +16,7 @@
 #include "openfpga_reserved_words.h"
 #include "verilog_constants.h"
 #include "verilog_decoders.h"
+#include "verilog_submodule_utils.h"
 #include "verilog_writer_utils.h"
 
 /* begin namespace openfpga */
@@ -188,9 +189,11 @@ void print_verilog_submodule_mux_local_decoders(
 
   /* Create the file stream */
   std::fstream fp;
-  fp.open(verilog_fpath, std::fstream::out | std::fstream::trunc);
+  std::string verilog_staging_fpath =
+    find_staging_file_path(verilog_fpath, options.keep_unchanged_files());
+  fp.open(verilog_staging_fpath, std::fstream::out | std::fstream::trunc);
 
-  check_file_stream(verilog_fpath.c_str(), fp);
+  check_file_stream(verilog_staging_fpath.c_str(), fp);
 
   /* Print out debugging information for if the file is not opened/created
    * properly */
@@ -242,18 +245,67 @@ void print_verilog_submodule_mux_local_decoders(
 
   /* Close the file stream */
   fp.close();
+  /* Commit the file and add fname to the netlist name list */
+  commit_verilog_submodule_netlist(netlist_manager, verilog_staging_fpath,
+                                   verilog_fpath, submodule_dir_name,
+                                   verilog_fname, options);
 
-  /* Add fname to the netlist name list */
-  NetlistId nlist_id = NetlistId::INVALID();
-  if (options.use_relative_path()) {
-    nlist_id = netlist_manager.add_netlist(submodule_dir_name + verilog_fname);
-  } else {
-    nlist_id = netlist_manager.add_netlist(verilog_fpath);
+  VTR_LOG("Done\n");
+}
+
+/***************************************************************************************
+ * Generate the address of a decoder as an unsigned number, where the first
+ * pin of the address port is the least significant bit, for example:
+ *   {addr[2], addr[1], addr[0]}
+ * This is the same bit order as the address codes given by itobin_vec()
+ ***************************************************************************************/
+static std::string generate_verilog_decoder_address(
+  const BasicPort& addr_port) {
+  std::string addr_str("{");
+  for (size_t ipin = addr_port.get_width(); ipin > 0; --ipin) {
+    if (ipin < addr_port.get_width()) {
+      addr_str += ", ";
+    }
+    size_t pin = addr_port.pins()[ipin - 1];
+    BasicPort addr_pin(addr_port.get_name(), pin, pin);
+    addr_str += generate_verilog_port(VERILOG_PORT_CONKT, addr_pin);
   }
-  VTR_ASSERT(nlist_id);
-  netlist_manager.set_netlist_type(nlist_id, NetlistManager::SUBMODULE_NETLIST);
+  addr_str += "}";
+  return addr_str;
+}
 
-  VTR_LOG("Done\n");
+/***************************************************************************************
+ * Print the behavioral decoding of an address to a data output, where only
+ * the data output bit indexed by the address is assigned with a given value:
+ *   <default_assignment>;
+ *   if (<address> < <data_size>) begin
+ *     data[<address>] = <data_value>;
+ *   end
+ * The range check is skipped when any address has a data output bit.
+ * Compared to a case statement listing the one-hot code of each address,
+ * the size of the netlist is linear to the data size
+ ***************************************************************************************/
+static void print_verilog_decoder_indexed_data(
+  std::fstream& fp, const BasicPort& addr_port, const BasicPort& data_port,
+  const std::string& default_assignment, const std::string& data_value,
+  const std::string& indent) {
+  std::string addr_str = generate_verilog_decoder_address(addr_port);
+  bool check_range = (addr_port.get_width() >= 64) ||
+                     (data_port.get_width() <
+                      (size_t(1) << addr_port.get_width()));
+
+  fp << indent << default_assignment << ";" << std::endl;
+  std::string data_indent(indent);
+  if (true == check_range) {
+    fp << indent << "if (" << addr_str << " < " << data_port.get_width()
+       << ") begin" << std::endl;
+    data_indent += "\t";
+  }
+  fp << data_indent << data_port.get_name() << "[" << addr_str
+     << "] = " << data_value << ";" << std::endl;
+  if (true == check_range) {
+    fp << indent << "end" << std::endl;
+  }
 }
 
 /***************************************************************************************
@@ -476,28 +528,12 @@ static void print_verilog_arch_decoder_module(
     fp << "\tif (" << generate_verilog_port(VERILOG_PORT_CONKT, enable_port)
        << " == 1'b1) begin" << std::endl;
   }
-  fp << "\t\t"
-     << "case (" << generate_verilog_port(VERILOG_PORT_CONKT, addr_port) << ")"
-     << std::endl;
-  /* Create a string for addr and data */
-  for (size_t i = 0; i < data_size; ++i) {
-    fp << "\t\t\t"
-       << generate_verilog_constant_values(itobin_vec(i, addr_size));
-    fp << " : ";
-    fp << generate_verilog_port_constant_values(data_port,
-                                                ito1hot_vec(i, data_size));
-    fp << ";" << std::endl;
-  }
   /* Different from MUX decoder, we assign default values which is all zero */
-  fp << "\t\t\t"
-     << "default";
-  fp << " : ";
-  fp << generate_verilog_port_constant_values(
-    data_port, ito1hot_vec(data_size, data_size));
-  fp << ";" << std::endl;
-
-  fp << "\t\t"
-     << "endcase" << std::endl;
+  print_verilog_decoder_indexed_data(
+    fp, addr_port, data_port,
+    generate_verilog_port_constant_values(data_port,
+                                          ito1hot_vec(data_size, data_size)),
+    std::string("1'b1"), std::string("\t\t"));
   fp << "\t"
      << "end" << std::endl;
 
@@ -530,28 +566,12 @@ static void print_verilog_arch_decoder_module(
     fp << "(" << generate_verilog_port(VERILOG_PORT_CONKT, readback_port)
        << " == 1'b1) ";
     fp << ") begin" << std::endl;
-    fp << "\t\t"
-       << "case (" << generate_verilog_port(VERILOG_PORT_CONKT, addr_port)
-       << ")" << std::endl;
-    /* Create a string for addr and data */
-    for (size_t i = 0; i < data_size; ++i) {
-      fp << "\t\t\t"
-         << generate_verilog_constant_values(itobin_vec(i, addr_size));
-      fp << " : ";
-      fp << generate_verilog_port_constant_values(data_ren_port,
-                                                  ito1hot_vec(i, data_size));
-      fp << ";" << std::endl;
-    }
     /* Different from MUX decoder, we assign default values which is all zero */
-    fp << "\t\t\t"
-       << "default";
-    fp << " : ";
-    fp << generate_verilog_port_constant_values(
-      data_ren_port, ito1hot_vec(data_size, data_size));
-    fp << ";" << std::endl;
-
-    fp << "\t\t"
-       << "endcase" << std::endl;
+    print_verilog_decoder_indexed_data(
+      fp, addr_port, data_ren_port,
+      generate_verilog_port_constant_values(data_ren_port,
+                                            ito1hot_vec(data_size, data_size)),
+      std::string("1'b1"), std::string("\t\t"));
     fp << "\t"
        << "end" << std::endl;
 
@@ -711,37 +731,14 @@ static void print_verilog_arch_decoder_with_data_in_module(
 
   fp << "\tif (" << generate_verilog_port(VERILOG_PORT_CONKT, enable_port)
      << " == 1'b1) begin" << std::endl;
-  fp << "\t\t" << generate_verilog_port(VERILOG_PORT_CONKT, data_port);
-  fp << " = ";
   std::string high_res_str =
     "{" + std::to_string(data_port.get_width()) + "{1'bz}}";
-  fp << high_res_str;
-  fp << ";" << std::endl;
-  fp << "\t\t"
-     << "case (" << generate_verilog_port(VERILOG_PORT_CONKT, addr_port) << ")"
-     << std::endl;
-  /* Create a string for addr and data */
-  for (size_t i = 0; i < data_size; ++i) {
-    BasicPort cur_data_port(data_port.get_name(), i, i);
-    fp << "\t\t\t"
-       << generate_verilog_constant_values(itobin_vec(i, addr_size));
-    fp << " : ";
-    fp << generate_verilog_port(VERILOG_PORT_CONKT, cur_data_port);
-    fp << " = ";
-    fp << generate_verilog_port(VERILOG_PORT_CONKT, din_port);
-    fp << ";" << std::endl;
-  }
-  /* Different from MUX decoder, we assign default values which is all zero */
-  fp << "\t\t\t"
-     << "default";
-  fp << " : ";
-  fp << "\t\t" << generate_verilog_port(VERILOG_PORT_CONKT, data_port);
-  fp << " = ";
-  fp << high_res_str;
-  fp << ";" << std::endl;
-
-  fp << "\t\t"
-     << "endcase" << std::endl;
+  /* Different from MUX decoder, the other data outputs are in high resistance
+   */
+  print_verilog_decoder_indexed_data(
+    fp, addr_port, data_port,
+    generate_verilog_port(VERILOG_PORT_CONKT, data_port) + " = " + high_res_str,
+    generate_verilog_port(VERILOG_PORT_CONKT, din_port), std::string("\t\t"));
   fp << "\t"
      << "end" << std::endl;
 
@@ -790,9 +787,11 @@ void print_verilog_submodule_arch_decoders(
 
   /* Create the file stream */
   std::fstream fp;
-  fp.open(verilog_fpath, std::fstream::out | std::fstream::trunc);
+  std::string verilog_staging_fpath =
+    find_staging_file_path(verilog_fpath, options.keep_unchanged_files());
+  fp.open(verilog_staging_fpath, std::fstream::out | std::fstream::trunc);
 
-  check_file_stream(verilog_fpath.c_str(), fp);
+  check_file_stream(verilog_staging_fpath.c_str(), fp);
 
   /* Print out debugging information for if the file is not opened/created
    * properly */
@@ -817,16 +816,10 @@ void print_verilog_submodule_arch_decoders(
 
   /* Close the file stream */
   fp.close();
-
-  /* Add fname to the netlist name list */
-  NetlistId nlist_id = NetlistId::INVALID();
-  if (options.use_relative_path()) {
-    nlist_id = netlist_manager.add_netlist(submodule_dir_name + verilog_fname);
-  } else {
-    nlist_id = netlist_manager.add_netlist(verilog_fpath);
-  }
-  VTR_ASSERT(nlist_id);
-  netlist_manager.set_netlist_type(nlist_id, NetlistManager::SUBMODULE_NETLIST);
+  /* Commit the file and add fname to the netlist name list */
+  commit_verilog_submodule_netlist(netlist_manager, verilog_staging_fpath,
+                                   verilog_fpath, submodule_dir_name,
+                                   verilog_fname, options);
 
   VTR_LOG("Done\n");
 }
@@ -27,18 +27,52 @@ namespace openfpga {
 /************************************************
  * Print Verilog body codes of a power-gated inverter
  * This function does NOT generate any port map !
+ * In 2-state mode, the output is a single continuous assignment, which is
+ * driven to '0' when the inverter is power-gated
  ***********************************************/
 static void print_verilog_power_gated_invbuf_body(
   std::fstream& fp, const CircuitLibrary& circuit_lib,
   const CircuitModelId& circuit_model, const CircuitPortId& input_port,
   const CircuitPortId& output_port,
-  const std::vector<CircuitPortId>& power_gate_ports) {
+  const std::vector<CircuitPortId>& power_gate_ports, const bool& two_state) {
   /* Ensure a valid file handler*/
   VTR_ASSERT(true == valid_file_stream(fp));
 
   print_verilog_comment(
     fp, std::string("----- Verilog codes of a power-gated inverter -----"));
 
+  if (true == two_state) {
+    fp << "\tassign " << circuit_lib.port_lib_name(output_port) << " = (";
+    size_t port_cnt = 0;
+    for (const auto& power_gate_port : power_gate_ports) {
+      /* Only config_enable signal will be considered */
+      if (false == circuit_lib.port_is_config_enable(power_gate_port)) {
+        continue;
+      }
+      for (const auto& power_gate_pin : circuit_lib.pins(power_gate_port)) {
+        if (0 < port_cnt) {
+          fp << " && ";
+        }
+        fp << "(";
+        if (1 == circuit_lib.port_default_value(power_gate_port)) {
+          fp << "~";
+        }
+        fp << circuit_lib.port_lib_name(power_gate_port) << "["
+           << power_gate_pin << "])";
+        port_cnt++;
+      }
+    }
+    fp << ") ? ";
+    if ((CIRCUIT_MODEL_BUF_INV == circuit_lib.buffer_type(circuit_model)) ||
+        ((CIRCUIT_MODEL_BUF_BUF == circuit_lib.buffer_type(circuit_model)) &&
+         (size_t(-1) != circuit_lib.buffer_num_levels(circuit_model)) &&
+         (1 == circuit_lib.buffer_num_levels(circuit_model) % 2))) {
+      fp << "~";
+    }
+    fp << circuit_lib.port_lib_name(input_port) << " : 1'b0;" << std::endl;
+    return;
+  }
+
   /* Create a sensitive list */
   fp << "\treg " << circuit_lib.port_lib_name(output_port) << "_reg;"
      << std::endl;
@@ -118,15 +152,20 @@ static void print_verilog_invbuf_body(std::fstream& fp,
                                       const CircuitLibrary& circuit_lib,
                                       const CircuitModelId& circuit_model,
                                       const CircuitPortId& input_port,
-                                      const CircuitPortId& output_port) {
+                                      const CircuitPortId& output_port,
+                                      const bool& two_state) {
   /* Ensure a valid file handler*/
   VTR_ASSERT(true == valid_file_stream(fp));
 
   print_verilog_comment(
     fp, std::string("----- Verilog codes of a regular inverter -----"));
 
-  fp << "\tassign " << circuit_lib.port_lib_name(output_port) << " = ("
-     << circuit_lib.port_lib_name(input_port) << " === 1'bz)? $random : ";
+  /* A floating input is randomized, unless there is no 'z' in 2-state mode */
+  fp << "\tassign " << circuit_lib.port_lib_name(output_port) << " = ";
+  if (false == two_state) {
+    fp << "(" << circuit_lib.port_lib_name(input_port)
+       << " === 1'bz)? $random : ";
+  }
 
   /* Branch on the type of inverter/buffer:
    * 1. If this is an inverter or an tapered(multi-stage) buffer with odd number
@@ -151,7 +190,7 @@ static void print_verilog_invbuf_body(std::fstream& fp,
 static void print_verilog_invbuf_module(
   const ModuleManager& module_manager, std::fstream& fp,
   const CircuitLibrary& circuit_lib, const CircuitModelId& circuit_model,
-  const ModuleNameMap& module_name_map,
+  const ModuleNameMap& module_name_map, const bool& two_state,
   const e_verilog_default_net_type& default_net_type) {
   /* Ensure a valid file handler*/
   VTR_ASSERT(true == valid_file_stream(fp));
@@ -199,11 +238,11 @@ static void print_verilog_invbuf_module(
     /* Output Verilog codes for a power-gated inverter */
     print_verilog_power_gated_invbuf_body(fp, circuit_lib, circuit_model,
                                           input_ports[0], output_ports[0],
-                                          global_ports);
+                                          global_ports, two_state);
   } else {
     /* Output Verilog codes for a regular inverter */
     print_verilog_invbuf_body(fp, circuit_lib, circuit_model, input_ports[0],
-                              output_ports[0]);
+                              output_ports[0], two_state);
   }
 
   /* Print timing info */
@@ -221,7 +260,7 @@ static void print_verilog_invbuf_module(
 static void print_verilog_passgate_module(
   const ModuleManager& module_manager, std::fstream& fp,
   const CircuitLibrary& circuit_lib, const CircuitModelId& circuit_model,
-  const ModuleNameMap& module_name_map,
+  const ModuleNameMap& module_name_map, const bool& two_state,
   const e_verilog_default_net_type& default_net_type) {
   /* Ensure a valid file handler*/
   VTR_ASSERT(true == valid_file_stream(fp));
@@ -282,12 +321,13 @@ static void print_verilog_passgate_module(
   /* Finish dumping ports */
 
   /* Dump logics: we propagate input to the output when the gate is '1'
-   * the input is blocked from output when the gate is '0'
+   * the input is blocked from output when the gate is '0', which drives the
+   * output to '0' in 2-state mode
    */
   fp << "\tassign " << circuit_lib.port_lib_name(output_ports[0]) << " = ";
   fp << circuit_lib.port_lib_name(input_ports[1]) << " ? "
      << circuit_lib.port_lib_name(input_ports[0]);
-  fp << " : 1'bz;" << std::endl;
+  fp << (two_state ? " : 1'b0;" : " : 1'bz;") << std::endl;
 
   /* Print timing info */
   print_verilog_submodule_timing(fp, circuit_lib, circuit_model);
@@ -556,9 +596,11 @@ void print_verilog_submodule_essentials(const ModuleManager& module_manager,
   std::fstream fp;
 
   /* Create the file stream */
-  fp.open(verilog_fpath, std::fstream::out | std::fstream::trunc);
+  std::string verilog_staging_fpath =
+    find_staging_file_path(verilog_fpath, options.keep_unchanged_files());
+  fp.open(verilog_staging_fpath, std::fstream::out | std::fstream::trunc);
   /* Check if the file stream if valid or not */
-  check_file_stream(verilog_fpath.c_str(), fp);
+  check_file_stream(verilog_staging_fpath.c_str(), fp);
 
   /* Create file */
   VTR_LOG("Generating Verilog netlist '%s' for essential gates...",
@@ -580,15 +622,15 @@ void print_verilog_submodule_essentials(const ModuleManager& module_manager,
       continue;
     }
     if (CIRCUIT_MODEL_INVBUF == circuit_lib.model_type(circuit_model)) {
-      print_verilog_invbuf_module(module_manager, fp, circuit_lib,
-                                  circuit_model, module_name_map,
-                                  options.default_net_type());
+      print_verilog_invbuf_module(
+        module_manager, fp, circuit_lib, circuit_model, module_name_map,
+        options.two_state(), options.default_net_type());
       continue;
     }
     if (CIRCUIT_MODEL_PASSGATE == circuit_lib.model_type(circuit_model)) {
-      print_verilog_passgate_module(module_manager, fp, circuit_lib,
-                                    circuit_model, module_name_map,
-                                    options.default_net_type());
+      print_verilog_passgate_module(
+        module_manager, fp, circuit_lib, circuit_model, module_name_map,
+        options.two_state(), options.default_net_type());
       continue;
     }
     if (CIRCUIT_MODEL_GATE == circuit_lib.model_type(circuit_model)) {
@@ -600,16 +642,10 @@ void print_verilog_submodule_essentials(const ModuleManager& module_manager,
 
   /* Close file handler*/
   fp.close();
-
-  /* Add fname to the netlist name list */
-  NetlistId nlist_id = NetlistId::INVALID();
-  if (options.use_relative_path()) {
-    nlist_id = netlist_manager.add_netlist(submodule_dir_name + verilog_fname);
-  } else {
-    nlist_id = netlist_manager.add_netlist(verilog_fpath);
-  }
-  VTR_ASSERT(nlist_id);
-  netlist_manager.set_netlist_type(nlist_id, NetlistManager::SUBMODULE_NETLIST);
+  /* Commit the file and add fname to the netlist name list */
+  commit_verilog_submodule_netlist(netlist_manager, verilog_staging_fpath,
+                                   verilog_fpath, submodule_dir_name,
+                                   verilog_fname, options);
 
   VTR_LOG("Done\n");
 }
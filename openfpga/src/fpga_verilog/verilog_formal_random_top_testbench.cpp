@@ -53,7 +53,8 @@ constexpr const char* FORMAL_TB_SIM_START_PORT_NAME = "sim_start";
 static void print_verilog_top_random_testbench_ports(
   std::fstream& fp, const ModuleManager& module_manager,
   const ModuleNameMap& module_name_map, const std::string& circuit_name,
-  const std::vector<std::string>& clock_port_names, const AtomContext& atom_ctx,
+  const std::vector<std::string>& clock_port_names,
+  const std::vector<BasicPort>& clock_ports, const AtomContext& atom_ctx,
   const VprNetlistAnnotation& netlist_annotation,
   const VerilogTestbenchOption& options) {
   /* Validate the file stream */
@@ -68,8 +69,6 @@ static void print_verilog_top_random_testbench_ports(
   /* Create a clock port if the benchmark does not have one!
    * The clock is used for counting and synchronizing input stimulus
    */
-  std::vector<BasicPort> clock_ports = generate_verilog_testbench_clock_port(
-    clock_port_names, std::string(DEFAULT_CLOCK_NAME));
   print_verilog_comment(
     fp, std::string("----- Default clock port is added here since benchmark "
                     "does not contain one -------"));
@@ -303,10 +302,14 @@ void print_verilog_random_top_testbench(
   std::vector<std::string> clock_port_names =
     find_atom_netlist_clock_port_names(atom_ctx.nlist, netlist_annotation);
 
+  /* Find clock port to be used */
+  std::vector<BasicPort> clock_ports = generate_verilog_testbench_clock_port(
+    clock_port_names, std::string(DEFAULT_CLOCK_NAME));
+
   /* Start of testbench */
   print_verilog_top_random_testbench_ports(
     fp, module_manager, module_name_map, circuit_name, clock_port_names,
-    atom_ctx, netlist_annotation, options);
+    clock_ports, atom_ctx, netlist_annotation, options);
 
   /* Call defined top-level module */
   print_verilog_random_testbench_fpga_instance(
@@ -320,10 +323,6 @@ void print_verilog_random_top_testbench(
       bus_group, options.explicit_port_mapping());
   }
 
-  /* Find clock port to be used */
-  std::vector<BasicPort> clock_ports = generate_verilog_testbench_clock_port(
-    clock_port_names, std::string(DEFAULT_CLOCK_NAME));
-
   /* Add stimuli for reset, set, clock and iopad signals */
   print_verilog_testbench_clock_stimuli(fp, pin_constraints,
                                         simulation_parameters, clock_ports);
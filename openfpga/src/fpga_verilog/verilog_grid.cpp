@@ -3,6 +3,7 @@
  * (CLBs, I/Os, heterogeneous blocks etc.)
  *******************************************************************/
 /* System header files */
+#include <algorithm>
 #include <fstream>
 #include <vector>
 
@@ -16,6 +17,7 @@
 
 /* Headers from openfpgautil library */
 #include "openfpga_digest.h"
+#include "openfpga_parallel.h"
 #include "openfpga_side_manager.h"
 
 /* Headers from vpr library */
@@ -24,10 +26,12 @@
 #include "openfpga_naming.h"
 #include "openfpga_physical_tile_utils.h"
 #include "openfpga_reserved_words.h"
+#include "openfpga_trace.h"
 #include "pb_type_utils.h"
 #include "verilog_constants.h"
 #include "verilog_grid.h"
 #include "verilog_module_writer.h"
+#include "verilog_submodule_utils.h"
 #include "verilog_writer_utils.h"
 #include "vpr_utils.h"
 
@@ -66,9 +70,11 @@ namespace openfpga {
  *******************************************************************/
 static void print_verilog_primitive_block(
   NetlistManager& netlist_manager, const ModuleManager& module_manager,
+  VerilogModuleWireLayout& wire_layout, VerilogNetlistPack* netlist_pack,
   const ModuleNameMap& module_name_map, const std::string& subckt_dir,
   const std::string& subckt_dir_name, t_pb_graph_node* primitive_pb_graph_node,
-  const FabricVerilogOption& options, const bool& verbose) {
+  const FabricVerilogOption& options, const bool& verbose,
+  const bool& show_progress) {
   /* Ensure a valid pb_graph_node */
   if (nullptr == primitive_pb_graph_node) {
     VTR_LOGF_ERROR(__FILE__, __LINE__, "Invalid primitive_pb_graph_node!\n");
@@ -82,15 +88,25 @@ static void print_verilog_primitive_block(
   /* Create the file name for Verilog */
   std::string verilog_fpath(subckt_dir + verilog_fname);
 
-  VTR_LOG("Writing Verilog netlist '%s' for primitive pb_type '%s' ...",
-          verilog_fpath.c_str(), primitive_pb_graph_node->pb_type->name);
-  VTR_LOGV(verbose, "\n");
+  /* The netlist of another partition is only added to the name list */
+  if (false == options.netlist_in_partition(verilog_fname)) {
+    add_verilog_netlist_to_manager(
+      netlist_manager, subckt_dir_name, verilog_fname, verilog_fpath,
+      NetlistManager::LOGIC_BLOCK_NETLIST, options);
+    return;
+  }
 
-  /* Create the file stream */
-  std::fstream fp;
-  fp.open(verilog_fpath, std::fstream::out | std::fstream::trunc);
+  VTR_LOGV(show_progress,
+           "Writing Verilog netlist '%s' for primitive pb_type '%s' ...",
+           verilog_fpath.c_str(), primitive_pb_graph_node->pb_type->name);
+  VTR_LOGV(verbose, "\n");
 
-  check_file_stream(verilog_fpath.c_str(), fp);
+  /* Create the file stream, unless the netlist is appended to a pack */
+  std::fstream netlist_fp;
+  std::string verilog_staging_fpath =
+    find_staging_file_path(verilog_fpath, options.keep_unchanged_files());
+  std::fstream& fp = open_verilog_netlist_stream(
+    netlist_fp, verilog_staging_fpath, netlist_pack);
 
   print_verilog_file_header(
     fp,
@@ -114,21 +130,17 @@ static void print_verilog_primitive_block(
 
   /* Write the verilog module */
   write_verilog_module_to_file(fp, module_manager, primitive_module, true,
-                               options.default_net_type());
-
-  /* Close file handler */
-  fp.close();
-
-  /* Add fname to the netlist name list */
-  NetlistId nlist_id = NetlistId::INVALID();
-  if (options.use_relative_path()) {
-    nlist_id = netlist_manager.add_netlist(subckt_dir_name + verilog_fname);
-  } else {
-    nlist_id = netlist_manager.add_netlist(verilog_fpath);
+                               options.default_net_type(), &wire_layout);
+
+  /* Close file handler. The netlists in a pack are added to the netlist
+   * name list by the shards of the pack */
+  if (true == close_verilog_netlist_stream(fp, verilog_staging_fpath,
+                                           verilog_fpath, netlist_pack)) {
+    /* Add fname to the netlist name list */
+    add_verilog_netlist_to_manager(
+      netlist_manager, subckt_dir_name, verilog_fname, verilog_fpath,
+      NetlistManager::LOGIC_BLOCK_NETLIST, options);
   }
-  VTR_ASSERT(nlist_id);
-  netlist_manager.set_netlist_type(nlist_id,
-                                   NetlistManager::LOGIC_BLOCK_NETLIST);
 
   VTR_LOGV(verbose, "Done\n");
 }
@@ -151,10 +163,12 @@ static void print_verilog_primitive_block(
  *******************************************************************/
 static void rec_print_verilog_logical_tile(
   NetlistManager& netlist_manager, const ModuleManager& module_manager,
+  VerilogModuleWireLayout& wire_layout, VerilogNetlistPack* netlist_pack,
   const ModuleNameMap& module_name_map,
   const VprDeviceAnnotation& device_annotation, const std::string& subckt_dir,
   const std::string& subckt_dir_name, t_pb_graph_node* physical_pb_graph_node,
-  const FabricVerilogOption& options, const bool& verbose) {
+  const FabricVerilogOption& options, const bool& verbose,
+  const bool& show_progress) {
   /* Check cur_pb_graph_node*/
   if (nullptr == physical_pb_graph_node) {
     VTR_LOGF_ERROR(__FILE__, __LINE__, "Invalid physical_pb_graph_node\n");
@@ -174,19 +188,20 @@ static void rec_print_verilog_logical_tile(
     for (int ipb = 0; ipb < physical_mode->num_pb_type_children; ++ipb) {
       /* Go recursive to visit the children */
       rec_print_verilog_logical_tile(
-        netlist_manager, module_manager, module_name_map, device_annotation,
-        subckt_dir, subckt_dir_name,
+        netlist_manager, module_manager, wire_layout, netlist_pack,
+        module_name_map, device_annotation, subckt_dir, subckt_dir_name,
         &(physical_pb_graph_node
             ->child_pb_graph_nodes[physical_mode->index][ipb][0]),
-        options, verbose);
+        options, verbose, show_progress);
     }
   }
 
   /* For leaf node, a primitive Verilog module will be generated. */
   if (true == is_primitive_pb_type(physical_pb_type)) {
-    print_verilog_primitive_block(netlist_manager, module_manager,
-                                  module_name_map, subckt_dir, subckt_dir_name,
-                                  physical_pb_graph_node, options, verbose);
+    print_verilog_primitive_block(
+      netlist_manager, module_manager, wire_layout, netlist_pack,
+      module_name_map, subckt_dir, subckt_dir_name, physical_pb_graph_node,
+      options, verbose, show_progress);
     /* Finish for primitive node, return */
     return;
   }
@@ -198,15 +213,24 @@ static void rec_print_verilog_logical_tile(
     std::string(VERILOG_NETLIST_FILE_POSTFIX)));
   std::string verilog_fpath(subckt_dir + verilog_fname);
 
-  VTR_LOG("Writing Verilog netlist '%s' for pb_type '%s' ...",
-          verilog_fpath.c_str(), physical_pb_type->name);
-  VTR_LOGV(verbose, "\n");
+  /* The netlist of another partition is only added to the name list */
+  if (false == options.netlist_in_partition(verilog_fname)) {
+    add_verilog_netlist_to_manager(
+      netlist_manager, subckt_dir_name, verilog_fname, verilog_fpath,
+      NetlistManager::LOGIC_BLOCK_NETLIST, options);
+    return;
+  }
 
-  /* Create the file stream */
-  std::fstream fp;
-  fp.open(verilog_fpath, std::fstream::out | std::fstream::trunc);
+  VTR_LOGV(show_progress, "Writing Verilog netlist '%s' for pb_type '%s' ...",
+           verilog_fpath.c_str(), physical_pb_type->name);
+  VTR_LOGV(verbose, "\n");
 
-  check_file_stream(verilog_fpath.c_str(), fp);
+  /* Create the file stream, unless the netlist is appended to a pack */
+  std::fstream netlist_fp;
+  std::string verilog_staging_fpath =
+    find_staging_file_path(verilog_fpath, options.keep_unchanged_files());
+  std::fstream& fp = open_verilog_netlist_stream(
+    netlist_fp, verilog_staging_fpath, netlist_pack);
 
   print_verilog_file_header(fp,
                             std::string("Verilog modules for pb_type: " +
@@ -234,26 +258,22 @@ static void rec_print_verilog_logical_tile(
   /* Write the verilog module */
   write_verilog_module_to_file(fp, module_manager, pb_module,
                                options.explicit_port_mapping(),
-                               options.default_net_type());
+                               options.default_net_type(), &wire_layout);
 
   print_verilog_comment(
     fp,
     std::string("----- END Physical programmable logic block Verilog module: " +
                 std::string(physical_pb_type->name) + " -----"));
 
-  /* Close file handler */
-  fp.close();
-
-  /* Add fname to the netlist name list */
-  NetlistId nlist_id = NetlistId::INVALID();
-  if (options.use_relative_path()) {
-    nlist_id = netlist_manager.add_netlist(subckt_dir_name + verilog_fname);
-  } else {
-    nlist_id = netlist_manager.add_netlist(verilog_fpath);
+  /* Close file handler. The netlists in a pack are added to the netlist
+   * name list by the shards of the pack */
+  if (true == close_verilog_netlist_stream(fp, verilog_staging_fpath,
+                                           verilog_fpath, netlist_pack)) {
+    /* Add fname to the netlist name list */
+    add_verilog_netlist_to_manager(
+      netlist_manager, subckt_dir_name, verilog_fname, verilog_fpath,
+      NetlistManager::LOGIC_BLOCK_NETLIST, options);
   }
-  VTR_ASSERT(nlist_id);
-  netlist_manager.set_netlist_type(nlist_id,
-                                   NetlistManager::LOGIC_BLOCK_NETLIST);
 
   VTR_LOGV(verbose, "Done\n");
 }
@@ -264,13 +284,15 @@ static void rec_print_verilog_logical_tile(
  *****************************************************************************/
 static void print_verilog_logical_tile_netlist(
   NetlistManager& netlist_manager, const ModuleManager& module_manager,
+  VerilogModuleWireLayout& wire_layout, VerilogNetlistPack* netlist_pack,
   const ModuleNameMap& module_name_map,
   const VprDeviceAnnotation& device_annotation, const std::string& subckt_dir,
   const std::string& subckt_dir_name, t_pb_graph_node* pb_graph_head,
-  const FabricVerilogOption& options, const bool& verbose) {
-  VTR_LOG("Writing Verilog netlists for logic tile '%s' ...",
-          pb_graph_head->pb_type->name);
-  VTR_LOG("\n");
+  const FabricVerilogOption& options, const bool& verbose,
+  const bool& show_progress) {
+  VTR_LOGV(show_progress, "Writing Verilog netlists for logic tile '%s' ...",
+           pb_graph_head->pb_type->name);
+  VTR_LOGV(show_progress, "\n");
 
   /* Print Verilog modules for all the pb_types/pb_graph_nodes
    * use a Depth-First Search Algorithm to print the sub-modules
@@ -281,11 +303,12 @@ static void print_verilog_logical_tile_netlist(
   /* Print Verilog modules starting from the top-level pb_type/pb_graph_node,
    * and traverse the graph in a recursive way */
   rec_print_verilog_logical_tile(
-    netlist_manager, module_manager, module_name_map, device_annotation,
-    subckt_dir, subckt_dir_name, pb_graph_head, options, verbose);
+    netlist_manager, module_manager, wire_layout, netlist_pack, module_name_map,
+    device_annotation, subckt_dir, subckt_dir_name, pb_graph_head, options,
+    verbose, show_progress);
 
-  VTR_LOG("Done\n");
-  VTR_LOG("\n");
+  VTR_LOGV(show_progress, "Done\n");
+  VTR_LOGV(show_progress, "\n");
 }
 
 /*****************************************************************************
@@ -298,9 +321,11 @@ static void print_verilog_logical_tile_netlist(
  *****************************************************************************/
 static void print_verilog_physical_tile_netlist(
   NetlistManager& netlist_manager, const ModuleManager& module_manager,
+  VerilogModuleWireLayout& wire_layout, VerilogNetlistPack* netlist_pack,
   const ModuleNameMap& module_name_map, const std::string& subckt_dir,
   const std::string& subckt_dir_name, t_physical_tile_type_ptr phy_block_type,
-  const e_side& border_side, const FabricVerilogOption& options) {
+  const e_side& border_side, const FabricVerilogOption& options,
+  const bool& show_progress) {
   /* Give a name to the Verilog netlist */
   std::string verilog_fname(generate_grid_block_netlist_name(
     std::string(GRID_MODULE_NAME_PREFIX) + std::string(phy_block_type->name),
@@ -310,22 +335,33 @@ static void print_verilog_physical_tile_netlist(
   /* Create the file name for Verilog */
   std::string verilog_fpath(subckt_dir + verilog_fname);
 
+  /* The netlist of another partition is only added to the name list */
+  if (false == options.netlist_in_partition(verilog_fname)) {
+    add_verilog_netlist_to_manager(
+      netlist_manager, subckt_dir_name, verilog_fname, verilog_fpath,
+      NetlistManager::LOGIC_BLOCK_NETLIST, options);
+    return;
+  }
+
   /* Echo status */
   if (true == is_io_type(phy_block_type)) {
     SideManager side_manager(border_side);
-    VTR_LOG(
+    VTR_LOGV(
+      show_progress,
       "Writing Verilog Netlist '%s' for physical tile '%s' at %s side ...",
       verilog_fpath.c_str(), phy_block_type->name, side_manager.c_str());
   } else {
-    VTR_LOG("Writing Verilog Netlist '%s' for physical_tile '%s'...",
-            verilog_fpath.c_str(), phy_block_type->name);
+    VTR_LOGV(show_progress,
+             "Writing Verilog Netlist '%s' for physical_tile '%s'...",
+             verilog_fpath.c_str(), phy_block_type->name);
   }
 
-  /* Create the file stream */
-  std::fstream fp;
-  fp.open(verilog_fpath, std::fstream::out | std::fstream::trunc);
-
-  check_file_stream(verilog_fpath.c_str(), fp);
+  /* Create the file stream, unless the netlist is appended to a pack */
+  std::fstream netlist_fp;
+  std::string verilog_staging_fpath =
+    find_staging_file_path(verilog_fpath, options.keep_unchanged_files());
+  std::fstream& fp = open_verilog_netlist_stream(
+    netlist_fp, verilog_staging_fpath, netlist_pack);
 
   print_verilog_file_header(
     fp,
@@ -348,7 +384,7 @@ static void print_verilog_physical_tile_netlist(
                     module_manager.module_name(grid_module) + " -----"));
   write_verilog_module_to_file(fp, module_manager, grid_module,
                                options.explicit_port_mapping(),
-                               options.default_net_type());
+                               options.default_net_type(), &wire_layout);
 
   print_verilog_comment(
     fp, std::string("----- END Grid Verilog module: " +
@@ -357,21 +393,17 @@ static void print_verilog_physical_tile_netlist(
   /* Add an empty line as a splitter */
   fp << std::endl;
 
-  /* Close file handler */
-  fp.close();
-
-  /* Add fname to the netlist name list */
-  NetlistId nlist_id = NetlistId::INVALID();
-  if (options.use_relative_path()) {
-    nlist_id = netlist_manager.add_netlist(subckt_dir_name + verilog_fname);
-  } else {
-    nlist_id = netlist_manager.add_netlist(verilog_fpath);
+  /* Close file handler. The netlists in a pack are added to the netlist
+   * name list by the shards of the pack */
+  if (true == close_verilog_netlist_stream(fp, verilog_staging_fpath,
+                                           verilog_fpath, netlist_pack)) {
+    /* Add fname to the netlist name list */
+    add_verilog_netlist_to_manager(
+      netlist_manager, subckt_dir_name, verilog_fname, verilog_fpath,
+      NetlistManager::LOGIC_BLOCK_NETLIST, options);
   }
-  VTR_ASSERT(nlist_id);
-  netlist_manager.set_netlist_type(nlist_id,
-                                   NetlistManager::LOGIC_BLOCK_NETLIST);
 
-  VTR_LOG("Done\n");
+  VTR_LOGV(show_progress, "Done\n");
 }
 
 /*****************************************************************************
@@ -382,14 +414,27 @@ static void print_verilog_physical_tile_netlist(
  ****************************************************************************/
 void print_verilog_grids(
   NetlistManager& netlist_manager, const ModuleManager& module_manager,
+  VerilogModuleWireLayout& wire_layout, VerilogNetlistPack* netlist_pack,
   const ModuleNameMap& module_name_map, const DeviceContext& device_ctx,
   const VprDeviceAnnotation& device_annotation, const std::string& subckt_dir,
   const std::string& subckt_dir_name, const FabricVerilogOption& options,
   const bool& verbose) {
+  TraceScope trace_scope("print_verilog_grids");
   /* Create a vector to contain all the Verilog netlist names that have been
    * generated in this function */
   std::vector<std::string> netlist_names;
 
+  /* Each module is written to a separated netlist while the module manager is
+   * only read, so the netlists can be written by a pool of threads. Progress
+   * is only reported when a single thread is used, to avoid interleaved logs
+   */
+  bool show_progress = (1 == find_num_threads(options.num_threads()));
+
+  /* Logical and physical tiles which are not used by the fabric are not
+   * written when required */
+  vtr::vector<ModuleId, bool> modules_to_write =
+    find_verilog_modules_to_write(module_manager, module_name_map, options);
+
   /* Enumerate the types of logical tiles, and build a module for each
    * Write modules for all the pb_types/pb_graph_nodes
    * use a Depth-First Search Algorithm to print the sub-modules
@@ -398,17 +443,36 @@ void print_verilog_grids(
    * to its parent in module manager
    */
   VTR_LOG("Writing logical tiles...");
-  VTR_LOGV(verbose, "\n");
+  VTR_LOGV(verbose && show_progress, "\n");
+  std::vector<t_pb_graph_node*> pb_graph_heads;
   for (const t_logical_block_type& logical_tile :
        device_ctx.logical_block_types) {
     /* Bypass empty pb_graph */
     if (nullptr == logical_tile.pb_graph_head) {
       continue;
     }
-    print_verilog_logical_tile_netlist(
-      netlist_manager, module_manager, module_name_map, device_annotation,
-      subckt_dir, subckt_dir_name, logical_tile.pb_graph_head, options,
-      verbose);
+    ModuleId logical_tile_module = module_manager.find_module(
+      module_name_map.name(generate_physical_block_module_name(
+        logical_tile.pb_graph_head->pb_type)));
+    if (false ==
+        is_verilog_module_to_write(modules_to_write, logical_tile_module)) {
+      continue;
+    }
+    pb_graph_heads.push_back(logical_tile.pb_graph_head);
+  }
+  /* Each task registers its netlists in its own netlist manager. They are
+   * imported in the order of the tasks, as a single thread does */
+  std::vector<NetlistManager> logical_tile_netlists(pb_graph_heads.size());
+  parallel_for(
+    pb_graph_heads.size(), options.num_threads(), [&](const size_t& itile) {
+      print_verilog_logical_tile_netlist(
+        logical_tile_netlists[itile], module_manager, wire_layout, netlist_pack,
+        module_name_map, device_annotation, subckt_dir, subckt_dir_name,
+        pb_graph_heads[itile], options, verbose && show_progress,
+        show_progress);
+    });
+  for (const NetlistManager& netlists : logical_tile_netlists) {
+    netlist_manager.import_netlists(netlists);
   }
   VTR_LOG("Writing logical tiles...");
   VTR_LOG("Done\n");
@@ -419,7 +483,8 @@ void print_verilog_grids(
    * Use the logical tile module to build the physical tiles
    */
   VTR_LOG("Building physical tiles...");
-  VTR_LOGV(verbose, "\n");
+  VTR_LOGV(verbose && show_progress, "\n");
+  std::vector<std::pair<t_physical_tile_type_ptr, e_side>> physical_tiles;
   for (const t_physical_tile_type& physical_tile :
        device_ctx.physical_tile_types) {
     /* Bypass empty type or nullptr */
@@ -438,18 +503,45 @@ void print_verilog_grids(
       std::set<e_side> io_type_sides =
         find_physical_io_tile_located_sides(device_ctx.grid, &physical_tile);
       for (const e_side& io_type_side : io_type_sides) {
-        print_verilog_physical_tile_netlist(
-          netlist_manager, module_manager, module_name_map, subckt_dir,
-          subckt_dir_name, &physical_tile, io_type_side, options);
+        physical_tiles.push_back(std::make_pair(&physical_tile, io_type_side));
       }
       continue;
     } else {
       /* For CLB and heterogenenous blocks */
-      print_verilog_physical_tile_netlist(
-        netlist_manager, module_manager, module_name_map, subckt_dir,
-        subckt_dir_name, &physical_tile, NUM_SIDES, options);
+      physical_tiles.push_back(std::make_pair(&physical_tile, NUM_SIDES));
     }
   }
+  /* Bypass the physical tiles whose modules are not used, or are merged into
+   * identical modules, which are written for other physical tiles */
+  physical_tiles.erase(
+    std::remove_if(
+      physical_tiles.begin(), physical_tiles.end(),
+      [&](const std::pair<t_physical_tile_type_ptr, e_side>& physical_tile) {
+        std::string grid_module_name = generate_grid_block_module_name(
+          std::string(GRID_VERILOG_FILE_NAME_PREFIX),
+          std::string(physical_tile.first->name),
+          is_io_type(physical_tile.first), physical_tile.second);
+        if (true == module_name_map.tag_is_alias(grid_module_name)) {
+          return true;
+        }
+        ModuleId grid_module =
+          module_manager.find_module(module_name_map.name(grid_module_name));
+        return false ==
+               is_verilog_module_to_write(modules_to_write, grid_module);
+      }),
+    physical_tiles.end());
+  std::vector<NetlistManager> physical_tile_netlists(physical_tiles.size());
+  parallel_for(
+    physical_tiles.size(), options.num_threads(), [&](const size_t& itile) {
+      print_verilog_physical_tile_netlist(
+        physical_tile_netlists[itile], module_manager, wire_layout,
+        netlist_pack, module_name_map, subckt_dir, subckt_dir_name,
+        physical_tiles[itile].first, physical_tiles[itile].second, options,
+        show_progress);
+    });
+  for (const NetlistManager& netlists : physical_tile_netlists) {
+    netlist_manager.import_netlists(netlists);
+  }
   VTR_LOG("Building physical tiles...");
   VTR_LOG("Done\n");
   VTR_LOG("\n");
@@ -10,6 +10,8 @@
 #include "module_manager.h"
 #include "module_name_map.h"
 #include "netlist_manager.h"
+#include "verilog_module_wire_layout.h"
+#include "verilog_netlist_pack.h"
 #include "vpr_context.h"
 #include "vpr_device_annotation.h"
 
@@ -22,6 +24,7 @@ namespace openfpga {
 
 void print_verilog_grids(
   NetlistManager& netlist_manager, const ModuleManager& module_manager,
+  VerilogModuleWireLayout& wire_layout, VerilogNetlistPack* netlist_pack,
   const ModuleNameMap& module_name_map, const DeviceContext& device_ctx,
   const VprDeviceAnnotation& device_annotation, const std::string& subckt_dir,
   const std::string& subckt_dir_name, const FabricVerilogOption& options,
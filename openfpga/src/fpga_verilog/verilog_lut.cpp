@@ -17,6 +17,7 @@
 #include "verilog_constants.h"
 #include "verilog_lut.h"
 #include "verilog_module_writer.h"
+#include "verilog_submodule_utils.h"
 #include "verilog_writer_utils.h"
 
 /* begin namespace openfpga */
@@ -39,15 +40,20 @@ void print_verilog_submodule_luts(const ModuleManager& module_manager,
   std::fstream fp;
 
   /* Create the file stream */
-  fp.open(verilog_fpath, std::fstream::out | std::fstream::trunc);
+  std::string verilog_staging_fpath =
+    find_staging_file_path(verilog_fpath, options.keep_unchanged_files());
+  fp.open(verilog_staging_fpath, std::fstream::out | std::fstream::trunc);
   /* Check if the file stream if valid or not */
-  check_file_stream(verilog_fpath.c_str(), fp);
+  check_file_stream(verilog_staging_fpath.c_str(), fp);
 
   /* Create file */
   VTR_LOG("Writing Verilog netlist for LUTs '%s'...", verilog_fpath.c_str());
 
   print_verilog_file_header(fp, "Look-Up Tables", options.time_stamp());
 
+  vtr::vector<ModuleId, bool> modules_to_write =
+    find_verilog_modules_to_write(module_manager, module_name_map, options);
+
   /* Search for each LUT circuit model */
   for (const auto& lut_model : circuit_lib.models()) {
     /* Bypass user-defined and non-LUT modules */
@@ -59,6 +65,9 @@ void print_verilog_submodule_luts(const ModuleManager& module_manager,
     ModuleId lut_module = module_manager.find_module(
       module_name_map.name(circuit_lib.model_name(lut_model)));
     VTR_ASSERT(true == module_manager.valid_module_id(lut_module));
+    if (false == is_verilog_module_to_write(modules_to_write, lut_module)) {
+      continue;
+    }
     write_verilog_module_to_file(
       fp, module_manager, lut_module,
       options.explicit_port_mapping() ||
@@ -68,16 +77,10 @@ void print_verilog_submodule_luts(const ModuleManager& module_manager,
 
   /* Close the file handler */
   fp.close();
-
-  /* Add fname to the netlist name list */
-  NetlistId nlist_id = NetlistId::INVALID();
-  if (options.use_relative_path()) {
-    nlist_id = netlist_manager.add_netlist(submodule_dir_name + verilog_fname);
-  } else {
-    nlist_id = netlist_manager.add_netlist(verilog_fpath);
-  }
-  VTR_ASSERT(nlist_id);
-  netlist_manager.set_netlist_type(nlist_id, NetlistManager::SUBMODULE_NETLIST);
+  /* Commit the file and add fname to the netlist name list */
+  commit_verilog_submodule_netlist(netlist_manager, verilog_staging_fpath,
+                                   verilog_fpath, submodule_dir_name,
+                                   verilog_fname, options);
 
   VTR_LOG("Done\n");
 }
@@ -21,6 +21,7 @@
 #include "verilog_constants.h"
 #include "verilog_memory.h"
 #include "verilog_module_writer.h"
+#include "verilog_submodule_utils.h"
 #include "verilog_writer_utils.h"
 
 /* begin namespace openfpga */
@@ -42,7 +43,9 @@ namespace openfpga {
 static void print_verilog_mux_memory_module(
   const ModuleManager& module_manager, const CircuitLibrary& circuit_lib,
   std::fstream& fp, const CircuitModelId& mux_model, const MuxGraph& mux_graph,
-  const ModuleNameMap& module_name_map, const FabricVerilogOption& options) {
+  const ModuleNameMap& module_name_map,
+  const vtr::vector<ModuleId, bool>& modules_to_write,
+  const FabricVerilogOption& options) {
   /* Multiplexers built with different technology is in different organization
    */
   switch (circuit_lib.design_tech_type(mux_model)) {
@@ -56,15 +59,17 @@ static void print_verilog_mux_memory_module(
       module_name = module_name_map.name(module_name);
       ModuleId mem_module = module_manager.find_module(module_name);
       VTR_ASSERT(true == module_manager.valid_module_id(mem_module));
-      /* Write the module content in Verilog format */
-      write_verilog_module_to_file(
-        fp, module_manager, mem_module,
-        options.explicit_port_mapping() ||
-          circuit_lib.dump_explicit_port_map(mux_model),
-        options.default_net_type());
+      if (true == is_verilog_module_to_write(modules_to_write, mem_module)) {
+        /* Write the module content in Verilog format */
+        write_verilog_module_to_file(
+          fp, module_manager, mem_module,
+          options.explicit_port_mapping() ||
+            circuit_lib.dump_explicit_port_map(mux_model),
+          options.default_net_type());
 
-      /* Add an empty line as a splitter */
-      fp << std::endl;
+        /* Add an empty line as a splitter */
+        fp << std::endl;
+      }
 
       /* Print feedthrough memory if exists */
       std::string feedthru_module_name = generate_mux_subckt_name(
@@ -77,8 +82,9 @@ static void print_verilog_mux_memory_module(
       }
       ModuleId feedthru_mem_module =
         module_manager.find_module(feedthru_module_name);
-      if (module_manager.valid_module_id(feedthru_mem_module)) {
-        VTR_ASSERT(true == module_manager.valid_module_id(feedthru_mem_module));
+      if ((module_manager.valid_module_id(feedthru_mem_module)) &&
+          (true ==
+           is_verilog_module_to_write(modules_to_write, feedthru_mem_module))) {
         /* Write the module content in Verilog format */
         write_verilog_module_to_file(
           fp, module_manager, feedthru_mem_module,
@@ -133,9 +139,11 @@ void print_verilog_submodule_memories(
 
   /* Create the file stream */
   std::fstream fp;
-  fp.open(verilog_fpath, std::fstream::out | std::fstream::trunc);
+  std::string verilog_staging_fpath =
+    find_staging_file_path(verilog_fpath, options.keep_unchanged_files());
+  fp.open(verilog_staging_fpath, std::fstream::out | std::fstream::trunc);
 
-  check_file_stream(verilog_fpath.c_str(), fp);
+  check_file_stream(verilog_staging_fpath.c_str(), fp);
 
   /* Print out debugging information for if the file is not opened/created
    * properly */
@@ -144,6 +152,9 @@ void print_verilog_submodule_memories(
 
   print_verilog_file_header(fp, "Memories used in FPGA", options.time_stamp());
 
+  vtr::vector<ModuleId, bool> modules_to_write =
+    find_verilog_modules_to_write(module_manager, module_name_map, options);
+
   /* Create the memory circuits for the multiplexer */
   for (auto mux : mux_lib.muxes()) {
     const MuxGraph& mux_graph = mux_lib.mux_graph(mux);
@@ -157,7 +168,8 @@ void print_verilog_submodule_memories(
     }
     /* Create a Verilog module for the memories used by the multiplexer */
     print_verilog_mux_memory_module(module_manager, circuit_lib, fp, mux_model,
-                                    mux_graph, module_name_map, options);
+                                    mux_graph, module_name_map,
+                                    modules_to_write, options);
   }
 
   /* Create the memory circuits for non-MUX circuit models.
@@ -204,14 +216,17 @@ void print_verilog_submodule_memories(
 
     ModuleId mem_module = module_manager.find_module(module_name);
     VTR_ASSERT(true == module_manager.valid_module_id(mem_module));
-    /* Write the module content in Verilog format */
-    write_verilog_module_to_file(fp, module_manager, mem_module,
-                                 options.explicit_port_mapping() ||
-                                   circuit_lib.dump_explicit_port_map(model),
-                                 options.default_net_type());
+    /* Skip the memories of the circuit models which are not used */
+    if (true == is_verilog_module_to_write(modules_to_write, mem_module)) {
+      /* Write the module content in Verilog format */
+      write_verilog_module_to_file(fp, module_manager, mem_module,
+                                   options.explicit_port_mapping() ||
+                                     circuit_lib.dump_explicit_port_map(model),
+                                   options.default_net_type());
 
-    /* Add an empty line as a splitter */
-    fp << std::endl;
+      /* Add an empty line as a splitter */
+      fp << std::endl;
+    }
 
     /* Create the module name for the memory block */
     std::string feedthru_module_name =
@@ -223,7 +238,9 @@ void print_verilog_submodule_memories(
 
     ModuleId feedthru_mem_module =
       module_manager.find_module(feedthru_module_name);
-    if (module_manager.valid_module_id(feedthru_mem_module)) {
+    if ((module_manager.valid_module_id(feedthru_mem_module)) &&
+        (true ==
+         is_verilog_module_to_write(modules_to_write, feedthru_mem_module))) {
       /* Write the module content in Verilog format */
       write_verilog_module_to_file(fp, module_manager, feedthru_mem_module,
                                    options.explicit_port_mapping() ||
@@ -238,6 +255,10 @@ void print_verilog_submodule_memories(
   /* Include memory group modules */
   for (ModuleId mem_group_module : module_manager.modules_by_usage(
          ModuleManager::e_module_usage_type::MODULE_CONFIG_GROUP)) {
+    if (false ==
+        is_verilog_module_to_write(modules_to_write, mem_group_module)) {
+      continue;
+    }
     /* Write the module content in Verilog format */
     write_verilog_module_to_file(fp, module_manager, mem_group_module,
                                  options.explicit_port_mapping(),
@@ -249,16 +270,10 @@ void print_verilog_submodule_memories(
 
   /* Close the file stream */
   fp.close();
-
-  /* Add fname to the netlist name list */
-  NetlistId nlist_id = NetlistId::INVALID();
-  if (options.use_relative_path()) {
-    nlist_id = netlist_manager.add_netlist(submodule_dir_name + verilog_fname);
-  } else {
-    nlist_id = netlist_manager.add_netlist(verilog_fpath);
-  }
-  VTR_ASSERT(nlist_id);
-  netlist_manager.set_netlist_type(nlist_id, NetlistManager::SUBMODULE_NETLIST);
+  /* Commit the file and add fname to the netlist name list */
+  commit_verilog_submodule_netlist(netlist_manager, verilog_staging_fpath,
+                                   verilog_fpath, submodule_dir_name,
+                                   verilog_fname, options);
 
   VTR_LOG("Done\n");
 }
@@ -0,0 +1,54 @@
+/********************************************************************
+ * This file includes functions to build the port signature of a module,
+ * which is used by the Verilog writers to declare and instantiate it
+ *******************************************************************/
+/* Headers from vtrutil library */
+#include "vtr_assert.h"
+
+/* Headers from openfpgautil library */
+#include "verilog_module_port_signature.h"
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+/********************************************************************
+ * Build the port signature of a module
+ * The ports are first bucketed by their types, which keeps the order in
+ * which they are added to the module, and then concatenated in the order
+ * of port types
+ *******************************************************************/
+VerilogModulePortSignature build_verilog_module_port_signature(
+  const ModuleManager& module_manager, const ModuleId& module_id) {
+  VTR_ASSERT(module_manager.valid_module_id(module_id));
+
+  std::vector<std::vector<ModulePortId>> port_ids_by_type(
+    ModuleManager::NUM_MODULE_PORT_TYPES);
+  size_t num_ports = 0;
+  for (const ModulePortId& port_id : module_manager.module_ports(module_id)) {
+    port_ids_by_type[module_manager.port_type(module_id, port_id)].push_back(
+      port_id);
+    num_ports++;
+  }
+
+  VerilogModulePortSignature signature;
+  signature.reserve(num_ports);
+  for (size_t port_type = 0; port_type < ModuleManager::NUM_MODULE_PORT_TYPES;
+       ++port_type) {
+    for (const ModulePortId& port_id : port_ids_by_type[port_type]) {
+      VerilogModulePort module_port;
+      module_port.id = port_id;
+      module_port.type = ModuleManager::e_module_port_type(port_type);
+      module_port.port = module_manager.module_port(module_id, port_id);
+      module_port.preproc_flag =
+        module_manager.port_preproc_flag(module_id, port_id);
+      module_port.is_wire = module_manager.port_is_wire(module_id, port_id);
+      module_port.is_register =
+        module_manager.port_is_register(module_id, port_id);
+      signature.push_back(std::move(module_port));
+    }
+  }
+
+  return signature;
+}
+
+} /* end namespace openfpga */
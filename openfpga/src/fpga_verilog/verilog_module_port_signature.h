@@ -0,0 +1,48 @@
+#ifndef VERILOG_MODULE_PORT_SIGNATURE_H
+#define VERILOG_MODULE_PORT_SIGNATURE_H
+
+/********************************************************************
+ * Include header files required by the data structure definition
+ *******************************************************************/
+#include <string>
+#include <vector>
+
+#include "module_manager.h"
+#include "openfpga_port.h"
+
+/* namespace openfpga begins */
+namespace openfpga {
+
+/********************************************************************
+ * A port of a module, with all the attributes required to declare it
+ * or to instantiate it in Verilog
+ *******************************************************************/
+struct VerilogModulePort {
+  ModulePortId id;
+  ModuleManager::e_module_port_type type;
+  BasicPort port;
+  std::string preproc_flag;
+  bool is_wire;
+  bool is_register;
+};
+
+/********************************************************************
+ * The port signature of a module lists all its ports in the order to be
+ * written in Verilog, i.e., in the order of port types in module manager
+ * and then in the order they are added to the module.
+ *
+ * A signature is built once in a single pass over the ports of a module,
+ * so that the writers of module declarations and instances can print the
+ * ports without querying the module manager port by port.
+ *******************************************************************/
+typedef std::vector<VerilogModulePort> VerilogModulePortSignature;
+
+/********************************************************************
+ * Function declaration
+ *******************************************************************/
+VerilogModulePortSignature build_verilog_module_port_signature(
+  const ModuleManager& module_manager, const ModuleId& module_id);
+
+} /* end namespace openfpga */
+
+#endif
@@ -0,0 +1,340 @@
+/********************************************************************
+ * This file includes functions to find the local wires of a Verilog
+ * module and member functions for class VerilogModuleWireLayout
+ *******************************************************************/
+#include "verilog_module_wire_layout.h"
+
+#include <algorithm>
+
+/* Headers from vtrutil library */
+#include "vtr_assert.h"
+
+/* Headers from openfpgautil library */
+#include "module_manager_utils.h"
+#include "openfpga_symbol_table.h"
+#include "verilog_writer_utils.h"
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+/********************************************************************
+ * Generate the name of a local wire for a undriven port inside Verilog
+ * module
+ *******************************************************************/
+std::string generate_verilog_undriven_local_wire_name(
+  const ModuleManager& module_manager, const ModuleId& parent,
+  const ModuleId& child, const size_t& instance_id,
+  const ModulePortId& child_port_id) {
+  std::string wire_name =
+    module_manager.instance_name(parent, child, instance_id);
+  if (true == wire_name.empty()) {
+    wire_name = module_manager.module_name(child);
+    wire_name += '_';
+    append_verilog_number(wire_name, instance_id);
+    wire_name += '_';
+  }
+
+  wire_name += "_undriven_";
+  wire_name += symbol_string(
+    module_manager.module_port(child, child_port_id).get_name_symbol());
+
+  return wire_name;
+}
+
+/********************************************************************
+ * Name a net for a local wire for a verilog module
+ * 1. If this is a local wire, name it after the
+ *<src_module_name>_<instance_id>_<src_port_name>
+ *    When instance arrays are used, the local wires driven by the same
+ *    port of all the instances are merged into a bus
+ *<src_module_name>_<src_port_name>_array
+ *    where the pins of each instance are placed one after another
+ * 2. If this is not a local wire, name it after the port name of parent module
+ *
+ * In addition, it will assign the pin index as well
+ *
+ * Restriction: this function requires each net has single driver
+ * which is definitely always true in circuits.
+ *******************************************************************/
+BasicPort generate_verilog_port_for_module_net(
+  const ModuleManager& module_manager, const ModuleId& module_id,
+  const ModuleNetId& module_net, const bool& use_instance_arrays) {
+  BasicPort port_to_return;
+  /* Check all the sink modules of the net,
+   * if we have a source module is the current module, this is not local wire
+   */
+  for (ModuleNetSrcId src_id :
+       module_manager.module_net_sources(module_id, module_net)) {
+    if (module_id ==
+        module_manager.net_source_modules(module_id, module_net)[src_id]) {
+      /* Here, this is not a local wire, return the port name of the src_port */
+      ModulePortId net_src_port =
+        module_manager.net_source_ports(module_id, module_net)[src_id];
+      size_t src_pin_index =
+        module_manager.net_source_pins(module_id, module_net)[src_id];
+      port_to_return.set(module_manager.module_port(module_id, net_src_port));
+      port_to_return.set_width(src_pin_index, src_pin_index);
+      port_to_return.set_origin_port_width(
+        module_manager.module_port(module_id, net_src_port).get_width());
+      return port_to_return;
+    }
+  }
+
+  /* Check all the sink modules of the net */
+  for (ModuleNetSinkId sink_id :
+       module_manager.module_net_sinks(module_id, module_net)) {
+    if (module_id ==
+        module_manager.net_sink_modules(module_id, module_net)[sink_id]) {
+      /* Here, this is not a local wire, return the port name of the sink_port
+       */
+      ModulePortId net_sink_port =
+        module_manager.net_sink_ports(module_id, module_net)[sink_id];
+      size_t sink_pin_index =
+        module_manager.net_sink_pins(module_id, module_net)[sink_id];
+      port_to_return.set(module_manager.module_port(module_id, net_sink_port));
+      port_to_return.set_width(sink_pin_index, sink_pin_index);
+      port_to_return.set_origin_port_width(
+        module_manager.module_port(module_id, net_sink_port).get_width());
+      return port_to_return;
+    }
+  }
+
+  /* Reach here, this is a local wire */
+  std::string net_name;
+
+  /* Each net must only one 1 source */
+  VTR_ASSERT(1 ==
+             module_manager.net_source_modules(module_id, module_net).size());
+
+  /* Get the source module */
+  ModuleId net_src_module =
+    module_manager.net_source_modules(module_id, module_net)[ModuleNetSrcId(0)];
+  /* Get the instance id */
+  size_t net_src_instance = module_manager.net_source_instances(
+    module_id, module_net)[ModuleNetSrcId(0)];
+  /* Get the port id */
+  ModulePortId net_src_port =
+    module_manager.net_source_ports(module_id, module_net)[ModuleNetSrcId(0)];
+  /* Get the pin id */
+  size_t net_src_pin =
+    module_manager.net_source_pins(module_id, module_net)[ModuleNetSrcId(0)];
+
+  /* Load user-defined name if we have it */
+  if (false == module_manager.net_name(module_id, module_net).empty()) {
+    net_name = module_manager.net_name(module_id, module_net);
+  } else if (true == use_instance_arrays) {
+    size_t src_port_width =
+      module_manager.module_port(net_src_module, net_src_port).get_width();
+    net_name = module_manager.module_name(net_src_module);
+    net_name += '_';
+    net_name +=
+      module_manager.module_port(net_src_module, net_src_port).get_name();
+    net_name += "_array";
+    size_t array_pin = net_src_instance * src_port_width + net_src_pin;
+    port_to_return.set_name(net_name);
+    port_to_return.set_width(array_pin, array_pin);
+    port_to_return.set_origin_port_width(
+      module_manager.num_instance(module_id, net_src_module) * src_port_width);
+    return port_to_return;
+  } else {
+    net_name = module_manager.module_name(net_src_module);
+    net_name +=
+      std::string("_") + std::to_string(net_src_instance) + std::string("_");
+    net_name +=
+      module_manager.module_port(net_src_module, net_src_port).get_name();
+  }
+
+  port_to_return.set_name(net_name);
+  port_to_return.set_width(net_src_pin, net_src_pin);
+  port_to_return.set_origin_port_width(
+    module_manager.module_port(net_src_module, net_src_port).get_width());
+  return port_to_return;
+}
+
+/********************************************************************
+ * Find all the nets that are going to be local wires
+ * And organize it in a vector of ports
+ * Verilog wire writter function will use the output of this function
+ * to write up local wire declaration in Verilog format
+ *
+ * Local wires are grouped by their names, and each group is sorted by
+ * the name. Pins of a group are merged into index ranges as much as
+ * possible
+ *******************************************************************/
+std::vector<BasicPort> find_verilog_module_local_wires(
+  const ModuleManager& module_manager, const ModuleId& module_id,
+  const bool& use_instance_arrays) {
+  /* Local wires are grouped by the handle of their names, so that a
+   * candidate can find its group without comparing any string */
+  std::vector<std::vector<BasicPort>> wire_groups;
+  std::unordered_map<SymbolId, size_t> wire_group_ids;
+  auto find_wire_group = [&](const BasicPort& port) -> std::vector<BasicPort>& {
+    auto result =
+      wire_group_ids.emplace(port.get_name_symbol(), wire_groups.size());
+    if (true == result.second) {
+      wire_groups.emplace_back();
+    }
+    return wire_groups[result.first->second];
+  };
+
+  /* Local wires come from the child modules */
+  for (ModuleNetId module_net : module_manager.module_nets(module_id)) {
+    /* Bypass dangling nets:
+     * Xifan Tang: I comment this part because it will shadow our problems in
+     * creating module graph Indeed this make a robust and a smooth Verilog
+     * module writing But I do want the module graph create is nice and clean
+     * !!!
+     */
+    /*
+    if ( (0 == module_manager.net_source_modules(module_id, module_net).size())
+      && (0 == module_manager.net_source_modules(module_id, module_net).size())
+    ) { continue;
+    }
+    */
+
+    /* We only care local wires */
+    if (false ==
+        module_net_is_local_wire(module_manager, module_id, module_net)) {
+      continue;
+    }
+    /* Find the name for this local wire */
+    BasicPort local_wire_candidate = generate_verilog_port_for_module_net(
+      module_manager, module_id, module_net, use_instance_arrays);
+    /* Try to merge to one the port in the group that can absorb the current
+     * local wire. If merge fail, add to the group */
+    std::vector<BasicPort>& wire_group = find_wire_group(local_wire_candidate);
+    bool merged = false;
+    for (BasicPort& local_wire : wire_group) {
+      /* check if the candidate can be combined to an existing local wire */
+      if (true ==
+          two_verilog_ports_mergeable(local_wire, local_wire_candidate)) {
+        /* Merge the ports */
+        local_wire = merge_two_verilog_ports(local_wire, local_wire_candidate);
+        merged = true;
+        break;
+      }
+    }
+
+    /* If not merged, push the port to the group */
+    if (false == merged) {
+      wire_group.push_back(local_wire_candidate);
+    }
+  }
+
+  /* Local wires could also happen for undriven ports of child module */
+  for (const ModuleId& child : module_manager.child_modules(module_id)) {
+    for (size_t instance :
+         module_manager.child_module_instances(module_id, child)) {
+      for (const ModulePortId& child_port_id :
+           module_manager.module_ports(child)) {
+        BasicPort child_port = module_manager.module_port(child, child_port_id);
+        size_t undriven_lsb = child_port.get_width();
+        size_t undriven_msb = 0;
+        bool has_undriven_pin = false;
+        for (size_t child_pin : child_port.pins()) {
+          /* Find the net linked to the pin */
+          ModuleNetId net = module_manager.module_instance_port_net(
+            module_id, child, instance, child_port_id, child_pin);
+          /* We only care undriven ports */
+          if (ModuleNetId::INVALID() == net) {
+            undriven_lsb =
+              (false == has_undriven_pin) ? child_pin
+                                          : std::min(undriven_lsb, child_pin);
+            undriven_msb = std::max(undriven_msb, child_pin);
+            has_undriven_pin = true;
+          }
+        }
+        if (false == has_undriven_pin) {
+          continue;
+        }
+        /* Reach here, we need a local wire, we will create a port only for the
+         * undriven pins of the port! */
+        BasicPort instance_port;
+        instance_port.set_name(generate_verilog_undriven_local_wire_name(
+          module_manager, module_id, child, instance, child_port_id));
+        /* We give the same port name as child module, this case happens to
+         * global ports */
+        instance_port.set_width(undriven_lsb, undriven_msb);
+
+        find_wire_group(instance_port).push_back(instance_port);
+      }
+    }
+  }
+
+  /* Sort the groups by their names, and flatten them into a single list */
+  std::vector<size_t> sorted_group_ids;
+  sorted_group_ids.reserve(wire_groups.size());
+  size_t num_local_wires = 0;
+  for (size_t igroup = 0; igroup < wire_groups.size(); ++igroup) {
+    sorted_group_ids.push_back(igroup);
+    num_local_wires += wire_groups[igroup].size();
+  }
+  std::sort(sorted_group_ids.begin(), sorted_group_ids.end(),
+            [&](const size_t& lhs, const size_t& rhs) {
+              return symbol_string(wire_groups[lhs].front().get_name_symbol()) <
+                     symbol_string(wire_groups[rhs].front().get_name_symbol());
+            });
+
+  std::vector<BasicPort> local_wires;
+  local_wires.reserve(num_local_wires);
+  for (const size_t& igroup : sorted_group_ids) {
+    local_wires.insert(local_wires.end(), wire_groups[igroup].begin(),
+                       wire_groups[igroup].end());
+  }
+
+  return local_wires;
+}
+
+/************************************************************************
+ * Public Accessors
+ ***********************************************************************/
+const std::vector<BasicPort>& VerilogModuleWireLayout::local_wires(
+  const ModuleManager& module_manager, const ModuleId& module_id) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto result = local_wires_.find(module_id);
+    if (result != local_wires_.end()) {
+      return result->second;
+    }
+  }
+  /* Build the layout without holding the lock, so that other threads can
+   * work on other modules in the meantime. The elements of the cache are
+   * never moved, and the first layout built for a module is kept */
+  std::vector<BasicPort> module_local_wires =
+    find_verilog_module_local_wires(module_manager, module_id);
+  std::lock_guard<std::mutex> lock(mutex_);
+  return local_wires_.emplace(module_id, std::move(module_local_wires))
+    .first->second;
+}
+
+const VerilogModulePortSignature& VerilogModuleWireLayout::port_signature(
+  const ModuleManager& module_manager, const ModuleId& module_id) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto result = port_signatures_.find(module_id);
+    if (result != port_signatures_.end()) {
+      return result->second;
+    }
+  }
+  VerilogModulePortSignature signature =
+    build_verilog_module_port_signature(module_manager, module_id);
+  std::lock_guard<std::mutex> lock(mutex_);
+  return port_signatures_.emplace(module_id, std::move(signature))
+    .first->second;
+}
+
+size_t VerilogModuleWireLayout::num_modules() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return local_wires_.size();
+}
+
+/************************************************************************
+ * Public Mutators
+ ***********************************************************************/
+void VerilogModuleWireLayout::clear() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  local_wires_.clear();
+  port_signatures_.clear();
+}
+
+} /* end namespace openfpga */
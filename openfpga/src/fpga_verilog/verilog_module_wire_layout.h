@@ -0,0 +1,76 @@
+#ifndef VERILOG_MODULE_WIRE_LAYOUT_H
+#define VERILOG_MODULE_WIRE_LAYOUT_H
+
+/********************************************************************
+ * Include header files required by the data structure definition
+ *******************************************************************/
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "module_manager.h"
+#include "openfpga_port.h"
+#include "verilog_module_port_signature.h"
+
+/* namespace openfpga begins */
+namespace openfpga {
+
+/********************************************************************
+ * A cache of the local wires to be declared in the Verilog modules,
+ * which lives alongside the module manager.
+ *
+ * The local wires of a module are found by walking through all its nets
+ * and the pins of its child instances, which is expensive for large
+ * modules. The layout of a module is built on its first request, as a
+ * list of ports whose pins are already merged into index ranges, and is
+ * reused by any writer afterwards.
+ *
+ * The port signature of each module, which is required to declare the
+ * module and to instantiate it as a child, is cached in the same way.
+ *
+ * Note:
+ * - The layouts can be requested by multiple threads
+ * - The layouts refer to the names of modules, nets and instances. The
+ *   cache must be cleared once the module graph is modified, except when
+ *   new modules are added
+ *******************************************************************/
+class VerilogModuleWireLayout {
+ public: /* Public accessors */
+  /* Find the local wires of a module, in the order of declaration */
+  const std::vector<BasicPort>& local_wires(const ModuleManager& module_manager,
+                                            const ModuleId& module_id);
+  /* Find the ports of a module, in the order of declaration */
+  const VerilogModulePortSignature& port_signature(
+    const ModuleManager& module_manager, const ModuleId& module_id);
+  /* Find the number of modules whose layout has been built */
+  size_t num_modules() const;
+
+ public: /* Public mutators */
+  void clear();
+
+ private: /* Internal data */
+  std::unordered_map<ModuleId, std::vector<BasicPort>> local_wires_;
+  std::unordered_map<ModuleId, VerilogModulePortSignature> port_signatures_;
+  mutable std::mutex mutex_;
+};
+
+/********************************************************************
+ * Function declaration
+ *******************************************************************/
+std::string generate_verilog_undriven_local_wire_name(
+  const ModuleManager& module_manager, const ModuleId& parent,
+  const ModuleId& child, const size_t& instance_id,
+  const ModulePortId& child_port_id);
+
+BasicPort generate_verilog_port_for_module_net(
+  const ModuleManager& module_manager, const ModuleId& module_id,
+  const ModuleNetId& module_net, const bool& use_instance_arrays = false);
+
+std::vector<BasicPort> find_verilog_module_local_wires(
+  const ModuleManager& module_manager, const ModuleId& module_id,
+  const bool& use_instance_arrays = false);
+
+} /* end namespace openfpga */
+
+#endif
@@ -8,6 +8,7 @@
  * Please use const keyword to restrict this!
  *******************************************************************/
 #include <algorithm>
+#include <cstdlib>
 
 /* Headers from vtrutil library */
 #include "vtr_assert.h"
@@ -17,6 +18,9 @@
 #include "openfpga_digest.h"
 #include "openfpga_naming.h"
 #include "openfpga_port.h"
+#include "verilog_constants.h"
+#include "verilog_module_port_signature.h"
+#include "verilog_module_wire_layout.h"
 #include "verilog_module_writer.h"
 #include "verilog_port_types.h"
 #include "verilog_writer_utils.h"
@@ -24,227 +28,6 @@
 /* begin namespace openfpga */
 namespace openfpga {
 
-/********************************************************************
- * Generate the name of a local wire for a undriven port inside Verilog
- * module
- *******************************************************************/
-static std::string generate_verilog_undriven_local_wire_name(
-  const ModuleManager& module_manager, const ModuleId& parent,
-  const ModuleId& child, const size_t& instance_id,
-  const ModulePortId& child_port_id) {
-  std::string wire_name;
-  if (!module_manager.instance_name(parent, child, instance_id).empty()) {
-    wire_name = module_manager.instance_name(parent, child, instance_id);
-  } else {
-    wire_name = module_manager.module_name(child) + std::string("_") +
-                std::to_string(instance_id);
-    wire_name += std::string("_");
-  }
-
-  wire_name += std::string("_undriven_");
-  wire_name += module_manager.module_port(child, child_port_id).get_name();
-
-  return wire_name;
-}
-
-/********************************************************************
- * Name a net for a local wire for a verilog module
- * 1. If this is a local wire, name it after the
- *<src_module_name>_<instance_id>_<src_port_name>
- * 2. If this is not a local wire, name it after the port name of parent module
- *
- * In addition, it will assign the pin index as well
- *
- * Restriction: this function requires each net has single driver
- * which is definitely always true in circuits.
- *******************************************************************/
-static BasicPort generate_verilog_port_for_module_net(
-  const ModuleManager& module_manager, const ModuleId& module_id,
-  const ModuleNetId& module_net) {
-  BasicPort port_to_return;
-  /* Check all the sink modules of the net,
-   * if we have a source module is the current module, this is not local wire
-   */
-  for (ModuleNetSrcId src_id :
-       module_manager.module_net_sources(module_id, module_net)) {
-    if (module_id ==
-        module_manager.net_source_modules(module_id, module_net)[src_id]) {
-      /* Here, this is not a local wire, return the port name of the src_port */
-      ModulePortId net_src_port =
-        module_manager.net_source_ports(module_id, module_net)[src_id];
-      size_t src_pin_index =
-        module_manager.net_source_pins(module_id, module_net)[src_id];
-      port_to_return.set(module_manager.module_port(module_id, net_src_port));
-      port_to_return.set_width(src_pin_index, src_pin_index);
-      port_to_return.set_origin_port_width(
-        module_manager.module_port(module_id, net_src_port).get_width());
-      return port_to_return;
-    }
-  }
-
-  /* Check all the sink modules of the net */
-  for (ModuleNetSinkId sink_id :
-       module_manager.module_net_sinks(module_id, module_net)) {
-    if (module_id ==
-        module_manager.net_sink_modules(module_id, module_net)[sink_id]) {
-      /* Here, this is not a local wire, return the port name of the sink_port
-       */
-      ModulePortId net_sink_port =
-        module_manager.net_sink_ports(module_id, module_net)[sink_id];
-      size_t sink_pin_index =
-        module_manager.net_sink_pins(module_id, module_net)[sink_id];
-      port_to_return.set(module_manager.module_port(module_id, net_sink_port));
-      port_to_return.set_width(sink_pin_index, sink_pin_index);
-      port_to_return.set_origin_port_width(
-        module_manager.module_port(module_id, net_sink_port).get_width());
-      return port_to_return;
-    }
-  }
-
-  /* Reach here, this is a local wire */
-  std::string net_name;
-
-  /* Each net must only one 1 source */
-  VTR_ASSERT(1 ==
-             module_manager.net_source_modules(module_id, module_net).size());
-
-  /* Get the source module */
-  ModuleId net_src_module =
-    module_manager.net_source_modules(module_id, module_net)[ModuleNetSrcId(0)];
-  /* Get the instance id */
-  size_t net_src_instance = module_manager.net_source_instances(
-    module_id, module_net)[ModuleNetSrcId(0)];
-  /* Get the port id */
-  ModulePortId net_src_port =
-    module_manager.net_source_ports(module_id, module_net)[ModuleNetSrcId(0)];
-  /* Get the pin id */
-  size_t net_src_pin =
-    module_manager.net_source_pins(module_id, module_net)[ModuleNetSrcId(0)];
-
-  /* Load user-defined name if we have it */
-  if (false == module_manager.net_name(module_id, module_net).empty()) {
-    net_name = module_manager.net_name(module_id, module_net);
-  } else {
-    net_name = module_manager.module_name(net_src_module);
-    net_name +=
-      std::string("_") + std::to_string(net_src_instance) + std::string("_");
-    net_name +=
-      module_manager.module_port(net_src_module, net_src_port).get_name();
-  }
-
-  port_to_return.set_name(net_name);
-  port_to_return.set_width(net_src_pin, net_src_pin);
-  port_to_return.set_origin_port_width(
-    module_manager.module_port(net_src_module, net_src_port).get_width());
-  return port_to_return;
-}
-
-/********************************************************************
- * Find all the nets that are going to be local wires
- * And organize it in a vector of ports
- * Verilog wire writter function will use the output of this function
- * to write up local wire declaration in Verilog format
- *******************************************************************/
-static std::map<std::string, std::vector<BasicPort>>
-find_verilog_module_local_wires(const ModuleManager& module_manager,
-                                const ModuleId& module_id) {
-  std::map<std::string, std::vector<BasicPort>> local_wires;
-
-  /* Local wires come from the child modules */
-  for (ModuleNetId module_net : module_manager.module_nets(module_id)) {
-    /* Bypass dangling nets:
-     * Xifan Tang: I comment this part because it will shadow our problems in
-     * creating module graph Indeed this make a robust and a smooth Verilog
-     * module writing But I do want the module graph create is nice and clean
-     * !!!
-     */
-    /*
-    if ( (0 == module_manager.net_source_modules(module_id, module_net).size())
-      && (0 == module_manager.net_source_modules(module_id, module_net).size())
-    ) { continue;
-    }
-    */
-
-    /* We only care local wires */
-    if (false ==
-        module_net_is_local_wire(module_manager, module_id, module_net)) {
-      continue;
-    }
-    /* Find the name for this local wire */
-    BasicPort local_wire_candidate = generate_verilog_port_for_module_net(
-      module_manager, module_id, module_net);
-    /* Cache the net name, try to find it in the cache.
-     * If you can find one, it means this port may be mergeable, try to do
-     * merging. If merge fail, add to the local wire list If you cannot find
-     * one, it means that this port is not mergeable, add to the local wire list
-     * immediately.
-     */
-    std::map<std::string, std::vector<BasicPort>>::iterator it =
-      local_wires.find(local_wire_candidate.get_name());
-    bool merged = false;
-    if (it != local_wires.end()) {
-      /* Try to merge to one the port in the list that can absorb the current
-       * local wire */
-      for (BasicPort& local_wire :
-           local_wires[local_wire_candidate.get_name()]) {
-        /* check if the candidate can be combined to an existing local wire */
-        if (true ==
-            two_verilog_ports_mergeable(local_wire, local_wire_candidate)) {
-          /* Merge the ports */
-          local_wire =
-            merge_two_verilog_ports(local_wire, local_wire_candidate);
-          merged = true;
-          break;
-        }
-      }
-    }
-
-    /* If not merged/not found in the cache, push the port to the list */
-    if (false == merged) {
-      local_wires[local_wire_candidate.get_name()].push_back(
-        local_wire_candidate);
-    }
-  }
-
-  /* Local wires could also happen for undriven ports of child module */
-  for (const ModuleId& child : module_manager.child_modules(module_id)) {
-    for (size_t instance :
-         module_manager.child_module_instances(module_id, child)) {
-      for (const ModulePortId& child_port_id :
-           module_manager.module_ports(child)) {
-        BasicPort child_port = module_manager.module_port(child, child_port_id);
-        std::vector<size_t> undriven_pins;
-        for (size_t child_pin : child_port.pins()) {
-          /* Find the net linked to the pin */
-          ModuleNetId net = module_manager.module_instance_port_net(
-            module_id, child, instance, child_port_id, child_pin);
-          /* We only care undriven ports */
-          if (ModuleNetId::INVALID() == net) {
-            undriven_pins.push_back(child_pin);
-          }
-        }
-        if (true == undriven_pins.empty()) {
-          continue;
-        }
-        /* Reach here, we need a local wire, we will create a port only for the
-         * undriven pins of the port! */
-        BasicPort instance_port;
-        instance_port.set_name(generate_verilog_undriven_local_wire_name(
-          module_manager, module_id, child, instance, child_port_id));
-        /* We give the same port name as child module, this case happens to
-         * global ports */
-        instance_port.set_width(
-          *std::min_element(undriven_pins.begin(), undriven_pins.end()),
-          *std::max_element(undriven_pins.begin(), undriven_pins.end()));
-
-        local_wires[instance_port.get_name()].push_back(instance_port);
-      }
-    }
-  }
-
-  return local_wires;
-}
-
 /********************************************************************
  * Print a Verilog wire connection
  * We search all the sinks of the net,
@@ -419,7 +202,208 @@ static void print_verilog_module_output_short_connections(
 }
 
 /********************************************************************
- * Write a Verilog instance to a file
+ * Find the connections of each port of a child instance, in the order
+ * of port types in module manager, i.e., global, inout, input, output and
+ * clock ports. The pins of each port are named after the inputs/output or
+ * local wires available in the parent module, and merged as much as possible
+ *******************************************************************/
+static void find_verilog_instance_ports(
+  std::vector<std::vector<BasicPort>>& instance_ports,
+  const ModuleManager& module_manager, const ModuleId& parent_module,
+  const ModuleId& child_module,
+  const VerilogModulePortSignature& child_signature,
+  const size_t& instance_id, const bool& use_instance_arrays) {
+  instance_ports.clear();
+  std::vector<BasicPort> instance_pins;
+  for (const VerilogModulePort& child_module_port : child_signature) {
+    const ModulePortId& child_port_id = child_module_port.id;
+    const BasicPort& child_port = child_module_port.port;
+    /* Create the port name and width to be used by the instance */
+    instance_pins.clear();
+    for (size_t child_pin : child_port.pins()) {
+      /* Find the net linked to the pin */
+      ModuleNetId net = module_manager.module_instance_port_net(
+        parent_module, child_module, instance_id, child_port_id, child_pin);
+      BasicPort instance_port;
+      if (ModuleNetId::INVALID() == net) {
+        /* We give the same port name as child module, this case happens to
+         * global ports */
+        instance_port.set_name(generate_verilog_undriven_local_wire_name(
+          module_manager, parent_module, child_module, instance_id,
+          child_port_id));
+        instance_port.set_width(child_pin, child_pin);
+        instance_port.set_origin_port_width(child_port.get_width());
+      } else {
+        /* Find the name for this child port */
+        instance_port = generate_verilog_port_for_module_net(
+          module_manager, parent_module, net, use_instance_arrays);
+      }
+      /* Create the port information for the net */
+      instance_pins.push_back(instance_port);
+    }
+    /* Try to merge the ports by combining the instance pins */
+    instance_ports.push_back(combine_verilog_ports(instance_pins));
+  }
+}
+
+/********************************************************************
+ * Find the strides between the connections of two child instances, i.e.,
+ * the number of pins that each connection is shifted by from the first
+ * instance to the second one.
+ * Return false if the connections of the two instances are not in the same
+ * shape, i.e., a pair of connections differ in their names or widths
+ *******************************************************************/
+static bool find_verilog_instance_port_strides(
+  std::vector<std::vector<int>>& strides,
+  const std::vector<std::vector<BasicPort>>& first_instance_ports,
+  const std::vector<std::vector<BasicPort>>& next_instance_ports) {
+  VTR_ASSERT(first_instance_ports.size() == next_instance_ports.size());
+  strides.resize(first_instance_ports.size());
+  for (size_t iport = 0; iport < first_instance_ports.size(); ++iport) {
+    const std::vector<BasicPort>& first_ports = first_instance_ports[iport];
+    const std::vector<BasicPort>& next_ports = next_instance_ports[iport];
+    if (first_ports.size() != next_ports.size()) {
+      return false;
+    }
+    strides[iport].resize(first_ports.size());
+    for (size_t ipin = 0; ipin < first_ports.size(); ++ipin) {
+      if ((first_ports[ipin].get_name_symbol() !=
+           next_ports[ipin].get_name_symbol()) ||
+          (first_ports[ipin].get_width() != next_ports[ipin].get_width())) {
+        return false;
+      }
+      strides[iport][ipin] =
+        int(next_ports[ipin].get_lsb()) - int(first_ports[ipin].get_lsb());
+    }
+  }
+  return true;
+}
+
+/********************************************************************
+ * Check if the connections of a child instance, which is the n-th instance
+ * after the first instance of an array, are shifted from the connections of
+ * the first instance by n times the strides of the array
+ *******************************************************************/
+static bool verilog_instance_ports_follow_strides(
+  const std::vector<std::vector<BasicPort>>& first_instance_ports,
+  const std::vector<std::vector<int>>& strides, const size_t& offset,
+  const std::vector<std::vector<BasicPort>>& instance_ports) {
+  VTR_ASSERT(first_instance_ports.size() == instance_ports.size());
+  for (size_t iport = 0; iport < first_instance_ports.size(); ++iport) {
+    const std::vector<BasicPort>& first_ports = first_instance_ports[iport];
+    const std::vector<BasicPort>& ports = instance_ports[iport];
+    if (first_ports.size() != ports.size()) {
+      return false;
+    }
+    for (size_t ipin = 0; ipin < first_ports.size(); ++ipin) {
+      if ((first_ports[ipin].get_name_symbol() !=
+           ports[ipin].get_name_symbol()) ||
+          (first_ports[ipin].get_width() != ports[ipin].get_width()) ||
+          (int(ports[ipin].get_lsb()) !=
+           int(first_ports[ipin].get_lsb()) +
+             strides[iport][ipin] * int(offset))) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+/********************************************************************
+ * Append a pin index of a connection inside a generate loop, which is
+ * <base> + <stride> * <index>
+ *******************************************************************/
+static void append_verilog_indexed_pin(std::string& buffer, const size_t& base,
+                                       const int& stride) {
+  append_verilog_number(buffer, base);
+  buffer += (0 > stride) ? " - " : " + ";
+  append_verilog_number(buffer, size_t(std::abs(stride)));
+  buffer += " * ";
+  buffer += VERILOG_INSTANCE_ARRAY_INDEX_NAME;
+}
+
+/********************************************************************
+ * Append the connection of a port of a child instance
+ * When strides are given, the connection is written for the instances of a
+ * generate loop, where each pin index is shifted by the index of the loop
+ *******************************************************************/
+static void append_verilog_instance_port_connection(
+  std::string& buffer, const std::vector<BasicPort>& ports,
+  const std::vector<int>* strides) {
+  if (nullptr == strides) {
+    append_verilog_ports(buffer, ports);
+    return;
+  }
+  VTR_ASSERT(0 < ports.size());
+  if (1 < ports.size()) {
+    buffer += '{';
+  }
+  for (size_t ipin = 0; ipin < ports.size(); ++ipin) {
+    /* The first port does not need a comma */
+    if (0 != ipin) {
+      buffer += ", ";
+    }
+    const BasicPort& port = ports[ipin];
+    const int& stride = (*strides)[ipin];
+    if (0 == stride) {
+      append_verilog_port(buffer, VERILOG_PORT_CONKT, port, false);
+      continue;
+    }
+    buffer += symbol_string(port.get_name_symbol());
+    buffer += '[';
+    append_verilog_indexed_pin(buffer, port.get_lsb(), stride);
+    if (1 < port.get_width()) {
+      buffer += ':';
+      append_verilog_indexed_pin(buffer, port.get_msb(), stride);
+    }
+    buffer += ']';
+  }
+  if (1 < ports.size()) {
+    buffer += '}';
+  }
+}
+
+/********************************************************************
+ * Append the port mapping of a child instance to a string buffer, using
+ * the connections found by find_verilog_instance_ports()
+ *******************************************************************/
+static void append_verilog_instance_port_map(
+  std::string& buffer, const VerilogModulePortSignature& child_signature,
+  const std::vector<std::vector<BasicPort>>& instance_ports,
+  const std::vector<std::vector<int>>* strides,
+  const bool& use_explicit_port_map, const std::string& indent) {
+  /* Print each port with/without explicit port map
+   * Port sequence: global, inout, input, output and clock ports, which is
+   * the order of port types in module manager */
+  size_t port_cnt = 0;
+  for (const VerilogModulePort& child_module_port : child_signature) {
+    if (0 != port_cnt) {
+      /* Do not dump a comma for the first port */
+      buffer += ",\n";
+    }
+    /* Print port */
+    buffer += indent;
+    /* if explicit port map is required, output the port name */
+    if (true == use_explicit_port_map) {
+      buffer += '.';
+      buffer += symbol_string(child_module_port.port.get_name_symbol());
+      buffer += '(';
+    }
+
+    append_verilog_instance_port_connection(
+      buffer, instance_ports[port_cnt],
+      (nullptr == strides) ? nullptr : &((*strides)[port_cnt]));
+
+    /* if explicit port map is required, output the pair of branket */
+    if (true == use_explicit_port_map) {
+      buffer += ')';
+    }
+    port_cnt++;
+  }
+}
+
+/********************************************************************
+ * Append a Verilog instance to a string buffer
  * This function will name the input and output connections to
  * the inputs/output or local wires available in the parent module
  *
@@ -435,148 +419,252 @@ static void print_verilog_module_output_short_connections(
  *    +-----------------------------+
  *
  *******************************************************************/
-static void write_verilog_instance_to_file(std::fstream& fp,
-                                           const ModuleManager& module_manager,
-                                           const ModuleId& parent_module,
-                                           const ModuleId& child_module,
-                                           const size_t& instance_id,
-                                           const bool& use_explicit_port_map) {
-  /* Ensure a valid file stream */
-  VTR_ASSERT(true == valid_file_stream(fp));
-
+static void append_verilog_instance(
+  std::string& buffer, const ModuleManager& module_manager,
+  const ModuleId& parent_module, const ModuleId& child_module,
+  const VerilogModulePortSignature& child_signature, const size_t& instance_id,
+  const std::vector<std::vector<BasicPort>>& instance_ports,
+  const bool& use_explicit_port_map) {
   /* Print module name */
-  fp << "\t" << module_manager.module_name(child_module) << " ";
+  buffer += '\t';
+  buffer += module_manager.module_name(child_module);
+  buffer += ' ';
   /* Print instance name:
    * if we have an instance name, use it;
    * if not, we use a default name <name>_<num_instance_in_parent_module>
    */
-  if (true ==
-      module_manager.instance_name(parent_module, child_module, instance_id)
-        .empty()) {
-    fp << generate_instance_name(module_manager.module_name(child_module),
-                                 instance_id)
-       << " (" << std::endl;
+  std::string instance_name =
+    module_manager.instance_name(parent_module, child_module, instance_id);
+  if (true == instance_name.empty()) {
+    buffer += generate_instance_name(module_manager.module_name(child_module),
+                                     instance_id);
   } else {
-    fp << module_manager.instance_name(parent_module, child_module, instance_id)
-       << " (" << std::endl;
+    buffer += instance_name;
   }
+  buffer += " (\n";
 
-  /* Print each port with/without explicit port map */
-  /* port type2type mapping */
-  std::map<ModuleManager::e_module_port_type, enum e_dump_verilog_port_type>
-    port_type2type_map;
-  port_type2type_map[ModuleManager::MODULE_GLOBAL_PORT] = VERILOG_PORT_CONKT;
-  port_type2type_map[ModuleManager::MODULE_GPIN_PORT] = VERILOG_PORT_CONKT;
-  port_type2type_map[ModuleManager::MODULE_GPOUT_PORT] = VERILOG_PORT_CONKT;
-  port_type2type_map[ModuleManager::MODULE_GPIO_PORT] = VERILOG_PORT_CONKT;
-  port_type2type_map[ModuleManager::MODULE_INOUT_PORT] = VERILOG_PORT_CONKT;
-  port_type2type_map[ModuleManager::MODULE_INPUT_PORT] = VERILOG_PORT_CONKT;
-  port_type2type_map[ModuleManager::MODULE_OUTPUT_PORT] = VERILOG_PORT_CONKT;
-  port_type2type_map[ModuleManager::MODULE_CLOCK_PORT] = VERILOG_PORT_CONKT;
-
-  /* Port sequence: global, inout, input, output and clock ports, */
-  size_t port_cnt = 0;
-  for (const auto& kv : port_type2type_map) {
-    for (const ModulePortId& child_port_id :
-         module_manager.module_port_ids_by_type(child_module, kv.first)) {
-      BasicPort child_port =
-        module_manager.module_port(child_module, child_port_id);
-      if (0 != port_cnt) {
-        /* Do not dump a comma for the first port */
-        fp << "," << std::endl;
-      }
-      /* Print port */
-      fp << "\t\t";
-      /* if explicit port map is required, output the port name */
-      if (true == use_explicit_port_map) {
-        fp << "." << child_port.get_name() << "(";
-      }
+  append_verilog_instance_port_map(buffer, child_signature, instance_ports,
+                                   nullptr, use_explicit_port_map, "\t\t");
+
+  /* Print an end to the instance */
+  buffer += ");\n";
+}
 
-      /* Create the port name and width to be used by the instance */
-      std::vector<BasicPort> instance_ports;
-      std::vector<bool> instance_ports_is_single_bit;
-      for (size_t child_pin : child_port.pins()) {
-        /* Find the net linked to the pin */
-        ModuleNetId net = module_manager.module_instance_port_net(
-          parent_module, child_module, instance_id, child_port_id, child_pin);
-        BasicPort instance_port;
-        if (ModuleNetId::INVALID() == net) {
-          /* We give the same port name as child module, this case happens to
-           * global ports */
-          instance_port.set_name(generate_verilog_undriven_local_wire_name(
-            module_manager, parent_module, child_module, instance_id,
-            child_port_id));
-          instance_port.set_width(child_pin, child_pin);
-          instance_port.set_origin_port_width(
-            module_manager.module_port(child_module, child_port_id)
-              .get_width());
-        } else {
-          /* Find the name for this child port */
-          instance_port = generate_verilog_port_for_module_net(
-            module_manager, parent_module, net);
+/********************************************************************
+ * Append an array of instances of a child module to a string buffer,
+ * using a generate loop. The connections of the instances are those of
+ * the first instance, shifted by the strides of the array in each iteration
+ *
+ *   generate
+ *     for (instance_index = 0; instance_index < <num_instances>;
+ *          instance_index = instance_index + 1)
+ *     begin : <child_module>_array_<first_instance>
+ *       <child_module> inst (...);
+ *     end
+ *   endgenerate
+ *
+ *******************************************************************/
+static void append_verilog_instance_array(
+  std::string& buffer, const ModuleManager& module_manager,
+  const ModuleId& child_module,
+  const VerilogModulePortSignature& child_signature,
+  const size_t& first_instance, const size_t& num_instances,
+  const std::vector<std::vector<BasicPort>>& first_instance_ports,
+  const std::vector<std::vector<int>>& strides,
+  const bool& use_explicit_port_map) {
+  std::string child_module_name = module_manager.module_name(child_module);
+
+  buffer += "\tgenerate\n";
+  buffer += "\t\tfor (";
+  buffer += VERILOG_INSTANCE_ARRAY_INDEX_NAME;
+  buffer += " = 0; ";
+  buffer += VERILOG_INSTANCE_ARRAY_INDEX_NAME;
+  buffer += " < ";
+  append_verilog_number(buffer, num_instances);
+  buffer += "; ";
+  buffer += VERILOG_INSTANCE_ARRAY_INDEX_NAME;
+  buffer += " = ";
+  buffer += VERILOG_INSTANCE_ARRAY_INDEX_NAME;
+  buffer += " + 1) begin : ";
+  buffer += child_module_name;
+  buffer += VERILOG_INSTANCE_ARRAY_POSTFIX;
+  append_verilog_number(buffer, first_instance);
+  buffer += '\n';
+
+  buffer += "\t\t\t";
+  buffer += child_module_name;
+  buffer += ' ';
+  buffer += VERILOG_INSTANCE_ARRAY_INSTANCE_NAME;
+  buffer += " (\n";
+  append_verilog_instance_port_map(buffer, child_signature,
+                                   first_instance_ports, &strides,
+                                   use_explicit_port_map, "\t\t\t\t");
+  buffer += ");\n";
+
+  buffer += "\t\tend\n";
+  buffer += "\tendgenerate\n";
+}
+
+/********************************************************************
+ * Append all the instances of a child module to a string buffer
+ * When instance arrays are used, each run of instances whose connections
+ * are shifted by the same strides from one instance to the next is written
+ * as a generate loop. Other instances are written one by one.
+ *******************************************************************/
+static void append_verilog_child_instances(
+  std::fstream& fp, std::string& buffer, bool& index_declared,
+  const ModuleManager& module_manager, const ModuleId& parent_module,
+  const ModuleId& child_module,
+  const VerilogModulePortSignature& child_signature,
+  const bool& use_explicit_port_map, const bool& use_instance_arrays) {
+  ModuleManager::child_instance_range instances =
+    module_manager.child_module_instances(parent_module, child_module);
+
+  std::vector<std::vector<BasicPort>> first_instance_ports;
+  std::vector<std::vector<BasicPort>> instance_ports;
+  std::vector<std::vector<int>> strides;
+  /* The connections of the first instance of a run may be already found
+   * when checking the previous run */
+  bool first_instance_found = false;
+  size_t first = 0;
+  while (first < instances.size()) {
+    if (false == first_instance_found) {
+      find_verilog_instance_ports(first_instance_ports, module_manager,
+                                  parent_module, child_module, child_signature,
+                                  instances[first], use_instance_arrays);
+    }
+    first_instance_found = false;
+
+    /* Find how many instances can be written as an array */
+    size_t num_instances = 1;
+    if ((true == use_instance_arrays) && (first + 1 < instances.size())) {
+      find_verilog_instance_ports(instance_ports, module_manager,
+                                  parent_module, child_module, child_signature,
+                                  instances[first + 1], use_instance_arrays);
+      if (true == find_verilog_instance_port_strides(
+                    strides, first_instance_ports, instance_ports)) {
+        num_instances = 2;
+        while (first + num_instances < instances.size()) {
+          find_verilog_instance_ports(
+            instance_ports, module_manager, parent_module, child_module,
+            child_signature, instances[first + num_instances],
+            use_instance_arrays);
+          if (false == verilog_instance_ports_follow_strides(
+                         first_instance_ports, strides, num_instances,
+                         instance_ports)) {
+            break;
+          }
+          num_instances++;
         }
-        /* Create the port information for the net */
-        instance_ports.push_back(instance_port);
       }
-      /* Try to merge the ports */
-      std::vector<BasicPort> merged_ports =
-        combine_verilog_ports(instance_ports);
-
-      /* Print a verilog port by combining the instance ports */
-      fp << generate_verilog_ports(merged_ports);
+      /* The instance which breaks the run is the first one of the next run */
+      if (first + num_instances < instances.size()) {
+        first_instance_found = true;
+      }
+    }
 
-      /* if explicit port map is required, output the pair of branket */
-      if (true == use_explicit_port_map) {
-        fp << ")";
+    if (1 == num_instances) {
+      append_verilog_instance(buffer, module_manager, parent_module,
+                              child_module, child_signature, instances[first],
+                              first_instance_ports, use_explicit_port_map);
+    } else {
+      /* The index of generate loops is declared once in a module */
+      if (false == index_declared) {
+        buffer += "\tgenvar ";
+        buffer += VERILOG_INSTANCE_ARRAY_INDEX_NAME;
+        buffer += ";\n\n";
+        index_declared = true;
       }
-      port_cnt++;
+      append_verilog_instance_array(buffer, module_manager, child_module,
+                                    child_signature, instances[first],
+                                    num_instances, first_instance_ports,
+                                    strides, use_explicit_port_map);
+    }
+    /* Print an empty line as splitter */
+    buffer += '\n';
+    if (VERILOG_WRITER_BUFFER_SIZE <= buffer.size()) {
+      print_verilog_buffer(fp, buffer);
     }
-  }
 
-  /* Print an end to the instance */
-  fp << ");" << std::endl;
+    first += num_instances;
+    if (true == first_instance_found) {
+      std::swap(first_instance_ports, instance_ports);
+    }
+  }
 }
 
 /********************************************************************
  * Write a Verilog module to a file
  * This is a key function, maybe most frequently called in our Verilog writer
  * Note that file stream must be valid
+ *
+ * When instance arrays are used, the regular runs of instances are written
+ * with generate loops, and the local wires driven by the same port of a
+ * child module are merged into a bus. Such local wires are different from
+ * those in the cache, so the cached local wires are not used. The cached
+ * port signatures of the module and its child modules are always used.
  *******************************************************************/
 void write_verilog_module_to_file(
   std::fstream& fp, const ModuleManager& module_manager,
   const ModuleId& module_id, const bool& use_explicit_port_map,
-  const e_verilog_default_net_type& default_net_type) {
+  const e_verilog_default_net_type& default_net_type,
+  VerilogModuleWireLayout* wire_layout, const bool& use_instance_arrays) {
   VTR_ASSERT(true == valid_file_stream(fp));
 
   /* Ensure we have a valid module_id */
   VTR_ASSERT(module_manager.valid_module_id(module_id));
 
   /* Print module declaration */
-  print_verilog_module_declaration(fp, module_manager, module_id,
-                                   default_net_type);
+  if (nullptr == wire_layout) {
+    print_verilog_module_declaration(fp, module_manager, module_id,
+                                     default_net_type);
+  } else {
+    print_verilog_module_declaration(
+      fp, module_manager, module_id,
+      wire_layout->port_signature(module_manager, module_id),
+      default_net_type);
+  }
+
+  /* Local wires and instances, which are the bulk of a module, are formatted
+   * into an output buffer and written to the file stream in large chunks.
+   * The buffer is owned by the thread, so that its memory is reused by all
+   * the modules to be written */
+  thread_local std::string buffer;
+  buffer.clear();
+  buffer.reserve(VERILOG_WRITER_BUFFER_SIZE);
 
   /* Print an empty line as splitter */
-  fp << std::endl;
-
-  /* Print internal wires */
-  std::map<std::string, std::vector<BasicPort>> local_wires =
-    find_verilog_module_local_wires(module_manager, module_id);
-  for (std::pair<std::string, std::vector<BasicPort>> port_group :
-       local_wires) {
-    for (const BasicPort& local_wire : port_group.second) {
-      /* When default net type is wire, we can skip single-bit wires whose LSB
-       * is 0 */
-      if ((VERILOG_DEFAULT_NET_TYPE_WIRE == default_net_type) &&
-          (1 == local_wire.get_width()) && (0 == local_wire.get_lsb())) {
-        continue;
-      }
-      fp << generate_verilog_port(VERILOG_PORT_WIRE, local_wire) << ";"
-         << std::endl;
+  buffer += '\n';
+
+  /* Print internal wires. Reuse the layout in the cache when there is one */
+  bool use_wire_layout =
+    (nullptr != wire_layout) && (false == use_instance_arrays);
+  std::vector<BasicPort> uncached_local_wires;
+  if (false == use_wire_layout) {
+    uncached_local_wires = find_verilog_module_local_wires(
+      module_manager, module_id, use_instance_arrays);
+  }
+  const std::vector<BasicPort>& local_wires =
+    (false == use_wire_layout)
+      ? uncached_local_wires
+      : wire_layout->local_wires(module_manager, module_id);
+  for (const BasicPort& local_wire : local_wires) {
+    /* When default net type is wire, we can skip single-bit wires whose LSB
+     * is 0 */
+    if ((VERILOG_DEFAULT_NET_TYPE_WIRE == default_net_type) &&
+        (1 == local_wire.get_width()) && (0 == local_wire.get_lsb())) {
+      continue;
+    }
+    append_verilog_port(buffer, VERILOG_PORT_WIRE, local_wire);
+    buffer += ";\n";
+    if (VERILOG_WRITER_BUFFER_SIZE <= buffer.size()) {
+      print_verilog_buffer(fp, buffer);
     }
   }
 
   /* Print an empty line as splitter */
-  fp << std::endl;
+  buffer += '\n';
+  print_verilog_buffer(fp, buffer);
 
   /* Print local connection (from module inputs to output! */
   print_verilog_comment(
@@ -592,30 +680,35 @@ void write_verilog_module_to_file(
   print_verilog_comment(
     fp, std::string("----- END Local output short connections -----"));
   /* Print an empty line as splitter */
-  fp << std::endl;
+  fp << '\n';
 
   /* Print instances */
+  bool index_declared = false;
+  VerilogModulePortSignature uncached_child_signature;
   for (ModuleId child_module : module_manager.child_modules(module_id)) {
-    for (size_t instance :
-         module_manager.child_module_instances(module_id, child_module)) {
-      /* Print an instance */
-      write_verilog_instance_to_file(fp, module_manager, module_id,
-                                     child_module, instance,
-                                     use_explicit_port_map);
-      /* Print an empty line as splitter */
-      fp << std::endl;
+    if (nullptr == wire_layout) {
+      uncached_child_signature =
+        build_verilog_module_port_signature(module_manager, child_module);
     }
+    const VerilogModulePortSignature& child_signature =
+      (nullptr == wire_layout)
+        ? uncached_child_signature
+        : wire_layout->port_signature(module_manager, child_module);
+    append_verilog_child_instances(fp, buffer, index_declared, module_manager,
+                                   module_id, child_module, child_signature,
+                                   use_explicit_port_map, use_instance_arrays);
   }
+  print_verilog_buffer(fp, buffer);
 
   /* Print an end for the module */
   print_verilog_module_end(fp, module_manager.module_name(module_id),
                            default_net_type);
 
   /* Print an empty line as splitter */
-  fp << std::endl;
+  fp << '\n';
 
   /* Print an empty line as splitter */
-  fp << std::endl;
+  fp << '\n';
 }
 
 } /* end namespace openfpga */
@@ -7,6 +7,7 @@
 #include <fstream>
 
 #include "module_manager.h"
+#include "verilog_module_wire_layout.h"
 #include "verilog_port_types.h"
 
 /********************************************************************
@@ -19,7 +20,9 @@ namespace openfpga {
 void write_verilog_module_to_file(
   std::fstream& fp, const ModuleManager& module_manager,
   const ModuleId& module_id, const bool& use_explicit_port_map,
-  const e_verilog_default_net_type& default_net_type);
+  const e_verilog_default_net_type& default_net_type,
+  VerilogModuleWireLayout* wire_layout = nullptr,
+  const bool& use_instance_arrays = false);
 
 } /* end namespace openfpga */
 
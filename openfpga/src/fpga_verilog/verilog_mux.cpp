@@ -30,6 +30,7 @@
 #include "verilog_constants.h"
 #include "verilog_module_writer.h"
 #include "verilog_mux.h"
+#include "verilog_submodule_utils.h"
 #include "verilog_writer_utils.h"
 
 /* begin namespace openfpga */
@@ -38,11 +39,13 @@ namespace openfpga {
 /*********************************************************************
  * Generate behavior-level Verilog codes modeling an branch circuit
  * for a multiplexer with the given size
+ * In 2-state mode, the outputs are driven to '0' rather than 'z' when no
+ * input is selected
  *********************************************************************/
 static void generate_verilog_cmos_mux_branch_body_behavioral(
   std::fstream& fp, const BasicPort& input_port, const BasicPort& output_port,
   const BasicPort& mem_port, const MuxGraph& mux_graph,
-  const size_t& default_mem_val) {
+  const size_t& default_mem_val, const bool& two_state) {
   /* Make sure we have a valid file handler*/
   VTR_ASSERT(true == valid_file_stream(fp));
 
@@ -105,7 +108,7 @@ static void generate_verilog_cmos_mux_branch_body_behavioral(
   }
 
   /* Default case: outputs are at high-impedance state 'z' */
-  std::string default_case(mux_graph.num_outputs(), 'z');
+  std::string default_case(mux_graph.num_outputs(), two_state ? '0' : 'z');
   fp << "\t\tdefault: "
      << generate_verilog_port(VERILOG_PORT_CONKT, outreg_port) << " <= ";
   fp << mux_graph.num_outputs() << "'b" << default_case << ";" << std::endl;
@@ -129,7 +132,7 @@ static void print_verilog_cmos_mux_branch_module_behavioral(
   ModuleManager& module_manager, const CircuitLibrary& circuit_lib,
   std::fstream& fp, const CircuitModelId& mux_model,
   const std::string& module_name, const MuxGraph& mux_graph,
-  const e_verilog_default_net_type& default_net_type) {
+  const bool& two_state, const e_verilog_default_net_type& default_net_type) {
   /* Get the tgate model */
   CircuitModelId tgate_model = circuit_lib.pass_gate_logic_model(mux_model);
 
@@ -183,7 +186,8 @@ static void print_verilog_cmos_mux_branch_module_behavioral(
   /* Mem string must be only 1-bit! */
   VTR_ASSERT(1 == mem_default_val.length());
   generate_verilog_cmos_mux_branch_body_behavioral(
-    fp, input_port, output_port, mem_port, mux_graph, mem_default_val[0]);
+    fp, input_port, output_port, mem_port, mux_graph, mem_default_val[0],
+    two_state);
 
   /* Put an end to the Verilog module */
   print_verilog_module_end(fp, module_name, default_net_type);
@@ -644,7 +648,7 @@ static void generate_verilog_mux_branch_module(
   ModuleManager& module_manager, const CircuitLibrary& circuit_lib,
   std::fstream& fp, const CircuitModelId& mux_model, const MuxGraph& mux_graph,
   const ModuleNameMap& module_name_map, const bool& use_explicit_port_map,
-  const e_verilog_default_net_type& default_net_type,
+  const bool& two_state, const e_verilog_default_net_type& default_net_type,
   std::map<std::string, bool>& branch_mux_module_is_outputted) {
   std::string module_name = generate_mux_branch_subckt_name(
     circuit_lib, mux_model, mux_graph.num_inputs(), mux_graph.num_memory_bits(),
@@ -671,7 +675,10 @@ static void generate_verilog_mux_branch_module(
                    circuit_lib.gate_type(circuit_lib.model(module_name)));
         break;
       }
-      if (true == circuit_lib.dump_structural_verilog(mux_model)) {
+      /* A structural branch drives its output by a number of pass-gates,
+       * which can not be modeled with 2-state logic */
+      if ((true == circuit_lib.dump_structural_verilog(mux_model)) &&
+          (false == two_state)) {
         /* Structural verilog can be easily generated by module writer */
         ModuleId mux_module = module_manager.find_module(module_name);
         VTR_ASSERT(true == module_manager.valid_module_id(mux_module));
@@ -686,7 +693,7 @@ static void generate_verilog_mux_branch_module(
         /* Behavioral verilog requires customized generation */
         print_verilog_cmos_mux_branch_module_behavioral(
           module_manager, circuit_lib, fp, mux_model, module_name, mux_graph,
-          default_net_type);
+          two_state, default_net_type);
       }
       break;
     case CIRCUIT_MODEL_DESIGN_RRAM:
@@ -1394,6 +1401,204 @@ static void generate_verilog_rram_mux_module(
   print_verilog_module_end(fp, module_name, default_net_type);
 }
 
+/*********************************************************************
+ * Identify if a buffer of a multiplexer inverts its input
+ *********************************************************************/
+static bool is_verilog_mux_buffer_inverted(const CircuitLibrary& circuit_lib,
+                                           const CircuitModelId& buffer_model) {
+  VTR_ASSERT(CircuitModelId::INVALID() != buffer_model);
+  return (CIRCUIT_MODEL_INVBUF == circuit_lib.model_type(buffer_model)) &&
+         (CIRCUIT_MODEL_BUF_INV == circuit_lib.buffer_type(buffer_model));
+}
+
+/*********************************************************************
+ * Generate the behavioral expression of a node in the graph of a CMOS
+ * multiplexer, by walking backward to the inputs of the multiplexer
+ * A node driven by a few branches is selected by the memory bits of its
+ * fan-in edges, in the order of the edges, as what the bitstream generator
+ * assumes. An edge using an inverted memory bit is enabled by a logic '0'.
+ * When no edge is enabled, the node is at high-impedance state 'z', as a
+ * pass-gate multiplexer would be, or at '0' in 2-state mode.
+ *********************************************************************/
+static std::string generate_verilog_cmos_mux_node_behavioral_expression(
+  const CircuitLibrary& circuit_lib, const CircuitModelId& mux_model,
+  const MuxGraph& mux_graph, const MuxNodeId& node,
+  const std::string& input_port_name, const std::string& mem_port_name,
+  const std::vector<bool>& inter_inverter_location_map, const bool& two_state) {
+  /* Inputs are either a datapath input or a constant input */
+  if (true == mux_graph.is_node_input(node)) {
+    MuxInputId input_id = mux_graph.input_id(node);
+    if ((MuxInputId(mux_graph.num_inputs() - 1) == input_id) &&
+        (true == circuit_lib.mux_add_const_input(mux_model))) {
+      return std::string("1'b") +
+             std::to_string(circuit_lib.mux_const_input_value(mux_model));
+    }
+    std::string input_pin = generate_verilog_port(
+      VERILOG_PORT_CONKT,
+      BasicPort(input_port_name, size_t(input_id), size_t(input_id)));
+    if ((true == circuit_lib.is_input_buffered(mux_model)) &&
+        (true == is_verilog_mux_buffer_inverted(
+                   circuit_lib, circuit_lib.input_buffer_model(mux_model)))) {
+      return std::string("~") + input_pin;
+    }
+    return input_pin;
+  }
+
+  std::vector<MuxEdgeId> edges = mux_graph.node_in_edges(node);
+  VTR_ASSERT(false == edges.empty());
+
+  std::vector<std::string> src_exprs;
+  for (const MuxEdgeId& edge : edges) {
+    std::vector<MuxNodeId> src_nodes = mux_graph.edge_src_nodes(edge);
+    VTR_ASSERT(1 == src_nodes.size());
+    src_exprs.push_back(generate_verilog_cmos_mux_node_behavioral_expression(
+      circuit_lib, mux_model, mux_graph, src_nodes[0], input_port_name,
+      mem_port_name, inter_inverter_location_map, two_state));
+  }
+
+  std::string node_expr;
+  if ((2 == edges.size()) && (mux_graph.find_edge_mem(edges[0]) ==
+                              mux_graph.find_edge_mem(edges[1])) &&
+      (mux_graph.is_edge_use_inv_mem(edges[0]) !=
+       mux_graph.is_edge_use_inv_mem(edges[1]))) {
+    /* A 2:1 branch is fully decoded by a single memory bit */
+    size_t mem = size_t(mux_graph.find_edge_mem(edges[0]));
+    size_t inv_edge = mux_graph.is_edge_use_inv_mem(edges[0]) ? 0 : 1;
+    node_expr =
+      generate_verilog_port(VERILOG_PORT_CONKT,
+                            BasicPort(mem_port_name, mem, mem)) +
+      " ? " + src_exprs[1 - inv_edge] + " : " + src_exprs[inv_edge];
+  } else {
+    for (size_t iedge = 0; iedge < edges.size(); ++iedge) {
+      size_t mem = size_t(mux_graph.find_edge_mem(edges[iedge]));
+      if (true == mux_graph.is_edge_use_inv_mem(edges[iedge])) {
+        node_expr += "~";
+      }
+      node_expr += generate_verilog_port(VERILOG_PORT_CONKT,
+                                         BasicPort(mem_port_name, mem, mem)) +
+                   " ? " + src_exprs[iedge] + " : ";
+    }
+    node_expr += two_state ? "1'b0" : "1'bz";
+  }
+  node_expr = "(" + node_expr + ")";
+
+  /* Intermediate buffers are only inserted at the nodes which are not
+   * outputs */
+  if ((true == inter_inverter_location_map[mux_graph.node_level(node)]) &&
+      (false == mux_graph.is_node_output(node))) {
+    node_expr = "~" + node_expr;
+  }
+
+  return node_expr;
+}
+
+/*********************************************************************
+ * Generate a behavioral Verilog module for a CMOS multiplexer, whose ports
+ * are the same as the structural module. Each output is modeled by a
+ * single continuous assignment which follows the multiplexer graph,
+ * including the inverters along the datapath, so that a multiplexer
+ * is a single event in simulation rather than a tree of pass-gates.
+ *
+ * The inverted memory bits are modeled from the regular memory bits, so
+ * the inverted memory port is left unused.
+ * Return false if the multiplexer can not be modeled, i.e., when it uses
+ * local encoders, and the structural module should be written instead
+ *********************************************************************/
+static bool print_verilog_cmos_mux_module_behavioral(
+  const ModuleManager& module_manager, const CircuitLibrary& circuit_lib,
+  std::fstream& fp, const CircuitModelId& mux_model,
+  const std::string& module_name, const MuxGraph& mux_graph,
+  const bool& two_state, const e_verilog_default_net_type& default_net_type) {
+  if (true == circuit_lib.mux_use_local_encoder(mux_model)) {
+    return false;
+  }
+
+  ModuleId mux_module = module_manager.find_module(module_name);
+  VTR_ASSERT(true == module_manager.valid_module_id(mux_module));
+
+  /* Find the ports in the same way as the module builder */
+  std::vector<CircuitPortId> mux_input_ports;
+  std::vector<CircuitPortId> mux_output_ports;
+  if (CIRCUIT_MODEL_LUT == circuit_lib.model_type(mux_model)) {
+    mux_input_ports =
+      find_lut_circuit_model_input_port(circuit_lib, mux_model, false, false);
+    mux_output_ports =
+      find_lut_circuit_model_output_port(circuit_lib, mux_model, false, true);
+  } else {
+    VTR_ASSERT(CIRCUIT_MODEL_MUX == circuit_lib.model_type(mux_model));
+    mux_input_ports = circuit_lib.model_ports_by_type(
+      mux_model, CIRCUIT_MODEL_PORT_INPUT, true);
+    mux_output_ports = circuit_lib.model_ports_by_type(
+      mux_model, CIRCUIT_MODEL_PORT_OUTPUT, false);
+  }
+  std::vector<CircuitPortId> mux_sram_ports =
+    find_circuit_regular_sram_ports(circuit_lib, mux_model);
+  VTR_ASSERT(1 == mux_input_ports.size());
+  VTR_ASSERT(1 == mux_sram_ports.size());
+  std::string input_port_name = circuit_lib.port_prefix(mux_input_ports[0]);
+  std::string mem_port_name = circuit_lib.port_prefix(mux_sram_ports[0]);
+
+  /* Find the levels where the intermediate buffers are inverters */
+  std::vector<bool> inter_inverter_location_map =
+    build_mux_intermediate_buffer_location_map(circuit_lib, mux_model,
+                                               mux_graph.num_node_levels());
+  if ((CIRCUIT_MODEL_LUT != circuit_lib.model_type(mux_model)) ||
+      (false == circuit_lib.is_lut_intermediate_buffered(mux_model)) ||
+      (false ==
+       is_verilog_mux_buffer_inverted(
+         circuit_lib, circuit_lib.lut_intermediate_buffer_model(mux_model)))) {
+    inter_inverter_location_map.assign(inter_inverter_location_map.size(),
+                                       false);
+  }
+  bool output_inverted =
+    (true == circuit_lib.is_output_buffered(mux_model)) &&
+    (true == is_verilog_mux_buffer_inverted(
+               circuit_lib, circuit_lib.output_buffer_model(mux_model)));
+
+  /* dump module definition + ports */
+  print_verilog_module_declaration(fp, module_manager, mux_module,
+                                   default_net_type);
+
+  print_verilog_comment(fp,
+                        std::string("---- Behavioral-level description -----"));
+
+  for (const auto& output_port : mux_output_ports) {
+    for (const size_t& pin : circuit_lib.pins(output_port)) {
+      /* Find the node driving the output pin, as the module builder does */
+      size_t output_node_level = mux_graph.num_node_levels() - 1;
+      if (size_t(-1) != circuit_lib.port_lut_frac_level(output_port)) {
+        output_node_level = circuit_lib.port_lut_frac_level(output_port);
+      }
+      size_t output_node_index_at_level = 0;
+      if (!circuit_lib.port_lut_output_mask(output_port).empty()) {
+        output_node_index_at_level =
+          circuit_lib.port_lut_output_mask(output_port).at(pin);
+      }
+      MuxNodeId node_id =
+        mux_graph.node_id(output_node_level, output_node_index_at_level);
+      VTR_ASSERT(MuxNodeId::INVALID() != node_id);
+
+      fp << "\tassign "
+         << generate_verilog_port(
+              VERILOG_PORT_CONKT,
+              BasicPort(circuit_lib.port_prefix(output_port), pin, pin))
+         << " = ";
+      if (true == output_inverted) {
+        fp << "~";
+      }
+      fp << generate_verilog_cmos_mux_node_behavioral_expression(
+              circuit_lib, mux_model, mux_graph, node_id, input_port_name,
+              mem_port_name, inter_inverter_location_map, two_state)
+         << ";" << std::endl;
+    }
+  }
+
+  /* Put an end to the Verilog module */
+  print_verilog_module_end(fp, module_name, default_net_type);
+
+  return true;
+}
+
 /***********************************************
  * Generate Verilog codes modeling a multiplexer
  * with the given graph-level description
@@ -1402,6 +1607,7 @@ static void generate_verilog_mux_module(
   ModuleManager& module_manager, const CircuitLibrary& circuit_lib,
   std::fstream& fp, const CircuitModelId& mux_model, const MuxGraph& mux_graph,
   const ModuleNameMap& module_name_map, const bool& use_explicit_port_map,
+  const bool& behavioral_mux, const bool& two_state,
   const e_verilog_default_net_type& default_net_type) {
   std::string module_name =
     generate_mux_subckt_name(circuit_lib, mux_model,
@@ -1414,6 +1620,15 @@ static void generate_verilog_mux_module(
    */
   switch (circuit_lib.design_tech_type(mux_model)) {
     case CIRCUIT_MODEL_DESIGN_CMOS: {
+      /* Behavioral modules are only written on request, for fast simulation */
+      if ((true == behavioral_mux) &&
+          (true == print_verilog_cmos_mux_module_behavioral(
+                     module_manager, circuit_lib, fp, mux_model, module_name,
+                     mux_graph, two_state, default_net_type))) {
+        /* Add an empty line as a splitter */
+        fp << std::endl;
+        break;
+      }
       /* Use Verilog writer to print the module to file */
       ModuleId mux_module = module_manager.find_module(module_name);
       VTR_ASSERT(true == module_manager.valid_module_id(mux_module));
@@ -1442,6 +1657,26 @@ static void generate_verilog_mux_module(
   }
 }
 
+/***********************************************
+ * Check if the Verilog module of a multiplexer is to be written, see
+ * find_verilog_modules_to_write(). The branch modules of a multiplexer are
+ * only written when the multiplexer is written
+ **********************************************/
+static bool is_verilog_mux_module_to_write(
+  const ModuleManager& module_manager, const CircuitLibrary& circuit_lib,
+  const CircuitModelId& mux_model, const MuxGraph& mux_graph,
+  const ModuleNameMap& module_name_map,
+  const vtr::vector<ModuleId, bool>& modules_to_write) {
+  std::string module_name =
+    generate_mux_subckt_name(circuit_lib, mux_model,
+                             find_mux_num_datapath_inputs(
+                               circuit_lib, mux_model, mux_graph.num_inputs()),
+                             std::string(""));
+  ModuleId mux_module =
+    module_manager.find_module(module_name_map.name(module_name));
+  return is_verilog_module_to_write(modules_to_write, mux_module);
+}
+
 /***********************************************
  * Generate primitive Verilog modules for all the unique
  * multiplexers in the FPGA device
@@ -1457,9 +1692,11 @@ static void print_verilog_submodule_mux_primitives(
 
   /* Create the file stream */
   std::fstream fp;
-  fp.open(verilog_fpath, std::fstream::out | std::fstream::trunc);
+  std::string verilog_staging_fpath =
+    find_staging_file_path(verilog_fpath, options.keep_unchanged_files());
+  fp.open(verilog_staging_fpath, std::fstream::out | std::fstream::trunc);
 
-  check_file_stream(verilog_fpath.c_str(), fp);
+  check_file_stream(verilog_staging_fpath.c_str(), fp);
 
   /* Print out debugging information for if the file is not opened/created
    * properly */
@@ -1474,11 +1711,19 @@ static void print_verilog_submodule_mux_primitives(
    */
   std::map<std::string, bool> branch_mux_module_is_outputted;
 
+  vtr::vector<ModuleId, bool> modules_to_write =
+    find_verilog_modules_to_write(module_manager, module_name_map, options);
+
   /* Generate basis sub-circuit for unique branches shared by the multiplexers
    */
   for (auto mux : mux_lib.muxes()) {
     const MuxGraph& mux_graph = mux_lib.mux_graph(mux);
     CircuitModelId mux_circuit_model = mux_lib.mux_circuit_model(mux);
+    if (false == is_verilog_mux_module_to_write(
+                   module_manager, circuit_lib, mux_circuit_model, mux_graph,
+                   module_name_map, modules_to_write)) {
+      continue;
+    }
     /* Create a mux graph for the branch circuit */
     std::vector<MuxGraph> branch_mux_graphs =
       mux_graph.build_mux_branch_graphs();
@@ -1486,23 +1731,17 @@ static void print_verilog_submodule_mux_primitives(
     for (auto branch_mux_graph : branch_mux_graphs) {
       generate_verilog_mux_branch_module(
         module_manager, circuit_lib, fp, mux_circuit_model, branch_mux_graph,
-        module_name_map, options.explicit_port_mapping(),
+        module_name_map, options.explicit_port_mapping(), options.two_state(),
         options.default_net_type(), branch_mux_module_is_outputted);
     }
   }
 
   /* Close the file stream */
   fp.close();
-
-  /* Add fname to the netlist name list */
-  NetlistId nlist_id = NetlistId::INVALID();
-  if (options.use_relative_path()) {
-    nlist_id = netlist_manager.add_netlist(submodule_dir_name + verilog_fname);
-  } else {
-    nlist_id = netlist_manager.add_netlist(verilog_fpath);
-  }
-  VTR_ASSERT(nlist_id);
-  netlist_manager.set_netlist_type(nlist_id, NetlistManager::SUBMODULE_NETLIST);
+  /* Commit the file and add fname to the netlist name list */
+  commit_verilog_submodule_netlist(netlist_manager, verilog_staging_fpath,
+                                   verilog_fpath, submodule_dir_name,
+                                   verilog_fname, options);
 
   VTR_LOG("Done\n");
 }
@@ -1522,9 +1761,11 @@ static void print_verilog_submodule_mux_top_modules(
 
   /* Create the file stream */
   std::fstream fp;
-  fp.open(verilog_fpath, std::fstream::out | std::fstream::trunc);
+  std::string verilog_staging_fpath =
+    find_staging_file_path(verilog_fpath, options.keep_unchanged_files());
+  fp.open(verilog_staging_fpath, std::fstream::out | std::fstream::trunc);
 
-  check_file_stream(verilog_fpath.c_str(), fp);
+  check_file_stream(verilog_staging_fpath.c_str(), fp);
 
   /* Print out debugging information for if the file is not opened/created
    * properly */
@@ -1533,29 +1774,33 @@ static void print_verilog_submodule_mux_top_modules(
 
   print_verilog_file_header(fp, "Multiplexers", options.time_stamp());
 
+  vtr::vector<ModuleId, bool> modules_to_write =
+    find_verilog_modules_to_write(module_manager, module_name_map, options);
+
   /* Generate unique Verilog modules for the multiplexers */
   for (auto mux : mux_lib.muxes()) {
     const MuxGraph& mux_graph = mux_lib.mux_graph(mux);
     CircuitModelId mux_circuit_model = mux_lib.mux_circuit_model(mux);
+    if (false == is_verilog_mux_module_to_write(
+                   module_manager, circuit_lib, mux_circuit_model, mux_graph,
+                   module_name_map, modules_to_write)) {
+      continue;
+    }
     /* Create MUX circuits */
     generate_verilog_mux_module(module_manager, circuit_lib, fp,
                                 mux_circuit_model, mux_graph, module_name_map,
                                 options.explicit_port_mapping(),
+                                options.behavioral_muxes(),
+                                options.two_state(),
                                 options.default_net_type());
   }
 
   /* Close the file stream */
   fp.close();
-
-  /* Add fname to the netlist name list */
-  NetlistId nlist_id = NetlistId::INVALID();
-  if (options.use_relative_path()) {
-    nlist_id = netlist_manager.add_netlist(submodule_dir_name + verilog_fname);
-  } else {
-    nlist_id = netlist_manager.add_netlist(verilog_fpath);
-  }
-  VTR_ASSERT(nlist_id);
-  netlist_manager.set_netlist_type(nlist_id, NetlistManager::SUBMODULE_NETLIST);
+  /* Commit the file and add fname to the netlist name list */
+  commit_verilog_submodule_netlist(netlist_manager, verilog_staging_fpath,
+                                   verilog_fpath, submodule_dir_name,
+                                   verilog_fname, options);
 
   VTR_LOG("Done\n");
 }
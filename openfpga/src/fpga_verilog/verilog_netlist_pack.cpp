@@ -0,0 +1,131 @@
+/********************************************************************
+ * Member functions for the data structure VerilogNetlistPack
+ *******************************************************************/
+#include "verilog_netlist_pack.h"
+
+/* Headers from vtrutil library */
+#include "vtr_assert.h"
+
+/* Headers from openfpgautil library */
+#include "openfpga_digest.h"
+#include "verilog_constants.h"
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+/************************************************************************
+ * Constructors
+ ***********************************************************************/
+VerilogNetlistPack::VerilogNetlistPack(const std::string& shard_fpath_prefix,
+                                       const size_t& max_shard_size,
+                                       const bool& keep_unchanged_files)
+  : shard_fpath_prefix_(shard_fpath_prefix),
+    max_shard_size_(max_shard_size),
+    keep_unchanged_files_(keep_unchanged_files) {}
+
+/************************************************************************
+ * Public Accessors
+ ***********************************************************************/
+const std::vector<std::string>& VerilogNetlistPack::shards() const {
+  return shards_;
+}
+
+/************************************************************************
+ * Public Mutators
+ ***********************************************************************/
+std::fstream& VerilogNetlistPack::open_netlist() {
+  mutex_.lock();
+
+  /* Start a new shard if there is none or if the current one is full */
+  if ((true == fp_.is_open()) && (0 != max_shard_size_) &&
+      (size_t(fp_.tellp()) >= max_shard_size_)) {
+    close_shard();
+  }
+  if (false == fp_.is_open()) {
+    std::string shard_fpath = shard_fpath_prefix_ +
+                              std::to_string(shards_.size()) +
+                              std::string(VERILOG_NETLIST_FILE_POSTFIX);
+    shard_staging_fpath_ =
+      find_staging_file_path(shard_fpath, keep_unchanged_files_);
+    fp_.open(shard_staging_fpath_, std::fstream::out | std::fstream::trunc);
+    check_file_stream(shard_staging_fpath_.c_str(), fp_);
+    shards_.push_back(shard_fpath);
+  }
+
+  return fp_;
+}
+
+void VerilogNetlistPack::close_netlist() { mutex_.unlock(); }
+
+void VerilogNetlistPack::close() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (true == fp_.is_open()) {
+    close_shard();
+  }
+}
+
+/************************************************************************
+ * Internal Mutators
+ ***********************************************************************/
+void VerilogNetlistPack::close_shard() {
+  VTR_ASSERT(false == shards_.empty());
+  fp_.close();
+  commit_staging_file(shard_staging_fpath_, shards_.back());
+}
+
+/********************************************************************
+ * Open the stream to which a netlist is written
+ * The netlist is written to its own file, through the given file stream,
+ * unless a pack of netlists is defined
+ *******************************************************************/
+std::fstream& open_verilog_netlist_stream(std::fstream& fp,
+                                          const std::string& staging_fpath,
+                                          VerilogNetlistPack* netlist_pack) {
+  if (nullptr != netlist_pack) {
+    return netlist_pack->open_netlist();
+  }
+  fp.open(staging_fpath, std::fstream::out | std::fstream::trunc);
+  check_file_stream(staging_fpath.c_str(), fp);
+  return fp;
+}
+
+/********************************************************************
+ * Close the stream to which a netlist has been written
+ * Return true if the netlist has been written to its own file, which
+ * should be added to the netlist manager. The shards of a pack are added
+ * once all the netlists have been written
+ *******************************************************************/
+bool close_verilog_netlist_stream(std::fstream& fp,
+                                  const std::string& staging_fpath,
+                                  const std::string& fpath,
+                                  VerilogNetlistPack* netlist_pack) {
+  if (nullptr != netlist_pack) {
+    netlist_pack->close_netlist();
+    return false;
+  }
+  fp.close();
+  commit_staging_file(staging_fpath, fpath);
+  return true;
+}
+
+/********************************************************************
+ * Add a netlist which has its own file to the netlist name list.
+ * This is also called for the netlists written by other partitions, so
+ * that the netlist name list is complete in every partition
+ *******************************************************************/
+void add_verilog_netlist_to_manager(
+  NetlistManager& netlist_manager, const std::string& subckt_dir_name,
+  const std::string& verilog_fname, const std::string& verilog_fpath,
+  const NetlistManager::e_netlist_type& netlist_type,
+  const FabricVerilogOption& options) {
+  NetlistId nlist_id = NetlistId::INVALID();
+  if (options.use_relative_path()) {
+    nlist_id = netlist_manager.add_netlist(subckt_dir_name + verilog_fname);
+  } else {
+    nlist_id = netlist_manager.add_netlist(verilog_fpath);
+  }
+  VTR_ASSERT(nlist_id);
+  netlist_manager.set_netlist_type(nlist_id, netlist_type);
+}
+
+} /* end namespace openfpga */
@@ -0,0 +1,85 @@
+#ifndef VERILOG_NETLIST_PACK_H
+#define VERILOG_NETLIST_PACK_H
+
+/********************************************************************
+ * Include header files required by the data structure definition
+ *******************************************************************/
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "fabric_verilog_options.h"
+#include "netlist_manager.h"
+
+/* namespace openfpga begins */
+namespace openfpga {
+
+/********************************************************************
+ * A pack of Verilog netlists, which are written one after another to a
+ * few large files (shards) through a single sequential stream, instead
+ * of being written to a file each.
+ *
+ * A new shard is started when the current one has reached the maximum
+ * size. Netlists are never split over two shards, so a shard may exceed
+ * the maximum size by the size of its last netlist. A maximum size of 0
+ * means that all the netlists are written to a single shard.
+ *
+ * Note:
+ * - A netlist is written between a pair of open_netlist() and
+ *   close_netlist(). The pack is locked in the meantime, so that
+ *   netlists can be written by multiple threads, one at a time
+ *******************************************************************/
+class VerilogNetlistPack {
+ public: /* Constructors */
+  VerilogNetlistPack(const std::string& shard_fpath_prefix,
+                     const size_t& max_shard_size,
+                     const bool& keep_unchanged_files);
+
+ public: /* Public accessors */
+  /* Find the paths of the shards that have been written */
+  const std::vector<std::string>& shards() const;
+
+ public: /* Public mutators */
+  /* Lock the pack and find the stream to which a netlist is written */
+  std::fstream& open_netlist();
+  /* Unlock the pack once a netlist has been written */
+  void close_netlist();
+  /* Close the last shard, which must be called once all the netlists have
+   * been written */
+  void close();
+
+ private: /* Internal mutators */
+  void close_shard();
+
+ private: /* Internal data */
+  std::string shard_fpath_prefix_;
+  size_t max_shard_size_;
+  bool keep_unchanged_files_;
+  std::vector<std::string> shards_;
+  std::string shard_staging_fpath_;
+  std::fstream fp_;
+  std::mutex mutex_;
+};
+
+/********************************************************************
+ * Function declaration
+ *******************************************************************/
+std::fstream& open_verilog_netlist_stream(std::fstream& fp,
+                                          const std::string& staging_fpath,
+                                          VerilogNetlistPack* netlist_pack);
+
+bool close_verilog_netlist_stream(std::fstream& fp,
+                                  const std::string& staging_fpath,
+                                  const std::string& fpath,
+                                  VerilogNetlistPack* netlist_pack);
+
+void add_verilog_netlist_to_manager(
+  NetlistManager& netlist_manager, const std::string& subckt_dir_name,
+  const std::string& verilog_fname, const std::string& verilog_fpath,
+  const NetlistManager::e_netlist_type& netlist_type,
+  const FabricVerilogOption& options);
+
+} /* end namespace openfpga */
+
+#endif
@@ -2,6 +2,7 @@
  * This file includes functions that are used to generate
  * a Verilog module of a pre-configured FPGA fabric
  *******************************************************************/
+#include <algorithm>
 #include <fstream>
 
 /* Headers from vtrutil library */
@@ -15,6 +16,7 @@
 #include "openfpga_atom_netlist_utils.h"
 #include "openfpga_digest.h"
 #include "openfpga_naming.h"
+#include "openfpga_parallel.h"
 #include "openfpga_port.h"
 #include "openfpga_reserved_words.h"
 #include "verilog_constants.h"
@@ -132,161 +134,299 @@ static void print_verilog_preconfig_top_module_ports(
 }
 
 /********************************************************************
- * Impose the bitstream on the configuration memories
- * This function uses 'assign' syntax to impost the bitstream at mem port
- * while uses 'force' syntax to impost the bitstream at mem_inv port
+ * Append the statements which impose the bitstream of a configurable block
+ * on its configuration memories:
+ * - 'force' syntax is used for iVerilog
+ * - '$deposit' syntax is used for other simulators
+ * The values are either constants, or a word of the bitstream memory when
+ * the memory index is valid. In the latter case, the bits of the block are
+ * appended to the memory buffer as a line of the memory file
  *******************************************************************/
-static void print_verilog_preconfig_top_module_force_bitstream(
-  std::fstream &fp, const std::string &top_block_name,
-  const BitstreamManager &bitstream_manager, const bool &output_datab_bits) {
-  /* Validate the file stream */
-  valid_file_stream(fp);
+static void append_verilog_preconfig_top_module_block_bitstream(
+  std::string &buffer, std::string &memory_buffer,
+  const BitstreamManager &bitstream_manager, const ConfigBlockId &block,
+  const std::string &bit_hierarchy_path,
+  const e_embedded_bitstream_hdl_type &embedded_bitstream_hdl_type,
+  const bool &output_datab_bits, const size_t &memory_index,
+  const size_t &memory_width) {
+  std::vector<ConfigBitId> block_bits = bitstream_manager.block_bits(block);
+  bool use_memory = (size_t(-1) != memory_index);
+
+  /* Access both data out and data outb ports */
+  std::vector<std::string> port_names;
+  port_names.push_back(generate_configurable_memory_data_out_name());
+  if (true == output_datab_bits) {
+    port_names.push_back(generate_configurable_memory_inverted_data_out_name());
+  }
 
-  print_verilog_comment(
-    fp, std::string(
-          "----- Begin assign bitstream to configuration memories -----"));
+  std::vector<size_t> config_values(block_bits.size());
+  for (size_t iport = 0; iport < port_names.size(); ++iport) {
+    bool inverted = (1 == iport);
+    BasicPort config_port(bit_hierarchy_path + port_names[iport],
+                          block_bits.size());
+
+    buffer += '\t';
+    if (EMBEDDED_BITSTREAM_HDL_IVERILOG == embedded_bitstream_hdl_type) {
+      buffer += "force ";
+      append_verilog_port(buffer, VERILOG_PORT_CONKT, config_port);
+      buffer += " = ";
+    } else {
+      buffer += "$deposit(";
+      append_verilog_port(buffer, VERILOG_PORT_CONKT, config_port);
+      buffer += ", ";
+    }
 
-  fp << "initial begin" << std::endl;
+    if (true == use_memory) {
+      if (true == inverted) {
+        buffer += '~';
+      }
+      buffer += FORMAL_VERIFICATION_BITSTREAM_MEM_REG_NAME;
+      buffer += '[';
+      append_verilog_number(buffer, memory_index);
+      buffer += "][0:";
+      append_verilog_number(buffer, block_bits.size() - 1);
+      buffer += ']';
+    } else {
+      for (size_t ibit = 0; ibit < block_bits.size(); ++ibit) {
+        config_values[ibit] =
+          (inverted != bitstream_manager.bit_value(block_bits[ibit]));
+      }
+      append_verilog_constant_values(buffer, config_values);
+    }
 
-  for (const ConfigBlockId &config_block_id : bitstream_manager.blocks()) {
-    /* We only cares blocks with configuration bits */
-    if (0 == bitstream_manager.block_bits(config_block_id).size()) {
-      continue;
+    if (EMBEDDED_BITSTREAM_HDL_IVERILOG == embedded_bitstream_hdl_type) {
+      buffer += ";\n";
+    } else {
+      buffer += ");\n";
     }
-    /* Build the hierarchical path of the configuration bit in modules */
-    std::vector<ConfigBlockId> block_hierarchy =
-      find_bitstream_manager_block_hierarchy(bitstream_manager, config_block_id,
-                                             top_block_name);
-    /* Ensure that this is the module we want to drop! */
-    VTR_ASSERT(top_block_name ==
-               bitstream_manager.block_name(block_hierarchy[0]));
-    block_hierarchy.erase(block_hierarchy.begin());
-    /* Build the full hierarchy path */
-    std::string bit_hierarchy_path(FORMAL_VERIFICATION_TOP_MODULE_UUT_NAME);
-    for (const ConfigBlockId &temp_block : block_hierarchy) {
-      bit_hierarchy_path += std::string(".");
-      bit_hierarchy_path += bitstream_manager.block_name(temp_block);
+  }
+
+  /* Bits are aligned to the MSB of the memory word */
+  if (true == use_memory) {
+    for (const ConfigBitId &config_bit : block_bits) {
+      memory_buffer += bitstream_manager.bit_value(config_bit) ? '1' : '0';
     }
-    bit_hierarchy_path += std::string(".");
-
-    /* Find the bit index in the parent block */
-    BasicPort config_data_port(
-      bit_hierarchy_path + generate_configurable_memory_data_out_name(),
-      bitstream_manager.block_bits(config_block_id).size());
-
-    /* Wire it to the configuration bit: access both data out and data outb
-     * ports */
-    std::vector<size_t> config_data_values;
-    for (const ConfigBitId config_bit :
-         bitstream_manager.block_bits(config_block_id)) {
-      config_data_values.push_back(bitstream_manager.bit_value(config_bit));
+    memory_buffer.append(memory_width - block_bits.size(), '0');
+    memory_buffer += '\n';
+  }
+}
+
+/********************************************************************
+ * Split the configurable blocks into groups, each of which includes the
+ * blocks under the same configurable child of the top block. The blocks are
+ * kept in the order of the bitstream manager, a new group being started each
+ * time the configurable child changes, so that the groups can be generated
+ * independently and printed in the original order.
+ * Return the index of the first block of each group
+ *******************************************************************/
+static std::vector<size_t> find_verilog_preconfig_top_module_block_groups(
+  const BitstreamManager &bitstream_manager,
+  const std::vector<ConfigBlockId> &config_blocks,
+  const size_t &top_block_path_size) {
+  std::vector<size_t> group_starts;
+  std::string curr_child_path;
+  for (size_t iblk = 0; iblk < config_blocks.size(); ++iblk) {
+    const std::string &block_path =
+      bitstream_manager.block_path(config_blocks[iblk]);
+    /* The path of the configurable child ends at the next dot after the top
+     * block, if any */
+    size_t child_path_end = block_path.find('.', top_block_path_size + 1);
+    if (std::string::npos == child_path_end) {
+      child_path_end = block_path.size();
     }
-    print_verilog_force_wire_constant_values(fp, config_data_port,
-                                             config_data_values);
-
-    if (true == output_datab_bits) {
-      /* Find the bit index in the parent block */
-      BasicPort config_datab_port(
-        bit_hierarchy_path +
-          generate_configurable_memory_inverted_data_out_name(),
-        bitstream_manager.block_bits(config_block_id).size());
-
-      std::vector<size_t> config_datab_values;
-      for (const ConfigBitId config_bit :
-           bitstream_manager.block_bits(config_block_id)) {
-        config_datab_values.push_back(!bitstream_manager.bit_value(config_bit));
-      }
-      print_verilog_force_wire_constant_values(fp, config_datab_port,
-                                               config_datab_values);
+    if ((true == group_starts.empty()) ||
+        (0 != block_path.compare(0, child_path_end, curr_child_path))) {
+      group_starts.push_back(iblk);
+      curr_child_path = block_path.substr(0, child_path_end);
     }
   }
-
-  fp << "end" << std::endl;
-
-  print_verilog_comment(
-    fp,
-    std::string("----- End assign bitstream to configuration memories -----"));
+  return group_starts;
 }
 
 /********************************************************************
  * Impose the bitstream on the configuration memories
- * This function uses '$deposit' syntax to do so
+ * - iVerilog Icarus uses 'force' syntax to impose the bitstream at both
+ *   mem and mem_inv ports
+ * - Other simulators use '$deposit' syntax to do so
+ *
+ * The statements are generated by groups of configurable blocks, with
+ * multiple threads, and are printed in the order of the bitstream manager.
+ * The hierarchical path of each block is derived from the path cached by the
+ * bitstream manager, by replacing the top block with the instance name of
+ * the FPGA fabric.
+ *
+ * When a bitstream memory file is required, the bits of each block are a
+ * word of the file, which is loaded by $readmemb before imposing the
+ * bitstream. The statements then refer to the words of the memory
+ *
+ * When a shared bitstream loader is required, the memory and the statements
+ * are written to the loader netlist, which is included by the wrapper. The
+ * loader only depends on the fabric, and reads the bitstream memory file
+ * given by a plusarg at simulation time, so that it is written once for all
+ * the designs. The loader netlist is left in place if unchanged
  *******************************************************************/
-static void print_verilog_preconfig_top_module_deposit_bitstream(
+static void print_verilog_preconfig_top_module_embed_bitstream(
   std::fstream &fp, const std::string &top_block_name,
-  const BitstreamManager &bitstream_manager, const bool &output_datab_bits) {
+  const BitstreamManager &bitstream_manager, const bool &output_datab_bits,
+  const e_embedded_bitstream_hdl_type &embedded_bitstream_hdl_type,
+  const std::string &bitstream_memory_fname,
+  const std::string &bitstream_loader_fname, const bool &include_time_stamp,
+  const size_t &num_threads) {
   /* Validate the file stream */
   valid_file_stream(fp);
 
-  print_verilog_comment(
-    fp, std::string(
-          "----- Begin deposit bitstream to configuration memories -----"));
-
-  fp << "initial begin" << std::endl;
+  std::string action_name("assign");
+  if (EMBEDDED_BITSTREAM_HDL_IVERILOG != embedded_bitstream_hdl_type) {
+    action_name = "deposit";
+  }
 
+  /* We only cares blocks with configuration bits */
+  std::vector<ConfigBlockId> config_blocks;
+  size_t memory_width = 0;
   for (const ConfigBlockId &config_block_id : bitstream_manager.blocks()) {
-    /* We only cares blocks with configuration bits */
-    if (0 == bitstream_manager.block_bits(config_block_id).size()) {
+    size_t num_block_bits = bitstream_manager.num_block_bits(config_block_id);
+    if (0 == num_block_bits) {
       continue;
     }
-    /* Build the hierarchical path of the configuration bit in modules */
+    config_blocks.push_back(config_block_id);
+    memory_width = std::max(memory_width, num_block_bits);
+  }
+  bool use_memory =
+    (false == bitstream_memory_fname.empty()) && (!config_blocks.empty());
+  bool use_loader =
+    (true == use_memory) && (false == bitstream_loader_fname.empty());
+
+  /* Find the top block, whose path is dropped from the path of any block */
+  size_t top_block_path_size = 0;
+  if (false == config_blocks.empty()) {
     std::vector<ConfigBlockId> block_hierarchy =
-      find_bitstream_manager_block_hierarchy(bitstream_manager, config_block_id,
-                                             top_block_name);
-    /* Drop the first block, which is the top module, it should be replaced by
-     * the instance name here */
+      find_bitstream_manager_block_hierarchy(bitstream_manager,
+                                             config_blocks[0], top_block_name);
     /* Ensure that this is the module we want to drop! */
     VTR_ASSERT(top_block_name ==
                bitstream_manager.block_name(block_hierarchy[0]));
-    block_hierarchy.erase(block_hierarchy.begin());
-
-    /* Build the full hierarchy path */
-    std::string bit_hierarchy_path(FORMAL_VERIFICATION_TOP_MODULE_UUT_NAME);
-    for (const ConfigBlockId &temp_block : block_hierarchy) {
-      bit_hierarchy_path += std::string(".");
-      bit_hierarchy_path += bitstream_manager.block_name(temp_block);
-    }
-    bit_hierarchy_path += std::string(".");
-
-    /* Find the bit index in the parent block */
-    BasicPort config_data_port(
-      bit_hierarchy_path + generate_configurable_memory_data_out_name(),
-      bitstream_manager.block_bits(config_block_id).size());
-
-    /* Wire it to the configuration bit: access both data out and data outb
-     * ports */
-    std::vector<size_t> config_data_values;
-    for (const ConfigBitId config_bit :
-         bitstream_manager.block_bits(config_block_id)) {
-      config_data_values.push_back(bitstream_manager.bit_value(config_bit));
-    }
-    print_verilog_deposit_wire_constant_values(fp, config_data_port,
-                                               config_data_values);
+    top_block_path_size =
+      bitstream_manager.block_path(block_hierarchy[0]).size();
+  }
 
-    /* Skip datab ports if specified */
-    if (false == output_datab_bits) {
-      continue;
-    }
+  /* The statements are written either to the wrapper or to the loader */
+  std::fstream loader_fp;
+  std::string loader_staging_fname;
+  if (true == use_loader) {
+    loader_staging_fname = find_staging_file_path(bitstream_loader_fname, true);
+    loader_fp.open(loader_staging_fname,
+                   std::fstream::out | std::fstream::trunc);
+    check_file_stream(loader_staging_fname.c_str(), loader_fp);
+    print_verilog_file_header(
+      loader_fp,
+      std::string("Loader of bitstream memory files for pre-configured FPGA "
+                  "fabric"),
+      include_time_stamp);
+
+    print_verilog_include_netlist(fp, bitstream_loader_fname);
+  }
+  std::fstream &stmt_fp = use_loader ? loader_fp : fp;
+
+  std::fstream memory_fp;
+  if (true == use_memory) {
+    memory_fp.open(bitstream_memory_fname,
+                   std::fstream::out | std::fstream::trunc);
+    check_file_stream(bitstream_memory_fname.c_str(), memory_fp);
+
+    print_verilog_comment(
+      stmt_fp,
+      std::string("----- Virtual memory to store the bitstream -----"));
+    stmt_fp << "reg [0:" << memory_width - 1 << "] "
+            << FORMAL_VERIFICATION_BITSTREAM_MEM_REG_NAME << "[0:"
+            << config_blocks.size() - 1 << "];" << std::endl;
+  }
+  if (true == use_loader) {
+    stmt_fp << "reg [8*" << FORMAL_VERIFICATION_BITSTREAM_MEM_FILE_MAX_LENGTH
+            << ":1] " << FORMAL_VERIFICATION_BITSTREAM_MEM_FILE_REG_NAME << ";"
+            << std::endl;
+  }
 
-    BasicPort config_datab_port(
-      bit_hierarchy_path +
-        generate_configurable_memory_inverted_data_out_name(),
-      bitstream_manager.block_bits(config_block_id).size());
+  print_verilog_comment(stmt_fp, std::string("----- Begin ") + action_name +
+                                   std::string(" bitstream to configuration "
+                                               "memories -----"));
+
+  stmt_fp << "initial begin" << std::endl;
+
+  if (true == use_loader) {
+    stmt_fp << "\tif (!$value$plusargs(\""
+            << FORMAL_VERIFICATION_BITSTREAM_MEM_PLUSARG << "=%s\", "
+            << FORMAL_VERIFICATION_BITSTREAM_MEM_FILE_REG_NAME << ")) begin"
+            << std::endl;
+    stmt_fp << "\t\t$display(\"Error: no bitstream memory file is given by +"
+            << FORMAL_VERIFICATION_BITSTREAM_MEM_PLUSARG << "=<file>\");"
+            << std::endl;
+    stmt_fp << "\t\t$finish;" << std::endl;
+    stmt_fp << "\tend" << std::endl;
+    stmt_fp << "\t$readmemb(" << FORMAL_VERIFICATION_BITSTREAM_MEM_FILE_REG_NAME
+            << ", " << FORMAL_VERIFICATION_BITSTREAM_MEM_REG_NAME << ");"
+            << std::endl;
+  } else if (true == use_memory) {
+    stmt_fp << "\t$readmemb(\"" << bitstream_memory_fname << "\", "
+            << FORMAL_VERIFICATION_BITSTREAM_MEM_REG_NAME << ");" << std::endl;
+  }
 
-    std::vector<size_t> config_datab_values;
-    for (const ConfigBitId config_bit :
-         bitstream_manager.block_bits(config_block_id)) {
-      config_datab_values.push_back(!bitstream_manager.bit_value(config_bit));
+  std::vector<size_t> group_starts =
+    find_verilog_preconfig_top_module_block_groups(
+      bitstream_manager, config_blocks, top_block_path_size);
+  group_starts.push_back(config_blocks.size());
+  size_t num_groups = group_starts.size() - 1;
+
+  /* Groups are generated in batches, so that only a few of them are held in
+   * memory before being printed */
+  size_t batch_size = 4 * find_num_threads(num_threads);
+  std::vector<std::string> group_buffers(batch_size);
+  std::vector<std::string> group_memory_buffers(batch_size);
+  for (size_t batch_start = 0; batch_start < num_groups;
+       batch_start += batch_size) {
+    size_t batch_end = std::min(batch_start + batch_size, num_groups);
+    parallel_for(
+      batch_end - batch_start, num_threads, [&](const size_t &ibatch) {
+        std::string &buffer = group_buffers[ibatch];
+        std::string &memory_buffer = group_memory_buffers[ibatch];
+        buffer.clear();
+        memory_buffer.clear();
+        size_t igroup = batch_start + ibatch;
+        for (size_t iblk = group_starts[igroup];
+             iblk < group_starts[igroup + 1]; ++iblk) {
+          const std::string &block_path =
+            bitstream_manager.block_path(config_blocks[iblk]);
+          std::string bit_hierarchy_path(
+            FORMAL_VERIFICATION_TOP_MODULE_UUT_NAME);
+          bit_hierarchy_path.append(block_path, top_block_path_size,
+                                    std::string::npos);
+          bit_hierarchy_path += '.';
+          append_verilog_preconfig_top_module_block_bitstream(
+            buffer, memory_buffer, bitstream_manager, config_blocks[iblk],
+            bit_hierarchy_path, embedded_bitstream_hdl_type, output_datab_bits,
+            use_memory ? iblk : size_t(-1), memory_width);
+        }
+      });
+    for (size_t ibatch = 0; ibatch < batch_end - batch_start; ++ibatch) {
+      stmt_fp << group_buffers[ibatch];
+      if (true == use_memory) {
+        memory_fp << group_memory_buffers[ibatch];
+      }
     }
-    print_verilog_deposit_wire_constant_values(fp, config_datab_port,
-                                               config_datab_values);
   }
 
-  fp << "end" << std::endl;
+  stmt_fp << "end" << std::endl;
 
-  print_verilog_comment(
-    fp,
-    std::string("----- End deposit bitstream to configuration memories -----"));
+  print_verilog_comment(stmt_fp, std::string("----- End ") + action_name +
+                                   std::string(" bitstream to configuration "
+                                               "memories -----"));
+
+  if (true == use_memory) {
+    memory_fp.close();
+  }
+  if (true == use_loader) {
+    loader_fp.close();
+    commit_staging_file(loader_staging_fname, bitstream_loader_fname);
+  }
 }
 
 /********************************************************************
@@ -299,7 +439,10 @@ static void print_verilog_preconfig_top_module_load_bitstream(
   std::fstream &fp, const std::string &top_block_name,
   const CircuitLibrary &circuit_lib, const CircuitModelId &mem_model,
   const BitstreamManager &bitstream_manager,
-  const e_embedded_bitstream_hdl_type &embedded_bitstream_hdl_type) {
+  const e_embedded_bitstream_hdl_type &embedded_bitstream_hdl_type,
+  const std::string &bitstream_memory_fname,
+  const std::string &bitstream_loader_fname, const bool &include_time_stamp,
+  const size_t &num_threads) {
   /* Skip the datab port if there is only 1 output port in memory model
    * Currently, it assumes that the data output port is always defined while
    * datab is optional If we see only 1 port, we assume datab is not defined by
@@ -317,14 +460,14 @@ static void print_verilog_preconfig_top_module_load_bitstream(
     fp,
     std::string("----- Begin load bitstream to configuration memories -----"));
 
-  /* Use assign syntax for Icarus simulator */
-  if (EMBEDDED_BITSTREAM_HDL_IVERILOG == embedded_bitstream_hdl_type) {
-    print_verilog_preconfig_top_module_force_bitstream(
-      fp, top_block_name, bitstream_manager, output_datab_bits);
-    /* Use deposit syntax for other simulators */
-  } else if (EMBEDDED_BITSTREAM_HDL_MODELSIM == embedded_bitstream_hdl_type) {
-    print_verilog_preconfig_top_module_deposit_bitstream(
-      fp, top_block_name, bitstream_manager, output_datab_bits);
+  /* Use force syntax for Icarus simulator and deposit syntax for other
+   * simulators */
+  if ((EMBEDDED_BITSTREAM_HDL_IVERILOG == embedded_bitstream_hdl_type) ||
+      (EMBEDDED_BITSTREAM_HDL_MODELSIM == embedded_bitstream_hdl_type)) {
+    print_verilog_preconfig_top_module_embed_bitstream(
+      fp, top_block_name, bitstream_manager, output_datab_bits,
+      embedded_bitstream_hdl_type, bitstream_memory_fname,
+      bitstream_loader_fname, include_time_stamp, num_threads);
   }
 
   print_verilog_comment(
@@ -374,6 +517,8 @@ int print_verilog_preconfig_top_module(
   const IoNameMap &io_name_map, const ModuleNameMap &module_name_map,
   const VprNetlistAnnotation &netlist_annotation,
   const std::string &circuit_name, const std::string &verilog_fname,
+  const std::string &bitstream_memory_fname,
+  const std::string &bitstream_loader_fname,
   const VerilogTestbenchOption &options) {
   std::string timer_message =
     std::string(
@@ -478,7 +623,10 @@ int print_verilog_preconfig_top_module(
    * when needed */
   print_verilog_preconfig_top_module_load_bitstream(
     fp, inst_name, circuit_lib, sram_model, bitstream_manager,
-    options.embedded_bitstream_hdl_type());
+    options.embedded_bitstream_hdl_type(),
+    options.embed_bitstream_memory() ? bitstream_memory_fname : std::string(),
+    options.shared_bitstream_loader() ? bitstream_loader_fname : std::string(),
+    options.time_stamp(), options.num_threads());
 
   /* Add signal initialization:
    * Bypass writing codes to files due to the autogenerated codes are very
@@ -38,6 +38,8 @@ int print_verilog_preconfig_top_module(
   const IoNameMap& io_name_map, const ModuleNameMap& module_name_map,
   const VprNetlistAnnotation& netlist_annotation,
   const std::string& circuit_name, const std::string& verilog_fname,
+  const std::string& bitstream_memory_fname,
+  const std::string& bitstream_loader_fname,
   const VerilogTestbenchOption& options);
 
 } /* end namespace openfpga */
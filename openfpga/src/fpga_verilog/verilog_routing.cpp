@@ -9,9 +9,12 @@
 
 /* Headers from openfpgautil library */
 #include "openfpga_digest.h"
+#include "openfpga_parallel.h"
+#include "openfpga_progress.h"
 
 /* Include FPGA-Verilog header files*/
 #include "openfpga_naming.h"
+#include "openfpga_trace.h"
 #include "verilog_constants.h"
 #include "verilog_module_writer.h"
 #include "verilog_routing.h"
@@ -77,6 +80,7 @@ namespace openfpga {
  ********************************************************************/
 static void print_verilog_routing_connection_box_unique_module(
   NetlistManager& netlist_manager, const ModuleManager& module_manager,
+  VerilogModuleWireLayout& wire_layout, VerilogNetlistPack* netlist_pack,
   const ModuleNameMap& module_name_map, const std::string& subckt_dir,
   const std::string& subckt_dir_name, const RRGSB& rr_gsb,
   const t_rr_type& cb_type, const FabricVerilogOption& options) {
@@ -87,6 +91,10 @@ static void print_verilog_routing_connection_box_unique_module(
     cb_type, gsb_coordinate, std::string(VERILOG_NETLIST_FILE_POSTFIX)));
   std::string orig_module_name =
     generate_connection_block_module_name(cb_type, gsb_coordinate);
+  /* A module merged into an identical module is written with the latter */
+  if (true == module_name_map.tag_is_alias(orig_module_name)) {
+    return;
+  }
   if (module_name_map.name_exist(orig_module_name)) {
     verilog_fname = generate_tile_module_netlist_name(
       module_name_map.name(orig_module_name),
@@ -95,11 +103,20 @@ static void print_verilog_routing_connection_box_unique_module(
 
   std::string verilog_fpath(subckt_dir + verilog_fname);
 
-  /* Create the file stream */
-  std::fstream fp;
-  fp.open(verilog_fpath, std::fstream::out | std::fstream::trunc);
+  /* The netlist of another partition is only added to the name list */
+  if (false == options.netlist_in_partition(verilog_fname)) {
+    add_verilog_netlist_to_manager(
+      netlist_manager, subckt_dir_name, verilog_fname, verilog_fpath,
+      NetlistManager::ROUTING_MODULE_NETLIST, options);
+    return;
+  }
 
-  check_file_stream(verilog_fpath.c_str(), fp);
+  /* Create the file stream, unless the netlist is appended to a pack */
+  std::fstream netlist_fp;
+  std::string verilog_staging_fpath =
+    find_staging_file_path(verilog_fpath, options.keep_unchanged_files());
+  std::fstream& fp = open_verilog_netlist_stream(
+    netlist_fp, verilog_staging_fpath, netlist_pack);
 
   print_verilog_file_header(
     fp,
@@ -117,24 +134,20 @@ static void print_verilog_routing_connection_box_unique_module(
   /* Write the verilog module */
   write_verilog_module_to_file(fp, module_manager, cb_module,
                                options.explicit_port_mapping(),
-                               options.default_net_type());
+                               options.default_net_type(), &wire_layout);
 
   /* Add an empty line as a splitter */
   fp << std::endl;
 
-  /* Close file handler */
-  fp.close();
-
-  /* Add fname to the netlist name list */
-  NetlistId nlist_id = NetlistId::INVALID();
-  if (options.use_relative_path()) {
-    nlist_id = netlist_manager.add_netlist(subckt_dir_name + verilog_fname);
-  } else {
-    nlist_id = netlist_manager.add_netlist(verilog_fpath);
+  /* Close file handler. The netlists in a pack are added to the netlist
+   * name list by the shards of the pack */
+  if (true == close_verilog_netlist_stream(fp, verilog_staging_fpath,
+                                           verilog_fpath, netlist_pack)) {
+    /* Add fname to the netlist name list */
+    add_verilog_netlist_to_manager(
+      netlist_manager, subckt_dir_name, verilog_fname, verilog_fpath,
+      NetlistManager::ROUTING_MODULE_NETLIST, options);
   }
-  VTR_ASSERT(nlist_id);
-  netlist_manager.set_netlist_type(nlist_id,
-                                   NetlistManager::ROUTING_MODULE_NETLIST);
 }
 
 /*********************************************************************
@@ -199,6 +212,7 @@ static void print_verilog_routing_connection_box_unique_module(
  ********************************************************************/
 static void print_verilog_routing_switch_box_unique_module(
   NetlistManager& netlist_manager, const ModuleManager& module_manager,
+  VerilogModuleWireLayout& wire_layout, VerilogNetlistPack* netlist_pack,
   const ModuleNameMap& module_name_map, const std::string& subckt_dir,
   const std::string& subckt_dir_name, const RRGSB& rr_gsb,
   const FabricVerilogOption& options) {
@@ -209,6 +223,10 @@ static void print_verilog_routing_switch_box_unique_module(
     std::string(VERILOG_NETLIST_FILE_POSTFIX)));
   std::string orig_module_name =
     generate_switch_block_module_name(gsb_coordinate);
+  /* A module merged into an identical module is written with the latter */
+  if (true == module_name_map.tag_is_alias(orig_module_name)) {
+    return;
+  }
   if (module_name_map.name_exist(orig_module_name)) {
     verilog_fname = generate_tile_module_netlist_name(
       module_name_map.name(orig_module_name),
@@ -216,11 +234,20 @@ static void print_verilog_routing_switch_box_unique_module(
   }
   std::string verilog_fpath(subckt_dir + verilog_fname);
 
-  /* Create the file stream */
-  std::fstream fp;
-  fp.open(verilog_fpath, std::fstream::out | std::fstream::trunc);
+  /* The netlist of another partition is only added to the name list */
+  if (false == options.netlist_in_partition(verilog_fname)) {
+    add_verilog_netlist_to_manager(
+      netlist_manager, subckt_dir_name, verilog_fname, verilog_fpath,
+      NetlistManager::ROUTING_MODULE_NETLIST, options);
+    return;
+  }
 
-  check_file_stream(verilog_fpath.c_str(), fp);
+  /* Create the file stream, unless the netlist is appended to a pack */
+  std::fstream netlist_fp;
+  std::string verilog_staging_fpath =
+    find_staging_file_path(verilog_fpath, options.keep_unchanged_files());
+  std::fstream& fp = open_verilog_netlist_stream(
+    netlist_fp, verilog_staging_fpath, netlist_pack);
 
   print_verilog_file_header(
     fp,
@@ -238,33 +265,67 @@ static void print_verilog_routing_switch_box_unique_module(
   /* Write the verilog module */
   write_verilog_module_to_file(fp, module_manager, sb_module,
                                options.explicit_port_mapping(),
-                               options.default_net_type());
-
-  /* Close file handler */
-  fp.close();
-
-  /* Add fname to the netlist name list */
-  NetlistId nlist_id = NetlistId::INVALID();
-  if (options.use_relative_path()) {
-    nlist_id = netlist_manager.add_netlist(subckt_dir_name + verilog_fname);
-  } else {
-    nlist_id = netlist_manager.add_netlist(verilog_fpath);
+                               options.default_net_type(), &wire_layout);
+
+  /* Close file handler. The netlists in a pack are added to the netlist
+   * name list by the shards of the pack */
+  if (true == close_verilog_netlist_stream(fp, verilog_staging_fpath,
+                                           verilog_fpath, netlist_pack)) {
+    /* Add fname to the netlist name list */
+    add_verilog_netlist_to_manager(
+      netlist_manager, subckt_dir_name, verilog_fname, verilog_fpath,
+      NetlistManager::ROUTING_MODULE_NETLIST, options);
   }
-  VTR_ASSERT(nlist_id);
-  netlist_manager.set_netlist_type(nlist_id,
-                                   NetlistManager::ROUTING_MODULE_NETLIST);
 }
 
 /********************************************************************
- * Iterate over all the connection blocks in a device
- * and build a module for each of them
+ * Write a list of routing modules, each of which is a pair of a GSB and
+ * the type of the block to be written. A switch block is denoted by the
+ * type NUM_RR_TYPES, while a connection block is denoted by its channel
+ * type.
+ * Each module is written to a separated netlist while the module manager
+ * is only read, so the netlists can be written by a pool of threads.
  *******************************************************************/
-static void print_verilog_flatten_connection_block_modules(
+static void print_verilog_routing_modules(
   NetlistManager& netlist_manager, const ModuleManager& module_manager,
-  const ModuleNameMap& module_name_map, const DeviceRRGSB& device_rr_gsb,
+  VerilogModuleWireLayout& wire_layout, VerilogNetlistPack* netlist_pack,
+  const ModuleNameMap& module_name_map,
+  const std::vector<std::pair<const RRGSB*, t_rr_type>>& routing_modules,
   const std::string& subckt_dir, const std::string& subckt_dir_name,
-  const t_rr_type& cb_type, const FabricVerilogOption& options) {
-  /* Build unique X-direction connection block modules */
+  const FabricVerilogOption& options) {
+  ProgressReporter progress("Write routing modules", routing_modules.size());
+  /* Each task registers its netlists in its own netlist manager. They are
+   * imported in the order of the tasks, as a single thread does */
+  std::vector<NetlistManager> task_netlists(routing_modules.size());
+  parallel_for(
+    routing_modules.size(), options.num_threads(),
+    [&](const size_t& imodule) {
+      const RRGSB& rr_gsb = *(routing_modules[imodule].first);
+      const t_rr_type& block_type = routing_modules[imodule].second;
+      if (NUM_RR_TYPES == block_type) {
+        print_verilog_routing_switch_box_unique_module(
+          task_netlists[imodule], module_manager, wire_layout, netlist_pack,
+          module_name_map, subckt_dir, subckt_dir_name, rr_gsb, options);
+      } else {
+        print_verilog_routing_connection_box_unique_module(
+          task_netlists[imodule], module_manager, wire_layout, netlist_pack,
+          module_name_map, subckt_dir, subckt_dir_name, rr_gsb, block_type,
+          options);
+      }
+      progress.increment();
+    });
+  for (const NetlistManager& netlists : task_netlists) {
+    netlist_manager.import_netlists(netlists);
+  }
+}
+
+/********************************************************************
+ * Iterate over all the connection blocks in a device
+ * and collect those to be written as modules
+ *******************************************************************/
+static void collect_flatten_connection_block_modules(
+  std::vector<std::pair<const RRGSB*, t_rr_type>>& routing_modules,
+  const DeviceRRGSB& device_rr_gsb, const t_rr_type& cb_type) {
   vtr::Point<size_t> cb_range = device_rr_gsb.get_gsb_range();
 
   for (size_t ix = 0; ix < cb_range.x(); ++ix) {
@@ -277,9 +338,7 @@ static void print_verilog_flatten_connection_block_modules(
       if (true != rr_gsb.is_cb_exist(cb_type)) {
         continue;
       }
-      print_verilog_routing_connection_box_unique_module(
-        netlist_manager, module_manager, module_name_map, subckt_dir,
-        subckt_dir_name, rr_gsb, cb_type, options);
+      routing_modules.push_back(std::make_pair(&rr_gsb, cb_type));
     }
   }
 }
@@ -295,12 +354,14 @@ static void print_verilog_flatten_connection_block_modules(
  *******************************************************************/
 void print_verilog_flatten_routing_modules(
   NetlistManager& netlist_manager, const ModuleManager& module_manager,
+  VerilogModuleWireLayout& wire_layout, VerilogNetlistPack* netlist_pack,
   const ModuleNameMap& module_name_map, const DeviceRRGSB& device_rr_gsb,
   const RRGraphView& rr_graph, const std::string& subckt_dir,
   const std::string& subckt_dir_name, const FabricVerilogOption& options) {
-  /* Create a vector to contain all the Verilog netlist names that have been
-   * generated in this function */
-  std::vector<std::string> netlist_names;
+  TraceScope trace_scope("print_verilog_flatten_routing_modules");
+  /* Collect all the modules to be written, in the order of switch blocks,
+   * X-direction and Y-direction connection blocks */
+  std::vector<std::pair<const RRGSB*, t_rr_type>> routing_modules;
 
   vtr::Point<size_t> sb_range = device_rr_gsb.get_gsb_range();
 
@@ -311,19 +372,18 @@ void print_verilog_flatten_routing_modules(
       if (true != rr_gsb.is_sb_exist(rr_graph)) {
         continue;
       }
-      print_verilog_routing_switch_box_unique_module(
-        netlist_manager, module_manager, module_name_map, subckt_dir,
-        subckt_dir_name, rr_gsb, options);
+      routing_modules.push_back(std::make_pair(&rr_gsb, NUM_RR_TYPES));
     }
   }
 
-  print_verilog_flatten_connection_block_modules(
-    netlist_manager, module_manager, module_name_map, device_rr_gsb, subckt_dir,
-    subckt_dir_name, CHANX, options);
+  collect_flatten_connection_block_modules(routing_modules, device_rr_gsb,
+                                           CHANX);
+  collect_flatten_connection_block_modules(routing_modules, device_rr_gsb,
+                                           CHANY);
 
-  print_verilog_flatten_connection_block_modules(
-    netlist_manager, module_manager, module_name_map, device_rr_gsb, subckt_dir,
-    subckt_dir_name, CHANY, options);
+  print_verilog_routing_modules(netlist_manager, module_manager, wire_layout,
+                                netlist_pack, module_name_map, routing_modules,
+                                subckt_dir, subckt_dir_name, options);
 }
 
 /********************************************************************
@@ -336,44 +396,36 @@ void print_verilog_flatten_routing_modules(
  * Note: this function SHOULD be called only when
  * the option compact_routing_hierarchy is turned on!!!
  *******************************************************************/
-void print_verilog_unique_routing_modules(NetlistManager& netlist_manager,
-                                          const ModuleManager& module_manager,
-                                          const ModuleNameMap& module_name_map,
-                                          const DeviceRRGSB& device_rr_gsb,
-                                          const std::string& subckt_dir,
-                                          const std::string& subckt_dir_name,
-                                          const FabricVerilogOption& options) {
-  /* Create a vector to contain all the Verilog netlist names that have been
-   * generated in this function */
-  std::vector<std::string> netlist_names;
+void print_verilog_unique_routing_modules(
+  NetlistManager& netlist_manager, const ModuleManager& module_manager,
+  VerilogModuleWireLayout& wire_layout, VerilogNetlistPack* netlist_pack,
+  const ModuleNameMap& module_name_map, const DeviceRRGSB& device_rr_gsb,
+  const std::string& subckt_dir, const std::string& subckt_dir_name,
+  const FabricVerilogOption& options) {
+  TraceScope trace_scope("print_verilog_unique_routing_modules");
+  /* Collect all the modules to be written, in the order of switch blocks,
+   * X-direction and Y-direction connection blocks */
+  std::vector<std::pair<const RRGSB*, t_rr_type>> routing_modules;
 
   /* Build unique switch block modules */
   for (size_t isb = 0; isb < device_rr_gsb.get_num_sb_unique_module(); ++isb) {
     const RRGSB& unique_mirror = device_rr_gsb.get_sb_unique_module(isb);
-    print_verilog_routing_switch_box_unique_module(
-      netlist_manager, module_manager, module_name_map, subckt_dir,
-      subckt_dir_name, unique_mirror, options);
+    routing_modules.push_back(std::make_pair(&unique_mirror, NUM_RR_TYPES));
   }
 
-  /* Build unique X-direction connection block modules */
-  for (size_t icb = 0; icb < device_rr_gsb.get_num_cb_unique_module(CHANX);
-       ++icb) {
-    const RRGSB& unique_mirror = device_rr_gsb.get_cb_unique_module(CHANX, icb);
-
-    print_verilog_routing_connection_box_unique_module(
-      netlist_manager, module_manager, module_name_map, subckt_dir,
-      subckt_dir_name, unique_mirror, CHANX, options);
+  /* Build unique X-direction and Y-direction connection block modules */
+  for (const t_rr_type& cb_type : {CHANX, CHANY}) {
+    for (size_t icb = 0; icb < device_rr_gsb.get_num_cb_unique_module(cb_type);
+         ++icb) {
+      const RRGSB& unique_mirror =
+        device_rr_gsb.get_cb_unique_module(cb_type, icb);
+      routing_modules.push_back(std::make_pair(&unique_mirror, cb_type));
+    }
   }
 
-  /* Build unique X-direction connection block modules */
-  for (size_t icb = 0; icb < device_rr_gsb.get_num_cb_unique_module(CHANY);
-       ++icb) {
-    const RRGSB& unique_mirror = device_rr_gsb.get_cb_unique_module(CHANY, icb);
-
-    print_verilog_routing_connection_box_unique_module(
-      netlist_manager, module_manager, module_name_map, subckt_dir,
-      subckt_dir_name, unique_mirror, CHANY, options);
-  }
+  print_verilog_routing_modules(netlist_manager, module_manager, wire_layout,
+                                netlist_pack, module_name_map, routing_modules,
+                                subckt_dir, subckt_dir_name, options);
 
   VTR_LOG("\n");
 }
@@ -12,6 +12,8 @@
 #include "mux_library.h"
 #include "netlist_manager.h"
 #include "rr_graph_view.h"
+#include "verilog_module_wire_layout.h"
+#include "verilog_netlist_pack.h"
 
 /********************************************************************
  * Function declaration
@@ -22,17 +24,17 @@ namespace openfpga {
 
 void print_verilog_flatten_routing_modules(
   NetlistManager& netlist_manager, const ModuleManager& module_manager,
+  VerilogModuleWireLayout& wire_layout, VerilogNetlistPack* netlist_pack,
   const ModuleNameMap& module_name_map, const DeviceRRGSB& device_rr_gsb,
   const RRGraphView& rr_graph, const std::string& subckt_dir,
   const std::string& subckt_dir_name, const FabricVerilogOption& options);
 
-void print_verilog_unique_routing_modules(NetlistManager& netlist_manager,
-                                          const ModuleManager& module_manager,
-                                          const ModuleNameMap& module_name_map,
-                                          const DeviceRRGSB& device_rr_gsb,
-                                          const std::string& subckt_dir,
-                                          const std::string& subckt_dir_name,
-                                          const FabricVerilogOption& options);
+void print_verilog_unique_routing_modules(
+  NetlistManager& netlist_manager, const ModuleManager& module_manager,
+  VerilogModuleWireLayout& wire_layout, VerilogNetlistPack* netlist_pack,
+  const ModuleNameMap& module_name_map, const DeviceRRGSB& device_rr_gsb,
+  const std::string& subckt_dir, const std::string& subckt_dir_name,
+  const FabricVerilogOption& options);
 
 } /* end namespace openfpga */
 
@@ -125,22 +125,26 @@ void print_verilog_simulation_info(
      * For unused ports, by default we assume it is configured as inputs
      * TODO: this should be reworked to be consistent with bitstream
      */
-    for (const BasicPort& module_io_port : module_manager.module_ports_by_type(
-           top_module, ModuleManager::MODULE_GPIO_PORT)) {
-      std::string io_direction(module_io_port.get_width(), '1');
-      for (const AtomBlockId& atom_blk : atom_ctx.nlist.blocks()) {
-        /* Bypass non-I/O atom blocks ! */
-        if ((AtomBlockType::INPAD != atom_ctx.nlist.block_type(atom_blk)) &&
-            (AtomBlockType::OUTPAD != atom_ctx.nlist.block_type(atom_blk))) {
-          continue;
-        }
+    /* Collect the I/O blocks of the benchmark once and share them between all
+     * the GPIO ports */
+    std::vector<AtomBlockId> io_atom_blks;
+    for (const AtomBlockId& atom_blk : atom_ctx.nlist.blocks()) {
+      /* Bypass non-I/O atom blocks ! */
+      if ((AtomBlockType::INPAD == atom_ctx.nlist.block_type(atom_blk)) ||
+          (AtomBlockType::OUTPAD == atom_ctx.nlist.block_type(atom_blk))) {
+        io_atom_blks.push_back(atom_blk);
+      }
+    }
 
+    for (const BasicPort& module_io_port : module_io_ports) {
+      std::string io_direction(module_io_port.get_width(), '1');
+      bool mapped_port = false;
+      for (const AtomBlockId& atom_blk : io_atom_blks) {
         /* Find the index of the mapped GPIO in top-level FPGA fabric */
+        const t_pl_loc& io_loc =
+          place_ctx.block_locs[atom_ctx.lookup.atom_clb(atom_blk)].loc;
         size_t io_index = io_location_map.io_index(
-          place_ctx.block_locs[atom_ctx.lookup.atom_clb(atom_blk)].loc.x,
-          place_ctx.block_locs[atom_ctx.lookup.atom_clb(atom_blk)].loc.y,
-          place_ctx.block_locs[atom_ctx.lookup.atom_clb(atom_blk)].loc.sub_tile,
-          module_io_port.get_name());
+          io_loc.x, io_loc.y, io_loc.sub_tile, module_io_port.get_name());
 
         if (size_t(-1) == io_index) {
           continue;
@@ -153,10 +157,12 @@ void print_verilog_simulation_info(
                      atom_ctx.nlist.block_type(atom_blk));
           io_direction[io_index] = '0';
         }
+        mapped_port = true;
+      }
 
+      /* Organize the vector to string */
+      if (true == mapped_port) {
         std::string io_tag = "IO" + module_io_port.get_name();
-
-        /* Organize the vector to string */
         ini["SIMULATION_DECK"][io_tag] = io_direction;
       }
     }
@@ -6,6 +6,7 @@
 /* Headers from vtrutil library */
 #include "verilog_submodule.h"
 
+#include "openfpga_trace.h"
 #include "verilog_constants.h"
 #include "verilog_decoders.h"
 #include "verilog_essential_gates.h"
@@ -39,6 +40,7 @@ void print_verilog_submodule(
   const ModuleNameMap& module_name_map, const std::string& submodule_dir,
   const std::string& submodule_dir_name,
   const FabricVerilogOption& fpga_verilog_opts) {
+  TraceScope trace_scope("print_verilog_submodule");
   print_verilog_submodule_essentials(
     const_cast<const ModuleManager&>(module_manager), netlist_manager,
     submodule_dir, submodule_dir_name, circuit_lib, module_name_map,
@@ -3,9 +3,11 @@
  * generating Verilog sub-modules
  * such as timing matrix and signal initialization
  ***********************************************/
+#include <cstdio>
 #include <fstream>
 #include <iomanip>
 #include <limits>
+#include <sstream>
 
 /* Headers from vtrutil library */
 #include "vtr_assert.h"
@@ -16,8 +18,10 @@
 #include "openfpga_port.h"
 
 /* Headers from readarchopenfpga library */
+#include "check_result_cache.h"
 #include "circuit_types.h"
 #include "module_manager_utils.h"
+#include "openfpga_naming.h"
 #include "verilog_constants.h"
 #include "verilog_submodule_utils.h"
 #include "verilog_writer_utils.h"
@@ -196,9 +200,11 @@ void print_verilog_submodule_templates(const ModuleManager& module_manager,
 
   /* Create the file stream */
   std::fstream fp;
-  fp.open(verilog_fname, std::fstream::out | std::fstream::trunc);
+  std::string verilog_staging_fname =
+    find_staging_file_path(verilog_fname, options.keep_unchanged_files());
+  fp.open(verilog_staging_fname, std::fstream::out | std::fstream::trunc);
 
-  check_file_stream(verilog_fname.c_str(), fp);
+  check_file_stream(verilog_staging_fname.c_str(), fp);
 
   /* Print out debugging information for if the file is not opened/created
    * properly */
@@ -228,9 +234,112 @@ void print_verilog_submodule_templates(const ModuleManager& module_manager,
 
   /* close file stream */
   fp.close();
+  commit_staging_file(verilog_staging_fname, verilog_fname);
 
   /* No need to add the template to the subckt include files! */
   VTR_LOG("Done\n");
 }
 
+/********************************************************************
+ * Find the modules to be written to the fabric netlists. When required,
+ * the modules which are not used under the top-level module are skipped,
+ * otherwise all the modules are written
+ *******************************************************************/
+vtr::vector<ModuleId, bool> find_verilog_modules_to_write(
+  const ModuleManager& module_manager, const ModuleNameMap& module_name_map,
+  const FabricVerilogOption& options) {
+  if (false == options.skip_unused_modules()) {
+    return vtr::vector<ModuleId, bool>(module_manager.num_modules(), true);
+  }
+  ModuleId top_module = module_manager.find_module(
+    module_name_map.name(generate_fpga_top_module_name()));
+  return find_module_manager_used_modules(module_manager, top_module);
+}
+
+/********************************************************************
+ * Check if a module is to be written, see find_verilog_modules_to_write().
+ * Modules which are unknown, e.g., added after the modules to be written are
+ * found, are always written
+ *******************************************************************/
+bool is_verilog_module_to_write(
+  const vtr::vector<ModuleId, bool>& modules_to_write, const ModuleId& module) {
+  if ((false == bool(module)) || (size_t(module) >= modules_to_write.size())) {
+    return true;
+  }
+  return modules_to_write[module];
+}
+
+/********************************************************************
+ * Find the path of a submodule netlist in a library directory. The
+ * netlist is named after its file name and the hash of its content, e.g.,
+ * luts_<hash>.v, so that fabrics which share the same netlist find the
+ * same file
+ *******************************************************************/
+std::string find_verilog_submodule_library_file_path(
+  const std::string& library_dir, const std::string& verilog_fname,
+  const std::string& netlist_fpath) {
+  std::string stem = verilog_fname;
+  std::string extension;
+  size_t dot_pos = verilog_fname.find_last_of('.');
+  if (std::string::npos != dot_pos) {
+    stem = verilog_fname.substr(0, dot_pos);
+    extension = verilog_fname.substr(dot_pos);
+  }
+  std::stringstream hash_str;
+  hash_str << std::hex << std::setw(16) << std::setfill('0')
+           << find_file_content_hash(netlist_fpath);
+  return format_dir_path(library_dir) + stem + std::string("_") +
+         hash_str.str() + extension;
+}
+
+/********************************************************************
+ * Commit a submodule netlist, which has been written to its staging file,
+ * and add it to the netlist name list.
+ * When a library is used, the netlist is moved to the library, where it is
+ * only written if no fabric has written the same content before, and its
+ * staging file is removed. The netlist name list then refers to the file
+ * in the library
+ *******************************************************************/
+void commit_verilog_submodule_netlist(NetlistManager& netlist_manager,
+                                      const std::string& staging_fpath,
+                                      const std::string& verilog_fpath,
+                                      const std::string& submodule_dir_name,
+                                      const std::string& verilog_fname,
+                                      const FabricVerilogOption& options) {
+  std::string netlist_name = verilog_fpath;
+  if (options.use_relative_path()) {
+    netlist_name = submodule_dir_name + verilog_fname;
+  }
+  if (false == options.submodule_library().empty()) {
+    netlist_name = find_verilog_submodule_library_file_path(
+      options.submodule_library(), verilog_fname, staging_fpath);
+    if (true == std::ifstream(netlist_name).is_open()) {
+      VTR_LOGV(options.verbose_output(),
+               "Reuse netlist '%s' from the submodule library\n",
+               netlist_name.c_str());
+    } else {
+      /* The library may be on another file system than the output
+       * directory, so the netlist is copied to a staging file in the
+       * library before being renamed */
+      std::string library_staging_fpath =
+        find_staging_file_path(netlist_name, true);
+      {
+        std::ifstream src(staging_fpath, std::ifstream::binary);
+        std::ofstream dst(library_staging_fpath,
+                          std::ofstream::binary | std::ofstream::trunc);
+        dst << src.rdbuf();
+      }
+      commit_staging_file(library_staging_fpath, netlist_name);
+    }
+    std::remove(staging_fpath.c_str());
+  } else {
+    commit_staging_file(staging_fpath, verilog_fpath);
+  }
+
+  /* Add fname to the netlist name list */
+  NetlistId nlist_id = netlist_manager.add_netlist(netlist_name);
+  VTR_ASSERT(nlist_id);
+  netlist_manager.set_netlist_type(nlist_id, NetlistManager::SUBMODULE_NETLIST);
+}
+
 } /* end namespace openfpga */
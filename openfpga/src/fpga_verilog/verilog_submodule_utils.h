@@ -10,6 +10,8 @@
 #include "circuit_library.h"
 #include "fabric_verilog_options.h"
 #include "module_manager.h"
+#include "module_name_map.h"
+#include "netlist_manager.h"
 #include "verilog_port_types.h"
 
 /********************************************************************
@@ -31,6 +33,24 @@ void print_verilog_submodule_templates(const ModuleManager& module_manager,
                                        const std::string& submodule_dir,
                                        const FabricVerilogOption& options);
 
+bool is_verilog_module_to_write(
+  const vtr::vector<ModuleId, bool>& modules_to_write, const ModuleId& module);
+
+vtr::vector<ModuleId, bool> find_verilog_modules_to_write(
+  const ModuleManager& module_manager, const ModuleNameMap& module_name_map,
+  const FabricVerilogOption& options);
+
+std::string find_verilog_submodule_library_file_path(
+  const std::string& library_dir, const std::string& verilog_fname,
+  const std::string& netlist_fpath);
+
+void commit_verilog_submodule_netlist(NetlistManager& netlist_manager,
+                                      const std::string& staging_fpath,
+                                      const std::string& verilog_fpath,
+                                      const std::string& submodule_dir_name,
+                                      const std::string& verilog_fname,
+                                      const FabricVerilogOption& options);
+
 } /* end namespace openfpga */
 
 #endif
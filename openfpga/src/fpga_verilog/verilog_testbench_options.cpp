@@ -19,6 +19,7 @@ VerilogTestbenchOption::VerilogTestbenchOption() {
   dut_module_ = "fpga_top";
   fabric_netlist_file_path_.clear();
   reference_benchmark_file_path_.clear();
+  hex_bitstream_ = false;
   print_preconfig_top_testbench_ = false;
   print_formal_verification_top_netlist_ = false;
   print_top_testbench_ = false;
@@ -27,11 +28,14 @@ VerilogTestbenchOption::VerilogTestbenchOption() {
   include_signal_init_ = false;
   default_net_type_ = VERILOG_DEFAULT_NET_TYPE_NONE;
   embedded_bitstream_hdl_type_ = EMBEDDED_BITSTREAM_HDL_MODELSIM;
+  embed_bitstream_memory_ = false;
+  shared_bitstream_loader_ = false;
   time_unit_ = 1E-3;
   time_stamp_ = true;
   use_relative_path_ = false;
   simulator_type_ = e_simulator_type::IVERILOG;
   verbose_output_ = false;
+  num_threads_ = 1;
 
   SIMULATOR_TYPE_STRING_ = {{"iverilog", "vcs"}};
 }
@@ -71,6 +75,8 @@ bool VerilogTestbenchOption::fast_configuration() const {
   return fast_configuration_;
 }
 
+bool VerilogTestbenchOption::hex_bitstream() const { return hex_bitstream_; }
+
 bool VerilogTestbenchOption::print_simulation_ini() const {
   return !simulation_ini_path_.empty();
 }
@@ -102,6 +108,14 @@ VerilogTestbenchOption::embedded_bitstream_hdl_type() const {
   return embedded_bitstream_hdl_type_;
 }
 
+bool VerilogTestbenchOption::embed_bitstream_memory() const {
+  return embed_bitstream_memory_;
+}
+
+bool VerilogTestbenchOption::shared_bitstream_loader() const {
+  return shared_bitstream_loader_;
+}
+
 bool VerilogTestbenchOption::time_stamp() const { return time_stamp_; }
 
 bool VerilogTestbenchOption::use_relative_path() const {
@@ -110,6 +124,8 @@ bool VerilogTestbenchOption::use_relative_path() const {
 
 bool VerilogTestbenchOption::verbose_output() const { return verbose_output_; }
 
+size_t VerilogTestbenchOption::num_threads() const { return num_threads_; }
+
 VerilogTestbenchOption::e_simulator_type
 VerilogTestbenchOption::simulator_type() const {
   return simulator_type_;
@@ -173,6 +189,10 @@ void VerilogTestbenchOption::set_fast_configuration(const bool& enabled) {
   fast_configuration_ = enabled;
 }
 
+void VerilogTestbenchOption::set_hex_bitstream(const bool& enabled) {
+  hex_bitstream_ = enabled;
+}
+
 void VerilogTestbenchOption::set_print_preconfig_top_testbench(
   const bool& enabled) {
   print_preconfig_top_testbench_ =
@@ -251,6 +271,14 @@ void VerilogTestbenchOption::set_embedded_bitstream_hdl_type(
   }
 }
 
+void VerilogTestbenchOption::set_embed_bitstream_memory(const bool& enabled) {
+  embed_bitstream_memory_ = enabled;
+}
+
+void VerilogTestbenchOption::set_shared_bitstream_loader(const bool& enabled) {
+  shared_bitstream_loader_ = enabled;
+}
+
 void VerilogTestbenchOption::set_time_unit(const float& time_unit) {
   time_unit_ = time_unit;
 }
@@ -267,6 +295,10 @@ void VerilogTestbenchOption::set_verbose_output(const bool& enabled) {
   verbose_output_ = enabled;
 }
 
+void VerilogTestbenchOption::set_num_threads(const size_t& num_threads) {
+  num_threads_ = num_threads;
+}
+
 int VerilogTestbenchOption::set_simulator_type(const std::string& value) {
   simulator_type_ = str2simulator_type(value);
   return valid_simulator_type(simulator_type_);
@@ -52,6 +52,7 @@ class VerilogTestbenchOption {
   std::string fabric_netlist_file_path() const;
   std::string reference_benchmark_file_path() const;
   bool fast_configuration() const;
+  bool hex_bitstream() const;
   bool print_formal_verification_top_netlist() const;
   bool print_preconfig_top_testbench() const;
   bool print_top_testbench() const;
@@ -62,10 +63,13 @@ class VerilogTestbenchOption {
   bool no_self_checking() const;
   e_verilog_default_net_type default_net_type() const;
   e_embedded_bitstream_hdl_type embedded_bitstream_hdl_type() const;
+  bool embed_bitstream_memory() const;
+  bool shared_bitstream_loader() const;
   float time_unit() const;
   bool time_stamp() const;
   bool use_relative_path() const;
   bool verbose_output() const;
+  size_t num_threads() const;
   e_simulator_type simulator_type() const;
 
  public: /* Public validator */
@@ -94,6 +98,9 @@ class VerilogTestbenchOption {
    * verification top netlist is enabled */
   void set_print_preconfig_top_testbench(const bool& enabled);
   void set_fast_configuration(const bool& enabled);
+  /* When enabled, the bitstream file is written by the testbench generator
+   * in hexadecimal, rather than being an input of the testbench generator */
+  void set_hex_bitstream(const bool& enabled);
   void set_print_top_testbench(const bool& enabled);
   void set_print_simulation_ini(const std::string& simulation_ini_path);
   void set_explicit_port_mapping(const bool& enabled);
@@ -102,9 +109,16 @@ class VerilogTestbenchOption {
   void set_time_unit(const float& time_unit);
   void set_embedded_bitstream_hdl_type(
     const std::string& embedded_bitstream_hdl_type);
+  /* When enabled, the embedded bitstream is loaded from a memory file rather
+   * than being constant values in the netlist */
+  void set_embed_bitstream_memory(const bool& enabled);
+  /* When enabled, the statements which load the bitstream memory file are
+   * written to a netlist shared by all the designs of a fabric */
+  void set_shared_bitstream_loader(const bool& enabled);
   void set_time_stamp(const bool& enabled);
   void set_use_relative_path(const bool& enabled);
   void set_verbose_output(const bool& enabled);
+  void set_num_threads(const size_t& num_threads);
 
   /* @brief Create the simulator type by parsing a given string. Return error
    * when failed */
@@ -125,6 +139,7 @@ class VerilogTestbenchOption {
   std::string fabric_netlist_file_path_;
   std::string reference_benchmark_file_path_;
   bool fast_configuration_;
+  bool hex_bitstream_;
   bool print_formal_verification_top_netlist_;
   bool print_preconfig_top_testbench_;
   bool print_top_testbench_;
@@ -134,11 +149,16 @@ class VerilogTestbenchOption {
   bool include_signal_init_;
   e_verilog_default_net_type default_net_type_;
   e_embedded_bitstream_hdl_type embedded_bitstream_hdl_type_;
+  bool embed_bitstream_memory_;
+  bool shared_bitstream_loader_;
   e_simulator_type simulator_type_;
   float time_unit_;
   bool time_stamp_;
   bool use_relative_path_;
   bool verbose_output_;
+  /* Number of threads to write the netlists, 0 means all the hardware
+   * threads */
+  size_t num_threads_;
 };
 
 } /* End namespace openfpga*/
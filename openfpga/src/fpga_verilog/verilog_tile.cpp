@@ -11,6 +11,8 @@
 #include "command_exit_codes.h"
 #include "openfpga_digest.h"
 #include "openfpga_naming.h"
+#include "openfpga_parallel.h"
+#include "openfpga_trace.h"
 #include "verilog_constants.h"
 #include "verilog_module_writer.h"
 #include "verilog_writer_utils.h"
@@ -26,12 +28,19 @@ namespace openfpga {
  *******************************************************************/
 static int print_verilog_tile_module_netlist(
   NetlistManager& netlist_manager, const ModuleManager& module_manager,
+  VerilogModuleWireLayout& wire_layout, VerilogNetlistPack* netlist_pack,
   const ModuleNameMap& module_name_map, const std::string& verilog_dir,
   const FabricTile& fabric_tile, const FabricTileId& fabric_tile_id,
-  const std::string& subckt_dir_name, const FabricVerilogOption& options) {
+  const std::string& subckt_dir_name, const FabricVerilogOption& options,
+  const bool& show_progress) {
   /* Create a module as the top-level fabric, and add it to the module manager
    */
   vtr::Point<size_t> tile_coord = fabric_tile.tile_coordinate(fabric_tile_id);
+  /* A module merged into an identical module is written with the latter */
+  if (true ==
+      module_name_map.tag_is_alias(generate_tile_module_name(tile_coord))) {
+    return CMD_EXEC_SUCCESS;
+  }
   std::string tile_module_name =
     module_name_map.name(generate_tile_module_name(tile_coord));
   ModuleId tile_module = module_manager.find_module(tile_module_name);
@@ -45,14 +54,24 @@ static int print_verilog_tile_module_netlist(
     tile_module_name, std::string(VERILOG_NETLIST_FILE_POSTFIX)));
   std::string verilog_fpath(verilog_dir + verilog_fname);
 
-  VTR_LOG("Writing Verilog netlist '%s' for tile module '%s'...",
-          verilog_fpath.c_str(), tile_module_name.c_str());
+  /* The netlist of another partition is only added to the name list */
+  if (false == options.netlist_in_partition(verilog_fname)) {
+    add_verilog_netlist_to_manager(
+      netlist_manager, subckt_dir_name, verilog_fname, verilog_fpath,
+      NetlistManager::TILE_MODULE_NETLIST, options);
+    return CMD_EXEC_SUCCESS;
+  }
 
-  /* Create the file stream */
-  std::fstream fp;
-  fp.open(verilog_fpath, std::fstream::out | std::fstream::trunc);
+  VTR_LOGV(show_progress,
+           "Writing Verilog netlist '%s' for tile module '%s'...",
+           verilog_fpath.c_str(), tile_module_name.c_str());
 
-  check_file_stream(verilog_fpath.c_str(), fp);
+  /* Create the file stream, unless the netlist is appended to a pack */
+  std::fstream netlist_fp;
+  std::string verilog_staging_fpath =
+    find_staging_file_path(verilog_fpath, options.keep_unchanged_files());
+  std::fstream& fp = open_verilog_netlist_stream(
+    netlist_fp, verilog_staging_fpath, netlist_pack);
 
   print_verilog_file_header(fp, std::string("Tile Verilog module for FPGA"),
                             options.time_stamp());
@@ -60,27 +79,22 @@ static int print_verilog_tile_module_netlist(
   /* Write the module content in Verilog format */
   write_verilog_module_to_file(fp, module_manager, tile_module,
                                options.explicit_port_mapping(),
-                               options.default_net_type());
+                               options.default_net_type(), &wire_layout);
 
   /* Add an empty line as a splitter */
   fp << std::endl;
 
-  /* Close file handler */
-  fp.close();
-
-  /* Add fname to the netlist name list */
-  NetlistId nlist_id = NetlistId::INVALID();
-  if (options.use_relative_path()) {
-    nlist_id = netlist_manager.add_netlist(subckt_dir_name + verilog_fname);
-  } else {
-    nlist_id = netlist_manager.add_netlist(verilog_fpath);
+  /* Close file handler. The netlists in a pack are added to the netlist
+   * name list by the shards of the pack */
+  if (true == close_verilog_netlist_stream(fp, verilog_staging_fpath,
+                                           verilog_fpath, netlist_pack)) {
+    /* Add fname to the netlist name list */
+    add_verilog_netlist_to_manager(
+      netlist_manager, subckt_dir_name, verilog_fname, verilog_fpath,
+      NetlistManager::TILE_MODULE_NETLIST, options);
   }
 
-  VTR_ASSERT(nlist_id);
-  netlist_manager.set_netlist_type(nlist_id,
-                                   NetlistManager::TILE_MODULE_NETLIST);
-
-  VTR_LOG("Done\n");
+  VTR_LOGV(show_progress, "Done\n");
 
   return CMD_EXEC_SUCCESS;
 }
@@ -90,26 +104,45 @@ static int print_verilog_tile_module_netlist(
  *******************************************************************/
 int print_verilog_tiles(NetlistManager& netlist_manager,
                         const ModuleManager& module_manager,
+                        VerilogModuleWireLayout& wire_layout,
+                        VerilogNetlistPack* netlist_pack,
                         const ModuleNameMap& module_name_map,
                         const std::string& verilog_dir,
                         const FabricTile& fabric_tile,
                         const std::string& subckt_dir_name,
                         const FabricVerilogOption& options) {
   vtr::ScopedStartFinishTimer timer("Build tile modules for the FPGA fabric");
+  TraceScope trace_scope("print_verilog_tiles");
 
-  int status_code = CMD_EXEC_SUCCESS;
+  /* Each tile is written to a separated netlist while the module manager is
+   * only read, so the netlists can be written by a pool of threads. Progress
+   * is only reported when a single thread is used, to avoid interleaved logs
+   */
+  bool show_progress = (1 == find_num_threads(options.num_threads()));
 
   /* Build a module for each unique tile  */
-  for (FabricTileId fabric_tile_id : fabric_tile.unique_tiles()) {
-    status_code = print_verilog_tile_module_netlist(
-      netlist_manager, module_manager, module_name_map, verilog_dir,
-      fabric_tile, fabric_tile_id, subckt_dir_name, options);
+  std::vector<FabricTileId> unique_tiles = fabric_tile.unique_tiles();
+  std::vector<int> status_codes(unique_tiles.size(), CMD_EXEC_SUCCESS);
+  /* Each task registers its netlists in its own netlist manager. They are
+   * imported in the order of the tasks, as a single thread does */
+  std::vector<NetlistManager> tile_netlists(unique_tiles.size());
+  parallel_for(
+    unique_tiles.size(), options.num_threads(), [&](const size_t& itile) {
+      status_codes[itile] = print_verilog_tile_module_netlist(
+        tile_netlists[itile], module_manager, wire_layout, netlist_pack,
+        module_name_map, verilog_dir, fabric_tile, unique_tiles[itile],
+        subckt_dir_name, options, show_progress);
+    });
+  for (const NetlistManager& netlists : tile_netlists) {
+    netlist_manager.import_netlists(netlists);
+  }
+  for (const int& status_code : status_codes) {
     if (status_code != CMD_EXEC_SUCCESS) {
       return CMD_EXEC_FATAL_ERROR;
     }
   }
 
-  return status_code;
+  return CMD_EXEC_SUCCESS;
 }
 
 } /* end namespace openfpga */
@@ -11,6 +11,8 @@
 #include "module_manager.h"
 #include "module_name_map.h"
 #include "netlist_manager.h"
+#include "verilog_module_wire_layout.h"
+#include "verilog_netlist_pack.h"
 
 /********************************************************************
  * Function declaration
@@ -21,6 +23,8 @@ namespace openfpga {
 
 int print_verilog_tiles(NetlistManager& netlist_manager,
                         const ModuleManager& module_manager,
+                        VerilogModuleWireLayout& wire_layout,
+                        VerilogNetlistPack* netlist_pack,
                         const ModuleNameMap& module_name_map,
                         const std::string& verilog_dir,
                         const FabricTile& fabric_tile,
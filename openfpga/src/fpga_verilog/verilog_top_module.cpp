@@ -13,6 +13,7 @@
 /* Headers from openfpgautil library */
 #include "openfpga_digest.h"
 #include "openfpga_naming.h"
+#include "openfpga_trace.h"
 #include "verilog_constants.h"
 #include "verilog_module_writer.h"
 #include "verilog_top_module.h"
@@ -26,9 +27,11 @@ namespace openfpga {
  *******************************************************************/
 void print_verilog_core_module(NetlistManager& netlist_manager,
                                const ModuleManager& module_manager,
+                               VerilogModuleWireLayout& wire_layout,
                                const ModuleNameMap& module_name_map,
                                const std::string& verilog_dir,
                                const FabricVerilogOption& options) {
+  TraceScope trace_scope("print_verilog_core_module");
   /* Create a module as the top-level fabric, and add it to the module manager
    */
   std::string core_module_name = generate_fpga_core_module_name();
@@ -53,23 +56,27 @@ void print_verilog_core_module(NetlistManager& netlist_manager,
 
   /* Create the file stream */
   std::fstream fp;
-  fp.open(verilog_fpath, std::fstream::out | std::fstream::trunc);
+  std::string verilog_staging_fpath =
+    find_staging_file_path(verilog_fpath, options.keep_unchanged_files());
+  fp.open(verilog_staging_fpath, std::fstream::out | std::fstream::trunc);
 
-  check_file_stream(verilog_fpath.c_str(), fp);
+  check_file_stream(verilog_staging_fpath.c_str(), fp);
 
   print_verilog_file_header(fp, std::string("Wrapper Verilog module for FPGA"),
                             options.time_stamp());
 
   /* Write the module content in Verilog format */
-  write_verilog_module_to_file(fp, module_manager, core_module,
-                               options.explicit_port_mapping(),
-                               options.default_net_type());
+  write_verilog_module_to_file(
+    fp, module_manager, core_module, options.explicit_port_mapping(),
+    options.default_net_type(), &wire_layout,
+    options.compress_instance_arrays());
 
   /* Add an empty line as a splitter */
   fp << std::endl;
 
   /* Close file handler */
   fp.close();
+  commit_staging_file(verilog_staging_fpath, verilog_fpath);
 
   /* Add fname to the netlist name list */
   NetlistId nlist_id = NetlistId::INVALID();
@@ -98,9 +105,11 @@ void print_verilog_core_module(NetlistManager& netlist_manager,
  *******************************************************************/
 void print_verilog_top_module(NetlistManager& netlist_manager,
                               const ModuleManager& module_manager,
+                              VerilogModuleWireLayout& wire_layout,
                               const ModuleNameMap& module_name_map,
                               const std::string& verilog_dir,
                               const FabricVerilogOption& options) {
+  TraceScope trace_scope("print_verilog_top_module");
   /* Create a module as the top-level fabric, and add it to the module manager
    */
   std::string top_module_name = generate_fpga_top_module_name();
@@ -119,23 +128,27 @@ void print_verilog_top_module(NetlistManager& netlist_manager,
 
   /* Create the file stream */
   std::fstream fp;
-  fp.open(verilog_fpath, std::fstream::out | std::fstream::trunc);
+  std::string verilog_staging_fpath =
+    find_staging_file_path(verilog_fpath, options.keep_unchanged_files());
+  fp.open(verilog_staging_fpath, std::fstream::out | std::fstream::trunc);
 
-  check_file_stream(verilog_fpath.c_str(), fp);
+  check_file_stream(verilog_staging_fpath.c_str(), fp);
 
   print_verilog_file_header(
     fp, std::string("Top-level Verilog module for FPGA"), options.time_stamp());
 
   /* Write the module content in Verilog format */
-  write_verilog_module_to_file(fp, module_manager, top_module,
-                               options.explicit_port_mapping(),
-                               options.default_net_type());
+  write_verilog_module_to_file(
+    fp, module_manager, top_module, options.explicit_port_mapping(),
+    options.default_net_type(), &wire_layout,
+    options.compress_instance_arrays());
 
   /* Add an empty line as a splitter */
   fp << std::endl;
 
   /* Close file handler */
   fp.close();
+  commit_staging_file(verilog_staging_fpath, verilog_fpath);
 
   /* Add fname to the netlist name list */
   NetlistId nlist_id = NetlistId::INVALID();
@@ -10,6 +10,7 @@
 #include "module_manager.h"
 #include "module_name_map.h"
 #include "netlist_manager.h"
+#include "verilog_module_wire_layout.h"
 
 /********************************************************************
  * Function declaration
@@ -20,12 +21,14 @@ namespace openfpga {
 
 void print_verilog_core_module(NetlistManager& netlist_manager,
                                const ModuleManager& module_manager,
+                               VerilogModuleWireLayout& wire_layout,
                                const ModuleNameMap& module_name_map,
                                const std::string& verilog_dir,
                                const FabricVerilogOption& options);
 
 void print_verilog_top_module(NetlistManager& netlist_manager,
                               const ModuleManager& module_manager,
+                              VerilogModuleWireLayout& wire_layout,
                               const ModuleNameMap& module_name_map,
                               const std::string& verilog_dir,
                               const FabricVerilogOption& options);
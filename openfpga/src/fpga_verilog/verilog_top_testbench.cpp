@@ -31,6 +31,7 @@
 #include "verilog_top_testbench_constants.h"
 #include "verilog_top_testbench_memory_bank.h"
 #include "verilog_writer_utils.h"
+#include "write_hex_fabric_bitstream.h"
 
 /* begin namespace openfpga */
 namespace openfpga {
@@ -1588,9 +1589,9 @@ static void print_verilog_full_testbench_vanilla_bitstream(
  *******************************************************************/
 static void print_verilog_full_testbench_configuration_chain_bitstream(
   std::fstream& fp, const std::string& bitstream_file,
-  const bool& fast_configuration, const bool& bit_value_to_skip,
-  const ModuleManager& module_manager, const ModuleId& top_module,
-  const BitstreamManager& bitstream_manager,
+  const bool& hex_bitstream, const bool& fast_configuration,
+  const bool& bit_value_to_skip, const ModuleManager& module_manager,
+  const ModuleId& top_module, const BitstreamManager& bitstream_manager,
   const FabricBitstream& fabric_bitstream,
   const ConfigProtocol& config_protocol) {
   /* Validate the file stream */
@@ -1612,6 +1613,13 @@ static void print_verilog_full_testbench_configuration_chain_bitstream(
   }
   VTR_ASSERT(num_bits_to_skip < regional_bitstream_max_size);
 
+  /* The packed bitstream is written along with the testbench, so that its
+   * length is always consistent with the virtual memory */
+  if (true == hex_bitstream) {
+    write_config_chain_fabric_bitstream_to_hex_file(
+      bitstream_file, bitstream_manager, fabric_bitstream, num_bits_to_skip);
+  }
+
   size_t num_prog_clocks =
     find_config_protocol_num_prog_clocks(config_protocol);
 
@@ -1677,8 +1685,9 @@ static void print_verilog_full_testbench_configuration_chain_bitstream(
     fp, "----- Preload bitstream file to a virtual memory -----");
   fp << "initial begin" << std::endl;
   fp << "\t";
-  fp << "$readmemb(\"" << bitstream_file << "\", "
-     << TOP_TB_BITSTREAM_MEM_REG_NAME << ");";
+  fp << (hex_bitstream ? "$readmemh" : "$readmemb");
+  fp << "(\"" << bitstream_file << "\", " << TOP_TB_BITSTREAM_MEM_REG_NAME
+     << ");";
   fp << std::endl;
 
   print_verilog_comment(fp, "----- Configuration chain default input -----");
@@ -1992,9 +2001,9 @@ static void print_verilog_full_testbench_configuration_chain_bitstream(
  *******************************************************************/
 static void print_verilog_full_testbench_memory_bank_bitstream(
   std::fstream& fp, const std::string& bitstream_file,
-  const bool& fast_configuration, const bool& bit_value_to_skip,
-  const ModuleManager& module_manager, const ModuleId& top_module,
-  const FabricBitstream& fabric_bitstream) {
+  const bool& hex_bitstream, const bool& fast_configuration,
+  const bool& bit_value_to_skip, const ModuleManager& module_manager,
+  const ModuleId& top_module, const FabricBitstream& fabric_bitstream) {
   /* Validate the file stream */
   valid_file_stream(fp);
 
@@ -2012,6 +2021,14 @@ static void print_verilog_full_testbench_memory_bank_bitstream(
   }
   VTR_ASSERT(num_bits_to_skip < fabric_bits_by_addr.size());
 
+  /* The packed bitstream is written along with the testbench, so that its
+   * length is always consistent with the virtual memory */
+  if (true == hex_bitstream) {
+    write_memory_bank_fabric_bitstream_to_hex_file(
+      bitstream_file, fabric_bits_by_addr, fast_configuration,
+      bit_value_to_skip);
+  }
+
   /* Feed address and data input pair one by one
    * Note: the first cycle is reserved for programming reset
    * We should give dummy values
@@ -2055,8 +2072,9 @@ static void print_verilog_full_testbench_memory_bank_bitstream(
     fp, "----- Preload bitstream file to a virtual memory -----");
   fp << "initial begin" << std::endl;
   fp << "\t";
-  fp << "$readmemb(\"" << bitstream_file << "\", "
-     << TOP_TB_BITSTREAM_MEM_REG_NAME << ");";
+  fp << (hex_bitstream ? "$readmemh" : "$readmemb");
+  fp << "(\"" << bitstream_file << "\", " << TOP_TB_BITSTREAM_MEM_REG_NAME
+     << ");";
   fp << std::endl;
 
   print_verilog_comment(fp, "----- Bit-Line Address port default input -----");
@@ -2298,9 +2316,10 @@ static void print_verilog_full_testbench_frame_decoder_bitstream(
  *******************************************************************/
 static void print_verilog_full_testbench_bitstream(
   std::fstream& fp, const std::string& bitstream_file,
-  const ConfigProtocol& config_protocol, const bool& fast_configuration,
-  const bool& bit_value_to_skip, const ModuleManager& module_manager,
-  const ModuleId& top_module, const BitstreamManager& bitstream_manager,
+  const bool& hex_bitstream, const ConfigProtocol& config_protocol,
+  const bool& fast_configuration, const bool& bit_value_to_skip,
+  const ModuleManager& module_manager, const ModuleId& top_module,
+  const BitstreamManager& bitstream_manager,
   const FabricBitstream& fabric_bitstream,
   const MemoryBankShiftRegisterBanks& blwl_sr_banks) {
   /* Branch on the type of configuration protocol */
@@ -2312,14 +2331,14 @@ static void print_verilog_full_testbench_bitstream(
       break;
     case CONFIG_MEM_SCAN_CHAIN:
       print_verilog_full_testbench_configuration_chain_bitstream(
-        fp, bitstream_file, fast_configuration, bit_value_to_skip,
-        module_manager, top_module, bitstream_manager, fabric_bitstream,
-        config_protocol);
+        fp, bitstream_file, hex_bitstream, fast_configuration,
+        bit_value_to_skip, module_manager, top_module, bitstream_manager,
+        fabric_bitstream, config_protocol);
       break;
     case CONFIG_MEM_MEMORY_BANK:
       print_verilog_full_testbench_memory_bank_bitstream(
-        fp, bitstream_file, fast_configuration, bit_value_to_skip,
-        module_manager, top_module, fabric_bitstream);
+        fp, bitstream_file, hex_bitstream, fast_configuration,
+        bit_value_to_skip, module_manager, top_module, fabric_bitstream);
       break;
     case CONFIG_MEM_QL_MEMORY_BANK:
       print_verilog_full_testbench_ql_memory_bank_bitstream(
@@ -2489,6 +2508,17 @@ int print_verilog_full_testbench(
     circuit_name;
   print_verilog_file_header(fp, title, options.time_stamp());
 
+  /* Only the protocols whose bitstream is a plain memory of words can be
+   * loaded from a hex file */
+  if ((true == options.hex_bitstream()) &&
+      (CONFIG_MEM_SCAN_CHAIN != config_protocol.type()) &&
+      (CONFIG_MEM_MEMORY_BANK != config_protocol.type())) {
+    VTR_LOG_ERROR(
+      "Option '--hex_bitstream' is only applicable to configuration chain "
+      "and memory bank protocols!\n");
+    return CMD_EXEC_FATAL_ERROR;
+  }
+
   /* Spot the dut module */
   ModuleId top_module =
     module_manager.find_module(module_name_map.name(options.dut_module()));
@@ -2625,9 +2655,9 @@ int print_verilog_full_testbench(
 
   /* load bitstream to FPGA fabric in a configuration phase */
   print_verilog_full_testbench_bitstream(
-    fp, bitstream_file, config_protocol, apply_fast_configuration,
-    bit_value_to_skip, module_manager, core_module, bitstream_manager,
-    fabric_bitstream, blwl_sr_banks);
+    fp, bitstream_file, options.hex_bitstream(), config_protocol,
+    apply_fast_configuration, bit_value_to_skip, module_manager, core_module,
+    bitstream_manager, fabric_bitstream, blwl_sr_banks);
 
   /* Add signal initialization:
    * Bypass writing codes to files due to the autogenerated codes are very
@@ -32,10 +32,10 @@ void print_verilog_default_net_type_declaration(
   std::fstream& fp, const e_verilog_default_net_type& default_net_type) {
   VTR_ASSERT(true == valid_file_stream(fp));
 
-  fp << "//----- Default net type -----" << std::endl;
+  fp << "//----- Default net type -----\n";
   fp << "`default_nettype " << VERILOG_DEFAULT_NET_TYPE_STRING[default_net_type]
-     << std::endl;
-  fp << std::endl;
+     << '\n';
+  fp << '\n';
 }
 
 /************************************************
@@ -47,11 +47,11 @@ void print_verilog_file_header(std::fstream& fp, const std::string& usage,
                                const bool& include_time_scale) {
   VTR_ASSERT(true == valid_file_stream(fp));
 
-  fp << "//-------------------------------------------" << std::endl;
-  fp << "//\tFPGA Synthesizable Verilog Netlist" << std::endl;
-  fp << "//\tDescription: " << usage << std::endl;
-  fp << "//\tAuthor: Xifan TANG" << std::endl;
-  fp << "//\tOrganization: University of Utah" << std::endl;
+  fp << "//-------------------------------------------\n";
+  fp << "//\tFPGA Synthesizable Verilog Netlist\n";
+  fp << "//\tDescription: " << usage << '\n';
+  fp << "//\tAuthor: Xifan TANG\n";
+  fp << "//\tOrganization: University of Utah\n";
 
   if (include_time_stamp) {
     auto end = std::chrono::system_clock::now();
@@ -59,12 +59,12 @@ void print_verilog_file_header(std::fstream& fp, const std::string& usage,
     fp << "//\tDate: " << std::ctime(&end_time);
   }
 
-  fp << "//-------------------------------------------" << std::endl;
+  fp << "//-------------------------------------------\n";
 
   if (include_time_scale) {
-    fp << "//----- Time scale -----" << std::endl;
-    fp << "`timescale 1ns / 1ps" << std::endl;
-    fp << std::endl;
+    fp << "//----- Time scale -----\n";
+    fp << "`timescale 1ns / 1ps\n";
+    fp << '\n';
   }
 }
 
@@ -75,7 +75,7 @@ void print_verilog_include_netlist(std::fstream& fp,
                                    const std::string& netlist_name) {
   VTR_ASSERT(true == valid_file_stream(fp));
 
-  fp << "`include \"" << netlist_name << "\"" << std::endl;
+  fp << "`include \"" << netlist_name << "\"\n";
 }
 
 /********************************************************************
@@ -85,7 +85,7 @@ void print_verilog_define_flag(std::fstream& fp, const std::string& flag_name,
                                const int& flag_value) {
   VTR_ASSERT(true == valid_file_stream(fp));
 
-  fp << "`define " << flag_name << " " << flag_value << std::endl;
+  fp << "`define " << flag_name << " " << flag_value << '\n';
 }
 
 /************************************************
@@ -106,7 +106,7 @@ void print_verilog_include_defines_preproc_file(
 void print_verilog_comment(std::fstream& fp, const std::string& comment) {
   VTR_ASSERT(true == valid_file_stream(fp));
 
-  fp << "// " << comment << std::endl;
+  fp << "// " << comment << '\n';
 }
 
 /************************************************
@@ -116,7 +116,7 @@ void print_verilog_preprocessing_flag(std::fstream& fp,
                                       const std::string& preproc_flag) {
   VTR_ASSERT(true == valid_file_stream(fp));
 
-  fp << "`ifdef " << preproc_flag << std::endl;
+  fp << "`ifdef " << preproc_flag << '\n';
 }
 
 /************************************************
@@ -125,7 +125,7 @@ void print_verilog_preprocessing_flag(std::fstream& fp,
 void print_verilog_endif(std::fstream& fp) {
   VTR_ASSERT(true == valid_file_stream(fp));
 
-  fp << "`endif" << std::endl;
+  fp << "`endif\n";
 }
 
 /************************************************
@@ -133,9 +133,9 @@ void print_verilog_endif(std::fstream& fp) {
  * We use the following format:
  * module <module_name> (<ports without directions>);
  ***********************************************/
-void print_verilog_module_definition(std::fstream& fp,
-                                     const ModuleManager& module_manager,
-                                     const ModuleId& module_id) {
+void print_verilog_module_definition(
+  std::fstream& fp, const ModuleManager& module_manager,
+  const ModuleId& module_id, const VerilogModulePortSignature& signature) {
   VTR_ASSERT(true == valid_file_stream(fp));
 
   print_verilog_comment(
@@ -146,63 +146,91 @@ void print_verilog_module_definition(std::fstream& fp,
     "module " + module_manager.module_name(module_id) + "(";
   fp << module_head_line;
 
-  /* port type2type mapping */
-  std::map<ModuleManager::e_module_port_type, enum e_dump_verilog_port_type>
-    port_type2type_map;
-  port_type2type_map[ModuleManager::MODULE_GLOBAL_PORT] = VERILOG_PORT_CONKT;
-  port_type2type_map[ModuleManager::MODULE_GPIN_PORT] = VERILOG_PORT_CONKT;
-  port_type2type_map[ModuleManager::MODULE_GPOUT_PORT] = VERILOG_PORT_CONKT;
-  port_type2type_map[ModuleManager::MODULE_GPIO_PORT] = VERILOG_PORT_CONKT;
-  port_type2type_map[ModuleManager::MODULE_INOUT_PORT] = VERILOG_PORT_CONKT;
-  port_type2type_map[ModuleManager::MODULE_INPUT_PORT] = VERILOG_PORT_CONKT;
-  port_type2type_map[ModuleManager::MODULE_OUTPUT_PORT] = VERILOG_PORT_CONKT;
-  port_type2type_map[ModuleManager::MODULE_CLOCK_PORT] = VERILOG_PORT_CONKT;
-
   /* Port sequence: global, inout, input, output and clock ports, */
   size_t port_cnt = 0;
   bool printed_ifdef =
     false; /* A flag to tell if an ifdef has been printed for the last port */
-  for (const auto& kv : port_type2type_map) {
-    for (const auto& port :
-         module_manager.module_ports_by_type(module_id, kv.first)) {
-      if (0 != port_cnt) {
-        /* Do not dump a comma for the first port */
-        fp << "," << std::endl;
-      }
-
-      if (true == printed_ifdef) {
-        /* Print an endif to pair the ifdef */
-        print_verilog_endif(fp);
-        /* Reset the flag */
-        printed_ifdef = false;
-      }
+  for (const VerilogModulePort& module_port : signature) {
+    if (0 != port_cnt) {
+      /* Do not dump a comma for the first port */
+      fp << ",\n";
+    }
 
-      ModulePortId port_id =
-        module_manager.find_module_port(module_id, port.get_name());
-      VTR_ASSERT(ModulePortId::INVALID() != port_id);
-      /* Print pre-processing flag for a port, if defined */
-      std::string preproc_flag =
-        module_manager.port_preproc_flag(module_id, port_id);
-      if (false == preproc_flag.empty()) {
-        /* Print an ifdef Verilog syntax */
-        print_verilog_preprocessing_flag(fp, preproc_flag);
-        /* Raise the flag */
-        printed_ifdef = true;
-      }
+    if (true == printed_ifdef) {
+      /* Print an endif to pair the ifdef */
+      print_verilog_endif(fp);
+      /* Reset the flag */
+      printed_ifdef = false;
+    }
 
-      /* Create a space for "module <module_name>" except the first line! */
-      if (0 != port_cnt) {
-        std::string port_whitespace(module_head_line.length(), ' ');
-        fp << port_whitespace;
-      }
-      /* Print port: only the port name is enough */
-      fp << port.get_name();
+    /* Print pre-processing flag for a port, if defined */
+    if (false == module_port.preproc_flag.empty()) {
+      /* Print an ifdef Verilog syntax */
+      print_verilog_preprocessing_flag(fp, module_port.preproc_flag);
+      /* Raise the flag */
+      printed_ifdef = true;
+    }
 
-      /* Increase the counter */
-      port_cnt++;
+    /* Create a space for "module <module_name>" except the first line! */
+    if (0 != port_cnt) {
+      std::string port_whitespace(module_head_line.length(), ' ');
+      fp << port_whitespace;
     }
+    /* Print port: only the port name is enough */
+    fp << module_port.port.get_name();
+
+    /* Increase the counter */
+    port_cnt++;
+  }
+  fp << ");\n";
+}
+
+void print_verilog_module_definition(std::fstream& fp,
+                                     const ModuleManager& module_manager,
+                                     const ModuleId& module_id) {
+  print_verilog_module_definition(
+    fp, module_manager, module_id,
+    build_verilog_module_port_signature(module_manager, module_id));
+}
+
+/************************************************
+ * Find the Verilog port type to declare a port of a module
+ ***********************************************/
+static e_dump_verilog_port_type find_verilog_module_port_declaration_type(
+  const ModuleManager::e_module_port_type& port_type) {
+  switch (port_type) {
+    case ModuleManager::MODULE_GPOUT_PORT:
+    case ModuleManager::MODULE_OUTPUT_PORT:
+      return VERILOG_PORT_OUTPUT;
+    case ModuleManager::MODULE_GPIO_PORT:
+    case ModuleManager::MODULE_INOUT_PORT:
+      return VERILOG_PORT_INOUT;
+    default:
+      return VERILOG_PORT_INPUT;
+  }
+}
+
+/************************************************
+ * Print a Verilog port of a module, guarded by its pre-processing flag
+ * if defined
+ ***********************************************/
+static void print_verilog_module_port_with_preproc_flag(
+  std::fstream& fp, const e_dump_verilog_port_type& verilog_port_type,
+  const VerilogModulePort& module_port) {
+  /* Print pre-processing flag for a port, if defined */
+  if (false == module_port.preproc_flag.empty()) {
+    /* Print an ifdef Verilog syntax */
+    print_verilog_preprocessing_flag(fp, module_port.preproc_flag);
+  }
+
+  /* Print port */
+  fp << generate_verilog_port(verilog_port_type, module_port.port);
+  fp << ";\n";
+
+  if (false == module_port.preproc_flag.empty()) {
+    /* Print an endif to pair the ifdef */
+    print_verilog_endif(fp);
   }
-  fp << ");" << std::endl;
 }
 
 /************************************************
@@ -210,122 +238,72 @@ void print_verilog_module_definition(std::fstream& fp,
  ***********************************************/
 void print_verilog_module_ports(
   std::fstream& fp, const ModuleManager& module_manager,
-  const ModuleId& module_id,
+  const VerilogModulePortSignature& signature,
   const e_verilog_default_net_type& default_net_type) {
   VTR_ASSERT(true == valid_file_stream(fp));
 
-  /* port type2type mapping */
-  std::map<ModuleManager::e_module_port_type, enum e_dump_verilog_port_type>
-    port_type2type_map;
-  port_type2type_map[ModuleManager::MODULE_GLOBAL_PORT] = VERILOG_PORT_INPUT;
-  port_type2type_map[ModuleManager::MODULE_GPIN_PORT] = VERILOG_PORT_INPUT;
-  port_type2type_map[ModuleManager::MODULE_GPOUT_PORT] = VERILOG_PORT_OUTPUT;
-  port_type2type_map[ModuleManager::MODULE_GPIO_PORT] = VERILOG_PORT_INOUT;
-  port_type2type_map[ModuleManager::MODULE_INOUT_PORT] = VERILOG_PORT_INOUT;
-  port_type2type_map[ModuleManager::MODULE_INPUT_PORT] = VERILOG_PORT_INPUT;
-  port_type2type_map[ModuleManager::MODULE_OUTPUT_PORT] = VERILOG_PORT_OUTPUT;
-  port_type2type_map[ModuleManager::MODULE_CLOCK_PORT] = VERILOG_PORT_INPUT;
-
   /* Port sequence: global, inout, input, output and clock ports, */
-  for (const auto& kv : port_type2type_map) {
-    for (const auto& port :
-         module_manager.module_ports_by_type(module_id, kv.first)) {
-      ModulePortId port_id =
-        module_manager.find_module_port(module_id, port.get_name());
-      VTR_ASSERT(ModulePortId::INVALID() != port_id);
-      /* Print pre-processing flag for a port, if defined */
-      std::string preproc_flag =
-        module_manager.port_preproc_flag(module_id, port_id);
-      if (false == preproc_flag.empty()) {
-        /* Print an ifdef Verilog syntax */
-        print_verilog_preprocessing_flag(fp, preproc_flag);
-      }
-
-      /* Print port */
-      fp << "//----- " << module_manager.module_port_type_str(kv.first)
-         << " -----" << std::endl;
-      fp << generate_verilog_port(kv.second, port);
-      fp << ";" << std::endl;
+  for (const VerilogModulePort& module_port : signature) {
+    /* Print pre-processing flag for a port, if defined */
+    if (false == module_port.preproc_flag.empty()) {
+      /* Print an ifdef Verilog syntax */
+      print_verilog_preprocessing_flag(fp, module_port.preproc_flag);
+    }
 
-      if (false == preproc_flag.empty()) {
-        /* Print an endif to pair the ifdef */
-        print_verilog_endif(fp);
-      }
+    /* Print port */
+    fp << "//----- " << module_manager.module_port_type_str(module_port.type)
+       << " -----\n";
+    fp << generate_verilog_port(
+      find_verilog_module_port_declaration_type(module_port.type),
+      module_port.port);
+    fp << ";\n";
+
+    if (false == module_port.preproc_flag.empty()) {
+      /* Print an endif to pair the ifdef */
+      print_verilog_endif(fp);
     }
   }
 
   /* Output any port that is also wire connection when default net type is not
    * wire! */
   if (VERILOG_DEFAULT_NET_TYPE_WIRE != default_net_type) {
-    fp << std::endl;
-    fp << "//----- BEGIN wire-connection ports -----" << std::endl;
-    for (const auto& kv : port_type2type_map) {
-      for (const auto& port :
-           module_manager.module_ports_by_type(module_id, kv.first)) {
-        /* Skip the ports that are not registered */
-        ModulePortId port_id =
-          module_manager.find_module_port(module_id, port.get_name());
-        VTR_ASSERT(ModulePortId::INVALID() != port_id);
-        if (false == module_manager.port_is_wire(module_id, port_id)) {
-          continue;
-        }
-
-        /* Print pre-processing flag for a port, if defined */
-        std::string preproc_flag =
-          module_manager.port_preproc_flag(module_id, port_id);
-        if (false == preproc_flag.empty()) {
-          /* Print an ifdef Verilog syntax */
-          print_verilog_preprocessing_flag(fp, preproc_flag);
-        }
-
-        /* Print port */
-        fp << generate_verilog_port(VERILOG_PORT_WIRE, port);
-        fp << ";" << std::endl;
-
-        if (false == preproc_flag.empty()) {
-          /* Print an endif to pair the ifdef */
-          print_verilog_endif(fp);
-        }
+    fp << '\n';
+    fp << "//----- BEGIN wire-connection ports -----\n";
+    for (const VerilogModulePort& module_port : signature) {
+      /* Skip the ports that are not wire connections */
+      if (false == module_port.is_wire) {
+        continue;
       }
+      print_verilog_module_port_with_preproc_flag(fp, VERILOG_PORT_WIRE,
+                                                  module_port);
     }
-    fp << "//----- END wire-connection ports -----" << std::endl;
-    fp << std::endl;
+    fp << "//----- END wire-connection ports -----\n";
+    fp << '\n';
   }
 
   /* Output any port that is registered */
-  fp << std::endl;
-  fp << "//----- BEGIN Registered ports -----" << std::endl;
-  for (const auto& kv : port_type2type_map) {
-    for (const auto& port :
-         module_manager.module_ports_by_type(module_id, kv.first)) {
-      /* Skip the ports that are not registered */
-      ModulePortId port_id =
-        module_manager.find_module_port(module_id, port.get_name());
-      VTR_ASSERT(ModulePortId::INVALID() != port_id);
-      if (false == module_manager.port_is_register(module_id, port_id)) {
-        continue;
-      }
-
-      /* Print pre-processing flag for a port, if defined */
-      std::string preproc_flag =
-        module_manager.port_preproc_flag(module_id, port_id);
-      if (false == preproc_flag.empty()) {
-        /* Print an ifdef Verilog syntax */
-        print_verilog_preprocessing_flag(fp, preproc_flag);
-      }
-
-      /* Print port */
-      fp << generate_verilog_port(VERILOG_PORT_REG, port);
-      fp << ";" << std::endl;
-
-      if (false == preproc_flag.empty()) {
-        /* Print an endif to pair the ifdef */
-        print_verilog_endif(fp);
-      }
+  fp << '\n';
+  fp << "//----- BEGIN Registered ports -----\n";
+  for (const VerilogModulePort& module_port : signature) {
+    /* Skip the ports that are not registered */
+    if (false == module_port.is_register) {
+      continue;
     }
+    print_verilog_module_port_with_preproc_flag(fp, VERILOG_PORT_REG,
+                                                module_port);
   }
-  fp << "//----- END Registered ports -----" << std::endl;
-  fp << std::endl;
+  fp << "//----- END Registered ports -----\n";
+  fp << '\n';
+}
+
+void print_verilog_module_ports(
+  std::fstream& fp, const ModuleManager& module_manager,
+  const ModuleId& module_id,
+  const e_verilog_default_net_type& default_net_type) {
+  print_verilog_module_ports(
+    fp, module_manager,
+    build_verilog_module_port_signature(module_manager, module_id),
+    default_net_type);
 }
 
 /************************************************
@@ -336,7 +314,7 @@ void print_verilog_module_ports(
  ***********************************************/
 void print_verilog_module_declaration(
   std::fstream& fp, const ModuleManager& module_manager,
-  const ModuleId& module_id,
+  const ModuleId& module_id, const VerilogModulePortSignature& signature,
   const e_verilog_default_net_type& default_net_type) {
   VTR_ASSERT(true == valid_file_stream(fp));
 
@@ -345,9 +323,19 @@ void print_verilog_module_declaration(
     print_verilog_default_net_type_declaration(fp, default_net_type);
   }
 
-  print_verilog_module_definition(fp, module_manager, module_id);
+  print_verilog_module_definition(fp, module_manager, module_id, signature);
+
+  print_verilog_module_ports(fp, module_manager, signature, default_net_type);
+}
 
-  print_verilog_module_ports(fp, module_manager, module_id, default_net_type);
+void print_verilog_module_declaration(
+  std::fstream& fp, const ModuleManager& module_manager,
+  const ModuleId& module_id,
+  const e_verilog_default_net_type& default_net_type) {
+  print_verilog_module_declaration(
+    fp, module_manager, module_id,
+    build_verilog_module_port_signature(module_manager, module_id),
+    default_net_type);
 }
 
 /********************************************************************
@@ -388,64 +376,44 @@ void print_verilog_module_instance(
   /* Print module name */
   fp << "\t" << module_manager.module_name(module_id) << " ";
   /* Print instance name */
-  fp << instance_name << " (" << std::endl;
+  fp << instance_name << " (\n";
 
   /* Print each port with/without explicit port map */
-  /* port type2type mapping */
-  std::map<ModuleManager::e_module_port_type, enum e_dump_verilog_port_type>
-    port_type2type_map;
-  port_type2type_map[ModuleManager::MODULE_GLOBAL_PORT] = VERILOG_PORT_CONKT;
-  port_type2type_map[ModuleManager::MODULE_GPIN_PORT] = VERILOG_PORT_CONKT;
-  port_type2type_map[ModuleManager::MODULE_GPOUT_PORT] = VERILOG_PORT_CONKT;
-  port_type2type_map[ModuleManager::MODULE_GPIO_PORT] = VERILOG_PORT_CONKT;
-  port_type2type_map[ModuleManager::MODULE_INOUT_PORT] = VERILOG_PORT_CONKT;
-  port_type2type_map[ModuleManager::MODULE_INPUT_PORT] = VERILOG_PORT_CONKT;
-  port_type2type_map[ModuleManager::MODULE_OUTPUT_PORT] = VERILOG_PORT_CONKT;
-  port_type2type_map[ModuleManager::MODULE_CLOCK_PORT] = VERILOG_PORT_CONKT;
-
   /* Port sequence: global, inout, input, output and clock ports, */
   size_t port_cnt = 0;
-  for (const auto& kv : port_type2type_map) {
-    for (const auto& port :
-         module_manager.module_ports_by_type(module_id, kv.first)) {
-      if (0 != port_cnt) {
-        /* Do not dump a comma for the first port */
-        fp << "," << std::endl;
-      }
-      /* Print port */
-      fp << "\t\t";
-      /* if explicit port map is required, output the port name */
-      if (true == use_explicit_port_map) {
-        fp << "." << port.get_name() << "(";
-      }
-      /* Try to find the instanced port name in the name map */
-      if (port2port_name_map.find(port.get_name()) !=
-          port2port_name_map.end()) {
-        /* Found it, we assign the port name */
-        /* TODO: make sure the port width matches! */
-        ModulePortId module_port_id =
-          module_manager.find_module_port(module_id, port.get_name());
-        /* Get the port from module */
-        BasicPort module_port =
-          module_manager.module_port(module_id, module_port_id);
-        VTR_ASSERT(module_port.get_width() ==
-                   port2port_name_map.at(port.get_name()).get_width());
-        fp << generate_verilog_port(kv.second,
-                                    port2port_name_map.at(port.get_name()));
-      } else {
-        /* Not found, we give the default port name */
-        fp << generate_verilog_port(kv.second, port);
-      }
-      /* if explicit port map is required, output the pair of branket */
-      if (true == use_explicit_port_map) {
-        fp << ")";
-      }
-      port_cnt++;
+  for (const VerilogModulePort& module_port :
+       build_verilog_module_port_signature(module_manager, module_id)) {
+    const BasicPort& port = module_port.port;
+    if (0 != port_cnt) {
+      /* Do not dump a comma for the first port */
+      fp << ",\n";
+    }
+    /* Print port */
+    fp << "\t\t";
+    /* if explicit port map is required, output the port name */
+    if (true == use_explicit_port_map) {
+      fp << "." << port.get_name() << "(";
+    }
+    /* Try to find the instanced port name in the name map */
+    auto instance_port = port2port_name_map.find(port.get_name());
+    if (instance_port != port2port_name_map.end()) {
+      /* Found it, we assign the port name */
+      /* TODO: make sure the port width matches! */
+      VTR_ASSERT(port.get_width() == instance_port->second.get_width());
+      fp << generate_verilog_port(VERILOG_PORT_CONKT, instance_port->second);
+    } else {
+      /* Not found, we give the default port name */
+      fp << generate_verilog_port(VERILOG_PORT_CONKT, port);
     }
+    /* if explicit port map is required, output the pair of branket */
+    if (true == use_explicit_port_map) {
+      fp << ")";
+    }
+    port_cnt++;
   }
 
   /* Print an end to the instance */
-  fp << ");" << std::endl;
+  fp << ");\n";
 }
 
 /************************************************
@@ -480,10 +448,10 @@ void print_verilog_module_end(
   const e_verilog_default_net_type& default_net_type) {
   VTR_ASSERT(true == valid_file_stream(fp));
 
-  fp << "endmodule" << std::endl;
+  fp << "endmodule\n";
   print_verilog_comment(
     fp, std::string("----- END Verilog module for " + module_name + " -----"));
-  fp << std::endl;
+  fp << '\n';
 
   /* Reset default net type to be none */
   if (default_net_type != VERILOG_DEFAULT_NET_TYPE_WIRE) {
@@ -493,30 +461,44 @@ void print_verilog_module_end(
 }
 
 /************************************************
- * Generate a string of a Verilog port
+ * Append a non-negative number to a string buffer,
+ * without creating any temporary string
  ***********************************************/
-std::string generate_verilog_port(
-  const enum e_dump_verilog_port_type& verilog_port_type,
-  const BasicPort& port_info, const bool& must_print_port_size,
-  const bool& big_endian) {
-  std::string verilog_line;
+void append_verilog_number(std::string& buffer, const size_t& number) {
+  append_number_to_buffer(buffer, number);
+}
+
+/************************************************
+ * Append the size of a Verilog port, i.e., [<msb>:<lsb>]
+ ***********************************************/
+static void append_verilog_port_size(std::string& buffer,
+                                     const BasicPort& port_info,
+                                     const bool& big_endian) {
+  buffer += '[';
+  append_verilog_number(buffer,
+                        big_endian ? port_info.get_lsb() : port_info.get_msb());
+  buffer += ':';
+  append_verilog_number(buffer,
+                        big_endian ? port_info.get_msb() : port_info.get_lsb());
+  buffer += ']';
+}
 
+/************************************************
+ * Append a Verilog port to a string buffer
+ ***********************************************/
+void append_verilog_port(std::string& buffer,
+                         const enum e_dump_verilog_port_type& verilog_port_type,
+                         const BasicPort& port_info,
+                         const bool& must_print_port_size,
+                         const bool& big_endian) {
   /* Ensure the port type is valid */
   VTR_ASSERT(verilog_port_type < NUM_VERILOG_PORT_TYPES);
 
-  std::string size_str;
-  if (big_endian) {
-    size_str = "[" + std::to_string(port_info.get_lsb()) + ":" +
-               std::to_string(port_info.get_msb()) + "]";
-  } else {
-    size_str = "[" + std::to_string(port_info.get_msb()) + ":" +
-               std::to_string(port_info.get_lsb()) + "]";
-  }
-
   /* Only connection require a format of <port_name>[<lsb>:<msb>]
    * others require a format of <port_type> [<lsb>:<msb>] <port_name>
    */
   if (VERILOG_PORT_CONKT == verilog_port_type) {
+    buffer += symbol_string(port_info.get_name_symbol());
     /* Simplication:
      * - When LSB == MSB == 0, we do not need to specify size when the user
      * option allows Note that user option is essential, otherwise what could
@@ -529,16 +511,34 @@ std::string generate_verilog_port(
     if ((false == must_print_port_size) && (1 == port_info.get_width()) &&
         (0 == port_info.get_lsb()) &&
         (1 == port_info.get_origin_port_width())) {
-      size_str.clear();
-    } else if ((1 == port_info.get_width())) {
-      size_str = "[" + std::to_string(port_info.get_lsb()) + "]";
+      return;
+    }
+    if ((1 == port_info.get_width())) {
+      buffer += '[';
+      append_verilog_number(buffer, port_info.get_lsb());
+      buffer += ']';
+      return;
     }
-    verilog_line = port_info.get_name() + size_str;
+    append_verilog_port_size(buffer, port_info, big_endian);
   } else {
-    verilog_line = VERILOG_PORT_TYPE_STRING[verilog_port_type];
-    verilog_line += " " + size_str + " " + port_info.get_name();
+    buffer += VERILOG_PORT_TYPE_STRING[verilog_port_type];
+    buffer += ' ';
+    append_verilog_port_size(buffer, port_info, big_endian);
+    buffer += ' ';
+    buffer += symbol_string(port_info.get_name_symbol());
   }
+}
 
+/************************************************
+ * Generate a string of a Verilog port
+ ***********************************************/
+std::string generate_verilog_port(
+  const enum e_dump_verilog_port_type& verilog_port_type,
+  const BasicPort& port_info, const bool& must_print_port_size,
+  const bool& big_endian) {
+  std::string verilog_line;
+  append_verilog_port(verilog_line, verilog_port_type, port_info,
+                      must_print_port_size, big_endian);
   return verilog_line;
 }
 
@@ -629,9 +629,10 @@ std::vector<BasicPort> combine_verilog_ports(
 }
 
 /************************************************
- * Generate the string of a list of verilog ports
+ * Append a list of verilog ports to a string buffer
  ***********************************************/
-std::string generate_verilog_ports(const std::vector<BasicPort>& merged_ports) {
+void append_verilog_ports(std::string& buffer,
+                          const std::vector<BasicPort>& merged_ports) {
   /* Output the string of ports:
    * If there is only one port in the merged_port list
    * we only output the port.
@@ -642,19 +643,27 @@ std::string generate_verilog_ports(const std::vector<BasicPort>& merged_ports) {
   VTR_ASSERT(0 < merged_ports.size());
   if (1 == merged_ports.size()) {
     /* Use connection type of verilog port */
-    return generate_verilog_port(VERILOG_PORT_CONKT, merged_ports[0], false);
+    append_verilog_port(buffer, VERILOG_PORT_CONKT, merged_ports[0], false);
+    return;
   }
 
-  std::string verilog_line = "{";
+  buffer += '{';
   for (const auto& port : merged_ports) {
     /* The first port does not need a comma */
     if (&port != &merged_ports[0]) {
-      verilog_line += ", ";
+      buffer += ", ";
     }
-    verilog_line += generate_verilog_port(VERILOG_PORT_CONKT, port, false);
+    append_verilog_port(buffer, VERILOG_PORT_CONKT, port, false);
   }
-  verilog_line += "}";
+  buffer += '}';
+}
 
+/************************************************
+ * Generate the string of a list of verilog ports
+ ***********************************************/
+std::string generate_verilog_ports(const std::vector<BasicPort>& merged_ports) {
+  std::string verilog_line;
+  append_verilog_ports(verilog_line, merged_ports);
   return verilog_line;
 }
 
@@ -716,16 +725,16 @@ std::string generate_verilog_local_wire(
   VTR_ASSERT(input_ports_width == output_port.get_width());
 
   std::string wire_str;
-  wire_str += generate_verilog_port(VERILOG_PORT_WIRE, output_port);
+  append_verilog_port(wire_str, VERILOG_PORT_WIRE, output_port);
   wire_str += " = ";
-  wire_str += generate_verilog_ports(combined_input_ports);
+  append_verilog_ports(wire_str, combined_input_ports);
   wire_str += ";";
 
   return wire_str;
 }
 
 /********************************************************************
- * Generate a string for a constant value in Verilog format:
+ * Append a constant value in Verilog format to a string buffer:
  *  <#.of bits>'b<binary numbers>
  *
  * Optimization: short_constant
@@ -733,8 +742,9 @@ std::string generate_verilog_local_wire(
  *   for all-zero/all-one vectors
  *   {<length>{1'b<zero/one>}}
  *******************************************************************/
-std::string generate_verilog_constant_values(
-  const std::vector<size_t>& const_values, const bool& short_constant) {
+void append_verilog_constant_values(std::string& buffer,
+                                    const std::vector<size_t>& const_values,
+                                    const bool& short_constant) {
   VTR_ASSERT(!const_values.empty());
 
   bool same_values = true;
@@ -752,18 +762,28 @@ std::string generate_verilog_constant_values(
     same_values = false;
   }
 
-  std::string str;
-
   if ((true == short_constant) && (true == same_values)) {
-    str = "{" + std::to_string(const_values.size()) + "{1'b" +
-          std::to_string(first_val) + "}}";
+    buffer += '{';
+    append_verilog_number(buffer, const_values.size());
+    buffer += "{1'b";
+    append_verilog_number(buffer, first_val);
+    buffer += "}}";
   } else {
-    str = std::to_string(const_values.size());
-    str += "'b";
+    append_verilog_number(buffer, const_values.size());
+    buffer += "'b";
     for (const auto& val : const_values) {
-      str += std::to_string(val);
+      append_verilog_number(buffer, val);
     }
   }
+}
+
+/********************************************************************
+ * Generate a string for a constant value in Verilog format
+ *******************************************************************/
+std::string generate_verilog_constant_values(
+  const std::vector<size_t>& const_values, const bool& short_constant) {
+  std::string str;
+  append_verilog_constant_values(str, const_values, short_constant);
   return str;
 }
 
@@ -778,14 +798,14 @@ std::string generate_verilog_port_constant_values(
   /* Must check: the port width matches */
   VTR_ASSERT(const_values.size() == output_port.get_width());
 
-  port_str = generate_verilog_port(VERILOG_PORT_CONKT, output_port);
+  append_verilog_port(port_str, VERILOG_PORT_CONKT, output_port);
   if (is_register) {
     port_str += " <= ";
   } else {
     VTR_ASSERT_SAFE(!is_register);
     port_str += " = ";
   }
-  port_str += generate_verilog_constant_values(const_values);
+  append_verilog_constant_values(port_str, const_values);
   return port_str;
 }
 
@@ -804,14 +824,14 @@ std::string generate_verilog_ports_constant_values(
   }
   VTR_ASSERT(const_values.size() == total_width);
 
-  port_str = generate_verilog_ports(output_ports);
+  append_verilog_ports(port_str, output_ports);
   if (is_register) {
     port_str += " <= ";
   } else {
     VTR_ASSERT_SAFE(!is_register);
     port_str += " = ";
   }
-  port_str += generate_verilog_constant_values(const_values);
+  append_verilog_constant_values(port_str, const_values);
   return port_str;
 }
 
@@ -828,7 +848,7 @@ void print_verilog_wire_constant_values(
   fp << "\t";
   fp << "assign ";
   fp << generate_verilog_port_constant_values(output_port, const_values);
-  fp << ";" << std::endl;
+  fp << ";\n";
 }
 
 /********************************************************************
@@ -845,7 +865,7 @@ void print_verilog_deposit_wire_constant_values(
   fp << generate_verilog_port(VERILOG_PORT_CONKT, output_port);
   fp << ", ";
   fp << generate_verilog_constant_values(const_values);
-  fp << ");" << std::endl;
+  fp << ");\n";
 }
 
 /********************************************************************
@@ -861,7 +881,7 @@ void print_verilog_force_wire_constant_values(
   fp << "\t";
   fp << "force ";
   fp << generate_verilog_port_constant_values(output_port, const_values);
-  fp << ";" << std::endl;
+  fp << ";\n";
 }
 
 /********************************************************************
@@ -878,17 +898,17 @@ void print_verilog_wire_connection(std::fstream& fp,
   /* Must check: the port width matches */
   VTR_ASSERT(input_port.get_width() == output_port.get_width());
 
-  fp << "\t";
-  fp << "assign ";
-  fp << generate_verilog_port(VERILOG_PORT_CONKT, output_port);
-  fp << " = ";
+  std::string verilog_line("\tassign ");
+  append_verilog_port(verilog_line, VERILOG_PORT_CONKT, output_port);
+  verilog_line += " = ";
 
   if (true == inverted) {
-    fp << "~";
+    verilog_line += '~';
   }
 
-  fp << generate_verilog_port(VERILOG_PORT_CONKT, input_port);
-  fp << ";" << std::endl;
+  append_verilog_port(verilog_line, VERILOG_PORT_CONKT, input_port);
+  verilog_line += ";\n";
+  fp << verilog_line;
 }
 
 /********************************************************************
@@ -914,7 +934,7 @@ void print_verilog_register_connection(std::fstream& fp,
   }
 
   fp << generate_verilog_port(VERILOG_PORT_CONKT, input_port);
-  fp << ";" << std::endl;
+  fp << ";\n";
 }
 
 /********************************************************************
@@ -1087,7 +1107,7 @@ void print_verilog_local_sram_wires(std::fstream& fp,
       BasicPort ccff_config_bus_port(generate_local_config_bus_port_name(),
                                      port_size);
       fp << generate_verilog_port(VERILOG_PORT_WIRE, ccff_config_bus_port)
-         << ";" << std::endl;
+         << ";\n";
       /* Connect first CCFF to the head */
       /* Head is always a 1-bit port */
       BasicPort ccff_head_port(
@@ -1124,7 +1144,7 @@ void print_verilog_local_sram_wires(std::fstream& fp,
       /* Print local wire definition */
       for (const auto& sram_port : sram_ports) {
         fp << generate_verilog_port(VERILOG_PORT_WIRE, sram_port) << ";"
-           << std::endl;
+           << '\n';
       }
 
       break;
@@ -1214,13 +1234,13 @@ void print_verilog_local_config_bus(
                               prefix, instance_id, CIRCUIT_MODEL_PORT_INPUT),
                             num_conf_bits);
       fp << generate_verilog_port(VERILOG_PORT_WIRE, config_port) << ";"
-         << std::endl;
+         << '\n';
       BasicPort inverted_config_port(
         generate_local_sram_port_name(prefix, instance_id,
                                       CIRCUIT_MODEL_PORT_OUTPUT),
         num_conf_bits);
       fp << generate_verilog_port(VERILOG_PORT_WIRE, inverted_config_port)
-         << ";" << std::endl;
+         << ";\n";
       break;
     }
     default:
@@ -1288,24 +1308,24 @@ static void print_verilog_rram_mux_config_bus(
         generate_reserved_sram_port_name(CIRCUIT_MODEL_PORT_BL),
         num_reserved_conf_bits);
       fp << generate_verilog_port(VERILOG_PORT_WIRE, reserved_bl_bus) << ";"
-         << std::endl;
+         << '\n';
       BasicPort reserved_wl_bus(
         generate_reserved_sram_port_name(CIRCUIT_MODEL_PORT_WL),
         num_reserved_conf_bits);
       fp << generate_verilog_port(VERILOG_PORT_WIRE, reserved_wl_bus) << ";"
-         << std::endl;
+         << '\n';
 
       /* Print configuration bus to group BL/WLs */
       BasicPort bl_bus(generate_mux_config_bus_port_name(circuit_lib, mux_model,
                                                          mux_size, 0, false),
                        num_conf_bits + num_reserved_conf_bits);
       fp << generate_verilog_port(VERILOG_PORT_WIRE, bl_bus) << ";"
-         << std::endl;
+         << '\n';
       BasicPort wl_bus(generate_mux_config_bus_port_name(circuit_lib, mux_model,
                                                          mux_size, 1, false),
                        num_conf_bits + num_reserved_conf_bits);
       fp << generate_verilog_port(VERILOG_PORT_WIRE, wl_bus) << ";"
-         << std::endl;
+         << '\n';
 
       /* Print bus to group SRAM outputs, this is to interface memory cells to
        * routing multiplexers */
@@ -1314,13 +1334,13 @@ static void print_verilog_rram_mux_config_bus(
                                     mux_instance_id, CIRCUIT_MODEL_PORT_INPUT),
         num_conf_bits);
       fp << generate_verilog_port(VERILOG_PORT_WIRE, sram_output_bus) << ";"
-         << std::endl;
+         << '\n';
       BasicPort inverted_sram_output_bus(
         generate_mux_sram_port_name(circuit_lib, mux_model, mux_size,
                                     mux_instance_id, CIRCUIT_MODEL_PORT_OUTPUT),
         num_conf_bits);
       fp << generate_verilog_port(VERILOG_PORT_WIRE, inverted_sram_output_bus)
-         << ";" << std::endl;
+         << ";\n";
 
       /* Get the SRAM model of the mux_model */
       std::vector<CircuitModelId> sram_models =
@@ -1452,13 +1472,13 @@ void print_verilog_pulse_stimuli(std::fstream& fp, const BasicPort& port,
   VTR_ASSERT(true == valid_file_stream(fp));
 
   /* Config_done signal: indicate when configuration is finished */
-  fp << "initial" << std::endl;
-  fp << "\tbegin" << std::endl;
+  fp << "initial\n";
+  fp << "\tbegin\n";
   fp << "\t";
   std::vector<size_t> initial_values(port.get_width(), initial_value);
   fp << "\t";
   fp << generate_verilog_port_constant_values(port, initial_values);
-  fp << ";" << std::endl;
+  fp << ";\n";
 
   /* if flip_value is the same as initial value, we do not need to flip the
    * signal ! */
@@ -1468,13 +1488,13 @@ void print_verilog_pulse_stimuli(std::fstream& fp, const BasicPort& port,
     std::vector<size_t> port_flip_values(port.get_width(), flip_value);
     fp << "\t";
     fp << generate_verilog_port_constant_values(port, port_flip_values);
-    fp << ";" << std::endl;
+    fp << ";\n";
   }
 
-  fp << "\tend" << std::endl;
+  fp << "\tend\n";
 
   /* Print an empty line as splitter */
-  fp << std::endl;
+  fp << '\n';
 }
 
 /********************************************************************
@@ -1496,21 +1516,21 @@ void print_verilog_shifted_clock_stimuli(std::fstream& fp,
   VTR_ASSERT(true == valid_file_stream(fp));
 
   /* Config_done signal: indicate when configuration is finished */
-  fp << "initial" << std::endl;
+  fp << "initial\n";
 
   write_tab_to_file(fp, 1);
-  fp << "begin" << std::endl;
+  fp << "begin\n";
 
   write_tab_to_file(fp, 1);
   std::vector<size_t> initial_values(port.get_width(), initial_value);
 
   write_tab_to_file(fp, 1);
   fp << generate_verilog_port_constant_values(port, initial_values);
-  fp << ";" << std::endl;
+  fp << ";\n";
 
   write_tab_to_file(fp, 2);
   fp << "#" << std::setprecision(10) << initial_delay;
-  fp << ";" << std::endl;
+  fp << ";\n";
 
   write_tab_to_file(fp, 2);
   fp << "forever ";
@@ -1518,13 +1538,13 @@ void print_verilog_shifted_clock_stimuli(std::fstream& fp,
   fp << " = ";
   fp << "#" << std::setprecision(10) << pulse_width;
   fp << " ~" << generate_verilog_port(VERILOG_PORT_CONKT, port);
-  fp << ";" << std::endl;
+  fp << ";\n";
 
   write_tab_to_file(fp, 1);
-  fp << "end" << std::endl;
+  fp << "end\n";
 
   /* Print an empty line as splitter */
-  fp << std::endl;
+  fp << '\n';
 }
 
 /********************************************************************
@@ -1548,17 +1568,17 @@ void print_verilog_pulse_stimuli(std::fstream& fp, const BasicPort& port,
   VTR_ASSERT(true == valid_file_stream(fp));
 
   /* Config_done signal: indicate when configuration is finished */
-  fp << "initial" << std::endl;
-  fp << "\tbegin" << std::endl;
+  fp << "initial\n";
+  fp << "\tbegin\n";
   fp << "\t";
   std::vector<size_t> initial_values(port.get_width(), initial_value);
   fp << "\t";
   fp << generate_verilog_port_constant_values(port, initial_values);
-  fp << ";" << std::endl;
+  fp << ";\n";
 
   /* Set a wait condition if specified */
   if (false == wait_condition.empty()) {
-    fp << "\twait(" << wait_condition << ")" << std::endl;
+    fp << "\twait(" << wait_condition << ")\n";
   }
 
   /* Number of flip conditions and values should match */
@@ -1569,13 +1589,13 @@ void print_verilog_pulse_stimuli(std::fstream& fp, const BasicPort& port,
     std::vector<size_t> port_flip_value(port.get_width(), flip_values[ipulse]);
     fp << "\t";
     fp << generate_verilog_port_constant_values(port, port_flip_value);
-    fp << ";" << std::endl;
+    fp << ";\n";
   }
 
-  fp << "\tend" << std::endl;
+  fp << "\tend\n";
 
   /* Print an empty line as splitter */
-  fp << std::endl;
+  fp << '\n';
 }
 
 /********************************************************************
@@ -1598,25 +1618,25 @@ void print_verilog_clock_stimuli(std::fstream& fp, const BasicPort& port,
   VTR_ASSERT(true == valid_file_stream(fp));
 
   /* Config_done signal: indicate when configuration is finished */
-  fp << "initial" << std::endl;
-  fp << "\tbegin" << std::endl;
+  fp << "initial\n";
+  fp << "\tbegin\n";
 
   std::vector<size_t> initial_values(port.get_width(), initial_value);
   fp << "\t\t";
   fp << generate_verilog_port_constant_values(port, initial_values);
-  fp << ";" << std::endl;
+  fp << ";\n";
 
-  fp << "\tend" << std::endl;
+  fp << "\tend\n";
   fp << "always";
 
   /* Set a wait condition if specified */
   if (true == wait_condition.empty()) {
-    fp << std::endl;
+    fp << '\n';
   } else {
-    fp << " wait(" << wait_condition << ")" << std::endl;
+    fp << " wait(" << wait_condition << ")\n";
   }
 
-  fp << "\tbegin" << std::endl;
+  fp << "\tbegin\n";
   fp << "\t\t"
      << "#" << std::setprecision(10) << pulse_width;
 
@@ -1625,12 +1645,12 @@ void print_verilog_clock_stimuli(std::fstream& fp, const BasicPort& port,
   fp << " = ";
   fp << "~";
   fp << generate_verilog_port(VERILOG_PORT_CONKT, port);
-  fp << ";" << std::endl;
+  fp << ";\n";
 
-  fp << "\tend" << std::endl;
+  fp << "\tend\n";
 
   /* Print an empty line as splitter */
-  fp << std::endl;
+  fp << '\n';
 }
 
 /********************************************************************
@@ -1656,11 +1676,21 @@ void print_verilog_netlist_include_header_file(
 
   /* Output file names */
   for (const std::string& netlist_name : netlists_to_be_included) {
-    fp << "`include \"" << netlist_name << "\"" << std::endl;
+    fp << "`include \"" << netlist_name << "\"\n";
   }
 
   /* close file stream */
   fp.close();
 }
 
+/********************************************************************
+ * Write the content of a string buffer to a file stream in one go,
+ * and empty the buffer so that its memory can be reused
+ *******************************************************************/
+void print_verilog_buffer(std::fstream& fp, std::string& buffer) {
+  VTR_ASSERT(true == valid_file_stream(fp));
+
+  write_buffer_to_file(fp, buffer);
+}
+
 } /* end namespace openfpga */
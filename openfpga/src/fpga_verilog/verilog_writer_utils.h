@@ -16,6 +16,7 @@
 #include "circuit_library.h"
 #include "module_manager.h"
 #include "openfpga_port.h"
+#include "verilog_module_port_signature.h"
 #include "verilog_port_types.h"
 
 /********************************************************************
@@ -31,6 +32,10 @@ namespace openfpga {
  * begin with "generate_verilog" Please show respect to this naming convention,
  * in order to keep a clean header/source file as well maintain a easy way to
  * identify the functions
+ * If a function appends to a string buffer, its name should begin with
+ * "append_verilog". These are the building blocks of the "generate_verilog"
+ * functions, and they allow writers to format lines in a reusable buffer
+ * without temporary strings
  */
 
 void print_verilog_default_net_type_declaration(
@@ -56,15 +61,29 @@ void print_verilog_preprocessing_flag(std::fstream& fp,
 
 void print_verilog_endif(std::fstream& fp);
 
+void print_verilog_module_definition(
+  std::fstream& fp, const ModuleManager& module_manager,
+  const ModuleId& module_id, const VerilogModulePortSignature& signature);
+
 void print_verilog_module_definition(std::fstream& fp,
                                      const ModuleManager& module_manager,
                                      const ModuleId& module_id);
 
+void print_verilog_module_ports(
+  std::fstream& fp, const ModuleManager& module_manager,
+  const VerilogModulePortSignature& signature,
+  const e_verilog_default_net_type& default_net_type);
+
 void print_verilog_module_ports(
   std::fstream& fp, const ModuleManager& module_manager,
   const ModuleId& module_id,
   const e_verilog_default_net_type& default_net_type);
 
+void print_verilog_module_declaration(
+  std::fstream& fp, const ModuleManager& module_manager,
+  const ModuleId& module_id, const VerilogModulePortSignature& signature,
+  const e_verilog_default_net_type& default_net_type);
+
 void print_verilog_module_declaration(
   std::fstream& fp, const ModuleManager& module_manager,
   const ModuleId& module_id,
@@ -86,6 +105,14 @@ void print_verilog_module_end(
   std::fstream& fp, const std::string& module_name,
   const e_verilog_default_net_type& default_net_type);
 
+void append_verilog_number(std::string& buffer, const size_t& number);
+
+void append_verilog_port(std::string& buffer,
+                         const enum e_dump_verilog_port_type& dump_port_type,
+                         const BasicPort& port_info,
+                         const bool& must_print_port_size = true,
+                         const bool& big_endian = true);
+
 std::string generate_verilog_port(
   const enum e_dump_verilog_port_type& dump_port_type,
   const BasicPort& port_info, const bool& must_print_port_size = true,
@@ -100,6 +127,9 @@ BasicPort merge_two_verilog_ports(const BasicPort& portA,
 std::vector<BasicPort> combine_verilog_ports(
   const std::vector<BasicPort>& ports);
 
+void append_verilog_ports(std::string& buffer,
+                          const std::vector<BasicPort>& merged_ports);
+
 std::string generate_verilog_ports(const std::vector<BasicPort>& merged_ports);
 
 BasicPort generate_verilog_bus_port(const std::vector<BasicPort>& input_ports,
@@ -108,6 +138,10 @@ BasicPort generate_verilog_bus_port(const std::vector<BasicPort>& input_ports,
 std::string generate_verilog_local_wire(
   const BasicPort& output_port, const std::vector<BasicPort>& input_ports);
 
+void append_verilog_constant_values(std::string& buffer,
+                                    const std::vector<size_t>& const_values,
+                                    const bool& short_constant = true);
+
 std::string generate_verilog_constant_values(
   const std::vector<size_t>& const_values, const bool& short_constant = true);
 
@@ -199,6 +233,8 @@ void print_verilog_netlist_include_header_file(
   const char* subckt_dir, const char* header_file_name,
   const bool& include_time_stamp);
 
+void print_verilog_buffer(std::fstream& fp, std::string& buffer);
+
 } /* end namespace openfpga */
 
 #endif
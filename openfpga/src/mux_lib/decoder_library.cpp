@@ -3,6 +3,7 @@
  **************************************************************************************/
 #include "decoder_library.h"
 
+#include "openfpga_binary_io.h"
 #include "vtr_assert.h"
 
 /* Begin namespace openfpga */
@@ -117,4 +118,27 @@ DecoderId DecoderLibrary::add_decoder(const size_t& addr_size,
   return decoder;
 }
 
+/***************************************************************************************
+ * Public Serializers
+ **************************************************************************************/
+void DecoderLibrary::write_binary(std::ostream& fp) const {
+  write_binary_data(fp, decoder_ids_);
+  write_binary_data(fp, addr_sizes_);
+  write_binary_data(fp, data_sizes_);
+  write_binary_data(fp, use_enable_);
+  write_binary_data(fp, use_data_in_);
+  write_binary_data(fp, use_data_inv_port_);
+  write_binary_data(fp, use_readback_);
+}
+
+void DecoderLibrary::read_binary(std::istream& fp) {
+  read_binary_data(fp, decoder_ids_);
+  read_binary_data(fp, addr_sizes_);
+  read_binary_data(fp, data_sizes_);
+  read_binary_data(fp, use_enable_);
+  read_binary_data(fp, use_data_in_);
+  read_binary_data(fp, use_data_inv_port_);
+  read_binary_data(fp, use_readback_);
+}
+
 } /* End namespace openfpga*/
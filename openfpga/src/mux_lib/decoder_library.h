@@ -22,6 +22,8 @@
 #ifndef DECODER_LIBRARY_H
 #define DECODER_LIBRARY_H
 
+#include <iosfwd>
+
 #include "decoder_library_fwd.h"
 #include "vtr_range.h"
 #include "vtr_vector.h"
@@ -72,6 +74,13 @@ class DecoderLibrary {
   /* valid ids */
   bool valid_decoder_id(const DecoderId& decoder) const;
 
+ public: /* Public serializers */
+  /** @brief Dump the content to a binary stream */
+  void write_binary(std::ostream& fp) const;
+  /** @brief Replace the content by the one loaded from a binary stream, which
+   * is created by write_binary() */
+  void read_binary(std::istream& fp);
+
  public: /* Private mutators : basic operations */
   /* Add a decoder to the library */
   DecoderId add_decoder(const size_t& addr_size, const size_t& data_size,
@@ -158,13 +158,10 @@ std::vector<MuxEdgeId> MuxGraph::find_edges(const MuxNodeId& from_node,
   VTR_ASSERT(valid_node_id(from_node));
   VTR_ASSERT(valid_node_id(to_node));
 
-  for (const auto& edge : node_out_edges_[from_node]) {
-    for (const auto& cand : edge_sink_nodes_[edge]) {
-      if (cand == to_node) {
-        /* This is the wanted edge, add to list */
-        edges.push_back(edge);
-      }
-    }
+  MuxEdgeId edge = node_out_edges_[from_node];
+  if ((MuxEdgeId::INVALID() != edge) && (to_node == edge_sink_nodes_[edge])) {
+    /* This is the wanted edge, add to list */
+    edges.push_back(edge);
   }
 
   return edges;
@@ -241,14 +238,21 @@ size_t MuxGraph::node_index_at_level(const MuxNodeId& node) const {
 std::vector<MuxEdgeId> MuxGraph::node_in_edges(const MuxNodeId& node) const {
   /* validate the node */
   VTR_ASSERT(valid_node_id(node));
-  return node_in_edges_[node];
+  edge_range in_edges = node_in_edge_range(node);
+  return std::vector<MuxEdgeId>(in_edges.begin(), in_edges.end());
 }
 
 /* Find the input nodes for a edge */
 std::vector<MuxNodeId> MuxGraph::edge_src_nodes(const MuxEdgeId& edge) const {
   /* validate the edge */
   VTR_ASSERT(valid_edge_id(edge));
-  return edge_src_nodes_[edge];
+  return std::vector<MuxNodeId>(1, edge_src_nodes_[edge]);
+}
+
+/* Find the input edges for a node, which have consecutive ids */
+MuxGraph::edge_range MuxGraph::node_in_edge_range(const MuxNodeId& node) const {
+  edge_iterator first = edge_ids_.begin() + node_in_edge_offsets_[node];
+  return vtr::make_range(first, first + node_num_in_edges_[node]);
 }
 
 /* Find the mem that control the edge */
@@ -277,7 +281,7 @@ std::vector<size_t> MuxGraph::branch_sizes() const {
       continue;
     }
 
-    size_t branch_size = node_in_edges_[node].size();
+    size_t branch_size = node_num_in_edges_[node];
 
     /* make sure the branch size is valid */
     VTR_ASSERT_SAFE(valid_mux_implementation_num_inputs(branch_size));
@@ -316,7 +320,7 @@ std::vector<size_t> MuxGraph::branch_sizes(const size_t& level) const {
       continue;
     }
 
-    size_t branch_size = node_in_edges_[node].size();
+    size_t branch_size = node_num_in_edges_[node];
 
     /* make sure the branch size is valid */
     VTR_ASSERT_SAFE(valid_mux_implementation_num_inputs(branch_size));
@@ -366,10 +370,9 @@ MuxGraph MuxGraph::subgraph(const MuxNodeId& root_node) const {
 
   /* Add input nodes and edges to subgraph */
   size_t input_cnt = 0;
-  for (auto edge_origin : this->node_in_edges_[root_node]) {
-    VTR_ASSERT_SAFE(1 == edge_src_nodes_[edge_origin].size());
+  for (auto edge_origin : this->node_in_edge_range(root_node)) {
     /* Add nodes */
-    MuxNodeId from_node_origin = this->edge_src_nodes_[edge_origin][0];
+    MuxNodeId from_node_origin = this->edge_src_nodes_[edge_origin];
     MuxNodeId from_node_subgraph = mux_graph.add_node(MUX_INPUT_NODE);
     /* Configure the nodes */
     mux_graph.node_levels_[from_node_subgraph] = 0;
@@ -392,7 +395,7 @@ MuxGraph MuxGraph::subgraph(const MuxNodeId& root_node) const {
   std::map<MuxMemId, MuxMemId> mem2mem_map;
 
   /* Add memory bits and configure edges */
-  for (auto edge_origin : this->node_in_edges_[root_node]) {
+  for (auto edge_origin : this->node_in_edge_range(root_node)) {
     MuxMemId mem_origin = this->edge_mem_ids_[edge_origin];
     /* Try to find if the mem is already in the list */
     std::map<MuxMemId, MuxMemId>::iterator it = mem2mem_map.find(mem_origin);
@@ -441,7 +444,7 @@ std::vector<MuxGraph> MuxGraph::build_mux_branch_graphs() const {
       continue;
     }
 
-    size_t branch_size = node_in_edges_[node].size();
+    size_t branch_size = node_num_in_edges_[node];
 
     /* make sure the branch size is valid */
     VTR_ASSERT_SAFE(valid_mux_implementation_num_inputs(branch_size));
@@ -592,8 +595,8 @@ vtr::vector<MuxMemId, bool> MuxGraph::decode_memory_bits(
      * If the node has not been visited,
      * then mark it visited and enqueue it
      */
-    VTR_ASSERT_SAFE(1 == node_out_edges_[node_to_expand].size());
-    MuxEdgeId edge = node_out_edges_[node_to_expand][0];
+    MuxEdgeId edge = node_out_edges_[node_to_expand];
+    VTR_ASSERT_SAFE(MuxEdgeId::INVALID() != edge);
 
     /* Configure the mem bits:
      * if inv_mem is enabled, it means 0 to enable this edge
@@ -607,11 +610,8 @@ vtr::vector<MuxMemId, bool> MuxGraph::decode_memory_bits(
       mem_bits[mem] = true;
     }
 
-    /* each edge must have 1 fan-out */
-    VTR_ASSERT_SAFE(1 == edge_sink_nodes_[edge].size());
-
-    /* Get the fan-out node */
-    MuxNodeId next_node = edge_sink_nodes_[edge][0];
+    /* Get the fan-out node, each edge has 1 fan-out */
+    MuxNodeId next_node = edge_sink_nodes_[edge];
 
     /* If next node is the output node we want, we can finish here */
     if (next_node == node_id(output_id)) {
@@ -670,7 +670,7 @@ MuxInputId MuxGraph::find_input_node_driven_by_output_node(
      * then mark it visited and enqueue it
      */
     MuxEdgeId next_edge = MuxEdgeId::INVALID();
-    for (const MuxEdgeId& edge : node_in_edges_[node_to_expand]) {
+    for (const MuxEdgeId& edge : node_in_edge_range(node_to_expand)) {
       /* Configure the mem bits and find the edge that will propagate the signal
        * if inv_mem is enabled, it means false to enable this edge
        * otherwise, it is true to enable this edge
@@ -685,11 +685,8 @@ MuxInputId MuxGraph::find_input_node_driven_by_output_node(
     /* We must have a valid next edge */
     VTR_ASSERT(MuxEdgeId::INVALID() != next_edge);
 
-    /* each edge must have 1 fan-out */
-    VTR_ASSERT_SAFE(1 == edge_src_nodes_[next_edge].size());
-
-    /* Get the fan-in node */
-    MuxNodeId next_node = edge_src_nodes_[next_edge][0];
+    /* Get the fan-in node, each edge has 1 fan-in */
+    MuxNodeId next_node = edge_src_nodes_[next_edge];
 
     /* If next node is an input node, we can finish here */
     if (true == is_node_input(next_node)) {
@@ -710,6 +707,29 @@ MuxInputId MuxGraph::find_input_node_driven_by_output_node(
   return des_input_id;
 }
 
+MemoryUsage MuxGraph::memory_usage() const {
+  MemoryUsage usage = heap_memory_usage(node_ids_);
+  usage += heap_memory_usage(node_types_);
+  usage += heap_memory_usage(node_input_ids_);
+  usage += heap_memory_usage(node_output_ids_);
+  usage += heap_memory_usage(node_levels_);
+  usage += heap_memory_usage(node_ids_at_level_);
+  usage += heap_memory_usage(node_in_edge_offsets_);
+  usage += heap_memory_usage(node_num_in_edges_);
+  usage += heap_memory_usage(node_out_edges_);
+  usage += heap_memory_usage(edge_ids_);
+  usage += heap_memory_usage(edge_src_nodes_);
+  usage += heap_memory_usage(edge_sink_nodes_);
+  usage += heap_memory_usage(edge_models_);
+  usage += heap_memory_usage(edge_mem_ids_);
+  usage += heap_memory_usage(edge_inv_mem_);
+  usage += heap_memory_usage(mem_ids_);
+  usage += heap_memory_usage(mem_levels_);
+  usage += heap_memory_usage(node_lookup_);
+  usage += heap_memory_usage(mem_lookup_);
+  return usage;
+}
+
 /**************************************************
  * Private mutators: basic operations
  *************************************************/
@@ -724,8 +744,9 @@ MuxNodeId MuxGraph::add_node(const enum e_mux_graph_node_type& node_type) {
   node_output_ids_.push_back(MuxOutputId::INVALID());
   node_levels_.push_back(-1);
   node_ids_at_level_.push_back(-1);
-  node_in_edges_.emplace_back();
-  node_out_edges_.emplace_back();
+  node_in_edge_offsets_.push_back(0);
+  node_num_in_edges_.push_back(0);
+  node_out_edges_.push_back(MuxEdgeId::INVALID());
 
   return node;
 }
@@ -741,16 +762,23 @@ MuxEdgeId MuxGraph::add_edge(const MuxNodeId& from_node,
   edge_mem_ids_.push_back(MuxMemId::INVALID());
   edge_inv_mem_.push_back(false);
 
-  /* update the edge-node connections */
+  /* update the edge-node connections
+   * Each node drives at most 1 edge, and the incoming edges of a node
+   * are added consecutively, so that they are stored as a range of ids
+   */
   VTR_ASSERT(valid_node_id(from_node));
-  edge_src_nodes_.emplace_back();
-  edge_src_nodes_[edge].push_back(from_node);
-  node_out_edges_[from_node].push_back(edge);
+  VTR_ASSERT(MuxEdgeId::INVALID() == node_out_edges_[from_node]);
+  edge_src_nodes_.push_back(from_node);
+  node_out_edges_[from_node] = edge;
 
   VTR_ASSERT(valid_node_id(to_node));
-  edge_sink_nodes_.emplace_back();
-  edge_sink_nodes_[edge].push_back(to_node);
-  node_in_edges_[to_node].push_back(edge);
+  edge_sink_nodes_.push_back(to_node);
+  if (0 == node_num_in_edges_[to_node]) {
+    node_in_edge_offsets_[to_node] = size_t(edge);
+  }
+  VTR_ASSERT(node_in_edge_offsets_[to_node] + node_num_in_edges_[to_node] ==
+             size_t(edge));
+  node_num_in_edges_[to_node]++;
 
   return edge;
 }
@@ -1257,7 +1285,7 @@ bool MuxGraph::valid_mux_graph() const {
       continue;
     }
     /* other nodes should have 1 fan-out */
-    if (1 != node_out_edges_[node].size()) {
+    if (MuxEdgeId::INVALID() == node_out_edges_[node]) {
       return false;
     }
   }
@@ -1266,13 +1294,9 @@ bool MuxGraph::valid_mux_graph() const {
   for (const auto& node : nodes()) {
     if (MUX_INPUT_NODE == node_types_[node]) {
       MuxNodeId next_node = node;
-      while (0 < node_out_edges_[next_node].size()) {
-        MuxEdgeId edge = node_out_edges_[next_node][0];
-        /* each edge must have 1 fan-out */
-        if (1 != edge_sink_nodes_[edge].size()) {
-          return false;
-        }
-        next_node = edge_sink_nodes_[edge][0];
+      while (MuxEdgeId::INVALID() != node_out_edges_[next_node]) {
+        /* each edge has 1 fan-out */
+        next_node = edge_sink_nodes_[node_out_edges_[next_node]];
       }
       if (MUX_OUTPUT_NODE != node_types_[next_node]) {
         return false;
@@ -8,6 +8,7 @@
 
 #include "circuit_library.h"
 #include "mux_graph_fwd.h"
+#include "openfpga_memory_usage.h"
 #include "vtr_range.h"
 #include "vtr_vector.h"
 
@@ -147,6 +148,9 @@ class MuxGraph {
     const std::map<MuxMemId, bool>& memory_bits,
     const MuxOutputId& output_id) const;
 
+  /* Approximate heap memory used by the data structure */
+  MemoryUsage memory_usage() const;
+
  private: /* Private mutators : basic operations */
   /* Add a unconfigured node to the MuxGraph */
   MuxNodeId add_node(const enum e_mux_graph_node_type& node_type);
@@ -195,6 +199,10 @@ class MuxGraph {
   /* validate graph */
   bool valid_mux_graph() const;
 
+ private: /* Private accessors */
+  /* Find the input edges for a node without copying them */
+  edge_range node_in_edge_range(const MuxNodeId& node) const;
+
  private:                                      /* Internal data */
   vtr::vector<MuxNodeId, MuxNodeId> node_ids_; /* Unique ids for each node */
   vtr::vector<MuxNodeId, enum e_mux_graph_node_type>
@@ -207,16 +215,20 @@ class MuxGraph {
     node_levels_; /* at which level, each node belongs to */
   vtr::vector<MuxNodeId, size_t>
     node_ids_at_level_; /* the index at the level that each node belongs to */
-  vtr::vector<MuxNodeId, std::vector<MuxEdgeId>>
-    node_in_edges_; /* ids of incoming edges to each node */
-  vtr::vector<MuxNodeId, std::vector<MuxEdgeId>>
-    node_out_edges_; /* ids of outgoing edges from each node */
+  /* The incoming edges of each node have consecutive ids, which are
+   * stored as a range [offset, offset + num) */
+  vtr::vector<MuxNodeId, size_t>
+    node_in_edge_offsets_; /* id of the first incoming edge to each node */
+  vtr::vector<MuxNodeId, size_t>
+    node_num_in_edges_; /* number of incoming edges to each node */
+  vtr::vector<MuxNodeId, MuxEdgeId>
+    node_out_edges_; /* id of the outgoing edge from each node, if any */
 
   vtr::vector<MuxEdgeId, MuxEdgeId> edge_ids_; /* Unique ids for each edge */
-  vtr::vector<MuxEdgeId, std::vector<MuxNodeId>>
-    edge_src_nodes_; /* source nodes drive this edge */
-  vtr::vector<MuxEdgeId, std::vector<MuxNodeId>>
-    edge_sink_nodes_; /* sink nodes this edge drives */
+  vtr::vector<MuxEdgeId, MuxNodeId>
+    edge_src_nodes_; /* source node drives this edge */
+  vtr::vector<MuxEdgeId, MuxNodeId>
+    edge_sink_nodes_; /* sink node this edge drives */
   vtr::vector<MuxEdgeId, CircuitModelId>
     edge_models_; /* type of each edge: tgate/pass-gate */
   vtr::vector<MuxEdgeId, MuxMemId>
@@ -5,6 +5,8 @@
 
 #include "mux_library.h"
 
+#include <utility>
+
 #include "vtr_assert.h"
 
 /* begin namespace openfpga */
@@ -30,9 +32,10 @@ MuxId MuxLibrary::mux_graph(const CircuitModelId& circuit_model,
   /* Make sure we have a valid mux look-up */
   VTR_ASSERT_SAFE(valid_mux_lookup());
   /* Validate circuit model id and mux_size */
-  VTR_ASSERT_SAFE(valid_mux_size(circuit_model, mux_size));
+  VTR_ASSERT(valid_mux_size(circuit_model, mux_size));
 
-  return mux_lookup_[circuit_model][mux_size];
+  /* Use a read-only access, as the graph may be inquired by multiple threads */
+  return mux_lookup_[size_t(circuit_model)][mux_size];
 }
 
 const MuxGraph& MuxLibrary::mux_graph(const MuxId& mux_id) const {
@@ -56,6 +59,46 @@ size_t MuxLibrary::max_mux_size() const {
   return max_mux_size;
 }
 
+/* Append the memory bits which route a given input to the output of a mux.
+ * The bits are taken from the decode table when it is built, or decoded on
+ * the mux graph otherwise */
+void MuxLibrary::append_mux_memory_bits(const MuxId& mux_id,
+                                        const MuxInputId& input_id,
+                                        std::vector<bool>& mem_bits) const {
+  VTR_ASSERT_SAFE(valid_mux_id(mux_id));
+  const MuxGraph& mux_graph = mux_graphs_[mux_id];
+
+  if (true == mux_decode_tables_[mux_id].empty()) {
+    VTR_ASSERT(1 == mux_graph.num_outputs());
+    for (const bool& bit : mux_graph.decode_memory_bits(
+           input_id, mux_graph.output_id(mux_graph.outputs()[0]))) {
+      mem_bits.push_back(bit);
+    }
+    return;
+  }
+
+  VTR_ASSERT(size_t(input_id) < mux_decode_tables_[mux_id].size());
+  const std::vector<uint64_t>& words =
+    mux_decode_tables_[mux_id][size_t(input_id)];
+  size_t num_mems = mux_graph.num_memory_bits();
+  mem_bits.reserve(mem_bits.size() + num_mems);
+  for (size_t imem = 0; imem < num_mems; ++imem) {
+    mem_bits.push_back(0 != ((words[imem / 64] >> (imem % 64)) & 1));
+  }
+}
+
+MemoryUsage MuxLibrary::memory_usage() const {
+  MemoryUsage usage = heap_memory_usage(mux_graphs_);
+  usage += heap_memory_usage(mux_ids_);
+  usage += heap_memory_usage(mux_circuit_models_);
+  usage += heap_memory_usage(mux_decode_tables_);
+  usage += heap_memory_usage(mux_lookup_);
+  for (const MuxGraph& mux_graph : mux_graphs_) {
+    usage += mux_graph.memory_usage();
+  }
+  return usage;
+}
+
 /**************************************************
  * Private mutators:
  *************************************************/
@@ -68,17 +111,69 @@ void MuxLibrary::add_mux(const CircuitLibrary& circuit_lib,
     return;
   }
 
+  /* Add a mux graph */
+  add_mux(circuit_model, mux_size,
+          MuxGraph(circuit_lib, circuit_model, mux_size));
+}
+
+/* Add a mux to the library, whose graph is built by the caller, e.g., when
+ * graphs are built in parallel */
+void MuxLibrary::add_mux(const CircuitModelId& circuit_model,
+                         const size_t& mux_size, MuxGraph&& mux_graph) {
+  /* First, check if there is already an existing graph */
+  if (valid_mux_size(circuit_model, mux_size)) {
+    return;
+  }
+
   /* create a new id for the mux */
   MuxId mux = MuxId(mux_ids_.size());
   /* Push to the node list */
   mux_ids_.push_back(mux);
-  /* Add a mux graph */
-  mux_graphs_.push_back(MuxGraph(circuit_lib, circuit_model, mux_size));
+  mux_graphs_.push_back(std::move(mux_graph));
   /* Recorde mux cirucit model id */
   mux_circuit_models_.push_back(circuit_model);
+  /* The decode table is built on request */
+  mux_decode_tables_.emplace_back();
+
+  /* update mux_lookup, which is dense on circuit models and mux sizes */
+  if (size_t(circuit_model) >= mux_lookup_.size()) {
+    mux_lookup_.resize(size_t(circuit_model) + 1);
+  }
+  std::vector<MuxId>& size_lookup = mux_lookup_[size_t(circuit_model)];
+  if (mux_size >= size_lookup.size()) {
+    size_lookup.resize(mux_size + 1, MuxId::INVALID());
+  }
+  size_lookup[mux_size] = mux;
+}
 
-  /* update mux_lookup*/
-  mux_lookup_[circuit_model][mux_size] = mux;
+/* Decode the memory bits of each input of a mux to its output, and pack
+ * them into words. Only the decode table of the given mux is modified */
+void MuxLibrary::build_mux_decode_table(const MuxId& mux_id) {
+  VTR_ASSERT(valid_mux_id(mux_id));
+  const MuxGraph& mux_graph = mux_graphs_[mux_id];
+  std::vector<std::vector<uint64_t>>& decode_table =
+    mux_decode_tables_[mux_id];
+  decode_table.clear();
+
+  /* Only muxes with a single output are configured by a path */
+  if (1 != mux_graph.num_outputs()) {
+    return;
+  }
+  MuxOutputId output_id = mux_graph.output_id(mux_graph.outputs()[0]);
+
+  size_t num_words = (mux_graph.num_memory_bits() + 63) / 64;
+  decode_table.resize(mux_graph.num_inputs(),
+                      std::vector<uint64_t>(num_words, 0));
+  for (size_t input = 0; input < mux_graph.num_inputs(); ++input) {
+    vtr::vector<MuxMemId, bool> mem_bits =
+      mux_graph.decode_memory_bits(MuxInputId(input), output_id);
+    for (const MuxMemId& mem : mux_graph.memories()) {
+      if (true == mem_bits[mem]) {
+        decode_table[input][size_t(mem) / 64] |= uint64_t(1)
+                                                 << (size_t(mem) % 64);
+      }
+    }
+  }
 }
 
 /**************************************************
@@ -88,12 +183,15 @@ bool MuxLibrary::valid_mux_id(const MuxId& mux) const {
   return size_t(mux) < mux_ids_.size() && mux_ids_[mux] == mux;
 }
 
-bool MuxLibrary::valid_mux_lookup() const { return mux_lookup_.empty(); }
+/* The lookup is valid when it covers the muxes of the library */
+bool MuxLibrary::valid_mux_lookup() const {
+  return mux_ids_.empty() || !mux_lookup_.empty();
+}
 
 bool MuxLibrary::valid_mux_circuit_model_id(
   const CircuitModelId& circuit_model) const {
-  MuxLookup::iterator it = mux_lookup_.find(circuit_model);
-  return (it != mux_lookup_.end());
+  return size_t(circuit_model) < mux_lookup_.size() &&
+         !mux_lookup_[size_t(circuit_model)].empty();
 }
 
 bool MuxLibrary::valid_mux_size(const CircuitModelId& circuit_model,
@@ -101,9 +199,9 @@ bool MuxLibrary::valid_mux_size(const CircuitModelId& circuit_model,
   if (false == valid_mux_circuit_model_id(circuit_model)) {
     return false;
   }
-  std::map<size_t, MuxId>::iterator it =
-    mux_lookup_[circuit_model].find(mux_size);
-  return (it != mux_lookup_[circuit_model].end());
+  const std::vector<MuxId>& size_lookup = mux_lookup_[size_t(circuit_model)];
+  return mux_size < size_lookup.size() &&
+         MuxId::INVALID() != size_lookup[mux_size];
 }
 
 /**************************************************
@@ -10,10 +10,12 @@
 #ifndef MUX_LIBRARY_H
 #define MUX_LIBRARY_H
 
-#include <map>
+#include <cstdint>
+#include <vector>
 
 #include "mux_graph.h"
 #include "mux_library_fwd.h"
+#include "openfpga_memory_usage.h"
 
 /* begin namespace openfpga */
 namespace openfpga {
@@ -36,11 +38,24 @@ class MuxLibrary {
   CircuitModelId mux_circuit_model(const MuxId& mux_id) const;
   /* Find the mux sizes */
   size_t max_mux_size() const;
+  /* Append the memory bits which route a given input of a mux to its
+   * output, in the order of memories of the mux graph */
+  void append_mux_memory_bits(const MuxId& mux_id, const MuxInputId& input_id,
+                              std::vector<bool>& mem_bits) const;
+
+  /* Approximate heap memory used by the data structure */
+  MemoryUsage memory_usage() const;
 
  public: /* Public mutators */
   /* Add a mux to the library */
   void add_mux(const CircuitLibrary& circuit_lib,
                const CircuitModelId& circuit_model, const size_t& mux_size);
+  /* Add a mux whose graph has been built already */
+  void add_mux(const CircuitModelId& circuit_model, const size_t& mux_size,
+               MuxGraph&& mux_graph);
+  /* Decode the memory bits of each input of a mux in advance.
+   * Decode tables of different muxes can be built by multiple threads */
+  void build_mux_decode_table(const MuxId& mux_id);
 
  public: /* Public validators */
   bool valid_mux_id(const MuxId& mux) const;
@@ -63,15 +78,20 @@ class MuxLibrary {
     mux_graphs_; /* Graphs describing MUX internal structures */
   vtr::vector<MuxId, CircuitModelId>
     mux_circuit_models_; /* circuit model id in circuit library */
+  /* Memory bits routing each input to the only output of a mux, packed in
+   * 64-bit words: [mux][input][word]. Empty when not built, e.g., for muxes
+   * with multiple outputs */
+  vtr::vector<MuxId, std::vector<std::vector<uint64_t>>> mux_decode_tables_;
 
   /* Local encoder description */
   // vtr::vector<MuxLocalDecoderId, Decoder> mux_local_encoders_; /* Graphs
   // describing MUX internal structures */
 
   /* a fast look-up to search mux_graphs with given circuit model and mux size
+   * [circuit_model][mux_size], where MuxId::INVALID() denotes no mux
    */
-  typedef std::map<CircuitModelId, std::map<size_t, MuxId>> MuxLookup;
-  mutable MuxLookup mux_lookup_;
+  typedef std::vector<std::vector<MuxId>> MuxLookup;
+  MuxLookup mux_lookup_;
 };
 
 } /* end namespace openfpga */
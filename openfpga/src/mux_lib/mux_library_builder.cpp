@@ -2,6 +2,10 @@
  * This file includes the functions of builders for MuxLibrary.
  *******************************************************************/
 #include <cmath>
+#include <memory>
+#include <set>
+#include <utility>
+#include <vector>
 
 /* Headers from vtrutil library */
 #include "vtr_assert.h"
@@ -15,6 +19,7 @@
 #include "mux_library.h"
 #include "mux_library_builder.h"
 #include "mux_utils.h"
+#include "openfpga_parallel.h"
 #include "openfpga_rr_graph_utils.h"
 #include "pb_graph_utils.h"
 #include "pb_type_utils.h"
@@ -22,13 +27,35 @@
 /* Begin namespace openfpga */
 namespace openfpga {
 
+/********************************************************************
+ * The unique multiplexers required by the device, i.e., pairs of
+ * circuit model and size, in the order they are found. The graphs are
+ * built only after all the requests are collected
+ *******************************************************************/
+struct MuxLibraryRequests {
+  std::vector<std::pair<CircuitModelId, size_t>> muxes;
+  std::set<std::pair<CircuitModelId, size_t>> mux_lookup;
+};
+
+/********************************************************************
+ * Request a multiplexer, unless it has been requested already
+ *******************************************************************/
+static void add_mux_library_request(MuxLibraryRequests& mux_requests,
+                                    const CircuitModelId& circuit_model,
+                                    const size_t& mux_size) {
+  std::pair<CircuitModelId, size_t> mux(circuit_model, mux_size);
+  if (true == mux_requests.mux_lookup.insert(mux).second) {
+    mux_requests.muxes.push_back(mux);
+  }
+}
+
 /********************************************************************
  * Update MuxLibrary with the unique multiplexer structures
  * found in the global routing architecture
  *******************************************************************/
 static void build_routing_arch_mux_library(
-  const RRGraphView& rr_graph, const CircuitLibrary& circuit_lib,
-  const VprDeviceAnnotation& vpr_device_annotation, MuxLibrary& mux_lib) {
+  const RRGraphView& rr_graph, const VprDeviceAnnotation& vpr_device_annotation,
+  MuxLibraryRequests& mux_requests) {
   /* The routing path is.
    * OPIN ----> CHAN ----> ... ----> CHAN ----> IPIN
    * Each edge is a switch, for IPIN, the switch is a connection block,
@@ -65,8 +92,8 @@ static void build_routing_arch_mux_library(
 
         VTR_ASSERT(CircuitModelId::INVALID() != rr_switch_circuit_model);
         /* Add the mux to mux_library */
-        mux_lib.add_mux(circuit_lib, rr_switch_circuit_model,
-                        rr_graph.node_in_edges(node).size());
+        add_mux_library_request(mux_requests, rr_switch_circuit_model,
+                                rr_graph.node_in_edges(node).size());
         break;
       }
       default:
@@ -84,8 +111,8 @@ static void build_routing_arch_mux_library(
  ********************************************************************/
 static void build_pb_graph_pin_interconnect_mux_library(
   t_pb_graph_pin* pb_graph_pin, t_mode* interconnect_mode,
-  const CircuitLibrary& circuit_lib,
-  const VprDeviceAnnotation& vpr_device_annotation, MuxLibrary& mux_lib) {
+  const VprDeviceAnnotation& vpr_device_annotation,
+  MuxLibraryRequests& mux_requests) {
   /* Find the interconnect in the physical mode that drives this pin */
   t_interconnect* physical_interc =
     pb_graph_pin_interc(pb_graph_pin, interconnect_mode);
@@ -100,7 +127,7 @@ static void build_pb_graph_pin_interconnect_mux_library(
     vpr_device_annotation.interconnect_circuit_model(physical_interc);
   VTR_ASSERT(CircuitModelId::INVALID() != interc_circuit_model);
   /* Add the mux model to library */
-  mux_lib.add_mux(circuit_lib, interc_circuit_model, mux_size);
+  add_mux_library_request(mux_requests, interc_circuit_model, mux_size);
 }
 
 /********************************************************************
@@ -108,8 +135,9 @@ static void build_pb_graph_pin_interconnect_mux_library(
  * found in programmable logic blocks
  ********************************************************************/
 static void rec_build_vpr_physical_pb_graph_node_mux_library(
-  t_pb_graph_node* pb_graph_node, const CircuitLibrary& circuit_lib,
-  const VprDeviceAnnotation& vpr_device_annotation, MuxLibrary& mux_lib) {
+  t_pb_graph_node* pb_graph_node,
+  const VprDeviceAnnotation& vpr_device_annotation,
+  MuxLibraryRequests& mux_requests) {
   /* Find the number of inputs for each interconnect of this pb_graph_node
    * This is only applicable to each interconnect which will be implemented with
    * multiplexers
@@ -125,7 +153,7 @@ static void rec_build_vpr_physical_pb_graph_node_mux_library(
     for (int ipin = 0; ipin < pb_graph_node->num_input_pins[iport]; ++ipin) {
       build_pb_graph_pin_interconnect_mux_library(
         &(pb_graph_node->input_pins[iport][ipin]), parent_physical_mode,
-        circuit_lib, vpr_device_annotation, mux_lib);
+        vpr_device_annotation, mux_requests);
     }
   }
 
@@ -133,7 +161,7 @@ static void rec_build_vpr_physical_pb_graph_node_mux_library(
     for (int ipin = 0; ipin < pb_graph_node->num_clock_pins[iport]; ++ipin) {
       build_pb_graph_pin_interconnect_mux_library(
         &(pb_graph_node->clock_pins[iport][ipin]), parent_physical_mode,
-        circuit_lib, vpr_device_annotation, mux_lib);
+        vpr_device_annotation, mux_requests);
     }
   }
 
@@ -152,8 +180,8 @@ static void rec_build_vpr_physical_pb_graph_node_mux_library(
   for (int iport = 0; iport < pb_graph_node->num_output_ports; ++iport) {
     for (int ipin = 0; ipin < pb_graph_node->num_output_pins[iport]; ++ipin) {
       build_pb_graph_pin_interconnect_mux_library(
-        &(pb_graph_node->output_pins[iport][ipin]), physical_mode, circuit_lib,
-        vpr_device_annotation, mux_lib);
+        &(pb_graph_node->output_pins[iport][ipin]), physical_mode,
+        vpr_device_annotation, mux_requests);
     }
   }
 
@@ -163,7 +191,7 @@ static void rec_build_vpr_physical_pb_graph_node_mux_library(
          ++jpb) {
       rec_build_vpr_physical_pb_graph_node_mux_library(
         &(pb_graph_node->child_pb_graph_nodes[physical_mode->index][ipb][jpb]),
-        circuit_lib, vpr_device_annotation, mux_lib);
+        vpr_device_annotation, mux_requests);
     }
   }
 }
@@ -172,7 +200,7 @@ static void rec_build_vpr_physical_pb_graph_node_mux_library(
  * Update MuxLibrary with the unique multiplexers required by
  * LUTs in the circuit library
  ********************************************************************/
-static void build_lut_mux_library(MuxLibrary& mux_lib,
+static void build_lut_mux_library(MuxLibraryRequests& mux_requests,
                                   const CircuitLibrary& circuit_lib) {
   /* Find all the circuit models which are LUTs in the circuit library */
   for (const auto& circuit_model : circuit_lib.models()) {
@@ -189,7 +217,7 @@ static void build_lut_mux_library(MuxLibrary& mux_lib,
     size_t lut_mux_size =
       (size_t)pow(2., (double)(circuit_lib.port_size(input_ports[0])));
     /* Add mux to the mux library */
-    mux_lib.add_mux(circuit_lib, circuit_model, lut_mux_size);
+    add_mux_library_request(mux_requests, circuit_model, lut_mux_size);
   }
 }
 
@@ -201,17 +229,20 @@ static void build_lut_mux_library(MuxLibrary& mux_lib,
  * list, as a return value
  */
 MuxLibrary build_device_mux_library(const DeviceContext& vpr_device_ctx,
-                                    const OpenfpgaContext& openfpga_ctx) {
+                                    const OpenfpgaContext& openfpga_ctx,
+                                    const size_t& num_threads) {
   vtr::ScopedStartFinishTimer timer("Build a library of physical multiplexers");
 
-  /* MuxLibrary to store the information of Multiplexers*/
-  MuxLibrary mux_lib;
+  const CircuitLibrary& circuit_lib = openfpga_ctx.arch().circuit_lib;
+
+  /* Unique multiplexers to be stored in the MuxLibrary */
+  MuxLibraryRequests mux_requests;
 
   /* Step 1: We should check the multiplexer spice models defined in routing
    * architecture.*/
   build_routing_arch_mux_library(vpr_device_ctx.rr_graph,
-                                 openfpga_ctx.arch().circuit_lib,
-                                 openfpga_ctx.vpr_device_annotation(), mux_lib);
+                                 openfpga_ctx.vpr_device_annotation(),
+                                 mux_requests);
 
   /* Step 2: Count the sizes of multiplexers in complex logic blocks */
   for (const t_logical_block_type& lb_type :
@@ -221,21 +252,43 @@ MuxLibrary build_device_mux_library(const DeviceContext& vpr_device_ctx,
       continue;
     }
     rec_build_vpr_physical_pb_graph_node_mux_library(
-      lb_type.pb_graph_head, openfpga_ctx.arch().circuit_lib,
-      openfpga_ctx.vpr_device_annotation(), mux_lib);
+      lb_type.pb_graph_head, openfpga_ctx.vpr_device_annotation(),
+      mux_requests);
   }
 
   /* Step 3: count the size of multiplexer that will be used in LUTs*/
-  build_lut_mux_library(mux_lib, openfpga_ctx.arch().circuit_lib);
+  build_lut_mux_library(mux_requests, circuit_lib);
+
+  /* Step 4: Build the graphs of the multiplexers, which are independent
+   * from each other. They are added to the library in the order of
+   * requests, so that the library is the same regardless of the number of
+   * threads */
+  std::vector<std::unique_ptr<MuxGraph>> mux_graphs(mux_requests.muxes.size());
+  parallel_for(mux_graphs.size(), num_threads, [&](const size_t& imux) {
+    mux_graphs[imux] = std::make_unique<MuxGraph>(
+      circuit_lib, mux_requests.muxes[imux].first,
+      mux_requests.muxes[imux].second);
+  });
+
+  MuxLibrary mux_lib;
+  for (size_t imux = 0; imux < mux_graphs.size(); ++imux) {
+    mux_lib.add_mux(mux_requests.muxes[imux].first,
+                    mux_requests.muxes[imux].second,
+                    std::move(*mux_graphs[imux]));
+  }
+
+  /* Step 5: Decode the memory bits of each input in advance, so that the
+   * bitstream of a mux is a lookup in its decode table */
+  parallel_for(mux_graphs.size(), num_threads, [&](const size_t& imux) {
+    mux_lib.build_mux_decode_table(MuxId(imux));
+  });
 
   VTR_LOG("Built a multiplexer library of %lu physical multiplexers.\n",
           mux_lib.muxes().size());
   VTR_LOG("Maximum multiplexer size is %lu.\n", mux_lib.max_mux_size());
   for (auto mux_id : mux_lib.muxes()) {
     VTR_LOG("\tmodel '%s', input_size='%lu'\n",
-            openfpga_ctx.arch()
-              .circuit_lib.model_name(mux_lib.mux_circuit_model(mux_id))
-              .c_str(),
+            circuit_lib.model_name(mux_lib.mux_circuit_model(mux_id)).c_str(),
             mux_lib.mux_graph(mux_id).num_inputs());
   }
 
@@ -425,7 +425,7 @@ void build_physical_lb_rr_graphs(const DeviceContext& device_ctx,
              "Building routing resource graph for logical tile '%s'...",
              lb_type.pb_graph_head->pb_type->name);
 
-    const LbRRGraph& lb_rr_graph = build_lb_type_physical_lb_rr_graph(
+    LbRRGraph lb_rr_graph = build_lb_type_physical_lb_rr_graph(
       lb_type.pb_graph_head,
       const_cast<const VprDeviceAnnotation&>(device_annotation), verbose);
     /* Check the rr_graph */
@@ -437,6 +437,9 @@ void build_physical_lb_rr_graphs(const DeviceContext& device_ctx,
     }
     VTR_LOGV(verbose, "Check routing resource graph for logical tile passed\n");
 
+    /* Compress the edges for the router, as the graph will not change */
+    lb_rr_graph.freeze();
+
     device_annotation.add_physical_lb_rr_graph(lb_type.pb_graph_head,
                                                lb_rr_graph);
   }
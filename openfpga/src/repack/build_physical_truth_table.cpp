@@ -8,6 +8,7 @@
 
 #include "lut_utils.h"
 #include "openfpga_naming.h"
+#include "openfpga_parallel.h"
 #include "pb_type_utils.h"
 #include "physical_pb.h"
 #include "vtr_assert.h"
@@ -186,7 +187,8 @@ static void build_physical_pb_lut_truth_tables(
       const AtomNetlist::TruthTable& frac_lut_tt =
         adapt_truth_table_for_frac_lut(lut_frac_level, lut_output_mask,
                                        adapt_tt);
-      physical_pb.set_truth_table(lut_pb_id, output_pin, frac_lut_tt);
+      physical_pb.set_truth_table(lut_pb_id, output_pin,
+                                  build_lut_truth_table_mask(frac_lut_tt));
 
       /* Print debug information */
       VTR_LOGV(verbose, "Input nets: ");
@@ -226,16 +228,23 @@ static void build_physical_pb_lut_truth_tables(
  * Note that the truth table built here is different from the atom
  * netlists in VPR context. We consider fracturable LUT features
  * and LUTs operating as wires
+ * Clustered blocks are independent from each other, and can be processed by
+ * multiple threads. Logs are only shown when 1 thread is used
  ***************************************************************************************/
 void build_physical_lut_truth_tables(
   VprClusteringAnnotation& cluster_annotation, const AtomContext& atom_ctx,
   const ClusteringContext& cluster_ctx,
   const VprDeviceAnnotation& device_annotation,
-  const CircuitLibrary& circuit_lib, const bool& verbose) {
+  const CircuitLibrary& circuit_lib, const size_t& num_threads,
+  const bool& verbose) {
   vtr::ScopedStartFinishTimer timer("Build truth tables for physical LUTs");
 
-  for (auto blk_id : cluster_ctx.clb_nlist.blocks()) {
-    PhysicalPb& physical_pb = cluster_annotation.mutable_physical_pb(blk_id);
+  std::vector<ClusterBlockId> blocks(cluster_ctx.clb_nlist.blocks().begin(),
+                                     cluster_ctx.clb_nlist.blocks().end());
+  bool thread_verbose = verbose && (1 == find_num_threads(num_threads));
+  parallel_for(blocks.size(), num_threads, [&](const size_t& iblk) {
+    PhysicalPb& physical_pb =
+      cluster_annotation.mutable_physical_pb(blocks[iblk]);
     /* Find the LUT physical pb id */
     for (const PhysicalPbId& primitive_pb : physical_pb.primitive_pbs()) {
       CircuitModelId circuit_model = device_annotation.pb_type_circuit_model(
@@ -249,9 +258,9 @@ void build_physical_lut_truth_tables(
        * mapped to the LUT */
       build_physical_pb_lut_truth_tables(physical_pb, primitive_pb, atom_ctx,
                                          device_annotation, circuit_lib,
-                                         verbose);
+                                         thread_verbose);
     }
-  }
+  });
 }
 
 } /* end namespace openfpga */
@@ -3,6 +3,10 @@
  ******************************************************************************/
 #include "lb_router.h"
 
+#include <algorithm>
+#include <limits>
+#include <queue>
+
 #include "lb_rr_graph_utils.h"
 #include "pb_type_graph.h"
 #include "pb_type_utils.h"
@@ -21,6 +25,8 @@ LbRouter::LbRouter(const LbRRGraph& lb_rr_graph,
                    t_logical_block_type_ptr lb_type) {
   routing_status_.resize(lb_rr_graph.nodes().size());
   explored_node_tb_.resize(lb_rr_graph.nodes().size());
+  explored_node_dirty_.resize(lb_rr_graph.nodes().size(), false);
+  routing_status_node_dirty_.resize(lb_rr_graph.nodes().size(), false);
   explore_id_index_ = 1;
 
   lb_type_ = lb_type;
@@ -30,6 +36,20 @@ LbRouter::LbRouter(const LbRRGraph& lb_rr_graph,
   params_.pres_fac = 1;
   params_.pres_fac_mult = 2;
   params_.hist_fac = 0.3;
+  params_.use_lookahead = false;
+  params_.max_stagnant_iterations = 0;
+
+  /* The cost of an edge is scaled by a fanout factor which is at least 0.85,
+   * while congestion and historical usage only increase the cost */
+  min_hop_cost_ = std::numeric_limits<float>::max();
+  for (const LbRREdgeId& edge : lb_rr_graph.edges()) {
+    min_hop_cost_ =
+      std::min(min_hop_cost_, lb_rr_graph.edge_intrinsic_cost(edge) +
+                                lb_rr_graph.node_intrinsic_cost(
+                                  lb_rr_graph.edge_sink_node(edge)));
+  }
+  min_hop_cost_ = 0.85 * std::max(min_hop_cost_, float(0.));
+  curr_sink_hop_distances_ = nullptr;
 
   is_routed_ = false;
 
@@ -84,27 +104,92 @@ std::vector<LbRRNodeId> LbRouter::net_routed_nodes(const NetId& net) const {
   return routed_nodes;
 }
 
+std::vector<size_t> LbRouter::net_terminal_key() const {
+  std::vector<size_t> key;
+  for (const NetId& net : lb_net_ids_) {
+    key.push_back(lb_net_sources_[net].size());
+    for (const LbRRNodeId& node : lb_net_sources_[net]) {
+      key.push_back(size_t(node));
+    }
+    key.push_back(lb_net_sinks_[net].size());
+    for (const LbRRNodeId& node : lb_net_sinks_[net]) {
+      key.push_back(size_t(node));
+    }
+  }
+  return key;
+}
+
+LbRouter::t_route_result LbRouter::route_result() const {
+  VTR_ASSERT(true == is_routed());
+
+  t_route_result result;
+  result.net_rt_trees.resize(lb_net_ids_.size());
+  for (const NetId& net : lb_net_ids_) {
+    for (const t_trace* rt_tree : lb_net_rt_trees_[net]) {
+      if (nullptr == rt_tree) {
+        t_trace empty_tree;
+        empty_tree.current_node = LbRRNodeId::INVALID();
+        result.net_rt_trees[net].push_back(empty_tree);
+      } else {
+        result.net_rt_trees[net].push_back(*rt_tree);
+      }
+    }
+  }
+  return result;
+}
+
 /**************************************************
  * Private accessors
  *************************************************/
+float LbRouter::node_lookahead_cost(const LbRRNodeId& node) const {
+  if (nullptr == curr_sink_hop_distances_) {
+    return 0.;
+  }
+  int num_hops = (*curr_sink_hop_distances_)[node];
+  /* Nodes which can not reach the sink are left to the cost-ordered
+   * expansion */
+  if (OPEN == num_hops) {
+    return 0.;
+  }
+  return num_hops * min_hop_cost_;
+}
+
 bool LbRouter::is_route_success(const LbRRGraph& lb_rr_graph) const {
   /* Validate if the rr_graph is the one we used to initialize the router */
   VTR_ASSERT(true == matched_lb_rr_graph(lb_rr_graph));
 
-  for (const LbRRNodeId& inode : lb_rr_graph.nodes()) {
-    if (routing_status_[inode].occ > lb_rr_graph.node_capacity(inode)) {
-      VTR_LOGV(lb_rr_graph.node_pb_graph_pin(inode),
-               "Route failed due to overuse pin '%s': occupancy '%ld' > "
-               "capacity '%ld'!\n",
-               lb_rr_graph.node_pb_graph_pin(inode)->to_string().c_str(),
-               routing_status_[inode].occ, lb_rr_graph.node_capacity(inode));
-      return false;
+  /* Only the nodes modified since the last reset can be overused. The first
+   * overused node of the graph is reported */
+  LbRRNodeId overused_node = LbRRNodeId::INVALID();
+  for (const LbRRNodeId& inode : dirty_routing_status_nodes_) {
+    if ((routing_status_[inode].occ > lb_rr_graph.node_capacity(inode)) &&
+        ((LbRRNodeId::INVALID() == overused_node) || (inode < overused_node))) {
+      overused_node = inode;
     }
   }
+  if (LbRRNodeId::INVALID() != overused_node) {
+    VTR_LOGV(lb_rr_graph.node_pb_graph_pin(overused_node),
+             "Route failed due to overuse pin '%s': occupancy '%ld' > "
+             "capacity '%ld'!\n",
+             lb_rr_graph.node_pb_graph_pin(overused_node)->to_string().c_str(),
+             routing_status_[overused_node].occ,
+             lb_rr_graph.node_capacity(overused_node));
+    return false;
+  }
 
   return true;
 }
 
+size_t LbRouter::count_overused_nodes(const LbRRGraph& lb_rr_graph) const {
+  size_t num_overused_nodes = 0;
+  for (const LbRRNodeId& inode : dirty_routing_status_nodes_) {
+    if (routing_status_[inode].occ > lb_rr_graph.node_capacity(inode)) {
+      num_overused_nodes++;
+    }
+  }
+  return num_overused_nodes;
+}
+
 LbRouter::t_trace* LbRouter::find_node_in_rt(t_trace* rt,
                                              const LbRRNodeId& rt_index) {
   t_trace* cur;
@@ -219,6 +304,15 @@ void LbRouter::set_physical_pb_modes(
   }
 }
 
+void LbRouter::set_lookahead(const bool& enabled) {
+  params_.use_lookahead = enabled;
+}
+
+void LbRouter::set_max_stagnant_iterations(const int& num_iterations) {
+  VTR_ASSERT(0 <= num_iterations);
+  params_.max_stagnant_iterations = num_iterations;
+}
+
 bool LbRouter::try_route_net(
   const LbRRGraph& lb_rr_graph, const AtomNetlist& atom_nlist,
   const NetId& net_idx, t_expansion_node& exp_node,
@@ -259,6 +353,7 @@ bool LbRouter::try_route_net(
       }
 
       pq_.clear();
+      select_lookahead_sink(lb_rr_graph, lb_net_sinks_[net_idx][isink]);
 
       /* Get lowest cost next node, repeat until a path is found or if it is
        * impossible to route */
@@ -327,21 +422,17 @@ bool LbRouter::try_route_net(
       if (true == sink_routed[isink]) {
         explore_id_index_++;
         if (explore_id_index_ > 2000000000) {
-          /* overflow protection */
-          for (const LbRRNodeId& id : lb_rr_graph.nodes()) {
+          /* overflow protection: only the modified nodes may carry ids */
+          for (const LbRRNodeId& id : dirty_explored_nodes_) {
             explored_node_tb_[id].explored_id = OPEN;
             explored_node_tb_[id].enqueue_id = OPEN;
-            explore_id_index_ = 1;
           }
+          explore_id_index_ = 1;
         }
       } else {
         /* Route failed, reset the explore id index */
         reset_explored_node_tb();
-        for (const LbRRNodeId& id : lb_rr_graph.nodes()) {
-          explored_node_tb_[id].explored_id = OPEN;
-          explored_node_tb_[id].enqueue_id = OPEN;
-          explore_id_index_ = 1;
-        }
+        explore_id_index_ = 1;
       }
     }
 
@@ -421,8 +512,14 @@ bool LbRouter::try_route(const LbRRGraph& lb_rr_graph,
    * Cap the total number of iterations tried so that if a solution does not
    * exist, then the router won't run indefinitely */
   pres_con_fac_ = params_.pres_fac;
-  for (int iter = 0;
-       iter < params_.max_iterations && !is_routed_ && !is_impossible; iter++) {
+  /* Lowest number of overused nodes so far, and the number of iterations
+   * since it was reached, to find out if the negotiation stagnates */
+  size_t min_num_overused_nodes = std::numeric_limits<size_t>::max();
+  int num_stagnant_iterations = 0;
+  bool is_stagnant = false;
+  for (int iter = 0; iter < params_.max_iterations && !is_routed_ &&
+                     !is_impossible && !is_stagnant;
+       iter++) {
     unsigned int inet;
     /* Iterate across all nets internal to logic block */
     for (inet = 0; inet < lb_net_ids_.size() && !is_impossible; inet++) {
@@ -436,6 +533,20 @@ bool LbRouter::try_route(const LbRRGraph& lb_rr_graph,
 
     if (!is_impossible) {
       is_routed_ = is_route_success(lb_rr_graph);
+      if ((false == is_routed_) && (0 < params_.max_stagnant_iterations)) {
+        size_t num_overused_nodes = count_overused_nodes(lb_rr_graph);
+        if (num_overused_nodes < min_num_overused_nodes) {
+          min_num_overused_nodes = num_overused_nodes;
+          num_stagnant_iterations = 0;
+        } else if (++num_stagnant_iterations >=
+                   params_.max_stagnant_iterations) {
+          VTR_LOGV(verbosity,
+                   "Congestion has not been reduced in the last %d "
+                   "iterations. Stop routing after %d iterations\n",
+                   num_stagnant_iterations, iter + 1);
+          is_stagnant = true;
+        }
+      }
     } else {
       --inet;
       VTR_LOG(
@@ -476,6 +587,37 @@ bool LbRouter::try_route(const LbRRGraph& lb_rr_graph,
   return is_routed_;
 }
 
+void LbRouter::reset() {
+  clear_nets();
+  reset_illegal_modes();
+  reset_explored_node_tb();
+  reset_routing_status();
+  pq_.clear();
+
+  explore_id_index_ = 1;
+  is_routed_ = false;
+  mode_status_ = t_mode_selection_status();
+  pres_con_fac_ = 1;
+}
+
+void LbRouter::load_route_result(const t_route_result& result) {
+  VTR_ASSERT(result.net_rt_trees.size() == lb_net_ids_.size());
+
+  reset_net_rt();
+  for (const NetId& net : lb_net_ids_) {
+    VTR_ASSERT(result.net_rt_trees[net].size() == lb_net_sources_[net].size());
+    for (size_t isrc = 0; isrc < lb_net_sources_[net].size(); ++isrc) {
+      const t_trace& rt_tree = result.net_rt_trees[net][isrc];
+      if (LbRRNodeId::INVALID() == rt_tree.current_node) {
+        continue;
+      }
+      VTR_ASSERT(rt_tree.current_node == lb_net_sources_[net][isrc]);
+      lb_net_rt_trees_[net][isrc] = new t_trace(rt_tree);
+    }
+  }
+  is_routed_ = true;
+}
+
 /**************************************************
  * Private mutators
  *************************************************/
@@ -615,6 +757,7 @@ void LbRouter::commit_remove_rt(
   }
 
   LbRRNodeId inode = rt->current_node;
+  mark_routing_status_node(inode);
 
   /* Determine if node is being used or removed */
   if (op == RT_COMMIT) {
@@ -626,6 +769,7 @@ void LbRouter::commit_remove_rt(
     }
   } else {
     incr = -1;
+    mark_explored_node(inode);
     explored_node_tb_[inode].inet = NetId::INVALID();
   }
 
@@ -729,7 +873,9 @@ void LbRouter::expand_rt_rec(t_trace* rt, const LbRRNodeId& prev_index,
   enode.cost = 0;
   enode.node_index = rt->current_node;
   enode.prev_index = prev_index;
+  enode.lookahead_cost = node_lookahead_cost(enode.node_index);
   pq_.push(enode);
+  mark_explored_node(enode.node_index);
   explored_node_tb_[enode.node_index].inet = irt_net;
   explored_node_tb_[enode.node_index].explored_id = OPEN;
   explored_node_tb_[enode.node_index].enqueue_id = explore_id_index;
@@ -750,6 +896,40 @@ void LbRouter::expand_rt(const NetId& inet, const NetId& irt_net,
                 explore_id_index_);
 }
 
+void LbRouter::select_lookahead_sink(const LbRRGraph& lb_rr_graph,
+                                     const LbRRNodeId& sink) {
+  if (false == params_.use_lookahead) {
+    curr_sink_hop_distances_ = nullptr;
+    return;
+  }
+
+  auto result = sink_hop_distances_.find(sink);
+  if (result != sink_hop_distances_.end()) {
+    curr_sink_hop_distances_ = &(result->second);
+    return;
+  }
+
+  /* Walk backward from the sink, regardless of the modes, so that the hop
+   * distances never overestimate the remaining cost */
+  vtr::vector<LbRRNodeId, int>& hop_distances = sink_hop_distances_[sink];
+  hop_distances.resize(lb_rr_graph.nodes().size(), OPEN);
+  std::queue<LbRRNodeId> to_visit;
+  hop_distances[sink] = 0;
+  to_visit.push(sink);
+  while (!to_visit.empty()) {
+    LbRRNodeId node = to_visit.front();
+    to_visit.pop();
+    for (const LbRREdgeId& edge : lb_rr_graph.node_in_edges(node)) {
+      LbRRNodeId src_node = lb_rr_graph.edge_src_node(edge);
+      if (OPEN == hop_distances[src_node]) {
+        hop_distances[src_node] = hop_distances[node] + 1;
+        to_visit.push(src_node);
+      }
+    }
+  }
+  curr_sink_hop_distances_ = &hop_distances;
+}
+
 void LbRouter::expand_edges(const LbRRGraph& lb_rr_graph, t_mode* mode,
                             const LbRRNodeId& cur_inode, float cur_cost,
                             int net_fanout) {
@@ -760,7 +940,8 @@ void LbRouter::expand_edges(const LbRRGraph& lb_rr_graph, t_mode* mode,
   int usage;
   float incr_cost;
 
-  for (const LbRREdgeId& iedge : lb_rr_graph.node_out_edges(cur_inode, mode)) {
+  for (const LbRREdgeId& iedge :
+       lb_rr_graph.node_out_edge_range(cur_inode, mode)) {
     /* Init new expansion node */
     enode.prev_index = cur_inode;
     enode.node_index = lb_rr_graph.edge_sink_node(iedge);
@@ -797,7 +978,8 @@ void LbRouter::expand_edges(const LbRRGraph& lb_rr_graph, t_mode* mode,
                         ->parent_node->pb_type->modes[0]);
       }
     }
-    if (lb_rr_graph.node_out_edges(enode.node_index, next_mode).size() > 1) {
+    if (lb_rr_graph.node_out_edge_range(enode.node_index, next_mode).size() >
+        1) {
       fanout_factor = 0.85 + (0.25 / net_fanout);
     } else {
       fanout_factor = 1.15 - (0.25 / net_fanout);
@@ -805,6 +987,7 @@ void LbRouter::expand_edges(const LbRRGraph& lb_rr_graph, t_mode* mode,
 
     incr_cost *= fanout_factor;
     enode.cost = cur_cost + incr_cost;
+    enode.lookahead_cost = node_lookahead_cost(enode.node_index);
 
     /* Add to queue if cost is lower than lowest cost path to this enode */
     if (explored_node_tb_[enode.node_index].enqueue_id == explore_id_index_) {
@@ -818,6 +1001,7 @@ void LbRouter::expand_edges(const LbRRGraph& lb_rr_graph, t_mode* mode,
          */
       }
     } else {
+      mark_explored_node(enode.node_index);
       explored_node_tb_[enode.node_index].enqueue_id = explore_id_index_;
       explored_node_tb_[enode.node_index].enqueue_cost = enode.cost;
       pq_.push(enode);
@@ -877,7 +1061,7 @@ void LbRouter::expand_node_all_modes(const LbRRGraph& lb_rr_graph,
   t_mode* cur_mode = routing_status_[cur_inode].mode;
   auto* pin = lb_rr_graph.node_pb_graph_pin(cur_inode);
 
-  for (const LbRREdgeId& edge : lb_rr_graph.node_out_edges(cur_inode)) {
+  for (const LbRREdgeId& edge : lb_rr_graph.node_out_edge_range(cur_inode)) {
     t_mode* mode = lb_rr_graph.edge_mode(edge);
     /* If a mode has been forced, only add edges from that mode, otherwise add
      * edges from all modes. */
@@ -950,6 +1134,7 @@ bool LbRouter::try_expand_nodes(const AtomNetlist& atom_nlist,
          * cost. If the node is popped a second time, then the path to that node
          * is higher than this path so ignore.
          */
+        mark_explored_node(exp_inode);
         explored_node_tb_[exp_inode].explored_id = explore_id_index_;
         explored_node_tb_[exp_inode].prev_index = exp_node.prev_index;
         if (exp_inode != lb_net_sinks_[lb_net][itarget]) {
@@ -972,7 +1157,9 @@ bool LbRouter::try_expand_nodes(const AtomNetlist& atom_nlist,
  * Private validators
  *************************************************/
 bool LbRouter::matched_lb_rr_graph(const LbRRGraph& lb_rr_graph) const {
-  return ((routing_status_.size() == lb_rr_graph.nodes().size()) &&
+  /* The router walks through the compressed edges of a frozen graph */
+  return ((true == lb_rr_graph.frozen()) &&
+          (routing_status_.size() == lb_rr_graph.nodes().size()) &&
           (explored_node_tb_.size() == lb_rr_graph.nodes().size()));
 }
 
@@ -1045,14 +1232,19 @@ bool LbRouter::check_net(const LbRRGraph& lb_rr_graph,
 /**************************************************
  * Private Initializer and cleaner
  *************************************************/
+/* Only the nodes modified since the last reset are visited, which are usually
+ * a small part of the graph */
 void LbRouter::reset_explored_node_tb() {
-  for (t_explored_node_stats& explored_node : explored_node_tb_) {
+  for (const LbRRNodeId& node : dirty_explored_nodes_) {
+    t_explored_node_stats& explored_node = explored_node_tb_[node];
     explored_node.prev_index = LbRRNodeId::INVALID();
     explored_node.explored_id = OPEN;
     explored_node.inet = NetId::INVALID();
     explored_node.enqueue_id = OPEN;
     explored_node.enqueue_cost = 0;
+    explored_node_dirty_[node] = false;
   }
+  dirty_explored_nodes_.clear();
 }
 
 void LbRouter::reset_net_rt() {
@@ -1065,9 +1257,25 @@ void LbRouter::reset_net_rt() {
 }
 
 void LbRouter::reset_routing_status() {
-  for (t_routing_status& status : routing_status_) {
-    status.historical_usage = 0;
-    status.occ = 0;
+  for (const LbRRNodeId& node : dirty_routing_status_nodes_) {
+    routing_status_[node].historical_usage = 0;
+    routing_status_[node].occ = 0;
+    routing_status_node_dirty_[node] = false;
+  }
+  dirty_routing_status_nodes_.clear();
+}
+
+void LbRouter::mark_explored_node(const LbRRNodeId& node) {
+  if (false == bool(explored_node_dirty_[node])) {
+    explored_node_dirty_[node] = true;
+    dirty_explored_nodes_.push_back(node);
+  }
+}
+
+void LbRouter::mark_routing_status_node(const LbRRNodeId& node) {
+  if (false == bool(routing_status_node_dirty_[node])) {
+    routing_status_node_dirty_[node] = true;
+    dirty_routing_status_nodes_.push_back(node);
   }
 }
 
@@ -36,8 +36,9 @@ namespace openfpga {
  *
  * How to use the router:
  *
- *  // Create your own routing resource graph
+ *  // Create your own routing resource graph, which should be frozen
  *  LbRRGraph lb_rr_graph = <your_lb_rr_graph_builder>();
+ *  lb_rr_graph.freeze();
  *
  *  // Create a router object
  *  LbRouter lb_router(lb_rr_graph);
@@ -66,6 +67,10 @@ namespace openfpga {
  *  // Here is an example to check which nodes are mapped to the 'net' created
  *before std::vector<LbRRNodeId> routed_nodes = lb_router.net_routed_nodes(net);
  *
+ *  // Clear the nets and results, so that the router can be reused for
+ *  // another group of nets on the same graph, e.g., another clustered block
+ *  lb_router.reset();
+ *
  *******************************************************************/
 
 class LbRouter {
@@ -115,6 +120,11 @@ class LbRouter {
     float pres_fac;
     float pres_fac_mult;
     float hist_fac;
+    /* Guide the expansion with the hop distances to the sink to route */
+    bool use_lookahead;
+    /* Stop routing when the number of overused nodes is not reduced within
+     * this number of iterations. 0 means that only max_iterations applies */
+    int max_stagnant_iterations;
   };
 
   /**************************************************************************
@@ -126,11 +136,14 @@ class LbRouter {
     LbRRNodeId prev_index; /* Index of logic cluster_ctx.blocks rr node that
                               drives this expansion node */
     float cost;
+    /* Lower bound of the cost from this node to the sink to route */
+    float lookahead_cost;
 
     t_expansion_node() {
       node_index = LbRRNodeId::INVALID();
       prev_index = LbRRNodeId::INVALID();
       cost = 0;
+      lookahead_cost = 0;
     }
   };
 
@@ -138,7 +151,7 @@ class LbRouter {
    public:
     /* Returns true if t1 is earlier than t2 */
     bool operator()(t_expansion_node& e1, t_expansion_node& e2) {
-      if (e1.cost > e2.cost) {
+      if (e1.cost + e1.lookahead_cost > e2.cost + e2.lookahead_cost) {
         return true;
       }
       return false;
@@ -207,6 +220,15 @@ class LbRouter {
 
   enum e_commit_remove { RT_COMMIT, RT_REMOVE };
 
+  /**************************************************************************
+   * Routing results of a group of nets, which can be replayed on another
+   * group of nets with the same sources and terminals
+   * A source without any route tree is stored as a trace with an invalid node
+   ***************************************************************************/
+  struct t_route_result {
+    vtr::vector<NetId, std::vector<t_trace>> net_rt_trees;
+  };
+
  public: /* Public constructors */
   LbRouter(const LbRRGraph& lb_rr_graph, t_logical_block_type_ptr lb_type);
 
@@ -233,6 +255,17 @@ class LbRouter {
    */
   std::vector<LbRRNodeId> net_routed_nodes(const NetId& net) const;
 
+  /**
+   * Return a canonical key of the nets to be routed, which consists of the
+   * sources and terminals of each net in sequence. Atom nets are not part of
+   * the key, as they do not change the routing results. Groups of nets with
+   * the same key are routed in the same way on the same lb_rr_graph
+   */
+  std::vector<size_t> net_terminal_key() const;
+
+  /* Return a copy of the routing results, which can be loaded later */
+  t_route_result route_result() const;
+
  public: /* Public mutators */
   /**
    * Add net to be routed
@@ -254,6 +287,17 @@ class LbRouter {
   void set_physical_pb_modes(const LbRRGraph& lb_rr_graph,
                              const VprDeviceAnnotation& device_annotation);
 
+  /* Enable a lookahead which guides the expansion towards the sink to route,
+   * so that fewer nodes are expanded for each connection. The lookahead is a
+   * lower bound of the remaining cost, which keeps the routes of the lowest
+   * cost */
+  void set_lookahead(const bool& enabled);
+
+  /* Cap the iterations of negotiated congestion adaptively: routing gives up
+   * as soon as the congestion has stopped decreasing for a number of
+   * iterations, rather than running until max_iterations. 0 disables it */
+  void set_max_stagnant_iterations(const int& num_iterations);
+
   /**
    * Perform routing algorithm on a given logical tile routing resource graph
    * Note: the lb_rr_graph must be the same as you initilized the router!!!
@@ -261,6 +305,20 @@ class LbRouter {
   bool try_route(const LbRRGraph& lb_rr_graph, const AtomNetlist& atom_nlist,
                  const bool& verbosity);
 
+  /**
+   * Clear all the nets and routing results, so that the router can be reused
+   * to route another group of nets on the same lb_rr_graph, without
+   * reallocating its internal data.
+   * The modes set by set_physical_pb_modes() are kept
+   */
+  void reset();
+
+  /**
+   * Load the routing results which were found for a group of nets with the
+   * same key, instead of running the router
+   */
+  void load_route_result(const t_route_result& result);
+
  private: /* Private accessors */
   /**
    * Report if the routing is successfully done on a logical block routing
@@ -268,6 +326,9 @@ class LbRouter {
    */
   bool is_route_success(const LbRRGraph& lb_rr_graph) const;
 
+  /* Count the nodes whose occupancy exceeds their capacity */
+  size_t count_overused_nodes(const LbRRGraph& lb_rr_graph) const;
+
   /**
    * Try to find a node in the routing traces recursively
    * If not found, will return an empty pointer
@@ -276,6 +337,9 @@ class LbRouter {
 
   bool route_has_conflict(const LbRRGraph& lb_rr_graph, t_trace* rt) const;
 
+  /* Find the lookahead cost of a node to the current sink to route */
+  float node_lookahead_cost(const LbRRNodeId& node) const;
+
   /* Recursively find all the nodes in the trace */
   void rec_collect_trace_nodes(const t_trace* trace,
                                std::vector<LbRRNodeId>& routed_nodes) const;
@@ -305,6 +369,10 @@ class LbRouter {
   void expand_rt_rec(t_trace* rt, const LbRRNodeId& prev_index,
                      const NetId& irt_net, const int& explore_id_index);
   void expand_rt(const NetId& inet, const NetId& irt_net, const size_t& isrc);
+  /* Select the sink to route for the lookahead, whose hop distances are built
+   * by a reverse breadth-first search on its first use */
+  void select_lookahead_sink(const LbRRGraph& lb_rr_graph,
+                             const LbRRNodeId& sink);
   void expand_edges(const LbRRGraph& lb_rr_graph, t_mode* mode,
                     const LbRRNodeId& cur_inode, float cur_cost,
                     int net_fanout);
@@ -346,6 +414,11 @@ class LbRouter {
   void reset_routing_status();
   void reset_illegal_modes();
 
+  /* Record the nodes whose explored stats or routing status are modified, so
+   * that only these nodes are reset rather than the whole graph */
+  void mark_explored_node(const LbRRNodeId& node);
+  void mark_routing_status_node(const LbRRNodeId& node);
+
   void clear_nets();
   void free_net_rt(t_trace* lb_trace);
   void free_lb_trace(t_trace* lb_trace);
@@ -384,11 +457,30 @@ class LbRouter {
     explored_node_tb_; /* [0..lb_type_graph->size()-1] Stores mode exploration
                           and traceback info for nodes */
 
+  /* Nodes whose explored stats are modified since the last reset, and a flag
+   * for each node to avoid duplicated records */
+  std::vector<LbRRNodeId> dirty_explored_nodes_;
+  vtr::vector<LbRRNodeId, char> explored_node_dirty_;
+
+  /* Nodes whose occupancy or historical usage are modified since the last
+   * reset, and a flag for each node to avoid duplicated records */
+  std::vector<LbRRNodeId> dirty_routing_status_nodes_;
+  vtr::vector<LbRRNodeId, char> routing_status_node_dirty_;
+
   int explore_id_index_; /* used in conjunction with node_traceback to determine
                             whether or not a location has been explored.  By
                             using a unique identifier every route, I don't have
                             to clear the previous route exploration */
 
+  /* Lower bound of the cost to go through an edge and its sink node, which is
+   * the unit of the lookahead cost */
+  float min_hop_cost_;
+  /* Minimum number of edges from each node to a sink, which are built on
+   * demand for each sink and kept across resets, as the graph is the same */
+  std::map<LbRRNodeId, vtr::vector<LbRRNodeId, int>> sink_hop_distances_;
+  /* Hop distances to the sink under routing, nullptr if lookahead is off */
+  const vtr::vector<LbRRNodeId, int>* curr_sink_hop_distances_;
+
   /* Current type */
   t_logical_block_type_ptr lb_type_;
 
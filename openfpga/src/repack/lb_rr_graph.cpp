@@ -16,6 +16,7 @@ namespace openfpga {
 LbRRGraph::LbRRGraph() {
   ext_source_node_ = LbRRNodeId::INVALID();
   ext_sink_node_ = LbRRNodeId::INVALID();
+  frozen_ = false;
 }
 
 /**************************************************
@@ -91,6 +92,35 @@ std::vector<LbRREdgeId> LbRRGraph::node_out_edges(const LbRRNodeId& node,
   return out_edges;
 }
 
+LbRRGraph::edge_range LbRRGraph::node_out_edge_range(
+  const LbRRNodeId& node) const {
+  VTR_ASSERT(true == frozen());
+  VTR_ASSERT(true == valid_node_id(node));
+  size_t first_group = node_edge_group_offsets_[size_t(node)];
+  size_t last_group = node_edge_group_offsets_[size_t(node) + 1];
+  if (first_group == last_group) {
+    return vtr::make_range(edge_ids_.end(), edge_ids_.end());
+  }
+  return vtr::make_range(
+    edge_ids_.begin() + edge_groups_[first_group].first_edge,
+    edge_ids_.begin() + edge_groups_[last_group - 1].last_edge);
+}
+
+LbRRGraph::edge_range LbRRGraph::node_out_edge_range(const LbRRNodeId& node,
+                                                     t_mode* mode) const {
+  VTR_ASSERT(true == frozen());
+  VTR_ASSERT(true == valid_node_id(node));
+  for (size_t igroup = node_edge_group_offsets_[size_t(node)];
+       igroup < node_edge_group_offsets_[size_t(node) + 1]; ++igroup) {
+    const t_edge_group& group = edge_groups_[igroup];
+    if (mode == group.mode) {
+      return vtr::make_range(edge_ids_.begin() + group.first_edge,
+                             edge_ids_.begin() + group.last_edge);
+    }
+  }
+  return vtr::make_range(edge_ids_.end(), edge_ids_.end());
+}
+
 LbRRNodeId LbRRGraph::find_node(const e_lb_rr_type& type,
                                 const t_pb_graph_pin* pb_graph_pin) const {
   if (size_t(type) >= node_lookup_.size()) {
@@ -249,6 +279,8 @@ LbRREdgeId LbRRGraph::create_edge(const LbRRNodeId& source,
   node_out_edges_[source].push_back(edge);
   node_in_edges_[sink].push_back(edge);
 
+  frozen_ = false;
+
   return edge;
 }
 
@@ -258,6 +290,78 @@ void LbRRGraph::set_edge_intrinsic_cost(const LbRREdgeId& edge,
   edge_intrinsic_costs_[edge] = cost;
 }
 
+void LbRRGraph::freeze() {
+  /* Sort the edges by their source nodes and then by modes. The modes are
+   * ordered by their first appearance among the outgoing edges of a node,
+   * while the edges in a mode keep their original sequence */
+  std::vector<LbRREdgeId> sorted_edges;
+  sorted_edges.reserve(edge_ids_.size());
+  node_edge_group_offsets_.clear();
+  node_edge_group_offsets_.reserve(node_ids_.size() + 1);
+  edge_groups_.clear();
+  for (const LbRRNodeId& node : nodes()) {
+    node_edge_group_offsets_.push_back(edge_groups_.size());
+    size_t first_group = edge_groups_.size();
+    for (const LbRREdgeId& edge : node_out_edges_[node]) {
+      bool grouped = false;
+      for (size_t igroup = first_group; igroup < edge_groups_.size();
+           ++igroup) {
+        if (edge_modes_[edge] == edge_groups_[igroup].mode) {
+          grouped = true;
+          break;
+        }
+      }
+      if (true == grouped) {
+        continue;
+      }
+      /* Collect all the edges in the mode */
+      t_edge_group group;
+      group.mode = edge_modes_[edge];
+      group.first_edge = sorted_edges.size();
+      for (const LbRREdgeId& cand_edge : node_out_edges_[node]) {
+        if (group.mode == edge_modes_[cand_edge]) {
+          sorted_edges.push_back(cand_edge);
+        }
+      }
+      group.last_edge = sorted_edges.size();
+      edge_groups_.push_back(group);
+    }
+  }
+  node_edge_group_offsets_.push_back(edge_groups_.size());
+  VTR_ASSERT(sorted_edges.size() == edge_ids_.size());
+
+  /* Renumber the edges and move the edge-level attributes accordingly */
+  vtr::vector<LbRREdgeId, LbRREdgeId> new_edge_ids(edge_ids_.size());
+  vtr::vector<LbRREdgeId, LbRRNodeId> new_src_nodes(edge_ids_.size());
+  vtr::vector<LbRREdgeId, LbRRNodeId> new_sink_nodes(edge_ids_.size());
+  vtr::vector<LbRREdgeId, float> new_intrinsic_costs(edge_ids_.size());
+  vtr::vector<LbRREdgeId, t_mode*> new_modes(edge_ids_.size());
+  for (size_t iedge = 0; iedge < sorted_edges.size(); ++iedge) {
+    const LbRREdgeId& old_edge = sorted_edges[iedge];
+    LbRREdgeId new_edge = LbRREdgeId(iedge);
+    new_edge_ids[old_edge] = new_edge;
+    new_src_nodes[new_edge] = edge_src_nodes_[old_edge];
+    new_sink_nodes[new_edge] = edge_sink_nodes_[old_edge];
+    new_intrinsic_costs[new_edge] = edge_intrinsic_costs_[old_edge];
+    new_modes[new_edge] = edge_modes_[old_edge];
+  }
+  edge_src_nodes_ = std::move(new_src_nodes);
+  edge_sink_nodes_ = std::move(new_sink_nodes);
+  edge_intrinsic_costs_ = std::move(new_intrinsic_costs);
+  edge_modes_ = std::move(new_modes);
+
+  frozen_ = true;
+
+  /* Edge lists of nodes are updated with the new ids */
+  for (const LbRRNodeId& node : nodes()) {
+    for (LbRREdgeId& edge : node_in_edges_[node]) {
+      edge = new_edge_ids[edge];
+    }
+    edge_range out_edges = node_out_edge_range(node);
+    node_out_edges_[node].assign(out_edges.begin(), out_edges.end());
+  }
+}
+
 /******************************************************************************
  * Public validators/invalidators
  ******************************************************************************/
@@ -302,6 +406,8 @@ bool LbRRGraph::validate() const {
   return (0 == num_err);
 }
 
+bool LbRRGraph::frozen() const { return frozen_; }
+
 bool LbRRGraph::empty() const {
   return (0 == nodes().size()) && (0 == edges().size());
 }
@@ -216,6 +216,13 @@ class LbRRGraph {
   std::vector<LbRREdgeId> node_out_edges(const LbRRNodeId& node,
                                          t_mode* mode) const;
 
+  /* Get the outgoing edges from a node as a range, without any copy.
+   * This is only available when the graph is frozen, where the outgoing edges
+   * of a node, and those in each mode, have contiguous ids. The range is in
+   * the same sequence as node_out_edges() */
+  edge_range node_out_edge_range(const LbRRNodeId& node) const;
+  edge_range node_out_edge_range(const LbRRNodeId& node, t_mode* mode) const;
+
   /* General method to look up a node with type and only pb_graph_pin
    * information */
   LbRRNodeId find_node(const e_lb_rr_type& type,
@@ -281,6 +288,15 @@ class LbRRGraph {
                          t_mode* mode);
   void set_edge_intrinsic_cost(const LbRREdgeId& edge, const float& cost);
 
+  /* Renumber the edges so that the outgoing edges of each node are stored
+   * contiguously and sorted by modes, i.e., a compressed sparse row format.
+   * Edge-level attributes, e.g., sink nodes, costs and modes, are then
+   * contiguous for the router to walk through.
+   * Call it once all the nodes and edges are built. Edge ids found before
+   * are no longer valid, and creating more edges will unfreeze the graph.
+   */
+  void freeze();
+
  public: /* Public validators */
   /* Validate is the node id does exist in the RRGraph */
   bool valid_node_id(const LbRRNodeId& node) const;
@@ -292,6 +308,9 @@ class LbRRGraph {
 
   bool empty() const;
 
+  /* Check if the graph is frozen, see freeze() */
+  bool frozen() const;
+
  private: /* Private Validators */
   bool validate_node_sizes() const;
   bool validate_edge_sizes() const;
@@ -338,6 +357,20 @@ class LbRRGraph {
   typedef std::vector<std::map<const t_pb_graph_pin*, LbRRNodeId>> NodeLookup;
   mutable NodeLookup node_lookup_;
 
+  /* Compressed outgoing edges, which are built when the graph is frozen.
+   * The outgoing edges of a node in a mode are in the range of ids
+   * [first_edge, last_edge) of an edge group. The edge groups of a node are
+   * [node_edge_group_offsets_[node], node_edge_group_offsets_[node + 1])
+   */
+  struct t_edge_group {
+    t_mode* mode;
+    size_t first_edge;
+    size_t last_edge;
+  };
+  std::vector<size_t> node_edge_group_offsets_;
+  std::vector<t_edge_group> edge_groups_;
+  bool frozen_;
+
   /* Special node look-up */
   LbRRNodeId ext_source_node_;
   LbRRNodeId ext_sink_node_;
@@ -0,0 +1,34 @@
+#ifndef LUT_TRUTH_TABLE_MASK_H
+#define LUT_TRUTH_TABLE_MASK_H
+
+/********************************************************************
+ * Include header files required by the data structure definition
+ *******************************************************************/
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/* Begin namespace openfpga */
+namespace openfpga {
+
+/********************************************************************
+ * A truth table of a LUT output, packed into 64-bit words in the same
+ * sequence as the LUT bitstream.
+ * Bit i of the words is the output value when the j-th input of the LUT
+ * is logic '0' for each j-th bit of i which is 1, as the LUT multiplexer
+ * passes its first input when all the inputs are logic '1'.
+ * A truth table without any line has no words, and its bitstream is the
+ * default value of the LUT SRAMs.
+ * Use build_lut_truth_table_mask() in lut_utils.h to create one
+ *******************************************************************/
+struct LutTruthTableMask {
+  /* Number of inputs in the truth table, which may be less than the LUT
+   * size. The rest of the LUT inputs are don't care */
+  size_t num_inputs = 0;
+  /* 2^num_inputs bits, at least one word */
+  std::vector<uint64_t> words;
+};
+
+} /* End namespace openfpga*/
+
+#endif
@@ -0,0 +1,484 @@
+/***************************************************************************************
+ * Save the physical routing resource graphs of logical blocks to a binary
+ * database, and load them back. This allows repack to skip building the graphs
+ * when the architecture is not changed.
+ *
+ * The database is organized as follows:
+ *   - a header: a magic word, the format version and a key which is computed
+ *     from the physical modes of the pb_graphs of all the logical blocks
+ *   - a graph for each logical block, which starts with the name of the
+ *     logical block and the number of bytes of its payload, so that a
+ *     corrupted file can be detected.
+ * The pb_graph pins and modes are stored by their indices in a walk through
+ * the physical modes of a pb_graph, and are converted back to pointers when
+ * loading the graphs.
+ ***************************************************************************************/
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <sstream>
+#include <unordered_map>
+
+/* Headers from vtrutil library */
+#include "vtr_assert.h"
+#include "vtr_log.h"
+#include "vtr_time.h"
+
+/* Headers from openfpgautil library */
+#include "command_exit_codes.h"
+#include "openfpga_binary_io.h"
+#include "openfpga_digest.h"
+#include "openfpga_hash.h"
+#include "openfpga_version.h"
+
+/* Headers from openfpga library */
+#include "pb_type_utils.h"
+#include "physical_lb_rr_graph_database.h"
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+/* Identify the type of file; change the version whenever the layout of the
+ * graphs in the database changes */
+constexpr char LB_RR_GRAPH_DATABASE_MAGIC[] = "OFPGALRG";
+constexpr size_t LB_RR_GRAPH_DATABASE_MAGIC_SIZE =
+  sizeof(LB_RR_GRAPH_DATABASE_MAGIC) - 1;
+constexpr uint32_t LB_RR_GRAPH_DATABASE_VERSION = 1;
+
+/* Index of a missing pb_graph pin or mode */
+constexpr size_t LB_RR_GRAPH_DATABASE_NO_INDEX =
+  std::numeric_limits<size_t>::max();
+
+/***************************************************************************************
+ * Collect the pb_graph pins and the physical modes of a pb_graph, visited in
+ * the same way as the physical lb_rr_graph is built
+ ***************************************************************************************/
+static void rec_collect_physical_pb_graph_pins(
+  t_pb_graph_node* pb_graph_node, const VprDeviceAnnotation& device_annotation,
+  std::vector<t_pb_graph_pin*>& pins, std::vector<t_mode*>& modes) {
+  for (int iport = 0; iport < pb_graph_node->num_input_ports; iport++) {
+    for (int ipin = 0; ipin < pb_graph_node->num_input_pins[iport]; ipin++) {
+      pins.push_back(&pb_graph_node->input_pins[iport][ipin]);
+    }
+  }
+  for (int iport = 0; iport < pb_graph_node->num_clock_ports; iport++) {
+    for (int ipin = 0; ipin < pb_graph_node->num_clock_pins[iport]; ipin++) {
+      pins.push_back(&pb_graph_node->clock_pins[iport][ipin]);
+    }
+  }
+  for (int iport = 0; iport < pb_graph_node->num_output_ports; iport++) {
+    for (int ipin = 0; ipin < pb_graph_node->num_output_pins[iport]; ipin++) {
+      pins.push_back(&pb_graph_node->output_pins[iport][ipin]);
+    }
+  }
+
+  if (true == is_primitive_pb_type(pb_graph_node->pb_type)) {
+    return;
+  }
+
+  t_mode* physical_mode =
+    device_annotation.physical_mode(pb_graph_node->pb_type);
+  if (modes.end() == std::find(modes.begin(), modes.end(), physical_mode)) {
+    modes.push_back(physical_mode);
+  }
+  for (int ipb_type = 0; ipb_type < physical_mode->num_pb_type_children;
+       ipb_type++) {
+    for (int ipb = 0; ipb < physical_mode->pb_type_children[ipb_type].num_pb;
+         ipb++) {
+      rec_collect_physical_pb_graph_pins(
+        &(pb_graph_node
+            ->child_pb_graph_nodes[physical_mode->index][ipb_type][ipb]),
+        device_annotation, pins, modes);
+    }
+  }
+}
+
+/***************************************************************************************
+ * Index of a mode in the physical modes, where 0 denotes no mode
+ ***************************************************************************************/
+static size_t find_physical_mode_index(const std::vector<t_mode*>& modes,
+                                       const t_mode* mode) {
+  if (nullptr == mode) {
+    return 0;
+  }
+  auto it = std::find(modes.begin(), modes.end(), mode);
+  if (modes.end() == it) {
+    return LB_RR_GRAPH_DATABASE_NO_INDEX;
+  }
+  return size_t(it - modes.begin()) + 1;
+}
+
+/***************************************************************************************
+ * Compute the key of the database from everything that the physical
+ * lb_rr_graphs are built upon, i.e.,
+ * - the version of OpenFPGA
+ * - the names of the logical blocks
+ * - the physical modes of the pb_graphs
+ * - the ports, pins and interconnects of the pb_graphs under physical modes
+ ***************************************************************************************/
+size_t find_physical_lb_rr_graph_database_key(
+  const DeviceContext& device_ctx,
+  const VprDeviceAnnotation& device_annotation) {
+  size_t key = 0;
+  hash_combine<std::string>(key, std::string(VERSION));
+
+  for (const t_logical_block_type& lb_type : device_ctx.logical_block_types) {
+    if (nullptr == lb_type.pb_graph_head) {
+      continue;
+    }
+    hash_combine<std::string>(
+      key, std::string(lb_type.pb_graph_head->pb_type->name));
+
+    std::vector<t_pb_graph_pin*> pins;
+    std::vector<t_mode*> modes;
+    rec_collect_physical_pb_graph_pins(lb_type.pb_graph_head, device_annotation,
+                                       pins, modes);
+    std::unordered_map<const t_pb_graph_pin*, size_t> pin_indices;
+    for (size_t ipin = 0; ipin < pins.size(); ++ipin) {
+      pin_indices[pins[ipin]] = ipin;
+    }
+
+    for (const t_mode* mode : modes) {
+      hash_combine<std::string>(key, std::string(mode->parent_pb_type->name));
+      hash_combine<std::string>(key, std::string(mode->name));
+      hash_combine<int>(key, mode->index);
+    }
+
+    for (const t_pb_graph_pin* pin : pins) {
+      t_pb_type* pb_type = pin->parent_node->pb_type;
+      hash_combine<std::string>(key, std::string(pb_type->name));
+      hash_combine<bool>(key, is_primitive_pb_type(pb_type));
+      hash_combine<std::string>(key, std::string(pin->port->name));
+      hash_combine<int>(key, int(pin->port->type));
+      hash_combine<int>(key, int(pin->port->equivalent));
+      hash_combine<int>(key, pin->port->num_pins);
+      hash_combine<int>(key, pin->pin_number);
+      for (int iedge = 0; iedge < pin->num_output_edges; iedge++) {
+        const t_pb_graph_edge* edge = pin->output_edges[iedge];
+        hash_combine<std::string>(key, std::string(edge->interconnect->name));
+        hash_combine<size_t>(key, find_physical_mode_index(
+                                    modes, edge->interconnect->parent_mode));
+        for (int iout = 0; iout < edge->num_output_pins; iout++) {
+          auto result = pin_indices.find(edge->output_pins[iout]);
+          hash_combine<size_t>(key, pin_indices.end() == result
+                                      ? LB_RR_GRAPH_DATABASE_NO_INDEX
+                                      : result->second);
+        }
+      }
+    }
+  }
+
+  return key;
+}
+
+/***************************************************************************************
+ * Save a graph with flat arrays of node and edge attributes
+ ***************************************************************************************/
+static void write_lb_rr_graph_binary(std::ostream& fp,
+                                     const LbRRGraph& lb_rr_graph,
+                                     const std::vector<t_pb_graph_pin*>& pins,
+                                     const std::vector<t_mode*>& modes) {
+  std::unordered_map<const t_pb_graph_pin*, size_t> pin_indices;
+  for (size_t ipin = 0; ipin < pins.size(); ++ipin) {
+    pin_indices[pins[ipin]] = ipin;
+  }
+
+  std::vector<int> node_types;
+  std::vector<short> node_capacities;
+  std::vector<size_t> node_pins;
+  std::vector<float> node_costs;
+  for (const LbRRNodeId& node : lb_rr_graph.nodes()) {
+    node_types.push_back(int(lb_rr_graph.node_type(node)));
+    node_capacities.push_back(lb_rr_graph.node_capacity(node));
+    const t_pb_graph_pin* pin = lb_rr_graph.node_pb_graph_pin(node);
+    node_pins.push_back(nullptr == pin ? LB_RR_GRAPH_DATABASE_NO_INDEX
+                                       : pin_indices.at(pin));
+    node_costs.push_back(lb_rr_graph.node_intrinsic_cost(node));
+  }
+
+  std::vector<size_t> edge_src_nodes;
+  std::vector<size_t> edge_sink_nodes;
+  std::vector<float> edge_costs;
+  std::vector<size_t> edge_modes;
+  for (const LbRREdgeId& edge : lb_rr_graph.edges()) {
+    edge_src_nodes.push_back(size_t(lb_rr_graph.edge_src_node(edge)));
+    edge_sink_nodes.push_back(size_t(lb_rr_graph.edge_sink_node(edge)));
+    edge_costs.push_back(lb_rr_graph.edge_intrinsic_cost(edge));
+    edge_modes.push_back(
+      find_physical_mode_index(modes, lb_rr_graph.edge_mode(edge)));
+  }
+
+  write_binary_data(fp, node_types);
+  write_binary_data(fp, node_capacities);
+  write_binary_data(fp, node_pins);
+  write_binary_data(fp, node_costs);
+  write_binary_data(fp, edge_src_nodes);
+  write_binary_data(fp, edge_sink_nodes);
+  write_binary_data(fp, edge_costs);
+  write_binary_data(fp, edge_modes);
+}
+
+/***************************************************************************************
+ * Load a graph saved by write_lb_rr_graph_binary().
+ * Return false if any index is out of range
+ ***************************************************************************************/
+static bool read_lb_rr_graph_binary(std::istream& fp, LbRRGraph& lb_rr_graph,
+                                    const std::vector<t_pb_graph_pin*>& pins,
+                                    const std::vector<t_mode*>& modes) {
+  std::vector<int> node_types;
+  std::vector<short> node_capacities;
+  std::vector<size_t> node_pins;
+  std::vector<float> node_costs;
+  std::vector<size_t> edge_src_nodes;
+  std::vector<size_t> edge_sink_nodes;
+  std::vector<float> edge_costs;
+  std::vector<size_t> edge_modes;
+  read_binary_data(fp, node_types);
+  read_binary_data(fp, node_capacities);
+  read_binary_data(fp, node_pins);
+  read_binary_data(fp, node_costs);
+  read_binary_data(fp, edge_src_nodes);
+  read_binary_data(fp, edge_sink_nodes);
+  read_binary_data(fp, edge_costs);
+  read_binary_data(fp, edge_modes);
+  if (false == fp.good()) {
+    return false;
+  }
+
+  size_t num_nodes = node_types.size();
+  size_t num_edges = edge_src_nodes.size();
+  if ((num_nodes != node_capacities.size()) ||
+      (num_nodes != node_pins.size()) || (num_nodes != node_costs.size()) ||
+      (num_edges != edge_sink_nodes.size()) ||
+      (num_edges != edge_costs.size()) || (num_edges != edge_modes.size())) {
+    return false;
+  }
+
+  lb_rr_graph.reserve_nodes(num_nodes);
+  for (size_t inode = 0; inode < num_nodes; ++inode) {
+    if ((0 > node_types[inode]) || (NUM_LB_RR_TYPES <= node_types[inode])) {
+      return false;
+    }
+    LbRRNodeId node = lb_rr_graph.create_node(e_lb_rr_type(node_types[inode]));
+    lb_rr_graph.set_node_capacity(node, node_capacities[inode]);
+    if (LB_RR_GRAPH_DATABASE_NO_INDEX != node_pins[inode]) {
+      if (pins.size() <= node_pins[inode]) {
+        return false;
+      }
+      lb_rr_graph.set_node_pb_graph_pin(node, pins[node_pins[inode]]);
+    }
+    lb_rr_graph.set_node_intrinsic_cost(node, node_costs[inode]);
+  }
+
+  lb_rr_graph.reserve_edges(num_edges);
+  for (size_t iedge = 0; iedge < num_edges; ++iedge) {
+    if ((num_nodes <= edge_src_nodes[iedge]) ||
+        (num_nodes <= edge_sink_nodes[iedge]) ||
+        (modes.size() < edge_modes[iedge])) {
+      return false;
+    }
+    t_mode* mode = nullptr;
+    if (0 < edge_modes[iedge]) {
+      mode = modes[edge_modes[iedge] - 1];
+    }
+    LbRREdgeId edge =
+      lb_rr_graph.create_edge(LbRRNodeId(edge_src_nodes[iedge]),
+                              LbRRNodeId(edge_sink_nodes[iedge]), mode);
+    lb_rr_graph.set_edge_intrinsic_cost(edge, edge_costs[iedge]);
+  }
+
+  /* Edges were saved in the frozen order, which is kept by freezing again */
+  lb_rr_graph.freeze();
+
+  return true;
+}
+
+/***************************************************************************************
+ * Write the physical lb_rr_graphs of all the logical blocks to a binary file.
+ * The key should be computed by find_physical_lb_rr_graph_database_key().
+ *
+ * Return 0 if successful
+ * Return 1 if fail when creating files
+ ***************************************************************************************/
+int write_physical_lb_rr_graph_database(
+  const std::string& fname, const size_t& key, const DeviceContext& device_ctx,
+  const VprDeviceAnnotation& device_annotation, const bool& verbose) {
+  std::string timer_message =
+    std::string("Write physical lb_rr_graph database to binary file '") +
+    fname + std::string("'");
+
+  std::string dir_path = format_dir_path(find_path_dir_name(fname));
+
+  /* Create directories */
+  create_directory(dir_path);
+
+  /* Start time count */
+  vtr::ScopedStartFinishTimer timer(timer_message);
+
+  VTR_ASSERT(true != fname.empty());
+
+  /* Create a file handler*/
+  std::fstream fp;
+  /* Open a file */
+  fp.open(fname, std::fstream::out | std::fstream::trunc |
+                   std::fstream::binary);
+
+  /* Validate the file stream */
+  check_file_stream(fname.c_str(), fp);
+
+  /* Header */
+  fp.write(LB_RR_GRAPH_DATABASE_MAGIC, LB_RR_GRAPH_DATABASE_MAGIC_SIZE);
+  write_binary_data(fp, LB_RR_GRAPH_DATABASE_VERSION);
+  write_binary_data(fp, uint64_t(key));
+
+  /* Graphs */
+  std::ostringstream payload(std::ios::binary);
+  for (const t_logical_block_type& lb_type : device_ctx.logical_block_types) {
+    if (nullptr == lb_type.pb_graph_head) {
+      continue;
+    }
+    std::vector<t_pb_graph_pin*> pins;
+    std::vector<t_mode*> modes;
+    rec_collect_physical_pb_graph_pins(lb_type.pb_graph_head, device_annotation,
+                                       pins, modes);
+
+    LbRRGraph lb_rr_graph =
+      device_annotation.physical_lb_rr_graph(lb_type.pb_graph_head);
+    payload.str(std::string());
+    write_lb_rr_graph_binary(payload, lb_rr_graph, pins, modes);
+
+    std::string data = payload.str();
+    write_binary_data(fp, std::string(lb_type.pb_graph_head->pb_type->name));
+    write_binary_size(fp, data.size());
+    fp.write(data.data(), data.size());
+    VTR_LOGV(verbose,
+             "Written routing resource graph for logical tile '%s' (%lu "
+             "nodes, %lu edges)\n",
+             lb_type.pb_graph_head->pb_type->name, lb_rr_graph.nodes().size(),
+             lb_rr_graph.edges().size());
+  }
+
+  if (false == fp.good()) {
+    VTR_LOG_ERROR(
+      "Fail to write physical lb_rr_graph database to file '%s'!\n",
+      fname.c_str());
+    fp.close();
+    return CMD_EXEC_FATAL_ERROR;
+  }
+
+  /* close a file */
+  fp.close();
+
+  return CMD_EXEC_SUCCESS;
+}
+
+/***************************************************************************************
+ * Read the physical lb_rr_graphs of all the logical blocks from a binary file.
+ * The device annotation is not touched unless all the graphs are loaded from
+ * a file which is created by the same version of the database and with the
+ * same key as the given one.
+ *
+ * Return 0 if successful
+ * Return 1 if the file is corrupted
+ * Return 2 if the file does not exist or is outdated, which means that the
+ * graphs should be built again
+ ***************************************************************************************/
+int read_physical_lb_rr_graph_database(const std::string& fname,
+                                       const size_t& key,
+                                       const DeviceContext& device_ctx,
+                                       VprDeviceAnnotation& device_annotation,
+                                       const bool& verbose) {
+  std::string timer_message =
+    std::string("Read physical lb_rr_graph database from binary file '") +
+    fname + std::string("'");
+
+  /* Start time count */
+  vtr::ScopedStartFinishTimer timer(timer_message);
+
+  std::fstream fp;
+  fp.open(fname, std::fstream::in | std::fstream::binary);
+  if (false == valid_file_stream(fp)) {
+    VTR_LOG("Physical lb_rr_graph database '%s' does not exist\n",
+            fname.c_str());
+    return CMD_EXEC_MINOR_ERROR;
+  }
+
+  /* Header */
+  char magic[LB_RR_GRAPH_DATABASE_MAGIC_SIZE];
+  uint32_t version = 0;
+  uint64_t file_key = 0;
+  fp.read(magic, LB_RR_GRAPH_DATABASE_MAGIC_SIZE);
+  read_binary_data(fp, version);
+  read_binary_data(fp, file_key);
+  if ((false == fp.good()) ||
+      (0 != std::memcmp(magic, LB_RR_GRAPH_DATABASE_MAGIC,
+                        LB_RR_GRAPH_DATABASE_MAGIC_SIZE))) {
+    VTR_LOG_ERROR("File '%s' is not a physical lb_rr_graph database!\n",
+                  fname.c_str());
+    return CMD_EXEC_FATAL_ERROR;
+  }
+  if (LB_RR_GRAPH_DATABASE_VERSION != version) {
+    VTR_LOG("Physical lb_rr_graph database '%s' has version %u while version "
+            "%u is expected\n",
+            fname.c_str(), version, LB_RR_GRAPH_DATABASE_VERSION);
+    return CMD_EXEC_MINOR_ERROR;
+  }
+  if (uint64_t(key) != file_key) {
+    VTR_LOG(
+      "Physical lb_rr_graph database '%s' was not created with the current "
+      "architecture\n",
+      fname.c_str());
+    return CMD_EXEC_MINOR_ERROR;
+  }
+
+  /* Graphs are loaded aside, and annotated only when all of them are valid */
+  std::vector<std::pair<t_pb_graph_node*, LbRRGraph>> lb_rr_graphs;
+  for (const t_logical_block_type& lb_type : device_ctx.logical_block_types) {
+    if (nullptr == lb_type.pb_graph_head) {
+      continue;
+    }
+    std::string name;
+    read_binary_data(fp, name);
+    size_t num_bytes = read_binary_container_size(fp, 1);
+    if ((false == fp.good()) ||
+        (std::string(lb_type.pb_graph_head->pb_type->name) != name)) {
+      VTR_LOG_ERROR(
+        "Physical lb_rr_graph database '%s' is corrupted: graph of logical "
+        "tile '%s' is missing!\n",
+        fname.c_str(), lb_type.pb_graph_head->pb_type->name);
+      return CMD_EXEC_FATAL_ERROR;
+    }
+    std::streampos start = fp.tellg();
+
+    std::vector<t_pb_graph_pin*> pins;
+    std::vector<t_mode*> modes;
+    rec_collect_physical_pb_graph_pins(lb_type.pb_graph_head, device_annotation,
+                                       pins, modes);
+    lb_rr_graphs.emplace_back(lb_type.pb_graph_head, LbRRGraph());
+    if ((false ==
+         read_lb_rr_graph_binary(fp, lb_rr_graphs.back().second, pins,
+                                 modes)) ||
+        (std::streamoff(num_bytes) != fp.tellg() - start)) {
+      VTR_LOG_ERROR(
+        "Physical lb_rr_graph database '%s' is corrupted: graph of logical "
+        "tile '%s' is invalid!\n",
+        fname.c_str(), lb_type.pb_graph_head->pb_type->name);
+      return CMD_EXEC_FATAL_ERROR;
+    }
+    VTR_LOGV(verbose,
+             "Read routing resource graph for logical tile '%s' (%lu nodes, "
+             "%lu edges)\n",
+             name.c_str(), lb_rr_graphs.back().second.nodes().size(),
+             lb_rr_graphs.back().second.edges().size());
+  }
+
+  for (const auto& lb_rr_graph : lb_rr_graphs) {
+    device_annotation.add_physical_lb_rr_graph(lb_rr_graph.first,
+                                               lb_rr_graph.second);
+  }
+
+  return CMD_EXEC_SUCCESS;
+}
+
+} /* end namespace openfpga */
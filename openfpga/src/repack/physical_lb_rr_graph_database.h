@@ -0,0 +1,35 @@
+#ifndef PHYSICAL_LB_RR_GRAPH_DATABASE_H
+#define PHYSICAL_LB_RR_GRAPH_DATABASE_H
+
+/********************************************************************
+ * Include header files that are required by function declaration
+ *******************************************************************/
+#include <string>
+
+#include "vpr_context.h"
+#include "vpr_device_annotation.h"
+
+/********************************************************************
+ * Function declaration
+ *******************************************************************/
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+size_t find_physical_lb_rr_graph_database_key(
+  const DeviceContext& device_ctx,
+  const VprDeviceAnnotation& device_annotation);
+
+int write_physical_lb_rr_graph_database(
+  const std::string& fname, const size_t& key, const DeviceContext& device_ctx,
+  const VprDeviceAnnotation& device_annotation, const bool& verbose);
+
+int read_physical_lb_rr_graph_database(const std::string& fname,
+                                       const size_t& key,
+                                       const DeviceContext& device_ctx,
+                                       VprDeviceAnnotation& device_annotation,
+                                       const bool& verbose);
+
+} /* end namespace openfpga */
+
+#endif
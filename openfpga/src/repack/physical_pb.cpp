@@ -39,9 +39,10 @@ const t_pb_graph_node* PhysicalPb::pb_graph_node(const PhysicalPbId& pb) const {
 
 /* Find the module id by a given name, return invalid if not found */
 PhysicalPbId PhysicalPb::find_pb(const t_pb_graph_node* pb_graph_node) const {
-  if (type2id_map_.find(pb_graph_node) != type2id_map_.end()) {
+  auto result = type2id_map_.find(pb_graph_node);
+  if (result != type2id_map_.end()) {
     /* Find it, return the id */
-    return type2id_map_.at(pb_graph_node);
+    return result->second;
   }
   /* Not found, return an invalid id */
   return PhysicalPbId::INVALID();
@@ -55,10 +56,13 @@ PhysicalPbId PhysicalPb::parent(const PhysicalPbId& pb) const {
 PhysicalPbId PhysicalPb::child(const PhysicalPbId& pb, const t_pb_type* pb_type,
                                const size_t& index) const {
   VTR_ASSERT(true == valid_pb_id(pb));
-  if (0 < child_pbs_[pb].count(pb_type)) {
-    if (index < child_pbs_[pb].at(pb_type).size()) {
-      return child_pbs_[pb].at(pb_type)[index];
-    }
+  if (child_modes_[pb] != pb_type->parent_mode) {
+    return PhysicalPbId::INVALID();
+  }
+  size_t type_index = child_type_index(pb_type);
+  if ((type_index < child_pbs_[pb].size()) &&
+      (index < child_pbs_[pb][type_index].size())) {
+    return child_pbs_[pb][type_index][index];
   }
   return PhysicalPbId::INVALID();
 }
@@ -72,9 +76,9 @@ std::vector<AtomBlockId> PhysicalPb::atom_blocks(const PhysicalPbId& pb) const {
 AtomNetId PhysicalPb::pb_graph_pin_atom_net(
   const PhysicalPbId& pb, const t_pb_graph_pin* pb_graph_pin) const {
   VTR_ASSERT(true == valid_pb_id(pb));
-  if (pin_atom_nets_[pb].find(pb_graph_pin) != pin_atom_nets_[pb].end()) {
-    /* Find it, return the id */
-    return pin_atom_nets_[pb].at(pb_graph_pin);
+  size_t ipin = pin_index(pb_graph_pin);
+  if (ipin < pin_atom_nets_.size()) {
+    return pin_atom_nets_[ipin];
   }
   /* Not found, return an invalid id */
   return AtomNetId::INVALID();
@@ -83,15 +87,15 @@ AtomNetId PhysicalPb::pb_graph_pin_atom_net(
 bool PhysicalPb::is_wire_lut_output(const PhysicalPbId& pb,
                                     const t_pb_graph_pin* pb_graph_pin) const {
   VTR_ASSERT(true == valid_pb_id(pb));
-  if (wire_lut_outputs_[pb].find(pb_graph_pin) != wire_lut_outputs_[pb].end()) {
-    /* Find it, return the status */
-    return wire_lut_outputs_[pb].at(pb_graph_pin);
+  size_t ipin = pin_index(pb_graph_pin);
+  if (ipin < wire_lut_outputs_.size()) {
+    return wire_lut_outputs_[ipin];
   }
   /* Not found, return false */
   return false;
 }
 
-std::map<const t_pb_graph_pin*, AtomNetlist::TruthTable>
+const std::map<const t_pb_graph_pin*, LutTruthTableMask>&
 PhysicalPb::truth_tables(const PhysicalPbId& pb) const {
   VTR_ASSERT(true == valid_pb_id(pb));
   return truth_tables_[pb];
@@ -124,6 +128,26 @@ size_t PhysicalPb::fixed_mode_select_bitstream_offset(
   return fixed_mode_select_bitstream_offsets_[pb];
 }
 
+MemoryUsage PhysicalPb::memory_usage() const {
+  MemoryUsage usage = heap_memory_usage(pb_ids_);
+  usage += heap_memory_usage(pb_graph_nodes_);
+  usage += heap_memory_usage(names_);
+  usage += heap_memory_usage(atom_blocks_);
+  usage += heap_memory_usage(pin_atom_nets_);
+  usage += heap_memory_usage(wire_lut_outputs_);
+  usage += heap_memory_usage(child_pbs_);
+  usage += heap_memory_usage(child_modes_);
+  usage += heap_memory_usage(parent_pbs_);
+  usage += heap_memory_usage(truth_tables_);
+  usage += heap_memory_usage(mode_bits_);
+  usage += heap_memory_usage(fixed_bitstreams_);
+  usage += heap_memory_usage(fixed_bitstream_offsets_);
+  usage += heap_memory_usage(fixed_mode_select_bitstreams_);
+  usage += heap_memory_usage(fixed_mode_select_bitstream_offsets_);
+  usage += heap_memory_usage(type2id_map_);
+  return usage;
+}
+
 /******************************************************************************
  * Private Mutators
  ******************************************************************************/
@@ -144,10 +168,9 @@ PhysicalPbId PhysicalPb::create_pb(const t_pb_graph_node* pb_graph_node) {
   names_.emplace_back();
   pb_graph_nodes_.push_back(pb_graph_node);
   atom_blocks_.emplace_back();
-  pin_atom_nets_.emplace_back();
-  wire_lut_outputs_.emplace_back();
 
   child_pbs_.emplace_back();
+  child_modes_.push_back(nullptr);
   parent_pbs_.push_back(PhysicalPbId::INVALID());
 
   truth_tables_.emplace_back();
@@ -161,6 +184,12 @@ PhysicalPbId PhysicalPb::create_pb(const t_pb_graph_node* pb_graph_node) {
   /* Register in the name2id map */
   type2id_map_[pb_graph_node] = pb;
 
+  /* The pins of all the pbs are allocated with the top-level pb */
+  if (true == pb_graph_node->is_root()) {
+    pin_atom_nets_.resize(pb_graph_node->total_pb_pins, AtomNetId::INVALID());
+    wire_lut_outputs_.resize(pb_graph_node->total_pb_pins, false);
+  }
+
   return pb;
 }
 
@@ -170,7 +199,15 @@ void PhysicalPb::add_child(const PhysicalPbId& parent,
   VTR_ASSERT(true == valid_pb_id(parent));
   VTR_ASSERT(true == valid_pb_id(child));
 
-  child_pbs_[parent][child_type].push_back(child);
+  /* Children of a pb should be in the same mode */
+  VTR_ASSERT((nullptr == child_modes_[parent]) ||
+             (child_type->parent_mode == child_modes_[parent]));
+  child_modes_[parent] = child_type->parent_mode;
+  size_t type_index = child_type_index(child_type);
+  if (type_index >= child_pbs_[parent].size()) {
+    child_pbs_[parent].resize(child_type->parent_mode->num_pb_type_children);
+  }
+  child_pbs_[parent][type_index].push_back(child);
 
   if (PhysicalPbId::INVALID() != parent_pbs_[child]) {
     VTR_LOGF_WARN(
@@ -185,7 +222,7 @@ void PhysicalPb::add_child(const PhysicalPbId& parent,
 
 void PhysicalPb::set_truth_table(const PhysicalPbId& pb,
                                  const t_pb_graph_pin* pb_graph_pin,
-                                 const AtomNetlist::TruthTable& truth_table) {
+                                 const LutTruthTableMask& truth_table) {
   VTR_ASSERT(true == valid_pb_id(pb));
 
   if (0 < truth_tables_[pb].count(pb_graph_pin)) {
@@ -214,25 +251,33 @@ void PhysicalPb::set_pb_graph_pin_atom_net(const PhysicalPbId& pb,
                                            const t_pb_graph_pin* pb_graph_pin,
                                            const AtomNetId& atom_net) {
   VTR_ASSERT(true == valid_pb_id(pb));
-  if (pin_atom_nets_[pb].end() != pin_atom_nets_[pb].find(pb_graph_pin)) {
+  size_t ipin = pin_index(pb_graph_pin);
+  if (ipin >= pin_atom_nets_.size()) {
+    pin_atom_nets_.resize(ipin + 1, AtomNetId::INVALID());
+  }
+  if (AtomNetId::INVALID() != pin_atom_nets_[ipin]) {
     VTR_LOG_WARN("Overwrite pb_graph_pin '%s[%d]' atom net '%lu' with '%lu'\n",
                  pb_graph_pin->port->name, pb_graph_pin->pin_number,
-                 size_t(pin_atom_nets_[pb][pb_graph_pin]), size_t(atom_net));
+                 size_t(pin_atom_nets_[ipin]), size_t(atom_net));
   }
 
-  pin_atom_nets_[pb][pb_graph_pin] = atom_net;
+  pin_atom_nets_[ipin] = atom_net;
 }
 
 void PhysicalPb::set_wire_lut_output(const PhysicalPbId& pb,
                                      const t_pb_graph_pin* pb_graph_pin,
                                      const bool& wire_lut_output) {
   VTR_ASSERT(true == valid_pb_id(pb));
-  if (wire_lut_outputs_[pb].end() != wire_lut_outputs_[pb].find(pb_graph_pin)) {
+  size_t ipin = pin_index(pb_graph_pin);
+  if (ipin >= wire_lut_outputs_.size()) {
+    wire_lut_outputs_.resize(ipin + 1, false);
+  }
+  if (true == bool(wire_lut_outputs_[ipin])) {
     VTR_LOG_WARN("Overwrite pb_graph_pin '%s[%d]' status on wire LUT output\n",
                  pb_graph_pin->port->name, pb_graph_pin->pin_number);
   }
 
-  wire_lut_outputs_[pb][pb_graph_pin] = wire_lut_output;
+  wire_lut_outputs_[ipin] = wire_lut_output;
 }
 
 void PhysicalPb::set_fixed_bitstream(const PhysicalPbId& pb,
@@ -268,4 +313,17 @@ bool PhysicalPb::valid_pb_id(const PhysicalPbId& pb_id) const {
 
 bool PhysicalPb::empty() const { return 0 == pb_ids_.size(); }
 
+/******************************************************************************
+ * Private utility
+ ******************************************************************************/
+size_t PhysicalPb::pin_index(const t_pb_graph_pin* pb_graph_pin) const {
+  VTR_ASSERT(0 <= pb_graph_pin->pin_count_in_cluster);
+  return size_t(pb_graph_pin->pin_count_in_cluster);
+}
+
+size_t PhysicalPb::child_type_index(const t_pb_type* child_type) const {
+  VTR_ASSERT(nullptr != child_type->parent_mode);
+  return size_t(child_type - child_type->parent_mode->pb_type_children);
+}
+
 } /* end namespace openfpga */
@@ -4,6 +4,8 @@
 /********************************************************************
  * Include header files required by the data structure definition
  *******************************************************************/
+#include <unordered_map>
+
 /* Headers from vtrutil library */
 #include "vtr_geometry.h"
 #include "vtr_vector.h"
@@ -13,8 +15,12 @@
 
 /* Headers from vpr library */
 #include "atom_netlist.h"
+#include "lut_truth_table_mask.h"
 #include "physical_pb_fwd.h"
 
+/* Headers from openfpgautil library */
+#include "openfpga_memory_usage.h"
+
 /* Begin namespace openfpga */
 namespace openfpga {
 
@@ -52,13 +58,15 @@ class PhysicalPb {
                                   const t_pb_graph_pin* pb_graph_pin) const;
   bool is_wire_lut_output(const PhysicalPbId& pb,
                           const t_pb_graph_pin* pb_graph_pin) const;
-  std::map<const t_pb_graph_pin*, AtomNetlist::TruthTable> truth_tables(
+  const std::map<const t_pb_graph_pin*, LutTruthTableMask>& truth_tables(
     const PhysicalPbId& pb) const;
   std::vector<size_t> mode_bits(const PhysicalPbId& pb) const;
   std::string fixed_bitstream(const PhysicalPbId& pb) const;
   size_t fixed_bitstream_offset(const PhysicalPbId& pb) const;
   std::string fixed_mode_select_bitstream(const PhysicalPbId& pb) const;
   size_t fixed_mode_select_bitstream_offset(const PhysicalPbId& pb) const;
+  /* Approximate heap memory used by the data structure */
+  MemoryUsage memory_usage() const;
 
  public: /* Public mutators */
   PhysicalPbId create_pb(const t_pb_graph_node* pb_graph_node);
@@ -67,7 +75,7 @@ class PhysicalPb {
   void add_atom_block(const PhysicalPbId& pb, const AtomBlockId& atom_block);
   void set_truth_table(const PhysicalPbId& pb,
                        const t_pb_graph_pin* pb_graph_pin,
-                       const AtomNetlist::TruthTable& truth_table);
+                       const LutTruthTableMask& truth_table);
   void set_mode_bits(const PhysicalPbId& pb,
                      const std::vector<size_t>& mode_bits);
   void set_pb_graph_pin_atom_net(const PhysicalPbId& pb,
@@ -88,28 +96,37 @@ class PhysicalPb {
   bool valid_pb_id(const PhysicalPbId& pb_id) const;
   bool empty() const;
 
+ private: /* Internal utility */
+  /* Index of a pb_graph_pin in the flat pin arrays */
+  size_t pin_index(const t_pb_graph_pin* pb_graph_pin) const;
+  /* Index of a child pb_type in its parent mode */
+  size_t child_type_index(const t_pb_type* child_type) const;
+
  private: /* Internal Data */
   vtr::vector<PhysicalPbId, PhysicalPbId> pb_ids_;
   vtr::vector<PhysicalPbId, const t_pb_graph_node*> pb_graph_nodes_;
   vtr::vector<PhysicalPbId, std::string> names_;
   vtr::vector<PhysicalPbId, std::vector<AtomBlockId>> atom_blocks_;
-  vtr::vector<PhysicalPbId, std::map<const t_pb_graph_pin*, AtomNetId>>
-    pin_atom_nets_;
-  vtr::vector<PhysicalPbId, std::map<const t_pb_graph_pin*, bool>>
-    wire_lut_outputs_;
+
+  /* Nets and wire LUT status of pb_graph_pins, which are indexed by the
+   * pin_count_in_cluster of each pin. As a pb_graph_pin belongs to only one
+   * pb, the pins of all the pbs are stored in flat arrays, which are sized by
+   * the number of pins in the top-level pb_graph_node */
+  std::vector<AtomNetId> pin_atom_nets_;
+  std::vector<char> wire_lut_outputs_;
 
   /* Child pbs are organized as
-   * [0..num_child_pb_types-1][0..child_pb_type->num_pb-1] */
-  vtr::vector<PhysicalPbId,
-              std::map<const t_pb_type*, std::vector<PhysicalPbId>>>
+   * [0..num_child_pb_types-1][0..child_pb_type->num_pb-1]
+   * where child pb_types are indexed in the mode that they belong to */
+  vtr::vector<PhysicalPbId, std::vector<std::vector<PhysicalPbId>>>
     child_pbs_;
+  vtr::vector<PhysicalPbId, const t_mode*> child_modes_;
   vtr::vector<PhysicalPbId, PhysicalPbId> parent_pbs_;
 
   /* configuration bits
    * Truth tables and mode selection
    */
-  vtr::vector<PhysicalPbId,
-              std::map<const t_pb_graph_pin*, AtomNetlist::TruthTable>>
+  vtr::vector<PhysicalPbId, std::map<const t_pb_graph_pin*, LutTruthTableMask>>
     truth_tables_;
 
   vtr::vector<PhysicalPbId, std::vector<size_t>> mode_bits_;
@@ -121,7 +138,7 @@ class PhysicalPb {
   vtr::vector<PhysicalPbId, size_t> fixed_mode_select_bitstream_offsets_;
 
   /* Fast lookup */
-  std::map<const t_pb_graph_node*, PhysicalPbId> type2id_map_;
+  std::unordered_map<const t_pb_graph_node*, PhysicalPbId> type2id_map_;
 };
 
 } /* End namespace openfpga*/
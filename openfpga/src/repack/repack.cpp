@@ -2,6 +2,11 @@
  * This file includes functions that are used to redo packing for physical pbs
  ***************************************************************************************/
 
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <set>
+
 /* Headers from vtrutil library */
 #include "vtr_assert.h"
 #include "vtr_log.h"
@@ -9,10 +14,15 @@
 
 /* Headers from vpr library */
 #include "build_physical_lb_rr_graph.h"
+#include "command_exit_codes.h"
 #include "lb_router.h"
 #include "lb_router_utils.h"
+#include "openfpga_parallel.h"
+#include "openfpga_progress.h"
+#include "openfpga_trace.h"
 #include "pb_graph_utils.h"
 #include "pb_type_utils.h"
+#include "physical_lb_rr_graph_database.h"
 #include "physical_pb_utils.h"
 #include "repack.h"
 #include "vpr_utils.h"
@@ -477,6 +487,118 @@ static std::vector<LbRRNodeId> find_lb_net_physical_sink_lb_rr_nodes(
   return sink_nodes;
 }
 
+/***************************************************************************************
+ * Design constraints and options resolved on the pins of a logical block type,
+ * which are indexed by the pin index of a clustered block
+ ***************************************************************************************/
+struct LbPinConstraints {
+  /* Pins which are specified to ignore global nets */
+  std::vector<char> ignore_global_nets;
+  /* Name of the net constrained on each pin, which is empty if the pin is not
+   * constrained or OPEN if no net should be mapped */
+  std::vector<std::string> constrained_net_names;
+  /* Atom net constrained on each pin, which is invalid if the pin is not
+   * constrained or unmapped, or the net does not exist */
+  std::vector<AtomNetId> constrained_nets;
+  /* Atom nets which are specified to be ignored on each pin */
+  std::vector<std::vector<AtomNetId>> ignored_nets;
+};
+
+/***************************************************************************************
+ * Design constraints resolved for all the logical block types used by the
+ * clustered blocks, so that the clustered blocks are repacked without any
+ * look-up by names
+ ***************************************************************************************/
+struct RepackConstraintTable {
+  /* Constraints on pins of each logical block type, i.e., each top-level
+   * pb_graph_node */
+  std::map<const t_pb_graph_node*, LbPinConstraints> lb_pins;
+  /* Atom nets which are constrained to a pin */
+  std::set<AtomNetId> pinned_nets;
+};
+
+/***************************************************************************************
+ * Resolve the design constraints and options on the pins of the logical block
+ * types once for all the clustered blocks.
+ * Names of pins and nets are compared here in the same way as the accessors of
+ * RepackOption and RepackDesignConstraints
+ ***************************************************************************************/
+static RepackConstraintTable build_repack_constraint_table(
+  const AtomContext& atom_ctx, const ClusteringContext& clustering_ctx,
+  const RepackOption& options) {
+  RepackConstraintTable constraint_table;
+  const RepackDesignConstraints& design_constraints =
+    options.design_constraints();
+
+  /* Nets to be ignored, grouped by the pb_type names */
+  std::map<std::string, std::vector<RepackDesignConstraintId>> ignore_net_ids;
+  for (const RepackDesignConstraintId& id :
+       design_constraints.design_constraints()) {
+    if (RepackDesignConstraints::IGNORE_NET == design_constraints.type(id)) {
+      ignore_net_ids[design_constraints.pb_type(id)].push_back(id);
+    }
+  }
+
+  /* A net is pinned by the first constraint on it */
+  std::set<std::string> visited_net_names;
+  for (const RepackDesignConstraintId& id :
+       design_constraints.design_constraints()) {
+    std::string net_name = design_constraints.net(id);
+    if (false == visited_net_names.insert(net_name).second) {
+      continue;
+    }
+    AtomNetId atom_net_id = atom_ctx.nlist.find_net(net_name);
+    if ((true == design_constraints.pin(id).is_valid()) &&
+        (true == atom_ctx.nlist.valid_net_id(atom_net_id))) {
+      constraint_table.pinned_nets.insert(atom_net_id);
+    }
+  }
+
+  for (const ClusterBlockId& block_id : clustering_ctx.clb_nlist.blocks()) {
+    t_logical_block_type_ptr lb_type =
+      clustering_ctx.clb_nlist.block_type(block_id);
+    if (0 < constraint_table.lb_pins.count(lb_type->pb_graph_head)) {
+      continue;
+    }
+    LbPinConstraints& lb_pins =
+      constraint_table.lb_pins[lb_type->pb_graph_head];
+    std::string pb_type_name(lb_type->pb_type->name);
+    size_t num_pins = lb_type->pb_type->num_pins;
+    lb_pins.ignore_global_nets.resize(num_pins, false);
+    lb_pins.constrained_net_names.resize(num_pins);
+    lb_pins.constrained_nets.resize(num_pins, AtomNetId::INVALID());
+    lb_pins.ignored_nets.resize(num_pins);
+
+    for (size_t j = 0; j < num_pins; j++) {
+      const t_pb_graph_pin* pb_pin =
+        get_pb_graph_node_pin_from_block_pin(block_id, j);
+      BasicPort curr_pin(std::string(pb_pin->port->name), pb_pin->pin_number,
+                         pb_pin->pin_number);
+      lb_pins.ignore_global_nets[j] =
+        options.is_pin_ignore_global_nets(pb_type_name, curr_pin);
+
+      std::string constrained_net_name =
+        design_constraints.find_constrained_pin_net(pb_type_name, curr_pin);
+      lb_pins.constrained_net_names[j] = constrained_net_name;
+      if ((!design_constraints.unconstrained_net(constrained_net_name)) &&
+          (!design_constraints.unmapped_net(constrained_net_name))) {
+        lb_pins.constrained_nets[j] =
+          atom_ctx.nlist.find_net(constrained_net_name);
+      }
+
+      for (const RepackDesignConstraintId& id : ignore_net_ids[pb_type_name]) {
+        if (design_constraints.pin(id).mergeable(curr_pin) &&
+            design_constraints.pin(id).contained(curr_pin)) {
+          lb_pins.ignored_nets[j].push_back(
+            atom_ctx.nlist.find_net(design_constraints.net(id)));
+        }
+      }
+    }
+  }
+
+  return constraint_table;
+}
+
 /***************************************************************************************
  * Create nets to be routed, including the source nodes and terminals
  * And add them to the logical block router
@@ -487,10 +609,14 @@ static void add_lb_router_nets(
   const VprDeviceAnnotation& device_annotation,
   const ClusteringContext& clustering_ctx,
   const VprClusteringAnnotation& clustering_annotation,
-  const ClusterBlockId& block_id, const RepackOption& options) {
+  const ClusterBlockId& block_id, const RepackConstraintTable& constraint_table,
+  const RepackOption& options) {
   size_t net_counter = 0;
   bool verbose = options.verbose_output();
-  RepackDesignConstraints design_constraints = options.design_constraints();
+  const RepackDesignConstraints& design_constraints =
+    options.design_constraints();
+  const LbPinConstraints& lb_pins =
+    constraint_table.lb_pins.at(lb_type->pb_graph_head);
 
   /* Two spots to find source nodes for each nets
    *  - nets that appear in the inputs of a clustered block
@@ -573,15 +699,13 @@ static void add_lb_router_nets(
     }
 
     /* Only for global net which should be ignored, cache the sink nodes */
-    BasicPort curr_pin(std::string(source_pb_pin->port->name),
-                       source_pb_pin->pin_number, source_pb_pin->pin_number);
+    const std::vector<AtomNetId>& ignored_pin_nets = lb_pins.ignored_nets[j];
     if ((clustering_ctx.clb_nlist.net_is_ignored(cluster_net_id) &&
          clustering_ctx.clb_nlist.net_is_global(cluster_net_id) &&
-         options.is_pin_ignore_global_nets(std::string(lb_type->pb_type->name),
-                                           curr_pin)) ||
-        (options.net_is_specified_to_be_ignored(
-          atom_ctx.nlist.net_name(pb_pin_mapped_nets[source_pb_pin]),
-          std::string(lb_type->pb_type->name), curr_pin))) {
+         lb_pins.ignore_global_nets[j]) ||
+        (ignored_pin_nets.end() !=
+         std::find(ignored_pin_nets.begin(), ignored_pin_nets.end(),
+                   pb_pin_mapped_nets[source_pb_pin]))) {
       /* Find the net mapped to this pin in clustering results*/
       AtomNetId atom_net_id = pb_pin_mapped_nets[source_pb_pin];
 
@@ -638,20 +762,12 @@ static void add_lb_router_nets(
     /* Find the net mapped to this pin in clustering results*/
     AtomNetId atom_net_id = pb_pin_mapped_nets[source_pb_pin];
 
-    BasicPort curr_pin(std::string(source_pb_pin->port->name),
-                       source_pb_pin->pin_number, source_pb_pin->pin_number);
-    if ((ignored_atom_nets[atom_net_id]) &&
-        (options.is_pin_ignore_global_nets(std::string(lb_type->pb_type->name),
-                                           curr_pin))) {
+    if ((ignored_atom_nets[atom_net_id]) && (lb_pins.ignore_global_nets[j])) {
       continue;
     }
 
     /* Check if the net information is constrained or not */
-    std::string constrained_net_name =
-      design_constraints.find_constrained_pin_net(
-        std::string(lb_type->pb_type->name),
-        BasicPort(std::string(source_pb_pin->port->name),
-                  source_pb_pin->pin_number, source_pb_pin->pin_number));
+    const std::string& constrained_net_name = lb_pins.constrained_net_names[j];
 
     /* Find the constrained net mapped to this pin in clustering results */
     AtomNetId constrained_atom_net_id = AtomNetId::INVALID();
@@ -663,7 +779,7 @@ static void add_lb_router_nets(
      */
     if ((!design_constraints.unconstrained_net(constrained_net_name)) &&
         (!design_constraints.unmapped_net(constrained_net_name))) {
-      constrained_atom_net_id = atom_ctx.nlist.find_net(constrained_net_name);
+      constrained_atom_net_id = lb_pins.constrained_nets[j];
       if (false == atom_ctx.nlist.valid_net_id(constrained_atom_net_id)) {
         VTR_LOG_WARN(
           "Invalid net '%s' to be constrained! Will drop the constraint in "
@@ -682,8 +798,7 @@ static void add_lb_router_nets(
       constrained_atom_net_id = atom_net_id;
       /* Skip for the net which has been constrained on other pins */
       if (atom_net_id &&
-          design_constraints.net_pin(atom_ctx.nlist.net_name(atom_net_id))
-            .is_valid()) {
+          (0 < constraint_table.pinned_nets.count(atom_net_id))) {
         VTR_LOGV(verbose,
                  "Skip net '%s' on pin '%s[%d]' during repacking since it has "
                  "been constrained to another pin\n",
@@ -905,69 +1020,121 @@ static void add_lb_router_nets(
   VTR_LOGV(verbose, "Added %lu nets to be routed.\n", net_counter);
 }
 
+/***************************************************************************************
+ * A router which is reused across the clustered blocks of a logical block type
+ * Many clustered blocks pose the same routing problem, i.e., the same sources
+ * and terminals for each net, while only the atom nets are different. Their
+ * routing results are cached by the key of the nets, and replayed without
+ * running the router again
+ ***************************************************************************************/
+struct PooledLbRouter {
+  std::unique_ptr<LbRouter> router;
+  std::map<std::vector<size_t>, LbRouter::t_route_result> route_cache;
+};
+
+/***************************************************************************************
+ * Routers which are reused across the clustered blocks of a thread, one for
+ * each type of logical block, i.e., each top-level pb_graph_node
+ ***************************************************************************************/
+typedef std::map<const t_pb_graph_node*, PooledLbRouter> LbRouterPool;
+
+/***************************************************************************************
+ * Find the router for a logical block type in the pool. A router is created
+ * and its physical modes and lookahead are initialized on its first use,
+ * otherwise it is reset so that only the nodes touched by the previous routing
+ * are cleared
+ ***************************************************************************************/
+static PooledLbRouter& find_pooled_lb_router(
+  LbRouterPool& lb_routers, t_logical_block_type_ptr lb_type,
+  const LbRRGraph& lb_rr_graph, const VprDeviceAnnotation& device_annotation,
+  const RepackOption& options) {
+  PooledLbRouter& pooled_router = lb_routers[lb_type->pb_graph_head];
+  std::unique_ptr<LbRouter>& lb_router = pooled_router.router;
+  if (nullptr == lb_router) {
+    lb_router.reset(new LbRouter(lb_rr_graph, lb_type));
+    /* Initialize the modes to expand routing trees with the physical modes in
+     * device annotation This is a must-do before running the routeri in the
+     * purpose of repacking!!!
+     * The modes are the same for all the blocks of a type, so they are kept
+     * when the router is reset
+     */
+    lb_router->set_physical_pb_modes(lb_rr_graph, device_annotation);
+    lb_router->set_lookahead(options.lookahead());
+    lb_router->set_max_stagnant_iterations(
+      options.max_stagnant_route_iterations());
+  } else {
+    lb_router->reset();
+  }
+  return pooled_router;
+}
+
 /***************************************************************************************
  * Repack a clustered block in the physical mode
  * This function will do
  * - Find the lb_rr_graph that is affiliated to the clustered block
- *   and initilize the logcial tile router
+ *   and pick up a logcial tile router from the pool
  * - Create nets to be routed, including the source nodes and terminals
  *   This should consider the net remapping in the clustering_annotation
- * - Run the router to finish the repacking
- * - Output routing results to data structure PhysicalPb and store it in
- *clustering annotation
+ * - Run the router to finish the repacking, or reuse the routing results
+ *   of a previous block which has the same nets to route
+ * - Output routing results to data structure PhysicalPb
+ * Only read-only data is shared, so that clustered blocks can be repacked with
+ * multiple threads, each of which has its own pool of routers.
+ * Return false if the routing fails
  ***************************************************************************************/
-static void repack_cluster(const AtomContext& atom_ctx,
+static bool repack_cluster(PhysicalPb& phy_pb, LbRouterPool& lb_routers,
+                           const AtomContext& atom_ctx,
                            const ClusteringContext& clustering_ctx,
                            const VprDeviceAnnotation& device_annotation,
-                           VprClusteringAnnotation& clustering_annotation,
+                           const VprClusteringAnnotation& clustering_annotation,
                            const VprBitstreamAnnotation& bitstream_annotation,
                            const ClusterBlockId& block_id,
-                           const RepackOption& options) {
+                           const RepackConstraintTable& constraint_table,
+                           const RepackOption& options, const bool& verbose) {
   /* Get the pb graph that current clustered block is mapped to */
   t_logical_block_type_ptr lb_type =
     clustering_ctx.clb_nlist.block_type(block_id);
   t_pb_graph_node* pb_graph_head = lb_type->pb_graph_head;
   VTR_ASSERT(nullptr != pb_graph_head);
-  bool verbose = options.verbose_output();
 
   /* We should get a non-empty graph */
   const LbRRGraph& lb_rr_graph =
     device_annotation.physical_lb_rr_graph(pb_graph_head);
   VTR_ASSERT(!lb_rr_graph.empty());
 
-  VTR_LOG("Repack clustered block '%s'...",
-          clustering_ctx.clb_nlist.block_name(block_id).c_str());
-  VTR_LOGV(verbose, "\n");
-
-  /* Initialize the router */
-  LbRouter lb_router(lb_rr_graph, lb_type);
+  /* Get a router whose modes have been initialized */
+  PooledLbRouter& pooled_router = find_pooled_lb_router(
+    lb_routers, lb_type, lb_rr_graph, device_annotation, options);
+  LbRouter& lb_router = *pooled_router.router;
 
   /* Add nets to be routed with source and terminals */
-  add_lb_router_nets(
-    lb_router, lb_type, lb_rr_graph, atom_ctx, device_annotation,
-    clustering_ctx,
-    const_cast<const VprClusteringAnnotation&>(clustering_annotation), block_id,
-    options);
-
-  /* Initialize the modes to expand routing trees with the physical modes in
-   * device annotation This is a must-do before running the routeri in the
-   * purpose of repacking!!!
-   */
-  lb_router.set_physical_pb_modes(lb_rr_graph, device_annotation);
-
-  /* Run the router */
-  bool route_success =
-    lb_router.try_route(lb_rr_graph, atom_ctx.nlist, verbose);
+  add_lb_router_nets(lb_router, lb_type, lb_rr_graph, atom_ctx,
+                     device_annotation, clustering_ctx, clustering_annotation,
+                     block_id, constraint_table, options);
+
+  /* Replay the routing results of an identical routing problem if found,
+   * otherwise run the router and cache the results */
+  bool route_success = true;
+  std::vector<size_t> net_key = lb_router.net_terminal_key();
+  auto cached_result = pooled_router.route_cache.find(net_key);
+  if (cached_result != pooled_router.route_cache.end()) {
+    lb_router.load_route_result(cached_result->second);
+    VTR_LOGV(verbose, "Reuse routing results of an identical block\n");
+  } else {
+    route_success = lb_router.try_route(lb_rr_graph, atom_ctx.nlist, verbose);
+    if (true == route_success) {
+      pooled_router.route_cache.emplace(std::move(net_key),
+                                        lb_router.route_result());
+    }
+  }
 
   if (false == route_success) {
     VTR_LOGV(verbose, "Reroute failed\n");
-    exit(1);
+    return false;
   }
-  VTR_ASSERT(true == route_success);
   VTR_LOGV(verbose, "Reroute succeed\n");
 
   /* Annotate routing results to physical pb */
-  PhysicalPb phy_pb;
   alloc_physical_pb_from_pb_graph(phy_pb, pb_graph_head, device_annotation);
   rec_update_physical_pb_from_operating_pb(
     phy_pb, clustering_ctx.clb_nlist.block_pb(block_id),
@@ -978,14 +1145,18 @@ static void repack_cluster(const AtomContext& atom_ctx,
                                         atom_ctx.nlist, verbose);
   VTR_LOGV(verbose, "Saved results in physical pb\n");
 
-  /* Add the pb to clustering context */
-  clustering_annotation.add_physical_pb(block_id, phy_pb);
-
-  VTR_LOG("Done\n");
+  return true;
 }
 
 /***************************************************************************************
  * Repack each clustered blocks in the clustering context
+ * Clustered blocks are repacked with multiple threads, and the physical pbs are
+ * then stored in the clustering annotation by the sequence of blocks.
+ * Each thread owns a pool of routers, so that a router is not rebuilt for each
+ * block.
+ * Logs of each block are printed only in verbose mode and when running in a
+ * single thread, otherwise the outputs of threads would interleave.
+ * A rate-limited progress of all the blocks is reported instead
  ***************************************************************************************/
 static void repack_clusters(const AtomContext& atom_ctx,
                             const ClusteringContext& clustering_ctx,
@@ -995,12 +1166,49 @@ static void repack_clusters(const AtomContext& atom_ctx,
                             const RepackOption& options) {
   vtr::ScopedStartFinishTimer timer(
     "Repack clustered blocks to physical implementation of logical tile");
-
-  for (auto blk_id : clustering_ctx.clb_nlist.blocks()) {
-    repack_cluster(atom_ctx, clustering_ctx, device_annotation,
-                   clustering_annotation, bitstream_annotation, blk_id,
-                   options);
+  TraceScope trace_scope("repack_clusters");
+
+  std::vector<ClusterBlockId> blocks(clustering_ctx.clb_nlist.blocks().begin(),
+                                     clustering_ctx.clb_nlist.blocks().end());
+  std::vector<PhysicalPb> phy_pbs(blocks.size());
+  /* Use char rather than bool, so that threads write to different bytes */
+  std::vector<char> route_success(blocks.size(), false);
+
+  size_t num_threads = find_num_threads(options.num_threads());
+  std::vector<LbRouterPool> lb_router_pools(num_threads);
+
+  /* Resolve the design constraints once, rather than for each block */
+  RepackConstraintTable constraint_table =
+    build_repack_constraint_table(atom_ctx, clustering_ctx, options);
+
+  bool verbose = options.verbose_output() && (1 == num_threads);
+  ProgressReporter progress("Repack clustered blocks", blocks.size());
+  parallel_for_with_thread_id(
+    blocks.size(), options.num_threads(),
+    [&](const size_t& iblk, const size_t& thread_id) {
+      VTR_LOGV(verbose, "Repack clustered block '%s'...\n",
+               clustering_ctx.clb_nlist.block_name(blocks[iblk]).c_str());
+      route_success[iblk] = repack_cluster(
+        phy_pbs[iblk], lb_router_pools[thread_id], atom_ctx, clustering_ctx,
+        device_annotation,
+        const_cast<const VprClusteringAnnotation&>(clustering_annotation),
+        bitstream_annotation, blocks[iblk], constraint_table, options, verbose);
+      VTR_LOGV(verbose && route_success[iblk], "Done\n");
+      progress.increment();
+    });
+  progress.finish();
+
+  for (size_t iblk = 0; iblk < blocks.size(); ++iblk) {
+    if (false == route_success[iblk]) {
+      VTR_LOG_ERROR("Failed to repack clustered block '%s'!\n",
+                    clustering_ctx.clb_nlist.block_name(blocks[iblk]).c_str());
+      exit(1);
+    }
+    /* Add the pb to clustering context */
+    clustering_annotation.add_physical_pb(blocks[iblk],
+                                          std::move(phy_pbs[iblk]));
   }
+  VTR_LOG("Repacked %lu clustered blocks\n", blocks.size());
 }
 
 /***************************************************************************************
@@ -1016,6 +1224,7 @@ static void identify_physical_pb_wire_lut_created_by_repack(
   const VprDeviceAnnotation& device_annotation,
   const CircuitLibrary& circuit_lib, const bool& verbose) {
   vtr::ScopedStartFinishTimer timer("Identify wire LUTs created by repacking");
+  TraceScope trace_scope("identify_physical_pb_wire_lut_created_by_repack");
   int wire_lut_counter = 0;
 
   for (auto blk_id : cluster_ctx.clb_nlist.blocks()) {
@@ -1058,9 +1267,27 @@ void pack_physical_pbs(const DeviceContext& device_ctx,
                        const VprBitstreamAnnotation& bitstream_annotation,
                        const CircuitLibrary& circuit_lib,
                        const RepackOption& options) {
-  /* build the routing resource graph for each logical tile */
-  build_physical_lb_rr_graphs(device_ctx, device_annotation,
-                              options.verbose_output());
+  /* build the routing resource graph for each logical tile, unless they can be
+   * loaded from the cache file */
+  int cache_status = CMD_EXEC_MINOR_ERROR;
+  size_t cache_key = 0;
+  if (false == options.lb_rr_graph_cache().empty()) {
+    cache_key = find_physical_lb_rr_graph_database_key(
+      device_ctx, const_cast<const VprDeviceAnnotation&>(device_annotation));
+    cache_status = read_physical_lb_rr_graph_database(
+      options.lb_rr_graph_cache(), cache_key, device_ctx, device_annotation,
+      options.verbose_output());
+  }
+  if (CMD_EXEC_SUCCESS != cache_status) {
+    build_physical_lb_rr_graphs(device_ctx, device_annotation,
+                                options.verbose_output());
+    if (false == options.lb_rr_graph_cache().empty()) {
+      write_physical_lb_rr_graph_database(
+        options.lb_rr_graph_cache(), cache_key, device_ctx,
+        const_cast<const VprDeviceAnnotation&>(device_annotation),
+        options.verbose_output());
+    }
+  }
 
   /* Call the LbRouter to re-pack each clustered block to physical
    * implementation */
@@ -18,6 +18,9 @@ namespace openfpga {
  * Public Constructors
  *************************************************/
 RepackOption::RepackOption() {
+  num_threads_ = 1;
+  lookahead_ = false;
+  max_stagnant_route_iterations_ = 0;
   verbose_output_ = false;
   num_parse_errors_ = 0;
 }
@@ -25,7 +28,7 @@ RepackOption::RepackOption() {
 /**************************************************
  * Public Accessors
  *************************************************/
-RepackDesignConstraints RepackOption::design_constraints() const {
+const RepackDesignConstraints& RepackOption::design_constraints() const {
   return design_constraints_;
 }
 
@@ -64,6 +67,18 @@ bool RepackOption::net_is_specified_to_be_ignored(std::string cluster_net_name,
   return false;
 }
 
+size_t RepackOption::num_threads() const { return num_threads_; }
+
+bool RepackOption::lookahead() const { return lookahead_; }
+
+int RepackOption::max_stagnant_route_iterations() const {
+  return max_stagnant_route_iterations_;
+}
+
+std::string RepackOption::lb_rr_graph_cache() const {
+  return lb_rr_graph_cache_;
+}
+
 bool RepackOption::verbose_output() const { return verbose_output_; }
 
 /******************************************************************************
@@ -138,6 +153,23 @@ void RepackOption::set_ignore_global_nets_on_pins(const std::string& content) {
   }
 }
 
+void RepackOption::set_num_threads(const size_t& num_threads) {
+  num_threads_ = num_threads;
+}
+
+void RepackOption::set_lookahead(const bool& enabled) {
+  lookahead_ = enabled;
+}
+
+void RepackOption::set_max_stagnant_route_iterations(
+  const int& num_iterations) {
+  max_stagnant_route_iterations_ = num_iterations;
+}
+
+void RepackOption::set_lb_rr_graph_cache(const std::string& fname) {
+  lb_rr_graph_cache_ = fname;
+}
+
 void RepackOption::set_verbose_output(const bool& enabled) {
   verbose_output_ = enabled;
 }
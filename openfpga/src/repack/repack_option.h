@@ -21,19 +21,27 @@ class RepackOption {
   RepackOption();
 
  public: /* Public accessors */
-  RepackDesignConstraints design_constraints() const;
+  const RepackDesignConstraints& design_constraints() const;
   /* Identify if a pin should ignore all the global nets */
   bool is_pin_ignore_global_nets(const std::string& pb_type_name,
                                  const BasicPort& pin) const;
   bool net_is_specified_to_be_ignored(std::string cluster_net_name,
                                       std::string pb_type_name,
                                       const BasicPort& pin) const;
+  size_t num_threads() const;
+  bool lookahead() const;
+  int max_stagnant_route_iterations() const;
+  std::string lb_rr_graph_cache() const;
   bool verbose_output() const;
 
  public: /* Public mutators */
   void set_design_constraints(
     const RepackDesignConstraints& design_constraints);
   void set_ignore_global_nets_on_pins(const std::string& content);
+  void set_num_threads(const size_t& num_threads);
+  void set_lookahead(const bool& enabled);
+  void set_max_stagnant_route_iterations(const int& num_iterations);
+  void set_lb_rr_graph_cache(const std::string& fname);
   void set_verbose_output(const bool& enabled);
 
  public: /* Public validators */
@@ -51,6 +59,17 @@ class RepackOption {
    */
   std::map<std::string, std::vector<BasicPort>> ignore_global_nets_on_pins_;
 
+  /* Number of threads to repack clustered blocks, 0 means all the hardware
+   * threads */
+  size_t num_threads_;
+  /* Guide the routing of clustered blocks with a lookahead to the sinks */
+  bool lookahead_;
+  /* Give up routing a clustered block when its congestion is not reduced
+   * within this number of iterations. 0 means no adaptive limit */
+  int max_stagnant_route_iterations_;
+  /* File to load the physical lb_rr_graphs from, or to save them to when the
+   * file is missing or outdated. Empty means that no cache is used */
+  std::string lb_rr_graph_cache_;
   bool verbose_output_;
 
   /* A flag to indicate if the data parse is invalid or not */
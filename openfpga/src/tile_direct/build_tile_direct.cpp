@@ -3,6 +3,11 @@
  * between tiles (programmable blocks)
  ***************************************************************************************/
 
+#include <iterator>
+#include <map>
+#include <string>
+#include <vector>
+
 /* Headers from vtrutil library */
 #include "vtr_assert.h"
 #include "vtr_log.h"
@@ -153,193 +158,140 @@ static bool is_grid_coordinate_exist_in_device(
 }
 
 /********************************************************************
- * Find the coordinate of a grid in a specific column
- * with a given type
- * This function will return the coordinate of the grid that satifies
- * the type requirement
+ * The core grids of a physical tile type, indexed by column and by row.
+ * For each column, the rows of the grids are sorted in ascending order,
+ * and vice versa. Columns and rows without any grid of the type are not
+ * stored, so that the next column or row containing the type can be
+ * found by a binary search.
  *******************************************************************/
-static vtr::Point<size_t> find_grid_coordinate_given_type(
-  const DeviceGrid& grids,
-  const std::vector<vtr::Point<size_t>>& candidate_coords,
-  const std::string& wanted_grid_type_name) {
-  for (vtr::Point<size_t> coord : candidate_coords) {
-    /* If the next column is not longer in device range, we can return */
-    if (false == is_grid_coordinate_exist_in_device(grids, coord)) {
-      continue;
-    }
-    if (wanted_grid_type_name ==
-        std::string(
-          grids.get_physical_type(t_physical_tile_loc(coord.x(), coord.y(), 0))
-            ->name)) {
-      return coord;
+struct TileTypeGridIndex {
+  /* x -> sorted y of the grids in the column */
+  std::map<size_t, std::vector<size_t>> column_rows;
+  /* y -> sorted x of the grids in the row */
+  std::map<size_t, std::vector<size_t>> row_columns;
+};
+
+/* Indexes of the core grids for each physical tile type, by type name */
+typedef std::map<std::string, TileTypeGridIndex> TileGridIndex;
+
+/********************************************************************
+ * Index the core grids of a device by the name of their physical tile
+ * type. Tile names are compared only here rather than for each candidate
+ * coordinate when searching the directs
+ *******************************************************************/
+static TileGridIndex build_tile_grid_index(const DeviceGrid& grids) {
+  TileGridIndex grid_index;
+  /* Visit the grids in ascending order of x and then y, so that the lists
+   * are sorted without any extra effort */
+  for (size_t ix = 1; ix < grids.width() - 1; ++ix) {
+    for (size_t iy = 1; iy < grids.height() - 1; ++iy) {
+      TileTypeGridIndex& type_index = grid_index[std::string(
+        grids.get_physical_type(t_physical_tile_loc(ix, iy, 0))->name)];
+      type_index.column_rows[ix].push_back(iy);
+      type_index.row_columns[iy].push_back(ix);
     }
   }
-  /* Return an valid coordinate */
-  return vtr::Point<size_t>(grids.width(), grids.height());
+  return grid_index;
+}
+
+/********************************************************************
+ * Find the grid index of a physical tile type, or nullptr if the type
+ * does not appear in the core grids
+ *******************************************************************/
+static const TileTypeGridIndex* find_tile_type_grid_index(
+  const TileGridIndex& grid_index, const std::string& tile_type_name) {
+  auto result = grid_index.find(tile_type_name);
+  if (result == grid_index.end()) {
+    return nullptr;
+  }
+  return &(result->second);
+}
+
+/********************************************************************
+ * Find the first coordinate of a sorted list when searching from the
+ * lowest to the highest one or the other way around
+ *******************************************************************/
+static size_t find_first_sorted_coordinate(const std::vector<size_t>& coords,
+                                           const bool& search_from_lowest) {
+  VTR_ASSERT(false == coords.empty());
+  if (true == search_from_lowest) {
+    return coords.front();
+  }
+  return coords.back();
+}
+
+/********************************************************************
+ * Find the next column (or row) after a given one in a search direction,
+ * which contains at least one grid of the type
+ * Return the end of the list if there is none
+ *******************************************************************/
+static std::map<size_t, std::vector<size_t>>::const_iterator
+find_next_sorted_line(const std::map<size_t, std::vector<size_t>>& lines,
+                      const size_t& curr_line,
+                      const e_direct_direction& direction) {
+  if (POSITIVE_DIR == direction) {
+    return lines.upper_bound(curr_line);
+  }
+  VTR_ASSERT(NEGATIVE_DIR == direction);
+  auto result = lines.lower_bound(curr_line);
+  if (result == lines.begin()) {
+    return lines.end();
+  }
+  return std::prev(result);
 }
 
 /********************************************************************
  * Find the coordinate of the destination clb/heterogeneous block
  * considering intra column/row direct connections in core grids
+ *
+ * For cross-column connections, the search starts from the next column
+ * in the x-direction of the direct, and ends at the border of the fabric.
+ * The next column may NOT have the grid type we want!
+ * Think about heterogeneous architecture!
+ * In the first column containing the type, the grid is searched
+ * - from y = ny to y = 1 for positive y-direction
+ * - from y = 1 to y = ny for negative y-direction
+ *
+ *      x      ...      nx
+ *   +-----+
+ *   |Grid |  ----->
+ *   +-----+
+ *
+ * Cross-row connections are handled in the same way with the x- and
+ * y-directions swapped.
+ *
+ * Return an invalid coordinate if there is no such grid
  *******************************************************************/
 static vtr::Point<size_t> find_inter_direct_destination_coordinate(
   const DeviceGrid& grids, const vtr::Point<size_t>& src_coord,
-  const std::string des_tile_type_name, const ArchDirect& arch_direct,
+  const TileTypeGridIndex* des_type_index, const ArchDirect& arch_direct,
   const ArchDirectId& arch_direct_id) {
   vtr::Point<size_t> des_coord(grids.width(), grids.height());
-
-  std::vector<size_t> first_search_space;
-  std::vector<size_t> second_search_space;
-
-  /* Cross column connection from Bottom to Top on Right
-   * The next column may NOT have the grid type we want!
-   * Think about heterogeneous architecture!
-   * Our search space will start from the next column
-   * and ends at the RIGHT side of fabric
-   */
-  if (INTER_COLUMN == arch_direct.type(arch_direct_id)) {
-    if (POSITIVE_DIR == arch_direct.x_dir(arch_direct_id)) {
-      /* Our first search space will be in x-direction:
-       *
-       *      x      ...      nx
-       *   +-----+
-       *   |Grid |  ----->
-       *   +-----+
-       */
-      for (size_t ix = src_coord.x() + 1; ix < grids.width() - 1; ++ix) {
-        first_search_space.push_back(ix);
-      }
-    } else {
-      VTR_ASSERT(NEGATIVE_DIR == arch_direct.x_dir(arch_direct_id));
-      /* Our first search space will be in x-direction:
-       *
-       *    1   ...      x
-       *              +-----+
-       *     < -------|Grid |
-       *              +-----+
-       */
-      for (size_t ix = src_coord.x() - 1; ix >= 1; --ix) {
-        first_search_space.push_back(ix);
-      }
-    }
-
-    /* Our second search space will be in y-direction:
-     *
-     *  +------+
-     *  | Grid | ny
-     *  +------+
-     *     ^     .
-     *     |     .
-     *     |     .
-     *  +------+
-     *  | Grid | 1
-     *  +------+
-     */
-    for (size_t iy = 1; iy < grids.height() - 1; ++iy) {
-      second_search_space.push_back(iy);
-    }
-
-    /* For negative direction, our second search space will be in y-direction:
-     *
-     *  +------+
-     *  | Grid | ny
-     *  +------+
-     *     |     .
-     *     |     .
-     *     v     .
-     *  +------+
-     *  | Grid | 1
-     *  +------+
-     */
-    if (POSITIVE_DIR == arch_direct.y_dir(arch_direct_id)) {
-      std::reverse(second_search_space.begin(), second_search_space.end());
-    }
+  if (nullptr == des_type_index) {
+    return des_coord;
   }
 
-  /* Cross row connection from Bottom to Top on Right
-   * The next column may NOT have the grid type we want!
-   * Think about heterogeneous architecture!
-   * Our search space will start from the next column
-   * and ends at the RIGHT side of fabric
-   */
-  if (INTER_ROW == arch_direct.type(arch_direct_id)) {
-    if (POSITIVE_DIR == arch_direct.y_dir(arch_direct_id)) {
-      /* Our first search space will be in y-direction:
-       *
-       *  +------+
-       *  | Grid | ny
-       *  +------+
-       *     ^     .
-       *     |     .
-       *     |     .
-       *  +------+
-       *  | Grid | y
-       *  +------+
-       */
-      for (size_t iy = src_coord.y() + 1; iy < grids.height() - 1; ++iy) {
-        first_search_space.push_back(iy);
-      }
-    } else {
-      VTR_ASSERT(NEGATIVE_DIR == arch_direct.y_dir(arch_direct_id));
-      /* For negative y-direction,
-       * Our first search space will be in y-direction:
-       *
-       *  +------+
-       *  | Grid | ny
-       *  +------+
-       *     |     .
-       *     |     .
-       *     v     .
-       *  +------+
-       *  | Grid | y
-       *  +------+
-       */
-      for (size_t iy = src_coord.y() - 1; iy >= 1; --iy) {
-        first_search_space.push_back(iy);
-      }
-    }
-
-    /* Our second search space will be in x-direction:
-     *
-     *     1      ...     nx
-     *  +------+       +------+
-     *  | Grid |<------| Grid |
-     *  +------+       +------+
-     */
-    for (size_t ix = 1; ix < grids.width() - 1; ++ix) {
-      second_search_space.push_back(ix);
-    }
-
-    /* For negative direction,
-     * our second search space will be in x-direction:
-     *
-     *     1      ...     nx
-     *  +------+       +------+
-     *  | Grid |------>| Grid |
-     *  +------+       +------+
-     */
-    if (POSITIVE_DIR == arch_direct.x_dir(arch_direct_id)) {
-      std::reverse(second_search_space.begin(), second_search_space.end());
+  if (INTER_COLUMN == arch_direct.type(arch_direct_id)) {
+    auto des_column =
+      find_next_sorted_line(des_type_index->column_rows, src_coord.x(),
+                            arch_direct.x_dir(arch_direct_id));
+    if (des_column != des_type_index->column_rows.end()) {
+      des_coord.set_x(des_column->first);
+      des_coord.set_y(find_first_sorted_coordinate(
+        des_column->second,
+        NEGATIVE_DIR == arch_direct.y_dir(arch_direct_id)));
     }
+    return des_coord;
   }
 
-  for (size_t ix : first_search_space) {
-    std::vector<vtr::Point<size_t>> next_col_row_coords;
-    for (size_t iy : second_search_space) {
-      if (INTER_COLUMN == arch_direct.type(arch_direct_id)) {
-        next_col_row_coords.push_back(vtr::Point<size_t>(ix, iy));
-      } else {
-        VTR_ASSERT(INTER_ROW == arch_direct.type(arch_direct_id));
-        /* For cross-row connection, our search space is flipped */
-        next_col_row_coords.push_back(vtr::Point<size_t>(iy, ix));
-      }
-    }
-    vtr::Point<size_t> des_coord_cand = find_grid_coordinate_given_type(
-      grids, next_col_row_coords, des_tile_type_name);
-    /* For a valid coordinate, we can return */
-    if (true == is_grid_coordinate_exist_in_device(grids, des_coord_cand)) {
-      return des_coord_cand;
-    }
+  VTR_ASSERT(INTER_ROW == arch_direct.type(arch_direct_id));
+  auto des_row =
+    find_next_sorted_line(des_type_index->row_columns, src_coord.y(),
+                          arch_direct.y_dir(arch_direct_id));
+  if (des_row != des_type_index->row_columns.end()) {
+    des_coord.set_x(find_first_sorted_coordinate(
+      des_row->second, NEGATIVE_DIR == arch_direct.x_dir(arch_direct_id)));
+    des_coord.set_y(des_row->first);
   }
   return des_coord;
 }
@@ -531,8 +483,9 @@ static void build_inner_column_row_tile_direct(
  *******************************************************************/
 static void build_inter_column_row_tile_direct(
   TileDirect& tile_direct, const t_direct_inf& vpr_direct,
-  const DeviceContext& device_ctx, const ArchDirect& arch_direct,
-  const ArchDirectId& arch_direct_id, const bool& verbose) {
+  const DeviceContext& device_ctx, const TileGridIndex& grid_index,
+  const ArchDirect& arch_direct, const ArchDirectId& arch_direct_id,
+  const bool& verbose) {
   /* Get the source tile and pin information */
   std::string from_tile_name =
     parse_direct_tile_name(std::string(vpr_direct.from_pin));
@@ -553,6 +506,16 @@ static void build_inter_column_row_tile_direct(
       (INTER_ROW != arch_direct.type(arch_direct_id))) {
     return;
   }
+
+  /* Nothing to build if the source tile is not in the core grids */
+  const TileTypeGridIndex* from_type_index =
+    find_tile_type_grid_index(grid_index, from_tile_name);
+  if (nullptr == from_type_index) {
+    return;
+  }
+  const TileTypeGridIndex* to_type_index =
+    find_tile_type_grid_index(grid_index, to_tile_name);
+
   /* For cross-column connection, we will search the first valid grid in each
    * column from y = 1 to y = ny
    *
@@ -569,27 +532,14 @@ static void build_inter_column_row_tile_direct(
    *
    */
   if (INTER_COLUMN == arch_direct.type(arch_direct_id)) {
-    for (size_t ix = 1; ix < device_ctx.grid.width() - 1; ++ix) {
-      std::vector<vtr::Point<size_t>> next_col_src_grid_coords;
-      /* For negative y- direction, we should start from y = ny */
-      for (size_t iy = 1; iy < device_ctx.grid.height() - 1; ++iy) {
-        next_col_src_grid_coords.push_back(vtr::Point<size_t>(ix, iy));
-      }
-      /* For positive y- direction, we should start from y = 1 */
-      if (NEGATIVE_DIR == arch_direct.y_dir(arch_direct_id)) {
-        std::reverse(next_col_src_grid_coords.begin(),
-                     next_col_src_grid_coords.end());
-      }
-
-      /* Bypass the grid that does not fit the from_tile name */
-      vtr::Point<size_t> from_grid_coord = find_grid_coordinate_given_type(
-        device_ctx.grid, next_col_src_grid_coords, from_tile_name);
-      /* Skip if we do not have a valid coordinate for source CLB/heterogeneous
-       * block */
-      if (false == is_grid_coordinate_exist_in_device(device_ctx.grid,
-                                                      from_grid_coord)) {
-        continue;
-      }
+    /* Only the columns containing the source tile are visited */
+    for (const auto& column : from_type_index->column_rows) {
+      /* For positive y- direction, we should start from y = 1
+       * For negative y- direction, we should start from y = ny */
+      vtr::Point<size_t> from_grid_coord(
+        column.first,
+        find_first_sorted_coordinate(
+          column.second, POSITIVE_DIR == arch_direct.y_dir(arch_direct_id)));
 
       /* Search all the sides, the from pin may locate any side!
        * Note: the vpr_direct.from_side is NUM_SIDES, which is unintialized
@@ -613,7 +563,7 @@ static void build_inter_column_row_tile_direct(
          * clb */
         vtr::Point<size_t> to_grid_coord =
           find_inter_direct_destination_coordinate(
-            device_ctx.grid, from_grid_coord, to_tile_name, arch_direct,
+            device_ctx.grid, from_grid_coord, to_type_index, arch_direct,
             arch_direct_id);
         /* If destination clb is valid, we should add something */
         if (false == is_grid_coordinate_exist_in_device(device_ctx.grid,
@@ -681,26 +631,14 @@ static void build_inter_column_row_tile_direct(
    *   +------+               +------+
    *
    */
-  for (size_t iy = 1; iy < device_ctx.grid.height() - 1; ++iy) {
-    std::vector<vtr::Point<size_t>> next_col_src_grid_coords;
-    /* For negative x- direction, we should start from x = nx */
-    for (size_t ix = 1; ix < device_ctx.grid.width() - 1; ++ix) {
-      next_col_src_grid_coords.push_back(vtr::Point<size_t>(ix, iy));
-    }
-    /* For positive x- direction, we should start from x = 1 */
-    if (POSITIVE_DIR == arch_direct.x_dir(arch_direct_id)) {
-      std::reverse(next_col_src_grid_coords.begin(),
-                   next_col_src_grid_coords.end());
-    }
-
-    vtr::Point<size_t> from_grid_coord = find_grid_coordinate_given_type(
-      device_ctx.grid, next_col_src_grid_coords, from_tile_name);
-    /* Skip if we do not have a valid coordinate for source CLB/heterogeneous
-     * block */
-    if (false ==
-        is_grid_coordinate_exist_in_device(device_ctx.grid, from_grid_coord)) {
-      continue;
-    }
+  /* Only the rows containing the source tile are visited */
+  for (const auto& row : from_type_index->row_columns) {
+    /* For negative x- direction, we should start from x = 1
+     * For positive x- direction, we should start from x = nx */
+    vtr::Point<size_t> from_grid_coord(
+      find_first_sorted_coordinate(
+        row.second, NEGATIVE_DIR == arch_direct.x_dir(arch_direct_id)),
+      row.first);
 
     /* Search all the sides, the from pin may locate any side!
      * Note: the vpr_direct.from_side is NUM_SIDES, which is unintialized
@@ -724,7 +662,7 @@ static void build_inter_column_row_tile_direct(
        * clb */
       vtr::Point<size_t> to_grid_coord =
         find_inter_direct_destination_coordinate(device_ctx.grid,
-                                                 from_grid_coord, to_tile_name,
+                                                 from_grid_coord, to_type_index,
                                                  arch_direct, arch_direct_id);
       /* If destination clb is valid, we should add something */
       if (false ==
@@ -792,6 +730,9 @@ TileDirect build_device_tile_direct(const DeviceContext& device_ctx,
 
   TileDirect tile_direct;
 
+  /* Index the grids once for all the directs */
+  TileGridIndex grid_index = build_tile_grid_index(device_ctx.grid);
+
   /* Walk through each direct definition in the VPR arch */
   for (int idirect = 0; idirect < device_ctx.arch->num_directs; ++idirect) {
     ArchDirectId arch_direct_id =
@@ -809,8 +750,8 @@ TileDirect build_device_tile_direct(const DeviceContext& device_ctx,
                                        device_ctx, arch_direct_id, verbose);
     /* Build from OpenFPGA arch definition */
     build_inter_column_row_tile_direct(
-      tile_direct, device_ctx.arch->Directs[idirect], device_ctx, arch_direct,
-      arch_direct_id, verbose);
+      tile_direct, device_ctx.arch->Directs[idirect], device_ctx, grid_index,
+      arch_direct, arch_direct_id, verbose);
   }
 
   VTR_LOG(
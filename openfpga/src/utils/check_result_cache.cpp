@@ -0,0 +1,139 @@
+/********************************************************************
+ * This file includes functions to record the checks which have passed
+ * in a cache file, so that the checks on the same inputs can be skipped
+ * by later runs.
+ *
+ * A cache file contains a magic word, the format version, and the keys of
+ * the checks passed. A key is computed by the caller from all the inputs
+ * of a check, which should include the version of OpenFPGA.
+ * Keys are appended to the file, which never contains a failed check
+ *******************************************************************/
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+
+/* Headers from vtrutil library */
+#include "vtr_log.h"
+
+/* Headers from openfpgautil library */
+#include "check_result_cache.h"
+#include "command_exit_codes.h"
+#include "openfpga_binary_io.h"
+#include "openfpga_digest.h"
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+/* Identify the type of file; change the version whenever the content of the
+ * file changes */
+constexpr char CHECK_RESULT_CACHE_MAGIC[] = "OFPGACHK";
+constexpr size_t CHECK_RESULT_CACHE_MAGIC_SIZE =
+  sizeof(CHECK_RESULT_CACHE_MAGIC) - 1;
+constexpr uint32_t CHECK_RESULT_CACHE_VERSION = 1;
+
+/********************************************************************
+ * Hash the content of a file, which is a part of the key of the checks on
+ * the data read from the file.
+ * Return 0 if the file can not be read
+ *******************************************************************/
+size_t find_file_content_hash(const std::string& fname) {
+  std::ifstream fp(fname, std::ifstream::in | std::ifstream::binary);
+  if (false == fp.is_open()) {
+    return 0;
+  }
+  std::stringstream content;
+  content << fp.rdbuf();
+  return std::hash<std::string>()(content.str());
+}
+
+/********************************************************************
+ * Identify if the check with a given key has passed before.
+ * A missing or invalid cache file is considered as empty
+ *******************************************************************/
+bool find_check_result_cache(const std::string& fname, const size_t& key) {
+  std::fstream fp;
+  fp.open(fname, std::fstream::in | std::fstream::binary);
+  if (false == valid_file_stream(fp)) {
+    return false;
+  }
+
+  char magic[CHECK_RESULT_CACHE_MAGIC_SIZE];
+  uint32_t version = 0;
+  fp.read(magic, CHECK_RESULT_CACHE_MAGIC_SIZE);
+  read_binary_data(fp, version);
+  if ((false == fp.good()) ||
+      (0 != std::memcmp(magic, CHECK_RESULT_CACHE_MAGIC,
+                        CHECK_RESULT_CACHE_MAGIC_SIZE)) ||
+      (CHECK_RESULT_CACHE_VERSION != version)) {
+    return false;
+  }
+
+  uint64_t cached_key = 0;
+  while (true) {
+    read_binary_data(fp, cached_key);
+    if (false == fp.good()) {
+      return false;
+    }
+    if (uint64_t(key) == cached_key) {
+      return true;
+    }
+  }
+}
+
+/********************************************************************
+ * Record that the check with a given key has passed. The cache file is
+ * created when it is missing or invalid
+ *
+ * Return 0 if successful
+ * Return 1 if fail when writing the file
+ *******************************************************************/
+int write_check_result_cache(const std::string& fname, const size_t& key) {
+  /* Validate the header of the existing file */
+  bool valid_cache = false;
+  {
+    std::fstream fp;
+    fp.open(fname, std::fstream::in | std::fstream::binary);
+    if (true == valid_file_stream(fp)) {
+      char magic[CHECK_RESULT_CACHE_MAGIC_SIZE];
+      uint32_t version = 0;
+      fp.read(magic, CHECK_RESULT_CACHE_MAGIC_SIZE);
+      read_binary_data(fp, version);
+      valid_cache = fp.good() &&
+                    (0 == std::memcmp(magic, CHECK_RESULT_CACHE_MAGIC,
+                                      CHECK_RESULT_CACHE_MAGIC_SIZE)) &&
+                    (CHECK_RESULT_CACHE_VERSION == version);
+    }
+  }
+
+  std::fstream fp;
+  if (true == valid_cache) {
+    fp.open(fname,
+            std::fstream::out | std::fstream::app | std::fstream::binary);
+  } else {
+    create_directory(format_dir_path(find_path_dir_name(fname)));
+    fp.open(fname,
+            std::fstream::out | std::fstream::trunc | std::fstream::binary);
+  }
+  if (false == valid_file_stream(fp)) {
+    VTR_LOG_ERROR("Fail to open check result cache '%s'!\n", fname.c_str());
+    return CMD_EXEC_FATAL_ERROR;
+  }
+
+  if (false == valid_cache) {
+    fp.write(CHECK_RESULT_CACHE_MAGIC, CHECK_RESULT_CACHE_MAGIC_SIZE);
+    write_binary_data(fp, CHECK_RESULT_CACHE_VERSION);
+  }
+  write_binary_data(fp, uint64_t(key));
+
+  if (false == fp.good()) {
+    VTR_LOG_ERROR("Fail to write check result cache '%s'!\n", fname.c_str());
+    fp.close();
+    return CMD_EXEC_FATAL_ERROR;
+  }
+  fp.close();
+
+  return CMD_EXEC_SUCCESS;
+}
+
+} /* end namespace openfpga */
@@ -0,0 +1,24 @@
+#ifndef CHECK_RESULT_CACHE_H
+#define CHECK_RESULT_CACHE_H
+
+/********************************************************************
+ * Include header files that are required by function declaration
+ *******************************************************************/
+#include <string>
+
+/********************************************************************
+ * Function declaration
+ *******************************************************************/
+
+/* begin namespace openfpga */
+namespace openfpga {
+
+size_t find_file_content_hash(const std::string& fname);
+
+bool find_check_result_cache(const std::string& fname, const size_t& key);
+
+int write_check_result_cache(const std::string& fname, const size_t& key);
+
+} /* end namespace openfpga */
+
+#endif
@@ -15,6 +15,8 @@
 /* Headers from openfpgautil library */
 #include "fabric_bitstream_utils.h"
 #include "openfpga_decode.h"
+#include "openfpga_hash.h"
+#include "openfpga_parallel.h"
 #include "openfpga_reserved_words.h"
 
 /* begin namespace openfpga */
@@ -98,18 +100,22 @@ size_t find_configuration_chain_fabric_bitstream_size_to_be_skipped(
  *   Region 1:     00000011010101 <- shorter bitstream than the max.; add zeros
  *to the head Region 2:   0010101111000110 <- shorter bitstream than the max.;
  *add zeros to the head
+ *
+ * The regions are independent, so that they are built by a pool of threads
  *******************************************************************/
 ConfigChainFabricBitstream build_config_chain_fabric_bitstream_by_region(
   const BitstreamManager& bitstream_manager,
-  const FabricBitstream& fabric_bitstream) {
+  const FabricBitstream& fabric_bitstream, const size_t& num_threads) {
   /* Find the longest bitstream */
   size_t regional_bitstream_max_size =
     find_fabric_regional_bitstream_max_size(fabric_bitstream);
 
-  ConfigChainFabricBitstream regional_bitstreams;
-  regional_bitstreams.reserve(fabric_bitstream.regions().size());
-  for (const FabricBitRegionId& region : fabric_bitstream.regions()) {
-    std::vector<bool> curr_regional_bitstream;
+  std::vector<FabricBitRegionId> regions(fabric_bitstream.regions().begin(),
+                                         fabric_bitstream.regions().end());
+  ConfigChainFabricBitstream regional_bitstreams(regions.size());
+  parallel_for(regions.size(), num_threads, [&](const size_t& iregion) {
+    const FabricBitRegionId& region = regions[iregion];
+    std::vector<bool>& curr_regional_bitstream = regional_bitstreams[iregion];
     curr_regional_bitstream.resize(regional_bitstream_max_size, false);
     /* Starting index should consider the offset between the current bitstream
      * size and the maximum size of regional bitstream
@@ -122,11 +128,76 @@ ConfigChainFabricBitstream build_config_chain_fabric_bitstream_by_region(
       offset++;
     }
     VTR_ASSERT(offset == regional_bitstream_max_size);
+  });
+  return regional_bitstreams;
+}
+
+/********************************************************************
+ * Group the bits of a fabric bitstream for frame-based protocol by their
+ * encoded addresses, where the don't care bits of addresses are expanded.
+ * Comparing the encoded words is much cheaper than comparing the addresses
+ * as strings
+ *******************************************************************/
+typedef std::map<std::vector<uint64_t>, std::vector<bool>>
+  FrameFabricBitstreamByCode;
 
-    /* Add the adapt sub-bitstream */
-    regional_bitstreams.push_back(curr_regional_bitstream);
+static FrameFabricBitstreamByCode
+build_frame_based_fabric_bitstream_by_address_code(
+  const FabricBitstream& fabric_bitstream, size_t& address_size) {
+  FrameFabricBitstreamByCode fabric_bits_by_code;
+  address_size = 0;
+
+  std::vector<uint64_t> addr_code;
+  std::vector<std::pair<size_t, uint64_t>> dont_care_bits;
+  for (const FabricBitRegionId& region : fabric_bitstream.regions()) {
+    for (const FabricBitId& bit_id : fabric_bitstream.region_bits(region)) {
+      FabricBitAddressView addr = fabric_bitstream.bit_address_view(bit_id);
+      address_size = addr.size();
+
+      /* Find all the don't care bits */
+      addr_code.resize(addr.num_words());
+      dont_care_bits.clear();
+      for (size_t iword = 0; iword < addr.num_words(); ++iword) {
+        addr_code[iword] = addr.word_1bits(iword);
+        uint64_t xbits = addr.word_xbits(iword);
+        while (0 != xbits) {
+          uint64_t lowest_xbit = xbits & (~xbits + 1);
+          dont_care_bits.push_back(std::make_pair(iword, lowest_xbit));
+          xbits ^= lowest_xbit;
+        }
+      }
+      VTR_ASSERT(dont_care_bits.size() < 64);
+
+      /* Expand all the don't care bits */
+      for (uint64_t icomb = 0; icomb < (uint64_t(1) << dont_care_bits.size());
+           ++icomb) {
+        for (size_t ixbit = 0; ixbit < dont_care_bits.size(); ++ixbit) {
+          const std::pair<size_t, uint64_t>& xbit = dont_care_bits[ixbit];
+          if ((icomb >> ixbit) & 1) {
+            addr_code[xbit.first] |= xbit.second;
+          } else {
+            addr_code[xbit.first] &= ~xbit.second;
+          }
+        }
+        /* Place the config bit */
+        auto result = fabric_bits_by_code.find(addr_code);
+        if (result == fabric_bits_by_code.end()) {
+          /* This is a new bit, resize the vector to the number of regions
+           * and deposit '0' to all the bits
+           */
+          result =
+            fabric_bits_by_code
+              .emplace(addr_code,
+                       std::vector<bool>(fabric_bitstream.regions().size(),
+                                         false))
+              .first;
+        }
+        result->second[size_t(region)] = fabric_bitstream.bit_din(bit_id);
+      }
+    }
   }
-  return regional_bitstreams;
+
+  return fabric_bits_by_code;
 }
 
 /********************************************************************
@@ -141,34 +212,22 @@ ConfigChainFabricBitstream build_config_chain_fabric_bitstream_by_region(
  *******************************************************************/
 FrameFabricBitstream build_frame_based_fabric_bitstream_by_address(
   const FabricBitstream& fabric_bitstream) {
-  FrameFabricBitstream fabric_bits_by_addr;
-  for (const FabricBitRegionId& region : fabric_bitstream.regions()) {
-    for (const FabricBitId& bit_id : fabric_bitstream.region_bits(region)) {
-      /* Create string for address */
-      std::string addr_str;
-      for (const char& addr_bit : fabric_bitstream.bit_address(bit_id)) {
-        addr_str.push_back(addr_bit);
-      }
+  size_t address_size = 0;
+  FrameFabricBitstreamByCode fabric_bits_by_code =
+    build_frame_based_fabric_bitstream_by_address_code(fabric_bitstream,
+                                                       address_size);
 
-      /* Expand all the don't care bits */
-      for (const std::string& curr_addr_str :
-           expand_dont_care_bin_str(addr_str)) {
-        /* Place the config bit */
-        auto result = fabric_bits_by_addr.find(curr_addr_str);
-        if (result == fabric_bits_by_addr.end()) {
-          /* This is a new bit, resize the vector to the number of regions
-           * and deposit '0' to all the bits
-           */
-          fabric_bits_by_addr[curr_addr_str] =
-            std::vector<bool>(fabric_bitstream.regions().size(), false);
-          fabric_bits_by_addr[curr_addr_str][size_t(region)] =
-            fabric_bitstream.bit_din(bit_id);
-        } else {
-          VTR_ASSERT_SAFE(result != fabric_bits_by_addr.end());
-          result->second[size_t(region)] = fabric_bitstream.bit_din(bit_id);
-        }
+  /* Decode the addresses, where the first bit of an address is the LSB of
+   * its first word */
+  FrameFabricBitstream fabric_bits_by_addr;
+  for (auto& code_din_pair : fabric_bits_by_code) {
+    std::string addr_str(address_size, '0');
+    for (size_t ibit = 0; ibit < address_size; ++ibit) {
+      if ((code_din_pair.first[ibit / 64] >> (ibit % 64)) & 1) {
+        addr_str[ibit] = '1';
       }
     }
+    fabric_bits_by_addr.emplace(addr_str, std::move(code_din_pair.second));
   }
 
   return fabric_bits_by_addr;
@@ -191,12 +250,14 @@ FrameFabricBitstream build_frame_based_fabric_bitstream_by_address(
  *******************************************************************/
 size_t find_frame_based_fast_configuration_fabric_bitstream_size(
   const FabricBitstream& fabric_bitstream, const bool& bit_value_to_skip) {
-  FrameFabricBitstream fabric_bits_by_addr =
-    build_frame_based_fabric_bitstream_by_address(fabric_bitstream);
+  size_t address_size = 0;
+  FrameFabricBitstreamByCode fabric_bits_by_code =
+    build_frame_based_fabric_bitstream_by_address_code(fabric_bitstream,
+                                                       address_size);
 
   size_t num_bits = 0;
 
-  for (const auto& addr_din_pair : fabric_bits_by_addr) {
+  for (const auto& addr_din_pair : fabric_bits_by_code) {
     bool skip_curr_bits = true;
     for (const bool& bit : addr_din_pair.second) {
       if (bit_value_to_skip != bit) {
@@ -229,16 +290,12 @@ MemoryBankFabricBitstream build_memory_bank_fabric_bitstream_by_address(
   for (const FabricBitRegionId& region : fabric_bitstream.regions()) {
     for (const FabricBitId& bit_id : fabric_bitstream.region_bits(region)) {
       /* Create string for BL address */
-      std::string bl_addr_str;
-      for (const char& addr_bit : fabric_bitstream.bit_bl_address(bit_id)) {
-        bl_addr_str.push_back(addr_bit);
-      }
+      std::string bl_addr_str =
+        fabric_bitstream.bit_bl_address_view(bit_id).to_string();
 
       /* Create string for WL address */
-      std::string wl_addr_str;
-      for (const char& addr_bit : fabric_bitstream.bit_wl_address(bit_id)) {
-        wl_addr_str.push_back(addr_bit);
-      }
+      std::string wl_addr_str =
+        fabric_bitstream.bit_wl_address_view(bit_id).to_string();
 
       /* Place the config bit */
       auto result =
@@ -273,14 +330,12 @@ MemoryBankFlattenFabricBitstream build_memory_bank_flatten_fabric_bitstream(
     for (const FabricBitRegionId& region : fabric_bitstream.regions()) {
       for (const FabricBitId& bit_id : fabric_bitstream.region_bits(region)) {
         /* Create string for BL address with complete don't care bits */
-        std::string bl_addr_str(fabric_bitstream.bit_bl_address(bit_id).size(),
-                                dont_care_bit);
+        std::string bl_addr_str(
+          fabric_bitstream.bit_bl_address_view(bit_id).size(), dont_care_bit);
 
         /* Create string for WL address */
-        std::string wl_addr_str;
-        for (const char& addr_bit : fabric_bitstream.bit_wl_address(bit_id)) {
-          wl_addr_str.push_back(addr_bit);
-        }
+        std::string wl_addr_str =
+          fabric_bitstream.bit_wl_address_view(bit_id).to_string();
 
         /* Deposit the config bit */
         fabric_bits_per_region[region][wl_addr_str] = bl_addr_str;
@@ -296,10 +351,8 @@ MemoryBankFlattenFabricBitstream build_memory_bank_flatten_fabric_bitstream(
   for (const FabricBitRegionId& region : fabric_bitstream.regions()) {
     for (const FabricBitId& bit_id : fabric_bitstream.region_bits(region)) {
       /* Create string for BL address */
-      std::string bl_addr_str;
-      for (const char& addr_bit : fabric_bitstream.bit_bl_address(bit_id)) {
-        bl_addr_str.push_back(addr_bit);
-      }
+      std::string bl_addr_str =
+        fabric_bitstream.bit_bl_address_view(bit_id).to_string();
 
       /* If this bit should be programmed to 0, convert the 1s in BL to 0s  */
       if (fabric_bitstream.bit_din(bit_id) == bit_value_to_skip) {
@@ -307,10 +360,8 @@ MemoryBankFlattenFabricBitstream build_memory_bank_flatten_fabric_bitstream(
       }
 
       /* Create string for WL address */
-      std::string wl_addr_str;
-      for (const char& addr_bit : fabric_bitstream.bit_wl_address(bit_id)) {
-        wl_addr_str.push_back(addr_bit);
-      }
+      std::string wl_addr_str =
+        fabric_bitstream.bit_wl_address_view(bit_id).to_string();
 
       /* Place the config bit */
       auto result = fabric_bits_per_region[region].find(wl_addr_str);
@@ -392,161 +443,113 @@ MemoryBankFlattenFabricBitstream build_memory_bank_flatten_fabric_bitstream(
 }
 
 /********************************************************************
- * Reshape a list of vectors by aligning all of them to the first element
- * For example:
- * - Align vectors to the last element
- *
- *   index ---------------------->
- *   vector 0: 000000001111101010
- *   vector 1:     00000011010101
- *   vector 2:   0010101111000110
- *
- * - Fill void in each vector with desired bits (Here assume fill 'x'
- *   index ---------------------->
- *   vector 0: 000000001111101010
- *   vector 1: 00000011010101xxxx
- *   vector 2: 0010101111000110xx
- *
- * - Rotate the array by 90 degree
- *   index ----------------------->
- *   vector 0: 000
- *   vector 1: 000
- *   vector 2: 001
- *   ...
- *   vector N: 0xx
- *
+ * Find the locations of the bits of the BL vector of a configuration region
+ * in the shift register banks. A location is the index in a column-major
+ * matrix, where each column is a shift register bank and each row is a data
+ * line of the banks.
+ * The locations do not depend on the bitstream words, so they are computed
+ * once and only extended when a longer vector is met.
  *******************************************************************/
-static std::vector<std::string> reshape_bitstream_vectors_to_first_element(
-  const std::vector<std::string>& bitstream_vectors,
-  const char& default_bit_to_fill) {
-  /* Find the max sizes of BL bits, this determines the size of shift register
-   * chain */
-  size_t max_vec_size = 0;
-  for (const auto& vec : bitstream_vectors) {
-    max_vec_size = std::max(max_vec_size, vec.size());
-  }
-  /* Reshape the BL vectors */
-  std::vector<std::string> reshaped_vectors(bitstream_vectors.size(),
-                                            std::string());
-  size_t col_cnt = 0;
-  for (const auto& vec : bitstream_vectors) {
-    reshaped_vectors[col_cnt] += vec;
-    reshaped_vectors[col_cnt] +=
-      std::string(max_vec_size - vec.size(), default_bit_to_fill);
-    col_cnt++;
-  }
-
-  /* Add the BL word to final bitstream */
-  std::vector<std::string> rotated_vectors;
-  for (size_t irow = 0; irow < max_vec_size; ++irow) {
-    std::string cur_vec;
-    for (size_t icol = 0; icol < reshaped_vectors.size(); ++icol) {
-      cur_vec.push_back(reshaped_vectors[icol][irow]);
-    }
-    rotated_vectors.push_back(cur_vec);
-  }
-
-  return rotated_vectors;
-}
-
-/** @brief Split each BL vector in a configuration region into multiple shift
- * register banks For example Original vector: 1xxx010xxx1 Resulting vector (2
- * register register banks): 1xxx0 10xxx1
- */
-static std::vector<std::string> redistribute_bl_vectors_to_shift_register_banks(
-  const std::vector<std::string> bl_vectors,
+static void update_bl_shift_register_bank_bit_locations(
+  std::vector<size_t>& bit_locations,
   const MemoryBankShiftRegisterBanks& blwl_sr_banks,
-  const char& dont_care_bit) {
-  std::vector<std::string> multi_bank_bl_vec;
-
-  /* Resize the vector by counting the dimension */
-  /* Compute the start index of each region */
-  vtr::vector<ConfigRegionId, size_t> region_start_index;
-  region_start_index.resize(blwl_sr_banks.regions().size(), 0);
-  size_t total_num_banks = 0;
-  for (const auto& region : blwl_sr_banks.regions()) {
-    region_start_index[region] = total_num_banks;
-    total_num_banks += blwl_sr_banks.bl_banks(region).size();
+  const ConfigRegionId& region, const size_t& region_start_index,
+  const size_t& max_bank_size, const size_t& num_bits) {
+  for (size_t ibit = bit_locations.size(); ibit < num_bits; ++ibit) {
+    /* Find the shift register bank id and the offset in data lines */
+    FabricBitLineBankId bank_id =
+      blwl_sr_banks.find_bl_shift_register_bank_id(region, ibit);
+    size_t sr_pin =
+      blwl_sr_banks.find_bl_shift_register_bank_data_pin(region, ibit);
+
+    size_t vec_index = region_start_index + size_t(bank_id);
+    bit_locations.push_back(vec_index * max_bank_size + sr_pin);
   }
-  multi_bank_bl_vec.resize(total_num_banks);
-
-  /* Resize each bank to be memory efficient */
-  size_t vec_start_index = 0;
-  for (const auto& region : blwl_sr_banks.regions()) {
-    for (const auto& bank : blwl_sr_banks.bl_banks(region)) {
-      size_t bank_size = blwl_sr_banks.bl_bank_size(region, bank);
-      multi_bank_bl_vec[vec_start_index].resize(bank_size, dont_care_bit);
-      vec_start_index++;
-    }
-  }
-
-  for (const std::string& region_bl_vec : bl_vectors) {
-    ConfigRegionId region = ConfigRegionId(&region_bl_vec - &bl_vectors[0]);
-    for (size_t ibit = 0; ibit < region_bl_vec.size(); ++ibit) {
-      /* Find the shift register bank id and the offset in data lines */
-      BasicPort bl_port(std::string(MEMORY_BL_PORT_NAME), ibit, ibit);
-      FabricBitLineBankId bank_id =
-        blwl_sr_banks.find_bl_shift_register_bank_id(region, bl_port);
-      BasicPort sr_port =
-        blwl_sr_banks.find_bl_shift_register_bank_data_port(region, bl_port);
-      VTR_ASSERT(1 == sr_port.get_width());
-
-      size_t vec_index = region_start_index[region] + size_t(bank_id);
-      multi_bank_bl_vec[vec_index][sr_port.get_lsb()] = region_bl_vec[ibit];
-    }
-  }
-
-  return multi_bank_bl_vec;
 }
 
-/** @brief Split each WL vector in a configuration region into multiple shift
- * register banks For example Original vector: 1xxx010xxx1 Resulting vector (2
- * register register banks): 1xxx0 10xxx1
- */
-static std::vector<std::string> redistribute_wl_vectors_to_shift_register_banks(
-  const std::vector<std::string> wl_vectors,
+/********************************************************************
+ * Find the locations of the bits of the WL vector of a configuration region
+ * in the shift register banks. See the BL counterpart for details
+ *******************************************************************/
+static void update_wl_shift_register_bank_bit_locations(
+  std::vector<size_t>& bit_locations,
   const MemoryBankShiftRegisterBanks& blwl_sr_banks,
-  const char& dont_care_bit) {
-  std::vector<std::string> multi_bank_wl_vec;
-
-  /* Resize the vector by counting the dimension */
-  /* Compute the start index of each region */
-  vtr::vector<ConfigRegionId, size_t> region_start_index;
-  region_start_index.resize(blwl_sr_banks.regions().size(), 0);
-  size_t total_num_banks = 0;
-  for (const auto& region : blwl_sr_banks.regions()) {
-    region_start_index[region] = total_num_banks;
-    total_num_banks += blwl_sr_banks.wl_banks(region).size();
-  }
-  multi_bank_wl_vec.resize(total_num_banks);
-
-  /* Resize each bank to be memory efficient */
-  size_t vec_start_index = 0;
-  for (const auto& region : blwl_sr_banks.regions()) {
-    for (const auto& bank : blwl_sr_banks.wl_banks(region)) {
-      size_t bank_size = blwl_sr_banks.wl_bank_size(region, bank);
-      multi_bank_wl_vec[vec_start_index].resize(bank_size, dont_care_bit);
-      vec_start_index++;
-    }
+  const ConfigRegionId& region, const size_t& region_start_index,
+  const size_t& max_bank_size, const size_t& num_bits) {
+  for (size_t ibit = bit_locations.size(); ibit < num_bits; ++ibit) {
+    /* Find the shift register bank id and the offset in data lines */
+    FabricWordLineBankId bank_id =
+      blwl_sr_banks.find_wl_shift_register_bank_id(region, ibit);
+    size_t sr_pin =
+      blwl_sr_banks.find_wl_shift_register_bank_data_pin(region, ibit);
+
+    size_t vec_index = region_start_index + size_t(bank_id);
+    bit_locations.push_back(vec_index * max_bank_size + sr_pin);
   }
+}
 
-  for (const std::string& region_wl_vec : wl_vectors) {
-    ConfigRegionId region = ConfigRegionId(&region_wl_vec - &wl_vectors[0]);
-    for (size_t ibit = 0; ibit < region_wl_vec.size(); ++ibit) {
-      /* Find the shift register bank id and the offset in data lines */
-      BasicPort wl_port(std::string(MEMORY_WL_PORT_NAME), ibit, ibit);
-      FabricWordLineBankId bank_id =
-        blwl_sr_banks.find_wl_shift_register_bank_id(region, wl_port);
-      BasicPort sr_port =
-        blwl_sr_banks.find_wl_shift_register_bank_data_port(region, wl_port);
-      VTR_ASSERT(1 == sr_port.get_width());
-
-      size_t vec_index = region_start_index[region] + size_t(bank_id);
-      multi_bank_wl_vec[vec_index][sr_port.get_lsb()] = region_wl_vec[ibit];
+/********************************************************************
+ * Transpose the bits of shift register banks into the vectors to be loaded
+ * through the heads of the banks. For example:
+ * - Bits of each bank, where the void of short banks are filled with
+ *   don't care bits
+ *
+ *   data line ---------------------->
+ *   bank 0: 000000001111101010
+ *   bank 1: 00000011010101xxxx
+ *   bank 2: 0010101111000110xx
+ *
+ * - Rotate the array by 90 degree and reverse the order of vectors, due to
+ *   the first-in first-out nature of shift registers
+ *   bank ----->
+ *   vector 0: 0xx
+ *   ...
+ *   vector N-2: 000
+ *   vector N-1: 000
+ *
+ * The banks are stored in a column-major matrix of characters. Each vector
+ * is packed into blocks of 64 bits, with a value and a care mask per block.
+ * The transpose is done by tiles of 64 x 64 bits, so that both the source
+ * and the destination of a tile stay in cache.
+ *******************************************************************/
+static void transpose_shift_register_bank_bits(
+  const std::vector<char>& bank_bits, const size_t& num_banks,
+  const size_t& max_bank_size, std::vector<uint64_t>& vector_values,
+  std::vector<uint64_t>& vector_care_masks) {
+  size_t num_blocks = (num_banks + 63) / 64;
+  vector_values.assign(max_bank_size * num_blocks, 0);
+  vector_care_masks.assign(max_bank_size * num_blocks, 0);
+
+  uint64_t tile_values[64];
+  uint64_t tile_care_masks[64];
+  for (size_t row_start = 0; row_start < max_bank_size; row_start += 64) {
+    size_t row_end = std::min(row_start + 64, max_bank_size);
+    for (size_t iblock = 0; iblock < num_blocks; ++iblock) {
+      size_t col_start = iblock * 64;
+      size_t col_end = std::min(col_start + 64, num_banks);
+      std::fill(tile_values, tile_values + 64, 0);
+      std::fill(tile_care_masks, tile_care_masks + 64, 0);
+      for (size_t icol = col_start; icol < col_end; ++icol) {
+        const char* col_bits = bank_bits.data() + icol * max_bank_size;
+        uint64_t mask = uint64_t(1) << (icol - col_start);
+        for (size_t irow = row_start; irow < row_end; ++irow) {
+          if ('1' == col_bits[irow]) {
+            tile_values[irow - row_start] |= mask;
+            tile_care_masks[irow - row_start] |= mask;
+          } else if ('0' == col_bits[irow]) {
+            tile_care_masks[irow - row_start] |= mask;
+          }
+        }
+      }
+      for (size_t irow = row_start; irow < row_end; ++irow) {
+        size_t vec_index = max_bank_size - 1 - irow;
+        vector_values[vec_index * num_blocks + iblock] =
+          tile_values[irow - row_start];
+        vector_care_masks[vec_index * num_blocks + iblock] =
+          tile_care_masks[irow - row_start];
+      }
     }
   }
-
-  return multi_bank_wl_vec;
 }
 
 MemoryBankShiftRegisterFabricBitstream
@@ -561,6 +564,43 @@ build_memory_bank_shift_register_fabric_bitstream(
     build_memory_bank_flatten_fabric_bitstream(
       fabric_bitstream, fast_configuration, bit_value_to_skip, dont_care_bit);
   MemoryBankShiftRegisterFabricBitstream fabric_bits;
+  fabric_bits.set_dont_care_bit(dont_care_bit);
+
+  /* Compute the start index of each region among the banks, as well as the
+   * max. size of banks, which determines the length of shift register chain */
+  vtr::vector<ConfigRegionId, size_t> bl_region_start_index(
+    blwl_sr_banks.regions().size(), 0);
+  vtr::vector<ConfigRegionId, size_t> wl_region_start_index(
+    blwl_sr_banks.regions().size(), 0);
+  size_t num_bl_banks = 0;
+  size_t num_wl_banks = 0;
+  size_t max_bl_bank_size = 0;
+  size_t max_wl_bank_size = 0;
+  for (const auto& region : blwl_sr_banks.regions()) {
+    bl_region_start_index[region] = num_bl_banks;
+    num_bl_banks += blwl_sr_banks.bl_banks(region).size();
+    for (const auto& bank : blwl_sr_banks.bl_banks(region)) {
+      max_bl_bank_size =
+        std::max(max_bl_bank_size, blwl_sr_banks.bl_bank_size(region, bank));
+    }
+    wl_region_start_index[region] = num_wl_banks;
+    num_wl_banks += blwl_sr_banks.wl_banks(region).size();
+    for (const auto& bank : blwl_sr_banks.wl_banks(region)) {
+      max_wl_bank_size =
+        std::max(max_wl_bank_size, blwl_sr_banks.wl_bank_size(region, bank));
+    }
+  }
+
+  vtr::vector<ConfigRegionId, std::vector<size_t>> bl_bit_locations(
+    blwl_sr_banks.regions().size());
+  vtr::vector<ConfigRegionId, std::vector<size_t>> wl_bit_locations(
+    blwl_sr_banks.regions().size());
+
+  /* Buffers reused across words */
+  std::vector<char> bl_bank_bits(num_bl_banks * max_bl_bank_size);
+  std::vector<char> wl_bank_bits(num_wl_banks * max_wl_bank_size);
+  std::vector<uint64_t> vector_values;
+  std::vector<uint64_t> vector_care_masks;
 
   /* Iterate over each word */
   for (const auto& wl_vec : raw_fabric_bits.wl_vectors()) {
@@ -570,35 +610,61 @@ build_memory_bank_shift_register_fabric_bitstream(
       fabric_bits.create_word();
 
     /* Redistribute the BL vector to multiple banks */
-    std::vector<std::string> multi_bank_bl_vec =
-      redistribute_bl_vectors_to_shift_register_banks(bl_vec, blwl_sr_banks,
-                                                      dont_care_bit);
-
-    std::vector<std::string> reshaped_bl_vectors =
-      reshape_bitstream_vectors_to_first_element(multi_bank_bl_vec,
-                                                 dont_care_bit);
-    /* Reverse the vectors due to the shift register chain nature: first-in
-     * first-out */
-    std::reverse(reshaped_bl_vectors.begin(), reshaped_bl_vectors.end());
+    std::fill(bl_bank_bits.begin(), bl_bank_bits.end(), dont_care_bit);
+    for (size_t iregion = 0; iregion < bl_vec.size(); ++iregion) {
+      ConfigRegionId region = ConfigRegionId(iregion);
+      const std::string& region_bl_vec = bl_vec[iregion];
+      update_bl_shift_register_bank_bit_locations(
+        bl_bit_locations[region], blwl_sr_banks, region,
+        bl_region_start_index[region], max_bl_bank_size, region_bl_vec.size());
+      const std::vector<size_t>& locations = bl_bit_locations[region];
+      for (size_t ibit = 0; ibit < region_bl_vec.size(); ++ibit) {
+        bl_bank_bits[locations[ibit]] = region_bl_vec[ibit];
+      }
+    }
+
     /* Add the BL word to final bitstream */
-    for (const auto& reshaped_bl_vec : reshaped_bl_vectors) {
-      fabric_bits.add_bl_vectors(word_id, reshaped_bl_vec);
+    transpose_shift_register_bank_bits(bl_bank_bits, num_bl_banks,
+                                       max_bl_bank_size, vector_values,
+                                       vector_care_masks);
+    size_t num_bl_blocks = (num_bl_banks + 63) / 64;
+    fabric_bits.resize_bl_vectors(word_id, max_bl_bank_size, num_bl_banks);
+    for (size_t ivec = 0; ivec < max_bl_bank_size; ++ivec) {
+      for (size_t iblock = 0; iblock < num_bl_blocks; ++iblock) {
+        size_t offset = ivec * num_bl_blocks + iblock;
+        fabric_bits.set_bl_vector_block(word_id, ivec, iblock,
+                                        vector_values[offset],
+                                        vector_care_masks[offset]);
+      }
     }
 
     /* Redistribute the WL vector to multiple banks */
-    std::vector<std::string> multi_bank_wl_vec =
-      redistribute_wl_vectors_to_shift_register_banks(wl_vec, blwl_sr_banks,
-                                                      dont_care_bit);
-
-    std::vector<std::string> reshaped_wl_vectors =
-      reshape_bitstream_vectors_to_first_element(multi_bank_wl_vec,
-                                                 dont_care_bit);
-    /* Reverse the vectors due to the shift register chain nature: first-in
-     * first-out */
-    std::reverse(reshaped_wl_vectors.begin(), reshaped_wl_vectors.end());
-    /* Add the BL word to final bitstream */
-    for (const auto& reshaped_wl_vec : reshaped_wl_vectors) {
-      fabric_bits.add_wl_vectors(word_id, reshaped_wl_vec);
+    std::fill(wl_bank_bits.begin(), wl_bank_bits.end(), dont_care_bit);
+    for (size_t iregion = 0; iregion < wl_vec.size(); ++iregion) {
+      ConfigRegionId region = ConfigRegionId(iregion);
+      const std::string& region_wl_vec = wl_vec[iregion];
+      update_wl_shift_register_bank_bit_locations(
+        wl_bit_locations[region], blwl_sr_banks, region,
+        wl_region_start_index[region], max_wl_bank_size, region_wl_vec.size());
+      const std::vector<size_t>& locations = wl_bit_locations[region];
+      for (size_t ibit = 0; ibit < region_wl_vec.size(); ++ibit) {
+        wl_bank_bits[locations[ibit]] = region_wl_vec[ibit];
+      }
+    }
+
+    /* Add the WL word to final bitstream */
+    transpose_shift_register_bank_bits(wl_bank_bits, num_wl_banks,
+                                       max_wl_bank_size, vector_values,
+                                       vector_care_masks);
+    size_t num_wl_blocks = (num_wl_banks + 63) / 64;
+    fabric_bits.resize_wl_vectors(word_id, max_wl_bank_size, num_wl_banks);
+    for (size_t ivec = 0; ivec < max_wl_bank_size; ++ivec) {
+      for (size_t iblock = 0; iblock < num_wl_blocks; ++iblock) {
+        size_t offset = ivec * num_wl_blocks + iblock;
+        fabric_bits.set_wl_vector_block(word_id, ivec, iblock,
+                                        vector_values[offset],
+                                        vector_care_masks[offset]);
+      }
     }
   }
 
@@ -644,4 +710,65 @@ size_t find_memory_bank_fast_configuration_fabric_bitstream_size(
   return num_bits;
 }
 
+/********************************************************************
+ * Find a hash of the values of the bits of a configuration region, in the
+ * order of the bits in the region. The values are the data inputs when the
+ * protocol uses addresses, otherwise they are found in the bitstream
+ * database. Two bitstreams of the same fabric whose regions have the same
+ * hash are very likely to configure the regions in the same way, so that
+ * the region can be skipped, e.g., in partial reconfiguration.
+ * The bits are packed by 64 before being hashed
+ *******************************************************************/
+size_t find_fabric_bitstream_region_hash(
+  const FabricBitstream& fabric_bitstream,
+  const BitstreamManager& bitstream_manager, const FabricBitRegionId& region) {
+  VTR_ASSERT(true == fabric_bitstream.valid_region_id(region));
+  bool use_din = fabric_bitstream.use_address();
+
+  size_t hash = 0;
+  uint64_t word = 0;
+  size_t num_bits = 0;
+  for (const FabricBitId& bit_id : fabric_bitstream.region_bits(region)) {
+    bool bit_value = false;
+    if (true == use_din) {
+      bit_value = (0 != fabric_bitstream.bit_din(bit_id));
+    } else {
+      bit_value =
+        bitstream_manager.bit_value(fabric_bitstream.config_bit(bit_id));
+    }
+    word |= uint64_t(bit_value) << (num_bits % 64);
+    num_bits++;
+    if (0 == num_bits % 64) {
+      hash_combine<uint64_t>(hash, word);
+      word = 0;
+    }
+  }
+  if (0 != num_bits % 64) {
+    hash_combine<uint64_t>(hash, word);
+  }
+  hash_combine<size_t>(hash, num_bits);
+
+  return hash;
+}
+
+/********************************************************************
+ * Check if a configurable child of the top-level module, with a given
+ * coordinate, is covered by any of the regions of a partial bitstream.
+ * The bounds of each region are included. If no region is given, the whole
+ * fabric is considered, so that any child is covered
+ *******************************************************************/
+bool is_configurable_child_in_regions(
+  const vtr::Point<int>& child_coord,
+  const std::vector<vtr::Rect<int>>& child_regions) {
+  if (true == child_regions.empty()) {
+    return true;
+  }
+  for (const vtr::Rect<int>& child_region : child_regions) {
+    if (true == child_region.coincident(child_coord)) {
+      return true;
+    }
+  }
+  return false;
+}
+
 } /* end namespace openfpga */
@@ -16,6 +16,7 @@
 #include "memory_bank_flatten_fabric_bitstream.h"
 #include "memory_bank_shift_register_banks.h"
 #include "memory_bank_shift_register_fabric_bitstream.h"
+#include "vtr_geometry.h"
 
 /********************************************************************
  * Function declaration
@@ -38,7 +39,7 @@ size_t find_configuration_chain_fabric_bitstream_size_to_be_skipped(
 typedef std::vector<std::vector<bool>> ConfigChainFabricBitstream;
 ConfigChainFabricBitstream build_config_chain_fabric_bitstream_by_region(
   const BitstreamManager& bitstream_manager,
-  const FabricBitstream& fabric_bitstream);
+  const FabricBitstream& fabric_bitstream, const size_t& num_threads = 1);
 
 /* Alias to a specific organization of bitstreams for frame-based configuration
  * protocol */
@@ -118,6 +119,14 @@ MemoryBankFabricBitstream build_memory_bank_fabric_bitstream_by_address(
 size_t find_memory_bank_fast_configuration_fabric_bitstream_size(
   const FabricBitstream& fabric_bitstream, const bool& bit_value_to_skip);
 
+size_t find_fabric_bitstream_region_hash(
+  const FabricBitstream& fabric_bitstream,
+  const BitstreamManager& bitstream_manager, const FabricBitRegionId& region);
+
+bool is_configurable_child_in_regions(
+  const vtr::Point<int>& child_coord,
+  const std::vector<vtr::Rect<int>>& child_regions);
+
 } /* end namespace openfpga */
 
 #endif
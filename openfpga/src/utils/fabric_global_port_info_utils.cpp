@@ -89,8 +89,12 @@ bool port_is_fabric_global_reset_port(
     top_module = core_module;
   }
 
+  /* Port names are unique in a module, so only the global ports created
+   * from the port with the same name can be mergeable */
+  ModulePortId module_port =
+    module_manager.find_module_port(top_module, port.get_name());
   for (const FabricGlobalPortId& fabric_global_port_id :
-       fabric_global_port_info.global_ports()) {
+       fabric_global_port_info.find_module_port_global_ports(module_port)) {
     if ((false ==
          fabric_global_port_info.global_port_is_reset(fabric_global_port_id)) ||
         (true ==
@@ -98,9 +102,8 @@ bool port_is_fabric_global_reset_port(
       continue;
     }
 
-    BasicPort module_global_port = module_manager.module_port(
-      top_module,
-      fabric_global_port_info.global_module_port(fabric_global_port_id));
+    BasicPort module_global_port =
+      module_manager.module_port(top_module, module_port);
     if ((true == module_global_port.mergeable(port)) &&
         (true == module_global_port.contained(port))) {
       return true;
@@ -132,11 +135,14 @@ FabricGlobalPortId find_fabric_global_port(
     top_module = core_module;
   }
 
+  /* Port names are unique in a module, so only the global ports created
+   * from the port with the same name can be mergeable */
+  ModulePortId module_port =
+    module_manager.find_module_port(top_module, port.get_name());
   for (const FabricGlobalPortId& fabric_global_port_id :
-       fabric_global_port_info.global_ports()) {
-    BasicPort module_global_port = module_manager.module_port(
-      top_module,
-      fabric_global_port_info.global_module_port(fabric_global_port_id));
+       fabric_global_port_info.find_module_port_global_ports(module_port)) {
+    BasicPort module_global_port =
+      module_manager.module_port(top_module, module_port);
     if ((true == module_global_port.mergeable(port)) &&
         (true == module_global_port.contained(port))) {
       return fabric_global_port_id;
@@ -2,6 +2,7 @@
  * This file includes most utilized functions to manipulate LUTs,
  * especially their truth tables, in the OpenFPGA context
  *******************************************************************/
+#include <algorithm>
 #include <cmath>
 
 /* Headers from vtrutil library */
@@ -264,176 +265,165 @@ bool lut_truth_table_use_on_set(const AtomNetlist::TruthTable& truth_table) {
 }
 
 /********************************************************************
- * Complete a line in truth table with a given lut size
- * Due to the size of truth table may be less than the lut size.
- * i.e. in LUT-6 architecture, there exists LUT1-6 in technology-mapped netlists
- * So, in truth table line, there may be 10- 1
- * In this case, we should complete it by --10- 1
+ * Bit patterns of the inputs of a 6-input truth table in a 64-bit word:
+ * bit i of a pattern is 1 when the bit of the input is 1 in the index i
  *******************************************************************/
-static std::vector<vtr::LogicValue> complete_truth_table_line(
-  const size_t& lut_size, const std::vector<vtr::LogicValue>& tt_line) {
-  std::vector<vtr::LogicValue> ret;
+constexpr size_t LUT_MASK_WORD_INPUTS = 6;
+constexpr size_t LUT_MASK_WORD_BITS = 64;
+constexpr uint64_t LUT_MASK_INPUT_PATTERNS[LUT_MASK_WORD_INPUTS] = {
+  0xAAAAAAAAAAAAAAAAULL, 0xCCCCCCCCCCCCCCCCULL, 0xF0F0F0F0F0F0F0F0ULL,
+  0xFF00FF00FF00FF00ULL, 0xFFFF0000FFFF0000ULL, 0xFFFFFFFF00000000ULL};
 
-  VTR_ASSERT(0 < tt_line.size());
-
-  /* Complete the truth table line*/
-  size_t cover_len = tt_line.size() - 1;
-  VTR_ASSERT(cover_len <= lut_size);
-
-  /* Copy the original truth table line */
-  ret = tt_line;
-  /* Kick out the last value for now as it is the output value */
-  ret.pop_back();
-
-  /* Add the number of '-' we should add in the back !!! */
-  for (size_t j = cover_len; j < lut_size; ++j) {
-    ret.push_back(vtr::LogicValue::DONT_CARE);
+/********************************************************************
+ * Pack a truth table into 64-bit words, which is the bitstream of a
+ * single-output LUT with the same number of inputs.
+ * As truth tables may come from different logic blocks, truth tables could be
+ * in on and off sets. We first build base words, where all the bits are set to
+ * the opposite of the on/off set, and then apply the truth table lines one by
+ * one in their sequence.
+ * A line covers a cube of the truth table. The inputs in the first 6 positions
+ * select bits inside a word, which are set at once with a bit pattern, while
+ * don't cares in the other positions select a number of words.
+ * Truth table lines which are shorter than others are completed with don't
+ * cares, e.g., in a LUT-6 architecture, a line '10- 1' from a LUT-3 is
+ * considered as '10---- 1'
+ *******************************************************************/
+LutTruthTableMask build_lut_truth_table_mask(
+  const AtomNetlist::TruthTable& truth_table) {
+  LutTruthTableMask tt_mask;
+  if (0 == truth_table.size()) {
+    return tt_mask;
   }
 
-  /* Copy the original truth table line */
-  ret.push_back(tt_line.back());
-
-  /* Check if the size of ret matches our expectation */
-  VTR_ASSERT(lut_size + 1 == ret.size());
-
-  return ret;
-}
+  for (const std::vector<vtr::LogicValue>& tt_line : truth_table) {
+    VTR_ASSERT(0 < tt_line.size());
+    tt_mask.num_inputs = std::max(tt_mask.num_inputs, tt_line.size() - 1);
+  }
+  size_t num_words = 1;
+  if (LUT_MASK_WORD_INPUTS < tt_mask.num_inputs) {
+    num_words = size_t(1) << (tt_mask.num_inputs - LUT_MASK_WORD_INPUTS);
+  }
 
-/********************************************************************
- * For each lut_bit_lines, we should recover the truth table,
- * and then set the sram bits to "1" if the truth table defines so.
- * Start_point: the position we start converting don't care sign '-'
- *              to explicit '0' or '1'
- *******************************************************************/
-static void rec_build_lut_bitstream_per_line(
-  std::vector<bool>& lut_bitstream, const size_t& lut_size,
-  const std::vector<vtr::LogicValue>& tt_line, const size_t& start_point) {
-  std::vector<vtr::LogicValue> temp_line = tt_line;
-
-  /* Check the length of sram bits and truth table line */
-  VTR_ASSERT(lut_size + 1 == tt_line.size()); /* lut_size + '1|0' */
-
-  /* End of truth_table_line should be "space" and "1" */
-  VTR_ASSERT((vtr::LogicValue::TRUE == tt_line.back()) ||
-             (vtr::LogicValue::FALSE == tt_line.back()));
-
-  /* Make sure before start point there is no '-' */
-  VTR_ASSERT(start_point < tt_line.size());
-  for (size_t i = 0; i < start_point; ++i) {
-    VTR_ASSERT(vtr::LogicValue::DONT_CARE != tt_line[i]);
+  /* By default, the bits are initialized for on_set. For off set, it should be
+   * flipped */
+  uint64_t base_word = 0;
+  if (false == lut_truth_table_use_on_set(truth_table)) {
+    base_word = ~uint64_t(0);
   }
+  tt_mask.words.resize(num_words, base_word);
 
-  /* Configure sram bits recursively */
-  for (size_t i = start_point; i < lut_size; ++i) {
-    if (vtr::LogicValue::DONT_CARE == tt_line[i]) {
-      /* if we find a dont_care, we don't do configure now but recursively*/
-      /* '0' branch */
-      temp_line[i] = vtr::LogicValue::FALSE;
-      rec_build_lut_bitstream_per_line(lut_bitstream, lut_size, temp_line,
-                                       start_point + 1);
-      /* '1' branch */
-      temp_line[i] = vtr::LogicValue::TRUE;
-      rec_build_lut_bitstream_per_line(lut_bitstream, lut_size, temp_line,
-                                       start_point + 1);
-      return;
+  for (const std::vector<vtr::LogicValue>& tt_line : truth_table) {
+    /* The bits inside a word, and the fixed and don't care bits of word
+     * indices */
+    uint64_t word_pattern = ~uint64_t(0);
+    size_t fixed_word_bits = 0;
+    size_t dont_care_word_bits = 0;
+    for (size_t i = 0; i < tt_mask.num_inputs; ++i) {
+      vtr::LogicValue value = vtr::LogicValue::DONT_CARE;
+      if (i < tt_line.size() - 1) {
+        value = tt_line[i];
+      }
+      /* We assume the 1-lut pass sram1 when input = 0, and sram0 when
+       * input = 1 */
+      bool index_bit = false;
+      switch (value) {
+        case vtr::LogicValue::FALSE:
+          index_bit = true;
+          break;
+        case vtr::LogicValue::TRUE:
+          index_bit = false;
+          break;
+        case vtr::LogicValue::DONT_CARE:
+          if (LUT_MASK_WORD_INPUTS <= i) {
+            dont_care_word_bits |= size_t(1) << (i - LUT_MASK_WORD_INPUTS);
+          }
+          continue;
+        default:
+          VTR_LOGF_ERROR(__FILE__, __LINE__,
+                         "Invalid truth_table bit '%s', should be [0|1|]!\n",
+                         vtr::LOGIC_VALUE_STRING[size_t(value)]);
+          exit(1);
+      }
+      if (i < LUT_MASK_WORD_INPUTS) {
+        word_pattern &= index_bit ? LUT_MASK_INPUT_PATTERNS[i]
+                                  : ~LUT_MASK_INPUT_PATTERNS[i];
+      } else if (true == index_bit) {
+        fixed_word_bits |= size_t(1) << (i - LUT_MASK_WORD_INPUTS);
+      }
     }
-  }
 
-  /* TODO: Use MuxGraph to decode this!!! */
-  /* Decode bitstream only when there are only 0 or 1 in the truth table */
-  size_t sram_id = 0;
-  for (size_t i = 0; i < lut_size; ++i) {
-    /* Should be either '0' or '1' */
-    switch (tt_line[i]) {
-      case vtr::LogicValue::FALSE:
-        /* We assume the 1-lut pass sram1 when input = 0 */
-        sram_id += (size_t)pow(2., (double)(i));
-        break;
-      case vtr::LogicValue::TRUE:
-        /* We assume the 1-lut pass sram0 when input = 1 */
+    /* Walk through all the subsets of the don't care bits of word indices */
+    bool on_value = (vtr::LogicValue::TRUE == tt_line.back());
+    size_t dont_care_bits = dont_care_word_bits;
+    while (true) {
+      uint64_t& word = tt_mask.words[fixed_word_bits | dont_care_bits];
+      if (true == on_value) {
+        word |= word_pattern;
+      } else {
+        word &= ~word_pattern;
+      }
+      if (0 == dont_care_bits) {
         break;
-      case vtr::LogicValue::DONT_CARE:
-      default:
-        VTR_LOGF_ERROR(__FILE__, __LINE__,
-                       "Invalid truth_table bit '%s', should be [0|1|]!\n",
-                       vtr::LOGIC_VALUE_STRING[size_t(tt_line[i])]);
-        exit(1);
+      }
+      dont_care_bits = (dont_care_bits - 1) & dont_care_word_bits;
     }
   }
-  /* Set the sram bit to '1'*/
-  VTR_ASSERT(sram_id < lut_bitstream.size());
-  if (vtr::LogicValue::TRUE == tt_line.back()) {
-    lut_bitstream[sram_id] = true; /* on set*/
-  } else if (vtr::LogicValue::FALSE == tt_line.back()) {
-    lut_bitstream[sram_id] = false; /* off set */
-  } else {
-    VTR_LOGF_ERROR(__FILE__, __LINE__,
-                   "Invalid truth_table_line ending '%s'!\n",
-                   vtr::LOGIC_VALUE_STRING[size_t(tt_line.back())]);
-    exit(1);
-  }
+
+  return tt_mask;
 }
 
 /********************************************************************
- * Generate the bitstream for a single-output LUT with a given truth table
- * As truth tables may come from different logic blocks, truth tables could be
- *in on and off sets We first build a base SRAM bits, where different parts are
- *set to tbe on/off sets Then, we can decode SRAM bits as regular process
+ * Find the word of a truth table mask which covers the bits of the k-th
+ * word of a LUT bitstream. The inputs which are not in the truth table are
+ * don't care, so that the bits repeat every 2^num_inputs. For a truth table
+ * with less than 6 inputs, its bits are replicated across the word
  *******************************************************************/
-static std::vector<bool> build_single_output_lut_bitstream(
-  const AtomNetlist::TruthTable& truth_table, const MuxGraph& lut_mux_graph,
+static uint64_t find_lut_truth_table_mask_word(
+  const LutTruthTableMask& tt_mask, const size_t& bitstream_word,
   const size_t& default_sram_bit_value) {
-  size_t lut_size = lut_mux_graph.num_memory_bits();
-  size_t bitstream_size = lut_mux_graph.num_inputs();
-  std::vector<bool> lut_bitstream(bitstream_size, false);
-  AtomNetlist::TruthTable completed_truth_table;
-  bool on_set = false;
-  bool off_set = false;
-
-  /* if No truth_table, do default*/
-  if (0 == truth_table.size()) {
-    switch (default_sram_bit_value) {
-      case 0:
-        on_set = true;
-        off_set = false;
-        break;
-      case 1:
-        on_set = false;
-        off_set = true;
-        break;
-      default:
-        VTR_LOGF_ERROR(__FILE__, __LINE__,
-                       "Invalid default_signal_init_value '%lu'!\n",
-                       default_sram_bit_value);
-        exit(1);
-    }
-  } else {
-    on_set = lut_truth_table_use_on_set(truth_table);
-    off_set = !on_set;
+  /* A truth table without any line is full of default values */
+  if (true == tt_mask.words.empty()) {
+    return (1 == default_sram_bit_value) ? ~uint64_t(0) : uint64_t(0);
   }
-
-  /* Read in truth table lines, decode one by one */
-  for (const std::vector<vtr::LogicValue>& tt_line : truth_table) {
-    /* Complete the truth table line by line*/
-    completed_truth_table.push_back(
-      complete_truth_table_line(lut_size, tt_line));
+  if (LUT_MASK_WORD_INPUTS <= tt_mask.num_inputs) {
+    return tt_mask.words[bitstream_word & (tt_mask.words.size() - 1)];
   }
-
-  /* Initial all the bits in the bitstream */
-  if (true == off_set) {
-    /* By default, the lut_bitstream is initialize for on_set
-     * For off set, it should be flipped
-     */
-    lut_bitstream.clear();
-    lut_bitstream.resize(bitstream_size, true);
+  size_t num_bits = size_t(1) << tt_mask.num_inputs;
+  uint64_t word = tt_mask.words[0] & ((uint64_t(1) << num_bits) - 1);
+  for (size_t shift = num_bits; shift < LUT_MASK_WORD_BITS; shift <<= 1) {
+    word |= word << shift;
   }
+  return word;
+}
 
-  for (const std::vector<vtr::LogicValue>& tt_line : completed_truth_table) {
-    /* Update the truth table, sram_bits */
-    rec_build_lut_bitstream_per_line(lut_bitstream, lut_size, tt_line, 0);
+/********************************************************************
+ * Copy the bits [offset, offset + length) of a truth table mask to a LUT
+ * bitstream which is packed into 64-bit words, word by word
+ *******************************************************************/
+static void write_lut_truth_table_mask_to_bitstream(
+  std::vector<uint64_t>& bitstream_words, const size_t& offset,
+  const size_t& length, const LutTruthTableMask& tt_mask,
+  const size_t& default_sram_bit_value) {
+  if (0 == length) {
+    return;
+  }
+  size_t first_word = offset / LUT_MASK_WORD_BITS;
+  size_t last_word = (offset + length - 1) / LUT_MASK_WORD_BITS;
+  for (size_t iword = first_word; iword <= last_word; ++iword) {
+    /* Bits of the word to be written */
+    size_t word_start = iword * LUT_MASK_WORD_BITS;
+    size_t lsb = std::max(offset, word_start) - word_start;
+    size_t msb = std::min(offset + length, word_start + LUT_MASK_WORD_BITS) -
+                 word_start;
+    uint64_t write_bits = ~uint64_t(0) << lsb;
+    if (msb < LUT_MASK_WORD_BITS) {
+      write_bits &= (uint64_t(1) << msb) - 1;
+    }
+    uint64_t word =
+      find_lut_truth_table_mask_word(tt_mask, iword, default_sram_bit_value);
+    bitstream_words[iword] =
+      (bitstream_words[iword] & ~write_bits) | (word & write_bits);
   }
-
-  return lut_bitstream;
 }
 
 /********************************************************************
@@ -441,18 +431,34 @@ static std::vector<bool> build_single_output_lut_bitstream(
  *LUT) Check type of truth table of each mapped logical block if it is on-set,
  *we give a all 0 base bitstream if it is off-set, we give a all 1 base
  *bitstream
+ * The truth tables are packed by build_lut_truth_table_mask(), so that the
+ * bitstream is built in 64-bit words, which are written to a buffer given by
+ * the caller. Bit i of the bitstream is bit (i % 64) of word (i / 64). Bits
+ * beyond the size of the bitstream in the last word are not used
  *******************************************************************/
-std::vector<bool> build_frac_lut_bitstream(
-  const CircuitLibrary& circuit_lib, const MuxGraph& lut_mux_graph,
-  const VprDeviceAnnotation& device_annotation,
-  const std::map<const t_pb_graph_pin*, AtomNetlist::TruthTable>& truth_tables,
+void build_frac_lut_bitstream(
+  std::vector<uint64_t>& bitstream_words, const CircuitLibrary& circuit_lib,
+  const MuxGraph& lut_mux_graph, const VprDeviceAnnotation& device_annotation,
+  const std::map<const t_pb_graph_pin*, LutTruthTableMask>& truth_tables,
   const size_t& default_sram_bit_value) {
   /* Initialization */
-  std::vector<bool> lut_bitstream(lut_mux_graph.num_inputs(),
-                                  default_sram_bit_value);
+  size_t bitstream_size = lut_mux_graph.num_inputs();
+  bitstream_words.assign(
+    (bitstream_size + LUT_MASK_WORD_BITS - 1) / LUT_MASK_WORD_BITS,
+    (0 != default_sram_bit_value) ? ~uint64_t(0) : uint64_t(0));
+
+  for (const auto& element : truth_tables) {
+    const LutTruthTableMask& tt_mask = element.second;
+    /* A truth table without any line is full of default values */
+    if ((true == tt_mask.words.empty()) && (0 != default_sram_bit_value) &&
+        (1 != default_sram_bit_value)) {
+      VTR_LOGF_ERROR(__FILE__, __LINE__,
+                     "Invalid default_signal_init_value '%lu'!\n",
+                     default_sram_bit_value);
+      exit(1);
+    }
+    VTR_ASSERT(tt_mask.num_inputs <= lut_mux_graph.num_memory_bits());
 
-  for (std::pair<const t_pb_graph_pin*, AtomNetlist::TruthTable> element :
-       truth_tables) {
     /* Find the corresponding circuit model output port and assoicated
      * lut_output_mask */
     CircuitPortId lut_model_output_port =
@@ -470,10 +476,6 @@ std::vector<bool> build_frac_lut_bitstream(
     size_t lut_output_mask = circuit_lib.port_lut_output_mask(
       lut_model_output_port)[element.first->pin_number];
 
-    /* Decode lut sram bits */
-    std::vector<bool> temp_bitstream = build_single_output_lut_bitstream(
-      element.second, lut_mux_graph, default_sram_bit_value);
-
     /* Depending on the frac-level, we get the location(starting/end points) of
      * sram bits */
     size_t length_of_temp_bitstream_to_copy =
@@ -481,39 +483,36 @@ std::vector<bool> build_frac_lut_bitstream(
     size_t bitstream_offset =
       length_of_temp_bitstream_to_copy * lut_output_mask;
     /* Ensure the offset is in range */
-    VTR_ASSERT(bitstream_offset < lut_bitstream.size());
+    VTR_ASSERT(bitstream_offset < bitstream_size);
     VTR_ASSERT(bitstream_offset + length_of_temp_bitstream_to_copy <=
-               lut_bitstream.size());
-
-    /* Print debug information
-    bool verbose = true;
-    VTR_LOGV(verbose, "Full truth table\n");
-    for (const std::string& tt_line : truth_table_to_string(element.second)) {
-      VTR_LOGV(verbose, "\t%s\n", tt_line.c_str());
-    }
-    VTR_LOGV(verbose, "\n");
+               bitstream_size);
 
-    VTR_LOGV(verbose, "Bitstream (size = %ld)\n", temp_bitstream.size());
-    for (const bool& bit : temp_bitstream) {
-      if (true == bit) {
-        VTR_LOGV(verbose, "1");
-      } else {
-        VTR_ASSERT(false == bit);
-        VTR_LOGV(verbose, "0");
-      }
-    }
-    VTR_LOGV(verbose, "\n");
+    /* Copy to the segment of bitstream */
+    write_lut_truth_table_mask_to_bitstream(
+      bitstream_words, bitstream_offset, length_of_temp_bitstream_to_copy,
+      tt_mask, default_sram_bit_value);
+  }
+}
 
-    VTR_LOGV(verbose, "Bitstream offset = %d\n", bitstream_offset);
-    VTR_LOGV(verbose, "Bitstream length to be used = %d\n",
-    length_of_temp_bitstream_to_copy);
-     */
+/********************************************************************
+ * Generate bitstream for a fracturable LUT as a vector of bits
+ *******************************************************************/
+std::vector<bool> build_frac_lut_bitstream(
+  const CircuitLibrary& circuit_lib, const MuxGraph& lut_mux_graph,
+  const VprDeviceAnnotation& device_annotation,
+  const std::map<const t_pb_graph_pin*, LutTruthTableMask>& truth_tables,
+  const size_t& default_sram_bit_value) {
+  std::vector<uint64_t> bitstream_words;
+  build_frac_lut_bitstream(bitstream_words, circuit_lib, lut_mux_graph,
+                           device_annotation, truth_tables,
+                           default_sram_bit_value);
 
-    /* Copy to the segment of bitstream */
-    for (size_t bit = bitstream_offset;
-         bit < bitstream_offset + length_of_temp_bitstream_to_copy; ++bit) {
-      lut_bitstream[bit] = temp_bitstream[bit];
-    }
+  size_t bitstream_size = lut_mux_graph.num_inputs();
+  std::vector<bool> lut_bitstream(bitstream_size, false);
+  for (size_t bit = 0; bit < bitstream_size; ++bit) {
+    lut_bitstream[bit] = (bitstream_words[bit / LUT_MASK_WORD_BITS] >>
+                          (bit % LUT_MASK_WORD_BITS)) &
+                         1;
   }
 
   return lut_bitstream;
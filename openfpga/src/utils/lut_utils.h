@@ -9,6 +9,7 @@
 #include <vector>
 
 #include "atom_netlist.h"
+#include "lut_truth_table_mask.h"
 #include "mux_graph.h"
 #include "physical_types.h"
 #include "vpr_device_annotation.h"
@@ -36,10 +37,19 @@ AtomNetlist::TruthTable adapt_truth_table_for_frac_lut(
 
 bool lut_truth_table_use_on_set(const AtomNetlist::TruthTable& truth_table);
 
+LutTruthTableMask build_lut_truth_table_mask(
+  const AtomNetlist::TruthTable& truth_table);
+
+void build_frac_lut_bitstream(
+  std::vector<uint64_t>& bitstream_words, const CircuitLibrary& circuit_lib,
+  const MuxGraph& lut_mux_graph, const VprDeviceAnnotation& device_annotation,
+  const std::map<const t_pb_graph_pin*, LutTruthTableMask>& truth_tables,
+  const size_t& default_sram_bit_value);
+
 std::vector<bool> build_frac_lut_bitstream(
   const CircuitLibrary& circuit_lib, const MuxGraph& lut_mux_graph,
   const VprDeviceAnnotation& device_annotation,
-  const std::map<const t_pb_graph_pin*, AtomNetlist::TruthTable>& truth_tables,
+  const std::map<const t_pb_graph_pin*, LutTruthTableMask>& truth_tables,
   const size_t& default_sram_bit_value);
 
 bool is_wired_lut(const std::vector<AtomNetId>& input_nets,
@@ -43,24 +43,30 @@ static bool submodule_memory_modules_match_fabric_key(
       .configurable_children(module_id,
                              ModuleManager::e_config_child_type::PHYSICAL)
       .size();
-  size_t len_fabric_sub_key = fabric_key.sub_keys(key_module_id).size();
-  if (len_module_memory != len_fabric_sub_key) {
+  const std::vector<FabricSubKeyId>& fabric_sub_keys =
+    fabric_key.sub_keys(key_module_id);
+  if (len_module_memory != fabric_sub_keys.size()) {
     return false;
   }
+  ModuleInstanceNameLookup instance_lookup =
+    build_module_manager_instance_name_lookup(module_manager, module_id);
   /* Now walk through the child one by one */
   for (size_t ikey = 0; ikey < len_module_memory; ++ikey) {
-    FabricSubKeyId key_id = fabric_key.sub_keys(key_module_id)[ikey];
+    FabricSubKeyId key_id = fabric_sub_keys[ikey];
     std::pair<ModuleId, size_t> inst_info(ModuleId::INVALID(), 0);
     /* Try to match the alias */
     if (!fabric_key.sub_key_alias(key_id).empty()) {
       if (!fabric_key.sub_key_name(key_id).empty()) {
         inst_info.first =
           module_manager.find_module(fabric_key.sub_key_name(key_id));
-        inst_info.second = module_manager.instance_id(
-          module_id, inst_info.first, fabric_key.sub_key_alias(key_id));
+        if (true == module_manager.valid_module_id(inst_info.first)) {
+          inst_info.second = find_module_manager_instance_id(
+            module_manager, module_id, instance_lookup, inst_info.first,
+            fabric_key.sub_key_alias(key_id));
+        }
       } else {
         inst_info = find_module_manager_instance_module_info(
-          module_manager, module_id, fabric_key.sub_key_alias(key_id));
+          instance_lookup, fabric_key.sub_key_alias(key_id));
       }
     } else {
       inst_info.first =
@@ -90,6 +96,9 @@ static bool update_submodule_memory_modules_from_fabric_key(
   /* Reset the configurable children */
   module_manager.clear_configurable_children(module_id);
 
+  ModuleInstanceNameLookup instance_lookup =
+    build_module_manager_instance_name_lookup(module_manager, module_id);
+
   for (FabricSubKeyId key_id : fabric_key.sub_keys(key_module_id)) {
     std::pair<ModuleId, size_t> inst_info(ModuleId::INVALID(), 0);
     /* Try to match the alias */
@@ -97,11 +106,14 @@ static bool update_submodule_memory_modules_from_fabric_key(
       if (!fabric_key.sub_key_name(key_id).empty()) {
         inst_info.first =
           module_manager.find_module(fabric_key.sub_key_name(key_id));
-        inst_info.second = module_manager.instance_id(
-          module_id, inst_info.first, fabric_key.sub_key_alias(key_id));
+        if (true == module_manager.valid_module_id(inst_info.first)) {
+          inst_info.second = find_module_manager_instance_id(
+            module_manager, module_id, instance_lookup, inst_info.first,
+            fabric_key.sub_key_alias(key_id));
+        }
       } else {
         inst_info = find_module_manager_instance_module_info(
-          module_manager, module_id, fabric_key.sub_key_alias(key_id));
+          instance_lookup, fabric_key.sub_key_alias(key_id));
       }
     } else {
       inst_info.first =
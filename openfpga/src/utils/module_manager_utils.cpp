@@ -6,6 +6,7 @@
 #include <algorithm>
 #include <cmath>
 #include <map>
+#include <utility>
 
 /* Headers from vtrutil library */
 #include "command_exit_codes.h"
@@ -101,6 +102,36 @@ size_t count_module_manager_module_configurable_children(
   return num_config_children;
 }
 
+/******************************************************************************
+ * Find the modules which are instantiated, directly or not, under a top-level
+ * module, including the top-level module itself. The other modules are never
+ * used by the FPGA fabric, e.g., the memories of circuit models which are not
+ * used by any block, so that netlist writers can skip them.
+ * Each module is visited once, whatever its number of parents
+ ******************************************************************************/
+vtr::vector<ModuleId, bool> find_module_manager_used_modules(
+  const ModuleManager& module_manager, const ModuleId& top_module) {
+  VTR_ASSERT(true == module_manager.valid_module_id(top_module));
+
+  vtr::vector<ModuleId, bool> used_modules(module_manager.num_modules(),
+                                           false);
+  std::vector<ModuleId> modules_to_visit;
+  modules_to_visit.push_back(top_module);
+  used_modules[top_module] = true;
+  while (false == modules_to_visit.empty()) {
+    ModuleId module = modules_to_visit.back();
+    modules_to_visit.pop_back();
+    for (const ModuleId& child : module_manager.child_modules(module)) {
+      if (false == used_modules[child]) {
+        used_modules[child] = true;
+        modules_to_visit.push_back(child);
+      }
+    }
+  }
+
+  return used_modules;
+}
+
 /******************************************************************************
  * Find the module id and instance id in module manager with a given instance
  *name This function will exhaustively search all the child module under a given
@@ -127,6 +158,60 @@ std::pair<ModuleId, size_t> find_module_manager_instance_module_info(
   return instance_info;
 }
 
+/******************************************************************************
+ * Index the names of all the child instances under a given parent module, so
+ * that instances can be found by name without searching the child modules.
+ * When a name is shared by several instances, the first one in the order of
+ * the exhaustive search is kept
+ ******************************************************************************/
+ModuleInstanceNameLookup build_module_manager_instance_name_lookup(
+  const ModuleManager& module_manager, const ModuleId& parent) {
+  ModuleInstanceNameLookup instance_lookup;
+  for (const ModuleId& child : module_manager.child_modules(parent)) {
+    for (const size_t& child_instance :
+         module_manager.child_module_instances(parent, child)) {
+      std::string instance_name =
+        module_manager.instance_name(parent, child, child_instance);
+      if (true == instance_name.empty()) {
+        continue;
+      }
+      instance_lookup.emplace(std::move(instance_name),
+                              std::make_pair(child, child_instance));
+    }
+  }
+  return instance_lookup;
+}
+
+/******************************************************************************
+ * Find the module id and instance id with a given instance name from an index
+ * built by build_module_manager_instance_name_lookup()
+ ******************************************************************************/
+std::pair<ModuleId, size_t> find_module_manager_instance_module_info(
+  const ModuleInstanceNameLookup& instance_lookup,
+  const std::string& instance_name) {
+  auto result = instance_lookup.find(instance_name);
+  if (result == instance_lookup.end()) {
+    return std::pair<ModuleId, size_t>(ModuleId::INVALID(), 0);
+  }
+  return result->second;
+}
+
+/******************************************************************************
+ * Find the instance id of a child module with a given instance name, using an
+ * index built by build_module_manager_instance_name_lookup(). Fall back to the
+ * search in the module manager when the name is indexed for another child
+ ******************************************************************************/
+size_t find_module_manager_instance_id(
+  const ModuleManager& module_manager, const ModuleId& parent,
+  const ModuleInstanceNameLookup& instance_lookup, const ModuleId& child,
+  const std::string& instance_name) {
+  auto result = instance_lookup.find(instance_name);
+  if ((result != instance_lookup.end()) && (child == result->second.first)) {
+    return result->second.second;
+  }
+  return module_manager.instance_id(parent, child, instance_name);
+}
+
 /******************************************************************************
  * Add a module to the module manager based on the circuit-level
  * description of a circuit model
@@ -158,6 +243,8 @@ ModuleId add_circuit_model_to_module_manager(
   } else {
     module_manager.set_module_usage(module, ModuleManager::MODULE_HARD_IP);
   }
+  module_manager.set_module_circuit_model(
+    module, circuit_lib.model_name(circuit_model));
 
   /* Add ports */
   /* Find global ports and add one by one
@@ -2239,11 +2326,13 @@ void add_module_global_input_ports_from_child_modules(
 
   /* Iterate over the child modules */
   for (const ModuleId& child : module_manager.child_modules(module_id)) {
+    /* Find all the global ports, whose port type is special */
+    std::vector<BasicPort> child_global_ports =
+      module_manager.module_ports_by_type(child,
+                                          ModuleManager::MODULE_GLOBAL_PORT);
     /* Iterate over the child instances */
     for (size_t i = 0; i < module_manager.num_instance(module_id, child); ++i) {
-      /* Find all the global ports, whose port type is special */
-      for (BasicPort global_port : module_manager.module_ports_by_type(
-             child, ModuleManager::MODULE_GLOBAL_PORT)) {
+      for (const BasicPort& global_port : child_global_ports) {
         /* Search in the global port list to be added, if this is unique, we
          * update the list */
         std::vector<BasicPort>::iterator it = std::find(
@@ -9,6 +9,7 @@
  * Include header files that are required by function declaration
  *******************************************************************/
 #include <tuple>
+#include <unordered_map>
 #include <vector>
 
 /* Headers from readarch library */
@@ -33,6 +34,11 @@
 /* begin namespace openfpga */
 namespace openfpga {
 
+/* The module id and instance id of each named child instance under a parent
+ * module, indexed by instance name */
+typedef std::unordered_map<std::string, std::pair<ModuleId, size_t>>
+  ModuleInstanceNameLookup;
+
 constexpr std::array<ModuleManager::e_module_port_type, 3>
   MODULE_IO_PORT_TYPES = {ModuleManager::MODULE_GPIN_PORT,
                           ModuleManager::MODULE_GPOUT_PORT,
@@ -45,10 +51,25 @@ size_t count_module_manager_module_configurable_children(
   const ModuleManager& module_manager, const ModuleId& module,
   const ModuleManager::e_config_child_type& config_child_type);
 
+vtr::vector<ModuleId, bool> find_module_manager_used_modules(
+  const ModuleManager& module_manager, const ModuleId& top_module);
+
 std::pair<ModuleId, size_t> find_module_manager_instance_module_info(
   const ModuleManager& module_manager, const ModuleId& parent,
   const std::string& instance_name);
 
+ModuleInstanceNameLookup build_module_manager_instance_name_lookup(
+  const ModuleManager& module_manager, const ModuleId& parent);
+
+std::pair<ModuleId, size_t> find_module_manager_instance_module_info(
+  const ModuleInstanceNameLookup& instance_lookup,
+  const std::string& instance_name);
+
+size_t find_module_manager_instance_id(
+  const ModuleManager& module_manager, const ModuleId& parent,
+  const ModuleInstanceNameLookup& instance_lookup, const ModuleId& child,
+  const std::string& instance_name);
+
 ModuleId add_circuit_model_to_module_manager(
   ModuleManager& module_manager, const CircuitLibrary& circuit_lib,
   const CircuitModelId& circuit_model, const std::string& module_name);
@@ -167,6 +167,84 @@ t_pb_type* try_find_pb_type_with_given_path(
   return nullptr;
 }
 
+/********************************************************************
+ * Generate the key of a pb_type in the path index, which consists of the
+ * names of the pb_types and the modes from the top-level pb_type down to
+ * the pb_type, in an interleaved way. The names are separated by null
+ * characters, which never appear in names, so that any key is unique
+ *******************************************************************/
+static std::string generate_pb_type_path_key(
+  const std::vector<std::string>& pb_type_names,
+  const std::vector<std::string>& pb_mode_names) {
+  VTR_ASSERT_SAFE(pb_type_names.size() == pb_mode_names.size() + 1);
+  std::string key = pb_type_names[0];
+  for (size_t i = 0; i < pb_mode_names.size(); ++i) {
+    key.push_back('\0');
+    key += pb_mode_names[i];
+    key.push_back('\0');
+    key += pb_type_names[i + 1];
+  }
+  return key;
+}
+
+/********************************************************************
+ * Add a pb_type as well as all the pb_types under its modes to the
+ * path index. The first pb_type is kept for a key, same as the search
+ * in try_find_pb_type_with_given_path()
+ *******************************************************************/
+static void rec_build_pb_type_path_index(PbTypePathIndex& pb_type_path_index,
+                                         t_pb_type* cur_pb_type,
+                                         const std::string& cur_key) {
+  pb_type_path_index.emplace(cur_key, cur_pb_type);
+  for (int imode = 0; imode < cur_pb_type->num_modes; ++imode) {
+    t_mode* cur_mode = &(cur_pb_type->modes[imode]);
+    std::string mode_key = cur_key;
+    mode_key.push_back('\0');
+    mode_key += cur_mode->name;
+    mode_key.push_back('\0');
+    for (int ichild = 0; ichild < cur_mode->num_pb_type_children; ++ichild) {
+      t_pb_type* child_pb_type = &(cur_mode->pb_type_children[ichild]);
+      rec_build_pb_type_path_index(pb_type_path_index, child_pb_type,
+                                   mode_key + child_pb_type->name);
+    }
+  }
+}
+
+/********************************************************************
+ * Index all the pb_types of the logical blocks by their full paths,
+ * so that the pb_types can be found with a single look-up rather than
+ * walking through the pb_type graph repeatedly
+ *******************************************************************/
+PbTypePathIndex build_pb_type_path_index(
+  const std::vector<t_logical_block_type>& logical_block_types) {
+  PbTypePathIndex pb_type_path_index;
+  for (const t_logical_block_type& lb_type : logical_block_types) {
+    /* By pass nullptr for pb_type head */
+    if (nullptr == lb_type.pb_type) {
+      continue;
+    }
+    rec_build_pb_type_path_index(pb_type_path_index, lb_type.pb_type,
+                                 std::string(lb_type.pb_type->name));
+  }
+  return pb_type_path_index;
+}
+
+/********************************************************************
+ * Find a pb_type with a given name as well as its hierarchy in the path
+ * index. Return nullptr if not found
+ *******************************************************************/
+t_pb_type* find_pb_type_in_path_index(
+  const PbTypePathIndex& pb_type_path_index,
+  const std::vector<std::string>& target_pb_type_names,
+  const std::vector<std::string>& target_pb_mode_names) {
+  auto result = pb_type_path_index.find(
+    generate_pb_type_path_key(target_pb_type_names, target_pb_mode_names));
+  if (result == pb_type_path_index.end()) {
+    return nullptr;
+  }
+  return result->second;
+}
+
 /********************************************************************
  * This function will return all the interconnects defined under a mode
  * of pb_type
@@ -5,6 +5,7 @@
  * Include header files that are required by function declaration
  *******************************************************************/
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "circuit_library.h"
@@ -43,6 +44,18 @@ t_pb_type* try_find_pb_type_with_given_path(
   t_pb_type* top_pb_type, const std::vector<std::string>& target_pb_type_names,
   const std::vector<std::string>& target_pb_mode_names);
 
+/* Index of pb_types by their full paths from the top-level pb_types of
+ * logical blocks, i.e., the names of pb_types and modes in the hierarchy */
+typedef std::unordered_map<std::string, t_pb_type*> PbTypePathIndex;
+
+PbTypePathIndex build_pb_type_path_index(
+  const std::vector<t_logical_block_type>& logical_block_types);
+
+t_pb_type* find_pb_type_in_path_index(
+  const PbTypePathIndex& pb_type_path_index,
+  const std::vector<std::string>& target_pb_type_names,
+  const std::vector<std::string>& target_pb_mode_names);
+
 std::vector<t_interconnect*> pb_mode_interconnects(t_mode* pb_mode);
 
 t_interconnect* find_pb_mode_interconnect(t_mode* pb_mode,
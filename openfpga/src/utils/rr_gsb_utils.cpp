@@ -7,6 +7,7 @@
 #include "vtr_log.h"
 
 /* Headers from openfpgautil library */
+#include "openfpga_hash.h"
 #include "openfpga_side_manager.h"
 #include "rr_gsb_utils.h"
 
@@ -386,4 +387,134 @@ bool is_cb_mirror(const RRGraphView& rr_graph,
   return true;
 }
 
+/** @brief Fold the features of a driver edge, which are compared in
+ * is_sb_node_mirror() and is_cb_node_mirror(), into a signature */
+static void hash_rr_gsb_driver_edge(
+  size_t& signature, const RRGraphView& rr_graph,
+  const VprDeviceAnnotation& device_annotation, const RREdgeId& edge) {
+  RRNodeId src_node = rr_graph.edge_src_node(edge);
+  hash_combine<size_t>(signature, size_t(rr_graph.node_type(src_node)));
+  hash_combine<size_t>(signature,
+                       size_t(device_annotation.rr_switch_circuit_model(
+                         rr_graph.edge_switch(edge))));
+}
+
+/** @brief Compute a structural signature of the switch block part of a GSB.
+ * The signature covers exactly the features which are compared by
+ * is_sb_mirror(): number of sides, channel width, node directions,
+ * passing wires, and for each multiplexer the type, side, index and switch
+ * of its drivers. As a result, two mirrors always share the same signature,
+ * while two GSBs with different signatures can never be mirrors.
+ * @note The guarantee holds only when the base GSB has routing tracks on
+ * every side. See is_sb_signature_complete() for details.
+ */
+size_t compute_sb_signature(const RRGraphView& rr_graph,
+                            const VprDeviceAnnotation& device_annotation,
+                            const RRGSB& rr_gsb) {
+  size_t signature = 0;
+  hash_combine<size_t>(signature, rr_gsb.get_num_sides());
+
+  for (size_t side = 0; side < rr_gsb.get_num_sides(); ++side) {
+    SideManager side_manager(side);
+    e_side curr_side = side_manager.get_side();
+    hash_combine<size_t>(signature, rr_gsb.get_chan_width(curr_side));
+    hash_combine<size_t>(signature, rr_gsb.get_num_opin_nodes(curr_side));
+    for (size_t itrack = 0; itrack < rr_gsb.get_chan_width(curr_side);
+         ++itrack) {
+      hash_combine<size_t>(
+        signature, size_t(rr_gsb.get_chan_node_direction(curr_side, itrack)));
+      if (OUT_PORT != rr_gsb.get_chan_node_direction(curr_side, itrack)) {
+        continue;
+      }
+      bool is_short_conkt =
+        rr_gsb.is_sb_node_passing_wire(rr_graph, curr_side, itrack);
+      hash_combine<bool>(signature, is_short_conkt);
+      if (true == is_short_conkt) {
+        continue;
+      }
+      std::vector<RREdgeId> node_in_edges =
+        rr_gsb.get_chan_node_in_edges(rr_graph, curr_side, itrack);
+      hash_combine<size_t>(signature, node_in_edges.size());
+      for (const RREdgeId& edge : node_in_edges) {
+        hash_rr_gsb_driver_edge(signature, rr_graph, device_annotation, edge);
+        int src_node_id;
+        enum e_side src_node_side;
+        rr_gsb.get_node_side_and_index(rr_graph, rr_graph.edge_src_node(edge),
+                                       OUT_PORT, src_node_side, src_node_id);
+        hash_combine<size_t>(signature, size_t(src_node_side));
+        hash_combine<int>(signature, src_node_id);
+      }
+    }
+  }
+
+  return signature;
+}
+
+/** @brief Identify if the signature of a switch block can be trusted to
+ * pre-filter mirror candidates. is_sb_mirror() skips all the checks on a
+ * side of the base GSB where there is no routing track, so a GSB with an
+ * empty side may be a mirror of a GSB whose signature is different.
+ * Such GSBs have to be compared against every unique module.
+ */
+bool is_sb_signature_complete(const RRGSB& rr_gsb) {
+  for (size_t side = 0; side < rr_gsb.get_num_sides(); ++side) {
+    SideManager side_manager(side);
+    if (0 == rr_gsb.get_chan_width(side_manager.get_side())) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/** @brief Compute a structural signature of a connection block part of a
+ * GSB. The signature covers exactly the features which are compared by
+ * is_cb_mirror(), so two mirrors always share the same signature */
+size_t compute_cb_signature(const RRGraphView& rr_graph,
+                            const VprDeviceAnnotation& device_annotation,
+                            const RRGSB& rr_gsb, const t_rr_type& cb_type) {
+  size_t signature = 0;
+  hash_combine<size_t>(signature, rr_gsb.get_cb_chan_width(cb_type));
+
+  enum e_side chan_side = rr_gsb.get_cb_chan_side(cb_type);
+  const RRChan& chan = rr_gsb.chan(chan_side);
+  hash_combine<size_t>(signature, size_t(chan.get_type()));
+  hash_combine<size_t>(signature, chan.get_chan_width());
+  for (size_t inode = 0; inode < chan.get_chan_width(); ++inode) {
+    hash_combine<size_t>(signature,
+                         size_t(rr_graph.node_type(chan.get_node(inode))));
+    hash_combine<size_t>(signature,
+                         size_t(rr_graph.node_direction(chan.get_node(inode))));
+    hash_combine<size_t>(signature,
+                         size_t(device_annotation.rr_segment_circuit_model(
+                           chan.get_node_segment(inode))));
+  }
+
+  for (const e_side& ipin_side : rr_gsb.get_cb_ipin_sides(cb_type)) {
+    hash_combine<size_t>(signature, rr_gsb.get_num_ipin_nodes(ipin_side));
+    for (size_t inode = 0; inode < rr_gsb.get_num_ipin_nodes(ipin_side);
+         ++inode) {
+      std::vector<RREdgeId> node_in_edges =
+        rr_gsb.get_ipin_node_in_edges(rr_graph, ipin_side, inode);
+      hash_combine<size_t>(signature, node_in_edges.size());
+      for (const RREdgeId& edge : node_in_edges) {
+        hash_rr_gsb_driver_edge(signature, rr_graph, device_annotation, edge);
+        RRNodeId src_node = rr_graph.edge_src_node(edge);
+        if (OPIN == rr_graph.node_type(src_node)) {
+          int src_node_id;
+          enum e_side src_node_side;
+          rr_gsb.get_node_side_and_index(rr_graph, src_node, OUT_PORT,
+                                         src_node_side, src_node_id);
+          hash_combine<size_t>(signature, size_t(src_node_side));
+          hash_combine<int>(signature, src_node_id);
+        } else {
+          hash_combine<int>(signature,
+                            rr_gsb.get_chan_node_index(chan_side, src_node));
+        }
+      }
+    }
+  }
+
+  return signature;
+}
+
 } /* end namespace openfpga */
@@ -34,6 +34,16 @@ bool is_cb_mirror(const RRGraphView& rr_graph,
                   const RRGSB& base, const RRGSB& cand,
                   const t_rr_type& cb_type);
 
+size_t compute_sb_signature(const RRGraphView& rr_graph,
+                            const VprDeviceAnnotation& device_annotation,
+                            const RRGSB& rr_gsb);
+
+bool is_sb_signature_complete(const RRGSB& rr_gsb);
+
+size_t compute_cb_signature(const RRGraphView& rr_graph,
+                            const VprDeviceAnnotation& device_annotation,
+                            const RRGSB& rr_gsb, const t_rr_type& cb_type);
+
 } /* end namespace openfpga */
 
 #endif
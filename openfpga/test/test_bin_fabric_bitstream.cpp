@@ -0,0 +1,341 @@
+/********************************************************************
+ * Unit test functions to validate the packed binary file format of
+ * fabric bitstreams, see write_bin_fabric_bitstream.cpp
+ * The files of the standalone, scan-chain and frame-based protocols are
+ * parsed and compared to the rows of the plain text file, while the
+ * blocks of compressed files are decoded and compared to the same bits
+ *******************************************************************/
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+/* Headers from vtrutil library */
+#include "vtr_assert.h"
+#include "vtr_log.h"
+
+/* Headers from openfpga library */
+#include "fabric_bitstream_utils.h"
+#include "openfpga_bit_run_length.h"
+#include "write_bin_fabric_bitstream.h"
+
+/* Headers shared by the unit tests */
+#include "openfpga_test_utils.h"
+
+/********************************************************************
+ * A minimal reader of the binary file
+ *******************************************************************/
+struct BinFabricBitstreamFile {
+  std::string data;
+  size_t offset = 0;
+
+  uint64_t read_uint(const size_t& num_bytes) {
+    uint64_t value = 0;
+    for (size_t ibyte = 0; ibyte < num_bytes; ++ibyte) {
+      VTR_ASSERT(offset < data.size());
+      value |= uint64_t(uint8_t(data[offset++])) << (8 * ibyte);
+    }
+    return value;
+  }
+  /* Packed bits after the header */
+  bool bit(const size_t& ibit) const {
+    VTR_ASSERT(offset + ibit / 8 < data.size());
+    return 0 != ((uint8_t(data[offset + ibit / 8]) >> (ibit % 8)) & 1);
+  }
+};
+
+struct BinFabricBitstreamHeader {
+  std::string magic;
+  uint64_t version;
+  uint64_t config_protocol_type;
+  uint64_t num_regions;
+  uint64_t flags;
+  uint64_t bl_width;
+  uint64_t wl_width;
+  uint64_t row_width;
+  uint64_t num_rows;
+};
+
+static BinFabricBitstreamHeader read_header(BinFabricBitstreamFile& file) {
+  BinFabricBitstreamHeader header;
+  header.magic = file.data.substr(0, 4);
+  file.offset = 4;
+  header.version = file.read_uint(4);
+  header.config_protocol_type = file.read_uint(4);
+  file.read_uint(8); /* BL and WL protocol types */
+  header.num_regions = file.read_uint(4);
+  header.flags = file.read_uint(4);
+  header.bl_width = file.read_uint(8);
+  header.wl_width = file.read_uint(8);
+  header.row_width = file.read_uint(8);
+  header.num_rows = file.read_uint(8);
+  return header;
+}
+
+static BinFabricBitstreamFile write_and_read(
+  const openfpga::BitstreamManager& bitstream_manager,
+  const openfpga::FabricBitstream& fabric_bitstream,
+  const ConfigProtocol& config_protocol, const bool& compress) {
+  std::string fname("test_bin_fabric_bitstream.bin");
+  openfpga::BitstreamWriterOption options;
+  options.set_output_file_type("bin");
+  options.set_output_file_name(fname);
+  options.set_compress(compress);
+  openfpga::FabricGlobalPortInfo global_ports;
+  check(0 == openfpga::write_fabric_bitstream_to_bin_file(
+               bitstream_manager, fabric_bitstream, config_protocol,
+               global_ports, options),
+        "Failed to write binary fabric bitstream");
+
+  BinFabricBitstreamFile file;
+  file.data = read_file(fname);
+  std::remove(fname.c_str());
+  return file;
+}
+
+/* Check the packed rows against the rows of the plain text file, where
+ * the last byte is padded with zeros */
+static void check_rows(const BinFabricBitstreamFile& file,
+                       const BinFabricBitstreamHeader& header,
+                       const std::vector<std::vector<bool>>& rows) {
+  check(rows.size() == header.num_rows, "Mismatch in number of rows");
+  size_t num_bits = 0;
+  for (const std::vector<bool>& row : rows) {
+    check(row.size() == header.row_width, "Mismatch in row width");
+    for (const bool& bit : row) {
+      check(bit == file.bit(num_bits), "Mismatch in bit value");
+      num_bits++;
+    }
+  }
+  check(file.offset + (num_bits + 7) / 8 == file.data.size(),
+        "Mismatch in file size");
+  for (size_t ibit = num_bits; ibit < (num_bits + 7) / 8 * 8; ++ibit) {
+    check(false == file.bit(ibit), "Padding bit is not zero");
+  }
+}
+
+/* Decode the run-length encoded blocks, which follow the header of a
+ * compressed file */
+static void check_compressed_blocks(
+  BinFabricBitstreamFile& file, const BinFabricBitstreamHeader& header,
+  const std::vector<std::vector<bool>>& blocks) {
+  check(2 == header.version, "Mismatch in version of compressed file");
+  check(4 == (header.flags & 4), "Missing compression flag");
+  for (const std::vector<bool>& block : blocks) {
+    size_t num_bits = file.read_uint(8);
+    size_t num_bytes = file.read_uint(8);
+    check(block.size() == num_bits, "Mismatch in number of block bits");
+    VTR_ASSERT(file.offset + num_bytes <= file.data.size());
+    std::vector<bool> bits;
+    check(true == openfpga::decode_bit_run_length(
+                    reinterpret_cast<const uint8_t*>(file.data.data()) +
+                      file.offset,
+                    num_bytes, num_bits, bits),
+          "Failed to decode compressed block");
+    check(block == bits, "Mismatch in compressed block");
+    file.offset += num_bytes;
+  }
+  check(file.offset == file.data.size(), "Mismatch in compressed file size");
+}
+
+/* Bits of all the rows in a single block */
+static std::vector<bool> flatten_rows(
+  const std::vector<std::vector<bool>>& rows) {
+  std::vector<bool> bits;
+  for (const std::vector<bool>& row : rows) {
+    bits.insert(bits.end(), row.begin(), row.end());
+  }
+  return bits;
+}
+
+/********************************************************************
+ * Build a bitstream of a number of blocks, where the values of bits
+ * follow a pattern which is not periodic in bytes
+ *******************************************************************/
+static openfpga::BitstreamManager build_test_bitstream_manager(
+  const size_t& num_bits) {
+  openfpga::BitstreamManager bitstream_manager;
+  openfpga::ConfigBlockId top = bitstream_manager.add_block("fpga_top");
+  openfpga::ConfigBlockId block = bitstream_manager.add_block("mem");
+  bitstream_manager.add_child_block(top, block);
+  std::vector<bool> bits;
+  for (size_t ibit = 0; ibit < num_bits; ++ibit) {
+    bits.push_back((0 == ibit % 3) || (0 == ibit % 7));
+  }
+  bitstream_manager.add_block_bits(block, bits);
+  return bitstream_manager;
+}
+
+/* Add the bits to a number of regions of the same size */
+static openfpga::FabricBitstream build_test_fabric_bitstream(
+  const openfpga::BitstreamManager& bitstream_manager,
+  const size_t& num_regions, const size_t& address_length) {
+  openfpga::FabricBitstream fabric_bitstream;
+  if (0 < address_length) {
+    fabric_bitstream.set_use_address(true);
+    fabric_bitstream.set_address_length(address_length);
+  }
+  std::vector<openfpga::FabricBitRegionId> regions;
+  for (size_t iregion = 0; iregion < num_regions; ++iregion) {
+    regions.push_back(fabric_bitstream.add_region());
+  }
+  size_t num_region_bits = bitstream_manager.num_bits() / num_regions;
+  for (const openfpga::ConfigBitId& bit : bitstream_manager.bits()) {
+    openfpga::FabricBitId fabric_bit = fabric_bitstream.add_bit(bit);
+    size_t ibit = size_t(bit) % num_region_bits;
+    fabric_bitstream.add_bit_to_region(regions[size_t(bit) / num_region_bits],
+                                       fabric_bit);
+    if (0 < address_length) {
+      std::vector<char> address(address_length, '0');
+      for (size_t iaddr = 0; iaddr < address_length; ++iaddr) {
+        address[iaddr] = ((ibit >> iaddr) & 1) ? '1' : '0';
+      }
+      fabric_bitstream.set_bit_address(fabric_bit, address);
+      fabric_bitstream.set_bit_din(
+        fabric_bit, bitstream_manager.bit_value(bit) ? '1' : '0');
+    }
+  }
+  return fabric_bitstream;
+}
+
+static void test_standalone(const bool& compress) {
+  openfpga::BitstreamManager bitstream_manager =
+    build_test_bitstream_manager(45);
+  openfpga::FabricBitstream fabric_bitstream =
+    build_test_fabric_bitstream(bitstream_manager, 1, 0);
+  ConfigProtocol config_protocol;
+  config_protocol.set_type(CONFIG_MEM_STANDALONE);
+
+  BinFabricBitstreamFile file =
+    write_and_read(bitstream_manager, fabric_bitstream, config_protocol,
+                   compress);
+  BinFabricBitstreamHeader header = read_header(file);
+  check("OFBS" == header.magic, "Mismatch in magic number");
+  check(CONFIG_MEM_STANDALONE == header.config_protocol_type,
+        "Mismatch in configuration protocol");
+  check(header.num_rows == 45, "Mismatch in number of rows");
+
+  std::vector<std::vector<bool>> rows;
+  for (const openfpga::ConfigBitId& bit : bitstream_manager.bits()) {
+    rows.push_back({bitstream_manager.bit_value(bit)});
+  }
+  if (true == compress) {
+    check_compressed_blocks(file, header, {flatten_rows(rows)});
+    return;
+  }
+  check(1 == header.version, "Mismatch in version");
+  check(0 == header.flags, "Mismatch in flags");
+  check_rows(file, header, rows);
+}
+
+static void test_scan_chain(const bool& compress) {
+  openfpga::BitstreamManager bitstream_manager =
+    build_test_bitstream_manager(3 * 13);
+  openfpga::FabricBitstream fabric_bitstream =
+    build_test_fabric_bitstream(bitstream_manager, 3, 0);
+  ConfigProtocol config_protocol;
+  config_protocol.set_type(CONFIG_MEM_SCAN_CHAIN);
+  config_protocol.set_num_regions(3);
+
+  BinFabricBitstreamFile file =
+    write_and_read(bitstream_manager, fabric_bitstream, config_protocol,
+                   compress);
+  BinFabricBitstreamHeader header = read_header(file);
+  check(3 == header.num_regions, "Mismatch in number of regions");
+
+  /* Each row shifts a bit in each region */
+  openfpga::ConfigChainFabricBitstream regional_bitstreams =
+    openfpga::build_config_chain_fabric_bitstream_by_region(
+      bitstream_manager, fabric_bitstream, 1);
+  /* Each region is compressed in its own block */
+  if (true == compress) {
+    check_compressed_blocks(file, header, regional_bitstreams);
+    return;
+  }
+  std::vector<std::vector<bool>> rows;
+  for (size_t ibit = 0; ibit < regional_bitstreams[0].size(); ++ibit) {
+    std::vector<bool> row;
+    for (const std::vector<bool>& region_bitstream : regional_bitstreams) {
+      row.push_back(region_bitstream[ibit]);
+    }
+    rows.push_back(row);
+  }
+  check_rows(file, header, rows);
+}
+
+static void test_frame_based(const bool& compress) {
+  openfpga::BitstreamManager bitstream_manager =
+    build_test_bitstream_manager(2 * 11);
+  openfpga::FabricBitstream fabric_bitstream =
+    build_test_fabric_bitstream(bitstream_manager, 2, 4);
+  ConfigProtocol config_protocol;
+  config_protocol.set_type(CONFIG_MEM_FRAME_BASED);
+  config_protocol.set_num_regions(2);
+
+  BinFabricBitstreamFile file =
+    write_and_read(bitstream_manager, fabric_bitstream, config_protocol,
+                   compress);
+  BinFabricBitstreamHeader header = read_header(file);
+
+  /* Each row is an address and the data input of each region */
+  std::vector<std::vector<bool>> rows;
+  std::vector<bool> addr_bits;
+  std::vector<bool> din_bits;
+  for (const auto& addr_din_pair :
+       openfpga::build_frame_based_fabric_bitstream_by_address(
+         fabric_bitstream)) {
+    std::vector<bool> row;
+    for (const char& bit : addr_din_pair.first) {
+      row.push_back('1' == bit);
+      addr_bits.push_back('1' == bit);
+    }
+    din_bits.insert(din_bits.end(), addr_din_pair.second.begin(),
+                    addr_din_pair.second.end());
+    row.insert(row.end(), addr_din_pair.second.begin(),
+               addr_din_pair.second.end());
+    rows.push_back(row);
+  }
+  check(11 == rows.size(), "Mismatch in number of addresses");
+  /* The addresses and the data inputs are compressed in two blocks */
+  if (true == compress) {
+    check_compressed_blocks(file, header, {addr_bits, din_bits});
+    return;
+  }
+  check_rows(file, header, rows);
+}
+
+/* Compression is rejected by memory banks */
+static void test_memory_bank_compression() {
+  openfpga::BitstreamManager bitstream_manager =
+    build_test_bitstream_manager(8);
+  openfpga::FabricBitstream fabric_bitstream =
+    build_test_fabric_bitstream(bitstream_manager, 1, 0);
+  ConfigProtocol config_protocol;
+  config_protocol.set_type(CONFIG_MEM_MEMORY_BANK);
+
+  std::string fname("test_bin_fabric_bitstream.bin");
+  openfpga::BitstreamWriterOption options;
+  options.set_output_file_type("bin");
+  options.set_output_file_name(fname);
+  options.set_compress(true);
+  openfpga::FabricGlobalPortInfo global_ports;
+  check(1 == openfpga::write_fabric_bitstream_to_bin_file(
+               bitstream_manager, fabric_bitstream, config_protocol,
+               global_ports, options),
+        "Compressed memory bank is accepted");
+  std::remove(fname.c_str());
+}
+
+int main(int argc, const char** argv) {
+  VTR_ASSERT(1 == argc);
+  (void)argv;
+
+  for (const bool& compress : {false, true}) {
+    test_standalone(compress);
+    test_scan_chain(compress);
+    test_frame_based(compress);
+  }
+  test_memory_bank_compression();
+
+  return test_exit_code("Binary fabric bitstream");
+}
@@ -0,0 +1,260 @@
+/********************************************************************
+ * Unit test functions to validate the checkpoint of bitstream databases
+ * 1. the architecture and fabric bitstreams are saved and loaded back to
+ *    the same databases
+ * 2. a checkpoint of another fabric or version is reported as outdated,
+ *    without loading any database
+ * 3. a checkpoint with a corrupted manifest or database is reported as
+ *    corrupted, without touching the architecture bitstream
+ *******************************************************************/
+#include <cstdio>
+#include <string>
+#include <vector>
+
+/* Headers from vtrutil library */
+#include "vtr_assert.h"
+#include "vtr_log.h"
+
+/* Headers from openfpga library */
+#include "bitstream_checkpoint.h"
+#include "command_exit_codes.h"
+
+/* Headers shared by the unit tests */
+#include "openfpga_test_utils.h"
+
+/* Files of a checkpoint directory and the offset of the version in the
+ * manifest, which follows the magic word */
+constexpr char TEST_CHECKPOINT_DIR[] = "test_bitstream_checkpoint/";
+constexpr char TEST_CHECKPOINT_MANIFEST_FILE[] =
+  "test_bitstream_checkpoint/checkpoint.bin";
+constexpr char TEST_CHECKPOINT_ARCH_BITSTREAM_FILE[] =
+  "test_bitstream_checkpoint/arch_bitstream.bin";
+constexpr char TEST_CHECKPOINT_FABRIC_BITSTREAM_FILE[] =
+  "test_bitstream_checkpoint/fabric_bitstream_template.bin";
+constexpr size_t BITSTREAM_CHECKPOINT_VERSION_OFFSET = 8;
+
+/********************************************************************
+ * Build an architecture bitstream of two tiles, and a fabric bitstream of
+ * a memory bank using decoders, which addresses all the bits of the
+ * architecture bitstream
+ *******************************************************************/
+static openfpga::BitstreamManager build_test_bitstream() {
+  openfpga::BitstreamManager bitstream_manager;
+  openfpga::ConfigBlockId top = bitstream_manager.add_block("fpga_top");
+  for (size_t itile = 0; itile < 2; ++itile) {
+    openfpga::ConfigBlockId tile = bitstream_manager.add_block(
+      std::string("grid_clb_") + std::to_string(itile));
+    bitstream_manager.add_child_block(top, tile);
+    std::vector<bool> bits;
+    for (size_t ibit = 0; ibit < 10; ++ibit) {
+      bits.push_back(0 == (ibit * (itile + 3)) % 4);
+    }
+    bitstream_manager.add_block_bits(tile, bits);
+  }
+  return bitstream_manager;
+}
+
+static openfpga::FabricBitstream build_test_fabric_bitstream(
+  const openfpga::BitstreamManager& bitstream_manager) {
+  openfpga::FabricBitstream fabric_bitstream;
+  fabric_bitstream.set_use_address(true);
+  fabric_bitstream.set_use_wl_address(true);
+  fabric_bitstream.set_address_length(5);
+  fabric_bitstream.set_wl_address_length(5);
+  openfpga::FabricBitRegionId region = fabric_bitstream.add_region();
+  for (const openfpga::ConfigBitId& config_bit : bitstream_manager.bits()) {
+    openfpga::FabricBitId fabric_bit = fabric_bitstream.add_bit(config_bit);
+    fabric_bitstream.add_bit_to_region(region, fabric_bit);
+    std::vector<char> address(5, '0');
+    for (size_t iaddr = 0; iaddr < 5; ++iaddr) {
+      address[iaddr] = ((size_t(config_bit) >> iaddr) & 1) ? '1' : '0';
+    }
+    fabric_bitstream.set_bit_bl_address(fabric_bit, address);
+    fabric_bitstream.set_bit_wl_address(fabric_bit, address);
+    fabric_bitstream.set_bit_din(fabric_bit,
+                                 bitstream_manager.bit_value(config_bit));
+  }
+  return fabric_bitstream;
+}
+
+static void check_same_bitstream(const openfpga::BitstreamManager& ref,
+                                 const openfpga::BitstreamManager& test) {
+  check(ref.num_blocks() == test.num_blocks(), "Mismatch in number of blocks");
+  check(ref.num_bits() == test.num_bits(), "Mismatch in number of bits");
+  if ((ref.num_blocks() != test.num_blocks()) ||
+      (ref.num_bits() != test.num_bits())) {
+    return;
+  }
+  for (const openfpga::ConfigBlockId& blk : ref.blocks()) {
+    check(ref.block_name(blk) == test.block_name(blk), "Mismatch in name");
+    check(ref.block_bits(blk) == test.block_bits(blk), "Mismatch in bits");
+  }
+  for (const openfpga::ConfigBitId& bit : ref.bits()) {
+    check(ref.bit_value(bit) == test.bit_value(bit), "Mismatch in bit value");
+  }
+}
+
+static void check_same_fabric_bitstream(const openfpga::FabricBitstream& ref,
+                                        const openfpga::FabricBitstream& test) {
+  check(ref.num_bits() == test.num_bits(), "Mismatch in number of fabric bits");
+  check(ref.num_regions() == test.num_regions(),
+        "Mismatch in number of regions");
+  if ((ref.num_bits() != test.num_bits()) ||
+      (ref.num_regions() != test.num_regions())) {
+    return;
+  }
+  for (const openfpga::FabricBitId& bit : ref.bits()) {
+    check(ref.config_bit(bit) == test.config_bit(bit),
+          "Mismatch in configuration bit");
+    check(ref.bit_bl_address(bit) == test.bit_bl_address(bit),
+          "Mismatch in BL address");
+    check(ref.bit_wl_address(bit) == test.bit_wl_address(bit),
+          "Mismatch in WL address");
+    check(ref.bit_din(bit) == test.bit_din(bit), "Mismatch in data input");
+  }
+}
+
+/* Read a checkpoint which should not be loaded, and return the status */
+static int read_bad_checkpoint(const size_t& key,
+                               const openfpga::BitstreamManager& ref) {
+  openfpga::BitstreamManager bitstream_manager = ref;
+  openfpga::FabricBitstream fabric_bitstream;
+  bool bitstream_manager_loaded = false;
+  bool fabric_bitstream_loaded = false;
+  int status = openfpga::read_bitstream_checkpoint(
+    TEST_CHECKPOINT_DIR, key, bitstream_manager, fabric_bitstream,
+    bitstream_manager_loaded, fabric_bitstream_loaded, false);
+  check(false == fabric_bitstream_loaded, "Fabric bitstream is loaded");
+  check(0 == fabric_bitstream.num_bits(), "Fabric bitstream is touched");
+  check_same_bitstream(ref, bitstream_manager);
+  return status;
+}
+
+int main(int argc, const char** argv) {
+  VTR_ASSERT(1 == argc);
+  (void)argv;
+
+  const size_t key = 0x123456789abcdef;
+  openfpga::BitstreamManager ref_bitstream = build_test_bitstream();
+  openfpga::FabricBitstream ref_fabric_bitstream =
+    build_test_fabric_bitstream(ref_bitstream);
+
+  /* A fabric bitstream can not be saved alone */
+  check(openfpga::CMD_EXEC_FATAL_ERROR ==
+          openfpga::write_bitstream_checkpoint(
+            TEST_CHECKPOINT_DIR, key, openfpga::BitstreamManager(),
+            ref_fabric_bitstream, false),
+        "Fabric bitstream is saved without architecture bitstream");
+
+  /* Only the architecture bitstream */
+  check(openfpga::CMD_EXEC_SUCCESS ==
+          openfpga::write_bitstream_checkpoint(TEST_CHECKPOINT_DIR, key,
+                                               ref_bitstream,
+                                               openfpga::FabricBitstream(),
+                                               false),
+        "Fail to write checkpoint of architecture bitstream");
+  openfpga::BitstreamManager test_bitstream;
+  openfpga::FabricBitstream test_fabric_bitstream;
+  bool bitstream_manager_loaded = false;
+  bool fabric_bitstream_loaded = false;
+  check(openfpga::CMD_EXEC_SUCCESS ==
+          openfpga::read_bitstream_checkpoint(
+            TEST_CHECKPOINT_DIR, key, test_bitstream, test_fabric_bitstream,
+            bitstream_manager_loaded, fabric_bitstream_loaded, false),
+        "Fail to read checkpoint of architecture bitstream");
+  check(true == bitstream_manager_loaded,
+        "Architecture bitstream is not loaded");
+  check(false == fabric_bitstream_loaded, "Missing fabric bitstream is loaded");
+  check_same_bitstream(ref_bitstream, test_bitstream);
+
+  /* Both databases */
+  check(openfpga::CMD_EXEC_SUCCESS ==
+          openfpga::write_bitstream_checkpoint(TEST_CHECKPOINT_DIR, key,
+                                               ref_bitstream,
+                                               ref_fabric_bitstream, false),
+        "Fail to write checkpoint");
+  test_bitstream = openfpga::BitstreamManager();
+  check(openfpga::CMD_EXEC_SUCCESS ==
+          openfpga::read_bitstream_checkpoint(
+            TEST_CHECKPOINT_DIR, key, test_bitstream, test_fabric_bitstream,
+            bitstream_manager_loaded, fabric_bitstream_loaded, false),
+        "Fail to read checkpoint");
+  check((true == bitstream_manager_loaded) && (true == fabric_bitstream_loaded),
+        "Databases are not loaded");
+  check_same_bitstream(ref_bitstream, test_bitstream);
+  check_same_fabric_bitstream(ref_fabric_bitstream, test_fabric_bitstream);
+
+  /* The checkpoint of another fabric is not loaded */
+  check(openfpga::CMD_EXEC_MINOR_ERROR ==
+          read_bad_checkpoint(key + 1, openfpga::BitstreamManager()),
+        "Checkpoint of another fabric is accepted");
+
+  /* Another version of the manifest */
+  std::string manifest = read_file(TEST_CHECKPOINT_MANIFEST_FILE);
+  std::string bad_data = manifest;
+  bad_data[BITSTREAM_CHECKPOINT_VERSION_OFFSET]++;
+  write_file(TEST_CHECKPOINT_MANIFEST_FILE, bad_data);
+  check(openfpga::CMD_EXEC_MINOR_ERROR ==
+          read_bad_checkpoint(key, openfpga::BitstreamManager()),
+        "Checkpoint of another version is accepted");
+
+  /* Another type of file, or a truncated manifest */
+  bad_data = manifest;
+  bad_data[0] = 'X';
+  write_file(TEST_CHECKPOINT_MANIFEST_FILE, bad_data);
+  check(openfpga::CMD_EXEC_FATAL_ERROR ==
+          read_bad_checkpoint(key, openfpga::BitstreamManager()),
+        "Manifest with a wrong magic word is accepted");
+  write_file(TEST_CHECKPOINT_MANIFEST_FILE,
+             manifest.substr(0, manifest.size() - 1));
+  check(openfpga::CMD_EXEC_FATAL_ERROR ==
+          read_bad_checkpoint(key, openfpga::BitstreamManager()),
+        "Truncated manifest is accepted");
+
+  /* A fabric bitstream without its architecture bitstream, whose flags are
+   * the last two bytes of the manifest */
+  bad_data = manifest;
+  bad_data[manifest.size() - 2] = 0;
+  write_file(TEST_CHECKPOINT_MANIFEST_FILE, bad_data);
+  check(openfpga::CMD_EXEC_FATAL_ERROR ==
+          read_bad_checkpoint(key, openfpga::BitstreamManager()),
+        "Fabric bitstream without architecture bitstream is accepted");
+  write_file(TEST_CHECKPOINT_MANIFEST_FILE, manifest);
+
+  /* Corrupted architecture bitstream, which leaves the database untouched */
+  std::string arch_data = read_file(TEST_CHECKPOINT_ARCH_BITSTREAM_FILE);
+  write_file(TEST_CHECKPOINT_ARCH_BITSTREAM_FILE,
+             arch_data.substr(0, arch_data.size() / 2));
+  check(openfpga::CMD_EXEC_FATAL_ERROR ==
+          read_bad_checkpoint(key, build_test_bitstream()),
+        "Truncated architecture bitstream is accepted");
+  std::remove(TEST_CHECKPOINT_ARCH_BITSTREAM_FILE);
+  check(openfpga::CMD_EXEC_FATAL_ERROR ==
+          read_bad_checkpoint(key, build_test_bitstream()),
+        "Missing architecture bitstream is accepted");
+  write_file(TEST_CHECKPOINT_ARCH_BITSTREAM_FILE, arch_data);
+
+  /* Corrupted fabric bitstream */
+  std::string fabric_data = read_file(TEST_CHECKPOINT_FABRIC_BITSTREAM_FILE);
+  write_file(TEST_CHECKPOINT_FABRIC_BITSTREAM_FILE,
+             fabric_data.substr(0, fabric_data.size() / 2));
+  test_fabric_bitstream = openfpga::FabricBitstream();
+  check(openfpga::CMD_EXEC_FATAL_ERROR ==
+          openfpga::read_bitstream_checkpoint(
+            TEST_CHECKPOINT_DIR, key, test_bitstream, test_fabric_bitstream,
+            bitstream_manager_loaded, fabric_bitstream_loaded, false),
+        "Truncated fabric bitstream is accepted");
+  check(false == fabric_bitstream_loaded,
+        "Truncated fabric bitstream is loaded");
+
+  /* Missing checkpoint */
+  std::remove(TEST_CHECKPOINT_MANIFEST_FILE);
+  std::remove(TEST_CHECKPOINT_ARCH_BITSTREAM_FILE);
+  std::remove(TEST_CHECKPOINT_FABRIC_BITSTREAM_FILE);
+  std::remove(TEST_CHECKPOINT_DIR);
+  check(openfpga::CMD_EXEC_MINOR_ERROR ==
+          read_bad_checkpoint(key, openfpga::BitstreamManager()),
+        "Missing checkpoint is not reported as outdated");
+
+  return test_exit_code("Bitstream checkpoint");
+}
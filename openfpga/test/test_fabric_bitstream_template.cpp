@@ -0,0 +1,203 @@
+/********************************************************************
+ * Unit test functions to validate the binary file of fabric bitstream
+ * templates
+ * 1. a template is written, read back and written again, which should
+ *    result in the same bytes and the same fabric bitstream
+ * 2. a template of another fabric or version is reported as outdated
+ * 3. a truncated template or another file is reported as corrupted
+ *******************************************************************/
+#include <cstdio>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+/* Headers from vtrutil library */
+#include "vtr_assert.h"
+#include "vtr_log.h"
+
+/* Headers from openfpga library */
+#include "command_exit_codes.h"
+#include "fabric_bitstream_template_file.h"
+
+/* Headers shared by the unit tests */
+#include "openfpga_test_utils.h"
+
+/* Offset of the version in the header of a template, which follows the
+ * magic word */
+constexpr size_t FABRIC_BITSTREAM_TEMPLATE_VERSION_OFFSET = 8;
+
+static std::string write_template_to_string(
+  const openfpga::FabricBitstreamTemplate& bitstream_template) {
+  std::ostringstream fp(std::ios::binary);
+  bitstream_template.write_binary(fp);
+  return fp.str();
+}
+
+/********************************************************************
+ * Build a fabric bitstream of a memory bank using decoders, whose BL
+ * and WL addresses contain don't care bits, over two regions
+ *******************************************************************/
+static openfpga::FabricBitstream build_test_address_fabric_bitstream() {
+  openfpga::FabricBitstream fabric_bitstream;
+  fabric_bitstream.set_use_address(true);
+  fabric_bitstream.set_use_wl_address(true);
+  /* Addresses longer than a word are split into several words */
+  fabric_bitstream.set_address_length(70);
+  fabric_bitstream.set_wl_address_length(5);
+  openfpga::FabricBitRegionId regions[2] = {fabric_bitstream.add_region(),
+                                            fabric_bitstream.add_region()};
+  for (size_t ibit = 0; ibit < 20; ++ibit) {
+    openfpga::FabricBitId fabric_bit =
+      fabric_bitstream.add_bit(openfpga::ConfigBitId(ibit));
+    fabric_bitstream.add_bit_to_region(regions[ibit % 2], fabric_bit);
+    std::vector<char> bl_address(70, '0');
+    bl_address[ibit % 70] = '1';
+    bl_address[69 - ibit] = 'x';
+    fabric_bitstream.set_bit_bl_address(fabric_bit, bl_address);
+    std::vector<char> wl_address(5, '0');
+    for (size_t iaddr = 0; iaddr < 5; ++iaddr) {
+      wl_address[iaddr] = ((ibit >> iaddr) & 1) ? '1' : '0';
+    }
+    fabric_bitstream.set_bit_wl_address(fabric_bit, wl_address);
+    fabric_bitstream.set_bit_din(fabric_bit, (0 == ibit % 3) ? '1' : '0');
+  }
+  return fabric_bitstream;
+}
+
+/* Build a fabric bitstream of a memory bank using flatten BLs and WLs */
+static openfpga::FabricBitstream build_test_memory_bank_fabric_bitstream() {
+  openfpga::FabricBitstream fabric_bitstream;
+  fabric_bitstream.set_use_address(true);
+  fabric_bitstream.set_use_wl_address(true);
+  fabric_bitstream.set_bl_address_length(4);
+  fabric_bitstream.set_wl_address_length(3);
+  openfpga::FabricBitRegionId region = fabric_bitstream.add_region();
+  for (size_t ibit = 0; ibit < 12; ++ibit) {
+    openfpga::FabricBitId fabric_bit =
+      fabric_bitstream.add_bit(openfpga::ConfigBitId(ibit));
+    fabric_bitstream.add_bit_to_region(region, fabric_bit);
+    fabric_bitstream.set_memory_bank_info(fabric_bit, region, ibit % 4,
+                                          ibit / 4, 4, 3, 0 == ibit % 5);
+  }
+  return fabric_bitstream;
+}
+
+/* Addresses are only compared when they are stored per bit, i.e., not by
+ * the BL/WL location of memory banks */
+static void check_same_fabric_bitstream(const openfpga::FabricBitstream& ref,
+                                        const openfpga::FabricBitstream& test,
+                                        const bool& compare_addresses) {
+  check(ref.num_bits() == test.num_bits(), "Mismatch in number of bits");
+  check(ref.num_regions() == test.num_regions(),
+        "Mismatch in number of regions");
+  if ((ref.num_bits() != test.num_bits()) ||
+      (ref.num_regions() != test.num_regions())) {
+    return;
+  }
+  for (const openfpga::FabricBitRegionId& region : ref.regions()) {
+    check(ref.region_bits(region) == test.region_bits(region),
+          "Mismatch in bits of region");
+  }
+  for (const openfpga::FabricBitId& bit : ref.bits()) {
+    check(ref.config_bit(bit) == test.config_bit(bit),
+          "Mismatch in configuration bit");
+    if (false == compare_addresses) {
+      continue;
+    }
+    if (true == ref.use_address()) {
+      check(ref.bit_bl_address(bit) == test.bit_bl_address(bit),
+            "Mismatch in BL address");
+    }
+    if (true == ref.use_wl_address()) {
+      check(ref.bit_wl_address(bit) == test.bit_wl_address(bit),
+            "Mismatch in WL address");
+    }
+  }
+}
+
+/********************************************************************
+ * Write a template to a file and check that it can be read back only
+ * when the file is intact and created for the same fabric
+ *******************************************************************/
+static void test_template_file(const openfpga::FabricBitstream& ref,
+                               const bool& compare_addresses) {
+  std::string fname("test_fabric_bitstream_template.bin");
+  const size_t key = 0x123456789abcdef;
+  const openfpga::FabricBitstreamTemplate& ref_template =
+    *ref.bitstream_template();
+
+  check(openfpga::CMD_EXEC_SUCCESS ==
+          openfpga::write_fabric_bitstream_template(fname, key, ref_template,
+                                                    false),
+        "Fail to write fabric bitstream template");
+
+  std::shared_ptr<const openfpga::FabricBitstreamTemplate> test_template;
+  check(openfpga::CMD_EXEC_SUCCESS ==
+          openfpga::read_fabric_bitstream_template(fname, key, test_template,
+                                                   false),
+        "Fail to read fabric bitstream template");
+  if (nullptr == test_template) {
+    check(false, "Missing fabric bitstream template");
+    return;
+  }
+  check(write_template_to_string(ref_template) ==
+          write_template_to_string(*test_template),
+        "Template changes after a round trip");
+  check_same_fabric_bitstream(ref, openfpga::FabricBitstream(test_template),
+                              compare_addresses);
+
+  /* The template of another fabric is not loaded */
+  std::shared_ptr<const openfpga::FabricBitstreamTemplate> bad_template;
+  check(openfpga::CMD_EXEC_MINOR_ERROR ==
+          openfpga::read_fabric_bitstream_template(fname, key + 1,
+                                                   bad_template, false),
+        "Template of another fabric is accepted");
+  check(nullptr == bad_template, "Outdated template is loaded");
+
+  /* Another version of the file */
+  std::string data = read_file(fname);
+  std::string bad_data = data;
+  bad_data[FABRIC_BITSTREAM_TEMPLATE_VERSION_OFFSET]++;
+  write_file(fname, bad_data);
+  check(openfpga::CMD_EXEC_MINOR_ERROR ==
+          openfpga::read_fabric_bitstream_template(fname, key, bad_template,
+                                                   false),
+        "Template of another version is accepted");
+
+  /* Another type of file */
+  bad_data = data;
+  bad_data[0] = 'X';
+  write_file(fname, bad_data);
+  check(openfpga::CMD_EXEC_FATAL_ERROR ==
+          openfpga::read_fabric_bitstream_template(fname, key, bad_template,
+                                                   false),
+        "File with a wrong magic word is accepted");
+
+  /* Truncated files */
+  for (size_t num_bytes : {size_t(4), data.size() / 2, data.size() - 1}) {
+    write_file(fname, data.substr(0, num_bytes));
+    check(openfpga::CMD_EXEC_FATAL_ERROR ==
+            openfpga::read_fabric_bitstream_template(fname, key, bad_template,
+                                                     false),
+          "Truncated template is accepted");
+  }
+  check(nullptr == bad_template, "Corrupted template is loaded");
+
+  /* Missing file */
+  std::remove(fname.c_str());
+  check(openfpga::CMD_EXEC_MINOR_ERROR ==
+          openfpga::read_fabric_bitstream_template(fname, key, bad_template,
+                                                   false),
+        "Missing template is not reported as outdated");
+}
+
+int main(int argc, const char** argv) {
+  VTR_ASSERT(1 == argc);
+  (void)argv;
+
+  test_template_file(build_test_address_fabric_bitstream(), true);
+  test_template_file(build_test_memory_bank_fabric_bitstream(), false);
+
+  return test_exit_code("Fabric bitstream template");
+}
@@ -0,0 +1,301 @@
+/********************************************************************
+ * Unit test functions to validate the binary formats of the fabric
+ * database
+ * 1. each data structure is written, read back and written again,
+ *    which should result in the same bytes
+ * 2. a database file is written and read back
+ * 3. a truncated database or a database of another version is rejected
+ *******************************************************************/
+#include <cstdio>
+#include <map>
+#include <sstream>
+#include <string>
+
+/* Headers from vtrutils */
+#include "vtr_log.h"
+
+/* Headers from openfpga */
+#include "command_exit_codes.h"
+#include "fabric_database.h"
+#include "vpr_device_annotation.h"
+
+/* Headers shared by the unit tests */
+#include "openfpga_test_utils.h"
+
+/* Offset of the version in the header of a database, which follows the
+ * magic word */
+constexpr size_t FABRIC_DATABASE_VERSION_OFFSET = 8;
+
+/********************************************************************
+ * Write a data structure, read it back and write it again. The two
+ * streams should be the same
+ *******************************************************************/
+template <class T>
+static std::string write_binary_to_string(const T& data) {
+  std::ostringstream fp(std::ios::binary);
+  data.write_binary(fp);
+  return fp.str();
+}
+
+template <class T>
+static T read_binary_from_string(const std::string& bytes) {
+  std::istringstream fp(bytes, std::ios::binary);
+  T data;
+  data.read_binary(fp);
+  check(true == fp.good(), "Fail to read a data structure back");
+  return data;
+}
+
+/********************************************************************
+ * Build a small module graph: a top module instantiating two leaf
+ * modules, whose ports are connected by a net
+ *******************************************************************/
+static openfpga::ModuleManager build_test_module_manager() {
+  openfpga::ModuleManager module_manager;
+
+  openfpga::ModuleId leaf = module_manager.add_module("leaf");
+  module_manager.set_module_usage(leaf, openfpga::ModuleManager::MODULE_LUT);
+  module_manager.set_module_circuit_model(leaf, "lut4");
+  openfpga::ModulePortId leaf_in = module_manager.add_port(
+    leaf, openfpga::BasicPort("in", 4),
+    openfpga::ModuleManager::MODULE_INPUT_PORT);
+  openfpga::ModulePortId leaf_out = module_manager.add_port(
+    leaf, openfpga::BasicPort("out", 1),
+    openfpga::ModuleManager::MODULE_OUTPUT_PORT);
+  module_manager.set_port_preproc_flag(leaf, leaf_out, "ENABLE_TIMING");
+
+  openfpga::ModuleId top = module_manager.add_module("fpga_top");
+  module_manager.set_module_usage(top, openfpga::ModuleManager::MODULE_TOP);
+  openfpga::ModulePortId top_in = module_manager.add_port(
+    top, openfpga::BasicPort("gfpga_pad", 2, 5),
+    openfpga::ModuleManager::MODULE_GPIO_PORT);
+  module_manager.set_port_is_mappable_io(top, top_in, true);
+  module_manager.add_child_module(top, leaf);
+  module_manager.add_child_module(top, leaf);
+  module_manager.set_child_instance_name(top, leaf, 1, "leaf_inst_1");
+  module_manager.add_configurable_child(
+    top, leaf, 0, openfpga::ModuleManager::e_config_child_type::UNIFIED);
+
+  openfpga::ModuleNetId net = module_manager.create_module_net(top);
+  module_manager.set_net_name(top, net, "leaf_0_out");
+  module_manager.add_module_net_source(top, net, leaf, 0, leaf_out, 0);
+  module_manager.add_module_net_sink(top, net, leaf, 1, leaf_in, 3);
+  module_manager.add_module_net_sink(top, net, top, 0, top_in, 1);
+
+  return module_manager;
+}
+
+/********************************************************************
+ * Check the content of a module graph loaded from a binary stream
+ *******************************************************************/
+static void check_test_module_manager(
+  const openfpga::ModuleManager& module_manager) {
+  check(2 == module_manager.num_modules(), "Unexpected number of modules");
+  openfpga::ModuleId leaf = module_manager.find_module("leaf");
+  openfpga::ModuleId top = module_manager.find_module("fpga_top");
+  if ((false == module_manager.valid_module_id(leaf)) ||
+      (false == module_manager.valid_module_id(top))) {
+    check(false, "Modules are missing");
+    return;
+  }
+  check(2 == module_manager.num_instance(top, leaf),
+        "Unexpected number of instances");
+  check(std::string("leaf_inst_1") ==
+          module_manager.instance_name(top, leaf, 1),
+        "Unexpected instance name");
+  check(1 == module_manager.num_nets(top), "Unexpected number of nets");
+  openfpga::ModulePortId top_in =
+    module_manager.find_module_port(top, "gfpga_pad");
+  check(true == module_manager.valid_module_port_id(top, top_in),
+        "Port is missing");
+  check(5 == module_manager.module_port(top, top_in).get_msb(),
+        "Unexpected port width");
+}
+
+/********************************************************************
+ * Round trip of each data structure in a stream
+ *******************************************************************/
+static void test_data_structures() {
+  openfpga::ModuleManager module_manager = build_test_module_manager();
+  std::string module_bytes = write_binary_to_string(module_manager);
+  openfpga::ModuleManager loaded_module_manager =
+    read_binary_from_string<openfpga::ModuleManager>(module_bytes);
+  check_test_module_manager(loaded_module_manager);
+  check(module_bytes == write_binary_to_string(loaded_module_manager),
+        "Module graph changes after a round trip");
+
+  openfpga::DecoderLibrary decoder_lib;
+  decoder_lib.add_decoder(3, 8, true, false, false, false);
+  decoder_lib.add_decoder(4, 16, false, true, true, true);
+  std::string decoder_bytes = write_binary_to_string(decoder_lib);
+  openfpga::DecoderLibrary loaded_decoder_lib =
+    read_binary_from_string<openfpga::DecoderLibrary>(decoder_bytes);
+  check(decoder_bytes == write_binary_to_string(loaded_decoder_lib),
+        "Decoder library changes after a round trip");
+  check(true == loaded_decoder_lib.valid_decoder_id(
+                  loaded_decoder_lib.find_decoder(4, 16, false, true, true,
+                                                  true)),
+        "Decoder is missing");
+
+  openfpga::FabricGlobalPortInfo global_ports;
+  FabricGlobalPortId global_port =
+    global_ports.create_global_port(openfpga::ModulePortId(0));
+  global_ports.set_global_port_is_clock(global_port, true);
+  global_ports.set_global_port_default_value(global_port, 1);
+  std::string global_port_bytes = write_binary_to_string(global_ports);
+  openfpga::FabricGlobalPortInfo loaded_global_ports =
+    read_binary_from_string<openfpga::FabricGlobalPortInfo>(
+      global_port_bytes);
+  check(global_port_bytes == write_binary_to_string(loaded_global_ports),
+        "Global ports change after a round trip");
+  check(true == loaded_global_ports.global_port_is_clock(global_port),
+        "Global port is not a clock");
+
+  openfpga::FabricTile fabric_tile;
+  std::string tile_bytes = write_binary_to_string(fabric_tile);
+  check(tile_bytes == write_binary_to_string(
+                        read_binary_from_string<openfpga::FabricTile>(
+                          tile_bytes)),
+        "Fabric tiles change after a round trip");
+
+  openfpga::MemoryBankShiftRegisterBanks blwl_sr_banks;
+  std::string bank_bytes = write_binary_to_string(blwl_sr_banks);
+  check(bank_bytes ==
+          write_binary_to_string(
+            read_binary_from_string<openfpga::MemoryBankShiftRegisterBanks>(
+              bank_bytes)),
+        "Shift register banks change after a round trip");
+
+  /* Unique modules only fit an array of GSBs of the same size */
+  openfpga::VprDeviceAnnotation device_annotation;
+  openfpga::DeviceRRGSB device_rr_gsb(device_annotation);
+  device_rr_gsb.reserve(vtr::Point<size_t>(2, 3));
+  std::ostringstream gsb_ofp(std::ios::binary);
+  device_rr_gsb.write_unique_modules_binary(gsb_ofp);
+  std::string gsb_bytes = gsb_ofp.str();
+  openfpga::DeviceRRGSB loaded_device_rr_gsb(device_annotation);
+  loaded_device_rr_gsb.reserve(vtr::Point<size_t>(2, 3));
+  std::istringstream gsb_ifp(gsb_bytes, std::ios::binary);
+  loaded_device_rr_gsb.read_unique_modules_binary(gsb_ifp);
+  check(true == gsb_ifp.good(), "Fail to read unique GSBs");
+  std::ostringstream loaded_gsb_ofp(std::ios::binary);
+  loaded_device_rr_gsb.write_unique_modules_binary(loaded_gsb_ofp);
+  check(gsb_bytes == loaded_gsb_ofp.str(),
+        "Unique GSBs change after a round trip");
+  openfpga::DeviceRRGSB other_device_rr_gsb(device_annotation);
+  other_device_rr_gsb.reserve(vtr::Point<size_t>(3, 3));
+  std::istringstream other_gsb_ifp(gsb_bytes, std::ios::binary);
+  other_device_rr_gsb.read_unique_modules_binary(other_gsb_ifp);
+  check(false == other_gsb_ifp.good(),
+        "Unique GSBs of another array are accepted");
+
+  /* A truncated stream leaves the reader in a failed state */
+  std::istringstream truncated_fp(
+    module_bytes.substr(0, module_bytes.size() / 2), std::ios::binary);
+  openfpga::ModuleManager truncated_module_manager;
+  truncated_module_manager.read_binary(truncated_fp);
+  check(false == truncated_fp.good(),
+        "Truncated module graph is not detected");
+}
+
+/********************************************************************
+ * Write a database file with the given data structures
+ *******************************************************************/
+static int write_test_fabric_database(const std::string& fname,
+                                      const size_t& key) {
+  openfpga::ModuleManager module_manager = build_test_module_manager();
+  openfpga::ModuleNameMap module_name_map;
+  module_name_map.set_tag_to_name_pair("leaf", "my_leaf");
+  openfpga::DecoderLibrary decoder_lib;
+  decoder_lib.add_decoder(3, 8, true, false, false, false);
+  openfpga::MemoryBankShiftRegisterBanks blwl_sr_banks;
+  openfpga::FabricTile fabric_tile;
+  openfpga::FabricGlobalPortInfo global_ports;
+  openfpga::VprDeviceAnnotation device_annotation;
+  openfpga::DeviceRRGSB device_rr_gsb(device_annotation);
+  std::map<std::string, size_t> fingerprints = {{"lut4", 42}};
+  return openfpga::write_fabric_database(
+    fname, key, fingerprints, module_manager, module_name_map, decoder_lib,
+    blwl_sr_banks, fabric_tile, global_ports, device_rr_gsb, false);
+}
+
+/********************************************************************
+ * Read a database file, and return the status of the reader
+ *******************************************************************/
+static int read_test_fabric_database(
+  const std::string& fname, const size_t& key,
+  const std::map<std::string, size_t>& fingerprints,
+  openfpga::ModuleManager& module_manager,
+  openfpga::ModuleNameMap& module_name_map) {
+  openfpga::DecoderLibrary decoder_lib;
+  openfpga::MemoryBankShiftRegisterBanks blwl_sr_banks;
+  openfpga::FabricTile fabric_tile;
+  openfpga::FabricGlobalPortInfo global_ports;
+  openfpga::VprDeviceAnnotation device_annotation;
+  openfpga::DeviceRRGSB device_rr_gsb(device_annotation);
+  return openfpga::read_fabric_database(
+    fname, key, fingerprints, module_manager, module_name_map, decoder_lib,
+    blwl_sr_banks, fabric_tile, global_ports, device_rr_gsb, false);
+}
+
+/********************************************************************
+ * Round trip of a database file, and rejection of invalid files
+ *******************************************************************/
+static void test_database_file() {
+  const std::string fname("test_fabric_database.bin");
+  const size_t key = 1234;
+  std::map<std::string, size_t> fingerprints = {{"lut4", 42}};
+  check(openfpga::CMD_EXEC_SUCCESS == write_test_fabric_database(fname, key),
+        "Fail to write fabric database");
+
+  openfpga::ModuleManager module_manager;
+  openfpga::ModuleNameMap module_name_map;
+  check(openfpga::CMD_EXEC_SUCCESS ==
+          read_test_fabric_database(fname, key, fingerprints, module_manager,
+                                    module_name_map),
+        "Fail to read fabric database");
+  check_test_module_manager(module_manager);
+  check(std::string("my_leaf") == module_name_map.name("leaf"),
+        "Module name map is not loaded");
+
+  /* Outdated databases are reported as minor errors, so that the fabric is
+   * built again */
+  check(openfpga::CMD_EXEC_MINOR_ERROR ==
+          read_test_fabric_database(fname, key + 1, fingerprints,
+                                    module_manager, module_name_map),
+        "Database with another key is not rejected");
+  std::map<std::string, size_t> changed_fingerprints = {{"lut4", 43}};
+  check(openfpga::CMD_EXEC_MINOR_ERROR ==
+          read_test_fabric_database(fname, key, changed_fingerprints,
+                                    module_manager, module_name_map),
+        "Database with changed circuit models is not rejected");
+
+  std::string bytes = read_file(fname);
+
+  /* Another version */
+  std::string version_bytes = bytes;
+  version_bytes[FABRIC_DATABASE_VERSION_OFFSET]++;
+  write_file(fname, version_bytes);
+  check(openfpga::CMD_EXEC_MINOR_ERROR ==
+          read_test_fabric_database(fname, key, fingerprints, module_manager,
+                                    module_name_map),
+        "Database of another version is not rejected");
+
+  /* Truncated files */
+  for (size_t num_bytes : {size_t(4), bytes.size() * 3 / 4, bytes.size() - 1}) {
+    write_file(fname, bytes.substr(0, num_bytes));
+    check(openfpga::CMD_EXEC_FATAL_ERROR ==
+            read_test_fabric_database(fname, key, fingerprints,
+                                      module_manager, module_name_map),
+          "Truncated database is not rejected");
+  }
+
+  std::remove(fname.c_str());
+}
+
+int main() {
+  test_data_structures();
+  test_database_file();
+
+  return test_exit_code("Fabric database");
+}
@@ -0,0 +1,280 @@
+/********************************************************************
+ * Unit test functions to validate the binary database of physical
+ * lb_rr_graphs
+ * 1. the graphs of a device are written and read back to the same
+ *    graphs, bound to the same pb_graph pins and modes
+ * 2. a database of another architecture or version is reported as
+ *    outdated
+ * 3. a truncated database or another file is reported as corrupted,
+ *    without touching the device annotation
+ *******************************************************************/
+#include <cstdio>
+#include <string>
+
+/* Headers from vtrutil library */
+#include "vtr_assert.h"
+#include "vtr_log.h"
+
+/* Headers from openfpga library */
+#include "command_exit_codes.h"
+#include "physical_lb_rr_graph_database.h"
+
+/* Headers shared by the unit tests */
+#include "openfpga_test_utils.h"
+
+/* Offset of the version in the header of a database, which follows the
+ * magic word */
+constexpr size_t LB_RR_GRAPH_DATABASE_VERSION_OFFSET = 8;
+
+/********************************************************************
+ * A logical block 'clb' whose physical mode 'default' contains a
+ * primitive 'lut', i.e.,
+ *
+ *   clb.I[0] --> lut.I[0] --> lut.O[0] --> clb.O[0]
+ *
+ * The pb_graph refers to itself, so it is built in place
+ *******************************************************************/
+struct TestDevice {
+  char clb_name[4] = "clb";
+  char lut_name[4] = "lut";
+  char mode_name[8] = "default";
+  char in_name[2] = "I";
+  char out_name[2] = "O";
+  char interc_name[7] = "direct";
+
+  t_pb_type clb = t_pb_type();
+  t_pb_type lut = t_pb_type();
+  t_mode mode = t_mode();
+  t_interconnect interc = t_interconnect();
+  t_port ports[4] = {t_port(), t_port(), t_port(), t_port()};
+
+  t_pb_graph_node clb_node = t_pb_graph_node();
+  t_pb_graph_node lut_node = t_pb_graph_node();
+  t_pb_graph_node* lut_nodes[1];
+  t_pb_graph_node** mode_lut_nodes[1];
+
+  /* Pins in the order of clb.I, clb.O, lut.I and lut.O */
+  t_pb_graph_pin pins[4] = {t_pb_graph_pin(), t_pb_graph_pin(),
+                            t_pb_graph_pin(), t_pb_graph_pin()};
+  t_pb_graph_pin* pin_ptrs[4];
+  t_pb_graph_edge edges[2] = {t_pb_graph_edge(), t_pb_graph_edge()};
+  t_pb_graph_edge* edge_ptrs[2];
+  t_pb_graph_pin* edge_sinks[2];
+  int num_pins = 1;
+
+  DeviceContext device_ctx;
+  openfpga::VprDeviceAnnotation device_annotation;
+
+  TestDevice();
+  TestDevice(const TestDevice&) = delete;
+  TestDevice& operator=(const TestDevice&) = delete;
+
+  openfpga::LbRRGraph build_lb_rr_graph();
+};
+
+TestDevice::TestDevice() {
+  clb.name = clb_name;
+  clb.num_pb = 1;
+  clb.num_modes = 1;
+  clb.modes = &mode;
+  lut.name = lut_name;
+  lut.num_pb = 1;
+  lut.parent_mode = &mode;
+  mode.name = mode_name;
+  mode.index = 0;
+  mode.parent_pb_type = &clb;
+  mode.pb_type_children = &lut;
+  mode.num_pb_type_children = 1;
+  interc.name = interc_name;
+  interc.parent_mode = &mode;
+
+  t_pb_graph_node* parents[4] = {&clb_node, &clb_node, &lut_node, &lut_node};
+  for (size_t ipin = 0; ipin < 4; ++ipin) {
+    ports[ipin].name = (0 == ipin % 2) ? in_name : out_name;
+    ports[ipin].type = (0 == ipin % 2) ? IN_PORT : OUT_PORT;
+    ports[ipin].equivalent = PortEquivalence::NONE;
+    ports[ipin].num_pins = 1;
+    pins[ipin].port = &ports[ipin];
+    pins[ipin].pin_number = 0;
+    pins[ipin].parent_node = parents[ipin];
+    pin_ptrs[ipin] = &pins[ipin];
+  }
+
+  /* clb.I -> lut.I and lut.O -> clb.O */
+  t_pb_graph_pin* drivers[2] = {&pins[0], &pins[3]};
+  t_pb_graph_pin* sinks[2] = {&pins[2], &pins[1]};
+  for (size_t iedge = 0; iedge < 2; ++iedge) {
+    edge_sinks[iedge] = sinks[iedge];
+    edges[iedge].interconnect = &interc;
+    edges[iedge].num_output_pins = 1;
+    edges[iedge].output_pins = &edge_sinks[iedge];
+    edge_ptrs[iedge] = &edges[iedge];
+    drivers[iedge]->num_output_edges = 1;
+    drivers[iedge]->output_edges = &edge_ptrs[iedge];
+  }
+
+  lut_node.pb_type = &lut;
+  lut_node.num_input_ports = 1;
+  lut_node.num_output_ports = 1;
+  lut_node.num_input_pins = &num_pins;
+  lut_node.num_output_pins = &num_pins;
+  lut_node.input_pins = &pin_ptrs[2];
+  lut_node.output_pins = &pin_ptrs[3];
+  lut_node.parent_pb_graph_node = &clb_node;
+  lut_nodes[0] = &lut_node;
+  mode_lut_nodes[0] = lut_nodes;
+
+  clb_node.pb_type = &clb;
+  clb_node.num_input_ports = 1;
+  clb_node.num_output_ports = 1;
+  clb_node.num_input_pins = &num_pins;
+  clb_node.num_output_pins = &num_pins;
+  clb_node.input_pins = &pin_ptrs[0];
+  clb_node.output_pins = &pin_ptrs[1];
+  clb_node.child_pb_graph_nodes = mode_lut_nodes;
+
+  /* The empty type has no pb_graph and is skipped by the database */
+  device_ctx.logical_block_types.resize(2);
+  device_ctx.logical_block_types[1].pb_graph_head = &clb_node;
+  device_annotation.add_pb_type_physical_mode(&clb, &mode);
+}
+
+/* The lb_rr_graph as built by the repacker: a source and a sink around the
+ * pins, where the edges inside the clb are in the physical mode */
+openfpga::LbRRGraph TestDevice::build_lb_rr_graph() {
+  openfpga::LbRRGraph lb_rr_graph;
+  LbRRNodeId source = lb_rr_graph.create_ext_source_node(LB_SOURCE);
+  LbRRNodeId sink = lb_rr_graph.create_ext_sink_node(LB_SINK);
+  lb_rr_graph.set_node_capacity(source, 2);
+  lb_rr_graph.set_node_capacity(sink, 2);
+  LbRRNodeId nodes[4];
+  for (size_t ipin = 0; ipin < 4; ++ipin) {
+    nodes[ipin] = lb_rr_graph.create_node(LB_INTERMEDIATE);
+    lb_rr_graph.set_node_capacity(nodes[ipin], 1);
+    lb_rr_graph.set_node_pb_graph_pin(nodes[ipin], &pins[ipin]);
+    lb_rr_graph.set_node_intrinsic_cost(nodes[ipin], 1. + ipin);
+  }
+  LbRRNodeId src_nodes[6] = {source, nodes[0], nodes[2],
+                             source, nodes[3], nodes[1]};
+  LbRRNodeId sink_nodes[6] = {nodes[0], nodes[2], sink,
+                              nodes[3], nodes[1], sink};
+  t_mode* modes[6] = {nullptr, &mode, nullptr, nullptr, &mode, nullptr};
+  for (size_t iedge = 0; iedge < 6; ++iedge) {
+    LbRREdgeId edge = lb_rr_graph.create_edge(src_nodes[iedge],
+                                              sink_nodes[iedge], modes[iedge]);
+    lb_rr_graph.set_edge_intrinsic_cost(edge, 1. + iedge);
+  }
+  lb_rr_graph.freeze();
+  return lb_rr_graph;
+}
+
+static void check_same_lb_rr_graph(const openfpga::LbRRGraph& ref,
+                                   const openfpga::LbRRGraph& test) {
+  check(ref.nodes().size() == test.nodes().size(),
+        "Mismatch in number of nodes");
+  check(ref.edges().size() == test.edges().size(),
+        "Mismatch in number of edges");
+  if ((ref.nodes().size() != test.nodes().size()) ||
+      (ref.edges().size() != test.edges().size())) {
+    return;
+  }
+  for (const LbRRNodeId& node : ref.nodes()) {
+    check(ref.node_type(node) == test.node_type(node),
+          "Mismatch in node type");
+    check(ref.node_capacity(node) == test.node_capacity(node),
+          "Mismatch in node capacity");
+    check(ref.node_pb_graph_pin(node) == test.node_pb_graph_pin(node),
+          "Mismatch in pb_graph pin of node");
+    check(ref.node_intrinsic_cost(node) == test.node_intrinsic_cost(node),
+          "Mismatch in node cost");
+  }
+  for (const LbRREdgeId& edge : ref.edges()) {
+    check(ref.edge_src_node(edge) == test.edge_src_node(edge),
+          "Mismatch in source node of edge");
+    check(ref.edge_sink_node(edge) == test.edge_sink_node(edge),
+          "Mismatch in sink node of edge");
+    check(ref.edge_intrinsic_cost(edge) == test.edge_intrinsic_cost(edge),
+          "Mismatch in edge cost");
+    check(ref.edge_mode(edge) == test.edge_mode(edge), "Mismatch in edge mode");
+  }
+}
+
+int main(int argc, const char** argv) {
+  VTR_ASSERT(1 == argc);
+  (void)argv;
+
+  std::string fname("test_physical_lb_rr_graph_database.bin");
+  TestDevice ref;
+  ref.device_annotation.add_physical_lb_rr_graph(&ref.clb_node,
+                                                 ref.build_lb_rr_graph());
+  const size_t key = openfpga::find_physical_lb_rr_graph_database_key(
+    ref.device_ctx, ref.device_annotation);
+  check(openfpga::CMD_EXEC_SUCCESS ==
+          openfpga::write_physical_lb_rr_graph_database(
+            fname, key, ref.device_ctx, ref.device_annotation, false),
+        "Fail to write physical lb_rr_graph database");
+
+  /* Read back to a device without any lb_rr_graph. Pins and modes of the
+   * graph should belong to the new device */
+  TestDevice test;
+  check(key == openfpga::find_physical_lb_rr_graph_database_key(
+                 test.device_ctx, test.device_annotation),
+        "Key depends on the addresses of the pb_graph");
+  check(openfpga::CMD_EXEC_SUCCESS ==
+          openfpga::read_physical_lb_rr_graph_database(
+            fname, key, test.device_ctx, test.device_annotation, false),
+        "Fail to read physical lb_rr_graph database");
+  check_same_lb_rr_graph(
+    test.build_lb_rr_graph(),
+    test.device_annotation.physical_lb_rr_graph(&test.clb_node));
+
+  /* The database of another architecture is not loaded */
+  TestDevice bad;
+  check(openfpga::CMD_EXEC_MINOR_ERROR ==
+          openfpga::read_physical_lb_rr_graph_database(
+            fname, key + 1, bad.device_ctx, bad.device_annotation, false),
+        "Database of another architecture is accepted");
+
+  /* Another version of the file */
+  std::string data = read_file(fname);
+  std::string bad_data = data;
+  bad_data[LB_RR_GRAPH_DATABASE_VERSION_OFFSET]++;
+  write_file(fname, bad_data);
+  check(openfpga::CMD_EXEC_MINOR_ERROR ==
+          openfpga::read_physical_lb_rr_graph_database(
+            fname, key, bad.device_ctx, bad.device_annotation, false),
+        "Database of another version is accepted");
+
+  /* Another type of file */
+  bad_data = data;
+  bad_data[0] = 'X';
+  write_file(fname, bad_data);
+  check(openfpga::CMD_EXEC_FATAL_ERROR ==
+          openfpga::read_physical_lb_rr_graph_database(
+            fname, key, bad.device_ctx, bad.device_annotation, false),
+        "File with a wrong magic word is accepted");
+
+  /* Truncated files */
+  for (size_t num_bytes : {size_t(4), data.size() / 2, data.size() - 1}) {
+    write_file(fname, data.substr(0, num_bytes));
+    check(openfpga::CMD_EXEC_FATAL_ERROR ==
+            openfpga::read_physical_lb_rr_graph_database(
+              fname, key, bad.device_ctx, bad.device_annotation, false),
+          "Truncated database is accepted");
+  }
+
+  /* The device annotation is not touched by the failed reads */
+  openfpga::LbRRGraph bad_graph =
+    bad.device_annotation.physical_lb_rr_graph(&bad.clb_node);
+  check(0 == bad_graph.nodes().size(),
+        "Graph is loaded from a rejected database");
+
+  /* Missing file */
+  std::remove(fname.c_str());
+  check(openfpga::CMD_EXEC_MINOR_ERROR ==
+          openfpga::read_physical_lb_rr_graph_database(
+            fname, key, bad.device_ctx, bad.device_annotation, false),
+        "Missing database is not reported as outdated");
+
+  return test_exit_code("Physical lb_rr_graph database");
+}
@@ -11,6 +11,9 @@ echo -e "Basic regression tests";
 echo -e "Test multiple runs of vpr"
 run-task basic_tests/vpr_standalone $@
 
+echo -e "Test loading a binary routing resource graph in vpr"
+run-task basic_tests/rr_graph_bin $@
+
 echo -e "Test source commands in openfpga shell"
 run-task basic_tests/source_command/source_string $@
 run-task basic_tests/source_command/source_file $@
@@ -0,0 +1,20 @@
+#!/bin/bash
+
+set -e
+source openfpga.sh
+PYTHON_EXEC=python3.8
+###############################################
+# OpenFPGA Shell with VPR8
+##############################################
+# These tasks map a small design to fabrics from 10x10 to 200x200,
+# which takes hours and a large amount of memory.
+# They are not part of the regular regression tests and are used to
+# measure the scaling of runtime and memory. The runtime and peak memory
+# of each command are written to runtime.csv in each run directory.
+echo -e "Fabric scaling benchmarks";
+
+echo -e "Testing the scaling of k4_N4 fabrics";
+run-task benchmark_sweep/fabric_scaling/k4_N4 $@
+
+echo -e "Testing the scaling of k6_frac_N10 fabrics";
+run-task benchmark_sweep/fabric_scaling/k6_frac_N10 $@
@@ -17,6 +17,8 @@ import shlex
 import glob
 import json
 import argparse
+import hashlib
+import tempfile
 from configparser import ConfigParser, ExtendedInterpolation
 import logging
 from envyaml import EnvYAML
@@ -124,6 +126,13 @@ parser.add_argument(
 parser.add_argument("--verific", action="store_true", help="Run yosys with verific enabled")
 parser.add_argument("--disp", action="store_true", help="Open display while running VPR")
 parser.add_argument("--debug", action="store_true", help="Run script in debug mode")
+parser.add_argument(
+    "--stage_cache",
+    type=str,
+    default=os.environ.get("OPENFPGA_STAGE_CACHE"),
+    help="Directory of a cache where the outputs of yosys and OpenFPGA shell "
+    + "runs are reused when their inputs, tools and options are unchanged",
+)
 
 # Blif_VPR Only flow arguments
 parser.add_argument("--activity_file", type=str, help="Activity file used while running yosys flow")
@@ -739,7 +748,13 @@ def run_yosys_with_abc():
     with open("yosys.ys", "w") as archfile:
         archfile.write(tmpl.safe_substitute(ys_params))
 
-    run_command("Run yosys", "yosys_output.log", [cad_tools["yosys_path"], "yosys.ys"])
+    command = [cad_tools["yosys_path"], "yosys.ys"]
+    run_cached_stage(
+        "yosys",
+        [cad_tools["yosys_path"]],
+        [open("yosys.ys", encoding="utf-8").read()] + command,
+        lambda: run_command("Run yosys", "yosys_output.log", command),
+    )
 
 
 def run_odin2():
@@ -894,7 +909,14 @@ def run_openfpga_shell():
     with open(args.top_module + "_run.openfpga", "w", encoding="utf-8") as archfile:
         archfile.write(tmpl.safe_substitute(path_variables))
     command = [cad_tools["openfpga_shell_path"], "-batch", "-f", args.top_module + "_run.openfpga"]
-    run_command("OpenFPGA Shell Run", "openfpgashell.log", command)
+    # The runtime report is used by run_fpga_task.py to schedule the next runs
+    command += ["--runtime_report", "openfpga_runtime_report.json"]
+    run_cached_stage(
+        "openfpga_shell",
+        [cad_tools["openfpga_shell_path"]],
+        [open(args.top_module + "_run.openfpga", encoding="utf-8").read()] + command,
+        lambda: run_command("OpenFPGA Shell Run", "openfpgashell.log", command),
+    )
     ExecTime["VPREnd"] = time.time()
     extract_vpr_stats("openfpgashell.log")
 
@@ -957,7 +979,12 @@ def run_rewrite_verilog():
             "write_verilog %s" % args.top_module + "_output_verilog.v",
         ]
         command = [cad_tools["yosys_path"], "-p", "; ".join(script_cmd)]
-        run_command("Yosys", "yosys_rewrite.log", command)
+        run_cached_stage(
+            "yosys_rewrite",
+            [cad_tools["yosys_path"]],
+            command,
+            lambda: run_command("Yosys", "yosys_rewrite.log", command),
+        )
     else:
         # Yosys script parameter mapping
         ys_rewrite_params = create_yosys_params()
@@ -969,10 +996,17 @@ def run_rewrite_verilog():
             logger.info("Yosys rewrite iteration: " + str(iteration_idx))
             with open("yosys_rewrite_" + str(iteration_idx) + ".ys", "w") as archfile:
                 archfile.write(tmpl.safe_substitute(ys_rewrite_params))
-            run_command(
-                "Run yosys",
-                "yosys_rewrite_output_" + str(iteration_idx) + ".log",
-                [cad_tools["yosys_path"], "yosys_rewrite_" + str(iteration_idx) + ".ys"],
+            script = "yosys_rewrite_" + str(iteration_idx) + ".ys"
+            command = [cad_tools["yosys_path"], script]
+            run_cached_stage(
+                "yosys_rewrite",
+                [cad_tools["yosys_path"]],
+                [open(script, encoding="utf-8").read()] + command,
+                lambda: run_command(
+                    "Run yosys",
+                    "yosys_rewrite_output_" + str(iteration_idx) + ".log",
+                    command,
+                ),
             )
 
 
@@ -1009,6 +1043,101 @@ def run_netlists_verification(exit_if_fail=True):
     ExecTime["VerificationEnd"] = time.time()
 
 
+# Digests of the tool executables, which are computed once per run
+tool_digests = {}
+
+
+def hash_file(filename, hasher):
+    with open(filename, "rb") as fp:
+        for chunk in iter(lambda: fp.read(1 << 20), b""):
+            hasher.update(chunk)
+
+
+def find_tool_digest(tool):
+    """Identify the version of a tool by the content of its executable"""
+    tool_path = shutil.which(tool) or tool
+    if tool_path not in tool_digests:
+        hasher = hashlib.sha256()
+        if os.path.isfile(tool_path):
+            hash_file(tool_path, hasher)
+        else:
+            hasher.update(tool.encode())
+        tool_digests[tool_path] = hasher.hexdigest()
+    return tool_digests[tool_path]
+
+
+def snapshot_run_directory():
+    """Collect the size and the modification time of each file in the run directory"""
+    snapshot = {}
+    for dirpath, _, filenames in os.walk(os.curdir):
+        for filename in filenames:
+            filepath = os.path.normpath(os.path.join(dirpath, filename))
+            stat = os.stat(filepath)
+            snapshot[filepath] = (stat.st_size, stat.st_mtime_ns)
+    return snapshot
+
+
+def find_stage_key(stage, tools, texts):
+    """
+    Hash everything which may change the outputs of a stage:
+    - the digests of the tools
+    - the scripts and the command lines
+    - the content of any file named in the scripts or the command lines
+    The run directory is replaced by a placeholder, so that the same task
+    executed in another run directory has the same key
+    """
+    run_dir = os.getcwd()
+    hasher = hashlib.sha256()
+    hasher.update(stage.encode())
+    for tool in tools:
+        hasher.update(find_tool_digest(tool).encode())
+    input_files = set()
+    for text in texts:
+        hasher.update(text.replace(run_dir, "${RUN_DIR}").encode())
+        for token in re.split(r"[\s'\";,=]+", text):
+            if token and os.path.isfile(token):
+                input_files.add(os.path.abspath(token))
+    for input_file in sorted(input_files):
+        hasher.update(input_file.replace(run_dir, "${RUN_DIR}").encode())
+        hash_file(input_file, hasher)
+    return hasher.hexdigest()
+
+
+def run_cached_stage(stage, tools, texts, run_stage):
+    """
+    Run a stage unless its outputs are found in the stage cache.
+    The outputs of a stage are the files of the run directory which are
+    created or modified by the stage. They are copied to the cache once the
+    stage succeeds, and copied back to the run directory on a cache hit
+    """
+    if not args.stage_cache:
+        run_stage()
+        return
+    stage_dir = os.path.join(os.path.abspath(args.stage_cache), stage)
+    cache_dir = os.path.join(stage_dir, find_stage_key(stage, tools, texts))
+    if os.path.isdir(cache_dir):
+        shutil.copytree(cache_dir, os.curdir, dirs_exist_ok=True)
+        logger.info("Reused cached outputs of %s from %s" % (stage, cache_dir))
+        return
+
+    snapshot = snapshot_run_directory()
+    run_stage()
+    os.makedirs(stage_dir, exist_ok=True)
+    # Outputs are gathered aside first, so that a partial entry is never used
+    tmp_dir = tempfile.mkdtemp(dir=stage_dir)
+    os.chmod(tmp_dir, 0o755)
+    for filepath, stat in snapshot_run_directory().items():
+        if snapshot.get(filepath) != stat:
+            os.makedirs(os.path.join(tmp_dir, os.path.dirname(filepath)), exist_ok=True)
+            shutil.copy2(filepath, os.path.join(tmp_dir, filepath))
+    try:
+        os.rename(tmp_dir, cache_dir)
+        logger.info("Cached outputs of %s in %s" % (stage, cache_dir))
+    except OSError:
+        # Another task has cached the same outputs in the meantime
+        shutil.rmtree(tmp_dir, ignore_errors=True)
+
+
 def run_command(taskname, logfile, command, exit_if_fail=True):
     logger.info("Launching %s " % taskname)
     with open(logfile, "w") as output:
@@ -25,6 +25,8 @@ from string import Template
 import pprint
 from importlib import util
 from collections import OrderedDict
+from contextlib import contextmanager
+import json
 
 if util.find_spec("coloredlogs"):
     import coloredlogs
@@ -44,6 +46,9 @@ else:
     logging.basicConfig(level=logging.INFO, stream=sys.stdout, format=LOG_FORMAT)
 logger = logging.getLogger("OpenFPGA_Task_logs")
 
+# Runtime report written by OpenFPGA shell in the directory of each job
+RUNTIME_REPORT_FILE = "openfpga_runtime_report.json"
+
 
 # = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = = =
 # Read commandline arguments
@@ -58,6 +63,13 @@ parser.add_argument(
     help="Number of fpga_flow threads to run default = 2,"
     + "Typically <= Number of processors on the system",
 )
+parser.add_argument(
+    "--maxmemory",
+    type=int,
+    default=0,
+    help="Memory budget in MB shared by the running fpga_flow jobs, default = 0 (unlimited). "
+    + "The memory of each job is the peak RSS recorded in the previous runs of the task",
+)
 parser.add_argument(
     "--remove_run_dir",
     type=str,
@@ -144,6 +156,8 @@ def validate_command_line_arguments():
         logger.info("Setting loggger in debug mode")
         logger.setLevel(logging.DEBUG)
     logger.info("Set up to run %d Parallel threads", args.maxthreads)
+    if args.maxmemory:
+        logger.info("Set up to use at most %d MB of memory", args.maxmemory)
 
 
 def remove_run_dir():
@@ -423,6 +437,7 @@ def generate_each_task_actions(taskname):
                         "commands": command + bench["benchVariable"],
                         "finished": False,
                         "status": False,
+                        "profile": read_job_profile_history(curr_task_dir, flow_run_dir),
                     }
                 )
 
@@ -448,6 +463,35 @@ def get_flow_rundir(arch, top_module, flow_params=None):
     return os.path.abspath(os.path.join(*path))
 
 
+def read_job_profile_history(task_dir, job_dir):
+    """
+    Find the peak memory and the number of cores used by a job in the latest
+    previous run of the task, from the runtime report of OpenFPGA shell.
+    Return None when no previous run has the report
+    """
+    job_rel_dir = os.path.relpath(job_dir, os.getcwd())
+    prev_run_dirs = sorted(glob.glob(os.path.join(task_dir, "run*[0-9]")), reverse=True)
+    for prev_run_dir in prev_run_dirs:
+        if os.path.samefile(prev_run_dir, os.getcwd()):
+            continue
+        report_file = os.path.join(prev_run_dir, job_rel_dir, RUNTIME_REPORT_FILE)
+        if not os.path.isfile(report_file):
+            continue
+        try:
+            with open(report_file, encoding="UTF-8") as fp:
+                report = json.load(fp)
+            wall_time = float(report["wall_time_s"])
+            cpu_time = float(report["cpu_time_s"])
+            return {
+                "memory": int(report["peak_rss_kb"]) / 1024.0,
+                "cores": max(1, int(round(cpu_time / wall_time))) if wall_time > 0 else 1,
+                "wall_time": wall_time,
+            }
+        except (OSError, ValueError, KeyError):
+            logger.warning("Skipping invalid runtime report %s", report_file)
+    return None
+
+
 def create_run_command(curr_job_dir, archfile, benchmark_obj, param, task_conf):
     """
     Create_run_script function accepts run directory, architecture list and
@@ -541,7 +585,7 @@ def strip_child_logger_info(line):
 
 
 def run_single_script(s, eachJob, job_list):
-    with s:
+    with s.reserve(eachJob):
         thread_name = threading.currentThread().getName()
         eachJob["starttime"] = time.time()
         try:
@@ -589,14 +633,80 @@ def run_single_script(s, eachJob, job_list):
         logger.info("***** %d runs pending *****", no_of_finished_job)
 
 
+class JobScheduler:
+    """
+    Share the cores (--maxthreads) and the memory (--maxmemory) of the machine
+    between the jobs. A job reserves the cores and the peak memory it used in
+    the previous run of the task, or a single core when there is no history.
+    A job larger than the budget is started only when no other job runs.
+    """
+
+    def __init__(self, max_cores, max_memory):
+        self.max_cores = max(1, max_cores)
+        self.max_memory = max_memory
+        self.used_cores = 0
+        self.used_memory = 0
+        self.num_running = 0
+        self.cond = threading.Condition()
+
+    def job_resources(self, job):
+        profile = job.get("profile")
+        if not profile:
+            return 1, 0
+        memory = profile["memory"] if self.max_memory else 0
+        return min(profile["cores"], self.max_cores), memory
+
+    def fits(self, job):
+        cores, memory = self.job_resources(job)
+        if not self.num_running:
+            return True
+        if self.used_cores + cores > self.max_cores:
+            return False
+        return not self.max_memory or self.used_memory + memory <= self.max_memory
+
+    def acquire(self, job):
+        cores, memory = self.job_resources(job)
+        self.used_cores += cores
+        self.used_memory += memory
+        self.num_running += 1
+
+    @contextmanager
+    def reserve(self, job):
+        # The resources are acquired by run_actions() before starting the job
+        try:
+            yield
+        finally:
+            cores, memory = self.job_resources(job)
+            with self.cond:
+                self.used_cores -= cores
+                self.used_memory -= memory
+                self.num_running -= 1
+                self.cond.notify_all()
+
+
 def run_actions(job_list):
-    thread_sema = threading.Semaphore(args.maxthreads)
+    scheduler = JobScheduler(args.maxthreads, args.maxmemory)
+    # Start the largest jobs first, so that the small ones fill the gaps
+    pending_jobs = sorted(
+        job_list,
+        key=lambda job: (
+            (job["profile"]["memory"], job["profile"]["wall_time"]) if job["profile"] else (0, 0)
+        ),
+        reverse=True,
+    )
     thread_list = []
-    for _, eachjob in enumerate(job_list):
+    while pending_jobs:
+        with scheduler.cond:
+            eachjob = next((job for job in pending_jobs if scheduler.fits(job)), None)
+            if eachjob is None:
+                scheduler.cond.wait()
+                continue
+            scheduler.acquire(eachjob)
+        pending_jobs.remove(eachjob)
         t = threading.Thread(
             target=run_single_script,
             name=eachjob["name"],
-            args=(thread_sema, eachjob, job_list),
+            args=(scheduler, eachjob, job_list),
         )
         t.start()
         thread_list.append(t)